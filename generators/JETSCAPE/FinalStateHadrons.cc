@@ -50,7 +50,9 @@ int main(int argc, char** argv)
   JetScapeLogger::Instance()->SetVerboseLevel(0);
   
   auto reader=make_shared<JetScapeReaderAscii>("test_out.dat");
-  std::ofstream dist_output ("JetscapeFinalStateHadrons.txt"); //Format is SN, PID, E, Px, Py, Pz, Eta, Phi
+  std::ofstream dist_output ("JetscapeFinalStateHadrons.txt"); //Format is SN, PID, status, E, Px, Py, Pz
+  // the event headers make the file readable by Fun4AllHepMCInputManager::ReadJetscape()
+  dist_output<<"#\tJETSCAPE_FINAL_STATE\tv2\t|\tN\tpid\tstatus\tE\tPx\tPy\tPz"<<endl;
   vector<shared_ptr<Hadron>> hadrons;
   while (!reader->Finished())
     {
@@ -58,9 +60,9 @@ int main(int argc, char** argv)
       
       // cout<<"Analyze current event: "<<reader->GetCurrentEvent()<<endl;
 
-      //dist_output<<"Event "<< reader->GetCurrentEvent()+1<<endl;
       hadrons = reader->GetHadrons();
       cout<<"Number of hadrons is: " << hadrons.size() << endl;
+      dist_output<<"#\tEvent\t"<< reader->GetCurrentEvent()+1<<"\tN_hadrons\t"<<hadrons.size()<<endl;
       for(unsigned int i=0; i<hadrons.size(); i++)
 	{
 	  dist_output<<i<<" "<<hadrons[i].get()->pid()<<" "<<hadrons[i].get()->pstat()<<" "<< hadrons[i].get()->e() << " "<< hadrons[i].get()->px()<< " "<< hadrons[i].get()->py() << " "<< hadrons[i].get()->pz()<<  endl;
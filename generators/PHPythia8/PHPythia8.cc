@@ -29,14 +29,64 @@
 
 #include <boost/format.hpp>
 
+#include <atomic>
 #include <cassert>
+#include <condition_variable>
 #include <cstdlib>
+#include <deque>
 #include <iostream>                                // for operator<<, endl
+#include <mutex>
+#include <thread>
 
 class PHHepMCGenEvent;
 
 using namespace std;
 
+//! accepted events a generator thread keeps ready
+static const unsigned int kGeneratorQueueDepth = 4;
+
+//! Pythia8 instance running on its own thread, accepted events wait in the queue
+class PHPy8GeneratorThread
+{
+ public:
+  struct Event
+  {
+    HepMC::GenEvent *evt;
+    // generator statistics when this event was accepted
+    long nAccepted;
+    double weightSum;
+    double sigmaGen;
+  };
+
+  explicit PHPy8GeneratorThread(const string &xmlpath)
+    : pythia(xmlpath, false)
+    , stop(false)
+    , failed(false)
+    , nAccepted(0)
+    , weightSum(0)
+    , sigmaGen(0)
+  {
+    tohepmc.set_store_proc(true);
+    tohepmc.set_store_pdf(true);
+    tohepmc.set_store_xsec(true);
+  }
+
+  Pythia8::Pythia pythia;
+  HepMC::Pythia8ToHepMC tohepmc;
+  thread worker;
+
+  mutex mtx;
+  condition_variable cond;
+  deque<Event> queue;
+  atomic<bool> stop;
+  bool failed;
+
+  // statistics of the last event taken from the queue, used by process_event only
+  long nAccepted;
+  double weightSum;
+  double sigmaGen;
+};
+
 PHPythia8::PHPythia8(const std::string &name)
   : SubsysReco(name)
   , _eventcount(0)
@@ -44,6 +94,7 @@ PHPythia8::PHPythia8(const std::string &name)
   , _triggersOR(true)
   , _triggersAND(false)
   , _pythia(nullptr)
+  , _ngenerator_threads(0)
   , _configFile("phpythia8.cfg")
   , _commands()
   , _pythiaToHepMC(nullptr)
@@ -59,6 +110,7 @@ PHPythia8::PHPythia8(const std::string &name)
 
   std::string thePath(charPath);
   thePath += "/xmldoc/";
+  _xmlPath = thePath;
   _pythia = new Pythia8::Pythia(thePath.c_str());
 
   _pythiaToHepMC = new HepMC::Pythia8ToHepMC();
@@ -71,6 +123,7 @@ PHPythia8::PHPythia8(const std::string &name)
 
 PHPythia8::~PHPythia8()
 {
+  stop_generator_threads();
   delete _pythia;
   delete _pythiaToHepMC;
 }
@@ -114,17 +167,124 @@ int PHPythia8::Init(PHCompositeNode *topNode)
 
   _pythia->init();
 
+  if (_ngenerator_threads > 0)
+  {
+    start_generator_threads(seed);
+  }
+
   return Fun4AllReturnCodes::EVENT_OK;
 }
 
+void PHPythia8::configure(Pythia8::Pythia *pythia, const unsigned int seed) const
+{
+  if (!_configFile.empty()) pythia->readFile(_configFile.c_str());
+  for (unsigned int j = 0; j < _commands.size(); j++)
+  {
+    pythia->readString(_commands[j]);
+  }
+  pythia->readString("Random:setSeed = on");
+  pythia->readString(str(boost::format("Random:seed = %1%") % seed));
+}
+
+void PHPythia8::start_generator_threads(const unsigned int seed)
+{
+  for (unsigned int i = 0; i < _ngenerator_threads; ++i)
+  {
+    // stays within the valid PYTHIA8 seed range of 1 - 900000000
+    unsigned int threadseed = 1 + (seed + i) % 900000000;
+    PHPy8GeneratorThread *gen = new PHPy8GeneratorThread(_xmlPath);
+    configure(&gen->pythia, threadseed);
+    if (Verbosity() > 0)
+    {
+      cout << "PHPythia8 generator thread " << i << " random seed: " << threadseed << endl;
+    }
+    gen->worker = thread(&PHPythia8::run_generator_thread, this, gen);
+    _generator_threads.push_back(gen);
+  }
+}
+
+void PHPythia8::stop_generator_threads()
+{
+  for (unsigned int i = 0; i < _generator_threads.size(); ++i)
+  {
+    PHPy8GeneratorThread *gen = _generator_threads[i];
+    {
+      lock_guard<mutex> lock(gen->mtx);
+      gen->stop = true;
+    }
+    gen->cond.notify_all();
+    gen->worker.join();
+    while (!gen->queue.empty())
+    {
+      delete gen->queue.front().evt;
+      gen->queue.pop_front();
+    }
+    delete gen;
+  }
+  _generator_threads.clear();
+}
+
+void PHPythia8::run_generator_thread(PHPy8GeneratorThread *gen)
+{
+  if (!gen->pythia.init())
+  {
+    lock_guard<mutex> lock(gen->mtx);
+    gen->failed = true;
+    gen->cond.notify_all();
+    return;
+  }
+  while (true)
+  {
+    bool passedTrigger = false;
+    while (!passedTrigger)
+    {
+      if (gen->stop) return;
+      if (!gen->pythia.next()) continue;
+      passedTrigger = pass_triggers(&gen->pythia);
+    }
+
+    PHPy8GeneratorThread::Event next;
+    next.evt = new HepMC::GenEvent(HepMC::Units::GEV, HepMC::Units::MM);
+    gen->tohepmc.fill_next_event(gen->pythia, next.evt);
+    next.nAccepted = gen->pythia.info.nAccepted();
+    next.weightSum = gen->pythia.info.weightSum();
+    next.sigmaGen = gen->pythia.info.sigmaGen();
+
+    unique_lock<mutex> lock(gen->mtx);
+    gen->cond.wait(lock, [gen] { return gen->queue.size() < kGeneratorQueueDepth || gen->stop; });
+    if (gen->stop)
+    {
+      delete next.evt;
+      return;
+    }
+    gen->queue.push_back(next);
+    lock.unlock();
+    gen->cond.notify_all();
+  }
+}
+
 int PHPythia8::End(PHCompositeNode *topNode)
 {
   if (Verbosity() >= VERBOSITY_MORE) cout << "PHPythia8::End - I'm here!" << endl;
 
+  // the generator threads ran ahead, their statistics include events still in the queue
+  long nAccepted = _pythia->info.nAccepted();
+  if (!_generator_threads.empty())
+  {
+    nAccepted = 0;
+    for (unsigned int i = 0; i < _generator_threads.size(); ++i)
+    {
+      nAccepted += _generator_threads[i]->nAccepted;
+    }
+  }
+
   if (Verbosity() >= VERBOSITY_SOME)
   {
     //-* dump out closing info (cross-sections, etc)
-    _pythia->stat();
+    if (_generator_threads.empty())
+    {
+      _pythia->stat();
+    }
 
     //match pythia printout
     cout << " |                                                                "
@@ -132,8 +292,8 @@ int PHPythia8::End(PHCompositeNode *topNode)
     cout << "                         PHPythia8::End - " << _eventcount
          << " events passed trigger" << endl;
     cout << "                         Fraction passed: " << _eventcount
-         << "/" << _pythia->info.nAccepted()
-         << " = " << _eventcount / float(_pythia->info.nAccepted()) << endl;
+         << "/" << nAccepted
+         << " = " << _eventcount / float(nAccepted) << endl;
     cout << " *-------  End PYTHIA Trigger Statistics  ------------------------"
          << "-------------------------------------------------* " << endl;
 
@@ -146,6 +306,8 @@ int PHPythia8::End(PHCompositeNode *topNode)
     }
   }
 
+  stop_generator_threads();
+
   return Fun4AllReturnCodes::EVENT_OK;
 }
 
@@ -179,69 +341,47 @@ int PHPythia8::process_event(PHCompositeNode *topNode)
 {
   if (Verbosity() >= VERBOSITY_MORE) cout << "PHPythia8::process_event - event: " << _eventcount << endl;
 
-  bool passedGen = false;
-  bool passedTrigger = false;
-  int genCounter = 0;
-
-  while (!passedTrigger)
+  HepMC::GenEvent *genevent = nullptr;
+  if (!_generator_threads.empty())
   {
-    ++genCounter;
-
-    // generate another pythia event
-    while (!passedGen)
-    {
-      passedGen = _pythia->next();
-    }
-
-    // test trigger logic
-
-    bool andScoreKeeper = true;
-    if (Verbosity() >= VERBOSITY_EVEN_MORE)
+    // take the events from the threads in turn, this keeps the sequence reproducible
+    PHPy8GeneratorThread *gen = _generator_threads[_eventcount % _generator_threads.size()];
+    unique_lock<mutex> lock(gen->mtx);
+    gen->cond.wait(lock, [gen] { return !gen->queue.empty() || gen->failed; });
+    if (gen->queue.empty())
     {
-      cout << "PHPythia8::process_event - triggersize: " << _registeredTriggers.size() << endl;
+      cout << "PHPythia8::process_event - Pythia8 initialization failed in generator thread" << endl;
+      return Fun4AllReturnCodes::ABORTRUN;
     }
-
-    for (unsigned int tr = 0; tr < _registeredTriggers.size(); tr++)
+    PHPy8GeneratorThread::Event next = gen->queue.front();
+    gen->queue.pop_front();
+    lock.unlock();
+    gen->cond.notify_all();
+
+    genevent = next.evt;
+    genevent->set_event_number(_eventcount);
+    gen->nAccepted = next.nAccepted;
+    gen->weightSum = next.weightSum;
+    gen->sigmaGen = next.sigmaGen;
+  }
+  else
+  {
+    bool passedTrigger = false;
+    while (!passedTrigger)
     {
-      bool trigResult = _registeredTriggers[tr]->Apply(_pythia);
-
-      if (Verbosity() >= VERBOSITY_EVEN_MORE)
-      {
-        cout << "PHPythia8::process_event trigger: "
-             << _registeredTriggers[tr]->GetName() << "  " << trigResult << endl;
-      }
-
-      if (_triggersOR && trigResult)
-      {
-        passedTrigger = true;
-        break;
-      }
-      else if (_triggersAND)
-      {
-        andScoreKeeper &= trigResult;
-      }
-
-      if (Verbosity() >= VERBOSITY_EVEN_MORE && !passedTrigger)
+      // generate another pythia event
+      while (!_pythia->next())
       {
-        cout << "PHPythia8::process_event - failed trigger: "
-             << _registeredTriggers[tr]->GetName() << endl;
       }
+      passedTrigger = pass_triggers(_pythia);
     }
 
-    if ((andScoreKeeper && _triggersAND) || (_registeredTriggers.size() == 0))
-    {
-      passedTrigger = true;
-      genCounter = 0;
-    }
+    // fill HepMC object with event & pass to
 
-    passedGen = false;
+    genevent = new HepMC::GenEvent(HepMC::Units::GEV, HepMC::Units::MM);
+    _pythiaToHepMC->fill_next_event(*_pythia, genevent, _eventcount);
   }
 
-  // fill HepMC object with event & pass to
-
-  HepMC::GenEvent *genevent = new HepMC::GenEvent(HepMC::Units::GEV, HepMC::Units::MM);
-  _pythiaToHepMC->fill_next_event(*_pythia, genevent, _eventcount);
-
   /* pass HepMC to PHNode*/
   PHHepMCGenEvent *success = hepmc_helper.insert_event(genevent);
   if (!success)
@@ -253,23 +393,84 @@ int PHPythia8::process_event(PHCompositeNode *topNode)
   // print outs
 
   if (Verbosity() >= VERBOSITY_MORE) cout << "PHPythia8::process_event - FINISHED WHOLE EVENT" << endl;
-  if (_eventcount < 2 && Verbosity() >= VERBOSITY_SOME) _pythia->event.list();
-  if (_eventcount >= 2 && Verbosity() >= VERBOSITY_A_LOT) _pythia->event.list();
+  if (_generator_threads.empty())
+  {
+    if (_eventcount < 2 && Verbosity() >= VERBOSITY_SOME) _pythia->event.list();
+    if (_eventcount >= 2 && Verbosity() >= VERBOSITY_A_LOT) _pythia->event.list();
+  }
 
   ++_eventcount;
 
   // save statistics
   if (_integral_node)
   {
-    _integral_node->set_N_Generator_Accepted_Event(_pythia->info.nAccepted());
+    long nAccepted = _pythia->info.nAccepted();
+    double weightSum = _pythia->info.weightSum();
+    double sigmaGen = _pythia->info.sigmaGen();
+    if (!_generator_threads.empty())
+    {
+      // combined statistics of the threads, cross sections weighted by their accepted events
+      nAccepted = 0;
+      weightSum = 0;
+      double sigmaSum = 0;
+      for (unsigned int i = 0; i < _generator_threads.size(); ++i)
+      {
+        nAccepted += _generator_threads[i]->nAccepted;
+        weightSum += _generator_threads[i]->weightSum;
+        sigmaSum += _generator_threads[i]->sigmaGen * _generator_threads[i]->nAccepted;
+      }
+      sigmaGen = (nAccepted > 0 ? sigmaSum / nAccepted : 0);
+    }
+    _integral_node->set_N_Generator_Accepted_Event(nAccepted);
     _integral_node->set_N_Processed_Event(_eventcount);
-    _integral_node->set_Sum_Of_Weight(_pythia->info.weightSum());
-    _integral_node->set_Integrated_Lumi(_pythia->info.nAccepted() / (_pythia->info.sigmaGen() * 1e9));
+    _integral_node->set_Sum_Of_Weight(weightSum);
+    _integral_node->set_Integrated_Lumi(nAccepted / (sigmaGen * 1e9));
   }
 
   return Fun4AllReturnCodes::EVENT_OK;
 }
 
+bool PHPythia8::pass_triggers(Pythia8::Pythia *pythia) const
+{
+  if (Verbosity() >= VERBOSITY_EVEN_MORE)
+  {
+    cout << "PHPythia8::pass_triggers - triggersize: " << _registeredTriggers.size() << endl;
+  }
+  if (_registeredTriggers.empty())
+  {
+    return true;
+  }
+
+  bool andScoreKeeper = true;
+  for (unsigned int tr = 0; tr < _registeredTriggers.size(); tr++)
+  {
+    bool trigResult = _registeredTriggers[tr]->Apply(pythia);
+
+    if (Verbosity() >= VERBOSITY_EVEN_MORE)
+    {
+      cout << "PHPythia8::pass_triggers trigger: "
+           << _registeredTriggers[tr]->GetName() << "  " << trigResult << endl;
+    }
+
+    if (_triggersOR && trigResult)
+    {
+      return true;
+    }
+    else if (_triggersAND)
+    {
+      andScoreKeeper &= trigResult;
+    }
+
+    if (Verbosity() >= VERBOSITY_EVEN_MORE)
+    {
+      cout << "PHPythia8::pass_triggers - failed trigger: "
+           << _registeredTriggers[tr]->GetName() << endl;
+    }
+  }
+
+  return andScoreKeeper && _triggersAND;
+}
+
 int PHPythia8::create_node_tree(PHCompositeNode *topNode)
 {
   // HepMC IO
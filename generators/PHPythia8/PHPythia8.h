@@ -12,6 +12,7 @@
 class PHCompositeNode;
 class PHGenIntegral;
 class PHPy8GenTrigger;
+class PHPy8GeneratorThread;
 
 namespace HepMC
 {
@@ -105,9 +106,23 @@ class PHPythia8 : public SubsysReco
   //! whether to store the integrated luminosity and other event statistics to the TOP/RUN/PHGenIntegral node
   void save_integrated_luminosity(const bool b) { _save_integrated_luminosity = b; }
 
+  //! generate and trigger events ahead on this many threads, each with its own
+  //! Pythia8 instance and seed. Events are taken from the threads in turn, so the
+  //! event sequence is reproducible for a given seed and number of threads.
+  //! The registered triggers are called from these threads.
+  //! 0 (default) generates the events in process_event
+  void set_generator_threads(const unsigned int n) { _ngenerator_threads = n; }
+
  private:
   int read_config(const char *cfg_file = 0);
   int create_node_tree(PHCompositeNode *topNode);
+  //! configure a generator thread instance like the main Pythia8 instance, with its own seed
+  void configure(Pythia8::Pythia *pythia, const unsigned int seed) const;
+  //! the registered triggers with the OR/AND logic
+  bool pass_triggers(Pythia8::Pythia *pythia) const;
+  void start_generator_threads(const unsigned int seed);
+  void stop_generator_threads();
+  void run_generator_thread(PHPy8GeneratorThread *gen);
   double percent_diff(const double a, const double b) { return fabs((a - b) / a); }
   int _eventcount;
 
@@ -118,6 +133,11 @@ class PHPythia8 : public SubsysReco
 
   // PYTHIA
   Pythia8::Pythia *_pythia;
+  std::string _xmlPath;
+
+  // generator ahead threads
+  unsigned int _ngenerator_threads;
+  std::vector<PHPy8GeneratorThread *> _generator_threads;
 
   std::string _configFile;
   std::vector<std::string> _commands;
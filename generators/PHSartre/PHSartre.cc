@@ -7,6 +7,7 @@
 
 
 #include <phhepmc/PHHepMCGenHelper.h>       // for PHHepMCGenHelper
+#include <phhepmc/PHHepMCGenProcessPool.h>
 
 #include <fun4all/Fun4AllReturnCodes.h>
 #include <fun4all/SubsysReco.h>             // for SubsysReco
@@ -16,6 +17,7 @@
 #include <TGenPhaseSpace.h>
 #include <TLorentzVector.h>                 // for TLorentzVector
 #include <TParticlePDG.h>                   // for TParticlePDG
+#include <TRandom.h>                        // for gRandom
 
 #include <CLHEP/Vector/LorentzVector.h>
 
@@ -26,7 +28,7 @@
 #include <HepMC/SimpleVector.h>             // for FourVector
 #include <HepMC/Units.h>                    // for GEV, MM
 
-#include <gsl/gsl_rng.h>                    // for gsl_rng_uniform
+#include <gsl/gsl_rng.h>                    // for gsl_rng_uniform, gsl_rng_set
 
 #include <cfloat>                           // for FLT_EPSILON
 #include <cmath>                            // for M_PI
@@ -53,6 +55,8 @@ PHSartre::PHSartre(const std::string &name)
   , daughterID(-1)
   , daughterMasses{0., 0.}
   , doPerformDecay(false)
+  , _nworkers(0)
+  , _pool(nullptr)
 {
   char *charPath = getenv("SARTRE_DIR");
   if (!charPath)
@@ -73,6 +77,7 @@ PHSartre::PHSartre(const std::string &name)
 
 PHSartre::~PHSartre()
 {
+  delete _pool;
   delete _sartre;
 }
 
@@ -119,6 +124,20 @@ int PHSartre::Init(PHCompositeNode *topNode)
     cout << endl;
   }
 
+  if (_nworkers > 1)
+  {
+    // sartre is initialized once (the tables take a while) and then forked
+    _pool = new PHHepMCGenProcessPool(_nworkers);
+    _pool->Verbosity(Verbosity());
+    if (_pool->Start([this](const unsigned int worker) { reseed_worker(worker); },
+                     [this](unsigned int &ntrials) { return generate_event(ntrials); }))
+    {
+      cout << "PHSartre::Init - could not start " << _nworkers << " worker processes" << endl;
+      return Fun4AllReturnCodes::ABORTRUN;
+    }
+    cout << "PHSartre: generating in " << _nworkers << " worker processes" << endl;
+  }
+
   return Fun4AllReturnCodes::EVENT_OK;
 }
 
@@ -126,6 +145,13 @@ int PHSartre::End(PHCompositeNode *topNode)
 {
   if (Verbosity() > 1) cout << "PHSartre::End - I'm here!" << endl;
 
+  if (_pool)
+  {
+    _pool->Stop();
+    cout << "PHSartre: events were generated by " << _nworkers
+         << " worker processes, the sartre status below does not include them" << endl;
+  }
+
   cout << "PHSartre: "
        << " Total cross-section: " << _sartre->totalCrossSection() << " nb" << endl;
   _sartre->listStatus();
@@ -155,6 +181,37 @@ int PHSartre::process_event(PHCompositeNode *topNode)
 {
   if (Verbosity() > 1) cout << "PHSartre::process_event - event: " << _eventcount << endl;
 
+  unsigned int ntrials = 0;
+  HepMC::GenEvent *genevent = (_pool ? _pool->Next(&ntrials) : generate_event(ntrials));
+  _gencount += ntrials;
+  if (!genevent)
+  {
+    cout << "PHSartre::process_event - no event from the worker processes" << endl;
+    return Fun4AllReturnCodes::ABORTRUN;
+  }
+
+  // add some information to the event
+  genevent->set_event_number(_eventcount);
+
+  // pass HepMC to PHNode
+
+  PHHepMCGenEvent *success = hepmc_helper.insert_event(genevent);
+  if (!success)
+  {
+    cout << "PHSartre::process_event - Failed to add event to HepMC record!" << endl;
+    return Fun4AllReturnCodes::ABORTRUN;
+  }
+
+  // print outs
+
+  if (Verbosity() > 2) cout << "PHSartre::process_event - FINISHED WHOLE EVENT" << endl;
+
+  ++_eventcount;
+  return Fun4AllReturnCodes::EVENT_OK;
+}
+
+HepMC::GenEvent *PHSartre::generate_event(unsigned int &ntrials)
+{
   bool passedTrigger = false;
   Event *event = nullptr;
 
@@ -171,7 +228,7 @@ int PHSartre::process_event(PHCompositeNode *topNode)
 
   while (!passedTrigger)
   {
-    ++_gencount;
+    ++ntrials;
 
     // Generate a Sartre event
     event = _sartre->generateEvent();
@@ -292,9 +349,6 @@ int PHSartre::process_event(PHCompositeNode *topNode)
 
   HepMC::GenEvent *genevent = new HepMC::GenEvent(HepMC::Units::GEV, HepMC::Units::MM);
 
-  // add some information to the event
-  genevent->set_event_number(_eventcount);
-
   // Set the PDF information
   HepMC::PdfInfo pdfinfo;
   pdfinfo.set_scalePDF(event->Q2);
@@ -456,21 +510,7 @@ int PHSartre::process_event(PHCompositeNode *topNode)
     }
   }
 
-  // pass HepMC to PHNode
-
-  PHHepMCGenEvent *success = hepmc_helper.insert_event(genevent);
-  if (!success)
-  {
-    cout << "PHSartre::process_event - Failed to add event to HepMC record!" << endl;
-    return Fun4AllReturnCodes::ABORTRUN;
-  }
-
-  // print outs
-
-  if (Verbosity() > 2) cout << "PHSartre::process_event - FINISHED WHOLE EVENT" << endl;
-
-  ++_eventcount;
-  return Fun4AllReturnCodes::EVENT_OK;
+  return genevent;
 }
 
 int PHSartre::create_node_tree(PHCompositeNode *topNode)
@@ -485,6 +525,16 @@ int PHSartre::ResetEvent(PHCompositeNode *topNode)
   return Fun4AllReturnCodes::EVENT_OK;
 }
 
+void PHSartre::reseed_worker(const unsigned int worker)
+{
+  // sartre itself, the vector meson decays (gRandom) and the beam reversal
+  const unsigned long seed = settings->seed() + worker;
+  settings->setSeed(seed);
+  settings->randomGenerator()->SetSeed(seed);
+  gRandom->SetSeed(seed);
+  gsl_rng_set(hepmc_helper.get_random_generator(), seed);
+}
+
 void PHSartre::register_trigger(PHSartreGenTrigger *theTrigger)
 {
   if (Verbosity() > 1) cout << "PHSartre::registerTrigger - trigger " << theTrigger->GetName() << " registered" << endl;
@@ -9,6 +9,7 @@
 #include <vector>
 
 class PHCompositeNode;
+class PHHepMCGenProcessPool;
 
 class Sartre;
 class Event;
@@ -16,6 +17,11 @@ class EventGeneratorSettings;
 class PHSartreGenTrigger;
 class TGenPhaseSpace;
 
+namespace HepMC
+{
+  class GenEvent;
+}
+
 class PHSartre : public SubsysReco
 {
  public:
@@ -50,6 +56,10 @@ class PHSartre : public SubsysReco
   /// pass commands directly to PYTHIA8
   void process_string(std::string s) { _commands.push_back(s); }
 
+  //! generate in this many forked processes, worker i is seeded with the runcard seed + i.
+  //! The event sequence is reproducible for a given seed and number of workers
+  void set_nworkers(const unsigned int n) { _nworkers = n; }
+
   void beam_vertex_parameters(double beamX,
                               double beamY,
                               double beamZ,
@@ -99,6 +109,10 @@ class PHSartre : public SubsysReco
 
  private:
   int create_node_tree(PHCompositeNode *topNode);
+  //! runs sartre until an event passes the triggers, ntrials counts the generated events
+  HepMC::GenEvent *generate_event(unsigned int &ntrials);
+  //! reseeds all random generators of a forked worker
+  void reseed_worker(const unsigned int worker);
   double percent_diff(const double a, const double b) { return fabs((a - b) / a); }
   void randomlyReverseBeams(Event *myEvent);
   void ReverseBeams(Event *myEvent);
@@ -122,6 +136,9 @@ class PHSartre : public SubsysReco
   double daughterMasses[2];
   bool doPerformDecay;
 
+  unsigned int _nworkers;
+  PHHepMCGenProcessPool *_pool;
+
   //! helper for insert HepMC event to DST node and add vertex smearing
   PHHepMCGenHelper hepmc_helper;
 };
@@ -13,9 +13,7 @@
 
 #include "flowAfterburner.h"
 
-#include <gsl/gsl_errno.h>
 #include <gsl/gsl_math.h>
-#include <gsl/gsl_roots.h>
 
 #include <HepMC/GenEvent.h>
 #include <HepMC/GenParticle.h>  // for GenParticle
@@ -30,6 +28,7 @@
 
 #include <cmath>
 #include <map>  // for map
+#include <vector>
 
 namespace CLHEP
 {
@@ -55,39 +54,6 @@ struct loaderObj
 
 loaderObj loader;
 
-double
-vn_func(double x, void *params)
-{
-  float *par_float = (float *) params;
-  float phi_0 = par_float[0];
-  float *vn = par_float + 1;
-  float *psi_n = vn + 6;
-  double val =
-      x + 2 * (vn[0] * sin(1 * (x - psi_n[0])) / 1.0 +
-               vn[1] * sin(2 * (x - psi_n[1])) / 2.0 +
-               vn[2] * sin(3 * (x - psi_n[2])) / 3.0 +
-               vn[3] * sin(4 * (x - psi_n[3])) / 4.0 +
-               vn[4] * sin(5 * (x - psi_n[4])) / 5.0 +
-               vn[5] * sin(6 * (x - psi_n[5])) / 6.0);
-  return val - phi_0;
-}
-
-double
-vn_func_derivative(double x, void *params)
-{
-  float *par_float = (float *) params;
-  float *vn = par_float + 1;
-  float *psi_n = vn + 6;
-  double val =
-      1 + 2 * (vn[0] * cos(1 * (x - psi_n[0])) / 1.0 +
-               vn[1] * cos(2 * (x - psi_n[1])) / 2.0 +
-               vn[2] * cos(3 * (x - psi_n[2])) / 3.0 +
-               vn[3] * cos(4 * (x - psi_n[3])) / 4.0 +
-               vn[4] * cos(5 * (x - psi_n[4])) / 5.0 +
-               vn[5] * cos(6 * (x - psi_n[5])) / 6.0);
-  return val;
-}
-
 float psi_n[6], v1, v2, v3, v4, v5, v6;
 
 void MoveDescendantsToParent(HepMC::GenParticle *parent,
@@ -201,89 +167,98 @@ void custom_vn(double /*b*/, double /*eta*/, double /*pt*/)
   v6 = 0.0015;
 }
 
-double
-AddFlowToParent(HepMC::GenEvent *event, HepMC::GenParticle *parent)
+// Solve phi + 2 sum_n v_n/n sin(n (phi - psi_n)) = phi_0 for all particles
+// at once. The arrays are indexed by particle, vn[n] holds harmonic n+1.
+// Newton steps are kept inside the bracket of the root and replaced by a
+// bisection where they leave it. Only one sin/cos per particle and iteration
+// is evaluated, the higher harmonics follow from the angle addition theorems.
+// Particles which do not converge within 1000 iterations keep phi_0.
+void SolveFlowShifts(const std::vector<double> &phi_0,
+                     const std::vector<float> (&vn)[6],
+                     std::vector<double> &phi)
 {
-  CLHEP::HepLorentzVector momentum(parent->momentum().px(),
-                                   parent->momentum().py(),
-                                   parent->momentum().pz(),
-                                   parent->momentum().e());
-  double pt = momentum.perp();
-  double eta = momentum.pseudoRapidity();
-  double phi_0 = momentum.phi();
-
-  HepMC::HeavyIon *hi = event->heavy_ion();
-  double b = hi->impact_parameter();
-
-  v1 = 0, v2 = 0, v3 = 0, v4 = 0, v5 = 0, v6 = 0;
-
-  //Call the appropriate function to set the vn values
-  if (algorithm == minbias_algorithm)
+  const size_t npart = phi_0.size();
+  double cos_npsi[6], sin_npsi[6];
+  for (int n = 0; n < 6; n++)
   {
-    jjia_minbias_new(b, eta, pt);
+    cos_npsi[n] = cos((n + 1) * psi_n[n]);
+    sin_npsi[n] = sin((n + 1) * psi_n[n]);
   }
-  else if (algorithm == minbias_v2_algorithm)
-  {
-    jjia_minbias_new_v2only(b, eta, pt);
-  }
-  else if (algorithm == custom_algorithm)
+
+  // the modulation term is bounded by 2 sum_n |v_n|/n, so is the distance of the root from phi_0
+  std::vector<double> lo(npart), hi(npart);
+  std::vector<char> done(npart, 0);
+  phi = phi_0;
+  for (size_t i = 0; i < npart; i++)
   {
-    custom_vn(b, eta, pt);
+    double bound = 1e-6;
+    for (int n = 0; n < 6; n++)
+    {
+      bound += 2 * fabs(vn[n][i]) / (n + 1);
+    }
+    lo[i] = phi_0[i] - bound;
+    hi[i] = phi_0[i] + bound;
   }
 
-  double phishift = 0;
-
-  const gsl_root_fsolver_type *T = gsl_root_fsolver_brent;
-  gsl_root_fsolver *s = gsl_root_fsolver_alloc(T);
-  double x_lo = -2 * M_PI, x_hi = 2 * M_PI;
-  float params[13];
-  for (int ipar = 0; ipar < 13; ipar++)
+  size_t nleft = npart;
+  for (int iter = 0; iter < 1000 && nleft > 0; iter++)
   {
-    params[ipar] = 0;
+    nleft = 0;
+    for (size_t i = 0; i < npart; i++)
+    {
+      if (done[i])
+      {
+        continue;
+      }
+      const double x = phi[i];
+      const double s1 = sin(x);
+      const double c1 = cos(x);
+      double sk = s1, ck = c1;  // sin, cos of (n+1) x
+      double f = x - phi_0[i];
+      double df = 1;
+      for (int n = 0; n < 6; n++)
+      {
+        const double sn = sk * cos_npsi[n] - ck * sin_npsi[n];  // sin((n+1)(x - psi_n))
+        const double cn = ck * cos_npsi[n] + sk * sin_npsi[n];  // cos((n+1)(x - psi_n))
+        f += 2 * vn[n][i] * sn / (n + 1);
+        df += 2 * vn[n][i] * cn;
+        const double sk_next = sk * c1 + ck * s1;
+        ck = ck * c1 - sk * s1;
+        sk = sk_next;
+      }
+      if (f > 0)
+      {
+        hi[i] = x;
+      }
+      else
+      {
+        lo[i] = x;
+      }
+      double next = (df > 0 ? x - f / df : 0.5 * (lo[i] + hi[i]));
+      if (next <= lo[i] || next >= hi[i])
+      {
+        next = 0.5 * (lo[i] + hi[i]);
+      }
+      phi[i] = next;
+      if (fabs(next - x) < 0.00001 || f == 0)
+      {
+        done[i] = 1;
+      }
+      else
+      {
+        nleft++;
+      }
+    }
   }
-  gsl_function F;
-  F.function = &vn_func;
-  F.params = &params;
-  gsl_root_fsolver_set(s, &F, x_lo, x_hi);
-  int iter = 0;
-  params[0] = phi_0;
-  params[1] = v1;
-  params[2] = v2;
-  params[3] = v3;
-  params[4] = v4;
-  params[5] = v5;
-  params[6] = v6;
-  params[7] = psi_n[0];
-  params[8] = psi_n[1];
-  params[9] = psi_n[2];
-  params[10] = psi_n[3];
-  params[11] = psi_n[4];
-  params[12] = psi_n[5];
-  int status;
-  double phi;
-  do
-  {
-    iter++;
-    gsl_root_fsolver_iterate(s);
-    phi = gsl_root_fsolver_root(s);
-    x_lo = gsl_root_fsolver_x_lower(s);
-    x_hi = gsl_root_fsolver_x_upper(s);
-    status = gsl_root_test_interval(x_lo, x_hi, 0, 0.00001);
-  } while (status == GSL_CONTINUE && iter < 1000);
-  gsl_root_fsolver_free(s);
-
-  if (iter >= 1000)
-    return 0;
 
-  phishift = phi - phi_0;
-
-  if (fabs(phishift) > 1e-7)
+  for (size_t i = 0; i < npart; i++)
   {
-    momentum.rotateZ(phishift);  // DPM check units * Gaudi::Units::rad);
-    parent->set_momentum(momentum);
+    if (!done[i])
+    {
+      phi[i] = phi_0[i];
+    }
   }
-
-  return phishift;
+  return;
 }
 
 int flowAfterburner(HepMC::GenEvent *event,
@@ -310,6 +285,12 @@ int flowAfterburner(HepMC::GenEvent *event,
   psi_n[1] = atan2(sin(2 * psi_n[1]), cos(2 * psi_n[1])) / 2.0;
 
   HepMC::GenVertex *mainvtx = event->barcode_to_vertex(-1);
+  double b = hi->impact_parameter();
+
+  // collect the particles from the main vertex in flat arrays
+  std::vector<HepMC::GenParticle *> parents;
+  std::vector<double> phi_0;
+  std::vector<float> vn[6];
 
   // Loop over all children of this vertex
   HepMC::GenVertexParticleRange r(*mainvtx, HepMC::children);
@@ -342,9 +323,50 @@ int flowAfterburner(HepMC::GenEvent *event,
       continue;
     }
 
-    // Add flow to particles from main vertex
-    double phishift = AddFlowToParent(event, parent);
-    MoveDescendantsToParent(parent, phishift);
+    v1 = 0, v2 = 0, v3 = 0, v4 = 0, v5 = 0, v6 = 0;
+
+    //Call the appropriate function to set the vn values
+    if (algorithm == minbias_algorithm)
+    {
+      jjia_minbias_new(b, momentum.pseudoRapidity(), momentum.perp());
+    }
+    else if (algorithm == minbias_v2_algorithm)
+    {
+      jjia_minbias_new_v2only(b, momentum.pseudoRapidity(), momentum.perp());
+    }
+    else if (algorithm == custom_algorithm)
+    {
+      custom_vn(b, momentum.pseudoRapidity(), momentum.perp());
+    }
+
+    parents.push_back(parent);
+    phi_0.push_back(momentum.phi());
+    vn[0].push_back(v1);
+    vn[1].push_back(v2);
+    vn[2].push_back(v3);
+    vn[3].push_back(v4);
+    vn[4].push_back(v5);
+    vn[5].push_back(v6);
+  }
+
+  // Add flow to all particles from main vertex in one go
+  std::vector<double> phi;
+  SolveFlowShifts(phi_0, vn, phi);
+
+  for (size_t i = 0; i < parents.size(); i++)
+  {
+    double phishift = phi[i] - phi_0[i];
+    if (fabs(phishift) > 1e-7)
+    {
+      HepMC::GenParticle *parent = parents[i];
+      CLHEP::HepLorentzVector momentum(parent->momentum().px(),
+                                       parent->momentum().py(),
+                                       parent->momentum().pz(),
+                                       parent->momentum().e());
+      momentum.rotateZ(phishift);  // DPM check units * Gaudi::Units::rad);
+      parent->set_momentum(momentum);
+    }
+    MoveDescendantsToParent(parents[i], phishift);
   }
 
   return 0;
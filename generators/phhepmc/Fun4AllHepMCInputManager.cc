@@ -1,5 +1,6 @@
 #include "Fun4AllHepMCInputManager.h"
 
+#include "PHHepMCBinaryStore.h"
 #include "PHHepMCGenEvent.h"
 #include "PHHepMCGenEventMap.h"
 
@@ -21,6 +22,7 @@
 #include <HepMC/GenEvent.h>
 #include <HepMC/GenParticle.h>                            // for GenParticle
 #include <HepMC/GenVertex.h>                              // for GenVertex
+#include <HepMC/HeavyIon.h>
 #include <HepMC/IO_GenEvent.h>
 #include <HepMC/SimpleVector.h>                           // for FourVector
 #include <HepMC/Units.h>                                  // for CM, GEV
@@ -28,9 +30,12 @@
 #include <TPRegexp.h>
 #include <TString.h>
 
+#include <boost/iostreams/device/file_descriptor.hpp>
 #include <boost/iostreams/filter/bzip2.hpp>
 #include <boost/iostreams/filter/gzip.hpp>
 
+#include <cmath>
+#include <cstdio>
 #include <cstdlib>
 #include <fstream>
 #include <iostream>
@@ -42,17 +47,37 @@ using namespace std;
 
 static const double toMM = 1.e-12;
 
+namespace
+{
+  //! the comment line starting a JETSCAPE event, # Event 1 ...
+  bool IsJetscapeEventHeader(const string &line)
+  {
+    if (line.find('#') != 0)
+    {
+      return false;
+    }
+    istringstream tokens(line.substr(1));
+    string key;
+    return (tokens >> key && key == "Event");
+  }
+}  // namespace
+
 Fun4AllHepMCInputManager::Fun4AllHepMCInputManager(const string &name, const string &nodename, const string &topnodename)
   : Fun4AllInputManager(name, nodename, topnodename)
   , events_total(0)
   , events_thisfile(0)
   , readoscar(0)
+  , readjetscape(0)
   , topNodeName(topnodename)
   , ascii_in(nullptr)
+  , binary_in(nullptr)
+  , binary_read_threads(1)
   , evt(nullptr)
   , save_evt(nullptr)
   , filestream(nullptr)
   , unzipstream(nullptr)
+  , jetscape_in(nullptr)
+  , jetscape_pipe(nullptr)
 {
   set_embedding_id(0);  // default embedding ID. Welcome to change via macro
 
@@ -79,6 +104,7 @@ Fun4AllHepMCInputManager::~Fun4AllHepMCInputManager()
   fileclose();
 
   delete ascii_in;
+  delete binary_in;
   delete filestream;
   delete unzipstream;
 }
@@ -99,7 +125,8 @@ int Fun4AllHepMCInputManager::fileopen(const string &filenam)
   }
   filename = filenam;
   FROG frog;
-  string fname(frog.location(filename.c_str()));
+  // commands are not files
+  string fname(readjetscape && filename.find('|') == 0 ? filename : frog.location(filename.c_str()));
   if (Verbosity() > 0)
   {
     cout << Name() << ": opening file " << fname << endl;
@@ -109,6 +136,67 @@ int Fun4AllHepMCInputManager::fileopen(const string &filenam)
   {
     theOscarFile.open(fname.c_str());
   }
+  else if (readjetscape)
+  {
+    jetscape_header.clear();
+    zinbuffer.reset();
+    TString tstr(fname);
+    TPRegexp bzip_ext(".bz2$");
+    TPRegexp gzip_ext(".gz$");
+    if (fname.find('|') == 0)
+    {
+      // events arrive while the command (e.g. a JETSCAPE run) produces them
+      jetscape_pipe = popen(fname.substr(1).c_str(), "r");
+      if (!jetscape_pipe)
+      {
+        cout << PHWHERE << Name() << ": could not run " << fname.substr(1) << endl;
+        return -1;
+      }
+      zinbuffer.push(boost::iostreams::file_descriptor_source(fileno(jetscape_pipe), boost::iostreams::never_close_handle));
+    }
+    else if (tstr.Contains(bzip_ext) || tstr.Contains(gzip_ext))
+    {
+      delete filestream;
+      filestream = new ifstream(fname.c_str(), std::ios::in | std::ios::binary);
+      if (tstr.Contains(bzip_ext))
+      {
+        zinbuffer.push(boost::iostreams::bzip2_decompressor());
+      }
+      else
+      {
+        zinbuffer.push(boost::iostreams::gzip_decompressor());
+      }
+      zinbuffer.push(*filestream);
+    }
+    else
+    {
+      // plain files and named pipes
+      theJetscapeFile.open(fname.c_str());
+      if (!theJetscapeFile.is_open())
+      {
+        cout << PHWHERE << Name() << ": could not open " << fname << endl;
+        return -1;
+      }
+      jetscape_in = &theJetscapeFile;
+    }
+    if (!jetscape_in)
+    {
+      delete unzipstream;
+      unzipstream = new istream(&zinbuffer);
+      jetscape_in = unzipstream;
+    }
+  }
+  else if (PHHepMCBinaryStore::IsBinaryFile(fname))
+  {
+    binary_in = new PHHepMCBinaryStore();
+    binary_in->set_nthreads(binary_read_threads);
+    if (binary_in->OpenRead(fname))
+    {
+      delete binary_in;
+      binary_in = nullptr;
+      return -1;
+    }
+  }
   else
   {
     TString tstr(fname);
@@ -188,23 +276,15 @@ int Fun4AllHepMCInputManager::run(const int nevents)
     }
     else
     {
-      if (readoscar)
-      {
-        evt = ConvertFromOscar();
-      }
-      else
-      {
-        evt = ascii_in->read_next_event();
-      }
+      evt = ReadNextEvent();
     }
 
     if (!evt)
     {
       if (Verbosity() > 1)
       {
-        cout << "Fun4AllHepMCInputManager::run::" << Name()
-             << ": error type: " << ascii_in->error_type()
-             << ", rdstate: " << ascii_in->rdstate() << endl;
+        cout << "Fun4AllHepMCInputManager::run::" << Name() << ": ";
+        PrintReadError();
       }
       fileclose();
     }
@@ -254,6 +334,29 @@ int Fun4AllHepMCInputManager::fileclose()
   {
     theOscarFile.close();
   }
+  else if (readjetscape)
+  {
+    jetscape_in = nullptr;
+    zinbuffer.reset();
+    if (theJetscapeFile.is_open())
+    {
+      theJetscapeFile.close();
+    }
+    if (filestream)
+    {
+      filestream->close();
+    }
+    if (jetscape_pipe)
+    {
+      pclose(jetscape_pipe);
+      jetscape_pipe = nullptr;
+    }
+  }
+  else if (binary_in)
+  {
+    delete binary_in;
+    binary_in = nullptr;
+  }
   else
   {
     delete ascii_in;
@@ -306,14 +409,25 @@ int Fun4AllHepMCInputManager::PushBackEvents(const int i)
   // the skipping of events we read -i events.
   int nevents = -i;  // negative number of events to push back -> skip num events
   int errorflag = 0;
+  if (binary_in)
+  {
+    // the binary file has an event index, skipped events are not decoded
+    int nskipped = binary_in->Skip(nevents);
+    if (nskipped < nevents)
+    {
+      cout << "Error after skipping " << nskipped << endl;
+      errorflag = -1;
+      fileclose();
+    }
+    return errorflag;
+  }
   while (nevents > 0 && !errorflag)
   {
-    evt = ascii_in->read_next_event();
+    evt = ReadNextEvent();
     if (!evt)
     {
-      cout << "Error after skipping " << i - nevents << endl;
-      cout << "error type: " << ascii_in->error_type()
-           << ", rdstate: " << ascii_in->rdstate() << endl;
+      cout << "Error after skipping " << -i - nevents << endl;
+      PrintReadError();
       errorflag = -1;
       fileclose();
     }
@@ -330,6 +444,37 @@ int Fun4AllHepMCInputManager::PushBackEvents(const int i)
   return errorflag;
 }
 
+HepMC::GenEvent *
+Fun4AllHepMCInputManager::ReadNextEvent()
+{
+  if (readoscar)
+  {
+    return ConvertFromOscar();
+  }
+  if (readjetscape)
+  {
+    return ConvertFromJetscape();
+  }
+  if (binary_in)
+  {
+    return binary_in->ReadNextEvent();
+  }
+  return ascii_in->read_next_event();
+}
+
+void Fun4AllHepMCInputManager::PrintReadError() const
+{
+  if (ascii_in)
+  {
+    cout << "error type: " << ascii_in->error_type()
+         << ", rdstate: " << ascii_in->rdstate() << endl;
+  }
+  else
+  {
+    cout << "end of file " << filename << endl;
+  }
+}
+
 HepMC::GenEvent *
 Fun4AllHepMCInputManager::ConvertFromOscar()
 {
@@ -404,3 +549,141 @@ Fun4AllHepMCInputManager::ConvertFromOscar()
   }
   return evt;
 }
+
+HepMC::GenEvent *
+Fun4AllHepMCInputManager::ConvertFromJetscape()
+{
+  // JETSCAPE final state format:
+  // #	JETSCAPE_FINAL_STATE	v2	|	N	pid	status	E	Px	Py	Pz
+  // #	Event	1	weight	1	EPangle	0	N_hadrons	236
+  // 0	211	27	2.39	-0.21	1.04	2.14
+  // ...
+  // Every event starts with its header line. With N_hadrons in the header the
+  // event ends after its last hadron, so streams are not read past the event.
+  // Without it the event ends at the next event header or the end of the file.
+  string theLine;
+  bool have_line = false;  // hadron line read while looking for the event header
+  if (jetscape_header.empty())
+  {
+    while (getline(*jetscape_in, theLine))
+    {
+      if (IsJetscapeEventHeader(theLine))
+      {
+        jetscape_header = theLine;
+        break;
+      }
+      if (theLine.find('#') != 0 && theLine.find_first_not_of(" \t\r") != string::npos)
+      {
+        // hadrons without event header, all of them are one event
+        have_line = true;
+        break;
+      }
+    }
+    if (jetscape_header.empty() && !have_line)
+    {
+      return nullptr;  // end of file
+    }
+  }
+
+  int event_number = events_total;
+  int nhadrons = -1;
+  double weight = NAN;
+  double epangle = NAN;
+  if (!jetscape_header.empty())
+  {
+    istringstream tokens(jetscape_header.substr(1));
+    string key;
+    string value;
+    while (tokens >> key >> value)
+    {
+      if (key == "Event")
+      {
+        event_number = atoi(value.c_str());
+      }
+      else if (key == "N_hadrons")
+      {
+        nhadrons = atoi(value.c_str());
+      }
+      else if (key == "weight")
+      {
+        weight = atof(value.c_str());
+      }
+      else if (key == "EPangle")
+      {
+        epangle = atof(value.c_str());
+      }
+    }
+    jetscape_header.clear();
+  }
+
+  //use PHENIX unit
+  HepMC::GenEvent *jetscape_evt = new HepMC::GenEvent(HepMC::Units::GEV, HepMC::Units::CM);
+  jetscape_evt->set_event_number(event_number);
+  if (!std::isnan(weight))
+  {
+    jetscape_evt->weights().push_back(weight);
+  }
+  if (!std::isnan(epangle))
+  {
+    HepMC::HeavyIon heavyion;
+    heavyion.set_event_plane_angle(epangle);
+    jetscape_evt->set_heavy_ion(heavyion);
+  }
+  // the final state hadrons come without vertex, they all start at the origin
+  HepMC::GenVertex *v = new HepMC::GenVertex(HepMC::FourVector(0, 0, 0, 0));
+  jetscape_evt->add_vertex(v);
+
+  if (Verbosity() > 1) cout << "Reading JETSCAPE Event " << event_number << endl;
+  int nread = 0;
+  int barcode = 0;
+  while (nhadrons < 0 || nread < nhadrons)
+  {
+    if (!have_line && !getline(*jetscape_in, theLine))
+    {
+      break;
+    }
+    have_line = false;
+    if (IsJetscapeEventHeader(theLine))
+    {
+      jetscape_header = theLine;  // next event
+      break;
+    }
+    if (theLine.find('#') == 0)
+    {
+      continue;  // e.g. the cross section at the end of the file
+    }
+    int index = 0;
+    int pid = 0;
+    int status = 0;
+    double E = 0;
+    double px = 0;
+    double py = 0;
+    double pz = 0;
+    if (!(istringstream(theLine) >> index >> pid >> status >> E >> px >> py >> pz))
+    {
+      continue;  // empty lines
+    }
+    ++nread;
+    // negative status are the holes left behind by recoils, they are
+    // subtracted in jet finding and must not be tracked
+    if (status < 0)
+    {
+      continue;
+    }
+    HepMC::GenParticle *p = new HepMC::GenParticle(HepMC::FourVector(px, py, pz, E), pid, 1);
+    p->suggest_barcode(++barcode);
+    v->add_particle_out(p);
+  }
+  if (nhadrons >= 0 && nread < nhadrons)
+  {
+    cout << PHWHERE << Name() << ": JETSCAPE event " << event_number << " truncated after "
+         << nread << " of " << nhadrons << " hadrons" << endl;
+    delete jetscape_evt;
+    return nullptr;
+  }
+  if (Verbosity() > 3)
+  {
+    jetscape_evt->print();
+  }
+  return jetscape_evt;
+}
@@ -6,6 +6,7 @@
 #include <fun4all/Fun4AllInputManager.h>
 #include <fun4all/Fun4AllReturnCodes.h>
 
+#include <cstdio>  // for FILE
 #include <fstream>
 #include <string>
 
@@ -16,6 +17,7 @@
 #endif
 
 class PHCompositeNode;
+class PHHepMCBinaryStore;
 class SyncObject;
 
 // forward declaration of classes in namespace
@@ -35,6 +37,10 @@ class Fun4AllHepMCInputManager : public Fun4AllInputManager
   virtual int fileclose();
   virtual int run(const int nevents = 0);
   void ReadOscar(const int i = 1) { readoscar = i; }
+  //! read the JETSCAPE final state hadron format instead of HepMC (.gz and .bz2 as well).
+  //! A file name starting with | runs the rest as command and reads its output,
+  //! a named pipe works as file name, too
+  void ReadJetscape(const int i = 1) { readjetscape = i; }
   virtual void Print(const std::string &what = "ALL") const;
   virtual int PushBackEvents(const int i);
 
@@ -44,6 +50,10 @@ class Fun4AllHepMCInputManager : public Fun4AllInputManager
   int GetSyncObject(SyncObject ** /*mastersync*/) { return Fun4AllReturnCodes::SYNC_NOOBJECT; }
   int NoSyncPushBackEvents(const int nevt) { return PushBackEvents(nevt); }
   HepMC::GenEvent *ConvertFromOscar();
+  HepMC::GenEvent *ConvertFromJetscape();
+
+  //! number of threads decoding read ahead events of binary (.hepmcb) files
+  void set_binary_read_threads(const unsigned int n) { binary_read_threads = n; }
 
   //! toss a new vertex according to a Uniform or Gaus distribution
   void set_vertex_distribution_function(PHHepMCGenHelper::VTXFUNC x, PHHepMCGenHelper::VTXFUNC y, PHHepMCGenHelper::VTXFUNC z, PHHepMCGenHelper::VTXFUNC t)
@@ -82,16 +92,22 @@ class Fun4AllHepMCInputManager : public Fun4AllInputManager
   void set_embedding_id(int id) { hepmc_helper.set_embedding_id(id); }
 
  protected:
+  //! next event from the open oscar, binary or ascii file, nullptr at the end of the file
+  HepMC::GenEvent *ReadNextEvent();
+  void PrintReadError() const;
 
   int events_total;
   int events_thisfile;
   int readoscar;
+  int readjetscape;
 
   std::string filename;
   std::string topNodeName;
   PHCompositeNode *topNode;
 
   HepMC::IO_GenEvent *ascii_in;
+  PHHepMCBinaryStore *binary_in;
+  unsigned int binary_read_threads;
   HepMC::GenEvent *evt;
   HepMC::GenEvent *save_evt;
 
@@ -100,6 +116,14 @@ class Fun4AllHepMCInputManager : public Fun4AllInputManager
   std::istream *unzipstream;  // feed into HepMc
   std::ifstream theOscarFile;
 
+  // JETSCAPE final state input, the stream is either the file, the
+  // decompressed file or the output of the command
+  std::ifstream theJetscapeFile;
+  std::istream *jetscape_in;
+  FILE *jetscape_pipe;
+  //! event header line read ahead while looking for the end of the previous event
+  std::string jetscape_header;
+
   //! helper for insert HepMC event to DST node and add vertex smearing
   PHHepMCGenHelper hepmc_helper;
 
@@ -1,5 +1,6 @@
 #include "Fun4AllHepMCOutputManager.h"
 
+#include "PHHepMCBinaryStore.h"
 #include "PHHepMCGenEvent.h"
 #include "PHHepMCGenEventMap.h"
 
@@ -36,6 +37,8 @@ Fun4AllHepMCOutputManager::Fun4AllHepMCOutputManager(const string &myname,
                                                      const string &filename)
   : Fun4AllOutputManager(myname)
   , outfilename(filename)
+  , ascii_out(nullptr)
+  , binary_out(nullptr)
   , comment_written(0)
   , filestream(nullptr)
   , zipstream(nullptr)
@@ -45,7 +48,18 @@ Fun4AllHepMCOutputManager::Fun4AllHepMCOutputManager(const string &myname,
   TPRegexp bzip_ext(".bz2$");
   TPRegexp gzip_ext(".gz$");
 
-  if (tstr.Contains(bzip_ext))
+  if (PHHepMCBinaryStore::IsBinaryFile(filename))
+  {
+    binary_out = new PHHepMCBinaryStore();
+    binary_out->set_write_queue(100);
+    if (binary_out->OpenWrite(filename))
+    {
+      cout << "error opening " << outfilename << " exiting " << endl;
+      exit(1);
+    }
+    return;
+  }
+  else if (tstr.Contains(bzip_ext))
   {
     // use boost iosteam library to compress to bz2 file on the fly
     filestream = new ofstream(filename.c_str(), std::ios::out | std::ios::binary);
@@ -93,6 +107,12 @@ Fun4AllHepMCOutputManager::~Fun4AllHepMCOutputManager()
 
   delete ascii_out;
 
+  if (binary_out)
+  {
+    binary_out->Close();
+    delete binary_out;
+  }
+
   if (zoutbuffer.size() > 0) zoutbuffer.reset();
 
   if (zipstream) delete zipstream;
@@ -114,9 +134,18 @@ void Fun4AllHepMCOutputManager::Print(const string &what) const
   return;
 }
 
+void Fun4AllHepMCOutputManager::set_write_queue(const unsigned int depth)
+{
+  if (binary_out)
+  {
+    binary_out->set_write_queue(depth);
+  }
+  return;
+}
+
 int Fun4AllHepMCOutputManager::Write(PHCompositeNode *topNode)
 {
-  if (!comment_written)
+  if (ascii_out && !comment_written)
   {
     if (comment.size())
     {
@@ -151,6 +180,15 @@ int Fun4AllHepMCOutputManager::Write(PHCompositeNode *topNode)
   assert(evt);
 
   IncrementEvents(1);
+  if (binary_out)
+  {
+    if (binary_out->Write(evt))
+    {
+      cout << PHWHERE << " could not write to " << outfilename << endl;
+      return Fun4AllReturnCodes::ABORTRUN;
+    }
+    return Fun4AllReturnCodes::EVENT_OK;
+  }
   ascii_out->write_event(evt);
   return Fun4AllReturnCodes::EVENT_OK;
 }
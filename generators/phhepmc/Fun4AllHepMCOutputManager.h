@@ -12,7 +12,17 @@ namespace HepMC
 }
 
 class PHCompositeNode;
+class PHHepMCBinaryStore;
 
+/*!
+ * \brief writes the HepMC event of one embedding id per event
+ *
+ * The format follows the file name: ascii HepMC2 (compressed for .gz and
+ * .bz2) or, for .hepmcb, the indexed binary format of PHHepMCBinaryStore
+ * which the HepMC input managers read back. Binary events are compressed in
+ * a background thread, the event index is written when the manager is
+ * deleted. Comments are not stored in binary files.
+ */
 class Fun4AllHepMCOutputManager : public Fun4AllOutputManager
 {
  public:
@@ -41,9 +51,13 @@ class Fun4AllHepMCOutputManager : public Fun4AllOutputManager
   //! Usually, ID = 0 means the primary Au+Au collision background
   void set_embedding_id(int id) { _embedding_id = id; }
 
+  //! binary output: at most depth events wait for the compression thread (0: compress in Write())
+  void set_write_queue(const unsigned int depth);
+
  protected:
   std::string outfilename;
   HepMC::IO_GenEvent *ascii_out;
+  PHHepMCBinaryStore *binary_out;
   std::string comment;
   int comment_written;
 
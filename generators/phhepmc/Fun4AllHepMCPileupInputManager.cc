@@ -36,6 +36,7 @@ Fun4AllHepMCPileupInputManager::Fun4AllHepMCPileupInputManager(
   _max_crossing(0)
   ,  // recalculated
   _first_run(true)
+  , _event_pool_size(0)
 {
   //! repeatedly read the input file
   Repeat(1);
@@ -58,6 +59,44 @@ Fun4AllHepMCPileupInputManager::Fun4AllHepMCPileupInputManager(
 Fun4AllHepMCPileupInputManager::~Fun4AllHepMCPileupInputManager()
 {
   gsl_rng_free(RandomGenerator);
+  for (unsigned int i = 0; i < _event_pool.size(); ++i)
+  {
+    delete _event_pool[i];
+  }
+}
+
+unsigned int Fun4AllHepMCPileupInputManager::FillEventPool()
+{
+  while (_event_pool.size() < _event_pool_size)
+  {
+    if (!IsOpen())
+    {
+      if (FileListEmpty() || OpenNextFile())
+      {
+        break;
+      }
+    }
+    HepMC::GenEvent *poolevt = ReadNextEvent();
+    if (!poolevt)
+    {
+      // a file without events ends the pool, the file list repeats forever
+      const bool emptyfile = (events_thisfile == 0);
+      fileclose();
+      if (emptyfile)
+      {
+        break;
+      }
+      continue;
+    }
+    _event_pool.push_back(poolevt);
+    evt = nullptr;  // owned by the pool, ConvertFromOscar() would delete it
+    events_thisfile++;
+  }
+  if (Verbosity() > 0)
+  {
+    cout << Name() << ": " << _event_pool.size() << " events in the pile up event pool" << endl;
+  }
+  return _event_pool.size();
 }
 
 int Fun4AllHepMCPileupInputManager::run(const int nevents)
@@ -78,6 +117,12 @@ int Fun4AllHepMCPileupInputManager::run(const int nevents)
       cout << " _max_crossing = " << _max_crossing;
       cout << ". Start first event." << endl;
     }
+
+    if (_event_pool_size > 0 && FillEventPool() == 0)
+    {
+      cout << Name() << ": could not read any event for the pile up event pool" << endl;
+      return -1;
+    }
   }
 
   // toss multiple crossings all the way back
@@ -93,8 +138,16 @@ int Fun4AllHepMCPileupInputManager::run(const int nevents)
     {
       double t0 = crossing_time;
 
+      HepMC::GenEvent *poolevt = nullptr;
+      if (!_event_pool.empty())
+      {
+        // sample with replacement, the event is shared with the pool and not read again
+        poolevt = _event_pool[gsl_rng_uniform_int(RandomGenerator, _event_pool.size())];
+        events_total++;
+      }
+
       // loop until retrieve a valid event
-      while (true)
+      while (!poolevt)
       {
         if (!IsOpen())
         {
@@ -124,22 +177,14 @@ int Fun4AllHepMCPileupInputManager::run(const int nevents)
         }
         else
         {
-          if (readoscar)
-          {
-            evt = ConvertFromOscar();
-          }
-          else
-          {
-            evt = ascii_in->read_next_event();
-          }
+          evt = ReadNextEvent();
         }
 
         if (!evt)
         {
           if (Verbosity() > 1)
           {
-            cout << "error type: " << ascii_in->error_type()
-                 << ", rdstate: " << ascii_in->rdstate() << endl;
+            PrintReadError();
           }
           fileclose();
         }
@@ -180,8 +225,15 @@ int Fun4AllHepMCPileupInputManager::run(const int nevents)
         genevent = geneventmap->insert_background_event();
       }
       assert(genevent);
-      assert(evt);
-      genevent->addEvent(evt);
+      if (poolevt)
+      {
+        genevent->addSharedEvent(poolevt);
+      }
+      else
+      {
+        assert(evt);
+        genevent->addEvent(evt);
+      }
       hepmc_helper.move_vertex(genevent);
       // place to the crossing center in time
       genevent->moveVertex(0, 0, 0, t0);
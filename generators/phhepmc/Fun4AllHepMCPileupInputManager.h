@@ -4,6 +4,7 @@
 #include "Fun4AllHepMCInputManager.h"
 
 #include <string>
+#include <vector>
 
 #if !defined(__CINT__) || defined(__CLING__)
 #include <gsl/gsl_rng.h>
@@ -34,7 +35,15 @@ class Fun4AllHepMCPileupInputManager : public Fun4AllHepMCInputManager
   /// time between bunch crossing in ns
   void set_time_between_crossings(double nsec) { _time_between_crossings = nsec; }
 
+  /// preload this many events and sample the pile up collisions from them with replacement,
+  /// 0 (default) reads every collision from the input. The pool events are shared between
+  /// collisions, do not run modules which modify the HepMC record (HepMCFlowAfterBurner) on them
+  void set_event_pool_size(unsigned int n) { _event_pool_size = n; }
+
  private:
+  //! read the events of the pool, returns the number of events read
+  unsigned int FillEventPool();
+
   /// past times are negative, future times are positive
   double _min_integration_time;
   double _max_integration_time;
@@ -50,6 +59,9 @@ class Fun4AllHepMCPileupInputManager : public Fun4AllHepMCInputManager
 
   bool _first_run;
 
+  unsigned int _event_pool_size;
+  std::vector<HepMC::GenEvent *> _event_pool;
+
 #if !defined(__CINT__) || defined(__CLING__)
   gsl_rng *RandomGenerator;
 #endif
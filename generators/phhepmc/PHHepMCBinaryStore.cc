@@ -0,0 +1,707 @@
+#include "PHHepMCBinaryStore.h"
+
+#include <HepMC/Flow.h>
+#include <HepMC/GenEvent.h>
+#include <HepMC/GenParticle.h>
+#include <HepMC/GenVertex.h>
+#include <HepMC/HeavyIon.h>
+#include <HepMC/IO_GenEvent.h>
+#include <HepMC/PdfInfo.h>
+#include <HepMC/Polarization.h>
+#include <HepMC/SimpleVector.h>
+#include <HepMC/Units.h>
+
+#include <boost/iostreams/device/array.hpp>
+#include <boost/iostreams/device/back_inserter.hpp>
+#include <boost/iostreams/filter/bzip2.hpp>
+#include <boost/iostreams/filter/gzip.hpp>
+#include <boost/iostreams/filter/zlib.hpp>
+#include <boost/iostreams/filtering_stream.hpp>
+#include <boost/iostreams/filtering_streambuf.hpp>
+
+#include <atomic>
+#include <cstring>  // for memcpy
+#include <iostream>
+#include <mutex>
+#include <thread>
+#include <utility>  // for pair
+
+using namespace std;
+
+namespace
+{
+  const char kMagic[8] = {'P', 'H', 'H', 'E', 'P', 'M', 'C', 'B'};
+  const char kIndexMagic[8] = {'P', 'H', 'H', 'M', 'C', 'I', 'D', 'X'};
+  const unsigned int kVersion = 1;
+
+  template <class T>
+  void put(string &buffer, const T &value)
+  {
+    buffer.append(reinterpret_cast<const char *>(&value), sizeof(T));
+  }
+
+  //! reads values from a decompressed block, ok is false after reading past the end
+  class BlockReader
+  {
+   public:
+    explicit BlockReader(const string &block)
+      : m_Pos(block.data())
+      , m_End(block.data() + block.size())
+      , ok(true)
+    {
+    }
+
+    template <class T>
+    T get()
+    {
+      T value = T();
+      if (m_Pos + sizeof(T) > m_End)
+      {
+        ok = false;
+        return value;
+      }
+      memcpy(&value, m_Pos, sizeof(T));
+      m_Pos += sizeof(T);
+      return value;
+    }
+
+   private:
+    const char *m_Pos;
+    const char *m_End;
+
+   public:
+    bool ok;
+  };
+}  // namespace
+
+PHHepMCBinaryStore::PHHepMCBinaryStore()
+  : m_Writing(false)
+  , m_Next(0)
+  , m_NThreads(1)
+  , m_WriteQueueDepth(0)
+  , m_WriteFailed(false)
+  , m_StopCompressor(false)
+{
+}
+
+PHHepMCBinaryStore::~PHHepMCBinaryStore()
+{
+  Close();
+}
+
+bool PHHepMCBinaryStore::IsBinaryFile(const string &filename)
+{
+  const string extension = ".hepmcb";
+  return filename.size() > extension.size() &&
+         filename.compare(filename.size() - extension.size(), extension.size(), extension) == 0;
+}
+
+int PHHepMCBinaryStore::ConvertAscii(const string &asciifile, const string &binaryfile)
+{
+  ifstream filestream(asciifile.c_str(), ios::in | ios::binary);
+  if (!filestream.is_open())
+  {
+    cout << "PHHepMCBinaryStore::ConvertAscii - could not open " << asciifile << endl;
+    return -1;
+  }
+  boost::iostreams::filtering_streambuf<boost::iostreams::input> zinbuffer;
+  if (asciifile.size() > 4 && asciifile.compare(asciifile.size() - 4, 4, ".bz2") == 0)
+  {
+    zinbuffer.push(boost::iostreams::bzip2_decompressor());
+  }
+  else if (asciifile.size() > 3 && asciifile.compare(asciifile.size() - 3, 3, ".gz") == 0)
+  {
+    zinbuffer.push(boost::iostreams::gzip_decompressor());
+  }
+  zinbuffer.push(filestream);
+  istream unzipstream(&zinbuffer);
+  HepMC::IO_GenEvent ascii_in(unzipstream);
+
+  PHHepMCBinaryStore store;
+  if (store.OpenWrite(binaryfile))
+  {
+    return -1;
+  }
+  int nevents = 0;
+  while (HepMC::GenEvent *evt = ascii_in.read_next_event())
+  {
+    store.Write(evt);
+    delete evt;
+    ++nevents;
+  }
+  store.Close();
+  cout << "PHHepMCBinaryStore::ConvertAscii - wrote " << nevents << " events from "
+       << asciifile << " to " << binaryfile << endl;
+  return nevents;
+}
+
+int PHHepMCBinaryStore::OpenWrite(const string &filename)
+{
+  Close();
+  m_File.open(filename.c_str(), ios::out | ios::binary | ios::trunc);
+  if (!m_File.is_open())
+  {
+    cout << "PHHepMCBinaryStore::OpenWrite - could not open " << filename << endl;
+    return -1;
+  }
+  m_Writing = true;
+  m_WriteFailed = false;
+  m_File.write(kMagic, sizeof(kMagic));
+  m_File.write(reinterpret_cast<const char *>(&kVersion), sizeof(kVersion));
+  return 0;
+}
+
+int PHHepMCBinaryStore::Write(const HepMC::GenEvent *evt)
+{
+  if (!m_Writing)
+  {
+    cout << "PHHepMCBinaryStore::Write - no file open for writing" << endl;
+    return -1;
+  }
+  // the event belongs to the caller, only its record can be handed to the compressor
+  string raw;
+  EncodeRecord(evt, raw);
+  if (m_WriteQueueDepth == 0)
+  {
+    return WriteRecord(raw) ? 0 : -1;
+  }
+  if (!m_Compressor.joinable())
+  {
+    m_StopCompressor = false;
+    m_Compressor = thread(&PHHepMCBinaryStore::CompressorLoop, this);
+  }
+  unique_lock<mutex> lock(m_WriteMutex);
+  m_WriteCondition.wait(lock, [this] { return m_WriteQueue.size() < m_WriteQueueDepth; });
+  if (m_WriteFailed)
+  {
+    return -1;
+  }
+  m_WriteQueue.push_back(string());
+  m_WriteQueue.back().swap(raw);
+  lock.unlock();
+  m_WriteCondition.notify_all();
+  return 0;
+}
+
+bool PHHepMCBinaryStore::WriteRecord(const string &raw)
+{
+  string compressed;
+  {
+    boost::iostreams::filtering_ostream zout;
+    zout.push(boost::iostreams::zlib_compressor());
+    zout.push(boost::iostreams::back_inserter(compressed));
+    zout.write(raw.data(), raw.size());
+  }  // flushed when zout goes out of scope
+  m_Offsets.push_back(m_File.tellp());
+  const unsigned int sizes[2] = {static_cast<unsigned int>(compressed.size()), static_cast<unsigned int>(raw.size())};
+  m_File.write(reinterpret_cast<const char *>(sizes), sizeof(sizes));
+  m_File.write(compressed.data(), compressed.size());
+  return m_File.good();
+}
+
+void PHHepMCBinaryStore::CompressorLoop()
+{
+  while (true)
+  {
+    const string *raw = nullptr;
+    {
+      unique_lock<mutex> lock(m_WriteMutex);
+      m_WriteCondition.wait(lock, [this] { return !m_WriteQueue.empty() || m_StopCompressor; });
+      if (m_WriteQueue.empty())
+      {
+        return;
+      }
+      // push_back does not move the front record
+      raw = &m_WriteQueue.front();
+    }
+    const bool written = WriteRecord(*raw);
+    {
+      lock_guard<mutex> lock(m_WriteMutex);
+      if (!written)
+      {
+        m_WriteFailed = true;
+      }
+      m_WriteQueue.pop_front();
+    }
+    m_WriteCondition.notify_all();
+  }
+}
+
+void PHHepMCBinaryStore::StopCompressor()
+{
+  if (!m_Compressor.joinable())
+  {
+    return;
+  }
+  {
+    lock_guard<mutex> lock(m_WriteMutex);
+    m_StopCompressor = true;
+  }
+  m_WriteCondition.notify_all();
+  m_Compressor.join();
+}
+
+int PHHepMCBinaryStore::OpenRead(const string &filename)
+{
+  Close();
+  m_File.open(filename.c_str(), ios::in | ios::binary);
+  if (!m_File.is_open())
+  {
+    cout << "PHHepMCBinaryStore::OpenRead - could not open " << filename << endl;
+    return -1;
+  }
+  char magic[sizeof(kMagic)];
+  unsigned int version = 0;
+  m_File.read(magic, sizeof(magic));
+  m_File.read(reinterpret_cast<char *>(&version), sizeof(version));
+  if (!m_File.good() || memcmp(magic, kMagic, sizeof(kMagic)) || version != kVersion)
+  {
+    cout << "PHHepMCBinaryStore::OpenRead - " << filename << " is not a binary HepMC file of version " << kVersion << endl;
+    m_File.close();
+    return -1;
+  }
+
+  // trailer: index offset and index magic
+  unsigned long long indexoffset = 0;
+  char indexmagic[sizeof(kIndexMagic)];
+  m_File.seekg(-static_cast<long long>(sizeof(indexoffset) + sizeof(indexmagic)), ios::end);
+  m_File.read(reinterpret_cast<char *>(&indexoffset), sizeof(indexoffset));
+  m_File.read(indexmagic, sizeof(indexmagic));
+  if (!m_File.good() || memcmp(indexmagic, kIndexMagic, sizeof(kIndexMagic)))
+  {
+    cout << "PHHepMCBinaryStore::OpenRead - " << filename << " has no event index, was it closed properly?" << endl;
+    m_File.close();
+    return -1;
+  }
+  unsigned long long nevents = 0;
+  m_File.seekg(indexoffset);
+  m_File.read(reinterpret_cast<char *>(&nevents), sizeof(nevents));
+  m_Offsets.resize(nevents);
+  if (nevents > 0)
+  {
+    m_File.read(reinterpret_cast<char *>(&m_Offsets[0]), nevents * sizeof(unsigned long long));
+  }
+  if (!m_File.good())
+  {
+    cout << "PHHepMCBinaryStore::OpenRead - could not read the event index of " << filename << endl;
+    m_Offsets.clear();
+    m_File.close();
+    return -1;
+  }
+  m_Next = 0;
+  return 0;
+}
+
+bool PHHepMCBinaryStore::ReadBlock(const unsigned int ievent, string &block)
+{
+  block.clear();
+  if (m_Writing || ievent >= m_Offsets.size())
+  {
+    return false;
+  }
+  unsigned int sizes[2] = {0, 0};
+  m_File.clear();
+  m_File.seekg(m_Offsets[ievent]);
+  m_File.read(reinterpret_cast<char *>(sizes), sizeof(sizes));
+  // the raw size travels in front of the compressed data for Decode
+  block.resize(sizeof(sizes[1]) + sizes[0]);
+  memcpy(&block[0], &sizes[1], sizeof(sizes[1]));
+  m_File.read(&block[sizeof(sizes[1])], sizes[0]);
+  if (!m_File.good())
+  {
+    cout << "PHHepMCBinaryStore::ReadBlock - could not read event " << ievent << endl;
+    block.clear();
+    return false;
+  }
+  return true;
+}
+
+HepMC::GenEvent *PHHepMCBinaryStore::ReadEvent(const unsigned int ievent)
+{
+  string block;
+  if (!ReadBlock(ievent, block))
+  {
+    return nullptr;
+  }
+  return Decode(block);
+}
+
+HepMC::GenEvent *PHHepMCBinaryStore::ReadNextEvent()
+{
+  if (m_ReadAhead.empty())
+  {
+    FillReadAhead();
+  }
+  if (m_ReadAhead.empty())
+  {
+    return nullptr;
+  }
+  HepMC::GenEvent *evt = m_ReadAhead.front();
+  m_ReadAhead.pop_front();
+  return evt;
+}
+
+void PHHepMCBinaryStore::FillReadAhead()
+{
+  // the file is read sequentially, the decompression and event building runs in parallel
+  vector<string> blocks;
+  const unsigned int nblocks = (m_NThreads > 1 ? 4 * m_NThreads : 1);
+  while (blocks.size() < nblocks && m_Next < m_Offsets.size())
+  {
+    blocks.push_back(string());
+    if (!ReadBlock(m_Next, blocks.back()))
+    {
+      blocks.pop_back();
+      m_Next = m_Offsets.size();
+      break;
+    }
+    ++m_Next;
+  }
+  vector<HepMC::GenEvent *> events(blocks.size(), nullptr);
+  if (m_NThreads > 1 && blocks.size() > 1)
+  {
+    atomic<unsigned int> nextblock(0);
+    vector<thread> threads;
+    for (unsigned int i = 0; i < m_NThreads; ++i)
+    {
+      threads.push_back(thread([&]() {
+        for (unsigned int iblock = nextblock++; iblock < blocks.size(); iblock = nextblock++)
+        {
+          events[iblock] = Decode(blocks[iblock]);
+        }
+      }));
+    }
+    for (unsigned int i = 0; i < threads.size(); ++i)
+    {
+      threads[i].join();
+    }
+  }
+  else
+  {
+    for (unsigned int iblock = 0; iblock < blocks.size(); ++iblock)
+    {
+      events[iblock] = Decode(blocks[iblock]);
+    }
+  }
+  for (unsigned int iblock = 0; iblock < events.size(); ++iblock)
+  {
+    if (events[iblock])
+    {
+      m_ReadAhead.push_back(events[iblock]);
+    }
+  }
+}
+
+unsigned int PHHepMCBinaryStore::Skip(const unsigned int n)
+{
+  unsigned int nskipped = 0;
+  while (nskipped < n && !m_ReadAhead.empty())
+  {
+    delete m_ReadAhead.front();
+    m_ReadAhead.pop_front();
+    ++nskipped;
+  }
+  const unsigned int nleft = m_Offsets.size() - m_Next;
+  const unsigned int nblocks = (n - nskipped < nleft ? n - nskipped : nleft);
+  m_Next += nblocks;
+  return nskipped + nblocks;
+}
+
+int PHHepMCBinaryStore::Close()
+{
+  while (!m_ReadAhead.empty())
+  {
+    delete m_ReadAhead.front();
+    m_ReadAhead.pop_front();
+  }
+  if (!m_File.is_open())
+  {
+    return 0;
+  }
+  int iret = 0;
+  if (m_Writing)
+  {
+    // the index needs the offsets of all queued events
+    StopCompressor();
+    if (m_WriteFailed)
+    {
+      cout << "PHHepMCBinaryStore::Close - events could not be written" << endl;
+      iret = -1;
+    }
+    const unsigned long long indexoffset = m_File.tellp();
+    const unsigned long long nevents = m_Offsets.size();
+    m_File.write(reinterpret_cast<const char *>(&nevents), sizeof(nevents));
+    if (nevents > 0)
+    {
+      m_File.write(reinterpret_cast<const char *>(&m_Offsets[0]), nevents * sizeof(unsigned long long));
+    }
+    m_File.write(reinterpret_cast<const char *>(&indexoffset), sizeof(indexoffset));
+    m_File.write(kIndexMagic, sizeof(kIndexMagic));
+    if (!m_File.good())
+    {
+      cout << "PHHepMCBinaryStore::Close - could not write the event index" << endl;
+      iret = -1;
+    }
+  }
+  m_File.close();
+  m_Writing = false;
+  m_Offsets.clear();
+  m_Next = 0;
+  return iret;
+}
+
+void PHHepMCBinaryStore::EncodeRecord(const HepMC::GenEvent *evt, string &buffer)
+{
+  buffer.clear();
+  put<int>(buffer, evt->event_number());
+  put<int>(buffer, evt->signal_process_id());
+  put<int>(buffer, evt->mpi());
+  put<double>(buffer, evt->event_scale());
+  put<double>(buffer, evt->alphaQCD());
+  put<double>(buffer, evt->alphaQED());
+  put<int>(buffer, evt->momentum_unit());
+  put<int>(buffer, evt->length_unit());
+  put<int>(buffer, evt->signal_process_vertex() ? evt->signal_process_vertex()->barcode() : 0);
+  pair<HepMC::GenParticle *, HepMC::GenParticle *> beams = evt->beam_particles();
+  put<int>(buffer, beams.first ? beams.first->barcode() : 0);
+  put<int>(buffer, beams.second ? beams.second->barcode() : 0);
+
+  const HepMC::WeightContainer &weights = evt->weights();
+  put<unsigned int>(buffer, weights.size());
+  for (unsigned int i = 0; i < weights.size(); ++i)
+  {
+    put<double>(buffer, weights[i]);
+  }
+  const vector<long> &random_states = evt->random_states();
+  put<unsigned int>(buffer, random_states.size());
+  for (unsigned int i = 0; i < random_states.size(); ++i)
+  {
+    put<long long>(buffer, random_states[i]);
+  }
+
+  const HepMC::HeavyIon *hi = evt->heavy_ion();
+  put<char>(buffer, hi ? 1 : 0);
+  if (hi)
+  {
+    put<int>(buffer, hi->Ncoll_hard());
+    put<int>(buffer, hi->Npart_proj());
+    put<int>(buffer, hi->Npart_targ());
+    put<int>(buffer, hi->Ncoll());
+    put<int>(buffer, hi->spectator_neutrons());
+    put<int>(buffer, hi->spectator_protons());
+    put<int>(buffer, hi->N_Nwounded_collisions());
+    put<int>(buffer, hi->Nwounded_N_collisions());
+    put<int>(buffer, hi->Nwounded_Nwounded_collisions());
+    put<float>(buffer, hi->impact_parameter());
+    put<float>(buffer, hi->event_plane_angle());
+    put<float>(buffer, hi->eccentricity());
+    put<float>(buffer, hi->sigma_inel_NN());
+  }
+
+  const HepMC::PdfInfo *pdf = evt->pdf_info();
+  put<char>(buffer, pdf ? 1 : 0);
+  if (pdf)
+  {
+    put<int>(buffer, pdf->id1());
+    put<int>(buffer, pdf->id2());
+    put<int>(buffer, pdf->pdf_id1());
+    put<int>(buffer, pdf->pdf_id2());
+    put<double>(buffer, pdf->x1());
+    put<double>(buffer, pdf->x2());
+    put<double>(buffer, pdf->scalePDF());
+    put<double>(buffer, pdf->pdf1());
+    put<double>(buffer, pdf->pdf2());
+  }
+
+  put<unsigned int>(buffer, evt->vertices_size());
+  for (HepMC::GenEvent::vertex_const_iterator v = evt->vertices_begin(); v != evt->vertices_end(); ++v)
+  {
+    put<int>(buffer, (*v)->barcode());
+    put<int>(buffer, (*v)->id());
+    put<double>(buffer, (*v)->position().x());
+    put<double>(buffer, (*v)->position().y());
+    put<double>(buffer, (*v)->position().z());
+    put<double>(buffer, (*v)->position().t());
+  }
+
+  put<unsigned int>(buffer, evt->particles_size());
+  for (HepMC::GenEvent::particle_const_iterator p = evt->particles_begin(); p != evt->particles_end(); ++p)
+  {
+    put<int>(buffer, (*p)->barcode());
+    put<int>(buffer, (*p)->pdg_id());
+    put<int>(buffer, (*p)->status());
+    put<double>(buffer, (*p)->momentum().px());
+    put<double>(buffer, (*p)->momentum().py());
+    put<double>(buffer, (*p)->momentum().pz());
+    put<double>(buffer, (*p)->momentum().e());
+    put<double>(buffer, (*p)->generated_mass());
+    put<double>(buffer, (*p)->polarization().theta());
+    put<double>(buffer, (*p)->polarization().phi());
+    put<int>(buffer, (*p)->production_vertex() ? (*p)->production_vertex()->barcode() : 0);
+    put<int>(buffer, (*p)->end_vertex() ? (*p)->end_vertex()->barcode() : 0);
+  }
+}
+
+HepMC::GenEvent *PHHepMCBinaryStore::Decode(const string &block)
+{
+  // raw size, then the zlib compressed event
+  unsigned int rawsize = 0;
+  if (block.size() < sizeof(rawsize))
+  {
+    return nullptr;
+  }
+  memcpy(&rawsize, block.data(), sizeof(rawsize));
+  string raw(rawsize, '\0');
+  {
+    boost::iostreams::filtering_istream zin;
+    zin.push(boost::iostreams::zlib_decompressor());
+    zin.push(boost::iostreams::array_source(block.data() + sizeof(rawsize), block.size() - sizeof(rawsize)));
+    zin.read(&raw[0], rawsize);
+    if (zin.gcount() != static_cast<streamsize>(rawsize))
+    {
+      cout << "PHHepMCBinaryStore::Decode - corrupt event block" << endl;
+      return nullptr;
+    }
+  }
+  return DecodeRecord(raw);
+}
+
+HepMC::GenEvent *PHHepMCBinaryStore::DecodeRecord(const string &raw)
+{
+  BlockReader in(raw);
+  const int event_number = in.get<int>();
+  const int signal_process_id = in.get<int>();
+  const int mpi = in.get<int>();
+  const double event_scale = in.get<double>();
+  const double alphaQCD = in.get<double>();
+  const double alphaQED = in.get<double>();
+  const int momentum_unit = in.get<int>();
+  const int length_unit = in.get<int>();
+  const int signal_vertex = in.get<int>();
+  const int beam1 = in.get<int>();
+  const int beam2 = in.get<int>();
+
+  HepMC::GenEvent *evt = new HepMC::GenEvent(static_cast<HepMC::Units::MomentumUnit>(momentum_unit),
+                                             static_cast<HepMC::Units::LengthUnit>(length_unit));
+  evt->set_event_number(event_number);
+  evt->set_signal_process_id(signal_process_id);
+  evt->set_mpi(mpi);
+  evt->set_event_scale(event_scale);
+  evt->set_alphaQCD(alphaQCD);
+  evt->set_alphaQED(alphaQED);
+
+  const unsigned int nweights = in.get<unsigned int>();
+  for (unsigned int i = 0; i < nweights && in.ok; ++i)
+  {
+    evt->weights().push_back(in.get<double>());
+  }
+  const unsigned int nrandom = in.get<unsigned int>();
+  vector<long> random_states;
+  for (unsigned int i = 0; i < nrandom && in.ok; ++i)
+  {
+    random_states.push_back(in.get<long long>());
+  }
+  evt->set_random_states(random_states);
+
+  if (in.get<char>())
+  {
+    const int Ncoll_hard = in.get<int>();
+    const int Npart_proj = in.get<int>();
+    const int Npart_targ = in.get<int>();
+    const int Ncoll = in.get<int>();
+    const int spectator_neutrons = in.get<int>();
+    const int spectator_protons = in.get<int>();
+    const int N_Nwounded_collisions = in.get<int>();
+    const int Nwounded_N_collisions = in.get<int>();
+    const int Nwounded_Nwounded_collisions = in.get<int>();
+    const float impact_parameter = in.get<float>();
+    const float event_plane_angle = in.get<float>();
+    const float eccentricity = in.get<float>();
+    const float sigma_inel_NN = in.get<float>();
+    evt->set_heavy_ion(HepMC::HeavyIon(Ncoll_hard, Npart_proj, Npart_targ, Ncoll,
+                                       spectator_neutrons, spectator_protons,
+                                       N_Nwounded_collisions, Nwounded_N_collisions, Nwounded_Nwounded_collisions,
+                                       impact_parameter, event_plane_angle, eccentricity, sigma_inel_NN));
+  }
+
+  if (in.get<char>())
+  {
+    const int id1 = in.get<int>();
+    const int id2 = in.get<int>();
+    const int pdf_id1 = in.get<int>();
+    const int pdf_id2 = in.get<int>();
+    const double x1 = in.get<double>();
+    const double x2 = in.get<double>();
+    const double scalePDF = in.get<double>();
+    const double pdf1 = in.get<double>();
+    const double pdf2 = in.get<double>();
+    evt->set_pdf_info(HepMC::PdfInfo(id1, id2, x1, x2, scalePDF, pdf1, pdf2, pdf_id1, pdf_id2));
+  }
+
+  const unsigned int nvertices = in.get<unsigned int>();
+  for (unsigned int i = 0; i < nvertices && in.ok; ++i)
+  {
+    const int barcode = in.get<int>();
+    const int id = in.get<int>();
+    const double x = in.get<double>();
+    const double y = in.get<double>();
+    const double z = in.get<double>();
+    const double t = in.get<double>();
+    HepMC::GenVertex *v = new HepMC::GenVertex(HepMC::FourVector(x, y, z, t), id);
+    v->suggest_barcode(barcode);
+    evt->add_vertex(v);
+  }
+
+  const unsigned int nparticles = in.get<unsigned int>();
+  for (unsigned int i = 0; i < nparticles && in.ok; ++i)
+  {
+    const int barcode = in.get<int>();
+    const int pdg_id = in.get<int>();
+    const int status = in.get<int>();
+    const double px = in.get<double>();
+    const double py = in.get<double>();
+    const double pz = in.get<double>();
+    const double e = in.get<double>();
+    const double mass = in.get<double>();
+    const double theta = in.get<double>();
+    const double phi = in.get<double>();
+    const int production_vertex = in.get<int>();
+    const int end_vertex = in.get<int>();
+    HepMC::GenVertex *prod = (production_vertex ? evt->barcode_to_vertex(production_vertex) : nullptr);
+    HepMC::GenVertex *end = (end_vertex ? evt->barcode_to_vertex(end_vertex) : nullptr);
+    if (!prod && !end)
+    {
+      // a particle without vertices cannot be attached to the event
+      continue;
+    }
+    HepMC::GenParticle *p = new HepMC::GenParticle(HepMC::FourVector(px, py, pz, e), pdg_id, status,
+                                                   HepMC::Flow(), HepMC::Polarization(theta, phi));
+    p->setGeneratedMass(mass);
+    p->suggest_barcode(barcode);
+    if (prod)
+    {
+      prod->add_particle_out(p);
+    }
+    if (end)
+    {
+      end->add_particle_in(p);
+    }
+  }
+
+  if (!in.ok)
+  {
+    cout << "PHHepMCBinaryStore::DecodeRecord - truncated event " << event_number << endl;
+    delete evt;
+    return nullptr;
+  }
+
+  if (signal_vertex)
+  {
+    evt->set_signal_process_vertex(evt->barcode_to_vertex(signal_vertex));
+  }
+  if (beam1 && beam2)
+  {
+    evt->set_beam_particles(evt->barcode_to_particle(beam1), evt->barcode_to_particle(beam2));
+  }
+  return evt;
+}
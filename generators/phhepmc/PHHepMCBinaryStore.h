@@ -0,0 +1,128 @@
+#ifndef PHHEPMC_PHHEPMCBINARYSTORE_H
+#define PHHEPMC_PHHEPMCBINARYSTORE_H
+
+#include <deque>
+#include <fstream>
+#include <string>
+#include <vector>
+
+#if !defined(__CINT__) || defined(__CLING__)
+#include <condition_variable>
+#include <mutex>
+#include <thread>
+#endif
+
+namespace HepMC
+{
+  class GenEvent;
+}
+
+/*!
+ * \brief binary HepMC event file with an event index
+ *
+ * Every event is a separately zlib compressed block, an index of the block
+ * offsets is written at the end of the file. Events can be read in order or
+ * by event number, skipping does not decode anything and read ahead decodes
+ * several blocks in parallel.
+ *
+ * The block stores the event header (numbers, scales, weights, random states,
+ * units, heavy ion and pdf info), the vertices and the particles with their
+ * production and end vertices. Vertex weights and particle flow are not kept.
+ * Files from ConvertAscii() carry the extension .hepmcb, which is how the
+ * HepMC input managers recognize them.
+ *
+ * When writing, the compression can run in a background thread, Write() then
+ * only encodes the event and queues the record.
+ */
+class PHHepMCBinaryStore
+{
+ public:
+  PHHepMCBinaryStore();
+  virtual ~PHHepMCBinaryStore();
+
+  //! convert an ascii HepMC2 file (.gz and .bz2 as well), returns the number of events, -1 on error
+  static int ConvertAscii(const std::string &asciifile, const std::string &binaryfile);
+
+  //! true if the file name has the extension of a binary store
+  static bool IsBinaryFile(const std::string &filename);
+
+  // --- writing ---------------------------------------------------------------
+
+  int OpenWrite(const std::string &filename);
+  //! -1 if the event or an earlier queued one could not be written
+  int Write(const HepMC::GenEvent *evt);
+
+  //! compress and write in a background thread, at most depth events are queued (0: in Write())
+  void set_write_queue(const unsigned int depth) { m_WriteQueueDepth = depth; }
+
+  // --- reading ---------------------------------------------------------------
+
+  int OpenRead(const std::string &filename);
+
+  //! number of events in the file
+  unsigned int size() const { return m_Offsets.size(); }
+
+  //! event by its position in the file, nullptr if there is no such event.
+  //! The caller owns the event
+  HepMC::GenEvent *ReadEvent(const unsigned int ievent);
+
+  //! next event in the file, nullptr at the end. The caller owns the event
+  HepMC::GenEvent *ReadNextEvent();
+
+  //! move the read position by n events without decoding them, returns the number skipped
+  unsigned int Skip(const unsigned int n);
+
+  //! decode this many events in parallel when reading in order, 1 decodes one at a time
+  void set_nthreads(const unsigned int nthreads) { m_NThreads = (nthreads > 0 ? nthreads : 1); }
+
+  //! waits for the queued events, writes the index when writing, then closes the file
+  int Close();
+
+  // --- event records ---------------------------------------------------------
+
+  //! uncompressed record of one event as stored in a block, also used to ship events between processes
+  static void EncodeRecord(const HepMC::GenEvent *evt, std::string &buffer);
+
+  //! event from an uncompressed record, nullptr if it is truncated. The caller owns the event
+  static HepMC::GenEvent *DecodeRecord(const std::string &buffer);
+
+ private:
+  //! compressed block of one event, empty on error
+  bool ReadBlock(const unsigned int ievent, std::string &block);
+  //! decode the events of the next read ahead batch
+  void FillReadAhead();
+  //! compress an uncompressed record and append it to the file
+  bool WriteRecord(const std::string &raw);
+#if !defined(__CINT__) || defined(__CLING__)
+  void CompressorLoop();
+  void StopCompressor();
+#endif
+
+  //! event from a compressed block
+  static HepMC::GenEvent *Decode(const std::string &block);
+
+  std::fstream m_File;
+  bool m_Writing;
+
+  //! file offset of every event block
+  std::vector<unsigned long long> m_Offsets;
+
+  //! next event to be read
+  unsigned int m_Next;
+
+  unsigned int m_NThreads;
+  std::deque<HepMC::GenEvent *> m_ReadAhead;
+
+  unsigned int m_WriteQueueDepth;
+  bool m_WriteFailed;
+#if !defined(__CINT__) || defined(__CLING__)
+  //! records waiting for the compressor thread (front is being compressed)
+  std::deque<std::string> m_WriteQueue;
+  std::mutex m_WriteMutex;
+  std::condition_variable m_WriteCondition;
+  std::thread m_Compressor;
+  bool m_StopCompressor;
+#endif
+};
+
+#endif /* PHHEPMC_PHHEPMCBINARYSTORE_H */
@@ -12,7 +12,9 @@ PHHepMCGenEvent::PHHepMCGenEvent()
   : _embedding_id(0)
   , _isSimulated(false)
   , _collisionVertex(0, 0, 0, 0)
+  , _boostBetaVector(0, 0, 0)
   , _theEvt(nullptr)
+  , _ownsEvt(true)
 {
 }
 
@@ -20,7 +22,9 @@ PHHepMCGenEvent::PHHepMCGenEvent(const PHHepMCGenEvent& event)
   : _embedding_id(event.get_embedding_id())
   , _isSimulated(event.is_simulated())
   , _collisionVertex(event.get_collision_vertex())
+  , _boostBetaVector(event.get_boost_beta_vector())
   , _theEvt(nullptr)
+  , _ownsEvt(true)
 {
   _theEvt = new HepMC::GenEvent(*event.getEvent());
   return;
@@ -34,6 +38,8 @@ PHHepMCGenEvent& PHHepMCGenEvent::operator=(const PHHepMCGenEvent& event)
 
   _embedding_id = event.get_embedding_id();
   _isSimulated = event.is_simulated();
+  _collisionVertex = event.get_collision_vertex();
+  _boostBetaVector = event.get_boost_beta_vector();
 
   const HepMC::GenEvent* hepmc = event.getEvent();
   _theEvt = new HepMC::GenEvent(*(hepmc));
@@ -43,7 +49,7 @@ PHHepMCGenEvent& PHHepMCGenEvent::operator=(const PHHepMCGenEvent& event)
 
 PHHepMCGenEvent::~PHHepMCGenEvent()
 {
-  delete _theEvt;
+  if (_ownsEvt) delete _theEvt;
 }
 
 void PHHepMCGenEvent::Reset()
@@ -51,8 +57,10 @@ void PHHepMCGenEvent::Reset()
   _embedding_id = 0;
   _isSimulated = false;
   _collisionVertex.set(0, 0, 0, 0);
-  delete _theEvt;
+  _boostBetaVector.set(0, 0, 0);
+  if (_ownsEvt) delete _theEvt;
   _theEvt = nullptr;
+  _ownsEvt = true;
 }
 
 HepMC::GenEvent* PHHepMCGenEvent::getEvent()
@@ -67,15 +75,32 @@ const HepMC::GenEvent* PHHepMCGenEvent::getEvent() const
 
 bool PHHepMCGenEvent::addEvent(HepMC::GenEvent* evt)
 {
-  if (_theEvt) delete _theEvt;
+  if (_theEvt && _ownsEvt) delete _theEvt;
 
   _theEvt = evt;
+  _ownsEvt = true;
+  if (!_theEvt) return false;
+  return true;
+}
+
+bool PHHepMCGenEvent::addSharedEvent(HepMC::GenEvent* evt)
+{
+  if (_theEvt && _ownsEvt) delete _theEvt;
+
+  _theEvt = evt;
+  _ownsEvt = false;
   if (!_theEvt) return false;
   return true;
 }
 
 bool PHHepMCGenEvent::swapEvent(HepMC::GenEvent*& evt)
 {
+  if (!_ownsEvt)
+  {
+    // the caller gets a copy, the shared record stays untouched
+    _theEvt = (_theEvt ? new HepMC::GenEvent(*_theEvt) : nullptr);
+    _ownsEvt = true;
+  }
   swap(_theEvt, evt);
 
   if (!_theEvt) return false;
@@ -89,6 +114,12 @@ bool PHHepMCGenEvent::addEvent(HepMC::GenEvent& evt)
 
 void PHHepMCGenEvent::clearEvent()
 {
+  if (!_ownsEvt)
+  {
+    _theEvt = new HepMC::GenEvent();
+    _ownsEvt = true;
+    return;
+  }
   if (_theEvt) _theEvt->clear();
 }
 
@@ -123,6 +154,7 @@ void PHHepMCGenEvent::identify(std::ostream& os) const
   os << " embedding_id = " << _embedding_id;
   os << " isSimulated = " << _isSimulated;
   os << " collisionVertex = (" << _collisionVertex.x() << "," << _collisionVertex.y() << "," << _collisionVertex.z() << ") cm, " << _collisionVertex.t() << " ns";
+  os << " boost beta = (" << _boostBetaVector.x() << "," << _boostBetaVector.y() << "," << _boostBetaVector.z() << ")";
   os << ", No of Particles: " << size();
   os << ", No of Vertices:  " << vertexSize();
   os << endl;
@@ -58,12 +58,27 @@ class PHHepMCGenEvent : public PHObject
   //! collision vertex position in the Hall coordinate system, use PHENIX units of cm, ns
   void set_collision_vertex(const HepMC::FourVector& v) { _collisionVertex = v; }
 
+  //! boost of the collision in the Hall coordinate system (e.g. from the beam crossing angle).
+  //! Like the collision vertex it is applied to the vertices and momenta when the event
+  //! is converted for Geant4, the HepMC record itself is never changed
+  const HepMC::ThreeVector& get_boost_beta_vector() const { return _boostBetaVector; }
+
+  //! boost of the collision in the Hall coordinate system, |beta| < 1
+  void set_boost_beta_vector(const HepMC::ThreeVector& v) { _boostBetaVector = v; }
+
   //! host an HepMC event
   bool addEvent(HepMC::GenEvent* evt);
   bool addEvent(HepMC::GenEvent& evt);
   bool swapEvent(HepMC::GenEvent*& evt);
   void clearEvent();
 
+  //! host an HepMC event owned by someone else (e.g. a pileup event pool), it is
+  //! neither modified by clearEvent() nor deleted. Copies and events read back
+  //! from a DST own their record again
+  bool addSharedEvent(HepMC::GenEvent* evt);
+  //! false if the hosted HepMC event is shared
+  bool ownsEvent() const { return _ownsEvt; }
+
   //! move the collision vertex position in the Hall coordinate system, use PHENIX units of cm, ns
   virtual void moveVertex(double x, double y, double z, double t = 0);
 
@@ -88,10 +103,16 @@ class PHHepMCGenEvent : public PHObject
   //! collision vertex position in the Hall coordinate system, use PHENIX units of cm, ns
   HepMC::FourVector _collisionVertex;
 
+  //! boost of the collision in the Hall coordinate system
+  HepMC::ThreeVector _boostBetaVector;
+
   //! The HEP MC record from event generator. Note the units are recorded in GenEvent
   HepMC::GenEvent* _theEvt;
 
-  ClassDef(PHHepMCGenEvent, 5)
+  //! false if _theEvt is shared and must not be deleted
+  bool _ownsEvt;  //!
+
+  ClassDef(PHHepMCGenEvent, 6)
 };
 
 #endif  // PHHEPMC_PHHEPMCEVENT_H
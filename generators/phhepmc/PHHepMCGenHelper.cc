@@ -24,7 +24,7 @@
 #include <phool/getClass.h>
 #include <phool/phool.h>                 // for PHWHERE
 
-#include <HepMC/SimpleVector.h>          // for FourVector
+#include <HepMC/SimpleVector.h>          // for FourVector, ThreeVector
 
 #include <gsl/gsl_randist.h>
 #include <gsl/gsl_rng.h>
@@ -49,6 +49,9 @@ PHHepMCGenHelper::PHHepMCGenHelper()
   , _vertex_width_y(0)
   , _vertex_width_z(0)
   , _vertex_width_t(0)
+  , _boost_beta_x(0)
+  , _boost_beta_y(0)
+  , _boost_beta_z(0)
   , _embedding_id(0)
   , _reuse_vertex(false)
   , _reuse_vertex_embedding_id(numeric_limits<int>::min())
@@ -128,6 +131,11 @@ void PHHepMCGenHelper::move_vertex(PHHepMCGenEvent *genevent)
         vtx_evt->get_collision_vertex().y(),
         vtx_evt->get_collision_vertex().z(),
         vtx_evt->get_collision_vertex().t());
+    genevent->set_boost_beta_vector(vtx_evt->get_boost_beta_vector());
+  }
+  else
+  {
+    genevent->set_boost_beta_vector(HepMC::ThreeVector(_boost_beta_x, _boost_beta_y, _boost_beta_z));
   }
 
   genevent->moveVertex(
@@ -137,6 +145,19 @@ void PHHepMCGenHelper::move_vertex(PHHepMCGenEvent *genevent)
       (smear(_vertex_t, _vertex_width_t, _vertex_func_t)));
 }
 
+void PHHepMCGenHelper::set_boost_beta_vector(const double bx, const double by, const double bz)
+{
+  if (bx * bx + by * by + bz * bz >= 1)
+  {
+    cout << "PHHepMCGenHelper::set_boost_beta_vector - Fatal Error - |beta| has to be smaller than 1" << endl;
+    exit(10);
+  }
+  _boost_beta_x = bx;
+  _boost_beta_y = by;
+  _boost_beta_z = bz;
+  return;
+}
+
 void PHHepMCGenHelper::set_vertex_distribution_function(VTXFUNC x, VTXFUNC y, VTXFUNC z, VTXFUNC t)
 {
   _vertex_func_x = x;
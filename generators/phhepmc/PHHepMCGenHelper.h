@@ -51,6 +51,11 @@ class PHHepMCGenHelper
   //! set the width of the vertex distribution function about the mean, use PHENIX units of cm, ns
   void set_vertex_distribution_width(const double x, const double y, const double z, const double t);
 
+  //! boost of the collisions in the Hall coordinate system (e.g. from the beam crossing angle),
+  //! stored with the event and applied when it is converted for Geant4. With
+  //! set_reuse_vertex() the boost of the source event is taken
+  void set_boost_beta_vector(const double bx, const double by, const double bz);
+
   //! embedding ID for the event
   //! positive ID is the embedded event of interest, e.g. jetty event from pythia
   //! negative IDs are backgrounds, .e.g out of time pile up collisions
@@ -125,6 +130,10 @@ class PHHepMCGenHelper
   double _vertex_width_z;
   double _vertex_width_t;
 
+  double _boost_beta_x;
+  double _boost_beta_y;
+  double _boost_beta_z;
+
   //! positive ID is the embedded event of interest, e.g. jetty event from pythia
   //! negative IDs are backgrounds, .e.g out of time pile up collisions
   //! Usually, ID = 0 means the primary Au+Au collision background
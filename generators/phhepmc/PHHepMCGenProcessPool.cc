@@ -0,0 +1,239 @@
+#include "PHHepMCGenProcessPool.h"
+
+#include "PHHepMCBinaryStore.h"
+
+#include <HepMC/GenEvent.h>
+
+#include <cerrno>
+#include <csignal>
+#include <cstdio>  // for fflush
+#include <cstring>  // for strerror
+#include <exception>
+#include <iostream>
+
+#include <sys/wait.h>
+#include <unistd.h>
+
+using namespace std;
+
+namespace
+{
+  //! in front of every event record, a record size of 0 means the worker is done
+  struct FrameHeader
+  {
+    unsigned int size;
+    unsigned int ntrials;
+  };
+}  // namespace
+
+PHHepMCGenProcessPool::PHHepMCGenProcessPool(const unsigned int nworkers)
+  : m_NWorkers(nworkers > 0 ? nworkers : 1)
+  , m_Verbosity(0)
+  , m_NRead(0)
+{
+}
+
+PHHepMCGenProcessPool::~PHHepMCGenProcessPool()
+{
+  Stop();
+}
+
+int PHHepMCGenProcessPool::Start(InitFunction init, GenerateFunction generate)
+{
+  if (running())
+  {
+    cout << "PHHepMCGenProcessPool::Start - workers are already running" << endl;
+    return -1;
+  }
+  // otherwise buffered output shows up once per worker
+  cout.flush();
+  cerr.flush();
+  fflush(nullptr);
+
+  m_NRead = 0;
+  for (unsigned int worker = 0; worker < m_NWorkers; ++worker)
+  {
+    int fds[2];
+    if (pipe(fds))
+    {
+      cout << "PHHepMCGenProcessPool::Start - pipe failed: " << strerror(errno) << endl;
+      Stop();
+      return -1;
+    }
+    const pid_t pid = fork();
+    if (pid < 0)
+    {
+      cout << "PHHepMCGenProcessPool::Start - fork failed: " << strerror(errno) << endl;
+      close(fds[0]);
+      close(fds[1]);
+      Stop();
+      return -1;
+    }
+    if (pid == 0)
+    {
+      // the worker must not keep the pipes of the other workers open
+      for (int fd : m_Pipes)
+      {
+        close(fd);
+      }
+      close(fds[0]);
+      RunWorker(worker, fds[1], init, generate);
+    }
+    close(fds[1]);
+    m_Pids.push_back(pid);
+    m_Pipes.push_back(fds[0]);
+    if (m_Verbosity > 0)
+    {
+      cout << "PHHepMCGenProcessPool::Start - worker " << worker << " has pid " << pid << endl;
+    }
+  }
+  return 0;
+}
+
+void PHHepMCGenProcessPool::RunWorker(const unsigned int worker, const int fd, InitFunction &init, GenerateFunction &generate)
+{
+  // nobody listens anymore once the reader closed the pipe
+  signal(SIGPIPE, SIG_DFL);
+  int status = 0;
+  try
+  {
+    init(worker);
+    string buffer;
+    while (true)
+    {
+      FrameHeader header = {0, 0};
+      HepMC::GenEvent *evt = generate(header.ntrials);
+      if (evt)
+      {
+        PHHepMCBinaryStore::EncodeRecord(evt, buffer);
+        delete evt;
+        header.size = buffer.size();
+      }
+      if (!WriteFully(fd, reinterpret_cast<const char *>(&header), sizeof(header)) ||
+          !WriteFully(fd, buffer.data(), header.size))
+      {
+        status = 1;
+        break;
+      }
+      if (!header.size)
+      {
+        break;
+      }
+    }
+  }
+  catch (const exception &e)
+  {
+    cout << "PHHepMCGenProcessPool - worker " << worker << " failed: " << e.what() << endl;
+    status = 1;
+  }
+  cout.flush();
+  cerr.flush();
+  fflush(nullptr);
+  close(fd);
+  // no destructors or atexit handlers of the parent in here
+  _exit(status);
+}
+
+HepMC::GenEvent *PHHepMCGenProcessPool::Next(unsigned int *ntrials)
+{
+  if (!running())
+  {
+    cout << "PHHepMCGenProcessPool::Next - workers are not running" << endl;
+    return nullptr;
+  }
+  const unsigned int worker = m_NRead % m_NWorkers;
+  FrameHeader header = {0, 0};
+  if (!ReadFully(m_Pipes[worker], reinterpret_cast<char *>(&header), sizeof(header)))
+  {
+    cout << "PHHepMCGenProcessPool::Next - worker " << worker << " died" << endl;
+    return nullptr;
+  }
+  if (!header.size)
+  {
+    cout << "PHHepMCGenProcessPool::Next - worker " << worker << " has no more events" << endl;
+    return nullptr;
+  }
+  m_Buffer.resize(header.size);
+  if (!ReadFully(m_Pipes[worker], &m_Buffer[0], header.size))
+  {
+    cout << "PHHepMCGenProcessPool::Next - worker " << worker << " died" << endl;
+    return nullptr;
+  }
+  HepMC::GenEvent *evt = PHHepMCBinaryStore::DecodeRecord(m_Buffer);
+  ++m_NRead;
+  if (ntrials)
+  {
+    *ntrials = header.ntrials;
+  }
+  if (m_Verbosity > 1)
+  {
+    cout << "PHHepMCGenProcessPool::Next - event " << m_NRead << " from worker " << worker
+         << ", " << header.size << " bytes" << endl;
+  }
+  return evt;
+}
+
+void PHHepMCGenProcessPool::Stop()
+{
+  // closing the pipes makes blocked workers fail on the next write,
+  // the signal takes care of the ones in the middle of an event
+  for (int fd : m_Pipes)
+  {
+    close(fd);
+  }
+  for (pid_t pid : m_Pids)
+  {
+    kill(pid, SIGTERM);
+  }
+  for (pid_t pid : m_Pids)
+  {
+    while (waitpid(pid, nullptr, 0) < 0 && errno == EINTR)
+    {
+    }
+  }
+  if (m_Verbosity > 0 && !m_Pids.empty())
+  {
+    cout << "PHHepMCGenProcessPool::Stop - stopped " << m_Pids.size() << " workers after "
+         << m_NRead << " events" << endl;
+  }
+  m_Pipes.clear();
+  m_Pids.clear();
+}
+
+bool PHHepMCGenProcessPool::ReadFully(const int fd, char *buffer, size_t size)
+{
+  while (size > 0)
+  {
+    const ssize_t n = read(fd, buffer, size);
+    if (n < 0 && errno == EINTR)
+    {
+      continue;
+    }
+    if (n <= 0)
+    {
+      return false;
+    }
+    buffer += n;
+    size -= n;
+  }
+  return true;
+}
+
+bool PHHepMCGenProcessPool::WriteFully(const int fd, const char *buffer, size_t size)
+{
+  while (size > 0)
+  {
+    const ssize_t n = write(fd, buffer, size);
+    if (n < 0 && errno == EINTR)
+    {
+      continue;
+    }
+    if (n <= 0)
+    {
+      return false;
+    }
+    buffer += n;
+    size -= n;
+  }
+  return true;
+}
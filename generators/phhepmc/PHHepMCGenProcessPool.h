@@ -0,0 +1,73 @@
+#ifndef PHHEPMC_PHHEPMCGENPROCESSPOOL_H
+#define PHHEPMC_PHHEPMCGENPROCESSPOOL_H
+
+#include <functional>
+#include <string>
+#include <vector>
+
+#include <sys/types.h>  // for pid_t
+
+namespace HepMC
+{
+  class GenEvent;
+}
+
+/*!
+ * \brief runs an event generator in forked worker processes
+ *
+ * Generators with Fortran common blocks or other global state cannot run in
+ * threads, so the initialized generator is forked instead. Every worker first
+ * calls the init function with its index (this is where it has to reseed its
+ * generator, e.g. with seed + worker) and then generates events until it is
+ * stopped. The events travel back as PHHepMCBinaryStore records over one pipe
+ * per worker.
+ *
+ * Event i is always taken from worker i % nworkers, so for a given number of
+ * workers and seed the event sequence is reproducible no matter which worker
+ * is faster. A worker runs ahead of the reader by about one pipe buffer.
+ */
+class PHHepMCGenProcessPool
+{
+ public:
+  //! generates the next event in a worker, nullptr stops the worker. ntrials counts the generator calls behind it
+  typedef std::function<HepMC::GenEvent *(unsigned int &ntrials)> GenerateFunction;
+
+  //! called in every worker right after the fork with the index of the worker
+  typedef std::function<void(const unsigned int worker)> InitFunction;
+
+  explicit PHHepMCGenProcessPool(const unsigned int nworkers);
+  virtual ~PHHepMCGenProcessPool();
+
+  //! forks the workers, returns 0 on success
+  int Start(InitFunction init, GenerateFunction generate);
+
+  //! next event in the reproducible order, nullptr if its worker failed. The caller owns the event
+  HepMC::GenEvent *Next(unsigned int *ntrials = nullptr);
+
+  //! terminates and reaps the workers
+  void Stop();
+
+  unsigned int nworkers() const { return m_NWorkers; }
+  bool running() const { return !m_Pids.empty(); }
+
+  void Verbosity(const int i) { m_Verbosity = i; }
+
+ private:
+  //! event loop of a worker, never returns
+  void RunWorker(const unsigned int worker, const int fd, InitFunction &init, GenerateFunction &generate);
+
+  static bool ReadFully(const int fd, char *buffer, size_t size);
+  static bool WriteFully(const int fd, const char *buffer, size_t size);
+
+  unsigned int m_NWorkers;
+  int m_Verbosity;
+
+  //! number of events read so far, selects the worker of the next event
+  unsigned long long m_NRead;
+
+  std::vector<pid_t> m_Pids;
+  std::vector<int> m_Pipes;  //< read ends, one per worker
+  std::string m_Buffer;
+};
+
+#endif /* PHHEPMC_PHHEPMCGENPROCESSPOOL_H */
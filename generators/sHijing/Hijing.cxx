@@ -20,6 +20,9 @@
 #include <HepMC/IO_AsciiParticles.h>
 #include <HepMC/IO_GenEvent.h>
 
+#include <phhepmc/PHHepMCBinaryStore.h>
+#include <phhepmc/PHHepMCGenProcessPool.h>
+
 #include <CLHEP/Random/RandomEngine.h>
 #include <CLHEP/Random/MTwistEngine.h>
 #include <CLHEP/Random/RandFlat.h>
@@ -137,6 +140,8 @@ main (int argc, char **argv)
   int N = pt.get ("HIJING.N", 1);
   keepSpectators = pt.get("HIJING.KEEP_SPECTATORS", 1);
   std::string output = pt.get("HIJING.OUTPUT", "sHijing.dat");
+  // HIJING lives in common blocks, more than one worker means forked processes
+  unsigned int nworkers = pt.get("HIJING.NWORKERS", 1);
 
   std::random_device rdev;
   long randomSeed = pt.get ("HIJING.RANDOM.SEED", rdev());
@@ -190,32 +195,85 @@ main (int argc, char **argv)
 
   HIJSET (efrm, frame, proj, targ, iap, izp, iat, izt);
 
-  //  int status;
-  HepMC::IO_GenEvent ascii_io (output.c_str(), std::ios::out);
-  int events = 0;
-  do 
+  // one good HIJING event, either right here or in a worker process
+  auto generate = [&](unsigned int &ntrials)
     {
-      HIJING (frame, bmin, bmax);
-
-      if (m_himain1.ierrstat () != 0)
+      do
 	{
-	  continue;
+	  HIJING (frame, bmin, bmax);
+	  ntrials++;
 	}
-      events++;
+      while (m_himain1.ierrstat () != 0);
 
       HepMC::GenEvent * evt = new HepMC::GenEvent ();
       evt->use_units(HepMC::Units::GEV, HepMC::Units::MM);
-      evt->set_event_number (events);
 
       fillEvent(evt);
 
-      ascii_io << evt;
+      return evt;
+    };
+
+  // worker i continues with the seed + i, the events are written in the
+  // order event n from worker n % NWORKERS which makes the output
+  // reproducible for a fixed seed and number of workers
+  PHHepMCGenProcessPool *pool = nullptr;
+  if (nworkers > 1)
+    {
+      cout << "generating in " << nworkers << " worker processes with seeds "
+	   << randomSeed << " to " << randomSeed + nworkers - 1 << endl;
+      pool = new PHHepMCGenProcessPool(nworkers);
+      if (pool->Start([&](const unsigned int worker) { engine->setSeed(randomSeed + worker, 0); },
+		      generate))
+	{
+	  return 1;
+	}
+    }
+
+  // files ending in .hepmcb are written as binary HepMC store
+  PHHepMCBinaryStore binary_out;
+  HepMC::IO_GenEvent * ascii_io = nullptr;
+  if (PHHepMCBinaryStore::IsBinaryFile(output))
+    {
+      if (binary_out.OpenWrite(output))
+	{
+	  return 1;
+	}
+    }
+  else
+    {
+      ascii_io = new HepMC::IO_GenEvent (output.c_str(), std::ios::out);
+    }
+
+  int status = 0;
+  for (int events = 1; events <= N; events++)
+    {
+      unsigned int ntrials = 0;
+      HepMC::GenEvent * evt = (pool ? pool->Next () : generate (ntrials));
+      if (!evt)
+	{
+	  cout << "no event " << events << " from the worker processes" << endl;
+	  status = 1;
+	  break;
+	}
+      evt->set_event_number (events);
+
+      if (ascii_io)
+	{
+	  *ascii_io << evt;
+	}
+      else
+	{
+	  binary_out.Write (evt);
+	}
 
       delete evt;
     }
-  while (events < N);
 
-  return 0;
+  delete pool;
+  delete ascii_io;
+  binary_out.Close ();
+
+  return status;
 }
 
 int
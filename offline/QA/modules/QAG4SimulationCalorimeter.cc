@@ -156,6 +156,10 @@ int QAG4SimulationCalorimeter::process_event(PHCompositeNode *topNode)
   if (Verbosity() > 2)
     cout << "QAG4SimulationCalorimeter::process_event() entered" << endl;
 
+  uint64_t ievent = 0;
+  if (!_sampling.accept_event(ievent))
+    return Fun4AllReturnCodes::EVENT_OK;
+
   if (_caloevalstack)
     _caloevalstack->next_event(topNode);
 
@@ -186,7 +190,7 @@ int QAG4SimulationCalorimeter::process_event(PHCompositeNode *topNode)
   // at the end, count success events
   Fun4AllHistoManager *hm = QAHistManagerDef::getHistoManager();
   assert(hm);
-  TH1D *h_norm = dynamic_cast<TH1D *>(hm->getHisto(
+  TH1D *h_norm = dynamic_cast<TH1D *>(hm->getThreadHisto(
       get_histo_prefix() + "_Normalization"));
   assert(h_norm);
   h_norm->Fill("Event", 1);
@@ -194,6 +198,14 @@ int QAG4SimulationCalorimeter::process_event(PHCompositeNode *topNode)
   return Fun4AllReturnCodes::EVENT_OK;
 }
 
+int QAG4SimulationCalorimeter::End(PHCompositeNode *topNode)
+{
+  if (Verbosity() || _sampling.get_every_n_events() > 1)
+    _sampling.print(Name());
+
+  return Fun4AllReturnCodes::EVENT_OK;
+}
+
 string
 QAG4SimulationCalorimeter::get_histo_prefix()
 {
@@ -258,7 +270,7 @@ int QAG4SimulationCalorimeter::process_event_G4Hit(PHCompositeNode *topNode)
   Fun4AllHistoManager *hm = QAHistManagerDef::getHistoManager();
   assert(hm);
 
-  TH1D *h_norm = dynamic_cast<TH1D *>(hm->getHisto(
+  TH1D *h_norm = dynamic_cast<TH1D *>(hm->getThreadHisto(
       get_histo_prefix() + "_Normalization"));
   assert(h_norm);
 
@@ -327,16 +339,16 @@ int QAG4SimulationCalorimeter::process_event_G4Hit(PHCompositeNode *topNode)
 
   if (_calo_hit_container)
   {
-    TH2F *hrz = dynamic_cast<TH2F *>(hm->getHisto(
+    TH2F *hrz = dynamic_cast<TH2F *>(hm->getThreadHisto(
         get_histo_prefix() + "_G4Hit_RZ"));
     assert(hrz);
-    TH2F *hxy = dynamic_cast<TH2F *>(hm->getHisto(
+    TH2F *hxy = dynamic_cast<TH2F *>(hm->getThreadHisto(
         get_histo_prefix() + "_G4Hit_XY"));
     assert(hxy);
-    TH1F *ht = dynamic_cast<TH1F *>(hm->getHisto(
+    TH1F *ht = dynamic_cast<TH1F *>(hm->getThreadHisto(
         get_histo_prefix() + "_G4Hit_HitTime"));
     assert(ht);
-    TH2F *hlat = dynamic_cast<TH2F *>(hm->getHisto(
+    TH2F *hlat = dynamic_cast<TH2F *>(hm->getThreadHisto(
         get_histo_prefix() + "_G4Hit_LateralTruthProjection"));
     assert(hlat);
 
@@ -400,23 +412,23 @@ int QAG4SimulationCalorimeter::process_event_G4Hit(PHCompositeNode *topNode)
 
   if (e_calo + ea_calo > 0)
   {
-    h = dynamic_cast<TH1F *>(hm->getHisto(get_histo_prefix() + "_G4Hit_SF"));
+    h = dynamic_cast<TH1F *>(hm->getThreadHisto(get_histo_prefix() + "_G4Hit_SF"));
     assert(h);
     h->Fill(e_calo / (e_calo + ea_calo));
 
-    h = dynamic_cast<TH1F *>(hm->getHisto(get_histo_prefix() + "_G4Hit_VSF"));
+    h = dynamic_cast<TH1F *>(hm->getThreadHisto(get_histo_prefix() + "_G4Hit_VSF"));
     assert(h);
     h->Fill(ev_calo / (e_calo + ea_calo));
   }
 
-  h = dynamic_cast<TH1F *>(hm->getHisto(
+  h = dynamic_cast<TH1F *>(hm->getThreadHisto(
       get_histo_prefix() + "_G4Hit_FractionTruthEnergy"));
   assert(h);
   h->Fill((e_calo + ea_calo) / total_primary_energy);
 
   if (ev_calo > 0)
   {
-    h = dynamic_cast<TH1F *>(hm->getHisto(
+    h = dynamic_cast<TH1F *>(hm->getThreadHisto(
         get_histo_prefix() + "_G4Hit_FractionEMVisibleEnergy"));
     assert(h);
     h->Fill(ev_calo_em / (ev_calo));
@@ -493,7 +505,7 @@ int QAG4SimulationCalorimeter::process_event_Tower(PHCompositeNode *topNode)
 
   Fun4AllHistoManager *hm = QAHistManagerDef::getHistoManager();
   assert(hm);
-  TH1D *h_norm = dynamic_cast<TH1D *>(hm->getHisto(
+  TH1D *h_norm = dynamic_cast<TH1D *>(hm->getThreadHisto(
       get_histo_prefix() + "_Normalization"));
   assert(h_norm);
 
@@ -532,11 +544,11 @@ int QAG4SimulationCalorimeter::process_event_Tower(PHCompositeNode *topNode)
   {
     max_energy[size] = 0;
 
-    TH1F *h = dynamic_cast<TH1F *>(hm->getHisto(
+    TH1F *h = dynamic_cast<TH1F *>(hm->getThreadHisto(
         get_histo_prefix() + "_Tower_" + size_label[size]));
     assert(h);
     energy_hist_list[size] = h;
-    h = dynamic_cast<TH1F *>(hm->getHisto(
+    h = dynamic_cast<TH1F *>(hm->getThreadHisto(
         get_histo_prefix() + "_Tower_" + size_label[size] + "_max"));
     assert(h);
     max_energy_hist_list[size] = h;
@@ -637,7 +649,7 @@ int QAG4SimulationCalorimeter::process_event_Cluster(PHCompositeNode *topNode)
   }
 
   //get a cluster count
-  TH1D *h_norm = dynamic_cast<TH1D *>(hm->getHisto(
+  TH1D *h_norm = dynamic_cast<TH1D *>(hm->getThreadHisto(
       get_histo_prefix() + "_Normalization"));
   assert(h_norm);
 
@@ -665,7 +677,7 @@ int QAG4SimulationCalorimeter::process_event_Cluster(PHCompositeNode *topNode)
   CaloRawClusterEval *clustereval = _caloevalstack->get_rawcluster_eval();
   assert(clustereval);
 
-  TH1F *h = dynamic_cast<TH1F *>(hm->getHisto(
+  TH1F *h = dynamic_cast<TH1F *>(hm->getThreadHisto(
       get_histo_prefix() + "_Cluster_BestMatchERatio"));
   assert(h);
 
@@ -717,7 +729,7 @@ int QAG4SimulationCalorimeter::process_event_Cluster(PHCompositeNode *topNode)
     assert(axis_polar.mag() > 0);
     axis_polar = axis_polar.unit();
 
-    TH2F *hlat = dynamic_cast<TH2F *>(hm->getHisto(
+    TH2F *hlat = dynamic_cast<TH2F *>(hm->getThreadHisto(
         get_histo_prefix() + "_Cluster_LateralTruthProjection"));
     assert(hlat);
 
@@ -1,6 +1,8 @@
 #ifndef QA_QAG4SIMULATIONCALORIMETER_H
 #define QA_QAG4SIMULATIONCALORIMETER_H
 
+#include "QASampling.h"
+
 #include <fun4all/SubsysReco.h>
 
 #include <memory>
@@ -37,6 +39,14 @@ class QAG4SimulationCalorimeter : public SubsysReco
   int Init(PHCompositeNode *topNode);
   int InitRun(PHCompositeNode *topNode);
   int process_event(PHCompositeNode *topNode);
+  int End(PHCompositeNode *topNode);
+
+  //! analyze one event out of n (default 1, all events)
+  void
+  set_every_n_events(unsigned int n)
+  {
+    _sampling.set_every_n_events(n);
+  }
 
   uint32_t
   get_flags() const
@@ -93,6 +103,9 @@ class QAG4SimulationCalorimeter : public SubsysReco
   PHG4HitContainer *_calo_hit_container;
   PHG4HitContainer *_calo_abs_hit_container;
   PHG4TruthInfoContainer *_truth_container;
+
+  //! event prescale
+  QASampling _sampling;
 };
 
 #endif  // QA_QAG4SIMULATIONCALORIMETER_H
@@ -184,7 +184,7 @@ int QAG4SimulationCalorimeterSum::process_event(PHCompositeNode *topNode)
   // at the end, count success events
   Fun4AllHistoManager *hm = QAHistManagerDef::getHistoManager();
   assert(hm);
-  TH1D *h_norm = dynamic_cast<TH1D *>(hm->getHisto(
+  TH1D *h_norm = dynamic_cast<TH1D *>(hm->getThreadHisto(
       get_histo_prefix() + "Normalization"));
   assert(h_norm);
   h_norm->Fill("Event", 1);
@@ -267,13 +267,13 @@ int QAG4SimulationCalorimeterSum::process_event_TrackProj(PHCompositeNode *topNo
 
   Fun4AllHistoManager *hm = QAHistManagerDef::getHistoManager();
   assert(hm);
-  TH1D *h_norm = dynamic_cast<TH1D *>(hm->getHisto(
+  TH1D *h_norm = dynamic_cast<TH1D *>(hm->getThreadHisto(
       get_histo_prefix() + "Normalization"));
   assert(h_norm);
   h_norm->Fill("Track", 1);
 
   {
-    TH1F *hsum = dynamic_cast<TH1F *>(hm->getHisto(
+    TH1F *hsum = dynamic_cast<TH1F *>(hm->getThreadHisto(
         (get_histo_prefix()) + "TrackProj_3x3Tower_EP"));
     assert(hsum);
 
@@ -281,7 +281,7 @@ int QAG4SimulationCalorimeterSum::process_event_TrackProj(PHCompositeNode *topNo
         (track->get_cal_energy_3x3(SvtxTrack::CEMC) + track->get_cal_energy_3x3(SvtxTrack::HCALIN) + track->get_cal_energy_3x3(SvtxTrack::HCALOUT)) / (primary->get_e() + 1e-9));
   }
   {
-    TH1F *hsum = dynamic_cast<TH1F *>(hm->getHisto(
+    TH1F *hsum = dynamic_cast<TH1F *>(hm->getThreadHisto(
         (get_histo_prefix()) + "TrackProj_5x5Tower_EP"));
     assert(hsum);
 
@@ -306,7 +306,7 @@ bool QAG4SimulationCalorimeterSum::eval_trk_proj(const string &detector, SvtxTra
   Fun4AllHistoManager *hm = QAHistManagerDef::getHistoManager();
   assert(hm);
 
-  TH2F *h2_proj = dynamic_cast<TH2F *>(hm->getHisto(
+  TH2F *h2_proj = dynamic_cast<TH2F *>(hm->getThreadHisto(
       (get_histo_prefix()) + detector + "_TrackProj"));
   assert(h2_proj);
 
@@ -533,13 +533,13 @@ int QAG4SimulationCalorimeterSum::process_event_Cluster(PHCompositeNode *topNode
 
   if (cluster_cemc_e + cluster_hcalin_e > 0)
   {
-    TH2F *h2 = dynamic_cast<TH2F *>(hm->getHisto(
+    TH2F *h2 = dynamic_cast<TH2F *>(hm->getThreadHisto(
         (get_histo_prefix()) + "Cluster_" + _calo_name_cemc + "_" + _calo_name_hcalin));
     assert(h2);
 
     h2->Fill(cluster_cemc_e, cluster_hcalin_e);
 
-    TH1F *hr = dynamic_cast<TH1F *>(hm->getHisto(
+    TH1F *hr = dynamic_cast<TH1F *>(hm->getThreadHisto(
         (get_histo_prefix()) + "Cluster_Ratio_" + _calo_name_cemc + "_" + _calo_name_hcalin));
     assert(hr);
 
@@ -558,20 +558,20 @@ int QAG4SimulationCalorimeterSum::process_event_Cluster(PHCompositeNode *topNode
            << endl;
     }
 
-    TH2F *h2 = dynamic_cast<TH2F *>(hm->getHisto(
+    TH2F *h2 = dynamic_cast<TH2F *>(hm->getThreadHisto(
         (get_histo_prefix()) + "Cluster_" + _calo_name_cemc + "_" + _calo_name_hcalin + "_" + _calo_name_hcalout));
     assert(h2);
 
     h2->Fill((cluster_cemc_e + cluster_hcalin_e), cluster_hcalout_e);
 
-    TH1F *hr = dynamic_cast<TH1F *>(hm->getHisto(
+    TH1F *hr = dynamic_cast<TH1F *>(hm->getThreadHisto(
         (get_histo_prefix()) + "Cluster_Ratio_" + _calo_name_cemc + "_" + _calo_name_hcalin + "_" + _calo_name_hcalout));
     assert(hr);
 
     hr->Fill(
         (cluster_cemc_e + cluster_hcalin_e) / (cluster_cemc_e + cluster_hcalin_e + cluster_hcalout_e));
 
-    TH1F *hsum = dynamic_cast<TH1F *>(hm->getHisto(
+    TH1F *hsum = dynamic_cast<TH1F *>(hm->getThreadHisto(
         (get_histo_prefix()) + "Cluster_EP"));
     assert(hsum);
 
@@ -175,13 +175,13 @@ void QAG4SimulationIntt::evaluate_clusters()
   for( const auto& layer: m_layers )
   {
     HistogramList h;
-    h.drphi = dynamic_cast<TH1*>( hm->getHisto(Form( "%sdrphi_%i", get_histo_prefix().c_str(), layer )) );
-    h.rphi_error = dynamic_cast<TH1*>( hm->getHisto(Form( "%srphi_error_%i", get_histo_prefix().c_str(), layer )) );
-    h.phi_pulls = dynamic_cast<TH1*>( hm->getHisto(Form( "%sphi_pulls_%i", get_histo_prefix().c_str(), layer )) );
+    h.drphi = dynamic_cast<TH1*>( hm->getThreadHisto(Form( "%sdrphi_%i", get_histo_prefix().c_str(), layer )) );
+    h.rphi_error = dynamic_cast<TH1*>( hm->getThreadHisto(Form( "%srphi_error_%i", get_histo_prefix().c_str(), layer )) );
+    h.phi_pulls = dynamic_cast<TH1*>( hm->getThreadHisto(Form( "%sphi_pulls_%i", get_histo_prefix().c_str(), layer )) );
 
-    h.dz = dynamic_cast<TH1*>( hm->getHisto(Form( "%sdz_%i", get_histo_prefix().c_str(), layer )) );
-    h.z_error = dynamic_cast<TH1*>( hm->getHisto(Form( "%sz_error_%i", get_histo_prefix().c_str(), layer )) );
-    h.z_pulls = dynamic_cast<TH1*>( hm->getHisto(Form( "%sz_pulls_%i", get_histo_prefix().c_str(), layer )) );
+    h.dz = dynamic_cast<TH1*>( hm->getThreadHisto(Form( "%sdz_%i", get_histo_prefix().c_str(), layer )) );
+    h.z_error = dynamic_cast<TH1*>( hm->getThreadHisto(Form( "%sz_error_%i", get_histo_prefix().c_str(), layer )) );
+    h.z_pulls = dynamic_cast<TH1*>( hm->getThreadHisto(Form( "%sz_pulls_%i", get_histo_prefix().c_str(), layer )) );
 
     histograms.insert( std::make_pair(layer,h));
   }
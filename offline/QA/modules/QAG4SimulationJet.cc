@@ -131,6 +131,10 @@ int QAG4SimulationJet::process_event(PHCompositeNode* topNode)
   if (Verbosity() > 2)
     cout << "QAG4SimulationJet::process_event() entered" << endl;
 
+  uint64_t ievent = 0;
+  if (!_sampling.accept_event(ievent))
+    return Fun4AllReturnCodes::EVENT_OK;
+
   for (jetevalstacks_map::iterator it_jetevalstack = _jetevalstacks.begin();
        it_jetevalstack != _jetevalstacks.end(); ++it_jetevalstack)
   {
@@ -179,6 +183,14 @@ int QAG4SimulationJet::process_event(PHCompositeNode* topNode)
   return Fun4AllReturnCodes::EVENT_OK;
 }
 
+int QAG4SimulationJet::End(PHCompositeNode* topNode)
+{
+  if (Verbosity() || _sampling.get_every_n_events() > 1)
+    _sampling.print(Name());
+
+  return Fun4AllReturnCodes::EVENT_OK;
+}
+
 //! set eta range
 void QAG4SimulationJet::set_eta_range(double low, double high)
 {
@@ -333,21 +345,21 @@ int QAG4SimulationJet::process_Spectrum(PHCompositeNode* topNode,
   Fun4AllHistoManager* hm = QAHistManagerDef::getHistoManager();
   assert(hm);
 
-  TH1D* h_norm = dynamic_cast<TH1D*>(hm->getHisto(
+  TH1D* h_norm = dynamic_cast<TH1D*>(hm->getThreadHisto(
       get_histo_prefix(jet_name) + "Normalization"));
   assert(h_norm);
   h_norm->Fill("Event", 1);
   h_norm->Fill("Inclusive Jets", jets->size());
 
-  TH1F* ie = dynamic_cast<TH1F*>(hm->getHisto(
+  TH1F* ie = dynamic_cast<TH1F*>(hm->getThreadHisto(
       (get_histo_prefix(jet_name)) + "Inclusive_E"  //
       ));
   assert(ie);
-  TH1F* ieta = dynamic_cast<TH1F*>(hm->getHisto(
+  TH1F* ieta = dynamic_cast<TH1F*>(hm->getThreadHisto(
       (get_histo_prefix(jet_name)) + "Inclusive_eta"  //
       ));
   assert(ieta);
-  TH1F* iphi = dynamic_cast<TH1F*>(hm->getHisto(
+  TH1F* iphi = dynamic_cast<TH1F*>(hm->getThreadHisto(
       (get_histo_prefix(jet_name)) + "Inclusive_phi"  //
       ));
   assert(iphi);
@@ -385,36 +397,36 @@ int QAG4SimulationJet::process_Spectrum(PHCompositeNode* topNode,
 
     h_norm->Fill("Leading Jets", 1);
 
-    TH1F* let = dynamic_cast<TH1F*>(hm->getHisto(
+    TH1F* let = dynamic_cast<TH1F*>(hm->getThreadHisto(
         (get_histo_prefix(jet_name)) + "Leading_Et"  //
         ));
     assert(let);
-    TH1F* leta = dynamic_cast<TH1F*>(hm->getHisto(
+    TH1F* leta = dynamic_cast<TH1F*>(hm->getThreadHisto(
         (get_histo_prefix(jet_name)) + "Leading_eta"  //
         ));
     assert(leta);
-    TH1F* lphi = dynamic_cast<TH1F*>(hm->getHisto(
+    TH1F* lphi = dynamic_cast<TH1F*>(hm->getThreadHisto(
         (get_histo_prefix(jet_name)) + "Leading_phi"  //
         ));
     assert(lphi);
 
-    TH1F* lcomp = dynamic_cast<TH1F*>(hm->getHisto(
+    TH1F* lcomp = dynamic_cast<TH1F*>(hm->getThreadHisto(
         (get_histo_prefix(jet_name)) + "Leading_CompSize"  //
         ));
     assert(lcomp);
-    TH1F* lmass = dynamic_cast<TH1F*>(hm->getHisto(
+    TH1F* lmass = dynamic_cast<TH1F*>(hm->getThreadHisto(
         (get_histo_prefix(jet_name)) + "Leading_Mass"  //
         ));
     assert(lmass);
-    TH1F* lcemcr = dynamic_cast<TH1F*>(hm->getHisto(
+    TH1F* lcemcr = dynamic_cast<TH1F*>(hm->getThreadHisto(
         (get_histo_prefix(jet_name)) + "Leading_CEMC_Ratio"  //
         ));
     assert(lcemcr);
-    TH1F* lemchcalr = dynamic_cast<TH1F*>(hm->getHisto(
+    TH1F* lemchcalr = dynamic_cast<TH1F*>(hm->getThreadHisto(
         (get_histo_prefix(jet_name)) + "Leading_CEMC_HCalIN_Ratio"  //
         ));
     assert(lemchcalr);
-    TH1F* lleak = dynamic_cast<TH1F*>(hm->getHisto(
+    TH1F* lleak = dynamic_cast<TH1F*>(hm->getThreadHisto(
         (get_histo_prefix(jet_name)) + "Leading_Leakage_Ratio"  //
         ));
     assert(lleak);
@@ -612,27 +624,27 @@ int QAG4SimulationJet::process_TruthMatching(PHCompositeNode* topNode,
   Fun4AllHistoManager* hm = QAHistManagerDef::getHistoManager();
   assert(hm);
 
-  TH2F* Matching_Count_Truth_Et = dynamic_cast<TH2F*>(hm->getHisto(
+  TH2F* Matching_Count_Truth_Et = dynamic_cast<TH2F*>(hm->getThreadHisto(
       (get_histo_prefix(_truth_jet, reco_jet_name)) + "Matching_Count_Truth_Et"  //
       ));
   assert(Matching_Count_Truth_Et);
-  TH2F* Matching_Count_Reco_Et = dynamic_cast<TH2F*>(hm->getHisto(
+  TH2F* Matching_Count_Reco_Et = dynamic_cast<TH2F*>(hm->getThreadHisto(
       (get_histo_prefix(_truth_jet, reco_jet_name)) + "Matching_Count_Reco_Et"  //
       ));
   assert(Matching_Count_Reco_Et);
-  TH2F* Matching_dEt = dynamic_cast<TH2F*>(hm->getHisto(
+  TH2F* Matching_dEt = dynamic_cast<TH2F*>(hm->getThreadHisto(
       (get_histo_prefix(_truth_jet, reco_jet_name)) + "Matching_dEt"  //
       ));
   assert(Matching_dEt);
-  TH2F* Matching_dE = dynamic_cast<TH2F*>(hm->getHisto(
+  TH2F* Matching_dE = dynamic_cast<TH2F*>(hm->getThreadHisto(
       (get_histo_prefix(_truth_jet, reco_jet_name)) + "Matching_dE"  //
       ));
   assert(Matching_dE);
-  TH2F* Matching_dEta = dynamic_cast<TH2F*>(hm->getHisto(
+  TH2F* Matching_dEta = dynamic_cast<TH2F*>(hm->getThreadHisto(
       (get_histo_prefix(_truth_jet, reco_jet_name)) + "Matching_dEta"  //
       ));
   assert(Matching_dEta);
-  TH2F* Matching_dPhi = dynamic_cast<TH2F*>(hm->getHisto(
+  TH2F* Matching_dPhi = dynamic_cast<TH2F*>(hm->getThreadHisto(
       (get_histo_prefix(_truth_jet, reco_jet_name)) + "Matching_dPhi"  //
       ));
   assert(Matching_dPhi);
@@ -1,6 +1,8 @@
 #ifndef QA_QAG4SIMULATIONJET_H
 #define QA_QAG4SIMULATIONJET_H
 
+#include "QASampling.h"
+
 #include <fun4all/SubsysReco.h>
 
 #include <TString.h>
@@ -132,6 +134,14 @@ class QAG4SimulationJet : public SubsysReco
   int Init(PHCompositeNode *topNode);
   int InitRun(PHCompositeNode *topNode);
   int process_event(PHCompositeNode *topNode);
+  int End(PHCompositeNode *topNode);
+
+  //! analyze one event out of n (default 1, all events)
+  void
+  set_every_n_events(unsigned int n)
+  {
+    _sampling.set_every_n_events(n);
+  }
 
  private:
   int Init_Spectrum(PHCompositeNode *topNode, const std::string &jet_name);
@@ -181,6 +191,9 @@ class QAG4SimulationJet : public SubsysReco
 
   //! Energy ratio difference cut from 1 for matched jets
   double _jet_match_dE_Ratio;
+
+  //! event prescale
+  QASampling _sampling;
 };
 
 #endif  // QA_QAG4SIMULATIONJET_H
@@ -3,6 +3,7 @@
 
 #include <g4eval/CaloEvalStack.h>
 #include <g4eval/CaloRawClusterEval.h>
+#include <g4eval/SvtxClusterEval.h>
 #include <g4eval/SvtxEvalStack.h>
 
 #include <g4main/PHG4Particle.h>
@@ -15,6 +16,7 @@
 
 #include <trackbase/TrkrDefs.h>  // for cluskey, getLayer
 #include <trackbase_historic/SvtxTrack.h>
+#include <trackbase_historic/SvtxTrackMap.h>
 
 #include <g4eval/SvtxTrackEval.h>  // for SvtxTrackEval
 #include <g4eval/SvtxTruthEval.h>  // for SvtxTruthEval
@@ -37,6 +39,8 @@
 #include <cmath>
 #include <iostream>
 #include <iterator>  // for reverse_iterator
+#include <map>
+#include <set>
 #include <utility>   // for pair
 #include <vector>
 
@@ -156,50 +160,56 @@ int QAG4SimulationTracking::process_event(PHCompositeNode *topNode)
   Fun4AllHistoManager *hm = QAHistManagerDef::getHistoManager();
   assert(hm);
 
+  uint64_t ievent = 0;
+  if (!m_sampling.accept_event(ievent))
+  {
+    if (Verbosity() > 2)
+      cout << "QAG4SimulationTracking::process_event() - skip event " << ievent << endl;
+    return Fun4AllReturnCodes::EVENT_OK;
+  }
+
   if (_svtxEvalStack)
     _svtxEvalStack->next_event(topNode);
 
-  SvtxTrackEval *trackeval = _svtxEvalStack->get_track_eval();
-  assert(trackeval);
   SvtxTruthEval *trutheval = _svtxEvalStack->get_truth_eval();
   assert(trutheval);
 
   // reco pT / gen pT histogram
-  TH1 *h_pTRecoGenRatio = dynamic_cast<TH1 *>(hm->getHisto(get_histo_prefix() + "pTRecoGenRatio"));
+  TH1 *h_pTRecoGenRatio = dynamic_cast<TH1 *>(hm->getThreadHisto(get_histo_prefix() + "pTRecoGenRatio"));
   assert(h_pTRecoGenRatio);
 
   // reco pT / gen pT histogram
-  TH2 *h_pTRecoGenRatio_pTGen = dynamic_cast<TH2 *>(hm->getHisto(get_histo_prefix() + "pTRecoGenRatio_pTGen"));
+  TH2 *h_pTRecoGenRatio_pTGen = dynamic_cast<TH2 *>(hm->getThreadHisto(get_histo_prefix() + "pTRecoGenRatio_pTGen"));
   assert(h_pTRecoGenRatio);
 
   // reco histogram plotted at gen pT
-  TH1 *h_nReco_pTGen = dynamic_cast<TH1 *>(hm->getHisto(get_histo_prefix() + "nReco_pTGen"));
+  TH1 *h_nReco_pTGen = dynamic_cast<TH1 *>(hm->getThreadHisto(get_histo_prefix() + "nReco_pTGen"));
   assert(h_nReco_pTGen);
 
   // reco histogram plotted at gen pT
-  TH1 *h_nMVTX_nReco_pTGen = dynamic_cast<TH1 *>(hm->getHisto(get_histo_prefix() + "nMVTX_nReco_pTGen"));
+  TH1 *h_nMVTX_nReco_pTGen = dynamic_cast<TH1 *>(hm->getThreadHisto(get_histo_prefix() + "nMVTX_nReco_pTGen"));
   assert(h_nMVTX_nReco_pTGen);
   // reco histogram plotted at gen pT
-  TH1 *h_nINTT_nReco_pTGen = dynamic_cast<TH1 *>(hm->getHisto(get_histo_prefix() + "nINTT_nReco_pTGen"));
+  TH1 *h_nINTT_nReco_pTGen = dynamic_cast<TH1 *>(hm->getThreadHisto(get_histo_prefix() + "nINTT_nReco_pTGen"));
   assert(h_nINTT_nReco_pTGen);
   // reco histogram plotted at gen pT
-  TH1 *h_nTPC_nReco_pTGen = dynamic_cast<TH1 *>(hm->getHisto(get_histo_prefix() + "nTPC_nReco_pTGen"));
+  TH1 *h_nTPC_nReco_pTGen = dynamic_cast<TH1 *>(hm->getThreadHisto(get_histo_prefix() + "nTPC_nReco_pTGen"));
   assert(h_nTPC_nReco_pTGen);
 
   // gen pT histogram
-  TH1 *h_nGen_pTGen = dynamic_cast<TH1 *>(hm->getHisto(get_histo_prefix() + "nGen_pTGen"));
+  TH1 *h_nGen_pTGen = dynamic_cast<TH1 *>(hm->getThreadHisto(get_histo_prefix() + "nGen_pTGen"));
   assert(h_nGen_pTGen);
 
   // reco histogram plotted at gen eta
-  TH1 *h_nReco_etaGen = dynamic_cast<TH1 *>(hm->getHisto(get_histo_prefix() + "nReco_etaGen"));
+  TH1 *h_nReco_etaGen = dynamic_cast<TH1 *>(hm->getThreadHisto(get_histo_prefix() + "nReco_etaGen"));
   assert(h_nReco_etaGen);
 
   // gen eta histogram
-  TH1 *h_nGen_etaGen = dynamic_cast<TH1 *>(hm->getHisto(get_histo_prefix() + "nGen_etaGen"));
+  TH1 *h_nGen_etaGen = dynamic_cast<TH1 *>(hm->getThreadHisto(get_histo_prefix() + "nGen_etaGen"));
   assert(h_nGen_etaGen);
 
   // n events and n tracks histogram
-  TH1 *h_norm = dynamic_cast<TH1 *>(hm->getHisto(get_histo_prefix() + "Normalization"));
+  TH1 *h_norm = dynamic_cast<TH1 *>(hm->getThreadHisto(get_histo_prefix() + "Normalization"));
   assert(h_norm);
   h_norm->Fill("Event", 1);
 
@@ -210,6 +220,16 @@ int QAG4SimulationTracking::process_event(PHCompositeNode *topNode)
     return Fun4AllReturnCodes::ABORTRUN;
   }
 
+  // primary particles in the acceptance
+  struct Candidate
+  {
+    PHG4Particle *g4particle;
+    double gpt;
+    double geta;
+    double gcharge;
+  };
+  vector<Candidate> candidates;
+
   PHG4TruthInfoContainer::ConstRange range = _truthContainer->GetPrimaryParticleRange();
   for (PHG4TruthInfoContainer::ConstIterator iter = range.first; iter != range.second; ++iter)
   {
@@ -268,19 +288,36 @@ int QAG4SimulationTracking::process_event(PHCompositeNode *topNode)
     }
 
     const double gcharge = pdg_p->Charge() / 3;
-    if (gcharge > 0)
+    if (gcharge == 0)
     {
-      h_norm->Fill("Truth Track+", 1);
+      if (Verbosity())
+        cout << "QAG4SimulationTracking::process_event - invalid particle ID = " << pid << endl;
+      continue;
     }
-    else if (gcharge < 0)
+
+    Candidate candidate = {g4particle, gpt, geta, gcharge};
+    candidates.push_back(candidate);
+  }
+
+  // all of them, or a random sample of at most the max. number of truth particles
+  vector<unsigned int> selected;
+  m_sampling.sample(ievent, candidates.size(), selected);
+
+  build_track_index(topNode);
+
+  for (vector<unsigned int>::const_iterator isel = selected.begin(); isel != selected.end(); ++isel)
+  {
+    PHG4Particle *g4particle = candidates[*isel].g4particle;
+    const double gpt = candidates[*isel].gpt;
+    const double geta = candidates[*isel].geta;
+
+    if (candidates[*isel].gcharge > 0)
     {
-      h_norm->Fill("Truth Track-", 1);
+      h_norm->Fill("Truth Track+", 1);
     }
     else
     {
-      if (Verbosity())
-        cout << "QAG4SimulationTracking::process_event - invalid particle ID = " << pid << endl;
-      continue;
+      h_norm->Fill("Truth Track-", 1);
     }
     h_norm->Fill("Truth Track", 1);
 
@@ -288,14 +325,16 @@ int QAG4SimulationTracking::process_event(PHCompositeNode *topNode)
     h_nGen_etaGen->Fill(geta);
 
     // look for best matching track in reco data & get its information
-    SvtxTrack *track = trackeval->best_track_from(g4particle);
+    map<int, SvtxTrack *>::const_iterator best_iter = m_bestTrack.find(g4particle->get_track_id());
+    SvtxTrack *track = (best_iter != m_bestTrack.end()) ? best_iter->second : nullptr;
     if (track)
     {
       bool match_found(false);
 
       if (m_uniqueTrackingMatch)
       {
-        PHG4Particle *g4particle_mathced = trackeval->max_truth_particle_by_nclusters(track);
+        map<SvtxTrack *, PHG4Particle *>::const_iterator max_iter = m_maxParticle.find(track);
+        PHG4Particle *g4particle_mathced = (max_iter != m_maxParticle.end()) ? max_iter->second : nullptr;
 
         if (g4particle_mathced)
         {
@@ -371,6 +410,78 @@ int QAG4SimulationTracking::process_event(PHCompositeNode *topNode)
   return Fun4AllReturnCodes::EVENT_OK;
 }
 
+int QAG4SimulationTracking::End(PHCompositeNode *topNode)
+{
+  if (Verbosity() || m_sampling.get_every_n_events() > 1 || m_sampling.get_max_particles() > 0)
+    m_sampling.print(Name());
+
+  return Fun4AllReturnCodes::EVENT_OK;
+}
+
+void QAG4SimulationTracking::build_track_index(PHCompositeNode *topNode)
+{
+  m_bestTrack.clear();
+  m_maxParticle.clear();
+
+  SvtxTrackMap *trackmap = findNode::getClass<SvtxTrackMap>(topNode, "SvtxTrackMap");
+  if (!trackmap)
+  {
+    if (Verbosity())
+      cout << "QAG4SimulationTracking::build_track_index - missing SvtxTrackMap" << endl;
+    return;
+  }
+
+  SvtxClusterEval *clustereval = _svtxEvalStack->get_cluster_eval();
+  assert(clustereval);
+
+  // number of clusters of the best track so far, per truth track id
+  map<int, unsigned int> best_nclusters;
+  // number of clusters of the current track, per truth particle
+  map<PHG4Particle *, unsigned int> nclusters;
+
+  for (SvtxTrackMap::Iter iter = trackmap->begin(); iter != trackmap->end(); ++iter)
+  {
+    SvtxTrack *track = iter->second;
+
+    nclusters.clear();
+    for (auto cluster_iter = track->begin_cluster_keys(); cluster_iter != track->end_cluster_keys(); ++cluster_iter)
+    {
+      const set<PHG4Particle *> particles = clustereval->all_truth_particles(*cluster_iter);
+      for (set<PHG4Particle *>::const_iterator jter = particles.begin(); jter != particles.end(); ++jter)
+      {
+        ++nclusters[*jter];
+      }
+    }
+
+    // same tie breaking as the track eval: first particle and track in pointer order
+    PHG4Particle *max_particle = nullptr;
+    unsigned int max_nclusters = 0;
+    for (map<PHG4Particle *, unsigned int>::const_iterator jter = nclusters.begin(); jter != nclusters.end(); ++jter)
+    {
+      if (jter->second > max_nclusters)
+      {
+        max_nclusters = jter->second;
+        max_particle = jter->first;
+      }
+
+      const int truth_id = jter->first->get_track_id();
+      map<int, unsigned int>::iterator best_iter = best_nclusters.find(truth_id);
+      if (best_iter == best_nclusters.end())
+      {
+        best_nclusters[truth_id] = jter->second;
+        m_bestTrack[truth_id] = track;
+      }
+      else if (jter->second > best_iter->second ||
+               (jter->second == best_iter->second && track < m_bestTrack[truth_id]))
+      {
+        best_iter->second = jter->second;
+        m_bestTrack[truth_id] = track;
+      }
+    }
+    m_maxParticle[track] = max_particle;
+  }
+}
+
 string
 QAG4SimulationTracking::get_histo_prefix()
 {
@@ -1,8 +1,11 @@
 #ifndef QA_QAG4SimulationTracking_H
 #define QA_QAG4SimulationTracking_H
 
+#include "QASampling.h"
+
 #include <fun4all/SubsysReco.h>
 
+#include <map>
 #include <memory>
 #include <set>
 #include <string>
@@ -31,6 +34,7 @@ class QAG4SimulationTracking : public SubsysReco
   int Init(PHCompositeNode *topNode);
   int InitRun(PHCompositeNode *topNode);
   int process_event(PHCompositeNode *topNode);
+  int End(PHCompositeNode *topNode);
 
   // common prefix for QA histograms
   std::string get_histo_prefix();
@@ -53,13 +57,30 @@ class QAG4SimulationTracking : public SubsysReco
     m_uniqueTrackingMatch = b;
   }
 
+  //! analyze one event out of n (default 1, all events)
+  void setEveryNEvents(unsigned int n) { m_sampling.set_every_n_events(n); }
+
+  //! analyze a random sample of at most n primary truth particles per event (default 0, all)
+  void setMaxTruthParticles(unsigned int n) { m_sampling.set_max_particles(n); }
+
  private:
+  //! reco<->truth association of the event, from one pass over the track clusters
+  void build_track_index(PHCompositeNode *topNode);
+
+
 #if !defined(__CINT__) || defined(__CLING__)
   //CINT is not c++11 compatible
   std::shared_ptr<SvtxEvalStack> _svtxEvalStack;
   std::set<int> m_embeddingIDs;
+
+  //! truth track id -> best track, as SvtxTrackEval::best_track_from
+  std::map<int, SvtxTrack *> m_bestTrack;
+  //! track -> truth particle with most clusters, as SvtxTrackEval::max_truth_particle_by_nclusters
+  std::map<SvtxTrack *, PHG4Particle *> m_maxParticle;
 #endif
 
+  QASampling m_sampling;
+
   //! range of the truth track eta to be analyzed
   std::pair<double, double> m_etaRange;
 
@@ -161,38 +161,38 @@ int QAG4SimulationUpsilon::process_event(PHCompositeNode *topNode)
   assert(trutheval);
 
   // reco pT / gen pT histogram
-  TH1 *h_pTRecoGenRatio = dynamic_cast<TH1 *>(hm->getHisto(get_histo_prefix() + "pTRecoGenRatio"));
+  TH1 *h_pTRecoGenRatio = dynamic_cast<TH1 *>(hm->getThreadHisto(get_histo_prefix() + "pTRecoGenRatio"));
   assert(h_pTRecoGenRatio);
 
   // reco pT / gen pT histogram
-  TH2 *h_pTRecoGenRatio_pTGen = dynamic_cast<TH2 *>(hm->getHisto(get_histo_prefix() + "pTRecoGenRatio_pTGen"));
+  TH2 *h_pTRecoGenRatio_pTGen = dynamic_cast<TH2 *>(hm->getThreadHisto(get_histo_prefix() + "pTRecoGenRatio_pTGen"));
   assert(h_pTRecoGenRatio);
 
   // reco histogram plotted at gen pT
-  TH1 *h_nReco_pTGen = dynamic_cast<TH1 *>(hm->getHisto(get_histo_prefix() + "nReco_pTGen"));
+  TH1 *h_nReco_pTGen = dynamic_cast<TH1 *>(hm->getThreadHisto(get_histo_prefix() + "nReco_pTGen"));
   assert(h_nReco_pTGen);
 
   // gen pT histogram
-  TH1 *h_nGen_pTGen = dynamic_cast<TH1 *>(hm->getHisto(get_histo_prefix() + "nGen_pTGen"));
+  TH1 *h_nGen_pTGen = dynamic_cast<TH1 *>(hm->getThreadHisto(get_histo_prefix() + "nGen_pTGen"));
   assert(h_nGen_pTGen);
 
   // reco histogram plotted at gen eta
-  TH1 *h_nReco_etaGen = dynamic_cast<TH1 *>(hm->getHisto(get_histo_prefix() + "nReco_etaGen"));
+  TH1 *h_nReco_etaGen = dynamic_cast<TH1 *>(hm->getThreadHisto(get_histo_prefix() + "nReco_etaGen"));
   assert(h_nReco_etaGen);
 
   // gen eta histogram
-  TH1 *h_nGen_etaGen = dynamic_cast<TH1 *>(hm->getHisto(get_histo_prefix() + "nGen_etaGen"));
+  TH1 *h_nGen_etaGen = dynamic_cast<TH1 *>(hm->getThreadHisto(get_histo_prefix() + "nGen_etaGen"));
   assert(h_nGen_etaGen);
 
   // inv mass
-  TH1 *h_nGen_Pair_InvMassGen = dynamic_cast<TH1 *>(hm->getHisto(get_histo_prefix() + "nGen_Pair_InvMassGen"));
+  TH1 *h_nGen_Pair_InvMassGen = dynamic_cast<TH1 *>(hm->getThreadHisto(get_histo_prefix() + "nGen_Pair_InvMassGen"));
   assert(h_nGen_etaGen);
   // inv mass
-  TH1 *h_nReco_Pair_InvMassReco = dynamic_cast<TH1 *>(hm->getHisto(get_histo_prefix() + "nReco_Pair_InvMassReco"));
+  TH1 *h_nReco_Pair_InvMassReco = dynamic_cast<TH1 *>(hm->getThreadHisto(get_histo_prefix() + "nReco_Pair_InvMassReco"));
   assert(h_nGen_etaGen);
 
   // n events and n tracks histogram
-  TH1 *h_norm = dynamic_cast<TH1 *>(hm->getHisto(get_histo_prefix() + "Normalization"));
+  TH1 *h_norm = dynamic_cast<TH1 *>(hm->getThreadHisto(get_histo_prefix() + "Normalization"));
   assert(h_norm);
   h_norm->Fill("Event", 1);
 
@@ -0,0 +1,77 @@
+#include "QASampling.h"
+
+#include <algorithm>  // for sort
+#include <iostream>
+
+using namespace std;
+
+namespace
+{
+  //! splitmix64 finalizer, stateless random numbers from the event and particle counts
+  uint64_t mix(uint64_t x)
+  {
+    x += 0x9e3779b97f4a7c15ULL;
+    x = (x ^ (x >> 30)) * 0xbf58476d1ce4e5b9ULL;
+    x = (x ^ (x >> 27)) * 0x94d049bb133111ebULL;
+    return x ^ (x >> 31);
+  }
+}  // namespace
+
+QASampling::QASampling()
+  : m_everyNEvents(1)
+  , m_maxParticles(0)
+  , m_seed(0)
+  , m_nEvents(0)
+  , m_nAccepted(0)
+{
+}
+
+bool QASampling::accept_event(uint64_t &ievent)
+{
+  ievent = m_nEvents++;
+  if (ievent % m_everyNEvents) return false;
+  ++m_nAccepted;
+  return true;
+}
+
+void QASampling::sample(const uint64_t ievent, const unsigned int n, vector<unsigned int> &selected) const
+{
+  selected.clear();
+  if (m_maxParticles == 0 || n <= m_maxParticles)
+  {
+    selected.reserve(n);
+    for (unsigned int i = 0; i < n; ++i) selected.push_back(i);
+    return;
+  }
+
+  // reservoir sampling (algorithm R)
+  selected.reserve(m_maxParticles);
+  for (unsigned int i = 0; i < m_maxParticles; ++i) selected.push_back(i);
+
+  const uint64_t event_seed = mix(m_seed ^ mix(ievent));
+  for (unsigned int i = m_maxParticles; i < n; ++i)
+  {
+    const uint64_t j = mix(event_seed + i) % (i + 1);
+    if (j < m_maxParticles) selected[j] = i;
+  }
+  sort(selected.begin(), selected.end());
+}
+
+uint64_t QASampling::get_nevents() const
+{
+  return m_nEvents;
+}
+
+uint64_t QASampling::get_naccepted() const
+{
+  return m_nAccepted;
+}
+
+void QASampling::print(const string &name) const
+{
+  cout << name << " - analyzed " << get_naccepted() << " of " << get_nevents() << " events"
+       << " (every " << m_everyNEvents << " events";
+  if (m_maxParticles)
+    cout << ", at most " << m_maxParticles << " truth particles per event";
+  cout << ")" << endl;
+}
@@ -0,0 +1,67 @@
+#ifndef QA_QASAMPLING_H
+#define QA_QASAMPLING_H
+
+/*!
+ * \file QASampling.h
+ * \brief event prescale and per event truth particle sample for the QA modules
+ *
+ * Lets the QA modules run in production jobs at a bounded cost: only every
+ * Nth event is analyzed, and of an analyzed event at most a fixed number of
+ * truth particles (a uniform reservoir sample). The sample only depends on
+ * the seed, the event count and the number of candidates, so it is the same
+ * whichever thread processes the event. The "Event" entry of the
+ * Normalization histograms counts the analyzed events only.
+ */
+
+#include <string>
+#include <vector>
+
+#if !defined(__CINT__) || defined(__CLING__)
+#include <atomic>
+#include <cstdint>
+#else
+#include <stdint.h>
+#endif
+
+class QASampling
+{
+ public:
+  QASampling();
+  virtual ~QASampling() {}
+
+  //! analyze one event out of n, 1 (default) analyzes all events
+  void set_every_n_events(const unsigned int n) { m_everyNEvents = (n > 0) ? n : 1; }
+  unsigned int get_every_n_events() const { return m_everyNEvents; }
+
+  //! at most n sampled truth particles per analyzed event, 0 (default) is all
+  void set_max_particles(const unsigned int n) { m_maxParticles = n; }
+  unsigned int get_max_particles() const { return m_maxParticles; }
+
+  //! seed of the particle sample
+  void set_seed(const uint64_t seed) { m_seed = seed; }
+
+  //! counts the event, true if it is analyzed. ievent is the count of this event
+  bool accept_event(uint64_t &ievent);
+
+  //! indices (sorted) of the particles to analyze out of n candidates
+  void sample(const uint64_t ievent, const unsigned int n, std::vector<unsigned int> &selected) const;
+
+  //! events seen and analyzed so far
+  uint64_t get_nevents() const;
+  uint64_t get_naccepted() const;
+
+  void print(const std::string &name) const;
+
+ private:
+  unsigned int m_everyNEvents;
+  unsigned int m_maxParticles;
+  uint64_t m_seed;
+
+#if !defined(__CINT__) || defined(__CLING__)
+  //CINT is not c++11 compatible
+  std::atomic<uint64_t> m_nEvents;
+  std::atomic<uint64_t> m_nAccepted;
+#endif
+};
+
+#endif  // QA_QASAMPLING_H
@@ -44,11 +44,22 @@
 #include <cstdlib>
 #include <ctime>
 #include <iostream>
+#include <mutex>
 #include <sstream>
 
 using namespace std;
 
+namespace
+{
+  // the bank manager has a single DB connection, fetches from the
+  // Fun4AllServer calibration prefetch threads have to take turns
+  mutex dbmutex;
+}  // namespace
+
 PHParameters::PHParameters(const PHParameters &params, const std::string &name)
+  : m_Hash(0)
+  , m_HashValid(false)
+  , m_SyncedMap(nullptr)
 {
   set_name(name);
   FillFrom(&params);
@@ -64,6 +75,13 @@ PHParameters::~PHParameters()
 void PHParameters::set_int_param(const std::string &name, const int ival)
 {
   m_IntParMap[name] = ival;
+  m_HashValid = false;
+  m_ChangedInt.insert(name);
+  auto iter = m_IntHandles.find(name);
+  if (iter != m_IntHandles.end())
+  {
+    m_IntValues[iter->second] = ival;
+  }
 }
 
 int PHParameters::get_int_param(const std::string &name) const
@@ -106,6 +124,13 @@ void PHParameters::printint() const
 void PHParameters::set_double_param(const std::string &name, const double dval)
 {
   m_DoubleParMap[name] = dval;
+  m_HashValid = false;
+  m_ChangedDouble.insert(name);
+  auto iter = m_DoubleHandles.find(name);
+  if (iter != m_DoubleHandles.end())
+  {
+    m_DoubleValues[iter->second] = dval;
+  }
 }
 
 double
@@ -145,9 +170,41 @@ void PHParameters::Print(Option_t *option) const
   return;
 }
 
+unsigned int PHParameters::get_int_param_handle(const std::string &name) const
+{
+  auto iter = m_IntHandles.find(name);
+  if (iter != m_IntHandles.end())
+  {
+    return iter->second;
+  }
+  // exits if the parameter does not exist
+  int ival = get_int_param(name);
+  m_IntValues.push_back(ival);
+  m_IntHandles[name] = m_IntValues.size() - 1;
+  return m_IntValues.size() - 1;
+}
+
+unsigned int PHParameters::get_double_param_handle(const std::string &name) const
+{
+  auto iter = m_DoubleHandles.find(name);
+  if (iter != m_DoubleHandles.end())
+  {
+    return iter->second;
+  }
+  // exits if the parameter does not exist
+  double dval = get_double_param(name);
+  m_DoubleValues.push_back(dval);
+  m_DoubleHandles[name] = m_DoubleValues.size() - 1;
+  return m_DoubleValues.size() - 1;
+}
+
 size_t
 PHParameters::get_hash() const
 {
+  if (m_HashValid)
+  {
+    return m_Hash;
+  }
   size_t seed = 0;
 
   for (dMap::const_iterator iter = m_DoubleParMap.begin();
@@ -177,6 +234,8 @@ PHParameters::get_hash() const
     //      cout << iter->first << ": " << iter->second <<" -> "<<seed<< endl;
   }
 
+  m_Hash = seed;
+  m_HashValid = true;
   return seed;
 }
 
@@ -194,6 +253,8 @@ void PHParameters::printdouble() const
 void PHParameters::set_string_param(const std::string &name, const string &str)
 {
   m_StringParMap[name] = str;
+  m_HashValid = false;
+  m_ChangedString.insert(name);
 }
 
 string
@@ -245,7 +306,7 @@ void PHParameters::FillFrom(const PdbParameterMap *saveparams)
   for (map<const std::string, double>::const_iterator iter = begin_end_d.first;
        iter != begin_end_d.second; ++iter)
   {
-    m_DoubleParMap[iter->first] = iter->second;
+    set_double_param(iter->first, iter->second);
   }
   pair<std::map<const std::string, int>::const_iterator,
        std::map<const std::string, int>::const_iterator>
@@ -254,7 +315,7 @@ void PHParameters::FillFrom(const PdbParameterMap *saveparams)
   for (map<const std::string, int>::const_iterator iter = begin_end_i.first;
        iter != begin_end_i.second; ++iter)
   {
-    m_IntParMap[iter->first] = iter->second;
+    set_int_param(iter->first, iter->second);
   }
   pair<std::map<const std::string, string>::const_iterator,
        std::map<const std::string, string>::const_iterator>
@@ -263,7 +324,7 @@ void PHParameters::FillFrom(const PdbParameterMap *saveparams)
   for (map<const std::string, string>::const_iterator iter = begin_end_s.first;
        iter != begin_end_s.second; ++iter)
   {
-    m_StringParMap[iter->first] = iter->second;
+    set_string_param(iter->first, iter->second);
   }
 
   return;
@@ -285,7 +346,7 @@ void PHParameters::FillFrom(const PdbParameterMapContainer *saveparamcontainer,
   for (map<const std::string, double>::const_iterator iter = begin_end_d.first;
        iter != begin_end_d.second; ++iter)
   {
-    m_DoubleParMap[iter->first] = iter->second;
+    set_double_param(iter->first, iter->second);
   }
   pair<std::map<const std::string, int>::const_iterator,
        std::map<const std::string, int>::const_iterator>
@@ -294,7 +355,7 @@ void PHParameters::FillFrom(const PdbParameterMapContainer *saveparamcontainer,
   for (map<const std::string, int>::const_iterator iter = begin_end_i.first;
        iter != begin_end_i.second; ++iter)
   {
-    m_IntParMap[iter->first] = iter->second;
+    set_int_param(iter->first, iter->second);
   }
   pair<std::map<const std::string, string>::const_iterator,
        std::map<const std::string, string>::const_iterator>
@@ -303,7 +364,7 @@ void PHParameters::FillFrom(const PdbParameterMapContainer *saveparamcontainer,
   for (map<const std::string, string>::const_iterator iter = begin_end_s.first;
        iter != begin_end_s.second; ++iter)
   {
-    m_StringParMap[iter->first] = iter->second;
+    set_string_param(iter->first, iter->second);
   }
 
   return;
@@ -315,15 +376,15 @@ void PHParameters::FillFrom(const PHParameters *saveparams)
 
   for (dMap::const_iterator iter = saveparams->m_DoubleParMap.begin();
        iter != saveparams->m_DoubleParMap.end(); ++iter)
-    m_DoubleParMap[iter->first] = iter->second;
+    set_double_param(iter->first, iter->second);
 
   for (iMap::const_iterator iter = saveparams->m_IntParMap.begin();
        iter != saveparams->m_IntParMap.end(); ++iter)
-    m_IntParMap[iter->first] = iter->second;
+    set_int_param(iter->first, iter->second);
 
   for (strMap::const_iterator iter = saveparams->m_StringParMap.begin();
        iter != saveparams->m_StringParMap.end(); ++iter)
-    m_StringParMap[iter->first] = iter->second;
+    set_string_param(iter->first, iter->second);
 
   return;
 }
@@ -345,6 +406,7 @@ void PHParameters::SaveToNodeTree(PHCompositeNode *topNode, const string &nodena
     nodeparams->Reset();  // just clear previous content in case variables were deleted
   }
   CopyToPdbParameterMap(nodeparams);
+  Synced(nodeparams);
   return;
 }
 
@@ -358,7 +420,15 @@ void PHParameters::UpdateNodeTree(PHCompositeNode *topNode, const string &nodena
          << " which must exist" << endl;
     gSystem->Exit(1);
   }
-  CopyToPdbParameterMap(nodeparams);
+  if (nodeparams == m_SyncedMap)
+  {
+    CopyChangedToPdbParameterMap(nodeparams);
+  }
+  else
+  {
+    CopyToPdbParameterMap(nodeparams);
+  }
+  Synced(nodeparams);
   return;
 }
 
@@ -384,6 +454,7 @@ void PHParameters::SaveToNodeTree(PHCompositeNode *topNode, const string &nodena
     nodeparamcontainer->AddPdbParameterMap(detid, nodeparams);
   }
   CopyToPdbParameterMap(nodeparams);
+  Synced(nodeparams);
   return;
 }
 
@@ -403,7 +474,15 @@ void PHParameters::UpdateNodeTree(PHCompositeNode *topNode, const string &nodena
          << " which must exist" << endl;
     gSystem->Exit(1);
   }
-  CopyToPdbParameterMap(nodeparams);
+  if (nodeparams == m_SyncedMap)
+  {
+    CopyChangedToPdbParameterMap(nodeparams);
+  }
+  else
+  {
+    CopyToPdbParameterMap(nodeparams);
+  }
+  Synced(nodeparams);
   return;
 }
 
@@ -447,6 +526,7 @@ int PHParameters::WriteToDB()
 
 int PHParameters::ReadFromDB(const string &name, const int detid)
 {
+  lock_guard<mutex> lock(dbmutex);
   PdbBankManager *bankManager = PdbBankManager::instance();
   PdbApplication *application = bankManager->getApplication();
   if (!application->startRead())
@@ -482,6 +562,7 @@ int PHParameters::ReadFromDB(const string &name, const int detid)
 
 int PHParameters::ReadFromDB()
 {
+  lock_guard<mutex> lock(dbmutex);
   PdbBankManager *bankManager = PdbBankManager::instance();
   PdbApplication *application = bankManager->getApplication();
   if (!application->startRead())
@@ -663,6 +744,30 @@ void PHParameters::CopyToPdbParameterMap(PdbParameterMap *myparm)
   }
 }
 
+void PHParameters::CopyChangedToPdbParameterMap(PdbParameterMap *myparm) const
+{
+  for (auto &name : m_ChangedDouble)
+  {
+    myparm->set_double_param(name, m_DoubleParMap.find(name)->second);
+  }
+  for (auto &name : m_ChangedInt)
+  {
+    myparm->set_int_param(name, m_IntParMap.find(name)->second);
+  }
+  for (auto &name : m_ChangedString)
+  {
+    myparm->set_string_param(name, m_StringParMap.find(name)->second);
+  }
+}
+
+void PHParameters::Synced(PdbParameterMap *myparm)
+{
+  m_SyncedMap = myparm;
+  m_ChangedDouble.clear();
+  m_ChangedInt.clear();
+  m_ChangedString.clear();
+}
+
 unsigned int
 PHParameters::ConvertStringToUint(const std::string &str) const
 {
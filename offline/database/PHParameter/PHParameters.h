@@ -7,8 +7,10 @@
 
 #include <cstddef>
 #include <map>
+#include <set>
 #include <string>
 #include <utility>
+#include <vector>
 
 class PdbParameterMap;
 class PdbParameterMapContainer;
@@ -29,6 +31,9 @@ class PHParameters : public PHObject
 
   explicit PHParameters(const std::string &name)
     : m_Detector(name)
+    , m_Hash(0)
+    , m_HashValid(false)
+    , m_SyncedMap(nullptr)
   {
   }
   PHParameters(const PHParameters &params, const std::string &name);
@@ -37,9 +42,17 @@ class PHParameters : public PHObject
 
   void Print(Option_t *option = "") const;
 
-  //! hash of binary information for checking purpose
+  //! hash of binary information for checking purpose, recalculated only after changes
   size_t get_hash() const;
 
+  //! Handles for parameters read in per hit code: resolve the name once (exits
+  //! like the get methods if it does not exist), then the value is an array access.
+  //! Handles stay valid and follow later set calls
+  unsigned int get_int_param_handle(const std::string &name) const;
+  int get_int_param(const unsigned int handle) const { return m_IntValues[handle]; }
+  unsigned int get_double_param_handle(const std::string &name) const;
+  double get_double_param(const unsigned int handle) const { return m_DoubleValues[handle]; }
+
   void set_int_param(const std::string &name, const int ival);
   int get_int_param(const std::string &name) const;
   bool exist_int_param(const std::string &name) const;
@@ -91,11 +104,29 @@ class PHParameters : public PHObject
 
  private:
   unsigned int ConvertStringToUint(const std::string &str) const;
+  //! copy parameters changed since the last save or update
+  void CopyChangedToPdbParameterMap(PdbParameterMap *myparm) const;
+  //! node tree map which holds our parameters, only changes need to be copied there
+  void Synced(PdbParameterMap *myparm);
   std::string m_Detector;
   dMap m_DoubleParMap;
   iMap m_IntParMap;
   strMap m_StringParMap;
 
+  mutable size_t m_Hash;
+  mutable bool m_HashValid;
+
+  // flat values for handles, indices in order of handle creation
+  mutable std::map<const std::string, unsigned int> m_IntHandles;
+  mutable std::vector<int> m_IntValues;
+  mutable std::map<const std::string, unsigned int> m_DoubleHandles;
+  mutable std::vector<double> m_DoubleValues;
+
+  PdbParameterMap *m_SyncedMap;
+  std::set<std::string> m_ChangedInt;
+  std::set<std::string> m_ChangedDouble;
+  std::set<std::string> m_ChangedString;
+
   //No Class Def since this class is not intended to be persistent
 };
 
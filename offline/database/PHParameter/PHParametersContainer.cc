@@ -18,6 +18,7 @@
 #include <TFile.h>
 #include <TSystem.h>
 
+#include <boost/functional/hash.hpp>
 #include <boost/stacktrace.hpp>
 
 #include <unistd.h>
@@ -273,3 +274,14 @@ int PHParametersContainer::ExistDetid(const int detid) const
   }
   return 0;
 }
+
+size_t PHParametersContainer::get_hash() const
+{
+  size_t seed = 0;
+  for (auto &iter : parametermap)
+  {
+    boost::hash_combine(seed, iter.first);
+    boost::hash_combine(seed, iter.second->get_hash());
+  }
+  return seed;
+}
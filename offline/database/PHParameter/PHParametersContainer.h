@@ -5,6 +5,7 @@
 
 #include <phool/PHObject.h>
 
+#include <cstddef>
 #include <map>
 #include <string>
 #include <utility>
@@ -35,10 +36,13 @@ class PHParametersContainer : public PHObject
   std::string Name() const { return superdetectorname; }
   //  std::pair<std::map<int, PHParameters *>::const_iterator,  std::map<int, PHParameters *>::const_iterator> GetAllParameters() {return std::make_pair(parametermap.begin(),parametermap.end());}
   ConstRange GetAllParameters() const { return std::make_pair(parametermap.begin(), parametermap.end()); }
+  Range GetAllParametersToModify() { return std::make_pair(parametermap.begin(), parametermap.end()); }
   void Print(Option_t *option = "") const;
   void SaveToNodeTree(PHCompositeNode *topNode, const std::string &nodename);
   void UpdateNodeTree(PHCompositeNode *topNode, const std::string &nodename);
   int ExistDetid(const int detid) const;
+  //! combined hash of the detids and their parameters
+  size_t get_hash() const;
   void clear() { parametermap.clear(); }
   void FillFrom(const PdbParameterMapContainer *saveparamcontainer);
   void CreateAndFillFrom(const PdbParameterMapContainer *saveparamcontainer, const std::string &name);
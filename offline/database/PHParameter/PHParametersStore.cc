@@ -0,0 +1,90 @@
+#include "PHParametersStore.h"
+#include "PHParameters.h"
+
+#include <phool/PHCompositeNode.h>
+#include <phool/PHDataNode.h>
+#include <phool/PHNodeIterator.h>
+#include <phool/getClass.h>
+#include <phool/phool.h>
+
+#include <iostream>
+
+using namespace std;
+
+namespace
+{
+  const string storenodename = "G4GEOPARAM_STORE";
+}
+
+void PHParametersStore::Print(Option_t * /*option*/) const
+{
+  cout << "PHParametersStore with " << m_ParamsMap.size() << " entries" << endl;
+  for (map<Key, Entry>::const_iterator iter = m_ParamsMap.begin(); iter != m_ParamsMap.end(); ++iter)
+  {
+    cout << "detector " << iter->first.first << ", layer " << iter->first.second << endl;
+    iter->second.params->Print();
+  }
+}
+
+PHParametersStore *PHParametersStore::GetStore(PHCompositeNode *topNode, const bool create)
+{
+  PHParametersStore *store = findNode::getClass<PHParametersStore>(topNode, storenodename);
+  if (store || !create)
+  {
+    return store;
+  }
+  PHNodeIterator iter(topNode);
+  PHCompositeNode *parNode = dynamic_cast<PHCompositeNode *>(iter.findFirst("PHCompositeNode", "PAR"));
+  if (!parNode)
+  {
+    cout << PHWHERE << " no PAR node" << endl;
+    return nullptr;
+  }
+  store = new PHParametersStore();
+  parNode->addNode(new PHDataNode<PHParametersStore>(store, storenodename));
+  return store;
+}
+
+void PHParametersStore::Register(const string &detector, const int layer, PHParameters *params, const bool superdetector)
+{
+  Entry &entry = m_ParamsMap[make_pair(detector, layer)];
+  entry.params = params;
+  entry.superdetector = superdetector;
+}
+
+const PHParameters *PHParametersStore::GetParameters(const string &detector, const int layer) const
+{
+  map<Key, Entry>::const_iterator iter = m_ParamsMap.find(make_pair(detector, layer));
+  if (iter == m_ParamsMap.end())
+  {
+    return nullptr;
+  }
+  return iter->second.params;
+}
+
+void PHParametersStore::SaveToNodeTree(PHCompositeNode *runNode)
+{
+  // the map is sorted by detector, the node of a detector is looked up once for all its layers
+  PHCompositeNode *detNode = nullptr;
+  string lastdetector;
+  PHNodeIterator runIter(runNode);
+  for (map<Key, Entry>::const_iterator iter = m_ParamsMap.begin(); iter != m_ParamsMap.end(); ++iter)
+  {
+    const string &detector = iter->first.first;
+    if (!detNode || detector != lastdetector)
+    {
+      lastdetector = detector;
+      detNode = runNode;
+      if (iter->second.superdetector)
+      {
+        detNode = dynamic_cast<PHCompositeNode *>(runIter.findFirst("PHCompositeNode", detector));
+        if (!detNode)
+        {
+          detNode = new PHCompositeNode(detector);
+          runNode->addNode(detNode);
+        }
+      }
+    }
+    iter->second.params->SaveToNodeTree(detNode, "G4GEOPARAM_" + detector, iter->first.second);
+  }
+}
@@ -0,0 +1,56 @@
+// Tell emacs that this is a C++ source
+//  -*- C++ -*-.
+#ifndef PHPARAMETER_PHPARAMETERSSTORE_H
+#define PHPARAMETER_PHPARAMETERSSTORE_H
+
+#include <phool/PHObject.h>
+
+#include <map>
+#include <string>
+#include <utility>
+
+class PHCompositeNode;
+class PHParameters;
+
+/*!
+ * \brief registry of the geometry parameters of all detectors, keyed by (detector, layer)
+ *
+ * The store lives on the PAR node. It does not copy or own the parameters, the
+ * subsystems register the objects they already have and readers get a const
+ * pointer to the one instance. SaveToNodeTree() writes everything into the
+ * G4GEOPARAM_<detector> containers of the RUN node in one go, after all
+ * subsystems are initialized.
+ */
+class PHParametersStore : public PHObject
+{
+ public:
+  typedef std::pair<std::string, int> Key;
+
+  PHParametersStore() {}
+  virtual ~PHParametersStore() {}
+
+  void Print(Option_t *option = "") const;
+  void Reset() { m_ParamsMap.clear(); }
+
+  //! find the store on the node tree, create it under PAR if requested
+  static PHParametersStore *GetStore(PHCompositeNode *topNode, const bool create = false);
+
+  //! params of a super detector are saved in a node named after it
+  void Register(const std::string &detector, const int layer, PHParameters *params, const bool superdetector);
+  const PHParameters *GetParameters(const std::string &detector, const int layer) const;
+
+  //! write all registered parameters to the node tree under runNode
+  void SaveToNodeTree(PHCompositeNode *runNode);
+
+ private:
+  struct Entry
+  {
+    PHParameters *params;
+    bool superdetector;
+  };
+  std::map<Key, Entry> m_ParamsMap;
+
+  //No Class Def since this class is not intended to be persistent
+};
+
+#endif  // PHPARAMETER_PHPARAMETERSSTORE_H
@@ -32,6 +32,7 @@ class PgPostApplication : public PdbApplication
   static int releaseConnection();
   static PgPostApplication *instance();
   int setDBName(const std::string &name);
+  std::string getDBName() const { return dsn; }
   int DisconnectDB();
 
  protected:
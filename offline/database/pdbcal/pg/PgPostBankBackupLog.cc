@@ -4,6 +4,8 @@
 #include <RDBC/TSQLConnection.h>
 #include <RDBC/TSQLDriverManager.h>
 #include <RDBC/TSQLPreparedStatement.h>
+#include <RDBC/TSQLResultSet.h>
+#include <RDBC/TSQLStatement.h>
 
 #include <TString.h>
 
@@ -12,10 +14,18 @@
 #include <exception>
 #include <fstream>
 #include <iostream>
+#include <memory>
+#include <mutex>
 #include <sstream>
 
 using namespace std;
 
+namespace
+{
+// serializes the use of the shared connection by parallel backups
+mutex logmutex;
+}  // namespace
+
 PgPostBankBackupLog::TSQLConnection_PTR PgPostBankBackupLog::con(
     static_cast<TSQLConnection*>(nullptr));
 
@@ -84,6 +94,7 @@ void PgPostBankBackupLog::Init()
 
 void PgPostBankBackupLog::Log(const int rid, const enu_ops ops)
 {
+  lock_guard<mutex> lock(logmutex);
   Init();
 
   if (Verbosity() >= 2)
@@ -119,3 +130,34 @@ void PgPostBankBackupLog::Log(const int rid, const enu_ops ops)
     exit(1);
   }
 }
+
+vector<int> PgPostBankBackupLog::getLoggedRIds(const enu_ops ops)
+{
+  lock_guard<mutex> lock(logmutex);
+  Init();
+
+  ostringstream sqlcmd;
+  sqlcmd << "select rid from calib_log where tablename = '" << tablename
+         << "' and tag = '" << tag << "' and ops = " << (int) ops << ";";
+  if (Verbosity() >= 1)
+    cout << "PgPostBankBackupLog::getLoggedRIds - " << sqlcmd.str() << endl;
+
+  vector<int> rids;
+  try
+  {
+    TSQLStatement* stmt = con->CreateStatement();
+    std::unique_ptr<TSQLResultSet> rs(stmt->ExecuteQuery(sqlcmd.str().c_str()));
+    while ((rs) && rs->Next())
+    {
+      rids.push_back(rs->GetInt(1));
+    }
+  }
+  catch (TSQLException& e)
+  {
+    cout << "PgPostBankBackupLog::getLoggedRIds - Error - "
+         << " Exception caught during query" << endl;
+    cout << e.GetMessage() << endl;
+    exit(1);
+  }
+  return rids;
+}
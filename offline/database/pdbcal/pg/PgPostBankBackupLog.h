@@ -14,6 +14,7 @@
 #define PDBCALPG_PGPOSTBANKBACKUPLOG_H
 
 #include <string>
+#include <vector>
 
 class TSQLConnection;
 class TSQLPreparedStatement;
@@ -53,10 +54,14 @@ class PgPostBankBackupLog
 
     //! use in PgPostBankBackupManager::fetchAllBank2TFile
     kOptBackup2File = 10,
+    //! use in PgPostBankBackupManager::parallelFetchAllBank2TFile, rid is the first of the chunk
+    kOptBackup2File_Chunk = 11,
 
     //! use in PgPostBankBackupManager::commitAllBankfromTFile
     kOptFile2Db = 20,
     kOptFile2Db_Skip = 21,
+    //! use in PgPostBankBackupManager::parallelCommitAllBankfromTFiles, rid is the first of the chunk
+    kOptFile2Db_Chunk = 22,
 
     //! use in PgPostBankBackupManager::dumpTable
     kOptDump = 30,
@@ -69,10 +74,14 @@ class PgPostBankBackupLog
   void
   Init();
 
-  //! enter one log entry
+  //! enter one log entry. Thread safe, all logs share one connection
   void
   Log(const int rid, const enu_ops ops);
 
+  //! rids logged with ops for this table and tag, used to resume interrupted operations
+  std::vector<int>
+  getLoggedRIds(const enu_ops ops);
+
  protected:
   //! The verbosity level. 0 means not verbose at all.
   int verbosity;
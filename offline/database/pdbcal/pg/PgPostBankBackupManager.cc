@@ -24,6 +24,7 @@
 
 #include <RDBC/TSQL.h>
 #include <RDBC/TSQLConnection.h>
+#include <RDBC/TSQLDriverManager.h>
 #include <RDBC/TSQLPreparedStatement.h>
 #include <RDBC/TSQLResultSet.h>
 #include <RDBC/TSQLStatement.h>
@@ -36,9 +37,11 @@
 #include <TKey.h>
 #include <TList.h>
 #include <TObject.h>                     // for TObject, TObject::kWriteDelete
+#include <TROOT.h>
 #include <TString.h>
 
 #include <algorithm>
+#include <atomic>
 #include <cassert>
 #include <cstdlib>
 #include <exception>
@@ -46,15 +49,65 @@
 #include <iostream>
 #include <map>
 #include <memory>
+#include <mutex>
+#include <set>
 #include <sstream>
+#include <thread>
 #include <utility>
 #include <vector>
 
 using namespace std;
 
+namespace
+{
+// serializes opening and closing of the worker connections
+mutex connectionmutex;
+
+TSQLConnection *NewConnection()
+{
+  PgPostApplication *ap = PgPostApplication::instance();
+  if (!ap)
+  {
+    cout << "PgPostBankBackupManager - ERROR - "
+         << " PgPostApplication instance is nullptr, exiting" << endl;
+    exit(1);
+  }
+  lock_guard<mutex> lock(connectionmutex);
+  ostringstream constr;
+  constr << "dsn=" << ap->getDBName() << "; uid=phnxrc; pwd= ";
+  TSQLConnection *con = gSQLDriverManager->GetConnection(constr.str().c_str());
+  if (!con)
+  {
+    cout << "PgPostBankBackupManager - ERROR - "
+         << " Cannot get TSQLConnection to " << ap->getDBName() << ", exiting" << endl;
+    exit(1);
+  }
+  return con;
+}
+
+void CloseConnection(TSQLConnection *con)
+{
+  lock_guard<mutex> lock(connectionmutex);
+  con->Close();
+  delete con;
+}
+
+// statements belong to the connection, remove them when done
+void DeleteStatement(TSQLConnection *con, TObject *stmt)
+{
+  TList *sl = con->GetListOfStatements();
+  if (sl)
+  {
+    sl->Remove(stmt);
+  }
+  delete stmt;
+}
+}  // namespace
+
 PgPostBankBackupManager::PgPostBankBackupManager(const std::string &Tag)
   : verbosity(0)
   , tag(Tag)
+  , compression(-1)
 {
   if (tag.length() == 0)
   {
@@ -1035,6 +1088,354 @@ int PgPostBankBackupManager::fetchAllBank2TFile(const std::string &bankName,
   return cnt;
 }
 
+//! Database -> TFiles in parallel chunks of rids
+int PgPostBankBackupManager::parallelFetchAllBank2TFile(const std::string &bankName,
+                                                        const std::string &record_selection, const std::string &out_file_base,
+                                                        const int nthreads, const int chunk_size)
+{
+  rid_list_t rids = getListOfRId(bankName, record_selection);
+  if (rids.empty())
+  {
+    cout << "PgPostBankBackupManager::parallelFetchAllBank2TFile - WARNING - "
+         << " no data in table " << bankName << endl;
+    return 0;
+  }
+  sort(rids.begin(), rids.end());
+
+  // chunks are fixed rid ranges, so they are the same when the backup is resumed
+  vector<pair<int, int> > chunks;
+  for (auto rid : rids)
+  {
+    const int first = rid - rid % chunk_size;
+    if (chunks.empty() || chunks.back().first != first)
+    {
+      chunks.push_back(make_pair(first, first + chunk_size - 1));
+    }
+  }
+
+  PgPostBankBackupLog bklog(bankName, tag);
+  bklog.Init();
+  const rid_list_t done_list = bklog.getLoggedRIds(PgPostBankBackupLog::kOptBackup2File_Chunk);
+  const set<int> done(done_list.begin(), done_list.end());
+  vector<pair<int, int> > todo;
+  for (auto &chunk : chunks)
+  {
+    // the last chunk may have new records
+    if (done.find(chunk.first) == done.end() || chunk == chunks.back())
+    {
+      todo.push_back(chunk);
+    }
+  }
+  if (verbosity >= 1)
+    cout << "PgPostBankBackupManager::parallelFetchAllBank2TFile - "
+         << bankName << ": " << rids.size() << " records in " << chunks.size()
+         << " chunks, " << chunks.size() - todo.size() << " done by an earlier backup with tag "
+         << tag << endl;
+
+  // the workers stream and write ROOT objects concurrently
+  ROOT::EnableThreadSafety();
+  PdbClassMap<PdbCalBank>::instance();
+
+  atomic<unsigned int> next_chunk(0);
+  atomic<int> cnt(0);
+  atomic<int> failed_chunks(0);
+  auto worker = [&]() {
+    TSQLConnection *con = NewConnection();
+    for (unsigned int i = next_chunk++; i < todo.size(); i = next_chunk++)
+    {
+      TString file_name;
+      file_name.Form("%s_%010d.root", out_file_base.c_str(), todo[i].first);
+      const int n = fetchChunk2TFile(con, bankName, record_selection, todo[i].first, todo[i].second, file_name.Data());
+      if (n < 0)
+      {
+        // not checkpointed, a rerun will retry it
+        failed_chunks++;
+        bklog.Log(todo[i].first,
+                  (PgPostBankBackupLog::enu_ops)(PgPostBankBackupLog::kOptBackup2File_Chunk * PgPostBankBackupLog::kOptFailed));
+        continue;
+      }
+      cnt += n;
+      bklog.Log(todo[i].first, PgPostBankBackupLog::kOptBackup2File_Chunk);
+      if (verbosity >= 1)
+        cout << "PgPostBankBackupManager::parallelFetchAllBank2TFile - " << n
+             << " records in " << bankName << " saved to " << file_name << endl;
+    }
+    CloseConnection(con);
+  };
+  vector<thread> workers;
+  for (int i = 0; i < max(nthreads, 1); i++)
+  {
+    workers.push_back(thread(worker));
+  }
+  for (auto &w : workers)
+  {
+    w.join();
+  }
+
+  cout << "PgPostBankBackupManager::parallelFetchAllBank2TFile - " << cnt
+       << " records in " << bankName << " saved to " << out_file_base << "*.root";
+  if (failed_chunks > 0)
+  {
+    cout << ", " << failed_chunks << " chunks failed, rerun with tag " << tag << " to retry them";
+  }
+  cout << endl;
+  return cnt;
+}
+
+int PgPostBankBackupManager::fetchChunk2TFile(TSQLConnection *con, const std::string &bankName,
+                                              const std::string &record_selection, const int first_rid, const int last_rid,
+                                              const std::string &out_file)
+{
+  TFile f(out_file.c_str(), "recreate");
+  if (f.IsZombie())
+  {
+    cout << "PgPostBankBackupManager::fetchChunk2TFile - Error -"
+         << " can not open file " << out_file << endl;
+    return -1;
+  }
+  if (compression >= 0)
+  {
+    f.SetCompressionSettings(compression);
+  }
+
+  std::ostringstream tem;
+  tem
+      << "select bankid,inserttime,startvaltime,endvaltime,description,username,calibrations,rid from "
+      << bankName << " where rid >= " << first_rid << " and rid <= " << last_rid;
+  if (record_selection.length() > 0)
+    tem << " and (" << record_selection << ")";
+  tem << " ORDER BY rid ASC";
+
+  if (verbosity >= 2)
+    cout << "PgPostBankBackupManager::fetchChunk2TFile - database exe : "
+         << tem.str() << endl;
+
+  int cnt = 0;
+  bool failed = false;
+  TSQLStatement *stmt = con->CreateStatement();
+  assert(stmt);
+  stmt->SetMaxRows(last_rid - first_rid + 2);
+  {
+    std::unique_ptr<TSQLResultSet> rs(stmt->ExecuteQuery(tem.str().c_str()));
+    if (!rs)
+    {
+      cout << "PgPostBankBackupManager::fetchChunk2TFile - ERROR - "
+           << " Cannot get TSQLResultSet from ExecuteQuery" << endl;
+      failed = true;
+    }
+    while (rs && rs->Next())
+    {
+      PgPostBankBackupStorage *bs = SQLResultSet2BackupStorage(rs.get(), bankName);
+      if (bs)
+      {
+        f.cd();
+        bs->Write(bs->GetName(), TObject::kWriteDelete);
+        delete bs;
+        cnt++;
+      }
+      else
+      {
+        cout << "PgPostBankBackupManager::fetchChunk2TFile - Error - "
+             << "invalid PgPostBankBackupStorage for row " << rs->GetRow()
+             << endl;
+        failed = true;
+      }
+    }
+  }
+  DeleteStatement(con, stmt);
+  f.Close();
+  return (failed ? -1 : cnt);
+}
+
+//! TFiles -> Database in parallel, one file per worker
+int PgPostBankBackupManager::parallelCommitAllBankfromTFiles(const std::vector<std::string> &in_files,
+                                                             const int nthreads, const int chunk_size)
+{
+  ROOT::EnableThreadSafety();
+  PdbClassMap<PdbCalBank>::instance();
+
+  atomic<unsigned int> next_file(0);
+  atomic<int> cnt(0);
+  auto worker = [&]() {
+    TSQLConnection *con = NewConnection();
+    for (unsigned int i = next_file++; i < in_files.size(); i = next_file++)
+    {
+      cnt += commitTFileChunked(con, in_files[i], chunk_size);
+    }
+    CloseConnection(con);
+  };
+  vector<thread> workers;
+  for (int i = 0; i < max(nthreads, 1); i++)
+  {
+    workers.push_back(thread(worker));
+  }
+  for (auto &w : workers)
+  {
+    w.join();
+  }
+
+  cout << "PgPostBankBackupManager::parallelCommitAllBankfromTFiles - committed "
+       << cnt << " records from " << in_files.size() << " files" << endl;
+  return cnt;
+}
+
+int PgPostBankBackupManager::commitTFileChunked(TSQLConnection *con, const std::string &in_file, const int chunk_size)
+{
+  TFile f(in_file.c_str());
+  if (!f.IsOpen())
+  {
+    cout
+        << "PgPostBankBackupManager::commitTFileChunked - ERROR - can not open TFile "
+        << in_file << endl;
+    return 0;
+  }
+  con->SetAutoCommit(kFALSE);
+
+  int commit_cnt = 0;
+  int skip_cnt = 0;
+  int pending_cnt = 0;
+  int chunk_first_rid = 0;
+  string table_name;
+  set<int> existing_rids;
+  TSQLPreparedStatement *pstmt = nullptr;
+  std::unique_ptr<PgPostBankBackupLog> bklog;
+
+  TIter next(f.GetListOfKeys());
+  while (TKey *key = dynamic_cast<TKey *>(next()))
+  {
+    std::unique_ptr<PgPostBankBackupStorage>
+        bs(dynamic_cast<PgPostBankBackupStorage *>(key->ReadObj()));
+    if (!bs.get())
+    {
+      cout
+          << "PgPostBankBackupManager::commitTFileChunked - ERROR - can not read "
+          << key->GetName() << " from " << in_file << endl;
+      continue;
+    }
+
+    if (!pstmt)
+    {
+      table_name = bs->get_database_header().getTableName();
+
+      ostringstream sqlcmd;
+      sqlcmd << "select rid from " << table_name;
+      TSQLStatement *stmt = con->CreateStatement();
+      {
+        std::unique_ptr<TSQLResultSet> rs(stmt->ExecuteQuery(sqlcmd.str().c_str()));
+        while ((rs) && rs->Next())
+        {
+          existing_rids.insert(rs->GetInt(1));
+        }
+      }
+      DeleteStatement(con, stmt);
+
+      sqlcmd.str("");
+      sqlcmd << "insert into " << table_name
+             << "(bankid,inserttime,startvaltime,endvaltime,description,username,calibrations,rid) values (?,?,?,?,?,?,?,?);";
+      pstmt = con->PrepareStatement(sqlcmd.str().c_str());
+      bklog.reset(new PgPostBankBackupLog(table_name, tag));
+
+      if (Verbosity() >= 1)
+        cout
+            << "PgPostBankBackupManager::commitTFileChunked - writing table "
+            << table_name << " from TFile " << in_file
+            << ". database size = " << existing_rids.size() << endl;
+    }
+
+    if (table_name != bs->get_database_header().getTableName())
+    {
+      cout
+          << "PgPostBankBackupManager::commitTFileChunked - ERROR - inconsistent table name for "
+          << key->GetName() << " from " << in_file << ", expect "
+          << table_name << endl;
+      continue;
+    }
+
+    const int rid = bs->get_database_header().getRId();
+    if (existing_rids.find(rid) != existing_rids.end())
+    {
+      skip_cnt++;
+      continue;
+    }
+
+    pstmt->SetInt(1, bs->get_database_header().getBankID());
+    pstmt->SetLong(2, (bs->get_database_header().getInsertTime()).getTics());
+    pstmt->SetLong(3, (bs->get_database_header().getStartValTime()).getTics());
+    pstmt->SetLong(4, (bs->get_database_header().getEndValTime()).getTics());
+    pstmt->SetString(5, (bs->get_database_header().getDescription()).c_str());
+    pstmt->SetString(6, (bs->get_database_header().getUserName()).c_str());
+    std::unique_ptr<PgPostCalBank> bw(bs->createBank());
+    assert(bw.get());
+    pstmt->SetObject(7, bw.get());
+    pstmt->SetInt(8, rid);
+    const int res = pstmt->ExecuteUpdate();
+    if (res != 1)
+    {
+      cout
+          << "PgPostBankBackupManager::commitTFileChunked - Error - "
+          << "DATABASE: commit to " << table_name
+          << " failed with ExecuteUpdate()=" << res
+          << ". Make sure you commit to a writable database " << endl;
+      bklog->Log(rid,
+                 (PgPostBankBackupLog::enu_ops)(PgPostBankBackupLog::kOptFile2Db * PgPostBankBackupLog::kOptFailed));
+      continue;
+    }
+    if (pending_cnt == 0)
+    {
+      chunk_first_rid = rid;
+    }
+    pending_cnt++;
+
+    if (pending_cnt >= chunk_size)
+    {
+      try
+      {
+        con->Commit();
+      }
+      catch (TSQLException &e)
+      {
+        cout
+            << "PgPostBankBackupManager::commitTFileChunked - Error - "
+            << " Exception caught during connection->commit()" << endl;
+        cout << e.GetMessage() << endl;
+        exit(1);
+      }
+      bklog->Log(chunk_first_rid, PgPostBankBackupLog::kOptFile2Db_Chunk);
+      commit_cnt += pending_cnt;
+      pending_cnt = 0;
+    }
+  }
+
+  if (pending_cnt > 0)
+  {
+    try
+    {
+      con->Commit();
+    }
+    catch (TSQLException &e)
+    {
+      cout
+          << "PgPostBankBackupManager::commitTFileChunked - Error - "
+          << " Exception caught during connection->commit()" << endl;
+      cout << e.GetMessage() << endl;
+      exit(1);
+    }
+    bklog->Log(chunk_first_rid, PgPostBankBackupLog::kOptFile2Db_Chunk);
+    commit_cnt += pending_cnt;
+  }
+  if (pstmt)
+  {
+    DeleteStatement(con, dynamic_cast<TObject *>(pstmt));
+  }
+  f.Close();
+
+  if (Verbosity() >= 1)
+    cout << "PgPostBankBackupManager::commitTFileChunked - Done "
+         << table_name << ": commit/skip = " << commit_cnt << "/"
+         << skip_cnt << " from " << in_file << endl;
+  return commit_cnt;
+}
+
 std::string
 PgPostBankBackupManager::getBankBaseName(const std::string &bank_classname)
 {
@@ -21,6 +21,7 @@
 
 class PdbCalChan;
 class PgPostBankBackupStorage;
+class TSQLConnection;
 class TSQLStatement;
 class TSQLPreparedStatement;
 class TSQLResultSet;
@@ -74,6 +75,28 @@ class PgPostBankBackupManager
                          const std::string &record_selection, const std::string &out_file_base,
                          int splitting_limit = 100000);
 
+  //! Database -> TFiles with nthreads workers, each with its own database connection.
+  //! Records are split in rid ranges of chunk_size, each written to
+  //! out_file_base_<first rid>.root. Finished chunks are checkpointed in the backup log,
+  //! a rerun with the same tag skips them (except the last one, which may have grown)
+  int parallelFetchAllBank2TFile(const std::string &bankName,
+                                 const std::string &record_selection, const std::string &out_file_base,
+                                 const int nthreads = 4, const int chunk_size = 10000);
+
+  //! TFiles -> Database with nthreads workers, one file at a time each with its own
+  //! database connection and a commit every chunk_size records. Records already in the
+  //! database are skipped, so an interrupted restore can simply be rerun
+  int parallelCommitAllBankfromTFiles(const std::vector<std::string> &in_files,
+                                      const int nthreads = 4, const int chunk_size = 1000);
+
+  //! compression of the backup files written by parallelFetchAllBank2TFile
+  //! (100 * algorithm + level), negative for the ROOT default
+  void
+  CompressionSettings(const int c)
+  {
+    compression = c;
+  }
+
   //! dump databse to text
   void
   dumpTable(const std::string &bankName, std::ostream &out);
@@ -117,10 +140,20 @@ class PgPostBankBackupManager
   PgPostBankBackupStorage *
   SQLResultSet2BackupStorage(TSQLResultSet *rs, const std::string &table_name);
 
+  //! one chunk of parallelFetchAllBank2TFile, returns the number of records or -1 on failure
+  int fetchChunk2TFile(TSQLConnection *con, const std::string &bankName,
+                       const std::string &record_selection, const int first_rid, const int last_rid,
+                       const std::string &out_file);
+
+  //! one file of parallelCommitAllBankfromTFiles, returns the number of committed records
+  int commitTFileChunked(TSQLConnection *con, const std::string &in_file, const int chunk_size);
+
   //! The verbosity level. 0 means not verbose at all.
   int verbosity;
 
   std::string tag;
+
+  int compression;
 };
 
 #endif /* PDBCAL_PG_PGPOSTBANKBACKUPMANAGER_H */
@@ -2,6 +2,7 @@
 #include "PgPostApplication.h"
 #include "PgPostBankWrapper.h"
 #include "PgPostCalBankIterator.h"
+#include "PgPostCalibSnapshot.h"
 
 #include <pdbcalbase/PdbBankID.h>
 #include <pdbcalbase/PdbBankManagerFactory.h>
@@ -63,6 +64,8 @@ int PgPostBankManager::Register()
 }
 
 PgPostBankManager::PgPostBankManager()
+  : m_Snapshot(nullptr)
+  , m_Frozen(false)
 {
   tMaxInsertTime.setToFarFuture();
 #ifdef DEBUG
@@ -72,6 +75,7 @@ PgPostBankManager::PgPostBankManager()
 
 PgPostBankManager::~PgPostBankManager()
 {
+  delete m_Snapshot;
   mySpecificCopy = 0;
 }
 
@@ -240,6 +244,22 @@ PdbCalBank *PgPostBankManager::fetchBank(const string &className, PdbBankID bank
   cout << "Fetching " << className << " from " << bankName << endl;
 #endif
 
+  time_t sT = searchTime.getTics();
+  if (m_Snapshot && (m_Frozen || m_Snapshot->hasTable(bankName)))
+  {
+    int rid;
+    PgPostBankWrapper *bw = m_Snapshot->fetchBank(bankName, bankID.getInternalValue(), sT, tMaxInsertTime.getTics(), rid);
+    if (bw)
+    {
+      BankRid[bankName].insert(rid);
+      return bw;
+    }
+    std::cerr << PHWHERE << "NO Bank found in snapshot: " << bankName
+              << " bankID " << bankID.getInternalValue()
+              << " time " << sT << std::endl;
+    return 0;
+  }
+
   PgPostApplication *ap = PgPostApplication::instance();
   if (!ap)
   {
@@ -255,7 +275,6 @@ PdbCalBank *PgPostBankManager::fetchBank(const string &className, PdbBankID bank
   }
 
   TSQLStatement *stmt = con->CreateStatement();
-  time_t sT = searchTime.getTics();
   std::ostringstream tem;
   std::ostringstream t2;
 
@@ -453,3 +472,76 @@ void PgPostBankManager::SetMaxInsertTime(const PHTimeStamp &tMax)
   tMaxInsertTime = tMax;
   return;
 }
+
+int PgPostBankManager::UseSnapshot(const string &filename, const bool frozen)
+{
+  delete m_Snapshot;
+  m_Snapshot = new PgPostCalibSnapshot();
+  if (m_Snapshot->OpenRead(filename))
+  {
+    delete m_Snapshot;
+    m_Snapshot = nullptr;
+    return -1;
+  }
+  m_Frozen = frozen;
+  cout << "Using calibration snapshot " << filename;
+  if (m_Frozen)
+  {
+    cout << ", the database is not used";
+  }
+  cout << endl;
+  return 0;
+}
+
+int PgPostBankManager::WriteSnapshot(const string &filename, const string &bankName)
+{
+  PgPostApplication *ap = PgPostApplication::instance();
+  if (!ap)
+  {
+    cout << PHWHERE << " PgPostApplication instance is nullptr, exiting" << endl;
+    exit(1);
+  }
+
+  TSQLConnection *con = ap->getConnection();
+  if (!con)
+  {
+    cout << PHWHERE << " Cannot get TSQLConnection, exiting" << endl;
+    exit(1);
+  }
+
+  PgPostCalibSnapshot snapshot;
+  if (snapshot.OpenWrite(filename))
+  {
+    return -1;
+  }
+  if (snapshot.hasTable(bankName))
+  {
+    cout << PHWHERE << " table " << bankName << " is already in " << filename << endl;
+    return -1;
+  }
+
+  TSQLStatement *stmt = con->CreateStatement();
+  std::ostringstream tem;
+  tem << "select * from " << bankName;
+  std::unique_ptr<TSQLResultSet> rs(stmt->ExecuteQuery(tem.str().c_str()));
+  int nbanks = 0;
+  while ((rs) && rs->Next())
+  {
+    PdbCalBank *bank = (PdbCalBank *) (rs->GetObject(7));
+    PgPostBankWrapper bw(bank);
+    bw.setBankID(rs->GetInt(1));
+    bw.setInsertTime(rs->GetLong(2));
+    bw.setStartValTime(rs->GetLong(3));
+    bw.setEndValTime(rs->GetLong(4));
+    bw.setDescription(string(rs->GetString(5)));
+    bw.setUserName(string(rs->GetString(6)));
+    bw.setTableName(bankName);
+    if (snapshot.AddBank(bankName, rs->GetInt(1), rs->GetLong(2), rs->GetLong(3), rs->GetLong(4), rs->GetInt("rid"), &bw))
+    {
+      return -1;
+    }
+    nbanks++;
+  }
+  cout << "Wrote " << nbanks << " banks of " << bankName << " to " << filename << endl;
+  return 0;
+}
@@ -16,6 +16,7 @@
 class PdbApplication;
 class PdbCalBank;
 class PdbCalBankIterator;
+class PgPostCalibSnapshot;
 
 class PgPostBankManager : public PdbBankManager
 {
@@ -64,11 +65,19 @@ class PgPostBankManager : public PdbBankManager
   void ClearUsedBankRids() { BankRid.clear(); }
   void SetMaxInsertTime(const PHTimeStamp &tMax);
 
+  //! look up banks in a calibration snapshot file first. A frozen snapshot
+  //! never falls back to the database, banks not in the snapshot are not found
+  int UseSnapshot(const std::string &filename, const bool frozen = true);
+  //! copy all banks of a table from the database into a snapshot file
+  int WriteSnapshot(const std::string &filename, const std::string &bankName);
+
  private:
   static PgPostBankManager *mySpecificCopy;
   std::map<std::string, std::set<int> > BankRid;
   std::string getRealName(const std::string &);
   PHTimeStamp tMaxInsertTime;
+  PgPostCalibSnapshot *m_Snapshot;
+  bool m_Frozen;
 };
 
 #endif /* PDBCAL_PG_PGPOSTBANKMANAGER_H */
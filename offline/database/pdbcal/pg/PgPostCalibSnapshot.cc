@@ -0,0 +1,341 @@
+#include "PgPostCalibSnapshot.h"
+
+#include "PgPostBankWrapper.h"
+
+#include <phool/phool.h>
+
+#include <TDirectory.h>
+#include <TFile.h>
+#include <TKey.h>
+#include <TList.h>
+#include <TObject.h>
+#include <TTree.h>
+
+#include <algorithm>
+#include <iostream>
+
+using namespace std;
+
+namespace
+{
+string BankKey(const int rid)
+{
+  return "rid_" + to_string(rid);
+}
+}  // namespace
+
+PgPostCalibSnapshot::PgPostCalibSnapshot()
+  : m_File(nullptr)
+  , m_Writing(false)
+{
+}
+
+PgPostCalibSnapshot::~PgPostCalibSnapshot()
+{
+  Close();
+}
+
+int PgPostCalibSnapshot::OpenRead(const string &filename)
+{
+  Close();
+  m_File = TFile::Open(filename.c_str());
+  if (!m_File || m_File->IsZombie())
+  {
+    cout << PHWHERE << " could not open calibration snapshot " << filename << endl;
+    delete m_File;
+    m_File = nullptr;
+    return -1;
+  }
+  m_Writing = false;
+  ReadContents();
+  return 0;
+}
+
+int PgPostCalibSnapshot::OpenWrite(const string &filename)
+{
+  Close();
+  // creates the file if it does not exist yet
+  m_File = TFile::Open(filename.c_str(), "UPDATE");
+  if (!m_File || m_File->IsZombie() || !m_File->IsWritable())
+  {
+    cout << PHWHERE << " could not open calibration snapshot " << filename << " for writing" << endl;
+    delete m_File;
+    m_File = nullptr;
+    return -1;
+  }
+  m_Writing = true;
+  ReadContents();
+  return 0;
+}
+
+void PgPostCalibSnapshot::ReadContents()
+{
+  TIter next(m_File->GetListOfKeys());
+  while (TKey *key = dynamic_cast<TKey *>(next()))
+  {
+    if (string(key->GetClassName()) == "TDirectoryFile")
+    {
+      ReadIndex(key->GetName());
+    }
+  }
+
+  TTree *runs = dynamic_cast<TTree *>(m_File->Get("runs"));
+  if (runs)
+  {
+    Int_t runnumber;
+    Long64_t begintime;
+    Long64_t endtime;
+    runs->SetBranchAddress("runnumber", &runnumber);
+    runs->SetBranchAddress("begintime", &begintime);
+    runs->SetBranchAddress("endtime", &endtime);
+    for (Long64_t i = 0; i < runs->GetEntries(); i++)
+    {
+      runs->GetEntry(i);
+      m_RunTimes[runnumber] = make_pair(begintime, endtime);
+    }
+    delete runs;
+  }
+}
+
+int PgPostCalibSnapshot::Close()
+{
+  if (!m_File)
+  {
+    return 0;
+  }
+  if (m_Writing)
+  {
+    for (auto &tablename : m_NewTables)
+    {
+      m_File->cd(tablename.c_str());
+      TTree index("index", (tablename + " validity ranges").c_str());
+      Int_t bankid;
+      Long64_t inserttime;
+      Long64_t startvaltime;
+      Long64_t endvaltime;
+      Int_t rid;
+      index.Branch("bankid", &bankid, "bankid/I");
+      index.Branch("inserttime", &inserttime, "inserttime/L");
+      index.Branch("startvaltime", &startvaltime, "startvaltime/L");
+      index.Branch("endvaltime", &endvaltime, "endvaltime/L");
+      index.Branch("rid", &rid, "rid/I");
+      for (auto &bank : m_Tables[tablename])
+      {
+        for (auto &validity : bank.second)
+        {
+          bankid = bank.first;
+          inserttime = validity.insertTime;
+          startvaltime = validity.startValTime;
+          endvaltime = validity.endValTime;
+          rid = validity.rid;
+          index.Fill();
+        }
+      }
+      index.Write();
+    }
+    m_NewTables.clear();
+
+    m_File->cd();
+    TTree runs("runs", "run times");
+    Int_t runnumber;
+    Long64_t begintime;
+    Long64_t endtime;
+    runs.Branch("runnumber", &runnumber, "runnumber/I");
+    runs.Branch("begintime", &begintime, "begintime/L");
+    runs.Branch("endtime", &endtime, "endtime/L");
+    for (auto &run : m_RunTimes)
+    {
+      runnumber = run.first;
+      begintime = run.second.first;
+      endtime = run.second.second;
+      runs.Fill();
+    }
+    runs.Write("", TObject::kOverwrite);
+  }
+  m_File->Close();
+  delete m_File;
+  m_File = nullptr;
+  m_Writing = false;
+  m_Tables.clear();
+  m_RunTimes.clear();
+  return 0;
+}
+
+int PgPostCalibSnapshot::ReadIndex(const string &bankName)
+{
+  TTree *index = dynamic_cast<TTree *>(m_File->Get((bankName + "/index").c_str()));
+  if (!index)
+  {
+    cout << PHWHERE << " no index for table " << bankName << " in calibration snapshot" << endl;
+    return -1;
+  }
+  Int_t bankid;
+  Long64_t inserttime;
+  Long64_t startvaltime;
+  Long64_t endvaltime;
+  Int_t rid;
+  index->SetBranchAddress("bankid", &bankid);
+  index->SetBranchAddress("inserttime", &inserttime);
+  index->SetBranchAddress("startvaltime", &startvaltime);
+  index->SetBranchAddress("endvaltime", &endvaltime);
+  index->SetBranchAddress("rid", &rid);
+  map<int, vector<Validity> > &table = m_Tables[bankName];
+  for (Long64_t i = 0; i < index->GetEntries(); i++)
+  {
+    index->GetEntry(i);
+    Validity validity;
+    validity.startValTime = startvaltime;
+    validity.endValTime = endvaltime;
+    validity.insertTime = inserttime;
+    validity.rid = rid;
+    validity.maxEndValTime = endvaltime;
+    table[bankid].push_back(validity);
+  }
+  delete index;
+
+  for (auto &bank : table)
+  {
+    vector<Validity> &ranges = bank.second;
+    sort(ranges.begin(), ranges.end(), [](const Validity &a, const Validity &b) { return a.startValTime < b.startValTime; });
+    for (unsigned int i = 1; i < ranges.size(); i++)
+    {
+      ranges[i].maxEndValTime = max(ranges[i].endValTime, ranges[i - 1].maxEndValTime);
+    }
+  }
+  return 0;
+}
+
+PgPostBankWrapper *PgPostCalibSnapshot::fetchBank(const string &bankName, const int bankID, const time_t tics, const time_t maxInsertTime, int &rid)
+{
+  rid = -1;
+  if (!m_File || m_Writing)
+  {
+    return nullptr;
+  }
+  auto tableiter = m_Tables.find(bankName);
+  if (tableiter == m_Tables.end())
+  {
+    return nullptr;
+  }
+  auto bankiter = tableiter->second.find(bankID);
+  if (bankiter == tableiter->second.end())
+  {
+    return nullptr;
+  }
+  const vector<Validity> &ranges = bankiter->second;
+
+  // first range starting after tics, everything before it starts early enough
+  auto last = upper_bound(ranges.begin(), ranges.end(), tics,
+                          [](const time_t t, const Validity &v) { return t < v.startValTime; });
+  const Validity *best = nullptr;
+  for (auto iter = last; iter != ranges.begin();)
+  {
+    --iter;
+    if (iter->maxEndValTime <= tics)
+    {
+      // no earlier range reaches tics
+      break;
+    }
+    if (iter->endValTime > tics && iter->insertTime <= maxInsertTime)
+    {
+      if (!best || iter->insertTime > best->insertTime || (iter->insertTime == best->insertTime && iter->rid > best->rid))
+      {
+        best = &(*iter);
+      }
+    }
+  }
+  if (!best)
+  {
+    return nullptr;
+  }
+
+  PgPostBankWrapper *bw = dynamic_cast<PgPostBankWrapper *>(m_File->Get((bankName + "/" + BankKey(best->rid)).c_str()));
+  if (!bw)
+  {
+    cout << PHWHERE << " calibration snapshot has no bank " << BankKey(best->rid) << " in " << bankName << endl;
+    return nullptr;
+  }
+  rid = best->rid;
+  return bw;
+}
+
+bool PgPostCalibSnapshot::getRunTimes(const int runNumber, time_t &beginTime, time_t &endTime) const
+{
+  auto iter = m_RunTimes.find(runNumber);
+  if (iter == m_RunTimes.end())
+  {
+    return false;
+  }
+  beginTime = iter->second.first;
+  endTime = iter->second.second;
+  return true;
+}
+
+int PgPostCalibSnapshot::getRunNumber(const time_t tics) const
+{
+  int runnumber = -1;
+  time_t begintime = 0;
+  for (auto &run : m_RunTimes)
+  {
+    if (run.second.first <= tics && (runnumber < 0 || run.first > runnumber))
+    {
+      runnumber = run.first;
+      begintime = run.second.first;
+    }
+  }
+  if (runnumber < 0)
+  {
+    return -1;
+  }
+  const time_t endtime = m_RunTimes.find(runnumber)->second.second;
+  if (endtime > 0 && endtime < tics)
+  {
+    cout << "Timestamp " << tics
+         << " not covered by any run, closest smaller begin run time " << begintime << " is from run "
+         << runnumber << endl;
+    return -1;
+  }
+  return runnumber;
+}
+
+int PgPostCalibSnapshot::AddBank(const string &bankName, const int bankID, const time_t insertTime,
+                                 const time_t startValTime, const time_t endValTime, const int rid, PgPostBankWrapper *bank)
+{
+  if (!m_File || !m_Writing)
+  {
+    cout << PHWHERE << " calibration snapshot is not open for writing" << endl;
+    return -1;
+  }
+  if (m_NewTables.find(bankName) == m_NewTables.end())
+  {
+    if (hasTable(bankName))
+    {
+      cout << PHWHERE << " table " << bankName << " is already in the calibration snapshot" << endl;
+      return -1;
+    }
+    m_File->mkdir(bankName.c_str());
+    m_NewTables.insert(bankName);
+  }
+  m_File->cd(bankName.c_str());
+  bank->Write(BankKey(rid).c_str());
+
+  Validity validity;
+  validity.startValTime = startValTime;
+  validity.endValTime = endValTime;
+  validity.insertTime = insertTime;
+  validity.rid = rid;
+  validity.maxEndValTime = endValTime;
+  m_Tables[bankName][bankID].push_back(validity);
+  return 0;
+}
+
+int PgPostCalibSnapshot::AddRunTimes(const int runNumber, const time_t beginTime, const time_t endTime)
+{
+  if (!m_File || !m_Writing)
+  {
+    cout << PHWHERE << " calibration snapshot is not open for writing" << endl;
+    return -1;
+  }
+  m_RunTimes[runNumber] = make_pair(beginTime, endTime);
+  return 0;
+}
@@ -0,0 +1,82 @@
+// Tell emacs that this is a C++ source
+//  -*- C++ -*-.
+#ifndef PDBCALPG_PGPOSTCALIBSNAPSHOT_H
+#define PDBCALPG_PGPOSTCALIBSNAPSHOT_H
+
+#include <ctime>
+#include <map>
+#include <set>
+#include <string>
+#include <utility>
+#include <vector>
+
+class PgPostBankWrapper;
+class TFile;
+
+/*!
+ * \brief read only copy of calibration tables and run times in a root file
+ *
+ * Every bank table is a directory with the bank objects (keyed by rid) and an
+ * index tree of bankID, insert time, validity range and rid. The run table is
+ * the tree "runs". The indices are read into memory when the file is opened,
+ * a bank lookup is a binary search in the validity ranges of its bankID.
+ */
+class PgPostCalibSnapshot
+{
+ public:
+  PgPostCalibSnapshot();
+  virtual ~PgPostCalibSnapshot();
+
+  int OpenRead(const std::string &filename);
+  //! tables and runs are added to an existing file, a table can only be written once
+  int OpenWrite(const std::string &filename);
+  //! writes the indices when writing
+  int Close();
+
+  // --- reading ---------------------------------------------------------------
+
+  bool hasTable(const std::string &bankName) const { return m_Tables.find(bankName) != m_Tables.end(); }
+
+  //! bank valid at tics with the latest insert time up to maxInsertTime (highest rid
+  //! among equal insert times, like the database query), nullptr if there is none.
+  //! The caller owns the bank
+  PgPostBankWrapper *fetchBank(const std::string &bankName, const int bankID, const time_t tics, const time_t maxInsertTime, int &rid);
+
+  //! false if the run is not in the snapshot
+  bool getRunTimes(const int runNumber, time_t &beginTime, time_t &endTime) const;
+  bool hasRuns() const { return !m_RunTimes.empty(); }
+  //! run with the latest begin time not after tics, -1 if tics is after the end of that run
+  int getRunNumber(const time_t tics) const;
+
+  // --- writing ---------------------------------------------------------------
+
+  int AddBank(const std::string &bankName, const int bankID, const time_t insertTime,
+              const time_t startValTime, const time_t endValTime, const int rid, PgPostBankWrapper *bank);
+  int AddRunTimes(const int runNumber, const time_t beginTime, const time_t endTime);
+
+ private:
+  struct Validity
+  {
+    time_t startValTime;
+    time_t endValTime;
+    time_t insertTime;
+    int rid;
+    //! largest end time of this and all earlier starting ranges, ends the backward search
+    time_t maxEndValTime;
+  };
+
+  //! indices of all tables and the run times of the open file
+  void ReadContents();
+  int ReadIndex(const std::string &bankName);
+
+  TFile *m_File;
+  bool m_Writing;
+
+  //! validity ranges by table name and bankID, sorted by start time
+  std::map<std::string, std::map<int, std::vector<Validity> > > m_Tables;
+  std::map<int, std::pair<time_t, time_t> > m_RunTimes;
+  //! tables added since OpenWrite, their index trees are written by Close()
+  std::set<std::string> m_NewTables;
+};
+
+#endif /* PDBCALPG_PGPOSTCALIBSNAPSHOT_H */
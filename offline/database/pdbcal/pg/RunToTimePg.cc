@@ -1,4 +1,5 @@
 #include "RunToTimePg.h"
+#include "PgPostCalibSnapshot.h"
 
 #include <pdbcalbase/RunToTime.h>  // for RunToTime::__instance
 
@@ -28,6 +29,8 @@ unsigned int maxentries = 10;
 RunToTimePg* RunToTimePg::mySpecificCopy = nullptr;
 
 RunToTimePg::RunToTimePg()
+  : m_Snapshot(nullptr)
+  , m_Frozen(false)
 {
   con = nullptr;
   return;
@@ -37,6 +40,7 @@ RunToTimePg::~RunToTimePg()
 {
   mySpecificCopy = nullptr;
   __instance = nullptr;
+  delete m_Snapshot;
   while (beginruntimes.begin() != beginruntimes.end())
   {
     delete beginruntimes.begin()->second;
@@ -91,6 +95,32 @@ PHTimeStamp*
 RunToTimePg::getTime(const int runNumber, const string& what)
 {
   PHTimeStamp* whatTime = nullptr;
+  if (m_Snapshot)
+  {
+    time_t begintime;
+    time_t endtime;
+    if (m_Snapshot->getRunTimes(runNumber, begintime, endtime))
+    {
+      // the snapshot has all runs, the cache does not need trimming
+      beginruntimes[runNumber] = new PHTimeStamp(begintime);
+      endruntimes[runNumber] = new PHTimeStamp(endtime);
+      if (what == "brunixtime")
+      {
+        return beginruntimes[runNumber];
+      }
+      else if (what == "erunixtime")
+      {
+        return endruntimes[runNumber];
+      }
+      cout << "invalid time selection " << what << endl;
+      exit(1);
+    }
+    if (m_Frozen)
+    {
+      cout << PHWHERE << " run " << runNumber << " not in calibration snapshot" << endl;
+      return nullptr;
+    }
+  }
   //  Establish connection to Postgres...
   GetConnection();  // on error this method will exit
   Statement* stmt = con->createStatement();
@@ -236,6 +266,10 @@ RunToTimePg::getEndTime(const int runNumber)
 
 int RunToTimePg::getRunNumber(const PHTimeStamp& ts)
 {
+  if (m_Snapshot && (m_Frozen || m_Snapshot->hasRuns()))
+  {
+    return m_Snapshot->getRunNumber(ts.getTics());
+  }
   GetConnection();
   Statement* stmt = con->createStatement();
 
@@ -306,3 +340,68 @@ int RunToTimePg::getRunNumber(const PHTimeStamp& ts)
 cleanup:
   return runnumber;
 }
+
+int RunToTimePg::UseSnapshot(const string& filename, const bool frozen)
+{
+  delete m_Snapshot;
+  m_Snapshot = new PgPostCalibSnapshot();
+  if (m_Snapshot->OpenRead(filename))
+  {
+    delete m_Snapshot;
+    m_Snapshot = nullptr;
+    return -1;
+  }
+  m_Frozen = frozen;
+  return 0;
+}
+
+int RunToTimePg::WriteSnapshot(const string& filename, const int minRun, const int maxRun)
+{
+  PgPostCalibSnapshot snapshot;
+  if (snapshot.OpenWrite(filename))
+  {
+    return -1;
+  }
+  GetConnection();
+  Statement* stmt = con->createStatement();
+
+  std::ostringstream cmd;
+  cmd << "select runnumber,brunixtime,erunixtime,updateunixtime from run where runnumber >= " << minRun
+      << " and runnumber <= " << maxRun;
+
+  ResultSet* rs = nullptr;
+  try
+  {
+    rs = stmt->executeQuery(cmd.str());
+  }
+  catch (SQLException& e)
+  {
+    cout << "Fatal Exception caught during stmt->executeQuery(" << cmd.str() << ")" << endl;
+    cout << "Message: " << e.getMessage() << endl;
+    exit(1);
+  }
+
+  int nruns = 0;
+  while (rs->next())
+  {
+    try
+    {
+      time_t eruntics = rs->getInt("erunixtime");
+      if (eruntics == 0)
+      {
+        eruntics = rs->getInt("updateunixtime");
+      }
+      snapshot.AddRunTimes(rs->getInt("runnumber"), rs->getInt("brunixtime"), eruntics);
+    }
+    catch (SQLException& e)
+    {
+      cout << "Fatal Exception caught during reading run times" << endl;
+      cout << "Message: " << e.getMessage() << endl;
+      exit(1);
+    }
+    nruns++;
+  }
+  delete rs;
+  cout << "Wrote " << nruns << " run times to " << filename << endl;
+  return 0;
+}
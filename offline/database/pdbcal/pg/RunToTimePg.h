@@ -15,6 +15,8 @@ namespace odbc
 class Connection;
 }
 
+class PgPostCalibSnapshot;
+
 class RunToTimePg : public RunToTime
 {
  protected:
@@ -34,6 +36,12 @@ class RunToTimePg : public RunToTime
   int DisconnectDB();
   static int Register();
 
+  //! look up run times in a calibration snapshot file first. A frozen snapshot
+  //! never falls back to the database
+  int UseSnapshot(const std::string &filename, const bool frozen = true);
+  //! copy the run times of a range of runs from the database into a snapshot file
+  int WriteSnapshot(const std::string &filename, const int minRun, const int maxRun);
+
  private:
   PHTimeStamp *getTime(const int runNumber, const std::string &what);
   int GetConnection();
@@ -41,6 +49,8 @@ class RunToTimePg : public RunToTime
   std::map<const int, PHTimeStamp *> beginruntimes;
   std::map<const int, PHTimeStamp *> endruntimes;
   odbc::Connection *con;
+  PgPostCalibSnapshot *m_Snapshot;
+  bool m_Frozen;
 };
 
 #endif // PDBCALPG_RUNTOTIMEPG_H
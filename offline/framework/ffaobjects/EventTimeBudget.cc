@@ -0,0 +1,34 @@
+#include "EventTimeBudget.h"
+
+#include <iostream>
+
+/// Clear Event
+void EventTimeBudget::Reset()
+{
+  std::cout << __PRETTY_FUNCTION__
+            << "ERROR Reset() not implemented by daughter class" << std::endl;
+  return;
+}
+
+/** identify Function from PHObject
+ @param os Output Stream
+ */
+void EventTimeBudget::identify(std::ostream &os) const
+{
+  os << "identify yourself: virtual EventTimeBudget Object" << std::endl;
+  return;
+}
+
+/// isValid returns non zero if object contains valid data
+int EventTimeBudget::isValid() const
+{
+  std::cout << __PRETTY_FUNCTION__ << "isValid not implemented by daughter class"
+            << std::endl;
+  return 0;
+}
+
+const std::string &EventTimeBudget::get_DegradedModules() const
+{
+  static const std::string none;
+  return none;
+}
@@ -0,0 +1,54 @@
+// Tell emacs that this is a C++ source
+//  -*- C++ -*-.
+#ifndef FFAOBJECTS_EVENTTIMEBUDGET_H
+#define FFAOBJECTS_EVENTTIMEBUDGET_H
+
+#include <phool/PHObject.h>
+
+#include <iostream>  // for cout, ostream
+#include <string>
+
+//! base class for the per event time budget record written by Fun4AllServer
+class EventTimeBudget : public PHObject
+{
+ public:
+  /// dtor
+  virtual ~EventTimeBudget() {}
+
+  /// Clear Event
+  virtual void Reset();
+
+  /** identify Function from PHObject
+      @param os Output Stream
+   */
+  virtual void identify(std::ostream &os = std::cout) const;
+
+  /// isValid returns non zero if object contains valid data
+  virtual int isValid() const;
+
+  /// get time budget of the event in ms
+  virtual float get_Budget() const { return 0; }
+  /// set time budget of the event in ms
+  virtual void set_Budget(const float /*ms*/) { return; }
+
+  /// get time the modules spent on the event in ms
+  virtual float get_Time() const { return 0; }
+  /// set time the modules spent on the event in ms
+  virtual void set_Time(const float /*ms*/) { return; }
+
+  /// true if the event took longer than the budget
+  virtual bool get_Exceeded() const { return false; }
+
+  /// comma separated names of the modules which degraded their result
+  virtual const std::string &get_DegradedModules() const;
+  /// add a module which degraded its result
+  virtual void add_DegradedModule(const std::string & /*name*/) { return; }
+
+  /// true if any module degraded its result in this event
+  virtual bool get_Degraded() const { return false; }
+
+ private:  // prevent doc++ from showing ClassDef
+  ClassDef(EventTimeBudget, 1)
+};
+
+#endif
@@ -0,0 +1,51 @@
+#include "EventTimeBudgetv1.h"
+
+#include <iostream>
+
+using namespace std;
+
+EventTimeBudgetv1::EventTimeBudgetv1()
+  : Budget(0)
+{
+  Reset();
+  return;
+}
+
+void EventTimeBudgetv1::Reset()
+{
+  // the budget is set once by the server, it stays for all events
+  Time = 0;
+  DegradedModules.clear();
+  return;
+}
+
+void EventTimeBudgetv1::identify(ostream &out) const
+{
+  out << "identify yourself: I am an EventTimeBudgetv1 Object" << endl;
+  out << "Budget: " << Budget << " ms, Time: " << Time << " ms";
+  if (get_Exceeded())
+  {
+    out << " (exceeded)";
+  }
+  out << endl;
+  if (get_Degraded())
+  {
+    out << "Degraded modules: " << DegradedModules << endl;
+  }
+  return;
+}
+
+int EventTimeBudgetv1::isValid() const
+{
+  return ((Budget > 0) ? 1 : 0);  // return 1 if there is a budget
+}
+
+void EventTimeBudgetv1::add_DegradedModule(const string &name)
+{
+  if (!DegradedModules.empty())
+  {
+    DegradedModules += ",";
+  }
+  DegradedModules += name;
+  return;
+}
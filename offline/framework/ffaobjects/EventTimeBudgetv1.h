@@ -0,0 +1,57 @@
+// Tell emacs that this is a C++ source
+//  -*- C++ -*-.
+#ifndef FFAOBJECTS_EVENTTIMEBUDGETV1_H
+#define FFAOBJECTS_EVENTTIMEBUDGETV1_H
+
+#include "EventTimeBudget.h"
+
+#include <iostream>  // for cout, ostream
+#include <string>
+
+class PHObject;
+
+//! time budget, time used and degraded modules of an event
+class EventTimeBudgetv1 : public EventTimeBudget
+{
+ public:
+  /// ctor
+  EventTimeBudgetv1();
+  /// dtor
+  virtual ~EventTimeBudgetv1() {}
+
+  PHObject *CloneMe() const { return new EventTimeBudgetv1(*this); }
+
+  ///  Clear Event
+  void Reset();
+
+  /** identify Function from PHObject
+      @param os Output Stream
+   */
+  void identify(std::ostream &os = std::cout) const;
+
+  /// isValid returns non zero if object contains valid data
+  int isValid() const;
+
+  float get_Budget() const { return Budget; }
+  void set_Budget(const float ms) { Budget = ms; }
+
+  float get_Time() const { return Time; }
+  void set_Time(const float ms) { Time = ms; }
+
+  bool get_Exceeded() const { return Budget > 0 && Time > Budget; }
+
+  const std::string &get_DegradedModules() const { return DegradedModules; }
+  void add_DegradedModule(const std::string &name);
+
+  bool get_Degraded() const { return !DegradedModules.empty(); }
+
+ protected:
+  float Budget;                 // time budget in ms, 0: no budget
+  float Time;                   // time used by the modules in ms
+  std::string DegradedModules;  // comma separated, empty for most events
+
+ private:  // prevent doc++ from showing ClassDef
+  ClassDef(EventTimeBudgetv1, 1)
+};
+
+#endif
@@ -59,3 +59,17 @@ int SyncObject::Different(const SyncObject *other) const
     }
   return iret;
 }
+
+uint64_t SyncObject::SyncKey() const
+{
+  const int run = RunNumber();
+  const int segment = SegmentNumber();
+  const int counter = EventCounter();
+  if (run < 0 || run >= (1 << 24) ||
+      segment < 0 || segment >= (1 << 14) ||
+      counter < 0 || counter >= (1 << 26))
+    {
+      return 0;
+    }
+  return (static_cast<uint64_t>(run) << 40) | (static_cast<uint64_t>(segment) << 26) | static_cast<uint64_t>(counter);
+}
@@ -5,6 +5,7 @@
 
 #include <phool/PHObject.h>
 
+#include <cstdint>
 #include <iostream>
 
 ///
@@ -31,6 +32,12 @@ class SyncObject: public PHObject
   virtual SyncObject& operator=(const SyncObject &source);
   virtual int Different(const SyncObject *other) const;
 
+  /** run number, segment number and event counter packed into 64 bits,
+      keys order like the triplets. 0 if one of them is negative or
+      does not fit (run < 2^24, segment < 2^14, event counter < 2^26)
+   */
+  uint64_t SyncKey() const;
+
   /// set Event Counter
   virtual void EventCounter(const int /*ival*/) {return;}
 
@@ -10,15 +10,83 @@
 
 #include <boost/tokenizer.hpp>
 
+#include <algorithm>
 #include <chrono>
 #include <cstdlib>
 #include <fstream>
 #include <iostream>
+#include <map>
+#include <mutex>
+#include <set>
 #include <string>
 #include <thread>
+#include <utility>
 
 using namespace std;
 
+namespace
+{
+// resolved logical names of this process, shared by all FROG instances
+// (the input managers each create their own)
+mutex cachemutex;
+map<string, string> pfncache;
+string cachefile;
+
+// logical names per catalog query
+const unsigned int maxquerynames = 500;
+
+bool CacheLookup(const string &lname, string &pfn)
+{
+  lock_guard<mutex> lock(cachemutex);
+  auto iter = pfncache.find(lname);
+  if (iter == pfncache.end())
+  {
+    return false;
+  }
+  pfn = iter->second;
+  return true;
+}
+
+void CacheStore(const string &lname, const string &pfn)
+{
+  lock_guard<mutex> lock(cachemutex);
+  if (!pfncache.insert(make_pair(lname, pfn)).second || cachefile.empty())
+  {
+    return;
+  }
+  // one line per write, other jobs append to the same file
+  ofstream outfile(cachefile, ios::app);
+  outfile << (lname + " " + pfn + "\n") << flush;
+}
+
+// quoted and comma separated names [first, first + maxquerynames) for an IN list
+string InList(const vector<string> &lnames, const unsigned int first)
+{
+  string inlist;
+  for (unsigned int i = first; i < lnames.size() && i < first + maxquerynames; i++)
+  {
+    if (i > first)
+    {
+      inlist += ",";
+    }
+    string quoted = lnames[i];
+    for (size_t pos = quoted.find('\''); pos != string::npos; pos = quoted.find('\'', pos + 2))
+    {
+      quoted.insert(pos, 1, '\'');
+    }
+    inlist += "'" + quoted + "'";
+  }
+  return inlist;
+}
+
+void RemoveFound(vector<string> &lnames, const set<string> &found)
+{
+  lnames.erase(remove_if(lnames.begin(), lnames.end(),
+                         [&found](const string &lname) { return found.find(lname) != found.end(); }),
+               lnames.end());
+}
+}  // namespace
+
 FROG::FROG()
   : m_Verbosity(0)
   , m_OdbcConnection(nullptr)
@@ -44,6 +112,14 @@ FROG::location(const string &logical_name)
     }
     return pfn.c_str();
   }
+  if (CacheLookup(logical_name, pfn))
+  {
+    if (Verbosity() > 1)
+    {
+      cout << "FROG: found " << logical_name << " in cache, returning " << pfn << endl;
+    }
+    return pfn.c_str();
+  }
   try
   {
     string gsearchpath(getenv("GSEARCHPATH"));
@@ -111,9 +187,81 @@ FROG::location(const string &logical_name)
     }
   }
   Disconnect();
+  if (pfn != logical_name)
+  {
+    CacheStore(logical_name, pfn);
+  }
   return pfn.c_str();
 }
 
+int FROG::resolve(const vector<string> &logical_names)
+{
+  vector<string> lnames;
+  string cached;
+  for (auto &lname : logical_names)
+  {
+    if (lname.empty() || lname.find("/") != string::npos || CacheLookup(lname, cached))
+    {
+      continue;
+    }
+    lnames.push_back(lname);
+  }
+  sort(lnames.begin(), lnames.end());
+  lnames.erase(unique(lnames.begin(), lnames.end()), lnames.end());
+  const unsigned int nnames = lnames.size();
+  const char *gsearchpath = getenv("GSEARCHPATH");
+  if (!gsearchpath)
+  {
+    if (Verbosity() > 0)
+    {
+      cout << "FROG: GSEARCHPATH not set " << endl;
+    }
+    return 0;
+  }
+  string searchpath(gsearchpath);
+  boost::char_separator<char> sep(":");
+  boost::tokenizer<boost::char_separator<char> > tok(searchpath, sep);
+  for (auto &iter : tok)
+  {
+    if (lnames.empty())
+    {
+      break;
+    }
+    if (iter == "PG")
+    {
+      PGSearchList(lnames);
+    }
+    else if (iter == "DCACHE")
+    {
+      dCacheSearchList(lnames);
+    }
+    else  // assuming this is a file path
+    {
+      localSearchList(iter, lnames);
+    }
+  }
+  Disconnect();
+  if (Verbosity() > 0)
+  {
+    cout << "FROG: resolved " << nnames - lnames.size() << " of " << nnames
+         << " logical names" << endl;
+  }
+  return nnames - lnames.size();
+}
+
+void FROG::CacheFile(const string &filename)
+{
+  lock_guard<mutex> lock(cachemutex);
+  cachefile = filename;
+  ifstream infile(filename);
+  string lname;
+  string fname;
+  while (infile >> lname >> fname)
+  {
+    pfncache.insert(make_pair(lname, fname));
+  }
+}
+
 bool FROG::localSearch(const string &logical_name)
 {
   if (std::ifstream(logical_name))
@@ -213,3 +361,80 @@ bool FROG::dCacheSearch(const string &lname)
   delete stmt;
   return bret;
 }
+
+void FROG::localSearchList(const string &path, vector<string> &lnames)
+{
+  set<string> found;
+  for (auto &lname : lnames)
+  {
+    string fullfile = path + "/" + lname;
+    if (std::ifstream(fullfile))
+    {
+      CacheStore(lname, fullfile);
+      found.insert(lname);
+    }
+  }
+  RemoveFound(lnames, found);
+}
+
+void FROG::PGSearchList(vector<string> &lnames)
+{
+  if (lnames.empty() || !GetConnection())
+  {
+    return;
+  }
+  set<string> found;
+  for (unsigned int first = 0; first < lnames.size(); first += maxquerynames)
+  {
+    string sqlquery = "SELECT lfn, full_file_path from files where lfn in (" + InList(lnames, first) + ") and full_host_name <> 'hpss'";
+
+    odbc::Statement *stmt = m_OdbcConnection->createStatement();
+    odbc::ResultSet *rs = stmt->executeQuery(sqlquery);
+    while (rs->next())
+    {
+      string lname = rs->getString(1);
+      if (found.insert(lname).second)
+      {
+        CacheStore(lname, rs->getString(2));
+      }
+    }
+    delete rs;
+    delete stmt;
+  }
+  RemoveFound(lnames, found);
+}
+
+void FROG::dCacheSearchList(vector<string> &lnames)
+{
+  if (lnames.empty() || !GetConnection())
+  {
+    return;
+  }
+  set<string> found;
+  string dcachedir = "/pnfs/rcf.bnl.gov/phenix/phnxreco/";
+  for (unsigned int first = 0; first < lnames.size(); first += maxquerynames)
+  {
+    string sqlquery = "SELECT lfn, full_file_path from files where lfn in (" + InList(lnames, first) + ") and full_host_name = 'hpss' and full_file_path like '/home/dcphenix/phnxreco/%'";
+
+    odbc::Statement *stmt = m_OdbcConnection->createStatement();
+    odbc::ResultSet *rs = stmt->executeQuery(sqlquery);
+    while (rs->next())
+    {
+      string lname = rs->getString(1);
+      if (found.find(lname) != found.end())
+      {
+        continue;
+      }
+      string hpssfile = rs->getString(2);
+      hpssfile.replace(0, 24, dcachedir);
+      if (std::ifstream(hpssfile))
+      {
+        CacheStore(lname, "dcache:" + hpssfile);
+        found.insert(lname);
+      }
+    }
+    delete rs;
+    delete stmt;
+  }
+  RemoveFound(lnames, found);
+}
@@ -4,6 +4,8 @@
 #define FROG_FROG_H
 
 #include <string>
+#include <vector>
+
 namespace odbc
 {
 class Connection;
@@ -13,9 +15,15 @@ class FROG
 {
  public:
   FROG();
-  virtual ~FROG() {}
+  virtual ~FROG() { Disconnect(); }
 
   const char *location(const std::string &logical_name);
+  //! resolve many logical names with one catalog query per search path entry,
+  //! location() then returns the cached result. Returns the number of resolved names
+  int resolve(const std::vector<std::string> &logical_names);
+  //! file shared between jobs with resolved logical names, read now and appended
+  //! to whenever a name is resolved
+  static void CacheFile(const std::string &filename);
   bool localSearch(const std::string &lname);
   bool dCacheSearch(const std::string &lname);
   bool PGSearch(const std::string &lname);
@@ -25,6 +33,10 @@ class FROG
  private:
   bool GetConnection();
   void Disconnect();
+  //! catalog lookup of lnames, resolved names are cached and removed from lnames
+  void PGSearchList(std::vector<std::string> &lnames);
+  void dCacheSearchList(std::vector<std::string> &lnames);
+  void localSearchList(const std::string &path, std::vector<std::string> &lnames);
   std::string pfn;
   int m_Verbosity;
   odbc::Connection *m_OdbcConnection;
@@ -0,0 +1,111 @@
+// counts the calls to the global operator new, the allocated bytes and the
+// live heap memory. The counters are read by Fun4AllMemoryTracker and
+// attributed to the running module (Fun4AllServer::BenchmarkFile,
+// Fun4AllServer::PrintMemoryTracker).
+// This library is not linked into anything, preload it to switch the
+// counting on:
+// LD_PRELOAD=$OFFLINE_MAIN/lib/libfun4all_alloccount.so root.exe Fun4All_G4_sPHENIX.C
+
+#include "Fun4AllAllocCount.h"
+
+#include <malloc.h>  // for malloc_usable_size
+#include <cstdlib>
+#include <new>
+
+namespace
+{
+  Fun4AllAllocCounters counters;
+
+  void *counted_malloc(const std::size_t size)
+  {
+    // malloc(0) may return nullptr, new must return a unique pointer
+    void *p = std::malloc(size ? size : 1);
+    if (p)
+    {
+      // the usable size is also known in free, so live memory adds up
+      long long usable = malloc_usable_size(p);
+      counters.allocations.fetch_add(1, std::memory_order_relaxed);
+      counters.bytes.fetch_add(usable, std::memory_order_relaxed);
+      long long live = counters.live.fetch_add(usable, std::memory_order_relaxed) + usable;
+      long long peak = counters.peak.load(std::memory_order_relaxed);
+      while (live > peak && !counters.peak.compare_exchange_weak(peak, live, std::memory_order_relaxed))
+      {
+      }
+    }
+    return p;
+  }
+
+  void counted_free(void *p)
+  {
+    if (p)
+    {
+      counters.live.fetch_sub(malloc_usable_size(p), std::memory_order_relaxed);
+    }
+    std::free(p);
+  }
+}  // namespace
+
+extern "C" Fun4AllAllocCounters *fun4all_allocation_counters()
+{
+  return &counters;
+}
+
+void *operator new(std::size_t size)
+{
+  void *p = counted_malloc(size);
+  if (!p)
+  {
+    throw std::bad_alloc();
+  }
+  return p;
+}
+
+void *operator new[](std::size_t size)
+{
+  void *p = counted_malloc(size);
+  if (!p)
+  {
+    throw std::bad_alloc();
+  }
+  return p;
+}
+
+void *operator new(std::size_t size, const std::nothrow_t &) noexcept
+{
+  return counted_malloc(size);
+}
+
+void *operator new[](std::size_t size, const std::nothrow_t &) noexcept
+{
+  return counted_malloc(size);
+}
+
+void operator delete(void *p) noexcept
+{
+  counted_free(p);
+}
+
+void operator delete[](void *p) noexcept
+{
+  counted_free(p);
+}
+
+void operator delete(void *p, std::size_t) noexcept
+{
+  counted_free(p);
+}
+
+void operator delete[](void *p, std::size_t) noexcept
+{
+  counted_free(p);
+}
+
+void operator delete(void *p, const std::nothrow_t &) noexcept
+{
+  counted_free(p);
+}
+
+void operator delete[](void *p, const std::nothrow_t &) noexcept
+{
+  counted_free(p);
+}
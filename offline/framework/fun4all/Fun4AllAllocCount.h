@@ -0,0 +1,21 @@
+// Tell emacs that this is a C++ source
+//  -*- C++ -*-.
+#ifndef FUN4ALL_FUN4ALLALLOCCOUNT_H
+#define FUN4ALL_FUN4ALLALLOCCOUNT_H
+
+#include <atomic>
+
+//! counters of the interposed operator new/delete in libfun4all_alloccount.so
+struct Fun4AllAllocCounters
+{
+  std::atomic<unsigned long long> allocations;
+  std::atomic<unsigned long long> bytes;
+  //! currently allocated bytes and their maximum since the last reset of peak
+  std::atomic<long long> live;
+  std::atomic<long long> peak;
+};
+
+//! resolved with dlsym, only exists if libfun4all_alloccount.so is preloaded
+extern "C" Fun4AllAllocCounters *fun4all_allocation_counters();
+
+#endif
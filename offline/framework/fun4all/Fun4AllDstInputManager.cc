@@ -21,8 +21,12 @@
 
 #include <cassert>
 #include <cstdlib>
+#include <fstream>
 #include <iostream>                 // for operator<<, basic_ostream, endl
+#include <sstream>
+#include <tuple>
 #include <utility>                  // for pair
+#include <vector>
 
 class TBranch;
 
@@ -31,6 +35,11 @@ using namespace std;
 Fun4AllDstInputManager::Fun4AllDstInputManager(const string &name, const string &nodename, const string &topnodename)
   : Fun4AllInputManager(name, nodename, topnodename)
   , m_ReadRunTTree(1)
+  , m_CacheSize(-1)
+  , m_Prefetch(false)
+  , m_LazyLoading(false)
+  , m_EventIndexEnabled(false)
+  , m_EventIndexSidecar(false)
   , events_total(0)
   , events_thisfile(0)
   , events_skipped_during_sync(0)
@@ -41,7 +50,11 @@ Fun4AllDstInputManager::Fun4AllDstInputManager(const string &name, const string
   , runNodeSum(nullptr)
   , IManager(nullptr)
   , syncobject(nullptr)
+  , m_EventIndexEntries(0)
+  , m_BytesReadClosed(0)
+  , m_BytesDecompressedClosed(0)
 {
+  PrefetchFileLocations(true);
   return;
 }
 
@@ -137,10 +150,25 @@ int Fun4AllDstInputManager::fileopen(const string &filenam)
   IManager = new PHNodeIOManager(fullfilename, PHReadOnly);
   if (IManager->isFunctional())
   {
+    // read cache settings are applied when the event tree is attached on the first read
+    IManager->SetCacheSize(m_CacheSize);
+    IManager->SetParallelUnzip(m_Prefetch);
+    if (m_LazyLoading)
+    {
+      IManager->SetLazyLoading(true);
+      for (auto &nodename : m_EagerNodes)
+      {
+        IManager->readEagerly(nodename);
+      }
+    }
     IsOpen(1);
     events_thisfile = 0;
     setBranches();                // set branch selections
     AddToFileOpened(FileName());  // add file to the list of files which were opened
+    if (m_EventIndexEnabled)
+    {
+      BuildEventIndex();
+    }
     return 0;
   }
   else
@@ -218,8 +246,12 @@ int Fun4AllDstInputManager::fileclose()
     cout << Name() << ": fileclose: No Input file open" << endl;
     return -1;
   }
+  m_BytesReadClosed += IManager->GetBytesRead();
+  m_BytesDecompressedClosed += IManager->GetBytesUnzipped();
   delete IManager;
   IManager = nullptr;
+  m_EventIndex.clear();
+  m_EventIndexEntries = 0;
   IsOpen(0);
   UpdateFileList();
   return 0;
@@ -268,6 +300,16 @@ int Fun4AllDstInputManager::SyncIt(const SyncObject *mastersync)
     }
     else  // okay try to resync here
     {
+      // jump close to the matching event, the loops below then only
+      // have to cover what the index cannot know (e.g. the next file)
+      if (!m_EventIndex.empty())
+      {
+        int iret = SeekEventIndex(mastersync);
+        if (iret)
+        {
+          return iret;
+        }
+      }
       if (Verbosity() > 3)
       {
         cout << "Need to Resync, mastersync evt no: " << mastersync->EventNumber()
@@ -590,6 +632,22 @@ void Fun4AllDstInputManager::Print(const string &what) const
       cout << endl;
     }
   }
+  if (what == "ALL" || what == "CACHE")
+  {
+    cout << "--------------------------------------" << endl
+         << endl;
+    cout << "Read cache settings of Fun4AllDstInputManager " << Name() << ":" << endl;
+    cout << "TTreeCache size: ";
+    if (m_CacheSize < 0)
+    {
+      cout << "ROOT default" << endl;
+    }
+    else
+    {
+      cout << m_CacheSize << " bytes" << endl;
+    }
+    cout << "Prefetch (parallel unzip): " << (m_Prefetch ? "ON" : "OFF") << endl;
+  }
   if ((what == "ALL" || what == "PHOOL") && IManager)
   {
     // loop over the map and print out the content (name and location in memory)
@@ -604,6 +662,11 @@ void Fun4AllDstInputManager::Print(const string &what) const
 
 int Fun4AllDstInputManager::PushBackEvents(const int i)
 {
+  // negative values skip events
+  if (i < 0)
+  {
+    return SkipEvents(-i);
+  }
   if (IManager)
   {
     unsigned EventOnDst = IManager->getEventNumber();
@@ -615,3 +678,228 @@ int Fun4AllDstInputManager::PushBackEvents(const int i)
        << " probably the dst is not open yet (you need to call fileopen or run 1 event for lists)" << endl;
   return -1;
 }
+
+int Fun4AllDstInputManager::SkipEvents(const unsigned long nevents)
+{
+  if (!IsOpen() && !FileListEmpty())
+  {
+    OpenNextFile();
+  }
+  unsigned long nskip = nevents;
+  while (IManager)
+  {
+    unsigned long EventOnDst = IManager->getEventNumber();
+    long long nentries = IManager->GetEntries();
+    if (nentries < 0)
+    {
+      cout << PHWHERE << Name() << ": cannot determine number of events in " << FileName() << endl;
+      return -1;
+    }
+    if (EventOnDst + nskip < static_cast<unsigned long>(nentries))
+    {
+      IManager->setEventNumber(EventOnDst + nskip);
+      return 0;
+    }
+    // the rest of this file is skipped without reading it
+    if (static_cast<unsigned long>(nentries) > EventOnDst)
+    {
+      nskip -= nentries - EventOnDst;
+    }
+    fileclose();
+    if (OpenNextFile())
+    {
+      cout << PHWHERE << Name() << ": skipped past the last file, "
+           << nskip << " events left to skip" << endl;
+      return -1;
+    }
+  }
+  cout << PHWHERE << Name() << ": could not skip events, Imanager is NULL"
+       << " probably the dst is not open yet (you need to call fileopen or run 1 event for lists)" << endl;
+  return -1;
+}
+
+void Fun4AllDstInputManager::EventIndex(const bool b, const bool sidecar)
+{
+  m_EventIndexEnabled = b;
+  m_EventIndexSidecar = sidecar;
+  // the file might have been opened before the index was switched on
+  if (b && IsOpen() && m_EventIndex.empty())
+  {
+    BuildEventIndex();
+  }
+  return;
+}
+
+uint64_t Fun4AllDstInputManager::SyncKey() const
+{
+  if (!syncobject)
+  {
+    return 0;
+  }
+  return syncobject->SyncKey();
+}
+
+unsigned long long Fun4AllDstInputManager::BytesRead() const
+{
+  double bytes = m_BytesReadClosed;
+  if (IManager)
+  {
+    bytes += IManager->GetBytesRead();
+  }
+  return bytes;
+}
+
+unsigned long long Fun4AllDstInputManager::BytesDecompressed() const
+{
+  double bytes = m_BytesDecompressedClosed;
+  if (IManager)
+  {
+    bytes += IManager->GetBytesUnzipped();
+  }
+  return bytes;
+}
+
+int Fun4AllDstInputManager::BuildEventIndex()
+{
+  m_EventIndex.clear();
+  m_EventIndexEntries = 0;
+  string indexfile = fullfilename + ".evtidx";
+  if (m_EventIndexSidecar && !ReadEventIndex(indexfile))
+  {
+    return 0;
+  }
+  // read only the sync branch of the file with a separate io manager,
+  // the event reading of this input manager is not touched
+  PHNodeIOManager indexin(fullfilename, PHReadOnly);
+  if (!indexin.isFunctional())
+  {
+    return -1;
+  }
+  string syncbranch;
+  for (auto &branch : *indexin.GetBranchMap())
+  {
+    const string &bname = branch.first;
+    if (bname.size() > 5 && bname.compare(bname.size() - 4, 4, "Sync") == 0 &&
+        (bname[bname.size() - 5] == '#' || bname[bname.size() - 5] == '/'))
+    {
+      syncbranch = bname;
+      break;
+    }
+  }
+  if (syncbranch.empty())
+  {
+    cout << PHWHERE << Name() << ": no Sync branch in " << fullfilename << ", no event index" << endl;
+    return -1;
+  }
+  indexin.selectObjectToRead("*", false);
+  indexin.selectObjectToRead((syncbranch + "*").c_str(), true);
+  PHCompositeNode *indextop = new PHCompositeNode("TOP");
+  unsigned long entry = 0;
+  while (indexin.read(indextop))
+  {
+    SyncObject *sync = findNode::getClass<SyncObject>(indextop, "Sync");
+    if (!sync)
+    {
+      break;
+    }
+    // keep the first entry if a combination is not unique
+    m_EventIndex.insert(make_pair(make_tuple(sync->RunNumber(), sync->SegmentNumber(), sync->EventCounter()), entry));
+    entry++;
+  }
+  delete indextop;
+  m_EventIndexEntries = entry;
+  if (Verbosity() > 0)
+  {
+    cout << Name() << ": indexed " << entry << " events of " << fullfilename << endl;
+  }
+  if (m_EventIndexSidecar)
+  {
+    WriteEventIndex(indexfile);
+  }
+  return 0;
+}
+
+int Fun4AllDstInputManager::ReadEventIndex(const string &indexfile)
+{
+  ifstream infile(indexfile);
+  if (!infile.is_open())
+  {
+    return -1;
+  }
+  // one line per entry: run segment eventcounter
+  string line;
+  unsigned long entry = 0;
+  while (getline(infile, line))
+  {
+    istringstream linestream(line);
+    int run;
+    int segment;
+    int counter;
+    if (!(linestream >> run >> segment >> counter))
+    {
+      cout << PHWHERE << Name() << ": bad line " << line << " in " << indexfile << ", rebuilding event index" << endl;
+      m_EventIndex.clear();
+      return -1;
+    }
+    m_EventIndex.insert(make_pair(make_tuple(run, segment, counter), entry));
+    entry++;
+  }
+  if (static_cast<long long>(entry) != IManager->GetEntries())
+  {
+    cout << PHWHERE << Name() << ": " << indexfile << " does not match " << fullfilename
+         << ", rebuilding event index" << endl;
+    m_EventIndex.clear();
+    return -1;
+  }
+  m_EventIndexEntries = entry;
+  return 0;
+}
+
+int Fun4AllDstInputManager::WriteEventIndex(const string &indexfile) const
+{
+  vector<tuple<int, int, int> > entries(m_EventIndexEntries, make_tuple(0, 0, 0));
+  for (auto &idx : m_EventIndex)
+  {
+    entries[idx.second] = idx.first;
+  }
+  ofstream outfile(indexfile);
+  if (!outfile.is_open())
+  {
+    cout << PHWHERE << Name() << ": could not write event index " << indexfile << endl;
+    return -1;
+  }
+  for (auto &key : entries)
+  {
+    outfile << get<0>(key) << " " << get<1>(key) << " " << get<2>(key) << endl;
+  }
+  return 0;
+}
+
+int Fun4AllDstInputManager::SeekEventIndex(const SyncObject *mastersync)
+{
+  if (!IManager)
+  {
+    return 0;
+  }
+  unsigned long target = m_EventIndexEntries;
+  auto iter = m_EventIndex.lower_bound(make_tuple(mastersync->RunNumber(), mastersync->SegmentNumber(), mastersync->EventCounter()));
+  if (iter != m_EventIndex.end())
+  {
+    target = iter->second;
+  }
+  // only forward, the sequential search handles files which are not sorted
+  unsigned long EventOnDst = IManager->getEventNumber();
+  if (target <= EventOnDst)
+  {
+    return 0;
+  }
+  events_skipped_during_sync += target - EventOnDst;
+  if (Verbosity() > 2)
+  {
+    cout << Name() << ": event index jumps from entry " << EventOnDst << " to " << target << endl;
+  }
+  // the next sync object read is the one of the target entry (or the
+  // next file if the event is not on this one)
+  IManager->setEventNumber(target);
+  return ReadNextEventSyncObject();
+}
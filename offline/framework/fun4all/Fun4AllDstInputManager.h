@@ -5,8 +5,11 @@
 
 #include "Fun4AllInputManager.h"
 
+#include <cstdint>
 #include <map>
+#include <set>
 #include <string>
+#include <tuple>
 
 class PHCompositeNode;
 class PHNodeIOManager;
@@ -27,13 +30,46 @@ class Fun4AllDstInputManager : public Fun4AllInputManager
   virtual int setSyncBranches(PHNodeIOManager *IManager);
   void Print(const std::string &what = "ALL") const;
   int PushBackEvents(const int i);
+  //! TTreeCache size in bytes used for the event tree (0 switches it off, negative keeps the ROOT default)
+  void CacheSize(const long size) { m_CacheSize = size; }
+  //! decompress the upcoming events in a background thread while the current one is processed
+  void Prefetch(const bool b) { m_Prefetch = b; }
+  /*!
+    \brief read the object of a node only if a module asks for it with
+    findNode::getClass in this event. Nodes of modules which keep object
+    pointers between events have to be read eagerly
+  */
+  void LazyLoading(const bool b) { m_LazyLoading = b; }
+  void ReadEagerly(const std::string &nodename) { m_EagerNodes.insert(nodename); }
+  /*!
+    \brief index of run, segment and event counter of every event of a file
+    built at fileopen from the SyncObjects, synchronization with other inputs
+    then jumps to the matching event instead of reading through the file.
+    With sidecar the index is read from (or written to) <file>.evtidx
+  */
+  void EventIndex(const bool b, const bool sidecar = false);
+  uint64_t SyncKey() const;
+  unsigned long long BytesRead() const;
+  unsigned long long BytesDecompressed() const;
 
  protected:
   int ReadNextEventSyncObject();
+  //! skip n events, continuing with the next files of the list
+  int SkipEvents(const unsigned long nevents);
+  int BuildEventIndex();
+  int ReadEventIndex(const std::string &indexfile);
+  int WriteEventIndex(const std::string &indexfile) const;
+  //! position the file at the first event not before mastersync, 0 if nothing was done
+  int SeekEventIndex(const SyncObject *mastersync);
   void ReadRunTTree(const int i) { m_ReadRunTTree = i; }
 
  private:
   int m_ReadRunTTree;
+  long m_CacheSize;
+  bool m_Prefetch;
+  bool m_LazyLoading;
+  bool m_EventIndexEnabled;
+  bool m_EventIndexSidecar;
   int events_total;
   int events_thisfile;
   int events_skipped_during_sync;
@@ -41,6 +77,13 @@ class Fun4AllDstInputManager : public Fun4AllInputManager
   std::string RunNode;
   std::map<const std::string, int> branchread;
   std::string syncbranchname;
+  std::set<std::string> m_EagerNodes;
+  //! run, segment, event counter -> first entry with these values
+  std::map<std::tuple<int, int, int>, unsigned long> m_EventIndex;
+  unsigned long m_EventIndexEntries;
+  //! bytes of the files which are already closed
+  double m_BytesReadClosed;
+  double m_BytesDecompressedClosed;
   PHCompositeNode *dstNode;
   PHCompositeNode *runNode;
   PHCompositeNode *runNodeCopy;
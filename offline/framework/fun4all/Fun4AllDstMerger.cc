@@ -0,0 +1,273 @@
+#include "Fun4AllDstMerger.h"
+
+#include <frog/FROG.h>
+
+#include <phool/PHCompositeNode.h>
+#include <phool/PHNodeIOManager.h>
+#include <phool/PHNodeIntegrate.h>
+#include <phool/PHNodeIterator.h>
+#include <phool/phool.h>  // for PHWHERE, PHReadOnly, PHRunTree
+
+#include <TBranch.h>
+#include <TBranchElement.h>
+#include <TChain.h>
+#include <TDirectory.h>
+#include <TFile.h>
+#include <TObjArray.h>
+#include <TROOT.h>
+#include <TTree.h>
+
+#include <fstream>
+#include <iostream>
+
+using namespace std;
+
+Fun4AllDstMerger::Fun4AllDstMerger(const string &name, const string &outfile)
+  : Fun4AllBase(name)
+  , m_OutFileName(outfile)
+  , m_Entries(0)
+{
+}
+
+Fun4AllDstMerger::~Fun4AllDstMerger()
+{
+}
+
+int Fun4AllDstMerger::AddFile(const string &filename)
+{
+  if (Verbosity() > 0)
+  {
+    cout << Name() << ": Adding " << filename << " to list of input files" << endl;
+  }
+  m_Files.push_back(filename);
+  return 0;
+}
+
+int Fun4AllDstMerger::AddListFile(const string &filename)
+{
+  ifstream infile;
+  infile.open(filename.c_str(), ios_base::in);
+  if (!infile)
+  {
+    cout << PHWHERE << "Could not open " << filename << endl;
+    return -1;
+  }
+  string FullLine;
+  while (getline(infile, FullLine))
+  {
+    if (FullLine.size() && FullLine[0] != '#')  // remove comments
+    {
+      AddFile(FullLine);
+    }
+  }
+  infile.close();
+  return 0;
+}
+
+int Fun4AllDstMerger::Merge()
+{
+  if (m_Files.empty())
+  {
+    cout << PHWHERE << Name() << ": no input files" << endl;
+    return -1;
+  }
+  int iret = MergeEventTrees();
+  if (iret)
+  {
+    return iret;
+  }
+  return MergeRunTrees();
+}
+
+Fun4AllDstMerger::Schema Fun4AllDstMerger::GetSchema(TTree *tree) const
+{
+  Schema schema;
+  TObjArray *branches = tree->GetListOfBranches();
+  for (int i = 0; i < branches->GetEntriesFast(); i++)
+  {
+    TBranch *branch = static_cast<TBranch *>(branches->UncheckedAt(i));
+    TBranchElement *element = dynamic_cast<TBranchElement *>(branch);
+    if (element)
+    {
+      schema[branch->GetName()] = make_pair(element->GetClassName(), element->GetClassVersion());
+    }
+    else
+    {
+      // leaflist branches, the title is the leaf list
+      schema[branch->GetName()] = make_pair(branch->GetTitle(), 0);
+    }
+  }
+  return schema;
+}
+
+bool Fun4AllDstMerger::CompareSchema(const Schema &reference, const Schema &schema, const string &filename) const
+{
+  bool compatible = true;
+  for (auto &branch : reference)
+  {
+    auto iter = schema.find(branch.first);
+    if (iter == schema.end())
+    {
+      cout << Name() << ": branch " << branch.first << " missing in " << filename << endl;
+      compatible = false;
+    }
+    else if (iter->second != branch.second)
+    {
+      cout << Name() << ": branch " << branch.first << " is " << iter->second.first
+           << " version " << iter->second.second << " in " << filename
+           << ", expected " << branch.second.first << " version " << branch.second.second << endl;
+      compatible = false;
+    }
+  }
+  for (auto &branch : schema)
+  {
+    if (reference.find(branch.first) == reference.end())
+    {
+      cout << Name() << ": additional branch " << branch.first << " in " << filename << endl;
+      compatible = false;
+    }
+  }
+  return compatible;
+}
+
+int Fun4AllDstMerger::MergeEventTrees()
+{
+  FROG frog;
+  TChain chain("T");
+  Schema reference;
+  int compression = -1;
+  m_Entries = 0;
+  for (auto &filename : m_Files)
+  {
+    string fullfilename = frog.location(filename);
+    TFile *f = TFile::Open(fullfilename.c_str());
+    if (!f || f->IsZombie())
+    {
+      cout << PHWHERE << Name() << ": could not open " << fullfilename << endl;
+      delete f;
+      return -1;
+    }
+    TTree *tree = dynamic_cast<TTree *>(f->Get("T"));
+    if (!tree)
+    {
+      cout << PHWHERE << Name() << ": no event tree in " << fullfilename << endl;
+      f->Close();
+      delete f;
+      return -1;
+    }
+    if (compression < 0)
+    {
+      // the copied baskets keep their compression, use the same for the new ones
+      compression = f->GetCompressionSettings();
+      reference = GetSchema(tree);
+    }
+    else if (!CompareSchema(reference, GetSchema(tree), fullfilename))
+    {
+      cout << PHWHERE << Name() << ": " << fullfilename << " is not compatible with "
+           << m_Files.front() << ", not merging" << endl;
+      f->Close();
+      delete f;
+      return -1;
+    }
+    m_Entries += tree->GetEntries();
+    if (Verbosity() > 0)
+    {
+      cout << Name() << ": " << fullfilename << " has " << tree->GetEntries() << " events" << endl;
+    }
+    f->Close();
+    delete f;
+    chain.Add(fullfilename.c_str());
+  }
+
+  string currdir = gDirectory->GetPath();
+  TFile *outfile = TFile::Open(m_OutFileName.c_str(), "RECREATE", "titled by PHOOL");
+  if (!outfile || outfile->IsZombie())
+  {
+    cout << PHWHERE << Name() << ": could not open " << m_OutFileName << endl;
+    delete outfile;
+    gROOT->cd(currdir.c_str());
+    return -1;
+  }
+  outfile->SetCompressionSettings(compression);
+  // keep: the file stays open so we can check the result before closing it
+  Long64_t merged = chain.Merge(outfile, 0, "fast keep");
+  TTree *outtree = dynamic_cast<TTree *>(outfile->Get("T"));
+  Long64_t written = (outtree ? outtree->GetEntries() : 0);
+  outfile->Close();
+  delete outfile;
+  gROOT->cd(currdir.c_str());
+  if (merged <= 0 && m_Entries > 0)
+  {
+    cout << PHWHERE << Name() << ": merging event trees into " << m_OutFileName << " failed" << endl;
+    return -1;
+  }
+  if (written != m_Entries)
+  {
+    cout << PHWHERE << Name() << ": " << m_OutFileName << " has " << written
+         << " events, expected " << m_Entries << endl;
+    return -1;
+  }
+  return 0;
+}
+
+int Fun4AllDstMerger::MergeRunTrees()
+{
+  FROG frog;
+  PHCompositeNode *runNode = new PHCompositeNode("RUN");
+  PHCompositeNode *runNodeSum = new PHCompositeNode("RUNNODESUM");
+  for (auto &filename : m_Files)
+  {
+    string fullfilename = frog.location(filename);
+    PHNodeIOManager *IManager = new PHNodeIOManager(fullfilename, PHReadOnly, PHRunTree);
+    if (IManager->isFunctional())
+    {
+      IManager->read(runNode);
+      // same as Fun4AllDstInputManager, the copy is integrated into the sum
+      // and the sum is copied back to the run node
+      PHCompositeNode *runNodeCopy = new PHCompositeNode("RUNNODECOPY");
+      PHNodeIOManager *tmpIman = new PHNodeIOManager(fullfilename, PHReadOnly, PHRunTree);
+      tmpIman->read(runNodeCopy);
+      delete tmpIman;
+
+      PHNodeIntegrate integrate;
+      integrate.RunNode(runNode);
+      integrate.RunSumNode(runNodeSum);
+      PHNodeIterator mainIter(runNodeCopy);
+      mainIter.forEach(integrate);
+      delete runNodeCopy;
+    }
+    else
+    {
+      cout << Name() << ": no run tree in " << fullfilename << endl;
+    }
+    delete IManager;
+  }
+  PHNodeIOManager *dstOut = new PHNodeIOManager(m_OutFileName, PHUpdate, PHRunTree);
+  int iret = 0;
+  if (!dstOut->isFunctional() || !dstOut->write(runNode))
+  {
+    cout << PHWHERE << Name() << ": could not write run tree to " << m_OutFileName << endl;
+    iret = -1;
+  }
+  delete dstOut;
+  delete runNode;
+  delete runNodeSum;
+  return iret;
+}
+
+void Fun4AllDstMerger::Print(const string &what) const
+{
+  if (what == "ALL" || what == "FILES")
+  {
+    cout << Name() << ": merging into " << m_OutFileName << endl;
+    for (auto &filename : m_Files)
+    {
+      cout << filename << endl;
+    }
+  }
+  if (what == "ALL")
+  {
+    cout << Name() << ": " << m_Entries << " events merged" << endl;
+  }
+  return;
+}
@@ -0,0 +1,59 @@
+// Tell emacs that this is a C++ source
+//  -*- C++ -*-.
+#ifndef FUN4ALL_FUN4ALLDSTMERGER_H
+#define FUN4ALL_FUN4ALLDSTMERGER_H
+
+#include "Fun4AllBase.h"
+
+#include <map>
+#include <string>
+#include <utility>
+#include <vector>
+
+class PHCompositeNode;
+class TTree;
+
+/*!
+ * \brief merges DST segments without unpacking the events
+ *
+ * The event trees are copied basket by basket (TTree::CopyEntries with the
+ * "fast" option), the compressed buffers are not touched. All inputs must have
+ * the same branches with the same classes and class versions as the first file,
+ * otherwise the merge is refused. The run trees are read via PHNodeIOManager and
+ * the run objects which implement Integrate() are summed like
+ * Fun4AllDstInputManager does when reading several files.
+ */
+class Fun4AllDstMerger : public Fun4AllBase
+{
+ public:
+  Fun4AllDstMerger(const std::string &name = "DSTMERGER", const std::string &outfile = "merged.root");
+  virtual ~Fun4AllDstMerger();
+
+  int AddFile(const std::string &filename);
+  //! adds all files in a list file (one file per line, # starts a comment)
+  int AddListFile(const std::string &filename);
+
+  void OutFileName(const std::string &fname) { m_OutFileName = fname; }
+  const std::string &OutFileName() const { return m_OutFileName; }
+
+  //! merges all added files into the output file, 0 on success
+  int Merge();
+
+  void Print(const std::string &what = "ALL") const;
+
+ private:
+  //! class name and class version by branch name
+  typedef std::map<std::string, std::pair<std::string, int> > Schema;
+
+  Schema GetSchema(TTree *tree) const;
+  //! false if the schema of file differs from the reference
+  bool CompareSchema(const Schema &reference, const Schema &schema, const std::string &filename) const;
+  int MergeEventTrees();
+  int MergeRunTrees();
+
+  std::string m_OutFileName;
+  std::vector<std::string> m_Files;
+  long long m_Entries;
+};
+
+#endif
@@ -2,11 +2,21 @@
 
 #include "Fun4AllServer.h"
 
+#include <phool/PHCompositeNode.h>
+#include <phool/PHIODataNode.h>
 #include <phool/PHNode.h>
 #include <phool/PHNodeIOManager.h>
 #include <phool/PHNodeIterator.h>
+#include <phool/PHObject.h>
+#include <phool/PHPointerListIterator.h>
 #include <phool/phool.h>            // for PHWHERE, PHReadOnly, PHRunTree
 
+#include <RVersion.h>
+#include <TDirectory.h>
+#include <TFile.h>
+#include <TROOT.h>
+#include <TTree.h>
+
 #include <boost/foreach.hpp>
 
 #include <cstdlib>
@@ -15,8 +25,61 @@
 
 using namespace std;
 
+namespace
+{
+  // copy the persistent objects below from into to, keeping the node
+  // structure so the branch names are the same as for the original tree.
+  // The objects are copied through their streamer (PHObject::StreamCopy),
+  // the copy is what would be written and no class needs a CloneMe().
+  // Returns false if an object cannot be copied
+  bool SnapshotNodes(PHCompositeNode *from, PHCompositeNode *to)
+  {
+    PHNodeIterator nodeiter(from);
+    PHPointerListIterator<PHNode> iter(nodeiter.ls());
+    PHNode *thisNode;
+    while ((thisNode = iter()))
+    {
+      if (thisNode->getType() == "PHCompositeNode")
+      {
+        PHCompositeNode *copy = new PHCompositeNode(thisNode->getName());
+        to->addNode(copy);
+        if (!SnapshotNodes(static_cast<PHCompositeNode *>(thisNode), copy))
+        {
+          return false;
+        }
+      }
+      else if (thisNode->getType() == "PHIODataNode" && thisNode->isPersistent())
+      {
+        PHIODataNode<PHObject> *datanode = static_cast<PHIODataNode<PHObject> *>(thisNode);
+        PHObject *obj = dynamic_cast<PHObject *>(datanode->getData());
+        PHObject *clone = (obj ? obj->StreamCopy() : nullptr);
+        if (!clone)
+        {
+          cout << PHWHERE << " cannot copy node " << thisNode->getName()
+               << " of class " << thisNode->getClass() << endl;
+          return false;
+        }
+        PHIODataNode<PHObject> *copy = new PHIODataNode<PHObject>(clone, thisNode->getName(), thisNode->getObjectType());
+        copy->BufferSize(datanode->BufferSize());
+        copy->SplitLevel(datanode->SplitLevel());
+        to->addNode(copy);
+      }
+    }
+    return true;
+  }
+}  // namespace
+
 Fun4AllDstOutputManager::Fun4AllDstOutputManager(const string &myname, const string &fname)
   : Fun4AllOutputManager(myname, fname)
+  , m_QueueDepth(0)
+  , m_CompressionThreads(0)
+  , m_CompressionAlgorithm(0)
+  , m_CompressionLevel(3)
+  , m_AutoFlush(0)
+  , m_IOStatistics(false)
+  , m_BytesWrittenClosed(0)
+  , m_StopWriter(false)
+  , m_BytesWritten(0)
 {
   dstOut = new PHNodeIOManager(fname, PHWrite);
   if (!dstOut->isFunctional())
@@ -26,12 +89,13 @@ Fun4AllDstOutputManager::Fun4AllDstOutputManager(const string &myname, const str
          << " exiting now" << endl;
     exit(1);
   }
-  dstOut->SetCompressionLevel(3);
+  ConfigureOutput();
   return;
 }
 
 Fun4AllDstOutputManager::~Fun4AllDstOutputManager()
 {
+  StopWriter();
   delete dstOut;
   return;
 }
@@ -56,6 +120,13 @@ int Fun4AllDstOutputManager::StripRunNode(const string &nodename)
 
 int Fun4AllDstOutputManager::outfileopen(const string &fname)
 {
+  // events still queued belong to the old file
+  WaitForWriter();
+  if (m_IOStatistics && dstOut)
+  {
+    dstOut->PrintBranchStatistics();
+  }
+  CloseBytesWritten();
   delete dstOut;
   dstOut = new PHNodeIOManager(fname, PHWrite);
   if (!dstOut->isFunctional())
@@ -66,10 +137,66 @@ int Fun4AllDstOutputManager::outfileopen(const string &fname)
     return -1;
   }
 
-  dstOut->SetCompressionLevel(3);
+  ConfigureOutput();
   return 0;
 }
 
+void Fun4AllDstOutputManager::ConfigureOutput()
+{
+  dstOut->SetCompressionLevel(m_CompressionLevel);
+  dstOut->SetCompressionAlgorithm(m_CompressionAlgorithm);
+  dstOut->SetAutoFlush(m_AutoFlush);
+  for (auto &policy : m_NodeIOPolicies)
+  {
+    dstOut->SetBranchPolicy(policy.first, policy.second.algorithm, policy.second.level, policy.second.basketsize);
+  }
+  return;
+}
+
+void Fun4AllDstOutputManager::CompressionAlgorithm(const int algorithm)
+{
+  m_CompressionAlgorithm = algorithm;
+  if (dstOut)
+  {
+    dstOut->SetCompressionAlgorithm(m_CompressionAlgorithm);
+  }
+  return;
+}
+
+void Fun4AllDstOutputManager::CompressionLevel(const int level)
+{
+  m_CompressionLevel = level;
+  if (dstOut)
+  {
+    dstOut->SetCompressionLevel(m_CompressionLevel);
+  }
+  return;
+}
+
+void Fun4AllDstOutputManager::AutoFlush(const long long n)
+{
+  m_AutoFlush = n;
+  if (dstOut)
+  {
+    dstOut->SetAutoFlush(m_AutoFlush);
+  }
+  return;
+}
+
+void Fun4AllDstOutputManager::SetNodeIOPolicy(const string &nodename, const int algorithm, const int level, const int basketsize)
+{
+  NodeIOPolicy policy;
+  policy.algorithm = algorithm;
+  policy.level = level;
+  policy.basketsize = basketsize;
+  m_NodeIOPolicies[nodename] = policy;
+  if (dstOut)
+  {
+    dstOut->SetBranchPolicy(nodename, algorithm, level, basketsize);
+  }
+  return;
+}
+
 void Fun4AllDstOutputManager::Print(const string &what) const
 {
   if (what == "ALL" || what == "WRITENODES")
@@ -98,6 +225,36 @@ void Fun4AllDstOutputManager::Print(const string &what) const
       }
     }
   }
+  if (what == "ALL" || what == "IO")
+  {
+    cout << Name() << ": compression algorithm " << m_CompressionAlgorithm
+         << ", level " << m_CompressionLevel;
+    if (m_AutoFlush)
+    {
+      cout << ", auto flush " << m_AutoFlush;
+    }
+    cout << endl;
+    for (auto &policy : m_NodeIOPolicies)
+    {
+      cout << Name() << ": Node " << policy.first << " algorithm " << policy.second.algorithm
+           << ", level " << policy.second.level << ", basket size " << policy.second.basketsize << endl;
+    }
+  }
+  if (what == "ALL" || what == "ASYNC")
+  {
+    if (m_QueueDepth > 0)
+    {
+      cout << Name() << ": asynchronous writing, queue depth " << m_QueueDepth << endl;
+    }
+    else
+    {
+      cout << Name() << ": synchronous writing" << endl;
+    }
+    if (m_CompressionThreads > 0)
+    {
+      cout << Name() << ": " << m_CompressionThreads << " compression threads" << endl;
+    }
+  }
   // base class print method
   Fun4AllOutputManager::Print(what);
 
@@ -113,9 +270,16 @@ void Fun4AllDstOutputManager::Print(const string &what) const
 // if we want to strip nodes (only meaningful if we take the default
 // that everything is written out), those nodes are declared transient
 int Fun4AllDstOutputManager::Write(PHCompositeNode *startNode)
+{
+  SelectNodes(startNode);
+  WriteEvent(startNode);
+  DeselectNodes(startNode);
+  return 0;
+}
+
+void Fun4AllDstOutputManager::SelectNodes(PHCompositeNode *startNode)
 {
   PHNodeIterator nodeiter(startNode);
-  //  vector<string>::iterator iter;
   PHNode *ChosenNode = 0;
   if (savenodes.empty())
   {
@@ -160,7 +324,11 @@ int Fun4AllDstOutputManager::Write(PHCompositeNode *startNode)
       }
     }
   }
-  dstOut->write(startNode);
+  return;
+}
+
+void Fun4AllDstOutputManager::DeselectNodes(PHCompositeNode *startNode)
+{
   if (savenodes.empty())
   {
     Fun4AllServer *se = Fun4AllServer::instance();
@@ -168,20 +336,187 @@ int Fun4AllDstOutputManager::Write(PHCompositeNode *startNode)
   }
   else
   {
+    PHNodeIterator nodeiter(startNode);
     BOOST_FOREACH (string nodename, savenodes)
     {
-      ChosenNode = nodeiter.findFirst("PHIODataNode", nodename);
+      PHNode *ChosenNode = nodeiter.findFirst("PHIODataNode", nodename);
       if (ChosenNode)
       {
         ChosenNode->makeTransient();
       }
     }
   }
+  return;
+}
+
+// copy of the selected nodes for the reorder buffer, an event which finished
+// before earlier events is kept until it can be written in input order.
+// The copy is made through the streamers like the one for the writer thread
+// and is handed to it unchanged by WriteSnapshot(), so it is not copied twice
+PHCompositeNode *Fun4AllDstOutputManager::SnapshotEvent(PHCompositeNode *startNode)
+{
+  SelectNodes(startNode);
+  PHCompositeNode *snapshot = new PHCompositeNode(startNode->getName());
+  bool copied = SnapshotNodes(startNode, snapshot);
+  DeselectNodes(startNode);
+  if (!copied)
+  {
+    delete snapshot;
+    return nullptr;
+  }
+  return snapshot;
+}
+
+int Fun4AllDstOutputManager::WriteSnapshot(PHCompositeNode *snapshot)
+{
+  if (m_QueueDepth > 0)
+  {
+    Enqueue(snapshot);
+    return 0;
+  }
+  dstOut->write(snapshot);
+  dstOut->ResetBranchAddresses();
+  CountBytesWritten();
+  delete snapshot;
+  return 0;
+}
+
+// the persistent objects are copied and handed to the writer thread,
+// Fill() and compression then overlap with the next event. If an object
+// cannot be copied (a class without I/O) asynchronous writing is switched off for good
+int Fun4AllDstOutputManager::WriteEvent(PHCompositeNode *startNode)
+{
+#if ROOT_VERSION_CODE >= ROOT_VERSION(6, 10, 0)
+  // with implicit multithreading TTree::Fill() compresses the baskets in parallel
+  if (m_CompressionThreads > 0 && !ROOT::IsImplicitMTEnabled())
+  {
+    ROOT::EnableImplicitMT(m_CompressionThreads);
+  }
+#endif
+  if (m_QueueDepth == 0)
+  {
+    dstOut->write(startNode);
+    CountBytesWritten();
+    return 0;
+  }
+  PHCompositeNode *snapshot = new PHCompositeNode(startNode->getName());
+  if (!SnapshotNodes(startNode, snapshot))
+  {
+    cout << PHWHERE << Name() << ": switching to synchronous writing" << endl;
+    delete snapshot;
+    WaitForWriter();
+    StopWriter();
+    m_QueueDepth = 0;
+    dstOut->write(startNode);
+    CountBytesWritten();
+    return 0;
+  }
+  Enqueue(snapshot);
   return 0;
 }
 
+void Fun4AllDstOutputManager::Enqueue(PHCompositeNode *snapshot)
+{
+  if (!m_Writer.joinable())
+  {
+    StartWriter();
+  }
+  unique_lock<mutex> lock(m_QueueMutex);
+  m_QueueCondition.wait(lock, [this] { return m_Queue.size() < m_QueueDepth; });
+  m_Queue.push_back(snapshot);
+  lock.unlock();
+  m_QueueCondition.notify_all();
+}
+
+void Fun4AllDstOutputManager::StartWriter()
+{
+  // the writer thread uses ROOT concurrently with the event loop
+  ROOT::EnableThreadSafety();
+  m_StopWriter = false;
+  m_Writer = thread(&Fun4AllDstOutputManager::WriterLoop, this);
+}
+
+void Fun4AllDstOutputManager::WriterLoop()
+{
+  while (true)
+  {
+    PHCompositeNode *snapshot = nullptr;
+    {
+      unique_lock<mutex> lock(m_QueueMutex);
+      m_QueueCondition.wait(lock, [this] { return !m_Queue.empty() || m_StopWriter; });
+      if (m_Queue.empty())
+      {
+        return;
+      }
+      snapshot = m_Queue.front();
+    }
+    dstOut->write(snapshot);
+    // the branches must not point to the objects we are about to delete
+    dstOut->ResetBranchAddresses();
+    CountBytesWritten();
+    delete snapshot;
+    {
+      lock_guard<mutex> lock(m_QueueMutex);
+      m_Queue.pop_front();
+    }
+    m_QueueCondition.notify_all();
+  }
+}
+
+void Fun4AllDstOutputManager::CountBytesWritten()
+{
+  m_BytesWritten = m_BytesWrittenClosed + dstOut->GetBytesWritten();
+}
+
+void Fun4AllDstOutputManager::CloseBytesWritten()
+{
+  if (dstOut)
+  {
+    CountBytesWritten();
+    m_BytesWrittenClosed = m_BytesWritten;
+  }
+}
+
+unsigned long long Fun4AllDstOutputManager::BytesWritten() const
+{
+  return m_BytesWritten;
+}
+
+unsigned int Fun4AllDstOutputManager::QueueDepth() const
+{
+  lock_guard<mutex> lock(m_QueueMutex);
+  return m_Queue.size();
+}
+
+void Fun4AllDstOutputManager::WaitForWriter()
+{
+  unique_lock<mutex> lock(m_QueueMutex);
+  m_QueueCondition.wait(lock, [this] { return m_Queue.empty(); });
+}
+
+void Fun4AllDstOutputManager::StopWriter()
+{
+  if (!m_Writer.joinable())
+  {
+    return;
+  }
+  {
+    lock_guard<mutex> lock(m_QueueMutex);
+    m_StopWriter = true;
+  }
+  m_QueueCondition.notify_all();
+  m_Writer.join();
+}
+
 int Fun4AllDstOutputManager::WriteNode(PHCompositeNode *thisNode)
 {
+  // all events have to be on the file before it is reopened for the run tree
+  StopWriter();
+  if (m_IOStatistics && dstOut)
+  {
+    dstOut->PrintBranchStatistics();
+  }
+  CloseBytesWritten();
   delete dstOut;
   dstOut = new PHNodeIOManager(OutFileName(), PHUpdate, PHRunTree);
   Fun4AllServer *se = Fun4AllServer::instance();
@@ -200,7 +535,40 @@ int Fun4AllDstOutputManager::WriteNode(PHCompositeNode *thisNode)
   }
   dstOut->write(thisNode);
   se->MakeNodesPersistent(thisNode);
+  CloseBytesWritten();
   delete dstOut;
   dstOut = nullptr;
+  if (OutputOrder() == kCompletionOrder)
+  {
+    WriteSlotIndex();
+  }
   return 0;
 }
+
+// events written in completion order: the tree EventSlot has the input slot
+// of every entry of T, so readers can restore the input order
+void Fun4AllDstOutputManager::WriteSlotIndex()
+{
+  string currdir = gDirectory->GetPath();
+  TFile *f = TFile::Open(OutFileName().c_str(), "UPDATE");
+  if (!f || f->IsZombie())
+  {
+    cout << PHWHERE << Name() << ": could not open " << OutFileName()
+         << " for the slot index" << endl;
+    delete f;
+    gROOT->cd(currdir.c_str());
+    return;
+  }
+  ULong64_t slot = 0;
+  TTree *index = new TTree("EventSlot", "input slot of the events in T");
+  index->Branch("slot", &slot, "slot/l");
+  for (unsigned long long islot : SlotIndex())
+  {
+    slot = islot;
+    index->Fill();
+  }
+  index->Write();
+  f->Close();
+  delete f;
+  gROOT->cd(currdir.c_str());
+}
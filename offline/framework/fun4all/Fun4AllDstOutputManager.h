@@ -5,9 +5,18 @@
 
 #include "Fun4AllOutputManager.h"
 
+#include <map>
 #include <set>
 #include <string>
 
+#if !defined(__CINT__) || defined(__CLING__)
+#include <atomic>
+#include <condition_variable>
+#include <deque>
+#include <mutex>
+#include <thread>
+#endif
+
 class PHNodeIOManager;
 class PHCompositeNode;
 
@@ -27,11 +36,84 @@ class Fun4AllDstOutputManager : public Fun4AllOutputManager
   int Write(PHCompositeNode *startNode);
   int WriteNode(PHCompositeNode *thisNode);
 
+  //! write events in a separate thread, at most depth events are queued (0: write synchronously)
+  void AsyncWrite(const unsigned int depth) { m_QueueDepth = depth; }
+  unsigned int AsyncWrite() const { return m_QueueDepth; }
+  //! number of threads ROOT uses to compress baskets (0: no implicit multithreading)
+  void CompressionThreads(const unsigned int n) { m_CompressionThreads = n; }
+
+  //! compression of the whole file (algorithm: 1 zlib, 2 lzma, 4 lz4, 5 zstd)
+  void CompressionAlgorithm(const int algorithm);
+  void CompressionLevel(const int level);
+  //! entries (positive) or bytes (negative) between basket flushes
+  void AutoFlush(const long long n);
+  /*!
+    \brief output settings of a single node, e.g. lz4 for nodes read often
+    and lzma for archived ones. algorithm 0 and level -1 keep the file
+    setting, basketsize 0 keeps the default buffer size of the node
+  */
+  void SetNodeIOPolicy(const std::string &nodename, const int algorithm, const int level = -1, const int basketsize = 0);
+  //! print bytes and compression ratio per branch and the write time when the file is closed
+  void IOStatistics(const bool b) { m_IOStatistics = b; }
+
+  unsigned long long BytesWritten() const;
+  unsigned int QueueDepth() const;
+
+ protected:
+  //! streamer copy of the selected nodes (PHObject::StreamCopy), nullptr only if a class has no I/O
+  PHCompositeNode *SnapshotEvent(PHCompositeNode *startNode);
+  int WriteSnapshot(PHCompositeNode *snapshot);
+
  private:
+  struct NodeIOPolicy
+  {
+    int algorithm;
+    int level;
+    int basketsize;
+  };
+
+  int WriteEvent(PHCompositeNode *startNode);
+  //! applies AddNode/StripNode to the persistency flags
+  void SelectNodes(PHCompositeNode *startNode);
+  //! makes the nodes transient again after writing
+  void DeselectNodes(PHCompositeNode *startNode);
+  void WriteSlotIndex();
+  //! applies the compression and node settings to a newly opened output file
+  void ConfigureOutput();
+  //! updates the byte count after a write, in the thread which wrote
+  void CountBytesWritten();
+  //! adds the current file to the bytes of the closed files before dstOut is deleted
+  void CloseBytesWritten();
+#if !defined(__CINT__) || defined(__CLING__)
+  void Enqueue(PHCompositeNode *snapshot);
+  void StartWriter();
+  void StopWriter();
+  void WaitForWriter();
+  void WriterLoop();
+#endif
+
   std::set<std::string> savenodes;
   std::set<std::string> stripnodes;
   std::set<std::string> striprunnodes;
   PHNodeIOManager *dstOut;
+  unsigned int m_QueueDepth;
+  unsigned int m_CompressionThreads;
+  int m_CompressionAlgorithm;
+  int m_CompressionLevel;
+  long long m_AutoFlush;
+  bool m_IOStatistics;
+  double m_BytesWrittenClosed;
+  std::map<std::string, NodeIOPolicy> m_NodeIOPolicies;
+#if !defined(__CINT__) || defined(__CLING__)
+  //! snapshots of the persistent nodes waiting to be written (front is being written)
+  std::deque<PHCompositeNode *> m_Queue;
+  mutable std::mutex m_QueueMutex;
+  std::condition_variable m_QueueCondition;
+  std::thread m_Writer;
+  bool m_StopWriter;
+  //! read by BytesWritten() while the writer thread updates it
+  std::atomic<unsigned long long> m_BytesWritten;
+#endif
 };
 
 #endif
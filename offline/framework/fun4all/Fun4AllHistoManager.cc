@@ -7,7 +7,9 @@
 
 #include <TFile.h>
 #include <TH1.h>
+#include <TList.h>
 #include <TNamed.h>
+#include <TROOT.h>
 #include <TTree.h>
 
 #include <RVersion.h>
@@ -18,19 +20,66 @@
 
 #include <iomanip>
 #include <iostream>
+#include <mutex>
+#include <set>
 #include <sstream>
+#include <thread>
 #include <utility>             // for pair
 
 using namespace std;
 
+namespace
+{
+  // managers which can still take back thread copies
+  mutex s_ManagersMutex;
+  set<Fun4AllHistoManager *> s_Managers;
+
+  // hands the copies of an exiting thread back to its managers
+  struct ThreadHistoRelease
+  {
+    set<Fun4AllHistoManager *> managers;
+    ~ThreadHistoRelease()
+    {
+      lock_guard<mutex> lock(s_ManagersMutex);
+      for (Fun4AllHistoManager *hm : managers)
+      {
+        if (s_Managers.find(hm) != s_Managers.end())
+        {
+          hm->releaseThreadHistos();
+        }
+      }
+    }
+  };
+  thread_local ThreadHistoRelease t_ThreadHistoRelease;
+}  // namespace
+
 Fun4AllHistoManager::Fun4AllHistoManager(const string &name)
   : Fun4AllBase(name)
+  , m_AsyncWrite(false)
+  , m_Compression(9)
+  , m_OwnerThread(this_thread::get_id())
+  , m_WriterStatus(0)
 {
+  lock_guard<mutex> lock(s_ManagersMutex);
+  s_Managers.insert(this);
   return;
 }
 
 Fun4AllHistoManager::~Fun4AllHistoManager()
 {
+  {
+    lock_guard<mutex> lock(s_ManagersMutex);
+    s_Managers.erase(this);
+  }
+  WaitForWrite();
+  for (auto &thread_histos : m_ThreadHisto)
+  {
+    for (auto &hiter : thread_histos)
+    {
+      delete hiter.second;
+    }
+  }
+  m_ThreadHisto.clear();
   while (Histo.begin() != Histo.end())
   {
     delete Histo.begin()->second;
@@ -41,7 +90,6 @@ Fun4AllHistoManager::~Fun4AllHistoManager()
 
 int Fun4AllHistoManager::dumpHistos(const string &filename, const string &openmode)
 {
-  int iret = 0;
   if (!filename.empty())
   {
     outfilename = filename;
@@ -68,21 +116,87 @@ int Fun4AllHistoManager::dumpHistos(const string &filename, const string &openmo
   }
   cout << "Fun4AllHistoManager::dumpHistos() Writing root file: " << outfilename << endl;
 
-  const int compress = 9;
+  mergeThreadHistos();
+
+  // the previous file might be the same one
+  int iret = WaitForWrite();
+
+  HistoList histos;
+  if (!m_AsyncWrite)
+  {
+    for (auto &hiter : Histo)
+    {
+      histos.push_back(make_pair(hiter.first, hiter.second));
+    }
+    int iwrite = WriteHistos(histos, outfilename, openmode, false);
+    return (iwrite ? iwrite : iret);
+  }
+
+  // snapshot of the current state, the originals keep being filled
+  // while the copies are written
+  for (auto &hiter : Histo)
+  {
+    // null pointers are passed on, WriteHistos complains about them
+    TNamed *hcopy = nullptr;
+    if (hiter.second && hiter.second->InheritsFrom("TTree"))
+    {
+      TTree *tcopy = static_cast<TTree *>(hiter.second)->CloneTree(-1);
+      tcopy->SetDirectory(nullptr);
+      hcopy = tcopy;
+    }
+    else if (hiter.second)
+    {
+      hcopy = static_cast<TNamed *>(hiter.second->Clone());
+      if (hcopy->InheritsFrom("TH1"))
+      {
+        static_cast<TH1 *>(hcopy)->SetDirectory(nullptr);
+      }
+    }
+    histos.push_back(make_pair(hiter.first, hcopy));
+  }
+  ROOT::EnableThreadSafety();
+  const string filename_copy = outfilename;
+  m_Writer = thread([this, histos, filename_copy, openmode]() {
+    m_WriterStatus = WriteHistos(histos, filename_copy, openmode, true);
+  });
+  return iret;
+}
+
+int Fun4AllHistoManager::WaitForWrite()
+{
+  if (!m_Writer.joinable())
+  {
+    return 0;
+  }
+  m_Writer.join();
+  int iret = m_WriterStatus;
+  m_WriterStatus = 0;
+  return iret;
+}
+
+int Fun4AllHistoManager::WriteHistos(const HistoList &histos, const string &filename, const string &openmode, const bool owner) const
+{
+  int iret = 0;
   ostringstream creator;
   creator << "Created by " << Name();
-  TFile hfile(outfilename.c_str(), openmode.c_str(), creator.str().c_str(), compress);
+  TFile hfile(filename.c_str(), openmode.c_str(), creator.str().c_str(), m_Compression);
   if (!hfile.IsOpen())
   {
-    cout << PHWHERE << " Could not open output file" << outfilename << endl;
+    cout << PHWHERE << " Could not open output file" << filename << endl;
+    if (owner)
+    {
+      for (auto &hiter : histos)
+      {
+        delete hiter.second;
+      }
+    }
     return -1;
   }
 
-  map<const string, TNamed *>::const_iterator hiter;
-  for (hiter = Histo.begin(); hiter != Histo.end(); ++hiter)
+  for (auto &hiter : histos)
   {
-    const std::string &hname = hiter->first;
-    const TNamed *hptr = hiter->second;
+    const std::string &hname = hiter.first;
+    const TNamed *hptr = hiter.second;
     if (Verbosity() > 0)
     {
       std::cout << PHWHERE << " Saving histo "
@@ -102,7 +216,7 @@ int Fun4AllHistoManager::dumpHistos(const string &filename, const string &openmo
       dirname = "";
     }
 
-    if (Verbosity())
+    if (Verbosity() && hptr)
     {
       cout << " Histogram named " << hptr->GetName();
       cout << " key " << hname;
@@ -121,7 +235,17 @@ int Fun4AllHistoManager::dumpHistos(const string &filename, const string &openmo
 
     if (hptr)
     {
+      // the compression of a key is taken from the file when it is written
+      map<string, int>::const_iterator citer = m_ObjectCompression.find(hname);
+      if (citer != m_ObjectCompression.end())
+      {
+        hfile.SetCompressionSettings(citer->second);
+      }
       int byteswritten = hptr->Write();
+      if (citer != m_ObjectCompression.end())
+      {
+        hfile.SetCompressionSettings(m_Compression);
+      }
       if (!byteswritten)
       {
         cout << PHWHERE << "Error saving histogram "
@@ -136,6 +260,10 @@ int Fun4AllHistoManager::dumpHistos(const string &filename, const string &openmo
            << hname << " is a null pointer! Won't be saved."
            << std::endl;
     }
+    if (owner)
+    {
+      delete hptr;
+    }
   }
   hfile.Close();
   return iret;
@@ -175,6 +303,21 @@ bool Fun4AllHistoManager::registerHisto(const string &hname, TNamed *h1d, const
   h1d->SetName(histoname.c_str());
   Histo[hname] = h1d;
 
+  // thread copies of a replaced histogram are stale
+  if (histoiter != Histo.end())
+  {
+    lock_guard<mutex> lock(m_ThreadHistoMutex);
+    for (auto &thread_histos : m_ThreadHisto)
+    {
+      map<string, TH1 *>::iterator copyiter = thread_histos.find(hname);
+      if (copyiter != thread_histos.end())
+      {
+        delete copyiter->second;
+        thread_histos.erase(copyiter);
+      }
+    }
+  }
+
   // reset directory for TTree
   if (h1d->InheritsFrom("TTree"))
     static_cast<TTree *>(h1d)->SetDirectory(0);
@@ -260,6 +403,89 @@ Fun4AllHistoManager::getHisto(const string &hname) const
   return nullptr;
 }
 
+TNamed *
+Fun4AllHistoManager::getThreadHisto(const string &hname)
+{
+  if (this_thread::get_id() == m_OwnerThread)
+  {
+    return getHisto(hname);
+  }
+  lock_guard<mutex> lock(m_ThreadHistoMutex);
+  // the copies belong to a worker slot, a new thread takes over the slot of
+  // an exited one, so per event threads do not pile up copies
+  unsigned int slot;
+  map<thread::id, unsigned int>::const_iterator slotiter = m_ThreadSlot.find(this_thread::get_id());
+  if (slotiter != m_ThreadSlot.end())
+  {
+    slot = slotiter->second;
+  }
+  else
+  {
+    if (m_FreeSlots.empty())
+    {
+      m_FreeSlots.push_back(m_ThreadHisto.size());
+      m_ThreadHisto.push_back(map<string, TH1 *>());
+    }
+    slot = m_FreeSlots.back();
+    m_FreeSlots.pop_back();
+    m_ThreadSlot[this_thread::get_id()] = slot;
+    t_ThreadHistoRelease.managers.insert(this);
+  }
+  map<string, TH1 *> &thread_histos = m_ThreadHisto[slot];
+  map<string, TH1 *>::const_iterator histoiter = thread_histos.find(hname);
+  if (histoiter != thread_histos.end())
+  {
+    return histoiter->second;
+  }
+  TNamed *h = getHisto(hname);
+  // only histograms can be merged, everything else is shared
+  if (!h || !h->InheritsFrom("TH1"))
+  {
+    return h;
+  }
+  TH1 *hcopy = static_cast<TH1 *>(h->Clone());
+  hcopy->SetDirectory(nullptr);
+  hcopy->Reset();
+  thread_histos[hname] = hcopy;
+  if (Verbosity() > 1)
+  {
+    cout << PHWHERE << " made thread copy of " << hname << endl;
+  }
+  return hcopy;
+}
+
+void Fun4AllHistoManager::mergeThreadHistos()
+{
+  lock_guard<mutex> lock(m_ThreadHistoMutex);
+  for (auto &thread_histos : m_ThreadHisto)
+  {
+    for (auto &hiter : thread_histos)
+    {
+      TH1 *h = static_cast<TH1 *>(Histo[hiter.first]);
+      // TH1::Merge also adds the statistics and handles extendable axes
+      TList list;
+      list.Add(hiter.second);
+      h->Merge(&list);
+      hiter.second->Reset();
+    }
+  }
+  return;
+}
+
+void Fun4AllHistoManager::releaseThreadHistos()
+{
+  lock_guard<mutex> lock(m_ThreadHistoMutex);
+  map<thread::id, unsigned int>::iterator slotiter = m_ThreadSlot.find(this_thread::get_id());
+  if (slotiter == m_ThreadSlot.end())
+  {
+    return;
+  }
+  // the contents stay in the copies until the next merge
+  m_FreeSlots.push_back(slotiter->second);
+  m_ThreadSlot.erase(slotiter);
+  return;
+}
+
 void Fun4AllHistoManager::Print(const string &what) const
 {
   if (what == "ALL" || what == "HISTOS")
@@ -282,6 +508,16 @@ void Fun4AllHistoManager::Print(const string &what) const
 
 void Fun4AllHistoManager::Reset()
 {
+  {
+    lock_guard<mutex> lock(m_ThreadHistoMutex);
+    for (auto &thread_histos : m_ThreadHisto)
+    {
+      for (auto &thread_hiter : thread_histos)
+      {
+        thread_hiter.second->Reset();
+      }
+    }
+  }
   map<const string, TNamed *>::const_iterator hiter;
   for (hiter = Histo.begin(); hiter != Histo.end(); ++hiter)
   {
@@ -7,7 +7,15 @@
 
 #include <map>
 #include <string>
+#include <utility>
+#include <vector>
 
+#if !defined(__CINT__) || defined(__CLING__)
+#include <mutex>
+#include <thread>
+#endif
+
+class TH1;
 class TNamed;
 
 class Fun4AllHistoManager : public Fun4AllBase
@@ -41,13 +49,65 @@ class Fun4AllHistoManager : public Fun4AllBase
   TNamed *getHisto(const unsigned int ihisto) const;
   const char *getHistoName(const unsigned int ihisto) const;
   unsigned int nHistos() const { return Histo.size(); }
+
+  //! histogram to fill from the calling thread.
+  //! The thread which created the manager gets the registered histogram,
+  //! any other thread gets its own copy of a registered TH1 (made on first
+  //! use), so filling needs no locking. The copies are merged into the
+  //! registered histograms by mergeThreadHistos() and dumpHistos().
+  //! The returned pointer stays valid until the manager is deleted.
+  TNamed *getThreadHisto(const std::string &hname);
+  //! add the contents of all thread copies to the registered histograms
+  //! and reset the copies
+  void mergeThreadHistos();
+  //! the calling thread is done filling, its copies are reused by the next new
+  //! thread. Called automatically when a thread which used getThreadHisto() exits
+  void releaseThreadHistos();
+
   void Reset();
+  //! write all registered objects. With AsyncWrite the objects are copied and the
+  //! copies are written by a helper thread, the return code then only covers the copy
   int dumpHistos(const std::string &filename = "", const std::string &openmode = "RECREATE");
   void setOutfileName(const std::string &filename) { outfilename = filename; }
 
+  //! let dumpHistos() return right after copying the objects, the next
+  //! dumpHistos() waits for the previous write to finish
+  void AsyncWrite(const bool b = true) { m_AsyncWrite = b; }
+  //! wait for a background write, returns its dumpHistos() return code
+  int WaitForWrite();
+
+  //! compression settings of the output file in the ROOT convention
+  //! (algorithm * 100 + level, e.g. 505 for zstd level 5), default is 9
+  void setCompression(const int settings) { m_Compression = settings; }
+  //! compression settings for a single registered object
+  void setCompression(const std::string &hname, const int settings) { m_ObjectCompression[hname] = settings; }
+
  private:
+  typedef std::vector<std::pair<std::string, TNamed *> > HistoList;
+
+  //! writes the objects to filename, deletes them if they are copies
+  int WriteHistos(const HistoList &histos, const std::string &filename, const std::string &openmode, const bool owner) const;
+
   std::string outfilename;
   std::map<const std::string, TNamed *> Histo;
+
+  bool m_AsyncWrite;
+  int m_Compression;
+  std::map<std::string, int> m_ObjectCompression;
+
+#if !defined(__CINT__) || defined(__CLING__)
+  std::thread::id m_OwnerThread;
+  std::mutex m_ThreadHistoMutex;
+  //! copies of the registered histograms per worker slot
+  std::vector<std::map<std::string, TH1 *> > m_ThreadHisto;
+  //! slot of every thread which is filling copies
+  std::map<std::thread::id, unsigned int> m_ThreadSlot;
+  std::vector<unsigned int> m_FreeSlots;
+
+  //! writes the copies made by dumpHistos() in AsyncWrite mode
+  std::thread m_Writer;
+  int m_WriterStatus;
+#endif
 };
 
 #endif /* __FUN4ALLHISTOMANAGER_H */
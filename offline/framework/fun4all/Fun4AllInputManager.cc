@@ -3,6 +3,8 @@
 #include "Fun4AllServer.h"
 #include "SubsysReco.h"
 
+#include <frog/FROG.h>
+
 #include <phool/phool.h>
 
 #include <boost/filesystem.hpp>
@@ -20,6 +22,7 @@ Fun4AllInputManager::Fun4AllInputManager(const string &name, const string &noden
   , m_Repeat(0)
   , m_MyRunNumber(0)
   , m_InitRun(0)
+  , m_PrefetchFileLocations(false)
   , m_InputNode(nodename)
   , m_TopNodeName(topnodename)
 {
@@ -28,6 +31,10 @@ Fun4AllInputManager::Fun4AllInputManager(const string &name, const string &noden
 
 Fun4AllInputManager::~Fun4AllInputManager()
 {
+  if (m_PrefetchThread.joinable())
+  {
+    m_PrefetchThread.join();
+  }
   while (m_SubsystemsVector.begin() != m_SubsystemsVector.end())
   {
     if (Verbosity())
@@ -227,6 +234,21 @@ int Fun4AllInputManager::OpenNextFile()
     }
     else
     {
+      if (m_PrefetchFileLocations && m_FileList.size() > 1)
+      {
+        if (m_PrefetchThread.joinable())
+        {
+          m_PrefetchThread.join();
+        }
+        // names resolved by an earlier prefetch are cached, only new ones go to the catalog
+        vector<string> lnames(++m_FileList.begin(), m_FileList.end());
+        int verbosity = Verbosity();
+        m_PrefetchThread = thread([lnames, verbosity]() {
+          FROG frog;
+          frog.Verbosity(verbosity);
+          frog.resolve(lnames);
+        });
+      }
       return 0;
     }
   }
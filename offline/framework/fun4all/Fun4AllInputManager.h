@@ -6,12 +6,14 @@
 #include "Fun4AllBase.h"
 #include "Fun4AllReturnCodes.h"
 
+#include <cstdint>
 #include <list>
 #include <string>
 #include <utility>               // for make_pair, pair
 #include <vector>
 
 #if !defined(__CINT__) || defined (__CLING__)
+#include <thread>
 #include <type_traits>           // for __decay_and_strip<>::__type
 #endif
 
@@ -32,6 +34,10 @@ class Fun4AllInputManager : public Fun4AllBase
   void FileName(const std::string &fn) { m_FileName = fn; }
   virtual int GetSyncObject(SyncObject ** /*mastersync*/) { return 0; }
   virtual int SyncIt(const SyncObject * /*mastersync*/) { return Fun4AllReturnCodes::SYNC_FAIL; }
+  //! SyncObject::SyncKey() of the current event, 0 if there is none (then SyncIt decides)
+  virtual uint64_t SyncKey() const { return 0; }
+  //! index the events of the input files for resynchronization jumps (if the input supports it)
+  virtual void EventIndex(const bool /*b*/, const bool /*sidecar*/ = false) { return; }
   virtual int BranchSelect(const std::string & /*branch*/, const int /*iflag*/) { return -1; }
   virtual int setBranches() { return -1; }
   virtual void Print(const std::string &what = "ALL") const;
@@ -57,6 +63,15 @@ class Fun4AllInputManager : public Fun4AllBase
   std::string TopNodeName() const { return m_TopNodeName; }
   bool FileListEmpty() const { return m_FileList.empty(); }
   virtual int IsOpen() const { return m_IsOpen; }
+  //! resolve the locations of the remaining files in the file catalog in the
+  //! background while the current file is processed
+  void PrefetchFileLocations(const bool b) { m_PrefetchFileLocations = b; }
+  //! bytes read from the input files so far (compressed, as they are on disk)
+  virtual unsigned long long BytesRead() const { return 0; }
+  //! bytes of the events after decompression, 0 if the input does not know
+  virtual unsigned long long BytesDecompressed() const { return 0; }
+  //! events read ahead and waiting to be processed
+  virtual unsigned int QueueDepth() const { return 0; }
 
  protected:
   Fun4AllInputManager(const std::string &name = "DUMMY", const std::string &nodename = "DST", const std::string &topnodename = "TOP");
@@ -71,6 +86,7 @@ class Fun4AllInputManager : public Fun4AllBase
   int m_Repeat;
   int m_MyRunNumber;
   int m_InitRun;
+  bool m_PrefetchFileLocations;
   std::vector<SubsysReco *> m_SubsystemsVector;
   std::string m_InputNode;
   std::string m_FileName;
@@ -78,6 +94,9 @@ class Fun4AllInputManager : public Fun4AllBase
   std::list<std::string> m_FileList;
   std::list<std::string> m_FileListCopy;
   std::list<std::string> m_FileListOpened;  // all files which were opened during running
+#if !defined(__CINT__) || defined(__CLING__)
+  std::thread m_PrefetchThread;
+#endif
 };
 
 #endif
@@ -1,7 +1,12 @@
 #include "Fun4AllMemoryTracker.h"
 
+#include "Fun4AllAllocCount.h"
+
 #include <TSystem.h>
 
+#include <dlfcn.h>
+#include <algorithm>  // for max
+#include <iomanip>
 #include <iostream>
 #include <utility>    // for pair, make_pair
 
@@ -9,9 +14,28 @@ using namespace std;
 
 Fun4AllMemoryTracker *Fun4AllMemoryTracker::mInstance = nullptr;
 
+Fun4AllAllocationStats::Fun4AllAllocationStats()
+  : calls(0)
+  , allocations(0)
+  , bytes(0)
+  , peak(0)
+  , start_allocations(0)
+  , start_bytes(0)
+  , start_live(0)
+{
+}
+
 Fun4AllMemoryTracker::Fun4AllMemoryTracker()
   : Fun4AllBase("Fun4AllMemoryTracker")
+  , mAllocCounters(nullptr)
 {
+  // the counting operator new lives in a library which has to be preloaded
+  typedef Fun4AllAllocCounters *(*CountersFunction)();
+  CountersFunction counters = reinterpret_cast<CountersFunction>(dlsym(RTLD_DEFAULT, "fun4all_allocation_counters"));
+  if (counters)
+  {
+    mAllocCounters = counters();
+  }
 }
 
 int Fun4AllMemoryTracker::GetRSSMemory() const
@@ -146,6 +170,61 @@ void Fun4AllMemoryTracker::PrintMemoryTracker(const string &name) const
   return;
 }
 
+Fun4AllAllocationStats *Fun4AllMemoryTracker::GetAllocationStats(const string &trackername, const string &group)
+{
+  // map entries are never moved, the pointer stays valid
+  return &mAllocationMap[CreateFullTrackerName(trackername, group)];
+}
+
+void Fun4AllMemoryTracker::StartAllocations(Fun4AllAllocationStats *stats)
+{
+  if (!mAllocCounters)
+  {
+    return;
+  }
+  stats->start_allocations = mAllocCounters->allocations.load(memory_order_relaxed);
+  stats->start_bytes = mAllocCounters->bytes.load(memory_order_relaxed);
+  stats->start_live = mAllocCounters->live.load(memory_order_relaxed);
+  mAllocCounters->peak.store(stats->start_live, memory_order_relaxed);
+  return;
+}
+
+void Fun4AllMemoryTracker::StopAllocations(Fun4AllAllocationStats *stats)
+{
+  if (!mAllocCounters)
+  {
+    return;
+  }
+  stats->calls++;
+  stats->allocations += mAllocCounters->allocations.load(memory_order_relaxed) - stats->start_allocations;
+  stats->bytes += mAllocCounters->bytes.load(memory_order_relaxed) - stats->start_bytes;
+  stats->peak = max(stats->peak, mAllocCounters->peak.load(memory_order_relaxed) - stats->start_live);
+  return;
+}
+
+void Fun4AllMemoryTracker::PrintAllocations(const string &name) const
+{
+  if (!mAllocCounters)
+  {
+    cout << "libfun4all_alloccount.so not preloaded, no allocation counts" << endl;
+    return;
+  }
+  cout << left << setw(50) << "SubsysReco/OutputManager" << right << setw(10) << "calls"
+       << setw(16) << "allocs/call" << setw(16) << "bytes/call" << setw(16) << "peak bytes" << endl;
+  for (auto &iter : mAllocationMap)
+  {
+    if (!name.empty() && iter.first != name)
+    {
+      continue;
+    }
+    double calls = (iter.second.calls > 0 ? iter.second.calls : 1);
+    cout << left << setw(50) << iter.first << right << setw(10) << iter.second.calls
+         << setw(16) << iter.second.allocations / calls << setw(16) << iter.second.bytes / calls
+         << setw(16) << iter.second.peak << endl;
+  }
+  return;
+}
+
 vector<int> Fun4AllMemoryTracker::GetMemoryVector(const std::string &name) const
 {
   vector<int> memvec;
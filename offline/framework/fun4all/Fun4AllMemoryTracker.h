@@ -9,6 +9,23 @@
 #include <string>
 #include <vector>
 
+struct Fun4AllAllocCounters;
+
+//! heap allocations of one module, summed over all calls
+struct Fun4AllAllocationStats
+{
+  Fun4AllAllocationStats();
+  unsigned long long calls;
+  unsigned long long allocations;
+  unsigned long long bytes;
+  //! largest growth of the live heap memory during a single call
+  long long peak;
+  // counter values at StartAllocations
+  unsigned long long start_allocations;
+  unsigned long long start_bytes;
+  long long start_live;
+};
+
 class Fun4AllMemoryTracker : public Fun4AllBase
 {
  public:
@@ -27,12 +44,23 @@ class Fun4AllMemoryTracker : public Fun4AllBase
   void PrintMemoryTracker(const std::string &name = "") const;
   std::vector<int> GetMemoryVector(const std::string &name) const;
 
+  //! true if libfun4all_alloccount.so is preloaded, otherwise there are no allocation counts
+  bool AllocationCounting() const { return mAllocCounters != nullptr; }
+  //! counters of a tracker, the pointer stays valid for the lifetime of the tracker
+  Fun4AllAllocationStats *GetAllocationStats(const std::string &trackername, const std::string &group = "");
+  //! cheap enough to be called around every module in every event
+  void StartAllocations(Fun4AllAllocationStats *stats);
+  void StopAllocations(Fun4AllAllocationStats *stats);
+  void PrintAllocations(const std::string &name = "") const;
+
  private:
   Fun4AllMemoryTracker();
   std::string CreateFullTrackerName(const std::string &trackername, const std::string &group = "");
   static Fun4AllMemoryTracker *mInstance;
   std::map<std::string, std::vector<int>> mMemoryTrackerMap;
   std::map<std::string, int> mStartMem;
+  std::map<std::string, Fun4AllAllocationStats> mAllocationMap;
+  Fun4AllAllocCounters *mAllocCounters;
 };
 
 #endif
@@ -1,5 +1,9 @@
 #include "Fun4AllOutputManager.h"
 
+#include <phool/PHCompositeNode.h>
+#include <phool/phool.h>
+
+#include <algorithm>
 #include <iostream>
 #include <string>
 #include <vector>
@@ -9,16 +13,30 @@ using namespace std;
 Fun4AllOutputManager::Fun4AllOutputManager(const string &name)
   : Fun4AllBase(name)
   , m_NEvents(0)
+  , m_OutputOrder(kInputOrder)
+  , m_NextSlot(0)
+  , m_MaxBuffered(0)
 {
 }
 
 Fun4AllOutputManager::Fun4AllOutputManager(const string &name, const string &outfname)
   : Fun4AllBase(name)
   , m_NEvents(0)
+  , m_OutputOrder(kInputOrder)
+  , m_NextSlot(0)
+  , m_MaxBuffered(0)
   , m_OutFileName(outfname)
 {
 }
 
+Fun4AllOutputManager::~Fun4AllOutputManager()
+{
+  for (auto &pending : m_Pending)
+  {
+    delete pending.second;
+  }
+}
+
 //___________________________________________________________________
 int Fun4AllOutputManager::AddEventSelector(const string &recomodule)
 {
@@ -44,6 +62,106 @@ int Fun4AllOutputManager::WriteGeneric(PHCompositeNode *startNode)
   return iret;
 }
 
+//___________________________________________________________________
+int Fun4AllOutputManager::SubmitEvent(const unsigned long long slot, PHCompositeNode *startNode, vector<int> *retcodes)
+{
+  lock_guard<mutex> lock(m_SubmitMutex);
+  // the selectors only see the return codes of this event slot
+  PHCompositeNode *writenode = ((startNode && !DoNotWriteEvent(retcodes)) ? startNode : nullptr);
+  if (m_OutputOrder == kCompletionOrder || slot < m_NextSlot)
+  {
+    if (slot < m_NextSlot && m_OutputOrder == kInputOrder)
+    {
+      cout << PHWHERE << Name() << ": slot " << slot << " arrived after slot "
+           << m_NextSlot << " was written, writing it out of order" << endl;
+    }
+    if (writenode)
+    {
+      WriteSlot(slot, writenode);
+    }
+    return 0;
+  }
+  if (slot == m_NextSlot)
+  {
+    if (writenode)
+    {
+      WriteSlot(slot, writenode);
+    }
+    m_NextSlot++;
+    DrainBuffer();
+    return 0;
+  }
+  // earlier events are still being processed, keep a copy of this one
+  PHCompositeNode *snapshot = nullptr;
+  if (writenode)
+  {
+    snapshot = SnapshotEvent(writenode);
+    if (!snapshot)
+    {
+      cout << PHWHERE << Name() << ": cannot buffer slot " << slot
+           << ", writing it out of order" << endl;
+      WriteSlot(slot, writenode);
+    }
+  }
+  m_Pending[slot] = snapshot;
+  m_MaxBuffered = max(m_MaxBuffered, m_Pending.size());
+  return 0;
+}
+
+//___________________________________________________________________
+void Fun4AllOutputManager::WriteSlot(const unsigned long long slot, PHCompositeNode *startNode)
+{
+  WriteGeneric(startNode);
+  // in input order the slots on the file are consecutive, no index needed
+  if (m_OutputOrder == kCompletionOrder)
+  {
+    m_SlotIndex.push_back(slot);
+  }
+}
+
+//___________________________________________________________________
+void Fun4AllOutputManager::DrainBuffer()
+{
+  while (!m_Pending.empty() && m_Pending.begin()->first == m_NextSlot)
+  {
+    if (m_Pending.begin()->second)
+    {
+      m_NEvents++;
+      WriteSnapshot(m_Pending.begin()->second);
+    }
+    m_Pending.erase(m_Pending.begin());
+    m_NextSlot++;
+  }
+}
+
+//___________________________________________________________________
+int Fun4AllOutputManager::FlushEvents()
+{
+  lock_guard<mutex> lock(m_SubmitMutex);
+  // slots which never arrived do not hold back the rest any longer
+  while (!m_Pending.empty())
+  {
+    m_NextSlot = m_Pending.begin()->first;
+    DrainBuffer();
+  }
+  return 0;
+}
+
+//___________________________________________________________________
+size_t Fun4AllOutputManager::BufferedEvents() const
+{
+  lock_guard<mutex> lock(m_SubmitMutex);
+  return m_Pending.size();
+}
+
+//___________________________________________________________________
+int Fun4AllOutputManager::WriteSnapshot(PHCompositeNode *snapshot)
+{
+  int iret = Write(snapshot);
+  delete snapshot;
+  return iret;
+}
+
 //___________________________________________________________________
 void Fun4AllOutputManager::Print(const string &what) const
 {
@@ -61,6 +179,11 @@ void Fun4AllOutputManager::Print(const string &what) const
   {
     cout << Name() << " wrote " << EventsWritten() << " Events" << endl;
   }
+  if (what == "ALL" || what == "ORDER")
+  {
+    cout << Name() << ": writing in " << (m_OutputOrder == kInputOrder ? "input" : "completion")
+         << " order, at most " << m_MaxBuffered << " events were buffered" << endl;
+  }
   return;
 }
 
@@ -6,18 +6,27 @@
 #include "Fun4AllBase.h"
 
 #include <cstddef>       // for size_t
+#include <map>
 #include <string>
 #include <vector>
 
+#if !defined(__CINT__) || defined(__CLING__)
+#include <mutex>
+#endif
+
 class PHCompositeNode;
 
 class Fun4AllOutputManager : public Fun4AllBase
 {
  public:
-  //! destructor
-  virtual ~Fun4AllOutputManager()
+  enum enu_OutputOrder
   {
-  }
+    kInputOrder = 0,
+    kCompletionOrder = 1
+  };
+
+  //! destructor
+  virtual ~Fun4AllOutputManager();
 
   //! print method (dump event selector)
   virtual void Print(const std::string &what = "ALL") const;
@@ -83,6 +92,37 @@ class Fun4AllOutputManager : public Fun4AllBase
   //! decides if event is to be written or not
   virtual int DoNotWriteEvent(std::vector<int> *retcodes) const;
 
+  /*! \brief
+    hand over the event of an input slot, events may arrive in any order.
+    The event selectors are evaluated with the return codes of this slot.
+    startNode nullptr marks an event which is not written (e.g. discarded)
+    but which earlier slots must not wait for. Thread safe.
+  */
+  int SubmitEvent(const unsigned long long slot, PHCompositeNode *startNode, std::vector<int> *retcodes);
+  //! writes all buffered events in slot order, called before the run nodes are written
+  int FlushEvents();
+  //! slot of the next event in input order (the first slot after registration)
+  void FirstSlot(const unsigned long long slot) { m_NextSlot = slot; }
+
+  /*! \brief
+    kInputOrder (default) keeps events which finish early in a reorder
+    buffer until all earlier slots are done, kCompletionOrder writes them
+    right away and records the input slot of each written event (SlotIndex)
+  */
+  void OutputOrder(const int order) { m_OutputOrder = order; }
+  int OutputOrder() const { return m_OutputOrder; }
+  //! kCompletionOrder only: input slots of the written events in the order they are on the file
+  const std::vector<unsigned long long> &SlotIndex() const { return m_SlotIndex; }
+  //! most events held in the reorder buffer at the same time
+  size_t MaxBufferedEvents() const { return m_MaxBuffered; }
+  //! events in the reorder buffer right now
+  size_t BufferedEvents() const;
+
+  //! bytes written to the output so far, 0 if the manager does not know
+  virtual unsigned long long BytesWritten() const { return 0; }
+  //! events waiting for an asynchronous writer
+  virtual unsigned int QueueDepth() const { return 0; }
+
   //! get number of Events
   virtual size_t EventsWritten() const { return m_NEvents; }
   //! increment number of events
@@ -92,6 +132,14 @@ class Fun4AllOutputManager : public Fun4AllBase
   void OutFileName(const std::string &name) { m_OutFileName = name; }
 
  protected:
+  //! copy of the event which can be written later, nullptr if this manager cannot buffer events
+  virtual PHCompositeNode *SnapshotEvent(PHCompositeNode * /*startNode*/)
+  {
+    return nullptr;
+  }
+  //! writes a copy made by SnapshotEvent and deletes it
+  virtual int WriteSnapshot(PHCompositeNode *snapshot);
+
   /*! 
     constructor.
     is protected since we do not want the  class to be created in root macros
@@ -100,9 +148,24 @@ class Fun4AllOutputManager : public Fun4AllBase
   Fun4AllOutputManager(const std::string &myname, const std::string &outfname);
 
  private:
+  //! writes the event of slot and records it in the slot index
+  void WriteSlot(const unsigned long long slot, PHCompositeNode *startNode);
+  //! writes the buffered events which are next in input order
+  void DrainBuffer();
+
   //! Number of Events
   unsigned int m_NEvents;
 
+  int m_OutputOrder;
+  unsigned long long m_NextSlot;
+  size_t m_MaxBuffered;
+  //! reorder buffer: snapshots by slot, nullptr for events which are done without a copy
+  std::map<unsigned long long, PHCompositeNode *> m_Pending;
+  std::vector<unsigned long long> m_SlotIndex;
+#if !defined(__CINT__) || defined(__CLING__)
+  mutable std::mutex m_SubmitMutex;
+#endif
+
   //! output file name
   std::string m_OutFileName;
 
@@ -0,0 +1,221 @@
+#include "Fun4AllProfiler.h"
+
+#include <cxxabi.h>
+#include <dlfcn.h>
+#include <execinfo.h>
+#include <signal.h>
+#include <sys/time.h>
+
+#include <atomic>
+#include <cerrno>
+#include <cstdlib>
+#include <cstring>
+#include <fstream>
+#include <iostream>
+#include <utility>  // for pair, make_pair
+
+using namespace std;
+
+Fun4AllProfiler *Fun4AllProfiler::mInstance = nullptr;
+
+namespace
+{
+  // frames stored per sample, deeper stacks are cut at the outermost end
+  const int kMaxDepth = 64;
+  // the buffer holds a few seconds of samples, it is drained after every event
+  const unsigned long kBufferSize = 8192;
+  // frames of the signal handler and the signal trampoline
+  const int kSkipFrames = 2;
+
+  struct Sample
+  {
+    atomic<int> ready;
+    int module;
+    int depth;
+    void *pc[kMaxDepth];
+  };
+
+  Sample samplebuffer[kBufferSize];
+  atomic<unsigned long> head(0);  // next sample written by the signal handler
+  atomic<unsigned long> tail(0);  // next sample read by Drain()
+  atomic<unsigned long> dropped(0);
+  atomic<int> currentmodule(-1);
+
+  void SignalHandler(int /*signal*/)
+  {
+    int saved_errno = errno;
+    unsigned long index = head.load(memory_order_relaxed);
+    do
+    {
+      if (index - tail.load(memory_order_acquire) >= kBufferSize)
+      {
+        dropped.fetch_add(1, memory_order_relaxed);
+        errno = saved_errno;
+        return;
+      }
+    } while (!head.compare_exchange_weak(index, index + 1, memory_order_relaxed));
+    Sample &sample = samplebuffer[index % kBufferSize];
+    sample.module = currentmodule.load(memory_order_relaxed);
+    sample.depth = backtrace(sample.pc, kMaxDepth);
+    sample.ready.store(1, memory_order_release);
+    errno = saved_errno;
+  }
+
+  string Symbol(void *pc)
+  {
+    Dl_info info;
+    if (!dladdr(pc, &info))
+    {
+      return "[unknown]";
+    }
+    if (info.dli_sname)
+    {
+      int status = 0;
+      char *demangled = abi::__cxa_demangle(info.dli_sname, nullptr, nullptr, &status);
+      string name = (status == 0 && demangled ? demangled : info.dli_sname);
+      free(demangled);
+      return name;
+    }
+    string library = (info.dli_fname ? info.dli_fname : "unknown");
+    size_t slash = library.rfind('/');
+    if (slash != string::npos)
+    {
+      library = library.substr(slash + 1);
+    }
+    return "[" + library + "]";
+  }
+}  // namespace
+
+Fun4AllProfiler::Fun4AllProfiler()
+  : mRunning(false)
+  , mSamples(0)
+{
+}
+
+Fun4AllProfiler::~Fun4AllProfiler()
+{
+  Stop();
+}
+
+int Fun4AllProfiler::Start(const unsigned int hz)
+{
+  if (mRunning || hz == 0)
+  {
+    return -1;
+  }
+  // the first backtrace() loads libgcc, which is not async signal safe
+  void *dummy[2];
+  backtrace(dummy, 2);
+
+  struct sigaction action;
+  memset(&action, 0, sizeof(action));
+  action.sa_handler = SignalHandler;
+  action.sa_flags = SA_RESTART;
+  sigemptyset(&action.sa_mask);
+  if (sigaction(SIGPROF, &action, nullptr))
+  {
+    cout << "Fun4AllProfiler: could not install SIGPROF handler: " << strerror(errno) << endl;
+    return -1;
+  }
+  struct itimerval timer;
+  timer.it_interval.tv_sec = 0;
+  timer.it_interval.tv_usec = (hz > 1000000 ? 1 : 1000000 / hz);
+  timer.it_value = timer.it_interval;
+  if (setitimer(ITIMER_PROF, &timer, nullptr))
+  {
+    cout << "Fun4AllProfiler: could not start profiling timer: " << strerror(errno) << endl;
+    signal(SIGPROF, SIG_DFL);
+    return -1;
+  }
+  mRunning = true;
+  return 0;
+}
+
+void Fun4AllProfiler::Stop()
+{
+  if (!mRunning)
+  {
+    return;
+  }
+  struct itimerval timer;
+  memset(&timer, 0, sizeof(timer));
+  setitimer(ITIMER_PROF, &timer, nullptr);
+  // a pending signal would kill the job with the default action
+  signal(SIGPROF, SIG_IGN);
+  mRunning = false;
+  Drain();
+  return;
+}
+
+void Fun4AllProfiler::CurrentModule(const int module)
+{
+  currentmodule.store(module, memory_order_relaxed);
+}
+
+void Fun4AllProfiler::Drain()
+{
+  unsigned long index = tail.load(memory_order_relaxed);
+  while (index != head.load(memory_order_acquire))
+  {
+    Sample &sample = samplebuffer[index % kBufferSize];
+    // claimed by the handler but not written yet, take it next time
+    if (!sample.ready.load(memory_order_acquire))
+    {
+      break;
+    }
+    if (sample.depth > kSkipFrames)
+    {
+      vector<void *> stack(sample.pc + kSkipFrames, sample.pc + sample.depth);
+      mStacks[make_pair(sample.module, stack)]++;
+    }
+    mSamples++;
+    sample.ready.store(0, memory_order_relaxed);
+    index++;
+    tail.store(index, memory_order_release);
+  }
+  return;
+}
+
+unsigned long Fun4AllProfiler::Dropped() const
+{
+  return dropped.load(memory_order_relaxed);
+}
+
+int Fun4AllProfiler::Write(const string &filename, const vector<string> &modulenames)
+{
+  Drain();
+  ofstream folded(filename.c_str());
+  if (!folded.is_open())
+  {
+    cout << "Fun4AllProfiler: could not open " << filename << endl;
+    return -1;
+  }
+  // many stacks share frames, symbolize every address only once
+  map<void *, string> symbols;
+  // different addresses in the same function end up in the same folded stack
+  map<string, unsigned long> lines;
+  for (auto &iter : mStacks)
+  {
+    int module = iter.first.first;
+    string line = (module >= 0 && module < static_cast<int>(modulenames.size()) ? modulenames[module] : "Fun4AllServer");
+    const vector<void *> &stack = iter.first.second;
+    for (auto frame = stack.rbegin(); frame != stack.rend(); ++frame)
+    {
+      auto symbol = symbols.find(*frame);
+      if (symbol == symbols.end())
+      {
+        symbol = symbols.insert(make_pair(*frame, Symbol(*frame))).first;
+      }
+      line += ";" + symbol->second;
+    }
+    lines[line] += iter.second;
+  }
+  for (auto &iter : lines)
+  {
+    folded << iter.first << " " << iter.second << endl;
+  }
+  folded.close();
+  cout << "Fun4AllProfiler: wrote " << mSamples << " samples (" << Dropped()
+       << " dropped) in " << lines.size() << " stacks to " << filename << endl;
+  return 0;
+}
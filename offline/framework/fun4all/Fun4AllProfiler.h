@@ -0,0 +1,59 @@
+// Tell emacs that this is a C++ source
+//  -*- C++ -*-.
+#ifndef FUN4ALL_FUN4ALLPROFILER_H
+#define FUN4ALL_FUN4ALLPROFILER_H
+
+#include <map>
+#include <string>
+#include <vector>
+
+/*!
+ * \brief statistical sampling profiler
+ *
+ * SIGPROF (setitimer ITIMER_PROF, process cpu time) interrupts the job hz
+ * times per second, the signal handler stores the call stack and the module
+ * which is currently running in a lock free buffer. Drain() moves the samples
+ * out of the buffer into the stack counts, Fun4AllServer calls it after every
+ * event. Write() symbolizes the stacks (dladdr, only exported symbols can be
+ * resolved) and writes them in folded format, one line per stack:
+ * module;outermost frame;...;innermost frame count
+ * which is the input of flamegraph.pl or speedscope.
+ */
+class Fun4AllProfiler
+{
+ public:
+  static Fun4AllProfiler *instance()
+  {
+    if (mInstance) return mInstance;
+    mInstance = new Fun4AllProfiler();
+    return mInstance;
+  }
+  ~Fun4AllProfiler();
+
+  //! start sampling hz times per second of cpu time
+  int Start(const unsigned int hz);
+  void Stop();
+  bool Running() const { return mRunning; }
+
+  //! module which gets the samples, -1 for the framework itself
+  static void CurrentModule(const int module);
+
+  //! moves the samples from the signal buffer into the stack counts
+  void Drain();
+
+  //! module names are indexed by the module number given to CurrentModule
+  int Write(const std::string &filename, const std::vector<std::string> &modulenames);
+
+  unsigned long Samples() const { return mSamples; }
+  unsigned long Dropped() const;
+
+ private:
+  Fun4AllProfiler();
+  static Fun4AllProfiler *mInstance;
+  bool mRunning;
+  unsigned long mSamples;
+  //! (module, call stack innermost first) -> samples
+  std::map<std::pair<int, std::vector<void *> >, unsigned long> mStacks;
+};
+
+#endif
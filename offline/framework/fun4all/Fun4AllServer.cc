@@ -2,15 +2,24 @@
 
 #include "Fun4AllHistoBinDefs.h"
 #include "Fun4AllHistoManager.h"          // for Fun4AllHistoManager
+#include "Fun4AllInputManager.h"
 #include "Fun4AllMemoryTracker.h"
 #include "Fun4AllOutputManager.h"
+#include "Fun4AllProfiler.h"
 #include "Fun4AllReturnCodes.h"
 #include "Fun4AllSyncManager.h"
 #include "SubsysReco.h"
 
+#include <ffaobjects/EventHeader.h>
+#include <ffaobjects/EventTimeBudgetv1.h>
+
 #include <phool/PHCompositeNode.h>
+#include <phool/PHCounterRng.h>
+#include <phool/PHDataNode.h>
+#include <phool/PHIODataNode.h>
 #include <phool/PHNode.h>                 // for PHNode
 #include <phool/PHNodeIterator.h>
+#include <phool/PHNodeOperation.h>
 #include <phool/PHNodeReset.h>
 #include <phool/PHObject.h>
 #include <phool/PHPointerListIterator.h>
@@ -21,6 +30,7 @@
 #include <phool/recoConsts.h>
 
 #include <Rtypes.h>                       // for kMAXSIGNALS
+#include <TAxis.h>
 #include <TDirectory.h>
 #include <TH1.h>
 #include <TROOT.h>
@@ -29,16 +39,108 @@
 
 #include <boost/foreach.hpp>
 
+#include <sys/resource.h>
+
 #include <algorithm>
+#include <atomic>
 #include <cmath>
 #include <cstdlib>
+#include <chrono>
+#include <cstdio>                         // for rename
 #include <exception>
+#include <fstream>
+#include <future>
+#include <iomanip>
 #include <iostream>
+#include <limits>
 #include <memory>                         // for allocator_traits<>::value_type
+#include <set>
 #include <sstream>
+#include <thread>
 
 using namespace std;
 
+namespace
+{
+  // microseconds since the first call, used for the trace timeline
+  double TraceClock()
+  {
+    static const chrono::steady_clock::time_point start = chrono::steady_clock::now();
+    return chrono::duration<double, micro>(chrono::steady_clock::now() - start).count();
+  }
+
+  double CpuSeconds()
+  {
+    struct rusage usage;
+    getrusage(RUSAGE_SELF, &usage);
+    return usage.ru_utime.tv_sec + usage.ru_stime.tv_sec + (usage.ru_utime.tv_usec + usage.ru_stime.tv_usec) / 1e6;
+  }
+
+  // readers polling the file never see a partially written one
+  bool ReplaceFile(const string &fname, const string &content)
+  {
+    string tmpname = fname + ".tmp";
+    ofstream out(tmpname.c_str());
+    if (!out.is_open())
+    {
+      return false;
+    }
+    out << content;
+    out.close();
+    return !out.fail() && !rename(tmpname.c_str(), fname.c_str());
+  }
+
+  // collects the nodes PHNodeReset would reset, in tree order
+  class ResetNodeCollector : public PHNodeOperation
+  {
+   public:
+    explicit ResetNodeCollector(vector<PHNode *> &nodes)
+      : m_Nodes(nodes)
+    {
+    }
+
+   protected:
+    void perform(PHNode *node)
+    {
+      if (PHNodeReset::isResettable(node))
+      {
+        m_Nodes.push_back(node);
+      }
+    }
+
+   private:
+    vector<PHNode *> &m_Nodes;
+  };
+
+  // the nodes are read only as long as the guard exists, afterwards
+  // they get back the flag they had before
+  class ReadOnlyGuard
+  {
+   public:
+    explicit ReadOnlyGuard(const vector<PHNode *> &nodes)
+      : m_Nodes(nodes)
+    {
+      m_WasReadOnly.reserve(m_Nodes.size());
+      for (auto node : m_Nodes)
+      {
+        m_WasReadOnly.push_back(node->isReadOnly());
+        node->makeReadOnly(true);
+      }
+    }
+    ~ReadOnlyGuard()
+    {
+      for (size_t i = 0; i < m_Nodes.size(); i++)
+      {
+        m_Nodes[i]->makeReadOnly(m_WasReadOnly[i]);
+      }
+    }
+
+   private:
+    vector<PHNode *> m_Nodes;
+    vector<bool> m_WasReadOnly;
+  };
+}  // namespace
+
 Fun4AllServer *Fun4AllServer::__instance = nullptr;
 
 Fun4AllServer *Fun4AllServer::instance()
@@ -62,6 +164,29 @@ Fun4AllServer::Fun4AllServer(const std::string &name)
   , runnumber(0)
   , eventnumber(0)
   , keep_db_connected(0)
+  , m_ModuleScheduling(false)
+  , m_MemoryTrackingInterval(0)
+  , m_EventsProcessed(0)
+  , m_TraceThisEvent(false)
+  , m_TraceMaxEvents(0)
+  , m_MetricsInterval(0.)
+  , m_FirstEventClock(0.)
+  , m_EventTimeBudget(0.)
+  , m_EventStartClock(0.)
+  , m_EventsOverBudget(0)
+  , m_EventsDegraded(0)
+  , m_EventTimeBudgetNode(nullptr)
+  , m_Profiler(nullptr)
+  , m_ProtectRunNodes(false)
+  , m_NSlowestEvents(0)
+  , m_EventIdValid(false)
+  , m_EventRun(0)
+  , m_EventSequence(0)
+  , m_CalibrationThreads(4)
+  , m_InitThreads(1)
+  , m_IndependentInitWall(0.)
+  , m_ResetNodesValid(false)
+  , m_ResetNodesVersion(0)
 {
   InitAll();
   return;
@@ -70,6 +195,7 @@ Fun4AllServer::Fun4AllServer(const std::string &name)
 Fun4AllServer::~Fun4AllServer()
 {
   Reset();
+  ClearCalibrations();
   delete beginruntimestamp;
   while (Subsystems.begin() != Subsystems.end())
   {
@@ -270,6 +396,7 @@ int Fun4AllServer::registerSubsystem(SubsysReco *subsystem, const string &topnod
     timer_map.insert(make_pair(timer_name, timer));
   }
   RetCodes.push_back(iret);  // vector with return codes
+  BuildModuleSlots();
   return 0;
 }
 
@@ -324,6 +451,9 @@ int Fun4AllServer::unregisterSubsystemsNow()
   }
   unregistersubsystem = 0;
   DeleteSubsystems.clear();
+  // indices into Subsystems changed
+  BuildModuleSlots();
+  BuildModuleSchedule();
   return 0;
 }
 
@@ -379,6 +509,7 @@ int Fun4AllServer::registerOutputManager(Fun4AllOutputManager *manager)
     cout << "Registering OutputManager " << manager->Name() << endl;
   }
   UpdateEventSelector(manager);
+  manager->FirstSlot(m_EventsProcessed);
   OutputManager.push_back(manager);
   return 0;
 }
@@ -534,126 +665,217 @@ int Fun4AllServer::process_event()
   }
   gROOT->cd(default_Tdirectory.c_str());
   string currdir = gDirectory->GetPath();
-  for (iter = Subsystems.begin(); iter != Subsystems.end(); ++iter)
+  // reading /proc for the memory is expensive, only do it every n events
+  bool memsample = (m_MemoryTrackingInterval > 0 && (m_EventsProcessed % m_MemoryTrackingInterval) == 0);
+  m_TraceThisEvent = (!m_TraceFileName.empty() && m_EventsProcessed < m_TraceMaxEvents);
+  if (!m_EventsProcessed)
   {
-    if (Verbosity() >= VERBOSITY_MORE)
-    {
-      cout << "Fun4AllServer::process_event processing " << (*iter).first->Name() << endl;
-    }
-    ostringstream newdirname;
-    newdirname << (*iter).second->getName() << "/" << (*iter).first->Name();
-    if (!gROOT->cd(newdirname.str().c_str()))
-    {
-      cout << PHWHERE << "Unexpected TDirectory Problem cd'ing to "
-           << (*iter).second->getName()
-           << " - send e-mail to off-l with your macro" << endl;
-      exit(1);
-    }
-    else
+    m_FirstEventClock = TraceClock();
+  }
+  m_EventIdValid = false;
+  // the random streams of this event only depend on run and event count
+  PHCounterRng::SetEvent(runnumber, m_EventsProcessed);
+  m_EventsProcessed++;
+  if (m_EventTimeBudget > 0)
+  {
+    m_EventStartClock = TraceClock();
+  }
+  vector<PHNode *> runnodes;
+  if (m_ProtectRunNodes)
+  {
+    for (auto &topnode : topnodemap)
     {
-      if (Verbosity() >= VERBOSITY_EVEN_MORE)
+      for (const string &name : {"RUN", "PAR"})
       {
-        cout << "process_event: cded to " << newdirname.str().c_str() << endl;
+        PHNode *node = topnode.second->findNode(name);
+        if (node && node->getType() == "PHCompositeNode")
+        {
+          runnodes.push_back(node);
+        }
       }
     }
-
-    try
+  }
+  ReadOnlyGuard protectrunnodes(runnodes);
+  if (m_ScheduleGroups.empty())
+  {
+    for (iter = Subsystems.begin(); iter != Subsystems.end(); ++iter)
     {
-      string timer_name;
-      timer_name = (*iter).first->Name() + "_" + (*iter).second->getName();
-      std::map<const std::string, PHTimer>::iterator titer = timer_map.find(timer_name);
-      bool timer_found = false;
-      if (titer != timer_map.end())
+      if (Verbosity() >= VERBOSITY_MORE)
+      {
+        cout << "Fun4AllServer::process_event processing " << (*iter).first->Name() << endl;
+      }
+      ModuleSlot &slot = m_ModuleSlots[icnt];
+      if (!slot.dir->cd())
       {
-        timer_found = true;
-        titer->second.restart();
+        cout << PHWHERE << "Unexpected TDirectory Problem cd'ing to "
+             << (*iter).second->getName()
+             << " - send e-mail to off-l with your macro" << endl;
+        exit(1);
       }
       else
       {
-        cout << "could not find timer for " << timer_name << endl;
+        if (Verbosity() >= VERBOSITY_EVEN_MORE)
+        {
+          cout << "process_event: cded to " << slot.dirname << endl;
+        }
       }
-      ffamemtracker->Start(timer_name, "SubsysReco");
-      ffamemtracker->Snapshot("Fun4AllServerProcessEvent");
-      int retcode = (*iter).first->process_event((*iter).second);
-      ffamemtracker->Snapshot("Fun4AllServerProcessEvent");
-      // we have observed an index overflow in RetCodes. I assume it is some
-      // memory corruption elsewhere which hits the icnt variable. Rather than
-      // the previous [], use at() which does bounds checking and throws an
-      // exception which will allow us to catch this and print out icnt and the size
+
       try
       {
-        RetCodes.at(icnt) = retcode;
+        if (slot.timer)
+        {
+          slot.timer->restart();
+        }
+        if (memsample)
+        {
+          ffamemtracker->Start(slot.trackername, "SubsysReco");
+          ffamemtracker->Snapshot("Fun4AllServerProcessEvent");
+        }
+        double tracestart = (m_TraceThisEvent ? TraceClock() : 0.);
+        if (slot.allocations)
+        {
+          ffamemtracker->StartAllocations(slot.allocations);
+        }
+        if (m_Profiler)
+        {
+          Fun4AllProfiler::CurrentModule(slot.traceindex);
+        }
+        int retcode = (*iter).first->process_event((*iter).second);
+        if (m_Profiler)
+        {
+          Fun4AllProfiler::CurrentModule(-1);
+        }
+        if (slot.allocations)
+        {
+          ffamemtracker->StopAllocations(slot.allocations);
+        }
+        if (m_TraceThisEvent)
+        {
+          TraceModule(slot.traceindex, tracestart, TraceClock());
+        }
+        if (memsample)
+        {
+          ffamemtracker->Snapshot("Fun4AllServerProcessEvent");
+        }
+        // we have observed an index overflow in RetCodes. I assume it is some
+        // memory corruption elsewhere which hits the icnt variable. Rather than
+        // the previous [], use at() which does bounds checking and throws an
+        // exception which will allow us to catch this and print out icnt and the size
+        try
+        {
+          RetCodes.at(icnt) = retcode;
+        }
+        catch (const exception &e)
+        {
+          cout << PHWHERE << " caught exception thrown during RetCodes.at(icnt)" << endl;
+          cout << "RetCodes.size(): " << RetCodes.size() << ", icnt: " << icnt << endl;
+          cout << "error: " << e.what() << endl;
+          gSystem->Exit(1);
+        }
+        if (slot.timer)
+        {
+          slot.timer->stop();
+          if (slot.times)
+          {
+            RecordModuleTime(slot.times, slot.timer->elapsed());
+          }
+        }
+        if (memsample)
+        {
+          ffamemtracker->Stop(slot.trackername, "SubsysReco");
+        }
       }
       catch (const exception &e)
       {
-        cout << PHWHERE << " caught exception thrown during RetCodes.at(icnt)" << endl;
-        cout << "RetCodes.size(): " << RetCodes.size() << ", icnt: " << icnt << endl;
+        cout << PHWHERE << " caught exception thrown during process_event from "
+             << (*iter).first->Name() << endl;
         cout << "error: " << e.what() << endl;
         gSystem->Exit(1);
       }
-      if (timer_found)
+      catch (...)
       {
-        titer->second.stop();
+        cout << PHWHERE << " caught unknown type exception thrown during process_event from "
+             << (*iter).first->Name() << endl;
+        exit(1);
       }
-      ffamemtracker->Stop(timer_name, "SubsysReco");
-    }
-    catch (const exception &e)
-    {
-      cout << PHWHERE << " caught exception thrown during process_event from "
-           << (*iter).first->Name() << endl;
-      cout << "error: " << e.what() << endl;
-      gSystem->Exit(1);
-    }
-    catch (...)
-    {
-      cout << PHWHERE << " caught unknown type exception thrown during process_event from "
-           << (*iter).first->Name() << endl;
-      exit(1);
-    }
-    if (RetCodes[icnt])
-    {
-      if (RetCodes[icnt] == Fun4AllReturnCodes::DISCARDEVENT)
+      if (RetCodes[icnt])
       {
-        if (Verbosity() >= VERBOSITY_EVEN_MORE)
+        if (RetCodes[icnt] == Fun4AllReturnCodes::DISCARDEVENT)
         {
-          cout << "Fun4AllServer::Discard Event by " << (*iter).first->Name() << endl;
+          if (Verbosity() >= VERBOSITY_EVEN_MORE)
+          {
+            cout << "Fun4AllServer::Discard Event by " << (*iter).first->Name() << endl;
+          }
         }
-      }
-      else if (RetCodes[icnt] == Fun4AllReturnCodes::ABORTEVENT)
-      {
-        retcodesmap[Fun4AllReturnCodes::ABORTEVENT]++;
-        eventbad = 1;
-        if (Verbosity() >= VERBOSITY_MORE)
+        else if (RetCodes[icnt] == Fun4AllReturnCodes::ABORTEVENT)
         {
-          cout << "Fun4AllServer::Abort Event by " << (*iter).first->Name() << endl;
+          retcodesmap[Fun4AllReturnCodes::ABORTEVENT]++;
+          eventbad = 1;
+          if (Verbosity() >= VERBOSITY_MORE)
+          {
+            cout << "Fun4AllServer::Abort Event by " << (*iter).first->Name() << endl;
+          }
+          break;
+        }
+        else if (RetCodes[icnt] == Fun4AllReturnCodes::ABORTRUN)
+        {
+          retcodesmap[Fun4AllReturnCodes::ABORTRUN]++;
+          cout << "Fun4AllServer::Abort Run by " << (*iter).first->Name() << endl;
+          SubmitEmptySlot();
+          return Fun4AllReturnCodes::ABORTRUN;
+        }
+        else
+        {
+          cout << "Fun4AllServer::Unknown return code: "
+               << RetCodes[icnt] << " from process_event method of "
+               << (*iter).first->Name() << endl;
+          cout << "This smells like an uninitialized return code and" << endl;
+          cout << "it is too dangerous to continue, this Run will be aborted" << endl;
+          cout << "If you do not know how to fix this please send mail to" << endl;
+          cout << "phenix-off-l with this message" << endl;
+          SubmitEmptySlot();
+          return Fun4AllReturnCodes::ABORTRUN;
         }
-        break;
-      }
-      else if (RetCodes[icnt] == Fun4AllReturnCodes::ABORTRUN)
-      {
-        retcodesmap[Fun4AllReturnCodes::ABORTRUN]++;
-        cout << "Fun4AllServer::Abort Run by " << (*iter).first->Name() << endl;
-        return Fun4AllReturnCodes::ABORTRUN;
-      }
-      else
-      {
-        cout << "Fun4AllServer::Unknown return code: "
-             << RetCodes[icnt] << " from process_event method of "
-             << (*iter).first->Name() << endl;
-        cout << "This smells like an uninitialized return code and" << endl;
-        cout << "it is too dangerous to continue, this Run will be aborted" << endl;
-        cout << "If you do not know how to fix this please send mail to" << endl;
-        cout << "phenix-off-l with this message" << endl;
-        return Fun4AllReturnCodes::ABORTRUN;
       }
+      icnt++;
+    }
+  }
+  else
+  {
+    int iret = process_event_scheduled(eventbad, memsample);
+    if (iret)
+    {
+      SubmitEmptySlot();
+      return iret;
     }
-    icnt++;
   }
   if (!eventbad)
   {
     retcodesmap[Fun4AllReturnCodes::EVENT_OK]++;
   }
 
+  if (m_Profiler)
+  {
+    m_Profiler->Drain();
+  }
+  if (m_EventTimeBudgetNode)
+  {
+    m_EventTimeBudgetNode->set_Time((TraceClock() - m_EventStartClock) / 1000.);
+    if (m_EventTimeBudgetNode->get_Exceeded())
+    {
+      m_EventsOverBudget++;
+      if (Verbosity() > 0)
+      {
+        cout << "Fun4AllServer: event " << m_EventsProcessed << " took "
+             << m_EventTimeBudgetNode->get_Time() << " ms, budget is " << m_EventTimeBudget << " ms" << endl;
+      }
+    }
+    if (m_EventTimeBudgetNode->get_Degraded())
+    {
+      m_EventsDegraded++;
+    }
+  }
+
   gROOT->cd(currdir.c_str());
 
   //  mainIter.print();
@@ -686,28 +908,29 @@ int Fun4AllServer::process_event()
       vector<Fun4AllOutputManager *>::iterator iterOutMan;
       for (iterOutMan = OutputManager.begin(); iterOutMan != OutputManager.end(); ++iterOutMan)
       {
-        if (!(*iterOutMan)->DoNotWriteEvent(&RetCodes))
+        if (Verbosity() >= VERBOSITY_MORE)
+        {
+          cout << "Submitting Event for " << (*iterOutMan)->Name() << endl;
+        }
+        if (memsample)
         {
-          if (Verbosity() >= VERBOSITY_MORE)
-          {
-            cout << "Writing Event for " << (*iterOutMan)->Name() << endl;
-          }
           ffamemtracker->Snapshot("Fun4AllServerOutputManager");
           ffamemtracker->Start((*iterOutMan)->Name(), "OutputManager");
-          (*iterOutMan)->WriteGeneric(dstNode);
-          ffamemtracker->Stop((*iterOutMan)->Name(), "OutputManager");
-          ffamemtracker->Snapshot("Fun4AllServerOutputManager");
         }
-        else
+        // the event selectors are evaluated by the manager for this event slot
+        (*iterOutMan)->SubmitEvent(m_EventsProcessed - 1, dstNode, &RetCodes);
+        if (memsample)
         {
-          if (Verbosity() >= VERBOSITY_MORE)
-          {
-            cout << "Not Writing Event for " << (*iterOutMan)->Name() << endl;
-          }
+          ffamemtracker->Stop((*iterOutMan)->Name(), "OutputManager");
+          ffamemtracker->Snapshot("Fun4AllServerOutputManager");
         }
       }
     }
   }
+  else
+  {
+    SubmitEmptySlot();
+  }
   for (iter = Subsystems.begin(); iter != Subsystems.end(); ++iter)
   {
     if (Verbosity() >= VERBOSITY_EVEN_MORE)
@@ -728,12 +951,50 @@ int Fun4AllServer::process_event()
   return 0;
 }
 
+void Fun4AllServer::SubmitEmptySlot()
+{
+  // later events must not wait for this one in the reorder buffers
+  BOOST_FOREACH (Fun4AllOutputManager *outman, OutputManager)
+  {
+    outman->SubmitEvent(m_EventsProcessed - 1, nullptr, &RetCodes);
+  }
+}
+
 int Fun4AllServer::ResetNodeTree()
 {
+  // the walk through the node trees is only repeated if a node was added or removed
+  if (!m_ResetNodesValid || m_ResetNodesVersion != PHCompositeNode::structureVersion())
+  {
+    BuildResetNodeList();
+  }
+  // one lower verbosity level than Fun4AllServer, like PHNodeReset
+  const int resetverbosity = (Verbosity() > 0 ? Verbosity() - 1 : 0);
+  for (auto node : m_ResetNodes)
+  {
+    if (!node->getResetFlag())
+    {
+      continue;
+    }
+    if (resetverbosity > 0)
+    {
+      cout << "PHNodeReset: Resetting " << node->getName() << endl;
+    }
+    PHObject *obj = static_cast<PHDataNode<PHObject> *>(node)->getData();
+    if (obj)
+    {
+      obj->Reset();
+    }
+  }
+  return 0;  // anything except 0 would abort the event loop in pmonitor
+}
+
+void Fun4AllServer::BuildResetNodeList()
+{
+  m_ResetNodesVersion = PHCompositeNode::structureVersion();
+  m_ResetNodes.clear();
   vector<string> ResetNodeList;
   ResetNodeList.push_back("DST");
-  PHNodeReset reset;
-  reset.Verbosity(Verbosity() > 0 ? Verbosity() - 1 : 0);  // one lower verbosity level than Fun4AllServer
+  ResetNodeCollector collector(m_ResetNodes);
   map<string, PHCompositeNode *>::const_iterator iter;
   for (iter = topnodemap.begin(); iter != topnodemap.end(); ++iter)
   {
@@ -743,12 +1004,17 @@ int Fun4AllServer::ResetNodeTree()
     {
       if (mainIter.cd(*nodename))
       {
-        mainIter.forEach(reset);
+        mainIter.forEach(collector);
         mainIter.cd();
       }
     }
   }
-  return 0;  // anything except 0 would abort the event loop in pmonitor
+  m_ResetNodesValid = true;
+  if (Verbosity() > 1)
+  {
+    cout << "Fun4AllServer: " << m_ResetNodes.size() << " nodes are reset after every event" << endl;
+  }
+  return;
 }
 
 int Fun4AllServer::Reset()
@@ -815,6 +1081,13 @@ int Fun4AllServer::BeginRun(const int runno)
     unregisterSubsystemsNow();
   }
 
+  // fetch all calibrations the modules asked for before their InitRun
+  FetchCalibrations(runno);
+  // run independent setup of all modules concurrently, fills m_StartupTimes
+  RunIndependentInit(runno);
+  // modules add their nodes in InitRun, collect the nodes to reset again
+  m_ResetNodesValid = false;
+
   // we have to do the same TDirectory games as in the Init methods
   // save the current dir, cd to the subsystem name dir (which was
   // created in init) call the InitRun of the module and cd back
@@ -844,6 +1117,7 @@ int Fun4AllServer::BeginRun(const int runno)
     {
       cout << "Fun4AllServer::BeginRun: InitRun for " << (*iter).first->Name() << endl;
     }
+    chrono::steady_clock::time_point initstart = chrono::steady_clock::now();
     try
     {
       ffamemtracker->Start((*iter).first->Name(), "SubsysReco");
@@ -874,8 +1148,13 @@ int Fun4AllServer::BeginRun(const int runno)
       cout << PHWHERE << "Module " << (*iter).first->Name() << " issued non Fun4AllReturnCodes::EVENT_OK return code " << iret << " in InitRun()" << endl;
       exit(-2);
     }
+    m_StartupTimes[iter - Subsystems.begin()].initrun = chrono::duration<double>(chrono::steady_clock::now() - initstart).count();
   }
   gROOT->cd(currdir.c_str());
+  if (Verbosity() >= VERBOSITY_SOME)
+  {
+    Print("STARTUP");
+  }
 
   // disconnect from DB to save resources on DB machine
   // PdbCal leaves the DB connection open (PdbCal will reconnect without
@@ -892,6 +1171,8 @@ int Fun4AllServer::BeginRun(const int runno)
     cout << "Fun4AllServer->KeepDBConnection()" << endl;
     cout << "from your macro" << endl;
   }
+  // modules may declare their nodes in Init or InitRun
+  BuildModuleSchedule();
   // print out all node trees
   Print("NODETREE");
   ffamemtracker->Snapshot("Fun4AllServerBeginRun");
@@ -1021,6 +1302,14 @@ int Fun4AllServer::EndRun(const int runno)
 int Fun4AllServer::End()
 {
   recoConsts *rc = recoConsts::instance();
+  if (m_EventTimeBudget > 0)
+  {
+    // goes into the FlagSave of the output files
+    rc->set_IntFlag("EVENTS_OVER_TIMEBUDGET", m_EventsOverBudget);
+    rc->set_IntFlag("EVENTS_DEGRADED", m_EventsDegraded);
+    cout << "Fun4AllServer: " << m_EventsOverBudget << " events exceeded the time budget of "
+         << m_EventTimeBudget << " ms, " << m_EventsDegraded << " events have degraded results" << endl;
+  }
   EndRun(rc->get_IntFlag("RUNNUMBER"));  // call SubsysReco EndRun methods for current run
   int i = 0;
   vector<pair<SubsysReco *, PHCompositeNode *> >::iterator iter;
@@ -1067,6 +1356,11 @@ int Fun4AllServer::End()
     }
   }
   gROOT->cd(currdir.c_str());
+  // all events have to be on the files before the run trees
+  BOOST_FOREACH (Fun4AllOutputManager *outman, OutputManager)
+  {
+    outman->FlushEvents();
+  }
   PHNodeIterator nodeiter(TopNode);
   PHCompositeNode *runNode = dynamic_cast<PHCompositeNode *>(nodeiter.findFirst("PHCompositeNode", "RUN"));
   if (!runNode)
@@ -1087,6 +1381,33 @@ int Fun4AllServer::End()
   // close output files (check for existing output managers is
   // done inside outfileclose())
   outfileclose();
+  // histogram files dumped in the End methods are written in the background
+  BOOST_FOREACH (Fun4AllHistoManager *histoman, HistoManager)
+  {
+    histoman->WaitForWrite();
+  }
+  if (!m_TraceFileName.empty())
+  {
+    WriteTrace();
+  }
+  if (!m_MetricsFileName.empty())
+  {
+    WriteMetrics();
+  }
+  if (!m_BenchmarkFileName.empty())
+  {
+    WriteBenchmark();
+  }
+  if (m_NSlowestEvents > 0)
+  {
+    WriteModuleTimes();
+  }
+  if (m_Profiler)
+  {
+    m_Profiler->Stop();
+    m_Profiler->Write(m_ProfileFileName, m_TraceNames);
+    m_Profiler = nullptr;
+  }
 
   if (ScreamEveryEvent)
   {
@@ -1135,6 +1456,77 @@ void Fun4AllServer::Print(const string &what) const
     cout << endl;
   }
 
+  if (what == "ALL" || what == "THREADSAFETY")
+  {
+    cout << "--------------------------------------" << endl
+         << endl;
+    cout << "Thread safety of Subsystems in Fun4AllServer:" << endl;
+    vector<pair<SubsysReco *, PHCompositeNode *> >::const_iterator miter;
+    for (miter = Subsystems.begin(); miter != Subsystems.end(); ++miter)
+    {
+      cout << (*miter).first->Name() << ": "
+           << ((*miter).first->ThreadSafe() ? "thread-safe" : "not thread-safe") << endl;
+    }
+    cout << endl;
+  }
+
+  if (what == "ALL" || what == "STARTUP")
+  {
+    cout << "--------------------------------------" << endl
+         << endl;
+    if (m_StartupTimes.empty())
+    {
+      cout << "No startup profile, BeginRun was not called yet" << endl;
+    }
+    else
+    {
+      // most expensive modules first
+      vector<StartupTimes> sorted(m_StartupTimes);
+      sort(sorted.begin(), sorted.end(), [](const StartupTimes &a, const StartupTimes &b) { return a.independent + a.initrun > b.independent + b.initrun; });
+      double sumindependent = 0;
+      double suminitrun = 0;
+      cout << "Startup profile of last BeginRun (s):" << endl;
+      cout << setw(40) << left << "module" << right
+           << setw(14) << "independent" << setw(12) << "InitRun" << endl;
+      for (auto &times : sorted)
+      {
+        cout << setw(40) << left << times.name << right << fixed << setprecision(3)
+             << setw(14) << times.independent << setw(12) << times.initrun << endl;
+        sumindependent += times.independent;
+        suminitrun += times.initrun;
+      }
+      cout.unsetf(ios::floatfield);
+      cout << "InitRunIndependent: " << sumindependent << " s summed, "
+           << m_IndependentInitWall << " s wall time with " << m_InitThreads << " threads" << endl;
+      cout << "InitRun: " << suminitrun << " s" << endl;
+    }
+    cout << endl;
+  }
+
+  if (what == "ALL" || what == "SCHEDULE")
+  {
+    cout << "--------------------------------------" << endl
+         << endl;
+    if (m_ScheduleGroups.empty())
+    {
+      cout << "Fun4AllServer runs Subsystems sequentially" << endl;
+    }
+    else
+    {
+      cout << "Module schedule in Fun4AllServer:" << endl;
+      for (unsigned igrp = 0; igrp < m_ScheduleGroups.size(); igrp++)
+      {
+        cout << "group " << igrp << ":";
+        BOOST_FOREACH (unsigned index, m_ScheduleGroups[igrp])
+        {
+          cout << " " << Subsystems[index].first->Name();
+        }
+        cout << endl;
+      }
+    }
+    cout << endl;
+  }
+
   if (what == "ALL" || what == "INPUTMANAGER")
   {
     // the input managers are managed by the input singleton
@@ -1271,6 +1663,7 @@ int Fun4AllServer::AddTopNode(const string &name)
   }
   PHCompositeNode *newNode = new PHCompositeNode(name.c_str());
   topnodemap[name] = newNode;
+  m_ResetNodesValid = false;
   return 0;
 }
 
@@ -1460,7 +1853,11 @@ int Fun4AllServer::run(const int nevnts, const bool require_nevents)
     }
 
     ++icnt;  // completed one event processing
-    if (require_nevents)
+    if (!m_MetricsFileName.empty() && TraceClock() - m_MetricsLast.clock >= m_MetricsInterval)
+    {
+      WriteMetrics();
+    }
+    if (require_nevents)
     {
       if (std::find(RetCodes.begin(),
                     RetCodes.end(),
@@ -1678,6 +2075,737 @@ void Fun4AllServer::NodeIdentify(const std::string &name)
   return;
 }
 
+void Fun4AllServer::ModuleScheduling(const bool b)
+{
+  m_ModuleScheduling = b;
+  BuildModuleSchedule();
+  return;
+}
+
+namespace
+{
+  bool Overlap(const set<string> &a, const set<string> &b)
+  {
+    BOOST_FOREACH (const string &name, a)
+    {
+      if (b.find(name) != b.end())
+      {
+        return true;
+      }
+    }
+    return false;
+  }
+}  // namespace
+
+int Fun4AllServer::BuildModuleSlots()
+{
+  m_ModuleSlots.clear();
+  vector<pair<SubsysReco *, PHCompositeNode *> >::const_iterator iter;
+  for (iter = Subsystems.begin(); iter != Subsystems.end(); ++iter)
+  {
+    ModuleSlot slot;
+    slot.dirname = (*iter).second->getName() + "/" + (*iter).first->Name();
+    slot.dir = gROOT->GetDirectory(slot.dirname.c_str());
+    if (!slot.dir)
+    {
+      cout << PHWHERE << "Unexpected TDirectory Problem, cannot find "
+           << slot.dirname
+           << " - send e-mail to off-l with your macro" << endl;
+      exit(1);
+    }
+    slot.trackername = (*iter).first->Name() + "_" + (*iter).second->getName();
+    map<const string, PHTimer>::iterator titer = timer_map.find(slot.trackername);
+    if (titer != timer_map.end())
+    {
+      slot.timer = &(titer->second);
+    }
+    else
+    {
+      cout << "could not find timer for " << slot.trackername << endl;
+      slot.timer = nullptr;
+    }
+    // trace names are never removed, records of unregistered modules stay valid
+    vector<string>::const_iterator niter = find(m_TraceNames.begin(), m_TraceNames.end(), slot.trackername);
+    slot.traceindex = niter - m_TraceNames.begin();
+    if (niter == m_TraceNames.end())
+    {
+      m_TraceNames.push_back(slot.trackername);
+    }
+    slot.times = (m_NSlowestEvents > 0 ? GetModuleTimes(slot.trackername) : nullptr);
+    // only used by the sequential path, scheduled modules run concurrently and share the counters
+    slot.allocations = nullptr;
+    if (ffamemtracker->AllocationCounting())
+    {
+      slot.allocations = ffamemtracker->GetAllocationStats(slot.trackername, "SubsysReco");
+    }
+    m_ModuleSlots.push_back(slot);
+  }
+  return 0;
+}
+
+void Fun4AllServer::TraceFile(const string &fname, const unsigned int maxevents)
+{
+  m_TraceFileName = fname;
+  m_TraceMaxEvents = maxevents;
+  m_TraceRecords.reserve(maxevents * Subsystems.size());
+  TraceClock();  // start the clock
+  return;
+}
+
+void Fun4AllServer::TraceModule(const unsigned int traceindex, const double start, const double stop)
+{
+  TraceRecord record;
+  record.slot = traceindex;
+  record.event = m_EventsProcessed;
+  record.start = start;
+  record.duration = stop - start;
+  // modules can run in different threads with ModuleScheduling
+  lock_guard<mutex> lock(m_TraceMutex);
+  thread::id tid = this_thread::get_id();
+  vector<thread::id>::const_iterator titer = find(m_TraceThreads.begin(), m_TraceThreads.end(), tid);
+  record.thread = titer - m_TraceThreads.begin();
+  if (titer == m_TraceThreads.end())
+  {
+    m_TraceThreads.push_back(tid);
+  }
+  m_TraceRecords.push_back(record);
+  return;
+}
+
+int Fun4AllServer::WriteTrace() const
+{
+  ofstream trace(m_TraceFileName.c_str());
+  if (!trace.is_open())
+  {
+    cout << PHWHERE << " could not open trace file " << m_TraceFileName << endl;
+    return -1;
+  }
+  trace << "{\"traceEvents\":[" << endl;
+  for (vector<TraceRecord>::const_iterator iter = m_TraceRecords.begin(); iter != m_TraceRecords.end(); ++iter)
+  {
+    if (iter != m_TraceRecords.begin())
+    {
+      trace << "," << endl;
+    }
+    // module and node names cannot contain quotes or backslashes
+    trace << "{\"name\":\"" << m_TraceNames[iter->slot] << "\",\"cat\":\"SubsysReco\",\"ph\":\"X\""
+          << ",\"ts\":" << iter->start << ",\"dur\":" << iter->duration
+          << ",\"pid\":1,\"tid\":" << iter->thread
+          << ",\"args\":{\"event\":" << iter->event << "}}";
+  }
+  trace << endl
+        << "],\"displayTimeUnit\":\"ms\"}" << endl;
+  trace.close();
+  if (Verbosity() > 0)
+  {
+    cout << "Fun4AllServer: wrote " << m_TraceRecords.size() << " trace records to "
+         << m_TraceFileName << endl;
+  }
+  return 0;
+}
+
+void Fun4AllServer::BenchmarkFile(const string &fname, const string &label)
+{
+  m_BenchmarkFileName = fname;
+  m_BenchmarkLabel = label;
+  if (!ffamemtracker->AllocationCounting())
+  {
+    cout << "Fun4AllServer: libfun4all_alloccount.so not preloaded, "
+         << "the benchmark report will not contain allocation counts" << endl;
+  }
+  return;
+}
+
+int Fun4AllServer::WriteBenchmark() const
+{
+  ofstream bench(m_BenchmarkFileName.c_str());
+  if (!bench.is_open())
+  {
+    cout << PHWHERE << " could not open benchmark file " << m_BenchmarkFileName << endl;
+    return -1;
+  }
+  struct rusage usage;
+  getrusage(RUSAGE_SELF, &usage);
+  double events = (m_EventsProcessed > 0 ? m_EventsProcessed : 1);
+  // label, module and node names cannot contain quotes or backslashes
+  bench << "{" << endl
+        << "\"label\":\"" << m_BenchmarkLabel << "\"," << endl
+        << "\"events\":" << m_EventsProcessed << "," << endl
+        << "\"wall_time_per_event_ms\":" << (m_EventsProcessed > 0 ? (TraceClock() - m_FirstEventClock) / 1000. / events : 0.) << "," << endl
+        << "\"peak_rss_kb\":" << usage.ru_maxrss << "," << endl
+        << "\"modules\":[" << endl;
+  for (vector<ModuleSlot>::const_iterator iter = m_ModuleSlots.begin(); iter != m_ModuleSlots.end(); ++iter)
+  {
+    if (iter != m_ModuleSlots.begin())
+    {
+      bench << "," << endl;
+    }
+    bench << "{\"name\":\"" << iter->trackername << "\"";
+    if (iter->timer)
+    {
+      bench << ",\"calls\":" << iter->timer->get_ncycle()
+            << ",\"time_per_event_ms\":" << iter->timer->get_accumulated_time() / events;
+    }
+    if (iter->allocations && m_ScheduleGroups.empty())
+    {
+      bench << ",\"allocations_per_event\":" << iter->allocations->allocations / events
+            << ",\"allocated_bytes_per_event\":" << iter->allocations->bytes / events
+            << ",\"peak_heap_growth_bytes\":" << iter->allocations->peak;
+    }
+    bench << "}";
+  }
+  bench << endl
+        << "]}" << endl;
+  bench.close();
+  if (Verbosity() > 0)
+  {
+    cout << "Fun4AllServer: wrote benchmark report to " << m_BenchmarkFileName << endl;
+  }
+  return 0;
+}
+
+void Fun4AllServer::MetricsFile(const string &jsonfile, const double interval_s, const string &promfile)
+{
+  m_MetricsFileName = jsonfile;
+  m_MetricsPromFileName = promfile;
+  m_MetricsInterval = max(interval_s, 0.) * 1e6;
+  m_MetricsLast.clock = TraceClock();
+  m_MetricsLast.cpu = CpuSeconds();
+  m_MetricsLast.events = m_EventsProcessed;
+  m_MetricsLast.bytesread = 0;
+  m_MetricsLast.bytesdecompressed = 0;
+  m_MetricsLast.byteswritten = 0;
+  m_MetricsLast.moduletime.clear();
+  return;
+}
+
+int Fun4AllServer::WriteMetrics()
+{
+  MetricsSample now;
+  now.clock = TraceClock();
+  now.cpu = CpuSeconds();
+  now.events = m_EventsProcessed;
+  now.bytesread = 0;
+  now.bytesdecompressed = 0;
+  now.byteswritten = 0;
+  vector<Fun4AllInputManager *> inputs;
+  BOOST_FOREACH (Fun4AllSyncManager *syncman, SyncManagers)
+  {
+    const vector<Fun4AllInputManager *> syncinputs = syncman->GetInputManagers();
+    inputs.insert(inputs.end(), syncinputs.begin(), syncinputs.end());
+  }
+  BOOST_FOREACH (Fun4AllInputManager *inman, inputs)
+  {
+    now.bytesread += inman->BytesRead();
+    now.bytesdecompressed += inman->BytesDecompressed();
+  }
+  BOOST_FOREACH (Fun4AllOutputManager *outman, OutputManager)
+  {
+    now.byteswritten += outman->BytesWritten();
+  }
+  // the counters go away with an unregistered manager, the totals never go backwards
+  now.bytesread = max(now.bytesread, m_MetricsLast.bytesread);
+  now.bytesdecompressed = max(now.bytesdecompressed, m_MetricsLast.bytesdecompressed);
+  now.byteswritten = max(now.byteswritten, m_MetricsLast.byteswritten);
+
+  double elapsed = (now.clock - m_MetricsLast.clock) / 1e6;
+  double interval = (elapsed > 0 ? elapsed : 1.);
+  double total = (m_EventsProcessed > 0 ? (now.clock - m_FirstEventClock) / 1e6 : 0.);
+  // modules of a schedule group run on separate threads
+  size_t workers = 1;
+  BOOST_FOREACH (const vector<unsigned> &modgroup, m_ScheduleGroups)
+  {
+    workers = max(workers, modgroup.size());
+  }
+  double cpu = (now.cpu - m_MetricsLast.cpu) / interval;
+
+  // label, module and manager names cannot contain quotes or backslashes
+  ostringstream json;
+  ostringstream prom;
+  json << "{" << endl
+       << "\"time_s\":" << now.clock / 1e6 << "," << endl
+       << "\"interval_s\":" << elapsed << "," << endl
+       << "\"events\":" << now.events << "," << endl
+       << "\"events_per_s\":" << (now.events - m_MetricsLast.events) / interval << "," << endl
+       << "\"events_per_s_total\":" << (total > 0 ? now.events / total : 0.) << "," << endl
+       << "\"input_bytes_read\":" << now.bytesread << "," << endl
+       << "\"input_bytes_read_per_s\":" << (now.bytesread - m_MetricsLast.bytesread) / interval << "," << endl
+       << "\"input_bytes_decompressed\":" << now.bytesdecompressed << "," << endl
+       << "\"input_bytes_decompressed_per_s\":" << (now.bytesdecompressed - m_MetricsLast.bytesdecompressed) / interval << "," << endl
+       << "\"output_bytes_written\":" << now.byteswritten << "," << endl
+       << "\"output_bytes_written_per_s\":" << (now.byteswritten - m_MetricsLast.byteswritten) / interval << "," << endl
+       << "\"workers\":" << workers << "," << endl
+       << "\"cpu_utilization\":" << cpu << "," << endl
+       << "\"worker_utilization\":" << cpu / workers << "," << endl;
+  prom << "# TYPE fun4all_events_total counter" << endl
+       << "fun4all_events_total " << now.events << endl
+       << "# TYPE fun4all_events_per_second gauge" << endl
+       << "fun4all_events_per_second " << (now.events - m_MetricsLast.events) / interval << endl
+       << "# TYPE fun4all_input_bytes_read_total counter" << endl
+       << "fun4all_input_bytes_read_total " << now.bytesread << endl
+       << "# TYPE fun4all_input_bytes_decompressed_total counter" << endl
+       << "fun4all_input_bytes_decompressed_total " << now.bytesdecompressed << endl
+       << "# TYPE fun4all_output_bytes_written_total counter" << endl
+       << "fun4all_output_bytes_written_total " << now.byteswritten << endl
+       << "# TYPE fun4all_worker_utilization gauge" << endl
+       << "fun4all_worker_utilization " << cpu / workers << endl
+       << "# TYPE fun4all_module_busy_fraction gauge" << endl;
+
+  // busy fraction: time spent in the module over the wall time of the interval
+  json << "\"modules\":[";
+  bool first = true;
+  for (vector<ModuleSlot>::const_iterator iter = m_ModuleSlots.begin(); iter != m_ModuleSlots.end(); ++iter)
+  {
+    if (!iter->timer)
+    {
+      continue;
+    }
+    double accumulated = iter->timer->get_accumulated_time();
+    now.moduletime[iter->trackername] = accumulated;
+    map<string, double>::const_iterator last = m_MetricsLast.moduletime.find(iter->trackername);
+    double busy = (accumulated - (last != m_MetricsLast.moduletime.end() ? last->second : 0.)) / 1000. / interval;
+    json << (first ? "" : ",") << endl
+         << "{\"name\":\"" << iter->trackername << "\",\"busy_fraction\":" << busy << "}";
+    prom << "fun4all_module_busy_fraction{module=\"" << iter->trackername << "\"} " << busy << endl;
+    first = false;
+  }
+  json << endl
+       << "]," << endl;
+
+  json << "\"queues\":[";
+  prom << "# TYPE fun4all_queue_depth gauge" << endl;
+  first = true;
+  BOOST_FOREACH (Fun4AllInputManager *inman, inputs)
+  {
+    unsigned int depth = inman->QueueDepth();
+    json << (first ? "" : ",") << endl
+         << "{\"stage\":\"input\",\"manager\":\"" << inman->Name() << "\",\"depth\":" << depth << "}";
+    prom << "fun4all_queue_depth{stage=\"input\",manager=\"" << inman->Name() << "\"} " << depth << endl;
+    first = false;
+  }
+  BOOST_FOREACH (Fun4AllOutputManager *outman, OutputManager)
+  {
+    unsigned int depth = outman->QueueDepth();
+    size_t buffered = outman->BufferedEvents();
+    json << (first ? "" : ",") << endl
+         << "{\"stage\":\"reorder\",\"manager\":\"" << outman->Name() << "\",\"depth\":" << buffered << "}," << endl
+         << "{\"stage\":\"output\",\"manager\":\"" << outman->Name() << "\",\"depth\":" << depth << "}";
+    prom << "fun4all_queue_depth{stage=\"reorder\",manager=\"" << outman->Name() << "\"} " << buffered << endl
+         << "fun4all_queue_depth{stage=\"output\",manager=\"" << outman->Name() << "\"} " << depth << endl;
+    first = false;
+  }
+  json << endl
+       << "]}" << endl;
+
+  m_MetricsLast = now;
+  int iret = 0;
+  if (!ReplaceFile(m_MetricsFileName, json.str()))
+  {
+    cout << PHWHERE << " could not write metrics file " << m_MetricsFileName << endl;
+    iret = -1;
+  }
+  if (!m_MetricsPromFileName.empty() && !ReplaceFile(m_MetricsPromFileName, prom.str()))
+  {
+    cout << PHWHERE << " could not write metrics file " << m_MetricsPromFileName << endl;
+    iret = -1;
+  }
+  if (Verbosity() > VERBOSITY_SOME)
+  {
+    cout << "Fun4AllServer: wrote metrics to " << m_MetricsFileName << endl;
+  }
+  return iret;
+}
+
+void Fun4AllServer::ProfileFile(const string &fname, const unsigned int hz)
+{
+  if (m_Profiler)
+  {
+    cout << "Fun4AllServer: profiler already running, writing to " << m_ProfileFileName << endl;
+    return;
+  }
+  Fun4AllProfiler *profiler = Fun4AllProfiler::instance();
+  if (profiler->Start(hz))
+  {
+    cout << PHWHERE << " could not start the profiler" << endl;
+    return;
+  }
+  m_ProfileFileName = fname;
+  m_Profiler = profiler;
+  return;
+}
+
+void Fun4AllServer::TimeBudgetPerEvent(const double ms)
+{
+  m_EventTimeBudget = ms;
+  if (ms <= 0)
+  {
+    m_EventTimeBudget = 0;
+    return;
+  }
+  // output nodes cannot be added after the first event was written, set the budget before
+  if (!m_EventTimeBudgetNode)
+  {
+    PHNodeIterator iter(TopNode);
+    PHCompositeNode *dstNode = dynamic_cast<PHCompositeNode *>(iter.findFirst("PHCompositeNode", "DST"));
+    if (!dstNode)
+    {
+      cout << PHWHERE << " DST Node missing, no time budget" << endl;
+      m_EventTimeBudget = 0;
+      return;
+    }
+    m_EventTimeBudgetNode = findNode::getClass<EventTimeBudget>(TopNode, "EventTimeBudget");
+    if (!m_EventTimeBudgetNode)
+    {
+      m_EventTimeBudgetNode = new EventTimeBudgetv1();
+      PHIODataNode<PHObject> *newnode = new PHIODataNode<PHObject>(m_EventTimeBudgetNode, "EventTimeBudget", "PHObject");
+      dstNode->addNode(newnode);
+    }
+  }
+  m_EventTimeBudgetNode->set_Budget(ms);
+  return;
+}
+
+double Fun4AllServer::EventTimeLeft() const
+{
+  if (m_EventTimeBudget <= 0)
+  {
+    return numeric_limits<double>::max();
+  }
+  return m_EventTimeBudget - (TraceClock() - m_EventStartClock) / 1000.;
+}
+
+void Fun4AllServer::DegradedResult(const string &modulename)
+{
+  if (!m_EventTimeBudgetNode)
+  {
+    return;
+  }
+  lock_guard<mutex> lock(m_DegradedMutex);
+  m_EventTimeBudgetNode->add_DegradedModule(modulename);
+  return;
+}
+
+void Fun4AllServer::ModuleTimeHistograms(const unsigned int nslowest)
+{
+  m_NSlowestEvents = (nslowest > 0 ? nslowest : 1);
+  // modules which are already registered get their histograms now
+  BuildModuleSlots();
+  return;
+}
+
+Fun4AllServer::ModuleTimes *Fun4AllServer::GetModuleTimes(const string &trackername)
+{
+  map<string, ModuleTimes>::iterator iter = m_ModuleTimes.find(trackername);
+  if (iter != m_ModuleTimes.end())
+  {
+    return &iter->second;
+  }
+  // 20 bins per decade from 1 us to 1000 s
+  const int nbins = 180;
+  double edges[nbins + 1];
+  for (int i = 0; i <= nbins; i++)
+  {
+    edges[i] = pow(10., -3. + i / 20.);
+  }
+  string currdir = gDirectory->GetPath();
+  gROOT->cd(default_Tdirectory.c_str());
+  ModuleTimes &times = m_ModuleTimes[trackername];
+  string hname = "ModuleTime_" + trackername;
+  times.histo = new TH1D(hname.c_str(), (trackername + " time per event;time (ms);events").c_str(), nbins, edges);
+  registerHisto(hname.c_str(), times.histo);
+  hname = "SlowestEvents_" + trackername;
+  times.slowest = new TH1D(hname.c_str(), (trackername + " slowest events;run/event;time (ms)").c_str(), m_NSlowestEvents, 0, m_NSlowestEvents);
+  registerHisto(hname.c_str(), times.slowest);
+  gROOT->cd(currdir.c_str());
+  return &times;
+}
+
+void Fun4AllServer::RecordModuleTime(ModuleTimes *times, const double ms)
+{
+  times->histo->Fill(ms);
+  if (times->events.size() >= m_NSlowestEvents && ms <= times->events.front().time)
+  {
+    return;
+  }
+  if (!m_EventIdValid)
+  {
+    EventHeader *evthead = findNode::getClass<EventHeader>(TopNode, "EventHeader");
+    m_EventRun = (evthead ? evthead->get_RunNumber() : runnumber);
+    m_EventSequence = (evthead ? evthead->get_EvtSequence() : static_cast<int>(m_EventsProcessed));
+    m_EventIdValid = true;
+  }
+  SlowEvent slow;
+  slow.time = ms;
+  slow.run = m_EventRun;
+  slow.event = m_EventSequence;
+  if (times->events.size() >= m_NSlowestEvents)
+  {
+    pop_heap(times->events.begin(), times->events.end());
+    times->events.pop_back();
+  }
+  times->events.push_back(slow);
+  push_heap(times->events.begin(), times->events.end());
+  return;
+}
+
+void Fun4AllServer::WriteModuleTimes()
+{
+  cout << "Fun4AllServer: time per event (ms)" << endl;
+  cout << left << setw(50) << "module" << right << setw(10) << "events" << setw(12) << "p50"
+       << setw(12) << "p90" << setw(12) << "p99" << setw(12) << "max" << endl;
+  for (map<string, ModuleTimes>::iterator iter = m_ModuleTimes.begin(); iter != m_ModuleTimes.end(); ++iter)
+  {
+    ModuleTimes &times = iter->second;
+    // slowest first
+    vector<SlowEvent> events = times.events;
+    sort_heap(events.begin(), events.end());
+    for (unsigned int i = 0; i < events.size(); i++)
+    {
+      ostringstream label;
+      label << events[i].run << "/" << events[i].event;
+      times.slowest->GetXaxis()->SetBinLabel(i + 1, label.str().c_str());
+      times.slowest->SetBinContent(i + 1, events[i].time);
+    }
+    double quantiles[3] = {0.5, 0.9, 0.99};
+    double values[3] = {0, 0, 0};
+    if (times.histo->GetEntries() > 0)
+    {
+      times.histo->GetQuantiles(3, values, quantiles);
+    }
+    cout << left << setw(50) << iter->first << right << setw(10) << times.histo->GetEntries()
+         << setw(12) << setprecision(4) << values[0] << setw(12) << values[1] << setw(12) << values[2]
+         << setw(12) << (events.empty() ? 0. : events.front().time) << endl;
+    if (!events.empty())
+    {
+      cout << "  slowest (run/event: ms):";
+      for (unsigned int i = 0; i < events.size() && i < 5; i++)
+      {
+        cout << " " << events[i].run << "/" << events[i].event << ": " << events[i].time;
+      }
+      cout << endl;
+    }
+  }
+  return;
+}
+
+int Fun4AllServer::BuildModuleSchedule()
+{
+  m_ScheduleGroups.clear();
+  if (!m_ModuleScheduling)
+  {
+    return 0;
+  }
+  // every module gets the lowest group number which comes after all
+  // modules it depends on. Modules which are not thread-safe or did not
+  // declare their nodes are barriers, they form a group on their own and
+  // nothing is moved across them
+  vector<int> group(Subsystems.size(), 0);
+  int lastbarrier = -1;
+  int maxgroup = -1;
+  for (unsigned j = 0; j < Subsystems.size(); j++)
+  {
+    SubsysReco *modj = Subsystems[j].first;
+    bool barrier = (!modj->ThreadSafe() ||
+                    (modj->InputNodes().empty() && modj->OutputNodes().empty() &&
+                     modj->SharedOutputNodes().empty()));
+    int igrp = lastbarrier + 1;
+    if (barrier)
+    {
+      igrp = maxgroup + 1;
+      lastbarrier = igrp;
+    }
+    else
+    {
+      for (unsigned i = 0; i < j; i++)
+      {
+        if (group[i] < igrp || Subsystems[i].second != Subsystems[j].second)
+        {
+          continue;
+        }
+        SubsysReco *modi = Subsystems[i].first;
+        // read after write, write after write and write after read,
+        // shared outputs only conflict with reading and exclusive writing
+        if (Overlap(modi->OutputNodes(), modj->InputNodes()) ||
+            Overlap(modi->OutputNodes(), modj->OutputNodes()) ||
+            Overlap(modi->InputNodes(), modj->OutputNodes()) ||
+            Overlap(modi->SharedOutputNodes(), modj->InputNodes()) ||
+            Overlap(modi->InputNodes(), modj->SharedOutputNodes()) ||
+            Overlap(modi->SharedOutputNodes(), modj->OutputNodes()) ||
+            Overlap(modi->OutputNodes(), modj->SharedOutputNodes()))
+        {
+          igrp = group[i] + 1;
+        }
+      }
+    }
+    group[j] = igrp;
+    maxgroup = max(maxgroup, igrp);
+  }
+  m_ScheduleGroups.resize(maxgroup + 1);
+  for (unsigned j = 0; j < Subsystems.size(); j++)
+  {
+    m_ScheduleGroups[group[j]].push_back(j);
+  }
+  BOOST_FOREACH (const vector<unsigned> &modgroup, m_ScheduleGroups)
+  {
+    if (modgroup.size() > 1)
+    {
+      // concurrent modules fill histograms and need a thread local gDirectory
+      ROOT::EnableThreadSafety();
+      break;
+    }
+  }
+  if (Verbosity() >= VERBOSITY_SOME)
+  {
+    Print("SCHEDULE");
+  }
+  return 0;
+}
+
+int Fun4AllServer::process_event_scheduled(int &eventbad, const bool memsample)
+{
+  BOOST_FOREACH (const vector<unsigned> &modgroup, m_ScheduleGroups)
+  {
+    // RSS and allocation counters are process wide, modules which run
+    // concurrently are measured together and all get the numbers of their group
+    BOOST_FOREACH (unsigned index, modgroup)
+    {
+      ModuleSlot &slot = m_ModuleSlots[index];
+      if (memsample)
+      {
+        ffamemtracker->Start(slot.trackername, "SubsysReco");
+      }
+      if (slot.allocations)
+      {
+        ffamemtracker->StartAllocations(slot.allocations);
+      }
+    }
+    if (memsample)
+    {
+      ffamemtracker->Snapshot("Fun4AllServerProcessEvent");
+    }
+    if (m_Profiler && modgroup.size() == 1)
+    {
+      Fun4AllProfiler::CurrentModule(m_ModuleSlots[modgroup[0]].traceindex);
+    }
+    vector<future<int> > results;
+    BOOST_FOREACH (unsigned index, modgroup)
+    {
+      SubsysReco *subsys = Subsystems[index].first;
+      PHCompositeNode *subsystopNode = Subsystems[index].second;
+      if (Verbosity() >= VERBOSITY_MORE)
+      {
+        cout << "Fun4AllServer::process_event_scheduled processing " << subsys->Name() << endl;
+      }
+      // single modules (barriers) run in the calling thread, only thread-safe
+      // modules are run concurrently. Every task cd's to the TDirectory of its
+      // module, gDirectory is thread local once ROOT thread safety is enabled
+      launch policy = (modgroup.size() > 1) ? launch::async : launch::deferred;
+      ModuleSlot *slot = &m_ModuleSlots[index];
+      results.push_back(async(policy, [subsys, subsystopNode, slot, this]() {
+        if (!slot->dir->cd())
+        {
+          cout << PHWHERE << "Unexpected TDirectory Problem cd'ing to "
+               << slot->dirname << " - send e-mail to off-l with your macro" << endl;
+          exit(1);
+        }
+        if (slot->timer)
+        {
+          slot->timer->restart();
+        }
+        double tracestart = (m_TraceThisEvent ? TraceClock() : 0.);
+        int retcode = subsys->process_event(subsystopNode);
+        if (m_TraceThisEvent)
+        {
+          TraceModule(slot->traceindex, tracestart, TraceClock());
+        }
+        if (slot->timer)
+        {
+          slot->timer->stop();
+        }
+        return retcode;
+      }));
+    }
+    for (unsigned i = 0; i < modgroup.size(); i++)
+    {
+      unsigned index = modgroup[i];
+      SubsysReco *subsys = Subsystems[index].first;
+      try
+      {
+        RetCodes.at(index) = results[i].get();
+      }
+      catch (const exception &e)
+      {
+        cout << PHWHERE << " caught exception thrown during process_event from "
+             << subsys->Name() << endl;
+        cout << "error: " << e.what() << endl;
+        gSystem->Exit(1);
+      }
+      catch (...)
+      {
+        cout << PHWHERE << " caught unknown type exception thrown during process_event from "
+             << subsys->Name() << endl;
+        exit(1);
+      }
+    }
+    if (m_Profiler && modgroup.size() == 1)
+    {
+      Fun4AllProfiler::CurrentModule(-1);
+    }
+    if (memsample)
+    {
+      ffamemtracker->Snapshot("Fun4AllServerProcessEvent");
+    }
+    BOOST_FOREACH (unsigned index, modgroup)
+    {
+      ModuleSlot &slot = m_ModuleSlots[index];
+      if (slot.allocations)
+      {
+        ffamemtracker->StopAllocations(slot.allocations);
+      }
+      if (slot.timer && slot.times)
+      {
+        RecordModuleTime(slot.times, slot.timer->elapsed());
+      }
+      if (memsample)
+      {
+        ffamemtracker->Stop(slot.trackername, "SubsysReco");
+      }
+    }
+    // evaluate return codes in registration order after the whole group is done
+    BOOST_FOREACH (unsigned index, modgroup)
+    {
+      int retcode = RetCodes[index];
+      if (!retcode || retcode == Fun4AllReturnCodes::DISCARDEVENT)
+      {
+        continue;
+      }
+      if (retcode == Fun4AllReturnCodes::ABORTEVENT)
+      {
+        retcodesmap[Fun4AllReturnCodes::ABORTEVENT]++;
+        if (Verbosity() >= VERBOSITY_MORE)
+        {
+          cout << "Fun4AllServer::Abort Event by " << Subsystems[index].first->Name() << endl;
+        }
+        eventbad = 1;
+        return 0;
+      }
+      if (retcode == Fun4AllReturnCodes::ABORTRUN)
+      {
+        retcodesmap[Fun4AllReturnCodes::ABORTRUN]++;
+        cout << "Fun4AllServer::Abort Run by " << Subsystems[index].first->Name() << endl;
+        return Fun4AllReturnCodes::ABORTRUN;
+      }
+      cout << "Fun4AllServer::Unknown return code: "
+           << retcode << " from process_event method of "
+           << Subsystems[index].first->Name() << endl;
+      cout << "This smells like an uninitialized return code and" << endl;
+      cout << "it is too dangerous to continue, this Run will be aborted" << endl;
+      return Fun4AllReturnCodes::ABORTRUN;
+    }
+  }
+  return 0;
+}
+
 void Fun4AllServer::PrintTimer(const string &name)
 {
   map<const string, PHTimer>::const_iterator iter;
@@ -1711,5 +2839,190 @@ void Fun4AllServer::PrintTimer(const string &name)
 void Fun4AllServer::PrintMemoryTracker(const string &name) const
 {
   ffamemtracker->PrintMemoryTracker(name);
+  if (ffamemtracker->AllocationCounting())
+  {
+    ffamemtracker->PrintAllocations(name);
+  }
   return;
 }
+
+int Fun4AllServer::registerCalibrationRequest(const string &key, function<PHObject *(const int runnumber)> fetch)
+{
+  if (m_Calibrations.find(key) != m_Calibrations.end())
+  {
+    cout << PHWHERE << " calibration " << key << " already registered" << endl;
+    return -1;
+  }
+  m_Calibrations[key] = make_pair(fetch, nullptr);
+  if (Verbosity() > 0)
+  {
+    cout << "Fun4AllServer: registered calibration " << key << endl;
+  }
+  return 0;
+}
+
+PHObject *Fun4AllServer::getCalibration(const string &key) const
+{
+  auto iter = m_Calibrations.find(key);
+  if (iter == m_Calibrations.end())
+  {
+    return nullptr;
+  }
+  return iter->second.second;
+}
+
+void Fun4AllServer::ClearCalibrations()
+{
+  for (auto &calib : m_Calibrations)
+  {
+    delete calib.second.second;
+    calib.second.second = nullptr;
+  }
+  return;
+}
+
+int Fun4AllServer::RunIndependentInit(const int runno)
+{
+  m_StartupTimes.clear();
+  for (auto &subsys : Subsystems)
+  {
+    StartupTimes times;
+    times.name = subsys.first->Name();
+    times.independent = 0;
+    times.initrun = 0;
+    m_StartupTimes.push_back(times);
+  }
+  m_IndependentInitWall = 0;
+  if (Subsystems.empty())
+  {
+    return 0;
+  }
+  chrono::steady_clock::time_point wallstart = chrono::steady_clock::now();
+  unsigned int nthreads = min(max(m_InitThreads, 1U), static_cast<unsigned int>(Subsystems.size()));
+  if (nthreads > 1)
+  {
+    // modules read root files (field maps, tables) here
+    ROOT::EnableThreadSafety();
+  }
+  // return codes are checked after all threads are done, exit() is not thread safe
+  vector<int> iret(Subsystems.size(), Fun4AllReturnCodes::EVENT_OK);
+  atomic<unsigned int> next(0);
+  auto worker = [&]() {
+    for (unsigned int i = next++; i < Subsystems.size(); i = next++)
+    {
+      chrono::steady_clock::time_point start = chrono::steady_clock::now();
+      try
+      {
+        iret[i] = Subsystems[i].first->InitRunIndependent(runno);
+      }
+      catch (const exception &e)
+      {
+        cout << PHWHERE << " caught exception thrown during SubsysReco::InitRunIndependent() from "
+             << Subsystems[i].first->Name() << endl;
+        cout << "error: " << e.what() << endl;
+        iret[i] = Fun4AllReturnCodes::ABORTRUN;
+      }
+      catch (...)
+      {
+        cout << PHWHERE << " caught unknown type exception thrown during SubsysReco::InitRunIndependent() from "
+             << Subsystems[i].first->Name() << endl;
+        iret[i] = Fun4AllReturnCodes::ABORTRUN;
+      }
+      m_StartupTimes[i].independent = chrono::duration<double>(chrono::steady_clock::now() - start).count();
+    }
+  };
+  vector<thread> workers;
+  for (unsigned int i = 1; i < nthreads; i++)
+  {
+    workers.push_back(thread(worker));
+  }
+  worker();
+  for (auto &t : workers)
+  {
+    t.join();
+  }
+  m_IndependentInitWall = chrono::duration<double>(chrono::steady_clock::now() - wallstart).count();
+  for (unsigned int i = 0; i < Subsystems.size(); i++)
+  {
+    if (iret[i] == Fun4AllReturnCodes::ABORTRUN)
+    {
+      cout << PHWHERE << "Module " << Subsystems[i].first->Name() << " issued Abort Run in InitRunIndependent(), exiting" << endl;
+      exit(-1);
+    }
+    else if (iret[i] != Fun4AllReturnCodes::EVENT_OK)
+    {
+      cout << PHWHERE << "Module " << Subsystems[i].first->Name() << " issued non Fun4AllReturnCodes::EVENT_OK return code " << iret[i] << " in InitRunIndependent()" << endl;
+      exit(-2);
+    }
+  }
+  return 0;
+}
+
+int Fun4AllServer::FetchCalibrations(const int runno)
+{
+  ClearCalibrations();
+  if (m_Calibrations.empty())
+  {
+    return 0;
+  }
+  vector<pair<const string *, pair<function<PHObject *(const int)>, PHObject *> *> > requests;
+  for (auto &calib : m_Calibrations)
+  {
+    requests.push_back(make_pair(&calib.first, &calib.second));
+  }
+  // the fetches read root files (or the calibration snapshot)
+  ROOT::EnableThreadSafety();
+  atomic<unsigned int> next(0);
+  auto worker = [&]() {
+    for (unsigned int i = next++; i < requests.size(); i = next++)
+    {
+      PHObject *calib = nullptr;
+      try
+      {
+        calib = requests[i].second->first(runno);
+      }
+      catch (const exception &e)
+      {
+        cout << PHWHERE << " caught exception fetching calibration " << *requests[i].first
+             << ": " << e.what() << endl;
+      }
+      catch (...)
+      {
+        cout << PHWHERE << " caught unknown type exception fetching calibration "
+             << *requests[i].first << endl;
+      }
+      requests[i].second->second = calib;
+    }
+  };
+  unsigned int nthreads = min(max(m_CalibrationThreads, 1U), static_cast<unsigned int>(requests.size()));
+  vector<thread> workers;
+  for (unsigned int i = 1; i < nthreads; i++)
+  {
+    workers.push_back(thread(worker));
+  }
+  worker();
+  for (auto &t : workers)
+  {
+    t.join();
+  }
+  int nfailed = 0;
+  for (auto &req : requests)
+  {
+    if (!req.second->second)
+    {
+      // the module falls back to its own fetch in InitRun
+      if (Verbosity() > 0)
+      {
+        cout << PHWHERE << " calibration " << *req.first << " not available for run " << runno << endl;
+      }
+      nfailed++;
+    }
+  }
+  if (Verbosity() > 0)
+  {
+    cout << "Fun4AllServer: fetched " << requests.size() - nfailed << " of "
+         << requests.size() << " calibrations for run " << runno
+         << " with " << nthreads << " threads" << endl;
+  }
+  return nfailed;
+}
@@ -15,11 +15,22 @@
 #include <utility>          // for pair
 #include <vector>
 
+#if !defined(__CINT__) || defined(__CLING__)
+#include <functional>
+#include <mutex>
+#include <thread>
+#endif
+
 class Fun4AllInputManager;
 class Fun4AllMemoryTracker;
+class Fun4AllProfiler;
+struct Fun4AllAllocationStats;
 class Fun4AllSyncManager;
+class EventTimeBudget;
 class Fun4AllOutputManager;
 class PHCompositeNode;
+class PHNode;
+class PHObject;
 class PHTimeStamp;
 class SubsysReco;
 class TDirectory;
@@ -110,6 +121,97 @@ class Fun4AllServer : public Fun4AllBase
   void PrintTimer(const std::string &name = "");
   void PrintMemoryTracker(const std::string &name = "") const;
 
+  /*!
+    \brief run independent modules of an event concurrently.
+    Modules declare the nodes they read and write (SubsysReco::DeclareInputNode,
+    SubsysReco::DeclareOutputNode, SubsysReco::DeclareSharedOutputNode),
+    thread-safe modules without conflicting
+    nodes end up in the same group and are executed at the same time.
+  */
+  void ModuleScheduling(const bool b);
+  bool ModuleScheduling() const { return m_ModuleScheduling; }
+
+  //! sample the RSS memory around every module only every n events (0: never)
+  void MemoryTrackingInterval(const unsigned int n) { m_MemoryTrackingInterval = n; }
+  unsigned int MemoryTrackingInterval() const { return m_MemoryTrackingInterval; }
+
+  /*!
+    \brief record when each module runs and write the timeline at End()
+    in Chrome trace format (view in chrome://tracing or ui.perfetto.dev).
+    Only the first maxevents events are recorded
+  */
+  void TraceFile(const std::string &fname, const unsigned int maxevents = 1000);
+
+  /*!
+    \brief write a benchmark report in JSON format at End(): time per event
+    of each module, peak RSS and, if libfun4all_alloccount.so is preloaded,
+    the allocations, allocated bytes and peak heap growth per event of each
+    module. The label (e.g. the
+    chain and the sample) is copied into the report to tell the files apart
+  */
+  void BenchmarkFile(const std::string &fname, const std::string &label = "");
+
+  /*!
+    \brief write a throughput snapshot in JSON format every interval seconds
+    (checked after each event) and at End(): events/s, bytes read, decompressed
+    and written per second, the busy fraction of every module, the cpu
+    utilization of the workers and the queue depths of the input and output
+    stages. With promfile the same numbers go to a file in Prometheus text
+    format (e.g. for the textfile collector of node_exporter). Both files are
+    replaced atomically so they can be polled while the job runs
+  */
+  void MetricsFile(const std::string &jsonfile, const double interval_s = 10., const std::string &promfile = "");
+
+  /*!
+    \brief histogram the time of every module call (log binned, 1 us - 1000 s)
+    and keep the nslowest events (run, event) of every module. The histograms
+    go to the server histogram output, the percentiles and the slowest events
+    are also printed at End()
+  */
+  void ModuleTimeHistograms(const unsigned int nslowest = 10);
+
+  /*!
+    \brief sample the call stacks hz times per second of cpu time and write
+    them in folded format (flamegraph.pl, speedscope) at End(). The samples are
+    attributed to the module which is running, starts right away so InitRun is
+    included
+  */
+  void ProfileFile(const std::string &fname, const unsigned int hz = 100);
+
+  /*!
+    \brief time budget per event in ms (0: no budget). Expensive modules can
+    poll EventTimeBudgetExceeded() or EventTimeLeft() and switch to a cheaper
+    mode, they report this with DegradedResult(). The time, the budget and the
+    degraded modules of every event are written to the EventTimeBudget node
+  */
+  void TimeBudgetPerEvent(const double ms);
+  double TimeBudgetPerEvent() const { return m_EventTimeBudget; }
+  //! time left for the current event in ms, a large number if there is no budget
+  double EventTimeLeft() const;
+  //! true if the current event is over its time budget, cheap enough to be called often
+  bool EventTimeBudgetExceeded() const { return m_EventTimeBudget > 0 && EventTimeLeft() < 0; }
+  //! a module switched to a cheaper mode or bailed out in this event, thread safe
+  void DegradedResult(const std::string &modulename);
+
+  //! RUN and PAR nodes are read only during process_event, modules cannot add nodes there
+  void ProtectRunNodes(const bool b) { m_ProtectRunNodes = b; }
+
+#if !defined(__CINT__) || defined(__CLING__)
+  /*!
+    \brief declare a calibration needed in InitRun (register in Init).
+    All registered fetches run concurrently at the start of BeginRun,
+    before any InitRun. fetch returns the calibration for the run or
+    nullptr on failure, returns -1 if key is already registered
+  */
+  int registerCalibrationRequest(const std::string &key, std::function<PHObject *(const int runnumber)> fetch);
+#endif
+  //! calibration fetched for the current run, owned by the server and deleted at the next BeginRun, nullptr if not available
+  PHObject *getCalibration(const std::string &key) const;
+  //! number of threads fetching the registered calibrations
+  void CalibrationThreads(const unsigned int n) { m_CalibrationThreads = n; }
+  //! number of threads running the InitRunIndependent() of all modules
+  void InitThreads(const unsigned int n) { m_InitThreads = n; }
+
  protected:
   Fun4AllServer(const std::string &name = "Fun4AllServer");
   int InitNodeTree(PHCompositeNode *topNode);
@@ -118,6 +220,75 @@ class Fun4AllServer : public Fun4AllBase
   int UpdateEventSelector(Fun4AllOutputManager *manager);
   int unregisterSubsystemsNow();
   int setRun(const int runnumber);
+  int BuildModuleSchedule();
+  int process_event_scheduled(int &eventbad, const bool memsample);
+  //! tells the output managers that the current event is not written
+  void SubmitEmptySlot();
+  int BuildModuleSlots();
+  void TraceModule(const unsigned int traceindex, const double start, const double stop);
+  int WriteTrace() const;
+  int WriteBenchmark() const;
+  int WriteMetrics();
+  int FetchCalibrations(const int runno);
+  int RunIndependentInit(const int runno);
+  void BuildResetNodeList();
+  void ClearCalibrations();
+
+  struct SlowEvent
+  {
+    double time;  // ms
+    int run;
+    int event;
+    // the heap keeps the fastest of the slow events on top
+    bool operator<(const SlowEvent &other) const { return time > other.time; }
+  };
+  //! per event module times, kept by tracker name so they survive re-registration
+  struct ModuleTimes
+  {
+    TH1 *histo;
+    TH1 *slowest;
+    std::vector<SlowEvent> events;  // heap of the slowest events
+  };
+  struct StartupTimes
+  {
+    std::string name;
+    double independent;  // s, InitRunIndependent
+    double initrun;      // s, InitRun
+  };
+  ModuleTimes *GetModuleTimes(const std::string &trackername);
+  void RecordModuleTime(ModuleTimes *times, const double ms);
+  void WriteModuleTimes();
+
+  //! per module information resolved at registration instead of in every event
+  struct ModuleSlot
+  {
+    std::string dirname;
+    TDirectory *dir;
+    PHTimer *timer;
+    std::string trackername;
+    unsigned int traceindex;  // index in m_TraceNames
+    Fun4AllAllocationStats *allocations;  // nullptr without allocation counting
+    ModuleTimes *times;                   // nullptr without ModuleTimeHistograms
+  };
+  //! counters at the last metrics snapshot, the rates are taken over the interval since then
+  struct MetricsSample
+  {
+    double clock;  // us, TraceClock()
+    double cpu;    // s, user + system of the process
+    unsigned long events;
+    unsigned long long bytesread;
+    unsigned long long bytesdecompressed;
+    unsigned long long byteswritten;
+    std::map<std::string, double> moduletime;  // ms by tracker name
+  };
+  struct TraceRecord
+  {
+    unsigned int slot;
+    unsigned int thread;
+    unsigned long event;
+    double start;  // microseconds since the start of the job
+    double duration;
+  };
   static Fun4AllServer *__instance;
   TH1 *FrameWorkVars;
   Fun4AllMemoryTracker *ffamemtracker;
@@ -133,6 +304,38 @@ class Fun4AllServer : public Fun4AllBase
   int runnumber;
   int eventnumber;
   int keep_db_connected;
+  bool m_ModuleScheduling;
+  unsigned int m_MemoryTrackingInterval;
+  unsigned long m_EventsProcessed;
+  bool m_TraceThisEvent;
+  unsigned int m_TraceMaxEvents;
+  unsigned int m_CalibrationThreads;
+  unsigned int m_InitThreads;
+  double m_IndependentInitWall;  // s
+  bool m_ResetNodesValid;
+  unsigned long m_ResetNodesVersion;
+  std::string m_TraceFileName;
+  std::string m_BenchmarkFileName;
+  std::string m_BenchmarkLabel;
+  std::string m_ProfileFileName;
+  std::string m_MetricsFileName;
+  std::string m_MetricsPromFileName;
+  double m_MetricsInterval;  // us
+  MetricsSample m_MetricsLast;
+  double m_FirstEventClock;
+  double m_EventTimeBudget;  // ms
+  double m_EventStartClock;  // us, TraceClock() at the start of the event
+  unsigned long m_EventsOverBudget;
+  unsigned long m_EventsDegraded;
+  EventTimeBudget *m_EventTimeBudgetNode;
+  Fun4AllProfiler *m_Profiler;
+  bool m_ProtectRunNodes;
+  std::mutex m_DegradedMutex;
+  unsigned int m_NSlowestEvents;
+  //! run and event number of the current event, looked up when a slow event is recorded
+  bool m_EventIdValid;
+  int m_EventRun;
+  int m_EventSequence;
 
   std::vector<std::string> ComplaintList;
   std::vector<std::pair<SubsysReco *, PHCompositeNode *> > Subsystems;
@@ -146,6 +349,23 @@ class Fun4AllServer : public Fun4AllBase
   std::vector<Fun4AllSyncManager *> SyncManagers;
   std::map<int, int> retcodesmap;
   std::map<const std::string, PHTimer> timer_map;
+  //! groups of Subsystems indices which are executed concurrently, in order
+  std::vector<std::vector<unsigned> > m_ScheduleGroups;
+  //! same order as Subsystems
+  std::vector<ModuleSlot> m_ModuleSlots;
+  std::vector<std::string> m_TraceNames;
+  std::vector<TraceRecord> m_TraceRecords;
+  std::map<std::string, ModuleTimes> m_ModuleTimes;
+  //! startup cost of the last BeginRun, same order as Subsystems
+  std::vector<StartupTimes> m_StartupTimes;
+  //! nodes below DST whose objects are reset after every event, in tree order
+  std::vector<PHNode *> m_ResetNodes;
+#if !defined(__CINT__) || defined(__CLING__)
+  std::vector<std::thread::id> m_TraceThreads;
+  std::mutex m_TraceMutex;
+  //! registered calibration fetches and their result for the current run
+  std::map<std::string, std::pair<std::function<PHObject *(const int)>, PHObject *> > m_Calibrations;
+#endif
 };
 
 #endif
@@ -7,10 +7,16 @@
 
 #include <phool/phool.h>            // for PHWHERE
 
+#include <TROOT.h>
+
 #include <cstdlib>
+#include <functional>               // for cref
 #include <iostream>                 // for operator<<, endl, basic_ostream
+#include <iterator>                 // for next
 #include <list>                     // for list<>::const_iterator, _List_con...
+#include <map>
 #include <string>
+#include <thread>
 #include <utility>                  // for pair
 #include <vector>
 
@@ -24,6 +30,7 @@ Fun4AllSyncManager::Fun4AllSyncManager(const string &name)
   , m_CurrentRun(0)
   , m_CurrentEvent(0)
   , m_Repeat(0)
+  , m_FastSync(false)
   , m_MasterSync(nullptr)
 {
   return;
@@ -62,6 +69,10 @@ int Fun4AllSyncManager::registerInputManager(Fun4AllInputManager *InputManager)
   m_InManager.push_back(InputManager);
   m_iretInManager.push_back(0);
   InputManager->setSyncManager(this);
+  if (m_FastSync)
+  {
+    InputManager->EventIndex(true);
+  }
   return 0;
 }
 
@@ -89,30 +100,37 @@ int Fun4AllSyncManager::run(const int nevnts)
   while (!iret)
   {
     unsigned iman = 0;
-    int ifirst = 0;
-    for (vector<Fun4AllInputManager *>::iterator iter = m_InManager.begin(); iter != m_InManager.end(); ++iter)
+    if (m_FastSync)
+    {
+      iret = ReadFastSync(iman, iretsync);
+    }
+    else
     {
-      m_iretInManager[iman] = (*iter)->run(1);
-      iret += m_iretInManager[iman];
-      if (!ifirst)
+      int ifirst = 0;
+      for (vector<Fun4AllInputManager *>::iterator iter = m_InManager.begin(); iter != m_InManager.end(); ++iter)
       {
-        if (!m_iretInManager[iman])
+        m_iretInManager[iman] = (*iter)->run(1);
+        iret += m_iretInManager[iman];
+        if (!ifirst)
         {
-          if (!((*iter)->GetSyncObject(&m_MasterSync)))  // NoSync managers return non zero
+          if (!m_iretInManager[iman])
           {
-            ifirst = 1;
+            if (!((*iter)->GetSyncObject(&m_MasterSync)))  // NoSync managers return non zero
+            {
+              ifirst = 1;
+            }
           }
         }
-      }
-      else
-      {
-        iretsync = CheckSync(iman);
-        if (iretsync)
+        else
         {
-          break;
+          iretsync = CheckSync(iman);
+          if (iretsync)
+          {
+            break;
+          }
         }
+        iman++;
       }
-      iman++;
     }
 
     // check event reading, syncronisation
@@ -368,6 +386,105 @@ int Fun4AllSyncManager::CheckSync(const unsigned i)
   return iret;
 }
 
+void Fun4AllSyncManager::FastSync(const bool b)
+{
+  m_FastSync = b;
+  if (b)
+  {
+    // the input managers of the different top nodes use ROOT concurrently
+    ROOT::EnableThreadSafety();
+    for (Fun4AllInputManager *inman : m_InManager)
+    {
+      inman->EventIndex(true);
+    }
+  }
+  return;
+}
+
+void Fun4AllSyncManager::ReadConcurrently()
+{
+  // input managers of the same top node add to the same node tree
+  map<string, vector<unsigned int> > topnodes;
+  for (unsigned int i = 0; i < m_InManager.size(); i++)
+  {
+    topnodes[m_InManager[i]->TopNodeName()].push_back(i);
+  }
+  auto reader = [this](const vector<unsigned int> &imans) {
+    for (unsigned int i : imans)
+    {
+      m_iretInManager[i] = m_InManager[i]->run(1);
+    }
+  };
+  // the last top node is read by this thread
+  vector<thread> readers;
+  for (auto iter = topnodes.begin(); iter != topnodes.end(); ++iter)
+  {
+    if (next(iter) == topnodes.end())
+    {
+      reader(iter->second);
+    }
+    else
+    {
+      readers.push_back(thread(reader, cref(iter->second)));
+    }
+  }
+  for (thread &t : readers)
+  {
+    t.join();
+  }
+  return;
+}
+
+int Fun4AllSyncManager::ReadFastSync(unsigned &iman, int &iretsync)
+{
+  // iretsync is only set by CheckSync(), which is skipped when all keys
+  // match, a resync of the previous event must not stick
+  iretsync = 0;
+  ReadConcurrently();
+  int iret = 0;
+  for (int iretman : m_iretInManager)
+  {
+    iret += iretman;
+  }
+  if (iret)
+  {
+    return iret;
+  }
+  int ifirst = 0;
+  uint64_t masterkey = 0;
+  for (iman = 0; iman < m_InManager.size(); iman++)
+  {
+    if (!ifirst)
+    {
+      if (!(m_InManager[iman]->GetSyncObject(&m_MasterSync)))  // NoSync managers return non zero
+      {
+        ifirst = 1;
+        masterkey = (m_MasterSync ? m_MasterSync->SyncKey() : 0);
+      }
+      continue;
+    }
+    // matching keys (0 means no key) are in sync without asking the input manager
+    if (masterkey && m_InManager[iman]->SyncKey() == masterkey)
+    {
+      continue;
+    }
+    iretsync = CheckSync(iman);
+    if (iretsync)
+    {
+      // the sequential loop would not have read the following input managers yet
+      for (unsigned int i = iman + 1; i < m_InManager.size(); i++)
+      {
+        if (m_InManager[i]->NoSyncPushBackEvents(1))
+        {
+          m_InManager[i]->PushBackEvents(1);
+        }
+      }
+      break;
+    }
+  }
+  return 0;
+}
+
 void Fun4AllSyncManager::GetInputFullFileList(std::vector<std::string> &fnames) const
 {
   for (Fun4AllInputManager *InMan : m_InManager)
@@ -9,6 +9,7 @@
 
 #include "Fun4AllBase.h"
 
+#include <cstdint>
 #include <string>         // for string
 #include <vector>
 
@@ -53,15 +54,29 @@ class Fun4AllSyncManager : public Fun4AllBase
   void PushBackInputMgrsEvents(const int i);
   int ResetEvent();
   const std::vector<Fun4AllInputManager *> GetInputManagers() const { return m_InManager; }
+  /*!
+    \brief read the inputs of different top nodes (e.g. signal and background
+    of an embedding job) concurrently, accept events whose run, segment and
+    event counter match the master as 64 bit key without a SyncIt call and
+    let the input managers jump through their event index to resynchronize.
+    Input managers of the same top node still read one after the other, their
+    SubsysRecos must not touch other top nodes
+  */
+  void FastSync(const bool b);
 
  private:
   int CheckSync(unsigned i);
+  //! run(1) of all input managers, one thread per top node
+  void ReadConcurrently();
+  //! returns the accumulated read error, iman is the manager which failed to sync
+  int ReadFastSync(unsigned &iman, int &iretsync);
   int m_PrdfSegment;
   int m_PrdfEvents;
   int m_EventsTotal;
   int m_CurrentRun;
   int m_CurrentEvent;
   int m_Repeat;
+  bool m_FastSync;
   SyncObject *m_MasterSync;
   std::vector<Fun4AllInputManager *> m_InManager;
   std::vector<int> m_iretInManager;
@@ -11,9 +11,12 @@
 #include "PHTFileServer.h"
 
 #include <TObject.h>  // for TObject, TObject::kWriteDelete
+#include <TROOT.h>
 
 #include <iostream>   // for operator<<, basic_ostream, ostringstream, endl
+#include <mutex>
 #include <sstream>
+#include <thread>
 #include <utility>    // for pair, make_pair
 
 using namespace std;
@@ -21,6 +24,9 @@ using namespace std;
 //_________________________________________________
 PHTFileServer::SafeTFile::TFileMap PHTFileServer::SafeTFile::_map;
 
+// modules running in worker threads open and write their files concurrently
+static mutex fFileMapMutex;
+
 //_________________________________________________
 PHTFileServer::~PHTFileServer(void)
 {
@@ -28,8 +34,9 @@ PHTFileServer::~PHTFileServer(void)
 }
 
 //_________________________________________________
-void PHTFileServer::open(const string& filename, const string& type)
+void PHTFileServer::open(const string& filename, const string& type, const int compression)
 {
+  lock_guard<mutex> lock(fFileMapMutex);
   SafeTFile::TFileMap::iterator iter(SafeTFile::file_map().find(filename));
   if (iter != SafeTFile::file_map().end())
   {
@@ -38,6 +45,7 @@ void PHTFileServer::open(const string& filename, const string& type)
     cout << (what.str()) << endl;
 
     // increment counter; change TDirectory
+    iter->second->wait();
     iter->second->counter()++;
     iter->second->cd();
   }
@@ -50,6 +58,7 @@ void PHTFileServer::open(const string& filename, const string& type)
     // create new SafeTFile; insert in map; change TDirectory
     SafeTFile* file(new SafeTFile(filename, type));
     if (!file->IsOpen()) cout << ("PHTFileServer::open - error opening TFile") << endl;
+    if (compression >= 0) file->SetCompressionSettings(compression);
     SafeTFile::file_map().insert(make_pair(filename, file));
     file->cd();
   }
@@ -58,9 +67,13 @@ void PHTFileServer::open(const string& filename, const string& type)
 //_________________________________________________
 bool PHTFileServer::flush(const string& filename)
 {
+  lock_guard<mutex> lock(fFileMapMutex);
   SafeTFile::TFileMap::iterator iter(SafeTFile::file_map().find(filename));
   if (iter != SafeTFile::file_map().end())
+  {
+    iter->second->wait();
     iter->second->Flush();
+  }
   else
   {
     ostringstream what;
@@ -75,9 +88,13 @@ bool PHTFileServer::flush(const string& filename)
 //_________________________________________________
 bool PHTFileServer::cd(const string& filename)
 {
+  lock_guard<mutex> lock(fFileMapMutex);
   SafeTFile::TFileMap::iterator iter(SafeTFile::file_map().find(filename));
   if (iter != SafeTFile::file_map().end())
+  {
+    iter->second->wait();
     iter->second->cd();
+  }
   else
   {
     ostringstream what;
@@ -92,9 +109,11 @@ bool PHTFileServer::cd(const string& filename)
 //_________________________________________________
 bool PHTFileServer::write(const string& filename)
 {
+  lock_guard<mutex> lock(fFileMapMutex);
   SafeTFile::TFileMap::iterator iter(SafeTFile::file_map().find(filename));
   if (iter != SafeTFile::file_map().end())
   {
+    iter->second->wait();
     if (iter->second->counter() > 1)
     {
       iter->second->counter()--;
@@ -104,7 +123,10 @@ bool PHTFileServer::write(const string& filename)
     }
     else if (iter->second->counter() == 1)
     {
-      iter->second->Write();
+      if (_async_write)
+        iter->second->write_async();
+      else
+        iter->second->Write();
       iter->second->counter()--;
       ostringstream what;
       what << "PHTFileServer::write - writing file " << filename << ".";
@@ -132,10 +154,12 @@ bool PHTFileServer::write(const string& filename)
 //__________________________________________
 void PHTFileServer::close(void)
 {
+  lock_guard<mutex> lock(fFileMapMutex);
   // close
   //  MUTOO::TRACE( "PHTFileServer::close" );
   for (SafeTFile::TFileMap::iterator iter = SafeTFile::file_map().begin(); iter != SafeTFile::file_map().end(); ++iter)
   {
+    iter->second->wait();
     if (iter->second->IsOpen())
     {
       if (iter->second->counter())
@@ -158,9 +182,18 @@ void PHTFileServer::close(void)
   SafeTFile::file_map().clear();
 }
 
+//__________________________________________________________________________________
+void PHTFileServer::SafeTFile::write_async()
+{
+  wait();
+  ROOT::EnableThreadSafety();
+  _writer = thread([this]() { Write(); });
+}
+
 //__________________________________________________________________________________
 PHTFileServer::SafeTFile::~SafeTFile(void)
 {
+  wait();
   // see if TFile is still open
   if (IsOpen())
   {
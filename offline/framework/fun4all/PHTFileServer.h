@@ -18,6 +18,7 @@
 #include <map>
 #include <sstream>
 #include <string>
+#include <thread>
 
 /*! 
   \brief TFile clean handling. It allow independant classes to access
@@ -40,9 +41,11 @@ class PHTFileServer
 
   /*! \brief 
     open a SafeTFile. If filename is not found in the map, create a new TFile
-    and append to the map; increment counter otherwise
+    and append to the map; increment counter otherwise.
+    compression (ROOT convention, algorithm * 100 + level) is only used
+    for new files, negative values keep the ROOT default
   */
-  void open(const std::string& filename, const std::string& type = "RECREATE");
+  void open(const std::string& filename, const std::string& type = "RECREATE", const int compression = -1);
 
   //! flush TFile matching filename
   bool flush(const std::string& filename);
@@ -59,12 +62,23 @@ class PHTFileServer
   //! close all TFiles
   void close(void);
 
+  /*! \brief
+    the last write() of a file returns right away and the TFile is written
+    by a helper thread. Any other call for this file waits for it.
+    The objects in the file must not be changed after the last write()
+  */
+  void AsyncWrite(const bool b = true) { _async_write = b; }
+
  private:
   //! constructor
   PHTFileServer(void)
+    : _async_write(false)
   {
   }
 
+  //! write TFiles in a helper thread
+  bool _async_write;
+
   //! local class to store TFile and counter
   class SafeTFile : public TFile
   {
@@ -92,6 +106,15 @@ class PHTFileServer
       return _counter;
     }
 
+    //! Write() in a helper thread
+    void write_async();
+
+    //! wait for the helper thread started by write_async
+    void wait()
+    {
+      if (_writer.joinable()) _writer.join();
+    }
+
     //! shortcut for SafeTFile map
     typedef std::map<std::string, SafeTFile*> TFileMap;
 
@@ -107,6 +130,9 @@ class PHTFileServer
     //! call counter
     int _counter;
 
+    //! thread running the asynchronous Write()
+    std::thread _writer;
+
     //! filename/SafeTFile map
     static TFileMap _map;
   };
@@ -5,6 +5,7 @@
 
 #include "Fun4AllBase.h"
 
+#include <set>
 #include <string>
 
 class PHCompositeNode;
@@ -47,6 +48,14 @@ class SubsysReco : public Fun4AllBase
    */
   virtual int InitRun(PHCompositeNode * /*topNode*/) { return 0; }
 
+  /** Called for first event before any InitRun(), concurrently for all
+      modules (see Fun4AllServer::InitThreads()). Only for run dependent
+      setup which does not touch the node tree, gDirectory or other
+      modules, e.g. reading field maps or building lookup tables into
+      members. InitRun() is called afterwards as usual.
+   */
+  virtual int InitRunIndependent(const int /*runnumber*/) { return 0; }
+
   /** Called for each event.
       This is where you do the real work.
   */
@@ -60,6 +69,40 @@ class SubsysReco : public Fun4AllBase
 
   virtual void Print(const std::string &what = "ALL") const {}
 
+  /** Declares whether process_event() may run concurrently with other
+      modules of the same event when Fun4AllServer::ModuleScheduling()
+      is on. A thread-safe module must not create or
+      delete nodes, must not modify state shared with other modules
+      (histograms, counters, random number streams) without its own
+      locking and must only read the objects it does not own.
+      Events are always processed one after the other, a module may keep
+      per event state in its members.
+      Modules are not thread-safe unless they say so.
+   */
+  virtual bool ThreadSafe() const { return false; }
+
+  /** Nodes read and written by this module in process_event().
+      Fun4AllServer uses them to find modules which do not depend on each
+      other and can be run at the same time. A module which declares
+      neither is scheduled as a barrier (runs alone, in registration order).
+   */
+  const std::set<std::string> &InputNodes() const { return m_InputNodes; }
+  const std::set<std::string> &OutputNodes() const { return m_OutputNodes; }
+  const std::set<std::string> &SharedOutputNodes() const { return m_SharedOutputNodes; }
+
+  /// Declare a node read by this module (can also be done from a macro)
+  void DeclareInputNode(const std::string &name) { m_InputNodes.insert(name); }
+
+  /// Declare a node written (created or filled) by this module
+  void DeclareOutputNode(const std::string &name) { m_OutputNodes.insert(name); }
+
+  /** Declare a node this module only adds to through a method of the
+      node object which does its own locking (e.g. TrkrClusterContainer::addClusters).
+      Modules sharing an output node can run at the same time, they still
+      run after the modules reading it and before the ones writing it
+   */
+  void DeclareSharedOutputNode(const std::string &name) { m_SharedOutputNodes.insert(name); }
+
  protected:
   /** ctor.
       @param name is the reference used inside the Fun4AllServer
@@ -68,6 +111,11 @@ class SubsysReco : public Fun4AllBase
     : Fun4AllBase(name)
   {
   }
+
+ private:
+  std::set<std::string> m_InputNodes;
+  std::set<std::string> m_OutputNodes;
+  std::set<std::string> m_SharedOutputNodes;
 };
 
 #endif
@@ -30,11 +30,15 @@ Fun4AllEventOutStream::Fun4AllEventOutStream(const std::string &name)
   ,  // there shouldn't be more than this number of packets in a single event
   npackets(0)
   , default_addall(0)
+  , m_QueueDepth(0)
+  , m_StopWriter(false)
 {
 }
 
 Fun4AllEventOutStream::~Fun4AllEventOutStream()
 {
+  // the derived streams stop the writer, this only catches forgotten events
+  StopWriter();
   delete[] evtbuf;
   delete[] plist;
   return;
@@ -57,6 +61,16 @@ int Fun4AllEventOutStream::WriteEvent(Event *evt)
   int iret;
   if (!add_or_remove)
   {
+    if (m_QueueDepth > 0)
+    {
+      // the input event is gone when the writer gets to it
+      unsigned int length = evt->getEvtLength();
+      PHDWORD *buffer = new PHDWORD[length];
+      int nw = 0;
+      evt->Copy(reinterpret_cast<int *>(buffer), length, &nw);
+      QueueEvent(buffer);
+      return 0;
+    }
     iret = WriteEventOut(evt);
     return iret;
   }
@@ -131,13 +145,20 @@ int Fun4AllEventOutStream::WriteEvent(Event *evt)
     }
   }
   size += 100;  // add some size for the event header
-  if (size > evtbuf_size)
+  PHDWORD *buffer = evtbuf;
+  if (m_QueueDepth > 0)
+  {
+    // the filtered event is built directly in the buffer the writer thread takes over
+    buffer = new PHDWORD[size]();
+  }
+  else if (size > evtbuf_size)
   {
     // Add 10000 so we do this resize only a few times
     resize_evtbuf(size + 10000);
+    buffer = evtbuf;
   }
 
-  oEvent new_event(evtbuf, size, evt->getRunNumber(), evt->getEvtType(), evt->getEvtSequence());
+  oEvent new_event(buffer, size, evt->getRunNumber(), evt->getEvtType(), evt->getEvtSequence());
   while (!savepacket.empty())
   {
     int index = savepacket.front();
@@ -145,9 +166,17 @@ int Fun4AllEventOutStream::WriteEvent(Event *evt)
     savepacket.pop();
   }
 
-  Event *newE = new A_Event(evtbuf);
-  iret = WriteEventOut(newE);
-  delete newE;
+  if (m_QueueDepth > 0)
+  {
+    QueueEvent(buffer);
+    iret = 0;
+  }
+  else
+  {
+    Event *newE = new A_Event(buffer);
+    iret = WriteEventOut(newE);
+    delete newE;
+  }
   for (int i = 0; i < npackets; i++)
   {
     delete plist[i];
@@ -229,3 +258,66 @@ int Fun4AllEventOutStream::DropPacketRange(const int minpacket, const int maxpac
   }
   return 0;
 }
+
+void Fun4AllEventOutStream::AsyncWrite(const unsigned int depth)
+{
+  if (depth == 0)
+  {
+    StopWriter();
+  }
+  m_QueueDepth = depth;
+}
+
+void Fun4AllEventOutStream::QueueEvent(PHDWORD *buffer)
+{
+  if (!m_Writer.joinable())
+  {
+    m_StopWriter = false;
+    m_Writer = thread(&Fun4AllEventOutStream::WriterLoop, this);
+  }
+  unique_lock<mutex> lock(m_QueueMutex);
+  m_QueueCondition.wait(lock, [this] { return m_Queue.size() < m_QueueDepth; });
+  m_Queue.push_back(buffer);
+  lock.unlock();
+  m_QueueCondition.notify_all();
+}
+
+void Fun4AllEventOutStream::WriterLoop()
+{
+  while (true)
+  {
+    PHDWORD *buffer = nullptr;
+    {
+      unique_lock<mutex> lock(m_QueueMutex);
+      m_QueueCondition.wait(lock, [this] { return !m_Queue.empty() || m_StopWriter; });
+      if (m_Queue.empty())
+      {
+        return;
+      }
+      buffer = m_Queue.front();
+    }
+    Event *evt = new A_Event(buffer);
+    WriteEventOut(evt);
+    delete evt;
+    delete[] buffer;
+    {
+      lock_guard<mutex> lock(m_QueueMutex);
+      m_Queue.pop_front();
+    }
+    m_QueueCondition.notify_all();
+  }
+}
+
+void Fun4AllEventOutStream::StopWriter()
+{
+  if (!m_Writer.joinable())
+  {
+    return;
+  }
+  {
+    lock_guard<mutex> lock(m_QueueMutex);
+    m_StopWriter = true;
+  }
+  m_QueueCondition.notify_all();
+  m_Writer.join();
+}
@@ -24,6 +24,13 @@
 #include <map>
 #include <string>
 
+#if !defined(__CINT__) || defined(__CLING__)
+#include <condition_variable>
+#include <deque>
+#include <mutex>
+#include <thread>
+#endif
+
 class Event;
 class Packet;
 class Fun4AllEventOutputManager;
@@ -43,12 +50,24 @@ class Fun4AllEventOutStream : public Fun4AllBase
   int DropPacketRange(const int minpacket, const int maxpacket);
   void SetManager(Fun4AllEventOutputManager *myman) { m_MyManager = myman; }
 
+  //! write events in a separate thread, at most depth events are queued (0: write synchronously)
+  void AsyncWrite(const unsigned int depth);
+  //! write the queued events and stop the writer thread, has to be called before
+  //! the derived stream is destroyed
+  void StopWriter();
+
  protected:
   Fun4AllEventOutStream(const std::string &name = "OUTSTREAM");
   int resize_evtbuf(const unsigned int newsize);
   Fun4AllEventOutputManager *MyManager() { return m_MyManager; }
 
  private:
+#if !defined(__CINT__) || defined(__CLING__)
+  //! hand an event buffer over to the writer thread, which deletes it
+  void QueueEvent(PHDWORD *buffer);
+  void WriterLoop();
+#endif
+
   PHDWORD *evtbuf;
   Fun4AllEventOutputManager *m_MyManager;  // pointer to my master
   unsigned int evtbuf_size;
@@ -62,6 +81,15 @@ class Fun4AllEventOutStream : public Fun4AllBase
 #if !defined(__CINT__) || defined(__CLING__)
   std::map<int, boost::numeric::interval<int> > addpktrange;
   std::map<int, boost::numeric::interval<int> > droppktrange;
+#endif
+  unsigned int m_QueueDepth;
+#if !defined(__CINT__) || defined(__CLING__)
+  //! event buffers waiting to be written (front is being written)
+  std::deque<PHDWORD *> m_Queue;
+  std::mutex m_QueueMutex;
+  std::condition_variable m_QueueCondition;
+  std::thread m_Writer;
+  bool m_StopWriter;
 #endif
 };
 
@@ -27,6 +27,7 @@ Fun4AllEventOutputManager::Fun4AllEventOutputManager(const string &myname, const
 
 Fun4AllEventOutputManager::~Fun4AllEventOutputManager()
 {
+  m_OutStream->StopWriter();
   delete m_OutStream;
   return;
 }
@@ -115,3 +116,9 @@ void Fun4AllEventOutputManager::SetOutfileName(const std::string &fname)
   OutFileName(fname);
   return;
 }
+
+void Fun4AllEventOutputManager::AsyncWrite(const unsigned int depth)
+{
+  m_OutStream->AsyncWrite(depth);
+  return;
+}
@@ -27,6 +27,8 @@ class Fun4AllEventOutputManager : public Fun4AllOutputManager
   int AddPacketRange(const int ipktmin, const int ipktmax);
   int DropPacketRange(const int ipktmin, const int ipktmax);
   void SetOutfileName(const std::string &fname);
+  //! write events in a separate thread, at most depth events are queued (0: write synchronously)
+  void AsyncWrite(const unsigned int depth);
 
  protected:
   std::string m_OutFileRule;
@@ -32,6 +32,7 @@ Fun4AllFileOutStream::Fun4AllFileOutStream(const string &frule, const string &na
 
 Fun4AllFileOutStream::~Fun4AllFileOutStream()
 {
+  StopWriter();
   delete m_ob;
   if (m_OutFileDesc >= 0)
   {
@@ -93,6 +94,7 @@ int Fun4AllFileOutStream::WriteEventOut(Event *evt)
 
 int Fun4AllFileOutStream::CloseOutStream()
 {
+  StopWriter();
   DeleteoBuffer();
   return 0;
 }
@@ -21,11 +21,13 @@
 #include <Event/Event.h>
 #include <Event/Eventiterator.h>  // for Eventiterator
 #include <Event/fileEventiterator.h>
+#include <Event/packet.h>
 
 #include <cassert>
 #include <cstdlib>
 #include <iostream>  // for operator<<, basic_ostream, endl
 #include <utility>   // for pair
+#include <vector>
 
 using namespace std;
 
@@ -39,6 +41,15 @@ Fun4AllPrdfInputManager::Fun4AllPrdfInputManager(const string &name, const strin
   , m_EventIterator(nullptr)
   , m_SyncObject(new SyncObjectv1())
   , m_PrdfNodeName(prdfnodename)
+  , m_Packets(nullptr)
+  , m_SavePackets(nullptr)
+  , m_PipelineDepth(0)
+  , m_NDecoders(1)
+  , m_BytesRead(0)
+  , m_ReadSequence(0)
+  , m_NextSequence(0)
+  , m_ReaderDone(false)
+  , m_StopPipeline(false)
 {
   Fun4AllServer *se = Fun4AllServer::instance();
   m_topNode = se->topNode(TopNodeName());
@@ -91,6 +102,10 @@ int Fun4AllPrdfInputManager::fileopen(const string &filenam)
   m_Segment = runseg.second;
   IsOpen(1);
   AddToFileOpened(fname);  // add file to the list of files which were opened
+  if (m_PipelineDepth > 0)
+  {
+    StartPipeline();
+  }
   return 0;
 }
 
@@ -127,13 +142,15 @@ readagain:
   if (m_SaveEvent)  // if an event was pushed back, copy saved pointer and reset m_SaveEvent pointer
   {
     m_Event = m_SaveEvent;
+    m_Packets = m_SavePackets;
     m_SaveEvent = nullptr;
+    m_SavePackets = nullptr;
     m_EventsThisFile--;
     m_EventsTotal--;
   }
   else
   {
-    m_Event = m_EventIterator->getNextEvent();
+    m_Event = NextEvent(m_Packets);
   }
   PrdfNode->setData(m_Event);
   if (!m_Event)
@@ -141,6 +158,16 @@ readagain:
     fileclose();
     goto readagain;
   }
+  if (m_Packets)
+  {
+    PHDataNode<PrdfPacketMap> *PacketNode = dynamic_cast<PHDataNode<PrdfPacketMap> *>(iter.findFirst("PHDataNode", m_PrdfNodeName + "_PACKETS"));
+    if (!PacketNode)
+    {
+      PacketNode = new PHDataNode<PrdfPacketMap>(nullptr, m_PrdfNodeName + "_PACKETS", "PrdfPacketMap");
+      m_topNode->addNode(PacketNode);
+    }
+    PacketNode->setData(m_Packets);
+  }
   if (Verbosity() > 1)
   {
     cout << Name() << " PRDF run " << m_Event->getRunNumber() << ", evt no: " << m_Event->getEvtSequence() << endl;
@@ -171,6 +198,8 @@ int Fun4AllPrdfInputManager::fileclose()
     cout << Name() << ": fileclose: No Input file open" << endl;
     return -1;
   }
+  // the reader thread uses the event iterator
+  StopPipeline();
   delete m_EventIterator;
   m_EventIterator = nullptr;
   IsOpen(0);
@@ -193,6 +222,17 @@ int Fun4AllPrdfInputManager::ResetEvent()
   PrdfNode->setData(nullptr);  // set pointer in Node to nullptr before deleting it
   delete m_Event;
   m_Event = nullptr;
+  PHDataNode<PrdfPacketMap> *PacketNode = dynamic_cast<PHDataNode<PrdfPacketMap> *>(iter.findFirst("PHDataNode", m_PrdfNodeName + "_PACKETS"));
+  if (PacketNode)
+  {
+    PacketNode->setData(nullptr);
+  }
+  // a pushed back event keeps its packets
+  if (m_Packets != m_SavePackets)
+  {
+    DeletePackets(m_Packets);
+  }
+  m_Packets = nullptr;
   m_SyncObject->Reset();
   return 0;
 }
@@ -209,6 +249,7 @@ int Fun4AllPrdfInputManager::PushBackEvents(const int i)
     if (i == 1 && m_Event)  // check on m_Event pointer makes sure it is not done from the cmd line
     {
       m_SaveEvent = m_Event;
+      m_SavePackets = m_Packets;
       return 0;
     }
     cout << PHWHERE << Name()
@@ -229,7 +270,9 @@ int Fun4AllPrdfInputManager::PushBackEvents(const int i)
   int errorflag = 0;
   while (nevents > 0 && !errorflag)
   {
-    m_Event = m_EventIterator->getNextEvent();
+    PrdfPacketMap *packets = nullptr;
+    m_Event = NextEvent(packets);
+    DeletePackets(packets);
     if (!m_Event)
     {
       cout << "Error after skipping " << i - nevents
@@ -292,3 +335,194 @@ int Fun4AllPrdfInputManager::SyncIt(const SyncObject *mastersync)
   }
   return Fun4AllReturnCodes::SYNC_OK;
 }
+
+void Fun4AllPrdfInputManager::Pipeline(const unsigned int depth, const unsigned int ndecoders)
+{
+  if (IsOpen())
+  {
+    cout << PHWHERE << Name() << ": the pipeline has to be set up before opening a file" << endl;
+    return;
+  }
+  m_PipelineDepth = depth;
+  m_NDecoders = (ndecoders > 0 ? ndecoders : 1);
+}
+
+Event *Fun4AllPrdfInputManager::NextEvent(PrdfPacketMap *&packets)
+{
+  packets = nullptr;
+  if (!m_Reader.joinable())
+  {
+    Event *evt = m_EventIterator->getNextEvent();
+    if (evt)
+    {
+      m_BytesRead += 4ULL * evt->getEvtLength();  // evtlength is in 32bit words
+      packets = DecodePackets(evt);
+    }
+    return evt;
+  }
+  // events are handed out in the order in which they were read, no matter which decoder finished first
+  unique_lock<mutex> lock(m_PipelineMutex);
+  m_PipelineCondition.wait(lock, [this] {
+    auto iter = m_Pipeline.find(m_NextSequence);
+    return (iter != m_Pipeline.end() && iter->second.decoded) || (m_ReaderDone && m_NextSequence == m_ReadSequence);
+  });
+  auto iter = m_Pipeline.find(m_NextSequence);
+  if (iter == m_Pipeline.end())
+  {
+    return nullptr;
+  }
+  Event *evt = iter->second.event;
+  packets = iter->second.packets;
+  m_Pipeline.erase(iter);
+  m_NextSequence++;
+  lock.unlock();
+  m_PipelineCondition.notify_all();
+  m_BytesRead += 4ULL * evt->getEvtLength();
+  return evt;
+}
+
+unsigned int Fun4AllPrdfInputManager::QueueDepth() const
+{
+  lock_guard<mutex> lock(m_PipelineMutex);
+  return m_Pipeline.size();
+}
+
+PrdfPacketMap *Fun4AllPrdfInputManager::DecodePackets(Event *evt) const
+{
+  if (m_DecodePackets.empty())
+  {
+    return nullptr;
+  }
+  PrdfPacketMap *packets = new PrdfPacketMap();
+  for (auto id : m_DecodePackets)
+  {
+    Packet *packet = evt->getPacket(id);
+    if (packet)
+    {
+      // packets decode their data with the first access
+      packet->iValue(0);
+      (*packets)[id] = packet;
+    }
+  }
+  return packets;
+}
+
+void Fun4AllPrdfInputManager::DeletePackets(PrdfPacketMap *packets)
+{
+  if (!packets)
+  {
+    return;
+  }
+  for (auto &iter : *packets)
+  {
+    delete iter.second;
+  }
+  delete packets;
+}
+
+void Fun4AllPrdfInputManager::StartPipeline()
+{
+  m_ReadSequence = 0;
+  m_NextSequence = 0;
+  m_ReaderDone = false;
+  m_StopPipeline = false;
+  m_Reader = thread(&Fun4AllPrdfInputManager::ReaderLoop, this);
+  for (unsigned int i = 0; i < m_NDecoders; i++)
+  {
+    m_Decoders.push_back(thread(&Fun4AllPrdfInputManager::DecoderLoop, this));
+  }
+}
+
+void Fun4AllPrdfInputManager::ReaderLoop()
+{
+  while (true)
+  {
+    {
+      unique_lock<mutex> lock(m_PipelineMutex);
+      m_PipelineCondition.wait(lock, [this] { return m_Pipeline.size() < m_PipelineDepth || m_StopPipeline; });
+      if (m_StopPipeline)
+      {
+        return;
+      }
+    }
+    Event *evt = m_EventIterator->getNextEvent();
+    {
+      lock_guard<mutex> lock(m_PipelineMutex);
+      if (!evt || m_StopPipeline)
+      {
+        delete evt;
+        m_ReaderDone = true;
+      }
+      else
+      {
+        PipelineEvent pipelineevent;
+        pipelineevent.event = evt;
+        pipelineevent.packets = nullptr;
+        pipelineevent.decoded = false;
+        m_Pipeline[m_ReadSequence] = pipelineevent;
+        m_DecodeQueue.push_back(m_ReadSequence);
+        m_ReadSequence++;
+      }
+    }
+    m_PipelineCondition.notify_all();
+    if (!evt)
+    {
+      return;
+    }
+  }
+}
+
+void Fun4AllPrdfInputManager::DecoderLoop()
+{
+  while (true)
+  {
+    unsigned long sequence;
+    Event *evt = nullptr;
+    {
+      unique_lock<mutex> lock(m_PipelineMutex);
+      m_PipelineCondition.wait(lock, [this] { return !m_DecodeQueue.empty() || m_ReaderDone || m_StopPipeline; });
+      if (m_DecodeQueue.empty() || m_StopPipeline)
+      {
+        return;
+      }
+      sequence = m_DecodeQueue.front();
+      m_DecodeQueue.pop_front();
+      evt = m_Pipeline[sequence].event;
+    }
+    // every decoder works on a different event
+    PrdfPacketMap *packets = DecodePackets(evt);
+    {
+      lock_guard<mutex> lock(m_PipelineMutex);
+      m_Pipeline[sequence].packets = packets;
+      m_Pipeline[sequence].decoded = true;
+    }
+    m_PipelineCondition.notify_all();
+  }
+}
+
+void Fun4AllPrdfInputManager::StopPipeline()
+{
+  if (!m_Reader.joinable())
+  {
+    return;
+  }
+  {
+    lock_guard<mutex> lock(m_PipelineMutex);
+    m_StopPipeline = true;
+  }
+  m_PipelineCondition.notify_all();
+  m_Reader.join();
+  for (auto &decoder : m_Decoders)
+  {
+    decoder.join();
+  }
+  m_Decoders.clear();
+  // events read ahead but not processed
+  for (auto &iter : m_Pipeline)
+  {
+    DeletePackets(iter.second.packets);
+    delete iter.second.event;
+  }
+  m_Pipeline.clear();
+  m_DecodeQueue.clear();
+}
@@ -5,13 +5,27 @@
 
 #include <fun4all/Fun4AllInputManager.h>
 
+#include <map>
+#include <set>
 #include <string>
 
+#if !defined(__CINT__) || defined(__CLING__)
+#include <condition_variable>
+#include <deque>
+#include <mutex>
+#include <thread>
+#include <vector>
+#endif
+
 class Event;
 class Eventiterator;
+class Packet;
 class PHCompositeNode;
 class SyncObject;
 
+//! decoded packets of the current event by packet id, on the node <prdfnodename>_PACKETS
+typedef std::map<int, Packet *> PrdfPacketMap;
+
 class Fun4AllPrdfInputManager : public Fun4AllInputManager
 {
  public:
@@ -27,7 +41,28 @@ class Fun4AllPrdfInputManager : public Fun4AllInputManager
   int GetSyncObject(SyncObject **mastersync);
   int SyncIt(const SyncObject *mastersync);
 
+  //! read events in a separate thread, at most depth events are read ahead and
+  //! ndecoders threads decode their packets in parallel (0: read synchronously)
+  void Pipeline(const unsigned int depth, const unsigned int ndecoders = 1);
+  //! packets decoded before the event is handed to the modules
+  void AddDecodePacket(const int id) { m_DecodePackets.insert(id); }
+  //! bytes of the events handed to the modules so far
+  unsigned long long BytesRead() const { return m_BytesRead; }
+  //! events read ahead by the pipeline
+  unsigned int QueueDepth() const;
+
  private:
+  //! next event of the open file with its decoded packets, nullptr at the end of the file
+  Event *NextEvent(PrdfPacketMap *&packets);
+  PrdfPacketMap *DecodePackets(Event *evt) const;
+  static void DeletePackets(PrdfPacketMap *packets);
+#if !defined(__CINT__) || defined(__CLING__)
+  void StartPipeline();
+  void StopPipeline();
+  void ReaderLoop();
+  void DecoderLoop();
+#endif
+
   int m_Segment;
   int m_EventsTotal;
   int m_EventsThisFile;
@@ -37,6 +72,32 @@ class Fun4AllPrdfInputManager : public Fun4AllInputManager
   Eventiterator *m_EventIterator;
   SyncObject *m_SyncObject;
   std::string m_PrdfNodeName;
+  std::set<int> m_DecodePackets;
+  PrdfPacketMap *m_Packets;
+  PrdfPacketMap *m_SavePackets;
+  unsigned int m_PipelineDepth;
+  unsigned int m_NDecoders;
+  unsigned long long m_BytesRead;
+#if !defined(__CINT__) || defined(__CLING__)
+  struct PipelineEvent
+  {
+    Event *event;
+    PrdfPacketMap *packets;
+    bool decoded;
+  };
+  //! events read ahead by their sequence number in the file
+  std::map<unsigned long, PipelineEvent> m_Pipeline;
+  //! sequence numbers of the events waiting for a decoder
+  std::deque<unsigned long> m_DecodeQueue;
+  unsigned long m_ReadSequence;
+  unsigned long m_NextSequence;
+  bool m_ReaderDone;
+  bool m_StopPipeline;
+  mutable std::mutex m_PipelineMutex;
+  std::condition_variable m_PipelineCondition;
+  std::thread m_Reader;
+  std::vector<std::thread> m_Decoders;
+#endif
 };
 
 #endif /* FUN4ALL_FUN4ALLPRDFINPUTMANAGER_H */
@@ -18,7 +18,7 @@ class Fun4AllRolloverFileOutStream : public Fun4AllFileOutStream
                                const int offset = 0,
                                const int increment = 1,
                                const std::string &name = "Fun4AllRolloverFileOutStream");
-  virtual ~Fun4AllRolloverFileOutStream() {}
+  virtual ~Fun4AllRolloverFileOutStream() { StopWriter(); }
   int WriteEventOut(Event *evt);
   void identify(std::ostream &os = std::cout) const;
 
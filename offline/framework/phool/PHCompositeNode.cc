@@ -11,13 +11,21 @@
 #include "phool.h"
 #include "phooldefs.h"
 
+#include <atomic>
 #include <iostream>
+#include <utility>
 
 using namespace std;
 
+namespace
+{
+  atomic<unsigned long> treeversion(0);
+}  // namespace
+
 PHCompositeNode::PHCompositeNode(const string& name)
   : PHNode(name, "PHCompositeNode")
   , deleteMe(0)
+  , indexValid(false)
 {
   type = "PHCompositeNode";
 }
@@ -32,10 +40,18 @@ PHCompositeNode::~PHCompositeNode()
   // out of the node list
   deleteMe = 1;
   subNodes.clearAndDestroy();
+  // deleted subnodes do not report back to a node being deleted
+  ++treeversion;
 }
 
 bool PHCompositeNode::addNode(PHNode* newNode)
 {
+  if (isReadOnly())
+  {
+    cout << PHWHERE << "Node " << getName() << " is read only, cannot add "
+         << newNode->getName() << endl;
+    return false;
+  }
   //
   // Check all existing subNodes for name-conflict.
   //
@@ -54,9 +70,63 @@ bool PHCompositeNode::addNode(PHNode* newNode)
   // No conflict, so we can append the new node.
   //
   newNode->setParent(this);
+  invalidateIndex();
   return (subNodes.append(newNode));
 }
 
+PHNode* PHCompositeNode::findNode(const string& name)
+{
+  lock_guard<mutex> lock(indexMutex);
+  if (!indexValid)
+  {
+    nodeIndex.clear();
+    buildIndex(this);
+    indexValid = true;
+  }
+  unordered_map<string, PHNode*>::const_iterator iter = nodeIndex.find(name);
+  if (iter != nodeIndex.end())
+  {
+    return iter->second;
+  }
+  return nullptr;
+}
+
+void PHCompositeNode::buildIndex(PHCompositeNode* node)
+{
+  // depth first in list order, the first node with a given name wins
+  // just like in PHNodeIterator::findFirst()
+  PHPointerListIterator<PHNode> nodeIter(node->subNodes);
+  PHNode* thisNode;
+  while ((thisNode = nodeIter()))
+  {
+    nodeIndex.insert(make_pair(thisNode->getName(), thisNode));
+    if (thisNode->getType() == "PHCompositeNode")
+    {
+      buildIndex(static_cast<PHCompositeNode*>(thisNode));
+    }
+  }
+}
+
+unsigned long PHCompositeNode::structureVersion()
+{
+  return treeversion.load();
+}
+
+void PHCompositeNode::invalidateIndex()
+{
+  ++treeversion;
+  PHCompositeNode* node = this;
+  while (node)
+  {
+    // findNode() of another thread may be rebuilding this index, one lock at a time
+    {
+      lock_guard<mutex> lock(node->indexMutex);
+      node->indexValid = false;
+    }
+    node = static_cast<PHCompositeNode*>(node->getParent());
+  }
+}
+
 void PHCompositeNode::prune()
 {
   PHPointerListIterator<PHNode> nodeIter(subNodes);
@@ -65,6 +135,7 @@ void PHCompositeNode::prune()
   {
     if (!thisNode->isPersistent())
     {
+      invalidateIndex();
       subNodes.removeAt(nodeIter.pos());
       --nodeIter;
       delete thisNode;
@@ -92,6 +163,7 @@ void PHCompositeNode::forgetMe(PHNode* child)
   {
     if (thisNode == child)
     {
+      invalidateIndex();
       subNodes.removeAt(nodeIter.pos());
       child = 0;
     }
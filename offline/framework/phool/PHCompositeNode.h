@@ -8,6 +8,11 @@
 #include "PHPointerList.h"
 
 #include <string>
+#include <unordered_map>
+
+#if !defined(__CINT__) || defined(__CLING__)
+#include <mutex>
+#endif
 
 class PHIOManager;
 
@@ -37,10 +42,31 @@ class PHCompositeNode : public PHNode
   void print(const std::string & = "");
   virtual bool write(PHIOManager *, const std::string & = "");
 
+  //
+  // Find a node by name anywhere below this node, same result as
+  // PHNodeIterator::findFirst(name) but through a hashed name index
+  // which is built on first use and dropped when the tree below changes
+  //
+  PHNode *findNode(const std::string &name);
+
+  // drop the name index of this node and all its parents
+  void invalidateIndex();
+
+  // changes whenever a node is added to or removed from any node tree,
+  // lets users cache lists of nodes
+  static unsigned long structureVersion();
+
  protected:
   virtual void forgetMe(PHNode *);
+  void buildIndex(PHCompositeNode *node);
   PHPointerList<PHNode> subNodes;
   int deleteMe;
+  bool indexValid;
+  std::unordered_map<std::string, PHNode *> nodeIndex;
+#if !defined(__CINT__) || defined(__CLING__)
+  // modules running concurrently may look up nodes at the same time
+  std::mutex indexMutex;
+#endif
 
  private:
   PHCompositeNode() = delete;
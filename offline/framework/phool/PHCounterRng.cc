@@ -0,0 +1,264 @@
+#include "PHCounterRng.h"
+#include "PHRandomSeed.h"
+
+#include <cmath>
+#include <cstdlib>
+
+using namespace std;
+
+int PHCounterRng::s_Run(0);
+uint64_t PHCounterRng::s_Event(0);
+uint64_t PHCounterRng::s_Generation(1);
+
+static unsigned int fMasterSeed(0);
+static bool fMasterSeedSet(false);
+
+namespace
+{
+  const uint32_t kPhiloxM0 = 0xD2511F53;
+  const uint32_t kPhiloxM1 = 0xCD9E8D57;
+  const uint32_t kPhiloxW0 = 0x9E3779B9;
+  const uint32_t kPhiloxW1 = 0xBB67AE85;
+  const double kTwoPiRng = 6.283185307179586476925286766559;
+
+  inline void PhiloxRound(uint32_t *ctr, const uint32_t *key)
+  {
+    const uint64_t p0 = static_cast<uint64_t>(kPhiloxM0) * ctr[0];
+    const uint64_t p1 = static_cast<uint64_t>(kPhiloxM1) * ctr[2];
+    const uint32_t c1 = ctr[1];
+    const uint32_t c3 = ctr[3];
+    ctr[0] = static_cast<uint32_t>(p1 >> 32) ^ c1 ^ key[0];
+    ctr[1] = static_cast<uint32_t>(p1);
+    ctr[2] = static_cast<uint32_t>(p0 >> 32) ^ c3 ^ key[1];
+    ctr[3] = static_cast<uint32_t>(p0);
+  }
+
+  // 53 bit double in [0,1) from two 32 bit words
+  inline double ToUniform(const uint32_t hi, const uint32_t lo)
+  {
+    return static_cast<double>(((static_cast<uint64_t>(hi) << 32) | lo) >> 11) * (1.0 / 9007199254740992.0);
+  }
+
+  inline uint64_t SplitMix(uint64_t z)
+  {
+    z += 0x9E3779B97F4A7C15ULL;
+    z = (z ^ (z >> 30)) * 0xBF58476D1CE4E5B9ULL;
+    z = (z ^ (z >> 27)) * 0x94D049BB133111EBULL;
+    return z ^ (z >> 31);
+  }
+
+  // gsl_rng interface, the state is just the owning stream
+  struct GslState
+  {
+    PHCounterRng *rng;
+  };
+
+  void gsl_philox_set(void *state, unsigned long int seed)
+  {
+    static_cast<GslState *>(state)->rng->Seed(static_cast<unsigned int>(seed));
+  }
+
+  unsigned long int gsl_philox_get(void *state)
+  {
+    return static_cast<GslState *>(state)->rng->Get();
+  }
+
+  double gsl_philox_get_double(void *state)
+  {
+    return static_cast<GslState *>(state)->rng->Uniform();
+  }
+
+  const gsl_rng_type gsl_rng_philox4x32 = {"philox4x32", 0xffffffffUL, 0, sizeof(GslState), &gsl_philox_set, &gsl_philox_get, &gsl_philox_get_double};
+}  // namespace
+
+PHCounterRng::PHCounterRng(const string &module, const unsigned int stream)
+  : m_Module(module)
+  , m_Stream(stream)
+  , m_Generation(0)
+  , m_Word(0)
+  , m_CachedBlock(~0ULL)
+  , m_GslRng(nullptr)
+{
+  if (!fMasterSeedSet)
+  {
+    MasterSeed(PHRandomSeed());
+  }
+  SetKey(fMasterSeed);
+}
+
+PHCounterRng::~PHCounterRng()
+{
+  if (m_GslRng)
+  {
+    // allocated by hand, gsl_rng_free would not know the state
+    free(m_GslRng->state);
+    free(m_GslRng);
+  }
+}
+
+void PHCounterRng::SetEvent(const int run, const uint64_t event)
+{
+  s_Run = run;
+  s_Event = event;
+  s_Generation++;
+}
+
+void PHCounterRng::MasterSeed(const unsigned int seed)
+{
+  fMasterSeed = seed;
+  fMasterSeedSet = true;
+}
+
+void PHCounterRng::Seed(const unsigned int seed)
+{
+  SetKey(seed);
+}
+
+void PHCounterRng::SetKey(const unsigned int seed)
+{
+  // FNV-1a of the module name, mixed with seed and stream
+  uint64_t h = 0xCBF29CE484222325ULL;
+  for (string::const_iterator iter = m_Module.begin(); iter != m_Module.end(); ++iter)
+  {
+    h ^= static_cast<unsigned char>(*iter);
+    h *= 0x100000001B3ULL;
+  }
+  h = SplitMix(h ^ SplitMix((static_cast<uint64_t>(m_Stream) << 32) | seed));
+  m_Key[0] = static_cast<uint32_t>(h);
+  m_Key[1] = static_cast<uint32_t>(h >> 32);
+  // a new key restarts the stream
+  m_Word = 0;
+  m_CachedBlock = ~0ULL;
+  m_Generation = s_Generation;
+}
+
+void PHCounterRng::Sync()
+{
+  if (m_Generation != s_Generation)
+  {
+    m_Generation = s_Generation;
+    m_Word = 0;
+    m_CachedBlock = ~0ULL;
+  }
+}
+
+void PHCounterRng::Block(const uint64_t block, uint32_t *out) const
+{
+  out[0] = static_cast<uint32_t>(block);
+  out[1] = static_cast<uint32_t>(block >> 32);
+  out[2] = static_cast<uint32_t>(s_Event);
+  out[3] = static_cast<uint32_t>(s_Run);
+  uint32_t key[2] = {m_Key[0], m_Key[1]};
+  for (int i = 0; i < 9; i++)
+  {
+    PhiloxRound(out, key);
+    key[0] += kPhiloxW0;
+    key[1] += kPhiloxW1;
+  }
+  PhiloxRound(out, key);
+}
+
+uint32_t PHCounterRng::Get()
+{
+  Sync();
+  const uint64_t block = m_Word >> 2;
+  if (block != m_CachedBlock)
+  {
+    Block(block, m_Cache);
+    m_CachedBlock = block;
+  }
+  return m_Cache[m_Word++ & 3];
+}
+
+double PHCounterRng::Uniform()
+{
+  Sync();
+  // doubles start on even words so they line up with UniformAt
+  m_Word += (m_Word & 1);
+  const uint32_t hi = Get();
+  return ToUniform(hi, Get());
+}
+
+void PHCounterRng::Uniform(double *out, const unsigned int n)
+{
+  Sync();
+  m_Word += (m_Word & 1);
+  UniformAt(m_Word >> 1, out, n);
+  m_Word += 2 * static_cast<uint64_t>(n);
+}
+
+void PHCounterRng::UniformAt(const uint64_t first, double *out, const unsigned int n) const
+{
+  uint32_t words[4];
+  unsigned int i = 0;
+  // two doubles per block, the first one may sit in the upper half
+  if (n > 0 && (first & 1))
+  {
+    Block(first >> 1, words);
+    out[i++] = ToUniform(words[2], words[3]);
+  }
+  for (; i + 1 < n; i += 2)
+  {
+    Block((first + i) >> 1, words);
+    out[i] = ToUniform(words[0], words[1]);
+    out[i + 1] = ToUniform(words[2], words[3]);
+  }
+  if (i < n)
+  {
+    Block((first + i) >> 1, words);
+    out[i] = ToUniform(words[0], words[1]);
+  }
+}
+
+void PHCounterRng::Gaus(double *out, const unsigned int n, const double sigma)
+{
+  Uniform(out, n);
+  unsigned int i = 0;
+  for (; i + 1 < n; i += 2)
+  {
+    // 1-u is in (0,1], fine for the log
+    const double r = sigma * sqrt(-2. * log(1. - out[i]));
+    const double phi = kTwoPiRng * out[i + 1];
+    out[i] = r * cos(phi);
+    out[i + 1] = r * sin(phi);
+  }
+  if (i < n)
+  {
+    const double r = sigma * sqrt(-2. * log(1. - out[i]));
+    out[i] = r * cos(kTwoPiRng * Uniform());
+  }
+}
+
+void PHCounterRng::GausAt(const uint64_t first, double *out, const unsigned int n, const double sigma) const
+{
+  UniformAt(first, out, n);
+  unsigned int i = 0;
+  for (; i + 1 < n; i += 2)
+  {
+    const double r = sigma * sqrt(-2. * log(1. - out[i]));
+    const double phi = kTwoPiRng * out[i + 1];
+    out[i] = r * cos(phi);
+    out[i + 1] = r * sin(phi);
+  }
+  if (i < n)
+  {
+    double u;
+    UniformAt(first + n, &u, 1);
+    const double r = sigma * sqrt(-2. * log(1. - out[i]));
+    out[i] = r * cos(kTwoPiRng * u);
+  }
+}
+
+gsl_rng *PHCounterRng::get_gsl_rng()
+{
+  if (!m_GslRng)
+  {
+    // not gsl_rng_alloc(), that one seeds the state before we can set the owner
+    m_GslRng = static_cast<gsl_rng *>(malloc(sizeof(gsl_rng)));
+    m_GslRng->type = &gsl_rng_philox4x32;
+    GslState *state = static_cast<GslState *>(malloc(sizeof(GslState)));
+    state->rng = this;
+    m_GslRng->state = state;
+  }
+  return m_GslRng;
+}
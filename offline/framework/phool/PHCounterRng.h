@@ -0,0 +1,81 @@
+// Tell emacs that this is a C++ source
+//  -*- C++ -*-.
+#ifndef PHOOL_PHCOUNTERRNG_H
+#define PHOOL_PHCOUNTERRNG_H
+
+#include <gsl/gsl_rng.h>
+
+#include <cstdint>
+#include <string>
+
+/*!
+ * \brief counter based random number streams (Philox4x32-10)
+ *
+ * Every stream is keyed by (master seed, module name, stream number) and the
+ * counter is (draw index, event, run). The numbers of an event therefore do
+ * not depend on which modules ran before or how many numbers they used, and
+ * the n-th number of an event can be computed directly (UniformAt), so batched
+ * or threaded kernels give the same result for any number of threads.
+ *
+ * The master seed is taken once from PHRandomSeed (fixed with the RANDOMSEED
+ * flag), Fun4AllServer sets the run and event before every event. Modules which
+ * use the gsl_ran_* distributions can get a gsl_rng running on this stream:
+ *
+ *   m_Rng = new PHCounterRng(Name());
+ *   RandomGenerator = m_Rng->get_gsl_rng();
+ */
+class PHCounterRng
+{
+ public:
+  explicit PHCounterRng(const std::string &module, const unsigned int stream = 0);
+  virtual ~PHCounterRng();
+
+  //! restarts all streams for a new event, called by Fun4AllServer
+  static void SetEvent(const int run, const uint64_t event);
+  //! overrides the master seed of all streams created afterwards
+  static void MasterSeed(const unsigned int seed);
+
+  //! replaces the master seed by a seed of this stream only (set_seed() of the modules)
+  void Seed(const unsigned int seed);
+
+  //! next 32 bit random number
+  uint32_t Get();
+  //! uniform in [0,1), 53 bit precision
+  double Uniform();
+  //! n uniforms in [0,1), same numbers as n calls of Uniform()
+  void Uniform(double *out, const unsigned int n);
+  //! n gaussians with mean 0 (Box-Muller)
+  void Gaus(double *out, const unsigned int n, const double sigma = 1.);
+  //! the uniforms with index first ... first+n-1 of this event, does not move the stream
+  void UniformAt(const uint64_t first, double *out, const unsigned int n) const;
+  //! n gaussians from the uniforms with index first ... first+n-1 (first+n for odd n), does not move the stream
+  void GausAt(const uint64_t first, double *out, const unsigned int n, const double sigma = 1.) const;
+
+  //! a gsl_rng drawing from this stream, owned by this object - do not gsl_rng_free() it
+  gsl_rng *get_gsl_rng();
+
+  const std::string &Module() const { return m_Module; }
+  unsigned int Stream() const { return m_Stream; }
+
+ private:
+  void SetKey(const unsigned int seed);
+  void Sync();
+  void Block(const uint64_t block, uint32_t *out) const;
+
+  std::string m_Module;
+  unsigned int m_Stream;
+  uint32_t m_Key[2];
+  //! event generation this stream was last used in
+  uint64_t m_Generation;
+  //! next 32 bit word of the event
+  uint64_t m_Word;
+  uint64_t m_CachedBlock;
+  uint32_t m_Cache[4];
+  gsl_rng *m_GslRng;
+
+  static int s_Run;
+  static uint64_t s_Event;
+  static uint64_t s_Generation;
+};
+
+#endif
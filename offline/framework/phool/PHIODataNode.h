@@ -27,6 +27,8 @@ class PHIODataNode : public PHDataNode<T>
   typedef PHTypedNodeIterator<T> iterator;
   void BufferSize(int size) {buffersize = size;}
   void SplitLevel(int split) {splitlevel = split;}
+  int BufferSize() const {return buffersize;}
+  int SplitLevel() const {return splitlevel;}
 
  protected:
   virtual bool write(PHIOManager *, const std::string & = "");
@@ -63,6 +65,8 @@ bool PHIODataNode<T>::write(PHIOManager *IOManager, const std::string &path)
 {
   if (this->persistent)
   {
+    // do not write stale contents of a lazily loaded input node
+    this->loadDeferred();
     PHNodeIOManager *np = dynamic_cast<PHNodeIOManager *>(IOManager);
     if (np)
     {
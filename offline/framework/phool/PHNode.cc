@@ -2,16 +2,25 @@
 
 #include "PHNode.h"
 
+#include "PHCompositeNode.h"
 #include "phool.h"
 
+#include <TBranch.h>
 #include <TSystem.h>
 
 #include <boost/stacktrace.hpp>
 
 #include <iostream>
+#include <mutex>
 
 using namespace std;
 
+namespace
+{
+  // modules running concurrently may access the same deferred node
+  mutex deferredmutex;
+}  // namespace
+
 PHNode::PHNode(const string& n)
   : PHNode(n, "")
 {
@@ -23,6 +32,9 @@ PHNode::PHNode(const string& n, const string& typ)
   , type("PHNode")
   , objecttype(typ)
   , reset_able(true)
+  , readonly(false)
+  , deferredbranch(nullptr)
+  , deferredentry(0)
 {
   int badnode = 0;
   if (n.find(".") != string::npos)
@@ -52,6 +64,16 @@ PHNode::PHNode(const string& n, const string& typ)
   return;
 }
 
+void PHNode::setName(const string& n)
+{
+  name = n;
+  // the name index of the parents is keyed by name
+  if (parent)
+  {
+    static_cast<PHCompositeNode*>(parent)->invalidateIndex();
+  }
+}
+
 PHNode::~PHNode()
 {
   if (parent)
@@ -60,6 +82,27 @@ PHNode::~PHNode()
   }
 }
 
+void PHNode::deferLoad(TBranch* branch, const long long entry)
+{
+  lock_guard<mutex> lock(deferredmutex);
+  deferredentry = entry;
+  deferredbranch = branch;
+}
+
+void PHNode::loadDeferredBranch()
+{
+  lock_guard<mutex> lock(deferredmutex);
+  TBranch* branch = deferredbranch.load();
+  if (branch)
+  {
+    if (branch->GetEntry(deferredentry) < 0)
+    {
+      cout << PHWHERE << " error reading " << branch->GetName() << " for node " << name << endl;
+    }
+    deferredbranch = nullptr;
+  }
+}
+
 // Implementation of external functions.
 std::ostream&
 operator<<(std::ostream& stream, const PHNode& node)
@@ -7,7 +7,12 @@
 #include <iosfwd>
 #include <string>
 
+#if !defined(__CINT__) || defined(__CLING__)
+#include <atomic>
+#endif
+
 class PHIOManager;
+class TBranch;
 
 class PHNode
 {
@@ -26,7 +31,7 @@ class PHNode
   const std::string getName() const { return name; }
   const std::string getClass() const { return objectclass; }
   void setParent(PHNode *p) { parent = p; }
-  void setName(const std::string &n) { name = n; }
+  void setName(const std::string &n);
   void setObjectType(const std::string &type) { objecttype = type; }
   virtual void prune() = 0;
   virtual void print(const std::string &) = 0;
@@ -37,6 +42,23 @@ class PHNode
   virtual bool getResetFlag() const { return reset_able; }
   void makeTransient() { persistent = false; }
 
+  //! no nodes can be added below read only nodes and they are not reset
+  bool isReadOnly() const { return readonly; }
+  void makeReadOnly(const bool b = true) { readonly = b; }
+
+  //! the object of this node is read from branch the first time it is accessed (nullptr: nothing pending)
+  void deferLoad(TBranch *branch, const long long entry);
+  //! read the object if its loading was deferred, done by findNode::getClass
+  void loadDeferred()
+  {
+#if !defined(__CINT__) || defined(__CLING__)
+    if (deferredbranch.load())
+    {
+      loadDeferredBranch();
+    }
+#endif
+  }
+
  protected:
   PHNode *parent;
   bool persistent;
@@ -44,9 +66,17 @@ class PHNode
   std::string objecttype;
   std::string name;
   bool reset_able;
+  bool readonly;
   std::string objectclass;
 
  private:
+  void loadDeferredBranch();
+
+#if !defined(__CINT__) || defined(__CLING__)
+  std::atomic<TBranch *> deferredbranch;
+#endif
+  long long deferredentry;
+
   PHNode() = delete;
   PHNode(const PHNode &) = delete;
   PHNode &operator=(const PHNode &) = delete;
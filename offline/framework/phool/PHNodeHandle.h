@@ -0,0 +1,98 @@
+#ifndef PHOOL_PHNODEHANDLE_H
+#define PHOOL_PHNODEHANDLE_H
+
+//  Declaration of class template PHNodeHandle
+//  Purpose: typed reference to a data node which is looked up once
+//
+//  findNode::getClass() searches the node tree on every call. A module
+//  can instead resolve a handle in InitRun and use it in every event:
+//
+//    m_Hits = findNode::getHandle<PHG4HitContainer>(topNode, "G4HIT_SVTX");
+//    ...
+//    PHG4HitContainer *hits = m_Hits.get();
+//
+//  get() only goes back to the node for the current object pointer and
+//  redoes the cast if a different object was put into the node. The
+//  handle does not own anything, it must not be used after the node is
+//  deleted (resolve it again in InitRun).
+
+#include "PHDataNode.h"
+#include "PHNode.h"
+#include "PHNodeIterator.h"
+#include "getClass.h"
+
+#include <TObject.h>
+
+#include <string>
+
+class PHCompositeNode;
+
+template <class T>
+class PHNodeHandle
+{
+ public:
+  PHNodeHandle()
+    : m_Node(nullptr)
+    , m_Data(nullptr)
+    , m_Object(nullptr)
+  {
+  }
+  explicit PHNodeHandle(PHNode *node)
+    : m_Node(node)
+    , m_Data(nullptr)
+    , m_Object(nullptr)
+  {
+  }
+
+  //! look up the node, returns false if there is no such node
+  bool resolve(PHCompositeNode *top, const std::string &name)
+  {
+    PHNodeIterator iter(top);
+    m_Node = iter.findFirst(name);
+    if (m_Node && m_Node->getType() == "PHCompositeNode")
+    {
+      m_Node = nullptr;
+    }
+    m_Data = nullptr;
+    m_Object = nullptr;
+    return (m_Node != nullptr);
+  }
+
+  T *get()
+  {
+    if (!m_Node)
+    {
+      return nullptr;
+    }
+    // all data nodes keep their payload in the same pointer slot
+    TObject *data = static_cast<PHDataNode<TObject> *>(m_Node)->getData();
+    if (data != m_Data || !m_Object)
+    {
+      m_Data = data;
+      m_Object = findNode::getClass<T>(m_Node);
+    }
+    return m_Object;
+  }
+
+  T *operator->() { return get(); }
+  PHNode *node() const { return m_Node; }
+  bool valid() const { return (m_Node != nullptr); }
+
+ private:
+  PHNode *m_Node;
+  TObject *m_Data;
+  T *m_Object;
+};
+
+namespace findNode
+{
+template <class T>
+PHNodeHandle<T> getHandle(PHCompositeNode *top, const std::string &name)
+{
+  PHNodeHandle<T> handle;
+  handle.resolve(top, name);
+  return handle;
+}
+}  // namespace findNode
+
+#endif
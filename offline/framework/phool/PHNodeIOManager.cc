@@ -13,6 +13,7 @@
 #include <TClass.h>
 #include <TDirectory.h>                                      // for TDirectory
 #include <TFile.h>
+#include <TLeaf.h>
 #include <TLeafObject.h>
 #include <TObject.h>
 #include <TObjArray.h>                                       // for TObjArray
@@ -26,8 +27,11 @@
 
 #include <boost/algorithm/string.hpp>
 
+#include <algorithm>
 #include <cassert>
+#include <chrono>
 #include <cstdlib>
+#include <iomanip>
 #include <iostream>
 #include <sstream>
 #include <string>
@@ -42,6 +46,14 @@ PHNodeIOManager::PHNodeIOManager()
   , TreeName("T")
   , accessMode(PHReadOnly)
   , CompressionLevel(3)
+  , CompressionAlgorithm(0)
+  , AutoFlush(0)
+  , FillTime(0)
+  , BytesUnzipped(0)
+  , CacheSize(-1)
+  , ParallelUnzip(false)
+  , LazyLoading(false)
+  , LeafMode(false)
   , isFunctionalFlag(0)
 {
 }
@@ -52,6 +64,14 @@ PHNodeIOManager::PHNodeIOManager(const string& f,
   , tree(nullptr)
   , TreeName("T")
   , CompressionLevel(3)
+  , CompressionAlgorithm(0)
+  , AutoFlush(0)
+  , FillTime(0)
+  , BytesUnzipped(0)
+  , CacheSize(-1)
+  , ParallelUnzip(false)
+  , LazyLoading(false)
+  , LeafMode(false)
 {
   isFunctionalFlag = setFile(f, "titled by PHOOL", a) ? 1 : 0;
 }
@@ -62,6 +82,14 @@ PHNodeIOManager::PHNodeIOManager(const string& f, const string& title,
   , tree(nullptr)
   , TreeName("T")
   , CompressionLevel(3)
+  , CompressionAlgorithm(0)
+  , AutoFlush(0)
+  , FillTime(0)
+  , BytesUnzipped(0)
+  , CacheSize(-1)
+  , ParallelUnzip(false)
+  , LazyLoading(false)
+  , LeafMode(false)
 {
   isFunctionalFlag = setFile(f, title, a) ? 1 : 0;
 }
@@ -72,6 +100,14 @@ PHNodeIOManager::PHNodeIOManager(const string& f, const PHAccessType a,
   , tree(nullptr)
   , TreeName("T")
   , CompressionLevel(3)
+  , CompressionAlgorithm(0)
+  , AutoFlush(0)
+  , FillTime(0)
+  , BytesUnzipped(0)
+  , CacheSize(-1)
+  , ParallelUnzip(false)
+  , LazyLoading(false)
+  , LeafMode(false)
 {
   if (treeindex != PHEventTree)
   {
@@ -84,6 +120,7 @@ PHNodeIOManager::PHNodeIOManager(const string& f, const PHAccessType a,
 
 PHNodeIOManager::~PHNodeIOManager()
 {
+  clearDeferredLoads();
   closeFile();
   delete file;
 }
@@ -114,6 +151,11 @@ bool PHNodeIOManager::setFile(const string& f, const string& title,
     delete file;
     file = 0;
   }
+  clearDeferredLoads();
+  lazyBranches.clear();
+  eagerBranches.clear();
+  LeafMode = false;
+  fLeaves.clear();
   string currdir = gDirectory->GetPath();
   gROOT->cd();
   switch (accessMode)
@@ -125,8 +167,16 @@ bool PHNodeIOManager::setFile(const string& f, const string& title,
       return false;
     }
     file->SetCompressionLevel(CompressionLevel);
+    if (CompressionAlgorithm > 0)
+    {
+      file->SetCompressionAlgorithm(CompressionAlgorithm);
+    }
     tree = new TTree(TreeName.c_str(), title.c_str());
     tree->SetMaxTreeSize(900000000000LL);  // set max size to ~900 GB
+    if (AutoFlush)
+    {
+      tree->SetAutoFlush(AutoFlush);
+    }
     gROOT->cd(currdir.c_str());
     return true;
     break;
@@ -148,7 +198,15 @@ bool PHNodeIOManager::setFile(const string& f, const string& title,
       return false;
     }
     file->SetCompressionLevel(CompressionLevel);
+    if (CompressionAlgorithm > 0)
+    {
+      file->SetCompressionAlgorithm(CompressionAlgorithm);
+    }
     tree = new TTree(TreeName.c_str(), title.c_str());
+    if (AutoFlush)
+    {
+      tree->SetAutoFlush(AutoFlush);
+    }
     gROOT->cd(currdir.c_str());
     return true;
     break;
@@ -170,7 +228,9 @@ bool PHNodeIOManager::write(PHCompositeNode* topNode)
   // be filled.
   if (file && tree)
   {
+    chrono::steady_clock::time_point start = chrono::steady_clock::now();
     tree->Fill();
+    FillTime += chrono::duration<double>(chrono::steady_clock::now() - start).count();
     eventNumber++;
     return true;
   }
@@ -187,9 +247,27 @@ bool PHNodeIOManager::write(TObject** data, const string& path, int buffersize,
     {
       // the buffersize and splitlevel are set on the first call
       // when the branch is created, the values come from the caller
-      // which is the node which writes itself
-      tree->Branch(path.c_str(), (*data)->ClassName(),
-                   data, buffersize, splitlevel);
+      // which is the node which writes itself unless there is an
+      // output policy for this node
+      const BranchPolicy* policy = nullptr;
+      map<string, BranchPolicy>::const_iterator piter = branchPolicies.find(path.substr(path.rfind(phooldefs::branchpathdelim) + 1));
+      if (piter != branchPolicies.end())
+      {
+        policy = &piter->second;
+        if (policy->basketsize > 0)
+        {
+          buffersize = policy->basketsize;
+        }
+      }
+      thisBranch = tree->Branch(path.c_str(), (*data)->ClassName(),
+                                data, buffersize, splitlevel);
+      if (thisBranch && policy && (policy->algorithm > 0 || policy->level >= 0))
+      {
+        // applies to the sub-branches of split objects as well
+        const int algorithm = (policy->algorithm > 0) ? policy->algorithm : file->GetCompressionAlgorithm();
+        const int level = (policy->level >= 0) ? policy->level : file->GetCompressionLevel();
+        thisBranch->SetCompressionSettings(algorithm * 100 + level);
+      }
     }
     else
     {
@@ -201,6 +279,14 @@ bool PHNodeIOManager::write(TObject** data, const string& path, int buffersize,
   return false;
 }
 
+void PHNodeIOManager::ResetBranchAddresses()
+{
+  if (tree)
+  {
+    tree->ResetBranchAddresses();
+  }
+}
+
 bool PHNodeIOManager::read(size_t requestedEvent)
 {
   if (readEventFromFile(requestedEvent))
@@ -315,7 +401,15 @@ bool PHNodeIOManager::readEventFromFile(size_t requestedEvent)
   TFile* file_ptr = gFile;  // save current gFile
   file->cd();
 
-  if (requestedEvent)
+  if (LazyLoading)
+  {
+    bytesRead = readLazy(requestedEvent ? requestedEvent : eventNumber);
+    if (bytesRead)
+    {
+      eventNumber = (requestedEvent ? requestedEvent : eventNumber) + 1;
+    }
+  }
+  else if (requestedEvent)
   {
     if ((bytesRead = tree->GetEvent(requestedEvent)))
     {
@@ -339,6 +433,56 @@ bool PHNodeIOManager::readEventFromFile(size_t requestedEvent)
     cout << PHWHERE << "Error: Input TTree corrupt, exiting now" << endl;
     exit(1);
   }
+  BytesUnzipped += bytesRead;
+  return true;
+}
+
+int PHNodeIOManager::readLazy(const size_t entry)
+{
+  if (static_cast<Long64_t>(entry) >= tree->GetEntries() || tree->LoadTree(entry) < 0)
+  {
+    return 0;
+  }
+  int bytesRead = 0;
+  for (auto branch : eagerBranches)
+  {
+    int nbytes = branch->GetEntry(entry);
+    if (nbytes < 0)
+    {
+      return -1;
+    }
+    bytesRead += nbytes;
+  }
+  for (auto &lazy : lazyBranches)
+  {
+    lazy.second->deferLoad(lazy.first, entry);
+  }
+  // a valid entry, even if nothing was read yet
+  return max(bytesRead, 1);
+}
+
+void PHNodeIOManager::clearDeferredLoads()
+{
+  // the branches go away with the file
+  for (auto &lazy : lazyBranches)
+  {
+    lazy.second->deferLoad(nullptr, 0);
+  }
+}
+
+bool PHNodeIOManager::SetLazyLoading(const bool b)
+{
+  if (accessMode != PHReadOnly)
+  {
+    cout << PHWHERE << " lazy loading only applies to files opened read only" << endl;
+    return false;
+  }
+  if (tree)
+  {
+    cout << PHWHERE << " lazy loading has to be set before the first event of " << filename << " is read" << endl;
+    return false;
+  }
+  LazyLoading = b;
   return true;
 }
 
@@ -366,6 +510,63 @@ int PHNodeIOManager::readSpecific(size_t requestedEvent, const char* objectName)
   return 0;
 }
 
+bool PHNodeIOManager::SetCacheSize(const long size)
+{
+  if (accessMode != PHReadOnly)
+  {
+    cout << PHWHERE << " read cache only applies to files opened read only" << endl;
+    return false;
+  }
+  CacheSize = size;
+  if (tree)
+  {
+    setupReadCache();
+  }
+  return true;
+}
+
+bool PHNodeIOManager::SetParallelUnzip(const bool b)
+{
+  if (accessMode != PHReadOnly)
+  {
+    cout << PHWHERE << " parallel unzipping only applies to files opened read only" << endl;
+    return false;
+  }
+  ParallelUnzip = b;
+  if (tree)
+  {
+    setupReadCache();
+  }
+  return true;
+}
+
+void PHNodeIOManager::setupReadCache()
+{
+  // negative cache size: keep whatever ROOT does by default
+  if (CacheSize < 0 && !ParallelUnzip)
+  {
+    return;
+  }
+  // the unzip cache has to be selected before the cache is created, it
+  // decompresses the baskets of the upcoming entries in a helper thread
+  // while the current event is processed
+  if (ParallelUnzip)
+  {
+    tree->SetParallelUnzip(true);
+  }
+  if (CacheSize >= 0)
+  {
+    tree->SetCacheSize(CacheSize);
+  }
+  // with lazy loading the cache learns which branches are actually used
+  if (CacheSize != 0 && !LazyLoading)
+  {
+    // cache all branches which are switched on, skip the training phase
+    tree->AddBranchToCache("*", true);
+    tree->StopCacheLearningPhase();
+  }
+}
+
 PHCompositeNode*
 PHNodeIOManager::reconstructNodeTree(PHCompositeNode* topNode)
 {
@@ -382,22 +583,16 @@ PHNodeIOManager::reconstructNodeTree(PHCompositeNode* topNode)
     return nullptr;
   }
 
-  tree = static_cast<TTree*>(file->Get(TreeName.c_str()));
-
-  if (!tree)
+  if (LeafMode)
   {
-    cout << PHWHERE << "PHNodeIOManager::reconstructNodeTree : Root Tree "
-         << TreeName << " not found in file " << file->GetName() << endl;
+    cout << PHWHERE << "leaves of " << filename << " were selected for reading, no node tree is created" << endl;
     return nullptr;
   }
 
-  // ROOT sucks, we need a unique name for the tree so we can open multiple
-  // files. So we take the memory location of the file pointer which
-  // should be unique within this process to create it
-  ostringstream nname;
-  nname << TreeName << file;
-
-  tree->SetName(nname.str().c_str());
+  if (!openTree())
+  {
+    return nullptr;
+  }
 
   // Select the branches according to objectToRead
   map<string, bool>::const_iterator it;
@@ -410,6 +605,8 @@ PHNodeIOManager::reconstructNodeTree(PHCompositeNode* topNode)
                             static_cast<bool>(it->second));
     }
   }
+  setupReadCache();
+
   // The file contains a TTree with a list of the TBranchObjects
   // attached to it.
   TObjArray* branchArray = tree->GetListOfBranches();
@@ -510,6 +707,14 @@ PHNodeIOManager::reconstructNodeTree(PHCompositeNode* topNode)
       newIODataNode->setObjectType("PHObject");
     }
     thisBranch->SetAddress(&(newIODataNode->data));
+    if (LazyLoading && eagerNodes.find(*splitvec.rbegin()) == eagerNodes.end())
+    {
+      lazyBranches.push_back(make_pair(thisBranch, static_cast<PHNode*>(newIODataNode)));
+    }
+    else
+    {
+      eagerBranches.push_back(thisBranch);
+    }
     for (j = 1; j < splitvec.size() - 1; j++)
     {
       nodeIter.cd("..");
@@ -518,12 +723,79 @@ PHNodeIOManager::reconstructNodeTree(PHCompositeNode* topNode)
   return topNode;
 }
 
+bool PHNodeIOManager::openTree()
+{
+  tree = static_cast<TTree*>(file->Get(TreeName.c_str()));
+
+  if (!tree)
+  {
+    cout << PHWHERE << "PHNodeIOManager::reconstructNodeTree : Root Tree "
+         << TreeName << " not found in file " << file->GetName() << endl;
+    return false;
+  }
+
+  // ROOT sucks, we need a unique name for the tree so we can open multiple
+  // files. So we take the memory location of the file pointer which
+  // should be unique within this process to create it
+  ostringstream nname;
+  nname << TreeName << file;
+
+  tree->SetName(nname.str().c_str());
+  return true;
+}
+
+int PHNodeIOManager::selectLeaf(const string& leafname)
+{
+  if (accessMode != PHReadOnly || !file)
+  {
+    cout << PHWHERE << " leaves can only be selected in files opened read only" << endl;
+    return -1;
+  }
+  if (!LeafMode)
+  {
+    if (tree)
+    {
+      cout << PHWHERE << " node tree of " << filename << " already read, cannot select leaves" << endl;
+      return -1;
+    }
+    if (!openTree())
+    {
+      return -1;
+    }
+    // only the branches of the selected leaves are read
+    tree->SetBranchStatus("*", false);
+    LeafMode = true;
+  }
+  TLeaf* leaf = tree->FindLeaf(leafname.c_str());
+  if (!leaf)
+  {
+    cout << PHWHERE << " no leaf " << leafname << " in " << filename << endl;
+    return -1;
+  }
+  // this switches on the mother branches of split objects as well
+  tree->SetBranchStatus(leaf->GetBranch()->GetName(), true);
+  fLeaves.push_back(leaf);
+  setupReadCache();
+  return fLeaves.size() - 1;
+}
+
+double PHNodeIOManager::getLeafValue(const int handle, const int index) const
+{
+  return fLeaves[handle]->GetValue(index);
+}
+
+int PHNodeIOManager::getLeafLength(const int handle) const
+{
+  return fLeaves[handle]->GetLen();
+}
+
 void PHNodeIOManager::selectObjectToRead(const char* objectName, bool readit)
 {
   objectToRead[objectName] = readit;
 
   // If tree is already open, loop over map and set branch status
-  if (tree)
+  // (the branches of selected leaves are handled by selectLeaf)
+  if (tree && !LeafMode)
   {
     map<string, bool>::const_iterator it;
 
@@ -564,6 +836,92 @@ bool PHNodeIOManager::SetCompressionLevel(const int level)
   return true;
 }
 
+bool PHNodeIOManager::SetCompressionAlgorithm(const int algorithm)
+{
+  if (algorithm < 0)
+  {
+    return false;
+  }
+  CompressionAlgorithm = algorithm;
+  if (file && CompressionAlgorithm > 0)
+  {
+    file->SetCompressionAlgorithm(CompressionAlgorithm);
+  }
+  return true;
+}
+
+void PHNodeIOManager::SetAutoFlush(const long long autoflush)
+{
+  AutoFlush = autoflush;
+  if (tree && accessMode != PHReadOnly)
+  {
+    tree->SetAutoFlush(AutoFlush);
+  }
+  return;
+}
+
+void PHNodeIOManager::SetBranchPolicy(const string& nodename, const int algorithm, const int level, const int basketsize)
+{
+  BranchPolicy policy;
+  policy.algorithm = algorithm;
+  policy.level = level;
+  policy.basketsize = basketsize;
+  branchPolicies[nodename] = policy;
+  return;
+}
+
+void PHNodeIOManager::PrintBranchStatistics() const
+{
+  if (!tree || accessMode == PHReadOnly)
+  {
+    return;
+  }
+  cout << "PHNodeIOManager " << filename << ": " << tree->GetEntries() << " entries, "
+       << FillTime << " s in TTree::Fill" << endl;
+  cout << setw(50) << left << "branch" << right
+       << setw(10) << "basket" << setw(10) << "compress"
+       << setw(14) << "bytes" << setw(14) << "zipped" << setw(8) << "ratio" << endl;
+  streamsize oldprecision = cout.precision(3);
+  Long64_t totbytes = 0;
+  Long64_t zipbytes = 0;
+  TObjArray* branchArray = tree->GetListOfBranches();
+  for (int i = 0; i < branchArray->GetEntriesFast(); i++)
+  {
+    TBranch* branch = static_cast<TBranch*>(branchArray->At(i));
+    // includes the sub-branches of split objects
+    Long64_t bytes = branch->GetTotBytes("*");
+    Long64_t zipped = branch->GetZipBytes("*");
+    totbytes += bytes;
+    zipbytes += zipped;
+    cout << setw(50) << left << branch->GetName() << right
+         << setw(10) << branch->GetBasketSize() << setw(10) << branch->GetCompressionSettings()
+         << setw(14) << bytes << setw(14) << zipped
+         << setw(8) << ((zipped > 0) ? static_cast<double>(bytes) / zipped : 0.) << endl;
+  }
+  cout << setw(50) << left << "total" << right << setw(34) << totbytes << setw(14) << zipbytes
+       << setw(8) << ((zipbytes > 0) ? static_cast<double>(totbytes) / zipbytes : 0.) << endl;
+  cout.precision(oldprecision);
+  return;
+}
+
+long long PHNodeIOManager::GetEntries()
+{
+  if (tree)
+  {
+    return tree->GetEntries();
+  }
+  if (!file)
+  {
+    return -1;
+  }
+  TTree* treetmp = static_cast<TTree*>(file->Get(TreeName.c_str()));
+  if (!treetmp)
+  {
+    return -1;
+  }
+  return treetmp->GetEntries();
+}
+
 double
 PHNodeIOManager::GetBytesWritten()
 {
@@ -571,6 +929,13 @@ PHNodeIOManager::GetBytesWritten()
   return 0.;
 }
 
+double
+PHNodeIOManager::GetBytesRead() const
+{
+  if (file) return file->GetBytesRead();
+  return 0.;
+}
+
 map<string, TBranch*>*
 PHNodeIOManager::GetBranchMap()
 {
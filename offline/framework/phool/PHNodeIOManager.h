@@ -11,11 +11,16 @@
 
 #include <cstddef>
 #include <map>
+#include <set>
 #include <string>
+#include <utility>
+#include <vector>
 
 class PHCompositeNode;
+class PHNode;
 class TBranch;
 class TFile;
+class TLeaf;
 class TObject;
 class TTree;
 
@@ -39,25 +44,100 @@ class PHNodeIOManager : public PHIOManager
   void selectObjectToRead(const char *objectName, bool readit);
   bool isSelected(const char *objectName);
   int isFunctional() const { return isFunctionalFlag; }
+  //! number of entries in the tree of the file, -1 if there is none
+  long long GetEntries();
   bool SetCompressionLevel(const int level);
+  //! file wide compression algorithm (ROOT::RCompressionSetting::EAlgorithm: 1 zlib, 2 lzma, 4 lz4, 5 zstd)
+  bool SetCompressionAlgorithm(const int algorithm);
+  //! entries (positive) or bytes (negative) between basket flushes of the output tree
+  void SetAutoFlush(const long long autoflush);
+  /*!
+    \brief output settings for the branch of one node, applied when the branch
+    is created. algorithm 0 and level -1 keep the file setting, basketsize 0
+    keeps the buffer size of the node
+  */
+  void SetBranchPolicy(const std::string &nodename, const int algorithm, const int level, const int basketsize);
+  //! uncompressed and compressed bytes and the compression ratio of every output branch
+  void PrintBranchStatistics() const;
+  //! size of the TTreeCache in bytes for reading (0 disables it, negative: ROOT default)
+  bool SetCacheSize(const long size);
+  long GetCacheSize() const { return CacheSize; }
+  //! decompress the baskets of the next entries in a background thread
+  bool SetParallelUnzip(const bool b);
+  /*!
+    \brief read the object of a node only when it is accessed via
+    findNode::getClass in the current event. Has to be set before the
+    first read, modules which keep pointers to input objects across
+    events need their nodes read eagerly
+  */
+  bool SetLazyLoading(const bool b);
+  //! node which is read in every event even with lazy loading
+  void readEagerly(const std::string &nodename) { eagerNodes.insert(nodename); }
   double GetBytesWritten();
+  //! compressed bytes read from the file, including the read cache
+  double GetBytesRead() const;
+  //! uncompressed bytes of the entries read so far (eager branches only with lazy loading)
+  double GetBytesUnzipped() const { return BytesUnzipped; }
+  //! detach the output tree from the objects written last
+  void ResetBranchAddresses();
   std::map<std::string, TBranch *> *GetBranchMap();
 
+  /*!
+    \brief read only access to single data members of split objects.
+    Only the branches of the selected leaves (branch name.data member)
+    are read by read(size_t), no node tree and no objects are created, the
+    values are taken from the leaf buffers. Cannot be mixed with
+    read(PHCompositeNode *). Returns a handle for getLeafValue, -1 if the
+    leaf does not exist
+  */
+  int selectLeaf(const std::string &leafname);
+  double getLeafValue(const int handle, const int index = 0) const;
+  //! number of values of the leaf in the current entry (arrays, STL containers)
+  int getLeafLength(const int handle) const;
+
   bool write(TObject **, const std::string &, int buffersize, int splitlevel);
 
  private:
+  struct BranchPolicy
+  {
+    int algorithm;
+    int level;
+    int basketsize;
+  };
+
   int FillBranchMap();
+  bool openTree();
   PHCompositeNode *reconstructNodeTree(PHCompositeNode *);
   bool readEventFromFile(size_t requestedEvent);
+  //! reads the eager branches and defers the others, 0 past the last entry
+  int readLazy(const size_t entry);
+  void clearDeferredLoads();
   std::string getBranchClassName(TBranch *);
+  void setupReadCache();
 
   TFile *file;
   TTree *tree;
   std::string TreeName;
   int accessMode;
   int CompressionLevel;
+  int CompressionAlgorithm;
+  long long AutoFlush;
+  //! total time spent in TTree::Fill in seconds
+  double FillTime;
+  double BytesUnzipped;
+  long CacheSize;
+  bool ParallelUnzip;
+  bool LazyLoading;
+  bool LeafMode;
+  std::vector<TLeaf *> fLeaves;
   std::map<std::string, TBranch *> fBranches;
   std::map<std::string, bool> objectToRead;
+  std::set<std::string> eagerNodes;
+  //! branches read on access and their nodes, branches read in every event
+  std::vector<std::pair<TBranch *, PHNode *> > lazyBranches;
+  std::vector<TBranch *> eagerBranches;
+  //! output settings by node name
+  std::map<std::string, BranchPolicy> branchPolicies;
 
   int isFunctionalFlag;  // flag to tell if that object initialized properly
 };
@@ -77,28 +77,7 @@ PHNodeIterator::findFirst(const string& requiredType, const string& requiredName
 PHNode*
 PHNodeIterator::findFirst(const string& requiredName)
 {
-  PHPointerListIterator<PHNode> iter(currentNode->subNodes);
-  PHNode* thisNode;
-  while ((thisNode = iter()))
-  {
-    if (thisNode->getName() == requiredName)
-    {
-      return thisNode;
-    }
-    else
-    {
-      if (thisNode->getType() == "PHCompositeNode")
-      {
-        PHNodeIterator nodeIter(static_cast<PHCompositeNode*>(thisNode));
-        PHNode* nodeFoundInSubTree = nodeIter.findFirst(requiredName.c_str());
-        if (nodeFoundInSubTree)
-        {
-          return nodeFoundInSubTree;
-        }
-      }
-    }
-  }
-  return 0;
+  return currentNode->findNode(requiredName);
 }
 
 bool PHNodeIterator::cd(const string& pathString)
@@ -15,15 +15,20 @@ using namespace std;
 void PHNodeReset::perform(PHNode* node)
 {
   if (node->getResetFlag() != true) return;
+  // read only nodes keep their content
+  if (node->isReadOnly()) return;
   if (verbosity > 0)
   {
     cout << "PHNodeReset: Resetting " << node->getName() << endl;
   }
-  if (node->getType() == "PHDataNode" || node->getType() == "PHIODataNode")
+  if (isResettable(node))
   {
-    if (node->getObjectType() == "PHObject")
-    {
-      (static_cast<PHDataNode<PHObject>*>(node))->getData()->Reset();
-    }
+    (static_cast<PHDataNode<PHObject>*>(node))->getData()->Reset();
   }
 }
+
+bool PHNodeReset::isResettable(PHNode* node)
+{
+  return (node->getType() == "PHDataNode" || node->getType() == "PHIODataNode") &&
+         node->getObjectType() == "PHObject";
+}
@@ -15,6 +15,9 @@ class PHNodeReset : public PHNodeOperation
   PHNodeReset() {}
   virtual ~PHNodeReset() {}
 
+  //! true if perform() resets the object of this node (ignoring the reset flag)
+  static bool isResettable(PHNode *);
+
  protected:
   virtual void perform(PHNode*);
 };
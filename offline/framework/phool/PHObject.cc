@@ -2,9 +2,12 @@
 
 #include "phool.h"
 
+#include <TBufferFile.h>
+#include <TClass.h>
 #include <TSystem.h>
 
 #include <iostream>
+#include <typeinfo>
 
 class TObject;
 
@@ -16,6 +19,22 @@ PHObject::CloneMe() const
   return nullptr;
 }
 
+PHObject*
+PHObject::StreamCopy() const
+{
+  // a class without its own ClassDef would be streamed as its base class
+  TClass* cl = IsA();
+  if (!cl || !cl->GetTypeInfo() || *cl->GetTypeInfo() != typeid(*this) || cl->GetClassVersion() < 1)
+  {
+    return nullptr;
+  }
+  TBufferFile buffer(TBuffer::kWrite);
+  buffer.WriteObject(this);
+  buffer.SetReadMode();
+  buffer.SetBufferOffset(0);
+  return dynamic_cast<PHObject*>(buffer.ReadObject(cl));
+}
+
 PHObject*
 PHObject::clone() const
 {
@@ -20,6 +20,9 @@ class PHObject : public TObject
   virtual ~PHObject() {}
   /// Virtual copy constructor.
   virtual PHObject* CloneMe() const;
+  /// Deep copy through the ROOT streamer, the copy has exactly the state
+  /// which would be written out. nullptr if the class has no I/O
+  PHObject* StreamCopy() const;
 
 #if !defined(__CINT__) || defined(__CLING__)
   virtual PHObject* clone() const final;
@@ -0,0 +1,178 @@
+#ifndef PHOOL_PHOBJECTPOOL_H
+#define PHOOL_PHOBJECTPOOL_H
+
+//  Declaration of class template PHObjectPool
+//  Purpose: recycle the storage of small objects which are created and
+//           deleted in large numbers in every event (hits, clusters).
+//
+//  A class uses the pool by declaring its own allocation functions and
+//  forwarding them to the pool (in the .cc file, where T is complete):
+//
+//    void *TpcHit::operator new(size_t size)
+//    { return PHObjectPool<TpcHit>::allocate(size); }
+//    void TpcHit::operator delete(void *ptr, size_t size)
+//    { PHObjectPool<TpcHit>::deallocate(ptr, size); }
+//
+//  Storage is carved out of large chunks, a deleted object goes onto a
+//  free list and is handed out again by the next new. After the first
+//  event the containers' Reset() (called via Fun4AllServer::ResetNodeTree())
+//  just refills the free lists, no malloc/free is done in the event loop.
+//  Every thread keeps a small cache of free blocks which is refilled from
+//  and spilled to one shared free list in batches, so the lock is taken
+//  once every kBatchSize allocations. The cache goes back to the shared
+//  list when its thread exits, objects created by short lived worker
+//  threads and deleted elsewhere are reused as well. Chunks are kept
+//  until the end of the job.
+//  Derived classes with a different size fall back to the default
+//  operator new/delete.
+
+#include <cstddef>
+#include <cstring>
+#include <mutex>
+#include <new>
+
+template <class T>
+class PHObjectPool
+{
+ public:
+  static void *allocate(const std::size_t size)
+  {
+    if (size != sizeof(T))
+    {
+      return fill(::operator new(size), size);
+    }
+    Cache &cache = threadcache();
+    if (!cache.head)
+    {
+      cache.take();
+    }
+    FreeBlock *block = cache.head;
+    cache.head = block->next;
+    cache.count--;
+    return fill(block, size);
+  }
+
+  static void deallocate(void *ptr, const std::size_t size)
+  {
+    if (!ptr)
+    {
+      return;
+    }
+    if (size != sizeof(T))
+    {
+      ::operator delete(ptr);
+      return;
+    }
+    Cache &cache = threadcache();
+    FreeBlock *block = static_cast<FreeBlock *>(ptr);
+    block->next = cache.head;
+    cache.head = block;
+    if (++cache.count >= 2 * kBatchSize)
+    {
+      cache.give(kBatchSize);
+    }
+  }
+
+ private:
+  //! number of objects allocated at once
+  static const std::size_t kChunkSize = 1024;
+  //! number of blocks moved between a thread cache and the shared list
+  static const std::size_t kBatchSize = 256;
+
+  union FreeBlock
+  {
+    FreeBlock *next;
+    alignas(T) char storage[sizeof(T)];
+  };
+
+  struct Shared
+  {
+    std::mutex lock;
+    FreeBlock *head = nullptr;
+  };
+
+  static Shared &shared()
+  {
+    static Shared pool;
+    return pool;
+  }
+
+  struct Cache
+  {
+    FreeBlock *head = nullptr;
+    std::size_t count = 0;
+
+    ~Cache() { give(count); }
+
+    //! move up to kBatchSize blocks from the shared list, allocate a new chunk if it is empty
+    void take()
+    {
+      Shared &pool = shared();
+      std::lock_guard<std::mutex> guard(pool.lock);
+      if (!pool.head)
+      {
+        refill(pool.head);
+      }
+      FreeBlock *first = pool.head;
+      FreeBlock *last = first;
+      std::size_t n = 1;
+      while (n < kBatchSize && last->next)
+      {
+        last = last->next;
+        n++;
+      }
+      pool.head = last->next;
+      last->next = head;
+      head = first;
+      count += n;
+    }
+
+    //! move n blocks back to the shared list
+    void give(std::size_t n)
+    {
+      if (!n)
+      {
+        return;
+      }
+      FreeBlock *first = head;
+      FreeBlock *last = first;
+      for (std::size_t i = 1; i < n; i++)
+      {
+        last = last->next;
+      }
+      head = last->next;
+      count -= n;
+      Shared &pool = shared();
+      std::lock_guard<std::mutex> guard(pool.lock);
+      last->next = pool.head;
+      pool.head = first;
+    }
+  };
+
+  static Cache &threadcache()
+  {
+    static thread_local Cache cache;
+    return cache;
+  }
+
+  static void refill(FreeBlock *&head)
+  {
+    FreeBlock *chunk = static_cast<FreeBlock *>(::operator new(kChunkSize * sizeof(FreeBlock)));
+    for (std::size_t i = 0; i < kChunkSize - 1; i++)
+    {
+      chunk[i].next = &chunk[i + 1];
+    }
+    chunk[kChunkSize - 1].next = head;
+    head = chunk;
+  }
+
+  // fill memory with the same pattern as TStorage::ObjectAlloc
+  // so TObject sets the kIsOnHeap bit in its ctor
+  static void *fill(void *ptr, const std::size_t size)
+  {
+    memset(ptr, 0x99, size);
+    return ptr;
+  }
+};
+
+#endif
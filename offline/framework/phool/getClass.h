@@ -14,15 +14,16 @@ class PHCompositeNode;
 
 namespace findNode
 {
+//! the object of class T held by node, nullptr if node is nullptr or holds something else
 template <class T>
-T *getClass(PHCompositeNode *top, const std::string &name)
+T *getClass(PHNode *FoundNode)
 {
-  PHNodeIterator iter(top);
-  PHNode *FoundNode = iter.findFirst(name.c_str());  // returns pointer to PHNode
   if (!FoundNode)
   {
     return nullptr;
   }
+  // objects of lazily loaded input nodes are read on first access
+  FoundNode->loadDeferred();
   // first test if it is a PHDataNode
   PHDataNode<T> *DNode = dynamic_cast<PHDataNode<T> *>(FoundNode);
   if (DNode)
@@ -55,6 +56,14 @@ T *getClass(PHCompositeNode *top, const std::string &name)
 
   return nullptr;
 }
+
+template <class T>
+T *getClass(PHCompositeNode *top, const std::string &name)
+{
+  PHNodeIterator iter(top);
+  PHNode *FoundNode = iter.findFirst(name.c_str());  // returns pointer to PHNode
+  return getClass<T>(FoundNode);
+}
 }  // namespace findNode
 
 #endif
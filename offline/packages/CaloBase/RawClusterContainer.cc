@@ -1,6 +1,10 @@
 #include "RawClusterContainer.h"
 
 #include "RawCluster.h"
+#include "RawClusterv1.h"
+#include "RawClusterv2.h"
+
+#include <phool/recoConsts.h>
 
 #include <cstdlib>
 #include <iostream>
@@ -64,11 +68,12 @@ int RawClusterContainer::isValid() const
 
 void RawClusterContainer::Reset()
 {
-  while (_clusters.begin() != _clusters.end())
+  for (auto &entry : _clusters)
   {
-    delete _clusters.begin()->second;
-    _clusters.erase(_clusters.begin());
+    delete entry.second;
   }
+  // one clear instead of rebalancing the map after every erase
+  _clusters.clear();
 }
 
 void RawClusterContainer::identify(std::ostream& os) const
@@ -87,3 +92,22 @@ RawClusterContainer::getTotalEdep() const
   }
   return totalenergy;
 }
+
+int RawClusterContainer::ClusterVersion()
+{
+  recoConsts *rc = recoConsts::instance();
+  if (rc->FlagExist("RAWCLUSTER_VERSION"))
+  {
+    return rc->get_IntFlag("RAWCLUSTER_VERSION");
+  }
+  return 1;
+}
+
+RawCluster *RawClusterContainer::NewCluster(const int version)
+{
+  if (version == 2)
+  {
+    return new RawClusterv2();
+  }
+  return new RawClusterv1();
+}
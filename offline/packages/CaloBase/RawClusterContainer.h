@@ -40,6 +40,13 @@ class RawClusterContainer : public PHObject
   unsigned int size() const { return _clusters.size(); }
   double getTotalEdep() const;
 
+  //! cluster version the cluster builders create, from the RAWCLUSTER_VERSION flag:
+  //! 1 (default) RawClusterv1, 2 RawClusterv2. Read it once per run, not per cluster
+  static int ClusterVersion();
+
+  //! new empty cluster of the given version
+  static RawCluster *NewCluster(const int version);
+
  protected:
   Map _clusters;
 
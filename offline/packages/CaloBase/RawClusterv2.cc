@@ -0,0 +1,268 @@
+#include "RawClusterv2.h"
+
+#include <phool/phool.h>
+
+#include <climits>
+#include <cmath>
+#include <cstdlib>
+#include <limits>
+#include <string>
+#include <utility>
+
+using namespace std;
+
+RawClusterv2::RawClusterv2()
+  : RawCluster()
+  , prop_set(0)
+  , clusterid(0)
+  , _energy(numeric_limits<float>::signaling_NaN())
+  , _r(numeric_limits<float>::signaling_NaN())
+  , _phi(numeric_limits<float>::signaling_NaN())
+  , _z(numeric_limits<float>::signaling_NaN())
+{
+  for (int i = 0; i < kNProperties; i++)
+  {
+    prop_value[i] = 0;
+  }
+}
+
+void RawClusterv2::Reset()
+{
+  clusterid = 0;
+  _z = (numeric_limits<float>::signaling_NaN());
+  _r = (numeric_limits<float>::signaling_NaN());
+  _phi = (numeric_limits<float>::signaling_NaN());
+  _energy = (numeric_limits<float>::signaling_NaN());
+  towermap.clear();
+  prop_set = 0;
+  for (int i = 0; i < kNProperties; i++)
+  {
+    prop_value[i] = 0;
+  }
+}
+
+void RawClusterv2::addTower(const RawClusterDefs::keytype twrid, const float etower)
+{
+  if (towermap.find(twrid) != towermap.end())
+  {
+    cout << "tower 0x" << hex << twrid << ", dec: " << dec
+         << twrid << " already exists, that is bad" << endl;
+    exit(1);
+  }
+  towermap[twrid] = etower;
+}
+
+int RawClusterv2::property_slot(const PROPERTY prop_id)
+{
+  switch (prop_id)
+  {
+  case prop_ecore:
+    return 0;
+  case prop_prob:
+    return 1;
+  case prop_chi2:
+    return 2;
+  case prop_et_iso_calotower_sub_R01:
+  case prop_et_iso_calotower_R01:
+  case prop_et_iso_calotower_sub_R02:
+  case prop_et_iso_calotower_R02:
+  case prop_et_iso_calotower_sub_R03:
+  case prop_et_iso_calotower_R03:
+  case prop_et_iso_calotower_sub_R04:
+  case prop_et_iso_calotower_R04:
+    return 3 + (prop_id - prop_et_iso_calotower_sub_R01);
+  default:
+    return -1;
+  }
+}
+
+RawCluster::PROPERTY RawClusterv2::et_iso_property(const int radiusx10, const bool subtracted)
+{
+  if (radiusx10 < 1 || radiusx10 > 4)
+  {
+    return prop_MAX_NUMBER;
+  }
+  // sub_R01, R01, sub_R02, R02, ...
+  return static_cast<PROPERTY>(prop_et_iso_calotower_sub_R01 + 2 * (radiusx10 - 1) + (subtracted ? 0 : 1));
+}
+
+void RawClusterv2::set_et_iso(const float et_iso, const int radiusx10, bool subtracted, bool clusterTower = 1)
+{
+  if (!clusterTower)
+  {
+    PHOOL_VIRTUAL_WARN("set_et_iso(const int radiusx10, bool subtracted, bool clusterTower) - nonclusterTower algorithms have not been defined");
+    return;
+  }
+  PROPERTY prop_id = et_iso_property(radiusx10, subtracted);
+  if (prop_id == prop_MAX_NUMBER)
+  {
+    std::string warning = "set_et_iso(const int radiusx10, bool subtracted, bool clusterTower) - radius:" + std::to_string(radiusx10) + " has not been defined";
+    PHOOL_VIRTUAL_WARN(warning.c_str());
+    return;
+  }
+  set_property(prop_id, et_iso);
+}
+
+float RawClusterv2::get_et_iso(const int radiusx10 = 3, bool subtracted = 0, bool clusterTower = 1) const
+{
+  if (!clusterTower)
+  {
+    PHOOL_VIRTUAL_WARN("get_et_iso(const int radiusx10, bool subtracted, bool clusterTower) - nonclusterTower algorithms have not been defined");
+    return NAN;
+  }
+  PROPERTY prop_id = et_iso_property(radiusx10, subtracted);
+  if (prop_id == prop_MAX_NUMBER)
+  {
+    std::string warning = "get_et_iso(const int radiusx10, bool subtracted, bool clusterTower) - radius:" + std::to_string(radiusx10) + " has not been defined";
+    PHOOL_VIRTUAL_WARN(warning.c_str());
+    return NAN;
+  }
+  return get_property_float(prop_id);
+}
+
+void RawClusterv2::identify(std::ostream& os) const
+{
+  os << "RawClusterv2 ID " << get_id() << " consist of " << getNTowers() << " towers with total energy of " << get_energy() << " GeV ";
+  os << "@ (r,phi,z) = (" << get_r() << ", " << get_phi() << ", " << get_z() << "), (x,y,z) = (" << get_x() << ", " << get_y() << ", " << get_z() << ")";
+
+  for (unsigned char ic = 0; ic < UCHAR_MAX; ic++)
+  {
+    PROPERTY prop_id = static_cast<PROPERTY>(ic);
+    if (!has_property(prop_id))
+    {
+      continue;
+    }
+    pair<const string, PROPERTY_TYPE> property_info = get_property_info(prop_id);
+    os << "\t" << prop_id << ":\t" << property_info.first << " = \t";
+    switch (property_info.second)
+    {
+    case type_int:
+      os << get_property_int(prop_id);
+      break;
+    case type_uint:
+      os << get_property_uint(prop_id);
+      break;
+    case type_float:
+      os << get_property_float(prop_id);
+      break;
+    default:
+      os << " unknown type ";
+      break;
+    }
+    os << endl;
+  }
+}
+
+bool RawClusterv2::has_property(const PROPERTY prop_id) const
+{
+  int slot = property_slot(prop_id);
+  return (slot >= 0 && (prop_set & (1U << slot)));
+}
+
+float RawClusterv2::get_property_float(const PROPERTY prop_id) const
+{
+  if (!check_property(prop_id, type_float))
+  {
+    pair<const string, PROPERTY_TYPE> property_info = get_property_info(prop_id);
+    cout << PHWHERE << " Property " << property_info.first << " with id "
+         << prop_id << " is of type " << get_property_type(property_info.second)
+         << " not " << get_property_type(type_float) << endl;
+    exit(1);
+  }
+  if (has_property(prop_id)) return u_property(prop_value[property_slot(prop_id)]).fdata;
+
+  return NAN;
+}
+
+int RawClusterv2::get_property_int(const PROPERTY prop_id) const
+{
+  if (!check_property(prop_id, type_int))
+  {
+    pair<const string, PROPERTY_TYPE> property_info = get_property_info(prop_id);
+    cout << PHWHERE << " Property " << property_info.first << " with id "
+         << prop_id << " is of type " << get_property_type(property_info.second)
+         << " not " << get_property_type(type_int) << endl;
+    exit(1);
+  }
+  if (has_property(prop_id)) return u_property(prop_value[property_slot(prop_id)]).idata;
+
+  return INT_MIN;
+}
+
+unsigned int
+RawClusterv2::get_property_uint(const PROPERTY prop_id) const
+{
+  if (!check_property(prop_id, type_uint))
+  {
+    pair<const string, PROPERTY_TYPE> property_info = get_property_info(prop_id);
+    cout << PHWHERE << " Property " << property_info.first << " with id "
+         << prop_id << " is of type " << get_property_type(property_info.second)
+         << " not " << get_property_type(type_uint) << endl;
+    exit(1);
+  }
+  if (has_property(prop_id)) return u_property(prop_value[property_slot(prop_id)]).uidata;
+
+  return UINT_MAX;
+}
+
+void RawClusterv2::set_property(const PROPERTY prop_id, const float value)
+{
+  if (!check_property(prop_id, type_float))
+  {
+    pair<const string, PROPERTY_TYPE> property_info = get_property_info(prop_id);
+    cout << PHWHERE << " Property " << property_info.first << " with id "
+         << prop_id << " is of type " << get_property_type(property_info.second)
+         << " not " << get_property_type(type_float) << endl;
+    exit(1);
+  }
+  set_property_nocheck(prop_id, u_property(value).get_storage());
+}
+
+void RawClusterv2::set_property(const PROPERTY prop_id, const int value)
+{
+  if (!check_property(prop_id, type_int))
+  {
+    pair<const string, PROPERTY_TYPE> property_info = get_property_info(prop_id);
+    cout << PHWHERE << " Property " << property_info.first << " with id "
+         << prop_id << " is of type " << get_property_type(property_info.second)
+         << " not " << get_property_type(type_int) << endl;
+    exit(1);
+  }
+  set_property_nocheck(prop_id, u_property(value).get_storage());
+}
+
+void RawClusterv2::set_property(const PROPERTY prop_id, const unsigned int value)
+{
+  if (!check_property(prop_id, type_uint))
+  {
+    pair<const string, PROPERTY_TYPE> property_info = get_property_info(prop_id);
+    cout << PHWHERE << " Property " << property_info.first << " with id "
+         << prop_id << " is of type " << get_property_type(property_info.second)
+         << " not " << get_property_type(type_uint) << endl;
+    exit(1);
+  }
+  set_property_nocheck(prop_id, u_property(value).get_storage());
+}
+
+unsigned int
+RawClusterv2::get_property_nocheck(const PROPERTY prop_id) const
+{
+  if (has_property(prop_id))
+  {
+    return prop_value[property_slot(prop_id)];
+  }
+  return UINT_MAX;
+}
+
+void RawClusterv2::set_property_nocheck(const PROPERTY prop_id, const unsigned int ui)
+{
+  int slot = property_slot(prop_id);
+  if (slot < 0)
+  {
+    cout << PHWHERE << " Property with id " << prop_id
+         << " has no storage in RawClusterv2, add it to RawClusterv2::property_slot()" << endl;
+    exit(1);
+  }
+  prop_value[slot] = ui;
+  prop_set |= (1U << slot);
+}
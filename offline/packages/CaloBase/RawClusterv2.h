@@ -0,0 +1,142 @@
+#ifndef CALOBASE_RAWCLUSTERV2_H
+#define CALOBASE_RAWCLUSTERV2_H
+
+#include "RawCluster.h"
+#include "RawClusterDefs.h"
+
+#include <CLHEP/Vector/ThreeVector.h>
+
+#include <cmath>
+#include <cstddef>
+#include <iostream>
+#include <utility>
+
+#if !defined(__CINT__) || defined(__CLING__)
+#include <cstdint>
+#else
+#include <stdint.h>
+#endif
+
+class PHObject;
+
+/*!
+ * \brief RawCluster with fixed layout property storage
+ *
+ * Same content as RawClusterv1, but the optional properties (ecore, chi2,
+ * prob, isolation energies) are kept in a fixed array indexed by property
+ * instead of a std::map. A lookup is a table access and a cluster does not
+ * need a heap allocation for them.
+ */
+class RawClusterv2 : public RawCluster
+{
+ public:
+  RawClusterv2();
+  virtual ~RawClusterv2() {}
+  virtual void Reset();
+  virtual PHObject *CloneMe() const { return new RawClusterv2(*this); }
+  virtual int isValid() const { return towermap.size() > 0; }
+  virtual void identify(std::ostream &os = std::cout) const;
+
+  //! getters, see RawClusterv1
+  RawClusterDefs::keytype get_id() const { return clusterid; }
+  float get_energy() const { return _energy; }
+  size_t getNTowers() const { return towermap.size(); }
+  RawCluster::TowerConstRange get_towers() const { return make_pair(towermap.begin(), towermap.end()); }
+  const TowerMap &get_towermap() const { return towermap; }
+  virtual CLHEP::Hep3Vector get_position() const
+  {
+    return CLHEP::Hep3Vector(get_x(), get_y(), get_z());
+  }
+  float get_phi() const { return _phi; }
+  float get_r() const { return _r; }
+  float get_z() const { return _z; }
+  virtual float get_x() const { return get_r() * std::cos(get_phi()); }
+  virtual float get_y() const { return get_r() * std::sin(get_phi()); }
+  virtual float get_ecore() const { return get_property_float(prop_ecore); }
+  virtual float get_chi2() const { return get_property_float(prop_chi2); }
+  virtual float get_prob() const { return get_property_float(prop_prob); }
+  virtual float get_et_iso() const { return get_property_float(prop_et_iso_calotower_R03); }
+  virtual float get_et_iso(const int radiusx10, bool subtracted, bool clusterTower) const;
+
+  //! setters, see RawClusterv1
+  void set_id(const RawClusterDefs::keytype id) { clusterid = id; }
+  void addTower(const RawClusterDefs::keytype twrid, const float etower);
+  void set_energy(const float energy) { _energy = energy; }
+  void set_phi(const float phi) { _phi = phi; }
+  void set_z(const float z) { _z = z; }
+  void set_r(const float r) { _r = r; }
+  virtual void set_ecore(const float ecore) { set_property(prop_ecore, ecore); }
+  virtual void set_chi2(const float chi2) { set_property(prop_chi2, chi2); }
+  virtual void set_prob(const float prob) { set_property(prop_prob, prob); }
+  virtual void set_et_iso(const float e) { set_property(prop_et_iso_calotower_R03, e); }
+  virtual void set_et_iso(const float et_iso, const int radiusx10, bool subtracted, bool clusterTower);
+
+  bool has_property(const PROPERTY prop_id) const;
+  float get_property_float(const PROPERTY prop_id) const;
+  int get_property_int(const PROPERTY prop_id) const;
+  unsigned int get_property_uint(const PROPERTY prop_id) const;
+  void set_property(const PROPERTY prop_id, const float value);
+  void set_property(const PROPERTY prop_id, const int value);
+  void set_property(const PROPERTY prop_id, const unsigned int value);
+
+ protected:
+  unsigned int get_property_nocheck(const PROPERTY prop_id) const;
+  void set_property_nocheck(const PROPERTY prop_id, const unsigned int ui);
+
+  typedef uint32_t prop_storage_t;
+
+  //! convert between 32bit inputs and storage type prop_storage_t
+  union u_property {
+    float fdata;
+    int32_t idata;
+    uint32_t uidata;
+
+    u_property(int32_t in)
+      : idata(in)
+    {
+    }
+    u_property(uint32_t in)
+      : uidata(in)
+    {
+    }
+    u_property(float in)
+      : fdata(in)
+    {
+    }
+    u_property()
+      : uidata(0)
+    {
+    }
+
+    prop_storage_t get_storage() const { return uidata; }
+  };
+
+  //! number of defined RawCluster properties
+  static const int kNProperties = 11;
+
+  //! slot of a property in prop_value, -1 for unknown properties
+  static int property_slot(const PROPERTY prop_id);
+
+  //! isolation energy property for the radius, prop_MAX_NUMBER if the radius is not defined
+  static PROPERTY et_iso_property(const int radiusx10, const bool subtracted);
+
+  //! bit i is set if slot i holds a value
+  uint16_t prop_set;
+  prop_storage_t prop_value[kNProperties];
+
+  //! cluster ID
+  RawClusterDefs::keytype clusterid;
+  //! total energy
+  float _energy;
+  //! Tower operations
+  TowerMap towermap;
+
+  //! location of cluster in cylindrical coordinate
+  float _r;
+  float _phi;
+  float _z;
+
+  ClassDef(RawClusterv2, 1)
+};
+
+#endif
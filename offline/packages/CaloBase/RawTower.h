@@ -97,6 +97,14 @@ class RawTower : public PHObject
     return;
   }
 
+  //! quality/status bits of the tower, 0 is good
+  virtual unsigned int get_status() const { return 0; }
+  virtual void set_status(const unsigned int)
+  {
+    PHOOL_VIRTUAL_WARN("set_status()");
+    return;
+  }
+
   virtual bool empty_g4cells() const { return true; }
   virtual size_t size_g4cells() const { return 0; }
   virtual CellConstRange get_g4cells() const
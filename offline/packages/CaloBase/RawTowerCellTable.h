@@ -0,0 +1,81 @@
+#ifndef CALOBASE_RAWTOWERCELLTABLE_H
+#define CALOBASE_RAWTOWERCELLTABLE_H
+
+#include "RawTower.h"
+#include "RawTowerDefs.h"
+
+#include <phool/PHObject.h>
+
+#include <iostream>
+#include <utility>
+#include <vector>
+
+/*! \class RawTowerCellTable
+    \brief cell energies per tower of one calorimeter, in one flat table
+
+    Cell contributions of the towers which do not keep them themselves
+    (RawTowerv3), same layout and usage as RawTowerShowerTable with the
+    cell key instead of the shower id.
+*/
+class RawTowerCellTable : public PHObject
+{
+ public:
+  struct Entry
+  {
+    RawTowerDefs::keytype tower;
+    RawTower::CellKeyType cell;
+    float edep;
+  };
+  typedef std::vector<Entry> List;
+  typedef List::const_iterator ConstIterator;
+  typedef std::pair<ConstIterator, ConstIterator> ConstRange;
+
+  RawTowerCellTable()
+    : m_sorted(true)
+  {
+  }
+  virtual ~RawTowerCellTable() {}
+
+  void Reset();
+  int isValid() const { return 1; }
+  void identify(std::ostream &os = std::cout) const;
+
+  void reserve(const unsigned int n) { m_entries.reserve(n); }
+
+  //! adds edep of the cell to the tower
+  void add(const RawTowerDefs::keytype tower, const RawTower::CellKeyType cell, const float edep)
+  {
+    Entry entry = {tower, cell, edep};
+    m_entries.push_back(entry);
+    m_sorted = false;
+  }
+
+  //! sorts and merges the entries, to be called once all are added
+  void finalize();
+
+  //! removes the entries of the towers for which keep(tower) is false, the table stays sorted
+  template <class Predicate>
+  void keep_towers(Predicate keep)
+  {
+    List::iterator last = m_entries.begin();
+    for (List::iterator iter = m_entries.begin(); iter != m_entries.end(); ++iter)
+    {
+      if (keep(iter->tower)) *last++ = *iter;
+    }
+    m_entries.erase(last, m_entries.end());
+  }
+
+  //! cells of the tower, sorted by cell id. The table must be finalized
+  ConstRange get_cells(const RawTowerDefs::keytype tower) const;
+
+  unsigned int size() const { return m_entries.size(); }
+  ConstRange get_entries() const { return std::make_pair(m_entries.begin(), m_entries.end()); }
+
+ private:
+  List m_entries;
+  bool m_sorted;  //!
+
+  ClassDef(RawTowerCellTable, 1)
+};
+
+#endif
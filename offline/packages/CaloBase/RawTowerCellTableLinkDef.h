@@ -0,0 +1,6 @@
+#ifdef __CINT__
+
+#pragma link C++ class RawTowerCellTable + ;
+#pragma link C++ struct RawTowerCellTable::Entry + ;
+
+#endif /* __CINT__ */
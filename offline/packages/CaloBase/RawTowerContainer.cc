@@ -2,6 +2,7 @@
 
 #include "RawTower.h"
 
+#include <algorithm>
 #include <cstdlib>
 #include <iostream>
 
@@ -20,6 +21,7 @@ void RawTowerContainer::compress(const double emin)
     RawTower *tower = (itr->second);
     if (tower->get_energy() < emin)
     {
+      grid_erase(itr->first);
       delete tower;
       _towers.erase(itr++);
     }
@@ -30,6 +32,17 @@ void RawTowerContainer::compress(const double emin)
   }
 }
 
+void RawTowerContainer::RemoveTower(RawTowerDefs::keytype key)
+{
+  Iterator it = _towers.find(key);
+  if (it != _towers.end())
+  {
+    grid_erase(key);
+    delete it->second;
+    _towers.erase(it);
+  }
+}
+
 RawTowerContainer::ConstRange
 RawTowerContainer::getTowers(void) const
 {
@@ -48,6 +61,7 @@ RawTowerContainer::AddTower(const unsigned int ieta, const int unsigned iphi, Ra
   RawTowerDefs::keytype key = RawTowerDefs::encode_towerid(_caloid, ieta, iphi);
   _towers[key] = rawtower;
   rawtower->set_id(key);  // force tower key to be synced to container key
+  grid_insert(key, rawtower);
 
   return _towers.find(key);
 }
@@ -64,6 +78,7 @@ RawTowerContainer::AddTower(RawTowerDefs::keytype key, RawTower *twr)
 
   _towers[key] = twr;
   twr->set_id(key);  // force tower key to be synced to container key
+  grid_insert(key, twr);
 
   return _towers.find(key);
 }
@@ -71,23 +86,13 @@ RawTowerContainer::AddTower(RawTowerDefs::keytype key, RawTower *twr)
 RawTower *
 RawTowerContainer::getTower(RawTowerDefs::keytype key)
 {
-  ConstIterator it = _towers.find(key);
-  if (it != _towers.end())
-  {
-    return it->second;
-  }
-  return NULL;
+  return find_tower(key);
 }
 
 const RawTower *
 RawTowerContainer::getTower(RawTowerDefs::keytype key) const
 {
-  ConstIterator it = _towers.find(key);
-  if (it != _towers.end())
-  {
-    return it->second;
-  }
-  return NULL;
+  return find_tower(key);
 }
 
 RawTower *
@@ -111,11 +116,15 @@ int RawTowerContainer::isValid() const
 
 void RawTowerContainer::Reset()
 {
-  while (_towers.begin() != _towers.end())
+  for (auto &entry : _towers)
   {
-    delete _towers.begin()->second;
-    _towers.erase(_towers.begin());
+    delete entry.second;
   }
+  // one clear instead of rebalancing the map after every erase
+  _towers.clear();
+
+  // keep the grid size for the next event
+  std::fill(_grid.begin(), _grid.end(), static_cast<RawTower *>(NULL));
 }
 
 void RawTowerContainer::identify(std::ostream &os) const
@@ -134,3 +143,108 @@ RawTowerContainer::getTotalEdep() const
   }
   return totalenergy;
 }
+
+RawTower *
+RawTowerContainer::find_tower(RawTowerDefs::keytype key) const
+{
+  if (!_grid_valid) grid_rebuild();
+
+  if (_grid_dense)
+  {
+    const unsigned int index1 = RawTowerDefs::decode_index1(key);
+    const unsigned int index2 = RawTowerDefs::decode_index2(key);
+    if (index1 >= _grid_n1 || index2 >= _grid_n2) return NULL;
+
+    RawTower *tower = _grid[index1 * _grid_n2 + index2];
+    if (!tower) return NULL;
+
+    // the grid ignores the calorimeter id, check the full key and use the map if it differs
+    if (tower->get_id() == key) return tower;
+  }
+
+  ConstIterator it = _towers.find(key);
+  if (it != _towers.end())
+  {
+    return it->second;
+  }
+  return NULL;
+}
+
+void RawTowerContainer::grid_insert(RawTowerDefs::keytype key, RawTower *twr)
+{
+  if (!(_grid_valid && _grid_dense)) return;
+
+  const unsigned int index1 = RawTowerDefs::decode_index1(key);
+  const unsigned int index2 = RawTowerDefs::decode_index2(key);
+  if (index1 >= _grid_n1 || index2 >= _grid_n2)
+  {
+    // grow geometrically, so that filling tower by tower does not copy the grid each time
+    grid_resize(std::max(index1 + 1, std::min(2 * _grid_n1, 0x1000U)),
+                std::max(index2 + 1, std::min(2 * _grid_n2, 0x1000U)));
+    if (!_grid_dense) return;
+  }
+
+  _grid[index1 * _grid_n2 + index2] = twr;
+}
+
+void RawTowerContainer::grid_erase(RawTowerDefs::keytype key)
+{
+  if (!(_grid_valid && _grid_dense)) return;
+
+  const unsigned int index1 = RawTowerDefs::decode_index1(key);
+  const unsigned int index2 = RawTowerDefs::decode_index2(key);
+  if (index1 < _grid_n1 && index2 < _grid_n2)
+  {
+    _grid[index1 * _grid_n2 + index2] = NULL;
+  }
+}
+
+void RawTowerContainer::grid_resize(unsigned int n1, unsigned int n2) const
+{
+  if ((unsigned long) n1 * n2 > kMaxGridSize)
+  {
+    _grid.clear();
+    _grid_n1 = 0;
+    _grid_n2 = 0;
+    _grid_dense = false;
+    return;
+  }
+
+  std::vector<RawTower *> grid(n1 * n2, NULL);
+  for (unsigned int index1 = 0; index1 < _grid_n1 && index1 < n1; ++index1)
+  {
+    for (unsigned int index2 = 0; index2 < _grid_n2 && index2 < n2; ++index2)
+    {
+      grid[index1 * n2 + index2] = _grid[index1 * _grid_n2 + index2];
+    }
+  }
+
+  _grid.swap(grid);
+  _grid_n1 = n1;
+  _grid_n2 = n2;
+}
+
+void RawTowerContainer::grid_rebuild() const
+{
+  unsigned int n1 = 0;
+  unsigned int n2 = 0;
+  for (ConstIterator iter = _towers.begin(); iter != _towers.end(); ++iter)
+  {
+    n1 = std::max(n1, RawTowerDefs::decode_index1(iter->first) + 1);
+    n2 = std::max(n2, RawTowerDefs::decode_index2(iter->first) + 1);
+  }
+
+  _grid.clear();
+  _grid_n1 = 0;
+  _grid_n2 = 0;
+  _grid_dense = true;
+  _grid_valid = true;
+
+  grid_resize(n1, n2);
+  if (!_grid_dense) return;
+
+  for (ConstIterator iter = _towers.begin(); iter != _towers.end(); ++iter)
+  {
+    _grid[RawTowerDefs::decode_index1(iter->first) * _grid_n2 + RawTowerDefs::decode_index2(iter->first)] = iter->second;
+  }
+}
@@ -8,9 +8,19 @@
 #include <iostream>
 #include <map>
 #include <utility>
+#include <vector>
 
 class RawTower;
 
+/*!
+ * \brief container of the towers of one calorimeter
+ *
+ * Towers are stored in a map of tower key to tower, which defines the iteration order.
+ * Lookups go through a transient dense grid indexed by the two tower indices
+ * (ieta, iphi for the barrel calorimeters), so that neighbor searches in the
+ * clustering do not walk the map. The grid grows with the towers and keeps its
+ * size across Reset(). It is not used if the indices are too sparse.
+ */
 class RawTowerContainer : public PHObject
 {
  public:
@@ -22,6 +32,11 @@ class RawTowerContainer : public PHObject
 
   RawTowerContainer(RawTowerDefs::CalorimeterId caloid = RawTowerDefs::NONE)
     : _caloid(caloid)
+    , _grid()
+    , _grid_n1(0)
+    , _grid_n2(0)
+    , _grid_dense(true)
+    , _grid_valid(true)
   {
   }
 
@@ -49,12 +64,44 @@ class RawTowerContainer : public PHObject
 
   unsigned int size() const { return _towers.size(); }
   void compress(const double emin);
+  //! removes and deletes the tower
+  void RemoveTower(RawTowerDefs::keytype key);
   double getTotalEdep() const;
 
  protected:
   RawTowerDefs::CalorimeterId _caloid;
   Map _towers;
 
+ private:
+  //! maximum number of grid cells, towers with sparser indices are only looked up in the map
+  static const unsigned int kMaxGridSize = 1 << 20;
+
+  //! tower with this key, using the grid if possible
+  RawTower *find_tower(RawTowerDefs::keytype key) const;
+
+  //! store tower in the grid, growing it if needed
+  void grid_insert(RawTowerDefs::keytype key, RawTower *twr);
+
+  //! remove tower from the grid
+  void grid_erase(RawTowerDefs::keytype key);
+
+  //! resize the grid to n1 x n2 cells, keeping its content
+  void grid_resize(unsigned int n1, unsigned int n2) const;
+
+  //! rebuild the grid from the map
+  void grid_rebuild() const;
+
+  //! (index1, index2) => tower, index1 * _grid_n2 + index2
+  mutable std::vector<RawTower *> _grid;  //!
+  mutable unsigned int _grid_n1;  //!
+  mutable unsigned int _grid_n2;  //!
+
+  //! false if the tower indices are too sparse for a grid
+  mutable bool _grid_dense;  //!
+
+  //! false if the grid must be rebuilt from the map
+  mutable bool _grid_valid;  //!
+
   ClassDef(RawTowerContainer, 1)
 };
 
@@ -2,4 +2,7 @@
 
 #pragma link C++ class RawTowerContainer + ;
 
+// the tower grid points to the towers in _towers, rebuild it after reading
+#pragma read sourceClass="RawTowerContainer" targetClass="RawTowerContainer" version="[1-]" source="" target="_grid_valid" code="{ _grid_valid = false; }"
+
 #endif /* __CINT__ */
@@ -0,0 +1,118 @@
+#include "RawTowerDeadStencil.h"
+
+#include "RawTower.h"
+#include "RawTowerContainer.h"
+#include "RawTowerDeadMap.h"
+#include "RawTowerGeom.h"
+#include "RawTowerGeomContainer.h"
+
+#include <cassert>
+#include <iostream>
+#include <utility>
+
+using namespace std;
+
+RawTowerDeadStencil::RawTowerDeadStencil()
+  : m_etabins(0)
+  , m_phibins(0)
+{
+  m_neighbor_offset.assign(1, 0);
+}
+
+void RawTowerDeadStencil::clear()
+{
+  m_etabins = 0;
+  m_phibins = 0;
+  m_dead.clear();
+  m_dead_keys.clear();
+  m_neighbor_offset.assign(1, 0);
+  m_neighbor_eta.clear();
+  m_neighbor_phi.clear();
+  m_neighbor_weight.clear();
+}
+
+bool RawTowerDeadStencil::build(RawTowerDeadMap *deadmap, RawTowerGeomContainer *geom)
+{
+  assert(deadmap);
+  assert(geom);
+  clear();
+
+  // assume cylindrical calorimeters for now
+  m_etabins = geom->get_etabins();
+  m_phibins = geom->get_phibins();
+  assert(m_etabins > 0);
+  assert(m_phibins > 0);
+
+  // dead mask first, the neighbors below skip dead towers
+  m_dead.assign(m_etabins * m_phibins, false);
+  vector<pair<int, int> > bins;
+  for (const RawTowerDefs::keytype &key : deadmap->getDeadTowers())
+  {
+    RawTowerGeom *towerGeom = geom->get_tower_geometry(key);
+    if (towerGeom == nullptr)
+    {
+      cout << "RawTowerDeadStencil::build - invalid dead tower ID " << key << endl;
+      clear();
+      return false;
+    }
+    const int bineta = towerGeom->get_bineta();
+    const int binphi = towerGeom->get_binphi();
+    assert(bineta >= 0 && bineta < m_etabins);
+    assert(binphi >= 0 && binphi < m_phibins);
+
+    m_dead[bineta * m_phibins + binphi] = true;
+    m_dead_keys.push_back(key);
+    bins.push_back(make_pair(bineta, binphi));
+  }
+
+  // eight neighbors
+  static const vector<pair<int, int> > neighborIndexs =
+      {{+1, 0}, {+1, +1}, {0, +1}, {-1, +1}, {-1, 0}, {-1, -1}, {0, -1}, {+1, -1}};
+
+  for (const pair<int, int> &bin : bins)
+  {
+    const unsigned int first = m_neighbor_eta.size();
+    for (const pair<int, int> &neighborIndex : neighborIndexs)
+    {
+      const int ieta = bin.first + neighborIndex.first;
+      int iphi = bin.second + neighborIndex.second;
+
+      if (ieta >= m_etabins) continue;
+      if (ieta < 0) continue;
+
+      if (iphi >= m_phibins) iphi -= m_phibins;
+      if (iphi < 0) iphi += m_phibins;
+
+      if (is_dead(ieta, iphi)) continue;
+
+      m_neighbor_eta.push_back(ieta);
+      m_neighbor_phi.push_back(iphi);
+    }
+    const unsigned int n = m_neighbor_eta.size() - first;
+    for (unsigned int i = 0; i < n; ++i)
+    {
+      m_neighbor_weight.push_back(1. / n);
+    }
+    m_neighbor_offset.push_back(m_neighbor_eta.size());
+  }
+  return true;
+}
+
+void RawTowerDeadStencil::interpolate(const RawTowerContainer *towers, std::vector<double> &energies) const
+{
+  assert(towers);
+  energies.assign(m_dead_keys.size(), 0);
+  for (unsigned int i = 0; i < m_dead_keys.size(); ++i)
+  {
+    double e = 0;
+    for (unsigned int j = m_neighbor_offset[i]; j < m_neighbor_offset[i + 1]; ++j)
+    {
+      const RawTower *tower = towers->getTower(m_neighbor_eta[j], m_neighbor_phi[j]);
+      if (tower)
+      {
+        e += m_neighbor_weight[j] * tower->get_energy();
+      }
+    }
+    energies[i] = e;
+  }
+}
@@ -0,0 +1,72 @@
+#ifndef CALOBASE_RAWTOWERDEADSTENCIL_H
+#define CALOBASE_RAWTOWERDEADSTENCIL_H
+
+#include "RawTowerDefs.h"
+
+#include <vector>
+
+class RawTowerContainer;
+class RawTowerDeadMap;
+class RawTowerGeomContainer;
+
+/*! \class RawTowerDeadStencil
+    \brief Per run interpolation stencils of the dead towers of a cylindrical calorimeter
+
+    Built once (e.g. in InitRun) from the dead map and the tower geometry.
+    Each dead tower gets the list of its alive neighbors (the eight towers
+    around it, wrapping around in phi) with equal weights, so recovering the
+    dead tower energies each event is a sparse matrix times the alive tower
+    energies, without dead map searches. is_dead() answers dead map queries
+    from a dense (ieta, iphi) mask. Call build() again if the dead map or
+    the geometry change.
+*/
+class RawTowerDeadStencil
+{
+ public:
+  RawTowerDeadStencil();
+  virtual ~RawTowerDeadStencil() {}
+
+  //! stencils of all dead towers of deadmap, false if a dead tower has no geometry
+  bool build(RawTowerDeadMap *deadmap, RawTowerGeomContainer *geom);
+  void clear();
+
+  int get_etabins() const { return m_etabins; }
+  int get_phibins() const { return m_phibins; }
+
+  //! true for a dead tower, false outside of the grid
+  bool is_dead(const int ieta, const int iphi) const
+  {
+    if (ieta < 0 || ieta >= m_etabins || iphi < 0 || iphi >= m_phibins) return false;
+    return m_dead[ieta * m_phibins + iphi];
+  }
+
+  //! number of dead towers
+  unsigned int size() const { return m_dead_keys.size(); }
+  RawTowerDefs::keytype get_dead_key(const unsigned int i) const { return m_dead_keys[i]; }
+
+  //! number of alive neighbors of dead tower i
+  unsigned int get_n_neighbors(const unsigned int i) const { return m_neighbor_offset[i + 1] - m_neighbor_offset[i]; }
+
+  /*! interpolated energy of every dead tower, the weighted sum of its alive neighbors
+      in towers. Neighbors without a tower in this event count with zero energy
+  */
+  void interpolate(const RawTowerContainer *towers, std::vector<double> &energies) const;
+
+ private:
+  int m_etabins;
+  int m_phibins;
+
+  //! ieta * m_phibins + iphi => dead
+  std::vector<bool> m_dead;
+
+  //! dead towers, in key order
+  std::vector<RawTowerDefs::keytype> m_dead_keys;
+
+  //! neighbors of dead tower i are [m_neighbor_offset[i], m_neighbor_offset[i + 1])
+  std::vector<unsigned int> m_neighbor_offset;
+  std::vector<int> m_neighbor_eta;
+  std::vector<int> m_neighbor_phi;
+  std::vector<double> m_neighbor_weight;
+};
+
+#endif
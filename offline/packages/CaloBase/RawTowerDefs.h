@@ -5,6 +5,7 @@
 #include <string>
 
 #if !defined(__CINT__) || defined(__CLING__)
+#include <cstddef>
 #include <cstdlib>
 #else
 #include <stdlib.h>
@@ -22,9 +23,9 @@ typedef unsigned int keytype;
 
 /*! Bit ranges for encoding calorimeter ID and tower indices in combined tower ID
    */
-static unsigned int calo_idbits = 8;
-static unsigned int tower_idbits = sizeof(keytype) * 8 - calo_idbits;
-static unsigned int index1_idbits = tower_idbits / 2;
+static const unsigned int calo_idbits = 8;
+static const unsigned int tower_idbits = sizeof(keytype) * 8 - calo_idbits;
+static const unsigned int index1_idbits = tower_idbits / 2;
 
 /*! Enum with all available calorimeter IDs. This enum can be extended up to 254 entries.
    * If adding new CalorimeterIDs, please also add them to the decode_caloname function below.
@@ -40,54 +41,59 @@ enum CalorimeterId
   FHCAL
 };
 
+#if !defined(__CINT__) || defined(__CLING__)
+
+/*! Reports too large tower indices, the range checks of the encoding are only
+ * compiled into debug builds (NDEBUG not defined)
+   */
+inline void index_out_of_range(const unsigned int tower_index_1, const unsigned int tower_index_2)
+{
+  std::cout << "too large index1 and/or index2; index1: "
+            << tower_index_1 << " (max val " << 0xFFF << ")"
+            << ", index2: "
+            << tower_index_2 << " (max val " << 0xFFF << ")" << std::endl;
+  exit(1);
+}
+
+inline void index_out_of_range(const unsigned int tower_index)
+{
+  std::cout << "too large index; index: " << tower_index
+            << " (max val " << 0xFFFFFF << ")" << std::endl;
+  exit(1);
+}
+
 /*! Returns CaloTowerID for given calorimeter ID, tower index 1, and tower index 2
    */
-inline RawTowerDefs::keytype
+constexpr RawTowerDefs::keytype
 encode_towerid(const CalorimeterId calo_id, const unsigned int tower_index_1,
                const unsigned int tower_index_2)
 {
-  RawTowerDefs::keytype calo_tower_id = 0;
-
-  if (tower_index_1 < 0xFFF && tower_index_2 < 0xFFF)
-  {
-    calo_tower_id = (calo_id << RawTowerDefs::tower_idbits) + (tower_index_1 << RawTowerDefs::index1_idbits) + tower_index_2;
-  }
-  else
+#ifndef NDEBUG
+  if (tower_index_1 >= 0xFFF || tower_index_2 >= 0xFFF)
   {
-    std::cout << "too large index1 and/or index2; index1: "
-              << tower_index_1 << " (max val " << 0xFFF << ")"
-              << ", index2: "
-              << tower_index_2 << " (max val " << 0xFFF << ")" << std::endl;
-    exit(1);
+    index_out_of_range(tower_index_1, tower_index_2);
   }
-
-  return calo_tower_id;
+#endif
+  return (static_cast<RawTowerDefs::keytype>(calo_id) << RawTowerDefs::tower_idbits) + (tower_index_1 << RawTowerDefs::index1_idbits) + tower_index_2;
 }
 
 /*! Returns CaloTowerID for given calorimeter ID, tower index
    */
-inline RawTowerDefs::keytype
+constexpr RawTowerDefs::keytype
 encode_towerid(const CalorimeterId calo_id, const unsigned int tower_index)
 {
-  RawTowerDefs::keytype calo_tower_id = 0;
-
-  if (tower_index < 0xFFFFFF)
+#ifndef NDEBUG
+  if (tower_index >= 0xFFFFFF)
   {
-    calo_tower_id = (calo_id << RawTowerDefs::tower_idbits) + tower_index;
+    index_out_of_range(tower_index);
   }
-  else
-  {
-    std::cout << "too large index; index: " << tower_index
-              << " (max val " << 0xFFFFFF << ")" << std::endl;
-    exit(1);
-  }
-
-  return calo_tower_id;
+#endif
+  return (static_cast<RawTowerDefs::keytype>(calo_id) << RawTowerDefs::tower_idbits) + tower_index;
 }
 
 /*! Extract calorimeter ID from CaloTowerID
    */
-inline CalorimeterId
+constexpr CalorimeterId
 decode_caloid(const unsigned int calo_tower_id)
 {
   return static_cast<CalorimeterId>((calo_tower_id >> RawTowerDefs::tower_idbits) & 0xFFF);
@@ -95,7 +101,7 @@ decode_caloid(const unsigned int calo_tower_id)
 
 /*! Extract tower index of calorimeter tower from CaloTowerID
    */
-inline unsigned int
+constexpr unsigned int
 decode_index(const unsigned int calo_tower_id)
 {
   return (calo_tower_id) &0xFFFFFF;
@@ -103,7 +109,7 @@ decode_index(const unsigned int calo_tower_id)
 
 /*! Extract tower index 1 of calorimeter tower from CaloTowerID
    */
-inline unsigned int
+constexpr unsigned int
 decode_index1(const unsigned int calo_tower_id)
 {
   return (calo_tower_id >> RawTowerDefs::index1_idbits) & 0xFFF;
@@ -111,12 +117,36 @@ decode_index1(const unsigned int calo_tower_id)
 
 /*! Extract tower index 2 of calorimeter tower from CaloTowerID
    */
-inline unsigned int
+constexpr unsigned int
 decode_index2(const unsigned int calo_tower_id)
 {
   return calo_tower_id & 0xFFF;
 }
 
+/*! Extract both tower indices of n CaloTowerIDs
+   */
+inline void
+decode_index1_index2(const RawTowerDefs::keytype *calo_tower_ids, const size_t n,
+                     unsigned int *index1, unsigned int *index2)
+{
+  for (size_t i = 0; i < n; ++i)
+  {
+    index1[i] = decode_index1(calo_tower_ids[i]);
+    index2[i] = decode_index2(calo_tower_ids[i]);
+  }
+}
+
+#else
+
+RawTowerDefs::keytype encode_towerid(const CalorimeterId calo_id, const unsigned int tower_index_1, const unsigned int tower_index_2);
+RawTowerDefs::keytype encode_towerid(const CalorimeterId calo_id, const unsigned int tower_index);
+CalorimeterId decode_caloid(const unsigned int calo_tower_id);
+unsigned int decode_index(const unsigned int calo_tower_id);
+unsigned int decode_index1(const unsigned int calo_tower_id);
+unsigned int decode_index2(const unsigned int calo_tower_id);
+
+#endif
+
 /*! Convert calorimeter ID to name string
    */
 inline std::string
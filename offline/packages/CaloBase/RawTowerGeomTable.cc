@@ -0,0 +1,153 @@
+#include "RawTowerGeomTable.h"
+
+#include "RawTowerGeom.h"
+#include "RawTowerGeomContainer.h"
+#include "RawTowerGeomContainer_Cylinderv1.h"
+
+#include <algorithm>
+#include <cassert>
+#include <cmath>
+
+using namespace std;
+
+RawTowerGeomTable::RawTowerGeomTable()
+  : m_caloid(RawTowerDefs::NONE)
+  , m_index1_min(0)
+  , m_index2_min(0)
+  , m_n1(0)
+  , m_n2(0)
+{
+  m_neighbor_offset.assign(1, 0);
+}
+
+RawTowerGeomTable::RawTowerGeomTable(RawTowerGeomContainer *geom)
+  : RawTowerGeomTable()
+{
+  build(geom);
+}
+
+void RawTowerGeomTable::clear()
+{
+  m_caloid = RawTowerDefs::NONE;
+  m_key.clear();
+  m_x.clear();
+  m_y.clear();
+  m_z.clear();
+  m_eta.clear();
+  m_phi.clear();
+  m_neighbor_offset.assign(1, 0);
+  m_neighbors.clear();
+  m_grid.clear();
+  m_index1_min = 0;
+  m_index2_min = 0;
+  m_n1 = 0;
+  m_n2 = 0;
+}
+
+void RawTowerGeomTable::build(RawTowerGeomContainer *geom)
+{
+  assert(geom);
+  clear();
+
+  m_caloid = geom->get_calorimeter_id();
+
+  const unsigned int ntowers = geom->size();
+  m_key.reserve(ntowers);
+  m_x.reserve(ntowers);
+  m_y.reserve(ntowers);
+  m_z.reserve(ntowers);
+  m_eta.reserve(ntowers);
+  m_phi.reserve(ntowers);
+
+  int index1_max = -1;
+  int index2_max = -1;
+  m_index1_min = 0xFFF;
+  m_index2_min = 0xFFF;
+
+  RawTowerGeomContainer::ConstRange begin_end = geom->get_tower_geometries();
+  for (RawTowerGeomContainer::ConstIterator iter = begin_end.first; iter != begin_end.second; ++iter)
+  {
+    const RawTowerGeom *tower_geom = iter->second;
+    const RawTowerDefs::keytype key = iter->first;
+
+    m_key.push_back(key);
+    m_x.push_back(tower_geom->get_center_x());
+    m_y.push_back(tower_geom->get_center_y());
+    m_z.push_back(tower_geom->get_center_z());
+    m_eta.push_back(tower_geom->get_eta());
+    m_phi.push_back(tower_geom->get_phi());
+
+    const int index1 = RawTowerDefs::decode_index1(key);
+    const int index2 = RawTowerDefs::decode_index2(key);
+    m_index1_min = min(m_index1_min, index1);
+    m_index2_min = min(m_index2_min, index2);
+    index1_max = max(index1_max, index1);
+    index2_max = max(index2_max, index2);
+  }
+
+  if (m_key.empty())
+  {
+    m_index1_min = 0;
+    m_index2_min = 0;
+    return;
+  }
+
+  // the map is sorted by key, which find_sorted relies on
+  m_n1 = index1_max - m_index1_min + 1;
+  m_n2 = index2_max - m_index2_min + 1;
+  if (static_cast<long>(m_n1) * m_n2 <= kMaxGridSize)
+  {
+    m_grid.assign(m_n1 * m_n2, -1);
+    for (unsigned int i = 0; i < m_key.size(); ++i)
+    {
+      const int i1 = RawTowerDefs::decode_index1(m_key[i]) - m_index1_min;
+      const int i2 = RawTowerDefs::decode_index2(m_key[i]) - m_index2_min;
+      m_grid[i1 * m_n2 + i2] = i;
+    }
+  }
+
+  // towers of a cylindrical calorimeter wrap around in phi (index2)
+  int nphi = 0;
+  const RawTowerGeomContainer_Cylinderv1 *cylinder = dynamic_cast<const RawTowerGeomContainer_Cylinderv1 *>(geom);
+  if (cylinder) nphi = cylinder->get_phibins();
+
+  m_neighbor_offset.reserve(m_key.size() + 1);
+  m_neighbors.reserve(8 * m_key.size());
+  for (unsigned int i = 0; i < m_key.size(); ++i)
+  {
+    const int index1 = RawTowerDefs::decode_index1(m_key[i]);
+    const int index2 = RawTowerDefs::decode_index2(m_key[i]);
+    for (int d1 = -1; d1 <= 1; ++d1)
+    {
+      for (int d2 = -1; d2 <= 1; ++d2)
+      {
+        if (d1 == 0 && d2 == 0) continue;
+
+        const int neighbor_index1 = index1 + d1;
+        int neighbor_index2 = index2 + d2;
+        if (nphi > 2) neighbor_index2 = (neighbor_index2 + nphi) % nphi;
+        if (neighbor_index1 < 0 || neighbor_index1 >= 0xFFF || neighbor_index2 < 0 || neighbor_index2 >= 0xFFF) continue;
+
+        const int neighbor = find(RawTowerDefs::encode_towerid(m_caloid, neighbor_index1, neighbor_index2));
+        if (neighbor >= 0) m_neighbors.push_back(neighbor);
+      }
+    }
+    m_neighbor_offset.push_back(m_neighbors.size());
+  }
+}
+
+double RawTowerGeomTable::get_eta(const int i, const double vx, const double vy, const double vz) const
+{
+  if (vx == 0 && vy == 0 && vz == 0) return m_eta[i];
+
+  const double radius = sqrt((m_x[i] - vx) * (m_x[i] - vx) + (m_y[i] - vy) * (m_y[i] - vy));
+  const double theta = atan2(radius, m_z[i] - vz);
+  return -log(tan(theta / 2.));
+}
+
+int RawTowerGeomTable::find_sorted(RawTowerDefs::keytype key) const
+{
+  vector<RawTowerDefs::keytype>::const_iterator iter = lower_bound(m_key.begin(), m_key.end(), key);
+  if (iter == m_key.end() || *iter != key) return -1;
+  return iter - m_key.begin();
+}
@@ -0,0 +1,91 @@
+#ifndef CALOBASE_RAWTOWERGEOMTABLE_H
+#define CALOBASE_RAWTOWERGEOMTABLE_H
+
+#include "RawTowerDefs.h"
+
+#include <vector>
+
+class RawTowerGeomContainer;
+
+/*! \class RawTowerGeomTable
+    \brief Frozen flat copy of a calorimeter geometry for per event loops
+
+    Built once (e.g. in InitRun) from a RawTowerGeomContainer. Towers are
+    addressed by a dense index from find(), the positions, eta, phi and the
+    neighbor lists are plain arrays, so the per tower cost is an array
+    lookup instead of a std::map search and virtual calls on RawTowerGeom.
+    The table does not follow later changes of the geometry container,
+    call build() again if the geometry changes.
+*/
+class RawTowerGeomTable
+{
+ public:
+  RawTowerGeomTable();
+  explicit RawTowerGeomTable(RawTowerGeomContainer *geom);
+  virtual ~RawTowerGeomTable() {}
+
+  //! copy all towers of geom, replacing the current content
+  void build(RawTowerGeomContainer *geom);
+  void clear();
+
+  bool empty() const { return m_key.empty(); }
+  unsigned int size() const { return m_key.size(); }
+  RawTowerDefs::CalorimeterId get_calorimeter_id() const { return m_caloid; }
+
+  //! index of the tower with this key, -1 if it has no geometry
+  int find(RawTowerDefs::keytype key) const
+  {
+    if (m_grid.empty()) return find_sorted(key);
+    if (RawTowerDefs::decode_caloid(key) != m_caloid) return -1;
+    const int i1 = static_cast<int>(RawTowerDefs::decode_index1(key)) - m_index1_min;
+    const int i2 = static_cast<int>(RawTowerDefs::decode_index2(key)) - m_index2_min;
+    if (i1 < 0 || i1 >= m_n1 || i2 < 0 || i2 >= m_n2) return -1;
+    return m_grid[i1 * m_n2 + i2];
+  }
+
+  //! \name tower properties by index from find(), 0 <= i < size()
+  //@{
+  RawTowerDefs::keytype get_key(const int i) const { return m_key[i]; }
+  double get_center_x(const int i) const { return m_x[i]; }
+  double get_center_y(const int i) const { return m_y[i]; }
+  double get_center_z(const int i) const { return m_z[i]; }
+  double get_eta(const int i) const { return m_eta[i]; }
+  double get_phi(const int i) const { return m_phi[i]; }
+
+  //! eta of the tower center seen from the vertex (vx, vy, vz)
+  double get_eta(const int i, const double vx, const double vy, const double vz) const;
+
+  //! the neighbors of tower i are the indices in [neighbors_begin(i), neighbors_end(i))
+  const int *neighbors_begin(const int i) const { return m_neighbors.data() + m_neighbor_offset[i]; }
+  const int *neighbors_end(const int i) const { return m_neighbors.data() + m_neighbor_offset[i + 1]; }
+  //@}
+
+  //! largest index1 x index2 range stored as a dense grid, sparser geometries use a binary search
+  static const int kMaxGridSize = 1 << 20;
+
+ private:
+  int find_sorted(RawTowerDefs::keytype key) const;
+
+  RawTowerDefs::CalorimeterId m_caloid;
+
+  //! towers in key order
+  std::vector<RawTowerDefs::keytype> m_key;
+  std::vector<double> m_x;
+  std::vector<double> m_y;
+  std::vector<double> m_z;
+  std::vector<double> m_eta;
+  std::vector<double> m_phi;
+
+  //! neighbors sharing an edge or a corner in (index1, index2), index2 wraps around for cylinders
+  std::vector<int> m_neighbor_offset;
+  std::vector<int> m_neighbors;
+
+  //! (index1, index2) => tower index, -1 for no tower
+  std::vector<int> m_grid;
+  int m_index1_min;
+  int m_index2_min;
+  int m_n1;
+  int m_n2;
+};
+
+#endif
@@ -0,0 +1,67 @@
+#include "RawTowerShowerTable.h"
+
+#include <algorithm>
+
+namespace
+{
+  bool EntryLess(const RawTowerShowerTable::Entry &lhs, const RawTowerShowerTable::Entry &rhs)
+  {
+    return (lhs.tower < rhs.tower) || (lhs.tower == rhs.tower && lhs.shower < rhs.shower);
+  }
+  bool EntryTowerLess(const RawTowerShowerTable::Entry &entry, const RawTowerDefs::keytype tower)
+  {
+    return entry.tower < tower;
+  }
+  bool TowerEntryLess(const RawTowerDefs::keytype tower, const RawTowerShowerTable::Entry &entry)
+  {
+    return tower < entry.tower;
+  }
+}  // namespace
+
+void RawTowerShowerTable::Reset()
+{
+  // clear() keeps the capacity for the next event
+  m_entries.clear();
+  m_sorted = true;
+}
+
+void RawTowerShowerTable::identify(std::ostream &os) const
+{
+  os << "RawTowerShowerTable, number of entries: " << m_entries.size() << std::endl;
+}
+
+void RawTowerShowerTable::finalize()
+{
+  if (m_sorted)
+  {
+    return;
+  }
+  std::sort(m_entries.begin(), m_entries.end(), EntryLess);
+
+  // sum the energies of the same tower and shower
+  List::iterator last = m_entries.begin();
+  for (List::iterator iter = m_entries.begin(); iter != m_entries.end(); ++iter)
+  {
+    if (last != m_entries.begin() && (last - 1)->tower == iter->tower && (last - 1)->shower == iter->shower)
+    {
+      (last - 1)->edep += iter->edep;
+    }
+    else
+    {
+      *last++ = *iter;
+    }
+  }
+  m_entries.erase(last, m_entries.end());
+  m_sorted = true;
+}
+
+RawTowerShowerTable::ConstRange RawTowerShowerTable::get_showers(const RawTowerDefs::keytype tower) const
+{
+  if (!m_sorted)
+  {
+    std::cout << "RawTowerShowerTable::get_showers - table is not finalized" << std::endl;
+    return std::make_pair(m_entries.end(), m_entries.end());
+  }
+  return std::make_pair(std::lower_bound(m_entries.begin(), m_entries.end(), tower, EntryTowerLess),
+                        std::upper_bound(m_entries.begin(), m_entries.end(), tower, TowerEntryLess));
+}
@@ -0,0 +1,83 @@
+#ifndef CALOBASE_RAWTOWERSHOWERTABLE_H
+#define CALOBASE_RAWTOWERSHOWERTABLE_H
+
+#include "RawTowerDefs.h"
+
+#include <phool/PHObject.h>
+
+#include <iostream>
+#include <utility>
+#include <vector>
+
+/*! \class RawTowerShowerTable
+    \brief truth shower energy per tower of one calorimeter, in one flat table
+
+    Alternative to the per tower shower maps (RawTower::add_eshower): the
+    (tower key, shower id, energy) entries of all towers are kept in one
+    vector, appended while the towers are built and sorted by tower and
+    shower once by finalize(), which also sums entries of the same tower
+    and shower. The showers of a tower are a contiguous range found by
+    binary search.
+*/
+class RawTowerShowerTable : public PHObject
+{
+ public:
+  struct Entry
+  {
+    RawTowerDefs::keytype tower;
+    int shower;
+    float edep;
+  };
+  typedef std::vector<Entry> List;
+  typedef List::const_iterator ConstIterator;
+  typedef std::pair<ConstIterator, ConstIterator> ConstRange;
+
+  RawTowerShowerTable()
+    : m_sorted(true)
+  {
+  }
+  virtual ~RawTowerShowerTable() {}
+
+  void Reset();
+  int isValid() const { return 1; }
+  void identify(std::ostream &os = std::cout) const;
+
+  void reserve(const unsigned int n) { m_entries.reserve(n); }
+
+  //! adds edep of the shower to the tower
+  void add(const RawTowerDefs::keytype tower, const int shower, const float edep)
+  {
+    Entry entry = {tower, shower, edep};
+    m_entries.push_back(entry);
+    m_sorted = false;
+  }
+
+  //! sorts and merges the entries, to be called once all are added
+  void finalize();
+
+  //! removes the entries of the towers for which keep(tower) is false, the table stays sorted
+  template <class Predicate>
+  void keep_towers(Predicate keep)
+  {
+    List::iterator last = m_entries.begin();
+    for (List::iterator iter = m_entries.begin(); iter != m_entries.end(); ++iter)
+    {
+      if (keep(iter->tower)) *last++ = *iter;
+    }
+    m_entries.erase(last, m_entries.end());
+  }
+
+  //! showers of the tower, sorted by shower id. The table must be finalized
+  ConstRange get_showers(const RawTowerDefs::keytype tower) const;
+
+  unsigned int size() const { return m_entries.size(); }
+  ConstRange get_entries() const { return std::make_pair(m_entries.begin(), m_entries.end()); }
+
+ private:
+  List m_entries;
+  bool m_sorted;  //!
+
+  ClassDef(RawTowerShowerTable, 1)
+};
+
+#endif
@@ -0,0 +1,6 @@
+#ifdef __CINT__
+
+#pragma link C++ class RawTowerShowerTable + ;
+#pragma link C++ struct RawTowerShowerTable::Entry + ;
+
+#endif /* __CINT__ */
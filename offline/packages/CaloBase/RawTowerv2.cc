@@ -0,0 +1,90 @@
+#include "RawTowerv2.h"
+
+#include <half/half.h>
+
+#include <cmath>
+#include <iostream>
+
+using namespace std;
+
+namespace
+{
+  unsigned short FloatToHalfBits(float value)
+  {
+    // saturate instead of overflowing to inf
+    if (value > HALF_MAX)
+    {
+      value = HALF_MAX;
+    }
+    else if (value < -HALF_MAX)
+    {
+      value = -HALF_MAX;
+    }
+    return half(value).bits();
+  }
+
+  float HalfBitsToFloat(const unsigned short bits)
+  {
+    half halfvar;
+    halfvar.setBits(bits);
+    return halfvar;
+  }
+}  // namespace
+
+RawTowerv2::RawTowerv2()
+  : towerid(~0)  // initialize all bits on
+  , energy(FloatToHalfBits(0))
+  , time(FloatToHalfBits(NAN))
+{
+}
+
+RawTowerv2::RawTowerv2(const RawTower& tower)
+  : towerid(tower.get_id())
+  , energy(FloatToHalfBits(tower.get_energy()))
+  , time(FloatToHalfBits(tower.get_time()))
+{
+}
+
+RawTowerv2::RawTowerv2(RawTowerDefs::keytype id)
+  : towerid(id)
+  , energy(FloatToHalfBits(0))
+  , time(FloatToHalfBits(NAN))
+{
+}
+
+void RawTowerv2::Reset()
+{
+  energy = FloatToHalfBits(0);
+  time = FloatToHalfBits(NAN);
+}
+
+int RawTowerv2::isValid() const
+{
+  return get_energy() != 0;
+}
+
+void RawTowerv2::identify(std::ostream& os) const
+{
+  os << "RawTowerv2: etabin: " << get_bineta() << ", phibin: " << get_binphi()
+     << " energy=" << get_energy() << std::endl;
+}
+
+double RawTowerv2::get_energy() const
+{
+  return HalfBitsToFloat(energy);
+}
+
+void RawTowerv2::set_energy(const double e)
+{
+  energy = FloatToHalfBits(e);
+}
+
+float RawTowerv2::get_time() const
+{
+  return HalfBitsToFloat(time);
+}
+
+void RawTowerv2::set_time(const float t)
+{
+  time = FloatToHalfBits(t);
+}
@@ -0,0 +1,50 @@
+#ifndef CALOBASE_RAWTOWERV2_H
+#define CALOBASE_RAWTOWERV2_H
+
+#include "RawTower.h"
+
+#include "RawTowerDefs.h"
+
+#include <iostream>
+
+/*!
+  \brief compact tower for mini DSTs
+
+  energy and time are stored as 16 bit half floats (relative precision 5e-4,
+  range up to 65504) and there is no truth information. Since every set_energy()
+  rounds to half precision this class is meant for final (calibrated) towers,
+  not for towers which are summed up hit by hit
+*/
+class RawTowerv2 : public RawTower
+{
+ public:
+  RawTowerv2();
+  RawTowerv2(const RawTower& tower);
+  RawTowerv2(RawTowerDefs::keytype id);
+  virtual ~RawTowerv2() {}
+
+  void Reset();
+  int isValid() const;
+  void identify(std::ostream& os = std::cout) const;
+
+  void set_id(RawTowerDefs::keytype id) { towerid = id; }
+  RawTowerDefs::keytype get_id() const { return towerid; }
+  int get_bineta() const { return RawTowerDefs::decode_index1(towerid); }
+  int get_binphi() const { return RawTowerDefs::decode_index2(towerid); }
+  double get_energy() const;
+  void set_energy(const double e);
+  float get_time() const;
+  void set_time(const float t);
+
+ protected:
+  RawTowerDefs::keytype towerid;
+
+  //! energy assigned to the tower (half bits)
+  unsigned short energy;
+  //! time stamp assigned to the tower (half bits)
+  unsigned short time;
+
+  ClassDef(RawTowerv2, 1)
+};
+
+#endif
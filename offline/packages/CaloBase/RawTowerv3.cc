@@ -0,0 +1,48 @@
+#include "RawTowerv3.h"
+
+#include <cmath>
+#include <iostream>
+
+using namespace std;
+
+RawTowerv3::RawTowerv3()
+  : towerid(~0)  // initialize all bits on
+  , energy(0)
+  , time(NAN)
+  , status(0)
+{
+}
+
+RawTowerv3::RawTowerv3(const RawTower& tower)
+  : towerid(tower.get_id())
+  , energy(tower.get_energy())
+  , time(tower.get_time())
+  , status(tower.get_status())
+{
+}
+
+RawTowerv3::RawTowerv3(RawTowerDefs::keytype id)
+  : towerid(id)
+  , energy(0)
+  , time(NAN)
+  , status(0)
+{
+}
+
+void RawTowerv3::Reset()
+{
+  energy = 0;
+  time = NAN;
+  status = 0;
+}
+
+int RawTowerv3::isValid() const
+{
+  return get_energy() != 0;
+}
+
+void RawTowerv3::identify(std::ostream& os) const
+{
+  os << "RawTowerv3: etabin: " << get_bineta() << ", phibin: " << get_binphi()
+     << " energy=" << get_energy() << " status=" << get_status() << std::endl;
+}
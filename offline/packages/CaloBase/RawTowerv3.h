@@ -0,0 +1,60 @@
+#ifndef CALOBASE_RAWTOWERV3_H
+#define CALOBASE_RAWTOWERV3_H
+
+#include "RawTower.h"
+
+#include "RawTowerDefs.h"
+
+#include <iostream>
+
+/*!
+  \brief tower with energy, time and status only
+
+  Same precision as RawTowerv1 but without the cell and shower maps, so a
+  tower is a few plain members on the DST. The truth contributions of these
+  towers, if kept at all, are in the RawTowerCellTable and RawTowerShowerTable
+  nodes of the calorimeter (TOWERCELL_... and TOWERSHOWER_...), which can be
+  written or dropped independently of the towers.
+*/
+class RawTowerv3 : public RawTower
+{
+ public:
+  RawTowerv3();
+  RawTowerv3(const RawTower& tower);
+  RawTowerv3(RawTowerDefs::keytype id);
+  virtual ~RawTowerv3() {}
+
+  void Reset();
+  int isValid() const;
+  void identify(std::ostream& os = std::cout) const;
+
+  void set_id(RawTowerDefs::keytype id) { towerid = id; }
+  RawTowerDefs::keytype get_id() const { return towerid; }
+  int get_bineta() const { return RawTowerDefs::decode_index1(towerid); }
+  int get_binphi() const { return RawTowerDefs::decode_index2(towerid); }
+  double get_energy() const { return energy; }
+  void set_energy(const double e) { energy = e; }
+  float get_time() const { return time; }
+  void set_time(const float t) { time = t; }
+  unsigned int get_status() const { return status; }
+  void set_status(const unsigned int s) { status = s; }
+
+  //! cells are not stored, use RawTowerCellTable
+  void add_ecell(const CellKeyType, const float) {}
+  //! showers are not stored, use RawTowerShowerTable
+  void add_eshower(const int, const float) {}
+
+ protected:
+  RawTowerDefs::keytype towerid;
+
+  //! energy assigned to the tower, see RawTowerv1
+  float energy;
+  //! time stamp assigned to the tower
+  float time;
+  //! quality/status bits
+  unsigned int status;
+
+  ClassDef(RawTowerv3, 1)
+};
+
+#endif
@@ -0,0 +1,5 @@
+#ifdef __CINT__
+
+#pragma link C++ class RawTowerv3 + ;
+
+#endif /* __CINT__ */
@@ -1,6 +1,7 @@
 #include "BEmcProfile.h"
 #include "BEmcCluster.h"
 
+#include <TAxis.h>
 #include <TFile.h>
 #include <TH1.h>  // for TH1F
 #include <TMath.h>
@@ -106,6 +107,20 @@ BEmcProfile::BEmcProfile(const char* fname)
   }
 
   f->Close();
+
+  for (int i = 0; i < nth * nen * NP; i++)
+  {
+    int nbins = hmean[i]->GetNbinsX();
+    content_offset.push_back(mean_content.size());
+    content_nbins.push_back(nbins);
+    for (int ibin = 0; ibin <= nbins + 1; ibin++)
+    {
+      mean_content.push_back(hmean[i]->GetBinContent(ibin));
+      // read over the hmean[i] bins, GetBinContent() clamps like GetContent()
+      sigma_content.push_back(hsigma[i]->GetBinContent(ibin));
+    }
+  }
+
   bloaded = true;
 }
 
@@ -409,27 +424,27 @@ void BEmcProfile::PredictEnergy(int ip, float energy, float theta, float phi, fl
   int ii12 = ip + ie1 * NP + it2 * nen * NP;
   int ii22 = ip + ie2 * NP + it2 * nen * NP;
 
-  int ibin = hmean[ii11]->FindBin(xx);
+  int ibin = hmean[ii11]->GetXaxis()->FindFixBin(xx);
 
   // Log (1/sqrt) energy dependence of mean (sigma)
   //
-  float pr11 = hmean[ii11]->GetBinContent(ibin);
-  float pr21 = hmean[ii21]->GetBinContent(ibin);
+  float pr11 = GetMean(ii11, ibin);
+  float pr21 = GetMean(ii21, ibin);
   float prt1 = pr11 + (pr21 - pr11) / (log(en2) - log(en1)) * (log(energy) - log(en1));
   if (prt1 < 0) prt1 = 0;
 
-  float er11 = hsigma[ii11]->GetBinContent(ibin);
-  float er21 = hsigma[ii21]->GetBinContent(ibin);
+  float er11 = GetSigma(ii11, ibin);
+  float er21 = GetSigma(ii21, ibin);
   float ert1 = er11 + (er21 - er11) / (1. / sqrt(en2) - 1. / sqrt(en1)) * (1. / sqrt(energy) - 1. / sqrt(en1));
   if (ert1 < 0) ert1 = 0;
 
-  float pr12 = hmean[ii12]->GetBinContent(ibin);
-  float pr22 = hmean[ii22]->GetBinContent(ibin);
+  float pr12 = GetMean(ii12, ibin);
+  float pr22 = GetMean(ii22, ibin);
   float prt2 = pr12 + (pr22 - pr12) / (log(en2) - log(en1)) * (log(energy) - log(en1));
   if (prt2 < 0) prt2 = 0;
 
-  float er12 = hsigma[ii12]->GetBinContent(ibin);
-  float er22 = hsigma[ii22]->GetBinContent(ibin);
+  float er12 = GetSigma(ii12, ibin);
+  float er22 = GetSigma(ii22, ibin);
   float ert2 = er12 + (er22 - er12) / (1. / sqrt(en2) - 1. / sqrt(en1)) * (1. / sqrt(energy) - 1. / sqrt(en1));
   if (ert2 < 0) ert2 = 0;
 
@@ -445,10 +460,10 @@ void BEmcProfile::PredictEnergy(int ip, float energy, float theta, float phi, fl
   int ibin1 = ibin;
   if( ibin>1 ) ibin1 = ibin-1;
   int ibin2 = ibin;
-  if( ibin < hmean[ii11]->GetNbinsX() )
-    if( hmean[ii11]->GetBinContent(ibin+1) > 0 ) ibin2 = ibin+1;
-  float dd = (hmean[ii11]->GetBinContent(ibin2) -
-              hmean[ii11]->GetBinContent(ibin1) ) / 2.;
+  if( ibin < content_nbins[ii11] )
+    if( GetMean(ii11, ibin+1) > 0 ) ibin2 = ibin+1;
+  float dd = (GetMean(ii11, ibin2) -
+              GetMean(ii11, ibin1) ) / 2.;
   //  if( fabs(dd)>er ) printf("ie=%d it=%d bin=%d: %f %f\n",ie1,it1,ibin,er,dd);
   er = sqrt(er*er + dd*dd);
 
@@ -16,6 +16,16 @@ public:
   //  float GetProbTest(std::vector<EmcModule>* plist, int NX, float en, float theta, float& test_rr, float& test_et, float& test_ep, float& test_err);
 
 protected:
+  // bin content of the flattened hmean/hsigma histogram ii, clamped to its bin range like TH1::GetBinContent
+  float GetMean(int ii, int ibin) const { return GetContent(mean_content, ii, ibin); }
+  float GetSigma(int ii, int ibin) const { return GetContent(sigma_content, ii, ibin); }
+  float GetContent(const std::vector<float>& content, int ii, int ibin) const
+  {
+    if (ibin < 0) ibin = 0;
+    if (ibin > content_nbins[ii] + 1) ibin = content_nbins[ii] + 1;
+    return content[content_offset[ii] + ibin];
+  }
+
   bool bloaded;
 
   float thresh;
@@ -27,4 +37,11 @@ protected:
 
   TH1F* *hmean;
   TH1F* *hsigma;
+
+  // Contents of hmean and hsigma (including under/overflow) copied at load time,
+  // so PredictEnergy() only reads plain arrays and can be used from several threads
+  std::vector<float> mean_content;
+  std::vector<float> sigma_content;
+  std::vector<int> content_offset;
+  std::vector<int> content_nbins;
 };
@@ -23,6 +23,10 @@ using namespace std;
 // Max number of clusters, used in FindClusters(), automatically extended when needed
 int const BEmcRec::fgMaxLen = 1000;
 
+// Shower profile table, covers the distances seen in cluster splitting
+float const BEmcRec::fgProfileTableStep = 1. / 4096;
+float const BEmcRec::fgProfileTableMaxR = 4;
+
 
 // ///////////////////////////////////////////////////////////////////////////
 // BEmcRec member functions
@@ -41,6 +45,10 @@ BEmcRec::BEmcRec()
   fTowerGeom.clear();
   fModules = new vector<EmcModule>;
   fClusters = new vector<EmcCluster>;
+
+  int nbins = int(fgProfileTableMaxR / fgProfileTableStep) + 1;
+  fProfileTable.resize(nbins);
+  for (int i = 0; i < nbins; i++) fProfileTable[i] = ShowerProfile(i * fgProfileTableStep);
 }
 
 // ///////////////////////////////////////////////////////////////////////////
@@ -529,13 +537,41 @@ float BEmcRec::PredictEnergy(float xc, float yc, float en)
   // Calculates the energy deposited in the tower, the distance between
   // its center and shower Center of Gravity being (xc,yc)
   // en - shower energy
+  //
+  // The profile does not depend on en (yet), so it is interpolated
+  // from the table filled in the ctor; the parametrization itself
+  // is in ShowerProfile()
 
-  float dx, dy, r1, r2, r3;
-  float fPpar1, fPpar2, fPpar3, fPpar4;
+  float dx, dy, r1, r2;
 
   float fPshiftx = 0;  // !!!!! Untill tuned ... may not be necessary
   float fPshifty = 0;  // !!!!! Untill tuned ... may not be necessary
 
+  //  if (en > 0) SetProfileParameters(-1, en, xc, yc);
+
+  dx = fabs(xc - fPshiftx);
+  dy = fabs(yc - fPshifty);
+  r2 = dx * dx + dy * dy;
+  r1 = sqrt(r2);
+
+  float rbin = r1 / fgProfileTableStep;
+  int ibin = int(rbin);
+  if (ibin + 1 >= int(fProfileTable.size())) return ShowerProfile(r1);
+
+  float frac = rbin - ibin;
+  return fProfileTable[ibin] + frac * (fProfileTable[ibin + 1] - fProfileTable[ibin]);
+}
+
+// ///////////////////////////////////////////////////////////////////////////
+
+float BEmcRec::ShowerProfile(float r1)
+{
+  // Energy fraction deposited in the tower at distance r1 from the shower
+  // Center of Gravity (in tower units)
+
+  float r3;
+  float fPpar1, fPpar2, fPpar3, fPpar4;
+
   /*
   float lgE;
   if (en <= 1.e-10)
@@ -564,13 +600,7 @@ float BEmcRec::PredictEnergy(float xc, float yc, float en)
   fPpar4 = 0.548;
   */
 
-  //  if (en > 0) SetProfileParameters(-1, en, xc, yc);
-
-  dx = fabs(xc - fPshiftx);
-  dy = fabs(yc - fPshifty);
-  r2 = dx * dx + dy * dy;
-  r1 = sqrt(r2);
-  r3 = r2 * r1;
+  r3 = r1 * r1 * r1;
   double e = fPpar1 * exp(-r3 / fPpar2) + fPpar3 * exp(-r1 / fPpar4);
 
   return e;
@@ -73,6 +73,8 @@ class BEmcRec
   void Tower2Global(float E, float xC, float yC, float &xA, float &yA, float &zA);
 
   virtual float PredictEnergy(float, float, float);
+  // Shower profile parametrization vs distance from the shower center (tower units)
+  static float ShowerProfile(float r);
 
   // Calorimeter specific functions to be specified in respective inherited object
   virtual void CorrectEnergy(float energy, float x, float y, float* ecorr) {*ecorr=energy;}
@@ -109,6 +111,11 @@ class BEmcRec
   //  static float const fgMinShowerEnergy;
   static int const fgMaxLen;
 
+  // ShowerProfile() tabulated in r, filled in the ctor and interpolated in PredictEnergy()
+  std::vector<float> fProfileTable;
+  static float const fgProfileTableStep;
+  static float const fgProfileTableMaxR;
+
   //  BEmcProfile *_emcprof;
 
  private:
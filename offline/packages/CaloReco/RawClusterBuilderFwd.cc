@@ -5,12 +5,13 @@
 #include <calobase/RawCluster.h>
 #include <calobase/RawClusterContainer.h>
 #include <calobase/RawClusterDefs.h>
-#include <calobase/RawClusterv1.h>
 #include <calobase/RawTower.h>
 #include <calobase/RawTowerContainer.h>
 #include <calobase/RawTowerDefs.h>
 #include <calobase/RawTowerGeom.h>
 #include <calobase/RawTowerGeomContainer.h>
+#include <calobase/RawTowerGeomContainer_Cylinderv1.h>
+#include <calobase/RawTowerGeomTable.h>
 
 #include <fun4all/Fun4AllReturnCodes.h>
 #include <fun4all/SubsysReco.h>
@@ -22,7 +23,9 @@
 #include <phool/PHNodeIterator.h>
 #include <phool/PHObject.h>
 #include <phool/phool.h>
+#include <phool/recoConsts.h>
 
+#include <algorithm>
 #include <cassert>
 #include <cmath>
 #include <exception>
@@ -95,14 +98,18 @@ bool operator<(const twrs_fwd &a, const twrs_fwd &b)
 RawClusterBuilderFwd::RawClusterBuilderFwd(const std::string &name)
   : SubsysReco(name)
   , _clusters(nullptr)
+  , m_ClusterVersion(1)
   , _min_tower_e(0.0)
   , chkenergyconservation(0)
+  , m_FloatPrecision(-1)
   , detector("NONE")
 {
 }
 
 int RawClusterBuilderFwd::InitRun(PHCompositeNode *topNode)
 {
+  m_ClusterVersion = RawClusterContainer::ClusterVersion();
+
   try
   {
     CreateNodes(topNode);
@@ -113,6 +120,31 @@ int RawClusterBuilderFwd::InitRun(PHCompositeNode *topNode)
     throw;
   }
 
+  // without the geometry here every event goes through the pairwise clustering
+  string towergeomnodename = "TOWERGEOM_" + detector;
+  RawTowerGeomContainer *towergeom = findNode::getClass<RawTowerGeomContainer>(topNode, towergeomnodename.c_str());
+  // the table wraps cylinders around in phi, the forward clustering never does
+  if (towergeom && !dynamic_cast<RawTowerGeomContainer_Cylinderv1 *>(towergeom))
+  {
+    _geom_table.build(towergeom);
+  }
+  else
+  {
+    _geom_table.clear();
+  }
+  _tower_label.assign(_geom_table.size(), -2);
+  _tower_e.assign(_geom_table.size(), 0);
+
+  if (m_FloatPrecision < 0)
+  {
+    recoConsts *rc = recoConsts::instance();
+    m_FloatPrecision = (rc->FlagExist("RECO_FLOAT_PRECISION") && rc->get_IntFlag("RECO_FLOAT_PRECISION")) ? 1 : 0;
+  }
+  if (Verbosity() > 0 && m_FloatPrecision)
+  {
+    cout << "RawClusterBuilderFwd: cluster sums are done in float precision" << endl;
+  }
+
   return Fun4AllReturnCodes::EVENT_OK;
 }
 
@@ -133,6 +165,164 @@ int RawClusterBuilderFwd::process_event(PHCompositeNode *topNode)
     cout << PHWHERE << ": Could not find node " << towergeomnodename.c_str() << endl;
     return Fun4AllReturnCodes::ABORTEVENT;
   }
+  if (!ClusterGrid(towers))
+  {
+    ClusterPairs(towers, towergeom);
+  }
+
+  if (chkenergyconservation)
+  {
+    double ecluster = _clusters->getTotalEdep();
+    double etower = towers->getTotalEdep();
+    if (ecluster > 0)
+    {
+      // float sums are good to about 1e-7 per tower
+      const double tolerance = (m_FloatPrecision > 0) ? 1e-5 : 1e-9;
+      if (fabs(etower - ecluster) / ecluster > tolerance)
+      {
+        cout << "energy conservation violation: ETower: " << etower
+             << " ECluster: " << ecluster
+             << " diff: " << etower - ecluster << endl;
+      }
+    }
+    else
+    {
+      if (etower != 0)
+      {
+        cout << "energy conservation violation: ETower: " << etower
+             << " ECluster: " << ecluster << endl;
+      }
+    }
+  }
+  return Fun4AllReturnCodes::EVENT_OK;
+}
+
+bool RawClusterBuilderFwd::ClusterGrid(RawTowerContainer *towers)
+{
+  if (_geom_table.empty())
+  {
+    return false;
+  }
+  // towers above threshold as geometry table index, the table is sorted by key
+  // which orders the towers by (j, k) like the pairwise clustering does
+  _seeds.clear();
+  RawTowerContainer::ConstRange begin_end = towers->getTowers();
+  for (RawTowerContainer::ConstIterator itr = begin_end.first; itr != begin_end.second; ++itr)
+  {
+    const double e = itr->second->get_energy();
+    if (e > _min_tower_e)
+    {
+      const int itower = _geom_table.find(itr->first);
+      if (itower < 0)
+      {
+        for (int i : _seeds)
+        {
+          _tower_label[i] = -2;
+        }
+        if (Verbosity() > 0)
+        {
+          cout << PHWHERE << " tower " << itr->first << " has no geometry, using the pairwise clustering" << endl;
+        }
+        return false;
+      }
+      _tower_label[itower] = -1;
+      _tower_e[itower] = e;
+      _seeds.push_back(itower);
+    }
+  }
+  sort(_seeds.begin(), _seeds.end());
+
+  // connected components over the edge and corner neighbors of the table,
+  // clusters are numbered by their first tower as in PHMakeGroups
+  int nclusters = 0;
+  for (int seed : _seeds)
+  {
+    if (_tower_label[seed] != -1)
+    {
+      continue;
+    }
+    _members.clear();
+    _stack.assign(1, seed);
+    _tower_label[seed] = nclusters;
+    while (!_stack.empty())
+    {
+      const int itower = _stack.back();
+      _stack.pop_back();
+      _members.push_back(itower);
+      for (const int *neighbor = _geom_table.neighbors_begin(itower); neighbor != _geom_table.neighbors_end(itower); ++neighbor)
+      {
+        if (_tower_label[*neighbor] == -1)
+        {
+          _tower_label[*neighbor] = nclusters;
+          _stack.push_back(*neighbor);
+        }
+      }
+    }
+    ++nclusters;
+    // same summation order as the tower map of the cluster
+    sort(_members.begin(), _members.end());
+
+    RawCluster *cluster = RawClusterContainer::NewCluster(m_ClusterVersion);
+    _clusters->AddCluster(cluster);
+    if (m_FloatPrecision > 0)
+    {
+      FillCluster<float>(cluster);
+    }
+    else
+    {
+      FillCluster<double>(cluster);
+    }
+
+    if (Verbosity() > 1)
+    {
+      cout << "RawClusterBuilder constucted ";
+      cluster->identify();
+    }
+  }
+
+  for (int i : _seeds)
+  {
+    _tower_label[i] = -2;
+  }
+  return true;
+}
+
+template <typename Scalar>
+void RawClusterBuilderFwd::FillCluster(RawCluster *cluster) const
+{
+  Scalar sum_x(0);
+  Scalar sum_y(0);
+  Scalar sum_z(0);
+  Scalar sum_e(0);
+  for (int itower : _members)
+  {
+    cluster->addTower(_geom_table.get_key(itower), _tower_e[itower]);
+    const Scalar e = _tower_e[itower];
+    sum_e += e;
+    if (e > 0)
+    {
+      sum_x += e * static_cast<Scalar>(_geom_table.get_center_x(itower));
+      sum_y += e * static_cast<Scalar>(_geom_table.get_center_y(itower));
+      sum_z += e * static_cast<Scalar>(_geom_table.get_center_z(itower));
+    }
+  }
+
+  cluster->set_energy(sum_e);
+
+  if (sum_e > 0)
+  {
+    sum_x /= sum_e;
+    sum_y /= sum_e;
+    sum_z /= sum_e;
+
+    cluster->set_r(sqrt(sum_y * sum_y + sum_x * sum_x));
+    cluster->set_phi(atan2(sum_y, sum_x));
+    cluster->set_z(sum_z);
+  }
+}
+
+void RawClusterBuilderFwd::ClusterPairs(RawTowerContainer *towers, RawTowerGeomContainer *towergeom)
+{
   // make the list of towers above threshold
   std::vector<twrs_fwd> towerVector;
   RawTowerContainer::ConstRange begin_end = towers->getTowers();
@@ -164,7 +354,7 @@ int RawClusterBuilderFwd::process_event(PHCompositeNode *topNode)
     if (last_id != clusterid)
     {
       // new cluster
-      cluster = new RawClusterv1();
+      cluster = RawClusterContainer::NewCluster(m_ClusterVersion);
       _clusters->AddCluster(cluster);
 
       last_id = clusterid;
@@ -229,29 +419,6 @@ int RawClusterBuilderFwd::process_event(PHCompositeNode *topNode)
       cluster->identify();
     }
   }  //  for (const auto & cluster_pair : _clusters->getClustersMap())
-  if (chkenergyconservation)
-  {
-    double ecluster = _clusters->getTotalEdep();
-    double etower = towers->getTotalEdep();
-    if (ecluster > 0)
-    {
-      if (fabs(etower - ecluster) / ecluster > 1e-9)
-      {
-        cout << "energy conservation violation: ETower: " << etower
-             << " ECluster: " << ecluster
-             << " diff: " << etower - ecluster << endl;
-      }
-    }
-    else
-    {
-      if (etower != 0)
-      {
-        cout << "energy conservation violation: ETower: " << etower
-             << " ECluster: " << ecluster << endl;
-      }
-    }
-  }
-  return Fun4AllReturnCodes::EVENT_OK;
 }
 
 bool RawClusterBuilderFwd::CorrectPhi(RawCluster *cluster, RawTowerContainer *towers, RawTowerGeomContainer *towergeom)
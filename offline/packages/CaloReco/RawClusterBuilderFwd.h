@@ -1,9 +1,12 @@
 #ifndef CALORECO_RAWCLUSTERBUILDERFWD_H
 #define CALORECO_RAWCLUSTERBUILDERFWD_H
 
+#include <calobase/RawTowerGeomTable.h>
+
 #include <fun4all/SubsysReco.h>
 
 #include <string>
+#include <vector>
 
 class PHCompositeNode;
 class RawCluster;
@@ -24,15 +27,39 @@ class RawClusterBuilderFwd : public SubsysReco
 
   void set_threshold_energy(const float e) { _min_tower_e = e; }
   void checkenergy(const int i = 1) { chkenergyconservation = i; }
+  //! sum the cluster energies and positions in float instead of double, default from the RECO_FLOAT_PRECISION flag
+  void FloatPrecision(const bool b) { m_FloatPrecision = b ? 1 : 0; }
 
  private:
   void CreateNodes(PHCompositeNode *topNode);
+  //! connected towers on the index grid of the geometry table, false if a tower has no geometry
+  bool ClusterGrid(RawTowerContainer *towers);
+#if !defined(__CINT__) || defined(__CLING__)
+  //! energy and position of the cluster of the towers in _members, the sums are done in Scalar
+  template <typename Scalar>
+  void FillCluster(RawCluster *cluster) const;
+#endif
+  //! pairwise adjacency test of all towers above threshold
+  void ClusterPairs(RawTowerContainer *towers, RawTowerGeomContainer *towergeom);
   bool CorrectPhi(RawCluster *cluster, RawTowerContainer *towers, RawTowerGeomContainer *towergemom);
 
   RawClusterContainer *_clusters;
+  //! RawCluster version created, RawClusterContainer::ClusterVersion()
+  int m_ClusterVersion;
+
+  //! tower positions and neighbors, built in InitRun
+  RawTowerGeomTable _geom_table;
+  //! per geometry table index: -2 below threshold, -1 not yet clustered, else cluster number
+  std::vector<int> _tower_label;
+  std::vector<double> _tower_e;
+  std::vector<int> _seeds;
+  std::vector<int> _stack;
+  std::vector<int> _members;
 
   float _min_tower_e;
   int chkenergyconservation;
+  //! -1: take it from the RECO_FLOAT_PRECISION flag
+  int m_FloatPrecision;
 
   std::string detector;
   std::string ClusterNodeName;
@@ -4,12 +4,10 @@
 
 #include <calobase/RawClusterContainer.h>
 #include <calobase/RawCluster.h>
-#include <calobase/RawClusterv1.h>
 #include <calobase/RawClusterDefs.h>
 #include <calobase/RawTower.h>
 #include <calobase/RawTowerContainer.h>
 #include <calobase/RawTowerDefs.h>
-#include <calobase/RawTowerGeom.h>
 #include <calobase/RawTowerGeomContainer.h>
 
 #include <fun4all/Fun4AllReturnCodes.h>
@@ -115,6 +113,8 @@ bool operator<(const twrs &a, const twrs &b)
 RawClusterBuilderGraph::RawClusterBuilderGraph(const std::string &name)
   : SubsysReco(name)
   , _clusters(nullptr)
+  , m_ClusterVersion(1)
+  , _maxphibin(-10)
   , _min_tower_e(0.0)
   , chkenergyconservation(0)
   , detector("NONE")
@@ -123,6 +123,8 @@ RawClusterBuilderGraph::RawClusterBuilderGraph(const std::string &name)
 
 int RawClusterBuilderGraph::InitRun(PHCompositeNode *topNode)
 {
+  m_ClusterVersion = RawClusterContainer::ClusterVersion();
+
   try
   {
     CreateNodes(topNode);
@@ -133,6 +135,20 @@ int RawClusterBuilderGraph::InitRun(PHCompositeNode *topNode)
     throw;
   }
 
+  string towergeomnodename = "TOWERGEOM_" + detector;
+  RawTowerGeomContainer *towergeom = findNode::getClass<RawTowerGeomContainer>(topNode, towergeomnodename.c_str());
+  if (!towergeom)
+  {
+    cout << PHWHERE << ": Could not find node " << towergeomnodename.c_str() << endl;
+    return Fun4AllReturnCodes::ABORTRUN;
+  }
+  _geom_table.build(towergeom);
+  _maxphibin = towergeom->get_phibins();
+
+  // the tower positions are cached, only the towers are read per event
+  DeclareInputNode("TOWER_CALIB_" + detector);
+  DeclareOutputNode(ClusterNodeName);
+
   return Fun4AllReturnCodes::EVENT_OK;
 }
 
@@ -146,13 +162,6 @@ int RawClusterBuilderGraph::process_event(PHCompositeNode *topNode)
     std::cout << PHWHERE << ": Could not find node " << towernodename.c_str() << std::endl;
     return Fun4AllReturnCodes::DISCARDEVENT;
   }
-  string towergeomnodename = "TOWERGEOM_" + detector;
-  RawTowerGeomContainer *towergeom = findNode::getClass<RawTowerGeomContainer>(topNode, towergeomnodename.c_str());
-  if (!towergeom)
-  {
-    cout << PHWHERE << ": Could not find node " << towergeomnodename.c_str() << endl;
-    return Fun4AllReturnCodes::ABORTEVENT;
-  }
   // make the list of towers above threshold
   std::vector<twrs> towerVector;
   RawTowerContainer::ConstRange begin_end = towers->getTowers();
@@ -164,7 +173,7 @@ int RawClusterBuilderGraph::process_event(PHCompositeNode *topNode)
     if (tower->get_energy() > _min_tower_e)
     {
       twrs twr(tower);
-      twr.set_maxphibin(towergeom->get_phibins());
+      twr.set_maxphibin(_maxphibin);
       twr.set_id(towerid);
       towerVector.push_back(twr);
     }
@@ -185,7 +194,7 @@ int RawClusterBuilderGraph::process_event(PHCompositeNode *topNode)
     if (last_id != clusterid)
     {
       // new cluster
-      cluster = new RawClusterv1();
+      cluster = RawClusterContainer::NewCluster(m_ClusterVersion);
       _clusters->AddCluster(cluster);
 
       last_id = clusterid;
@@ -215,19 +224,19 @@ int RawClusterBuilderGraph::process_event(PHCompositeNode *topNode)
     for (const auto tower_pair : cluster->get_towermap())
     {
       const RawTower *rawtower = towers->getTower(tower_pair.first);
-      const RawTowerGeom *rawtowergeom = towergeom->get_tower_geometry(tower_pair.first);
+      const int itower = _geom_table.find(tower_pair.first);
 
       assert(rawtower);
-      assert(rawtowergeom);
+      assert(itower >= 0);
       const double e = rawtower->get_energy();
 
       sum_e += e;
 
       if (e > 0)
       {
-        sum_x += e * rawtowergeom->get_center_x();
-        sum_y += e * rawtowergeom->get_center_y();
-        sum_z += e * rawtowergeom->get_center_z();
+        sum_x += e * _geom_table.get_center_x(itower);
+        sum_y += e * _geom_table.get_center_y(itower);
+        sum_z += e * _geom_table.get_center_z(itower);
       }
     }  //     for (const auto tower_pair : cluster->get_towermap())
 
@@ -1,6 +1,8 @@
 #ifndef CALORECO_RAWCLUSTERBUILDER_H
 #define CALORECO_RAWCLUSTERBUILDER_H
 
+#include <calobase/RawTowerGeomTable.h>
+
 #include <fun4all/SubsysReco.h>
 
 #include <string>
@@ -17,6 +19,9 @@ class RawClusterBuilderGraph : public SubsysReco
   int InitRun(PHCompositeNode *topNode);
   int process_event(PHCompositeNode *topNode);
   int End(PHCompositeNode *topNode);
+
+  //! only reads the towers and fills its own cluster node, the node names are declared in InitRun
+  bool ThreadSafe() const { return true; }
   void Detector(const std::string &d) { detector = d; }
 
   void set_threshold_energy(const float e) { _min_tower_e = e; }
@@ -26,6 +31,12 @@ class RawClusterBuilderGraph : public SubsysReco
   void CreateNodes(PHCompositeNode *topNode);
 
   RawClusterContainer *_clusters;
+  //! RawCluster version created, RawClusterContainer::ClusterVersion()
+  int m_ClusterVersion;
+
+  //! tower positions, built in InitRun
+  RawTowerGeomTable _geom_table;
+  int _maxphibin;
 
   float _min_tower_e;
   int chkenergyconservation;
@@ -9,7 +9,6 @@
 
 #include <calobase/RawClusterContainer.h>
 #include <calobase/RawCluster.h>
-#include <calobase/RawClusterv1.h>
 #include <calobase/RawTower.h>
 #include <calobase/RawTowerContainer.h>
 #include <calobase/RawTowerDefs.h>
@@ -27,12 +26,14 @@
 #include <phool/PHObject.h>
 #include <phool/phool.h>
 
+#include <atomic>
 #include <cmath>
 #include <iostream>
 #include <cstdio>
 #include <exception>
 #include <map>
 #include <stdexcept>
+#include <thread>
 #include <utility>
 #include <vector>
 
@@ -46,10 +47,12 @@ RawClusterBuilderTemplate::~RawClusterBuilderTemplate()
 RawClusterBuilderTemplate::RawClusterBuilderTemplate(const std::string &name)
   : SubsysReco(name)
   , _clusters(nullptr)
+  , m_ClusterVersion(1)
   , _min_tower_e(0.020)
   , chkenergyconservation(0)
   , detector("NONE")
   , bPrintGeom(false)
+  , _nthreads(1)
 {
   bemc = nullptr;
 
@@ -121,6 +124,8 @@ void RawClusterBuilderTemplate::SetPlanarGeometry()
 
 int RawClusterBuilderTemplate::InitRun(PHCompositeNode *topNode)
 {
+  m_ClusterVersion = RawClusterContainer::ClusterVersion();
+
   if( bemc == nullptr ) {
     printf("Error in RawClusterBuilderTemplate::InitRun(): detector is not defined; use RawClusterBuilderTemplate::Detector() to define it\n");
     return Fun4AllReturnCodes::ABORTEVENT;
@@ -201,6 +206,10 @@ int RawClusterBuilderTemplate::InitRun(PHCompositeNode *topNode)
     //    PrintCylGeom(towergeom,"phieta.txt");
   }
 
+  DeclareInputNode("TOWER_CALIB_" + detector);
+  DeclareInputNode(towergeomnodename);
+  DeclareOutputNode(ClusterNodeName);
+
   return Fun4AllReturnCodes::EVENT_OK;
 }
 
@@ -266,7 +275,7 @@ int RawClusterBuilderTemplate::process_event(PHCompositeNode *topNode)
   EmcModule vhit;
   std::vector<EmcModule> HitList;
   HitList.erase(HitList.begin(), HitList.end());
-  int ich, ix, iy;
+  int ich;
 
   for (; itr != begin_end.second; ++itr)
   {
@@ -306,107 +315,146 @@ int RawClusterBuilderTemplate::process_event(PHCompositeNode *topNode)
 
   // Get pointer to clusters
   std::vector<EmcCluster> *ClusterList = bemc->GetClusters();
-  std::vector<EmcCluster>::iterator pc;
+  int nclusters = ClusterList->size();
 
-  std::vector<EmcCluster>::iterator pp;
-  float ecl, ecore, xcg, ycg, xx, xy, yy;
-  //  float xcorr, ycorr;
-  EmcModule hmax;
-  RawCluster *cluster;
+  RawTowerDefs::CalorimeterId caloid = towers->getCalorimeterID();
 
-  std::vector<EmcCluster> PList;
-  std::vector<EmcModule> Peaks;
-  std::vector<EmcCluster> *pPList = &PList;
-  std::vector<EmcModule> *pPeaks = &Peaks;
+  // clusters found above do not share towers, so they are split independently;
+  // the output is kept per cluster and added to the node in cluster order
+  std::vector<std::vector<RawCluster *> > final_clusters(nclusters);
+  std::vector<int> npeaks(nclusters, 0);
+  std::atomic<int> next_cluster(0);
 
-  float prob, chi2;
-  int ndf;
-  float xg, yg, zg;
+  auto split_clusters = [&]() {
+    std::vector<EmcCluster>::iterator pp;
+    float ecl, ecore, xcg, ycg, xx, xy, yy;
+    //  float xcorr, ycorr;
+    EmcModule hmax;
+    RawCluster *cluster;
 
-  vector<EmcModule>::iterator ph;
-  vector<EmcModule> hlist;
+    std::vector<EmcCluster> PList;
+    std::vector<EmcModule> Peaks;
+    std::vector<EmcCluster> *pPList = &PList;
+    std::vector<EmcModule> *pPeaks = &Peaks;
 
-  // ncl = 0;
-  for (pc = ClusterList->begin(); pc != ClusterList->end(); ++pc)
-  {
-    //    ecl = pc->GetTotalEnergy();
-    //    pc->GetMoments( &xcg, &ycg, &xx, &xy, &yy );
+    float prob, chi2;
+    int ndf;
+    float xg, yg, zg;
 
-    int npk = pc->GetSubClusters(pPList, pPeaks);
-    if (npk < 0) return Fun4AllReturnCodes::ABORTEVENT;
+    vector<EmcModule>::iterator ph;
+    vector<EmcModule> hlist;
+    int ich, ix, iy;
+
+    for (int icl = next_cluster++; icl < nclusters; icl = next_cluster++)
+    {
+      EmcCluster *pc = &(*ClusterList)[icl];
+      //    ecl = pc->GetTotalEnergy();
+      //    pc->GetMoments( &xcg, &ycg, &xx, &xy, &yy );
 
-    //    printf("  iCl=%d (%d): E=%f  x=%f  y=%f\n",ncl,npk,ecl,xcg,ycg);
+      int npk = pc->GetSubClusters(pPList, pPeaks);
+      npeaks[icl] = npk;
+      if (npk < 0) continue;
 
-    for (pp = pPList->begin(); pp != pPList->end(); ++pp)
+      //    printf("  iCl=%d (%d): E=%f  x=%f  y=%f\n",icl,npk,ecl,xcg,ycg);
+
+      for (pp = pPList->begin(); pp != pPList->end(); ++pp)
+      {
+        // Cluster energy
+        ecl = pp->GetTotalEnergy();
+        ecore = pp->GetECoreCorrected();
+        // 3x3 energy around center of gravity
+        //e9 = pp->GetE9();
+        // Ecore (basically near 2x2 energy around center of gravity)
+        //ecore = pp->GetECore();
+        // Center of Gravity etc.
+        pp->GetMoments(xcg, ycg, xx, xy, yy);
+        pp->GetGlobalPos(xg, yg, zg);
+
+        // Tower with max energy
+        hmax = pp->GetMaxTower();
+
+        //      phi = (xcg-float(NPHI)/2.+0.5)/float(NPHI)*2.*M_PI;
+        //      eta = (ycg-float(NETA)/2.+0.5)/float(NETA)*2.2; // -1.1<eta<1.1;
+
+        //      Cell2Abs(towergeom,xcg,ycg,phi,eta);
+
+        //      pp->GetCorrPos(&xcorr, &ycorr);
+        //      Cell2Abs(towergeom, xcorr, ycorr, phi, eta);
+        //      const double ref_radius = towergeom->get_radius();
+
+        //      phi = 0;
+        //      if (phi > M_PI) phi -= 2. * M_PI;  // convert to [-pi,pi]]
+
+        prob = -1;
+        chi2 = 0;
+        ndf = 0;
+        prob = pp->GetProb(chi2, ndf);
+        //      printf("Prob/Chi2/NDF= %f %f %d Ecl=%f\n",prob,chi2,ndf,ecl);
+
+        cluster = RawClusterContainer::NewCluster(m_ClusterVersion);
+        cluster->set_energy(ecl);
+        cluster->set_ecore(ecore);
+
+        cluster->set_r(sqrt(xg * xg + yg * yg));
+        cluster->set_phi(atan2(yg, xg));
+        cluster->set_z(zg);
+
+        cluster->set_prob(prob);
+        if (ndf > 0)
+          cluster->set_chi2(chi2 / ndf);
+        else
+          cluster->set_chi2(0);
+
+        hlist = pp->GetHitList();
+        ph = hlist.begin();
+        while (ph != hlist.end())
+        {
+          ich = (*ph).ich;
+          iy = ich / NBINX;
+          ix = ich % NBINX;
+          // that code needs a closer look - here are the towers
+          // with their energy added to the cluster object where
+          // the id is the tower id
+          // !!!!! Make sure twrkey is correctly extracted
+  	//        RawTowerDefs::keytype twrkey = RawTowerDefs::encode_towerid(towers->getCalorimeterID(), ix + BINX0, iy + BINY0);
+          RawTowerDefs::keytype twrkey = RawTowerDefs::encode_towerid(caloid, iy + BINY0, ix + BINX0); // Becuase in this part index1 is iy
+          //	printf("%d %d: %d e=%f\n",iphi,ieta,twrkey,(*ph).amp);
+          cluster->addTower(twrkey, (*ph).amp / fEnergyNorm);
+          ++ph;
+        }
+
+        final_clusters[icl].push_back(cluster);
+
+        //      printf("    ipk=%d: E=%f  E9=%f  x=%f  y=%f  MaxTower: (%d,%d) e=%f\n",ipk,ecl,e9,xcg,ycg,hmax.ich%NPHI,hmax.ich/NPHI,hmax.amp);
+      }
+    }
+  };
+
+  std::vector<std::thread> threads;
+  for (unsigned int ithread = 1; ithread < _nthreads && (int) ithread < nclusters; ithread++)
+    threads.push_back(std::thread(split_clusters));
+
+  split_clusters();
+
+  for (unsigned int ithread = 0; ithread < threads.size(); ithread++)
+    threads[ithread].join();
+
+  // as before, the clusters ahead of a failed split are kept
+  for (int icl = 0; icl < nclusters; icl++)
+  {
+    if (npeaks[icl] < 0)
     {
-      // Cluster energy
-      ecl = pp->GetTotalEnergy();
-      ecore = pp->GetECoreCorrected();
-      // 3x3 energy around center of gravity
-      //e9 = pp->GetE9();
-      // Ecore (basically near 2x2 energy around center of gravity)
-      //ecore = pp->GetECore();
-      // Center of Gravity etc.
-      pp->GetMoments(xcg, ycg, xx, xy, yy);
-      pp->GetGlobalPos(xg, yg, zg);
-
-      // Tower with max energy
-      hmax = pp->GetMaxTower();
-
-      //      phi = (xcg-float(NPHI)/2.+0.5)/float(NPHI)*2.*M_PI;
-      //      eta = (ycg-float(NETA)/2.+0.5)/float(NETA)*2.2; // -1.1<eta<1.1;
-
-      //      Cell2Abs(towergeom,xcg,ycg,phi,eta);
-
-      //      pp->GetCorrPos(&xcorr, &ycorr);
-      //      Cell2Abs(towergeom, xcorr, ycorr, phi, eta);
-      //      const double ref_radius = towergeom->get_radius();
-
-      //      phi = 0;
-      //      if (phi > M_PI) phi -= 2. * M_PI;  // convert to [-pi,pi]]
-
-      prob = -1;
-      chi2 = 0;
-      ndf = 0;
-      prob = pp->GetProb(chi2, ndf);
-      //      printf("Prob/Chi2/NDF= %f %f %d Ecl=%f\n",prob,chi2,ndf,ecl);
-
-      cluster = new RawClusterv1();
-      cluster->set_energy(ecl);
-      cluster->set_ecore(ecore);
-
-      cluster->set_r(sqrt(xg * xg + yg * yg));
-      cluster->set_phi(atan2(yg, xg));
-      cluster->set_z(zg);
-
-      cluster->set_prob(prob);
-      if (ndf > 0)
-        cluster->set_chi2(chi2 / ndf);
-      else
-        cluster->set_chi2(0);
-
-      hlist = pp->GetHitList();
-      ph = hlist.begin();
-      while (ph != hlist.end())
+      for (int jcl = icl; jcl < nclusters; jcl++)
       {
-        ich = (*ph).ich;
-        iy = ich / NBINX;
-        ix = ich % NBINX;
-        // that code needs a closer look - here are the towers
-        // with their energy added to the cluster object where
-        // the id is the tower id
-        // !!!!! Make sure twrkey is correctly extracted
-	//        RawTowerDefs::keytype twrkey = RawTowerDefs::encode_towerid(towers->getCalorimeterID(), ix + BINX0, iy + BINY0);
-        RawTowerDefs::keytype twrkey = RawTowerDefs::encode_towerid(towers->getCalorimeterID(), iy + BINY0, ix + BINX0); // Becuase in this part index1 is iy
-        //	printf("%d %d: %d e=%f\n",iphi,ieta,twrkey,(*ph).amp);
-        cluster->addTower(twrkey, (*ph).amp / fEnergyNorm);
-        ++ph;
+        for (unsigned int n = 0; n < final_clusters[jcl].size(); n++) delete final_clusters[jcl][n];
       }
+      return Fun4AllReturnCodes::ABORTEVENT;
+    }
 
-      _clusters->AddCluster(cluster);
+    for (unsigned int n = 0; n < final_clusters[icl].size(); n++)
+    {
+      _clusters->AddCluster(final_clusters[icl][n]);
       // ncl++;
-
-      //      printf("    ipk=%d: E=%f  E9=%f  x=%f  y=%f  MaxTower: (%d,%d) e=%f\n",ipk,ecl,e9,xcg,ycg,hmax.ich%NPHI,hmax.ich/NPHI,hmax.amp);
     }
   }
 
@@ -22,6 +22,9 @@ class RawClusterBuilderTemplate : public SubsysReco
   int InitRun(PHCompositeNode* topNode);
   int process_event(PHCompositeNode* topNode);
   int End(PHCompositeNode* topNode);
+
+  //! only reads the towers and fills its own cluster node, the node names are declared in InitRun
+  bool ThreadSafe() const { return true; }
   void Detector(const std::string& d);
 
   void SetCylindricalGeometry();
@@ -34,11 +37,17 @@ class RawClusterBuilderTemplate : public SubsysReco
   void checkenergy(const int i = 1) { chkenergyconservation = i; }
   void LoadProfile(const char *fname);
 
+  // clusters are split into subclusters in nthreads threads,
+  // the output clusters are added to the node in the same order
+  void set_nthreads(unsigned int nthreads) { _nthreads = (nthreads > 0 ? nthreads : 1); }
+
  private:
   void CreateNodes(PHCompositeNode* topNode);
   bool Cell2Abs(RawTowerGeomContainer* towergeom, float phiC, float etaC, float& phi, float& eta);
 
   RawClusterContainer* _clusters;
+  //! RawCluster version created, RawClusterContainer::ClusterVersion()
+  int m_ClusterVersion;
   //  BEmcProfile *_emcprof;
 
   BEmcRec* bemc;
@@ -56,6 +65,8 @@ class RawClusterBuilderTemplate : public SubsysReco
   int NBINY;
 
   bool bPrintGeom;
+
+  unsigned int _nthreads;
 };
 
 #endif /* RawClusterBuilderTemplate_H__ */
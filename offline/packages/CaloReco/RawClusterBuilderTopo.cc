@@ -2,7 +2,6 @@
 
 #include <calobase/RawClusterContainer.h>
 #include <calobase/RawCluster.h>
-#include <calobase/RawClusterv1.h>
 #include <calobase/RawClusterDefs.h>
 #include <calobase/RawTower.h>
 #include <calobase/RawTowerContainer.h>
@@ -21,14 +20,15 @@
 #include <phool/PHObject.h>
 #include <phool/phool.h>
 
+#include <atomic>
 #include <cassert>
 #include <cmath>
 #include <exception>
 #include <iostream>
 #include <stdexcept>
+#include <thread>
 #include <utility>
 #include <vector>
-#include <list>
 
 #include <algorithm>
 
@@ -160,64 +160,123 @@ std::vector<int> RawClusterBuilderTopo::get_adjacent_towers_by_ID( int ID ) {
   
 }
 
-void RawClusterBuilderTopo::export_single_cluster(std::vector<int> original_towers) {
+void RawClusterBuilderTopo::build_tower_index() {
+
+  // EMCal IDs start after the EMCal grid size, see get_ID
+  const int n_IDs = 2 * _EMCAL_NETA * _EMCAL_NPHI;
+
+  _tower_E.assign( n_IDs, 0 );
+  _tower_key.assign( n_IDs, 0 );
+  _tower_status.assign( n_IDs, -2 );
+  _tower_ownership.assign( n_IDs, std::pair<int,int>( -1, -1 ) );
+  _tower_ID_by_key.clear();
+
+  // neighbors only depend on the geometry and the configuration, compute them once
+  _adjacency_offset.assign( 1, 0 );
+  _adjacency.clear();
+  for (int ID = 0; ID < n_IDs; ID++) {
+
+    const bool is_HCal = ( ID < 2 * _HCAL_NETA * _HCAL_NPHI );
+    const bool is_EMCal = ( ID >= _EMCAL_NETA * _EMCAL_NPHI );
+    if ( is_HCal || is_EMCal ) {
+      std::vector<int> adjacent_towers = get_adjacent_towers_by_ID( ID );
+      _adjacency.insert( _adjacency.end(), adjacent_towers.begin(), adjacent_towers.end() );
+    }
+    _adjacency_offset.push_back( _adjacency.size() );
+
+  }
+
+  // a tower enters the growth queue at most once
+  _grow_queue.reserve( n_IDs );
+
+  if ( Verbosity() > 0 )
+    std::cout << "RawClusterBuilderTopo::build_tower_index: " << n_IDs << " tower IDs with " << _adjacency.size() << " adjacency entries " << std::endl;
+
+}
+
+void RawClusterBuilderTopo::fill_towers( RawTowerContainer *towers, int ilayer, std::vector< std::pair<int, float> >& list_of_seeds ) {
+
+  static const char* layer_names[3] = { "IHCal", "OHCal", "EMCal" };
+
+  RawTowerGeomContainer *geom = _geom_containers[ ilayer ];
+
+  RawTowerContainer::ConstRange begin_end = towers->getTowers();
+  for (RawTowerContainer::ConstIterator rtiter = begin_end.first; rtiter != begin_end.second; ++rtiter) {
+
+    RawTower *tower = rtiter->second;
+
+    int ID = -1;
+    std::map<unsigned int, int>::const_iterator id_iter = _tower_ID_by_key.find( tower->get_key() );
+    if ( id_iter != _tower_ID_by_key.end() ) {
+      ID = id_iter->second;
+    } else {
+      RawTowerGeom *tower_geom = geom->get_tower_geometry( tower->get_key() );
+      int ieta = geom->get_etabin( tower_geom->get_eta() );
+      int iphi = geom->get_phibin( tower_geom->get_phi() );
+      ID = get_ID( ilayer, ieta, iphi );
+      _tower_ID_by_key[ tower->get_key() ] = ID;
+    }
+
+    float this_E = tower->get_energy();
+    _tower_status[ ID ] = -1; // change status to unknown
+    _tower_E[ ID ] = this_E;
+    _tower_key[ ID ] = tower->get_key();
+
+    if ( this_E > _sigma_seed * _noise_LAYER[ ilayer ] ) {
+      list_of_seeds.push_back( std::pair<int, float>( ID, this_E ) );
+      if (Verbosity() > 10) {
+        std::cout << "RawClusterBuilderTopo::process_event: adding " << layer_names[ ilayer ] << " tower at ieta / iphi = " << get_ieta_from_ID( ID ) << " / " << get_iphi_from_ID( ID ) << " with E = " << this_E << std::endl;
+        std::cout << " --> ID = " << ID << " , check ilayer / ieta / iphi = " << get_ilayer_from_ID( ID ) << " / " << get_ieta_from_ID( ID ) << " / " << get_iphi_from_ID( ID ) << std::endl;
+      };
+    }
+
+  }
+
+}
+
+void RawClusterBuilderTopo::export_single_cluster( const std::vector<int>& original_towers, std::vector<RawCluster*>& clusters ) {
 
   if ( Verbosity() > 2 )
-    std::cout << "RawClusterBuilderTopo::export_single_cluster called " << std::endl; 
-  
-  std::map< int, std::pair<int, int> > tower_ownership;
+    std::cout << "RawClusterBuilderTopo::export_single_cluster called " << std::endl;
+
   for (unsigned int t = 0; t < original_towers.size(); t++)
-    tower_ownership[ original_towers.at( t ) ] = std::pair<int, int>(0,-1); // all towers owned by cluster 0
+    _tower_ownership[ original_towers[ t ] ] = std::pair<int, int>(0,-1); // all towers owned by cluster 0
 
-  export_clusters( original_towers, tower_ownership, 1, std::vector<float>(), std::vector<float>(), std::vector<float>() );
+  export_clusters( original_towers, 1, std::vector<float>(), std::vector<float>(), std::vector<float>(), clusters );
 
   return;
 
 }
 
-void RawClusterBuilderTopo::export_clusters(std::vector<int> original_towers, std::map< int, std::pair<int,int> > tower_ownership, unsigned int n_clusters, std::vector<float> pseudocluster_sumE, std::vector<float> pseudocluster_eta, std::vector<float> pseudocluster_phi ) {
-  
+void RawClusterBuilderTopo::export_clusters( const std::vector<int>& original_towers, unsigned int n_clusters, const std::vector<float>& pseudocluster_sumE, const std::vector<float>& pseudocluster_eta, const std::vector<float>& pseudocluster_phi, std::vector<RawCluster*>& clusters ) {
+
   if ( n_clusters != 1 ) // if we didn't just pass down from export_single_cluster
     if ( Verbosity() > 2 )
       std::cout << "RawClusterBuilderTopo::export_clusters called on an initial cluster with " << n_clusters << " final clusters " << std::endl;
 
-  // build a RawCluster for output    
-  std::vector<RawCluster*> clusters;
-  std::vector<float> clusters_E;
-  std::vector<float> clusters_x;
-  std::vector<float> clusters_y;
-  std::vector<float> clusters_z;
-  
-  for (unsigned int pc = 0; pc < n_clusters; pc++) {
-    clusters.push_back( new RawClusterv1() );
-    clusters_E.push_back( 0 );
-    clusters_x.push_back( 0 );
-    clusters_y.push_back( 0 );
-    clusters_z.push_back( 0 );
-  }
-  
+  // build a RawCluster for output
+  clusters.clear();
+  std::vector<float> clusters_E( n_clusters, 0 );
+  std::vector<float> clusters_x( n_clusters, 0 );
+  std::vector<float> clusters_y( n_clusters, 0 );
+  std::vector<float> clusters_z( n_clusters, 0 );
+
+  for (unsigned int pc = 0; pc < n_clusters; pc++)
+    clusters.push_back( RawClusterContainer::NewCluster(m_ClusterVersion) );
+
   for (unsigned int t = 0; t < original_towers.size(); t++) {
-    int this_ID = original_towers.at( t );
-    std::pair<int,int> the_pair = tower_ownership[ this_ID ];
-    
+    int this_ID = original_towers[ t ];
+    const std::pair<int,int>& the_pair = _tower_ownership[ this_ID ];
+
     if ( Verbosity() > 5 )
-      std::cout << "RawClusterBuilderTopo::export_clusters -> assigning tower " << original_towers.at( t ) << " with ownership ( " << the_pair.first << ", " << the_pair.second << " ) " << std::endl;
-    
-    int this_ieta = get_ieta_from_ID( this_ID );
-    int this_iphi = get_iphi_from_ID( this_ID );
+      std::cout << "RawClusterBuilderTopo::export_clusters -> assigning tower " << this_ID << " with ownership ( " << the_pair.first << ", " << the_pair.second << " ) " << std::endl;
+
     int this_layer = get_ilayer_from_ID( this_ID );
-    float this_E = get_E_from_ID( this_ID );
-    
-    int this_key = 0;
-    if ( this_layer == 2 ) {
-      this_key = _EMTOWERMAP_KEY_ETA_PHI[ this_ieta ][ this_iphi ];
-    }
-    else {
-      this_key = _TOWERMAP_KEY_LAYER_ETA_PHI[ this_layer ][ this_ieta ][ this_iphi ];
-    }
-    
+    float this_E = _tower_E[ this_ID ];
+    int this_key = _tower_key[ this_ID ];
+
     RawTowerGeom *tower_geom = _geom_containers[ this_layer ]->get_tower_geometry( this_key );
-    
+
     if ( the_pair.second == -1 ) {
       // assigned only to one cluster, easy
       clusters[ the_pair.first ]->addTower( this_key , this_E );
@@ -225,65 +284,406 @@ void RawClusterBuilderTopo::export_clusters(std::vector<int> original_towers, st
       clusters_x[ the_pair.first ] = clusters_x[ the_pair.first ] + this_E * tower_geom->get_center_x();
       clusters_y[ the_pair.first ] = clusters_y[ the_pair.first ] + this_E * tower_geom->get_center_y();
       clusters_z[ the_pair.first ] = clusters_z[ the_pair.first ] + this_E * tower_geom->get_center_z();
-      
-    if ( Verbosity() > 5 )
-      std::cout << " -> tower ID " << this_ID << " fully assigned to pseudocluster " <<  the_pair.first << std::endl;
-      
+
+      if ( Verbosity() > 5 )
+        std::cout << " -> tower ID " << this_ID << " fully assigned to pseudocluster " <<  the_pair.first << std::endl;
+
     } else {
-      // assigned to two clusters! get energy sharing fraction ... 
+      // assigned to two clusters! get energy sharing fraction ...
       float dR1 = calculate_dR( tower_geom->get_eta() , pseudocluster_eta[ the_pair.first ] , tower_geom->get_phi() , pseudocluster_phi[ the_pair.first ] ) / _R_shower;
       float dR2 = calculate_dR( tower_geom->get_eta() , pseudocluster_eta[ the_pair.second ] , tower_geom->get_phi() , pseudocluster_phi[ the_pair.second ] ) / _R_shower;
       float r = exp( dR1 - dR2 );
       float frac1 = pseudocluster_sumE[ the_pair.first ] / ( pseudocluster_sumE[ the_pair.first ] + r *  pseudocluster_sumE[ the_pair.second ] );
-      
+
       if ( Verbosity() > 5 )
-	std::cout << " tower ID " << this_ID << " has dR1 = " << dR1 << " to pseudocluster " <<  the_pair.first << " , and dR2 = " << dR2 << " to pseudocluster " << the_pair.second << ", so frac1 = " << frac1 << std::endl;
-      
+        std::cout << " tower ID " << this_ID << " has dR1 = " << dR1 << " to pseudocluster " <<  the_pair.first << " , and dR2 = " << dR2 << " to pseudocluster " << the_pair.second << ", so frac1 = " << frac1 << std::endl;
+
       clusters[ the_pair.first ]->addTower( this_key , this_E * frac1 );
       clusters_E[ the_pair.first ] = clusters_E[ the_pair.first ] + this_E * frac1 ;
       clusters_x[ the_pair.first ] = clusters_x[ the_pair.first ] + this_E * tower_geom->get_center_x() * frac1;
       clusters_y[ the_pair.first ] = clusters_y[ the_pair.first ] + this_E * tower_geom->get_center_y() * frac1;
       clusters_z[ the_pair.first ] = clusters_z[ the_pair.first ] + this_E * tower_geom->get_center_z() * frac1;
-      
+
       clusters[ the_pair.second ]->addTower( this_key , this_E * ( 1 - frac1 ) );
       clusters_E[ the_pair.second ] = clusters_E[ the_pair.second ] + this_E * ( 1 - frac1 ) ;
       clusters_x[ the_pair.second ] = clusters_x[ the_pair.second ] + this_E * tower_geom->get_center_x() * (1 - frac1);
       clusters_y[ the_pair.second ] = clusters_y[ the_pair.second ] + this_E * tower_geom->get_center_y() * (1 - frac1);
       clusters_z[ the_pair.second ] = clusters_z[ the_pair.second ] + this_E * tower_geom->get_center_z() * (1 - frac1);
-      
+
     }
-    
-    
+
   }
-  
-  // iterate through and add to official container
-  
+
+  // set cluster kinematics, they are added to the official container by the caller
+
   for (unsigned int cl = 0; cl < n_clusters; cl++) {
-    
+
     clusters[ cl ]->set_energy( clusters_E[ cl ] );
-    
+
     float mean_x = clusters_x[ cl ] /  clusters_E[ cl ];
     float mean_y = clusters_y[ cl ] /  clusters_E[ cl ];
     float mean_z = clusters_z[ cl ] /  clusters_E[ cl ];
-    
+
     clusters[ cl ]->set_r( sqrt( mean_y * mean_y + mean_x * mean_x) );
     clusters[ cl ]->set_phi( atan2( mean_y, mean_x) );
     clusters[ cl ]->set_z( mean_z );
-    
-    _clusters->AddCluster( clusters[ cl ] );
 
-    if ( Verbosity() > 1 )
-      std::cout << "RawClusterBuilderTopo::export_clusters: added cluster with E = " <<  clusters_E[ cl ] << ", eta = " << -1 * log( tan( atan2( sqrt( mean_y * mean_y + mean_x * mean_x), mean_z ) / 2.0 ) ) << ", phi = " << atan2( mean_y, mean_x ) << std::endl; 
-    
   }
-  
+
   return;
 }
 
+void RawClusterBuilderTopo::split_cluster( int cl, const std::vector<int>& original_towers, std::vector<RawCluster*>& clusters ) {
+
+  std::vector< std::pair<int, float> > local_maxima_ID;
+
+  // iterate through each tower, looking for maxima
+  for (unsigned int t = 0; t < original_towers.size(); t++) {
+    int tower_ID = original_towers[ t ];
+    float tower_E = _tower_E[ tower_ID ];
+
+    if ( Verbosity() > 10 ) std::cout << " -> examining tower ID " << tower_ID << " for possible local maximum " << std::endl;
+
+    // check minimum energy
+    if ( tower_E < _local_max_minE_LAYER[ get_ilayer_from_ID( tower_ID ) ] ) {
+      if ( Verbosity() > 10 ) std::cout << " -> -> energy E = " << tower_E << " < " << _local_max_minE_LAYER[ get_ilayer_from_ID( tower_ID ) ] << " too low" << std::endl;
+      continue;
+    }
+
+    // examine neighbors
+    int neighbors_in_cluster = 0;
+
+    // check for higher neighbor
+    bool has_higher_neighbor = false;
+    for (int adj = _adjacency_offset[ tower_ID ]; adj < _adjacency_offset[ tower_ID + 1 ]; adj++) {
+      int this_adjacent_tower_ID = _adjacency[ adj ];
+
+      if ( _tower_status[ this_adjacent_tower_ID ] != cl ) continue; // only consider neighbors in cluster, obviously
+
+      neighbors_in_cluster++;
+
+      if ( _tower_E[ this_adjacent_tower_ID ] > tower_E ) {
+        if ( Verbosity() > 10 ) std::cout << " -> -> has higher-energy neighbor ID / E = " << this_adjacent_tower_ID << " / " << _tower_E[ this_adjacent_tower_ID ] << std::endl;
+        has_higher_neighbor = true; // at this point we can break -- we won't need to count the number of good neighbors, since we won't even pass the E_neighbor test
+        break;
+      }
+    }
+
+    if (has_higher_neighbor) continue; // if we broke out, now continue
+
+    // check number of neighbors
+    if ( neighbors_in_cluster < 4 ) {
+      if ( Verbosity() > 10 ) std::cout << " -> -> too few neighbors N = " << neighbors_in_cluster << std::endl;
+      continue;
+    }
+
+    local_maxima_ID.push_back( std::pair<int,float>( tower_ID , tower_E ) );
+
+  }
+
+  // check for possible EMCal-OHCal seed overlaps
+
+  for (unsigned int n = 0; n < local_maxima_ID.size(); n++) {
+
+    // only look at I/OHCal local maxima
+    std::pair<int,float> this_LM = local_maxima_ID[ n ];
+    if ( get_ilayer_from_ID( this_LM.first ) == 2 ) continue;
+
+    float this_phi = _geom_containers[ get_ilayer_from_ID( this_LM.first ) ]->get_phicenter( get_iphi_from_ID( this_LM.first ) );
+    if ( this_phi > 3.14159 ) this_phi -= 2 * 3.14159;
+    float this_eta = _geom_containers[ get_ilayer_from_ID( this_LM.first ) ]->get_etacenter( get_ieta_from_ID( this_LM.first ) );
+
+    bool has_EM_overlap = false;
+
+    // check all other local maxima for overlaps
+    for (unsigned int n2 = 0; n2 < local_maxima_ID.size(); n2++) {
+
+      if ( n == n2 ) continue; // don't check the same one
+
+      // only look at EMCal local mazima
+      std::pair<int,float> this_LM2 = local_maxima_ID[ n2 ];
+      if ( get_ilayer_from_ID( this_LM2.first ) != 2 ) continue;
+
+      float this_phi2 = _geom_containers[ get_ilayer_from_ID( this_LM2.first ) ]->get_phicenter( get_iphi_from_ID( this_LM2.first ) );
+      if ( this_phi2 > 3.14159 ) this_phi -= 2 * 3.14159;
+      float this_eta2 = _geom_containers[ get_ilayer_from_ID( this_LM2.first ) ]->get_etacenter( get_ieta_from_ID( this_LM2.first ) );
+
+      // calculate geometric dR
+      float dR = calculate_dR( this_eta, this_eta2, this_phi, this_phi2 );
+
+      // check for and report overlaps
+      if ( dR < 0.15 ) {
+        has_EM_overlap = true;
+        if (Verbosity() > 2) {
+          std::cout << "RawClusterBuilderTopo::process_event : removing I/OHal local maximum (ID,E,phi,eta = " << this_LM.first << ", " << this_LM.second << ", " << this_phi << ", " << this_eta << "), ";
+          std::cout << "due to EM overlap (ID,E,phi,eta = " << this_LM2.first << ", " << this_LM2.second << ", " << this_phi2 << ", " << this_eta2 << "), dR = " << dR << std::endl;
+        }
+        break;
+      }
+    }
+
+    if ( has_EM_overlap ) {
+      // remove the I/OHCal local maximum from the list
+      local_maxima_ID.erase( local_maxima_ID.begin() + n );
+      // make sure to back up one index...
+      n = n - 1;
+    } // otherwise, keep this local maximum
+  }
+
+  // only now print out full set of local maxima
+  if ( Verbosity() > 2 ) {
+    for (unsigned int n = 0; n < local_maxima_ID.size(); n++) {
+      int tower_ID = local_maxima_ID[ n ].first;
+      std::cout << "RawClusterBuilderTopo::process_event in cluster " << cl << ", tower ID " << tower_ID << " is LOCAL MAXIMUM with layer / E = " << get_ilayer_from_ID( tower_ID ) << " / " << _tower_E[ tower_ID ] << ", ";
+      float this_phi = _geom_containers[ get_ilayer_from_ID( tower_ID ) ]->get_phicenter( get_iphi_from_ID( tower_ID ) );
+      if ( this_phi > 3.14159 ) this_phi -= 2 * 3.14159;
+      std::cout << " eta / phi = " << _geom_containers[ get_ilayer_from_ID( tower_ID ) ]->get_etacenter( get_ieta_from_ID( tower_ID ) ) << " / " << this_phi << std::endl;
+    }
+  }
+
+  // do we have only 1 or 0 local maxima?
+  if ( local_maxima_ID.size() <= 1 ) {
+
+    if (Verbosity() > 2) std::cout << "RawClusterBuilderTopo::process_event cluster " << cl << " has only " << local_maxima_ID.size() << " local maxima, not splitting " << std::endl;
+    export_single_cluster( original_towers, clusters );
+
+    return;
+
+  }
+
+  // engage splitting procedure!
+
+  if (Verbosity() > 2)
+    std::cout << "RawClusterBuilderTopo::process_event splitting cluster " << cl << " into " << local_maxima_ID.size() << " according to local maxima!" << std::endl;
+
+  const unsigned int n_pseudoclusters = local_maxima_ID.size();
+
+  // keep track of the ownership of all cluster towers
+  // -1 means unseen
+  // -2 means seen and in the seed list now (e.g. don't add it to the seed list again)
+  // -3 shared tower, ignore going forward...
+  for (unsigned int t = 0; t < original_towers.size(); t++)
+    _tower_ownership[ original_towers[ t ] ] = std::pair<int, int>(-1,-1); // initialize all towers as un-seen
+
+  std::vector<int> neighbor_list;
+  std::vector<int> new_neighbor_list;
+  std::vector<int> shared_list;
+  std::vector<int> new_ownerships;
+  std::vector<bool> pseudocluster_adjacency( n_pseudoclusters, false );
+
+  // sort maxima before populating seed list
+  std::sort( local_maxima_ID.begin(), local_maxima_ID.end(), sort_by_pair_second );
+
+  // initialize neighbor list
+  for (unsigned int s = 0; s < n_pseudoclusters; s++) {
+    _tower_ownership[ local_maxima_ID[ s ].first ] = std::pair<int, int>( s, -1 );
+    neighbor_list.push_back( local_maxima_ID[ s ].first );
+  }
+
+  bool first_pass = true;
+
+  do {
+
+    if (Verbosity() > 5 )
+      std::cout << " -> starting split loop with " << neighbor_list.size() << " neighbor, and " << shared_list.size() << " shared towers " << std::endl;
+
+    // go through neighbor list, assigning ownership only via the seed list
+    new_ownerships.clear();
+
+    for (unsigned int n = 0; n < neighbor_list.size(); n++) {
+
+      int neighbor_ID = neighbor_list[ n ];
+
+      if ( first_pass ) {
+        new_ownerships.push_back( _tower_ownership[ neighbor_ID ].first );
+        continue;
+      }
+
+      std::fill( pseudocluster_adjacency.begin(), pseudocluster_adjacency.end(), false );
+
+      // look over all towers THIS one is adjacent to, and count up...
+      for (int adj = _adjacency_offset[ neighbor_ID ]; adj < _adjacency_offset[ neighbor_ID + 1 ]; adj++) {
+        int this_adjacent_tower_ID = _adjacency[ adj ];
+        if ( _tower_status[ this_adjacent_tower_ID ] != cl ) continue;
+        int owner = _tower_ownership[ this_adjacent_tower_ID ].first;
+        if ( owner > -1 && owner < (int) n_pseudoclusters ) pseudocluster_adjacency[ owner ] = true;
+      }
+
+      int n_pseudocluster_adjacent = 0;
+      int last_adjacent_pseudocluster = -1;
+      for (unsigned int s = 0; s < n_pseudoclusters; s++)  {
+        if ( pseudocluster_adjacency[ s ] ) {
+          last_adjacent_pseudocluster = s;
+          n_pseudocluster_adjacent++;
+        }
+      }
+
+      if ( n_pseudocluster_adjacent == 0 ) {
+        std::cout << " -> -> ERROR! How can a neighbor tower at this stage be adjacent to no pseudoclusters?? " << std::endl;
+        new_ownerships.push_back( 9999 );
+      }
+      else if ( n_pseudocluster_adjacent == 1 ) {
+        if (Verbosity() > 10 )
+          std::cout << " -> -> neighbor tower " << neighbor_ID << " is ONLY adjacent to one pseudocluster # " << last_adjacent_pseudocluster << std::endl;
+        new_ownerships.push_back( last_adjacent_pseudocluster );
+      } else {
+        if (Verbosity() > 10 )
+          std::cout << " -> -> neighbor tower " << neighbor_ID << " is adjacent to " << n_pseudocluster_adjacent << " pseudoclusters, move to shared list " << std::endl;
+        new_ownerships.push_back( -3 );
+      }
+
+    }
+
+    // transfer neighbor list to seed list or shared list
+    for (unsigned int n = 0; n < neighbor_list.size(); n++) {
+      int neighbor_ID = neighbor_list[ n ];
+      if ( new_ownerships[ n ] > -1 ) {
+        _tower_ownership[ neighbor_ID ] = std::pair<int,int>( new_ownerships[ n ], -1 );
+      }
+      if ( new_ownerships[ n ] == -3 ) {
+        _tower_ownership[ neighbor_ID ] = std::pair<int,int>( -3, -1 );
+        shared_list.push_back( neighbor_ID );
+      }
+    }
+
+    // populate a new neighbor list from the about-to-be-owned towers before transferring this one
+    new_neighbor_list.clear();
+    for (unsigned int n = 0; n < neighbor_list.size(); n++) {
+      int neighbor_ID = neighbor_list[ n ];
+      if ( new_ownerships[ n ] > -1 ) {
+        for (int adj = _adjacency_offset[ neighbor_ID ]; adj < _adjacency_offset[ neighbor_ID + 1 ]; adj++) {
+          int this_adjacent_tower_ID = _adjacency[ adj ];
+          if ( _tower_status[ this_adjacent_tower_ID ] != cl ) continue;
+          if ( _tower_ownership[ this_adjacent_tower_ID ].first == -1 ) {
+            new_neighbor_list.push_back( this_adjacent_tower_ID );
+            if ( Verbosity() > 5 )
+              std::cout << " -> queueing up to add tower " << this_adjacent_tower_ID << " , neighbor of tower " << neighbor_ID << " to new neighbor list" << std::endl;
+          }
+        }
+      }
+    }
+
+    // remove duplicate elements, a tower adjacent to several new owned towers would otherwise be
+    // queued several times, and the number of copies grows with each pass
+    if ( Verbosity() > 5 )
+      std::cout << " new neighbor list has size " << new_neighbor_list.size() << ", but after removing duplicate elements: ";
+    std::sort( new_neighbor_list.begin(), new_neighbor_list.end() );
+    new_neighbor_list.erase( std::unique( new_neighbor_list.begin(), new_neighbor_list.end() ), new_neighbor_list.end() );
+    if ( Verbosity() > 5 )
+      std::cout << new_neighbor_list.size() << std::endl;
+
+    // now transfer over new neighbor list
+    neighbor_list.swap( new_neighbor_list );
+
+    first_pass = false;
+
+  } while ( neighbor_list.size() > 0 );
+
+  // calculate pseudocluster energies and positions
+  std::vector<float> pseudocluster_sumeta( n_pseudoclusters, 0 );
+  std::vector<float> pseudocluster_sumphi( n_pseudoclusters, 0 );
+  std::vector<float> pseudocluster_sumE( n_pseudoclusters, 0 );
+  std::vector<int> pseudocluster_ntower( n_pseudoclusters, 0 );
+  std::vector<float> pseudocluster_eta;
+  std::vector<float> pseudocluster_phi;
+
+  for (unsigned int t = 0; t < original_towers.size(); t++) {
+    int this_ID = original_towers[ t ];
+    const std::pair<int,int>& the_pair = _tower_ownership[ this_ID ];
+    if ( the_pair.first > -1 ) {
+      pseudocluster_sumE[ the_pair.first ] += _tower_E[ this_ID ];
+      float this_eta =  _geom_containers[ get_ilayer_from_ID( this_ID ) ]->get_etacenter( get_ieta_from_ID( this_ID ) );
+      float this_phi =  _geom_containers[ get_ilayer_from_ID( this_ID ) ]->get_phicenter( get_iphi_from_ID( this_ID ) );
+      pseudocluster_sumeta[ the_pair.first ] += this_eta;
+      pseudocluster_sumphi[ the_pair.first ] += this_phi;
+      pseudocluster_ntower[ the_pair.first ] += 1;
+    }
+  }
+
+  for (unsigned int pc = 0; pc < n_pseudoclusters; pc++) {
+    pseudocluster_eta.push_back( pseudocluster_sumeta[ pc ] / pseudocluster_ntower[ pc ] );
+    pseudocluster_phi.push_back( pseudocluster_sumphi[ pc ] / pseudocluster_ntower[ pc ] );
+
+    if (Verbosity() > 2 )
+      std::cout << "RawClusterBuilderTopo::process_event pseudocluster #" << pc << ", E / eta / phi / Ntower = " << pseudocluster_sumE[ pc ] << " / " << pseudocluster_eta[ pc ] << " / " << pseudocluster_phi[ pc ] << " / " << pseudocluster_ntower[ pc ] << std::endl;
+
+  }
+
+  if (Verbosity() > 2 )
+    std::cout << "RawClusterBuilderTopo::process_event now splitting up shared clusters (including unassigned clusters), initial shared list has size " << shared_list.size() << std::endl;
+
+  // iterate through shared cells in order, identifying which two they belong to
+  // towers found unowned on the way are added at the end of the list
+  for (unsigned int ishared = 0; ishared < shared_list.size(); ishared++) {
+
+    int shared_ID = shared_list[ ishared ];
+
+    if (Verbosity() > 5 )
+      std::cout << " -> looking at shared tower " << shared_ID << ", after this one there are " << shared_list.size() - ishared - 1 << " shared towers left " << std::endl;
+
+    // look through adjacent pseudoclusters, taking two with highest energies
+    std::fill( pseudocluster_adjacency.begin(), pseudocluster_adjacency.end(), false );
+
+    for (int adj = _adjacency_offset[ shared_ID ]; adj < _adjacency_offset[ shared_ID + 1 ]; adj++) {
+      int this_adjacent_tower_ID = _adjacency[ adj ];
+      if ( _tower_status[ this_adjacent_tower_ID ] != cl ) continue;
+      std::pair<int,int>& adjacent_ownership = _tower_ownership[ this_adjacent_tower_ID ];
+      if ( adjacent_ownership.first > -1 && adjacent_ownership.first < (int) n_pseudoclusters ) {
+        pseudocluster_adjacency[ adjacent_ownership.first ] = true;
+      }
+      if ( adjacent_ownership.second > -1 ) { // can inherit adjacency from shared cluster
+        pseudocluster_adjacency[ adjacent_ownership.second ] = true;
+      }
+      // at the same time, add unowned towers to the list for later examination
+      if ( adjacent_ownership.first == -1 ) {
+        shared_list.push_back( this_adjacent_tower_ID );
+        adjacent_ownership = std::pair<int, int>(-3, -1);
+        if (Verbosity() > 10 )
+          std::cout << " -> while looking at neighbors, have added un-examined tower " << this_adjacent_tower_ID << " to shared list " << std::endl;
+      }
+    }
+
+    // now figure out which pseudoclustes this shared tower is adjacent to...
+    int highest_pseudocluster_index = -1;
+    int second_highest_pseudocluster_index = -1;
+
+    float highest_pseudocluster_E = -1;
+    float second_highest_pseudocluster_E = -2;
+
+    for (unsigned int n = 0; n < n_pseudoclusters; n++) {
+
+      if ( ! pseudocluster_adjacency[ n ] ) continue;
+
+      if ( pseudocluster_sumE[ n ] > highest_pseudocluster_E ) {
+        second_highest_pseudocluster_E = highest_pseudocluster_E;
+        second_highest_pseudocluster_index = highest_pseudocluster_index;
+
+        highest_pseudocluster_E = pseudocluster_sumE[ n ];
+        highest_pseudocluster_index = n;
+      } else if ( pseudocluster_sumE[ n ] > second_highest_pseudocluster_E ) {
+        second_highest_pseudocluster_E = pseudocluster_sumE[ n ];
+        second_highest_pseudocluster_index = n;
+      }
+
+    }
+
+    if (Verbosity() > 5 )
+      std::cout << " -> highest pseudoclusters its adjacent to are " << highest_pseudocluster_index << " ( E = " << highest_pseudocluster_E << " ) and " << second_highest_pseudocluster_index << " ( E = " << second_highest_pseudocluster_E << " ) " << std::endl;
+
+    // assign these clusters as owners
+    _tower_ownership[ shared_ID ] = std::pair<int, int>( highest_pseudocluster_index, second_highest_pseudocluster_index );
+
+  }
+
+  // call helper function
+  export_clusters( original_towers, n_pseudoclusters, pseudocluster_sumE, pseudocluster_eta, pseudocluster_phi, clusters );
+
+}
 
 RawClusterBuilderTopo::RawClusterBuilderTopo(const std::string &name)
   : SubsysReco(name)
   , _clusters(nullptr)
+  , m_ClusterVersion(1)
 {
 
   // geometry defined at run-time
@@ -315,10 +715,14 @@ RawClusterBuilderTopo::RawClusterBuilderTopo(const std::string &name)
   _local_max_minE_LAYER[0] = 1;
   _local_max_minE_LAYER[1] = 1;
   _local_max_minE_LAYER[2] = 1;
+
+  _nthreads = 1;
 }
 
 int RawClusterBuilderTopo::InitRun(PHCompositeNode *topNode)
 {
+  m_ClusterVersion = RawClusterContainer::ClusterVersion();
+
   try
   {
     CreateNodes(topNode);
@@ -396,10 +800,6 @@ int RawClusterBuilderTopo::process_event(PHCompositeNode *topNode)
     _EMCAL_NETA =  _geom_containers[2]->get_etabins();
     _EMCAL_NPHI =  _geom_containers[2]->get_phibins();
 
-    _EMTOWERMAP_STATUS_ETA_PHI.resize( _EMCAL_NETA, std::vector<int>( _EMCAL_NPHI, -2 ) );
-    _EMTOWERMAP_KEY_ETA_PHI.resize( _EMCAL_NETA, std::vector<int>( _EMCAL_NPHI, 0 ) );
-    _EMTOWERMAP_E_ETA_PHI.resize( _EMCAL_NETA, std::vector<float>( _EMCAL_NPHI, 0 ) );
-    
   }
 
   if ( _HCAL_NETA < 0 ) {
@@ -408,118 +808,24 @@ int RawClusterBuilderTopo::process_event(PHCompositeNode *topNode)
     _HCAL_NETA =  _geom_containers[1]->get_etabins();
     _HCAL_NPHI =  _geom_containers[1]->get_phibins();
 
-    _TOWERMAP_STATUS_LAYER_ETA_PHI.resize( 2, std::vector<std::vector<int> > ( _HCAL_NETA, std::vector<int>( _HCAL_NPHI, -2 ) ) );
-    _TOWERMAP_KEY_LAYER_ETA_PHI.resize( 2, std::vector<std::vector<int> > ( _HCAL_NETA, std::vector<int>( _HCAL_NPHI, 0 ) ) );
-    _TOWERMAP_E_LAYER_ETA_PHI.resize( 2, std::vector<std::vector<float> > ( _HCAL_NETA, std::vector<float>( _HCAL_NPHI, 0 ) ) );
-    
   }
+
+  if ( _adjacency_offset.empty() ) build_tower_index();
   
   // reset maps
   // but note -- do not reset keys!
-  for (int ieta = 0; ieta < _EMCAL_NETA; ieta++) {
-    for (int iphi = 0; iphi < _EMCAL_NPHI; iphi++) { 
-      
-      _EMTOWERMAP_STATUS_ETA_PHI[ ieta ][ iphi ] = -2; // set tower does not exist
-      _EMTOWERMAP_E_ETA_PHI[ ieta ][ iphi ] = 0; // set zero energy
-      
-    }
-  }
-  for (int ilayer = 0; ilayer < 2; ilayer++) {
-    for (int ieta = 0; ieta < _HCAL_NETA; ieta++) {
-      for (int iphi = 0; iphi < _HCAL_NPHI; iphi++) { 
-	
-	_TOWERMAP_STATUS_LAYER_ETA_PHI[ ilayer ][ ieta ][ iphi ] = -2; // set tower does not exist
-	_TOWERMAP_E_LAYER_ETA_PHI[ ilayer ][ ieta ][ iphi ] = 0; // set zero energy
-	
-      }
-    }
-  }
+  std::fill( _tower_status.begin(), _tower_status.end(), -2 ); // set tower does not exist
+  std::fill( _tower_E.begin(), _tower_E.end(), 0 ); // set zero energy
   
   // setup 
   std::vector< std::pair<int, float> > list_of_seeds;
 
   // translate towers to our internal representation
-  if ( _enable_EMCal ) {
-    RawTowerContainer::ConstRange begin_end_EM = towersEM->getTowers();
-    for (RawTowerContainer::ConstIterator rtiter = begin_end_EM.first; rtiter != begin_end_EM.second; ++rtiter)
-      {
-	
-	RawTower *tower = rtiter->second;
-	RawTowerGeom *tower_geom =  _geom_containers[2]->get_tower_geometry(tower->get_key());
-	
-	int ieta =  _geom_containers[2]->get_etabin( tower_geom->get_eta() );
-	int iphi =  _geom_containers[2]->get_phibin( tower_geom->get_phi() );
-	float this_E = tower->get_energy();
-	
-	_EMTOWERMAP_STATUS_ETA_PHI[ ieta ][ iphi ] = -1; // change status to unknown
-	_EMTOWERMAP_E_ETA_PHI[ ieta ][ iphi ] = this_E;
-	_EMTOWERMAP_KEY_ETA_PHI[ ieta ][ iphi ] = tower->get_key();
-	
-	if ( this_E > _sigma_seed * _noise_LAYER[2] ) {
-	  int ID = get_ID( 2, ieta, iphi );
-	  list_of_seeds.push_back( std::pair<int, float>( ID, this_E ) ); 
-	  if (Verbosity() > 10) { 
-	    std::cout << "RawClusterBuilderTopo::process_event: adding EMCal tower at ieta / iphi = " << ieta << " / " << iphi << " with E = " << this_E << std::endl;
-	    std::cout << " --> ID = " << ID << " , check ilayer / ieta / iphi = " << get_ilayer_from_ID( ID ) << " / " << get_ieta_from_ID( ID ) << " / " << get_iphi_from_ID( ID ) << std::endl;
-	  };
-	}
-	
-      }
-  }
+  if ( _enable_EMCal ) fill_towers( towersEM, 2, list_of_seeds );
 
-  // translate towers to our internal representation
   if ( _enable_HCal ) {
-    RawTowerContainer::ConstRange begin_end_IH = towersIH->getTowers();
-    for (RawTowerContainer::ConstIterator rtiter = begin_end_IH.first; rtiter != begin_end_IH.second; ++rtiter)
-      {
-	
-	RawTower *tower = rtiter->second;
-	RawTowerGeom *tower_geom =  _geom_containers[0]->get_tower_geometry(tower->get_key());
-	
-	int ieta =  _geom_containers[0]->get_etabin( tower_geom->get_eta() );
-	int iphi =  _geom_containers[0]->get_phibin( tower_geom->get_phi() );
-	float this_E = tower->get_energy();
-	
-	_TOWERMAP_STATUS_LAYER_ETA_PHI[ 0 ][ ieta ][ iphi ] = -1; // change status to unknown
-	_TOWERMAP_E_LAYER_ETA_PHI[ 0 ][ ieta ][ iphi ] = this_E;
-	_TOWERMAP_KEY_LAYER_ETA_PHI[ 0 ][ ieta ][ iphi ] = tower->get_key();
-	
-	if ( this_E > _sigma_seed * _noise_LAYER[0] ) {
-	  int ID = get_ID( 0, ieta, iphi );
-	  list_of_seeds.push_back( std::pair<int, float>( ID, this_E ) ); 
-	  if (Verbosity() > 10) { 
-	    std::cout << "RawClusterBuilderTopo::process_event: adding IHCal tower at ieta / iphi = " << ieta << " / " << iphi << " with E = " << this_E << std::endl;
-	    std::cout << " --> ID = " << ID << " , check ilayer / ieta / iphi = " << get_ilayer_from_ID( ID ) << " / " << get_ieta_from_ID( ID ) << " / " << get_iphi_from_ID( ID ) << std::endl;
-	  };
-	}
-	
-      }
-    
-    RawTowerContainer::ConstRange begin_end_OH = towersOH->getTowers();
-    for (RawTowerContainer::ConstIterator rtiter = begin_end_OH.first; rtiter != begin_end_OH.second; ++rtiter)
-      {
-	
-	RawTower *tower = rtiter->second;
-	RawTowerGeom *tower_geom =  _geom_containers[1]->get_tower_geometry(tower->get_key());
-	
-	int ieta =  _geom_containers[1]->get_etabin( tower_geom->get_eta() );
-	int iphi =  _geom_containers[1]->get_phibin( tower_geom->get_phi() );
-	float this_E = tower->get_energy();
-	
-	_TOWERMAP_STATUS_LAYER_ETA_PHI[ 1 ][ ieta ][ iphi ] = -1; // change status to unknown
-	_TOWERMAP_E_LAYER_ETA_PHI[ 1 ][ ieta ][ iphi ] = this_E;
-	_TOWERMAP_KEY_LAYER_ETA_PHI[ 1 ][ ieta ][ iphi ] = tower->get_key();
-      	
-	if ( this_E > _sigma_seed * _noise_LAYER[1] ) {
-	  int ID = get_ID( 1, ieta, iphi );
-	  list_of_seeds.push_back( std::pair<int, float>( ID, this_E ) ); 
-	  if (Verbosity() > 10) { 
-	    std::cout << "RawClusterBuilderTopo::process_event: adding OHCal tower at ieta / iphi = " << ieta << " / " << iphi << " with E = " << this_E << std::endl;
-	    std::cout << " --> ID = " << ID << " , check ilayer / ieta / iphi = " << get_ilayer_from_ID( ID ) << " / " << get_ieta_from_ID( ID ) << " / " << get_iphi_from_ID( ID ) << std::endl;
-	  };
-	}
-	
-      }
+    fill_towers( towersIH, 0, list_of_seeds );
+    fill_towers( towersOH, 1, list_of_seeds );
   }
   
   if (Verbosity() > 10) {
@@ -544,89 +850,67 @@ int RawClusterBuilderTopo::process_event(PHCompositeNode *topNode)
 
   std::vector< std::vector<int> > all_cluster_towers; // store final cluster tower lists here
 
-  while ( list_of_seeds.size() > 0 ) {
+  for (unsigned int iseed = 0; iseed < list_of_seeds.size(); iseed++) {
 
-    int seed_ID = list_of_seeds.at( 0 ).first;
-    list_of_seeds.erase( list_of_seeds.begin() );
+    int seed_ID = list_of_seeds[ iseed ].first;
 
     if (Verbosity() > 5) {
-      std::cout << " RawClusterBuilderTopo::process_event: in seeded loop, current seed has ID = " << seed_ID << " , length of remaining seed vector = " << list_of_seeds.size() << std::endl;
+      std::cout << " RawClusterBuilderTopo::process_event: in seeded loop, current seed has ID = " << seed_ID << " , length of remaining seed vector = " << list_of_seeds.size() - iseed - 1 << std::endl;
     }
     
     // if this seed was already claimed by some other seed during its growth, remove it and do nothing
-    int seed_status = get_status_from_ID( seed_ID );
+    int seed_status = _tower_status[ seed_ID ];
     if ( seed_status > -1 ) {
       if (Verbosity() > 10)
-	std::cout << " --> already owned by cluster # " << seed_status << std::endl;
+        std::cout << " --> already owned by cluster # " << seed_status << std::endl;
       continue; // go onto the next iteration of the loop
     }
 
     // this seed tower now owned by new cluster
-    set_status_by_ID( seed_ID, cluster_index );
+    _tower_status[ seed_ID ] = cluster_index;
 
-    std::vector<int> cluster_tower_ID;
-    cluster_tower_ID.push_back( seed_ID );
+    all_cluster_towers.push_back( std::vector<int>( 1, seed_ID ) );
+    std::vector<int>& cluster_tower_ID = all_cluster_towers.back();
 
-    std::vector<int> grow_tower_ID;
-    grow_tower_ID.push_back( seed_ID );
-
-    // iteratively process growth towers, adding > 2 * sigma neighbors to the list for further checking
+    // iteratively process growth towers in order, adding > 2 * sigma neighbors to the end of the queue for further checking
+    _grow_queue.clear();
+    _grow_queue.push_back( seed_ID );
 
     if (Verbosity() > 5)
       std::cout << " RawClusterBuilderTopo::process_event: Entering Growth stage for cluster " << cluster_index << std::endl;
     
-    while ( grow_tower_ID.size() > 0 ) {
+    for (unsigned int igrow = 0; igrow < _grow_queue.size(); igrow++) {
 
-      int grow_ID = grow_tower_ID.at( 0 );
-      grow_tower_ID.erase( grow_tower_ID.begin() );
+      int grow_ID = _grow_queue[ igrow ];
       
       if (Verbosity() > 5)
-	std::cout << " --> cluster " << cluster_index << ", growth stage, examining neighbors of ID " << grow_ID << ", " << grow_tower_ID.size() << " grow towers left" << std::endl;
-
-      std::vector<int> adjacent_tower_IDs = get_adjacent_towers_by_ID( grow_ID );
-
-      for ( unsigned int adj = 0; adj < adjacent_tower_IDs.size(); adj++) {
-
-	int this_adjacent_tower_ID = adjacent_tower_IDs.at( adj );
-	
-	if (Verbosity() > 10) std::cout << " --> --> --> checking possible adjacent tower with ID " << this_adjacent_tower_ID << " : ";
-
-	int test_layer = get_ilayer_from_ID( this_adjacent_tower_ID );
-	
-	// if tower does not exist, continue
-	if ( get_status_from_ID( this_adjacent_tower_ID ) == -2 ) {
-	  if (Verbosity() > 10) std::cout << "does not exist " << std::endl;
-	  continue;
-	}
-
-	// if tower is owned by THIS cluster already, continue
-	if ( get_status_from_ID( this_adjacent_tower_ID ) == cluster_index ) {
-	  if (Verbosity() > 10) std::cout << "already owned by this cluster index " << cluster_index << std::endl;
-	  continue;
-	}
-	    
-	// if tower has < 2*sigma energy, continue
-	if ( get_E_from_ID( this_adjacent_tower_ID ) < _sigma_grow * _noise_LAYER[ test_layer ] ) {
-	  if (Verbosity() > 10) std::cout << "E = " << get_E_from_ID( this_adjacent_tower_ID ) << " under 2*sigma threshold " << std::endl;
-	  continue;
-	}
-
-	// if tower is owned by somebody else, continue (although should this really happen?)
-	if ( get_status_from_ID( this_adjacent_tower_ID ) > -1  ) {
-	  if (Verbosity() > 10) std::cout << "ERROR! in growth stage, encountered >2sigma tower which is already owned?!" << std::endl;
-	  continue;
-	}
-	  
-	// tower good to be added to cluster and to list of grow towers
-	grow_tower_ID.push_back( this_adjacent_tower_ID );
-	cluster_tower_ID.push_back( this_adjacent_tower_ID );
-	set_status_by_ID( this_adjacent_tower_ID, cluster_index );
-	if (Verbosity() > 10) std::cout << "add this tower ( ID " <<  this_adjacent_tower_ID << " ) to grow list " << std::endl;
-	
+        std::cout << " --> cluster " << cluster_index << ", growth stage, examining neighbors of ID " << grow_ID << ", " << _grow_queue.size() - igrow - 1 << " grow towers left" << std::endl;
+
+      for (int adj = _adjacency_offset[ grow_ID ]; adj < _adjacency_offset[ grow_ID + 1 ]; adj++) {
+
+        int this_adjacent_tower_ID = _adjacency[ adj ];
+        int this_status = _tower_status[ this_adjacent_tower_ID ];
+
+        // if tower does not exist, or is owned by THIS cluster already, continue
+        if ( this_status == -2 || this_status == cluster_index ) continue;
+
+        // if tower has < 2*sigma energy, continue
+        if ( _tower_E[ this_adjacent_tower_ID ] < _sigma_grow * _noise_LAYER[ get_ilayer_from_ID( this_adjacent_tower_ID ) ] ) continue;
+
+        // if tower is owned by somebody else, continue (although should this really happen?)
+        if ( this_status > -1 ) {
+          if (Verbosity() > 10) std::cout << "ERROR! in growth stage, encountered >2sigma tower which is already owned?!" << std::endl;
+          continue;
+        }
+          
+        // tower good to be added to cluster and to list of grow towers
+        _grow_queue.push_back( this_adjacent_tower_ID );
+        cluster_tower_ID.push_back( this_adjacent_tower_ID );
+        _tower_status[ this_adjacent_tower_ID ] = cluster_index;
+        if (Verbosity() > 10) std::cout << "add this tower ( ID " <<  this_adjacent_tower_ID << " ) to grow list " << std::endl;
+        
       }
 
-      if (Verbosity() > 5) std::cout << " --> after examining neighbors, grow list is now " <<  grow_tower_ID.size() << ", # of towers in cluster = " << cluster_tower_ID.size() << std::endl;
-
     }
 
     // done growing cluster, now add on perimeter towers with E > 0 * sigma
@@ -638,51 +922,29 @@ int RawClusterBuilderTopo::process_event(PHCompositeNode *topNode)
 
     for ( int ic = 0; ic < n_core_towers; ic++) {
       
-      int core_ID = cluster_tower_ID.at( ic );
-      
-      if (Verbosity() > 5)
-	std::cout << " --> cluster " << cluster_index << ", perimeter stage, examining neighbors of ID " << core_ID << ", core cluster # " << ic << " of " << n_core_towers << " total " << std::endl;
-
-      std::vector<int> adjacent_tower_IDs = get_adjacent_towers_by_ID( core_ID );
+      int core_ID = cluster_tower_ID[ ic ];
 
-      for ( unsigned int adj = 0; adj < adjacent_tower_IDs.size(); adj++) {
+      for (int adj = _adjacency_offset[ core_ID ]; adj < _adjacency_offset[ core_ID + 1 ]; adj++) {
 
-	int this_adjacent_tower_ID = adjacent_tower_IDs.at( adj );
+        int this_adjacent_tower_ID = _adjacency[ adj ];
+        int this_status = _tower_status[ this_adjacent_tower_ID ];
 
-	if (Verbosity() > 10) std::cout << " --> --> --> checking possible adjacent tower with ID " << this_adjacent_tower_ID << " : ";
+        // if tower does not exist, or is owned by somebody else (including current cluster), continue. ( allowed during perimeter fixing state )
+        if ( this_status == -2 || this_status > -1 ) continue;
 
-	int test_layer = get_ilayer_from_ID( this_adjacent_tower_ID );
-	
-	// if tower does not exist, continue
-	if ( get_status_from_ID( this_adjacent_tower_ID ) == -2 ) {
-	  if (Verbosity() > 10) std::cout << "does not exist " << std::endl;
-	  continue;
-	}
-	
-	// if tower is owned by somebody else (including current cluster), continue. ( allowed during perimeter fixing state )
-	if ( get_status_from_ID( this_adjacent_tower_ID ) > -1  ) {
-	  if (Verbosity() > 10) std::cout << "already owned by other cluster index " <<  get_status_from_ID( this_adjacent_tower_ID ) << std::endl;
-	  continue;
-	}
-	
-	// if tower has < 0*sigma energy, continue
-	if ( get_E_from_ID( this_adjacent_tower_ID ) < _sigma_peri * _noise_LAYER[ test_layer ] ) {
-	  if (Verbosity() > 10) std::cout << "E = " << get_E_from_ID( this_adjacent_tower_ID ) << " under 0*sigma threshold " << std::endl;
-	  continue;
-	}
-	
-	// perimeter tower good to be added to cluster
-	cluster_tower_ID.push_back( this_adjacent_tower_ID );
-	set_status_by_ID( this_adjacent_tower_ID, cluster_index );
-	if (Verbosity() > 10) std::cout << "add this tower ( ID " <<  this_adjacent_tower_ID << " ) to cluster " << std::endl;
-	
+        // if tower has < 0*sigma energy, continue
+        if ( _tower_E[ this_adjacent_tower_ID ] < _sigma_peri * _noise_LAYER[ get_ilayer_from_ID( this_adjacent_tower_ID ) ] ) continue;
+        
+        // perimeter tower good to be added to cluster
+        cluster_tower_ID.push_back( this_adjacent_tower_ID );
+        _tower_status[ this_adjacent_tower_ID ] = cluster_index;
+        if (Verbosity() > 10) std::cout << "add this tower ( ID " <<  this_adjacent_tower_ID << " ) to cluster " << std::endl;
+        
       }
       
-      if (Verbosity() > 5) std::cout << " --> after examining perimeter neighbors, # of towers in cluster is now = " << cluster_tower_ID.size() << std::endl;
     }
 
-    // keep track of these
-    all_cluster_towers.push_back( cluster_tower_ID );
+    if (Verbosity() > 5) std::cout << " --> after examining perimeter neighbors, # of towers in cluster is now = " << cluster_tower_ID.size() << std::endl;
 
     // increment cluster index for next one
     cluster_index++;
@@ -692,445 +954,48 @@ int RawClusterBuilderTopo::process_event(PHCompositeNode *topNode)
   if (Verbosity() > 0) std::cout << "RawClusterBuilderTopo::process_event: " << cluster_index << " topo-clusters initially reconstructed, entering splitting step" << std::endl;
 
   // now entering cluster splitting stage
-  int original_cluster_index = cluster_index; // since it may be updated
-  for (int cl = 0; cl < original_cluster_index; cl++) {
-
-    std::vector<int> original_towers = all_cluster_towers.at( cl );
-
-    if ( ! _do_split ) {
-      // don't run splitting, just export entire cluster as it is
-      if ( Verbosity() > 2 ) std::cout << "RawClusterBuilderTopo::process_event: splitting step disabled, cluster " << cluster_index << " is final" << std::endl;
-      export_single_cluster( original_towers );
-      continue;
-    }
-
-    std::vector< std::pair<int, float> > local_maxima_ID;
-
-    // iterate through each tower, looking for maxima
-    for (unsigned int t = 0; t < original_towers.size(); t++) {
-      int tower_ID = original_towers.at( t );
-
-      if ( Verbosity() > 10 ) std::cout << " -> examining tower ID " << tower_ID << " for possible local maximum " << std::endl;
-
-      // check minimum energy
-      if ( get_E_from_ID( tower_ID ) < _local_max_minE_LAYER[ get_ilayer_from_ID( tower_ID ) ] ) {
-	if ( Verbosity() > 10 ) std::cout << " -> -> energy E = " << get_E_from_ID( tower_ID ) << " < " << _local_max_minE_LAYER[ get_ilayer_from_ID( tower_ID ) ] << " too low" << std::endl;
-	continue;
-      }
-
-      // examine neighbors
-      std::vector<int> adjacent_tower_IDs = get_adjacent_towers_by_ID( tower_ID );
-      int neighbors_in_cluster = 0;
-
-      // check for higher neighbox
-      bool has_higher_neighbor = false;
-      for ( unsigned int adj = 0; adj < adjacent_tower_IDs.size(); adj++) {
-	int this_adjacent_tower_ID = adjacent_tower_IDs.at( adj );
-
-	if ( get_status_from_ID( this_adjacent_tower_ID ) != cl ) continue; // only consider neighbors in cluster, obviously 
-
-	neighbors_in_cluster++;
-
-	if ( get_E_from_ID( this_adjacent_tower_ID ) > get_E_from_ID( tower_ID ) ) {
-	  if ( Verbosity() > 10 ) std::cout << " -> -> has higher-energy neighbor ID / E = " << this_adjacent_tower_ID << " / " << get_E_from_ID( this_adjacent_tower_ID ) << std::endl;
-	  has_higher_neighbor = true; // at this point we can break -- we won't need to count the number of good neighbors, since we won't even pass the E_neighbor test
-	  break;
-	}
-      }
-
-      if (has_higher_neighbor) continue; // if we broke out, now continue
-
-      // check number of neighbors
-      if ( neighbors_in_cluster < 4 ) {
-	if ( Verbosity() > 10 ) std::cout << " -> -> too few neighbors N = " << neighbors_in_cluster << std::endl;
-	continue;
-      }
-
-      local_maxima_ID.push_back( std::pair<int,float>( tower_ID , get_E_from_ID( tower_ID ) ) );
-
-    }
-
-    // check for possible EMCal-OHCal seed overlaps
-
-    for (unsigned int n = 0; n < local_maxima_ID.size(); n++) {
-
-      // only look at I/OHCal local maxima
-      std::pair<int,float> this_LM = local_maxima_ID.at( n );
-      if ( get_ilayer_from_ID( this_LM.first ) == 2 ) continue;
-
-      float this_phi = _geom_containers[ get_ilayer_from_ID( this_LM.first ) ]->get_phicenter( get_iphi_from_ID( this_LM.first ) );
-      if ( this_phi > 3.14159 ) this_phi -= 2 * 3.14159;
-      float this_eta = _geom_containers[ get_ilayer_from_ID( this_LM.first ) ]->get_etacenter( get_ieta_from_ID( this_LM.first ) );
-
-      bool has_EM_overlap = false;
-
-      // check all other local maxima for overlaps 
-      for (unsigned int n2 = 0; n2 < local_maxima_ID.size(); n2++) {
-
-	if ( n == n2 ) continue; // don't check the same one 
-
-	// only look at EMCal local mazima
-	std::pair<int,float> this_LM2 = local_maxima_ID.at( n2 );
-	if ( get_ilayer_from_ID( this_LM2.first ) != 2 ) continue;
-
-	float this_phi2 = _geom_containers[ get_ilayer_from_ID( this_LM2.first ) ]->get_phicenter( get_iphi_from_ID( this_LM2.first ) );
-	if ( this_phi2 > 3.14159 ) this_phi -= 2 * 3.14159;
-	float this_eta2 = _geom_containers[ get_ilayer_from_ID( this_LM2.first ) ]->get_etacenter( get_ieta_from_ID( this_LM2.first ) );
-
-	// calculate geometric dR
-	float dR = calculate_dR( this_eta, this_eta2, this_phi, this_phi2 );
-
-	// check for and report overlaps
-	if ( dR < 0.15 ) {
-	  has_EM_overlap = true;
-	  if (Verbosity() > 2) {
-	    std::cout << "RawClusterBuilderTopo::process_event : removing I/OHal local maximum (ID,E,phi,eta = " << this_LM.first << ", " << this_LM.second << ", " << this_phi << ", " << this_eta << "), ";
-	    std::cout << "due to EM overlap (ID,E,phi,eta = " << this_LM2.first << ", " << this_LM2.second << ", " << this_phi2 << ", " << this_eta2 << "), dR = " << dR << std::endl;
-	  }
-	  break;
-	}
+  // topo-clusters do not share towers, so that they can be split independently
+  // clusters are taken from a common counter, and the final clusters stored per topo-cluster
+  std::vector< std::vector<RawCluster*> > final_clusters( cluster_index );
+  std::atomic<int> next_cluster( 0 );
+
+  auto split_clusters = [&]() {
+    for (int cl = next_cluster++; cl < cluster_index; cl = next_cluster++) {
+
+      if ( ! _do_split ) {
+        // don't run splitting, just export entire cluster as it is
+        if ( Verbosity() > 2 ) std::cout << "RawClusterBuilderTopo::process_event: splitting step disabled, cluster " << cl << " is final" << std::endl;
+        export_single_cluster( all_cluster_towers[ cl ], final_clusters[ cl ] );
+        continue;
       }
 
-      if ( has_EM_overlap ) {
-	// remove the I/OHCal local maximum from the list
-	local_maxima_ID.erase( local_maxima_ID.begin() + n );
-	// make sure to back up one index...
-	n = n - 1;
-      } // otherwise, keep this local maximum
+      split_cluster( cl, all_cluster_towers[ cl ], final_clusters[ cl ] );
     }
+  };
 
-    // only now print out full set of local maxima
-    if ( Verbosity() > 2 ) {
-      for (unsigned int n = 0; n < local_maxima_ID.size(); n++) {
-	std::pair<int,float> this_LM = local_maxima_ID.at( n );
-	int tower_ID = this_LM.first;
-	std::cout << "RawClusterBuilderTopo::process_event in cluster " << cl << ", tower ID " << tower_ID << " is LOCAL MAXIMUM with layer / E = " << get_ilayer_from_ID( tower_ID ) << " / " << get_E_from_ID( tower_ID ) << ", ";
-	float this_phi = _geom_containers[ get_ilayer_from_ID( tower_ID ) ]->get_phicenter( get_iphi_from_ID( tower_ID ) );
-	if ( this_phi > 3.14159 ) this_phi -= 2 * 3.14159;
-	std::cout << " eta / phi = " << _geom_containers[ get_ilayer_from_ID( tower_ID ) ]->get_etacenter( get_ieta_from_ID( tower_ID ) ) << " / " << this_phi << std::endl;
-      }
-      
-    }
-    
-    // do we have only 1 or 0 local maxima?
-    if ( local_maxima_ID.size() <= 1 ) {
-
-      if (Verbosity() > 2) std::cout << "RawClusterBuilderTopo::process_event cluster " << cl << " has only " << local_maxima_ID.size() << " local maxima, not splitting " << std::endl;
-      export_single_cluster( original_towers );
-
-      continue;
-
-    }
-    
-    // engage splitting procedure! 
-
-    if (Verbosity() > 2)
-      std::cout << "RawClusterBuilderTopo::process_event splitting cluster " << cl << " into " << local_maxima_ID.size() << " according to local maxima!" << std::endl;
-
-    // translate all cluster towers to a map which keeps track of their ownership
-    // -1 means unseen
-    // -2 means seen and in the seed list now (e.g. don't add it to the seed list again)
-    // -3 shared tower, ignore going forward...
-    std::map< int, std::pair<int, int> > tower_ownership;
-    for (unsigned int t = 0; t < original_towers.size(); t++)
-      tower_ownership[ original_towers.at( t ) ] = std::pair<int, int>(-1,-1); // initialize all towers as un-seen
-    
-    std::vector<int> seed_list;
-    std::vector<int> neighbor_list;
-    std::vector<int> shared_list;
-
-    // sort maxima before populating seed list 
-    std::sort( local_maxima_ID.begin(), local_maxima_ID.end(), sort_by_pair_second );
-
-    // initialize neighbor list
-    for (unsigned int s = 0; s < local_maxima_ID.size(); s++) {
-      tower_ownership[ local_maxima_ID.at( s ).first ] = std::pair<int, int>( s, -1 ); 
-      neighbor_list.push_back( local_maxima_ID.at( s ).first );
-    }
-
-     
-    if ( Verbosity() > 100 ) {
-      for (unsigned int t = 0; t < original_towers.size(); t++) {
-	std::pair<int,int> the_pair = tower_ownership[  original_towers.at( t ) ];
-	std::cout << " Debug Pre-Split: tower_ownership[ " << original_towers.at( t ) << " ] = ( " << the_pair.first << ", " << the_pair.second << " ) ";
-	std::cout << " , layer / ieta / iphi = " << get_ilayer_from_ID(  original_towers.at( t ) ) << " / " <<  get_ieta_from_ID(  original_towers.at( t ) ) << " / " <<  get_iphi_from_ID(  original_towers.at( t ) );
-	std::cout << std::endl;
-      }
-    }
-
-    bool first_pass = true;
-
-    do {
+  // debug printout of the splitting is per cluster, keep it in order
+  unsigned int nthreads = ( Verbosity() > 2 ? 1 : _nthreads );
 
-      if (Verbosity() > 5 )
-	std::cout << " -> starting split loop with " << seed_list.size() << " seed, " << neighbor_list.size() << " neighbor, and " << shared_list.size() << " shared towers " << std::endl;
-      
-      // go through neighbor list, assigning ownership only via the seed list 
-      std::vector<int> new_ownerships;
+  std::vector<std::thread> threads;
+  for (unsigned int ithread = 1; ithread < nthreads && (int) ithread < cluster_index; ithread++)
+    threads.push_back( std::thread( split_clusters ) );
 
-      for (unsigned int n = 0; n < neighbor_list.size(); n++) {
-	
-	int neighbor_ID = neighbor_list.at( n );
+  split_clusters();
 
-	if (Verbosity() > 10 )
-	  std::cout << " -> -> looking at neighbor " << n << " (tower ID " << neighbor_ID << " ) of " << neighbor_list.size() << " total" << std::endl;
+  for (unsigned int ithread = 0; ithread < threads.size(); ithread++)
+    threads[ ithread ].join();
 
-	if ( first_pass ) {
-	  if (Verbosity() > 10 )
-	    std::cout << " -> -> -> special first pass rules, this tower already owned by pseudocluster " <<  tower_ownership[ neighbor_ID ].first << std::endl;
-	  new_ownerships.push_back(  tower_ownership[ neighbor_ID ].first  );
-	} else {
-	
-	  std::map<int, bool> pseudocluster_adjacency;
-	  for (unsigned int s = 0; s < local_maxima_ID.size(); s++) 
-	    pseudocluster_adjacency[ s ] = false;
-	  
-	  // look over all towers THIS one is adjacent to, and count up...
-	  std::vector<int> adjacent_tower_IDs = get_adjacent_towers_by_ID( neighbor_ID );	
-	  for ( unsigned int adj = 0; adj < adjacent_tower_IDs.size(); adj++) {
-	    int this_adjacent_tower_ID = adjacent_tower_IDs.at( adj );
-	    if ( get_status_from_ID( this_adjacent_tower_ID ) != cl ) continue;
-	    if ( tower_ownership[ this_adjacent_tower_ID ].first > -1 ) {
-	      if (Verbosity() > 20 )
-		std::cout << " -> -> -> adjacent tower to this one, with ID " << this_adjacent_tower_ID << " , is owned by pseudocluster " <<  tower_ownership[ this_adjacent_tower_ID ].first << std::endl;
-	      pseudocluster_adjacency[ tower_ownership[ this_adjacent_tower_ID ].first ] = true;
-	    }
-	  }
-	  int n_pseudocluster_adjacent = 0;
-	  int last_adjacent_pseudocluster = -1;
-	  for (unsigned int s = 0; s < local_maxima_ID.size(); s++)  {
-	    if ( pseudocluster_adjacency[ s ] ) {
-	      last_adjacent_pseudocluster = s;
-	      n_pseudocluster_adjacent++;
-	      if (Verbosity() > 20 )
-		std::cout << " -> -> adjacent to pseudocluster " << s << std::endl;
-	    }
-	  }
-	  
-	  if ( n_pseudocluster_adjacent == 0 ) {
-	    std::cout << " -> -> ERROR! How can a neighbor tower at this stage be adjacent to no pseudoclusters?? " << std::endl;
-	    new_ownerships.push_back( 9999 );
-	  }
-	  else if ( n_pseudocluster_adjacent == 1 ) {
-	    if (Verbosity() > 10 )
-	      std::cout << " -> -> neighbor tower " << neighbor_ID << " is ONLY adjacent to one pseudocluster # " << last_adjacent_pseudocluster << std::endl;
-	    new_ownerships.push_back( last_adjacent_pseudocluster );
-	  } else {
-	    if (Verbosity() > 10 )
-	      std::cout << " -> -> neighbor tower " << neighbor_ID << " is adjacent to " << n_pseudocluster_adjacent << " pseudoclusters, move to shared list " << std::endl;
-	    new_ownerships.push_back( -3 );
-	  }
-	  
-	}
-      }
+  // iterate through and add to official container, in topo-cluster order
+  for (int cl = 0; cl < cluster_index; cl++) {
+    for (unsigned int n = 0; n < final_clusters[ cl ].size(); n++) {
 
-      if (Verbosity() > 5 )
-	std::cout << " -> now updating status of all " << neighbor_list.size() << " original neighbors " << std::endl;
-      // transfer neighbor list to seed list or shared list 
-      for (unsigned int n = 0; n < neighbor_list.size(); n++) {
-	int neighbor_ID = neighbor_list.at( n );
-	if ( new_ownerships.at( n ) > -1 ) {
-	  tower_ownership[ neighbor_ID ] = std::pair<int,int>( new_ownerships.at( n ), -1 );
-	  seed_list.push_back( neighbor_ID );
-	  if (Verbosity() > 20 )
-	    std::cout << " -> -> neighbor ID " << neighbor_ID << " has new status " << new_ownerships.at( n ) << std::endl;
-	}
-	if ( new_ownerships.at( n ) == -3 ) {
-	  tower_ownership[ neighbor_ID ] = std::pair<int,int>( -3, -1 );
-	  shared_list.push_back( neighbor_ID );
-	  if (Verbosity() > 20 )
-	    std::cout << " -> -> neighbor ID " << neighbor_ID << " has new status " << -3 << std::endl;
-	}
-      }
-
-      if ( Verbosity() > 5 )
-	std::cout << " producing a new neighbor list ... " << std::endl;
-      // populate a new neighbor list from the about-to-be-owned towers before transferring this one 
-      std::list<int> new_neighbor_list;
-      for (unsigned int n = 0; n < neighbor_list.size(); n++) {
-	int neighbor_ID = neighbor_list.at( n );
-	if ( new_ownerships.at( n ) > -1 ) {
-	  std::vector<int> adjacent_tower_IDs = get_adjacent_towers_by_ID( neighbor_ID );
-      
-	  for ( unsigned int adj = 0; adj < adjacent_tower_IDs.size(); adj++) {
-	    int this_adjacent_tower_ID = adjacent_tower_IDs.at( adj );
-	    if ( get_status_from_ID( this_adjacent_tower_ID ) != cl ) continue;
-	    if ( tower_ownership[ this_adjacent_tower_ID ].first == -1 ) {
-	      new_neighbor_list.push_back( this_adjacent_tower_ID );
-	      if ( Verbosity() > 5 )
-		std::cout << " -> queueing up to add tower " << this_adjacent_tower_ID << " , neighbor of tower " << neighbor_ID << " to new neighbor list" << std::endl;
-	    }
-	  }
-	  
-	}
-      }
+      RawCluster *cluster = final_clusters[ cl ][ n ];
+      _clusters->AddCluster( cluster );
 
-      if ( Verbosity() > 5 ) {
-	std::cout << " new neighbor list has size " << new_neighbor_list.size() << ", but after removing duplicate elements: ";
-	new_neighbor_list.sort();
-	new_neighbor_list.unique();
-	std::cout << new_neighbor_list.size() << std::endl;
-      }
-
-      // clear neighbor list!
-      neighbor_list.clear();
+      if ( Verbosity() > 1 )
+        std::cout << "RawClusterBuilderTopo::export_clusters: added cluster with E = " <<  cluster->get_energy() << ", eta = " << -1 * log( tan( atan2( cluster->get_r(), cluster->get_z() ) / 2.0 ) ) << ", phi = " << cluster->get_phi() << std::endl;
 
-      // now transfer over new neighbor list
-      for (; new_neighbor_list.size() > 0; ) {
-	neighbor_list.push_back( new_neighbor_list.front( ) );
-	new_neighbor_list.pop_front();
-      }
-      
-      first_pass = false;
-      
-    } while ( neighbor_list.size() > 0 );
-
-    if ( Verbosity() > 100 ) {
-      for (unsigned int t = 0; t < original_towers.size(); t++) {
-	std::pair<int,int> the_pair = tower_ownership[  original_towers.at( t ) ];
-	std::cout << " Debug Mid-Split: tower_ownership[ " << original_towers.at( t ) << " ] = ( " << the_pair.first << ", " << the_pair.second << " ) ";
-	std::cout << " , layer / ieta / iphi = " << get_ilayer_from_ID(  original_towers.at( t ) ) << " / " <<  get_ieta_from_ID(  original_towers.at( t ) ) << " / " <<  get_iphi_from_ID(  original_towers.at( t ) );
-	std::cout << std::endl;
-	if ( the_pair.first == -1 ) {
-	  std::vector<int> adjacent_tower_IDs = get_adjacent_towers_by_ID( original_towers.at( t ) );
-	  
-	  for ( unsigned int adj = 0; adj < adjacent_tower_IDs.size(); adj++) {
-	    int this_adjacent_tower_ID = adjacent_tower_IDs.at( adj );
-	    if ( get_status_from_ID( this_adjacent_tower_ID ) != cl ) continue;
-	    std::cout << "    -> adjacent to add tower " << this_adjacent_tower_ID << " , which has status " <<  tower_ownership[ this_adjacent_tower_ID ].first << std::endl;
-	  }
-	  
-	}
-      }
     }
-
-    // calculate pseudocluster energies and positions
-    std::vector<float> pseudocluster_sumeta;
-    std::vector<float> pseudocluster_sumphi;
-    std::vector<float> pseudocluster_sumE;
-    std::vector<int> pseudocluster_ntower;
-    std::vector<float> pseudocluster_eta;
-    std::vector<float> pseudocluster_phi;
-    
-    pseudocluster_sumeta.resize( local_maxima_ID.size(), 0 );
-    pseudocluster_sumphi.resize( local_maxima_ID.size(), 0 );
-    pseudocluster_sumE.resize( local_maxima_ID.size(), 0 );
-    pseudocluster_ntower.resize( local_maxima_ID.size(), 0 );
-      
-    for (unsigned int t = 0; t < original_towers.size(); t++) {
-      std::pair<int,int> the_pair = tower_ownership[ original_towers.at( t ) ];
-      if ( the_pair.first > -1 ) {
-	float this_ID = original_towers.at( t );
-	pseudocluster_sumE[ the_pair.first ] += get_E_from_ID( this_ID );
-	float this_eta =  _geom_containers[ get_ilayer_from_ID( this_ID ) ]->get_etacenter( get_ieta_from_ID( this_ID ) );
-	float this_phi =  _geom_containers[ get_ilayer_from_ID( this_ID ) ]->get_phicenter( get_iphi_from_ID( this_ID ) );
-	//float this_phi = ( get_ilayer_from_ID( this_ID ) == 2 ? geomEM->get_phicenter( get_iphi_from_ID( this_ID ) ) : geomOH->get_phicenter( get_iphi_from_ID( this_ID ) ) );
-	pseudocluster_sumeta[ the_pair.first ] += this_eta;
-	pseudocluster_sumphi[ the_pair.first ] += this_phi;
-	pseudocluster_ntower[ the_pair.first ] += 1;
-      }
-    }
-
-    for (unsigned int pc = 0; pc < local_maxima_ID.size(); pc++) {
-      pseudocluster_eta.push_back( pseudocluster_sumeta.at( pc ) / pseudocluster_ntower.at( pc ) );
-      pseudocluster_phi.push_back( pseudocluster_sumphi.at( pc ) / pseudocluster_ntower.at( pc ) );
-
-      if (Verbosity() > 2 )
-	std::cout << "RawClusterBuilderTopo::process_event pseudocluster #" << pc << ", E / eta / phi / Ntower = " << pseudocluster_sumE.at( pc ) << " / " << pseudocluster_eta.at( pc ) << " / " << pseudocluster_phi.at( pc ) << " / " << pseudocluster_ntower.at( pc ) << std::endl;
-
-    }
-
-    if (Verbosity() > 2 )
-      std::cout << "RawClusterBuilderTopo::process_event now splitting up shared clusters (including unassigned clusters), initial shared list has size " << shared_list.size() << std::endl;
-
-    // iterate through shared cells, identifying which two they belong to
-    while ( shared_list.size() > 0 ) {
-
-      // pick the first cell and pop off list
-      int shared_ID = shared_list.at( 0 );
-      shared_list.erase( shared_list.begin() );
-
-      if (Verbosity() > 5 )
-	std::cout << " -> looking at shared tower " << shared_ID << ", after this one there are " << shared_list.size() << " shared towers left " << std::endl;
-      
-      // look through adjacent pseudoclusters, taking two with highest energies
-      std::vector<bool> pseudocluster_adjacency;
-      pseudocluster_adjacency.resize( local_maxima_ID.size(), false );
-      
-      std::vector<int> adjacent_tower_IDs = get_adjacent_towers_by_ID( shared_ID );	
-
-      for ( unsigned int adj = 0; adj < adjacent_tower_IDs.size(); adj++) {
-	int this_adjacent_tower_ID = adjacent_tower_IDs.at( adj );
-	if ( get_status_from_ID( this_adjacent_tower_ID ) != cl ) continue;
-	if ( tower_ownership[ this_adjacent_tower_ID ].first > -1 ) {
-	  pseudocluster_adjacency[  tower_ownership[ this_adjacent_tower_ID ].first ] = true;
-	}
-	if ( tower_ownership[ this_adjacent_tower_ID ].second > -1 ) { // can inherit adjacency from shared cluster
-	  pseudocluster_adjacency[  tower_ownership[ this_adjacent_tower_ID ].second ] = true;
-	}
-	// at the same time, add unowned towers to the list for later examination
-	if ( tower_ownership[ this_adjacent_tower_ID ].first == -1 ) {
-	  shared_list.push_back( this_adjacent_tower_ID );
-	  tower_ownership[ this_adjacent_tower_ID ] = std::pair<int, int>(-3, -1);
-	  if (Verbosity() > 10 )
-	    std::cout << " -> while looking at neighbors, have added un-examined tower " << this_adjacent_tower_ID << " to shared list " << std::endl;
-	}
-      }
-
-      // now figure out which pseudoclustes this shared tower is adjacent to...
-      int highest_pseudocluster_index = -1;
-      int second_highest_pseudocluster_index = -1;
-      
-      float highest_pseudocluster_E = -1;
-      float second_highest_pseudocluster_E = -2;
-
-      for (unsigned int n = 0; n < pseudocluster_adjacency.size(); n++) {
-
-	if ( ! pseudocluster_adjacency[ n ] ) continue;
-
-	if ( pseudocluster_sumE[ n ] > highest_pseudocluster_E ) {
-	  second_highest_pseudocluster_E = highest_pseudocluster_E;
-	  second_highest_pseudocluster_index = highest_pseudocluster_index;
-
-	  highest_pseudocluster_E = pseudocluster_sumE[ n ];
-	  highest_pseudocluster_index = n;
-	} else if ( pseudocluster_sumE[ n ] > second_highest_pseudocluster_E ) {
-	  second_highest_pseudocluster_E = pseudocluster_sumE[ n ];
-	  second_highest_pseudocluster_index = n;
-	}
-
-      }
-
-      if (Verbosity() > 5 )
-	std::cout << " -> highest pseudoclusters its adjacent to are " << highest_pseudocluster_index << " ( E = " << highest_pseudocluster_E << " ) and " << second_highest_pseudocluster_index << " ( E = " << second_highest_pseudocluster_E << " ) " << std::endl;
-      
-      // assign these clusters as owners
-      tower_ownership[ shared_ID ] = std::pair<int, int>( highest_pseudocluster_index, second_highest_pseudocluster_index );  
-
-    }
-
-    if ( Verbosity() > 100 ) {
-      for (unsigned int t = 0; t < original_towers.size(); t++) {
-	std::pair<int,int> the_pair = tower_ownership[  original_towers.at( t ) ];
-	std::cout << " Debug Post-Split: tower_ownership[ " << original_towers.at( t ) << " ] = ( " << the_pair.first << ", " << the_pair.second << " ) ";
-	std::cout << " , layer / ieta / iphi = " << get_ilayer_from_ID(  original_towers.at( t ) ) << " / " <<  get_ieta_from_ID(  original_towers.at( t ) ) << " / " <<  get_iphi_from_ID(  original_towers.at( t ) );
-	std::cout << std::endl;
-	if ( the_pair.first == -1 ) {
-	  std::vector<int> adjacent_tower_IDs = get_adjacent_towers_by_ID( original_towers.at( t ) );
-	  
-	  for ( unsigned int adj = 0; adj < adjacent_tower_IDs.size(); adj++) {
-	    int this_adjacent_tower_ID = adjacent_tower_IDs.at( adj );
-	    if ( get_status_from_ID( this_adjacent_tower_ID ) != cl ) continue;
-	    std::cout << " -> adjacent to add tower " << this_adjacent_tower_ID << " , which has status " <<  tower_ownership[ this_adjacent_tower_ID ].first << std::endl;
-	  }
-	  
-	}
-      }
-    }
-
-    // call helper function
-    export_clusters( original_towers , tower_ownership , local_maxima_ID.size() , pseudocluster_sumE, pseudocluster_eta, pseudocluster_phi );
- 
   }
   
   if ( Verbosity() > 1 ) {
@@ -1139,9 +1004,9 @@ int RawClusterBuilderTopo::process_event(PHCompositeNode *topNode)
     int ncl = 0;
     for (RawClusterContainer::ConstIterator hiter = begin_end.first; hiter != begin_end.second; ++hiter)
       {
-	std::cout << "-> #" << ncl++ << " " ;
-	hiter->second->identify();
-	std::cout << std::endl;
+        std::cout << "-> #" << ncl++ << " " ;
+        hiter->second->identify();
+        std::cout << std::endl;
       }
   }
 
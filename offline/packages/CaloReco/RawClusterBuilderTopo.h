@@ -9,12 +9,15 @@
 
 #include <fun4all/SubsysReco.h>
 
+#include <map>
 #include <string>
+#include <utility>
 #include <vector>
-#include <map>
 
 class PHCompositeNode;
+class RawCluster;
 class RawClusterContainer;
+class RawTowerContainer;
 class RawTowerGeomContainer;
 
 class RawClusterBuilderTopo : public SubsysReco
@@ -81,17 +84,35 @@ class RawClusterBuilderTopo : public SubsysReco
 
   }
 
+  // topo-clusters are split into final clusters in nthreads threads
+  // they do not share towers, final clusters are added to the node in the same order
+  void set_nthreads( unsigned int nthreads ) {
+
+    _nthreads = ( nthreads > 0 ? nthreads : 1 );
+
+  }
+
  private:
 
   void CreateNodes(PHCompositeNode *topNode);
 
-  std::vector< std::vector< std::vector<float> > > _TOWERMAP_E_LAYER_ETA_PHI;
-  std::vector< std::vector< std::vector<int> > > _TOWERMAP_KEY_LAYER_ETA_PHI;
-  std::vector< std::vector< std::vector<int> > > _TOWERMAP_STATUS_LAYER_ETA_PHI;
+  // dense tower index across the three layers, indexed by tower ID (see get_ID)
+  std::vector<float> _tower_E;
+  std::vector<int> _tower_key;
+  std::vector<int> _tower_status;
+
+  // ownership in the splitting step, indexed by tower ID
+  std::vector< std::pair<int,int> > _tower_ownership;
+
+  // precomputed adjacency, the neighbors of ID are _adjacency[ _adjacency_offset[ ID ] ] to _adjacency[ _adjacency_offset[ ID + 1 ] - 1 ]
+  std::vector<int> _adjacency_offset;
+  std::vector<int> _adjacency;
 
-  std::vector< std::vector<float> > _EMTOWERMAP_E_ETA_PHI;
-  std::vector< std::vector<int> > _EMTOWERMAP_KEY_ETA_PHI;
-  std::vector< std::vector<int> > _EMTOWERMAP_STATUS_ETA_PHI;
+  // tower key => tower ID, filled on first use since the geometry bin search is slow
+  std::map<unsigned int, int> _tower_ID_by_key;
+
+  // growth queue, reused for all clusters
+  std::vector<int> _grow_queue;
 
   // geometric constants to express IHCal<->EMCal overlap in eta
   static int RawClusterBuilderTopo_constants_EMCal_eta_start_given_IHCal[];
@@ -118,11 +139,21 @@ class RawClusterBuilderTopo : public SubsysReco
 
   std::vector<int> get_adjacent_towers_by_ID( int ID );
 
+  // allocate the tower index and fill the adjacency table, once the geometry is known
+  void build_tower_index();
+
+  // copy towers of one layer to the tower index, adding seeds
+  void fill_towers( RawTowerContainer*, int ilayer, std::vector< std::pair<int, float> >& list_of_seeds );
+
   float calculate_dR( float, float, float, float );
 
-  void export_single_cluster(std::vector<int>);
+  // split topo-cluster cl around its local maxima
+  void split_cluster( int cl, const std::vector<int>& original_towers, std::vector<RawCluster*>& clusters );
+
+  void export_single_cluster( const std::vector<int>& original_towers, std::vector<RawCluster*>& clusters );
 
-  void export_clusters(std::vector<int>, std::map< int, std::pair<int,int> >, unsigned int, std::vector<float>, std::vector<float>, std::vector<float> );
+  // build final clusters from the ownership in _tower_ownership
+  void export_clusters( const std::vector<int>& original_towers, unsigned int n_clusters, const std::vector<float>& pseudocluster_sumE, const std::vector<float>& pseudocluster_eta, const std::vector<float>& pseudocluster_phi, std::vector<RawCluster*>& clusters );
 
   int get_ID( int ilayer, int ieta, int iphi ) {
     if ( ilayer < 2 ) return ilayer * _HCAL_NETA * _HCAL_NPHI + ieta * _HCAL_NPHI + iphi;
@@ -144,22 +175,15 @@ class RawClusterBuilderTopo : public SubsysReco
     else return ( (int) ( ( ID - _EMCAL_NPHI * _EMCAL_NETA ) % _EMCAL_NPHI ) );
   }
 
-  int get_status_from_ID( int ID ) {
-    if ( ID < _EMCAL_NPHI * _EMCAL_NETA ) return _TOWERMAP_STATUS_LAYER_ETA_PHI[ get_ilayer_from_ID( ID ) ][ get_ieta_from_ID( ID ) ][ get_iphi_from_ID( ID ) ];
-    else return _EMTOWERMAP_STATUS_ETA_PHI[ get_ieta_from_ID( ID ) ][ get_iphi_from_ID( ID ) ];
-  }
+  int get_status_from_ID( int ID ) const { return _tower_status[ ID ]; }
 
-  float get_E_from_ID( int ID ) {
-    if ( ID < _EMCAL_NPHI * _EMCAL_NETA ) return _TOWERMAP_E_LAYER_ETA_PHI[ get_ilayer_from_ID( ID ) ][ get_ieta_from_ID( ID ) ][ get_iphi_from_ID( ID ) ];
-    else return _EMTOWERMAP_E_ETA_PHI[ get_ieta_from_ID( ID ) ][ get_iphi_from_ID( ID ) ];
-  }
+  float get_E_from_ID( int ID ) const { return _tower_E[ ID ]; }
 
-  void set_status_by_ID( int ID , int status ) {
-    if ( ID < _EMCAL_NPHI * _EMCAL_NETA ) _TOWERMAP_STATUS_LAYER_ETA_PHI[ get_ilayer_from_ID( ID ) ][ get_ieta_from_ID( ID ) ][ get_iphi_from_ID( ID ) ] = status;
-    else _EMTOWERMAP_STATUS_ETA_PHI[ get_ieta_from_ID( ID ) ][ get_iphi_from_ID( ID ) ] = status;
-  }
+  void set_status_by_ID( int ID , int status ) { _tower_status[ ID ] = status; }
   
   RawClusterContainer *_clusters;
+  //! RawCluster version created, RawClusterContainer::ClusterVersion()
+  int m_ClusterVersion;
   
   RawTowerGeomContainer* _geom_containers[3];
 
@@ -178,6 +202,8 @@ class RawClusterBuilderTopo : public SubsysReco
   float _local_max_minE_LAYER[3];
   float _R_shower;
 
+  unsigned int _nthreads;
+
   std::string ClusterNodeName;
 };
 
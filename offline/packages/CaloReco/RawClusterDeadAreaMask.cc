@@ -150,7 +150,7 @@ int RawClusterDeadAreaMask::process_event(PHCompositeNode *topNode)
         if (iphi >= phi_bins) iphi -= phi_bins;
         if (iphi < 0) iphi += phi_bins;
 
-        const bool isDead = m_deadMap->isDeadTower(ieta, iphi);
+        const bool isDead = m_deadStencil.is_dead(ieta, iphi);
 
         // dead tower found in cluster
         if (Verbosity() > VERBOSITY_MORE)
@@ -259,6 +259,15 @@ void RawClusterDeadAreaMask::CreateNodeTree(PHCompositeNode *topNode)
          << "CreateNodeTree"
          << " use dead map: ";
     m_deadMap->identify();
+
+    if (!m_deadStencil.build(m_deadMap, m_geometry))
+    {
+      throw std::runtime_error("invalid dead tower in " + deadMapName + " in RawClusterDeadAreaMask::CreateNodeTree");
+    }
+  }
+  else
+  {
+    m_deadStencil.clear();
   }
 }
 
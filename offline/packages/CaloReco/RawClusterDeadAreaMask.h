@@ -1,6 +1,8 @@
 #ifndef CALORECO_RAWCLUSTERDEADAREAMASK_H
 #define CALORECO_RAWCLUSTERDEADAREAMASK_H
 
+#include <calobase/RawTowerDeadStencil.h>
+
 #include <fun4all/SubsysReco.h>
 
 #include <string>
@@ -43,6 +45,9 @@ class RawClusterDeadAreaMask : public SubsysReco
   RawTowerDeadMap *m_deadMap;
   RawTowerContainer *m_calibTowers;
   RawTowerGeomContainer *m_geometry;
+
+  //! dense dead tower mask, built in InitRun
+  RawTowerDeadStencil m_deadStencil;
 };
 
 #endif
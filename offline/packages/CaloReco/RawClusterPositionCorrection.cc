@@ -20,6 +20,7 @@
 #include <phool/phool.h>
 
 #include <cassert>
+#include <cmath>
 #include <fstream>
 #include <iostream>
 #include <map>
@@ -35,7 +36,9 @@ RawClusterPositionCorrection::RawClusterPositionCorrection(const std::string &na
   : SubsysReco(string("RawClusterPositionCorrection_") + name)
   , _eclus_calib_params(string("eclus_params_") + name)
   , _ecore_calib_params(string("ecore_params_") + name)
+  , _recalib_clusters(nullptr)
   , _det_name(name)
+  , _in_place(false)
   , bins(17)  //default bins to be 17 to set default recalib parameters to 1
 {
   SetDefaultParameters(_eclus_calib_params);
@@ -64,40 +67,26 @@ int RawClusterPositionCorrection::InitRun(PHCompositeNode *topNode)
   bins = _eclus_calib_params.get_int_param(paramname.str()) + 1;
 
   //set bin boundaries
-
+  binvals.clear();
   for (int j = 0; j < bins; j++)
   {
     binvals.push_back(0. + j * 2. / (float) (bins - 1));
   }
 
+  // flat tables of the constants, the string keyed parameters are only read here
+  eclus_calib_constants.assign((bins - 1) * (bins - 1), 1);
+  ecore_calib_constants.assign((bins - 1) * (bins - 1), 1);
   for (int i = 0; i < bins - 1; i++)
   {
-    std::vector<double> dumvec;
-
     for (int j = 0; j < bins - 1; j++)
     {
       std::ostringstream calib_const_name;
       calib_const_name.str("");
       calib_const_name << "recalib_const_eta"
                        << i << "_phi" << j;
-      dumvec.push_back(_eclus_calib_params.get_double_param(calib_const_name.str()));
+      eclus_calib_constants[i * (bins - 1) + j] = _eclus_calib_params.get_double_param(calib_const_name.str());
+      ecore_calib_constants[i * (bins - 1) + j] = _ecore_calib_params.get_double_param(calib_const_name.str());
     }
-    eclus_calib_constants.push_back(dumvec);
-  }
-
-  for (int i = 0; i < bins - 1; i++)
-  {
-    std::vector<double> dumvec;
-
-    for (int j = 0; j < bins - 1; j++)
-    {
-      std::ostringstream calib_const_name;
-      calib_const_name.str("");
-      calib_const_name << "recalib_const_eta"
-                       << i << "_phi" << j;
-      dumvec.push_back(_ecore_calib_params.get_double_param(calib_const_name.str()));
-    }
-    ecore_calib_constants.push_back(dumvec);
   }
 
   return Fun4AllReturnCodes::EVENT_OK;
@@ -142,15 +131,19 @@ int RawClusterPositionCorrection::process_event(PHCompositeNode *topNode)
     //    RawClusterDefs::keytype key = iter->first;
     RawCluster *cluster = iter->second;
 
-    float clus_energy = cluster->get_energy();
-
-    std::vector<float> toweretas;
-    std::vector<float> towerphis;
-    std::vector<float> towerenergies;
+    const float clus_energy = cluster->get_energy();
+    const float clus_ecore = cluster->get_ecore();
 
-    //loop over the towers in the cluster
+    //loop over the towers in the cluster to determine the energy
+    //weighted eta and phi position of the cluster
     RawCluster::TowerConstRange towers = cluster->get_towers();
     RawCluster::TowerConstIterator toweriter;
+    assert(towers.first != towers.second);
+
+    float etamult = 0;
+    float phimult = 0;
+    float esum = 0;
+    int firstphi = 0;
 
     for (toweriter = towers.first;
          toweriter != towers.second;
@@ -158,86 +151,57 @@ int RawClusterPositionCorrection::process_event(PHCompositeNode *topNode)
     {
       RawTower *tower = _towers->getTower(toweriter->first);
 
-      int towereta = tower->get_bineta();
+      const int towereta = tower->get_bineta();
       int towerphi = tower->get_binphi();
-      double towerenergy = tower->get_energy();
-
-      //put the etabin, phibin, and energy into the corresponding vectors
-      toweretas.push_back(towereta);
-      towerphis.push_back(towerphi);
-      towerenergies.push_back(towerenergy);
+      const float towerenergy = tower->get_energy();
+
+      if (toweriter == towers.first)
+      {
+        firstphi = towerphi;
+      }
+      if (towerphi - firstphi < -nphibin / 2.0)
+        towerphi += nphibin;
+      else if (towerphi - firstphi > +nphibin / 2.0)
+        towerphi -= nphibin;
+      assert(abs(towerphi - firstphi) <= nphibin / 2.0);
+
+      etamult += towerenergy * towereta;
+      phimult += towerenergy * towerphi;
+      esum += towerenergy;
     }
 
-    int ntowers = toweretas.size();
-    assert(ntowers >= 1);
-
-    //loop over the towers to determine the energy
-    //weighted eta and phi position of the cluster
-
-    float etamult = 0;
-    float etasum = 0;
-    float phimult = 0;
-    float phisum = 0;
-
-    for (int j = 0; j < ntowers; j++)
-    {
-      float energymult = towerenergies.at(j) * toweretas.at(j);
-      etamult += energymult;
-      etasum += towerenergies.at(j);
-
-      int phibin = towerphis.at(j);
-
-      if (phibin - towerphis.at(0) < -nphibin / 2.0)
-        phibin += nphibin;
-      else if (phibin - towerphis.at(0) > +nphibin / 2.0)
-        phibin -= nphibin;
-      assert(abs(phibin - towerphis.at(0)) <= nphibin / 2.0);
-
-      energymult = towerenergies.at(j) * phibin;
-      phimult += energymult;
-      phisum += towerenergies.at(j);
-    }
-
-    float avgphi = phimult / phisum;
-    float avgeta = etamult / etasum;
+    float avgphi = phimult / esum;
+    float avgeta = etamult / esum;
 
     if (avgphi < 0) avgphi += nphibin;
 
     //this determines the position of the cluster in the 2x2 block
-    float fmodphi = fmod(avgphi, 2.);
-    float fmodeta = fmod(avgeta, 2.);
-
-    //determine the bin number
     //2 is here since we divide the 2x2 block into 16 bins in eta/phi
-
-    int etabin = -99;
-    int phibin = -99;
-    for (int j = 0; j < bins - 1; j++)
-      if (fmodphi >= binvals.at(j) && fmodphi <= binvals.at(j + 1))
-        phibin = j;
-
-    for (int j = 0; j < bins - 1; j++)
-      if (fmodeta >= binvals.at(j) && fmodeta <= binvals.at(j + 1))
-        etabin = j;
+    const int phibin = get_bin(fmod(avgphi, 2.));
+    const int etabin = get_bin(fmod(avgeta, 2.));
 
     if ((phibin < 0 || etabin < 0) && Verbosity())
     {
-      if (Verbosity())
-        std::cout << "couldn't recalibrate cluster, something went wrong??" << std::endl;
+      std::cout << "couldn't recalibrate cluster, something went wrong??" << std::endl;
     }
 
     float eclus_recalib_val = 1;
     float ecore_recalib_val = 1;
     if (phibin > -1 && etabin > -1)
     {
-      eclus_recalib_val = eclus_calib_constants.at(etabin).at(phibin);
-      ecore_recalib_val = ecore_calib_constants.at(etabin).at(phibin);
+      eclus_recalib_val = eclus_calib_constants[etabin * (bins - 1) + phibin];
+      ecore_recalib_val = ecore_calib_constants[etabin * (bins - 1) + phibin];
+    }
+
+    RawCluster *recalibcluster = cluster;
+    if (!_in_place)
+    {
+      recalibcluster = dynamic_cast<RawCluster *>(cluster->CloneMe());
+      assert(recalibcluster);
+      _recalib_clusters->AddCluster(recalibcluster);
     }
-    RawCluster *recalibcluster = dynamic_cast<RawCluster *>(cluster->CloneMe());
-    assert(recalibcluster);
     recalibcluster->set_energy(clus_energy / eclus_recalib_val);
-    recalibcluster->set_ecore(cluster->get_ecore() / ecore_recalib_val);
-    _recalib_clusters->AddCluster(recalibcluster);
+    recalibcluster->set_ecore(clus_ecore / ecore_recalib_val);
 
     if (Verbosity() && clus_energy > 1)
     {
@@ -246,10 +210,10 @@ int RawClusterPositionCorrection::process_event(PHCompositeNode *topNode)
       std::cout << "Recalibrated eclus cluster energy: "
                 << clus_energy / eclus_recalib_val << endl;
       std::cout << "Input ecore cluster energy: "
-                << cluster->get_ecore() << endl;
+                << clus_ecore << endl;
       std::cout << "Recalib value: " << ecore_recalib_val << endl;
       std::cout << "Recalibrated eclus cluster energy: "
-                << cluster->get_ecore() / ecore_recalib_val << endl;
+                << clus_ecore / ecore_recalib_val << endl;
     }
   }
 
@@ -281,7 +245,7 @@ void RawClusterPositionCorrection::CreateNodeTree(PHCompositeNode *topNode)
   }
 
   //Check to see if the cluster recalib node is on the nodetree
-  _recalib_clusters = findNode::getClass<RawClusterContainer>(topNode, "CLUSTER_RECALIB_" + _det_name);
+  _recalib_clusters = findNode::getClass<RawClusterContainer>(topNode, "CLUSTER_POS_COR_" + _det_name);
 
   //If not, make it and add it to the _det_name subnode
   if (!_recalib_clusters)
@@ -299,6 +263,22 @@ void RawClusterPositionCorrection::CreateNodeTree(PHCompositeNode *topNode)
   const string paramNodeName2 = string("ecore_Recalibration_" + _det_name);
   _ecore_calib_params.SaveToNodeTree(parNode, paramNodeName2);
 }
+int RawClusterPositionCorrection::get_bin(const float fmodpos) const
+{
+  // equidistant bins, a position on a bin boundary goes to the upper bin
+  // as in a scan over binvals
+  if (fmodpos < binvals.front() || fmodpos > binvals.back())
+  {
+    return -1;
+  }
+  int bin = (fmodpos - binvals.front()) / (binvals.back() - binvals.front()) * (bins - 1);
+  if (bin > bins - 2) bin = bins - 2;
+  // rounding of the division against the stored boundaries
+  if (bin > 0 && fmodpos < binvals[bin]) --bin;
+  if (bin < bins - 2 && fmodpos >= binvals[bin + 1]) ++bin;
+  return bin;
+}
+
 int RawClusterPositionCorrection::End(PHCompositeNode *topNode)
 {
   return Fun4AllReturnCodes::EVENT_OK;
@@ -48,6 +48,9 @@ class RawClusterPositionCorrection : public SubsysReco
     _ecore_calib_params = calib_params;
   }
 
+  //! correct the clusters of CLUSTER_<det> in place instead of writing corrected copies to CLUSTER_POS_COR_<det>
+  void set_correct_in_place(const bool b) { _in_place = b; }
+
  private:
   PHParameters _eclus_calib_params;
   PHParameters _ecore_calib_params;
@@ -56,10 +59,18 @@ class RawClusterPositionCorrection : public SubsysReco
 
   std::string _det_name;
 
+  //! no copies in CLUSTER_POS_COR_<det>
+  bool _in_place;
+
   int bins;
   std::vector<float> binvals;
-  std::vector<std::vector<double> > eclus_calib_constants;
-  std::vector<std::vector<double> > ecore_calib_constants;
+
+  //! correction factors per (eta, phi) bin, etabin * (bins - 1) + phibin, read from the parameters in InitRun
+  std::vector<float> eclus_calib_constants;
+  std::vector<float> ecore_calib_constants;
+
+  //! correction bin of the position in the 2x2 block, -1 if outside
+  int get_bin(const float fmodpos) const;
 };
 
 #endif
@@ -5,6 +5,8 @@
 #include <calobase/RawTowerGeomContainer.h>
 #include <calobase/RawTower.h>
 #include <calobase/RawTowerv1.h>
+#include <calobase/RawTowerv2.h>
+#include <calobase/RawTowerv3.h>
 #include <calobase/RawTowerDefs.h>
 
 #include <phparameter/PHParameters.h>
@@ -54,6 +56,7 @@ RawTowerCalibration::RawTowerCalibration(const std::string &name)
   _zero_suppression_GeV(0)
   ,  //
   _tower_type(-1)
+  , _compact_towers(false)
   , _tower_calib_params(name)
 {
 }
@@ -82,6 +85,16 @@ int RawTowerCalibration::InitRun(PHCompositeNode *topNode)
     std::cout << e.what() << std::endl;
     return Fun4AllReturnCodes::ABORTRUN;
   }
+
+  // the parameters may be changed between runs, start with an empty cache
+  _geom_table.build(rawtowergeom);
+  _tower_by_tower_calib.assign(_geom_table.size(), NAN);
+  _tower_by_tower_calib_valid.assign(_geom_table.size(), false);
+
+  DeclareInputNode(RawTowerNodeName);
+  DeclareInputNode(TowerGeomNodeName);
+  DeclareOutputNode(CaliTowerNodeName);
+
   return Fun4AllReturnCodes::EVENT_OK;
 }
 
@@ -101,12 +114,12 @@ int RawTowerCalibration::process_event(PHCompositeNode *topNode)
     const RawTower *raw_tower = rtiter->second;
     assert(raw_tower);
 
-    RawTowerGeom *raw_tower_geom = rawtowergeom->get_tower_geometry(
-        raw_tower->get_id());
-    assert(raw_tower_geom);
-
     if (_tower_type >= 0)
     {
+      RawTowerGeom *raw_tower_geom = rawtowergeom->get_tower_geometry(
+          raw_tower->get_id());
+      assert(raw_tower_geom);
+
       // Skip towers that don't match the type we are supposed to calibrate
       if (_tower_type != raw_tower_geom->get_tower_type())
       {
@@ -118,7 +131,7 @@ int RawTowerCalibration::process_event(PHCompositeNode *topNode)
     {
       if (raw_tower->get_energy() > _zero_suppression_GeV)
       {
-        _calib_towers->AddTower(key, new RawTowerv1(*raw_tower));
+        _calib_towers->AddTower(key, new_calib_tower(raw_tower));
       }
     }
     else if (_calib_algorithm == kSimple_linear_calibration)
@@ -128,26 +141,22 @@ int RawTowerCalibration::process_event(PHCompositeNode *topNode)
 
       if (calib_energy > _zero_suppression_GeV)
       {
-        RawTower *calib_tower = new RawTowerv1(*raw_tower);
+        RawTower *calib_tower = new_calib_tower(raw_tower);
         calib_tower->set_energy(calib_energy);
         _calib_towers->AddTower(key, calib_tower);
       }
     }
     else if (_calib_algorithm == kTower_by_tower_calibration)
     {
-      const int eta = raw_tower->get_bineta();
-      const int phi = raw_tower->get_binphi();
-      const string calib_const_name("calib_const_eta" + to_string(eta) + "_phi" + to_string(phi));
-
       const double tower_by_tower_calib =
-          _tower_calib_params.get_double_param(calib_const_name);
+          get_tower_by_tower_calib(key, raw_tower->get_bineta(), raw_tower->get_binphi());
 
       const double raw_energy = raw_tower->get_energy();
       const double calib_energy = (raw_energy - _pedstal_ADC) * _calib_const_GeV_ADC * tower_by_tower_calib;
 
       if (calib_energy > _zero_suppression_GeV)
       {
-        RawTower *calib_tower = new RawTowerv1(*raw_tower);
+        RawTower *calib_tower = new_calib_tower(raw_tower);
         calib_tower->set_energy(calib_energy);
         _calib_towers->AddTower(key, calib_tower);
       }
@@ -172,6 +181,39 @@ int RawTowerCalibration::process_event(PHCompositeNode *topNode)
   return Fun4AllReturnCodes::EVENT_OK;
 }
 
+RawTower *RawTowerCalibration::new_calib_tower(const RawTower *raw_tower) const
+{
+  if (_compact_towers)
+  {
+    return new RawTowerv2(*raw_tower);
+  }
+  if (dynamic_cast<const RawTowerv3 *>(raw_tower))
+  {
+    // no truth to copy
+    return new RawTowerv3(*raw_tower);
+  }
+  return new RawTowerv1(*raw_tower);
+}
+
+double RawTowerCalibration::get_tower_by_tower_calib(const RawTowerDefs::keytype key, const int eta, const int phi)
+{
+  const int itower = _geom_table.find(key);
+  if (itower >= 0 && _tower_by_tower_calib_valid[itower])
+  {
+    return _tower_by_tower_calib[itower];
+  }
+
+  const string calib_const_name("calib_const_eta" + to_string(eta) + "_phi" + to_string(phi));
+  const double tower_by_tower_calib = _tower_calib_params.get_double_param(calib_const_name);
+
+  if (itower >= 0)
+  {
+    _tower_by_tower_calib[itower] = tower_by_tower_calib;
+    _tower_by_tower_calib_valid[itower] = true;
+  }
+  return tower_by_tower_calib;
+}
+
 int RawTowerCalibration::End(PHCompositeNode *topNode)
 {
   return Fun4AllReturnCodes::EVENT_OK;
@@ -1,13 +1,17 @@
 #ifndef CALORECO_RAWTOWERCALIBRATION_H
 #define CALORECO_RAWTOWERCALIBRATION_H
 
+#include <calobase/RawTowerGeomTable.h>
+
 #include <fun4all/SubsysReco.h>
 
 #include <phparameter/PHParameters.h>
 
 #include <string>
+#include <vector>
 
 class PHCompositeNode;
+class RawTower;
 class RawTowerContainer;
 class RawTowerGeomContainer;
 
@@ -25,6 +29,10 @@ class RawTowerCalibration : public SubsysReco
   int InitRun(PHCompositeNode *topNode);
   int process_event(PHCompositeNode *topNode);
   int End(PHCompositeNode *topNode);
+
+  //! the calibration cache is per module, the node names are declared in InitRun
+  bool ThreadSafe() const { return true; }
+
   void
   Detector(const std::string &d)
   {
@@ -121,6 +129,13 @@ class RawTowerCalibration : public SubsysReco
     _zero_suppression_GeV = zeroSuppressionGeV;
   }
 
+  //! write RawTowerv2 (half precision energy and time, no truth) for compact DSTs
+  void
+  set_compact_towers(const bool b)
+  {
+    _compact_towers = b;
+  }
+
   //! Get the parameters for update. Useful fields are listed in SetDefaultParameters();
   PHParameters &
   GetCalibrationParameters()
@@ -158,8 +173,24 @@ class RawTowerCalibration : public SubsysReco
   //! tower type to act on
   int _tower_type;
 
+  //! calibrated towers are RawTowerv2 instead of RawTowerv1
+  bool _compact_towers;
+
   //! Tower by tower calibration parameters
   PHParameters _tower_calib_params;
+
+  //! tower index for the per channel constants below, built in InitRun
+  RawTowerGeomTable _geom_table;
+
+  //! tower by tower calibration constant per channel, looked up in _tower_calib_params on first use
+  std::vector<double> _tower_by_tower_calib;
+  std::vector<bool> _tower_by_tower_calib_valid;
+
+  //! copy of the raw tower in the configured output class
+  RawTower *new_calib_tower(const RawTower *raw_tower) const;
+
+  //! tower by tower calibration constant of this tower
+  double get_tower_by_tower_calib(const RawTowerDefs::keytype key, const int eta, const int phi);
 };
 
 #endif
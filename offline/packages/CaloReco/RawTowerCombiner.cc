@@ -4,6 +4,7 @@
 #include <calobase/RawTowerGeomv1.h>
 #include <calobase/RawTower.h>
 #include <calobase/RawTowerv1.h>
+#include <calobase/RawTowerv3.h>
 #include <calobase/RawTowerDefs.h>
 #include <calobase/RawTowerGeomContainer.h>
 
@@ -40,6 +41,10 @@ RawTowerCombiner::RawTowerCombiner(const std::string &name)
   /*unsigned int*/ _n_combine_phi(2)
   ,
   /*RawTowerContainer**/ _towers(nullptr)
+  , _input_etabins(0)
+  , _input_phibins(0)
+  , _output_etabins(0)
+  , _output_phibins(0)
   ,
   /*std::string*/ detector("NONE")
 {
@@ -99,42 +104,33 @@ int RawTowerCombiner::process_event(PHCompositeNode *topNode)
     std::cout << __PRETTY_FUNCTION__ << "Process event entered" << std::endl;
   }
 
-  typedef pair<int, int> tower_id_t;
-  typedef map<tower_id_t, RawTower *> new_tower_map_t;
-  new_tower_map_t new_tower_map;
-
-  RawTowerContainer::ConstRange all_towers = _towers->getTowers();
-  for (RawTowerContainer::ConstIterator it = all_towers.first;
-       it != all_towers.second; ++it)
+  // gather the MxN input towers of each output tower through the tower grid
+  unsigned int n_gathered = 0;
+  for (unsigned int itower = 0; itower < _output_towers.size(); ++itower)
   {
-    const RawTower *input_tower = it->second;
-    assert(input_tower);
-
-    const int intput_eta = input_tower->get_bineta();
-    const int intput_phi = input_tower->get_binphi();
-    const int output_eta = get_output_bin_eta(intput_eta);
-    const int output_phi = get_output_bin_phi(intput_phi);
-
     RawTower *output_tower = nullptr;
-    new_tower_map_t::iterator it_new = new_tower_map.find(
-        make_pair(output_eta, output_phi));
-
-    if (it_new == new_tower_map.end())
+    for (unsigned int isource = _gather_first[itower]; isource < _gather_first[itower + 1]; ++isource)
     {
-      output_tower = new RawTowerv1(*input_tower);
-      assert(output_tower);
-      new_tower_map[make_pair(output_eta, output_phi)] = output_tower;
+      const RawTower *input_tower = _towers->getTower(_gather_eta[isource], _gather_phi[isource]);
+      if (!input_tower)
+      {
+        continue;
+      }
+      ++n_gathered;
 
-      if (Verbosity() >= VERBOSITY_MORE)
+      if (!output_tower)
       {
-        std::cout << __PRETTY_FUNCTION__ << "::" << detector << "::"
-                  << " new output tower (prior to tower ID assignment): ";
-        output_tower->identify();
+        output_tower = new_output_tower(input_tower);
+        assert(output_tower);
+
+        if (Verbosity() >= VERBOSITY_MORE)
+        {
+          std::cout << __PRETTY_FUNCTION__ << "::" << detector << "::"
+                    << " new output tower (prior to tower ID assignment): ";
+          output_tower->identify();
+        }
+        continue;
       }
-    }
-    else
-    {
-      output_tower = it_new->second;
 
       output_tower->set_energy(
           output_tower->get_energy() + input_tower->get_energy());
@@ -169,19 +165,26 @@ int RawTowerCombiner::process_event(PHCompositeNode *topNode)
         output_tower->identify();
       }
     }
+    _output_towers[itower] = output_tower;
+  }
+
+  if (n_gathered != input_n_tower)
+  {
+    std::cout << Name() << "::" << detector << "::" << __PRETTY_FUNCTION__
+              << " " << input_n_tower - n_gathered << " input towers outside of the "
+              << _input_etabins << " x " << _input_phibins << " tower geometry are dropped" << std::endl;
   }
 
   // replace content in tower container
   _towers->Reset();
 
-  for (new_tower_map_t::iterator it = new_tower_map.begin();
-       it != new_tower_map.end(); ++it)
+  for (unsigned int itower = 0; itower < _output_towers.size(); ++itower)
   {
-    const int eta = it->first.first;
-    const int phi = it->first.second;
-    RawTower *tower = it->second;
-
-    _towers->AddTower(eta, phi, tower);
+    if (_output_towers[itower])
+    {
+      _towers->AddTower(itower / _output_phibins, itower % _output_phibins, _output_towers[itower]);
+      _output_towers[itower] = nullptr;
+    }
   }
 
   if (Verbosity())
@@ -189,12 +192,59 @@ int RawTowerCombiner::process_event(PHCompositeNode *topNode)
     std::cout << Name() << "::" << detector << "::" << __PRETTY_FUNCTION__
               << "input sum energy = " << input_e_sum << " from " << input_n_tower << " towers, merged sum energy = "
               << _towers->getTotalEdep() << " from " << _towers->size() << " towers" << std::endl;
-    assert(input_e_sum == _towers->getTotalEdep());
   }
 
   return Fun4AllReturnCodes::EVENT_OK;
 }
 
+RawTower *RawTowerCombiner::new_output_tower(const RawTower *input_tower) const
+{
+  if (dynamic_cast<const RawTowerv3 *>(input_tower))
+  {
+    return new RawTowerv3(*input_tower);
+  }
+  return new RawTowerv1(*input_tower);
+}
+
+void RawTowerCombiner::BuildGatherTable(const int input_etabins, const int input_phibins)
+{
+  _input_etabins = input_etabins;
+  _input_phibins = input_phibins;
+  _output_etabins = ceil(double(input_etabins) / double(_n_combine_eta));
+  _output_phibins = ceil(double(input_phibins) / double(_n_combine_phi));
+
+  const unsigned int n_output = _output_etabins * _output_phibins;
+  _gather_first.assign(1, 0);
+  _gather_eta.clear();
+  _gather_phi.clear();
+  _gather_eta.reserve(input_etabins * input_phibins);
+  _gather_phi.reserve(input_etabins * input_phibins);
+  for (int oeta = 0; oeta < _output_etabins; ++oeta)
+  {
+    for (int ophi = 0; ophi < _output_phibins; ++ophi)
+    {
+      for (int ieta = oeta * _n_combine_eta; ieta < min(int((oeta + 1) * _n_combine_eta), input_etabins); ++ieta)
+      {
+        for (int iphi = ophi * _n_combine_phi; iphi < min(int((ophi + 1) * _n_combine_phi), input_phibins); ++iphi)
+        {
+          assert(get_output_bin_eta(ieta) == oeta && get_output_bin_phi(iphi) == ophi);
+          _gather_eta.push_back(ieta);
+          _gather_phi.push_back(iphi);
+        }
+      }
+      _gather_first.push_back(_gather_eta.size());
+    }
+  }
+  _output_towers.assign(n_output, nullptr);
+
+  if (Verbosity())
+  {
+    std::cout << Name() << "::" << detector << "::" << __PRETTY_FUNCTION__
+              << " combining " << input_etabins << " x " << input_phibins << " into "
+              << _output_etabins << " x " << _output_phibins << " towers" << std::endl;
+  }
+}
+
 int RawTowerCombiner::End(PHCompositeNode *topNode)
 {
   return Fun4AllReturnCodes::EVENT_OK;
@@ -230,82 +280,96 @@ void RawTowerCombiner::CreateNodes(PHCompositeNode *topNode)
 
   const double r = towergeom->get_radius();
 
-  const int new_phibins = ceil(
-      double(towergeom->get_phibins()) / double(_n_combine_phi));
-  const int new_etabins = ceil(
-      double(towergeom->get_etabins()) / double(_n_combine_eta));
+  if (_input_etabins > 0 && towergeom->get_etabins() == _output_etabins && towergeom->get_phibins() == _output_phibins)
+  {
+    // geometry on the node tree was already combined in a previous run
+    if (Verbosity())
+    {
+      std::cout << __PRETTY_FUNCTION__ << " - " << iTowerGeomNodeName
+                << " already combined, kept" << std::endl;
+    }
+  }
+  else
+  {
+    BuildGatherTable(towergeom->get_etabins(), towergeom->get_phibins());
 
-  typedef std::pair<double, double> bound_t;
-  typedef std::vector<bound_t> bound_map_t;
+    const int new_phibins = ceil(
+        double(towergeom->get_phibins()) / double(_n_combine_phi));
+    const int new_etabins = ceil(
+        double(towergeom->get_etabins()) / double(_n_combine_eta));
 
-  bound_map_t eta_bound_map;
-  bound_map_t phi_bound_map;
+    typedef std::pair<double, double> bound_t;
+    typedef std::vector<bound_t> bound_map_t;
 
-  for (int ibin = 0; ibin < new_phibins; ibin++)
-  {
-    const int first_bin = ibin * _n_combine_phi;
-    assert(first_bin >= 0 && first_bin < towergeom->get_phibins());
+    bound_map_t eta_bound_map;
+    bound_map_t phi_bound_map;
 
-    int last_bin = (ibin + 1) * _n_combine_phi - 1;
-    if (last_bin >= towergeom->get_phibins())
-      last_bin = towergeom->get_phibins();
+    for (int ibin = 0; ibin < new_phibins; ibin++)
+    {
+      const int first_bin = ibin * _n_combine_phi;
+      assert(first_bin >= 0 && first_bin < towergeom->get_phibins());
 
-    const pair<double, double> range1 = towergeom->get_phibounds(
-        first_bin);
-    const pair<double, double> range2 = towergeom->get_phibounds(
-        last_bin);
+      int last_bin = (ibin + 1) * _n_combine_phi - 1;
+      if (last_bin >= towergeom->get_phibins())
+        last_bin = towergeom->get_phibins();
 
-    phi_bound_map.push_back(make_pair(range1.first, range2.second));
-  }
+      const pair<double, double> range1 = towergeom->get_phibounds(
+          first_bin);
+      const pair<double, double> range2 = towergeom->get_phibounds(
+          last_bin);
 
-  for (int ibin = 0; ibin < new_etabins; ibin++)
-  {
-    const int first_bin = ibin * _n_combine_eta;
-    assert(first_bin >= 0 && first_bin < towergeom->get_etabins());
+      phi_bound_map.push_back(make_pair(range1.first, range2.second));
+    }
 
-    int last_bin = (ibin + 1) * _n_combine_eta - 1;
-    if (last_bin >= towergeom->get_etabins())
-      last_bin = towergeom->get_etabins();
+    for (int ibin = 0; ibin < new_etabins; ibin++)
+    {
+      const int first_bin = ibin * _n_combine_eta;
+      assert(first_bin >= 0 && first_bin < towergeom->get_etabins());
 
-    const pair<double, double> range1 = towergeom->get_etabounds(
-        first_bin);
-    const pair<double, double> range2 = towergeom->get_etabounds(
-        last_bin);
+      int last_bin = (ibin + 1) * _n_combine_eta - 1;
+      if (last_bin >= towergeom->get_etabins())
+        last_bin = towergeom->get_etabins();
 
-    eta_bound_map.push_back(make_pair(range1.first, range2.second));
-  }
+      const pair<double, double> range1 = towergeom->get_etabounds(
+          first_bin);
+      const pair<double, double> range2 = towergeom->get_etabounds(
+          last_bin);
 
-  // now update the tower geometry object with the new tower structure.
-  towergeom->Reset();
+      eta_bound_map.push_back(make_pair(range1.first, range2.second));
+    }
 
-  towergeom->set_phibins(new_phibins);
-  towergeom->set_etabins(new_etabins);
+    // now update the tower geometry object with the new tower structure.
+    towergeom->Reset();
 
-  for (int ibin = 0; ibin < new_phibins; ibin++)
-  {
-    towergeom->set_phibounds(ibin, phi_bound_map[ibin]);
-  }
-  for (int ibin = 0; ibin < new_etabins; ibin++)
-  {
-    towergeom->set_etabounds(ibin, eta_bound_map[ibin]);
-  }
+    towergeom->set_phibins(new_phibins);
+    towergeom->set_etabins(new_etabins);
 
-  // setup location of all towers
-  for (int iphi = 0; iphi < towergeom->get_phibins(); iphi++)
-    for (int ieta = 0; ieta < towergeom->get_etabins(); ieta++)
+    for (int ibin = 0; ibin < new_phibins; ibin++)
     {
-      RawTowerGeomv1 *tg = new RawTowerGeomv1(
-          RawTowerDefs::encode_towerid(caloid, ieta, iphi));
+      towergeom->set_phibounds(ibin, phi_bound_map[ibin]);
+    }
+    for (int ibin = 0; ibin < new_etabins; ibin++)
+    {
+      towergeom->set_etabounds(ibin, eta_bound_map[ibin]);
+    }
 
-      CLHEP::Hep3Vector tower_pos;
-      tower_pos.setRhoPhiEta(r, towergeom->get_phicenter(iphi), towergeom->get_etacenter(ieta));
+    // setup location of all towers
+    for (int iphi = 0; iphi < towergeom->get_phibins(); iphi++)
+      for (int ieta = 0; ieta < towergeom->get_etabins(); ieta++)
+      {
+        RawTowerGeomv1 *tg = new RawTowerGeomv1(
+            RawTowerDefs::encode_towerid(caloid, ieta, iphi));
 
-      tg->set_center_x(tower_pos.x());
-      tg->set_center_y(tower_pos.y());
-      tg->set_center_z(tower_pos.z());
+        CLHEP::Hep3Vector tower_pos;
+        tower_pos.setRhoPhiEta(r, towergeom->get_phicenter(iphi), towergeom->get_etacenter(ieta));
 
-      towergeom->add_tower_geometry(tg);
-    }
+        tg->set_center_x(tower_pos.x());
+        tg->set_center_y(tower_pos.y());
+        tg->set_center_z(tower_pos.z());
+
+        towergeom->add_tower_geometry(tg);
+      }
+  }
   if (Verbosity() >= VERBOSITY_SOME)
   {
     towergeom->identify();
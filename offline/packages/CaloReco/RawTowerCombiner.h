@@ -4,8 +4,10 @@
 #include <fun4all/SubsysReco.h>
 
 #include <string>
+#include <vector>
 
 class PHCompositeNode;
+class RawTower;
 class RawTowerContainer;
 
 //! \brief RawTowerCombiner module that joints multiple RawTower together to form a single readout in a separate node
@@ -140,8 +142,31 @@ class RawTowerCombiner : public SubsysReco
   void
   CreateNodes(PHCompositeNode *topNode);
 
+  //! fills the gather table below for the input tower grid
+  void
+  BuildGatherTable(const int input_etabins, const int input_phibins);
+
+  //! copy of the input tower in its own class, which keeps the truth of RawTowerv1
+  RawTower *
+  new_output_tower(const RawTower *input_tower) const;
+
   RawTowerContainer *_towers;
 
+  //! input tower grid and output grid of the current run
+  int _input_etabins;
+  int _input_phibins;
+  int _output_etabins;
+  int _output_phibins;
+
+  //! gather table, the input towers of output tower i (ieta * _output_phibins + iphi)
+  //! are _gather_eta/_gather_phi[_gather_first[i] ... _gather_first[i + 1] - 1]
+  std::vector<unsigned int> _gather_first;
+  std::vector<int> _gather_eta;
+  std::vector<int> _gather_phi;
+
+  //! output towers of the current event on the output grid, reused between events
+  std::vector<RawTower *> _output_towers;
+
   std::string detector;
 };
 
@@ -17,6 +17,7 @@
 #include <phparameter/PHParameters.h>
 
 #include <fun4all/Fun4AllReturnCodes.h>
+#include <fun4all/Fun4AllServer.h>
 #include <fun4all/SubsysReco.h>
 
 #include <phool/PHCompositeNode.h>
@@ -45,6 +46,7 @@
 #include <cassert>
 #include <iostream>
 #include <map>
+#include <memory>
 #include <stdexcept>
 #include <string>
 #include <utility>
@@ -57,6 +59,20 @@ RawTowerDeadMapLoader::RawTowerDeadMapLoader(const std::string &detector)
 {
 }
 
+int RawTowerDeadMapLoader::Init(PHCompositeNode * /*topNode*/)
+{
+  // the dead map file is read together with all other calibrations at BeginRun
+  const string detector = m_detector;
+  const string deadMapPath = m_deadMapPath;
+  Fun4AllServer *se = Fun4AllServer::instance();
+  se->registerCalibrationRequest(Name() + "_DEADMAP", [detector, deadMapPath](const int /*runnumber*/) {
+    PHParameters *deadMapParam = new PHParameters(detector);
+    deadMapParam->ReadFromFile(detector, "xml", 0, 0, deadMapPath);
+    return static_cast<PHObject *>(deadMapParam);
+  });
+  return Fun4AllReturnCodes::EVENT_OK;
+}
+
 int RawTowerDeadMapLoader::InitRun(PHCompositeNode *topNode)
 {
   PHNodeIterator iter(topNode);
@@ -97,10 +113,18 @@ int RawTowerDeadMapLoader::InitRun(PHCompositeNode *topNode)
 
   cout << "RawTowerDeadMapLoader::" << m_detector << "::InitRun - loading dead map from " << m_deadMapPath << endl;
 
-  PHParameters deadMapParam(m_detector);
-  deadMapParam.ReadFromFile(m_detector, "xml", 0, 0, m_deadMapPath);
+  // prefetched by the Fun4AllServer, read it here if that did not work
+  Fun4AllServer *se = Fun4AllServer::instance();
+  PHParameters *deadMapParam = dynamic_cast<PHParameters *>(se->getCalibration(Name() + "_DEADMAP"));
+  unique_ptr<PHParameters> localParam;
+  if (!deadMapParam)
+  {
+    localParam.reset(new PHParameters(m_detector));
+    localParam->ReadFromFile(m_detector, "xml", 0, 0, m_deadMapPath);
+    deadMapParam = localParam.get();
+  }
 
-  const auto in_par_ranges = deadMapParam.get_all_int_params();
+  const auto in_par_ranges = deadMapParam->get_all_int_params();
 
   for (auto iter = in_par_ranges.first; iter != in_par_ranges.second; ++iter)
   {
@@ -27,6 +27,9 @@ class RawTowerDeadMapLoader : public SubsysReco
 
   virtual ~RawTowerDeadMapLoader() {}
 
+  //! registers the dead map with the calibration prefetch of the Fun4AllServer
+  virtual int Init(PHCompositeNode* topNode);
+
   virtual int InitRun(PHCompositeNode* topNode);
 
   const std::string& deadMapPath() const
@@ -80,90 +80,25 @@ int RawTowerDeadTowerInterp::process_event(PHCompositeNode *topNode)
 
   if (m_deadTowerMap)
   {
-    const int eta_bins = m_geometry->get_etabins();
-    const int phi_bins = m_geometry->get_phibins();
+    assert(m_calibTowers);
+    m_stencil.interpolate(m_calibTowers, m_deadEnergies);
 
-    // assume cylindrical calorimeters for now. Need to add swithc for planary calorimeter
-    assert(eta_bins > 0);
-    assert(phi_bins > 0);
-
-    for (const RawTowerDefs::keytype &key : m_deadTowerMap->getDeadTowers())
+    for (unsigned int i = 0; i < m_stencil.size(); ++i)
     {
       ++deadTowerCnt;
 
+      const RawTowerDefs::keytype key = m_stencil.get_dead_key(i);
+      const unsigned int n_neighbor = m_stencil.get_n_neighbors(i);
+
       if (Verbosity() >= VERBOSITY_MORE)
       {
         std::cout << Name() << "::" << m_detector << "::"
                   << "process_event"
-                  << " - processing tower " << key;
+                  << " - processing tower " << key
+                  << " with " << n_neighbor << " alive neighbors";
       }
 
-      // check deadmap validity
-      RawTowerGeom *towerGeom = m_geometry->get_tower_geometry(key);
-      if (towerGeom == nullptr)
-      {
-        std::cerr << Name() << "::" << m_detector << "::"
-                  << "process_event"
-                  << " - invalid dead tower ID " << key << endl;
-
-        exit(2);
-      }
-
-      const int bineta = towerGeom->get_bineta();
-      const int binphi = towerGeom->get_binphi();
-
-      if (Verbosity() >= VERBOSITY_MORE)
-      {
-        cout << " bin " << bineta << "-" << binphi;
-        cout << ". Add neighbors: ";
-      }
-
-      assert(bineta >= 0);
-      assert(bineta <= eta_bins);
-      assert(binphi >= 0);
-      assert(binphi <= phi_bins);
-
-      // eight neighbors
-      static const vector<pair<int, int>> neighborIndexs =
-          {{+1, 0}, {+1, +1}, {0, +1}, {-1, +1}, {-1, 0}, {-1, -1}, {0, -1}, {+1, -1}};
-
-      int n_neighbor = 0;
-      double E_SumNeighbor = 0;
-      for (const pair<int, int> &neighborIndex : neighborIndexs)
-      {
-        int ieta = bineta + neighborIndex.first;
-        int iphi = binphi + neighborIndex.second;
-
-        if (ieta >= eta_bins) continue;
-        if (ieta < 0) continue;
-
-        if (iphi >= phi_bins) iphi -= phi_bins;
-        if (iphi < 0) iphi += phi_bins;
-
-        assert(ieta >= 0);
-        assert(ieta <= eta_bins);
-        assert(iphi >= 0);
-        assert(iphi <= phi_bins);
-
-        if (m_deadTowerMap->isDeadTower(ieta, iphi)) continue;
-
-        ++n_neighbor;
-
-        assert(m_calibTowers);
-        RawTower *neighTower =
-            m_calibTowers->getTower(ieta, iphi);
-        if (neighTower == nullptr) continue;
-
-        if (Verbosity() >= VERBOSITY_MORE)
-        {
-          cout << neighTower->get_energy() << " (" << ieta << "-" << iphi << "), ";
-        }
-
-        E_SumNeighbor += neighTower->get_energy();
-
-      }  // for (const pair<int, int> &neighborIndex : neighborIndexs)
-
-      if (n_neighbor > 0 and E_SumNeighbor != 0)
+      if (n_neighbor > 0 and m_deadEnergies[i] != 0)
       {
         RawTower *deadTower = m_calibTowers->getTower(key);
 
@@ -173,7 +108,7 @@ int RawTowerDeadTowerInterp::process_event(PHCompositeNode *topNode)
         }
         assert(deadTower);
 
-        deadTower->set_energy(E_SumNeighbor / n_neighbor);
+        deadTower->set_energy(m_deadEnergies[i]);
         m_calibTowers->AddTower(key, deadTower);
 
         recovery_energy += deadTower->get_energy();
@@ -189,7 +124,7 @@ int RawTowerDeadTowerInterp::process_event(PHCompositeNode *topNode)
       {
         if (Verbosity() >= VERBOSITY_MORE)
         {
-          cout << "No neighbor towers found.";
+          cout << " No neighbor towers found.";
         }
 
       }  // if (n_neighbor>0) -else
@@ -274,6 +209,16 @@ void RawTowerDeadTowerInterp::CreateNodes(PHCompositeNode *topNode)
     m_geometry->identify();
   }
 
+  if (!m_deadTowerMap)
+  {
+    m_stencil.clear();
+  }
+  else if (!m_stencil.build(m_deadTowerMap, m_geometry))
+  {
+    throw std::runtime_error(
+        "Invalid dead tower in " + deadMapName + " in RawTowerDeadTowerInterp::CreateNodes");
+  }
+
   PHCompositeNode *dstNode = dynamic_cast<PHCompositeNode *>(iter.findFirst(
       "PHCompositeNode", "DST"));
   if (!dstNode)
@@ -1,9 +1,12 @@
 #ifndef CALORECO_RAWTOWERDEADTOWERINTERP_H
 #define CALORECO_RAWTOWERDEADTOWERINTERP_H
 
+#include <calobase/RawTowerDeadStencil.h>
+
 #include <fun4all/SubsysReco.h>
 
 #include <string>
+#include <vector>
 
 class PHCompositeNode;
 class RawTowerContainer;
@@ -37,6 +40,11 @@ class RawTowerDeadTowerInterp : public SubsysReco
   RawTowerGeomContainer *m_geometry;
   RawTowerDeadMap *m_deadTowerMap;
 
+  //! neighbors of the dead towers, built in InitRun as the dead map only changes per run
+  RawTowerDeadStencil m_stencil;
+  //! interpolated energies of the dead towers in this event
+  std::vector<double> m_deadEnergies;
+
   std::string m_detector;
 
   std::string _calib_tower_node_prefix;
@@ -14,7 +14,6 @@
 #include <calobase/RawClusterUtility.h>
 #include <calobase/RawTower.h>
 #include <calobase/RawTowerContainer.h>
-#include <calobase/RawTowerGeom.h>
 #include <calobase/RawTowerGeomContainer.h>
 
 #include <g4vertex/GlobalVertex.h>
@@ -31,26 +30,87 @@
 #include <map>
 #include <utility>
 
-/** \Brief Function to get correct tower eta
+/** \Brief Function to put the towers of this event on the grid
  *
  * Each calorimeter tower's eta is calculated using the vertex (0,0,0)
- * which is incorrect in many collisions. This function 
- * uses geometry to find a given tower's eta using the correct vertex.
+ * which is incorrect in many collisions. With use_vertex the geometry
+ * is used to find a given tower's eta using the correct vertex.
+ * This is done once per event, not for each cluster.
  */
-double ClusterIso::getTowerEta(RawTowerGeom *tower_geom, double vx, double vy, double vz)
+void ClusterIso::fillGrid(RawTowerContainer *towers, const RawTowerGeomTable &geom, bool use_vertex, ClusterIsoGrid &grid)
 {
-  float r;
-  if (vx == 0 && vy == 0 && vz == 0)
+  grid.clear_towers();
+
+  RawTowerContainer::ConstRange begin_end = towers->getTowers();
+  for (RawTowerContainer::ConstIterator rtiter = begin_end.first; rtiter != begin_end.second; ++rtiter)
   {
-    r = tower_geom->get_eta();
+    RawTower *tower = rtiter->second;
+    const int itower = geom.find(tower->get_key());
+    if (itower < 0)
+    {
+      if (Verbosity() >= VERBOSITY_SOME) std::cout << "In " << Name() << "::ClusterIso WARNING no geometry for tower " << tower->get_key() << '\n';
+      continue;
+    }
+
+    const double phi = geom.get_phi(itower);
+    // the vertex corrected eta has always been kept as a float
+    const double eta = use_vertex ? static_cast<float>(geom.get_eta(itower, m_vx, m_vy, m_vz)) : geom.get_eta(itower);
+    grid.add(tower->get_key(), eta, phi, tower->get_energy() / cosh(eta));
   }
-  else
+  grid.finalize();
+}
+
+/** \Brief Function to set the isolation eT of the clusters from the tower grids of the event
+ */
+void ClusterIso::setIsolation(PHCompositeNode *topNode, const ClusterIsoGrid &gridEM, bool subtracted)
+{
+  RawClusterContainer *clusters = findNode::getClass<RawClusterContainer>(topNode, "CLUSTER_CEMC");
+  RawClusterContainer::ConstRange begin_end = clusters->getClusters();
+  RawClusterContainer::ConstIterator rtiter;
+  if (Verbosity() >= VERBOSITY_SOME) std::cout << Name() << "::ClusterIso sees " << clusters->size() << " clusters " << '\n';
+
+  for (rtiter = begin_end.first; rtiter != begin_end.second; ++rtiter)
   {
-    double radius = sqrt((tower_geom->get_center_x() - vx) * (tower_geom->get_center_x() - vx) + (tower_geom->get_center_y() - vy) * (tower_geom->get_center_y() - vy));
-    double theta = atan2(radius, tower_geom->get_center_z() - vz);
-    r = -log(tan(theta / 2.));
+    RawCluster *cluster = rtiter->second;
+
+    CLHEP::Hep3Vector vertex(m_vx, m_vy, m_vz);
+    CLHEP::Hep3Vector E_vec_cluster = RawClusterUtility::GetEVec(*cluster, vertex);
+    double cluster_energy = E_vec_cluster.mag();
+    double cluster_eta = E_vec_cluster.pseudoRapidity();
+    double cluster_phi = E_vec_cluster.phi();
+    double et = cluster_energy / cosh(cluster_eta);
+    if (Verbosity() >= VERBOSITY_MAX)
+    {
+      std::cout << Name() << "::ClusterIso processing";
+      cluster->identify();
+      std::cout << '\n';
+    }
+    if (et < m_eTCut)
+    {
+      if (Verbosity() >= VERBOSITY_MAX) std::cout << "\t does not pass eT cut" << '\n';
+      continue;
+    }  //skip if cluster is below eT cut
+
+    for (const float coneSize : m_coneSizes)
+    {
+      //EMCal, inner HCal and outer HCal tower contributions to isolation energy
+      double isoEt = gridEM.cone_et(cluster_eta, cluster_phi, coneSize);
+      if (Verbosity() >= VERBOSITY_MAX) std::cout << "\t after EMCal isoEt:" << isoEt << '\n';
+      isoEt += m_gridIH.cone_et(cluster_eta, cluster_phi, coneSize);
+      if (Verbosity() >= VERBOSITY_MAX) std::cout << "\t after innerHCal isoEt:" << isoEt << '\n';
+      isoEt += m_gridOH.cone_et(cluster_eta, cluster_phi, coneSize);
+      if (Verbosity() >= VERBOSITY_MAX) std::cout << "\t after outerHCal isoEt:" << isoEt << '\n';
+
+      isoEt -= et;  //Subtract cluster eT from isoET
+      if (Verbosity() >= VERBOSITY_EVEN_MORE)
+      {
+        std::cout << Name() << "::ClusterIso iso_et for ";
+        cluster->identify();
+        std::cout << "=" << isoEt << '\n';
+      }
+      cluster->set_et_iso(isoEt, (int) 10 * coneSize, subtracted, 1);
+    }
   }
-  return r;
 }
 
 /**
@@ -80,6 +140,31 @@ int ClusterIso::Init(PHCompositeNode *topNode)
   return 0;
 }
 
+/**
+ * Copy the tower geometries into flat tables, the geometry does not change during a run
+ */
+int ClusterIso::InitRun(PHCompositeNode *topNode)
+{
+  RawTowerGeomContainer *geomEM = findNode::getClass<RawTowerGeomContainer>(topNode, "TOWERGEOM_CEMC");
+  RawTowerGeomContainer *geomIH = findNode::getClass<RawTowerGeomContainer>(topNode, "TOWERGEOM_HCALIN");
+  RawTowerGeomContainer *geomOH = findNode::getClass<RawTowerGeomContainer>(topNode, "TOWERGEOM_HCALOUT");
+
+  if (geomEM) m_geomEM.build(geomEM); else m_geomEM.clear();
+  if (geomIH) m_geomIH.build(geomIH); else m_geomIH.clear();
+  if (geomOH) m_geomOH.build(geomOH); else m_geomOH.clear();
+
+  m_gridEM.build(m_geomEM);
+  m_gridEMRetower.build(m_geomIH);
+  m_gridIH.build(m_geomIH);
+  m_gridOH.build(m_geomOH);
+
+  if (Verbosity() >= VERBOSITY_SOME)
+  {
+    std::cout << Name() << "::ClusterIso::InitRun: " << m_geomEM.size() << " EMCal, " << m_geomIH.size() << " inner HCal and " << m_geomOH.size() << " outer HCal tower geometries" << '\n';
+  }
+  return 0;
+}
+
 /**
  * Set the minimum transverse energy required for a cluster to have its isolation calculated
  */
@@ -94,6 +179,15 @@ void ClusterIso::seteTCut(float eTCut)
 void ClusterIso::setConeSize(int coneSize)
 {
   this->m_coneSize = coneSize / 10.0;
+  m_coneSizes.assign(1, m_coneSize);
+}
+
+/**
+ * Add another isolation cone as integer multiple of 0.1, the towers are put on the grids once for all cones
+ */
+void ClusterIso::addConeSize(int coneSize)
+{
+  m_coneSizes.push_back(coneSize / 10.0);
 }
 
 /**
@@ -157,17 +251,7 @@ int ClusterIso::process_event(PHCompositeNode *topNode)
       RawTowerContainer *towersOH3 = findNode::getClass<RawTowerContainer>(topNode, "TOWER_CALIB_HCALOUT_SUB1");
       if (Verbosity() >= VERBOSITY_MORE) std::cout << Name() << "::ClusterIso::process_event: " << towersOH3->size() << " TOWER_CALIB_HCALOUT_SUB1 towers" << std::endl;
 
-      //get geometry of calorimeter towers
-      RawTowerGeomContainer *geomEM = findNode::getClass<RawTowerGeomContainer>(topNode, "TOWERGEOM_HCALIN");
-      RawTowerGeomContainer *geomIH = findNode::getClass<RawTowerGeomContainer>(topNode, "TOWERGEOM_HCALIN");
-      RawTowerGeomContainer *geomOH = findNode::getClass<RawTowerGeomContainer>(topNode, "TOWERGEOM_HCALOUT");
-
       {
-        RawClusterContainer *clusters = findNode::getClass<RawClusterContainer>(topNode, "CLUSTER_CEMC");
-        RawClusterContainer::ConstRange begin_end = clusters->getClusters();
-        RawClusterContainer::ConstIterator rtiter;
-        if (Verbosity() >= VERBOSITY_SOME) std::cout << Name() << "::ClusterIso sees " << clusters->size() << " clusters " << '\n';
-
         //vertexmap is used to get correct collision vertex
         GlobalVertexMap *vertexmap = findNode::getClass<GlobalVertexMap>(topNode, "GlobalVertexMap");
         m_vx = m_vy = m_vz = 0;
@@ -183,80 +267,12 @@ int ClusterIso::process_event(PHCompositeNode *topNode)
           }
         }
 
-        for (rtiter = begin_end.first; rtiter != begin_end.second; ++rtiter)
-        {
-          RawCluster *cluster = rtiter->second;
-
-          CLHEP::Hep3Vector vertex(m_vx, m_vy, m_vz);
-          CLHEP::Hep3Vector E_vec_cluster = RawClusterUtility::GetEVec(*cluster, vertex);
-          double cluster_energy = E_vec_cluster.mag();
-          double cluster_eta = E_vec_cluster.pseudoRapidity();
-          double cluster_phi = E_vec_cluster.phi();
-          double et = cluster_energy / cosh(cluster_eta);
-          double isoEt = 0;
-
-          if (et < m_eTCut)
-          {
-            continue;
-          }  //skip if cluster is under eT cut
-
-          //calculate EMCal tower contribution to isolation energy
-          {
-            RawTowerContainer::ConstRange begin_end = towersEM3old->getTowers();
-            for (RawTowerContainer::ConstIterator rtiter = begin_end.first; rtiter != begin_end.second; ++rtiter)
-            {
-              RawTower *tower = rtiter->second;
-              RawTowerGeom *tower_geom = geomEM->get_tower_geometry(tower->get_key());
-              double this_phi = tower_geom->get_phi();
-              double this_eta = tower_geom->get_eta();
-              if (deltaR(cluster_eta, this_eta, cluster_phi, this_phi) < m_coneSize)
-              {
-                isoEt += tower->get_energy() / cosh(this_eta);  //if tower is in cone, add energy
-              }
-            }
-          }
+        //the retowered EMCal towers have the inner HCal geometry
+        fillGrid(towersEM3old, m_geomIH, false, m_gridEMRetower);
+        fillGrid(towersIH3, m_geomIH, true, m_gridIH);
+        fillGrid(towersOH3, m_geomOH, true, m_gridOH);
 
-          //calculate Inner HCal tower contribution to isolation energy
-          {
-            RawTowerContainer::ConstRange begin_end = towersIH3->getTowers();
-            for (RawTowerContainer::ConstIterator rtiter = begin_end.first; rtiter != begin_end.second; ++rtiter)
-            {
-              RawTower *tower = rtiter->second;
-              RawTowerGeom *tower_geom = geomIH->get_tower_geometry(tower->get_key());
-              double this_phi = tower_geom->get_phi();
-              double this_eta = getTowerEta(tower_geom, m_vx, m_vy, m_vz);
-              if (deltaR(cluster_eta, this_eta, cluster_phi, this_phi) < m_coneSize)
-              {
-                isoEt += tower->get_energy() / cosh(this_eta);  //if tower is in cone, add energy
-              }
-            }
-          }
-
-          //calculate Outer HCal tower contribution to isolation energy
-          {
-            RawTowerContainer::ConstRange begin_end = towersOH3->getTowers();
-            for (RawTowerContainer::ConstIterator rtiter = begin_end.first; rtiter != begin_end.second; ++rtiter)
-            {
-              RawTower *tower = rtiter->second;
-              RawTowerGeom *tower_geom = geomOH->get_tower_geometry(tower->get_key());
-              double this_phi = tower_geom->get_phi();
-              double this_eta = getTowerEta(tower_geom, m_vx, m_vy, m_vz);
-              if (deltaR(cluster_eta, this_eta, cluster_phi, this_phi) < m_coneSize)
-              {
-                isoEt += tower->get_energy() / cosh(this_eta);  //if tower is in cone, add energy
-              }
-            }
-          }
-
-          isoEt -= et;  //Subtract cluster eT from isoET
-          if (Verbosity() >= VERBOSITY_EVEN_MORE)
-          {
-            std::cout << Name() << "::ClusterIso iso_et for ";
-            cluster->identify();
-            std::cout << "=" << isoEt << '\n';
-          }
-          cluster->set_et_iso(isoEt, (int) 10 * m_coneSize, 1, 1);
-        }
+        setIsolation(topNode, m_gridEMRetower, true);
       }
     }
   }
@@ -279,17 +295,7 @@ int ClusterIso::process_event(PHCompositeNode *topNode)
       RawTowerContainer *towersOH3 = findNode::getClass<RawTowerContainer>(topNode, "TOWER_CALIB_HCALOUT");
       if (Verbosity() >= VERBOSITY_MORE) std::cout << "ClusterIso::process_event: " << towersOH3->size() << " TOWER_CALIB_HCALOUT towers" << std::endl;
 
-      //get geometry of calorimeter towers
-      RawTowerGeomContainer *geomEM = findNode::getClass<RawTowerGeomContainer>(topNode, "TOWERGEOM_CEMC");
-      RawTowerGeomContainer *geomIH = findNode::getClass<RawTowerGeomContainer>(topNode, "TOWERGEOM_HCALIN");
-      RawTowerGeomContainer *geomOH = findNode::getClass<RawTowerGeomContainer>(topNode, "TOWERGEOM_HCALOUT");
-
       {
-        RawClusterContainer *clusters = findNode::getClass<RawClusterContainer>(topNode, "CLUSTER_CEMC");
-        RawClusterContainer::ConstRange begin_end = clusters->getClusters();
-        RawClusterContainer::ConstIterator rtiter;
-        if (Verbosity() >= VERBOSITY_SOME) std::cout << " ClusterIso sees " << clusters->size() << " clusters " << '\n';
-
         //vertexmap is used to get correct collision vertex
         GlobalVertexMap *vertexmap = findNode::getClass<GlobalVertexMap>(topNode, "GlobalVertexMap");
         m_vx = m_vy = m_vz = 0;
@@ -302,86 +308,11 @@ int ClusterIso::process_event(PHCompositeNode *topNode)
           if (Verbosity() >= VERBOSITY_SOME) std::cout << Name() << "ClusterIso Event Vertex Calculated at x:" << m_vx << " y:" << m_vy << " z:" << m_vz << '\n';
         }
 
-        for (rtiter = begin_end.first; rtiter != begin_end.second; ++rtiter)
-        {
-          RawCluster *cluster = rtiter->second;
-
-          CLHEP::Hep3Vector vertex(m_vx, m_vy, m_vz);
-          CLHEP::Hep3Vector E_vec_cluster = RawClusterUtility::GetEVec(*cluster, vertex);
-          double cluster_energy = E_vec_cluster.mag();
-          double cluster_eta = E_vec_cluster.pseudoRapidity();
-          double cluster_phi = E_vec_cluster.phi();
-          double et = cluster_energy / cosh(cluster_eta);
-          double isoEt = 0;
-          if (Verbosity() >= VERBOSITY_MAX)
-          {
-            std::cout << Name() << "::ClusterIso processing";
-            cluster->identify();
-            std::cout << '\n';
-          }
-          if (et < m_eTCut)
-          {
-            if (Verbosity() >= VERBOSITY_MAX) std::cout << "\t does not pass eT cut" << '\n';
-            continue;
-          }  //skip if cluster is below eT cut
+        fillGrid(towersEM3old, m_geomEM, true, m_gridEM);
+        fillGrid(towersIH3, m_geomIH, true, m_gridIH);
+        fillGrid(towersOH3, m_geomOH, true, m_gridOH);
 
-          //calculate EMCal tower contribution to isolation energy
-          {
-            RawTowerContainer::ConstRange begin_end = towersEM3old->getTowers();
-            for (RawTowerContainer::ConstIterator rtiter = begin_end.first; rtiter != begin_end.second; ++rtiter)
-            {
-              RawTower *tower = rtiter->second;
-              RawTowerGeom *tower_geom = geomEM->get_tower_geometry(tower->get_key());
-              double this_phi = tower_geom->get_phi();
-              double this_eta = getTowerEta(tower_geom, m_vx, m_vy, m_vz);
-              if (deltaR(cluster_eta, this_eta, cluster_phi, this_phi) < m_coneSize)
-              {
-                isoEt += tower->get_energy() / cosh(this_eta);  //if tower is in cone, add energy
-              }
-            }
-          }
-          if (Verbosity() >= VERBOSITY_MAX) std::cout << "\t after EMCal isoEt:" << isoEt << '\n';
-          //calculate Inner HCal tower contribution to isolation energy
-          {
-            RawTowerContainer::ConstRange begin_end = towersIH3->getTowers();
-            for (RawTowerContainer::ConstIterator rtiter = begin_end.first; rtiter != begin_end.second; ++rtiter)
-            {
-              RawTower *tower = rtiter->second;
-              RawTowerGeom *tower_geom = geomIH->get_tower_geometry(tower->get_key());
-              double this_phi = tower_geom->get_phi();
-              double this_eta = getTowerEta(tower_geom, m_vx, m_vy, m_vz);
-              if (deltaR(cluster_eta, this_eta, cluster_phi, this_phi) < m_coneSize)
-              {
-                isoEt += tower->get_energy() / cosh(this_eta);  //if tower is in cone, add energy
-              }
-            }
-          }
-          if (Verbosity() >= VERBOSITY_MAX) std::cout << "\t after innerHCal isoEt:" << isoEt << '\n';
-          //calculate Outer HCal tower contribution to isolation energy
-          {
-            RawTowerContainer::ConstRange begin_end = towersOH3->getTowers();
-            for (RawTowerContainer::ConstIterator rtiter = begin_end.first; rtiter != begin_end.second; ++rtiter)
-            {
-              RawTower *tower = rtiter->second;
-              RawTowerGeom *tower_geom = geomOH->get_tower_geometry(tower->get_key());
-              double this_phi = tower_geom->get_phi();
-              double this_eta = getTowerEta(tower_geom, m_vx, m_vy, m_vz);
-              if (deltaR(cluster_eta, this_eta, cluster_phi, this_phi) < m_coneSize)
-              {
-                isoEt += tower->get_energy() / cosh(this_eta);  //if tower is in cone, add energy
-              }
-            }
-          }
-          if (Verbosity() >= VERBOSITY_MAX) std::cout << "\t after outerHCal isoEt:" << isoEt << '\n';
-          isoEt -= et;  //Subtract cluster eT from isoET
-          if (Verbosity() >= VERBOSITY_EVEN_MORE)
-          {
-            std::cout << Name() << "::ClusterIso iso_et for ";
-            cluster->identify();
-            std::cout << "=" << isoEt << '\n';
-          }
-          cluster->set_et_iso(isoEt, (int) 10 * m_coneSize, 0, 1);
-        }
+        setIsolation(topNode, m_gridEM, false);
       }
     }
   }
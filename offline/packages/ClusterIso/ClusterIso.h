@@ -2,15 +2,20 @@
 #ifndef CLUSTERISO_CLUSTERISO_H
 #define CLUSTERISO_CLUSTERISO_H
 
+#include "ClusterIsoGrid.h"
+
+#include <calobase/RawTowerGeomTable.h>
+
 #include <fun4all/SubsysReco.h>
 
 #include <CLHEP/Vector/ThreeVector.h>
 
 #include <cmath>
 #include <string>
+#include <vector>
 
 class PHCompositeNode;
-class RawTowerGeom;
+class RawTowerContainer;
 
 /** \Brief Tool to find isolation energy of each EMCal cluster.
  * 
@@ -29,20 +34,39 @@ class ClusterIso : public SubsysReco
   ClusterIso(const std::string&, float eTCut, int coneSize, bool do_subtracted, bool do_unsubtracted);
 
   virtual int Init(PHCompositeNode*);
+  virtual int InitRun(PHCompositeNode*);
   virtual int process_event(PHCompositeNode*);
   virtual int End(PHCompositeNode*);
 
   void seteTCut(float x);
+  //! replaces the cone sizes by this one
   void setConeSize(int x);
+  //! additional cone size, in the same units, all cones are computed in one pass over the clusters
+  void addConeSize(int x);
   const float geteTCut();
   //! returns coneSize*10 as an int
   const int getConeSize();
   const CLHEP::Hep3Vector getVertex();
 
  private:
-  double getTowerEta(RawTowerGeom* tower_geom, double vx, double vy, double vz);
+  /** fills the grid with the towers of this event. With use_vertex the tower eta
+   * is computed from the vertex instead of (0,0,0)
+   */
+  void fillGrid(RawTowerContainer* towers, const RawTowerGeomTable& geom, bool use_vertex, ClusterIsoGrid& grid);
+
+  //! sets the isolation eT of all clusters above the eT cut for all cone sizes
+  void setIsolation(PHCompositeNode* topNode, const ClusterIsoGrid& gridEM, bool subtracted);
+
+  RawTowerGeomTable m_geomEM;  ///< EMCal tower geometry, built in InitRun
+  RawTowerGeomTable m_geomIH;  ///< inner HCal tower geometry, also used for the retowered EMCal
+  RawTowerGeomTable m_geomOH;  ///< outer HCal tower geometry
+  ClusterIsoGrid m_gridEM;         ///< EMCal towers of the event
+  ClusterIsoGrid m_gridEMRetower;  ///< retowered EMCal towers, with the inner HCal geometry
+  ClusterIsoGrid m_gridIH;
+  ClusterIsoGrid m_gridOH;
+  std::vector<float> m_coneSizes;  ///< all cone sizes
   float m_eTCut;     ///< The minimum required transverse energy in a cluster for ClusterIso to be run
-  float m_coneSize;  ///< Size of the cone used to isolate a given cluster
+  float m_coneSize;  ///< Size of the first cone used to isolate a given cluster
   float m_vx;        ///< Correct vertex x coordinate
   float m_vy;        ///< Correct vertex y coordinate
   float m_vz;        ///< Correct vertex z coordinate
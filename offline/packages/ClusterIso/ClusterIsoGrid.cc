@@ -0,0 +1,324 @@
+#include "ClusterIsoGrid.h"
+
+#include "ClusterIso.h"
+
+#include <calobase/RawTowerGeomTable.h>
+
+#include <algorithm>
+#include <cmath>
+
+namespace
+{
+  //! phi difference in -pi ... pi
+  double wrap_phi(double dphi)
+  {
+    while (dphi > M_PI) dphi -= 2 * M_PI;
+    while (dphi < -M_PI) dphi += 2 * M_PI;
+    return dphi;
+  }
+}  // namespace
+
+ClusterIsoGrid::ClusterIsoGrid()
+  : m_index1_min(0)
+  , m_index2_min(0)
+  , m_n1(0)
+  , m_n2(0)
+  , m_ordered(false)
+{
+}
+
+void ClusterIsoGrid::build(const RawTowerGeomTable &geom)
+{
+  m_n1 = m_n2 = 0;
+  m_ordered = false;
+  m_cells.clear();
+  if (geom.empty())
+  {
+    m_et.clear();
+    m_eta.clear();
+    m_phi.clear();
+    m_present.clear();
+    return;
+  }
+
+  int index1_max = -1;
+  int index2_max = -1;
+  m_index1_min = m_index2_min = 0xFFF;
+  for (unsigned int i = 0; i < geom.size(); ++i)
+  {
+    const int index1 = RawTowerDefs::decode_index1(geom.get_key(i));
+    const int index2 = RawTowerDefs::decode_index2(geom.get_key(i));
+    m_index1_min = std::min(m_index1_min, index1);
+    m_index2_min = std::min(m_index2_min, index2);
+    index1_max = std::max(index1_max, index1);
+    index2_max = std::max(index2_max, index2);
+  }
+  m_n1 = index1_max - m_index1_min + 1;
+  m_n2 = index2_max - m_index2_min + 1;
+
+  // phi range of the tower centers of each column, relative to its first tower
+  std::vector<bool> col_set(m_n2, false);
+  m_col_phi.assign(m_n2, 0);
+  m_col_lo.assign(m_n2, 0);
+  m_col_hi.assign(m_n2, 0);
+  for (unsigned int i = 0; i < geom.size(); ++i)
+  {
+    const int col = RawTowerDefs::decode_index2(geom.get_key(i)) - m_index2_min;
+    if (!col_set[col])
+    {
+      col_set[col] = true;
+      m_col_phi[col] = geom.get_phi(i);
+      continue;
+    }
+    const double dphi = wrap_phi(geom.get_phi(i) - m_col_phi[col]);
+    m_col_lo[col] = std::min(m_col_lo[col], dphi);
+    m_col_hi[col] = std::max(m_col_hi[col], dphi);
+  }
+
+  // the columns have to go around in phi in one direction, without gaps
+  m_ordered = (m_n2 >= 3);
+  double turn = 0;
+  for (int col = 0; col < m_n2 && m_ordered; ++col)
+  {
+    const int next = (col + 1) % m_n2;
+    if (!col_set[col] || m_col_hi[col] - m_col_lo[col] > M_PI / 2)
+    {
+      m_ordered = false;
+      break;
+    }
+    const double step = wrap_phi(m_col_phi[next] - m_col_phi[col]);
+    if (step <= 0)
+    {
+      m_ordered = false;
+    }
+    turn += step;
+  }
+  if (m_ordered && std::abs(turn - 2 * M_PI) > 1e-3)
+  {
+    m_ordered = false;
+  }
+  if (!m_ordered)
+  {
+    // same test with the columns in decreasing phi
+    bool ordered = (m_n2 >= 3);
+    turn = 0;
+    for (int col = 0; col < m_n2 && ordered; ++col)
+    {
+      const int next = (col + 1) % m_n2;
+      if (!col_set[col] || m_col_hi[col] - m_col_lo[col] > M_PI / 2)
+      {
+        ordered = false;
+        break;
+      }
+      const double step = wrap_phi(m_col_phi[next] - m_col_phi[col]);
+      if (step >= 0)
+      {
+        ordered = false;
+      }
+      turn += step;
+    }
+    m_ordered = ordered && std::abs(turn + 2 * M_PI) < 1e-3;
+  }
+
+  m_et.assign(m_n1 * m_n2, 0);
+  m_eta.assign(m_n1 * m_n2, 0);
+  m_phi.assign(m_n1 * m_n2, 0);
+  m_present.assign(m_n1 * m_n2, false);
+  m_sum.assign(m_n1 * (m_n2 + 1), 0);
+  m_row_eta_lo.assign(m_n1, 1);
+  m_row_eta_hi.assign(m_n1, -1);
+}
+
+void ClusterIsoGrid::clear_towers()
+{
+  for (const int cell : m_cells)
+  {
+    m_et[cell] = 0;
+    m_present[cell] = false;
+  }
+  m_cells.clear();
+}
+
+void ClusterIsoGrid::add(const RawTowerDefs::keytype key, const double eta, const double phi, const double et)
+{
+  const int row = static_cast<int>(RawTowerDefs::decode_index1(key)) - m_index1_min;
+  const int col = static_cast<int>(RawTowerDefs::decode_index2(key)) - m_index2_min;
+  if (row < 0 || row >= m_n1 || col < 0 || col >= m_n2)
+  {
+    return;
+  }
+  const int cell = row * m_n2 + col;
+  if (!m_present[cell])
+  {
+    m_present[cell] = true;
+    m_cells.push_back(cell);
+  }
+  m_et[cell] = et;
+  m_eta[cell] = eta;
+  m_phi[cell] = phi;
+}
+
+void ClusterIsoGrid::finalize()
+{
+  if (!m_ordered)
+  {
+    return;
+  }
+  m_row_eta_lo.assign(m_n1, 1);
+  m_row_eta_hi.assign(m_n1, -1);
+  for (const int cell : m_cells)
+  {
+    const int row = cell / m_n2;
+    if (m_row_eta_lo[row] > m_row_eta_hi[row])
+    {
+      m_row_eta_lo[row] = m_row_eta_hi[row] = m_eta[cell];
+    }
+    else
+    {
+      m_row_eta_lo[row] = std::min(m_row_eta_lo[row], m_eta[cell]);
+      m_row_eta_hi[row] = std::max(m_row_eta_hi[row], m_eta[cell]);
+    }
+  }
+  for (int row = 0; row < m_n1; ++row)
+  {
+    double *sum = &m_sum[row * (m_n2 + 1)];
+    const double *et = &m_et[row * m_n2];
+    sum[0] = 0;
+    for (int col = 0; col < m_n2; ++col)
+    {
+      sum[col + 1] = sum[col] + et[col];
+    }
+  }
+}
+
+double ClusterIsoGrid::cone_et_all(const double eta, const double phi, const double R) const
+{
+  double et = 0;
+  for (const int cell : m_cells)
+  {
+    if (deltaR(eta, m_eta[cell], phi, m_phi[cell]) < R)
+    {
+      et += m_et[cell];
+    }
+  }
+  return et;
+}
+
+double ClusterIsoGrid::edge_et(const int irow, const int col, const double eta, const double phi, const double R) const
+{
+  const int cell = irow * m_n2 + col;
+  if (m_present[cell] && deltaR(eta, m_eta[cell], phi, m_phi[cell]) < R)
+  {
+    return m_et[cell];
+  }
+  return 0;
+}
+
+double ClusterIsoGrid::cone_et(const double eta, const double phi, const double R) const
+{
+  if (m_cells.empty())
+  {
+    return 0;
+  }
+  if (!m_ordered || R >= M_PI / 2)
+  {
+    return cone_et_all(eta, phi, R);
+  }
+
+  // center column, closest to phi
+  int center = 0;
+  double best = 2 * M_PI;
+  for (int col = 0; col < m_n2; ++col)
+  {
+    const double d = std::abs(wrap_phi(phi - m_col_phi[col]));
+    if (d < best)
+    {
+      best = d;
+      center = col;
+    }
+  }
+
+  // columns c - k (left, k = 0 ... n2 / 2) and c + k (right, k = 0 ... n2 - 1 - n2 / 2):
+  // m_in_* is the largest phi distance of the columns up to k, so it grows with k,
+  // m_out_* the smallest phi distance of the columns from k outwards
+  const int nleft = m_n2 / 2 + 1;
+  const int nright = m_n2 - m_n2 / 2;
+  m_in_left.resize(nleft);
+  m_out_left.resize(nleft);
+  m_in_right.resize(nright);
+  m_out_right.resize(nright);
+  for (int side = 0; side < 2; ++side)
+  {
+    std::vector<double> &in = side ? m_in_right : m_in_left;
+    std::vector<double> &out = side ? m_out_right : m_out_left;
+    const int n = in.size();
+    for (int k = 0; k < n; ++k)
+    {
+      const int col = side ? (center + k) % m_n2 : (center - k + m_n2) % m_n2;
+      const double dphi = wrap_phi(phi - m_col_phi[col]);
+      const double d1 = std::abs(dphi - m_col_lo[col]);
+      const double d2 = std::abs(dphi - m_col_hi[col]);
+      const double dmax = std::max(d1, d2);
+      const double dmin = (dphi >= m_col_lo[col] && dphi <= m_col_hi[col]) ? 0 : std::min(d1, d2);
+      in[k] = (k > 0) ? std::max(in[k - 1], dmax) : dmax;
+      out[k] = dmin;
+    }
+    for (int k = n - 2; k >= 0; --k)
+    {
+      out[k] = std::min(out[k], out[k + 1]);
+    }
+  }
+
+  double et = 0;
+  for (int row = 0; row < m_n1; ++row)
+  {
+    const double eta_lo = m_row_eta_lo[row];
+    const double eta_hi = m_row_eta_hi[row];
+    if (eta_lo > eta_hi || eta_lo >= eta + R || eta_hi <= eta - R)
+    {
+      continue;
+    }
+    const double deta_far = std::max(std::abs(eta - eta_lo), std::abs(eta - eta_hi));
+    const double deta_near = (eta >= eta_lo && eta <= eta_hi) ? 0 : std::min(std::abs(eta - eta_lo), std::abs(eta - eta_hi));
+    // columns with all phi distances below rin are inside the cone for all towers of the row,
+    // columns with all phi distances above rout are outside
+    const double rin = (deta_far < R) ? std::sqrt(R * R - deta_far * deta_far) : -1;
+    const double rout = std::sqrt(R * R - deta_near * deta_near);
+
+    const int kin_left = std::lower_bound(m_in_left.begin(), m_in_left.end(), rin) - m_in_left.begin();
+    const int kin_right = std::lower_bound(m_in_right.begin(), m_in_right.end(), rin) - m_in_right.begin();
+    const int kout_left = std::lower_bound(m_out_left.begin(), m_out_left.end(), rout) - m_out_left.begin();
+    const int kout_right = std::lower_bound(m_out_right.begin(), m_out_right.end(), rout) - m_out_right.begin();
+
+    if (kin_left > 0 && kin_right > 0)
+    {
+      // columns c - kin_left + 1 ... c + kin_right - 1 from the prefix sums
+      const double *sum = &m_sum[row * (m_n2 + 1)];
+      const int first = center - kin_left + 1;
+      const int last = center + kin_right - 1;
+      if (first < 0)
+      {
+        et += sum[m_n2] - sum[first + m_n2] + sum[last + 1];
+      }
+      else if (last >= m_n2)
+      {
+        et += sum[m_n2] - sum[first] + sum[last - m_n2 + 1];
+      }
+      else
+      {
+        et += sum[last + 1] - sum[first];
+      }
+    }
+    const int edge_left = (kin_left > 0 && kin_right > 0) ? kin_left : 0;
+    const int edge_right = (kin_left > 0 && kin_right > 0) ? kin_right : 1;
+    for (int k = edge_left; k < kout_left; ++k)
+    {
+      et += edge_et(row, (center - k + m_n2) % m_n2, eta, phi, R);
+    }
+    for (int k = std::max(edge_right, 1); k < kout_right; ++k)
+    {
+      et += edge_et(row, (center + k) % m_n2, eta, phi, R);
+    }
+  }
+  return et;
+}
@@ -0,0 +1,83 @@
+// This file is really -*- C++ -*-.
+#ifndef CLUSTERISO_CLUSTERISOGRID_H
+#define CLUSTERISO_CLUSTERISOGRID_H
+
+#include <calobase/RawTowerDefs.h>
+
+#include <vector>
+
+class RawTowerGeomTable;
+
+/** \Brief Towers of one calorimeter on its (index1, index2) = (eta, phi) grid for cone sums
+ *
+ * The column layout (phi of the tower centers per phi index) comes from the
+ * geometry and is built once per run. Each event the towers are added with
+ * their (vertex corrected) eta, phi and eT, and finalize() builds the prefix
+ * sums of eT along phi for every eta row.
+ *
+ * cone_et() sums the towers within deltaR < R: in every eta row the phi
+ * columns which are entirely inside the cone are summed from the prefix sums,
+ * only the towers of the columns on the edge of the cone are tested one by
+ * one. Geometries whose columns are not ordered in phi fall back to testing
+ * all towers.
+ */
+class ClusterIsoGrid
+{
+ public:
+  ClusterIsoGrid();
+  virtual ~ClusterIsoGrid() {}
+
+  //! column layout of the geometry, empty geometries give an empty grid
+  void build(const RawTowerGeomTable &geom);
+
+  //! removes the towers of the previous event
+  void clear_towers();
+  void add(const RawTowerDefs::keytype key, const double eta, const double phi, const double et);
+  //! prefix sums and eta range of the rows, after all towers of the event are added
+  void finalize();
+
+  //! sum of the eT of the towers with deltaR < R around (eta, phi)
+  double cone_et(const double eta, const double phi, const double R) const;
+
+ private:
+  //! exact sum over all towers
+  double cone_et_all(const double eta, const double phi, const double R) const;
+
+  //! adds the towers of column col in row irow which are inside the cone
+  double edge_et(const int irow, const int col, const double eta, const double phi, const double R) const;
+
+  int m_index1_min;
+  int m_index2_min;
+  int m_n1;
+  int m_n2;
+
+  //! false if the phi columns are not ordered, cone_et tests all towers
+  bool m_ordered;
+
+  //! phi of column j is in [m_col_phi[j] + m_col_lo[j], m_col_phi[j] + m_col_hi[j]]
+  std::vector<double> m_col_phi;
+  std::vector<double> m_col_lo;
+  std::vector<double> m_col_hi;
+
+  //! towers of the event, cell irow * m_n2 + icol
+  std::vector<double> m_et;
+  std::vector<double> m_eta;
+  std::vector<double> m_phi;
+  std::vector<bool> m_present;
+  //! filled cells, for clear_towers and cone_et_all
+  std::vector<int> m_cells;
+
+  //! m_sum[irow * (m_n2 + 1) + j] is the eT of columns 0 ... j - 1 of row irow
+  std::vector<double> m_sum;
+  //! eta range of the towers in the row, empty rows have m_row_eta_lo > m_row_eta_hi
+  std::vector<double> m_row_eta_lo;
+  std::vector<double> m_row_eta_hi;
+
+  //! per cone_et call, distance in phi of the columns left (c - k) and right (c + k) of the center column c
+  mutable std::vector<double> m_in_left;
+  mutable std::vector<double> m_in_right;
+  mutable std::vector<double> m_out_left;
+  mutable std::vector<double> m_out_right;
+};
+
+#endif
@@ -0,0 +1,262 @@
+#ifndef FITNEWTON_NEWTONMINIMIZERFIXED_H
+#define FITNEWTON_NEWTONMINIMIZERFIXED_H
+
+#include <Eigen/Core>
+#include <Eigen/LU>
+
+#include <cmath>
+#include <utility>
+
+namespace FitNewton
+{
+  // same Newton iteration with strong Wolfe line search as NewtonMinimizerGradHessian::minimize,
+  // for a number of parameters N known at compile time.
+  // Function is used directly, not through FunctionGradHessian, and has to provide
+  //   bool calcValGradHessian(const Eigen::Matrix<double,N,1>& x, double& val, Eigen::Matrix<double,N,1>& grad, Eigen::Matrix<double,N,N>& hessian);
+  // so the evaluation can be inlined and vectors and matrices live on the stack.
+  // rescaleMove and computeCovariance are not called.
+  template <int N, class Function>
+  class NewtonMinimizerFixed
+  {
+    public:
+      typedef Eigen::Matrix<double, N, 1> Vector;
+      typedef Eigen::Matrix<double, N, N> Matrix;
+
+      NewtonMinimizerFixed() : function(0)
+      {
+        for(int i=0;i<N;++i){fixparameter[i] = false;}
+      }
+
+      void setFunction(Function* func)
+      {
+        function = func;
+        for(int i=0;i<N;++i){fixparameter[i] = false;}
+      }
+
+      void fixParameter(unsigned int par){if(par < N){fixparameter[par] = true;}}
+      void unfixParameter(unsigned int par){if(par < N){fixparameter[par] = false;}}
+
+      bool minimize(const Vector& start_point, Vector& min_point, double tol=0x1.0p-30, unsigned int max_iter=1024, double abs_tol=0.)
+      {
+        //parameters used for the Wolfe conditions
+        const double c1 = 1.0e-4;
+        const double c2 = 0.9;
+        const unsigned int search_iter = 32;
+
+        Vector working_points[2] = {start_point, Vector::Zero()};
+        Vector* current_point = &(working_points[0]);
+        Vector* try_point = &(working_points[1]);
+
+        Vector grad[2] = {Vector::Zero(), Vector::Zero()};
+        Vector* current_grad = &(grad[0]);
+        Vector* try_grad = &(grad[1]);
+
+        Matrix hessian = Matrix::Zero();
+        Vector move = Vector::Zero();
+
+        double value=0.;
+        double prev_value=0.;
+        double scale = 1.;
+        double scale_temp = 1.;
+        double grad0_dir = 0.;
+
+        //try a Newton iteration
+        evaluate((*current_point), value, (*current_grad), hessian);
+        newtonMove((*current_grad), hessian, move);
+        grad0_dir = (*current_grad).dot(move);
+        scale_temp = 1.;
+        //find scale, such that move*scale satisfies the strong Wolfe conditions
+        if(lineSearch(scale_temp, c1, c2, (*try_grad), move, grad0_dir, value, (*current_point), (*try_point), search_iter, scale) == false)
+        {
+          min_point = start_point;
+          return false;
+        }
+        move *= scale;
+        (*try_point) = ((*current_point) + move);
+        evaluate((*try_point), prev_value, (*try_grad), hessian);
+        std::swap(current_point, try_point);
+        std::swap(current_grad, try_grad);
+        std::swap(value, prev_value);
+
+        unsigned long int count = 1;
+        bool converged=false;
+        while(converged==false)
+        {
+          if((std::fabs((prev_value - value)/prev_value)<tol || std::fabs(prev_value - value)<abs_tol)){converged=true;break;}
+          prev_value = value;
+          newtonMove((*current_grad), hessian, move);
+          grad0_dir = (*current_grad).dot(move);
+          scale_temp = 1.;
+          if(lineSearch(scale_temp, c1, c2, (*try_grad), move, grad0_dir, value, (*current_point), (*try_point), search_iter, scale) == false)
+          {
+            min_point = (*current_point);
+            return false;
+          }
+          move *= scale;
+          (*try_point) = ((*current_point) + move);
+          evaluate((*try_point), value, (*try_grad), hessian);
+          std::swap(current_point, try_point);
+          std::swap(current_grad, try_grad);
+
+          count++;
+          if(count > max_iter){break;}
+        }
+
+        min_point = (*current_point);
+        return converged;
+      }
+
+    private:
+      // value, gradient and hessian with the fixed parameters taken out
+      bool evaluate(const Vector& x, double& val, Vector& grad, Matrix& hessian)
+      {
+        bool bounds = function->calcValGradHessian(x, val, grad, hessian);
+        for(int i=0;i<N;++i)
+        {
+          if(fixparameter[i])
+          {
+            grad(i) = 0.;
+            hessian.row(i).setZero();
+            hessian.col(i).setZero();
+            hessian(i,i) = 1.;
+          }
+        }
+        return bounds;
+      }
+
+      // value and gradient only, as FunctionGradHessian::calcValGrad
+      bool evaluate(const Vector& x, double& val, Vector& grad)
+      {
+        Matrix hessian = Matrix::Zero();
+        bool bounds = function->calcValGradHessian(x, val, grad, hessian);
+        for(int i=0;i<N;++i){if(fixparameter[i]){grad(i) = 0.;}}
+        return bounds;
+      }
+
+      // Newton step, or steepest descent if it is not defined, pointing downhill
+      static void newtonMove(const Vector& grad, const Matrix& hessian, Vector& move)
+      {
+        move = -hessian.fullPivLu().solve(grad);
+        bool good_value=true;
+        for(int i=0;i<N;++i){if(!(move(i) == move(i))){good_value=false;break;}}
+        if(good_value == false){move = -grad;}
+        //if the inverse hessian times the negative gradient isn't even a descent direction, negate the direction
+        if(grad.dot(move)>0.){move = -move;}
+      }
+
+      bool zoom(const double& wolfe1, const double& wolfe2, double& lo, double& hi, Vector& try_grad, const Vector& direction, const double& grad0_dir, const double& val0, double& val_lo, const Vector& init_params, Vector& try_params, unsigned int max_iter, double& result)
+      {
+        double tryval = val0;
+        double alpha = tryval;
+        double temp1 = tryval;
+        double temp2 = tryval;
+        double temp3 = tryval;
+        bool bounds = true;
+
+        unsigned int counter = 1;
+        while(true)
+        {
+          alpha = 0.5*(lo + hi);
+          try_params = init_params + alpha*direction;
+          bounds = evaluate(try_params, tryval, try_grad);
+          temp1 = val0 + wolfe1*alpha*grad0_dir;
+
+          if( ( tryval > temp1 ) || ( tryval >= val_lo ) || (bounds == false) )
+          {
+            if( (std::fabs((tryval - val_lo)/(tryval)) < 1.0e-4) ){result = alpha;return true;}
+            hi = alpha;
+          }
+          else
+          {
+            temp1 = try_grad.dot(direction);
+            temp2 = -wolfe2*grad0_dir;
+            temp3 = std::fabs(temp1);
+
+            if( temp3 <= std::fabs(temp2) )
+            {
+              result = alpha;
+              return bounds;
+            }
+            temp1 *= (hi - lo);
+            if( temp1 >= 0.)
+            {
+              hi = lo;
+            }
+            lo = alpha;
+            val_lo = tryval;
+          }
+          counter++;
+          if(counter > max_iter){return false;}
+        }
+      }
+
+      bool lineSearch(double& alpha, const double& wolfe1, const double& wolfe2, Vector& try_grad, const Vector& direction, const double& grad0_dir, const double& val0, const Vector& init_params, Vector& try_params, unsigned int max_iter, double& result)
+      {
+        double tryval = val0;
+        double prev_val = tryval;
+        double prev_alpha = 0.;
+        double lo = tryval;
+        double hi = tryval;
+        double temp1 = tryval;
+        double temp2 = tryval;
+        double temp3 = tryval;
+        unsigned int i = 1;
+
+        while(true)
+        {
+          try_params = init_params + alpha*direction;
+          bool bounds = evaluate(try_params, tryval, try_grad);
+          if(bounds == false)
+          {
+            // halve the step until it is allowed again and goes downhill
+            while(true)
+            {
+              alpha *= 0.5;
+              try_params = init_params + alpha*direction;
+              bounds = evaluate(try_params, tryval, try_grad);
+              if(bounds==true && tryval < val0)
+              {
+                result=alpha;
+                return true;
+              }
+              if(i>max_iter){return false;}
+              i++;
+            }
+          }
+
+          temp1 = val0 + wolfe1*alpha*grad0_dir;
+          if( ( tryval > temp1 ) || ( ( tryval > prev_val ) && (i>1) ))
+          {
+            lo = prev_alpha;
+            hi = alpha;
+            return zoom(wolfe1, wolfe2, lo, hi, try_grad, direction, grad0_dir, val0, prev_val, init_params, try_params, max_iter, result);
+          }
+          temp1 = try_grad.dot(direction);
+          temp2 = -wolfe2*grad0_dir;
+          temp3 = std::fabs(temp1);
+
+          if( temp3 <= std::fabs(temp2) )
+          {
+            result = alpha;
+            return bounds;
+          }
+          if( temp1 >= 0. )
+          {
+            lo = alpha;
+            hi = prev_alpha;
+            return zoom(wolfe1, wolfe2, lo, hi, try_grad, direction, grad0_dir, val0, tryval, init_params, try_params, max_iter, result);
+          }
+          prev_val = tryval;
+          prev_alpha = alpha;
+          alpha *= 2.;
+          i++;
+          if(i > max_iter){return false;}
+        }
+      }
+
+      Function* function;
+      bool fixparameter[N];
+  };
+}
+
+#endif
@@ -7,6 +7,7 @@
 #include <cmath>
 #include <cstddef>
 #include <emmintrin.h>
+#include <immintrin.h>
 #include <memory>
 #include <sys/time.h>
 #include <vector>
@@ -236,6 +237,84 @@ void fillBins4_sse(float* min_phi_a, float* max_phi_a, float n_phi_val,
   _mm_store_si128((__m128i*)phihi2, highphi_sel_2);
 }
 
+// same as fillBins4_sse for 8 hits at once, only called if the cpu has avx2
+__attribute__((target("avx2"))) void fillBins8_avx2(
+    float* min_phi_a, float* max_phi_a, float n_phi_val,
+    float inv_phi_range_val, float low_phi_a, float high_phi_a,
+    unsigned int* philow1, unsigned int* philow2, unsigned int* phihi1,
+    unsigned int* phihi2) {
+  const __m256i zero_int = _mm256_setzero_si256();
+  const __m256i neg1_int = _mm256_set1_epi32(-1);
+  const __m256i one_int = _mm256_set1_epi32(1);
+  const __m256 zero_8 = _mm256_setzero_ps();
+  const __m256 twopi_8 = _mm256_set1_ps(0x6.487ed5110b4611a8p0f);
+
+  __m256 min_phi = _mm256_load_ps(min_phi_a);
+  __m256 max_phi = _mm256_load_ps(max_phi_a);
+  __m256 n_phi = _mm256_set1_ps(n_phi_val);
+  __m256i n_phi_min1 = _mm256_cvtps_epi32(n_phi);
+  n_phi_min1 = _mm256_sub_epi32(n_phi_min1, one_int);
+  __m256 inv_phi_range = _mm256_set1_ps(inv_phi_range_val);
+  __m256 low_phi = _mm256_set1_ps(low_phi_a);
+  __m256 high_phi = _mm256_set1_ps(high_phi_a);
+  __m256 min_phi_2pi = _mm256_add_ps(min_phi, twopi_8);
+
+  __m256i low_phi_bin_1 = _mm256_cvttps_epi32(
+      _mm256_mul_ps(_mm256_mul_ps(_mm256_sub_ps(min_phi, low_phi), inv_phi_range), n_phi));
+  __m256i high_phi_bin_1 = _mm256_cvttps_epi32(
+      _mm256_mul_ps(_mm256_mul_ps(_mm256_sub_ps(max_phi, low_phi), inv_phi_range), n_phi));
+  __m256i low_phi_bin_2 = _mm256_cvttps_epi32(
+      _mm256_mul_ps(_mm256_mul_ps(_mm256_sub_ps(min_phi_2pi, low_phi), inv_phi_range), n_phi));
+
+  __m256i cmp1 = _mm256_castps_si256(_mm256_cmp_ps(min_phi, low_phi, _CMP_LT_OQ));
+  __m256i cmp2 = _mm256_castps_si256(_mm256_cmp_ps(high_phi, max_phi, _CMP_LT_OQ));
+  __m256i cmp3 = _mm256_castps_si256(_mm256_cmp_ps(min_phi_2pi, low_phi, _CMP_LT_OQ));
+  __m256i cmp4 = _mm256_castps_si256(_mm256_cmp_ps(zero_8, min_phi, _CMP_LT_OQ));
+  __m256i max_lt_low = _mm256_castps_si256(_mm256_cmp_ps(max_phi, low_phi, _CMP_LT_OQ));
+  __m256i low_lt_max = _mm256_castps_si256(_mm256_cmp_ps(low_phi, max_phi, _CMP_LT_OQ));
+  __m256i high_lt_min2pi = _mm256_castps_si256(_mm256_cmp_ps(high_phi, min_phi_2pi, _CMP_LT_OQ));
+  __m256i min2pi_lt_high = _mm256_castps_si256(_mm256_cmp_ps(min_phi_2pi, high_phi, _CMP_LT_OQ));
+  //   ( high_phi < ( min_phi_a[i] + 2.*M_PI) ) && ( low_phi > max_phi_a[i] )
+  __m256i cmp5 = _mm256_and_si256(high_lt_min2pi, max_lt_low);
+  // ( high_phi >= ( min_phi_a[i] + 2.*M_PI) ) && ( low_phi <= max_phi_a[i] )
+  __m256i cmp5_3 = _mm256_and_si256(min2pi_lt_high, low_lt_max);
+  __m256i cmp5_1 = _mm256_or_si256(_mm256_and_si256(min2pi_lt_high, max_lt_low), cmp5_3);
+  __m256i cmp5_2 = _mm256_or_si256(_mm256_and_si256(high_lt_min2pi, low_lt_max), cmp5_3);
+  // ( max_phi_a[i] < low_phi ) || ( min_phi_a[i] > high_phi )
+  __m256i cmp6 = _mm256_or_si256(
+      max_lt_low, _mm256_castps_si256(_mm256_cmp_ps(high_phi, min_phi, _CMP_LT_OQ)));
+
+  // _mm256_blendv_epi8(b, a, mask) is mask ? a : b
+
+  // low bin :
+  __m256i lowphi_sel_1 = _mm256_blendv_epi8(low_phi_bin_2, zero_int, cmp3);
+  lowphi_sel_1 = _mm256_blendv_epi8(neg1_int, lowphi_sel_1, cmp5_1);
+  __m256i tmp4 = _mm256_blendv_epi8(low_phi_bin_1, zero_int, cmp1);
+  __m256i tmp3 = _mm256_blendv_epi8(tmp4, neg1_int, cmp6);
+  lowphi_sel_1 = _mm256_blendv_epi8(lowphi_sel_1, tmp3, cmp4);
+
+  // high bin :
+  __m256i high_sel = _mm256_blendv_epi8(high_phi_bin_1, n_phi_min1, cmp2);
+  tmp4 = _mm256_blendv_epi8(high_sel, neg1_int, cmp6);
+  tmp3 = _mm256_blendv_epi8(n_phi_min1, neg1_int, cmp5);
+  __m256i highphi_sel_1 = _mm256_blendv_epi8(tmp3, tmp4, cmp4);
+
+  tmp4 = _mm256_blendv_epi8(neg1_int, zero_int, cmp5_2);
+  __m256i lowphi_sel_2 = _mm256_blendv_epi8(tmp4, neg1_int, cmp4);
+  __m256i highphi_sel_2 = _mm256_blendv_epi8(high_sel, neg1_int, cmp4);
+
+  _mm256_store_si256((__m256i*)philow1, lowphi_sel_1);
+  _mm256_store_si256((__m256i*)philow2, lowphi_sel_2);
+  _mm256_store_si256((__m256i*)phihi1, highphi_sel_1);
+  _mm256_store_si256((__m256i*)phihi2, highphi_sel_2);
+}
+
+// number of hits binned per kernel call, 8 if the cpu supports avx2
+static unsigned int fillBins_width() {
+  static const unsigned int width = __builtin_cpu_supports("avx2") ? 8 : 4;
+  return width;
+}
+
 void HelixHough::fillBins(unsigned int total_bins, unsigned int hit_counter,
                           float* min_phi_a, float* max_phi_a,
                           vector<SimpleHit3D>& four_hits, fastvec2d& z_bins,
@@ -251,14 +330,10 @@ void HelixHough::fillBins(unsigned int total_bins, unsigned int hit_counter,
   unsigned int zbufnum[8];
   unsigned int size2 = n_z0 * n_dzdl;
 
-  unsigned int philow1[4] __attribute__((aligned(16))) = {
-      0x00000000, 0x00000000, 0x00000000, 0x00000000};
-  unsigned int philow2[4] __attribute__((aligned(16))) = {
-      0x00000000, 0x00000000, 0x00000000, 0x00000000};
-  unsigned int phihi1[4] __attribute__((aligned(16))) = {
-      0x00000000, 0x00000000, 0x00000000, 0x00000000};
-  unsigned int phihi2[4] __attribute__((aligned(16))) = {
-      0x00000000, 0x00000000, 0x00000000, 0x00000000};
+  unsigned int philow1[8] __attribute__((aligned(32))) = {0};
+  unsigned int philow2[8] __attribute__((aligned(32))) = {0};
+  unsigned int phihi1[8] __attribute__((aligned(32))) = {0};
+  unsigned int phihi2[8] __attribute__((aligned(32))) = {0};
 
   z_bins.fetch(four_hits[0].get_id(), four_hits[hit_counter - 1].get_id(), zbuffer,
                zbufnum);
@@ -266,22 +341,28 @@ void HelixHough::fillBins(unsigned int total_bins, unsigned int hit_counter,
   unsigned int zoff = n_z0 * n_dzdl * (k_bin + n_k * d_bin);
   unsigned int binprod = n_z0 * n_dzdl * n_k * n_d;
 
+  const unsigned int width = fillBins_width();
   unsigned int count = hit_counter;
   unsigned int offset = 0;
-  unsigned int cur = 4;
-  if (count < 4) {
+  unsigned int cur = width;
+  if (count < width) {
     cur = count;
   }
   while (true) {
-    float minphi_a[4] __attribute__((aligned(16)));
-    float maxphi_a[4] __attribute__((aligned(16)));
+    float minphi_a[8] __attribute__((aligned(32)));
+    float maxphi_a[8] __attribute__((aligned(32)));
     for (unsigned int i = 0; i < cur; ++i) {
       minphi_a[i] = min_phi_a[i + offset];
       maxphi_a[i] = max_phi_a[i + offset];
     }
 
-    fillBins4_sse(minphi_a, maxphi_a, (float)n_phi, inv_phi_range, low_phi,
-                  high_phi, philow1, philow2, phihi1, phihi2);
+    if (width == 8) {
+      fillBins8_avx2(minphi_a, maxphi_a, (float)n_phi, inv_phi_range, low_phi,
+                     high_phi, philow1, philow2, phihi1, phihi2);
+    } else {
+      fillBins4_sse(minphi_a, maxphi_a, (float)n_phi, inv_phi_range, low_phi,
+                    high_phi, philow1, philow2, phihi1, phihi2);
+    }
 
     for (unsigned int i = 0; i < cur; ++i) {
       unsigned int index = four_hits[i + offset].get_id();
@@ -323,8 +404,8 @@ void HelixHough::fillBins(unsigned int total_bins, unsigned int hit_counter,
     }
     count -= cur;
     offset += cur;
-    cur = 4;
-    if (count < 4) {
+    cur = width;
+    if (count < width) {
       cur = count;
     }
   }
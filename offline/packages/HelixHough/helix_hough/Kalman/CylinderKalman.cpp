@@ -56,6 +56,8 @@ void CylinderKalman::calculate_dxda(SimpleHit3D& hit, HelixKalmanState& state,
   float P2y = kcy * tmp1;
 
   float h = sqrt(R2 - a * a);
+  // dh/dA = (0.5/h)*(-2*a*da/dA) for all the parameters below
+  double half_h_inv = 0.5 / h;
 
   float ux = -kcy * kd_inv;
   float uy = kcx * kd_inv;
@@ -92,7 +94,7 @@ void CylinderKalman::calculate_dxda(SimpleHit3D& hit, HelixKalmanState& state,
   float dtmp1dA = dadA * kd_inv + a * dkd_invdA;
   float dP2xdA = tmp1 * dkcxdA + kcx * dtmp1dA;
   float duxdA = -kd_inv * dkcydA - kcy * dkd_invdA;
-  float dhdA = (0.5 / sqrt(R2 - a * a)) * (-2. * a * dadA);
+  float dhdA = half_h_inv * (-2. * a * dadA);
   dxda(0, 0) = dP2xdA + signk * (duxdA * h + ux * dhdA);
 
   // dy/dphi
@@ -116,7 +118,7 @@ void CylinderKalman::calculate_dxda(SimpleHit3D& hit, HelixKalmanState& state,
   dtmp1dA = dadA * kd_inv + a * dkd_invdA;
   dP2xdA = tmp1 * dkcxdA + kcx * dtmp1dA;
   duxdA = -kd_inv * dkcydA - kcy * dkd_invdA;
-  dhdA = (0.5 / sqrt(R2 - a * a)) * (-2. * a * dadA);
+  dhdA = half_h_inv * (-2. * a * dadA);
   dxda(0, 1) = dP2xdA + signk * (duxdA * h + ux * dhdA);
 
   // dy/d
@@ -140,7 +142,7 @@ void CylinderKalman::calculate_dxda(SimpleHit3D& hit, HelixKalmanState& state,
   dtmp1dA = dadA * kd_inv + a * dkd_invdA;
   dP2xdA = tmp1 * dkcxdA + kcx * dtmp1dA;
   duxdA = -kd_inv * dkcydA - kcy * dkd_invdA;
-  dhdA = (0.5 / sqrt(R2 - a * a)) * (-2. * a * dadA);
+  dhdA = half_h_inv * (-2. * a * dadA);
   dxda(0, 2) = dP2xdA + signk * (duxdA * h + ux * dhdA);
 
   // dy/k
@@ -427,6 +429,7 @@ void CylinderKalman::calculateProjections(SimpleHit3D& hit,
 void CylinderKalman::calculateMeasurements(SimpleHit3D& hit,
                                            Matrix<float, 2, 1>& m,
                                            Matrix<float, 2, 2>& G) {
+  // the measurement covariance is diagonal, its inverse is as well
   Matrix<float, 2, 2> V = Matrix<float, 2, 2>::Zero(2, 2);
 
   V(0, 0) = 3.33333333333333426e-01 *
@@ -442,7 +445,9 @@ void CylinderKalman::calculateMeasurements(SimpleHit3D& hit,
     (2.0*sqrt(hit.get_size(2,2))) *
     (2.0*sqrt(hit.get_size(2,2)));
 
-  G = V.fullPivLu().inverse();
+  G = Matrix<float, 2, 2>::Zero(2, 2);
+  G(0, 0) = 1. / V(0, 0);
+  G(1, 1) = 1. / V(1, 1);
 
   m = Matrix<float, 2, 1>::Zero(2, 1);
   m(0) = atan2(hit.get_y(), hit.get_x());
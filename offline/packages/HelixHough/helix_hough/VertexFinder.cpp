@@ -5,6 +5,7 @@
 #include <VertexFitFunc.h>
 
 // FitNewton includes
+#include <NewtonMinimizerFixed.h>
 #include <NewtonMinimizerGradHessian.h>
 
 // Eigen includes
@@ -41,13 +42,35 @@ bool VertexFinder::findVertex(vector<SimpleTrack3D>& tracks, vector<float>& vert
 bool VertexFinder::findVertex(vector<SimpleTrack3D>& tracks, vector<Matrix<float,5,5> >& covariances, vector<float>& vertex, float sigma, bool fix_xy)
 {
   VertexFitFunc _vertexfit;
-  FitNewton::NewtonMinimizerGradHessian _minimizer;
 
   // setup function to minimize
   // expo-dca2 => ~dca^2 w/ extreme outlier de-weighting
   _vertexfit.setTracks(&tracks);
   _vertexfit.setCovariances(&covariances);
-    
+  _vertexfit.setFixedPar(0, sigma);                     // index = 0 used for x,y,z uncertainties
+
+  if(vertex.size() == 3)
+  {
+    // x,y,z: fixed size minimizer, no heap allocations or virtual calls in the iterations
+    NewtonMinimizerFixed<3, VertexFitFunc> _minimizer;
+    _minimizer.setFunction(&_vertexfit);
+    if(fix_xy)
+    {
+      _minimizer.fixParameter(0);
+      _minimizer.fixParameter(1);
+    }
+    NewtonMinimizerFixed<3, VertexFitFunc>::Vector start_point(vertex[0], vertex[1], vertex[2]);
+    NewtonMinimizerFixed<3, VertexFitFunc>::Vector min_point = NewtonMinimizerFixed<3, VertexFitFunc>::Vector::Zero();
+    _minimizer.minimize(start_point, min_point, 1.0e-12, 48, 1.0e-18);
+    for(unsigned i=0; i<3; i++)
+    {
+      vertex[i] = min_point(i);
+    }
+    return true;
+  }
+
+  FitNewton::NewtonMinimizerGradHessian _minimizer;
+
   // setup the minimizer
   // fast Newton gradient minimization
   _minimizer.setFunction(&_vertexfit);
@@ -63,7 +86,6 @@ bool VertexFinder::findVertex(vector<SimpleTrack3D>& tracks, vector<Matrix<float
     _minimizer.fixParameter(0);
     _minimizer.fixParameter(1);
   }
-  _vertexfit.setFixedPar(0, sigma);                     // index = 0 used for x,y,z uncertainties
 
   // output storage
   VectorXd min_point = VectorXd::Zero(vertex.size());   // output vector for minimize method below
@@ -1,6 +1,6 @@
 #include "VertexFitFunc.h"
 
-#include "NewtonMinimizerGradHessian.h"
+#include "NewtonMinimizerFixed.h"
 #include "SimpleTrack3D.h"
 
 #include <cmath>
@@ -25,6 +25,12 @@ HelixDCAFunc::~HelixDCAFunc()
 
 
 bool HelixDCAFunc::calcValGradHessian(const VectorXd& x, double& val, VectorXd& grad, MatrixXd& hessian)
+{
+  return calcDCA(x(0), val, grad(0), hessian(0,0), true);
+}
+
+
+bool HelixDCAFunc::calcDCA(double l, double& val, double& grad, double& hessian, bool with_covariance)
 {
 //   the 5 helix parameters are k,d,phi,z0,dzdl
 //   l will be used as the independent variable
@@ -61,7 +67,7 @@ bool HelixDCAFunc::calcValGradHessian(const VectorXd& x, double& val, VectorXd&
 //   l == x
   
   
-  point_covariance = Matrix<float,3,3>::Zero(3,3);
+  if(with_covariance){point_covariance = Matrix<float,3,3>::Zero(3,3);}
   
   
   float k = fixedpars[2];
@@ -77,12 +83,15 @@ bool HelixDCAFunc::calcValGradHessian(const VectorXd& x, double& val, VectorXd&
   
   // pc = (df/dx)*C*(df/dx)^T
   Matrix<float,3,5> dpdx =  Matrix<float,3,5>::Zero(3,5);
-  // dxp/dphi = -d*sinphi , dyp/dphi = d*cosphi
-  dpdx(0,0) = -d*sinphi;dpdx(1,0) = d*cosphi;
-  // dxp/dd = cosphi;dyp/dd = sinphi
-  dpdx(0,1) = cosphi;dpdx(1,1) = sinphi;
-  dpdx(2,3) = 1.;
-  point_covariance = dpdx * covariance * (dpdx.transpose());
+  if(with_covariance)
+  {
+    // dxp/dphi = -d*sinphi , dyp/dphi = d*cosphi
+    dpdx(0,0) = -d*sinphi;dpdx(1,0) = d*cosphi;
+    // dxp/dd = cosphi;dyp/dd = sinphi
+    dpdx(0,1) = cosphi;dpdx(1,1) = sinphi;
+    dpdx(2,3) = 1.;
+    point_covariance = dpdx * covariance * (dpdx.transpose());
+  }
   
   
   //determine tangent direction ux,uy in xy plane
@@ -99,10 +108,10 @@ bool HelixDCAFunc::calcValGradHessian(const VectorXd& x, double& val, VectorXd&
   }
   
   float dzdl = fixedpars[4];
-  //determine point on the helix with parameter l == x(0)
+  //determine point on the helix with parameter l
   float dsdl = sqrt(1. - dzdl*dzdl);
-  float s = dsdl*x(0);
-  float dsddzdl = -x(0) * (1./sqrt(1. - dzdl*dzdl)) * dzdl;
+  float s = dsdl*l;
+  float dsddzdl = -l * (1./sqrt(1. - dzdl*dzdl)) * dzdl;
   
   float psi = 0.5*s*k;
   float D = 0.;
@@ -168,17 +177,20 @@ bool HelixDCAFunc::calcValGradHessian(const VectorXd& x, double& val, VectorXd&
   
   xp += D*ux2;
   yp += D*uy2;
-  zp += dzdl*x(0);
-  
-  Matrix<float,1,5> temp_1_5 = Matrix<float,1,5>::Zero(1,5);
-  temp_1_5 = D*dux2dx + ux2*dDdx;
-  dpdx = Matrix<float,3,5>::Zero(3,5);
-  for(int i=0;i<5;++i){dpdx(0,i) = temp_1_5(0,i);}
-  temp_1_5 = D*duy2dx + uy2*dDdx;
-  for(int i=0;i<5;++i){dpdx(1,i) = temp_1_5(0,i);}
-  dpdx(2,4) = x(0);
+  zp += dzdl*l;
   
-  point_covariance += dpdx * covariance * (dpdx.transpose());
+  if(with_covariance)
+  {
+    Matrix<float,1,5> temp_1_5 = Matrix<float,1,5>::Zero(1,5);
+    temp_1_5 = D*dux2dx + ux2*dDdx;
+    dpdx = Matrix<float,3,5>::Zero(3,5);
+    for(int i=0;i<5;++i){dpdx(0,i) = temp_1_5(0,i);}
+    temp_1_5 = D*duy2dx + uy2*dDdx;
+    for(int i=0;i<5;++i){dpdx(1,i) = temp_1_5(0,i);}
+    dpdx(2,4) = l;
+    
+    point_covariance += dpdx * covariance * (dpdx.transpose());
+  }
   
   point[0] = xp;
   point[1] = yp;
@@ -255,13 +267,13 @@ bool HelixDCAFunc::calcValGradHessian(const VectorXd& x, double& val, VectorXd&
   
   val = dx*dx + dy*dy + dz*dz;
   
-  grad(0) = 2.*dx*dsdl*ux2 + 2.*dy*dsdl*uy2 + 2.*dz*dzdl;
+  grad = 2.*dx*dsdl*ux2 + 2.*dy*dsdl*uy2 + 2.*dz*dzdl;
   
-  hessian(0,0) = 2.*dsdl*ux2*dsdl*ux2;
-  hessian(0,0) += 2.*dsdl*uy2*dsdl*uy2;
-  hessian(0,0) += 2.*dzdl*dzdl;
-  hessian(0,0) += -2.*dx*dsdl*dsdl*uy2*k;
-  hessian(0,0) += 2.*dy*dsdl*dsdl*ux2*k;
+  hessian = 2.*dsdl*ux2*dsdl*ux2;
+  hessian += 2.*dsdl*uy2*dsdl*uy2;
+  hessian += 2.*dzdl*dzdl;
+  hessian += -2.*dx*dsdl*dsdl*uy2*k;
+  hessian += 2.*dy*dsdl*dsdl*ux2*k;
   
   float xylen = sqrt(1-dzdl*dzdl);
   tangent[0] = ux2*xylen;
@@ -290,7 +302,21 @@ VertexFitFunc::~VertexFitFunc()
 
 bool VertexFitFunc::calcValGradHessian(const VectorXd& x, double& val, VectorXd& grad, MatrixXd& hessian)
 {
-  NewtonMinimizerGradHessian minimizer;
+  return calcVertex(x, val, grad, hessian);
+}
+
+
+bool VertexFitFunc::calcValGradHessian(const Matrix<double,3,1>& x, double& val, Matrix<double,3,1>& grad, Matrix<double,3,3>& hessian)
+{
+  return calcVertex(x, val, grad, hessian);
+}
+
+
+template <class TVector, class TMatrix>
+bool VertexFitFunc::calcVertex(const TVector& x, double& val, TVector& grad, TMatrix& hessian)
+{
+  // the closest approach of every track is a one parameter minimization, done with fixed size vectors
+  NewtonMinimizerFixed<1, HelixDCAFunc> minimizer;
   HelixDCAFunc helixfunc;
   minimizer.setFunction(&helixfunc);
   
@@ -316,17 +342,14 @@ bool VertexFitFunc::calcValGradHessian(const VectorXd& x, double& val, VectorXd&
     helixfunc.setFixedPar(5, x(0));
     helixfunc.setFixedPar(6, x(1));
     helixfunc.setFixedPar(7, x(2));
-    VectorXd start_point = VectorXd::Zero(1);
-    VectorXd min_point = VectorXd::Zero(1);
+    NewtonMinimizerFixed<1, HelixDCAFunc>::Vector start_point = NewtonMinimizerFixed<1, HelixDCAFunc>::Vector::Zero();
+    NewtonMinimizerFixed<1, HelixDCAFunc>::Vector min_point = NewtonMinimizerFixed<1, HelixDCAFunc>::Vector::Zero();
     //find the point on the helix closest to the point x
     minimizer.minimize(start_point, min_point, 0x1.0p-30, 16, 0x1.0p-40);
     
     //now calculate the chi-square contribution from this track
-    double tval=0.;
-    VectorXd tgrad = VectorXd::Zero(1);
-    MatrixXd thessian = MatrixXd::Zero(1,1);
-    
-    helixfunc.calcValGradHessian(min_point, tval, tgrad, thessian);
+    //the point covariance is only needed here, and only if there are covariances
+    helixfunc.calcPoint(min_point(0), covariances->size() > 0);
     
     float point[3];float tangent[3];
     point[0] = helixfunc.getPoint(0);
@@ -17,6 +17,19 @@ class HelixDCAFunc : public FitNewton::FunctionGradHessian
     
     bool calcValGradHessian(const Eigen::VectorXd& x, double& val, Eigen::VectorXd& grad, Eigen::MatrixXd& hessian);
     
+    // fixed size version for FitNewton::NewtonMinimizerFixed, does not update the point covariance
+    bool calcValGradHessian(const Eigen::Matrix<double,1,1>& x, double& val, Eigen::Matrix<double,1,1>& grad, Eigen::Matrix<double,1,1>& hessian)
+    {
+      return calcDCA(x(0), val, grad(0), hessian(0,0), false);
+    }
+    
+    // point, tangent and optionally the point covariance at path length l
+    bool calcPoint(double l, bool with_covariance=true)
+    {
+      double val=0.;double grad=0.;double hessian=0.;
+      return calcDCA(l, val, grad, hessian, with_covariance);
+    }
+    
     FitNewton::FunctionGradHessian* Clone() const {return new HelixDCAFunc();}
     
     double getTangent(unsigned int coor){return tangent[coor];}
@@ -25,6 +38,9 @@ class HelixDCAFunc : public FitNewton::FunctionGradHessian
     void setCovariance(Eigen::Matrix<float,5,5> const& cov){covariance = cov;}
     
   private:
+    // squared distance of the point at path length l to the vertex, and its derivatives in l
+    bool calcDCA(double l, double& val, double& grad, double& hessian, bool with_covariance);
+    
     Eigen::Matrix<float,5,5> covariance;
     std::vector<double> tangent;
     std::vector<double> point;
@@ -39,12 +55,18 @@ class VertexFitFunc : public FitNewton::FunctionGradHessian
     
     bool calcValGradHessian(const Eigen::VectorXd& x, double& val, Eigen::VectorXd& grad, Eigen::MatrixXd& hessian);
     
+    // fixed size version for FitNewton::NewtonMinimizerFixed
+    bool calcValGradHessian(const Eigen::Matrix<double,3,1>& x, double& val, Eigen::Matrix<double,3,1>& grad, Eigen::Matrix<double,3,3>& hessian);
+    
     FitNewton::FunctionGradHessian* Clone() const {return new VertexFitFunc();}
     
     void setTracks(std::vector<SimpleTrack3D>* trks){tracks = trks;}
     void setCovariances(std::vector<Eigen::Matrix<float,5,5> >* covs){covariances = covs;}
     
   private:
+    template <class TVector, class TMatrix>
+    bool calcVertex(const TVector& x, double& val, TVector& grad, TMatrix& hessian);
+    
     std::vector<Eigen::Matrix<float,5,5> >* covariances;
     std::vector<SimpleTrack3D> *tracks;
 };
@@ -1973,7 +1973,21 @@ void sPHENIXSeedFinder::findHelicesParallelOneHelicity(
 		}
 	}
 
+	// the threads take the bins one at a time, so threads with cheap bins do
+	// not wait for one with a busy bin
+	bin_tracks.assign(thread_ranges.size(), vector<SimpleTrack3D>());
+	bin_states.assign(thread_ranges.size(), vector<HelixKalmanState>());
+	next_thread_bin = 0;
 	pins->sewStraight(&sPHENIXSeedFinder::findHelicesParallelThread, nthreads);
+
+	// merge in bin order, the result does not depend on the number of threads
+	// or on which thread did which bin
+	for (unsigned int b = 0; b < bin_tracks.size(); ++b) {
+		for (unsigned int j = 0; j < bin_tracks[b].size(); ++j) {
+			parallel_tracks.push_back(bin_tracks[b][j]);
+			parallel_states.push_back(bin_states[b][j]);
+		}
+	}
 }
 
 void sPHENIXSeedFinder::findHelicesParallel(vector<SimpleHit3D>& hits,
@@ -1982,9 +1996,15 @@ void sPHENIXSeedFinder::findHelicesParallel(vector<SimpleHit3D>& hits,
 	thread_min_hits = min_hits;
 	thread_max_hits = max_hits;
 
+	parallel_tracks.clear();
+	parallel_states.clear();
 	for (unsigned int i = 0; i < nthreads; ++i) {
 		thread_tracks[i].clear();
 		thread_trackers[i]->clear();
+		thread_trackers[i]->setSmoothBack(smooth_back);
+		thread_trackers[i]->setCutOnDca(cut_on_dca);
+		thread_trackers[i]->setDcaCut(dca_cut);
+		thread_trackers[i]->hit_error_scale = hit_error_scale;
 		if (cluster_start_bin != 0) {
 			thread_trackers[i]->setClusterStartBin(cluster_start_bin - 1);
 		} else {
@@ -2023,16 +2043,10 @@ void sPHENIXSeedFinder::findHelicesParallel(vector<SimpleHit3D>& hits,
 		findHelicesParallelOneHelicity(hits, min_hits, max_hits, tracks);
 	}
 
-	vector<SimpleTrack3D> temp_tracks;
-	for (unsigned int i = 0; i < nthreads; ++i) {
-		vector<HelixKalmanState>* states =
-				&(thread_trackers[i]->getKalmanStates());
-		for (unsigned int j = 0; j < thread_tracks[i].size(); ++j) {
-			track_states.push_back((*states)[j]);
-			temp_tracks.push_back(thread_tracks[i][j]);
-		}
+	for (unsigned int j = 0; j < parallel_states.size(); ++j) {
+		track_states.push_back(parallel_states[j]);
 	}
-	finalize(temp_tracks, tracks);
+	finalize(parallel_tracks, tracks);
 }
 
 void sPHENIXSeedFinder::splitHitsParallelThread(void* arg) {
@@ -2044,12 +2058,17 @@ void sPHENIXSeedFinder::splitHitsParallelThread(void* arg) {
 void sPHENIXSeedFinder::findHelicesParallelThread(void* arg) {
 	unsigned long int w = (*((unsigned long int*) arg));
 
-	for (unsigned int i = w; i < thread_ranges.size(); i += nthreads) {
+	unsigned int i = 0;
+	while ((i = next_thread_bin++) < thread_ranges.size()) {
 		if (thread_hits[i].size() == 0) {
 			continue;
 		}
+		thread_tracks[w].clear();
+		thread_trackers[w]->clear();
 		thread_trackers[w]->setTopRange(thread_ranges[i]);
 		thread_trackers[w]->findHelices(thread_hits[i], thread_min_hits,
 				thread_max_hits, thread_tracks[w]);
+		bin_tracks[i].swap(thread_tracks[w]);
+		bin_states[i].swap(thread_trackers[w]->getKalmanStates());
 	}
 }
@@ -9,6 +9,7 @@
 
 
 #include <algorithm>
+#include <atomic>
 #include <cmath>
 #include <map>
 #include <memory>
@@ -546,6 +547,14 @@ private:
 	SeamStress::Pincushion<sPHENIXSeedFinder> *pins;
 	std::vector<sPHENIXSeedFinder*> thread_trackers;
 	std::vector<std::vector<SimpleTrack3D> > thread_tracks;
+	// next top level bin to be taken by a thread
+	std::atomic<unsigned int> next_thread_bin;
+	// tracks and kalman states found in each top level bin
+	std::vector<std::vector<SimpleTrack3D> > bin_tracks;
+	std::vector<std::vector<HelixKalmanState> > bin_states;
+	// results of all bins, in bin order
+	std::vector<SimpleTrack3D> parallel_tracks;
+	std::vector<HelixKalmanState> parallel_states;
 	std::vector<HelixRange> thread_ranges;
 	std::vector<std::vector<SimpleHit3D> > thread_hits;
 	std::vector<std::vector<SimpleHit3D> > split_input_hits;
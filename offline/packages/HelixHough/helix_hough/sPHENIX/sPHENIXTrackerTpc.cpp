@@ -983,15 +983,39 @@ void sPHENIXTrackerTpc::findTracksByCombinatorialKalman(
 
     state.C *= 10.;
 
-    vector<vector<int> > inner_combos;
-    for (int l = 0; l < 2; ++l) {
-      for (int i0 = 0; i0 < layer_indexes[0].size(); ++i0) {
-        for (int i1 = 0; i1 < layer_indexes[1].size(); ++i1) {
-          for (int i2 = 0; i2 < layer_indexes[2].size(); ++i2) {
-            inner_combos.push_back(vector<int>(3, 0));
-            inner_combos.back()[0] = layer_indexes[0][i0];
-            inner_combos.back()[1] = layer_indexes[1][i1];
-            inner_combos.back()[2] = layer_indexes[2][i2];
+    // all combinations of one hit (or none, the negative index) in each of the
+    // three inner layers. The hits are added from the outside in, so the states
+    // after the outer layers are shared by all combinations behind them
+    const unsigned int n0 = layer_indexes[0].size();
+    const unsigned int n1 = layer_indexes[1].size();
+    const unsigned int n2 = layer_indexes[2].size();
+    vector<float> combo_chi2(n0 * n1 * n2, 0.);
+    vector<int> combo_np(n0 * n1 * n2, 0);
+    for (unsigned int i2 = 0; i2 < n2; ++i2) {
+      HelixKalmanState state2(state);
+      int np2 = 0;
+      if (layer_indexes[2][i2] >= 0) {
+        np2 += 1;
+        kalman->addHit(hits[layer_indexes[2][i2]], state2);
+      }
+      for (unsigned int i1 = 0; i1 < n1; ++i1) {
+        HelixKalmanState state1(state2);
+        int np1 = np2;
+        if (layer_indexes[1][i1] >= 0) {
+          np1 += 1;
+          kalman->addHit(hits[layer_indexes[1][i1]], state1);
+        }
+        for (unsigned int i0 = 0; i0 < n0; ++i0) {
+          // combinations are numbered with the innermost layer slowest
+          unsigned int c = (i0 * n1 + i1) * n2 + i2;
+          combo_np[c] = np1;
+          if (layer_indexes[0][i0] >= 0) {
+            HelixKalmanState temp_state(state1);
+            combo_np[c] += 1;
+            kalman->addHit(hits[layer_indexes[0][i0]], temp_state);
+            combo_chi2[c] = temp_state.chi2 - state.chi2;
+          } else {
+            combo_chi2[c] = state1.chi2 - state.chi2;
           }
         }
       }
@@ -1000,16 +1024,9 @@ void sPHENIXTrackerTpc::findTracksByCombinatorialKalman(
     float best_chi2_p[4] = {-1., -1., -1., -1.};
     int best_ind_p[4] = {-1, -1, -1, -1};
 
-    for (int c = 0; c < inner_combos.size(); ++c) {
-      HelixKalmanState temp_state(state);
-      int n_p = 0;
-      for (int l = 2; l >= 0; l -= 1) {
-        if (inner_combos[c][l] >= 0) {
-          n_p += 1;
-          kalman->addHit(hits[inner_combos[c][l]], temp_state);
-        }
-      }
-      float chi2 = temp_state.chi2 - state.chi2;
+    for (unsigned int c = 0; c < combo_chi2.size(); ++c) {
+      int n_p = combo_np[c];
+      float chi2 = combo_chi2[c];
       if ((best_chi2_p[n_p] == -1) || (chi2 < best_chi2_p[n_p])) {
         best_chi2_p[n_p] = chi2;
         best_ind_p[n_p] = c;
@@ -1026,11 +1043,14 @@ void sPHENIXTrackerTpc::findTracksByCombinatorialKalman(
 
     vector<SimpleHit3D> inner_hits;
     if (best_np > 0) {
+      int c = best_ind_p[best_np];
+      int best_combo[3] = {layer_indexes[0][c / (n1 * n2)],
+                           layer_indexes[1][(c / n2) % n1],
+                           layer_indexes[2][c % n2]};
       for (int l = 2; l >= 0; l -= 1) {
-        int c = best_ind_p[best_np];
-        if (inner_combos[c][l] >= 0) {
-          inner_hits.push_back(hits[inner_combos[c][l]]);
-          kalman->addHit(hits[inner_combos[c][l]], state);
+        if (best_combo[l] >= 0) {
+          inner_hits.push_back(hits[best_combo[l]]);
+          kalman->addHit(hits[best_combo[l]], state);
         }
       }
     }
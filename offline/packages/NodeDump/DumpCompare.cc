@@ -0,0 +1,291 @@
+#include "DumpCompare.h"
+#include "DumpRecord.h"
+
+#include <phool/phool.h>
+
+#include <algorithm>
+#include <cmath>
+#include <cstdlib>
+#include <iostream>
+#include <set>
+#include <sstream>
+#include <utility>
+#include <vector>
+
+#include <dirent.h>
+
+using namespace std;
+
+namespace
+{
+  //! keys of the object a field belongs to, e.g. hitset 0x... hit 0x...
+  string ObjectKeys(const vector<pair<string, uint64_t> > &keys)
+  {
+    if (keys.empty())
+    {
+      return "(no object) ";
+    }
+    ostringstream str;
+    for (auto &key : keys)
+    {
+      str << key.first << " 0x" << hex << key.second << dec << " ";
+    }
+    return str.str();
+  }
+
+  string Value(const DumpRecord::Field &field)
+  {
+    ostringstream str;
+    str.precision(17);
+    switch (field.type)
+    {
+    case DumpRecord::kKey:
+    case DumpRecord::kUInt:
+      str << field.uvalue;
+      break;
+    case DumpRecord::kInt:
+      str << field.ivalue;
+      break;
+    case DumpRecord::kFloat:
+    case DumpRecord::kDouble:
+      str << field.dvalue;
+      break;
+    default:
+      str << "\"" << field.svalue << "\"";
+    }
+    return str.str();
+  }
+
+  set<string> BinaryDumps(const string &dir)
+  {
+    set<string> names;
+    DIR *dp = opendir(dir.c_str());
+    if (!dp)
+    {
+      cout << PHWHERE << " cannot open directory " << dir << endl;
+      return names;
+    }
+    while (struct dirent *entry = readdir(dp))
+    {
+      string fname = entry->d_name;
+      if (fname.size() > 4 && fname.compare(fname.size() - 4, 4, ".bin") == 0)
+      {
+        names.insert(fname.substr(0, fname.size() - 4));
+      }
+    }
+    closedir(dp);
+    return names;
+  }
+}  // namespace
+
+DumpCompare::DumpCompare()
+  : m_RelTolerance(0.)
+  , m_AbsTolerance(0.)
+  , m_Verbosity(0)
+{
+}
+
+int DumpCompare::Compare(const string &dir1, const string &dir2)
+{
+  set<string> nodes1 = BinaryDumps(dir1);
+  set<string> nodes2 = BinaryDumps(dir2);
+  int ndiff = 0;
+  for (auto &node : nodes1)
+  {
+    if (nodes2.find(node) == nodes2.end())
+    {
+      cout << node << ": only in " << dir1 << endl;
+      ++ndiff;
+      continue;
+    }
+    if (CompareFiles(dir1 + "/" + node + ".bin", dir2 + "/" + node + ".bin"))
+    {
+      ++ndiff;
+    }
+  }
+  for (auto &node : nodes2)
+  {
+    if (nodes1.find(node) == nodes1.end())
+    {
+      cout << node << ": only in " << dir2 << endl;
+      ++ndiff;
+    }
+  }
+  cout << "DumpCompare: " << ndiff << " of " << max(nodes1.size(), nodes2.size())
+       << " nodes differ" << endl;
+  return ndiff;
+}
+
+int DumpCompare::CompareFiles(const string &file1, const string &file2)
+{
+  DumpRecordReader dump1(file1);
+  DumpRecordReader dump2(file2);
+  if (!dump1.IsOpen() || !dump2.IsOpen())
+  {
+    cout << PHWHERE << " " << (dump1.IsOpen() ? file2 : file1)
+         << " is not a binary node dump" << endl;
+    return 1;
+  }
+  // the node name for the printout
+  string node = file1.substr(file1.find_last_of('/') + 1);
+  node = node.substr(0, node.rfind(".bin"));
+
+  int nevents = 0;
+  int ndiff = 0;
+  vector<DumpRecord::Field> fields1;
+  vector<DumpRecord::Field> fields2;
+  while (true)
+  {
+    const bool more1 = dump1.NextEvent();
+    const bool more2 = dump2.NextEvent();
+    if (!more1 || !more2)
+    {
+      if (more1 || more2)
+      {
+        cout << node << ": " << (more1 ? file1 : file2) << " has more events than "
+             << nevents << endl;
+        ++ndiff;
+      }
+      break;
+    }
+    ++nevents;
+    if (dump1.Run() != dump2.Run() || dump1.EvtSequence() != dump2.EvtSequence())
+    {
+      cout << node << ": event mismatch, run " << dump1.Run() << " event " << dump1.EvtSequence()
+           << " vs run " << dump2.Run() << " event " << dump2.EvtSequence() << endl;
+      ++ndiff;
+      break;
+    }
+    if (dump1.Hash() == dump2.Hash())
+    {
+      continue;
+    }
+    if (!dump1.Decode(fields1) || !dump2.Decode(fields2))
+    {
+      cout << PHWHERE << " " << node << ": corrupt event " << dump1.EvtSequence() << endl;
+      ++ndiff;
+      break;
+    }
+
+    // fields are only compared up to the first difference of an event
+    vector<pair<string, uint64_t> > keys;
+    string difference;
+    const size_t nfields = min(fields1.size(), fields2.size());
+    for (size_t i = 0; i < nfields; ++i)
+    {
+      const DumpRecord::Field &f1 = fields1[i];
+      const DumpRecord::Field &f2 = fields2[i];
+      if (f1.type != f2.type || *f1.name != *f2.name)
+      {
+        difference = "field " + *f1.name + " vs field " + *f2.name;
+        break;
+      }
+      bool same = true;
+      switch (f1.type)
+      {
+      case DumpRecord::kKey:
+      case DumpRecord::kUInt:
+        same = (f1.uvalue == f2.uvalue);
+        break;
+      case DumpRecord::kInt:
+        same = (f1.ivalue == f2.ivalue);
+        break;
+      case DumpRecord::kFloat:
+      case DumpRecord::kDouble:
+        same = Equal(f1.dvalue, f2.dvalue);
+        break;
+      default:
+        same = EqualText(f1.svalue, f2.svalue);
+      }
+      if (!same)
+      {
+        ostringstream str;
+        str.precision(17);
+        str << *f1.name << ": " << Value(f1) << " vs " << Value(f2);
+        if (f1.type == DumpRecord::kFloat || f1.type == DumpRecord::kDouble)
+        {
+          str << " (diff " << f1.dvalue - f2.dvalue << ")";
+        }
+        difference = str.str();
+        break;
+      }
+      if (f1.type == DumpRecord::kKey)
+      {
+        auto iter = find_if(keys.begin(), keys.end(), [&f1](const pair<string, uint64_t> &key) { return key.first == *f1.name; });
+        if (iter != keys.end())
+        {
+          // a new object of this kind, inner keys do not apply anymore
+          keys.erase(iter, keys.end());
+        }
+        keys.push_back(make_pair(*f1.name, f1.uvalue));
+      }
+    }
+    if (difference.empty() && fields1.size() != fields2.size())
+    {
+      difference = (fields1.size() > fields2.size() ? file1 : file2) + " has more fields";
+    }
+    if (difference.empty())
+    {
+      // different hashes, but within tolerance
+      continue;
+    }
+    if (!ndiff || m_Verbosity > 0)
+    {
+      cout << node << ": run " << dump1.Run() << " event " << dump1.EvtSequence()
+           << " differs at " << ObjectKeys(keys) << difference << endl;
+    }
+    ++ndiff;
+  }
+  if (ndiff)
+  {
+    cout << node << ": " << ndiff << " of " << nevents << " events differ" << endl;
+  }
+  else if (m_Verbosity > 0)
+  {
+    cout << node << ": " << nevents << " events identical" << endl;
+  }
+  return ndiff;
+}
+
+bool DumpCompare::Equal(const double a, const double b) const
+{
+  if (a == b || (std::isnan(a) && std::isnan(b)))
+  {
+    return true;
+  }
+  const double diff = fabs(a - b);
+  return (diff <= m_AbsTolerance || diff <= m_RelTolerance * max(fabs(a), fabs(b)));
+}
+
+bool DumpCompare::EqualText(const string &a, const string &b) const
+{
+  if (a == b)
+  {
+    return true;
+  }
+  istringstream tokens1(a);
+  istringstream tokens2(b);
+  string t1;
+  string t2;
+  while (true)
+  {
+    const bool more1 = static_cast<bool>(tokens1 >> t1);
+    const bool more2 = static_cast<bool>(tokens2 >> t2);
+    if (!more1 || !more2)
+    {
+      return (more1 == more2);
+    }
+    if (t1 == t2)
+    {
+      continue;
+    }
+    char *end1;
+    char *end2;
+    const double d1 = strtod(t1.c_str(), &end1);
+    const double d2 = strtod(t2.c_str(), &end2);
+    if (*end1 || *end2 || end1 == t1.c_str() || end2 == t2.c_str() || !Equal(d1, d2))
+    {
+      return false;
+    }
+  }
+}
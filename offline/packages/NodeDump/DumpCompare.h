@@ -0,0 +1,44 @@
+#ifndef NODEDUMP_DUMPCOMPARE_H
+#define NODEDUMP_DUMPCOMPARE_H
+
+#include <string>
+
+/**
+ * Compares two binary node dumps (Dumper::SetBinary()), e.g. of the same
+ * input processed by two builds. Events with equal hashes are skipped,
+ * for the others the fields are compared in order and the first difference
+ * of every node is printed with the keys of the object it belongs to.
+ * Floating point values (also the numbers in the text lines of dumpers
+ * without binary output) agree if they differ by less than the absolute
+ * or the relative tolerance, both are 0 by default.
+ */
+class DumpCompare
+{
+ public:
+  DumpCompare();
+  virtual ~DumpCompare() {}
+
+  void SetTolerance(const double reltol, const double abstol = 0.)
+  {
+    m_RelTolerance = reltol;
+    m_AbsTolerance = abstol;
+  }
+  void Verbosity(const int i) { m_Verbosity = i; }
+
+  //! compares all <node>.bin files of two dump directories, returns the number of nodes which differ
+  int Compare(const std::string &dir1, const std::string &dir2);
+
+  //! compares the dumps of a single node, returns the number of events which differ
+  int CompareFiles(const std::string &file1, const std::string &file2);
+
+ private:
+  bool Equal(const double a, const double b) const;
+  //! compares the whitespace separated tokens, numbers with tolerance
+  bool EqualText(const std::string &a, const std::string &b) const;
+
+  double m_RelTolerance;
+  double m_AbsTolerance;
+  int m_Verbosity;
+};
+
+#endif
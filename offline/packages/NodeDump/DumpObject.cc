@@ -1,21 +1,26 @@
 #include "DumpObject.h"
 
+#include "DumpRecord.h"
 #include "PHNodeDump.h"
 
 #include <fstream>
 #include <iostream>
+#include <limits>
+#include <sstream>
 #include <string>
 
 using namespace std;
 
 DumpObject::DumpObject(const string &NodeName)
   : fout(nullptr)
+  , bout(nullptr)
   , ThisName(NodeName)
   , write_run_event(1)
   , OutDir("./")
   , fp_precision(-1)
   , myNodeDump(nullptr)
   , no_output(0)
+  , binary(false)
 {
   return;
 }
@@ -35,6 +40,14 @@ int DumpObject::OpenOutFile()
   {
     return 0;
   }
+  if (binary)
+  {
+    bout = new DumpRecordWriter(OutDir + "/" + ThisName + ".bin");
+    fout = new ostringstream();
+    // the stored text lines are compared with tolerance, not to the last digit
+    fout->precision((fp_precision > 0) ? fp_precision : numeric_limits<double>::max_digits10);
+    return 0;
+  }
   string fname = OutDir + "/" + ThisName + ".list";
   fout = new ofstream(fname.c_str());
   return 0;
@@ -48,6 +61,14 @@ void DumpObject::Print(const char *what) const
 
 int DumpObject::process_event(PHNode *myNode)
 {
+  if (bout)
+  {
+    bout->BeginEvent();
+    process_Node(myNode);
+    StoreTextLines();
+    bout->EndEvent(myNodeDump->RunNumber(), myNodeDump->EvtSequence());
+    return 0;
+  }
   if (fout && write_run_event)
   {
     if (fp_precision > 0)
@@ -70,9 +91,26 @@ int DumpObject::process_Node(PHNode *myNode)
   return 0;
 }
 
+void DumpObject::StoreTextLines()
+{
+  ostringstream *text = static_cast<ostringstream *>(fout);
+  istringstream lines(text->str());
+  string line;
+  while (getline(lines, line))
+  {
+    if (!line.empty())
+    {
+      bout->String("line", line);
+    }
+  }
+  text->str("");
+}
+
 int DumpObject::CloseOutputFile()
 {
   delete fout;
   fout = 0;
+  delete bout;
+  bout = nullptr;
   return 0;
 }
@@ -4,6 +4,7 @@
 #include <iosfwd>
 #include <string>
 
+class DumpRecordWriter;
 class PHNode;
 class PHNodeDump;
 
@@ -26,19 +27,27 @@ class DumpObject
   void SetParentNodeDump(PHNodeDump *nd) { myNodeDump = nd; }
   void NoOutput(const int i = 1) { no_output = i; }
   void WriteRunEvent(int i) { write_run_event = i; }
+  //! write OutDir/Name.bin instead of the text file, see DumpRecord.h
+  void SetBinary(const bool b) { binary = b; }
 
  protected:
   virtual int process_Node(PHNode *myNode);
   virtual int OpenOutFile();
   std::ostream *fout;
+  // binary output, dumpers without binary records write text to fout
+  // whose lines are stored as strings
+  DumpRecordWriter *bout;
 
  private:
+  void StoreTextLines();
+
   std::string ThisName;
   int write_run_event;  // flag for not writing info for each event
   std::string OutDir;
   int fp_precision;
   PHNodeDump *myNodeDump;
   int no_output;
+  bool binary;
 };
 
 #endif
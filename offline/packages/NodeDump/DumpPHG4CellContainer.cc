@@ -1,4 +1,5 @@
 #include "DumpPHG4CellContainer.h"
+#include "DumpRecord.h"
 
 #include <phool/PHIODataNode.h>
 
@@ -35,6 +36,51 @@ int DumpPHG4CellContainer::process_Node(PHNode *myNode)
   {
     PHG4CellContainer::ConstIterator celler;
     PHG4CellContainer::ConstRange cell_begin_end = phg4cellcontainer->getCells();
+    if (bout)
+    {
+      // the bins are encoded in the cell id
+      bout->UInt("size", phg4cellcontainer->size());
+      for (celler = cell_begin_end.first; celler != cell_begin_end.second; ++celler)
+      {
+        PHG4Cell *cell = celler->second;
+        bout->Key("cell", cell->get_cellid());
+        for (unsigned char ic = 0; ic < UCHAR_MAX; ic++)
+        {
+          PHG4Cell::PROPERTY prop_id = static_cast<PHG4Cell::PROPERTY>(ic);
+          if (cell->has_property(prop_id))
+          {
+            pair<const string, PHG4Cell::PROPERTY_TYPE> property_info = PHG4Cell::get_property_info(prop_id);
+            switch (property_info.second)
+            {
+            case PHG4Cell::type_int:
+              bout->Int(property_info.first.c_str(), cell->get_property_int(prop_id));
+              break;
+            case PHG4Cell::type_uint:
+              bout->UInt(property_info.first.c_str(), cell->get_property_uint(prop_id));
+              break;
+            case PHG4Cell::type_float:
+              bout->Float(property_info.first.c_str(), cell->get_property_float(prop_id));
+              break;
+            default:
+              break;
+            }
+          }
+        }
+        PHG4Cell::EdepConstRange hitedep_begin_end = cell->get_g4hits();
+        for (PHG4Cell::EdepConstIterator iter = hitedep_begin_end.first; iter != hitedep_begin_end.second; ++iter)
+        {
+          bout->UInt("hit", iter->first);
+          bout->Float("hit edep", iter->second);
+        }
+        PHG4Cell::ShowerEdepConstRange shower_begin_end = cell->get_g4showers();
+        for (PHG4Cell::ShowerEdepConstIterator iter = shower_begin_end.first; iter != shower_begin_end.second; ++iter)
+        {
+          bout->Int("shower", iter->first);
+          bout->Float("shower edep", iter->second);
+        }
+      }
+      return 0;
+    }
     *fout << "size: " << phg4cellcontainer->size() << endl;
     for (celler = cell_begin_end.first; celler != cell_begin_end.second; celler++)
     {
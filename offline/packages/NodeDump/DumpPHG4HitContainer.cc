@@ -1,4 +1,5 @@
 #include "DumpPHG4HitContainer.h"
+#include "DumpRecord.h"
 
 #include <phool/PHIODataNode.h>
 
@@ -33,6 +34,49 @@ int DumpPHG4HitContainer::process_Node(PHNode *myNode)
   {
     PHG4HitContainer::ConstIterator hiter;
     PHG4HitContainer::ConstRange hit_begin_end = phg4hitcontainer->getHits();
+    if (bout)
+    {
+      bout->UInt("size", phg4hitcontainer->size());
+      bout->UInt("num layers", phg4hitcontainer->num_layers());
+      for (hiter = hit_begin_end.first; hiter != hit_begin_end.second; ++hiter)
+      {
+        PHG4Hit *hit = hiter->second;
+        bout->Key("hit", hit->get_hit_id());
+        bout->Int("detid", hit->get_detid());
+        bout->Int("trkid", hit->get_trkid());
+        bout->Float("edep", hit->get_edep());
+        for (int i = 0; i < 2; i++)
+        {
+          bout->Float("x", hit->get_x(i));
+          bout->Float("y", hit->get_y(i));
+          bout->Float("z", hit->get_z(i));
+          bout->Float("t", hit->get_t(i));
+        }
+        for (unsigned char ic = 0; ic < UCHAR_MAX; ic++)
+        {
+          PHG4Hit::PROPERTY prop_id = static_cast<PHG4Hit::PROPERTY>(ic);
+          if (hit->has_property(prop_id))
+          {
+            pair<const string, PHG4Hit::PROPERTY_TYPE> property_info = PHG4Hit::get_property_info(prop_id);
+            switch (property_info.second)
+            {
+            case PHG4Hit::type_int:
+              bout->Int(property_info.first.c_str(), hit->get_property_int(prop_id));
+              break;
+            case PHG4Hit::type_uint:
+              bout->UInt(property_info.first.c_str(), hit->get_property_uint(prop_id));
+              break;
+            case PHG4Hit::type_float:
+              bout->Float(property_info.first.c_str(), hit->get_property_float(prop_id));
+              break;
+            default:
+              break;
+            }
+          }
+        }
+      }
+      return 0;
+    }
     *fout << "size: " << phg4hitcontainer->size() << endl;
     *fout << "num layers: " << phg4hitcontainer->num_layers() << endl;
     for (hiter = hit_begin_end.first; hiter != hit_begin_end.second; hiter++)
@@ -1,4 +1,5 @@
 #include "DumpRawTowerContainer.h"
+#include "DumpRecord.h"
 
 #include <phool/PHIODataNode.h>
 
@@ -32,6 +33,31 @@ int DumpRawTowerContainer::process_Node(PHNode *myNode)
   {
     RawTowerContainer::ConstIterator hiter;
     RawTowerContainer::ConstRange begin_end = rawtowercontainer->getTowers();
+    if (bout)
+    {
+      bout->UInt("size", rawtowercontainer->size());
+      for (hiter = begin_end.first; hiter != begin_end.second; ++hiter)
+      {
+        RawTower *rawtwr = hiter->second;
+        bout->Key("tower", hiter->first);
+        bout->Int("bineta", rawtwr->get_bineta());
+        bout->Int("binphi", rawtwr->get_binphi());
+        bout->Double("energy", rawtwr->get_energy());
+        RawTower::CellConstRange cbegin_end = rawtwr->get_g4cells();
+        for (RawTower::CellConstIterator iter = cbegin_end.first; iter != cbegin_end.second; ++iter)
+        {
+          bout->UInt("cell key", iter->first);
+          bout->Float("cell edep", iter->second);
+        }
+        RawTower::ShowerConstRange sbegin_end = rawtwr->get_g4showers();
+        for (RawTower::ShowerConstIterator iter = sbegin_end.first; iter != sbegin_end.second; ++iter)
+        {
+          bout->Int("shower id", iter->first);
+          bout->Float("shower edep", iter->second);
+        }
+      }
+      return 0;
+    }
     *fout << "size: " << rawtowercontainer->size() << endl;
     for (hiter = begin_end.first; hiter != begin_end.second; ++hiter)
     {
@@ -0,0 +1,338 @@
+#include "DumpRecord.h"
+
+#include <phool/phool.h>
+
+#include <cstring>
+#include <iostream>
+
+using namespace std;
+
+namespace
+{
+  const uint64_t fnv_offset = 14695981039346656037ULL;
+  const uint64_t fnv_prime = 1099511628211ULL;
+
+  uint64_t DecodeLE(const char *data, const size_t nbytes)
+  {
+    uint64_t value = 0;
+    for (size_t i = 0; i < nbytes; ++i)
+    {
+      value |= static_cast<uint64_t>(static_cast<unsigned char>(data[i])) << (8 * i);
+    }
+    return value;
+  }
+}  // namespace
+
+DumpRecordWriter::DumpRecordWriter(const string &fname)
+  : m_Out(fname.c_str(), ios::binary | ios::trunc)
+  , m_EventHash(fnv_offset)
+  , m_FileHash(fnv_offset)
+  , m_NEvents(0)
+{
+  if (!m_Out)
+  {
+    cout << PHWHERE << " could not open " << fname << endl;
+    return;
+  }
+  m_Out.write(DumpRecord::magic, sizeof(DumpRecord::magic));
+}
+
+DumpRecordWriter::~DumpRecordWriter()
+{
+  if (!m_Out)
+  {
+    return;
+  }
+  string end;
+  end.push_back(DumpRecord::kEnd);
+  Put(end, m_NEvents, 4);
+  Put(end, m_FileHash, 8);
+  m_Out.write(end.data(), end.size());
+}
+
+void DumpRecordWriter::BeginEvent()
+{
+  m_Payload.clear();
+  m_NewNames.clear();
+  m_EventHash = fnv_offset;
+}
+
+void DumpRecordWriter::EndEvent(const int run, const int evtseq)
+{
+  string header;
+  header.push_back(DumpRecord::kEvent);
+  Put(header, static_cast<uint32_t>(run), 4);
+  Put(header, static_cast<uint32_t>(evtseq), 4);
+  Put(header, m_EventHash, 8);
+  Put(header, m_Payload.size(), 4);
+  m_Out.write(m_NewNames.data(), m_NewNames.size());
+  m_Out.write(header.data(), header.size());
+  m_Out.write(m_Payload.data(), m_Payload.size());
+
+  // the file hash depends on the event hashes only
+  for (int i = 0; i < 8; ++i)
+  {
+    m_FileHash = (m_FileHash ^ ((m_EventHash >> (8 * i)) & 0xFF)) * fnv_prime;
+  }
+  ++m_NEvents;
+}
+
+void DumpRecordWriter::Key(const char *name, const uint64_t value)
+{
+  BeginField(DumpRecord::kKey, name);
+  Put(m_Payload, value, 8);
+  HashValue(value, 8);
+}
+
+void DumpRecordWriter::Int(const char *name, const int64_t value)
+{
+  BeginField(DumpRecord::kInt, name);
+  Put(m_Payload, static_cast<uint64_t>(value), 8);
+  HashValue(static_cast<uint64_t>(value), 8);
+}
+
+void DumpRecordWriter::UInt(const char *name, const uint64_t value)
+{
+  BeginField(DumpRecord::kUInt, name);
+  Put(m_Payload, value, 8);
+  HashValue(value, 8);
+}
+
+void DumpRecordWriter::Float(const char *name, const float value)
+{
+  uint32_t bits;
+  memcpy(&bits, &value, sizeof(bits));
+  BeginField(DumpRecord::kFloat, name);
+  Put(m_Payload, bits, 4);
+  HashValue(bits, 4);
+}
+
+void DumpRecordWriter::Double(const char *name, const double value)
+{
+  uint64_t bits;
+  memcpy(&bits, &value, sizeof(bits));
+  BeginField(DumpRecord::kDouble, name);
+  Put(m_Payload, bits, 8);
+  HashValue(bits, 8);
+}
+
+void DumpRecordWriter::String(const char *name, const string &value)
+{
+  BeginField(DumpRecord::kString, name);
+  Put(m_Payload, value.size(), 4);
+  m_Payload.append(value);
+  HashValue(value.size(), 4);
+  Hash(value.data(), value.size());
+}
+
+void DumpRecordWriter::BeginField(const DumpRecord::FieldType type, const char *name)
+{
+  uint16_t id;
+  auto iter = m_NameIds.find(name);
+  if (iter != m_NameIds.end())
+  {
+    id = iter->second;
+  }
+  else
+  {
+    id = m_NameIds.size();
+    m_NameIds[name] = id;
+    const size_t length = strlen(name);
+    m_NewNames.push_back(DumpRecord::kName);
+    Put(m_NewNames, id, 2);
+    Put(m_NewNames, length, 2);
+    m_NewNames.append(name, length);
+  }
+  m_Payload.push_back(type);
+  Put(m_Payload, id, 2);
+
+  const char t = type;
+  Hash(&t, 1);
+  // including the terminating 0
+  Hash(name, strlen(name) + 1);
+}
+
+void DumpRecordWriter::Put(string &buf, const uint64_t value, const size_t nbytes)
+{
+  for (size_t i = 0; i < nbytes; ++i)
+  {
+    buf.push_back(static_cast<char>((value >> (8 * i)) & 0xFF));
+  }
+}
+
+void DumpRecordWriter::Hash(const void *data, const size_t nbytes)
+{
+  const unsigned char *bytes = static_cast<const unsigned char *>(data);
+  for (size_t i = 0; i < nbytes; ++i)
+  {
+    m_EventHash = (m_EventHash ^ bytes[i]) * fnv_prime;
+  }
+}
+
+void DumpRecordWriter::HashValue(const uint64_t value, const size_t nbytes)
+{
+  for (size_t i = 0; i < nbytes; ++i)
+  {
+    m_EventHash = (m_EventHash ^ ((value >> (8 * i)) & 0xFF)) * fnv_prime;
+  }
+}
+
+DumpRecordReader::DumpRecordReader(const string &fname)
+  : m_In(fname.c_str(), ios::binary)
+  , m_Valid(false)
+  , m_Run(-9999)
+  , m_EvtSequence(-9999)
+  , m_Hash(0)
+{
+  char magic[sizeof(DumpRecord::magic)];
+  if (m_In.read(magic, sizeof(magic)) && !memcmp(magic, DumpRecord::magic, sizeof(magic)))
+  {
+    m_Valid = true;
+  }
+}
+
+bool DumpRecordReader::Get(uint64_t &value, const size_t nbytes)
+{
+  char buf[8];
+  if (!m_In.read(buf, nbytes))
+  {
+    return false;
+  }
+  value = DecodeLE(buf, nbytes);
+  return true;
+}
+
+bool DumpRecordReader::NextEvent()
+{
+  if (!m_Valid)
+  {
+    return false;
+  }
+  char type;
+  while (m_In.get(type))
+  {
+    uint64_t value;
+    if (type == DumpRecord::kName)
+    {
+      uint64_t id;
+      uint64_t length;
+      if (!Get(id, 2) || !Get(length, 2))
+      {
+        break;
+      }
+      string name(length, ' ');
+      if (!m_In.read(&name[0], length))
+      {
+        break;
+      }
+      if (id >= m_Names.size())
+      {
+        m_Names.resize(id + 1);
+      }
+      m_Names[id] = name;
+    }
+    else if (type == DumpRecord::kEvent)
+    {
+      uint64_t size;
+      if (!Get(value, 4))
+      {
+        break;
+      }
+      m_Run = static_cast<int32_t>(value);
+      if (!Get(value, 4))
+      {
+        break;
+      }
+      m_EvtSequence = static_cast<int32_t>(value);
+      if (!Get(m_Hash, 8) || !Get(size, 4))
+      {
+        break;
+      }
+      m_Payload.resize(size);
+      if (size && !m_In.read(&m_Payload[0], size))
+      {
+        break;
+      }
+      return true;
+    }
+    else
+    {
+      // end record or garbage
+      return false;
+    }
+  }
+  cout << PHWHERE << " truncated binary dump" << endl;
+  m_Valid = false;
+  return false;
+}
+
+bool DumpRecordReader::Decode(vector<DumpRecord::Field> &fields) const
+{
+  fields.clear();
+  const char *data = m_Payload.data();
+  const size_t size = m_Payload.size();
+  size_t pos = 0;
+  while (pos < size)
+  {
+    if (pos + 3 > size)
+    {
+      return false;
+    }
+    DumpRecord::Field field;
+    field.type = data[pos];
+    const uint64_t id = DecodeLE(data + pos + 1, 2);
+    pos += 3;
+    if (id >= m_Names.size())
+    {
+      return false;
+    }
+    field.name = &m_Names[id];
+    field.ivalue = 0;
+    field.uvalue = 0;
+    field.dvalue = 0;
+    size_t nbytes = 8;
+    if (field.type == DumpRecord::kFloat || field.type == DumpRecord::kString)
+    {
+      nbytes = 4;
+    }
+    if (pos + nbytes > size)
+    {
+      return false;
+    }
+    const uint64_t value = DecodeLE(data + pos, nbytes);
+    pos += nbytes;
+    switch (field.type)
+    {
+    case DumpRecord::kKey:
+    case DumpRecord::kUInt:
+      field.uvalue = value;
+      break;
+    case DumpRecord::kInt:
+      field.ivalue = static_cast<int64_t>(value);
+      break;
+    case DumpRecord::kFloat:
+    {
+      const uint32_t bits = value;
+      float f;
+      memcpy(&f, &bits, sizeof(f));
+      field.dvalue = f;
+      break;
+    }
+    case DumpRecord::kDouble:
+      memcpy(&field.dvalue, &value, sizeof(field.dvalue));
+      break;
+    case DumpRecord::kString:
+      if (pos + value > size)
+      {
+        return false;
+      }
+      field.svalue.assign(data + pos, value);
+      pos += value;
+      break;
+    default:
+      return false;
+    }
+    fields.push_back(field);
+  }
+  return true;
+}
@@ -0,0 +1,130 @@
+#ifndef NODEDUMP_DUMPRECORD_H
+#define NODEDUMP_DUMPRECORD_H
+
+#include <cstddef>
+#include <cstdint>
+#include <fstream>
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+/**
+ * Binary node dump (OutDir/<node>.bin), written instead of the .list text
+ * file with PHNodeDump::SetBinary(). All numbers are little endian.
+ *
+ *   file:    magic "PHNDUMP1", then name, event and end records
+ *   name:    'N', id (u16), length (u16), chars
+ *   event:   'E', run (i32), event sequence (i32), hash (u64),
+ *            payload size (u32), payload
+ *   end:     'T', number of events (u32), hash of the event hashes (u64)
+ *   payload: fields of type (u8), name id (u16), value
+ *            'k' object key (u64), starts an object (hit, tower, track...)
+ *            'i' i64, 'u' u64, 'f' float, 'd' double
+ *            's' string (u32 length, chars), used for the text lines of
+ *                dumpers without binary output
+ *
+ * A name is defined once per file before the first event using it. The
+ * event hash (64 bit FNV-1a) covers the names, types and values of the
+ * fields but not the name ids, two dumps of identical events have the same
+ * hash and only events with different hashes need to be decoded.
+ */
+namespace DumpRecord
+{
+  static const char magic[8] = {'P', 'H', 'N', 'D', 'U', 'M', 'P', '1'};
+
+  enum RecordType
+  {
+    kName = 'N',
+    kEvent = 'E',
+    kEnd = 'T'
+  };
+
+  enum FieldType
+  {
+    kKey = 'k',
+    kInt = 'i',
+    kUInt = 'u',
+    kFloat = 'f',
+    kDouble = 'd',
+    kString = 's'
+  };
+
+  //! decoded payload field, floats are stored in dvalue
+  struct Field
+  {
+    char type;
+    const std::string *name;
+    int64_t ivalue;
+    uint64_t uvalue;
+    double dvalue;
+    std::string svalue;
+  };
+}  // namespace DumpRecord
+
+class DumpRecordWriter
+{
+ public:
+  DumpRecordWriter(const std::string &fname);
+  //! writes the end record
+  ~DumpRecordWriter();
+
+  bool IsOpen() const { return m_Out.good(); }
+
+  void BeginEvent();
+  void EndEvent(const int run, const int evtseq);
+
+  void Key(const char *name, const uint64_t value);
+  void Int(const char *name, const int64_t value);
+  void UInt(const char *name, const uint64_t value);
+  void Float(const char *name, const float value);
+  void Double(const char *name, const double value);
+  void String(const char *name, const std::string &value);
+
+ private:
+  //! appends type and name id of a field and hashes type and name
+  void BeginField(const DumpRecord::FieldType type, const char *name);
+  void Put(std::string &buf, const uint64_t value, const size_t nbytes);
+  void Hash(const void *data, const size_t nbytes);
+  void HashValue(const uint64_t value, const size_t nbytes);
+
+  std::ofstream m_Out;
+  std::string m_Payload;
+  uint64_t m_EventHash;
+  uint64_t m_FileHash;
+  uint32_t m_NEvents;
+  std::unordered_map<std::string, uint16_t> m_NameIds;
+  //! names first used in the current event, written before it
+  std::string m_NewNames;
+};
+
+class DumpRecordReader
+{
+ public:
+  DumpRecordReader(const std::string &fname);
+
+  //! false if the file could not be opened or is no binary dump
+  bool IsOpen() const { return m_Valid; }
+
+  //! reads the next event, false at the end of the file
+  bool NextEvent();
+
+  int Run() const { return m_Run; }
+  int EvtSequence() const { return m_EvtSequence; }
+  uint64_t Hash() const { return m_Hash; }
+
+  //! decodes the payload of the current event, false if it is corrupt
+  bool Decode(std::vector<DumpRecord::Field> &fields) const;
+
+ private:
+  bool Get(uint64_t &value, const size_t nbytes);
+
+  std::ifstream m_In;
+  bool m_Valid;
+  int m_Run;
+  int m_EvtSequence;
+  uint64_t m_Hash;
+  std::string m_Payload;
+  std::vector<std::string> m_Names;
+};
+
+#endif
@@ -1,4 +1,5 @@
 #include "DumpSvtxTrackMap.h"
+#include "DumpRecord.h"
 
 #include <phool/PHIODataNode.h>
 
@@ -31,6 +32,29 @@ int DumpSvtxTrackMap::process_Node(PHNode *myNode)
   if (svtxtrackmap)
   {
     SvtxTrackMap::ConstIter hiter;
+    if (bout)
+    {
+      bout->UInt("size", svtxtrackmap->size());
+      for (hiter = svtxtrackmap->begin(); hiter != svtxtrackmap->end(); ++hiter)
+      {
+        SvtxTrack *track = hiter->second;
+        bout->Key("track", track->get_id());
+        bout->Int("positive_charge", track->get_positive_charge());
+        bout->Int("charge", track->get_charge());
+        bout->Float("chisq", track->get_chisq());
+        bout->UInt("ndf", track->get_ndf());
+        bout->Float("dca", track->get_dca());
+        bout->Float("dca2d", track->get_dca2d());
+        bout->Float("dca2d_error", track->get_dca2d_error());
+        bout->Float("x", track->get_x());
+        bout->Float("y", track->get_y());
+        bout->Float("z", track->get_z());
+        bout->Float("px", track->get_px());
+        bout->Float("py", track->get_py());
+        bout->Float("pz", track->get_pz());
+      }
+      return 0;
+    }
     *fout << "size: " << svtxtrackmap->size() << endl;
     for (hiter = svtxtrackmap->begin(); hiter != svtxtrackmap->end(); hiter++)
     {
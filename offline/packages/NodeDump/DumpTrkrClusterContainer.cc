@@ -1,4 +1,5 @@
 #include "DumpTrkrClusterContainer.h"
+#include "DumpRecord.h"
 
 #include <phool/PHIODataNode.h>
 
@@ -32,6 +33,24 @@ int DumpTrkrClusterContainer::process_Node(PHNode *myNode)
   {
     TrkrClusterContainer::ConstIterator hiter;
     TrkrClusterContainer::ConstRange begin_end = trkrclustercontainer->getClusters();
+    if (bout)
+    {
+      bout->UInt("size", trkrclustercontainer->size());
+      for (hiter = begin_end.first; hiter != begin_end.second; ++hiter)
+      {
+        TrkrCluster *trkrcluster = hiter->second;
+        bout->Key("cluster", hiter->first);
+        bout->Float("x", trkrcluster->getX());
+        bout->Float("y", trkrcluster->getY());
+        bout->Float("z", trkrcluster->getZ());
+        bout->UInt("adc", trkrcluster->getAdc());
+        bout->Float("phisize", trkrcluster->getPhiSize());
+        bout->Float("phierror", trkrcluster->getPhiError());
+        bout->Float("rphierror", trkrcluster->getRPhiError());
+        bout->Float("zerror", trkrcluster->getZError());
+      }
+      return 0;
+    }
     *fout << "size: " << trkrclustercontainer->size() << endl;
     for (hiter = begin_end.first; hiter != begin_end.second; ++hiter)
     {
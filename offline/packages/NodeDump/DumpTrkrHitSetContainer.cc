@@ -1,4 +1,5 @@
 #include "DumpTrkrHitSetContainer.h"
+#include "DumpRecord.h"
 
 #include <phool/PHIODataNode.h>
 
@@ -33,6 +34,22 @@ int DumpTrkrHitSetContainer::process_Node(PHNode *myNode)
   {
     TrkrHitSetContainer::ConstIterator hiter;
     TrkrHitSetContainer::ConstRange begin_end = trkrhitsetcontainer->getHitSets();
+    if (bout)
+    {
+      bout->UInt("size", trkrhitsetcontainer->size());
+      for (hiter = begin_end.first; hiter != begin_end.second; ++hiter)
+      {
+        bout->Key("hitset", hiter->first);
+        TrkrHitSet::ConstRange trset_begin_end = hiter->second->getHits();
+        for (TrkrHitSet::ConstIterator tsetiter = trset_begin_end.first; tsetiter != trset_begin_end.second; ++tsetiter)
+        {
+          bout->Key("hit", tsetiter->first);
+          bout->Double("edep", tsetiter->second->getEnergy());
+          bout->UInt("adc", tsetiter->second->getAdc());
+        }
+      }
+      return 0;
+    }
     *fout << "size: " << trkrhitsetcontainer->size() << endl;
     for (hiter = begin_end.first; hiter != begin_end.second; ++hiter)
     {
@@ -33,6 +33,7 @@ int Dumper::process_event(PHCompositeNode *topNode)
   {
     iter.cd("DST");
     iter.forEach(*nodedump);
+    nodedump->DumpPending();
     iter.cd();
   }
   return 0;
@@ -50,6 +51,7 @@ int Dumper::End(PHCompositeNode *topNode)
     if (nodeiter.cd(*iter))
     {
       nodeiter.forEach(*nodedump);
+      nodedump->DumpPending();
       nodeiter.cd();
     }
   }
@@ -69,6 +71,18 @@ void Dumper::SetPrecision(const int digits)
   return;
 }
 
+void Dumper::SetBinary(const bool b)
+{
+  nodedump->SetBinary(b);
+  return;
+}
+
+void Dumper::SetNThreads(const unsigned int n)
+{
+  nodedump->SetNThreads(n);
+  return;
+}
+
 int Dumper::AddIgnore(const string &name)
 {
   return nodedump->AddIgnore(name);
@@ -17,6 +17,10 @@ class Dumper : public SubsysReco
   int process_event(PHCompositeNode *topNode);
   void SetOutDir(const std::string &outdir);
   void SetPrecision(const int digits);
+  //! binary dumps (<node>.bin) for DumpCompare instead of text
+  void SetBinary(const bool b);
+  //! dump the nodes of an event in n threads
+  void SetNThreads(const unsigned int n);
   int AddIgnore(const std::string &name);
   int Select(const std::string &name);
 
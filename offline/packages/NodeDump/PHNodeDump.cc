@@ -37,10 +37,15 @@
 #include <ffaobjects/RunHeader.h>
 
 #include <TObject.h>
+#include <TROOT.h>
 
+#include <algorithm>
+#include <atomic>
 #include <iostream>
 #include <string>
+#include <thread>
 #include <utility>
+#include <vector>
 
 using namespace std;
 
@@ -49,6 +54,8 @@ PHNodeDump::PHNodeDump()
   , evtsequence(-9999)
   , fp_precision(-1)
   , outdir("./")
+  , binary(false)
+  , nthreads(1)
 {
 }
 
@@ -114,7 +121,17 @@ void PHNodeDump::perform(PHNode *node)
 
     if (iter != dumpthis.end())
     {
-      iter->second->process_event(node);
+      // lazily loaded input nodes are read here, the dump threads only
+      // access objects in memory
+      node->loadDeferred();
+      if (nthreads > 1)
+      {
+        pending[iter->second].push_back(node);
+      }
+      else
+      {
+        iter->second->process_event(node);
+      }
     }
     else
     {
@@ -130,6 +147,44 @@ void PHNodeDump::perform(PHNode *node)
   return;
 }
 
+int PHNodeDump::DumpPending()
+{
+  if (pending.empty())
+  {
+    return 0;
+  }
+  // every dump object writes its own file, a node appearing more than
+  // once is dumped in order by the same thread
+  vector<pair<DumpObject *, vector<PHNode *> > > jobs(pending.begin(), pending.end());
+  pending.clear();
+  atomic<size_t> next(0);
+  auto work = [&jobs, &next]() {
+    for (size_t i = next++; i < jobs.size(); i = next++)
+    {
+      for (auto node : jobs[i].second)
+      {
+        jobs[i].first->process_event(node);
+      }
+    }
+  };
+  const size_t nworkers = min<size_t>(nthreads, jobs.size()) - 1;
+  if (nworkers > 0)
+  {
+    ROOT::EnableThreadSafety();
+  }
+  vector<thread> workers;
+  for (size_t i = 0; i < nworkers; ++i)
+  {
+    workers.push_back(thread(work));
+  }
+  work();
+  for (auto &worker : workers)
+  {
+    worker.join();
+  }
+  return 0;
+}
+
 int PHNodeDump::CloseOutputFiles()
 {
   map<string, DumpObject *>::iterator iter;
@@ -292,6 +347,7 @@ initdump:
   newdump->SetParentNodeDump(this);
   newdump->SetOutDir(outdir);
   newdump->SetPrecision(fp_precision);
+  newdump->SetBinary(binary);
   newdump->Init();
   dumpthis[newnode] = newdump;
   return 0;
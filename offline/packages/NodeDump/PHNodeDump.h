@@ -6,6 +6,7 @@
 #include <map>
 #include <set>
 #include <string>
+#include <vector>
 
 class PHNode;
 class DumpObject;
@@ -26,6 +27,12 @@ class PHNodeDump : public PHNodeOperation
   int Select(const std::string &name);
   int SetOutDir(const std::string &dirname);
   void SetPrecision(const int digits) { fp_precision = digits; }
+  //! binary dumps with per event hashes instead of text, see DumpCompare
+  void SetBinary(const bool b) { binary = b; }
+  //! nodes are dumped by n threads in DumpPending()
+  void SetNThreads(const unsigned int n) { nthreads = n; }
+  //! dumps the nodes collected by forEach if running multithreaded
+  int DumpPending();
 
  protected:
   virtual void perform(PHNode *);
@@ -33,10 +40,14 @@ class PHNodeDump : public PHNodeOperation
   std::map<std::string, DumpObject *> dumpthis;
   std::set<std::string> ignore;
   std::set<std::string> exclusive;
+  //! nodes of the current forEach for each dump object
+  std::map<DumpObject *, std::vector<PHNode *> > pending;
   int runnumber;
   int evtsequence;
   int fp_precision;
   std::string outdir;
+  bool binary;
+  unsigned int nthreads;
 };
 
 #endif
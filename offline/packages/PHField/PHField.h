@@ -21,6 +21,20 @@ class PHField
       const double Point[4],
       double *Bfield) const = 0;
 
+  //! access field values of n points at once
+  //! @param[in]  Point   n space time coordinates, x0, y0, z0, t0, x1, y1, ... in Geant4/CLHEP units
+  //! @param[out] Bfield  n field values, Bx0, By0, Bz0, Bx1, ... in Geant4/CLHEP units
+  virtual void GetFieldValues(
+      const double *Point,
+      double *Bfield,
+      const unsigned int n) const
+  {
+    for (unsigned int i = 0; i < n; i++)
+    {
+      GetFieldValue(Point + 4 * i, Bfield + 3 * i);
+    }
+  }
+
   void Verbosity(const int i) { m_Verbosity = i; }
   int Verbosity() const { return m_Verbosity; }
 
@@ -8,25 +8,95 @@
 
 #include <boost/tuple/tuple_comparison.hpp>
 
+#include <phool/phool.h>  // for PHWHERE
+
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
 #include <algorithm>
 #include <cassert>
 #include <cmath>
+#include <cstdint>
+#include <cstdio>  // for rename
 #include <cstdlib>
+#include <cstring>
+#include <fstream>
+#include <functional>
 #include <iostream>
 #include <iterator>
 #include <set>
+#include <sstream>
 #include <utility>
 
 using namespace std;
 
-PHField3DCylindrical::PHField3DCylindrical(const string &filename, const int verb, const float magfield_rescale)
+namespace
+{
+  //! header of the binary field map, followed by the z, r and phi grid
+  //! points and the nz x nr x nphi x (bz, br, bphi) field values as floats
+  struct BinaryMapHeader
+  {
+    char magic[8];
+    uint32_t version;
+    uint32_t nz;
+    uint32_t nr;
+    uint32_t nphi;
+  };
+  const char binary_magic[8] = {'P', 'H', 'F', '3', 'D', 'C', 'Y', 'L'};
+  const uint32_t binary_version = 1;
+}  // namespace
+
+PHField3DCylindrical::PHField3DCylindrical(const string &filename, const int verb, const float magfield_rescale, const MapFormat format)
   : PHField(verb)
+  , field_data_(nullptr)
+  , mapped_(nullptr)
+  , mapped_size_(0)
+  , field_scale_(1.)
+  , maxz_(0)
+  , minz_(0)
 {
   cout << "\n================ Begin Construct Mag Field =====================" << endl;
   cout << "\n-----------------------------------------------------------"
        << "\n      Magnetic field Module - Verbosity:" << Verbosity()
        << "\n-----------------------------------------------------------";
 
+  if (format == kBinary)
+  {
+    ReadBinary(filename, magfield_rescale);
+  }
+  else if (format == kRootNtupleShared)
+  {
+    ReadShared(filename, magfield_rescale);
+  }
+  else
+  {
+    ReadRootNtuple(filename, magfield_rescale);
+  }
+
+  cout << "\n ---> ... read file successfully "
+       << "\n ---> Z Boundaries ~ zlow, zhigh: "
+       << minz_ / cm << "," << maxz_ / cm << " cm " << endl;
+  if (Verbosity() > 0)
+  {
+    cout << " ---> uniform grid in z, r, phi: " << z_.uniform << ", " << r_.uniform << ", " << phi_.uniform << endl;
+  }
+
+  cout << "\n================= End Construct Mag Field ======================\n"
+       << endl;
+}
+
+PHField3DCylindrical::~PHField3DCylindrical()
+{
+  if (mapped_)
+  {
+    munmap(mapped_, mapped_size_);
+  }
+}
+
+void PHField3DCylindrical::ReadRootNtuple(const string &filename, const float magfield_rescale)
+{
   // open file
   TFile *rootinput = TFile::Open(filename.c_str());
   if (!rootinput)
@@ -130,18 +200,15 @@ PHField3DCylindrical::PHField3DCylindrical(const string &filename, const int ver
   nz = z_set.size();
   nr = r_set.size();
   nphi = phi_set.size();
-  r_map_.resize(nr, 0);
-  z_map_.resize(nz, 0);
-  phi_map_.resize(nphi, 0);
+  r_.map.assign(r_set.begin(), r_set.end());
+  z_.map.assign(z_set.begin(), z_set.end());
+  phi_.map.assign(phi_set.begin(), phi_set.end());
+  r_.init();
+  z_.init();
+  phi_.init();
 
-  std::copy(z_set.begin(), z_set.end(), z_map_.begin());
-  std::copy(phi_set.begin(), phi_set.end(), phi_map_.begin());
-  std::copy(r_set.begin(), r_set.end(), r_map_.begin());
-
-  // initialize the field map vectors to the correct sizes
-  BFieldR_.resize(nz, vector<vector<float> >(nr, vector<float>(nphi, 0)));
-  BFieldPHI_.resize(nz, vector<vector<float> >(nr, vector<float>(nphi, 0)));
-  BFieldZ_.resize(nz, vector<vector<float> >(nr, vector<float>(nphi, 0)));
+  // initialize the field map vector to the correct size
+  BField_.assign(nz * nr * nphi * 3, 0);
 
   // all of this assumes that  z_prev < z , i.e. the table is ordered (as of right now)
   unsigned int ir = 0, iphi = 0, iz = 0;  // useful indexes to keep track of
@@ -160,31 +227,32 @@ PHField3DCylindrical::PHField3DCylindrical(const string &filename, const int ver
     if (z < minz_) minz_ = z;
 
     // check for change in z value, when z changes we have a ton of updates to do
-    if (z != z_map_[iz])
+    if (z != z_.map[iz])
     {
       ++iz;
       ir = 0;
       iphi = 0;  // reset indices
     }
-    else if (r != r_map_[ir])
+    else if (r != r_.map[ir])
     {  // check for change in r value
       ++ir;
       iphi = 0;
     }
-    else if (phi != phi_map_[iphi])
+    else if (phi != phi_.map[iphi])
     {  // change in phi value? (should be every time)
       ++iphi;
     }
 
     // shouldn't happen
-    if (iz > 0 && z < z_map_[iz - 1])
+    if (iz > 0 && z < z_.map[iz - 1])
     {
-      cout << "!!!!!!!!! Your map isn't ordered.... z: " << z << " zprev: " << z_map_[iz - 1] << endl;
+      cout << "!!!!!!!!! Your map isn't ordered.... z: " << z << " zprev: " << z_.map[iz - 1] << endl;
     }
 
-    BFieldR_[iz][ir][iphi] = Br * magfield_rescale;
-    BFieldPHI_[iz][ir][iphi] = Bphi * magfield_rescale;
-    BFieldZ_[iz][ir][iphi] = Bz * magfield_rescale;
+    float *bfield = &BField_[((iz * nr + ir) * nphi + iphi) * 3];
+    bfield[0] = Bz * magfield_rescale;
+    bfield[1] = Br * magfield_rescale;
+    bfield[2] = Bphi * magfield_rescale;
 
     // you can change this to check table values for correctness
     // print_map prints the values in the root table, and the
@@ -194,30 +262,235 @@ PHField3DCylindrical::PHField3DCylindrical(const string &filename, const int ver
       print_map(iter);
 
       cout << " B("
-           << r_map_[ir] << ", "
-           << phi_map_[iphi] << ", "
-           << z_map_[iz] << "):  ("
-           << BFieldR_[iz][ir][iphi] << ", "
-           << BFieldPHI_[iz][ir][iphi] << ", "
-           << BFieldZ_[iz][ir][iphi] << ")" << endl;
+           << r_.map[ir] << ", "
+           << phi_.map[iphi] << ", "
+           << z_.map[iz] << "):  ("
+           << bfield[1] << ", "
+           << bfield[2] << ", "
+           << bfield[0] << ")" << endl;
     }
 
   }  // end loop over root field map file
 
   rootinput->Close();
+  field_data_ = BField_.data();
+}
 
-  cout << "\n ---> ... read file successfully "
-       << "\n ---> Z Boundaries ~ zlow, zhigh: "
-       << minz_ / cm << "," << maxz_ / cm << " cm " << endl;
+void PHField3DCylindrical::ReadBinary(const string &filename, const float magfield_rescale)
+{
+  cout << "\n ---> "
+          "Mapping the binary field grid from "
+       << filename << " ... " << endl;
+  int fd = open(filename.c_str(), O_RDONLY);
+  if (fd < 0)
+  {
+    cout << "\n could not open " << filename << " exiting now" << endl;
+    exit(1);
+  }
+  struct stat filestat;
+  if (fstat(fd, &filestat) != 0 || filestat.st_size < (off_t) sizeof(BinaryMapHeader))
+  {
+    cout << "\n " << filename << " is too short for a binary field map, exiting now" << endl;
+    exit(1);
+  }
+  mapped_size_ = filestat.st_size;
+  // read only shared mapping, the pages are shared with every process using the same map
+  mapped_ = mmap(nullptr, mapped_size_, PROT_READ, MAP_SHARED, fd, 0);
+  close(fd);
+  if (mapped_ == MAP_FAILED)
+  {
+    cout << "\n could not mmap " << filename << " exiting now" << endl;
+    exit(1);
+  }
 
-  cout << "\n================= End Construct Mag Field ======================\n"
-       << endl;
+  const BinaryMapHeader *header = static_cast<const BinaryMapHeader *>(mapped_);
+  if (memcmp(header->magic, binary_magic, sizeof(binary_magic)) != 0 || header->version != binary_version)
+  {
+    cout << "\n " << filename << " is not a binary field map (version " << binary_version << "), exiting now" << endl;
+    exit(1);
+  }
+  const size_t nz = header->nz;
+  const size_t nr = header->nr;
+  const size_t nphi = header->nphi;
+  const size_t expected_size = sizeof(BinaryMapHeader) + (nz + nr + nphi + nz * nr * nphi * 3) * sizeof(float);
+  if (nz < 2 || nr < 2 || nphi < 1 || mapped_size_ != expected_size)
+  {
+    cout << "\n " << filename << " has size " << mapped_size_ << ", expected " << expected_size
+         << " for nz " << nz << " nr " << nr << " nphi " << nphi << ", exiting now" << endl;
+    exit(1);
+  }
+
+  const float *data = reinterpret_cast<const float *>(header + 1);
+  z_.map.assign(data, data + nz);
+  data += nz;
+  r_.map.assign(data, data + nr);
+  data += nr;
+  phi_.map.assign(data, data + nphi);
+  data += nphi;
+  z_.init();
+  r_.init();
+  phi_.init();
+  field_data_ = data;
+  field_scale_ = magfield_rescale;
+
+  minz_ = z_.map.front();
+  maxz_ = z_.map.back();
+
+  if (Verbosity() > 0)
+  {
+    cout << "  --> " << nz << " x " << nr << " x " << nphi << " grid points, scale " << field_scale_ << endl;
+  }
+}
+
+void PHField3DCylindrical::ReadShared(const string &filename, const float magfield_rescale)
+{
+  // the cache name depends on the map file and its modification time, so an
+  // updated map is converted again. The cache is unscaled, like a binary map
+  ostringstream key;
+  key << filename;
+  struct stat filestat;
+  if (stat(filename.c_str(), &filestat) == 0)
+  {
+    key << ":" << filestat.st_size << ":" << filestat.st_mtime;
+  }
+  const char *shmdir = getenv("PHFIELD_SHM_DIR");
+  ostringstream cachename;
+  cachename << (shmdir ? shmdir : "/dev/shm") << "/phfield3dcyl_" << hex << std::hash<string>()(key.str()) << ".bin";
+  const string cache = cachename.str();
+
+  if (access(cache.c_str(), R_OK) != 0)
+  {
+    cout << "\n ---> creating shared field map cache " << cache << endl;
+    ReadRootNtuple(filename, 1.0);
+    // write under a private name and rename, so other jobs never see a partial
+    // file. If several jobs get here at the same time the last rename wins,
+    // the content is the same
+    ostringstream tmpname;
+    tmpname << cache << "." << getpid();
+    if (!WriteBinary(tmpname.str()) || rename(tmpname.str().c_str(), cache.c_str()) != 0)
+    {
+      cout << PHWHERE << " could not create shared field map cache " << cache
+           << ", using a private copy" << endl;
+      unlink(tmpname.str().c_str());
+      field_scale_ = magfield_rescale;
+      return;
+    }
+    // drop the private copy, the mapped cache replaces it
+    vector<float>().swap(BField_);
+  }
+  ReadBinary(cache, magfield_rescale);
+}
+
+bool PHField3DCylindrical::WriteBinary(const string &filename) const
+{
+  BinaryMapHeader header;
+  memcpy(header.magic, binary_magic, sizeof(binary_magic));
+  header.version = binary_version;
+  header.nz = z_.map.size();
+  header.nr = r_.map.size();
+  header.nphi = phi_.map.size();
+  const size_t nfield = (size_t) header.nz * header.nr * header.nphi * 3;
+
+  // the scale of a memory mapped map is not stored in the file
+  vector<float> buffer(field_data_, field_data_ + nfield);
+  for (unsigned int i = 0; i < nfield; i++)
+  {
+    buffer[i] *= field_scale_;
+  }
+
+  ofstream out(filename.c_str(), ios::binary | ios::trunc);
+  out.write(reinterpret_cast<const char *>(&header), sizeof(header));
+  out.write(reinterpret_cast<const char *>(z_.map.data()), z_.map.size() * sizeof(float));
+  out.write(reinterpret_cast<const char *>(r_.map.data()), r_.map.size() * sizeof(float));
+  out.write(reinterpret_cast<const char *>(phi_.map.data()), phi_.map.size() * sizeof(float));
+  out.write(reinterpret_cast<const char *>(buffer.data()), nfield * sizeof(float));
+  out.close();
+  if (!out)
+  {
+    cout << PHWHERE << " error writing binary field map " << filename << endl;
+    return false;
+  }
+  cout << "PHField3DCylindrical: wrote binary field map " << filename << endl;
+  return true;
+}
+
+void PHField3DCylindrical::Axis::init()
+{
+  uniform = false;
+  min = map.front();
+  if (map.size() < 2)
+  {
+    return;
+  }
+  step = (map.back() - map.front()) / (map.size() - 1);
+  inv_step = 1. / step;
+  // the grid points are floats, allow for their rounding
+  uniform = true;
+  for (unsigned int i = 1; i < map.size(); ++i)
+  {
+    if (fabs(map[i] - map[i - 1] - step) > 1e-3 * step)
+    {
+      uniform = false;
+      break;
+    }
+  }
+}
+
+int PHField3DCylindrical::Axis::lower_index(const double x) const
+{
+  // largest i with map[i] <= x, -1 if x is below the first grid point
+  const int last = map.size() - 1;
+  if (!uniform)
+  {
+    return distance(map.begin(), upper_bound(map.begin(), map.end(), x)) - 1;
+  }
+  const double pos = (x - min) * inv_step;
+  if (pos < 0)
+  {
+    return -1;
+  }
+  int i = (pos < last) ? (int) pos : last;
+  // the computed index can be one off from rounding
+  if (x < map[i])
+  {
+    --i;
+  }
+  else if (i < last && x >= map[i + 1])
+  {
+    ++i;
+  }
+  return i;
 }
 
 void PHField3DCylindrical::GetFieldValue(const double point[4], double *Bfield) const
 {
   if (Verbosity() > 2)
     cout << "\nPHField3DCylindrical::GetFieldValue" << endl;
+
+  InterpolateCartesian(point, Bfield);
+
+  if (Verbosity() > 2)
+  {
+    if (Bfield[0] == 0 && Bfield[1] == 0 && Bfield[2] == 0)
+      cout << "!!!!!!!!!! Field point not in defined region or zero field" << endl;
+    cout << "END PHField3DCylindrical::GetFieldValue\n"
+         << "  --->  {Bx, By, Bz} : "
+         << "< " << Bfield[0] << ", " << Bfield[1] << ", " << Bfield[2] << " >" << endl;
+  }
+
+  return;
+}
+
+void PHField3DCylindrical::GetFieldValues(const double *Point, double *Bfield, const unsigned int n) const
+{
+  for (unsigned int i = 0; i < n; i++)
+  {
+    InterpolateCartesian(Point + 4 * i, Bfield + 3 * i);
+  }
+}
+
+void PHField3DCylindrical::InterpolateCartesian(const double point[4], double *Bfield) const
+{
   double x = point[0];
   double y = point[1];
   double z = point[2];
@@ -233,224 +506,141 @@ void PHField3DCylindrical::GetFieldValue(const double point[4], double *Bfield)
   }
   if (phi < 0) phi += 2 * M_PI;  // normalize phi to be over the range [0,2*pi]
 
+  Bfield[0] = 0.0;
+  Bfield[1] = 0.0;
+  Bfield[2] = 0.0;
+
   // Check that the point is within the defined z region (check r in a second)
   if ((z >= minz_) && (z <= maxz_))
   {
     double BFieldCyl[3];
-    double cylpoint[4] = {z, r, phi, 0};
 
     // take <z,r,phi> location and return a vector of <Bz, Br, Bphi>
-    GetFieldCyl(cylpoint, BFieldCyl);
+    if (!InterpolateCyl(z, r, phi, BFieldCyl))
+    {
+      return;
+    }
+
+    const double cosphi = cos(phi);
+    const double sinphi = sin(phi);
 
     // X direction of B-field ( Bx = Br*cos(phi) - Bphi*sin(phi)
-    Bfield[0] = cos(phi) * BFieldCyl[1] - sin(phi) * BFieldCyl[2];  // unit vector transformations
+    Bfield[0] = cosphi * BFieldCyl[1] - sinphi * BFieldCyl[2];  // unit vector transformations
 
     // Y direction of B-field ( By = Br*sin(phi) + Bphi*cos(phi)
-    Bfield[1] = sin(phi) * BFieldCyl[1] + cos(phi) * BFieldCyl[2];
+    Bfield[1] = sinphi * BFieldCyl[1] + cosphi * BFieldCyl[2];
 
     // Z direction of B-field
     Bfield[2] = BFieldCyl[0];
   }
-  else
-  {  // x,y,z is outside of z range of the field map
+  return;
+}
+
+void PHField3DCylindrical::GetFieldCyl(const double CylPoint[4], double *BfieldCyl) const
+{
+  if (Verbosity() > 2)
+    cout << "GetFieldCyl@ <z,r,phi>: {" << CylPoint[0] << "," << CylPoint[1] << "," << CylPoint[2] << "}" << endl;
 
-    Bfield[0] = 0.0;
-    Bfield[1] = 0.0;
-    Bfield[2] = 0.0;
+  if (!InterpolateCyl(CylPoint[0], CylPoint[1], CylPoint[2], BfieldCyl))
+  {
     if (Verbosity() > 2)
-      cout << "!!!!!!!!!! Field point not in defined region (outside of z bounds)" << endl;
+      cout << "!!!! Point not in defined region (|z| or radius too large)" << endl;
+    return;
   }
 
   if (Verbosity() > 2)
   {
-    cout << "END PHField3DCylindrical::GetFieldValue\n"
-         << "  --->  {Bx, By, Bz} : "
-         << "< " << Bfield[0] << ", " << Bfield[1] << ", " << Bfield[2] << " >" << endl;
+    cout << "End GFCyl Call: <bz,br,bphi> : {"
+         << BfieldCyl[0] / gauss << "," << BfieldCyl[1] / gauss << "," << BfieldCyl[2] / gauss << "}"
+         << endl;
   }
 
   return;
 }
 
-void PHField3DCylindrical::GetFieldCyl(const double CylPoint[4], double *BfieldCyl) const
+bool PHField3DCylindrical::InterpolateCyl(const float z, float r, const float phi, double *BfieldCyl) const
 {
-  float z = CylPoint[0];
-  float r = CylPoint[1];
-  float phi = CylPoint[2];
-
   BfieldCyl[0] = 0.0;
   BfieldCyl[1] = 0.0;
   BfieldCyl[2] = 0.0;
 
-  if (Verbosity() > 2)
-    cout << "GetFieldCyl@ <z,r,phi>: {" << z << "," << r << "," << phi << "}" << endl;
-
-  if (z <= z_map_[0] || z >= z_map_[z_map_.size() - 1])
+  if (z <= z_.map.front() || z >= z_.map.back())
   {
-    if (Verbosity() > 2)
-      cout << "!!!! Point not in defined region (|z| too large)" << endl;
-    return;
-  }
-  if (r < r_map_[0])
-  {
-    r = r_map_[0];
-    if (Verbosity() > 2)
-      cout << "!!!! Point not in defined region (radius too small in specific z-plane). Use min radius" << endl;
-    //    return;
+    return false;
   }
-  if (r > r_map_[r_map_.size() - 1])
+  // radius too small in specific z-plane, use min radius
+  if (r < r_.map.front())
   {
-    if (Verbosity() > 2)
-      cout << "!!!! Point not in defined region (radius too large in specific z-plane)" << endl;
-    return;
+    r = r_.map.front();
   }
 
-  vector<float>::const_iterator ziter = upper_bound(z_map_.begin(), z_map_.end(), z);
-  int z_index0 = distance(z_map_.begin(), ziter) - 1;
-  int z_index1 = z_index0 + 1;
-
+  const int z_index0 = z_.lower_index(z);
+  const int z_index1 = z_index0 + 1;
   assert(z_index0 >= 0);
-  assert(z_index1 >= 0);
-  assert(z_index0 < (int) z_map_.size());
-  assert(z_index1 < (int) z_map_.size());
+  assert(z_index1 < (int) z_.map.size());
 
-  vector<float>::const_iterator riter = upper_bound(r_map_.begin(), r_map_.end(), r);
-  int r_index0 = distance(r_map_.begin(), riter) - 1;
-  if (r_index0 >= (int) r_map_.size())
+  const int r_index0 = r_.lower_index(r);
+  const int r_index1 = r_index0 + 1;
+  if (r_index1 >= (int) r_.map.size())
   {
-    if (Verbosity() > 2)
-      cout << "!!!! Point not in defined region (radius too large in specific z-plane)" << endl;
-    return;
-  }
-
-  int r_index1 = r_index0 + 1;
-  if (r_index1 >= (int) r_map_.size())
-  {
-    if (Verbosity() > 2)
-      cout << "!!!! Point not in defined region (radius too large in specific z-plane)" << endl;
-    return;
+    return false;
   }
-
   assert(r_index0 >= 0);
-  assert(r_index1 >= 0);
 
-  vector<float>::const_iterator phiiter = upper_bound(phi_map_.begin(), phi_map_.end(), phi);
-  int phi_index0 = distance(phi_map_.begin(), phiiter) - 1;
+  // phi wraps around, the cell between the last and the first grid point spans 2pi
+  const int nphi = phi_.map.size();
+  int phi_index0 = phi_.lower_index(phi);
   int phi_index1 = phi_index0 + 1;
-  if (phi_index1 >= (int) phi_map_.size())
+  double phi0;
+  double phi1;
+  if (phi_index0 < 0)
+  {
+    phi_index0 = nphi - 1;
     phi_index1 = 0;
-
-  assert(phi_index0 >= 0);
-  assert(phi_index0 < (int) phi_map_.size());
-  assert(phi_index1 >= 0);
-
-  double Br000 = BFieldR_[z_index0][r_index0][phi_index0];
-  double Br001 = BFieldR_[z_index0][r_index0][phi_index1];
-  double Br010 = BFieldR_[z_index0][r_index1][phi_index0];
-  double Br011 = BFieldR_[z_index0][r_index1][phi_index1];
-  double Br100 = BFieldR_[z_index1][r_index0][phi_index0];
-  double Br101 = BFieldR_[z_index1][r_index0][phi_index1];
-  double Br110 = BFieldR_[z_index1][r_index1][phi_index0];
-  double Br111 = BFieldR_[z_index1][r_index1][phi_index1];
-
-  double Bphi000 = BFieldPHI_[z_index0][r_index0][phi_index0];
-  double Bphi001 = BFieldPHI_[z_index0][r_index0][phi_index1];
-  double Bphi010 = BFieldPHI_[z_index0][r_index1][phi_index0];
-  double Bphi011 = BFieldPHI_[z_index0][r_index1][phi_index1];
-  double Bphi100 = BFieldPHI_[z_index1][r_index0][phi_index0];
-  double Bphi101 = BFieldPHI_[z_index1][r_index0][phi_index1];
-  double Bphi110 = BFieldPHI_[z_index1][r_index1][phi_index0];
-  double Bphi111 = BFieldPHI_[z_index1][r_index1][phi_index1];
-
-  double Bz000 = BFieldZ_[z_index0][r_index0][phi_index0];
-  double Bz001 = BFieldZ_[z_index0][r_index0][phi_index1];
-  double Bz100 = BFieldZ_[z_index1][r_index0][phi_index0];
-  double Bz101 = BFieldZ_[z_index1][r_index0][phi_index1];
-  double Bz010 = BFieldZ_[z_index0][r_index1][phi_index0];
-  double Bz110 = BFieldZ_[z_index1][r_index1][phi_index0];
-  double Bz011 = BFieldZ_[z_index0][r_index1][phi_index1];
-  double Bz111 = BFieldZ_[z_index1][r_index1][phi_index1];
-
-  double zweight = z - z_map_[z_index0];
-  double zspacing = z_map_[z_index1] - z_map_[z_index0];
-  zweight /= zspacing;
-
-  double rweight = r - r_map_[r_index0];
-  double rspacing = r_map_[r_index1] - r_map_[r_index0];
-  rweight /= rspacing;
-
-  double phiweight = phi - phi_map_[phi_index0];
-  double phispacing = phi_map_[phi_index1] - phi_map_[phi_index0];
-  if (phi_index1 == 0)
-    phispacing += 2 * M_PI;
-  phiweight /= phispacing;
-
-  // Z direction of B-field
-  BfieldCyl[0] =
-      (1 - zweight) * ((1 - rweight) * ((1 - phiweight) * Bz000 + phiweight * Bz001) +
-                       rweight * ((1 - phiweight) * Bz010 + phiweight * Bz011)) +
-      zweight * ((1 - rweight) * ((1 - phiweight) * Bz100 + phiweight * Bz101) +
-                 rweight * ((1 - phiweight) * Bz110 + phiweight * Bz111));
-
-  // R direction of B-field
-  BfieldCyl[1] =
-      (1 - zweight) * ((1 - rweight) * ((1 - phiweight) * Br000 + phiweight * Br001) +
-                       rweight * ((1 - phiweight) * Br010 + phiweight * Br011)) +
-      zweight * ((1 - rweight) * ((1 - phiweight) * Br100 + phiweight * Br101) +
-                 rweight * ((1 - phiweight) * Br110 + phiweight * Br111));
-
-  // PHI Direction of B-field
-  BfieldCyl[2] =
-      (1 - zweight) * ((1 - rweight) * ((1 - phiweight) * Bphi000 + phiweight * Bphi001) +
-                       rweight * ((1 - phiweight) * Bphi010 + phiweight * Bphi011)) +
-      zweight * ((1 - rweight) * ((1 - phiweight) * Bphi100 + phiweight * Bphi101) +
-                 rweight * ((1 - phiweight) * Bphi110 + phiweight * Bphi111));
-
-  //     cout << "wr: " << rweight << " wz: " << zweight << " wphi: " << phiweight << endl;
-  //     cout << "Bz000: " << Bz000 << endl
-  //          << "Bz001: " << Bz001 << endl
-  //          << "Bz010: " << Bz010 << endl
-  //          << "Bz011: " << Bz011 << endl
-  //          << "Bz100: " << Bz100 << endl
-  //          << "Bz101: " << Bz101 << endl
-  //          << "Bz110: " << Bz110 << endl
-  //          << "Bz111: " << Bz111 << endl
-  //          << "Bz:    " << BfieldCyl[0] << endl << endl;
-
-  if (Verbosity() > 2)
+    phi0 = phi_.map[phi_index0] - 2 * M_PI;
+    phi1 = phi_.map[phi_index1];
+  }
+  else if (phi_index1 >= nphi)
   {
-    cout << "End GFCyl Call: <bz,br,bphi> : {"
-         << BfieldCyl[0] / gauss << "," << BfieldCyl[1] / gauss << "," << BfieldCyl[2] / gauss << "}"
-         << endl;
+    phi_index1 = 0;
+    phi0 = phi_.map[phi_index0];
+    phi1 = phi_.map[phi_index1] + 2 * M_PI;
   }
-
-  return;
-}
-
-// a binary search algorithm that puts the location that "key" would be, into index...
-// it returns true if key was found, and false if not.
-bool PHField3DCylindrical::bin_search(const vector<float> &vec, unsigned start, unsigned end, const float &key, unsigned &index) const
-{
-  // Termination condition: start index greater than end index
-  if (start > end)
+  else
   {
-    index = start;
-    return false;
+    phi0 = phi_.map[phi_index0];
+    phi1 = phi_.map[phi_index1];
   }
 
-  // Find the middle element of the vector and use that for splitting
-  // the array into two pieces.
-  unsigned middle = start + ((end - start) / 2);
-
-  if (vec[middle] == key)
+  const double zweight = (z - z_.map[z_index0]) / (z_.map[z_index1] - z_.map[z_index0]);
+  const double rweight = (r - r_.map[r_index0]) / (r_.map[r_index1] - r_.map[r_index0]);
+  const double phiweight = (phi - phi0) / (phi1 - phi0);
+
+  // corners of the cell, each with the three components <Bz, Br, Bphi>
+  const float *corner[8] = {
+      field(z_index0, r_index0, phi_index0), field(z_index0, r_index0, phi_index1),
+      field(z_index0, r_index1, phi_index0), field(z_index0, r_index1, phi_index1),
+      field(z_index1, r_index0, phi_index0), field(z_index1, r_index0, phi_index1),
+      field(z_index1, r_index1, phi_index0), field(z_index1, r_index1, phi_index1)};
+  const double weight[8] = {
+      (1 - zweight) * (1 - rweight) * (1 - phiweight), (1 - zweight) * (1 - rweight) * phiweight,
+      (1 - zweight) * rweight * (1 - phiweight), (1 - zweight) * rweight * phiweight,
+      zweight * (1 - rweight) * (1 - phiweight), zweight * (1 - rweight) * phiweight,
+      zweight * rweight * (1 - phiweight), zweight * rweight * phiweight};
+
+  for (int icorner = 0; icorner < 8; icorner++)
   {
-    index = middle;
-    return true;
+    for (int i = 0; i < 3; i++)
+    {
+      BfieldCyl[i] += weight[icorner] * corner[icorner][i];
+    }
   }
-  else if (vec[middle] > key)
+  for (int i = 0; i < 3; i++)
   {
-    return bin_search(vec, start, middle - 1, key, index);
+    BfieldCyl[i] *= field_scale_;
   }
-  return bin_search(vec, middle + 1, end, key, index);
+
+  return true;
 }
 
 // debug function to print key/value pairs in map
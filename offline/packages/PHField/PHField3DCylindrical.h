@@ -24,6 +24,7 @@
 
 #include <boost/tuple/tuple.hpp>
 
+#include <cstddef>
 #include <map>
 #include <string>
 #include <vector>
@@ -33,26 +34,79 @@ class PHField3DCylindrical : public PHField
   typedef boost::tuple<float, float, float> trio;
 
  public:
-  PHField3DCylindrical(const std::string& filename, int verb = 0, const float magfield_rescale = 1.0);
-  virtual ~PHField3DCylindrical() {}
+  //! format of the field map file
+  enum MapFormat
+  {
+    //! TNtuple "map" with z, r, phi, bz, br, bphi in cm, deg and gauss
+    kRootNtuple = 0,
+    //! flat binary file written by WriteBinary(), memory mapped read only
+    kBinary = 1,
+    //! ROOT TNtuple, converted to the binary format once per node in a shared
+    //! memory cache (PHFIELD_SHM_DIR, default /dev/shm) which every job maps
+    kRootNtupleShared = 2
+  };
+
+  PHField3DCylindrical(const std::string& filename, int verb = 0, const float magfield_rescale = 1.0, const MapFormat format = kRootNtuple);
+  virtual ~PHField3DCylindrical();
   void GetFieldValue(const double Point[4], double* Bfield) const;
+  void GetFieldValues(const double* Point, double* Bfield, const unsigned int n) const;
   void GetFieldCyl(const double CylPoint[4], double* Bfield) const;
 
+  //! write the map in the binary format (native byte order, Geant4 units, rescale applied)
+  bool WriteBinary(const std::string& filename) const;
+
  protected:
-  // < i, j, k > , this allows i and i+1 to be neighbors ( <i,j,k>=<z,r,phi> )
-  std::vector<std::vector<std::vector<float> > > BFieldZ_;
-  std::vector<std::vector<std::vector<float> > > BFieldR_;
-  std::vector<std::vector<std::vector<float> > > BFieldPHI_;
+  //! grid points along one axis of the map
+  struct Axis
+  {
+    // maps indices to values map[i] = value that corresponds to ith index
+    std::vector<float> map;
+    //! set if the points are equidistant, then the cell is found without search
+    bool uniform = false;
+    double min = 0;
+    double step = 0;
+    double inv_step = 0;
+
+    void init();
+    //! index of the grid point below x, the caller checks x is inside the grid
+    int lower_index(const double x) const;
+  };
+
+  //! field value at a grid point
+  const float* field(const int iz, const int ir, const int iphi) const
+  {
+    return &field_data_[((iz * r_.map.size() + ir) * phi_.map.size() + iphi) * 3];
+  }
+
+  //! interpolated field value without printout, returns false if the point is outside of the map
+  bool InterpolateCyl(const float z, float r, const float phi, double* BfieldCyl) const;
+  //! field value in cartesian coordinates without printout
+  void InterpolateCartesian(const double Point[4], double* Bfield) const;
+
+  void ReadRootNtuple(const std::string& filename, const float magfield_rescale);
+  void ReadBinary(const std::string& filename, const float magfield_rescale);
+  //! maps the shared cache of a ROOT map, the first process creates it
+  void ReadShared(const std::string& filename, const float magfield_rescale);
+
+  //! < i, j, k > = < z, r, phi >, the three components (Bz, Br, Bphi) of a grid point are
+  //! stored next to each other and phi runs fastest, the 8 corners of a cell are in 4 pairs
+  //! points either to BField_ or into the memory mapped file
+  const float* field_data_;
+  std::vector<float> BField_;
+
+  //! memory mapped binary map, shared with all processes reading the same file
+  void* mapped_;
+  size_t mapped_size_;
+  //! applied at lookup for the memory mapped map, 1 for maps read from ROOT
+  double field_scale_;
 
-  // maps indices to values z_map[i] = z_value that corresponds to ith index
-  std::vector<float> z_map_;    // < i >
-  std::vector<float> r_map_;    // < j >
-  std::vector<float> phi_map_;  // < k >
+  Axis z_;    // < i >
+  Axis r_;    // < j >
+  Axis phi_;  // < k >
 
   float maxz_, minz_;  // boundaries of magnetic field map cyl
 
  private:
-  bool bin_search(const std::vector<float>& vec, unsigned start, unsigned end, const float& key, unsigned& index) const;
   void print_map(std::map<trio, trio>::iterator& it) const;
 };
 
@@ -37,6 +37,12 @@ string PHFieldConfig::get_field_config_description() const
   case kFieldCleo:
     return "Cleo Magnet Field";
     break;
+  case kField3DCylindricalBinary:
+    return "3D field map expressed in cylindrical coordinates (binary)";
+    break;
+  case kField3DCylindricalShared:
+    return "3D field map expressed in cylindrical coordinates (shared memory)";
+    break;
   default:
     return "Invalid Field";
   }
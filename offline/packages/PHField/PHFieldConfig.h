@@ -39,6 +39,10 @@ class PHFieldConfig : public PHObject
     kFieldBeast = 4,
     //! Cleo field map from https://gitlab.com/eic/escalate/g4e/-/blob/master/SolenoidMag3D.TABLE
     kFieldCleo = 5,
+    //! 3D field map expressed in cylindrical coordinates, memory mapped binary file from PHFieldUtility::ConvertFieldMap3DCylindrical()
+    kField3DCylindricalBinary = 6,
+    //! 3D field map expressed in cylindrical coordinates, ROOT file converted once per node into a shared memory cache
+    kField3DCylindricalShared = 7,
     //! 3D field map expressed in Cartesian coordinates
     Field3DCartesian = 1,
 
@@ -0,0 +1,183 @@
+#include "PHFieldGrid.h"
+
+#include "PHField.h"
+
+#include <atomic>
+#include <cassert>
+#include <cmath>
+#include <cstdint>
+#include <iostream>
+
+using namespace std;
+
+namespace
+{
+  //! ids of the built tables, 0 is never used
+  atomic<unsigned long> next_grid_id(1);
+
+  //! corners of the last cell looked up by this thread
+  struct LastCell
+  {
+    unsigned long id = 0;
+    size_t cell = SIZE_MAX;
+    float corner[8][3];
+  };
+  thread_local LastCell last_cell;
+}  // namespace
+
+PHFieldGrid::PHFieldGrid(const PHField* field, const double length_unit, const double field_unit)
+  : m_PHField(field)
+  , m_LengthUnit(length_unit)
+  , m_FieldUnit(field_unit)
+  , m_Id(0)
+  , m_Step(0)
+  , m_InvStep(0)
+{
+  assert(m_PHField);
+  for (int i = 0; i < 3; ++i)
+  {
+    // empty grid, every point is outside
+    m_Min[i] = 1;
+    m_Max[i] = -1;
+    m_N[i] = 0;
+  }
+}
+
+void PHFieldGrid::build(const double xmin, const double xmax,
+                        const double ymin, const double ymax,
+                        const double zmin, const double zmax,
+                        const double step)
+{
+  assert(step > 0);
+  const double min[3] = {xmin, ymin, zmin};
+  const double max[3] = {xmax, ymax, zmax};
+
+  m_Step = step;
+  m_InvStep = 1. / step;
+  for (int i = 0; i < 3; ++i)
+  {
+    assert(max[i] > min[i]);
+    // at least one cell per axis
+    m_N[i] = static_cast<size_t>(ceil((max[i] - min[i]) * m_InvStep)) + 1;
+    m_Min[i] = min[i];
+    m_Max[i] = min[i] + (m_N[i] - 1) * step;
+  }
+
+  m_Field.assign(m_N[0] * m_N[1] * m_N[2] * 3, 0);
+
+  // one row along x at a time through the vectorized access
+  vector<double> points(m_N[0] * 4, 0);
+  vector<double> fields(m_N[0] * 3, 0);
+  for (size_t ix = 0; ix < m_N[0]; ++ix)
+  {
+    points[ix * 4] = (m_Min[0] + ix * step) * m_LengthUnit;
+  }
+  for (size_t iz = 0; iz < m_N[2]; ++iz)
+  {
+    for (size_t iy = 0; iy < m_N[1]; ++iy)
+    {
+      for (size_t ix = 0; ix < m_N[0]; ++ix)
+      {
+        points[ix * 4 + 1] = (m_Min[1] + iy * step) * m_LengthUnit;
+        points[ix * 4 + 2] = (m_Min[2] + iz * step) * m_LengthUnit;
+      }
+      m_PHField->GetFieldValues(points.data(), fields.data(), m_N[0]);
+
+      float* row = &m_Field[node(0, iy, iz) * 3];
+      for (size_t i = 0; i < m_N[0] * 3; ++i)
+      {
+        row[i] = fields[i] / m_FieldUnit;
+      }
+    }
+  }
+
+  m_Id = next_grid_id++;
+
+  if (m_PHField->Verbosity() > 0)
+  {
+    cout << "PHFieldGrid::build - " << m_N[0] << " x " << m_N[1] << " x " << m_N[2]
+         << " points, step " << step << ", " << size_bytes() / 1024 / 1024 << " MB" << endl;
+  }
+}
+
+void PHFieldGrid::get(const double x, const double y, const double z, double* B) const
+{
+  if (!is_built() || !inside(x, y, z))
+  {
+    get_field(x, y, z, B);
+    return;
+  }
+
+  // lower corner of the cell, the upper edge of the grid belongs to the last cell
+  const double u[3] = {(x - m_Min[0]) * m_InvStep, (y - m_Min[1]) * m_InvStep, (z - m_Min[2]) * m_InvStep};
+  size_t index[3];
+  double frac[3];
+  for (int i = 0; i < 3; ++i)
+  {
+    index[i] = static_cast<size_t>(u[i]);
+    if (index[i] > m_N[i] - 2) index[i] = m_N[i] - 2;
+    frac[i] = u[i] - index[i];
+  }
+
+  const size_t cell = node(index[0], index[1], index[2]);
+  if (last_cell.id != m_Id || last_cell.cell != cell)
+  {
+    int icorner = 0;
+    for (size_t iz = 0; iz < 2; ++iz)
+    {
+      for (size_t iy = 0; iy < 2; ++iy)
+      {
+        const float* row = &m_Field[node(index[0], index[1] + iy, index[2] + iz) * 3];
+        for (size_t ix = 0; ix < 2; ++ix)
+        {
+          for (int ib = 0; ib < 3; ++ib)
+          {
+            last_cell.corner[icorner][ib] = row[ix * 3 + ib];
+          }
+          ++icorner;
+        }
+      }
+    }
+    last_cell.id = m_Id;
+    last_cell.cell = cell;
+  }
+
+  const double wx[2] = {1 - frac[0], frac[0]};
+  const double wy[2] = {1 - frac[1], frac[1]};
+  const double wz[2] = {1 - frac[2], frac[2]};
+
+  B[0] = B[1] = B[2] = 0;
+  int icorner = 0;
+  for (int iz = 0; iz < 2; ++iz)
+  {
+    for (int iy = 0; iy < 2; ++iy)
+    {
+      for (int ix = 0; ix < 2; ++ix)
+      {
+        const double w = wx[ix] * wy[iy] * wz[iz];
+        B[0] += w * last_cell.corner[icorner][0];
+        B[1] += w * last_cell.corner[icorner][1];
+        B[2] += w * last_cell.corner[icorner][2];
+        ++icorner;
+      }
+    }
+  }
+}
+
+void PHFieldGrid::get_values(const double* xyz, double* B, const unsigned int n) const
+{
+  for (unsigned int i = 0; i < n; ++i)
+  {
+    get(xyz[i * 3], xyz[i * 3 + 1], xyz[i * 3 + 2], B + i * 3);
+  }
+}
+
+void PHFieldGrid::get_field(const double x, const double y, const double z, double* B) const
+{
+  const double point[4] = {x * m_LengthUnit, y * m_LengthUnit, z * m_LengthUnit, 0};
+  double bfield[3] = {0, 0, 0};
+  m_PHField->GetFieldValue(point, bfield);
+  B[0] = bfield[0] / m_FieldUnit;
+  B[1] = bfield[1] / m_FieldUnit;
+  B[2] = bfield[2] / m_FieldUnit;
+}
@@ -0,0 +1,80 @@
+#ifndef PHFIELD_PHFIELDGRID_H
+#define PHFIELD_PHFIELDGRID_H
+
+#include <cstddef>
+#include <vector>
+
+class PHField;
+
+//! \brief field of a PHField sampled on a regular cartesian grid, for fast lookup by the track fits
+//!
+//! The field is sampled once in a box (usually the tracking volume) and
+//! trilinearly interpolated at lookup, without virtual call. The positions
+//! and field values are in the units chosen at construction (e.g. cm and
+//! kGauss for GenFit, mm and T for Acts), the unit conversion is folded into
+//! the table. Points outside the box are passed to the sampled field.
+//! The grid is read only after build(), lookups can run in parallel. The
+//! corners of the last cell of each thread are cached, as the propagation
+//! asks for close points several times per step.
+class PHFieldGrid
+{
+ public:
+  //! @param[in] field       field to sample, it must stay alive as long as the grid
+  //! @param[in] length_unit length unit of the positions in Geant4/CLHEP units, e.g. CLHEP::cm
+  //! @param[in] field_unit  field unit of the results in Geant4/CLHEP units, e.g. CLHEP::kilogauss
+  PHFieldGrid(const PHField* field, const double length_unit, const double field_unit);
+  virtual ~PHFieldGrid() {}
+
+  //! sample the field in the box every step (in the length unit), the box is extended to whole cells
+  void build(const double xmin, const double xmax,
+             const double ymin, const double ymax,
+             const double zmin, const double zmax,
+             const double step);
+
+  bool is_built() const { return !m_Field.empty(); }
+
+  //! true if the point is inside the grid
+  bool inside(const double x, const double y, const double z) const
+  {
+    return x >= m_Min[0] && x <= m_Max[0] &&
+           y >= m_Min[1] && y <= m_Max[1] &&
+           z >= m_Min[2] && z <= m_Max[2];
+  }
+
+  //! field at x, y, z, the point and the result are in the units of the grid
+  void get(const double x, const double y, const double z, double* B) const;
+
+  //! field at n points, xyz = x0, y0, z0, x1, ... and B = Bx0, By0, Bz0, Bx1, ...
+  void get_values(const double* xyz, double* B, const unsigned int n) const;
+
+  //! memory used by the table in bytes
+  size_t size_bytes() const { return m_Field.size() * sizeof(float); }
+
+ private:
+  //! field of the sampled PHField, with unit conversion
+  void get_field(const double x, const double y, const double z, double* B) const;
+
+  //! grid point (ix, iy, iz), x runs fastest
+  size_t node(const size_t ix, const size_t iy, const size_t iz) const
+  {
+    return (iz * m_N[1] + iy) * m_N[0] + ix;
+  }
+
+  const PHField* m_PHField;
+  double m_LengthUnit;
+  double m_FieldUnit;
+
+  //! id of the table, tells the per thread cache apart from a rebuilt grid at the same address
+  unsigned long m_Id;
+
+  double m_Min[3];
+  double m_Max[3];
+  double m_Step;
+  double m_InvStep;
+  size_t m_N[3];
+
+  //! Bx, By, Bz of each grid point
+  std::vector<float> m_Field;
+};
+
+#endif
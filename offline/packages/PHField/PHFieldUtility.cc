@@ -67,6 +67,24 @@ PHFieldUtility::BuildFieldMap(const PHFieldConfig *field_config, const int verbo
         field_config->get_magfield_rescale());
     break;
 
+  case PHFieldConfig::kField3DCylindricalBinary:
+    //    return "3D field map expressed in cylindrical coordinates (binary)";
+    field = new PHField3DCylindrical(
+        field_config->get_filename(),
+        verbosity,
+        field_config->get_magfield_rescale(),
+        PHField3DCylindrical::kBinary);
+    break;
+
+  case PHFieldConfig::kField3DCylindricalShared:
+    //    return "3D field map expressed in cylindrical coordinates (shared memory)";
+    field = new PHField3DCylindrical(
+        field_config->get_filename(),
+        verbosity,
+        field_config->get_magfield_rescale(),
+        PHField3DCylindrical::kRootNtupleShared);
+    break;
+
   case PHFieldConfig::Field3DCartesian:
     //    return "3D field map expressed in Cartesian coordinates";
     field = new PHField3DCartesian(
@@ -101,6 +119,12 @@ PHFieldUtility::BuildFieldMap(const PHFieldConfig *field_config, const int verbo
   return field;
 }
 
+bool PHFieldUtility::ConvertFieldMap3DCylindrical(const std::string &rootfile, const std::string &binaryfile, const int verbosity)
+{
+  PHField3DCylindrical field(rootfile, verbosity, 1.0);
+  return field.WriteBinary(binaryfile);
+}
+
 //! Make a default PHFieldConfig
 //! Field map = /phenix/upgrades/decadal/fieldmaps/sPHENIX.2d.root
 //! Field Scale to 1.4/1.5
@@ -114,7 +138,7 @@ PHFieldConfig *PHFieldUtility::DefaultFieldConfig()
 
 //! Get transient PHField from DST nodes. If not found, make a new one based on default_config
 PHField *
-PHFieldUtility::GetFieldMapNode(const PHFieldConfig *default_config, PHCompositeNode *topNode, const int verbosity)
+PHFieldUtility::GetFieldMapNode(const PHFieldConfig *default_config, PHCompositeNode *topNode, const int verbosity, PHField *prebuilt)
 {
   if (topNode == nullptr)
   {
@@ -134,14 +158,29 @@ PHFieldUtility::GetFieldMapNode(const PHFieldConfig *default_config, PHComposite
   PHField *field = findNode::getClass<PHField>(parNode, GetDSTFieldMapNodeName());
   if (!field)
   {
+    // a configuration from the DST takes priority over default_config
+    const bool config_on_node = findNode::getClass<PHFieldConfig>(topNode, GetDSTConfigNodeName());
     PHFieldConfig *field_config = GetFieldConfigNode(default_config, topNode, verbosity);
     assert(field_config);
 
-    field = BuildFieldMap(field_config, verbosity > 0 ? verbosity - 1 : verbosity);
+    if (prebuilt && default_config && !config_on_node)
+    {
+      if (verbosity)
+      {
+        cout << "PHFieldUtility::GetFieldMapNode - using the field map built beforehand" << endl;
+      }
+      field = prebuilt;
+      prebuilt = nullptr;
+    }
+    else
+    {
+      field = BuildFieldMap(field_config, verbosity > 0 ? verbosity - 1 : verbosity);
+    }
     assert(field);
 
     parNode->addNode(new PHDataNode<PHField>(field, GetDSTFieldMapNodeName()));
   }
+  delete prebuilt;
 
   return field;
 }
@@ -20,8 +20,10 @@ class PHFieldUtility
   //! Get transient PHField from DST nodes. If not found, make a new one based on default_config
   //! \param[in]  default_config  default configuraiton if not on DST. If nullptr, use DefaultFieldConfig() as the default
   //! \param[in]  topNode         you know who....
+  //! \param[in]  prebuilt        field map built from default_config beforehand (e.g. in InitRunIndependent), used if
+  //!                             default_config ends up on the node tree, otherwise deleted. The node takes ownership
   static PHField *
-  GetFieldMapNode(const PHFieldConfig *default_config = nullptr, PHCompositeNode *topNode = nullptr, const int verbosity = 0);
+  GetFieldMapNode(const PHFieldConfig *default_config = nullptr, PHCompositeNode *topNode = nullptr, const int verbosity = 0, PHField *prebuilt = nullptr);
 
   //! Get persistent PHFieldConfig from DST nodes. If not found, make a new one based on default_config
   //! \param[in]  default_config  default configuraiton if not on DST. If nullptr, use DefaultFieldConfig() as the default
@@ -33,6 +35,12 @@ class PHFieldUtility
   static PHField *
   BuildFieldMap(const PHFieldConfig *field_config, const int verbosity = 0);
 
+  //! Convert a 3D cylindrical field map from ROOT TNtuple to the binary format
+  //! which is memory mapped at startup (PHFieldConfig::kField3DCylindricalBinary).
+  //! The map is written unscaled, the magfield_rescale of the configuration is applied when reading
+  static bool
+  ConvertFieldMap3DCylindrical(const std::string &rootfile, const std::string &binaryfile, const int verbosity = 0);
+
   //! DST node name for RunTime field map object
   static std::string
   GetDSTFieldMapNodeName()
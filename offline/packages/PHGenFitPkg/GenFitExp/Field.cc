@@ -4,6 +4,7 @@
 #include "Field.h"
 
 #include <phfield/PHField.h>
+#include <phfield/PHFieldGrid.h>
 
 #include <TVector3.h>                   // for TVector3
 
@@ -20,6 +21,17 @@ Field::Field(const PHField* field)
   assert(field_);
 }
 
+Field::~Field()
+{
+}
+
+void Field::use_grid(const double half_xy, const double half_z, const double step)
+{
+  assert(field_);
+  grid_.reset(new PHFieldGrid(field_, CLHEP::cm, CLHEP::kilogauss));
+  grid_->build(-half_xy, half_xy, -half_xy, half_xy, -half_z, half_z, step);
+}
+
 //
 //bool Field::initialize(std::string inname)
 //{
@@ -134,6 +146,16 @@ void Field::get(const double& x, const double& y, const double& z, double& Bx, d
 {
   assert(field_);
 
+  if (grid_)
+  {
+    double B[3];
+    grid_->get(x, y, z, B);
+    Bx = B[0];
+    By = B[1];
+    Bz = B[2];
+    return;
+  }
+
   const double Point[] = {x * CLHEP::cm, y * CLHEP::cm, z * CLHEP::cm, 0};
   double Bfield[] = {std::numeric_limits<double>::signaling_NaN(),
                      std::numeric_limits<double>::signaling_NaN(),
@@ -12,7 +12,10 @@
 
 #include <TVector3.h>
 
+#include <memory>
+
 class PHField;
+class PHFieldGrid;
 
 namespace genfit
 {
@@ -26,7 +29,7 @@ class Field : public AbsBField
  public:
   Field(const PHField* field);
 
-  virtual ~Field() {}
+  virtual ~Field();
 
   //  void plot(std::string option = "");
 
@@ -42,10 +45,18 @@ class Field : public AbsBField
   void set_field(const PHField* field)
   {
     field_ = field;
+    grid_.reset();
   }
 
+  //! sample the field every step in |x|, |y| < half_xy and |z| < half_z (in cm) and
+  //! interpolate the samples in this box instead of calling the field map
+  void use_grid(const double half_xy = 85, const double half_z = 110, const double step = 2);
+
  private:
   const PHField* field_;
+
+  //! fast lookup table of field_ in cm and kGauss, null if not used
+  std::unique_ptr<PHFieldGrid> grid_;
 };
 
 } /* End of namespace genfit */
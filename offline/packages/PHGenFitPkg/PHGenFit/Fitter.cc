@@ -266,6 +266,18 @@ Fitter::Fitter(TGeoManager* tgeo_manager, genfit::AbsBField* fieldMap,
   }
 }
 
+bool Fitter::use_field_grid()
+{
+  genfit::Field* fieldMap = dynamic_cast<genfit::Field*>(genfit::FieldManager::getInstance()->getField());
+  if (!fieldMap)
+  {
+    LogERROR("The GenFit field is not a genfit::Field, no field grid!");
+    return false;
+  }
+  fieldMap->use_grid();
+  return true;
+}
+
 int Fitter::displayEvent()
 {
   if (_display)
@@ -101,6 +101,10 @@ class Fitter
 
   int displayEvent();
 
+  //! interpolate the field on a cartesian grid of the tracking volume (genfit::Field::use_grid)
+  //! @return false if the field of genfit is not a genfit::Field
+  bool use_field_grid();
+
   bool is_do_Event_Display() const
   {
     return _doEventDisplay;
@@ -14,18 +14,48 @@
 #include <phool/recoConsts.h>
 
 #include <TGeoManager.h>
+#include <TROOT.h>
 
 #include <cassert>
+#include <cstdint>
 #include <cstdio>
 #include <cstdlib>
 #include <fstream>
+#include <iomanip>
 #include <iostream>
 #include <sstream>
 #include <stdexcept>
 #include <unistd.h>  // for generate unique local file
+#include <vector>
 
 using namespace std;
 
+namespace
+{
+  //! FNV-1a hash of a buffer. The ROOT version goes into the seed, as the
+  //! cached geometry is streamed with the ROOT classes of this version
+  size_t hash_bytes(const char *data, const size_t n)
+  {
+    uint64_t hash = 14695981039346656037ULL;
+    hash = (hash ^ static_cast<uint64_t>(gROOT->GetVersionInt())) * 1099511628211ULL;
+    for (size_t i = 0; i < n; ++i)
+    {
+      hash = (hash ^ static_cast<unsigned char>(data[i])) * 1099511628211ULL;
+    }
+    return hash;
+  }
+
+  //! hash of the contents of a file, false if it can not be read
+  bool hash_file(const string &file_name, size_t &hash)
+  {
+    ifstream file(file_name, ios_base::in | ios_base::binary);
+    if (!file) return false;
+    const vector<char> data((istreambuf_iterator<char>(file)), istreambuf_iterator<char>());
+    hash = hash_bytes(data.data(), data.size());
+    return true;
+  }
+}  // namespace
+
 //! DST node -> TGeoManager for downstream use
 TGeoManager *
 PHGeomUtility::GetTGeoManager(PHCompositeNode *topNode)
@@ -69,7 +99,21 @@ int PHGeomUtility::ImportGeomFile(PHCompositeNode *topNode,
   dst_geom->Reset();
 
   TGeoManager::SetVerboseLevel(GetVerbosity());
-  dst_geom->SetGeometry(TGeoManager::Import(geometry_file.c_str()));
+
+  // closed geometry from the cache, if this file was imported before
+  string cache_file;
+  size_t source_hash = 0;
+  if (!GetGeometryCacheDir().empty() and hash_file(geometry_file, source_hash))
+    cache_file = GetTGeoCacheFile(source_hash);
+
+  TGeoManager *tgeo = ImportFromCache(cache_file);
+  if (!tgeo)
+  {
+    tgeo = TGeoManager::Import(geometry_file.c_str());
+    if (tgeo)
+      ExportToCache(tgeo, cache_file);
+  }
+  dst_geom->SetGeometry(tgeo);
 
   if (dst_geom->GetGeometry() == nullptr)
   {
@@ -167,8 +211,11 @@ PHGeomUtility::GetGeomIOTGeoNode(PHCompositeNode *topNode, bool build_new)
 std::string
 PHGeomUtility::GenerateGeometryFileName(const std::string &filename_extension)
 {
+  // the file is only a transfer buffer, keep it in memory if possible
+  const char *tmp_dir = (access("/dev/shm", W_OK) == 0) ? "/dev/shm/" : "/tmp/";
+
   ostringstream file;
-  file << "/tmp/"
+  file << tmp_dir
        << "PHGeomUtility_geom_file_" << ::getpid() << "."
        << filename_extension;
 
@@ -248,10 +295,24 @@ PHGeomUtility::LoadFromIONode(PHCompositeNode *topNode)
     return nullptr;
   }
 
-  // build new TGeoManager
   TGeoManager::SetVerboseLevel(GetVerbosity());
-  TGeoManager *tgeo = dst_geom_io->ConstructTGeoManager();
-  tgeo->CloseGeometry();
+
+  // closed geometry from the cache, if this geometry was loaded before
+  string cache_file;
+  if (!GetGeometryCacheDir().empty())
+  {
+    const vector<char> &data = dst_geom_io->GetData();
+    cache_file = GetTGeoCacheFile(hash_bytes(data.data(), data.size()));
+  }
+
+  TGeoManager *tgeo = ImportFromCache(cache_file);
+  if (!tgeo)
+  {
+    // build new TGeoManager
+    tgeo = dst_geom_io->ConstructTGeoManager();
+    tgeo->CloseGeometry();
+    ExportToCache(tgeo, cache_file);
+  }
 
   PHGeomTGeo *dst_geom = GetGeomTGeoNode(topNode, true);
   assert(dst_geom);
@@ -260,6 +321,82 @@ PHGeomUtility::LoadFromIONode(PHCompositeNode *topNode)
   return dst_geom;
 }
 
+std::string
+PHGeomUtility::GetTGeoCacheFile(const size_t source_hash)
+{
+  const string dir = GetGeometryCacheDir();
+  if (dir.empty()) return "";
+
+  ostringstream file;
+  file << dir << "/PHGeomTGeo_" << hex << setw(16) << setfill('0')
+       << source_hash << ".root";
+  return file.str();
+}
+
+TGeoManager *
+PHGeomUtility::ImportFromCache(const std::string &cache_file)
+{
+  if (cache_file.empty()) return nullptr;
+  if (access(cache_file.c_str(), R_OK) != 0) return nullptr;
+
+  TGeoManager *tgeo = TGeoManager::Import(cache_file.c_str());
+  if (!tgeo)
+  {
+    cout << __PRETTY_FUNCTION__ << " - Warning - failed to import cached geometry "
+         << cache_file << ", rebuilding it" << endl;
+    return nullptr;
+  }
+  if (not tgeo->IsClosed())
+    tgeo->CloseGeometry();
+
+  if (GetVerbosity() > 0)
+    cout << __PRETTY_FUNCTION__ << " - imported closed geometry from " << cache_file << endl;
+
+  return tgeo;
+}
+
+void PHGeomUtility::ExportToCache(TGeoManager *tgeo, const std::string &cache_file)
+{
+  if (cache_file.empty()) return;
+
+  assert(tgeo);
+  if (not tgeo->IsClosed())
+    tgeo->CloseGeometry();
+
+  // write under a name of this process and rename, so that jobs sharing
+  // the cache never see a partial file
+  ostringstream tmp_file;
+  tmp_file << cache_file << "." << ::getpid() << ".root";
+
+  if (tgeo->Export(tmp_file.str().c_str()) and
+      rename(tmp_file.str().c_str(), cache_file.c_str()) == 0)
+  {
+    if (GetVerbosity() > 0)
+      cout << __PRETTY_FUNCTION__ << " - saved closed geometry to " << cache_file << endl;
+  }
+  else
+  {
+    cout << __PRETTY_FUNCTION__ << " - Warning - failed to save geometry to cache file "
+         << cache_file << endl;
+    RemoveGeometryFile(tmp_file.str());
+  }
+}
+
+void PHGeomUtility::SetGeometryCacheDir(const std::string &dir)
+{
+  recoConsts *rc = recoConsts::instance();
+  rc->set_CharFlag("PHGEOMETRY_CACHE_DIR", dir);
+}
+
+std::string PHGeomUtility::GetGeometryCacheDir()
+{
+  recoConsts *rc = recoConsts::instance();
+  if (rc->FlagExist("PHGEOMETRY_CACHE_DIR"))
+    return rc->get_CharFlag("PHGEOMETRY_CACHE_DIR");
+  else
+    return "";
+}
+
 //! Verbosity for geometry IO like, TGeoMangers
 void PHGeomUtility::SetVerbosity(int v)
 {
@@ -1,6 +1,7 @@
 #ifndef PHGEOMETRY_PHGEOMUTILITY_H
 #define PHGEOMETRY_PHGEOMUTILITY_H
 
+#include <cstddef>
 #include <string>
 
 class PHCompositeNode;
@@ -48,7 +49,8 @@ class PHGeomUtility
 
   //! Make a name for tmp geometry file
   //! Geometry files gain a size of ~10MB and it used in translation from Geant4 to DST format.
-  //! This tmp file should be on a local file system (/tmp/) and write/deletable
+  //! This tmp file should be on a local file system and write/deletable.
+  //! The memory backed /dev/shm/ is used when available, /tmp/ otherwise
   static std::string
   GenerateGeometryFileName(const std::string &filename_extension = "gdml");
 
@@ -56,6 +58,16 @@ class PHGeomUtility
   static bool
   RemoveGeometryFile(const std::string &file_name);
 
+  //! Local directory of closed TGeoManager ROOT files, keyed by a hash of the
+  //! geometry source (imported file or DST geometry node).
+  //! With a cache, ImportGeomFile and LoadFromIONode load the closed and
+  //! voxelized geometry instead of parsing and voxelizing it again.
+  //! Empty (default) disables the cache
+  static void SetGeometryCacheDir(const std::string &dir);
+
+  //! Local directory of closed TGeoManager ROOT files, empty if disabled
+  static std::string GetGeometryCacheDir();
+
   //! Verbosity for geometry IO like, TGeoMangers
   static void SetVerbosity(int v);
 
@@ -77,6 +89,18 @@ class PHGeomUtility
   }
 
  private:
+  //! cached closed TGeoManager for a geometry source hash, empty if the cache is disabled
+  static std::string
+  GetTGeoCacheFile(const size_t source_hash);
+
+  //! import a closed TGeoManager from the cache, nullptr if it is not there
+  static TGeoManager *
+  ImportFromCache(const std::string &cache_file);
+
+  //! write a closed TGeoManager to the cache
+  static void
+  ExportToCache(TGeoManager *tgeo, const std::string &cache_file);
+
 #if defined(__CINT__) && !defined(__CLING__)
   PHGeomUtility()
   {
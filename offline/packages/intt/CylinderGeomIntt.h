@@ -100,6 +100,18 @@ class CylinderGeomIntt : public PHG4CylinderGeom
     return m_OffsetRot;
   }
 
+  //! number of strips in phi (y) of a sensor
+  int get_nstrips_phi_cell() const
+  {
+    return m_NStripsPhiCell;
+  }
+
+  //! number of strips in z of the sensors at this ladder z index (type A or B)
+  int get_nstrips_z_sensor(const int segment_z_bin) const
+  {
+    return m_NStripsZSensor[segment_z_bin % 2];
+  }
+
  protected:
   int m_Layer;
   int m_NStripsPhiCell;
@@ -28,16 +28,13 @@
 #include <TMatrixT.h>                               // for TMatrixT, operator*
 #include <TMatrixTUtils.h>                          // for TMatrixTRow
 
-#include <boost/graph/adjacency_list.hpp>
-#include <boost/graph/connected_components.hpp>
-
+#include <algorithm>
 #include <array>
 #include <cmath>
 #include <iostream>
 #include <set>
 #include <vector>                                   // for vector
 
-using namespace boost;
 using namespace std;
 
 namespace
@@ -46,6 +43,41 @@ namespace
   /// convenience square method
   template<class T>
     inline constexpr T square( const T& x ) { return x*x; }
+
+  /// disjoint set forest over the hit indices of one hitset.
+  /// The root of a set is always its smallest index.
+  class HitDisjointSet
+  {
+   public:
+    explicit HitDisjointSet(const unsigned int n)
+      : m_parent(n)
+    {
+      for (unsigned int i = 0; i < n; ++i) m_parent[i] = i;
+    }
+
+    unsigned int find(unsigned int i)
+    {
+      while (m_parent[i] != i)
+      {
+        m_parent[i] = m_parent[m_parent[i]];
+        i = m_parent[i];
+      }
+      return i;
+    }
+
+    void unite(const unsigned int i, const unsigned int j)
+    {
+      const unsigned int ri = find(i);
+      const unsigned int rj = find(j);
+      if (ri < rj)
+        m_parent[rj] = ri;
+      else if (rj < ri)
+        m_parent[ri] = rj;
+    }
+
+   private:
+    std::vector<unsigned int> m_parent;
+  };
 }
 
 bool InttClusterizer::ladder_are_adjacent( const std::pair<TrkrDefs::hitkey, TrkrHit*> &lhs, const std::pair<TrkrDefs::hitkey, TrkrHit*> &rhs, const int layer)
@@ -72,6 +104,49 @@ bool InttClusterizer::ladder_are_adjacent( const std::pair<TrkrDefs::hitkey, Trk
   return false;
 }
 
+vector<int> InttClusterizer::find_components(const vector<pair<TrkrDefs::hitkey, TrkrHit*> > &hitvec, const int layer)
+{
+  // hits are ordered by hitkey, which is (col << 16 | row), so all
+  // neighbours with a larger key than hit i are found by binary search
+  // among (col, row+1) and (col+1, row-1 .. row+1)
+  HitDisjointSet clusters(hitvec.size());
+  auto find_hit = [&hitvec](const TrkrDefs::hitkey key) {
+    auto iter = std::lower_bound(hitvec.begin(), hitvec.end(), key,
+                                 [](const std::pair<TrkrDefs::hitkey, TrkrHit*> &hit, const TrkrDefs::hitkey k) { return hit.first < k; });
+    return (iter != hitvec.end() && iter->first == key) ? int(iter - hitvec.begin()) : -1;
+  };
+
+  const bool zclustering = get_z_clustering(layer);
+  for (unsigned int i = 0; i < hitvec.size(); i++)
+  {
+    const int col = InttDefs::getCol(hitvec[i].first);
+    const int row = InttDefs::getRow(hitvec[i].first);
+
+    std::array<std::pair<int, int>, 4> neighbours = {{ {col, row + 1}, {col + 1, row - 1}, {col + 1, row}, {col + 1, row + 1} }};
+    const unsigned int nneighbours = zclustering ? neighbours.size() : 1;
+    for (unsigned int n = 0; n < nneighbours; ++n)
+    {
+      if (neighbours[n].second < 0) continue;
+      const int j = find_hit(InttDefs::genHitKey(neighbours[n].first, neighbours[n].second));
+      if (j >= 0 && ladder_are_adjacent(hitvec[i], hitvec[j], layer))
+        clusters.unite(i, j);
+    }
+  }
+
+  // number the clusters in the order of their first hit, which is the
+  // numbering boost::connected_components gave them
+  std::vector<int> component(hitvec.size());
+  std::vector<int> cluster_number(hitvec.size(), -1);
+  int ncluster = 0;
+  for (unsigned int i = 0; i < hitvec.size(); i++)
+  {
+    const unsigned int root = clusters.find(i);
+    if (cluster_number[root] < 0) cluster_number[root] = ncluster++;
+    component[i] = cluster_number[root];
+  }
+  return component;
+}
+
 InttClusterizer::InttClusterizer(const string& name,
                                  unsigned int min_layer,
                                  unsigned int max_layer)
@@ -84,6 +159,10 @@ InttClusterizer::InttClusterizer(const string& name,
   , _make_z_clustering()
   , _make_e_weights()
 {
+  DeclareInputNode("TRKR_HITSET");
+  DeclareInputNode("CYLINDERGEOM_INTT");
+  DeclareSharedOutputNode("TRKR_CLUSTER");
+  DeclareSharedOutputNode("TRKR_CLUSTERHITASSOC");
 }
 
 int InttClusterizer::InitRun(PHCompositeNode* topNode)
@@ -277,6 +356,11 @@ void InttClusterizer::ClusterLadderCells(PHCompositeNode* topNode)
   //-----------
 
   // loop over the InttHitSet objects
+  // the clusters and associations of this detector, the containers are
+  // filled by other clusterizers at the same time with module scheduling
+  TrkrClusterContainer::Map newclusters;
+  TrkrClusterHitAssoc::Map newassocs;
+
   TrkrHitSetContainer::ConstRange hitsetrange =
       m_hits->getHitSets(TrkrDefs::TrkrId::inttId);
   for (TrkrHitSetContainer::ConstIterator hitsetitr = hitsetrange.first;
@@ -313,29 +397,8 @@ void InttClusterizer::ClusterLadderCells(PHCompositeNode* topNode)
     if (Verbosity() > 2)
       cout << "hitvec.size(): " << hitvec.size() << endl;
     
-    typedef adjacency_list<vecS, vecS, undirectedS> Graph;
-    Graph G;
-    
-    // Find adjacent strips
-    for (unsigned int i = 0; i < hitvec.size(); i++)
-      {
-	for (unsigned int j = i + 1; j < hitvec.size(); j++)
-	  {
-	    if (ladder_are_adjacent(hitvec[i], hitvec[j], layer))
-	      {
-		add_edge(i, j, G);
-	      }
-	  }
-	
-	add_edge(i, i, G);
-      }
-
-    // Find the connections between the vertices of the graph (vertices are the rawhits,
-    // connections are made when they are adjacent to one another)
-    vector<int> component(num_vertices(G));
-
-    // this is the actual clustering, performed by boost
-    connected_components(G, &component[0]);
+    // do the clustering
+    vector<int> component = find_components(hitvec, layer);
 
     // Loop over the components(hit cells) compiling a list of the
     // unique connected groups (ie. clusters).
@@ -358,9 +421,11 @@ void InttClusterizer::ClusterLadderCells(PHCompositeNode* topNode)
 	     multimap<int, std::pair<TrkrDefs::hitkey, TrkrHit*>>::iterator>  clusrange = clusters.equal_range(clusid);
 	multimap<int, std::pair<TrkrDefs::hitkey, TrkrHit*>>::iterator mapiter = clusrange.first;
 	
-	// make the cluster directly in the node tree
+	// collect the clusters, they are added to the node tree in one go at the end
 	TrkrDefs::cluskey ckey = InttDefs::genClusKey(hitset->getHitSetKey(), clusid);
-	TrkrClusterv1 *clus = static_cast<TrkrClusterv1 *>((m_clusterlist->findOrAddCluster(ckey))->second);
+	TrkrClusterv1 *clus = new TrkrClusterv1();
+	clus->setClusKey(ckey);
+	newclusters.push_back(make_pair(ckey, clus));
 
 	if (Verbosity() > 2)
 	  cout << "Filling cluster with key " << ckey << endl;
@@ -417,7 +482,7 @@ void InttClusterizer::ClusterLadderCells(PHCompositeNode* topNode)
 	    ++nhits;
 
 	    // add this cluster-hit association to the association map of (clusterkey,hitkey)
-	    m_clusterhitassoc->addAssoc(ckey, mapiter->second.first);
+	    newassocs.push_back(make_pair(ckey, mapiter->second.first));
 
 	    if (Verbosity() > 2) cout << "     nhits = " << nhits << endl;
 	    if (Verbosity() > 2)
@@ -557,6 +622,8 @@ void InttClusterizer::ClusterLadderCells(PHCompositeNode* topNode)
       } // end loop over cluster ID's
   }  // end loop over hitsets
 
+  m_clusterlist->addClusters(newclusters);
+  m_clusterhitassoc->addAssocs(newassocs);
 
   if(Verbosity() > 1)
     {
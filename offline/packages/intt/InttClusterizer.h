@@ -9,6 +9,7 @@
 #include <map>
 #include <string>
 #include <utility>
+#include <vector>
 
 class PHCompositeNode;
 class TrkrHitSetContainer;
@@ -35,6 +36,9 @@ class InttClusterizer : public SubsysReco
   //! end of process
   int End(PHCompositeNode *topNode) { return 0; }
 
+  //! clusters are added to the shared containers in one locked call, the debug printout reads them
+  bool ThreadSafe() const { return Verbosity() == 0; }
+
   //! set an energy requirement relative to the thickness MIP expectation
   void set_threshold(const float fraction_of_mip)
   {
@@ -70,6 +74,8 @@ class InttClusterizer : public SubsysReco
 
  private:
   bool ladder_are_adjacent(const std::pair<TrkrDefs::hitkey, TrkrHit*> &lhs, const std::pair<TrkrDefs::hitkey, TrkrHit*> &rhs, const int layer);
+  //! groups of adjacent strips, component number for every hit
+  std::vector<int> find_components(const std::vector<std::pair<TrkrDefs::hitkey, TrkrHit*> > &hitvec, const int layer);
 
   void CalculateLadderThresholds(PHCompositeNode *topNode);
   void ClusterLadderCells(PHCompositeNode *topNode);
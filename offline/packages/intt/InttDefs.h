@@ -32,35 +32,33 @@ static const unsigned int kBitShiftLadderPhiId __attribute__((unused)) = 0;
 static const unsigned int kBitShiftCol __attribute__((unused)) = 16;
 static const unsigned int kBitShiftRow __attribute__((unused)) = 0;
 
-#endif  // __CINT__
-
 /**
    * @brief Get the ladder id from hitsetkey
    * @param[in] hitsetkey
    * @param[out] ladder id
    */
-uint8_t getLadderZId(TrkrDefs::hitsetkey key);
+constexpr uint8_t getLadderZId(const TrkrDefs::hitsetkey key) { return key >> kBitShiftLadderZId; }
 
 /**
    * @brief Get the ladder id from cluskey
    * @param[in] cluskey
    * @param[out] ladder id
    */
-uint8_t getLadderZId(TrkrDefs::cluskey key);
+constexpr uint8_t getLadderZId(const TrkrDefs::cluskey key) { return getLadderZId(TrkrDefs::getHitSetKeyFromClusKey(key)); }
 
 /**
    * @brief Get the sensor id from hitsetkey
    * @param[in] hitsetkey
    * @param[out] sensor id
    */
-uint8_t getLadderPhiId(TrkrDefs::hitsetkey key);
+constexpr uint8_t getLadderPhiId(const TrkrDefs::hitsetkey key) { return key >> kBitShiftLadderPhiId; }
 
 /**
    * @brief Get the sensor id from cluskey
    * @param[in] cluskey
    * @param[out] sensor id
    */
-uint8_t getLadderPhiId(TrkrDefs::cluskey key);
+constexpr uint8_t getLadderPhiId(const TrkrDefs::cluskey key) { return getLadderPhiId(TrkrDefs::getHitSetKeyFromClusKey(key)); }
 
 /**
    * @brief Generate a hitkey from a strip id
@@ -73,16 +71,19 @@ uint8_t getLadderPhiId(TrkrDefs::cluskey key);
    * @param[in] hitkey
    * @param[out] column index
    */
-uint16_t getCol(TrkrDefs::hitkey key);
+constexpr uint16_t getCol(const TrkrDefs::hitkey key) { return key >> kBitShiftCol; }
 
 /**
    * @brief Get the row index from hitkey
    * @param[in] hitkey
    * @param[out] row index
    */
-uint16_t getRow(TrkrDefs::hitkey key);
+constexpr uint16_t getRow(const TrkrDefs::hitkey key) { return key >> kBitShiftRow; }
 
- TrkrDefs::hitkey genHitKey(const uint16_t col, const uint16_t row);
+constexpr TrkrDefs::hitkey genHitKey(const uint16_t col, const uint16_t row)
+{
+  return (static_cast<TrkrDefs::hitkey>(col) << kBitShiftCol) | (static_cast<TrkrDefs::hitkey>(row) << kBitShiftRow);
+}
 
 /**
    * @brief Generate a hitsetkey for the intt
@@ -94,7 +95,12 @@ uint16_t getRow(TrkrDefs::hitkey key);
    * Generate a hitsetkey for the intt. The tracker id is known
    * implicitly and used in the function.
    */
-TrkrDefs::hitsetkey genHitSetKey(const uint8_t lyr, const uint8_t ladder_z_index, const uint8_t ladder_phi_index);
+constexpr TrkrDefs::hitsetkey genHitSetKey(const uint8_t lyr, const uint8_t ladder_z_index, const uint8_t ladder_phi_index)
+{
+  return TrkrDefs::genHitSetKey(TrkrDefs::TrkrId::inttId, lyr) |
+         (static_cast<TrkrDefs::hitsetkey>(ladder_z_index) << kBitShiftLadderZId) |
+         (static_cast<TrkrDefs::hitsetkey>(ladder_phi_index) << kBitShiftLadderPhiId);
+}
 
 /**
    * @brief Generate a cluster key from indeces 
@@ -104,7 +110,10 @@ TrkrDefs::hitsetkey genHitSetKey(const uint8_t lyr, const uint8_t ladder_z_index
    * @param[in] clusid Cluster id
    * @param[out] cluskey
    */
-TrkrDefs::cluskey genClusKey(const uint8_t lyr, const uint8_t LadderZId, const uint8_t LadderPhiId, const uint32_t clusid);
+constexpr TrkrDefs::cluskey genClusKey(const uint8_t lyr, const uint8_t LadderZId, const uint8_t LadderPhiId, const uint32_t clusid)
+{
+  return TrkrDefs::genClusKey(genHitSetKey(lyr, LadderZId, LadderPhiId), clusid);
+}
 
 /**
    * @brief Generate a cluster key using a hitsetkey and cluster id
@@ -112,7 +121,27 @@ TrkrDefs::cluskey genClusKey(const uint8_t lyr, const uint8_t LadderZId, const u
    * @param[in] clusid Cluster id
    * @param[out] cluskey
    */
-TrkrDefs::cluskey genClusKey(const TrkrDefs::hitsetkey hskey, const uint32_t clusid);
+constexpr TrkrDefs::cluskey genClusKey(const TrkrDefs::hitsetkey hskey, const uint32_t clusid) { return TrkrDefs::genClusKey(hskey, clusid); }
+
+/**
+   * @brief hitsetkey of the intt with its ladder z and phi id
+   */
+class HitSetKey : public TrkrDefs::TypedHitSetKey<TrkrDefs::inttId>
+{
+ public:
+  constexpr explicit HitSetKey(const TrkrDefs::hitsetkey key)
+    : TrkrDefs::TypedHitSetKey<TrkrDefs::inttId>(key)
+  {
+  }
+  constexpr HitSetKey(const uint8_t lyr, const uint8_t ladderZId, const uint8_t ladderPhiId)
+    : TrkrDefs::TypedHitSetKey<TrkrDefs::inttId>(genHitSetKey(lyr, ladderZId, ladderPhiId))
+  {
+  }
+  constexpr uint8_t ladderZId() const { return getLadderZId(m_Key); }
+  constexpr uint8_t ladderPhiId() const { return getLadderPhiId(m_Key); }
+};
+
+#endif  // __CINT__
 
 }  // namespace InttDefs
 
@@ -8,6 +8,8 @@
 
 #include <trackbase/TrkrHit.h>  // for TrkrHit
 
+#include <phool/PHObjectPool.h>
+
 InttHit::InttHit()
   : TrkrHit()
 {
@@ -29,3 +31,13 @@ int InttHit::isValid() const
   // valid if the key is not equal to the default value
   return 0;
 }
+
+void *InttHit::operator new(size_t size)
+{
+  return PHObjectPool<InttHit>::allocate(size);
+}
+
+void InttHit::operator delete(void *ptr, size_t size)
+{
+  PHObjectPool<InttHit>::deallocate(ptr, size);
+}
@@ -9,6 +9,7 @@
 
 #include <trackbase/TrkrHit.h>
 
+#include <cstddef>
 #include <iostream>
 
 /**
@@ -25,7 +26,14 @@ class InttHit : public TrkrHit
   //! dtor
   virtual ~InttHit(){};
 
+#if !defined(__CINT__) || defined(__CLING__)
+  //! storage is recycled through PHObjectPool
+  static void *operator new(size_t size);
+  static void operator delete(void *ptr, size_t size);
+#endif
+
   // PHObject virtual overloads
+  virtual PHObject* CloneMe() const { return new InttHit(*this); }
   virtual void identify(std::ostream& os = std::cout) const;
   virtual void Reset();
   virtual int isValid() const;
@@ -177,7 +177,7 @@ int CopyAndSubtractJets::process_event(PHCompositeNode *topNode)
     new_jet->set_e(new_total_e);
     new_jet->set_id(ijet);
 
-    sub_jets->insert(new_jet);
+    new_jet = sub_jets->insert(new_jet);
 
     if (Verbosity() > 1 && this_pt > 5)
     {
@@ -0,0 +1,575 @@
+#include "DetermineAndSubtractTowers.h"
+
+#include "TowerBackground.h"
+#include "TowerBackgroundv1.h"
+
+#include <calobase/RawTower.h>
+#include <calobase/RawTowerContainer.h>
+#include <calobase/RawTowerDefs.h>
+#include <calobase/RawTowerGeom.h>
+#include <calobase/RawTowerGeomContainer.h>
+#include <calobase/RawTowerv1.h>
+
+#include <g4jets/Jet.h>
+#include <g4jets/JetMap.h>
+
+#include <g4main/PHG4Particle.h>
+#include <g4main/PHG4TruthInfoContainer.h>
+
+#include <fun4all/Fun4AllReturnCodes.h>
+#include <fun4all/SubsysReco.h>
+
+#include <phool/PHCompositeNode.h>
+#include <phool/PHIODataNode.h>
+#include <phool/PHNode.h>
+#include <phool/PHNodeIterator.h>
+#include <phool/PHObject.h>
+#include <phool/getClass.h>
+#include <phool/phool.h>
+
+#include <TLorentzVector.h>
+
+// standard includes
+#include <algorithm>
+#include <cmath>
+#include <cstdlib>
+#include <iostream>
+#include <map>
+#include <utility>
+#include <vector>
+
+DetermineAndSubtractTowers::DetermineAndSubtractTowers(const std::string &name)
+  : SubsysReco(name)
+  , _do_flow(0)
+  , _use_flow_modulation(false)
+  , _v2(0)
+  , _Psi2(0)
+  , _nStrips(0)
+  , _nTowers(0)
+  , _HCAL_NETA(-1)
+  , _HCAL_NPHI(-1)
+  , _backgroundName("TowerBackground_Sub2")
+  , _seedJetName("AntiKt_Tower_HIRecoSeedsSub_r02")
+  , _seed_jet_pt(7.0)
+{
+  _UE.resize(3, std::vector<float>(1, 0));
+}
+
+int DetermineAndSubtractTowers::InitRun(PHCompositeNode *topNode)
+{
+  return CreateNode(topNode);
+}
+
+int DetermineAndSubtractTowers::process_event(PHCompositeNode *topNode)
+{
+  if (Verbosity() > 0)
+    std::cout << "DetermineAndSubtractTowers::process_event: entering with do_flow = " << _do_flow << ", seed pT = " << _seed_jet_pt << ", _use_flow_modulation = " << _use_flow_modulation << std::endl;
+
+  // pull out the tower containers and geometry objects at the start
+  RawTowerContainer *towersEM3 = findNode::getClass<RawTowerContainer>(topNode, "TOWER_CALIB_CEMC");
+  RawTowerContainer *towersIH3 = findNode::getClass<RawTowerContainer>(topNode, "TOWER_CALIB_HCALIN");
+  RawTowerContainer *towersOH3 = findNode::getClass<RawTowerContainer>(topNode, "TOWER_CALIB_HCALOUT");
+
+  RawTowerGeomContainer *geomEM = findNode::getClass<RawTowerGeomContainer>(topNode, "TOWERGEOM_CEMC");
+  RawTowerGeomContainer *geomIH = findNode::getClass<RawTowerGeomContainer>(topNode, "TOWERGEOM_HCALIN");
+  RawTowerGeomContainer *geomOH = findNode::getClass<RawTowerGeomContainer>(topNode, "TOWERGEOM_HCALOUT");
+
+  if (!towersEM3 || !towersIH3 || !towersOH3 || !geomEM || !geomIH || !geomOH)
+  {
+    std::cout << PHWHERE << " missing tower or geometry nodes, aborting event" << std::endl;
+    return Fun4AllReturnCodes::ABORTEVENT;
+  }
+
+  if (Verbosity() > 0)
+  {
+    std::cout << "DetermineAndSubtractTowers::process_event: " << towersEM3->size() << " TOWER_CALIB_CEMC towers" << std::endl;
+    std::cout << "DetermineAndSubtractTowers::process_event: " << towersIH3->size() << " TOWER_CALIB_HCALIN towers" << std::endl;
+    std::cout << "DetermineAndSubtractTowers::process_event: " << towersOH3->size() << " TOWER_CALIB_HCALOUT towers" << std::endl;
+  }
+
+  if (_HCAL_NETA < 0) InitGrid(geomEM, geomIH, geomOH);
+
+  int retval = FindSeeds(topNode);
+  if (retval != Fun4AllReturnCodes::EVENT_OK) return retval;
+
+  // retowered CEMC, IHCal and OHCal energies on the same grid
+  std::fill(_grid_E.begin(), _grid_E.end(), 0);
+  FillGrid(0, towersEM3, _geom[0]);
+  FillGrid(1, towersIH3, _geom[1]);
+  FillGrid(2, towersOH3, _geom[2]);
+
+  retval = DetermineFlow(topNode);
+  if (retval != Fun4AllReturnCodes::EVENT_OK) return retval;
+
+  DetermineUE();
+
+  FillNode(topNode);
+
+  SubtractTowers(topNode);
+
+  if (Verbosity() > 0) std::cout << "DetermineAndSubtractTowers::process_event: exiting" << std::endl;
+
+  return Fun4AllReturnCodes::EVENT_OK;
+}
+
+void DetermineAndSubtractTowers::InitGrid(RawTowerGeomContainer *geomEM, RawTowerGeomContainer *geomIH, RawTowerGeomContainer *geomOH)
+{
+  _HCAL_NETA = geomIH->get_etabins();
+  _HCAL_NPHI = geomIH->get_phibins();
+  const int nbins = _HCAL_NETA * _HCAL_NPHI;
+
+  _UE[0].resize(_HCAL_NETA, 0);
+  _UE[1].resize(_HCAL_NETA, 0);
+  _UE[2].resize(_HCAL_NETA, 0);
+
+  _grid_E.assign(3 * nbins, 0);
+  _grid_excluded.assign(nbins, 0);
+  _FULLCALOFLOW_PHI_E.assign(_HCAL_NPHI, 0);
+
+  _eta_center.resize(_HCAL_NETA);
+  for (int eta = 0; eta < _HCAL_NETA; eta++) _eta_center[eta] = geomIH->get_etacenter(eta);
+  _phi_center.resize(_HCAL_NPHI);
+  for (int phi = 0; phi < _HCAL_NPHI; phi++) _phi_center[phi] = geomIH->get_phicenter(phi);
+
+  // the CEMC is retowered to the IHCal binning, the OHCal uses its own
+  RawTowerGeomContainer *geom[3] = {geomEM, geomIH, geomOH};
+  RawTowerGeomContainer *bingeom[3] = {geomIH, geomIH, geomOH};
+  for (int layer = 0; layer < 3; layer++)
+  {
+    _geom[layer].build(geom[layer]);
+    _tower_bin[layer].assign(_geom[layer].size(), -1);
+    for (unsigned int i = 0; i < _geom[layer].size(); i++)
+    {
+      RawTowerGeom *tower_geom = geom[layer]->get_tower_geometry(_geom[layer].get_key(i));
+      int this_etabin = bingeom[layer]->get_etabin(tower_geom->get_eta());
+      int this_phibin = bingeom[layer]->get_phibin(tower_geom->get_phi());
+      if (this_etabin < 0 || this_etabin >= _HCAL_NETA || this_phibin < 0 || this_phibin >= _HCAL_NPHI) continue;
+      _tower_bin[layer][i] = this_etabin * _HCAL_NPHI + this_phibin;
+    }
+  }
+
+  // the subtracted towers are keyed like in SubtractTowers, CEMC and IHCal
+  // towers with the HCALIN id, OHCal towers with the HCALOUT id
+  _tower_phi.assign(3 * nbins, 0);
+  for (int layer = 0; layer < 3; layer++)
+  {
+    RawTowerDefs::CalorimeterId caloid = (layer == 2 ? RawTowerDefs::CalorimeterId::HCALOUT : RawTowerDefs::CalorimeterId::HCALIN);
+    for (int eta = 0; eta < _HCAL_NETA; eta++)
+    {
+      for (int phi = 0; phi < _HCAL_NPHI; phi++)
+      {
+        RawTowerGeom *tower_geom = bingeom[layer]->get_tower_geometry(RawTowerDefs::encode_towerid(caloid, eta, phi));
+        _tower_phi[(layer * _HCAL_NETA + eta) * _HCAL_NPHI + phi] = (tower_geom ? tower_geom->get_phi() : _phi_center[phi]);
+      }
+    }
+  }
+
+  if (Verbosity() > 0)
+  {
+    std::cout << "DetermineAndSubtractTowers::InitGrid: setting number of towers in eta / phi: " << _HCAL_NETA << " / " << _HCAL_NPHI << std::endl;
+  }
+}
+
+void DetermineAndSubtractTowers::FillGrid(int layer, RawTowerContainer *towers, const RawTowerGeomTable &geom)
+{
+  float *grid = &_grid_E[layer * _HCAL_NETA * _HCAL_NPHI];
+  const std::vector<int> &tower_bin = _tower_bin[layer];
+
+  RawTowerContainer::ConstRange begin_end = towers->getTowers();
+  for (RawTowerContainer::ConstIterator rtiter = begin_end.first; rtiter != begin_end.second; ++rtiter)
+  {
+    const int i = geom.find(rtiter->first);
+    if (i < 0 || tower_bin[i] < 0) continue;
+
+    // summed as float, like RetowerCEMC
+    float this_E = rtiter->second->get_energy();
+    grid[tower_bin[i]] += this_E;
+  }
+}
+
+int DetermineAndSubtractTowers::FindSeeds(PHCompositeNode *topNode)
+{
+  // clear seed eta/phi positions
+  _seed_eta.resize(0);
+  _seed_phi.resize(0);
+
+  // seeds are the jets which have pT above the cut after the first
+  // background subtraction
+  if (!_seedJetName.empty())
+  {
+    JetMap *reco2_jets = findNode::getClass<JetMap>(topNode, _seedJetName);
+    if (!reco2_jets)
+    {
+      std::cout << PHWHERE << " missing seed jets " << _seedJetName << ", aborting event" << std::endl;
+      return Fun4AllReturnCodes::ABORTEVENT;
+    }
+
+    if (Verbosity() > 1)
+      std::cout << "DetermineAndSubtractTowers::FindSeeds: examining possible seeds ... " << std::endl;
+
+    for (JetMap::Iter iter = reco2_jets->begin(); iter != reco2_jets->end(); ++iter)
+    {
+      Jet *this_jet = iter->second;
+
+      float this_pt = this_jet->get_pt();
+      float this_phi = this_jet->get_phi();
+      float this_eta = this_jet->get_eta();
+
+      if (this_jet->get_pt() < _seed_jet_pt)
+      {
+        // mark that this jet was considered but not used as a seed
+        this_jet->set_property(Jet::PROPERTY::prop_SeedItr, 0.0);
+
+        continue;
+      }
+
+      _seed_eta.push_back(this_eta);
+      _seed_phi.push_back(this_phi);
+
+      // set second iteration seed property
+      this_jet->set_property(Jet::PROPERTY::prop_SeedItr, 2.0);
+
+      if (Verbosity() > 1)
+        std::cout << "DetermineAndSubtractTowers::FindSeeds: --> adding seed at eta / phi = " << this_eta << " / " << this_phi << " ( R=0.2 jet with pt = " << this_pt << " ) " << std::endl;
+    }
+  }
+
+  // the exclusion does not depend on the layer, mark the bins once
+  for (int eta = 0; eta < _HCAL_NETA; eta++)
+  {
+    for (int phi = 0; phi < _HCAL_NPHI; phi++)
+    {
+      float this_eta = _eta_center[eta];
+      float this_phi = _phi_center[phi];
+
+      bool isExcluded = false;
+
+      for (unsigned int iseed = 0; iseed < _seed_eta.size(); iseed++)
+      {
+        float deta = this_eta - _seed_eta[iseed];
+        float dphi = this_phi - _seed_phi[iseed];
+        if (dphi > 3.14159) dphi -= 2 * 3.14159;
+        if (dphi < -3.14159) dphi += 2 * 3.14159;
+        float dR = sqrt(pow(deta, 2) + pow(dphi, 2));
+        if (dR < 0.4)
+        {
+          isExcluded = true;
+          break;
+        }
+      }
+
+      _grid_excluded[eta * _HCAL_NPHI + phi] = isExcluded;
+    }
+  }
+
+  return Fun4AllReturnCodes::EVENT_OK;
+}
+
+int DetermineAndSubtractTowers::DetermineFlow(PHCompositeNode *topNode)
+{
+  _Psi2 = 0;
+  _v2 = 0;
+  _nStrips = 0;
+
+  if (_do_flow == 0)
+  {
+    if (Verbosity() > 0)
+    {
+      std::cout << "DetermineAndSubtractTowers::DetermineFlow: flow not enabled, setting Psi2 = " << _Psi2 << " ( " << _Psi2 / 3.14159 << " * pi ) , v2 = " << _v2 << std::endl;
+    }
+    return Fun4AllReturnCodes::EVENT_OK;
+  }
+
+  std::fill(_FULLCALOFLOW_PHI_E.begin(), _FULLCALOFLOW_PHI_E.end(), 0);
+
+  // if even a single tower in an eta strip is excluded, we
+  // can't use the strip for flow determination
+  std::vector<char> strip_usable(_HCAL_NETA, 1);
+  for (int eta = 0; eta < _HCAL_NETA; eta++)
+  {
+    for (int phi = 0; phi < _HCAL_NPHI; phi++)
+    {
+      if (_grid_excluded[eta * _HCAL_NPHI + phi]) strip_usable[eta] = 0;
+    }
+  }
+
+  // check for the case when every tower is excluded
+  int nStripsAvailableForFlow = 0;
+  int nStripsUnavailableForFlow = 0;
+
+  for (int layer = 0; layer < 3; layer++)
+  {
+    for (int eta = 0; eta < _HCAL_NETA; eta++)
+    {
+      if (!strip_usable[eta])
+      {
+        nStripsUnavailableForFlow++;
+        continue;
+      }
+      nStripsAvailableForFlow++;
+
+      const float *strip_E = &_grid_E[(layer * _HCAL_NETA + eta) * _HCAL_NPHI];
+      for (int phi = 0; phi < _HCAL_NPHI; phi++)
+      {
+        _FULLCALOFLOW_PHI_E[phi] += strip_E[phi];
+      }
+    }
+  }
+
+  // flow determination
+
+  float Q_x = 0;
+  float Q_y = 0;
+  float E = 0;
+
+  if (Verbosity() > 0)
+    std::cout << "DetermineAndSubtractTowers::DetermineFlow: # of strips (summed over layers) available / unavailable for flow determination: " << nStripsAvailableForFlow << " / " << nStripsUnavailableForFlow << std::endl;
+
+  if (nStripsAvailableForFlow > 0)
+  {
+    for (int iphi = 0; iphi < _HCAL_NPHI; iphi++)
+    {
+      E += _FULLCALOFLOW_PHI_E[iphi];
+      Q_x += _FULLCALOFLOW_PHI_E[iphi] * cos(2 * _phi_center[iphi]);
+      Q_y += _FULLCALOFLOW_PHI_E[iphi] * sin(2 * _phi_center[iphi]);
+    }
+
+    if (_do_flow == 1)
+    {
+      _Psi2 = atan2(Q_y, Q_x) / 2.0;
+    }
+    else if (_do_flow == 2)
+    {
+      PHG4TruthInfoContainer *truthinfo = findNode::getClass<PHG4TruthInfoContainer>(topNode, "G4TruthInfo");
+
+      if (!truthinfo)
+      {
+        std::cout << "DetermineAndSubtractTowers::DetermineFlow: FATAL , G4TruthInfo does not exist , cannot extract truth flow with do_flow = " << _do_flow << std::endl;
+        return -1;
+      }
+
+      PHG4TruthInfoContainer::Range range = truthinfo->GetPrimaryParticleRange();
+
+      float Hijing_Qx = 0, Hijing_Qy = 0;
+
+      for (PHG4TruthInfoContainer::ConstIterator iter = range.first; iter != range.second; ++iter)
+      {
+        PHG4Particle *g4particle = iter->second;
+
+        if (truthinfo->isEmbeded(g4particle->get_track_id()) != 0) continue;
+
+        TLorentzVector t;
+        t.SetPxPyPzE(g4particle->get_px(), g4particle->get_py(), g4particle->get_pz(), g4particle->get_e());
+
+        float truth_pt = t.Pt();
+        if (truth_pt < 0.4) continue;
+        float truth_eta = t.Eta();
+        if (fabs(truth_eta) > 1.1) continue;
+        float truth_phi = t.Phi();
+
+        Hijing_Qx += truth_pt * cos(2 * truth_phi);
+        Hijing_Qy += truth_pt * sin(2 * truth_phi);
+      }
+
+      _Psi2 = atan2(Hijing_Qy, Hijing_Qx) / 2.0;
+
+      if (Verbosity() > 0)
+        std::cout << "DetermineAndSubtractTowers::DetermineFlow: flow extracted from Hijing truth particles, setting Psi2 = " << _Psi2 << " ( " << _Psi2 / 3.14159 << " * pi ) " << std::endl;
+    }
+
+    // determine v2 from calo regardless of origin of Psi2
+    double sum_cos2dphi = 0;
+    for (int iphi = 0; iphi < _HCAL_NPHI; iphi++)
+    {
+      sum_cos2dphi += _FULLCALOFLOW_PHI_E[iphi] * cos(2 * (_phi_center[iphi] - _Psi2));
+    }
+
+    _v2 = sum_cos2dphi / E;
+
+    _nStrips = nStripsAvailableForFlow;
+  }
+  else
+  {
+    if (Verbosity() > 0)
+      std::cout << "DetermineAndSubtractTowers::DetermineFlow: no full strips available for flow modulation, setting v2 and Psi = 0" << std::endl;
+  }
+
+  if (Verbosity() > 0)
+  {
+    std::cout << "DetermineAndSubtractTowers::DetermineFlow: unnormalized Q vector (Qx, Qy) = ( " << Q_x << ", " << Q_y << " ) with Sum E_i = " << E << std::endl;
+    std::cout << "DetermineAndSubtractTowers::DetermineFlow: Psi2 = " << _Psi2 << " ( " << _Psi2 / 3.14159 << " * pi " << (_do_flow == 2 ? "from Hijing " : "") << ") , v2 = " << _v2 << " ( using " << _nStrips << " ) " << std::endl;
+  }
+
+  return Fun4AllReturnCodes::EVENT_OK;
+}
+
+void DetermineAndSubtractTowers::DetermineUE()
+{
+  _nTowers = 0;  // store how many towers were used to determine bkg
+
+  for (int layer = 0; layer < 3; layer++)
+  {
+    for (int eta = 0; eta < _HCAL_NETA; eta++)
+    {
+      const float *strip_E = &_grid_E[(layer * _HCAL_NETA + eta) * _HCAL_NPHI];
+      const char *strip_excluded = &_grid_excluded[eta * _HCAL_NPHI];
+
+      float total_E = 0;
+      int total_tower = 0;
+
+      for (int phi = 0; phi < _HCAL_NPHI; phi++)
+      {
+        if (strip_excluded[phi]) continue;
+
+        float this_phi = _phi_center[phi];
+        total_E += strip_E[phi] / (1 + 2 * _v2 * cos(2 * (this_phi - _Psi2)));
+        total_tower++;  // towers in this eta range & layer
+        _nTowers++;     // towers in entire calorimeter
+      }
+
+      _UE[layer][eta] = total_E / total_tower;
+
+      if (Verbosity() > 3)
+      {
+        std::cout << "DetermineAndSubtractTowers::DetermineUE: at layer / eta index = " << layer << " / " << eta << " , total E / total Ntower = " << total_E << " / " << total_tower << " , UE per tower = " << total_E / total_tower << std::endl;
+      }
+    }
+  }
+
+  if (Verbosity() > 0)
+  {
+    for (int layer = 0; layer < 3; layer++)
+    {
+      std::cout << "DetermineAndSubtractTowers::DetermineUE: summary UE in layer " << layer << " : ";
+      for (int eta = 0; eta < _HCAL_NETA; eta++) std::cout << _UE[layer][eta] << " , ";
+      std::cout << std::endl;
+    }
+  }
+}
+
+void DetermineAndSubtractTowers::SubtractTowers(PHCompositeNode *topNode)
+{
+  // these should have already been created during InitRun()
+  RawTowerContainer *sub_towers[3] = {
+      findNode::getClass<RawTowerContainer>(topNode, "TOWER_CALIB_CEMC_RETOWER_SUB1"),
+      findNode::getClass<RawTowerContainer>(topNode, "TOWER_CALIB_HCALIN_SUB1"),
+      findNode::getClass<RawTowerContainer>(topNode, "TOWER_CALIB_HCALOUT_SUB1")};
+
+  for (int layer = 0; layer < 3; layer++)
+  {
+    if (!sub_towers[layer]) continue;
+
+    for (int eta = 0; eta < _HCAL_NETA; eta++)
+    {
+      const int offset = (layer * _HCAL_NETA + eta) * _HCAL_NPHI;
+      for (int phi = 0; phi < _HCAL_NPHI; phi++)
+      {
+        float UE = _UE[layer][eta];
+        if (_use_flow_modulation)
+        {
+          float tower_phi = _tower_phi[offset + phi];
+          UE = UE * (1 + 2 * _v2 * cos(2 * (tower_phi - _Psi2)));
+        }
+
+        RawTower *new_tower = new RawTowerv1();
+        new_tower->set_energy(_grid_E[offset + phi] - UE);
+        sub_towers[layer]->AddTower(eta, phi, new_tower);
+      }
+    }
+  }
+
+  if (Verbosity() > 0)
+  {
+    std::cout << "DetermineAndSubtractTowers::SubtractTowers: filled " << _HCAL_NETA * _HCAL_NPHI << " towers per layer" << std::endl;
+  }
+}
+
+int DetermineAndSubtractTowers::CreateNode(PHCompositeNode *topNode)
+{
+  PHNodeIterator iter(topNode);
+
+  // Looking for the DST node
+  PHCompositeNode *dstNode = dynamic_cast<PHCompositeNode *>(iter.findFirst("PHCompositeNode", "DST"));
+  if (!dstNode)
+  {
+    std::cout << PHWHERE << "DST Node missing, doing nothing." << std::endl;
+    return Fun4AllReturnCodes::ABORTRUN;
+  }
+
+  // store the jet background stuff under a sub-node directory
+  PHCompositeNode *bkgNode = dynamic_cast<PHCompositeNode *>(iter.findFirst("PHCompositeNode", "JETBACKGROUND"));
+  if (!bkgNode)
+  {
+    bkgNode = new PHCompositeNode("JETBACKGROUND");
+    dstNode->addNode(bkgNode);
+  }
+
+  // create the TowerBackground node...
+  TowerBackground *towerbackground = findNode::getClass<TowerBackground>(topNode, _backgroundName);
+  if (!towerbackground)
+  {
+    towerbackground = new TowerBackgroundv1();
+    PHIODataNode<PHObject> *bkgDataNode = new PHIODataNode<PHObject>(towerbackground, _backgroundName, "PHObject");
+    bkgNode->addNode(bkgDataNode);
+  }
+  else
+  {
+    std::cout << PHWHERE << "::ERROR - " << _backgroundName << " pre-exists, but should not" << std::endl;
+    exit(-1);
+  }
+
+  // the subtracted towers, on the same nodes as from SubtractTowers
+  const char *detector[3] = {"CEMC", "HCALIN", "HCALOUT"};
+  const char *tower_node[3] = {"TOWER_CALIB_CEMC_RETOWER_SUB1", "TOWER_CALIB_HCALIN_SUB1", "TOWER_CALIB_HCALOUT_SUB1"};
+  for (int layer = 0; layer < 3; layer++)
+  {
+    PHCompositeNode *detNode = dynamic_cast<PHCompositeNode *>(iter.findFirst("PHCompositeNode", detector[layer]));
+    if (!detNode)
+    {
+      std::cout << PHWHERE << detector[layer] << " Node not found, doing nothing." << std::endl;
+      return Fun4AllReturnCodes::ABORTRUN;
+    }
+
+    RawTowerContainer *test_tower = findNode::getClass<RawTowerContainer>(topNode, tower_node[layer]);
+    if (!test_tower)
+    {
+      if (Verbosity() > 0) std::cout << "DetermineAndSubtractTowers::CreateNode : creating " << tower_node[layer] << " node " << std::endl;
+
+      RawTowerContainer *sub_towers = new RawTowerContainer(layer == 2 ? RawTowerDefs::CalorimeterId::HCALOUT : RawTowerDefs::CalorimeterId::HCALIN);
+      PHIODataNode<PHObject> *towerNode = new PHIODataNode<PHObject>(sub_towers, tower_node[layer], "PHObject");
+      detNode->addNode(towerNode);
+    }
+    else
+    {
+      std::cout << "DetermineAndSubtractTowers::CreateNode : " << tower_node[layer] << " already exists! " << std::endl;
+    }
+  }
+
+  return Fun4AllReturnCodes::EVENT_OK;
+}
+
+void DetermineAndSubtractTowers::FillNode(PHCompositeNode *topNode)
+{
+  TowerBackground *towerbackground = findNode::getClass<TowerBackground>(topNode, _backgroundName);
+  if (!towerbackground)
+  {
+    std::cout << " ERROR -- can't find TowerBackground node after it should have been created" << std::endl;
+    return;
+  }
+  else
+  {
+    towerbackground->set_UE(0, _UE[0]);
+    towerbackground->set_UE(1, _UE[1]);
+    towerbackground->set_UE(2, _UE[2]);
+
+    towerbackground->set_v2(_v2);
+
+    towerbackground->set_Psi2(_Psi2);
+
+    towerbackground->set_nStripsUsedForFlow(_nStrips);
+
+    towerbackground->set_nTowersUsedForBkg(_nTowers);
+  }
+
+  return;
+}
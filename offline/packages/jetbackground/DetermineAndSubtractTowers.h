@@ -0,0 +1,107 @@
+#ifndef JETBACKGROUND_DETERMINEANDSUBTRACTTOWERS_H
+#define JETBACKGROUND_DETERMINEANDSUBTRACTTOWERS_H
+
+//===========================================================
+/// \file DetermineAndSubtractTowers.h
+/// \brief UE background determination and subtraction in one module
+//===========================================================
+
+#include <fun4all/SubsysReco.h>
+
+#include <calobase/RawTowerGeomTable.h>
+
+// system includes
+#include <string>
+#include <vector>
+
+// forward declarations
+class PHCompositeNode;
+class RawTowerContainer;
+class RawTowerGeomContainer;
+
+/// \class DetermineAndSubtractTowers
+///
+/// \brief UE background determination and subtraction in one module
+///
+/// Does the work of RetowerCEMC, the second iteration of
+/// DetermineTowerBackground (seeds are the jets of a jet map above a pT
+/// cut) and SubtractTowers on one flat (layer, eta, phi) grid of the HCal
+/// binning. The CEMC towers are summed into the grid directly, the tower to
+/// bin lookup and the bin positions are computed on the first event.
+/// Fills the same TowerBackground node as DetermineTowerBackground and the
+/// same TOWER_CALIB_*_SUB1 tower containers as SubtractTowers, with the
+/// same values. The first background iteration and CopyAndSubtractJets
+/// still need the individual modules, they run before the second seed jets
+/// exist.
+///
+class DetermineAndSubtractTowers : public SubsysReco
+{
+ public:
+  DetermineAndSubtractTowers(const std::string &name = "DetermineAndSubtractTowers");
+  virtual ~DetermineAndSubtractTowers() {}
+
+  int InitRun(PHCompositeNode *topNode);
+  int process_event(PHCompositeNode *topNode);
+
+  void SetBackgroundOutputName(const std::string &name) { _backgroundName = name; }
+  void SetSeedJetName(const std::string &name) { _seedJetName = name; }
+  void SetFlow(int do_flow) { _do_flow = do_flow; };
+  void SetFlowModulation(bool use_flow_modulation) { _use_flow_modulation = use_flow_modulation; }
+
+  void SetSeedJetPt(float pt) { _seed_jet_pt = pt; };
+
+ private:
+  int CreateNode(PHCompositeNode *topNode);
+  void FillNode(PHCompositeNode *topNode);
+
+  //! tower => grid bin lookup and bin positions, on the first event
+  void InitGrid(RawTowerGeomContainer *geomEM, RawTowerGeomContainer *geomIH, RawTowerGeomContainer *geomOH);
+
+  //! add the energies of towers to the grid of layer
+  void FillGrid(int layer, RawTowerContainer *towers, const RawTowerGeomTable &geom);
+
+  int FindSeeds(PHCompositeNode *topNode);
+  int DetermineFlow(PHCompositeNode *topNode);
+  void DetermineUE();
+  void SubtractTowers(PHCompositeNode *topNode);
+
+  int _do_flow;
+  bool _use_flow_modulation;
+  float _v2;
+  float _Psi2;
+  std::vector<std::vector<float> > _UE;
+  int _nStrips;
+  int _nTowers;
+
+  int _HCAL_NETA;
+  int _HCAL_NPHI;
+
+  //! energies on the HCal grid, index (layer * _HCAL_NETA + eta) * _HCAL_NPHI + phi
+  std::vector<float> _grid_E;
+  //! 1 for the (eta, phi) bins within dR < 0.4 of a seed
+  std::vector<char> _grid_excluded;
+
+  //! bin centers of the HCal binning
+  std::vector<float> _eta_center;
+  std::vector<float> _phi_center;
+  //! phi of the subtracted tower in each bin (layer * _HCAL_NETA + eta) * _HCAL_NPHI + phi
+  std::vector<float> _tower_phi;
+
+  //! tower geometries and their grid bins (eta * _HCAL_NPHI + phi), -1 off the grid
+  RawTowerGeomTable _geom[3];
+  std::vector<int> _tower_bin[3];
+
+  // 1-D energies vs. phi (integrated over eta strips with complete
+  // phi coverage, and all layers)
+  std::vector<float> _FULLCALOFLOW_PHI_E;
+
+  std::string _backgroundName;
+  std::string _seedJetName;
+
+  float _seed_jet_pt;
+
+  std::vector<float> _seed_eta;
+  std::vector<float> _seed_phi;
+};
+
+#endif
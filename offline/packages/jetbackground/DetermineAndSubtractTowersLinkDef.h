@@ -0,0 +1,5 @@
+#ifdef __CINT__
+
+#pragma link C++ class DetermineAndSubtractTowers - !;
+
+#endif /* __CINT__ */
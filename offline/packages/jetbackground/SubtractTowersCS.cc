@@ -24,6 +24,7 @@
 #include <fastjet/contrib/ConstituentSubtractor.hh>
 
 // standard includes
+#include <algorithm>
 #include <cmath>
 #include <iostream>
 #include <map>
@@ -34,6 +35,7 @@
 SubtractTowersCS::SubtractTowersCS(const std::string &name)
   : SubsysReco(name)
   , _use_flow_modulation(false)
+  , _use_grid_pairing(true)
   , _alpha(1)
   , _DeltaRmax(0.3)
 {
@@ -171,7 +173,11 @@ int SubtractTowersCS::process_event(PHCompositeNode *topNode)
   }
 
   // constituent subtraction
-  std::vector<fastjet::PseudoJet> correctedEvent_EM = subtractor.do_subtraction(fullEvent_EM, backgroundProxies_EM, backgroundProxies_EM_remaining);
+  std::vector<fastjet::PseudoJet> correctedEvent_EM;
+  if (_use_grid_pairing)
+    correctedEvent_EM = DoSubtraction(fullEvent_EM, backgroundProxies_EM, backgroundProxies_EM_remaining);
+  else
+    correctedEvent_EM = subtractor.do_subtraction(fullEvent_EM, backgroundProxies_EM, backgroundProxies_EM_remaining);
 
   if (Verbosity() > 0)
   {
@@ -271,7 +277,11 @@ int SubtractTowersCS::process_event(PHCompositeNode *topNode)
   }
 
   // constituent subtraction
-  std::vector<fastjet::PseudoJet> correctedEvent_IH = subtractor.do_subtraction(fullEvent_IH, backgroundProxies_IH, backgroundProxies_IH_remaining);
+  std::vector<fastjet::PseudoJet> correctedEvent_IH;
+  if (_use_grid_pairing)
+    correctedEvent_IH = DoSubtraction(fullEvent_IH, backgroundProxies_IH, backgroundProxies_IH_remaining);
+  else
+    correctedEvent_IH = subtractor.do_subtraction(fullEvent_IH, backgroundProxies_IH, backgroundProxies_IH_remaining);
 
   if (Verbosity() > 0)
   {
@@ -371,7 +381,11 @@ int SubtractTowersCS::process_event(PHCompositeNode *topNode)
   }
 
   // constituent subtraction
-  std::vector<fastjet::PseudoJet> correctedEvent_OH = subtractor.do_subtraction(fullEvent_OH, backgroundProxies_OH, backgroundProxies_OH_remaining);
+  std::vector<fastjet::PseudoJet> correctedEvent_OH;
+  if (_use_grid_pairing)
+    correctedEvent_OH = DoSubtraction(fullEvent_OH, backgroundProxies_OH, backgroundProxies_OH_remaining);
+  else
+    correctedEvent_OH = subtractor.do_subtraction(fullEvent_OH, backgroundProxies_OH, backgroundProxies_OH_remaining);
 
   if (Verbosity() > 0)
   {
@@ -486,6 +500,180 @@ int SubtractTowersCS::process_event(PHCompositeNode *topNode)
   return Fun4AllReturnCodes::EVENT_OK;
 }
 
+std::vector<fastjet::PseudoJet> SubtractTowersCS::DoSubtraction(const std::vector<fastjet::PseudoJet> &particles, const std::vector<fastjet::PseudoJet> &backgroundProxies, std::vector<fastjet::PseudoJet> *backgroundProxies_remaining)
+{
+  const unsigned int nParticles = particles.size();
+  const unsigned int nProxies = backgroundProxies.size();
+
+  const double twopi = 2 * M_PI;
+  const double maxDeltaR2 = _DeltaRmax * _DeltaRmax;
+  const bool use_cells = _DeltaRmax > 0;
+
+  // kinematics of the inputs, only pairs with pt > 0 on both sides can subtract anything
+  _particle_pt.resize(nParticles);
+  _particle_y.resize(nParticles);
+  _particle_phi.resize(nParticles);
+  for (unsigned int i = 0; i < nParticles; ++i)
+  {
+    _particle_pt[i] = particles[i].pt();
+    _particle_y[i] = particles[i].rap();
+    _particle_phi[i] = particles[i].phi();
+  }
+
+  double y_min = 0;
+  double y_max = 0;
+  bool first = true;
+  _proxy_pt.resize(nProxies);
+  _proxy_y.resize(nProxies);
+  _proxy_phi.resize(nProxies);
+  for (unsigned int j = 0; j < nProxies; ++j)
+  {
+    _proxy_pt[j] = backgroundProxies[j].pt();
+    _proxy_y[j] = backgroundProxies[j].rap();
+    _proxy_phi[j] = backgroundProxies[j].phi();
+    if (!(_proxy_pt[j] > 0)) continue;
+    if (first || _proxy_y[j] < y_min) y_min = _proxy_y[j];
+    if (first || _proxy_y[j] > y_max) y_max = _proxy_y[j];
+    first = false;
+  }
+
+  // (y, phi) cells at least _DeltaRmax wide (the margin keeps the round off in
+  // the cell number from losing a pair), a pair is at most one cell apart
+  int nCells_y = 1;
+  int nCells_phi = 1;
+  double width_y = 1;
+  double width_phi = twopi;
+  if (use_cells)
+  {
+    width_y = _DeltaRmax * (1 + 1e-6);
+    nCells_y = std::floor((y_max - y_min) / width_y) + 1;
+    nCells_phi = std::max(1, static_cast<int>(std::floor(twopi / width_y)));
+    width_phi = twopi / nCells_phi;
+  }
+
+  _proxy_cell.assign(nProxies, -1);
+  _cell_start.assign(nCells_y * nCells_phi + 1, 0);
+  for (unsigned int j = 0; j < nProxies; ++j)
+  {
+    if (!(_proxy_pt[j] > 0)) continue;
+    const int cell_y = std::min(nCells_y - 1, static_cast<int>(std::floor((_proxy_y[j] - y_min) / width_y)));
+    const int cell_phi = std::min(nCells_phi - 1, std::max(0, static_cast<int>(std::floor(_proxy_phi[j] / width_phi))));
+    _proxy_cell[j] = cell_y * nCells_phi + cell_phi;
+    ++_cell_start[_proxy_cell[j] + 1];
+  }
+  for (int c = 0; c < nCells_y * nCells_phi; ++c) _cell_start[c + 1] += _cell_start[c];
+  // proxies keep their order within a cell
+  _cell_proxies.resize(_cell_start.back());
+  _pair_next.assign(_cell_start.begin(), _cell_start.end() - 1);
+  for (unsigned int j = 0; j < nProxies; ++j)
+  {
+    if (_proxy_cell[j] >= 0) _cell_proxies[_pair_next[_proxy_cell[j]]++] = j;
+  }
+
+  // pairs within _DeltaRmax, each particle has its own list sorted by
+  // distance and proxy. The distance is pt^(2 alpha) * dR^2 as in the contrib.
+  _pairs.clear();
+  _pair_next.resize(nParticles);
+  _pair_end.resize(nParticles);
+  _heap.clear();
+  for (unsigned int i = 0; i < nParticles; ++i)
+  {
+    _pair_next[i] = _pairs.size();
+    if (_particle_pt[i] > 0)
+    {
+      const double pt_factor = (std::fabs(2 * _alpha) > 1e-5 ? std::pow(_particle_pt[i], 2 * _alpha) : 1.);
+
+      const int cell_y = std::floor((_particle_y[i] - y_min) / width_y);
+      const int cell_phi = std::min(nCells_phi - 1, std::max(0, static_cast<int>(std::floor(_particle_phi[i] / width_phi))));
+      // with less than three phi cells all of them are neighbors
+      int cells_phi[3] = {cell_phi, (cell_phi + 1) % nCells_phi, (cell_phi + nCells_phi - 1) % nCells_phi};
+      const int nNeighbors_phi = std::min(3, nCells_phi);
+
+      for (int iy = std::max(0, cell_y - 1); iy <= std::min(nCells_y - 1, cell_y + 1); ++iy)
+      {
+        for (int iphi = 0; iphi < nNeighbors_phi; ++iphi)
+        {
+          const int cell = iy * nCells_phi + cells_phi[iphi];
+          for (unsigned int k = _cell_start[cell]; k < _cell_start[cell + 1]; ++k)
+          {
+            const unsigned int j = _cell_proxies[k];
+
+            const double delta_y = _particle_y[i] - _proxy_y[j];
+            double delta_phi = _proxy_phi[j] - _particle_phi[i];
+            if (delta_phi > M_PI) delta_phi -= twopi;
+            if (delta_phi < -M_PI) delta_phi += twopi;
+            const double deltaR2 = delta_y * delta_y + delta_phi * delta_phi;
+            if (use_cells && deltaR2 > maxDeltaR2) continue;
+
+            _pairs.push_back(std::make_pair(deltaR2 * pt_factor, j));
+          }
+        }
+      }
+      std::sort(_pairs.begin() + _pair_next[i], _pairs.end());
+    }
+    _pair_end[i] = _pairs.size();
+    if (_pair_next[i] < _pair_end[i]) _heap.push_back(i);
+  }
+
+  // the heap top is the closest remaining pair of the event, ties go to the lower particle index
+  auto later = [this](unsigned int a, unsigned int b) {
+    const double da = _pairs[_pair_next[a]].first;
+    const double db = _pairs[_pair_next[b]].first;
+    if (da != db) return da > db;
+    return a > b;
+  };
+  std::make_heap(_heap.begin(), _heap.end(), later);
+
+  while (!_heap.empty())
+  {
+    std::pop_heap(_heap.begin(), _heap.end(), later);
+    const unsigned int i = _heap.back();
+    _heap.pop_back();
+
+    const unsigned int j = _pairs[_pair_next[i]].second;
+    ++_pair_next[i];
+    if (_proxy_pt[j] > 0)
+    {
+      if (_proxy_pt[j] >= _particle_pt[i])
+      {
+        _proxy_pt[j] -= _particle_pt[i];
+        _particle_pt[i] = 0;
+        // nothing left to subtract from this particle
+        continue;
+      }
+      _particle_pt[i] -= _proxy_pt[j];
+      _proxy_pt[j] = 0;
+    }
+
+    // pairs with used up proxies do nothing
+    while (_pair_next[i] < _pair_end[i] && !(_proxy_pt[_pairs[_pair_next[i]].second] > 0)) ++_pair_next[i];
+    if (_pair_next[i] < _pair_end[i])
+    {
+      _heap.push_back(i);
+      std::push_heap(_heap.begin(), _heap.end(), later);
+    }
+  }
+
+  std::vector<fastjet::PseudoJet> subtracted_particles;
+  for (unsigned int i = 0; i < nParticles; ++i)
+  {
+    if (!(_particle_pt[i] > 0)) continue;
+    subtracted_particles.push_back(fastjet::PtYPhiM(_particle_pt[i], _particle_y[i], _particle_phi[i]));
+  }
+
+  if (backgroundProxies_remaining)
+  {
+    backgroundProxies_remaining->clear();
+    for (unsigned int j = 0; j < nProxies; ++j)
+    {
+      if (!(_proxy_pt[j] > 0)) continue;
+      backgroundProxies_remaining->push_back(fastjet::PtYPhiM(_proxy_pt[j], _proxy_y[j], _proxy_phi[j]));
+    }
+  }
+
+  return subtracted_particles;
+}
+
 int SubtractTowersCS::CreateNode(PHCompositeNode *topNode)
 {
   PHNodeIterator iter(topNode);
@@ -10,10 +10,17 @@
 #include <fun4all/SubsysReco.h>
 
 #include <string> 
+#include <utility>
+#include <vector>
 
 // forward declarations
 class PHCompositeNode;
 
+namespace fastjet
+{
+  class PseudoJet;
+}
+
 /// \class SubtractTowersCS
 ///
 /// \brief creates new UE-subtracted towers
@@ -22,6 +29,15 @@ class PHCompositeNode;
 /// constructs a new set of towers by subtracting the background from
 /// existing raw towers. CS parameters are configurable
 ///
+/// By default the constituent subtraction is done here rather than by
+/// fastjet::contrib::ConstituentSubtractor: the background proxies are
+/// binned in (y, phi) cells of size _DeltaRmax, so each tower is only
+/// paired with the proxies in the neighboring cells, and the per-tower
+/// sorted pair lists are merged with a heap instead of sorting all pairs
+/// of the event. The pairs are processed in the same order (distance,
+/// then tower and proxy index), so the subtraction is the same.
+/// SetGridPairing(false) goes back to the fastjet contrib subtractor.
+///
 class SubtractTowersCS : public SubsysReco
 {
  public:
@@ -34,14 +50,40 @@ class SubtractTowersCS : public SubsysReco
   void SetFlowModulation(bool use_flow_modulation) { _use_flow_modulation = use_flow_modulation; }
   void SetAlpha(float alpha) { _alpha = alpha; }
   void SetDeltaRmax(float DeltaRmax) { _DeltaRmax = DeltaRmax; }
+  void SetGridPairing(bool use_grid_pairing) { _use_grid_pairing = use_grid_pairing; }
 
  private:
   int CreateNode(PHCompositeNode *topNode);
 
+  //! constituent subtraction of backgroundProxies from particles with the (y, phi) binned pairing
+  std::vector<fastjet::PseudoJet> DoSubtraction(const std::vector<fastjet::PseudoJet> &particles, const std::vector<fastjet::PseudoJet> &backgroundProxies, std::vector<fastjet::PseudoJet> *backgroundProxies_remaining);
+
   bool _use_flow_modulation;
+  bool _use_grid_pairing;
 
   float _alpha;
   float _DeltaRmax;
+
+  // buffers of DoSubtraction, kept between events
+  std::vector<double> _particle_pt;
+  std::vector<double> _particle_y;
+  std::vector<double> _particle_phi;
+  std::vector<double> _proxy_pt;
+  std::vector<double> _proxy_y;
+  std::vector<double> _proxy_phi;
+
+  //! proxies sorted by cell, cell c has _cell_proxies[_cell_start[c] .. _cell_start[c + 1])
+  std::vector<unsigned int> _cell_start;
+  std::vector<unsigned int> _cell_proxies;
+  std::vector<int> _proxy_cell;
+
+  //! (distance, proxy) pairs, sorted per particle; particle i has _pairs[_pair_next[i] .. _pair_end[i])
+  std::vector<std::pair<double, unsigned int> > _pairs;
+  std::vector<unsigned int> _pair_next;
+  std::vector<unsigned int> _pair_end;
+
+  //! particles ordered by the distance of their next pair
+  std::vector<unsigned int> _heap;
 };
 
 #endif
@@ -34,9 +34,7 @@
 #include <TMatrixTUtils.h>                          // for TMatrixTRow
 #include <TVector3.h>
 
-#include <boost/graph/adjacency_list.hpp>
-#include <boost/graph/connected_components.hpp>
-
+#include <algorithm>
 #include <array>
 #include <cmath>
 #include <cstdlib>                                 // for exit
@@ -46,7 +44,6 @@
 #include <string>
 #include <vector>                                   // for vector
 
-using namespace boost;
 using namespace std;
 
 namespace
@@ -55,6 +52,41 @@ namespace
   /// convenience square method
   template<class T>
     inline constexpr T square( const T& x ) { return x*x; }
+
+  /// disjoint set forest over the hit indices of one hitset.
+  /// The root of a set is always its smallest index.
+  class HitDisjointSet
+  {
+   public:
+    explicit HitDisjointSet(const unsigned int n)
+      : m_parent(n)
+    {
+      for (unsigned int i = 0; i < n; ++i) m_parent[i] = i;
+    }
+
+    unsigned int find(unsigned int i)
+    {
+      while (m_parent[i] != i)
+      {
+        m_parent[i] = m_parent[m_parent[i]];
+        i = m_parent[i];
+      }
+      return i;
+    }
+
+    void unite(const unsigned int i, const unsigned int j)
+    {
+      const unsigned int ri = find(i);
+      const unsigned int rj = find(j);
+      if (ri < rj)
+        m_parent[rj] = ri;
+      else if (rj < ri)
+        m_parent[ri] = rj;
+    }
+
+   private:
+    std::vector<unsigned int> m_parent;
+  };
 }
 
 bool MvtxClusterizer::are_adjacent(const std::pair<TrkrDefs::hitkey, TrkrHit*> &lhs, const std::pair<TrkrDefs::hitkey, TrkrHit*> &rhs)
@@ -84,6 +116,49 @@ bool MvtxClusterizer::are_adjacent(const std::pair<TrkrDefs::hitkey, TrkrHit*> &
   return false;
 }
 
+vector<int> MvtxClusterizer::find_components(const vector<pair<TrkrDefs::hitkey, TrkrHit*> > &hitvec)
+{
+  // hits are ordered by hitkey, which is (col << 16 | row), so all
+  // neighbours with a larger key than hit i are found by binary search
+  // among (col, row+1) and (col+1, row-1 .. row+1)
+  HitDisjointSet clusters(hitvec.size());
+  auto find_hit = [&hitvec](const TrkrDefs::hitkey key) {
+    auto iter = std::lower_bound(hitvec.begin(), hitvec.end(), key,
+                                 [](const std::pair<TrkrDefs::hitkey, TrkrHit*> &hit, const TrkrDefs::hitkey k) { return hit.first < k; });
+    return (iter != hitvec.end() && iter->first == key) ? int(iter - hitvec.begin()) : -1;
+  };
+
+  const bool zclustering = GetZClustering();
+  for (unsigned int i = 0; i < hitvec.size(); i++)
+  {
+    const int col = MvtxDefs::getCol(hitvec[i].first);
+    const int row = MvtxDefs::getRow(hitvec[i].first);
+
+    std::array<std::pair<int, int>, 4> neighbours = {{ {col, row + 1}, {col + 1, row - 1}, {col + 1, row}, {col + 1, row + 1} }};
+    const unsigned int nneighbours = zclustering ? neighbours.size() : 1;
+    for (unsigned int n = 0; n < nneighbours; ++n)
+    {
+      if (neighbours[n].second < 0) continue;
+      const int j = find_hit(MvtxDefs::genHitKey(neighbours[n].first, neighbours[n].second));
+      if (j >= 0 && are_adjacent(hitvec[i], hitvec[j]))
+        clusters.unite(i, j);
+    }
+  }
+
+  // number the clusters in the order of their first hit, which is the
+  // numbering boost::connected_components gave them
+  std::vector<int> component(hitvec.size());
+  std::vector<int> cluster_number(hitvec.size(), -1);
+  int ncluster = 0;
+  for (unsigned int i = 0; i < hitvec.size(); i++)
+  {
+    const unsigned int root = clusters.find(i);
+    if (cluster_number[root] < 0) cluster_number[root] = ncluster++;
+    component[i] = cluster_number[root];
+  }
+  return component;
+}
+
 MvtxClusterizer::MvtxClusterizer(const string &name)
   : SubsysReco(name)
   , m_hits(nullptr)
@@ -91,6 +166,10 @@ MvtxClusterizer::MvtxClusterizer(const string &name)
   , m_clusterhitassoc(nullptr)
   , m_makeZClustering(true)
 {
+  DeclareInputNode("TRKR_HITSET");
+  DeclareInputNode("CYLINDERGEOM_MVTX");
+  DeclareSharedOutputNode("TRKR_CLUSTER");
+  DeclareSharedOutputNode("TRKR_CLUSTERHITASSOC");
 }
 
 int MvtxClusterizer::InitRun(PHCompositeNode *topNode)
@@ -215,6 +294,11 @@ void MvtxClusterizer::ClusterMvtx(PHCompositeNode *topNode)
   //-----------
 
   // loop over each MvtxHitSet object (chip)
+  // the clusters and associations of this detector, the containers are
+  // filled by other clusterizers at the same time with module scheduling
+  TrkrClusterContainer::Map newclusters;
+  TrkrClusterHitAssoc::Map newassocs;
+
   TrkrHitSetContainer::ConstRange hitsetrange =
       m_hits->getHitSets(TrkrDefs::TrkrId::mvtxId);
   for (TrkrHitSetContainer::ConstIterator hitsetitr = hitsetrange.first;
@@ -242,25 +326,7 @@ void MvtxClusterizer::ClusterMvtx(PHCompositeNode *topNode)
       cout << "hitvec.size(): " << hitvec.size() << endl;
 
     // do the clustering
-    typedef adjacency_list<vecS, vecS, undirectedS> Graph;
-    Graph G;
-
-    // loop over hits in this chip
-    for (unsigned int i = 0; i < hitvec.size(); i++)
-    {
-      for (unsigned int j = 0; j < hitvec.size(); j++)
-      {
-        if (are_adjacent(hitvec[i], hitvec[j]))
-          add_edge(i, j, G);
-      }
-    }
-
-    // Find the connections between the vertices of the graph (vertices are the rawhits,
-    // connections are made when they are adjacent to one another)
-    vector<int> component(num_vertices(G));
-
-    // this is the actual clustering, performed by boost
-    connected_components(G, &component[0]);
+    vector<int> component = find_components(hitvec);
 
     // Loop over the components(hits) compiling a list of the
     // unique connected groups (ie. clusters).
@@ -284,9 +350,11 @@ void MvtxClusterizer::ClusterMvtx(PHCompositeNode *topNode)
 	if (Verbosity() > 2)
 	  cout << "Filling cluster id " << clusid << endl;
 
-	// make the cluster directly in the node tree
+	// collect the clusters, they are added to the node tree in one go at the end
 	TrkrDefs::cluskey ckey = MvtxDefs::genClusKey(hitset->getHitSetKey(), clusid);
-	TrkrClusterv1 *clus = static_cast<TrkrClusterv1 *>((m_clusterlist->findOrAddCluster(ckey))->second);
+	TrkrClusterv1 *clus = new TrkrClusterv1();
+	clus->setClusKey(ckey);
+	newclusters.push_back(make_pair(ckey, clus));
 
 	// determine the size of the cluster in phi and z
 	set<int> phibins;
@@ -336,7 +404,7 @@ void MvtxClusterizer::ClusterMvtx(PHCompositeNode *topNode)
 	    zsum += world_coords.Z();
 
 	    // add the association between this cluster key and this hitkey to the table
-	    m_clusterhitassoc->addAssoc(ckey, mapiter->second.first);
+	    newassocs.push_back(make_pair(ckey, mapiter->second.first));
 
 	    ++nhits;
 	  }  //mapiter
@@ -487,6 +555,9 @@ void MvtxClusterizer::ClusterMvtx(PHCompositeNode *topNode)
       }  // clusitr
   }    // hitsetitr
 
+  m_clusterlist->addClusters(newclusters);
+  m_clusterhitassoc->addAssocs(newassocs);
+
   if(Verbosity() > 1)
     {
       // check that the associations were written correctly
@@ -12,6 +12,7 @@
 
 #include <string>                // for string
 #include <utility>
+#include <vector>
 
 class PHCompositeNode;
 class TrkrHit;
@@ -42,6 +43,9 @@ class MvtxClusterizer : public SubsysReco
   //! end of process
   int End(PHCompositeNode *topNode) { return 0; }
 
+  //! clusters are added to the shared containers in one locked call, the debug printout reads them
+  bool ThreadSafe() const { return Verbosity() == 0; }
+
   //! option to turn off z-dimension clustering
   void SetZClustering(const bool make_z_clustering)
   {
@@ -55,6 +59,8 @@ class MvtxClusterizer : public SubsysReco
  private:
   //bool are_adjacent(const pixel lhs, const pixel rhs);
   bool are_adjacent(const std::pair<TrkrDefs::hitkey, TrkrHit*> &lhs, const std::pair<TrkrDefs::hitkey, TrkrHit*> &rhs);
+  //! groups of adjacent hits, component number for every hit
+  std::vector<int> find_components(const std::vector<std::pair<TrkrDefs::hitkey, TrkrHit*> > &hitvec);
 
   void ClusterMvtx(PHCompositeNode *topNode);
 
@@ -37,49 +37,47 @@ static const unsigned int kBitShiftRow __attribute__((unused)) = 0;
 static const uint16_t MAXCOL __attribute__((unused)) = 1024;
 static const uint16_t MAXROW __attribute__((unused)) = 512;
 
-#endif  // __CINT__
-
 /**
    * @brief Get the stave id from hitsetkey
    * @param[in] hitsetkey
    * @param[out] stave id
    */
-uint8_t getStaveId(TrkrDefs::hitsetkey key);
+constexpr uint8_t getStaveId(const TrkrDefs::hitsetkey key) { return key >> kBitShiftStaveId; }
 
 /**
    * @brief Get the stave id from cluskey
    * @param[in] cluskey
    * @param[out] stave id
    */
-uint8_t getStaveId(TrkrDefs::cluskey key);
+constexpr uint8_t getStaveId(const TrkrDefs::cluskey key) { return getStaveId(TrkrDefs::getHitSetKeyFromClusKey(key)); }
 
 /**
    * @brief Get the chip id from hitsetkey
    * @param[in] hitsetkey
    * @param[out] chip id
    */
-uint8_t getChipId(TrkrDefs::hitsetkey key);
+constexpr uint8_t getChipId(const TrkrDefs::hitsetkey key) { return key >> kBitShiftChipId; }
 
 /**
    * @brief Get the chip id from cluskey
    * @param[in] cluskey
    * @param[out] chip id
    */
-uint8_t getChipId(TrkrDefs::cluskey key);
+constexpr uint8_t getChipId(const TrkrDefs::cluskey key) { return getChipId(TrkrDefs::getHitSetKeyFromClusKey(key)); }
 
 /**
    * @brief Get the column index from hitkey
    * @param[in] hitkey
    * @param[out] column index
    */
-uint16_t getCol(TrkrDefs::hitkey key);
+constexpr uint16_t getCol(const TrkrDefs::hitkey key) { return key >> kBitShiftCol; }
 
 /**
    * @brief Get the row index from hitkey
    * @param[in] hitkey
    * @param[out] row index
    */
-uint16_t getRow(TrkrDefs::hitkey key);
+constexpr uint16_t getRow(const TrkrDefs::hitkey key) { return key >> kBitShiftRow; }
 
 /**
    * @brief Generate a hitkey from a pixels column and row index
@@ -87,7 +85,10 @@ uint16_t getRow(TrkrDefs::hitkey key);
    * @param[in] row Row index
    * @param[out] hitkey
    */
-TrkrDefs::hitkey genHitKey(const uint16_t col, const uint16_t row);
+constexpr TrkrDefs::hitkey genHitKey(const uint16_t col, const uint16_t row)
+{
+  return (static_cast<TrkrDefs::hitkey>(col) << kBitShiftCol) | (static_cast<TrkrDefs::hitkey>(row) << kBitShiftRow);
+}
 
 /**
    * @brief Generate a hitsetkey for the mvtx
@@ -99,7 +100,12 @@ TrkrDefs::hitkey genHitKey(const uint16_t col, const uint16_t row);
    * Generate a hitsetkey for the mvtx. The tracker id is known
    * implicitly and used in the function.
    */
-TrkrDefs::hitsetkey genHitSetKey(const uint8_t lyr, const uint8_t stave, const uint8_t chip);
+constexpr TrkrDefs::hitsetkey genHitSetKey(const uint8_t lyr, const uint8_t stave, const uint8_t chip)
+{
+  return TrkrDefs::genHitSetKey(TrkrDefs::TrkrId::mvtxId, lyr) |
+         (static_cast<TrkrDefs::hitsetkey>(stave) << kBitShiftStaveId) |
+         (static_cast<TrkrDefs::hitsetkey>(chip) << kBitShiftChipId);
+}
 
 /**
    * @brief Generate a cluster key from indeces 
@@ -109,7 +115,10 @@ TrkrDefs::hitsetkey genHitSetKey(const uint8_t lyr, const uint8_t stave, const u
    * @param[in] clusid Cluster id
    * @param[out] cluskey
    */
-TrkrDefs::cluskey genClusKey(const uint8_t lyr, const uint8_t stave, const uint8_t chip, const uint32_t clusid);
+constexpr TrkrDefs::cluskey genClusKey(const uint8_t lyr, const uint8_t stave, const uint8_t chip, const uint32_t clusid)
+{
+  return TrkrDefs::genClusKey(genHitSetKey(lyr, stave, chip), clusid);
+}
 
 /**
    * @brief Generate a cluster key using a hitsetkey and cluster id
@@ -117,7 +126,27 @@ TrkrDefs::cluskey genClusKey(const uint8_t lyr, const uint8_t stave, const uint8
    * @param[in] clusid Cluster id
    * @param[out] cluskey
    */
-TrkrDefs::cluskey genClusKey(const TrkrDefs::hitsetkey hskey, const uint32_t clusid);
+constexpr TrkrDefs::cluskey genClusKey(const TrkrDefs::hitsetkey hskey, const uint32_t clusid) { return TrkrDefs::genClusKey(hskey, clusid); }
+
+/**
+   * @brief hitsetkey of the mvtx with its stave and chip
+   */
+class HitSetKey : public TrkrDefs::TypedHitSetKey<TrkrDefs::mvtxId>
+{
+ public:
+  constexpr explicit HitSetKey(const TrkrDefs::hitsetkey key)
+    : TrkrDefs::TypedHitSetKey<TrkrDefs::mvtxId>(key)
+  {
+  }
+  constexpr HitSetKey(const uint8_t lyr, const uint8_t stave, const uint8_t chip)
+    : TrkrDefs::TypedHitSetKey<TrkrDefs::mvtxId>(genHitSetKey(lyr, stave, chip))
+  {
+  }
+  constexpr uint8_t stave() const { return getStaveId(m_Key); }
+  constexpr uint8_t chip() const { return getChipId(m_Key); }
+};
+
+#endif  // __CINT__
 
 }  // namespace MvtxDefs
 
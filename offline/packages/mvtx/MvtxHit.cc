@@ -8,6 +8,8 @@
 
 #include <trackbase/TrkrHit.h>
 
+#include <phool/PHObjectPool.h>
+
 #include <ostream>              // for operator<<, endl, ostream, basic_ostream
 
 MvtxHit::MvtxHit()
@@ -30,3 +32,12 @@ int MvtxHit::isValid() const
   return 1;
 }
 
+void *MvtxHit::operator new(size_t size)
+{
+  return PHObjectPool<MvtxHit>::allocate(size);
+}
+
+void MvtxHit::operator delete(void *ptr, size_t size)
+{
+  PHObjectPool<MvtxHit>::deallocate(ptr, size);
+}
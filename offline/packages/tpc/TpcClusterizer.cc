@@ -1,14 +1,15 @@
 #include "TpcClusterizer.h"
 
 #include "TpcDefs.h"
+#include "TpcPeakFinderCpu.h"
 
 #include <trackbase/TrkrClusterContainer.h>
 #include <trackbase/TrkrClusterHitAssoc.h>
 #include <trackbase/TrkrClusterv1.h>
 #include <trackbase/TrkrDefs.h>  // for hitkey, getLayer
-#include <trackbase/TrkrHit.h>
 #include <trackbase/TrkrHitSet.h>
 #include <trackbase/TrkrHitSetContainer.h>
+#include <trackbase/TrkrRegionOfInterest.h>
 
 #include <fun4all/Fun4AllReturnCodes.h>
 #include <fun4all/SubsysReco.h>                         // for SubsysReco
@@ -23,6 +24,7 @@
 #include <phool/PHObject.h>                             // for PHObject
 #include <phool/getClass.h>
 #include <phool/phool.h>  // for PHWHERE
+#include <phool/recoConsts.h>
 
 #include <TMatrixFfwd.h>    // for TMatrixF
 #include <TMatrixT.h>       // for TMatrixT, ope...
@@ -31,7 +33,10 @@
 #include <TNtuple.h>  
 #include <TFile.h>  
 
+#include <algorithm>
+#include <atomic>
 #include <cmath>  // for sqrt, cos, sin
+#include <future>
 #include <iostream>
 #include <map>  // for _Rb_tree_cons...
 #include <string>
@@ -40,72 +45,71 @@
 
 using namespace std;
 
+namespace
+{
+  // largest extent of a cluster from its peak, in phi and z bins
+  const int kMaxPhiSteps = 3;
+  const int kMaxZSteps = 9;
+}  // namespace
+
 TpcClusterizer::TpcClusterizer(const string &name)
   : SubsysReco(name)
   , m_hits(nullptr)
   , m_clusterlist(nullptr)
   , m_clusterhitassoc(nullptr)
+  , m_roi(nullptr)
+  , m_PeakFinder(new TpcPeakFinderCpu())
   , zz_shaping_correction(0.0754)
   , pedestal(74.4)
-  , NPhiBinsMax(0)
-  , NPhiBinsMin(0)
-  , NZBinsMax(0)
-  , NZBinsMin(0)
+  , m_NThreads(1)
+  , m_FloatPrecision(-1)
   , hit_nt(nullptr)
   , cluster_nt(nullptr)
 {
+  DeclareInputNode("TRKR_HITSET");
+  DeclareInputNode("CYLINDERCELLGEOM_SVTX");
+  DeclareInputNode(TrkrRegionOfInterest::GetNodeName());
+  DeclareSharedOutputNode("TRKR_CLUSTER");
+  DeclareSharedOutputNode("TRKR_CLUSTERHITASSOC");
 }
 
-//===================
-bool TpcClusterizer::is_local_maximum(int phibin, int zbin, std::vector<std::vector<double>> &adcval)
+TpcClusterizer::~TpcClusterizer()
 {
-  bool retval = true;
-  double centval = adcval[phibin][zbin];
-  
-  // search contiguous adc values for a larger signal
-  for (int iz = zbin - 1; iz <= zbin + 1; iz++)
-    for (int iphi = phibin - 1; iphi <= phibin + 1; iphi++)
-      {
-	if (iz >= NZBinsMax) continue;
-	if (iz < NZBinsMin) continue;
-	
-	if (iphi >= NPhiBinsMax) continue;
-	if (iphi < NPhiBinsMin) continue;
-	
-	if (adcval[iphi][iz] > centval)
-	  {
-	    retval = false;
-	  }
-      }
-  
-  return retval;
+  delete m_PeakFinder;
 }
 
-void TpcClusterizer::get_cluster(int phibin, int zbin, int &phiup, int &phidown, int &zup, int &zdown, std::vector<std::vector<double>> &adcval)
+void TpcClusterizer::SetPeakFinder(TpcPeakFinder *finder)
+{
+  delete m_PeakFinder;
+  m_PeakFinder = finder;
+}
+
+//===================
+void TpcClusterizer::get_cluster(int phibin, int zbin, int &phiup, int &phidown, int &zup, int &zdown, const AdcGrid &grid) const
 {
   // search along phi at the peak in z
 
-  for (int iphi = phibin + 1; iphi < phibin + 4; iphi++)
+  for (int iphi = phibin + 1; iphi <= phibin + kMaxPhiSteps; iphi++)
   {
-    if (iphi >= NPhiBinsMax) continue;
+    if (iphi >= grid.NPhiBinsMax) continue;
 
-    if (adcval[iphi][zbin] <= 0)
+    if (grid.value(iphi, zbin) <= 0)
       break;
 
-    if (adcval[iphi][zbin] <= adcval[iphi - 1][zbin])
+    if (grid.value(iphi, zbin) <= grid.value(iphi - 1, zbin))
       phiup++;
     else
       break;
   }
 
-  for (int iphi = phibin - 1; iphi > phibin - 4; iphi--)
+  for (int iphi = phibin - 1; iphi >= phibin - kMaxPhiSteps; iphi--)
   {
-    if (iphi < NPhiBinsMin) continue;
+    if (iphi < grid.NPhiBinsMin) continue;
 
-    if (adcval[iphi][zbin] <= 0)
+    if (grid.value(iphi, zbin) <= 0)
       break;
 
-    if (adcval[iphi][zbin] <= adcval[iphi + 1][zbin])
+    if (grid.value(iphi, zbin) <= grid.value(iphi + 1, zbin))
       phidown++;
     else
       break;
@@ -113,35 +117,107 @@ void TpcClusterizer::get_cluster(int phibin, int zbin, int &phiup, int &phidown,
 
   // search along z at the peak in phi
 
-  for (int iz = zbin + 1; iz < zbin + 10; iz++)
+  for (int iz = zbin + 1; iz <= zbin + kMaxZSteps; iz++)
   {
-    if (iz >= NZBinsMax) continue;
+    if (iz >= grid.NZBinsMax) continue;
 
-    if (adcval[phibin][iz] <= 0)
+    if (grid.value(phibin, iz) <= 0)
       break;
 
-    if (adcval[phibin][iz] <= adcval[phibin][iz - 1])
+    if (grid.value(phibin, iz) <= grid.value(phibin, iz - 1))
       zup++;
     else
       break;
   }
 
-  for (int iz = zbin - 1; iz > zbin - 10; iz--)
+  for (int iz = zbin - 1; iz >= zbin - kMaxZSteps; iz--)
   {
-    if (iz < NZBinsMin) continue;
+    if (iz < grid.NZBinsMin) continue;
 
-    if (adcval[phibin][iz] <= 0)
+    if (grid.value(phibin, iz) <= 0)
       break;
 
-    if (adcval[phibin][iz] <= adcval[phibin][iz + 1])
+    if (grid.value(phibin, iz) <= grid.value(phibin, iz + 1))
       zdown++;
     else
       break;
   }
 }
 
+template <typename Scalar>
+void TpcClusterizer::cluster_moments(const AdcGrid &grid, PHG4CylinderCellGeom *layergeom, const int philo, const int phihi, const int zlo, const int zhi, ClusterMoments &moments) const
+{
+  // the bin centers are looked up once for both passes
+  Scalar phicenter[2 * kMaxPhiSteps + 1];
+  Scalar zcenter[2 * kMaxZSteps + 1];
+  const int nphi = phihi - philo + 1;
+  const int nz = zhi - zlo + 1;
+  for (int iphi = 0; iphi < nphi; iphi++)
+  {
+    phicenter[iphi] = layergeom->get_phicenter(philo + iphi);
+  }
+  for (int iz = 0; iz < nz; iz++)
+  {
+    zcenter[iz] = layergeom->get_zcenter(zlo + iz);
+  }
+
+  Scalar zsum = 0.0;
+  Scalar phi_sum = 0.0;
+  Scalar adc_sum = 0.0;
+  for (int iphi = 0; iphi < nphi; iphi++)
+  {
+    const float *row = &grid.adc[grid.index(philo + iphi, zlo)];
+    for (int iz = 0; iz < nz; iz++)
+    {
+      const Scalar adc = row[iz];
+      zsum += zcenter[iz] * adc;
+      phi_sum += phicenter[iphi] * adc;
+      adc_sum += adc;
+    }
+  }
+  moments.adc_sum = adc_sum;
+  if (adc_sum < 10) return;  // skip obvious noise "clusters"
+
+  const Scalar clusphi = phi_sum / adc_sum;
+  const Scalar clusz = zsum / adc_sum;
+
+  // Estimate the errors
+  Scalar dphi2_adc = 0.0;
+  Scalar dphi_adc = 0.0;
+  Scalar dz2_adc = 0.0;
+  Scalar dz_adc = 0.0;
+  for (int iz = 0; iz < nz; iz++)
+  {
+    for (int iphi = 0; iphi < nphi; iphi++)
+    {
+      const Scalar adc = grid.value(philo + iphi, zlo + iz);
+      const Scalar dphi = phicenter[iphi] - clusphi;
+      dphi2_adc += dphi * dphi * adc;
+      dphi_adc += dphi * adc;
+
+      const Scalar dz = zcenter[iz] - clusz;
+      dz2_adc += dz * dz * adc;
+      dz_adc += dz * adc;
+    }
+  }
+  moments.phi = clusphi;
+  moments.z = clusz;
+  moments.phi_cov = (dphi2_adc / adc_sum - dphi_adc * dphi_adc / (adc_sum * adc_sum));
+  moments.z_cov = dz2_adc / adc_sum - dz_adc * dz_adc / (adc_sum * adc_sum);
+}
+
 int TpcClusterizer::InitRun(PHCompositeNode *topNode)
 {
+  if (m_FloatPrecision < 0)
+  {
+    recoConsts *rc = recoConsts::instance();
+    m_FloatPrecision = (rc->FlagExist("RECO_FLOAT_PRECISION") && rc->get_IntFlag("RECO_FLOAT_PRECISION")) ? 1 : 0;
+  }
+  if (Verbosity() > 0 && m_FloatPrecision)
+  {
+    cout << "TpcClusterizer: cluster moments are summed in float precision" << endl;
+  }
+
   PHNodeIterator iter(topNode);
 
   // Looking for the DST node
@@ -199,8 +275,6 @@ int TpcClusterizer::InitRun(PHCompositeNode *topNode)
 
 int TpcClusterizer::process_event(PHCompositeNode *topNode)
 {
-  int print_layer = 18;
-
   if (Verbosity() > 1000)
     std::cout << "TpcClusterizer::Process_Event" << std::endl;
 
@@ -244,317 +318,429 @@ int TpcClusterizer::process_event(PHCompositeNode *topNode)
     return Fun4AllReturnCodes::ABORTRUN;
   }
 
+  // regions of interest are optional, without them everything is clustered
+  m_roi = findNode::getClass<TrkrRegionOfInterest>(topNode, TrkrRegionOfInterest::GetNodeName());
+
   // The hits are stored in hitsets, where each hitset contains all hits in a given TPC readout (layer, sector, side), so clusters are confined to a hitset
   // The TPC clustering is more complicated than for the silicon, because we have to deal with overlapping clusters
 
-  // loop over the TPC HitSet objects
-  TrkrHitSetContainer::ConstRange hitsetrange = m_hits->getHitSets(TrkrDefs::TrkrId::tpcId);
-  for (TrkrHitSetContainer::ConstIterator hitsetitr = hitsetrange.first;
-       hitsetitr != hitsetrange.second;
-       ++hitsetitr)
+  // the TPC hits are exported once into flat arrays, collect the hitsets with their layer geometry
+  m_hits->exportHits(TrkrDefs::TrkrId::tpcId, m_FlatHits);
+  std::vector<std::pair<unsigned int, PHG4CylinderCellGeom *>> hitsets;
+  for (unsigned int ihitset = 0; ihitset < m_FlatHits.nhitsets(); ihitset++)
   {
-    TrkrHitSet *hitset = hitsetitr->second;
-    int layer = TrkrDefs::getLayer(hitsetitr->first);
-    if (Verbosity() > 1)
-      if (layer == print_layer)
+    const TrkrDefs::hitsetkey hitsetkey = m_FlatHits.hitsetkeys[ihitset];
+    int layer = TrkrDefs::getLayer(hitsetkey);
+    PHG4CylinderCellGeom *layergeom = geom_container->GetLayerCellGeom(layer);
+    if (m_roi)
+    {
+      // hitsets cover the full phi range of one side, skip the side if no region reaches it
+      const int nzbins = layergeom->get_zbins();
+      const bool north = TpcDefs::getSide(hitsetkey) != 0;
+      const double zlow = layergeom->get_zcenter(north ? nzbins / 2 + 1 : 0);
+      const double zhigh = layergeom->get_zcenter(north ? nzbins - 1 : nzbins / 2 - 1);
+      const double radius = layergeom->get_radius();
+      const double halfthickness = 0.5 * layergeom->get_thickness();
+      if (!m_roi->overlaps(radius - halfthickness, radius + halfthickness, 0, M_PI, std::min(zlow, zhigh), std::max(zlow, zhigh)))
       {
-	cout << "TpcClusterizer process hitsetkey " << hitsetitr->first
-	     << " layer " << (int) TrkrDefs::getLayer(hitsetitr->first)
-	     << " side " << (int) TpcDefs::getSide(hitsetitr->first)
-	     << " sector " << (int) TpcDefs::getSectorId(hitsetitr->first)
-	     << endl;
-	if (Verbosity() > 5) hitset->identify();
+        continue;
       }
+    }
+    hitsets.push_back(make_pair(ihitset, layergeom));
+  }
 
-    // we have a single hitset, get the info that identifies the module
-    // int sector = TpcDefs::getSectorId(hitsetitr->first);
-    int side = TpcDefs::getSide(hitsetitr->first);
-
-    // we will need the geometry object for this layer to get the global position
-    PHG4CylinderCellGeom *layergeom = geom_container->GetLayerCellGeom(layer);
-    int NPhiBins = layergeom->get_phibins();
-    NPhiBinsMin = 0;
-    NPhiBinsMax = NPhiBins;
+  // hitsets are independent, each thread picks the next unprocessed one
+  // and fills its own result. Debug output (ntuples, printout) is only done
+  // single threaded
+  std::vector<HitSetClusters> results(hitsets.size());
+  unsigned int nthreads = (Verbosity() > 0) ? 1 : std::min<unsigned int>(m_NThreads, hitsets.size());
+  if (nthreads < 1)
+  {
+    nthreads = 1;
+  }
+  if (m_Grids.size() < nthreads)
+  {
+    m_Grids.resize(nthreads);
+  }
+  if (nthreads == 1)
+  {
+    for (unsigned int i = 0; i < hitsets.size(); i++)
+    {
+      cluster_hitset(hitsets[i].first, hitsets[i].second, m_Grids[0], results[i]);
+    }
+  }
+  else
+  {
+    std::atomic<unsigned int> next(0);
+    std::vector<std::future<void>> workers;
+    for (unsigned int ithread = 0; ithread < nthreads; ithread++)
+    {
+      workers.push_back(std::async(std::launch::async, [this, &hitsets, &results, &next, ithread]() {
+        unsigned int i;
+        while ((i = next++) < hitsets.size())
+        {
+          cluster_hitset(hitsets[i].first, hitsets[i].second, m_Grids[ithread], results[i]);
+        }
+      }));
+    }
+    for (unsigned int ithread = 0; ithread < workers.size(); ithread++)
+    {
+      workers[ithread].get();
+    }
+  }
 
-    int NZBins = layergeom->get_zbins();
-    if (side == 0)
+  // merge the results in hitset order into the node tree
+  TrkrClusterContainer::Map newclusters;
+  unsigned int nclusters = 0;
+  for (unsigned int i = 0; i < results.size(); i++)
+  {
+    nclusters += results[i].clusters.size();
+  }
+  newclusters.reserve(nclusters);
+  for (unsigned int i = 0; i < results.size(); i++)
+  {
+    for (const ClusterData &data : results[i].clusters)
     {
-      NZBinsMin = 0;
-      NZBinsMax = NZBins / 2;
+      TrkrClusterv1 *clus = new TrkrClusterv1();
+      clus->setClusKey(data.key);
+      clus->setAdc(data.adc);
+      clus->setPosition(0, data.position[0]);
+      clus->setPosition(1, data.position[1]);
+      clus->setPosition(2, data.position[2]);
+      clus->setGlobal();
+      for (int j = 0; j < 3; j++)
+      {
+        for (int k = 0; k < 3; k++)
+        {
+          clus->setSize(j, k, data.size[j][k]);
+          clus->setError(j, k, data.error[j][k]);
+        }
+      }
+      newclusters.push_back(make_pair(data.key, clus));
     }
-    else
+  }
+  m_clusterlist->addClusters(newclusters);
+
+  // Add the hit associations to the TrkrClusterHitAssoc node
+  // we need the cluster key and all associated hit keys (note: the cluster key includes the hitset key)
+  TrkrClusterHitAssoc::Map newassocs;
+  unsigned int nassoc = 0;
+  for (unsigned int i = 0; i < results.size(); i++)
+  {
+    nassoc += results[i].assoc.size();
+  }
+  newassocs.reserve(nassoc);
+  for (unsigned int i = 0; i < results.size(); i++)
+  {
+    newassocs.insert(newassocs.end(), results[i].assoc.begin(), results[i].assoc.end());
+  }
+  m_clusterhitassoc->addAssocs(newassocs);
+
+  if (Verbosity() > 100)
+  {
+    cout << "Dump clusters after TpcClusterizer" << endl;
+    m_clusterlist->identify();
+  }
+
+  if (Verbosity() > 100)
+  {
+    cout << "Dump cluster hit associations after TpcClusterizer" << endl;
+    m_clusterhitassoc->identify();
+  }
+
+  return Fun4AllReturnCodes::EVENT_OK;
+}
+
+void TpcClusterizer::cluster_hitset(const unsigned int ihitset, PHG4CylinderCellGeom *layergeom, AdcGrid &grid, HitSetClusters &result)
+{
+  int print_layer = 18;
+
+  TrkrDefs::hitsetkey hitsetkey = m_FlatHits.hitsetkeys[ihitset];
+  int layer = TrkrDefs::getLayer(hitsetkey);
+  if (Verbosity() > 1)
+    if (layer == print_layer)
     {
-      NZBinsMin = NZBins / 2 + 1;
-      NZBinsMax = NZBins;
+	cout << "TpcClusterizer process hitsetkey " << hitsetkey
+	     << " layer " << (int) TrkrDefs::getLayer(hitsetkey)
+	     << " side " << (int) TpcDefs::getSide(hitsetkey)
+	     << " sector " << (int) TpcDefs::getSectorId(hitsetkey)
+	     << endl;
+	if (Verbosity() > 5) m_hits->findHitSet(hitsetkey)->identify();
     }
 
-    // for convenience, create a 2D vector to store adc values in and initialize to zero
-    std::vector<std::vector<double>> adcval(NPhiBins, std::vector<double>(NZBins, 0));
+  // we have a single hitset, get the info that identifies the module
+  // int sector = TpcDefs::getSectorId(hitsetkey);
+  int side = TpcDefs::getSide(hitsetkey);
+
+  // we will need the geometry object for this layer to get the global position
+  int NPhiBins = layergeom->get_phibins();
+  grid.NPhiBinsMin = 0;
+  grid.NPhiBinsMax = NPhiBins;
+
+  int NZBins = layergeom->get_zbins();
+  if (side == 0)
+  {
+    grid.NZBinsMin = 0;
+    grid.NZBinsMax = NZBins / 2;
+  }
+  else
+  {
+    grid.NZBinsMin = NZBins / 2 + 1;
+    grid.NZBinsMax = NZBins;
+  }
+
+  // the adc values go into a contiguous (phi, z) array with one empty bin
+  // on each side. The array is reused, only the filled bins are cleared
+  // at the end, so it is zero whenever a new hitset starts
+  grid.stride = grid.NZBinsMax - grid.NZBinsMin + 2;
+  unsigned int gridsize = (grid.NPhiBinsMax - grid.NPhiBinsMin + 2) * grid.stride;
+  if (grid.adc.size() < gridsize)
+  {
+    grid.adc.resize(gridsize, 0);
+  }
+  grid.filled.clear();
 
-    TrkrHitSet::ConstRange hitrangei = hitset->getHits();
-    for (TrkrHitSet::ConstIterator hitr = hitrangei.first;
-         hitr != hitrangei.second;
-         ++hitr)
+  for (unsigned int ihit = m_FlatHits.offsets[ihitset]; ihit < m_FlatHits.offsets[ihitset + 1]; ihit++)
+  {
+    int phibin = TpcDefs::getPad(m_FlatHits.hitkeys[ihit]);
+    int zbin = TpcDefs::getTBin(m_FlatHits.hitkeys[ihit]);
+    if (phibin < grid.NPhiBinsMin || phibin >= grid.NPhiBinsMax || zbin < grid.NZBinsMin || zbin >= grid.NZBinsMax)
     {
-      int phibin = TpcDefs::getPad(hitr->first);
-      int zbin = TpcDefs::getTBin(hitr->first);
-      if (hitr->second->getAdc() > 0)
+      if (Verbosity() > 0)
+        cout << PHWHERE << " hit phibin " << phibin << " zbin " << zbin << " outside of hitset " << hitsetkey << ", ignored" << endl;
+      continue;
+    }
+    if (m_roi && !m_roi->contains(layergeom->get_radius(), layergeom->get_phicenter(phibin), layergeom->get_zcenter(zbin)))
+    {
+      continue;
+    }
+    if (m_FlatHits.adc[ihit] > 0)
 	{
-	  adcval[phibin][zbin] = (double) hitr->second->getAdc() - pedestal;
+	  int idx = grid.index(phibin, zbin);
+	  grid.adc[idx] = (double) m_FlatHits.adc[ihit] - pedestal;
+	  grid.filled.push_back(idx);
 
 	  if (Verbosity() > 2)
 	    if (layer == print_layer)
-	      cout << " add hit in layer " << layer << " with phibin " << phibin << " zbin " << zbin << " adcval " << adcval[phibin][zbin] << endl;
+	      cout << " add hit in layer " << layer << " with phibin " << phibin << " zbin " << zbin << " adcval " << grid.value(phibin, zbin) << endl;
 	  
 	  if(Verbosity() > 10)
 	    //if (layer == print_layer)
-	    hit_nt->Fill(phibin, zbin, layer, adcval[phibin][zbin]);
+	    hit_nt->Fill(phibin, zbin, layer, grid.value(phibin, zbin));
 	}
-    }
+  }
 
-    int phibin_last = -1;
-    int zbin_last = -1;
-    vector<int> phibinlo;
-    vector<int> phibinhi;
-    vector<int> zbinlo;
-    vector<int> zbinhi;
-    // we want to search the hit list for local maxima in phi-z space and cluster around them
-    for (TrkrHitSet::ConstIterator hitr = hitrangei.first;
-         hitr != hitrangei.second;
-         ++hitr)
-    {
-      int phibin = TpcDefs::getPad(hitr->first);
-      int zbin = TpcDefs::getTBin(hitr->first);
-      if (!is_local_maximum(phibin, zbin, adcval)) continue;
+  // we want to search the hit list for local maxima in phi-z space and cluster around them.
+  // Bins without a hit or with a hit outside of the regions of interest are empty, they
+  // cannot be the maximum next to a positive bin, so only the filled bins are tested
+  grid.peak.resize(grid.filled.size());
+  m_PeakFinder->FindPeaks(grid.adc.data(), grid.stride, grid.filled.data(), grid.filled.size(), grid.peak.data());
+
+  int phibin_last = -1;
+  int zbin_last = -1;
+  vector<int> phibinlo;
+  vector<int> phibinhi;
+  vector<int> zbinlo;
+  vector<int> zbinhi;
+  for (unsigned int i = 0; i < grid.filled.size(); i++)
+  {
+    if (!grid.peak[i]) continue;
+    const int phibin = grid.phibin(grid.filled[i]);
+    const int zbin = grid.zbin(grid.filled[i]);
 
-      // eliminate double counting when two contiguous adcvals are identical (both bins will register as local maximum)
-      if(phibin == phibin_last -1 || phibin == phibin_last || phibin == phibin_last + 1)
+    // eliminate double counting when two contiguous adcvals are identical (both bins will register as local maximum)
+    if(phibin == phibin_last -1 || phibin == phibin_last || phibin == phibin_last + 1)
 	if(zbin == zbin_last -1 || zbin == zbin_last || zbin == zbin_last + 1)
 	  continue;
-      phibin_last = phibin;
-      zbin_last = zbin;
+    phibin_last = phibin;
+    zbin_last = zbin;
 
-      int phiup = 0;
-      int phidown = 0;
-      int zup = 0;
-      int zdown = 0;
-      // cluster the hits around this local maximum
-      get_cluster(phibin, zbin, phiup, phidown, zup, zdown, adcval);
+    int phiup = 0;
+    int phidown = 0;
+    int zup = 0;
+    int zdown = 0;
+    // cluster the hits around this local maximum
+    get_cluster(phibin, zbin, phiup, phidown, zup, zdown, grid);
 
-      if (phiup == 0 && phidown == 0 && zup == 0 and zdown == 0) continue;  // ignore isolated noise hit
+    if (phiup == 0 && phidown == 0 && zup == 0 and zdown == 0) continue;  // ignore isolated noise hit
 
-      // Add this cluster to a vector of clusters for later analysis
-      phibinlo.push_back(phibin - phidown);
-      phibinhi.push_back(phibin + phiup);
-      zbinlo.push_back(zbin - zdown);
-      zbinhi.push_back(zbin + zup);
+    // Add this cluster to a vector of clusters for later analysis
+    phibinlo.push_back(phibin - phidown);
+    phibinhi.push_back(phibin + phiup);
+    zbinlo.push_back(zbin - zdown);
+    zbinhi.push_back(zbin + zup);
 
-      if(Verbosity() > 10) 
+    if(Verbosity() > 10) 
 	//if (layer == print_layer)
-	cluster_nt->Fill(phibin, zbin, layer, adcval[phibin][zbin]);
-
-      if (Verbosity() > 2)
-        if (layer == print_layer)
-          cout << " cluster found in layer " << layer << " around hitkey " << hitr->first << " with zbin " << zbin << " zup " << zup << " zdown " << zdown
-               << " phibin " << phibin << " phiup " << phiup << " phidown " << phidown << endl;
-    }  // end loop over hits in this hitset
-
-    // Now we analyze the clusters to get their parameters
-    for (unsigned int iclus = 0; iclus < phibinlo.size(); iclus++)
-    {
-      //cout << "TpcClusterizer: process cluster iclus = " << iclus <<  " in layer " << layer << endl;
-      // loop over the hits in this cluster
-      double zsum = 0.0;
-      double phi_sum = 0.0;
-      double adc_sum = 0.0;
-      double radius = layergeom->get_radius();  // returns center of layer
-      if (Verbosity() > 2)
-        if (layer == print_layer)
-        {
-          cout << "iclus " << iclus << " layer " << layer << " radius " << radius << endl;
-          cout << "    z bin range " << zbinlo[iclus] << " to " << zbinhi[iclus] << " phibin range " << phibinlo[iclus] << " to " << phibinhi[iclus] << endl;
-        }
+	cluster_nt->Fill(phibin, zbin, layer, grid.value(phibin, zbin));
 
-      std::vector<TrkrDefs::hitkey> hitkeyvec;
-      for (int iphi = phibinlo[iclus]; iphi <= phibinhi[iclus]; iphi++)
-      {
-        for (int iz = zbinlo[iclus]; iz <= zbinhi[iclus]; iz++)
-        {
-          double phi_center = layergeom->get_phicenter(iphi);
-          double z = layergeom->get_zcenter(iz);
-
-          zsum += z * adcval[iphi][iz];
-          phi_sum += phi_center * adcval[iphi][iz];
-          adc_sum += adcval[iphi][iz];
-
-          // capture the hitkeys for all non-zero adc values
-          if (adcval[iphi][iz] != 0)
-          {
-            TrkrDefs::hitkey hitkey = TpcDefs::genHitKey(iphi, iz);
-            hitkeyvec.push_back(hitkey);
-          }
-        }
-      }
-
-      if (adc_sum < 10) continue;  // skip obvious noise "clusters"
-
-      // This is the global position
-      double clusphi = phi_sum / adc_sum;
-      double clusz = zsum / adc_sum;
-
-      // create the cluster entry directly in the node tree
-      TrkrDefs::cluskey ckey = TpcDefs::genClusKey(hitset->getHitSetKey(), iclus);
-      TrkrClusterv1 *clus = static_cast<TrkrClusterv1 *>((m_clusterlist->findOrAddCluster(ckey))->second);
-
-      double phi_size = (double) (phibinhi[iclus] - phibinlo[iclus] + 1) * radius * layergeom->get_phistep();
-      double z_size = (double) (zbinhi[iclus] - zbinlo[iclus] + 1) * layergeom->get_zstep();
+    if (Verbosity() > 2)
+      if (layer == print_layer)
+        cout << " cluster found in layer " << layer << " around hitkey " << TpcDefs::genHitKey(phibin, zbin) << " with zbin " << zbin << " zup " << zup << " zdown " << zdown
+             << " phibin " << phibin << " phiup " << phiup << " phidown " << phidown << endl;
+  }  // end loop over hits in this hitset
 
-      // Estimate the errors
-      double dphi2_adc = 0.0;
-      double dphi_adc = 0.0;
-      double dz2_adc = 0.0;
-      double dz_adc = 0.0;
-      for (int iz = zbinlo[iclus]; iz <= zbinhi[iclus]; iz++)
+  // Now we analyze the clusters to get their parameters
+  for (unsigned int iclus = 0; iclus < phibinlo.size(); iclus++)
+  {
+    //cout << "TpcClusterizer: process cluster iclus = " << iclus <<  " in layer " << layer << endl;
+    double radius = layergeom->get_radius();  // returns center of layer
+    if (Verbosity() > 2)
+      if (layer == print_layer)
       {
-        for (int iphi = phibinlo[iclus]; iphi <= phibinhi[iclus]; iphi++)
-        {
-          double dphi = layergeom->get_phicenter(iphi) - clusphi;
-          dphi2_adc += dphi * dphi * adcval[iphi][iz];
-          dphi_adc += dphi * adcval[iphi][iz];
-
-          double dz = layergeom->get_zcenter(iz) - clusz;
-          dz2_adc += dz * dz * adcval[iphi][iz];
-          dz_adc += dz * adcval[iphi][iz];
-        }
+        cout << "iclus " << iclus << " layer " << layer << " radius " << radius << endl;
+        cout << "    z bin range " << zbinlo[iclus] << " to " << zbinhi[iclus] << " phibin range " << phibinlo[iclus] << " to " << phibinhi[iclus] << endl;
       }
-      double phi_cov = (dphi2_adc / adc_sum - dphi_adc * dphi_adc / (adc_sum * adc_sum));
-      double z_cov = dz2_adc / adc_sum - dz_adc * dz_adc / (adc_sum * adc_sum);
-
-      //cout << " layer " << layer << " z_cov " << z_cov << " dz2_adc " << dz2_adc << " adc_sum " <<  adc_sum << " dz_adc " << dz_adc << endl;
-
-      // phi_cov = (weighted mean of dphi^2) - (weighted mean of dphi)^2,  which is essentially the weighted mean of dphi^2. The error is then:
-      // e_phi = sigma_dphi/sqrt(N) = sqrt( sigma_dphi^2 / N )  -- where N is the number of samples of the distribution with standard deviation sigma_dphi
-      //    - N is the number of electrons that drift to the readout plane
-      // We have to convert (sum of adc units for all bins in the cluster) to number of ionization electrons N
-      // Conversion gain is 20 mV/fC - relates total charge collected on pad to PEAK voltage out of ADC. The GEM gain is assumed to be 2000
-      // To get equivalent charge per Z bin, so that summing ADC input voltage over all Z bins returns total input charge, divide voltages by 2.4 for 80 ns SAMPA
-      // Equivalent charge per Z bin is then  (ADU x 2200 mV / 1024) / 2.4 x (1/20) fC/mV x (1/1.6e-04) electrons/fC x (1/2000) = ADU x 0.14
-
-      double phi_err = radius * sqrt(phi_cov / (adc_sum * 0.14));
-      if (phi_err == 0.0)  // a single phi bin will cause this
-        phi_err = radius * layergeom->get_phistep() / sqrt(12.0);
-
-      double z_err = sqrt(z_cov / (adc_sum * 0.14));
-      if (z_err == 0.0)
-        z_err = layergeom->get_zstep() / sqrt(12.0);
-
-      // This corrects the bias introduced by the asymmetric SAMPA chip shaping - assumes 80 ns shaping time
-      if (clusz < 0)
-        clusz -= zz_shaping_correction;
-      else
-        clusz += zz_shaping_correction;
-
-      // Fill in the cluster details
-      //================
-      clus->setAdc(adc_sum);
-      clus->setPosition(0, radius * cos(clusphi));
-      clus->setPosition(1, radius * sin(clusphi));
-      clus->setPosition(2, clusz);
-      clus->setGlobal();
 
-      TMatrixF DIM(3, 3);
-      DIM[0][0] = 0.0;
-      DIM[0][1] = 0.0;
-      DIM[0][2] = 0.0;
-      DIM[1][0] = 0.0;
-      DIM[1][1] = pow(0.5 * phi_size,2);  //cluster_v1 expects 1/2 of actual size
-      DIM[1][2] = 0.0;
-      DIM[2][0] = 0.0;
-      DIM[2][1] = 0.0;
-      DIM[2][2] = pow(0.5 * z_size,2);
-
-      TMatrixF ERR(3, 3);
-      ERR[0][0] = 0.0;
-      ERR[0][1] = 0.0;
-      ERR[0][2] = 0.0;
-      ERR[1][0] = 0.0;
-      ERR[1][1] = phi_err * phi_err;  //cluster_v1 expects rad, arc, z as elementsof covariance
-      ERR[1][2] = 0.0;
-      ERR[2][0] = 0.0;
-      ERR[2][1] = 0.0;
-      ERR[2][2] = z_err * z_err;
-
-      TMatrixF ROT(3, 3);
-      ROT[0][0] = cos(clusphi);
-      ROT[0][1] = -sin(clusphi);
-      ROT[0][2] = 0.0;
-      ROT[1][0] = sin(clusphi);
-      ROT[1][1] = cos(clusphi);
-      ROT[1][2] = 0.0;
-      ROT[2][0] = 0.0;
-      ROT[2][1] = 0.0;
-      ROT[2][2] = 1.0;
-
-      TMatrixF ROT_T(3, 3);
-      ROT_T.Transpose(ROT);
-
-      TMatrixF COVAR_DIM(3, 3);
-      COVAR_DIM = ROT * DIM * ROT_T;
-
-      clus->setSize(0, 0, COVAR_DIM[0][0]);
-      clus->setSize(0, 1, COVAR_DIM[0][1]);
-      clus->setSize(0, 2, COVAR_DIM[0][2]);
-      clus->setSize(1, 0, COVAR_DIM[1][0]);
-      clus->setSize(1, 1, COVAR_DIM[1][1]);
-      clus->setSize(1, 2, COVAR_DIM[1][2]);
-      clus->setSize(2, 0, COVAR_DIM[2][0]);
-      clus->setSize(2, 1, COVAR_DIM[2][1]);
-      clus->setSize(2, 2, COVAR_DIM[2][2]);
-      //cout << " covar_dim[2][2] = " <<  COVAR_DIM[2][2] << endl;
-
-      TMatrixF COVAR_ERR(3, 3);
-      COVAR_ERR = ROT * ERR * ROT_T;
-
-      clus->setError(0, 0, COVAR_ERR[0][0]);
-      clus->setError(0, 1, COVAR_ERR[0][1]);
-      clus->setError(0, 2, COVAR_ERR[0][2]);
-      clus->setError(1, 0, COVAR_ERR[1][0]);
-      clus->setError(1, 1, COVAR_ERR[1][1]);
-      clus->setError(1, 2, COVAR_ERR[1][2]);
-      clus->setError(2, 0, COVAR_ERR[2][0]);
-      clus->setError(2, 1, COVAR_ERR[2][1]);
-      clus->setError(2, 2, COVAR_ERR[2][2]);
-
-      /*
+    ClusterMoments moments;
+    if (m_FloatPrecision > 0)
+    {
+      cluster_moments<float>(grid, layergeom, phibinlo[iclus], phibinhi[iclus], zbinlo[iclus], zbinhi[iclus], moments);
+    }
+    else
+    {
+      cluster_moments<double>(grid, layergeom, phibinlo[iclus], phibinhi[iclus], zbinlo[iclus], zbinhi[iclus], moments);
+    }
+    const double adc_sum = moments.adc_sum;
+    if (adc_sum < 10) continue;  // skip obvious noise "clusters"
+
+    // This is the global position
+    const double clusphi = moments.phi;
+    double clusz = moments.z;
+
+    // the cluster is created and added to the node tree after all hitsets are done,
+    // workers only fill plain values
+    TrkrDefs::cluskey ckey = TpcDefs::genClusKey(hitsetkey, iclus);
+    result.clusters.push_back(ClusterData());
+    ClusterData &clus = result.clusters.back();
+    clus.key = ckey;
+
+    double phi_size = (double) (phibinhi[iclus] - phibinlo[iclus] + 1) * radius * layergeom->get_phistep();
+    double z_size = (double) (zbinhi[iclus] - zbinlo[iclus] + 1) * layergeom->get_zstep();
+
+    const double phi_cov = moments.phi_cov;
+    const double z_cov = moments.z_cov;
+
+    //cout << " layer " << layer << " z_cov " << z_cov << " dz2_adc " << dz2_adc << " adc_sum " <<  adc_sum << " dz_adc " << dz_adc << endl;
+
+    // phi_cov = (weighted mean of dphi^2) - (weighted mean of dphi)^2,  which is essentially the weighted mean of dphi^2. The error is then:
+    // e_phi = sigma_dphi/sqrt(N) = sqrt( sigma_dphi^2 / N )  -- where N is the number of samples of the distribution with standard deviation sigma_dphi
+    //    - N is the number of electrons that drift to the readout plane
+    // We have to convert (sum of adc units for all bins in the cluster) to number of ionization electrons N
+    // Conversion gain is 20 mV/fC - relates total charge collected on pad to PEAK voltage out of ADC. The GEM gain is assumed to be 2000
+    // To get equivalent charge per Z bin, so that summing ADC input voltage over all Z bins returns total input charge, divide voltages by 2.4 for 80 ns SAMPA
+    // Equivalent charge per Z bin is then  (ADU x 2200 mV / 1024) / 2.4 x (1/20) fC/mV x (1/1.6e-04) electrons/fC x (1/2000) = ADU x 0.14
+
+    double phi_err = radius * sqrt(phi_cov / (adc_sum * 0.14));
+    if (phi_err == 0.0)  // a single phi bin will cause this
+      phi_err = radius * layergeom->get_phistep() / sqrt(12.0);
+
+    double z_err = sqrt(z_cov / (adc_sum * 0.14));
+    if (z_err == 0.0)
+      z_err = layergeom->get_zstep() / sqrt(12.0);
+
+    // This corrects the bias introduced by the asymmetric SAMPA chip shaping - assumes 80 ns shaping time
+    if (clusz < 0)
+      clusz -= zz_shaping_correction;
+    else
+      clusz += zz_shaping_correction;
+
+    // Fill in the cluster details
+    //================
+    clus.adc = adc_sum;
+    clus.position[0] = radius * cos(clusphi);
+    clus.position[1] = radius * sin(clusphi);
+    clus.position[2] = clusz;
+
+    TMatrixF DIM(3, 3);
+    DIM[0][0] = 0.0;
+    DIM[0][1] = 0.0;
+    DIM[0][2] = 0.0;
+    DIM[1][0] = 0.0;
+    DIM[1][1] = pow(0.5 * phi_size,2);  //cluster_v1 expects 1/2 of actual size
+    DIM[1][2] = 0.0;
+    DIM[2][0] = 0.0;
+    DIM[2][1] = 0.0;
+    DIM[2][2] = pow(0.5 * z_size,2);
+
+    TMatrixF ERR(3, 3);
+    ERR[0][0] = 0.0;
+    ERR[0][1] = 0.0;
+    ERR[0][2] = 0.0;
+    ERR[1][0] = 0.0;
+    ERR[1][1] = phi_err * phi_err;  //cluster_v1 expects rad, arc, z as elementsof covariance
+    ERR[1][2] = 0.0;
+    ERR[2][0] = 0.0;
+    ERR[2][1] = 0.0;
+    ERR[2][2] = z_err * z_err;
+
+    TMatrixF ROT(3, 3);
+    ROT[0][0] = cos(clusphi);
+    ROT[0][1] = -sin(clusphi);
+    ROT[0][2] = 0.0;
+    ROT[1][0] = sin(clusphi);
+    ROT[1][1] = cos(clusphi);
+    ROT[1][2] = 0.0;
+    ROT[2][0] = 0.0;
+    ROT[2][1] = 0.0;
+    ROT[2][2] = 1.0;
+
+    TMatrixF ROT_T(3, 3);
+    ROT_T.Transpose(ROT);
+
+    TMatrixF COVAR_DIM(3, 3);
+    COVAR_DIM = ROT * DIM * ROT_T;
+
+    clus.size[0][0] = COVAR_DIM[0][0];
+    clus.size[0][1] = COVAR_DIM[0][1];
+    clus.size[0][2] = COVAR_DIM[0][2];
+    clus.size[1][0] = COVAR_DIM[1][0];
+    clus.size[1][1] = COVAR_DIM[1][1];
+    clus.size[1][2] = COVAR_DIM[1][2];
+    clus.size[2][0] = COVAR_DIM[2][0];
+    clus.size[2][1] = COVAR_DIM[2][1];
+    clus.size[2][2] = COVAR_DIM[2][2];
+    //cout << " covar_dim[2][2] = " <<  COVAR_DIM[2][2] << endl;
+
+    TMatrixF COVAR_ERR(3, 3);
+    COVAR_ERR = ROT * ERR * ROT_T;
+
+    clus.error[0][0] = COVAR_ERR[0][0];
+    clus.error[0][1] = COVAR_ERR[0][1];
+    clus.error[0][2] = COVAR_ERR[0][2];
+    clus.error[1][0] = COVAR_ERR[1][0];
+    clus.error[1][1] = COVAR_ERR[1][1];
+    clus.error[1][2] = COVAR_ERR[1][2];
+    clus.error[2][0] = COVAR_ERR[2][0];
+    clus.error[2][1] = COVAR_ERR[2][1];
+    clus.error[2][2] = COVAR_ERR[2][2];
+
+    /*
 	  for(int i=0;i<3;i++)
 	    for(int j=0;j<3;j++)
-	      cout << "    i " << i << " j " << j << " clusphi " << clusphi << " clus error " << clus->getError(i,j) 
-		   << " clus size " << clus->getSize(i,j) << " ROT " << ROT[i][j] << " ROT_T " << ROT_T[i][j] << " COVAR_ERR " << COVAR_ERR[i][j] << endl;
+	      cout << "    i " << i << " j " << j << " clusphi " << clusphi << " clus error " << clus.error[i][j] 
+		   << " clus size " << clus.size[i][j] << " ROT " << ROT[i][j] << " ROT_T " << ROT_T[i][j] << " COVAR_ERR " << COVAR_ERR[i][j] << endl;
 	  */
 
-      // Add the hit associations to the TrkrClusterHitAssoc node
-      // we need the cluster key and all associated hit keys (note: the cluster key includes the hitset key)
-      for (unsigned int i = 0; i < hitkeyvec.size(); i++)
+    // keep the hit associations for the TrkrClusterHitAssoc node, all non-zero adc values of the cluster
+    for (int iphi = phibinlo[iclus]; iphi <= phibinhi[iclus]; iphi++)
+    {
+      for (int iz = zbinlo[iclus]; iz <= zbinhi[iclus]; iz++)
       {
-        m_clusterhitassoc->addAssoc(ckey, hitkeyvec[i]);
+        if (grid.value(iphi, iz) != 0)
+        {
+          result.assoc.push_back(make_pair(ckey, TpcDefs::genHitKey(iphi, iz)));
+        }
       }
+    }
 
-    }  // end loop over clusters for this hitset
-  }    // end loop over hitsets
+  }  // end loop over clusters for this hitset
 
-  if (Verbosity() > 100)
+  // clear the filled bins for the next hitset
+  for (unsigned int i = 0; i < grid.filled.size(); i++)
   {
-    cout << "Dump clusters after TpcClusterizer" << endl;
-    m_clusterlist->identify();
+    grid.adc[grid.filled[i]] = 0;
   }
-
-  if (Verbosity() > 100)
-  {
-    cout << "Dump cluster hit associations after TpcClusterizer" << endl;
-    m_clusterhitassoc->identify();
-  }
-
-  return Fun4AllReturnCodes::EVENT_OK;
 }
 
 int TpcClusterizer::End(PHCompositeNode *topNode)
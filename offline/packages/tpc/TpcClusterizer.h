@@ -3,40 +3,126 @@
 
 #include <fun4all/SubsysReco.h>
 
+#include <trackbase/TrkrDefs.h>
+#include <trackbase/TrkrHitSetContainer.h>
+
 #include <vector>
 #include <string>
+#include <utility>
 
 class PHCompositeNode;
-class TrkrHitSetContainer;
+class PHG4CylinderCellGeom;
 class TrkrClusterContainer;
 class TrkrClusterHitAssoc;
+class TrkrRegionOfInterest;
+class TpcPeakFinder;
 class TNtuple;
 
 class TpcClusterizer : public SubsysReco
 {
  public:
   TpcClusterizer(const std::string &name = "TpcClusterizer");
-  virtual ~TpcClusterizer(){}
+  virtual ~TpcClusterizer();
 
   int InitRun(PHCompositeNode *topNode);
   int process_event(PHCompositeNode *topNode);
   int End(PHCompositeNode *topNode);
 
+  //! clusters are added to the shared containers in one locked call, the debug printout reads them
+  bool ThreadSafe() const { return Verbosity() == 0; }
+
+  //! number of threads clustering the hitsets in parallel (default 1)
+  void NThreads(const unsigned int n) { m_NThreads = (n > 0) ? n : 1; }
+
+  //! sum the cluster moments in float instead of double, default from the RECO_FLOAT_PRECISION flag
+  void FloatPrecision(const bool b) { m_FloatPrecision = b ? 1 : 0; }
+
+  //! backend for the local maximum search, takes ownership (default TpcPeakFinderCpu)
+  void SetPeakFinder(TpcPeakFinder *finder);
+
  private:
-  bool is_local_maximum(int phi, int z, std::vector<std::vector<double>> &adcval);
-  void get_cluster(int phibin, int zbin, int &phiup, int &phidown, int &zup, int &zdown, std::vector<std::vector<double>> &adcval);
+  //! adc values of one hitset in a contiguous phi x z array with a border of empty bins,
+  //! the filled bins are also kept as a flat list of array indices in hit key order
+  struct AdcGrid
+  {
+    AdcGrid()
+      : NPhiBinsMin(0)
+      , NPhiBinsMax(0)
+      , NZBinsMin(0)
+      , NZBinsMax(0)
+      , stride(0)
+    {
+    }
+    int NPhiBinsMin;
+    int NPhiBinsMax;
+    int NZBinsMin;
+    int NZBinsMax;
+    int stride;
+    std::vector<float> adc;
+    std::vector<int> filled;
+    //! 1 if filled[i] is a local maximum
+    std::vector<char> peak;
+    int index(const int phibin, const int zbin) const { return (phibin - NPhiBinsMin + 1) * stride + (zbin - NZBinsMin + 1); }
+    float value(const int phibin, const int zbin) const { return adc[index(phibin, zbin)]; }
+    int phibin(const int idx) const { return idx / stride - 1 + NPhiBinsMin; }
+    int zbin(const int idx) const { return idx % stride - 1 + NZBinsMin; }
+  };
+
+  //! cluster parameters found by a worker, the TrkrCluster objects are created when the
+  //! results are merged on the calling thread
+  struct ClusterData
+  {
+    TrkrDefs::cluskey key;
+    double adc;
+    double position[3];
+    float size[3][3];
+    float error[3][3];
+  };
+
+  //! clusters and cluster-hit associations found in one hitset
+  struct HitSetClusters
+  {
+    std::vector<ClusterData> clusters;
+    std::vector<std::pair<TrkrDefs::cluskey, TrkrDefs::hitkey>> assoc;
+  };
+
+  //! adc weighted position and spread of the bins of one cluster
+  struct ClusterMoments
+  {
+    double adc_sum;
+    double phi;
+    double z;
+    double phi_cov;
+    double z_cov;
+  };
+
+  //! clusters the hitset m_FlatHits.hitsetkeys[ihitset]
+  void cluster_hitset(const unsigned int ihitset, PHG4CylinderCellGeom *layergeom, AdcGrid &grid, HitSetClusters &result);
+  void get_cluster(int phibin, int zbin, int &phiup, int &phidown, int &zup, int &zdown, const AdcGrid &grid) const;
+#if !defined(__CINT__) || defined(__CLING__)
+  //! moments of the bins [philo, phihi] x [zlo, zhi], the sums are done in Scalar. Position
+  //! and spread are only filled if adc_sum reaches the cluster threshold
+  template <typename Scalar>
+  void cluster_moments(const AdcGrid &grid, PHG4CylinderCellGeom *layergeom, const int philo, const int phihi, const int zlo, const int zhi, ClusterMoments &moments) const;
+#endif
 
   TrkrHitSetContainer *m_hits;
   TrkrClusterContainer *m_clusterlist;
   TrkrClusterHitAssoc *m_clusterhitassoc;
+  //! optional regions of interest, only hits inside are clustered
+  TrkrRegionOfInterest *m_roi;
+  TpcPeakFinder *m_PeakFinder;
+  //! TPC hits of the event, exported once from m_hits
+  TrkrHitSetContainer::FlatHits m_FlatHits;
 
   double zz_shaping_correction;
   double pedestal;
 
-  int NPhiBinsMax;
-  int NPhiBinsMin;
-  int NZBinsMax;
-  int NZBinsMin;
+  unsigned int m_NThreads;
+  //! -1: take it from the RECO_FLOAT_PRECISION flag
+  int m_FloatPrecision;
+  //! one grid per thread, reused for all hitsets
+  std::vector<AdcGrid> m_Grids;
 
   TNtuple *hit_nt;
   TNtuple *cluster_nt;
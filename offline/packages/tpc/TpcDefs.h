@@ -39,49 +39,47 @@ static const unsigned int kBitShiftTBin __attribute__((unused)) = 0;
 static const uint16_t MAXPAD __attribute__((unused)) = 1024;
 static const uint16_t MAXTBIN __attribute__((unused)) = 512;
 
-#endif  // __CINT__
-
 /**
    * @brief Get the sector id from hitsetkey
    * @param[in] hitsetkey
    * @param[out] sector id
    */
-uint8_t getSectorId(TrkrDefs::hitsetkey key);
+constexpr uint8_t getSectorId(const TrkrDefs::hitsetkey key) { return key >> kBitShiftSectorId; }
 
 /**
    * @brief Get the sector id from cluskey
    * @param[in] cluskey
    * @param[out] sector id
    */
-uint8_t getSectorId(TrkrDefs::cluskey key);
+constexpr uint8_t getSectorId(const TrkrDefs::cluskey key) { return getSectorId(TrkrDefs::getHitSetKeyFromClusKey(key)); }
 
 /**
    * @brief Get the side from hitsetkey
    * @param[in] hitsetkey
    * @param[out] side
    */
-uint8_t getSide(TrkrDefs::hitsetkey key);
+constexpr uint8_t getSide(const TrkrDefs::hitsetkey key) { return key >> kBitShiftSide; }
 
 /**
    * @brief Get the side id from cluskey
    * @param[in] cluskey
    * @param[out] side id
    */
-uint8_t getSide(TrkrDefs::cluskey key);
+constexpr uint8_t getSide(const TrkrDefs::cluskey key) { return getSide(TrkrDefs::getHitSetKeyFromClusKey(key)); }
 
 /**
    * @brief Get the pad index from hitkey
    * @param[in] hitkey
    * @param[out] pad index
    */
-uint16_t getPad(TrkrDefs::hitkey key);
+constexpr uint16_t getPad(const TrkrDefs::hitkey key) { return key >> kBitShiftPad; }
 
 /**
    * @brief Get the time bin from hitkey
    * @param[in] hitkey
    * @param[out] time bin
    */
-uint16_t getTBin(TrkrDefs::hitkey key);
+constexpr uint16_t getTBin(const TrkrDefs::hitkey key) { return key >> kBitShiftTBin; }
 
 /**
    * @brief Generate a hitkey from a pad index and time bin
@@ -89,7 +87,10 @@ uint16_t getTBin(TrkrDefs::hitkey key);
    * @param[in] tbin Time bin
    * @param[out] hitkey
    */
-TrkrDefs::hitkey genHitKey(const uint16_t pad, const uint16_t tbin);
+constexpr TrkrDefs::hitkey genHitKey(const uint16_t pad, const uint16_t tbin)
+{
+  return (static_cast<TrkrDefs::hitkey>(pad) << kBitShiftPad) | (static_cast<TrkrDefs::hitkey>(tbin) << kBitShiftTBin);
+}
 
 /**
    * @brief Generate a hitsetkey for the tpc
@@ -101,7 +102,12 @@ TrkrDefs::hitkey genHitKey(const uint16_t pad, const uint16_t tbin);
    * Generate a hitsetkey for the tpc. The tracker id is known
    * implicitly and used in the function.
    */
-TrkrDefs::hitsetkey genHitSetKey(const uint8_t lyr, const uint8_t sector, const uint8_t side);
+constexpr TrkrDefs::hitsetkey genHitSetKey(const uint8_t lyr, const uint8_t sector, const uint8_t side)
+{
+  return TrkrDefs::genHitSetKey(TrkrDefs::TrkrId::tpcId, lyr) |
+         (static_cast<TrkrDefs::hitsetkey>(sector) << kBitShiftSectorId) |
+         (static_cast<TrkrDefs::hitsetkey>(side) << kBitShiftSide);
+}
 
 /**
    * @brief Generate a cluster key from indeces 
@@ -111,7 +117,10 @@ TrkrDefs::hitsetkey genHitSetKey(const uint8_t lyr, const uint8_t sector, const
    * @param[in] clusid Cluster id
    * @param[out] cluskey
    */
-TrkrDefs::cluskey genClusKey(const uint8_t lyr, const uint8_t sector, const uint8_t side, const uint32_t clusid);
+constexpr TrkrDefs::cluskey genClusKey(const uint8_t lyr, const uint8_t sector, const uint8_t side, const uint32_t clusid)
+{
+  return TrkrDefs::genClusKey(genHitSetKey(lyr, sector, side), clusid);
+}
 
 /**
    * @brief Generate a cluster key using a hitsetkey and cluster id
@@ -119,7 +128,27 @@ TrkrDefs::cluskey genClusKey(const uint8_t lyr, const uint8_t sector, const uint
    * @param[in] clusid Cluster id
    * @param[out] cluskey
    */
-TrkrDefs::cluskey genClusKey(const TrkrDefs::hitsetkey hskey, const uint32_t clusid);
+constexpr TrkrDefs::cluskey genClusKey(const TrkrDefs::hitsetkey hskey, const uint32_t clusid) { return TrkrDefs::genClusKey(hskey, clusid); }
+
+/**
+   * @brief hitsetkey of the tpc with its sector and side
+   */
+class HitSetKey : public TrkrDefs::TypedHitSetKey<TrkrDefs::tpcId>
+{
+ public:
+  constexpr explicit HitSetKey(const TrkrDefs::hitsetkey key)
+    : TrkrDefs::TypedHitSetKey<TrkrDefs::tpcId>(key)
+  {
+  }
+  constexpr HitSetKey(const uint8_t lyr, const uint8_t sector, const uint8_t side)
+    : TrkrDefs::TypedHitSetKey<TrkrDefs::tpcId>(genHitSetKey(lyr, sector, side))
+  {
+  }
+  constexpr uint8_t sector() const { return getSectorId(m_Key); }
+  constexpr uint8_t side() const { return getSide(m_Key); }
+};
+
+#endif  // __CINT__
 
 }  // namespace TpcDefs
 
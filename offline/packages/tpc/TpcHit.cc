@@ -8,6 +8,8 @@
 
 #include <trackbase/TrkrHit.h>  // for TrkrHit
 
+#include <phool/PHObjectPool.h>
+
 TpcHit::TpcHit()
   : TrkrHit()
 {
@@ -28,3 +30,13 @@ int TpcHit::isValid() const
   // valid if the adc is not equal to the default value
   return 0;
 }
+
+void *TpcHit::operator new(size_t size)
+{
+  return PHObjectPool<TpcHit>::allocate(size);
+}
+
+void TpcHit::operator delete(void *ptr, size_t size)
+{
+  PHObjectPool<TpcHit>::deallocate(ptr, size);
+}
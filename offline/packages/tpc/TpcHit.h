@@ -9,6 +9,7 @@
 
 #include <trackbase/TrkrHit.h>
 
+#include <cstddef>
 #include <iostream>             // for cout, ostream
 
 /**
@@ -25,7 +26,14 @@ class TpcHit : public TrkrHit
   //! dtor
   virtual ~TpcHit(){};
 
+#if !defined(__CINT__) || defined(__CLING__)
+  //! storage is recycled through PHObjectPool
+  static void *operator new(size_t size);
+  static void operator delete(void *ptr, size_t size);
+#endif
+
   // PHObject virtual overloads
+  virtual PHObject* CloneMe() const { return new TpcHit(*this); }
   virtual void identify(std::ostream& os = std::cout) const;
   virtual void Reset();
   virtual int isValid() const;
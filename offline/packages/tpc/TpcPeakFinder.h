@@ -0,0 +1,25 @@
+#ifndef TPC_TPCPEAKFINDER_H
+#define TPC_TPCPEAKFINDER_H
+
+/*!
+ * \brief backend interface for the local maximum search of TpcClusterizer
+ *
+ * The adc values of one hitset are handed over as a dense phi x z array
+ * with a border of empty bins and the flat list of its filled bins, so an
+ * implementation only works on plain arrays and can run on an accelerator.
+ * FindPeaks is called by all clustering threads at the same time.
+ */
+class TpcPeakFinder
+{
+ public:
+  virtual ~TpcPeakFinder() {}
+
+  //! peak[i] = 1 if the bin adc[filled[i]] is not smaller than any of its 8 neighbours,
+  //! stride is the number of z bins of a phi row (including the border)
+  virtual void FindPeaks(const float *adc, const int stride, const int *filled, const unsigned int nfilled, char *peak) const = 0;
+
+ protected:
+  TpcPeakFinder() {}
+};
+
+#endif
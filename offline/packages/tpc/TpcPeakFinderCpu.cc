@@ -0,0 +1,21 @@
+#include "TpcPeakFinderCpu.h"
+
+#include <algorithm>
+
+void TpcPeakFinderCpu::FindPeaks(const float *adc, const int stride, const int *filled, const unsigned int nfilled, char *peak) const
+{
+  // the grid has a border of empty bins, so the 3x3 neighbourhood
+  // can be scanned without checking the bounds. There is no dependence
+  // between the bins, each one only reads the grid and writes its flag
+  for (unsigned int i = 0; i < nfilled; i++)
+  {
+    const float *cell = adc + filled[i];
+    float maxval = cell[-stride - 1];
+    for (int iphi = -1; iphi <= 1; iphi++)
+    {
+      const float *row = cell + iphi * stride;
+      maxval = std::max(maxval, std::max(row[-1], std::max(row[0], row[1])));
+    }
+    peak[i] = !(maxval > cell[0]);
+  }
+}
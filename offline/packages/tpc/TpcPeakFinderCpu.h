@@ -0,0 +1,16 @@
+#ifndef TPC_TPCPEAKFINDERCPU_H
+#define TPC_TPCPEAKFINDERCPU_H
+
+#include "TpcPeakFinder.h"
+
+//! default peak finder, tests the filled bins one after the other on the calling thread
+class TpcPeakFinderCpu : public TpcPeakFinder
+{
+ public:
+  TpcPeakFinderCpu() {}
+  virtual ~TpcPeakFinderCpu() {}
+
+  void FindPeaks(const float *adc, const int stride, const int *filled, const unsigned int nfilled, char *peak) const;
+};
+
+#endif
@@ -0,0 +1,253 @@
+#include "TpcDistortionCorrection.h"
+
+#include <phool/phool.h>
+
+#include <TAxis.h>
+#include <TFile.h>
+#include <TH3.h>
+
+#include <algorithm>
+#include <cmath>
+#include <iostream>
+#include <memory>
+
+namespace
+{
+
+  /// number of positions corrected per block, buffers are on the stack
+  static constexpr unsigned int block_size = 64;
+
+  /// lower grid point and weight of the upper one, clamped to the grid
+  template<class Axis>
+    inline void locate( const Axis& axis, float x, int& i, float& f )
+  {
+    float u = (x - axis.min)*axis.inv_step;
+    const float umax = axis.n - 1;
+    u = std::min( std::max( u, 0.f ), umax );
+    i = std::min<int>( u, std::max( axis.n - 2, 0 ) );
+    f = u - i;
+  }
+
+  /// content of a histogram along r, linear between the bin centers of a possibly variable axis
+  float sample_r( TH3* h, int iphi, float r, int iz )
+  {
+    const TAxis* axis = h->GetYaxis();
+    const int n = axis->GetNbins();
+    if( n == 1 ) return h->GetBinContent( iphi, 1, iz );
+
+    int bin = std::min( std::max( axis->FindFixBin( r ), 1 ), n );
+    if( r < axis->GetBinCenter( bin ) ) --bin;
+    bin = std::min( std::max( bin, 1 ), n-1 );
+
+    const float low = axis->GetBinCenter( bin );
+    const float high = axis->GetBinCenter( bin+1 );
+    const float f = std::min( std::max( (r - low)/(high - low), 0.f ), 1.f );
+    return (1-f)*h->GetBinContent( iphi, bin, iz ) + f*h->GetBinContent( iphi, bin+1, iz );
+  }
+
+}
+
+//_____________________________________________________________________
+bool TpcDistortionCorrection::load( const std::string& filename )
+{
+  std::unique_ptr<TFile> inputfile( TFile::Open( filename.c_str(), "READ" ) );
+  if( !( inputfile && inputfile->IsOpen() ) )
+  {
+    std::cout << PHWHERE << " unable to open " << filename << std::endl;
+    return false;
+  }
+
+  auto h_rphi = dynamic_cast<TH3*>( inputfile->Get( "hDistortionRPhi" ) );
+  auto h_z = dynamic_cast<TH3*>( inputfile->Get( "hDistortionZ" ) );
+  auto h_r = dynamic_cast<TH3*>( inputfile->Get( "hDistortionR" ) );
+  if( !( h_rphi && h_z && h_r ) )
+  {
+    std::cout << PHWHERE << " missing distortion histograms in " << filename << std::endl;
+    return false;
+  }
+
+  std::vector<float> values;
+  if( !fill_grid( h_rphi, h_z, h_r, values ) )
+  {
+    std::cout << PHWHERE << " inconsistent distortion histograms in " << filename << std::endl;
+    return false;
+  }
+
+  if( m_true_space_maps ) invert( values );
+  else m_values.swap( values );
+
+  m_filename = filename;
+  return true;
+}
+
+//_____________________________________________________________________
+bool TpcDistortionCorrection::fill_grid( TH3* h_rphi, TH3* h_z, TH3* h_r, std::vector<float>& values )
+{
+  for( const auto& h:{ h_z, h_r } )
+  {
+    if( h->GetNbinsX() != h_rphi->GetNbinsX() ||
+      h->GetNbinsY() != h_rphi->GetNbinsY() ||
+      h->GetNbinsZ() != h_rphi->GetNbinsZ() )
+    { return false; }
+  }
+
+  // phi is periodic, the grid spans the full axis
+  const TAxis* phi_axis = h_rphi->GetXaxis();
+  m_phi.n = phi_axis->GetNbins();
+  m_phi.min = phi_axis->GetBinCenter( 1 );
+  m_phi.inv_step = m_phi.n/( phi_axis->GetXmax() - phi_axis->GetXmin() );
+
+  // r and z from the first to the last bin center, r bins usually follow the layers and are resampled
+  const TAxis* r_axis = h_rphi->GetYaxis();
+  m_r.n = r_axis->GetNbins();
+  m_r.min = r_axis->GetBinCenter( 1 );
+  m_r.inv_step = m_r.n > 1 ? (m_r.n-1)/( r_axis->GetBinCenter( m_r.n ) - m_r.min ) : 0;
+
+  const TAxis* z_axis = h_rphi->GetZaxis();
+  m_z.n = z_axis->GetNbins();
+  m_z.min = z_axis->GetBinCenter( 1 );
+  m_z.inv_step = m_z.n > 1 ? (m_z.n-1)/( z_axis->GetBinCenter( m_z.n ) - m_z.min ) : 0;
+
+  values.resize( m_ncoord*m_phi.n*m_r.n*m_z.n );
+  auto iter = values.begin();
+  for( int iphi = 0; iphi < m_phi.n; ++iphi )
+    for( int ir = 0; ir < m_r.n; ++ir )
+    for( int iz = 0; iz < m_z.n; ++iz )
+  {
+    const float r = m_r.position( ir );
+    *iter++ = sample_r( h_rphi, iphi+1, r, iz+1 );
+    *iter++ = sample_r( h_z, iphi+1, r, iz+1 );
+    *iter++ = sample_r( h_r, iphi+1, r, iz+1 );
+  }
+
+  return true;
+}
+
+//_____________________________________________________________________
+void TpcDistortionCorrection::invert( const std::vector<float>& distortions )
+{
+  /*
+  for every grid point (reco position) find the true position such that true + distortion(true) = reco,
+  starting from true = reco. The distortions are small compared to their gradients, the iteration
+  converges in a few steps
+  */
+  m_values.resize( distortions.size() );
+  auto iter = m_values.begin();
+  for( int iphi = 0; iphi < m_phi.n; ++iphi )
+    for( int ir = 0; ir < m_r.n; ++ir )
+    for( int iz = 0; iz < m_z.n; ++iz )
+  {
+    const float phi = m_phi.position( iphi );
+    const float r = m_r.position( ir );
+    const float z = m_z.position( iz );
+
+    float phi_true = phi;
+    float r_true = r;
+    float z_true = z;
+    for( unsigned int i = 0; i < m_inversion_iterations; ++i )
+    {
+      float distortion[m_ncoord];
+      interpolate( distortions, phi_true, r_true, z_true, distortion );
+      r_true = r - distortion[2];
+      phi_true = phi - distortion[0]/r_true;
+      z_true = z - distortion[1];
+    }
+
+    *iter++ = r*( phi_true - phi );
+    *iter++ = z_true - z;
+    *iter++ = r_true - r;
+  }
+}
+
+//_____________________________________________________________________
+void TpcDistortionCorrection::interpolate( const std::vector<float>& values, float phi, float r, float z, float* out ) const
+{
+  // phi, periodic
+  const float u = (phi - m_phi.min)*m_phi.inv_step;
+  const float ufloor = std::floor( u );
+  const float fphi = u - ufloor;
+  int iphi0 = static_cast<int>( ufloor ) % m_phi.n;
+  if( iphi0 < 0 ) iphi0 += m_phi.n;
+  const int iphi1 = ( iphi0+1 == m_phi.n ) ? 0 : iphi0+1;
+
+  // r and z, clamped
+  int ir, iz;
+  float fr, fz;
+  locate( m_r, r, ir, fr );
+  locate( m_z, z, iz, fz );
+  const int dr = m_r.n > 1 ? m_z.n : 0;
+  const int dz = m_z.n > 1 ? 1 : 0;
+
+  const float* v0 = &values[m_ncoord*( ( iphi0*m_r.n + ir )*m_z.n + iz )];
+  const float* v1 = &values[m_ncoord*( ( iphi1*m_r.n + ir )*m_z.n + iz )];
+  const int sr = m_ncoord*dr;
+  const int sz = m_ncoord*dz;
+  for( int i = 0; i < m_ncoord; ++i )
+  {
+    const float c00 = v0[i] + fz*( v0[i+sz] - v0[i] );
+    const float c01 = v0[i+sr] + fz*( v0[i+sr+sz] - v0[i+sr] );
+    const float c10 = v1[i] + fz*( v1[i+sz] - v1[i] );
+    const float c11 = v1[i+sr] + fz*( v1[i+sr+sz] - v1[i+sr] );
+    const float c0 = c00 + fr*( c01 - c00 );
+    const float c1 = c10 + fr*( c11 - c10 );
+    out[i] = c0 + fphi*( c1 - c0 );
+  }
+}
+
+//_____________________________________________________________________
+void TpcDistortionCorrection::get_corrections( float phi, float r, float z, float* corrections ) const
+{
+  if( !is_loaded() )
+  {
+    std::fill( corrections, corrections + m_ncoord, 0 );
+    return;
+  }
+  interpolate( m_values, phi, r, z, corrections );
+}
+
+//_____________________________________________________________________
+void TpcDistortionCorrection::correct( unsigned int n, float* x, float* y, float* z ) const
+{
+  if( !is_loaded() ) return;
+
+  // blocks of positions: polar coordinates, corrections and back to cartesian in separate loops
+  float r[block_size];
+  float phi[block_size];
+  float corrections[m_ncoord*block_size];
+  for( unsigned int first = 0; first < n; first += block_size )
+  {
+    const unsigned int count = std::min( block_size, n - first );
+    float* bx = x + first;
+    float* by = y + first;
+    float* bz = z + first;
+
+    for( unsigned int i = 0; i < count; ++i )
+    {
+      r[i] = std::sqrt( bx[i]*bx[i] + by[i]*by[i] );
+      phi[i] = std::atan2( by[i], bx[i] );
+    }
+
+    for( unsigned int i = 0; i < count; ++i )
+    { interpolate( m_values, phi[i], r[i], bz[i], corrections + m_ncoord*i ); }
+
+    for( unsigned int i = 0; i < count; ++i )
+    {
+      const float* c = corrections + m_ncoord*i;
+      const float phi_corrected = phi[i] + c[0]/r[i];
+      const float r_corrected = r[i] + c[2];
+      bx[i] = r_corrected*std::cos( phi_corrected );
+      by[i] = r_corrected*std::sin( phi_corrected );
+      bz[i] += c[1];
+    }
+  }
+}
+
+//_____________________________________________________________________
+void TpcDistortionCorrection::print() const
+{
+  std::cout << "TpcDistortionCorrection - file: " << m_filename
+    << ( m_true_space_maps ? " (true space maps, inverted)" : "" ) << std::endl;
+  std::cout << "  phi: " << m_phi.n << " points from " << m_phi.min << " (periodic)" << std::endl;
+  std::cout << "  r: " << m_r.n << " points from " << m_r.min << " to " << m_r.position( m_r.n-1 ) << std::endl;
+  std::cout << "  z: " << m_z.n << " points from " << m_z.min << " to " << m_z.position( m_z.n-1 ) << std::endl;
+}
@@ -0,0 +1,119 @@
+#ifndef TPCCALIB_TPCDISTORTIONCORRECTION_H
+#define TPCCALIB_TPCDISTORTIONCORRECTION_H
+/**
+ * \file TpcDistortionCorrection.h
+ * \brief space charge corrections of tpc cluster positions on a cached reco-space grid
+ */
+
+#include <string>
+#include <vector>
+
+class TH3;
+
+/**
+ * \class TpcDistortionCorrection
+ * \brief space charge corrections of tpc cluster positions on a cached reco-space grid
+ * \detail The maps are read from the file written by TpcSpaceChargeReconstruction:
+ three TH3 (hDistortionRPhi, hDistortionZ, hDistortionR) with phi, r and z along x, y and z.
+
+ By default the maps are taken as corrections in reconstructed space
+ (what TpcSpaceChargeReconstruction measures: track - cluster vs cluster position).
+ With set_true_space_maps(true) they are taken as distortions in true space
+ (reco - true vs true position, as used in simulation) and the inverse is computed once
+ for every grid point, by fixed point iteration.
+
+ The corrections are stored interleaved on a uniform grid, periodic in phi and clamped in r and z,
+ and interpolated trilinearly. The object is not modified after load(), all correction methods
+ are const and can be called from several threads. It lives on the PAR node and is shared by
+ all instances of TpcSpaceChargeCorrection.
+ */
+class TpcDistortionCorrection
+{
+  public:
+
+  /// constructor
+  TpcDistortionCorrection() = default;
+
+  ///@name configuration, before load
+  //@{
+
+  /// maps are distortions in true space, to be inverted
+  void set_true_space_maps( bool value )
+  { m_true_space_maps = value; }
+
+  /// number of fixed point iterations for the inversion
+  void set_inversion_iterations( unsigned int value )
+  { m_inversion_iterations = value; }
+
+  //@}
+
+  /// load the maps from file, false on failure
+  bool load( const std::string& filename );
+
+  /// true if maps are loaded
+  bool is_loaded() const
+  { return !m_values.empty(); }
+
+  /// file the maps were loaded from
+  const std::string& get_filename() const
+  { return m_filename; }
+
+  /// correct n positions in place
+  void correct( unsigned int n, float* x, float* y, float* z ) const;
+
+  /// corrections (drphi, dz, dr) at a given reconstructed position
+  void get_corrections( float phi, float r, float z, float* corrections ) const;
+
+  /// print grid
+  void print() const;
+
+  private:
+
+  /// uniform grid axis
+  struct Axis
+  {
+    /// first grid point
+    float min = 0;
+
+    /// inverse step
+    float inv_step = 0;
+
+    /// number of grid points
+    int n = 0;
+
+    /// position of grid point i
+    float position( int i ) const
+    { return n > 1 ? min + i/inv_step : min; }
+  };
+
+  /// trilinear interpolation of all three coordinates on a grid
+  void interpolate( const std::vector<float>& values, float phi, float r, float z, float* out ) const;
+
+  /// copy the forward maps on the grid
+  bool fill_grid( TH3* h_rphi, TH3* h_z, TH3* h_r, std::vector<float>& values );
+
+  /// replace the true space distortions by reco space corrections
+  void invert( const std::vector<float>& distortions );
+
+  /// number of coordinates, interleaved
+  static constexpr int m_ncoord = 3;
+
+  bool m_true_space_maps = false;
+  unsigned int m_inversion_iterations = 5;
+
+  /// file name
+  std::string m_filename;
+
+  ///@name grid
+  //@{
+  Axis m_phi;
+  Axis m_r;
+  Axis m_z;
+  //@}
+
+  /// corrections (drphi, dz, dr) per grid point, phi slowest, z fastest
+  std::vector<float> m_values;
+
+};
+
+#endif
@@ -0,0 +1,102 @@
+#include "TpcSpaceChargeCorrection.h"
+#include "TpcDistortionCorrection.h"
+
+#include <fun4all/Fun4AllReturnCodes.h>
+#include <phool/getClass.h>
+#include <phool/PHCompositeNode.h>
+#include <phool/PHDataNode.h>
+#include <phool/PHNodeIterator.h>
+#include <phool/phool.h>
+#include <trackbase/TrkrCluster.h>
+#include <trackbase/TrkrClusterContainer.h>
+#include <trackbase/TrkrDefs.h>
+
+#include <iostream>
+
+//_____________________________________________________________________
+const std::string TpcSpaceChargeCorrection::m_nodename = "TpcDistortionCorrection";
+
+//_____________________________________________________________________
+TpcSpaceChargeCorrection::TpcSpaceChargeCorrection( const std::string& name ):
+  SubsysReco( name)
+{}
+
+//_____________________________________________________________________
+void TpcSpaceChargeCorrection::set_tpc_layers( unsigned int first_layer, unsigned int n_layers )
+{
+  m_firstlayer_tpc = first_layer;
+  m_nlayers_tpc = n_layers;
+}
+
+//_____________________________________________________________________
+int TpcSpaceChargeCorrection::InitRun(PHCompositeNode* topNode )
+{
+  PHNodeIterator iter(topNode);
+  auto parNode = dynamic_cast<PHCompositeNode*>(iter.findFirst("PHCompositeNode", "PAR"));
+  if( !parNode )
+  {
+    std::cout << PHWHERE << " PAR node missing" << std::endl;
+    return Fun4AllReturnCodes::ABORTRUN;
+  }
+
+  // the first instance loads the maps, the others share them
+  auto correction = findNode::getClass<TpcDistortionCorrection>(parNode, m_nodename);
+  if( !correction )
+  {
+    correction = new TpcDistortionCorrection;
+    correction->set_true_space_maps( m_true_space_maps );
+    if( !correction->load( m_distortion_filename ) )
+    {
+      delete correction;
+      return Fun4AllReturnCodes::ABORTRUN;
+    }
+    parNode->addNode( new PHDataNode<TpcDistortionCorrection>( correction, m_nodename ) );
+  } else if( correction->get_filename() != m_distortion_filename ) {
+    std::cout << PHWHERE << " corrections already loaded from " << correction->get_filename()
+      << ", " << m_distortion_filename << " is ignored" << std::endl;
+  }
+
+  if( Verbosity() ) correction->print();
+  m_correction = correction;
+  return Fun4AllReturnCodes::EVENT_OK;
+}
+
+//_____________________________________________________________________
+int TpcSpaceChargeCorrection::process_event(PHCompositeNode* topNode)
+{
+  auto cluster_map = findNode::getClass<TrkrClusterContainer>(topNode, "TRKR_CLUSTER");
+  if( !cluster_map )
+  {
+    std::cout << PHWHERE << " TRKR_CLUSTER node missing" << std::endl;
+    return Fun4AllReturnCodes::ABORTEVENT;
+  }
+
+  for( unsigned int layer = m_firstlayer_tpc; layer < m_firstlayer_tpc + m_nlayers_tpc; ++layer )
+  {
+    const auto range = cluster_map->getClusters( TrkrDefs::tpcId, layer );
+    if( range.first == range.second ) continue;
+
+    // copy the positions of the layer, correct them in one go and copy them back
+    m_x.clear();
+    m_y.clear();
+    m_z.clear();
+    for( auto iter = range.first; iter != range.second; ++iter )
+    {
+      m_x.push_back( iter->second->getX() );
+      m_y.push_back( iter->second->getY() );
+      m_z.push_back( iter->second->getZ() );
+    }
+
+    m_correction->correct( m_x.size(), &m_x[0], &m_y[0], &m_z[0] );
+
+    size_t i = 0;
+    for( auto iter = range.first; iter != range.second; ++iter, ++i )
+    {
+      iter->second->setX( m_x[i] );
+      iter->second->setY( m_y[i] );
+      iter->second->setZ( m_z[i] );
+    }
+  }
+
+  return Fun4AllReturnCodes::EVENT_OK;
+}
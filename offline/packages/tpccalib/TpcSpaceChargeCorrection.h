@@ -0,0 +1,78 @@
+#ifndef TPCCALIB_TPCSPACECHARGECORRECTION_H
+#define TPCCALIB_TPCSPACECHARGECORRECTION_H
+/**
+ * \file TpcSpaceChargeCorrection.h
+ * \brief applies space charge corrections to tpc clusters
+ */
+#include <fun4all/SubsysReco.h>
+
+#include <string>
+#include <vector>
+
+// forward declaration
+class TpcDistortionCorrection;
+
+/**
+ * \class TpcSpaceChargeCorrection
+ * \brief applies space charge corrections to tpc clusters
+ * \detail To be registered right after TpcClusterizer, before seeding.
+ The corrections are loaded once into a TpcDistortionCorrection on the PAR node, which is shared
+ by all instances of this module. The clusters of a layer are corrected in one batch.
+ */
+class TpcSpaceChargeCorrection: public SubsysReco
+{
+  public:
+
+  /// constructor
+  TpcSpaceChargeCorrection( const std::string& = "TPCSPACECHARGECORRECTION" );
+
+  ///@name configuration
+  //@{
+
+  /// set tpc layers
+  void set_tpc_layers( unsigned int first_layer, unsigned int n_layers );
+
+  /// file with the distortion maps, as written by TpcSpaceChargeReconstruction
+  void set_distortion_filename( const std::string& filename )
+  { m_distortion_filename = filename; }
+
+  /// maps are distortions in true space, inverted at load time
+  void set_true_space_maps( bool value )
+  { m_true_space_maps = value; }
+
+  //@}
+
+  /// run initialization
+  virtual int InitRun(PHCompositeNode*);
+
+  /// event processing
+  virtual int process_event(PHCompositeNode*);
+
+  private:
+
+  /// name of the node holding the corrections
+  static const std::string m_nodename;
+
+  /// distortion file
+  std::string m_distortion_filename;
+
+  /// true space maps
+  bool m_true_space_maps = false;
+
+  // tpc layers
+  unsigned int m_firstlayer_tpc = 7;
+  unsigned int m_nlayers_tpc = 48;
+
+  /// corrections, owned by the node
+  const TpcDistortionCorrection* m_correction = nullptr;
+
+  ///@name cluster positions of one layer
+  //@{
+  std::vector<float> m_x;
+  std::vector<float> m_y;
+  std::vector<float> m_z;
+  //@}
+
+};
+
+#endif
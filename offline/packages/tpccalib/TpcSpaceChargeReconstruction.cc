@@ -13,8 +13,13 @@
 
 #include <TFile.h>
 #include <TGraphErrors.h>
+#include <TH3.h>
+#include <TVectorD.h>
+#include <TVectorF.h>
 
+#include <array>
 #include <memory>
+#include <thread>
 
 namespace
 {
@@ -31,8 +36,45 @@ namespace
     else return phi;
   }
 
+  /// tpc z range
+  // TODO: get TPC dimension from recoconst ?
+  static constexpr float z_min = -212/2;
+  static constexpr float z_max = 212/2;
+
   /// radius
   template<class T> T get_r( T x, T y ) { return std::sqrt( square(x) + square(y) ); }
+
+  /// run function( first, last ) on nthreads contiguous chunks of [0,n), the first chunk in the calling thread
+  template<class F>
+    void run_chunks( unsigned int nthreads, int n, F function )
+  {
+    const int nchunks = std::max( 1, std::min<int>( nthreads, n ) );
+    std::vector<std::thread> threads;
+    for( int ichunk = 1; ichunk < nchunks; ++ichunk )
+    { threads.push_back( std::thread( function, ichunk, n*ichunk/nchunks, n*(ichunk+1)/nchunks ) ); }
+
+    function( 0, 0, n/nchunks );
+    for( auto&& thread:threads ) { thread.join(); }
+  }
+}
+
+//_____________________________________________________________________
+void TpcSpaceChargeReconstruction::Matrices::reset( int totalbins )
+{
+  m_lhs.assign( totalbins, matrix_t::Zero() );
+  m_rhs.assign( totalbins, column_t::Zero() );
+  m_cluster_count.assign( totalbins, 0 );
+}
+
+//_____________________________________________________________________
+void TpcSpaceChargeReconstruction::Matrices::add( const Matrices& other )
+{
+  for( size_t i = 0; i < m_lhs.size() && i < other.m_lhs.size(); ++i )
+  {
+    m_lhs[i] += other.m_lhs[i];
+    m_rhs[i] += other.m_rhs[i];
+    m_cluster_count[i] += other.m_cluster_count[i];
+  }
 }
 
 //_____________________________________________________________________
@@ -64,10 +106,9 @@ void TpcSpaceChargeReconstruction::set_outputfile( const std::string& filename )
 int TpcSpaceChargeReconstruction::Init(PHCompositeNode* topNode )
 {
 
-  // resize vectors
-  m_lhs = std::vector<matrix_t>( m_totalbins, matrix_t::Zero() );
-  m_rhs = std::vector<column_t>( m_totalbins, column_t::Zero() );
-  m_cluster_count = std::vector<int>( m_totalbins, 0 );
+  // resize vectors, one set per thread
+  m_matrices.resize( m_nthreads );
+  for( auto&& matrices:m_matrices ) { matrices.reset( m_totalbins ); }
   return Fun4AllReturnCodes::EVENT_OK;
 
 }
@@ -91,6 +132,18 @@ int TpcSpaceChargeReconstruction::process_event(PHCompositeNode* topNode)
 //_____________________________________________________________________
 int TpcSpaceChargeReconstruction::End(PHCompositeNode* topNode )
 {
+  // add matrices from all threads
+  auto& matrices = m_matrices.front();
+  for( size_t i = 1; i < m_matrices.size(); ++i )
+  { matrices.add( m_matrices[i] ); }
+  m_matrices.resize( 1 );
+
+  // add matrices from other jobs
+  for( const auto& filename:m_matrix_inputfiles )
+  { load_matrices( filename ); }
+
+  if( !m_matrix_outputfile.empty() ) save_matrices();
+
   calculate_distortions( topNode );
   return Fun4AllReturnCodes::EVENT_OK;
 }
@@ -109,12 +162,28 @@ void TpcSpaceChargeReconstruction::process_tracks()
 {
   if( !( m_track_map && m_cluster_map ) ) return;
 
+  if( m_matrices.size() == 1 )
+  {
+    for( auto iter = m_track_map->begin(); iter != m_track_map->end(); ++iter )
+    { process_track( iter->second, m_matrices.front() ); }
+    return;
+  }
+
+  // each thread processes a contiguous range of tracks into its own matrices
+  std::vector<SvtxTrack*> tracks;
+  tracks.reserve( m_track_map->size() );
   for( auto iter = m_track_map->begin(); iter != m_track_map->end(); ++iter )
-  { process_track( iter->second ); }
+  { tracks.push_back( iter->second ); }
+
+  run_chunks( m_matrices.size(), tracks.size(), [this, &tracks]( int ithread, int first, int last )
+  {
+    for( int i = first; i < last; ++i )
+    { process_track( tracks[i], m_matrices[ithread] ); }
+  } );
 }
 
 //_____________________________________________________________________
-void TpcSpaceChargeReconstruction::process_track( SvtxTrack* track )
+void TpcSpaceChargeReconstruction::process_track( SvtxTrack* track, Matrices& matrices ) const
 {
 
   // running track state
@@ -225,23 +294,26 @@ void TpcSpaceChargeReconstruction::process_track( SvtxTrack* track )
 
     if( i < 0 || i >= m_totalbins ) continue;
 
-    m_lhs[i](0,0) += 1./erp;
-    m_lhs[i](0,1) += 0;
-    m_lhs[i](0,2) += talpha/erp;
+    auto& lhs = matrices.m_lhs[i];
+    auto& rhs = matrices.m_rhs[i];
 
-    m_lhs[i](1,0) += 0;
-    m_lhs[i](1,1) += 1./ez;
-    m_lhs[i](1,2) += tbeta/ez;
+    lhs(0,0) += 1./erp;
+    lhs(0,1) += 0;
+    lhs(0,2) += talpha/erp;
 
-    m_lhs[i](2,0) += talpha/erp;
-    m_lhs[i](2,1) += tbeta/ez;
-    m_lhs[i](2,2) += square(talpha)/erp + square(tbeta)/ez;
+    lhs(1,0) += 0;
+    lhs(1,1) += 1./ez;
+    lhs(1,2) += tbeta/ez;
 
-    m_rhs[i](0,0) += drp/erp;
-    m_rhs[i](1,0) += dz/ez;
-    m_rhs[i](2,0) += talpha*drp/erp + tbeta*dz/ez;
+    lhs(2,0) += talpha/erp;
+    lhs(2,1) += tbeta/ez;
+    lhs(2,2) += square(talpha)/erp + square(tbeta)/ez;
 
-    ++m_cluster_count[i];
+    rhs(0,0) += drp/erp;
+    rhs(1,0) += dz/ez;
+    rhs(2,0) += talpha*drp/erp + tbeta*dz/ez;
+
+    ++matrices.m_cluster_count[i];
 
   }
 
@@ -260,14 +332,27 @@ void  TpcSpaceChargeReconstruction::calculate_distortions( PHCompositeNode* topN
   }
 
   // calculate distortions in each volume elements
-  std::vector<column_t> delta(m_totalbins);
-  std::vector<matrix_t> cov(m_totalbins);
-
-  for( int i = 0; i < m_totalbins; ++i )
+  /*
+  the covariance matrix is the inverse of lhs, so that the corrections are obtained from it directly,
+  rather than from a second decomposition. Cells are independent and split across threads.
+  Cells with a singular lhs (e.g. no cluster) get zero corrections and errors
+  */
+  const auto& matrices = m_matrices.front();
+  std::vector<column_t> delta(m_totalbins, column_t::Zero());
+  std::vector<matrix_t> cov(m_totalbins, matrix_t::Zero());
+
+  run_chunks( m_nthreads, m_totalbins, [&matrices, &delta, &cov]( int, int first, int last )
   {
-    cov[i] = m_lhs[i].inverse();
-    delta[i] = m_lhs[i].partialPivLu().solve( m_rhs[i] );
-  }
+    for( int i = first; i < last; ++i )
+    {
+      if( !matrices.m_cluster_count[i] ) continue;
+
+      bool invertible = false;
+      matrices.m_lhs[i].computeInverseWithCheck( cov[i], invertible );
+      if( invertible ) delta[i] = cov[i]*matrices.m_rhs[i];
+      else cov[i] = matrix_t::Zero();
+    }
+  } );
 
   // create tgraphs
   using TGraphPointer = std::unique_ptr<TGraphErrors>;
@@ -299,15 +384,145 @@ void  TpcSpaceChargeReconstruction::calculate_distortions( PHCompositeNode* topN
     }
   }
 
+  // histograms for TpcSpaceChargeCorrection, with phi, r and z along x, y and z
+  /* the r bins follow the layers, bin edges are placed half way between the bin centers */
+  std::vector<double> r_centers( m_rbins );
+  for( int ir = 0; ir < m_rbins; ++ir )
+  {
+    const int inner_layer = m_firstlayer_tpc + m_nlayers_tpc*ir/m_rbins;
+    const int outer_layer = m_firstlayer_tpc + m_nlayers_tpc*(ir+1)/m_rbins-1;
+    r_centers[ir] = (geom_container->GetLayerCellGeom(inner_layer)->get_radius() + geom_container->GetLayerCellGeom(outer_layer)->get_radius())/2;
+  }
+
+  std::vector<double> r_edges( m_rbins+1 );
+  for( int ir = 1; ir < m_rbins; ++ir ) { r_edges[ir] = (r_centers[ir-1]+r_centers[ir])/2; }
+  const double r_width = m_rbins > 1 ? r_centers[1]-r_centers[0] : 2;
+  const double r_width_last = m_rbins > 1 ? r_centers[m_rbins-1]-r_centers[m_rbins-2] : 2;
+  r_edges[0] = r_centers[0] - r_width/2;
+  r_edges[m_rbins] = r_centers[m_rbins-1] + r_width_last/2;
+
+  std::vector<double> phi_edges( m_phibins+1 );
+  for( int iphi = 0; iphi <= m_phibins; ++iphi ) { phi_edges[iphi] = -M_PI + 2.*M_PI*iphi/m_phibins; }
+
+  std::vector<double> z_edges( m_zbins+1 );
+  for( int iz = 0; iz <= m_zbins; ++iz ) { z_edges[iz] = z_min + (z_max-z_min)*iz/m_zbins; }
+
+  using TH3Pointer = std::unique_ptr<TH3F>;
+  static const std::array<std::string, m_ncoord> hnames = {{ "hDistortionRPhi", "hDistortionZ", "hDistortionR" }};
+  std::array<TH3Pointer, m_ncoord> h;
+  for( int icoord = 0; icoord < m_ncoord; ++icoord )
+  {
+    h[icoord].reset( new TH3F( hnames[icoord].c_str(), hnames[icoord].c_str(),
+      m_phibins, &phi_edges[0], m_rbins, &r_edges[0], m_zbins, &z_edges[0] ) );
+    h[icoord]->SetDirectory( nullptr );
+  }
+
+  for( int iz = 0; iz < m_zbins; ++iz )
+    for( int iphi = 0; iphi < m_phibins; ++iphi )
+    for( int ir = 0; ir < m_rbins; ++ir )
+  {
+    const int index = get_cell( iz, ir, iphi );
+    for( int icoord = 0; icoord < m_ncoord; ++icoord )
+    {
+      h[icoord]->SetBinContent( iphi+1, ir+1, iz+1, delta[index](icoord,0) );
+      h[icoord]->SetBinError( iphi+1, ir+1, iz+1, std::sqrt(cov[index](icoord,icoord)) );
+    }
+  }
+
   // save to root file
   {
     std::unique_ptr<TFile> outputfile( TFile::Open( m_outputfile.c_str(), "RECREATE" ) );
     outputfile->cd();
     for( auto&& value:tg ) { value->Write(); }
+    for( auto&& value:h ) { value->Write(); }
     outputfile->Close();
   }
 }
 
+//_____________________________________________________________________
+void TpcSpaceChargeReconstruction::save_matrices() const
+{
+  const auto& matrices = m_matrices.front();
+
+  // grid dimensions, used to check consistency when adding matrices
+  TVectorD grid( 3 );
+  grid[0] = m_zbins;
+  grid[1] = m_rbins;
+  grid[2] = m_phibins;
+
+  TVectorF lhs( m_totalbins*m_ncoord*m_ncoord );
+  TVectorF rhs( m_totalbins*m_ncoord );
+  TVectorD cluster_count( m_totalbins );
+  for( int i = 0; i < m_totalbins; ++i )
+  {
+    for( int irow = 0; irow < m_ncoord; ++irow )
+    {
+      for( int icol = 0; icol < m_ncoord; ++icol )
+      { lhs[m_ncoord*( m_ncoord*i + irow ) + icol] = matrices.m_lhs[i](irow,icol); }
+      rhs[m_ncoord*i + irow] = matrices.m_rhs[i](irow,0);
+    }
+    cluster_count[i] = matrices.m_cluster_count[i];
+  }
+
+  std::unique_ptr<TFile> outputfile( TFile::Open( m_matrix_outputfile.c_str(), "RECREATE" ) );
+  if( !( outputfile && outputfile->IsOpen() ) )
+  {
+    std::cout << PHWHERE << " unable to open " << m_matrix_outputfile << std::endl;
+    return;
+  }
+
+  outputfile->cd();
+  grid.Write( "grid" );
+  lhs.Write( "lhs" );
+  rhs.Write( "rhs" );
+  cluster_count.Write( "cluster_count" );
+  outputfile->Close();
+}
+
+//_____________________________________________________________________
+void TpcSpaceChargeReconstruction::load_matrices( const std::string& filename )
+{
+  std::unique_ptr<TFile> inputfile( TFile::Open( filename.c_str(), "READ" ) );
+  if( !( inputfile && inputfile->IsOpen() ) )
+  {
+    std::cout << PHWHERE << " unable to open " << filename << std::endl;
+    return;
+  }
+
+  auto grid = dynamic_cast<TVectorD*>( inputfile->Get( "grid" ) );
+  auto lhs = dynamic_cast<TVectorF*>( inputfile->Get( "lhs" ) );
+  auto rhs = dynamic_cast<TVectorF*>( inputfile->Get( "rhs" ) );
+  auto cluster_count = dynamic_cast<TVectorD*>( inputfile->Get( "cluster_count" ) );
+  if( !( grid && lhs && rhs && cluster_count ) )
+  {
+    std::cout << PHWHERE << " missing matrices in " << filename << std::endl;
+    return;
+  }
+
+  if( grid->GetNrows() != 3 || (*grid)[0] != m_zbins || (*grid)[1] != m_rbins || (*grid)[2] != m_phibins ||
+    lhs->GetNrows() != m_totalbins*m_ncoord*m_ncoord ||
+    rhs->GetNrows() != m_totalbins*m_ncoord ||
+    cluster_count->GetNrows() != m_totalbins )
+  {
+    std::cout << PHWHERE << " grid dimensions in " << filename << " do not match. Skipped" << std::endl;
+    return;
+  }
+
+  auto& matrices = m_matrices.front();
+  for( int i = 0; i < m_totalbins; ++i )
+  {
+    for( int irow = 0; irow < m_ncoord; ++irow )
+    {
+      for( int icol = 0; icol < m_ncoord; ++icol )
+      { matrices.m_lhs[i](irow,icol) += (*lhs)[m_ncoord*( m_ncoord*i + irow ) + icol]; }
+      matrices.m_rhs[i](irow,0) += (*rhs)[m_ncoord*i + irow];
+    }
+    matrices.m_cluster_count[i] += (*cluster_count)[i];
+  }
+
+  if( Verbosity() ) std::cout << PHWHERE << " added matrices from " << filename << std::endl;
+}
+
 //_____________________________________________________________________
 int TpcSpaceChargeReconstruction::get_cell( int iz, int ir, int iphi ) const
 {
@@ -330,10 +545,7 @@ int TpcSpaceChargeReconstruction::get_cell( TrkrDefs::cluskey cluster_key, TrkrC
   const int iphi = m_phibins*(cluster_phi + M_PI)/(2.*M_PI);
 
   // z
-  // TODO: get TPC dimension from recoconst ?
   const auto cluster_z = cluster->getZ();
-  static constexpr float z_min = -212/2;
-  static constexpr float z_max = 212/2;
   const int iz = m_zbins*(cluster_z-z_min)/(z_max-z_min);
 
   return get_cell( iz, ir, iphi );
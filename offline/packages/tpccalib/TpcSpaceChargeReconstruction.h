@@ -11,6 +11,8 @@
 #include <Eigen/Core>
 #include <Eigen/Dense>
 
+#include <algorithm>
+#include <string>
 #include <vector>
 
 // forward declaration
@@ -31,6 +33,10 @@ class TrkrClusterContainer;
  This results in a linear equation lhs[i].[corrections] = rhs[i], and thus [corrections] = lhs[i]**(-1).rhs[i]
  The lhs and rhs matrices are filled in TpcSpaceChargeReconstruction::process_track
  The inversion is performed in TpcSpaceChargeReconstruction::calculate_distortions
+
+ Since lhs and rhs are plain sums over clusters, they can be accumulated in several jobs and added afterwards:
+ each job saves its matrices with set_matrix_outputfile, and a final job (possibly without any event)
+ adds them with add_matrix_file before calculating the distortions
  */
 
 class TpcSpaceChargeReconstruction: public SubsysReco
@@ -58,11 +64,28 @@ class TpcSpaceChargeReconstruction: public SubsysReco
 
   /// output file
   /**
-  for now only TGraphs of space charge corrections vs r are stored
-  ultimately one wants to save the data in a format that is suitable for use in the reconstruction
+  contains TGraphs of space charge corrections vs r, and the TH3F (phi, r, z) maps
+  hDistortionRPhi, hDistortionZ and hDistortionR read by TpcSpaceChargeCorrection
   */
   void set_outputfile( const std::string& filename );
 
+  /// output file for the accumulated lhs and rhs matrices, before inversion
+  /** they can be added to the ones of other jobs using add_matrix_file */
+  void set_matrix_outputfile( const std::string& filename )
+  { m_matrix_outputfile = filename; }
+
+  /// add lhs and rhs matrices saved by another job. Files are read at the end of processing
+  void add_matrix_file( const std::string& filename )
+  { m_matrix_inputfiles.push_back( filename ); }
+
+  /// number of threads used to process tracks and invert matrices
+  /**
+  each thread accumulates its tracks in its own set of matrices, they are added in End.
+  The result differs from the single thread one only by the order of the sums.
+  */
+  void set_nthreads( unsigned int nthreads )
+  { m_nthreads = std::max( 1U, nthreads ); }
+
   //@}
 
   /// global initialization
@@ -85,8 +108,38 @@ class TpcSpaceChargeReconstruction: public SubsysReco
   /// process tracks
   void process_tracks();
 
-  /// process track
-  void process_track( SvtxTrack* );
+  // shortcut for relevant eigen matrices
+  static constexpr int m_ncoord = 3;
+  using matrix_t = Eigen::Matrix<float, m_ncoord, m_ncoord >;
+  using column_t = Eigen::Matrix<float, m_ncoord, 1 >;
+
+  /// lhs and rhs matrices, and cluster count for all cells
+  struct Matrices
+  {
+    /// resize to totalbins cells, and reset
+    void reset( int totalbins );
+
+    /// add other matrices, cell by cell
+    void add( const Matrices& );
+
+    /// left hand side matrices for distortion inversions
+    std::vector<matrix_t> m_lhs;
+
+    /// right hand side matrices for distortion inversions
+    std::vector<column_t> m_rhs;
+
+    /// keep track of how many clusters are used per cell
+    std::vector<int> m_cluster_count;
+  };
+
+  /// process track, filling matrices
+  void process_track( SvtxTrack*, Matrices& ) const;
+
+  /// save accumulated matrices to m_matrix_outputfile
+  void save_matrices() const;
+
+  /// add matrices stored in a file
+  void load_matrices( const std::string& );
 
   /// calculate distortions
   void calculate_distortions( PHCompositeNode* );
@@ -100,6 +153,15 @@ class TpcSpaceChargeReconstruction: public SubsysReco
   /// output file
   std::string m_outputfile = "TpcSpaceChargeReconstruction.root";
 
+  /// output file for accumulated matrices. Not written if empty
+  std::string m_matrix_outputfile;
+
+  /// files with matrices to be added before inversion
+  std::vector<std::string> m_matrix_inputfiles;
+
+  /// number of threads
+  unsigned int m_nthreads = 1;
+
   // tpc layers
   unsigned int m_firstlayer_tpc = 7;
   unsigned int m_nlayers_tpc = 48;
@@ -112,19 +174,8 @@ class TpcSpaceChargeReconstruction: public SubsysReco
   int m_totalbins = m_zbins*m_phibins*m_rbins;
   //@}
 
-  // shortcut for relevant eigen matrices
-  static constexpr int m_ncoord = 3;
-  using matrix_t = Eigen::Matrix<float, m_ncoord, m_ncoord >;
-  using column_t = Eigen::Matrix<float, m_ncoord, 1 >;
-
-  /// left hand side matrices for distortion inversions
-  std::vector<matrix_t> m_lhs;
-
-  /// right hand side matrices for distortion inversions
-  std::vector<column_t> m_rhs;
-
-  /// keep track of how many clusters are used per cell
-  std::vector<int> m_cluster_count;
+  /// accumulated matrices, one set per thread. All are added to the first one in End
+  std::vector<Matrices> m_matrices;
 
   ///@name nodes
   //@{
@@ -7,6 +7,7 @@
 #include <TStyle.h>
 #include <TVirtualFitter.h>
 
+#include <algorithm>
 #include <cassert>
 #include <cmath>
 #include <iostream>
@@ -15,6 +16,235 @@
 
 using namespace std;
 
+namespace
+{
+//! initial value and limits of a fit parameter, the parameter is fixed if min is not below max
+struct default_values_t
+{
+  default_values_t(double default_value, double min_value, double max_value)
+    : def(default_value)
+    , min(min_value)
+    , max(max_value)
+  {
+  }
+  double def;
+  double min;
+  double max;
+};
+
+static const int n_parameter = 7;
+static const double risetime = 1.5;
+
+//! pedestal and peak search, initial values and limits of the power law double exp parameters
+void SampleFit_DefaultValues(const std::vector<double> &samples, double &pedestal, int &peakPos,
+                             vector<default_values_t> &default_values, const int verbosity)
+{
+  const int n_samples = samples.size();
+
+  peakPos = 0;
+  pedestal = samples[0];  //(double) PEDESTAL;
+  double peakval = pedestal;
+
+  for (int iSample = 0; iSample < n_samples - risetime * 3; iSample++)
+  {
+    if (abs(samples[iSample] - pedestal) > abs(peakval - pedestal))
+    {
+      peakval = samples[iSample];
+      peakPos = iSample;
+    }
+  }
+  peakval -= pedestal;
+
+  if (verbosity)
+  {
+    cout << "SampleFit_PowerLawDoubleExp - "
+         << "pedestal = " << pedestal << ", "
+         << "peakval = " << peakval << ", "
+         << "peakPos = " << peakPos << endl;
+  }
+
+  default_values.assign(n_parameter, default_values_t(numeric_limits<double>::signaling_NaN(), numeric_limits<double>::signaling_NaN(), numeric_limits<double>::signaling_NaN()));
+
+  default_values[0] = default_values_t(peakval * .7, peakval * -1.5, peakval * 1.5);
+  default_values[1] = default_values_t(peakPos - risetime, peakPos - 3 * risetime, peakPos + risetime);
+  default_values[2] = default_values_t(5., 1, 10.);
+  default_values[3] = default_values_t(risetime, risetime * .2, risetime * 10);
+  default_values[4] = default_values_t(pedestal, pedestal - abs(peakval), pedestal + abs(peakval));
+  //  default_values[5] = default_values_t(0.3, 0, 1);
+  //  default_values[6] = default_values_t(5, risetime * .2, risetime * 10);
+  default_values[5] = default_values_t(0, 0, 0);  // disable 2nd component
+  default_values[6] = default_values_t(risetime, risetime, risetime);
+}
+
+//! power law double exp shape with unit amplitude and no pedestal, same as SignalShape_PowerLawDoubleExp.
+//! The derivatives with respect to all 7 parameters are filled if grad is not null
+//! (0: amplitude, 4: pedestal, the others of the shape times the amplitude)
+double PowerLawDoubleExp_Shape(const double x, const double *par, double *grad)
+{
+  const double dt = x - par[1];
+  if (dt <= 0)
+  {
+    if (grad)
+    {
+      for (int i = 0; i < n_parameter; ++i)
+      {
+        grad[i] = 0;
+      }
+      grad[4] = 1;
+    }
+    return 0;
+  }
+
+  // pow(dt, p) / pow(tau, p) * exp(p) * exp(-dt * p / tau) = exp(p * (log(dt / tau) + 1 - dt / tau))
+  const double logdt = log(dt);
+  const double arg1 = logdt - log(par[3]) + 1 - dt / par[3];
+  const double arg2 = logdt - log(par[6]) + 1 - dt / par[6];
+  const double e1 = exp(par[2] * arg1);
+  const double e2 = exp(par[2] * arg2);
+  const double g1 = (1. - par[5]) * e1;
+  const double g2 = par[5] * e2;
+  const double shape = g1 + g2;
+
+  if (grad)
+  {
+    grad[0] = shape;
+    grad[1] = -par[0] * par[2] * (g1 * (1 / dt - 1 / par[3]) + g2 * (1 / dt - 1 / par[6]));
+    grad[2] = par[0] * (g1 * arg1 + g2 * arg2);
+    grad[3] = par[0] * g1 * par[2] * (dt / par[3] - 1) / par[3];
+    grad[4] = 1;
+    grad[5] = par[0] * (e2 - e1);
+    grad[6] = par[0] * g2 * par[2] * (dt / par[6] - 1) / par[6];
+  }
+  return shape;
+}
+
+double PowerLawDoubleExp_Chi2(const std::vector<double> &samples, const double *par)
+{
+  double chi2 = 0;
+  const int n_samples = samples.size();
+  for (int i = 0; i < n_samples; i++)
+  {
+    const double r = samples[i] - par[4] - par[0] * PowerLawDoubleExp_Shape(i, par, nullptr);
+    chi2 += r * r;
+  }
+  return chi2;
+}
+
+//! peak sample and peak amplitude of the fitted shape, searched between the sample start and
+//! the later peak time, like TF1::GetMaximumX of the ROOT fit
+void PowerLawDoubleExp_Peak(const double *par, const int n_samples, double &peak, double &peak_sample)
+{
+  const double peakpos1 = par[3];
+  const double peakpos2 = par[6];
+  double max_peakpos = par[1] + (peakpos1 > peakpos2 ? peakpos1 : peakpos2);
+  if (max_peakpos > n_samples - 1) max_peakpos = n_samples - 1;
+
+  if (par[5] == 0)
+  {
+    // single component peaks at the peak time
+    peak_sample = min(par[1] + par[3], max_peakpos);
+  }
+  else
+  {
+    static const int n_scan = 1000;
+    double best = -numeric_limits<double>::max();
+    peak_sample = par[1];
+    for (int i = 0; i <= n_scan; i++)
+    {
+      const double x = par[1] + (max_peakpos - par[1]) * i / n_scan;
+      const double value = PowerLawDoubleExp_Shape(x, par, nullptr);
+      if (value > best)
+      {
+        best = value;
+        peak_sample = x;
+      }
+    }
+  }
+
+  peak = par[0] * PowerLawDoubleExp_Shape(peak_sample, par, nullptr);
+}
+
+//! solve the nfree x nfree system a * x = b in place by Cholesky decomposition, false if not positive definite
+bool CholeskySolve(double *a, double *b, const int nfree)
+{
+  for (int i = 0; i < nfree; i++)
+  {
+    for (int j = 0; j <= i; j++)
+    {
+      double sum = a[i * n_parameter + j];
+      for (int k = 0; k < j; k++)
+      {
+        sum -= a[i * n_parameter + k] * a[j * n_parameter + k];
+      }
+      if (i == j)
+      {
+        if (sum <= 0)
+        {
+          return false;
+        }
+        a[i * n_parameter + i] = sqrt(sum);
+      }
+      else
+      {
+        a[i * n_parameter + j] = sum / a[j * n_parameter + j];
+      }
+    }
+  }
+  for (int i = 0; i < nfree; i++)
+  {
+    for (int k = 0; k < i; k++)
+    {
+      b[i] -= a[i * n_parameter + k] * b[k];
+    }
+    b[i] /= a[i * n_parameter + i];
+  }
+  for (int i = nfree - 1; i >= 0; i--)
+  {
+    for (int k = i + 1; k < nfree; k++)
+    {
+      b[i] -= a[k * n_parameter + i] * b[k];
+    }
+    b[i] /= a[i * n_parameter + i];
+  }
+  return true;
+}
+
+//! least squares amplitude and pedestal for a fixed shape, returns the chi2
+double PowerLawDoubleExp_Linear(const std::vector<double> &samples, double *par)
+{
+  const int n_samples = samples.size();
+  double sum_s = 0;
+  double sum_ss = 0;
+  double sum_y = 0;
+  double sum_yy = 0;
+  double sum_ys = 0;
+  for (int i = 0; i < n_samples; i++)
+  {
+    const double shape = PowerLawDoubleExp_Shape(i, par, nullptr);
+    const double y = samples[i];
+    sum_s += shape;
+    sum_ss += shape * shape;
+    sum_y += y;
+    sum_yy += y * y;
+    sum_ys += y * shape;
+  }
+  const double det = sum_ss * n_samples - sum_s * sum_s;
+  if (det > sum_ss * 1e-9)
+  {
+    par[0] = (sum_ys * n_samples - sum_y * sum_s) / det;
+    par[4] = (sum_ss * sum_y - sum_s * sum_ys) / det;
+  }
+  else
+  {
+    // no signal shape inside the samples
+    par[0] = 0;
+    par[4] = sum_y / n_samples;
+  }
+  return sum_yy - par[0] * sum_ys - par[4] * sum_y;
+}
+
+}  // namespace
+
 namespace TPCDaqDefs
 {
 //! TPC v1 FEE test stand decoder
@@ -65,6 +295,82 @@ void SampleFit_PowerLawDoubleExp_PDFMaker::MakeSectionPage(const string &title)
   m_canvas->Print("SampleFit_PowerLawDoubleExp.pdf");
 }
 
+//! one page of SampleFit_PowerLawDoubleExp.pdf with the samples, the fit and its two components
+static void SampleFit_PowerLawDoubleExp_Draw(
+    const std::vector<double> &samples,
+    const double *par,
+    const double peak,
+    const double peak_sample,
+    const double pedestal)
+{
+  static int id = 0;
+  ++id;
+
+  const int n_samples = samples.size();
+  TGraph gpulse(n_samples);
+  for (int i = 0; i < n_samples; i++)
+  {
+    (gpulse.GetX())[i] = i;
+
+    (gpulse.GetY())[i] = samples[i];
+  }
+
+  string c_name(string("SampleFit_PowerLawDoubleExp_") + to_string(id));
+
+  TCanvas *canvas = new TCanvas(
+      c_name.c_str(), c_name.c_str());
+  canvas->Update();
+
+  TGraph *g_plot = static_cast<TGraph *>(gpulse.DrawClone("ap*l"));
+  g_plot->SetTitle((string("ADC data and fit #") + to_string(id) + string(";Sample number;ADC value")).c_str());
+
+  TF1 fits("f_SignalShape_PowerLawDoubleExp", SignalShape_PowerLawDoubleExp, 0., n_samples, n_parameter);
+  fits.SetParNames("Amplitude", "Sample Start", "Power", "Peak Time 1", "Pedestal", "Amplitude ratio", "Peak Time 2");
+  fits.SetParameters(par);
+  fits.SetLineColor(kMagenta);
+  fits.DrawClone("same");
+  fits.Print();
+
+  TF1 f1("f_SignalShape_PowerLawExp1", SignalShape_PowerLawExp, 0., n_samples, 5);
+  f1.SetParameters(
+      par[0] * (1 - par[5]) / pow(par[3], par[2]) * exp(par[2]),
+      par[1],
+      par[2],
+      par[2] / par[3],
+      par[4]);
+  f1.SetLineColor(kBlue);
+  f1.DrawClone("same");
+
+  TF1 f2("f_SignalShape_PowerLawExp2", SignalShape_PowerLawExp, 0., n_samples, 5);
+  f2.SetParameters(
+      par[0] * par[5] / pow(par[6], par[2]) * exp(par[2]),
+      par[1],
+      par[2],
+      par[2] / par[6],
+      par[4]);
+  f2.SetLineColor(kRed);
+  f2.DrawClone("same");
+
+  TGraph g_max(1);
+
+  g_max.GetX()[0] = peak_sample;
+  g_max.GetY()[0] = peak + pedestal;
+
+  g_max.SetMarkerStyle(kFullCircle);
+  g_max.SetMarkerSize(2);
+  g_max.SetMarkerColor(kRed);
+
+  static_cast<TGraph *>(g_max.DrawClone("p"));
+
+  canvas->Update();
+
+  //    if (id == 1)
+  //    {
+  //      canvas->Print("SampleFit_PowerLawDoubleExp.pdf(");
+  //    }
+  canvas->Print("SampleFit_PowerLawDoubleExp.pdf");
+}
+
 bool SampleFit_PowerLawDoubleExp(        //
     const std::vector<double> &samples,  //
     double &peak,                        //
@@ -73,12 +379,6 @@ bool SampleFit_PowerLawDoubleExp(        //
     std::map<int, double> &parameters_io,
     const int verbosity)
 {
-  static const int n_parameter = 7;
-
-  // inital guesses
-  int peakPos = 0.;
-
-  //  assert(samples.size() == n_samples);
   const int n_samples = samples.size();
 
   TGraph gpulse(n_samples);
@@ -98,53 +398,10 @@ bool SampleFit_PowerLawDoubleExp(        //
   //      ipoint--;
   //    }
 
-  pedestal = gpulse.GetY()[0];  //(double) PEDESTAL;
-  double peakval = pedestal;
-  const double risetime = 1.5;
-
-  for (int iSample = 0; iSample < n_samples - risetime * 3; iSample++)
-  {
-    if (abs(gpulse.GetY()[iSample] - pedestal) > abs(peakval - pedestal))
-    {
-      peakval = gpulse.GetY()[iSample];
-      peakPos = iSample;
-    }
-  }
-  peakval -= pedestal;
-
-  if (verbosity)
-  {
-    cout << "SampleFit_PowerLawDoubleExp - "
-         << "pedestal = " << pedestal << ", "
-         << "peakval = " << peakval << ", "
-         << "peakPos = " << peakPos << endl;
-  }
-
-  // build default value
-  struct default_values_t
-  {
-    default_values_t(double default_value, double min_value, double max_value)
-      : def(default_value)
-      , min(min_value)
-      , max(max_value)
-    {
-    }
-    double def;
-    double min;
-    double max;
-  };
-
-  vector<default_values_t> default_values(n_parameter, default_values_t(numeric_limits<double>::signaling_NaN(), numeric_limits<double>::signaling_NaN(), numeric_limits<double>::signaling_NaN()));
-
-  default_values[0] = default_values_t(peakval * .7, peakval * -1.5, peakval * 1.5);
-  default_values[1] = default_values_t(peakPos - risetime, peakPos - 3 * risetime, peakPos + risetime);
-  default_values[2] = default_values_t(5., 1, 10.);
-  default_values[3] = default_values_t(risetime, risetime * .2, risetime * 10);
-  default_values[4] = default_values_t(pedestal, pedestal - abs(peakval), pedestal + abs(peakval));
-  //  default_values[5] = default_values_t(0.3, 0, 1);
-  //  default_values[6] = default_values_t(5, risetime * .2, risetime * 10);
-  default_values[5] = default_values_t(0, 0, 0);  // disable 2nd component
-  default_values[6] = default_values_t(risetime, risetime, risetime);
+  // inital guesses
+  int peakPos = 0;
+  vector<default_values_t> default_values;
+  SampleFit_DefaultValues(samples, pedestal, peakPos, default_values, verbosity);
 
   // fit function
   TF1 fits("f_SignalShape_PowerLawDoubleExp", SignalShape_PowerLawDoubleExp, 0., n_samples, n_parameter);
@@ -208,60 +465,7 @@ bool SampleFit_PowerLawDoubleExp(        //
 
   if (verbosity)
   {
-    static int id = 0;
-    ++id;
-
-    string c_name(string("SampleFit_PowerLawDoubleExp_") + to_string(id));
-
-    TCanvas *canvas = new TCanvas(
-        c_name.c_str(), c_name.c_str());
-    canvas->Update();
-
-    TGraph *g_plot = static_cast<TGraph *>(gpulse.DrawClone("ap*l"));
-    g_plot->SetTitle((string("ADC data and fit #") + to_string(id) + string(";Sample number;ADC value")).c_str());
-
-    fits.SetLineColor(kMagenta);
-    fits.DrawClone("same");
-    fits.Print();
-
-    TF1 f1("f_SignalShape_PowerLawExp1", SignalShape_PowerLawExp, 0., n_samples, 5);
-    f1.SetParameters(
-        fits.GetParameter(0) * (1 - fits.GetParameter(5)) / pow(fits.GetParameter(3), fits.GetParameter(2)) * exp(fits.GetParameter(2)),
-        fits.GetParameter(1),
-        fits.GetParameter(2),
-        fits.GetParameter(2) / fits.GetParameter(3),
-        fits.GetParameter(4));
-    f1.SetLineColor(kBlue);
-    f1.DrawClone("same");
-
-    TF1 f2("f_SignalShape_PowerLawExp2", SignalShape_PowerLawExp, 0., n_samples, 5);
-    f2.SetParameters(
-        fits.GetParameter(0) * fits.GetParameter(5) / pow(fits.GetParameter(6), fits.GetParameter(2)) * exp(fits.GetParameter(2)),
-        fits.GetParameter(1),
-        fits.GetParameter(2),
-        fits.GetParameter(2) / fits.GetParameter(6),
-        fits.GetParameter(4));
-    f2.SetLineColor(kRed);
-    f2.DrawClone("same");
-
-    TGraph g_max(1);
-
-    g_max.GetX()[0] = peak_sample;
-    g_max.GetY()[0] = peak + pedestal;
-
-    g_max.SetMarkerStyle(kFullCircle);
-    g_max.SetMarkerSize(2);
-    g_max.SetMarkerColor(kRed);
-
-    static_cast<TGraph *>(g_max.DrawClone("p"));
-
-    canvas->Update();
-
-    //    if (id == 1)
-    //    {
-    //      canvas->Print("SampleFit_PowerLawDoubleExp.pdf(");
-    //    }
-    canvas->Print("SampleFit_PowerLawDoubleExp.pdf");
+    SampleFit_PowerLawDoubleExp_Draw(samples, fits.GetParameters(), peak, peak_sample, pedestal);
   }
 
   for (int i = 0; i < n_parameter; ++i)
@@ -282,6 +486,248 @@ bool SampleFit_PowerLawDoubleExp(        //
   return true;
 }
 
+bool SampleFit_PowerLawDoubleExp_LM(
+    const std::vector<double> &samples,
+    double &peak,
+    double &peak_sample,
+    double &pedestal,
+    std::map<int, double> &parameters_io,
+    const int verbosity)
+{
+  const int n_samples = samples.size();
+  if (n_samples < 2)
+  {
+    return false;
+  }
+
+  int peakPos = 0;
+  vector<default_values_t> default_values;
+  SampleFit_DefaultValues(samples, pedestal, peakPos, default_values, verbosity);
+
+  // start values, limits and free parameters
+  double par[n_parameter];
+  double par_min[n_parameter];
+  double par_max[n_parameter];
+  int free_par[n_parameter];
+  int nfree = 0;
+  for (int i = 0; i < n_parameter; ++i)
+  {
+    auto iter = parameters_io.find(i);
+    if (iter == parameters_io.end())
+    {
+      par[i] = default_values[i].def;
+      par_min[i] = default_values[i].min;
+      par_max[i] = default_values[i].max;
+      if (default_values[i].min < default_values[i].max)
+      {
+        free_par[nfree++] = i;
+      }
+    }
+    else
+    {
+      par[i] = iter->second;
+      par_min[i] = par_max[i] = iter->second;
+
+      if (verbosity)
+      {
+        cout << "SampleFit_PowerLawDoubleExp_LM - parameter [" << i << "]: fixed to " << iter->second << endl;
+      }
+    }
+  }
+
+  // Levenberg-Marquardt with the analytic gradient, all matrices on the stack
+  static const int max_iterations = 100;
+  double chi2 = PowerLawDoubleExp_Chi2(samples, par);
+  double lambda = 1e-3;
+  int iteration = 0;
+  for (; iteration < max_iterations && nfree > 0; ++iteration)
+  {
+    double jtj[n_parameter * n_parameter] = {0};
+    double jtr[n_parameter] = {0};
+    double grad[n_parameter];
+    for (int is = 0; is < n_samples; is++)
+    {
+      const double r = samples[is] - par[4] - par[0] * PowerLawDoubleExp_Shape(is, par, grad);
+      for (int i = 0; i < nfree; i++)
+      {
+        const double gi = grad[free_par[i]];
+        jtr[i] += gi * r;
+        for (int j = 0; j <= i; j++)
+        {
+          jtj[i * n_parameter + j] += gi * grad[free_par[j]];
+        }
+      }
+    }
+
+    bool improved = false;
+    double new_chi2 = chi2;
+    double trial[n_parameter];
+    while (!improved && lambda < 1e10)
+    {
+      double a[n_parameter * n_parameter];
+      double delta[n_parameter];
+      for (int i = 0; i < nfree; i++)
+      {
+        for (int j = 0; j <= i; j++)
+        {
+          a[i * n_parameter + j] = jtj[i * n_parameter + j];
+        }
+        a[i * n_parameter + i] *= 1 + lambda;
+        delta[i] = jtr[i];
+      }
+
+      if (CholeskySolve(a, delta, nfree))
+      {
+        copy(par, par + n_parameter, trial);
+        for (int i = 0; i < nfree; i++)
+        {
+          const int ip = free_par[i];
+          trial[ip] = max(par_min[ip], min(par_max[ip], par[ip] + delta[i]));
+        }
+        new_chi2 = PowerLawDoubleExp_Chi2(samples, trial);
+        improved = (new_chi2 < chi2);
+      }
+
+      if (improved)
+      {
+        lambda /= 10;
+      }
+      else
+      {
+        lambda *= 10;
+      }
+    }
+
+    if (!improved)
+    {
+      break;
+    }
+
+    copy(trial, trial + n_parameter, par);
+    const double change = chi2 - new_chi2;
+    chi2 = new_chi2;
+    if (change < 1e-7 * (chi2 + 1e-7))
+    {
+      break;
+    }
+  }
+
+  // store results
+  pedestal = par[4];
+  PowerLawDoubleExp_Peak(par, n_samples, peak, peak_sample);
+
+  if (verbosity)
+  {
+    SampleFit_PowerLawDoubleExp_Draw(samples, par, peak, peak_sample, pedestal);
+  }
+
+  for (int i = 0; i < n_parameter; ++i)
+  {
+    parameters_io[i] = par[i];
+  }
+
+  if (verbosity)
+  {
+    cout << "SampleFit_PowerLawDoubleExp_LM - "
+         << "iterations = " << iteration << ", "
+         << "chi2 = " << chi2 << ", "
+         << "peak_sample = " << peak_sample << ", "
+         << "parameters_io[1] = " << par[1] << ", "
+         << "peak = " << peak << ", "
+         << "pedestal = " << pedestal << endl;
+  }
+
+  return true;
+}
+
+bool SampleFit_PowerLawDoubleExp_Template(
+    const std::vector<double> &samples,
+    double &peak,
+    double &peak_sample,
+    double &pedestal,
+    std::map<int, double> &parameters_io,
+    const int verbosity)
+{
+  const int n_samples = samples.size();
+  if (n_samples < 2)
+  {
+    return false;
+  }
+
+  int peakPos = 0;
+  vector<default_values_t> default_values;
+  SampleFit_DefaultValues(samples, pedestal, peakPos, default_values, verbosity);
+
+  double par[n_parameter];
+  for (int i = 0; i < n_parameter; ++i)
+  {
+    auto iter = parameters_io.find(i);
+    par[i] = (iter == parameters_io.end() ? default_values[i].def : iter->second);
+  }
+
+  double chi2 = 0;
+  if (parameters_io.find(1) != parameters_io.end())
+  {
+    chi2 = PowerLawDoubleExp_Linear(samples, par);
+  }
+  else
+  {
+    // scan the sample start within the limits of the full fit
+    static const double step = 0.1;
+    const double start_min = default_values[1].min;
+    const int n_step = lrint((default_values[1].max - default_values[1].min) / step);
+    vector<double> chi2_scan(n_step + 1);
+    int best = 0;
+    for (int i = 0; i <= n_step; i++)
+    {
+      par[1] = start_min + i * step;
+      chi2_scan[i] = PowerLawDoubleExp_Linear(samples, par);
+      if (chi2_scan[i] < chi2_scan[best])
+      {
+        best = i;
+      }
+    }
+    // parabola through the minimum and its neighbours
+    double offset = 0;
+    if (best > 0 && best < n_step)
+    {
+      const double curvature = chi2_scan[best - 1] - 2 * chi2_scan[best] + chi2_scan[best + 1];
+      if (curvature > 0)
+      {
+        offset = 0.5 * (chi2_scan[best - 1] - chi2_scan[best + 1]) / curvature;
+      }
+    }
+    par[1] = start_min + (best + offset) * step;
+    chi2 = PowerLawDoubleExp_Linear(samples, par);
+  }
+
+  // store results
+  pedestal = par[4];
+  PowerLawDoubleExp_Peak(par, n_samples, peak, peak_sample);
+
+  if (verbosity)
+  {
+    SampleFit_PowerLawDoubleExp_Draw(samples, par, peak, peak_sample, pedestal);
+  }
+
+  for (int i = 0; i < n_parameter; ++i)
+  {
+    parameters_io[i] = par[i];
+  }
+
+  if (verbosity)
+  {
+    cout << "SampleFit_PowerLawDoubleExp_Template - "
+         << "chi2 = " << chi2 << ", "
+         << "peak_sample = " << peak_sample << ", "
+         << "parameters_io[1] = " << par[1] << ", "
+         << "peak = " << peak << ", "
+         << "pedestal = " << pedestal << endl;
+  }
+
+  return true;
+}
+
 double
 SignalShape_PowerLawExp(double *x, double *par)
 {
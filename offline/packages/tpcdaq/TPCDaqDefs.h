@@ -44,6 +44,28 @@ bool SampleFit_PowerLawDoubleExp(          //
     std::map<int, double> &parameters_io,  //! IO for fullset of parameters. If a parameter exist and not an NAN, the fit parameter will be fixed to that value. The order of the parameters are ("Amplitude 1", "Sample Start", "Power", "Peak Time 1", "Pedestal", "Amplitude 2", "Peak Time 2")
     const int verbosity = 0);
 
+//! Power law double exp fit without ROOT fitting: Levenberg-Marquardt with analytic derivatives
+//! and fixed size matrices on the stack. Same interface, limits and parameter convention as
+//! SampleFit_PowerLawDoubleExp
+bool SampleFit_PowerLawDoubleExp_LM(       //
+    const std::vector<double> &samples,    //
+    double &peak,                          //! peak amplitude.
+    double &peak_sample,                   //! peak sample position.
+    double &pedestal,                      //! pedestal
+    std::map<int, double> &parameters_io,  //! IO for fullset of parameters, existing parameters are fixed
+    const int verbosity = 0);
+
+//! Template match for online use: the shape ("Power", "Peak Time 1", "Amplitude 2", "Peak Time 2")
+//! is taken from parameters_io or the defaults, the "Sample Start" is scanned in steps of 0.1 sample
+//! unless it is in parameters_io, amplitude and pedestal are solved linearly for every step
+bool SampleFit_PowerLawDoubleExp_Template(  //
+    const std::vector<double> &samples,     //
+    double &peak,                           //! peak amplitude.
+    double &peak_sample,                    //! peak sample position.
+    double &pedestal,                       //! pedestal
+    std::map<int, double> &parameters_io,   //! IO for fullset of parameters
+    const int verbosity = 0);
+
 // Abhisek's power-law + exp signal shape model
 double
 SignalShape_PowerLawExp(double *x, double *par);
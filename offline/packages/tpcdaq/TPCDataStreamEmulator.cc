@@ -49,11 +49,16 @@
 
 #include <algorithm>
 #include <array>
+#include <atomic>
 #include <cassert>
 #include <cmath>
+#include <functional>
 #include <iostream>
 #include <limits>
+#include <queue>
 #include <stdexcept>
+#include <thread>
+#include <utility>
 
 using namespace std;
 using namespace CLHEP;
@@ -63,7 +68,9 @@ TPCDataStreamEmulator::TPCDataStreamEmulator(
     unsigned int m_maxLayer,
     const std::string& outputfilename)
   : SubsysReco("TPCDataStreamEmulator")
-  , m_saveDataStreamFile(true)
+  , m_saveDataStreamFile(false)
+  , m_compression(kHuffman)
+  , m_nThreads(1)
   , m_outputFileNameBase(outputfilename)
   , m_minLayer(minLayer)
   , m_maxLayer(m_maxLayer)
@@ -80,6 +87,12 @@ TPCDataStreamEmulator::TPCDataStreamEmulator(
   , m_hLayerDataSize(nullptr)
   , m_hLayerSumHit(nullptr)
   , m_hLayerSumDataSize(nullptr)
+  , m_hPackedDataSize(nullptr)
+  , m_hCompressedDataSize(nullptr)
+  , m_hFEEDataSize(nullptr)
+  , m_hFEEOccupancy(nullptr)
+  , m_hLayerPackedDataSize(nullptr)
+  , m_hLayerCompressionRatio(nullptr)
 {
 }
 
@@ -108,6 +121,11 @@ int TPCDataStreamEmulator::End(PHCompositeNode* topNode)
   assert(T_Index);
   T_Index->Write();
 
+  if (m_dataStreamFile.is_open())
+  {
+    m_dataStreamFile.close();
+  }
+
   return Fun4AllReturnCodes::EVENT_OK;
 }
 
@@ -144,6 +162,18 @@ int TPCDataStreamEmulator::InitRun(PHCompositeNode* topNode)
     }
   }  //   for (int layer = m_minLayer; layer <= m_maxLayer; ++layer)
 
+  m_layerWavelets.resize(m_maxLayer - m_minLayer + 1);
+
+  if (m_saveDataStreamFile)
+  {
+    m_dataStreamFile.open(m_outputFileNameBase + ".dat", ios::binary | ios::trunc);
+    if (!m_dataStreamFile.is_open())
+    {
+      cout << "TPCDataStreamEmulator::InitRun - Fatal Error - could not open " << m_outputFileNameBase + ".dat" << endl;
+      exit(1);
+    }
+  }
+
   if (Verbosity() >= VERBOSITY_SOME)
     cout << "TPCDataStreamEmulator::get_HistoManager - Making PHTFileServer " << m_outputFileNameBase + ".root"
          << endl;
@@ -162,6 +192,8 @@ int TPCDataStreamEmulator::InitRun(PHCompositeNode* topNode)
   h->GetXaxis()->SetBinLabel(i++, "TPC Hit");
   h->GetXaxis()->SetBinLabel(i++, "TPC Wavelet");
   h->GetXaxis()->SetBinLabel(i++, "TPC DataSize");
+  h->GetXaxis()->SetBinLabel(i++, "TPC Packed DataSize");
+  h->GetXaxis()->SetBinLabel(i++, "TPC Compressed DataSize");
 
   h->GetXaxis()->LabelsOption("v");
   hm->registerHisto(h);
@@ -231,6 +263,38 @@ int TPCDataStreamEmulator::InitRun(PHCompositeNode* topNode)
                                  "Sum ADC per Time Bin;z bin ID;Layer ID",
                                  nZBins, -.5, nZBins - .5,
                                  m_maxLayer - m_minLayer + 1, m_minLayer - .5, m_maxLayer + .5));
+
+  hm->registerHisto(m_hPackedDataSize =
+                        new TH1D("hPackedDataSize",  //
+                                 "TPC packed SAMPA data size per Event;Data size [Byte];Count",
+                                 10000, 0, 20e6));
+
+  hm->registerHisto(m_hCompressedDataSize =
+                        new TH1D("hCompressedDataSize",  //
+                                 "TPC compressed data size per Event;Data size [Byte];Count",
+                                 10000, 0, 20e6));
+
+  hm->registerHisto(m_hFEEDataSize =
+                        new TH1D("hFEEDataSize",  //
+                                 "Packed SAMPA data size per FEE per Event;Data size [Byte];Count",
+                                 10000, 0, 200e3));
+
+  hm->registerHisto(m_hFEEOccupancy =
+                        new TH1D("hFEEOccupancy",  //
+                                 "Fraction of recorded ADC samples per FEE;Occupancy;Count",
+                                 1000, 0, 1));
+
+  hm->registerHisto(m_hLayerPackedDataSize =
+                        new TH2D("hLayerPackedDataSize",  //
+                                 "Packed SAMPA data size per trigger per layer;Layer ID;Data size [Byte]",
+                                 m_maxLayer - m_minLayer + 1, m_minLayer - .5, m_maxLayer + .5,
+                                 1000, 0, 1e6));
+
+  hm->registerHisto(m_hLayerCompressionRatio =
+                        new TH2D("hLayerCompressionRatio",  //
+                                 "Compressed over packed data size per layer;Layer ID;Compression ratio",
+                                 m_maxLayer - m_minLayer + 1, m_minLayer - .5, m_maxLayer + .5,
+                                 1000, 0, 1.5));
   return Fun4AllReturnCodes::EVENT_OK;
 }
 
@@ -341,6 +405,11 @@ int TPCDataStreamEmulator::process_event(PHCompositeNode* topNode)
 
   }  //   for (unsigned int layer = m_minLayer; layer <= m_maxLayer; ++layer)
 
+  for (auto& wavelets : m_layerWavelets)
+  {
+    wavelets.clear();
+  }
+
   // prepreare stat. storage
   int nZBins = 0;
   vector<array<vector<int>, 2> > layerChanHit(m_maxLayer + 1);
@@ -500,6 +569,77 @@ int TPCDataStreamEmulator::process_event(PHCompositeNode* topNode)
     layerChanDataSize[last_layer][last_side][last_phibin] += datasize;
   }
 
+  // pack the layers into FEE streams, layers are independent
+  vector<LayerStreams> layerStreams(m_layerWavelets.size());
+  atomic<unsigned int> nextLayer(0);
+  auto worker = [&]() {
+    for (unsigned int i = nextLayer++; i < m_layerWavelets.size(); i = nextLayer++)
+    {
+      packLayer(m_layerWavelets[i], layerStreams[i]);
+    }
+  };
+  const unsigned int nThreads = min<unsigned int>(m_nThreads, m_layerWavelets.size());
+  if (nThreads <= 1)
+  {
+    worker();
+  }
+  else
+  {
+    vector<thread> threads;
+    for (unsigned int i = 0; i < nThreads; ++i)
+    {
+      threads.push_back(thread(worker));
+    }
+    for (auto& t : threads)
+    {
+      t.join();
+    }
+  }
+
+  double sumPackedDataSize = 0;
+  double sumCompressedDataSize = 0;
+  const double samplesPerFEE = TPCDaqDefs::FEEv1::kN_CHANNELS * (nZBins / 2);
+  for (int layer = m_minLayer; layer <= m_maxLayer; ++layer)
+  {
+    const LayerStreams& streams = layerStreams[layer - m_minLayer];
+    for (const auto& fee : streams.fees)
+    {
+      assert(m_hFEEDataSize);
+      m_hFEEDataSize->Fill(fee.second.data.size());
+      assert(m_hFEEOccupancy);
+      m_hFEEOccupancy->Fill(fee.second.nSamples / samplesPerFEE);
+
+      if (m_dataStreamFile.is_open())
+      {
+        const int side = fee.first / 1000;
+        const int feeIndex = fee.first % 1000;
+        const unsigned int nBytes = fee.second.data.size();
+        m_dataStreamFile.write(reinterpret_cast<const char*>(&m_evtCounter), sizeof(m_evtCounter));
+        m_dataStreamFile.write(reinterpret_cast<const char*>(&layer), sizeof(layer));
+        m_dataStreamFile.write(reinterpret_cast<const char*>(&side), sizeof(side));
+        m_dataStreamFile.write(reinterpret_cast<const char*>(&feeIndex), sizeof(feeIndex));
+        m_dataStreamFile.write(reinterpret_cast<const char*>(&nBytes), sizeof(nBytes));
+        m_dataStreamFile.write(reinterpret_cast<const char*>(fee.second.data.data()), nBytes);
+      }
+    }
+
+    sumPackedDataSize += streams.packedSize;
+    sumCompressedDataSize += streams.compressedSize;
+    assert(m_hLayerPackedDataSize);
+    m_hLayerPackedDataSize->Fill(layer, streams.packedSize);
+    if (streams.packedSize > 0)
+    {
+      assert(m_hLayerCompressionRatio);
+      m_hLayerCompressionRatio->Fill(layer, streams.compressedSize / streams.packedSize);
+    }
+  }
+  assert(m_hPackedDataSize);
+  m_hPackedDataSize->Fill(sumPackedDataSize);
+  h_norm->Fill("TPC Packed DataSize", sumPackedDataSize);
+  assert(m_hCompressedDataSize);
+  m_hCompressedDataSize->Fill(sumCompressedDataSize);
+  h_norm->Fill("TPC Compressed DataSize", sumCompressedDataSize);
+
   // statistics
   for (int layer = m_minLayer; layer <= m_maxLayer; ++layer)
   {
@@ -567,9 +707,158 @@ int TPCDataStreamEmulator::writeWavelet(int layer, int side, int phibin, int hit
   assert(m_hLayerWaveletSize);
   m_hLayerWaveletSize->Fill(layer, wavelet.size());
 
+  // keep for the packed streams
+  Wavelet w;
+  w.side = side;
+  w.phibin = phibin;
+  w.hittime = hittime;
+  w.adc = wavelet;
+  m_layerWavelets[layer - m_minLayer].push_back(w);
+
   return headersize + datasizebyte;
 }
 
+void TPCDataStreamEmulator::FEEStream::add(unsigned int word)
+{
+  static const unsigned int wordMask = (1U << 10) - 1;
+
+  bitBuffer = (bitBuffer << 10) | (word & wordMask);
+  nBits += 10;
+  while (nBits >= 8)
+  {
+    nBits -= 8;
+    data.push_back((bitBuffer >> nBits) & 0xFF);
+  }
+  bitBuffer &= (1U << nBits) - 1;
+}
+
+void TPCDataStreamEmulator::FEEStream::flush()
+{
+  if (nBits > 0)
+  {
+    data.push_back((bitBuffer << (8 - nBits)) & 0xFF);
+    bitBuffer = 0;
+    nBits = 0;
+  }
+}
+
+void TPCDataStreamEmulator::packLayer(const vector<Wavelet>& wavelets, LayerStreams& streams) const
+{
+  static const unsigned int maxADC = (1U << 10) - 1;
+
+  streams.fees.clear();
+  streams.wordCount.assign(maxADC + 1, 0);
+  streams.packedSize = 0;
+  streams.compressedSize = 0;
+
+  // a wavelet is the channel in the FEE, the hit time and the sample count followed by the samples,
+  // all as 10-bit words
+  for (const Wavelet& w : wavelets)
+  {
+    const unsigned int channel = w.phibin % TPCDaqDefs::FEEv1::kN_CHANNELS;
+    FEEStream& fee = streams.fees[w.side * 1000 + w.phibin / TPCDaqDefs::FEEv1::kN_CHANNELS];
+
+    const unsigned int header[3] = {channel, (unsigned int) w.hittime, (unsigned int) w.adc.size()};
+    for (unsigned int word : header)
+    {
+      word = min(word, maxADC);
+      fee.add(word);
+      ++streams.wordCount[word];
+    }
+    for (unsigned int adc : w.adc)
+    {
+      adc = min(adc, maxADC);
+      fee.add(adc);
+      ++streams.wordCount[adc];
+    }
+    fee.nSamples += w.adc.size();
+  }
+
+  for (auto& fee : streams.fees)
+  {
+    fee.second.flush();
+    streams.packedSize += fee.second.data.size();
+  }
+
+  streams.compressedSize = compressedSize(streams.wordCount, m_compression);
+}
+
+double TPCDataStreamEmulator::compressedSize(const vector<unsigned int>& wordCount, Compression compression)
+{
+  // a code table entry is the 10-bit word and a 5-bit code length
+  static const int tableEntryBits = 15;
+
+  double nWords = 0;
+  int nUsed = 0;
+  for (unsigned int count : wordCount)
+  {
+    nWords += count;
+    if (count > 0) ++nUsed;
+  }
+  if (nWords == 0)
+  {
+    return 0;
+  }
+
+  double bits = 0;
+  if (compression == kNoCompression)
+  {
+    bits = nWords * 10;
+  }
+  else if (compression == kANS)
+  {
+    for (unsigned int count : wordCount)
+    {
+      if (count > 0)
+      {
+        bits -= count * log2(count / nWords);
+      }
+    }
+    bits += nUsed * tableEntryBits;
+  }
+  else
+  {
+    // Huffman tree, the code length of a word is the depth of its leaf
+    typedef pair<double, int> Node;
+    priority_queue<Node, vector<Node>, greater<Node> > nodes;
+    vector<int> parent;
+    vector<unsigned int> leafCount;
+    for (unsigned int count : wordCount)
+    {
+      if (count > 0)
+      {
+        nodes.push(make_pair(count, parent.size()));
+        parent.push_back(-1);
+        leafCount.push_back(count);
+      }
+    }
+    while (nodes.size() > 1)
+    {
+      const Node a = nodes.top();
+      nodes.pop();
+      const Node b = nodes.top();
+      nodes.pop();
+      const int merged = parent.size();
+      parent.push_back(-1);
+      parent[a.second] = merged;
+      parent[b.second] = merged;
+      nodes.push(make_pair(a.first + b.first, merged));
+    }
+    for (unsigned int leaf = 0; leaf < leafCount.size(); ++leaf)
+    {
+      int depth = 0;
+      for (int node = leaf; parent[node] >= 0; node = parent[node])
+      {
+        ++depth;
+      }
+      bits += (double) leafCount[leaf] * max(depth, 1);
+    }
+    bits += nUsed * tableEntryBits;
+  }
+
+  return ceil(bits / 8);
+}
+
 Fun4AllHistoManager*
 TPCDataStreamEmulator::getHistoManager()
 {
@@ -13,6 +13,9 @@
 
 #include <fun4all/SubsysReco.h>
 
+#include <fstream>
+#include <map>
+#include <string>
 #include <vector>
 
 class PHCompositeNode;
@@ -26,6 +29,16 @@ class TH2;
 class TPCDataStreamEmulator : public SubsysReco
 {
  public:
+  //! lossless compression of the packed 10-bit SAMPA words, for the compressed data size estimate
+  enum Compression
+  {
+    kNoCompression,
+    //! Huffman code of the 10-bit words per layer and event, including the code table
+    kHuffman,
+    //! entropy of the 10-bit words per layer and event, the limit an ANS coder approaches
+    kANS
+  };
+
   TPCDataStreamEmulator(
       unsigned int minLayer,
       unsigned int m_maxLayer,
@@ -52,18 +65,77 @@ class TPCDataStreamEmulator : public SubsysReco
     m_outputFileNameBase = outputFileNameBase;
   }
 
+  //! write the packed per FEE streams to <outputfilenamebase>.dat
   void saveDataStreamFile(bool saveDataStreamFile)
   {
     m_saveDataStreamFile = saveDataStreamFile;
   }
 
+  void compression(Compression compression)
+  {
+    m_compression = compression;
+  }
+
+  //! layers are packed and compressed in parallel by this many threads
+  void nThreads(unsigned int nThreads)
+  {
+    m_nThreads = nThreads > 0 ? nThreads : 1;
+  }
+
  private:
 #if !defined(__CINT__) || defined(__CLING__)
 
+  //! one zero suppressed ADC sequence of a channel
+  struct Wavelet
+  {
+    int side;
+    int phibin;
+    int hittime;
+    std::vector<unsigned int> adc;
+  };
+
+  //! packed SAMPA 10-bit words of one front end card
+  struct FEEStream
+  {
+    FEEStream()
+      : bitBuffer(0)
+      , nBits(0)
+      , nSamples(0)
+    {
+    }
+    void add(unsigned int word);
+    void flush();
+
+    std::vector<unsigned char> data;
+    unsigned int bitBuffer;
+    unsigned int nBits;
+    int nSamples;
+  };
+
+  //! packed streams of a layer, the key is side * 1000 + FEE index in the layer
+  struct LayerStreams
+  {
+    std::map<int, FEEStream> fees;
+    std::vector<unsigned int> wordCount;
+    double packedSize;
+    double compressedSize;
+  };
+
   Fun4AllHistoManager *getHistoManager();
   int writeWavelet(int layer, int side, int phibin, int hittime, const std::vector<unsigned int> &wavelet);
+  //! pack the wavelets of a layer into its FEE streams and estimate the compressed size
+  void packLayer(const std::vector<Wavelet> &wavelets, LayerStreams &streams) const;
+  //! compressed size in byte of the words counted in wordCount
+  static double compressedSize(const std::vector<unsigned int> &wordCount, Compression compression);
 
   bool m_saveDataStreamFile;
+  std::ofstream m_dataStreamFile;
+
+  Compression m_compression;
+  unsigned int m_nThreads;
+
+  //! wavelets of the current event by layer - m_minLayer
+  std::vector<std::vector<Wavelet> > m_layerWavelets;
 
   std::string m_outputFileNameBase;
 
@@ -86,6 +158,12 @@ class TPCDataStreamEmulator : public SubsysReco
   TH2 *m_hLayerDataSize;
   TH2 *m_hLayerSumHit;
   TH2 *m_hLayerSumDataSize;
+  TH1 *m_hPackedDataSize;
+  TH1 *m_hCompressedDataSize;
+  TH1 *m_hFEEDataSize;
+  TH1 *m_hFEEOccupancy;
+  TH2 *m_hLayerPackedDataSize;
+  TH2 *m_hLayerCompressionRatio;
 
 #endif  // #if !defined(__CINT__) || defined(__CLING__)
 };
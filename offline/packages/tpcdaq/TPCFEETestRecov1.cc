@@ -75,6 +75,9 @@ TPCFEETestRecov1::TPCFEETestRecov1(const std::string& outputfilename)
   , m_clusteringZeroSuppression(50)
   , m_nPreSample(5)
   , m_nPostSample(5)
+  , m_sampleFitMethod(kFastFit)
+  , m_templatePower(5)
+  , m_templatePeakTime(1.5)
   , m_XRayLocationX(-1)
   , m_XRayLocationY(-1)
   , m_pdfMaker(nullptr)
@@ -438,8 +441,8 @@ void TPCFEETestRecov1::Clustering()
       double peak_sample = NAN;
       double pedstal = NAN;
       map<int, double> parameters_io;
-      SampleFit_PowerLawDoubleExp(cluster.sum_samples, peak,
-                                  peak_sample, pedstal, parameters_io, Verbosity());
+      SampleFit(cluster.sum_samples, peak,
+                peak_sample, pedstal, parameters_io);
 
       parameters_constraints[1] = parameters_io[1];
       parameters_constraints[2] = parameters_io[2];
@@ -463,8 +466,8 @@ void TPCFEETestRecov1::Clustering()
         double pedstal = NAN;
         map<int, double> parameters_io(parameters_constraints);
 
-        SampleFit_PowerLawDoubleExp(cluster.padx_samples[pad_x], peak,
-                                    peak_sample, pedstal, parameters_io, Verbosity());
+        SampleFit(cluster.padx_samples[pad_x], peak,
+                  peak_sample, pedstal, parameters_io);
 
         cluster.padx_peaks[pad_x] = peak;
         sum_peak += peak;
@@ -485,8 +488,8 @@ void TPCFEETestRecov1::Clustering()
         double pedstal = NAN;
         map<int, double> parameters_io(parameters_constraints);
 
-        SampleFit_PowerLawDoubleExp(cluster.pady_samples[pad_y], peak,
-                                    peak_sample, pedstal, parameters_io, Verbosity());
+        SampleFit(cluster.pady_samples[pad_y], peak,
+                  peak_sample, pedstal, parameters_io);
 
         cluster.pady_peaks[pad_y] = peak;
         sum_peak += peak;
@@ -554,6 +557,25 @@ vector<int>& TPCFEETestRecov1::PadPlaneData::getPad(const int pad_x, const int p
   return m_data[pad_y][pad_x];
 }
 
+bool TPCFEETestRecov1::SampleFit(const std::vector<double>& samples, double& peak, double& peak_sample,
+                                 double& pedestal, std::map<int, double>& parameters_io)
+{
+  if (m_sampleFitMethod == kROOTFit)
+  {
+    return SampleFit_PowerLawDoubleExp(samples, peak, peak_sample, pedestal, parameters_io, Verbosity());
+  }
+  else if (m_sampleFitMethod == kTemplateFit)
+  {
+    parameters_io[2] = m_templatePower;
+    parameters_io[3] = m_templatePeakTime;
+    parameters_io[5] = 0;
+    parameters_io[6] = m_templatePeakTime;
+    return SampleFit_PowerLawDoubleExp_Template(samples, peak, peak_sample, pedestal, parameters_io, Verbosity());
+  }
+
+  return SampleFit_PowerLawDoubleExp_LM(samples, peak, peak_sample, pedestal, parameters_io, Verbosity());
+}
+
 std::pair<int, int> TPCFEETestRecov1::roughZeroSuppression(std::vector<int>& data)
 {
   std::vector<int> sorted_data(data);
@@ -61,6 +61,28 @@ class TPCFEETestRecov1 : public SubsysReco
     m_nPreSample = nPreSample;
   }
 
+  enum SampleFitMethod
+  {
+    //! TF1 fit with Minuit
+    kROOTFit,
+    //! Levenberg-Marquardt with analytic derivatives, same result as kROOTFit
+    kFastFit,
+    //! fixed shape from setSampleFitTemplate(), amplitude and pedestal solved linearly
+    kTemplateFit
+  };
+
+  void setSampleFitMethod(SampleFitMethod method)
+  {
+    m_sampleFitMethod = method;
+  }
+
+  //! shape of kTemplateFit
+  void setSampleFitTemplate(double power, double peakTime)
+  {
+    m_templatePower = power;
+    m_templatePeakTime = peakTime;
+  }
+
   //! simple event header class for ROOT file IO
   class EventHeader : public TObject
   {
@@ -258,12 +280,20 @@ class TPCFEETestRecov1 : public SubsysReco
   //! Clustering then prepare IOs
   void Clustering(void);
 
+  //! waveform fit of the selected SampleFitMethod
+  bool SampleFit(const std::vector<double> &samples, double &peak, double &peak_sample,
+                 double &pedestal, std::map<int, double> &parameters_io);
+
 #endif  // #if !defined(__CINT__) || defined(__CLING__)
 
   int m_clusteringZeroSuppression;
   int m_nPreSample;
   int m_nPostSample;
 
+  SampleFitMethod m_sampleFitMethod;
+  double m_templatePower;
+  double m_templatePeakTime;
+
   void get_motor_loc(Event *evt);
 
   int m_XRayLocationX;
@@ -18,6 +18,7 @@
 #include <phool/PHCompositeNode.h>
 #include <phool/getClass.h>
 
+#include <TDirectory.h>
 #include <TFile.h>
 #include <TH1D.h>
 #include <TH2D.h>
@@ -45,9 +46,13 @@ TPCIntegratedCharge::TPCIntegratedCharge(
     unsigned int m_maxLayer,
     const std::string& outputfilename)
   : SubsysReco("TPCIntegratedCharge")
+  , m_runningSum(false)
+  , m_snapshotInterval(0)
   , m_outputFileName(outputfilename)
   , m_minLayer(minLayer)
   , m_maxLayer(m_maxLayer)
+  , m_nZBins(0)
+  , m_nEvents(0)
 {
 }
 
@@ -66,10 +71,16 @@ int TPCIntegratedCharge::End(PHCompositeNode* topNode)
     cout << "TPCIntegratedCharge::End - write to " << m_outputFileName << endl;
   PHTFileServer::get().cd(m_outputFileName);
 
+  if (m_runningSum)
+  {
+    FillRunningSumHistos();
+  }
+
   Fun4AllHistoManager* hm = getHistoManager();
   assert(hm);
+  // replaces the snapshots of the running sum mode
   for (unsigned int i = 0; i < hm->nHistos(); i++)
-    hm->getHisto(i)->Write();
+    hm->getHisto(i)->Write("", TObject::kOverwrite);
 
   // help index files with TChain
   TTree* T_Index = new TTree("T_Index", "T_Index");
@@ -183,6 +194,11 @@ int TPCIntegratedCharge::process_event(PHCompositeNode* topNode)
     h_norm->Fill("Collision count", geneventmap->size());
   }
 
+  if (m_runningSum)
+  {
+    return AccumulateRunningSum(g4hit, cells, seggeo, h_norm);
+  }
+
   for (unsigned int layer = m_minLayer; layer <= m_maxLayer; ++layer)
   {
     PHG4HitContainer::ConstRange hit_begin_end = g4hit->getHits(layer);
@@ -355,6 +371,166 @@ int TPCIntegratedCharge::process_event(PHCompositeNode* topNode)
   return Fun4AllReturnCodes::EVENT_OK;
 }
 
+int TPCIntegratedCharge::AccumulateRunningSum(PHG4HitContainer* g4hit, PHG4CellContainer* cells, PHG4CylinderCellGeomContainer* seggeo, TH1D* h_norm)
+{
+  if (m_padHit[0].empty())
+  {
+    InitRunningSum(seggeo);
+  }
+  Fun4AllHistoManager* hm = getHistoManager();
+  TH2* hLayerSumCellHit = dynamic_cast<TH2*>(hm->getHisto("hLayerSumCellHit"));
+  assert(hLayerSumCellHit);
+  TH2* hLayerSumCellCharge = dynamic_cast<TH2*>(hm->getHisto("hLayerSumCellCharge"));
+  assert(hLayerSumCellCharge);
+
+  // the normalization is filled once per event with the event sums
+  unsigned int nG4Hit = 0;
+  double sumEdep = 0;
+  for (unsigned int layer = m_minLayer; layer <= m_maxLayer; ++layer)
+  {
+    PHG4HitContainer::ConstRange hit_begin_end = g4hit->getHits(layer);
+    for (PHG4HitContainer::ConstIterator hiter = hit_begin_end.first; hiter != hit_begin_end.second; ++hiter)
+    {
+      sumEdep += hiter->second->get_edep();
+      ++nG4Hit;
+    }
+  }
+  h_norm->Fill("TPC G4Hit Edep", sumEdep);
+  h_norm->Fill("TPC G4Hit", nG4Hit);
+
+  const unsigned int nLayers = m_maxLayer - m_minLayer + 1;
+  vector<int> layerHit[2] = {vector<int>(nLayers, 0), vector<int>(nLayers, 0)};
+  vector<double> layerCharge[2] = {vector<double>(nLayers, 0), vector<double>(nLayers, 0)};
+
+  PHG4CellContainer::ConstRange cellrange = cells->getCells();
+  for (PHG4CellContainer::ConstIterator celliter = cellrange.first;
+       celliter != cellrange.second;
+       ++celliter)
+  {
+    PHG4Cell* cell = celliter->second;
+    const unsigned int layer = cell->get_layer();
+    if (layer < m_minLayer or layer > m_maxLayer) continue;
+
+    const unsigned int phibin = PHG4CellDefs::SizeBinning::get_phibin(cell->get_cellid());
+    const unsigned int zbin = PHG4CellDefs::SizeBinning::get_zbin(cell->get_cellid());
+    assert(zbin < m_nZBins);
+    const int side = (zbin < m_nZBins / 2) ? 0 : 1;
+    const unsigned int ilayer = layer - m_minLayer;
+    assert(phibin < m_padHit[side][ilayer].size());
+
+    const double charge_e = cell->get_edep();
+    m_padHit[side][ilayer][phibin] += 1;
+    m_padCharge[side][ilayer][phibin] += charge_e;
+    layerHit[side][ilayer] += 1;
+    layerCharge[side][ilayer] += charge_e;
+  }
+
+  int sumHit = 0;
+  double sumCharge_e = 0;
+  for (unsigned int ilayer = 0; ilayer < nLayers; ++ilayer)
+  {
+    for (unsigned int side = 0; side < 2; ++side)
+    {
+      hLayerSumCellHit->Fill(m_minLayer + ilayer, layerHit[side][ilayer]);
+      hLayerSumCellCharge->Fill(m_minLayer + ilayer, layerCharge[side][ilayer] * eplus / (1e-15 * coulomb));
+      sumHit += layerHit[side][ilayer];
+      sumCharge_e += layerCharge[side][ilayer];
+    }
+  }
+  h_norm->Fill("TPC Pad Hit", sumHit);
+  h_norm->Fill("TPC Charge e", sumCharge_e);
+  h_norm->Fill("TPC Charge fC", sumCharge_e * eplus / (1e-15 * coulomb));
+  h_norm->Fill("Event count", 1);
+  ++m_nEvents;
+
+  if (m_snapshotInterval > 0 && m_nEvents % m_snapshotInterval == 0)
+  {
+    if (Verbosity() >= VERBOSITY_SOME)
+      cout << "TPCIntegratedCharge::process_event - snapshot of " << m_nEvents << " events to " << m_outputFileName << endl;
+    FillRunningSumHistos();
+    // all histograms live in the output file, a job which dies later
+    // leaves the sums up to here
+    PHTFileServer::get().cd(m_outputFileName);
+    gDirectory->GetFile()->Write("", TObject::kOverwrite);
+  }
+
+  return Fun4AllReturnCodes::EVENT_OK;
+}
+
+void TPCIntegratedCharge::InitRunningSum(PHG4CylinderCellGeomContainer* seggeo)
+{
+  int maxPhiBins = 0;
+  for (unsigned int layer = m_minLayer; layer <= m_maxLayer; ++layer)
+  {
+    PHG4CylinderCellGeom* layerGeom = seggeo->GetLayerCellGeom(layer);
+    assert(layerGeom);
+    const int nphibins = layerGeom->get_phibins();
+    assert(nphibins > 0);
+    maxPhiBins = max(maxPhiBins, nphibins);
+
+    if (m_nZBins == 0)
+    {
+      m_nZBins = layerGeom->get_zbins();
+      assert(m_nZBins > 0);
+    }
+    else if ((int) m_nZBins != layerGeom->get_zbins())
+    {
+      cout << "TPCIntegratedCharge::InitRunningSum - Fatal Error - nZBin at layer " << layer << " is " << layerGeom->get_zbins()
+           << ", which is different from previous layers of nZBin = " << m_nZBins << endl;
+      exit(1);
+    }
+    for (unsigned int side = 0; side < 2; ++side)
+    {
+      m_padHit[side].push_back(vector<uint64_t>(nphibins, 0));
+      m_padCharge[side].push_back(vector<double>(nphibins, 0));
+    }
+  }
+
+  // created in the output file like the other histograms
+  TDirectory* save = gDirectory;
+  PHTFileServer::get().cd(m_outputFileName);
+  Fun4AllHistoManager* hm = getHistoManager();
+  for (unsigned int side = 0; side < 2; ++side)
+  {
+    hm->registerHisto(new TH2D(boost::str(boost::format{"hPadHit_Side%1%"} % side).c_str(),
+                               "Number of ADC time-bin hit per pad summed over events;Layer ID;Phi bin",
+                               m_maxLayer - m_minLayer + 1, m_minLayer - .5, m_maxLayer + .5,
+                               maxPhiBins, -.5, maxPhiBins - .5));
+    hm->registerHisto(new TH2D(boost::str(boost::format{"hPadCharge_Side%1%"} % side).c_str(),
+                               "Charge per pad summed over events [fC];Layer ID;Phi bin",
+                               m_maxLayer - m_minLayer + 1, m_minLayer - .5, m_maxLayer + .5,
+                               maxPhiBins, -.5, maxPhiBins - .5));
+  }
+  save->cd();
+}
+
+void TPCIntegratedCharge::FillRunningSumHistos()
+{
+  if (m_padHit[0].empty())
+  {
+    return;
+  }
+  Fun4AllHistoManager* hm = getHistoManager();
+  for (unsigned int side = 0; side < 2; ++side)
+  {
+    TH2* hPadHit = dynamic_cast<TH2*>(hm->getHisto(boost::str(boost::format{"hPadHit_Side%1%"} % side)));
+    assert(hPadHit);
+    TH2* hPadCharge = dynamic_cast<TH2*>(hm->getHisto(boost::str(boost::format{"hPadCharge_Side%1%"} % side)));
+    assert(hPadCharge);
+    for (unsigned int ilayer = 0; ilayer < m_padHit[side].size(); ++ilayer)
+    {
+      for (unsigned int phibin = 0; phibin < m_padHit[side][ilayer].size(); ++phibin)
+      {
+        hPadHit->SetBinContent(ilayer + 1, phibin + 1, m_padHit[side][ilayer][phibin]);
+        hPadCharge->SetBinContent(ilayer + 1, phibin + 1, m_padCharge[side][ilayer][phibin] * eplus / (1e-15 * coulomb));
+      }
+    }
+    // entries are events, hadd adds them up as well
+    hPadHit->SetEntries(m_nEvents);
+    hPadCharge->SetEntries(m_nEvents);
+  }
+}
+
 Fun4AllHistoManager*
 TPCIntegratedCharge::getHistoManager()
 {
@@ -5,10 +5,27 @@
 
 #include <string>
 
+#if !defined(__CINT__) || defined(__CLING__)
+#include <cstdint>
+#include <vector>
+#endif
+
 class PHCompositeNode;
+class PHG4CellContainer;
+class PHG4CylinderCellGeomContainer;
+class PHG4HitContainer;
 class Fun4AllHistoManager;
+class TH1D;
 
 /// \class TPCIntegratedCharge
+///
+/// In the running sum mode (set_running_sum()) the charge and the number of
+/// hits of every pad are summed over all events into dense arrays instead of
+/// filling the per channel distributions for each event. The sums are
+/// written as hPadCharge_Side[01] and hPadHit_Side[01] (layer vs phi bin,
+/// charge in fC) together with hNormalization, optionally also every n
+/// events as a snapshot. The outputs of several jobs can be added with hadd
+/// to build the integrated charge maps of a full run.
 class TPCIntegratedCharge : public SubsysReco
 {
  public:
@@ -24,16 +41,36 @@ class TPCIntegratedCharge : public SubsysReco
   int process_event(PHCompositeNode *topNode);
   int End(PHCompositeNode *topNode);
 
+  //! sum the pad charges over all events instead of per event distributions
+  void set_running_sum(bool b) { m_runningSum = b; }
+  //! running sum mode: write the sums every n events (0: only at the end)
+  void set_snapshot_interval(unsigned int n) { m_snapshotInterval = n; }
+
  private:
+  bool m_runningSum;
+  unsigned int m_snapshotInterval;
+
 #if !defined(__CINT__) || defined(__CLING__)
 
   Fun4AllHistoManager *getHistoManager();
 
+  int AccumulateRunningSum(PHG4HitContainer *g4hit, PHG4CellContainer *cells, PHG4CylinderCellGeomContainer *seggeo, TH1D *h_norm);
+  void InitRunningSum(PHG4CylinderCellGeomContainer *seggeo);
+  //! copies the pad sums into their histograms
+  void FillRunningSumHistos();
+
   std::string m_outputFileName;
 
   unsigned int m_minLayer;
   unsigned int m_maxLayer;
 
+  unsigned int m_nZBins;
+  //! events summed in the running sum mode
+  uint64_t m_nEvents;
+  //! per pad sums, [side][layer - m_minLayer][phibin], charge in electrons
+  std::vector<std::vector<double> > m_padCharge[2];
+  std::vector<std::vector<uint64_t> > m_padHit[2];
+
 #endif  // #if !defined(__CINT__) || defined(__CLING__)
 };
 
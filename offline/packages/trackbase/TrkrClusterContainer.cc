@@ -7,16 +7,38 @@
 #include "TrkrClusterContainer.h"
 #include "TrkrCluster.h"
 #include "TrkrClusterv1.h"
+#include "TrkrClusterv2.h"
 
+#include <algorithm>
 #include <cstdlib>
+#include <mutex>
+
+namespace
+{
+  bool KeyLess(const TrkrClusterContainer::Entry& lhs, const TrkrClusterContainer::Entry& rhs)
+  {
+    return lhs.first < rhs.first;
+  }
+  bool EntryKeyLess(const TrkrClusterContainer::Entry& entry, const TrkrDefs::cluskey key)
+  {
+    return entry.first < key;
+  }
+  bool KeyEntryLess(const TrkrDefs::cluskey key, const TrkrClusterContainer::Entry& entry)
+  {
+    return key < entry.first;
+  }
+  // taken by addClusters, concurrent clusterizers fill the same container
+  std::mutex s_AddClustersMutex;
+}  // namespace
 
 void TrkrClusterContainer::Reset()
 {
-  while (m_clusmap.begin() != m_clusmap.end())
+  for (auto& entry : m_clusmap)
   {
-    delete m_clusmap.begin()->second;
-    m_clusmap.erase(m_clusmap.begin());
+    delete entry.second;
   }
+  // clear() keeps the capacity for the next event
+  m_clusmap.clear();
   return;
 }
 
@@ -44,16 +66,64 @@ TrkrClusterContainer::addCluster(TrkrCluster* newclus)
 TrkrClusterContainer::ConstIterator
 TrkrClusterContainer::addClusterSpecifyKey(const TrkrDefs::cluskey key, TrkrCluster* newclus)
 {
-  auto ret = m_clusmap.insert(std::make_pair(key, newclus));
-  if ( !ret.second )
+  // clusterizers produce clusters mostly in increasing key order,
+  // appending does not need to move anything
+  if (m_clusmap.empty() || m_clusmap.back().first < key)
+  {
+    m_clusmap.push_back(std::make_pair(key, newclus));
+    return m_clusmap.end() - 1;
+  }
+  Iterator it = lower_bound(key);
+  if (it != m_clusmap.end() && it->first == key)
   {
     std::cout << "TrkrClusterContainer::AddClusterSpecifyKey: duplicate key: " << key << " exiting now" << std::endl;
     exit(1);
   }
-  else
+  return m_clusmap.insert(it, std::make_pair(key, newclus));
+}
+
+void TrkrClusterContainer::addClusters(Map& newclusters)
+{
+  std::lock_guard<std::mutex> lock(s_AddClustersMutex);
+  Map::size_type oldsize = m_clusmap.size();
+  m_clusmap.insert(m_clusmap.end(), newclusters.begin(), newclusters.end());
+  newclusters.clear();
+  std::sort(m_clusmap.begin() + oldsize, m_clusmap.end(), KeyLess);
+  std::inplace_merge(m_clusmap.begin(), m_clusmap.begin() + oldsize, m_clusmap.end(), KeyLess);
+  ConstIterator dup = std::adjacent_find(m_clusmap.begin(), m_clusmap.end(),
+                                         [](const Entry& lhs, const Entry& rhs) { return lhs.first == rhs.first; });
+  if (dup != m_clusmap.end())
   {
-    return ret.first;
+    std::cout << "TrkrClusterContainer::addClusters: duplicate key: " << dup->first << " exiting now" << std::endl;
+    exit(1);
   }
+  return;
+}
+
+void TrkrClusterContainer::removeCluster(TrkrCluster* clus)
+{
+  m_clusmap.erase(std::remove_if(m_clusmap.begin(), m_clusmap.end(),
+                             [clus](const Entry& entry) { return entry.second == clus; }),
+             m_clusmap.end());
+  return;
+}
+
+TrkrClusterContainer::Iterator
+TrkrClusterContainer::lower_bound(const TrkrDefs::cluskey key)
+{
+  return std::lower_bound(m_clusmap.begin(), m_clusmap.end(), key, EntryKeyLess);
+}
+
+TrkrClusterContainer::ConstIterator
+TrkrClusterContainer::lower_bound(const TrkrDefs::cluskey key) const
+{
+  return std::lower_bound(m_clusmap.begin(), m_clusmap.end(), key, EntryKeyLess);
+}
+
+TrkrClusterContainer::ConstIterator
+TrkrClusterContainer::upper_bound(const TrkrDefs::cluskey key) const
+{
+  return std::upper_bound(m_clusmap.begin(), m_clusmap.end(), key, KeyEntryLess);
 }
 
 TrkrClusterContainer::ConstRange
@@ -69,8 +139,8 @@ TrkrClusterContainer::getClusters(const TrkrDefs::TrkrId trackerid) const
   TrkrDefs::cluskey keyhi = TrkrDefs::getClusKeyHi(trackerid);
 
   ConstRange retpair;
-  retpair.first = m_clusmap.lower_bound(keylo);
-  retpair.second = m_clusmap.upper_bound(keyhi);
+  retpair.first = lower_bound(keylo);
+  retpair.second = upper_bound(keyhi);
   return retpair;
 }
 
@@ -81,8 +151,8 @@ TrkrClusterContainer::getClusters(const TrkrDefs::TrkrId trackerid, const char l
   TrkrDefs::cluskey keyhi = TrkrDefs::getClusKeyHi(trackerid, layer);
 
   ConstRange retpair;
-  retpair.first = m_clusmap.lower_bound(keylo);
-  retpair.second = m_clusmap.upper_bound(keyhi);
+  retpair.first = lower_bound(keylo);
+  retpair.second = upper_bound(keyhi);
   return retpair;
 }
 
@@ -95,23 +165,34 @@ TrkrClusterContainer::getClusters(void) const
 TrkrClusterContainer::Iterator
 TrkrClusterContainer::findOrAddCluster(TrkrDefs::cluskey key)
 {
-  TrkrClusterContainer::Iterator it = m_clusmap.find(key);
-  if (it == m_clusmap.end())
+  TrkrClusterContainer::Iterator it = lower_bound(key);
+  if (it == m_clusmap.end() || it->first != key)
   {
     // add new cluster and set its key
-    auto ret = m_clusmap.insert(std::make_pair(key, new TrkrClusterv1()));
-    (ret.first->second)->setClusKey(key);
-    it = ret.first;
+    TrkrCluster* newclus = m_compactClusters ? static_cast<TrkrCluster*>(new TrkrClusterv2()) : static_cast<TrkrCluster*>(new TrkrClusterv1());
+    it = m_clusmap.insert(it, std::make_pair(key, newclus));
+    (it->second)->setClusKey(key);
   }
   return it;
 }
 
+unsigned int
+TrkrClusterContainer::getIndex(const TrkrDefs::cluskey key) const
+{
+  ConstIterator it = lower_bound(key);
+  if (it != m_clusmap.end() && it->first == key)
+  {
+    return it - m_clusmap.begin();
+  }
+  return InvalidIndex;
+}
+
 TrkrCluster*
 TrkrClusterContainer::findCluster(TrkrDefs::cluskey key)
 {
-  TrkrClusterContainer::Iterator it = m_clusmap.find(key);
+  TrkrClusterContainer::Iterator it = lower_bound(key);
 
-  if (it != m_clusmap.end())
+  if (it != m_clusmap.end() && it->first == key)
   {
     return it->second;
   }
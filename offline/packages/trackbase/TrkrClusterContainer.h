@@ -11,9 +11,10 @@
 
 #include <phool/PHObject.h>
 
-#include <map>
 #include <iostream>          // for cout, ostream
+#include <map>               // for the version 1 read rule
 #include <utility>           // for pair
+#include <vector>
 
 class TrkrCluster;
 
@@ -21,17 +22,36 @@ class TrkrCluster;
  * @brief Cluster container object
  *
  * Container for TrkrCluster objects
+ *
+ * The clusters are kept in a contiguous vector of (key, cluster) pairs
+ * sorted by cluster key. Ranges for a given tracker and layer are found
+ * with binary searches, lookups are O(log n) without the per entry node
+ * allocation of a std::map. Adding clusters in increasing key order (or
+ * in bulk via addClusters()) is cheap, inserting at random positions moves
+ * the tail of the vector, adding invalidates iterators.
+ *
+ * The position of a cluster in the vector is its dense index (0..size()-1).
+ * Once the clustering is done the indices do not change and can be used for
+ * plain arrays or bitsets of per cluster state instead of maps keyed by the
+ * sparse cluster key. Adding or removing clusters renumbers them.
+ *
+ * Version 1 stored a std::map, a read rule (TrkrClusterContainerLinkDef.h)
+ * converts it when older DSTs are read.
  */
 class TrkrClusterContainer : public PHObject
 {
  public:
-  typedef std::map<TrkrDefs::cluskey, TrkrCluster *> Map;
+  typedef std::pair<TrkrDefs::cluskey, TrkrCluster *> Entry;
+  typedef std::vector<Entry> Map;
   typedef Map::iterator Iterator;
   typedef Map::const_iterator ConstIterator;
   typedef std::pair<Iterator, Iterator> Range;
   typedef std::pair<ConstIterator, ConstIterator> ConstRange;
 
-  TrkrClusterContainer(){}
+  TrkrClusterContainer()
+    : m_compactClusters(false)
+  {
+  }
 
   virtual ~TrkrClusterContainer() {}
   void Reset();
@@ -41,32 +61,34 @@ class TrkrClusterContainer : public PHObject
   ConstIterator addCluster(TrkrCluster *newClus);
   ConstIterator addClusterSpecifyKey(const TrkrDefs::cluskey key, TrkrCluster *newClus);
 
+  /**
+   * add many clusters at once, they are appended and sorted once (the vector is emptied).
+   * Serialized against concurrent addClusters() calls on any container, clusterizers
+   * scheduled in parallel (SubsysReco::DeclareSharedOutputNode) add through this only
+   */
+  void addClusters(Map &newClusters);
+
+  //! reserve space for n clusters
+  void reserve(const unsigned int n) { m_clusmap.reserve(n); }
+
   //! preferred removal method, key is currently the clus id
   void removeCluster(TrkrDefs::cluskey key)
   {
-    m_clusmap.erase(key);
-  }
-
-  //! inefficent, use key where possible instead
-  void removeCluster(TrkrCluster *clus)
-  {
-    Iterator its = m_clusmap.begin();
-    Iterator last = m_clusmap.end();
-    for (; its != last;)
+    Iterator it = lower_bound(key);
+    if (it != m_clusmap.end() && it->first == key)
     {
-      if (its->second == clus)
-      {
-        m_clusmap.erase(its++);
-      }
-      else
-      {
-        ++its;
-      }
+      m_clusmap.erase(it);
     }
   }
 
+  //! inefficent, use key where possible instead
+  void removeCluster(TrkrCluster *clus);
+
   Iterator findOrAddCluster(TrkrDefs::cluskey key);
 
+  //! findOrAddCluster creates TrkrClusterv2 (half precision covariances) instead of TrkrClusterv1
+  void useCompactClusters(const bool b) { m_compactClusters = b; }
+
   //! return all Clusters matching a given detid
   ConstRange getClusters(const TrkrDefs::TrkrId trackerid) const;
 
@@ -83,9 +105,31 @@ class TrkrClusterContainer : public PHObject
     return m_clusmap.size();
   }
 
+  //! returned by getIndex for unknown keys
+  static const unsigned int InvalidIndex = 0xFFFFFFFF;
+
+  //! dense index of a cluster key (binary search), InvalidIndex if not found
+  unsigned int getIndex(const TrkrDefs::cluskey key) const;
+
+  //! dense index of an entry returned by the iterators of this container
+  unsigned int getIndex(const ConstIterator &it) const { return it - m_clusmap.begin(); }
+
+  //! cluster key at dense index, no range check
+  TrkrDefs::cluskey getKey(const unsigned int index) const { return m_clusmap[index].first; }
+
+  //! cluster at dense index, no range check
+  TrkrCluster *getCluster(const unsigned int index) const { return m_clusmap[index].second; }
+
  protected:
+  //! first entry with key >= given key
+  Iterator lower_bound(const TrkrDefs::cluskey key);
+  ConstIterator lower_bound(const TrkrDefs::cluskey key) const;
+  //! first entry with key > given key
+  ConstIterator upper_bound(const TrkrDefs::cluskey key) const;
+
   Map m_clusmap;
-  ClassDef(TrkrClusterContainer, 1)
+  bool m_compactClusters;  //! not persistent, only steers findOrAddCluster
+  ClassDef(TrkrClusterContainer, 2)
 };
 
 #endif //TRACKBASE_TRKRCLUSTERCONTAINER_H
@@ -1,5 +1,7 @@
 #ifdef __CINT__
 
 #pragma link C++ class TrkrClusterContainer+;
+// version 1 kept the clusters in a std::map, it is sorted by key like the vector
+#pragma read sourceClass="TrkrClusterContainer" targetClass="TrkrClusterContainer" version="[1]" source="std::map<TrkrDefs::cluskey, TrkrCluster*> m_clusmap" target="m_clusmap" code="{ m_clusmap.assign(onfile.m_clusmap.begin(), onfile.m_clusmap.end()); }"
 
 #endif /* __CINT__ */
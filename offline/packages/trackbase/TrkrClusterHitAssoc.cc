@@ -7,10 +7,31 @@
 
 #include "TrkrClusterHitAssoc.h"
 
+#include <algorithm>
+#include <mutex>
 #include <ostream>  // for operator<<, endl, basic_ostream, ostream, basic_o...
 
+namespace
+{
+  bool KeyLess(const TrkrClusterHitAssoc::Entry& lhs, const TrkrClusterHitAssoc::Entry& rhs)
+  {
+    return lhs.first < rhs.first;
+  }
+  bool EntryKeyLess(const TrkrClusterHitAssoc::Entry& entry, const TrkrDefs::cluskey key)
+  {
+    return entry.first < key;
+  }
+  bool KeyEntryLess(const TrkrDefs::cluskey key, const TrkrClusterHitAssoc::Entry& entry)
+  {
+    return key < entry.first;
+  }
+  // taken by addAssocs, concurrent clusterizers fill the same map
+  std::mutex s_AddAssocsMutex;
+}  // namespace
+
 TrkrClusterHitAssoc::TrkrClusterHitAssoc() 
   : m_map()
+  , m_nsorted(0)
 {
 }
 
@@ -22,7 +43,9 @@ TrkrClusterHitAssoc::~TrkrClusterHitAssoc()
 void 
 TrkrClusterHitAssoc::Reset()
 {
+  // clear() keeps the capacity for the next event
   m_map.clear();
+  m_nsorted = 0;
 }
 
 void 
@@ -47,14 +70,52 @@ TrkrClusterHitAssoc::identify(std::ostream &os) const
 void 
 TrkrClusterHitAssoc::addAssoc(TrkrDefs::cluskey ckey, unsigned int hidx)
 {
-  m_map.insert(std::make_pair(ckey, hidx));
+  // clusterizers add in increasing cluster key order, the entry stays sorted
+  if (m_nsorted == m_map.size() && (m_map.empty() || !(ckey < m_map.back().first)))
+  {
+    ++m_nsorted;
+  }
+  m_map.push_back(std::make_pair(ckey, hidx));
+}
+
+void
+TrkrClusterHitAssoc::addAssocs(Map& newassocs)
+{
+  std::lock_guard<std::mutex> lock(s_AddAssocsMutex);
+  finalize();
+  m_map.insert(m_map.end(), newassocs.begin(), newassocs.end());
+  newassocs.clear();
+  finalize();
+}
+
+void
+TrkrClusterHitAssoc::finalize()
+{
+  if (m_nsorted > m_map.size())
+  {
+    // content was replaced without Reset(), e.g. by reading a file
+    m_nsorted = 0;
+  }
+  if (m_nsorted == m_map.size())
+  {
+    return;
+  }
+  // stable: the hits of a cluster keep the order they were added in, as in the multimap before
+  Iterator tail = m_map.begin() + m_nsorted;
+  if (!std::is_sorted(tail, m_map.end(), KeyLess))
+  {
+    std::stable_sort(tail, m_map.end(), KeyLess);
+  }
+  std::inplace_merge(m_map.begin(), m_map.begin() + m_nsorted, m_map.end(), KeyLess);
+  m_nsorted = m_map.size();
 }
 
 TrkrClusterHitAssoc::ConstRange 
 TrkrClusterHitAssoc::getHits(TrkrDefs::cluskey ckey)
 {
+  finalize();
   ConstRange retpair;
-  retpair.first = m_map.lower_bound(ckey);
-  retpair.second = m_map.upper_bound(ckey);
+  retpair.first = std::lower_bound(m_map.cbegin(), m_map.cend(), ckey, EntryKeyLess);
+  retpair.second = std::upper_bound(retpair.first, m_map.cend(), ckey, KeyEntryLess);
   return retpair;
 }
@@ -12,21 +12,28 @@
 #include <phool/PHObject.h>
 
 #include <iostream>          // for cout, ostream
-#include <map>
 #include <utility>           // for pair
+#include <vector>
 
 /**
  * @brief Class for associating clusters to the hits that went into them
  *
  * Store the associations between clusters and the hits that went into them.
+ *
+ * The associations are kept in a contiguous vector of (cluster key, hit key)
+ * pairs sorted by cluster key, the hits of a cluster are a contiguous range
+ * found by binary search. Associations are appended while filling and sorted
+ * once (finalize()), which is done on the first lookup if the producer did not
+ * call it. The order of the hits of a cluster is the order they were added in.
  */
 class TrkrClusterHitAssoc : public PHObject
 {
 public:
   //! typedefs for convenience
-  typedef std::multimap<TrkrDefs::cluskey, TrkrDefs::hitkey> MMap;
-  typedef MMap::iterator Iterator;
-  typedef MMap::const_iterator ConstIterator;
+  typedef std::pair<TrkrDefs::cluskey, TrkrDefs::hitkey> Entry;
+  typedef std::vector<Entry> Map;
+  typedef Map::iterator Iterator;
+  typedef Map::const_iterator ConstIterator;
   typedef std::pair<Iterator, Iterator> Range;
   typedef std::pair<ConstIterator, ConstIterator> ConstRange;
   //! ctor
@@ -45,6 +52,20 @@ public:
    */
   void addAssoc(TrkrDefs::cluskey ckey, unsigned int hidx);
 
+  /**
+   * @brief Add many associations at once and sort them (the vector is emptied)
+   *
+   * Serialized against concurrent addAssocs() calls, clusterizers scheduled
+   * in parallel add their associations through this only
+   */
+  void addAssocs(Map &newAssocs);
+
+  //! reserve space for n associations
+  void reserve(const unsigned int n) { m_map.reserve(n); }
+
+  //! sorts the associations added since the last call, not thread safe
+  void finalize();
+
   /**
    * @brief Get all the hits associated with a cluster by key
    * @param[in] ckey Cluster key
@@ -52,9 +73,14 @@ public:
    */
   ConstRange getHits(TrkrDefs::cluskey ckey);
 
+  //! number of associations
+  unsigned int size() const { return m_map.size(); }
+
 private:
-  MMap m_map;
-  ClassDef(TrkrClusterHitAssoc, 1);
+  Map m_map;
+  //! number of leading entries which are sorted
+  Map::size_type m_nsorted; //!
+  ClassDef(TrkrClusterHitAssoc, 2);
 };
 
 #endif // TRACKBASE_TRKRCLUSTERHITASSOC_H
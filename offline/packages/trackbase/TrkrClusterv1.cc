@@ -6,6 +6,8 @@
  */
 #include "TrkrClusterv1.h"
 
+#include <phool/PHObjectPool.h>
+
 #include <cmath>
 #include <utility>          // for swap
 
@@ -161,3 +163,13 @@ float TrkrClusterv1::getRPhiError() const
 
 float TrkrClusterv1::getZError() const
 { return std::sqrt(getError(2, 2)); }
+
+void *TrkrClusterv1::operator new(size_t size)
+{
+  return PHObjectPool<TrkrClusterv1>::allocate(size);
+}
+
+void TrkrClusterv1::operator delete(void *ptr, size_t size)
+{
+  PHObjectPool<TrkrClusterv1>::deallocate(ptr, size);
+}
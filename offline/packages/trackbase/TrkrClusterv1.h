@@ -10,6 +10,7 @@
 #include "TrkrCluster.h"
 #include "TrkrDefs.h"
 
+#include <cstddef>
 #include <iostream>
 
 class PHObject;
@@ -30,6 +31,12 @@ class TrkrClusterv1 : public TrkrCluster
 
   //!dtor
   virtual ~TrkrClusterv1() {}
+
+#if !defined(__CINT__) || defined(__CLING__)
+  //! storage is recycled through PHObjectPool
+  static void *operator new(size_t size);
+  static void operator delete(void *ptr, size_t size);
+#endif
   // PHObject virtual overloads
   virtual void identify(std::ostream& os = std::cout) const;
   virtual void Reset() {}
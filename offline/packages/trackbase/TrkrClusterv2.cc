@@ -0,0 +1,208 @@
+/**
+ * @file trackbase/TrkrClusterv2.cc
+ * @brief Implementation of TrkrClusterv2
+ */
+#include "TrkrClusterv2.h"
+
+#include <phool/PHObjectPool.h>
+
+#include <half/half.h>
+
+#include <cmath>
+#include <utility>          // for swap
+
+namespace
+{
+
+  // square convenience function
+  template<class T> inline constexpr T square( const T& x ) { return x*x; }
+
+  // get unique index in cov. matrix array from i and j
+  inline unsigned int covarIndex(unsigned int i, unsigned int j)
+  {
+    if (i > j) std::swap(i, j);
+    return i + 1 + (j + 1) * (j) / 2 - 1;
+  }
+
+  // covariances are stored in units of 2^-14 cm^2, a power of two
+  // so the scaling itself does not lose precision
+  const float covarScale = 16384.;
+
+  inline unsigned short packCovar(const float value)
+  {
+    float scaled = value * covarScale;
+    // saturate instead of overflowing to inf, nan stays nan
+    if (scaled > HALF_MAX) scaled = HALF_MAX;
+    else if (scaled < -HALF_MAX) scaled = -HALF_MAX;
+    return half(scaled).bits();
+  }
+
+  inline float unpackCovar(const unsigned short bits)
+  {
+    half h;
+    h.setBits(bits);
+    return h / covarScale;
+  }
+
+  // unpack a packed covariance matrix, the half to float conversion is a
+  // table lookup so this loop has no branches
+  inline void unpackMatrix(const unsigned short* bits, float* matrix)
+  {
+    for (int i = 0; i < 6; ++i)
+    {
+      matrix[i] = unpackCovar(bits[i]);
+    }
+  }
+
+  // rotate packed size or covariant matrix to polar coordinates and return the phi component
+  float rotate(const TrkrClusterv2* cluster, const float* matrix)
+  {
+    const auto phi = -std::atan2(cluster->getY(), cluster->getX());
+    const auto cosphi = std::cos(phi);
+    const auto sinphi = std::sin(phi);
+
+    return
+      square(sinphi)*matrix[covarIndex(0,0)] +
+      square(cosphi)*matrix[covarIndex(1,1)] +
+      2.*cosphi*sinphi*matrix[covarIndex(0,1)];
+  }
+
+}
+
+TrkrClusterv2::TrkrClusterv2()
+  : m_cluskey(TrkrDefs::CLUSKEYMAX)
+  , m_isGlobal(true)
+  , m_adc(0xFFFFFFFF)
+{
+  for (int i = 0; i < 3; ++i) m_pos[i] = NAN;
+
+  for (int j = 0; j < 3; ++j)
+  {
+    for (int i = j; i < 3; ++i)
+    {
+      setSize(i, j, NAN);
+      setError(i, j, NAN);
+    }
+  }
+}
+
+void TrkrClusterv2::identify(std::ostream& os) const
+{
+  os << "---TrkrClusterv2--------------------" << std::endl;
+  os << "clusid: " << getClusKey() << std::dec << std::endl;
+
+  os << " (x,y,z) =  (" << getPosition(0);
+  os << ", " << getPosition(1) << ", ";
+  os << getPosition(2) << ") cm";
+  if (m_isGlobal)
+    os << " - global coordinates" << std::endl;
+  else
+    os << " - local coordinates" << std::endl;
+
+  os << " adc = " << getAdc() << std::endl;
+
+  os << " size phi = " << getPhiSize();
+  os << " cm, size z = " << getZSize() << " cm" << std::endl;
+
+  for (int i = 0; i < 3; ++i)
+  {
+    os << ((i == 1) ? "  size = ( " : "         ( ");
+    os << getSize(i, 0) << " , ";
+    os << getSize(i, 1) << " , ";
+    os << getSize(i, 2) << " )" << std::endl;
+  }
+  for (int i = 0; i < 3; ++i)
+  {
+    os << ((i == 1) ? "  err  = ( " : "         ( ");
+    os << getError(i, 0) << " , ";
+    os << getError(i, 1) << " , ";
+    os << getError(i, 2) << " )" << std::endl;
+  }
+
+  os << std::endl;
+  os << "-----------------------------------------------" << std::endl;
+
+  return;
+}
+
+int TrkrClusterv2::isValid() const
+{
+  if (m_cluskey == TrkrDefs::CLUSKEYMAX) return 0;
+  for (int i = 0; i < 3; ++i)
+  {
+    if (std::isnan(getPosition(i))) return 0;
+  }
+  if (m_adc == 0xFFFFFFFF) return 0;
+  float size[6];
+  float err[6];
+  getSizeMatrix(size);
+  getErrorMatrix(err);
+  for (int i = 0; i < 6; ++i)
+  {
+    if (std::isnan(size[i])) return 0;
+    if (std::isnan(err[i])) return 0;
+  }
+
+  return 1;
+}
+
+void TrkrClusterv2::setSize(unsigned int i, unsigned int j, float value)
+{
+  m_size[covarIndex(i, j)] = packCovar(value);
+  return;
+}
+
+float TrkrClusterv2::getSize(unsigned int i, unsigned int j) const
+{ return unpackCovar(m_size[covarIndex(i, j)]); }
+
+void TrkrClusterv2::setError(unsigned int i, unsigned int j, float value)
+{
+  m_err[covarIndex(i, j)] = packCovar(value);
+  return;
+}
+
+float TrkrClusterv2::getError(unsigned int i, unsigned int j) const
+{ return unpackCovar(m_err[covarIndex(i, j)]); }
+
+void TrkrClusterv2::getSizeMatrix(float* size) const
+{ unpackMatrix(m_size, size); }
+
+void TrkrClusterv2::getErrorMatrix(float* err) const
+{ unpackMatrix(m_err, err); }
+
+float TrkrClusterv2::getPhiSize() const
+{
+  float size[6];
+  getSizeMatrix(size);
+  return 2*std::sqrt(rotate(this, size));
+}
+
+float TrkrClusterv2::getZSize() const
+{ return 2.*sqrt(getSize(2, 2)); }
+
+float TrkrClusterv2::getPhiError() const
+{
+  const float rad = std::sqrt(square(m_pos[0])+square(m_pos[1]));
+  if (rad > 0) return getRPhiError() / rad;
+  return 0;
+}
+
+float TrkrClusterv2::getRPhiError() const
+{
+  float err[6];
+  getErrorMatrix(err);
+  return std::sqrt(rotate(this, err));
+}
+
+float TrkrClusterv2::getZError() const
+{ return std::sqrt(getError(2, 2)); }
+
+void *TrkrClusterv2::operator new(size_t size)
+{
+  return PHObjectPool<TrkrClusterv2>::allocate(size);
+}
+
+void TrkrClusterv2::operator delete(void *ptr, size_t size)
+{
+  PHObjectPool<TrkrClusterv2>::deallocate(ptr, size);
+}
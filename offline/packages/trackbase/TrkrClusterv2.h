@@ -0,0 +1,97 @@
+/**
+ * @file trackbase/TrkrClusterv2.h
+ * @brief Version 2 of TrkrCluster, compact storage of the covariances
+ */
+#ifndef TRACKBASE_TRKRCLUSTERV2_H
+#define TRACKBASE_TRKRCLUSTERV2_H
+
+#include "TrkrCluster.h"
+#include "TrkrDefs.h"
+
+#include <cstddef>
+#include <iostream>
+
+class PHObject;
+
+/**
+ * @brief Version 2 of TrkrCluster
+ *
+ * Same interface as TrkrClusterv1, but the size and error covariance
+ * matrices are stored as 16 bit half floats (see offline/packages/Half),
+ * scaled by 2^14 to move the smallest silicon errors out of the denormal
+ * range. This gives a relative precision of 1e-3 for covariances between
+ * 4e-9 cm^2 and 4 cm^2 (larger values are saturated) and saves 24 bytes
+ * per cluster. Positions and adc are kept at full precision.
+ */
+class TrkrClusterv2 : public TrkrCluster
+{
+ public:
+  //! ctor
+  TrkrClusterv2();
+
+  //!dtor
+  virtual ~TrkrClusterv2() {}
+
+#if !defined(__CINT__) || defined(__CLING__)
+  //! storage is recycled through PHObjectPool
+  static void *operator new(size_t size);
+  static void operator delete(void *ptr, size_t size);
+#endif
+  // PHObject virtual overloads
+  virtual void identify(std::ostream& os = std::cout) const;
+  virtual void Reset() {}
+  virtual int isValid() const;
+  virtual PHObject* CloneMe() const { return new TrkrClusterv2(*this); }
+  virtual void setClusKey(TrkrDefs::cluskey id) { m_cluskey = id; }
+  virtual TrkrDefs::cluskey getClusKey() const { return m_cluskey; }
+  //
+  // cluster position
+  //
+  virtual float getX() const { return m_pos[0]; }
+  virtual void setX(float x) { m_pos[0] = x; }
+  virtual float getY() const { return m_pos[1]; }
+  virtual void setY(float y) { m_pos[1] = y; }
+  virtual float getZ() const { return m_pos[2]; }
+  virtual void setZ(float z) { m_pos[2] = z; }
+  virtual float getPosition(int coor) const { return m_pos[coor]; }
+  virtual void setPosition(int coor, float xi) { m_pos[coor] = xi; }
+  virtual void setGlobal() { m_isGlobal = true; }
+  virtual void setLocal() { m_isGlobal = false; }
+  virtual bool isGlobal() { return m_isGlobal; }
+  //
+  // cluster info
+  //
+  virtual unsigned int getAdc() const { return m_adc; }
+  virtual void setAdc(unsigned int adc) { m_adc = adc; }
+  virtual float getSize(unsigned int i, unsigned int j) const;        //< get cluster dimension covar
+  virtual void setSize(unsigned int i, unsigned int j, float value);  //< set cluster dimension covar
+
+  virtual float getError(unsigned int i, unsigned int j) const;        //< get cluster error covar
+  virtual void setError(unsigned int i, unsigned int j, float value);  //< set cluster error covar
+
+  //
+  // convenience interface
+  //
+  virtual float getPhiSize() const;
+  virtual float getZSize() const;
+
+  virtual float getRPhiError() const;
+  virtual float getPhiError() const;
+  virtual float getZError() const;
+
+  //! unpacks all 6 elements of the packed size (err) covariance at once
+  void getSizeMatrix(float* size) const;
+  void getErrorMatrix(float* err) const;
+
+ protected:
+  TrkrDefs::cluskey m_cluskey;  //< unique identifier within container
+  float m_pos[3];               //< mean position x,y,z
+  bool m_isGlobal;              //< flag for coord sys (true = global)
+  unsigned int m_adc;           //< cluster sum adc
+  unsigned short m_size[6];     //< size covariance matrix (packed storage, half bits)
+  unsigned short m_err[6];      //< covariance matrix: rad, arc and z (packed storage, half bits)
+
+  ClassDef(TrkrClusterv2, 1)
+};
+
+#endif //TRACKBASE_TRKRCLUSTERV2_H
@@ -10,6 +10,8 @@
 #if defined(__CINT__) && !defined(__CLING__)
 #include <stdint.h>
 #else
+#include <cassert>
+#include <cstddef>
 #include <cstdint>
 #endif
 #include <iostream>
@@ -60,36 +62,122 @@ namespace TrkrDefs
   void printBits(const TrkrDefs::hitsetkey key, std::ostream& os = std::cout);
   void printBits(const TrkrDefs::cluskey key, std::ostream& os = std::cout);
   // void print_bits(const TrkrDefs::hitkey key, std::ostream& os = std::cout);
-  
+
+#if !defined(__CINT__) || defined(__CLING__)
+
+  // the key functions are called for every hit and cluster, they are
+  // constexpr so the compiler can fold them into the loops of the callers
+
   /// Get the tracker ID from either key type
-  uint8_t getTrkrId(const TrkrDefs::hitsetkey key);
-  uint8_t getTrkrId(const TrkrDefs::cluskey key);
+  constexpr uint8_t getTrkrId(const TrkrDefs::hitsetkey key) { return key >> kBitShiftTrkrId; }
+  constexpr uint8_t getTrkrId(const TrkrDefs::cluskey key) { return getTrkrId(static_cast<TrkrDefs::hitsetkey>(key >> kBitShiftClusId)); }
 
   /// Get the layer number from either key type
-  uint8_t getLayer(const TrkrDefs::hitsetkey key);
-  uint8_t getLayer(const TrkrDefs::cluskey key);
+  constexpr uint8_t getLayer(const TrkrDefs::hitsetkey key) { return key >> kBitShiftLayer; }
+  constexpr uint8_t getLayer(const TrkrDefs::cluskey key) { return getLayer(static_cast<TrkrDefs::hitsetkey>(key >> kBitShiftClusId)); }
 
   /// Get the lower 32 bits for cluster keys only
-  uint32_t getClusIndex(const TrkrDefs::cluskey key);
+  constexpr uint32_t getClusIndex(const TrkrDefs::cluskey key) { return key; }
 
   /// generate the common upper 16 bits for hitsetkey
-  TrkrDefs::hitsetkey genHitSetKey(const TrkrDefs::TrkrId trkrId, const uint8_t lyr);
+  constexpr TrkrDefs::hitsetkey genHitSetKey(const TrkrDefs::TrkrId trkrId, const uint8_t lyr)
+  {
+    return (static_cast<TrkrDefs::hitsetkey>(trkrId) << kBitShiftTrkrId) | (static_cast<TrkrDefs::hitsetkey>(lyr) << kBitShiftLayer);
+  }
 
   /// Get the upper 32 bits from cluster keys
-  uint32_t getHitSetKeyFromClusKey(const TrkrDefs::cluskey key);
+  constexpr uint32_t getHitSetKeyFromClusKey(const TrkrDefs::cluskey key) { return key >> kBitShiftClusId; }
+
+  /// generate a cluster key from hitsetkey and cluster id
+  constexpr TrkrDefs::cluskey genClusKey(const TrkrDefs::hitsetkey hskey, const uint32_t clusid)
+  {
+    return (static_cast<TrkrDefs::cluskey>(hskey) << kBitShiftClusId) | clusid;
+  }
 
   /// Get a valid low / hi range for hitsetkey given tracker id & layer
+  constexpr TrkrDefs::hitsetkey getHitSetKeyLo(const TrkrDefs::TrkrId trkrId) { return genHitSetKey(trkrId, 0); }
+  constexpr TrkrDefs::hitsetkey getHitSetKeyHi(const TrkrDefs::TrkrId trkrId) { return genHitSetKey(static_cast<TrkrDefs::TrkrId>(trkrId + 1), 0) - 1; }
+  constexpr TrkrDefs::hitsetkey getHitSetKeyLo(const TrkrDefs::TrkrId trkrId, const uint8_t lyr) { return genHitSetKey(trkrId, lyr); }
+  constexpr TrkrDefs::hitsetkey getHitSetKeyHi(const TrkrDefs::TrkrId trkrId, const uint8_t lyr)
+  {
+    return (static_cast<TrkrDefs::hitsetkey>(genHitSetKey(trkrId, lyr)) + (static_cast<TrkrDefs::hitsetkey>(1) << kBitShiftLayer)) - 1;
+  }
+
+  /// Get a valid low / hi range for cluskey given tracker id & layer
+  constexpr TrkrDefs::cluskey getClusKeyLo(const TrkrDefs::TrkrId trkrId) { return genClusKey(getHitSetKeyLo(trkrId), 0); }
+  constexpr TrkrDefs::cluskey getClusKeyHi(const TrkrDefs::TrkrId trkrId) { return genClusKey(getHitSetKeyHi(trkrId), UINT32_MAX); }
+  constexpr TrkrDefs::cluskey getClusKeyLo(const TrkrDefs::TrkrId trkrId, const uint8_t lyr) { return genClusKey(getHitSetKeyLo(trkrId, lyr), 0); }
+  constexpr TrkrDefs::cluskey getClusKeyHi(const TrkrDefs::TrkrId trkrId, const uint8_t lyr) { return genClusKey(getHitSetKeyHi(trkrId, lyr), UINT32_MAX); }
+
+  /// bulk decoding of n keys, the loops vectorize
+  inline void getLayers(const TrkrDefs::hitsetkey* keys, const size_t n, uint8_t* layers)
+  {
+    for (size_t i = 0; i < n; ++i)
+    {
+      layers[i] = getLayer(keys[i]);
+    }
+  }
+  inline void getLayers(const TrkrDefs::cluskey* keys, const size_t n, uint8_t* layers)
+  {
+    for (size_t i = 0; i < n; ++i)
+    {
+      layers[i] = getLayer(keys[i]);
+    }
+  }
+  inline void getHitSetKeysFromClusKeys(const TrkrDefs::cluskey* keys, const size_t n, TrkrDefs::hitsetkey* hitsetkeys)
+  {
+    for (size_t i = 0; i < n; ++i)
+    {
+      hitsetkeys[i] = getHitSetKeyFromClusKey(keys[i]);
+    }
+  }
+
+  /**
+   * @brief hitsetkey of a given tracker
+   *
+   * The tracker id is part of the type, the detector specific key types
+   * (MvtxDefs::HitSetKey, ...) add their bit fields. Wrapping a key of
+   * another tracker is caught by an assert in debug builds.
+   */
+  template <TrkrDefs::TrkrId ID>
+  class TypedHitSetKey
+  {
+   public:
+    static constexpr TrkrDefs::TrkrId trkrId = ID;
+
+    constexpr explicit TypedHitSetKey(const TrkrDefs::hitsetkey key)
+      : m_Key((assert(getTrkrId(key) == ID), key))
+    {
+    }
+    constexpr TrkrDefs::hitsetkey key() const { return m_Key; }
+    constexpr operator TrkrDefs::hitsetkey() const { return m_Key; }
+    constexpr uint8_t layer() const { return getLayer(m_Key); }
+    constexpr TrkrDefs::cluskey clusKey(const uint32_t clusid) const { return genClusKey(m_Key, clusid); }
+
+   protected:
+    TrkrDefs::hitsetkey m_Key;
+  };
+
+#else
+
+  uint8_t getTrkrId(const TrkrDefs::hitsetkey key);
+  uint8_t getTrkrId(const TrkrDefs::cluskey key);
+  uint8_t getLayer(const TrkrDefs::hitsetkey key);
+  uint8_t getLayer(const TrkrDefs::cluskey key);
+  uint32_t getClusIndex(const TrkrDefs::cluskey key);
+  TrkrDefs::hitsetkey genHitSetKey(const TrkrDefs::TrkrId trkrId, const uint8_t lyr);
+  uint32_t getHitSetKeyFromClusKey(const TrkrDefs::cluskey key);
   TrkrDefs::hitsetkey getHitSetKeyLo(const TrkrDefs::TrkrId trkrId);
   TrkrDefs::hitsetkey getHitSetKeyHi(const TrkrDefs::TrkrId trkrId);
   TrkrDefs::hitsetkey getHitSetKeyLo(const TrkrDefs::TrkrId trkrId, const uint8_t lyr);
   TrkrDefs::hitsetkey getHitSetKeyHi(const TrkrDefs::TrkrId trkrId, const uint8_t lyr);
-
-  /// Get a valid low / hi range for cluskey given tracker id & layer
   TrkrDefs::cluskey getClusKeyLo(const TrkrDefs::TrkrId trkrId);
   TrkrDefs::cluskey getClusKeyHi(const TrkrDefs::TrkrId trkrId);
   TrkrDefs::cluskey getClusKeyLo(const TrkrDefs::TrkrId trkrId, const uint8_t lyr);
   TrkrDefs::cluskey getClusKeyHi(const TrkrDefs::TrkrId trkrId, const uint8_t lyr);
 
+#endif
+
 }
 
 #endif  //TRACKBASE_TRKRDEFUTIL_H
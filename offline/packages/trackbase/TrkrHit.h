@@ -31,7 +31,11 @@ class TrkrHit : public PHObject
   {
     os << "TrkrHit base class" << std::endl;
   }
-  virtual void Reset() {}
+  virtual void Reset()
+  {
+    m_edep = 0;
+    m_adc = 0;
+  }
   virtual int isValid() const { return 0; }
 
   void addEnergy(const double edep) {m_edep += edep;}
@@ -8,6 +8,7 @@
 
 #include "TrkrHit.h"
 
+#include <algorithm>
 #include <cstdlib>     // for exit
 #include <iostream>
 #include <type_traits>  // for __decay_and_strip<>::__type
@@ -34,11 +35,13 @@ void TrkrHitSet::Reset()
 {
   m_hitSetKey = TrkrDefs::HITSETKEYMAX;
   
-  while ( m_hits.begin() != m_hits.end() )
+  for (auto& entry : m_hits)
   {
-    delete (m_hits.begin())->second;
-    m_hits.erase(m_hits.begin());
+    delete entry.second;
   }
+  // one clear instead of rebalancing the map after every erase
+  m_hits.clear();
+  m_staged.clear();
   
   return;
 }
@@ -111,3 +114,42 @@ TrkrHitSet::getHits()
 {
   return std::make_pair(m_hits.begin(), m_hits.end());
 }
+
+TrkrHitSet::ConstRange
+TrkrHitSet::getHits(const TrkrDefs::hitkey keylow, const TrkrDefs::hitkey keyhigh) const
+{
+  return std::make_pair(m_hits.lower_bound(keylow), m_hits.upper_bound(keyhigh));
+}
+
+void TrkrHitSet::addStagedHits(const std::function<TrkrHit*()>& newhit)
+{
+  if (m_staged.empty())
+  {
+    return;
+  }
+  std::stable_sort(m_staged.begin(), m_staged.end(),
+                   [](const std::pair<TrkrDefs::hitkey, double>& lhs, const std::pair<TrkrDefs::hitkey, double>& rhs) { return lhs.first < rhs.first; });
+  // the keys come in order, so the map position of the next key is at or after the
+  // current one. For a new hitset it is always the end and the insertion is constant time
+  Map::iterator pos = m_hits.lower_bound(m_staged.front().first);
+  auto iter = m_staged.begin();
+  while (iter != m_staged.end())
+  {
+    const TrkrDefs::hitkey key = iter->first;
+    double energy = 0;
+    for (; iter != m_staged.end() && iter->first == key; ++iter)
+    {
+      energy += iter->second;
+    }
+    if (pos != m_hits.end() && pos->first < key)
+    {
+      pos = m_hits.lower_bound(key);
+    }
+    if (pos == m_hits.end() || pos->first != key)
+    {
+      pos = m_hits.emplace_hint(pos, key, newhit());
+    }
+    pos->second->addEnergy(energy);
+  }
+  m_staged.clear();
+}
@@ -14,6 +14,11 @@
 #include <iostream>
 #include <map>
 #include <utility>           // for pair
+#include <vector>
+
+#if !defined(__CINT__) || defined(__CLING__)
+#include <functional>
+#endif
 
 class TrkrHit;
 
@@ -85,6 +90,50 @@ class TrkrHitSet : public PHObject
    */
   ConstRange getHits();
 
+  /**
+   * @brief Get the hits with keys in [keylow, keyhigh]
+   * @param[out] Pair of iterator to the first and behind the last hit
+   *
+   * For the TPC the time bin is the lower part of the hit key, so the
+   * hits of a pad in a time window are the range
+   * TpcDefs::genHitKey(pad, tbin_min) to TpcDefs::genHitKey(pad, tbin_max).
+   */
+  ConstRange getHits(const TrkrDefs::hitkey keylow, const TrkrDefs::hitkey keyhigh) const;
+
+  /**
+   * @brief Stage the energy of a hit for addStagedHits()
+   * @param[in] key Hit key
+   * @param[in] energy Energy (or charge) to be added to the hit
+   *
+   * Producers which fill many hits (digitizers, hit recos) stage them
+   * here instead of looking up every hit in the map. Keys can be staged
+   * more than once, their energies are summed.
+   */
+  void stageHit(const TrkrDefs::hitkey key, const double energy) { m_staged.push_back(std::make_pair(key, energy)); }
+
+  /**
+   * @brief Number of staged hits not yet added
+   */
+  unsigned int stagedSize() const { return m_staged.size(); }
+
+#if !defined(__CINT__) || defined(__CLING__)
+  /**
+   * @brief Add the staged hits to this container in one step
+   * @param[in] newhit creates the TrkrHit for keys not in this container yet
+   *
+   * The staged entries are sorted by key (entries of the same key keep their
+   * staging order, so the sums are reproducible), merged and then inserted
+   * in key order, each with the position of the previous one as hint.
+   */
+  void addStagedHits(const std::function<TrkrHit*()>& newhit);
+
+  template <class T>
+  void addStagedHits()
+  {
+    addStagedHits([]() -> TrkrHit* { return new T(); });
+  }
+#endif
+
   /**
    * @brief Get the number of hits stored
    * @param[out] number of hits
@@ -95,6 +144,7 @@ class TrkrHitSet : public PHObject
  private:
   TrkrDefs::hitsetkey m_hitSetKey; /// unique key for this object
   Map m_hits; /// storage for TrkrHit objects
+  std::vector<std::pair<TrkrDefs::hitkey, double> > m_staged; //! hits of stageHit() waiting for addStagedHits()
   ClassDef(TrkrHitSet, 1);
 };
 
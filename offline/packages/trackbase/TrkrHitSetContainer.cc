@@ -7,10 +7,28 @@
 #include "TrkrHitSetContainer.h"
 
 #include "TrkrDefs.h"
+#include "TrkrHit.h"
 #include "TrkrHitSet.h"
 
+#include <algorithm>
 #include <cstdlib>
 
+namespace
+{
+  bool KeyLess(const TrkrHitSetContainer::Entry& lhs, const TrkrHitSetContainer::Entry& rhs)
+  {
+    return lhs.first < rhs.first;
+  }
+  bool EntryKeyLess(const TrkrHitSetContainer::Entry& entry, const TrkrDefs::hitsetkey key)
+  {
+    return entry.first < key;
+  }
+  bool KeyEntryLess(const TrkrDefs::hitsetkey key, const TrkrHitSetContainer::Entry& entry)
+  {
+    return key < entry.first;
+  }
+}  // namespace
+
 TrkrHitSetContainer::TrkrHitSetContainer()
 {
 }
@@ -22,11 +40,12 @@ TrkrHitSetContainer::~TrkrHitSetContainer()
 
 void TrkrHitSetContainer::Reset()
 {
-  while (m_hitmap.begin() != m_hitmap.end())
+  for (auto& entry : m_hitmap)
   {
-    delete m_hitmap.begin()->second;   // frees up memory for TrkrHit objects
-    m_hitmap.erase(m_hitmap.begin());
+    delete entry.second;   // frees up memory for TrkrHit objects
   }
+  // clear() keeps the capacity for the next event
+  m_hitmap.clear();
   return;
 }
 
@@ -52,16 +71,61 @@ TrkrHitSetContainer::addHitSet(TrkrHitSet* newhit)
 TrkrHitSetContainer::ConstIterator
 TrkrHitSetContainer::addHitSetSpecifyKey(const TrkrDefs::hitsetkey key, TrkrHitSet* newhit)
 {
-  auto ret = m_hitmap.insert(std::make_pair(key, newhit));
-  if ( !ret.second )
+  if (m_hitmap.empty() || m_hitmap.back().first < key)
+  {
+    m_hitmap.push_back(std::make_pair(key, newhit));
+    return m_hitmap.end() - 1;
+  }
+  Iterator it = lower_bound(key);
+  if (it != m_hitmap.end() && it->first == key)
   {
     std::cout << "TrkrHitSetContainer::AddHitSpecifyKey: duplicate key: " << key << " exiting now" << std::endl;
     exit(1);
   }
-  else
+  return m_hitmap.insert(it, std::make_pair(key, newhit));
+}
+
+void TrkrHitSetContainer::addHitSets(Map& newhitsets)
+{
+  Map::size_type oldsize = m_hitmap.size();
+  m_hitmap.insert(m_hitmap.end(), newhitsets.begin(), newhitsets.end());
+  newhitsets.clear();
+  std::sort(m_hitmap.begin() + oldsize, m_hitmap.end(), KeyLess);
+  std::inplace_merge(m_hitmap.begin(), m_hitmap.begin() + oldsize, m_hitmap.end(), KeyLess);
+  ConstIterator dup = std::adjacent_find(m_hitmap.begin(), m_hitmap.end(),
+                                         [](const Entry& lhs, const Entry& rhs) { return lhs.first == rhs.first; });
+  if (dup != m_hitmap.end())
   {
-    return ret.first;
+    std::cout << "TrkrHitSetContainer::addHitSets: duplicate key: " << dup->first << " exiting now" << std::endl;
+    exit(1);
   }
+  return;
+}
+
+void TrkrHitSetContainer::removeHitSet(TrkrHitSet* hit)
+{
+  m_hitmap.erase(std::remove_if(m_hitmap.begin(), m_hitmap.end(),
+                             [hit](const Entry& entry) { return entry.second == hit; }),
+             m_hitmap.end());
+  return;
+}
+
+TrkrHitSetContainer::Iterator
+TrkrHitSetContainer::lower_bound(const TrkrDefs::hitsetkey key)
+{
+  return std::lower_bound(m_hitmap.begin(), m_hitmap.end(), key, EntryKeyLess);
+}
+
+TrkrHitSetContainer::ConstIterator
+TrkrHitSetContainer::lower_bound(const TrkrDefs::hitsetkey key) const
+{
+  return std::lower_bound(m_hitmap.begin(), m_hitmap.end(), key, EntryKeyLess);
+}
+
+TrkrHitSetContainer::ConstIterator
+TrkrHitSetContainer::upper_bound(const TrkrDefs::hitsetkey key) const
+{
+  return std::upper_bound(m_hitmap.begin(), m_hitmap.end(), key, KeyEntryLess);
 }
 
 TrkrHitSetContainer::ConstRange
@@ -77,8 +141,8 @@ TrkrHitSetContainer::getHitSets(const TrkrDefs::TrkrId trackerid) const
   TrkrDefs::hitsetkey keyhi = TrkrDefs::getHitSetKeyHi(trackerid);
 
   ConstRange retpair;
-  retpair.first = m_hitmap.lower_bound(keylo);
-  retpair.second = m_hitmap.upper_bound(keyhi);
+  retpair.first = lower_bound(keylo);
+  retpair.second = upper_bound(keyhi);
   return retpair;
 }
 
@@ -98,8 +162,8 @@ TrkrHitSetContainer::getHitSets(const TrkrDefs::TrkrId trackerid,
   TrkrDefs::hitsetkey keyhi = TrkrDefs::getHitSetKeyHi(trackerid, layer);
 
   ConstRange retpair;
-  retpair.first = m_hitmap.lower_bound(keylo);
-  retpair.second = m_hitmap.upper_bound(keyhi);
+  retpair.first = lower_bound(keylo);
+  retpair.second = upper_bound(keyhi);
   return retpair;
 }
 
@@ -109,11 +173,33 @@ TrkrHitSetContainer::getHitSets(void) const
   return std::make_pair(m_hitmap.begin(), m_hitmap.end());
 }
 
+void TrkrHitSetContainer::exportHits(const TrkrDefs::TrkrId trackerid, FlatHits& flat) const
+{
+  flat.hitsetkeys.clear();
+  flat.offsets.clear();
+  flat.hitkeys.clear();
+  flat.adc.clear();
+  ConstRange hitsets = getHitSets(trackerid);
+  flat.offsets.push_back(0);
+  for (ConstIterator iter = hitsets.first; iter != hitsets.second; ++iter)
+  {
+    flat.hitsetkeys.push_back(iter->first);
+    TrkrHitSet::ConstRange hits = iter->second->getHits();
+    for (TrkrHitSet::ConstIterator hiter = hits.first; hiter != hits.second; ++hiter)
+    {
+      flat.hitkeys.push_back(hiter->first);
+      flat.adc.push_back(hiter->second->getAdc());
+    }
+    flat.offsets.push_back(flat.hitkeys.size());
+  }
+  return;
+}
+
 TrkrHitSetContainer::Iterator
 TrkrHitSetContainer::findOrAddHitSet(TrkrDefs::hitsetkey key)
 {
-  auto it = m_hitmap.lower_bound( key );
-  if( it == m_hitmap.cend() || (key < it->first ) )
+  Iterator it = lower_bound( key );
+  if( it == m_hitmap.end() || (key < it->first ) )
   {
     it = m_hitmap.insert(it, std::make_pair(key, new TrkrHitSet()));
     it->second->setHitSetKey( key );
@@ -124,9 +210,9 @@ TrkrHitSetContainer::findOrAddHitSet(TrkrDefs::hitsetkey key)
 TrkrHitSet*
 TrkrHitSetContainer::findHitSet(TrkrDefs::hitsetkey key)
 {
-  TrkrHitSetContainer::ConstIterator it = m_hitmap.find(key);
+  TrkrHitSetContainer::ConstIterator it = lower_bound(key);
 
-  if (it != m_hitmap.end())
+  if (it != m_hitmap.end() && it->first == key)
   {
     return it->second;
   }
@@ -6,23 +6,44 @@
 #include <phool/PHObject.h>
 
 #include <iostream>          // for cout, ostream
-#include <map>
+#include <map>               // for the version 1 read rule
 #include <utility>           // for pair
+#include <vector>
 
 class TrkrHitSet;
 
 /**
  * Container for TrkrHitSet objects
+ *
+ * The hitsets are kept in a contiguous vector of (key, hitset) pairs
+ * sorted by hitset key, ranges and lookups are binary searches. Adding
+ * hitsets in increasing key order (or in bulk via addHitSets()) is cheap,
+ * adding invalidates iterators.
+ *
+ * Version 1 stored a std::map, a read rule (TrkrHitSetContainerLinkDef.h)
+ * converts it when older DSTs are read.
  */
 class TrkrHitSetContainer : public PHObject
 {
  public:
-  typedef std::map<TrkrDefs::hitsetkey, TrkrHitSet *> Map;
+  typedef std::pair<TrkrDefs::hitsetkey, TrkrHitSet *> Entry;
+  typedef std::vector<Entry> Map;
   typedef Map::iterator Iterator;
   typedef Map::const_iterator ConstIterator;
   typedef std::pair<Iterator, Iterator> Range;
   typedef std::pair<ConstIterator, ConstIterator> ConstRange;
 
+  //! hits of many hitsets in plain arrays, e.g. to hand them to an accelerator.
+  //! The hits of hitsetkeys[i] are the entries [offsets[i], offsets[i + 1])
+  struct FlatHits
+  {
+    std::vector<TrkrDefs::hitsetkey> hitsetkeys;
+    std::vector<unsigned int> offsets;
+    std::vector<TrkrDefs::hitkey> hitkeys;
+    std::vector<unsigned int> adc;
+    unsigned int nhitsets() const { return hitsetkeys.size(); }
+  };
+
   //! ctor
   TrkrHitSetContainer();
 
@@ -36,30 +57,25 @@ class TrkrHitSetContainer : public PHObject
   ConstIterator addHitSet(TrkrHitSet *newHit);
   ConstIterator addHitSetSpecifyKey(const TrkrDefs::hitsetkey key, TrkrHitSet *newHit);
 
+  //! add many hitsets at once, they are appended and sorted once (the vector is emptied)
+  void addHitSets(Map &newHitSets);
+
+  //! reserve space for n hitsets
+  void reserve(const unsigned int n) { m_hitmap.reserve(n); }
+
   //! preferred removal method, key is currently the hit id
   void removeHitSet(TrkrDefs::hitsetkey key)
   {
-    m_hitmap.erase(key);
-  }
-
-  //! inefficent, use key where possible instead
-  void removeHitSet(TrkrHitSet *hit)
-  {
-    Iterator its = m_hitmap.begin();
-    Iterator last = m_hitmap.end();
-    for (; its != last;)
+    Iterator it = lower_bound(key);
+    if (it != m_hitmap.end() && it->first == key)
     {
-      if (its->second == hit)
-      {
-        m_hitmap.erase(its++);
-      }
-      else
-      {
-        ++its;
-      }
+      m_hitmap.erase(it);
     }
   }
 
+  //! inefficent, use key where possible instead
+  void removeHitSet(TrkrHitSet *hit);
+
   //! find or add HitSet
   Iterator findOrAddHitSet(TrkrDefs::hitsetkey key);
 
@@ -72,6 +88,9 @@ class TrkrHitSetContainer : public PHObject
   //! return all HitSets
   ConstRange getHitSets(void) const;
 
+  //! copy the hits of all hitsets of a detector in key order into flat, the arrays are reused
+  void exportHits(const TrkrDefs::TrkrId trackerid, FlatHits &flat) const;
+
   //! return a given HitSet based on its key
   TrkrHitSet *findHitSet(TrkrDefs::hitsetkey key);
 
@@ -81,8 +100,14 @@ class TrkrHitSetContainer : public PHObject
   }
 
  protected:
+  //! first entry with key >= given key
+  Iterator lower_bound(const TrkrDefs::hitsetkey key);
+  ConstIterator lower_bound(const TrkrDefs::hitsetkey key) const;
+  //! first entry with key > given key
+  ConstIterator upper_bound(const TrkrDefs::hitsetkey key) const;
+
   Map m_hitmap;
-  ClassDef(TrkrHitSetContainer, 1)
+  ClassDef(TrkrHitSetContainer, 2)
 };
 
 #endif //TRACKBASE_TRKRHITSETCONTAINER_H
@@ -1,5 +1,7 @@
 #ifdef __CINT__
 
 #pragma link C++ class TrkrHitSetContainer+;
+// version 1 kept the hitsets in a std::map, it is sorted by key like the vector
+#pragma read sourceClass="TrkrHitSetContainer" targetClass="TrkrHitSetContainer" version="[1]" source="std::map<TrkrDefs::hitsetkey, TrkrHitSet*> m_hitmap" target="m_hitmap" code="{ m_hitmap.assign(onfile.m_hitmap.begin(), onfile.m_hitmap.end()); }"
 
 #endif /* __CINT__ */
@@ -13,8 +13,26 @@
 #include <algorithm>
 #include <ostream>               // for operator<<, endl, basic_ostream, bas...
 
+namespace
+{
+  bool KeyLess(const TrkrHitTruthAssoc::Entry& lhs, const TrkrHitTruthAssoc::Entry& rhs)
+  {
+    return lhs.first < rhs.first;
+  }
+  bool EntryKeyLess(const TrkrHitTruthAssoc::Entry& entry, const TrkrDefs::hitsetkey key)
+  {
+    return entry.first < key;
+  }
+  bool KeyEntryLess(const TrkrDefs::hitsetkey key, const TrkrHitTruthAssoc::Entry& entry)
+  {
+    return key < entry.first;
+  }
+}  // namespace
+
+
 TrkrHitTruthAssoc::TrkrHitTruthAssoc()
   : m_map()
+  , m_nsorted(0)
 {
 }
 
@@ -25,7 +43,11 @@ TrkrHitTruthAssoc::~TrkrHitTruthAssoc()
 void
 TrkrHitTruthAssoc::Reset()
 {
-m_map.clear();
+  // clear() keeps the capacity for the next event
+  m_map.clear();
+  m_nsorted = 0;
+  m_pending.clear();
+  m_removed.clear();
 }
 
 void
@@ -52,71 +74,115 @@ void
 TrkrHitTruthAssoc::addAssoc(const TrkrDefs::hitsetkey hitsetkey, const TrkrDefs::hitkey hitkey, const PHG4HitDefs::keytype g4hitkey)
 {
   // the association we want is between TrkrHit and PHG4Hit, but we need to know which TrkrHitSet the TrkrHit is in
-  m_map.insert (std::make_pair(hitsetkey, std::make_pair(hitkey, g4hitkey)));
+  // removals only apply to what was added before them
+  if (!m_removed.empty())
+  {
+    finalize();
+  }
+  if (m_nsorted == m_map.size() && (m_map.empty() || !(hitsetkey < m_map.back().first)))
+  {
+    ++m_nsorted;
+  }
+  m_map.push_back(std::make_pair(hitsetkey, std::make_pair(hitkey, g4hitkey)));
 }
 
 void
 TrkrHitTruthAssoc::findOrAddAssoc(const TrkrDefs::hitsetkey hitsetkey, const TrkrDefs::hitkey hitkey, const PHG4HitDefs::keytype g4hitkey)
 {
   // the association we want is between TrkrHit and PHG4Hit, but we need to know which TrkrHitSet the TrkrHit is in
-  // check if this association already exists
-  // We need all hitsets with this key
-
-  const auto hitsetrange = m_map.equal_range(hitsetkey);
-  if( std::any_of(
-    hitsetrange.first,
-    hitsetrange.second,
-    [&hitkey, &g4hitkey]( const MMap::value_type& pair ) { return pair.second.first == hitkey && pair.second.second == g4hitkey; } ) )
-  { return; }
-
-  // Does not exist, create it
-  const auto assoc = std::make_pair(hitkey, g4hitkey);
-  m_map.insert (hitsetrange.second, std::make_pair(hitsetkey, std::move(assoc)));
+  // the check if this association already exists is done for all of them at once in finalize()
+  if (!m_removed.empty())
+  {
+    finalize();
+  }
+  m_pending.push_back(std::make_pair(hitsetkey, std::make_pair(hitkey, g4hitkey)));
 }
 
 void
 TrkrHitTruthAssoc::removeAssoc(const TrkrDefs::hitsetkey hitsetkey, const TrkrDefs::hitkey hitkey)
 {
   // remove all entries for this TrkrHit and its PHG4Hits, but we need to know which TrkrHitSet the TrkrHit is in
-  // check if this association already exists
-  // We need all hitsets with this key
-
-  std::pair<MMap::iterator, MMap::iterator> hitsetrange = m_map.equal_range(hitsetkey);
-  MMap::iterator mapiter = hitsetrange.first;
-  for (mapiter = hitsetrange.first; mapiter != hitsetrange.second; ++mapiter)
-    {
-      if(mapiter->second.first == hitkey)
+  // the associations added so far are merged first, removals are then collected until the next lookup
+  if (m_nsorted != m_map.size() || !m_pending.empty())
   {
-    // exists, erase it
-    //std::cout << "Association with hitsetkey " << hitsetkey << " hitkey " << hitkey
-    //	    << " g4hitkey " << mapiter->second.second << "  exists, erasing it " << std::endl;
-    m_map.erase (mapiter);
-    return;
+    finalize();
   }
-    }
-
+  m_removed.push_back(std::make_pair(hitsetkey, hitkey));
 }
 
 void
-//TrkrHitTruthAssoc::ConstRange
-TrkrHitTruthAssoc::getG4Hits(const TrkrDefs::hitsetkey hitsetkey, const unsigned int hidx, MMap &temp_map)
+TrkrHitTruthAssoc::finalize()
 {
-  //MMap temp_map;
+  if (m_nsorted > m_map.size())
+  {
+    // content was replaced without Reset(), e.g. by reading a file
+    m_nsorted = 0;
+  }
 
-  std::pair<MMap::iterator, MMap::iterator> hitsetrange = m_map.equal_range(hitsetkey);
-  MMap::iterator mapiter = hitsetrange.first;
+  // appended associations, stable so the order within a hitset is the order they were added in
+  if (m_nsorted != m_map.size())
+  {
+    Iterator tail = m_map.begin() + m_nsorted;
+    if (!std::is_sorted(tail, m_map.end(), KeyLess))
+    {
+      std::stable_sort(tail, m_map.end(), KeyLess);
+    }
+    std::inplace_merge(m_map.begin(), tail, m_map.end(), KeyLess);
+    m_nsorted = m_map.size();
+  }
 
-  for (mapiter = hitsetrange.first; mapiter != hitsetrange.second; ++mapiter)
+  // associations which are added only if they do not exist yet
+  if (!m_pending.empty())
+  {
+    // sorted by hitset key, and by hit and g4hit within a hitset, duplicates are adjacent
+    std::sort(m_pending.begin(), m_pending.end());
+    m_pending.erase(std::unique(m_pending.begin(), m_pending.end()), m_pending.end());
+    const Map::size_type oldsize = m_map.size();
+    for (const auto &pending : m_pending)
     {
-      if(mapiter->second.first == hidx)
+      const auto hitsetrange = std::equal_range(m_map.begin(), m_map.begin() + oldsize, pending, KeyLess);
+      if (std::none_of(hitsetrange.first, hitsetrange.second, [&pending](const Entry &entry) { return entry.second == pending.second; }))
+      {
+        m_map.push_back(pending);
+      }
+    }
+    std::inplace_merge(m_map.begin(), m_map.begin() + oldsize, m_map.end(), KeyLess);
+    m_nsorted = m_map.size();
+    m_pending.clear();
+  }
+
+  // removals
+  if (!m_removed.empty())
   {
-    //std::cout << "   Association with hitsetkey " << hitsetkey << " hitkey " << mapiter->second.first << " g4hitkey " << mapiter->second.second << " exists " << std::endl;
-    // add this to the return object
-    std::pair<TrkrDefs::hitkey, PHG4HitDefs::keytype> assoc = std::make_pair(mapiter->second.first, mapiter->second.second);
-    temp_map.insert (std::make_pair(hitsetkey, assoc));
+    std::sort(m_removed.begin(), m_removed.end());
+    m_map.erase(std::remove_if(m_map.begin(), m_map.end(),
+                               [this](const Entry &entry) { return std::binary_search(m_removed.begin(), m_removed.end(), std::make_pair(entry.first, entry.second.first)); }),
+                m_map.end());
+    m_nsorted = m_map.size();
+    m_removed.clear();
   }
-    }
+}
 
-  //return std::make_pair(temp_map.begin(), temp_map.end());
+void
+TrkrHitTruthAssoc::getG4Hits(const TrkrDefs::hitsetkey hitsetkey, const unsigned int hidx, MMap &temp_map)
+{
+  const ConstRange hitsetrange = getAssocs(hitsetkey);
+  for (ConstIterator mapiter = hitsetrange.first; mapiter != hitsetrange.second; ++mapiter)
+  {
+    if (mapiter->second.first == hidx)
+    {
+      // add this to the return object
+      temp_map.insert(temp_map.end(), *mapiter);
+    }
+  }
 }
 
+TrkrHitTruthAssoc::ConstRange
+TrkrHitTruthAssoc::getAssocs(const TrkrDefs::hitsetkey hitsetkey)
+{
+  finalize();
+  ConstRange retpair;
+  retpair.first = std::lower_bound(m_map.cbegin(), m_map.cend(), hitsetkey, EntryKeyLess);
+  retpair.second = std::upper_bound(retpair.first, m_map.cend(), hitsetkey, KeyEntryLess);
+  return retpair;
+}
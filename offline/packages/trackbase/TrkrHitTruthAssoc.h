@@ -16,21 +16,30 @@
 #include <iostream>              // for cout, ostream
 #include <map>
 #include <utility>               // for pair
+#include <vector>
 
 /**
  * @brief Association object for PHG4Cells contributiong to TrkrHits
  *
- * Association object holding a multimap of PHG4Cells associated with a given TrkrHit
+ * Association object holding the PHG4Hits associated with a given TrkrHit.
+ *
+ * The associations are kept in a contiguous vector of (hitset key, (hit key, g4hit key))
+ * entries sorted by hitset key. While filling, new associations are appended and
+ * removals are collected, finalize() sorts and applies them in one go. Producers
+ * should call finalize() when they are done, the lookups call it otherwise.
  */
 class TrkrHitTruthAssoc : public PHObject
 {
 public:
   //! typedefs for convenience 
-  typedef std::multimap< TrkrDefs::hitsetkey, std::pair<TrkrDefs::hitkey, PHG4HitDefs::keytype> > MMap; 
-  typedef MMap::iterator Iterator;
-  typedef MMap::const_iterator ConstIterator;
+  typedef std::pair<TrkrDefs::hitsetkey, std::pair<TrkrDefs::hitkey, PHG4HitDefs::keytype> > Entry;
+  typedef std::vector<Entry> Map;
+  typedef Map::iterator Iterator;
+  typedef Map::const_iterator ConstIterator;
   typedef std::pair<Iterator, Iterator> Range;
   typedef std::pair<ConstIterator, ConstIterator> ConstRange;
+  //! output of getG4Hits
+  typedef std::multimap< TrkrDefs::hitsetkey, std::pair<TrkrDefs::hitkey, PHG4HitDefs::keytype> > MMap; 
   //! ctor                                                                                                                                                                                                  
   TrkrHitTruthAssoc();
   //! dtor                                                                                                                                                                                                  
@@ -53,11 +62,17 @@ public:
    * @param[in] hset TrkrHitSet key
    * @param[in] hidx TrkrHit index in TrkrHitSet
    * @param[in] ckey Key for assocuated g4hit
+   *
+   * it is not added if the same association exists when finalize() runs
    */
   void findOrAddAssoc(const TrkrDefs::hitsetkey hitsetkey, const TrkrDefs::hitkey hitkey, const PHG4HitDefs::keytype  g4hitkey);
 
+  //! removes all associations of this hit, applied in finalize()
   void removeAssoc(const TrkrDefs::hitsetkey hitsetkey, const TrkrDefs::hitkey hitkey);
 
+  //! sorts the new associations and applies the removals, not thread safe
+  void finalize();
+
   /**
    * @brief Get cell keys associated with desired hit
    * @param[in] hset TrkrHitSet key
@@ -65,9 +80,31 @@ public:
    */
   void  getG4Hits(const TrkrDefs::hitsetkey hitsetkey, const unsigned int hidx, MMap &temp_map);
 
+  //! all associations of a hitset
+  ConstRange getAssocs(const TrkrDefs::hitsetkey hitsetkey);
+
+  //! all associations, ordered by hitsetkey
+  ConstRange getAssocs()
+  {
+    finalize();
+    return std::make_pair(m_map.cbegin(), m_map.cend());
+  }
+
+  //! number of associations
+  unsigned int size() const { return m_map.size(); }
+
 private:
-  MMap m_map;
-  ClassDef(TrkrHitTruthAssoc, 1);
+  //! key of a hit, used for the removals
+  typedef std::pair<TrkrDefs::hitsetkey, TrkrDefs::hitkey> HitKey;
+
+  Map m_map;
+  //! number of leading entries which are sorted
+  Map::size_type m_nsorted; //!
+  //! associations added with findOrAddAssoc, added in finalize() if they are new
+  Map m_pending; //!
+  //! hits whose associations are removed in finalize()
+  std::vector<HitKey> m_removed; //!
+  ClassDef(TrkrHitTruthAssoc, 2);
 
 };
 
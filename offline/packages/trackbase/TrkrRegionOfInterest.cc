@@ -0,0 +1,98 @@
+/**
+ * @file trackbase/TrkrRegionOfInterest.cc
+ * @brief TrkrRegionOfInterest implementation
+ */
+
+#include "TrkrRegionOfInterest.h"
+
+#include <algorithm>
+#include <cmath>
+#include <ostream>  // for operator<<, endl, basic_ostream, ostream
+
+namespace
+{
+  //! |phi1 - phi2| folded into [0, pi]
+  float delta_phi(const float phi1, const float phi2)
+  {
+    float dphi = std::fmod(std::fabs(phi1 - phi2), float(2 * M_PI));
+    return (dphi > M_PI) ? float(2 * M_PI) - dphi : dphi;
+  }
+}  // namespace
+
+TrkrRegionOfInterest::TrkrRegionOfInterest()
+  : m_regions()
+{
+}
+
+void TrkrRegionOfInterest::Reset()
+{
+  m_regions.clear();
+}
+
+void TrkrRegionOfInterest::identify(std::ostream &os) const
+{
+  os << "-----TrkrRegionOfInterest-----" << std::endl;
+  os << "Number of regions: " << m_regions.size() << std::endl;
+  for (const Region &region : m_regions)
+  {
+    os << "   eta " << region.eta_min << " - " << region.eta_max
+       << " phi " << region.phi_center << " +/- " << region.phi_halfwidth
+       << " vertex z " << region.z_min << " - " << region.z_max << std::endl;
+  }
+  os << "------------------------------" << std::endl;
+}
+
+void TrkrRegionOfInterest::addRegion(const float eta, const float phi, const float deta, const float dphi, const float z_min, const float z_max)
+{
+  Region region;
+  region.eta_min = eta - std::fabs(deta);
+  region.eta_max = eta + std::fabs(deta);
+  region.phi_center = phi;
+  region.phi_halfwidth = std::min<float>(std::fabs(dphi), M_PI);
+  region.z_min = std::min(z_min, z_max);
+  region.z_max = std::max(z_min, z_max);
+  region.dzdr_min = std::sinh(region.eta_min);
+  region.dzdr_max = std::sinh(region.eta_max);
+  m_regions.push_back(region);
+}
+
+bool TrkrRegionOfInterest::contains(const float r, const float phi, const float z) const
+{
+  for (const Region &region : m_regions)
+  {
+    if (delta_phi(phi, region.phi_center) > region.phi_halfwidth) continue;
+    // a straight track from z0 reaches z0 + r*sinh(eta) at radius r
+    if (z < region.z_min + r * region.dzdr_min) continue;
+    if (z > region.z_max + r * region.dzdr_max) continue;
+    return true;
+  }
+  return false;
+}
+
+bool TrkrRegionOfInterest::containsDirection(const float eta, const float phi, const float z0) const
+{
+  for (const Region &region : m_regions)
+  {
+    if (delta_phi(phi, region.phi_center) > region.phi_halfwidth) continue;
+    if (eta < region.eta_min || eta > region.eta_max) continue;
+    if (z0 < region.z_min || z0 > region.z_max) continue;
+    return true;
+  }
+  return false;
+}
+
+bool TrkrRegionOfInterest::overlaps(const float r_min, const float r_max,
+                                    const float phi_center, const float phi_halfwidth,
+                                    const float z_min, const float z_max) const
+{
+  for (const Region &region : m_regions)
+  {
+    if (delta_phi(phi_center, region.phi_center) > phi_halfwidth + region.phi_halfwidth) continue;
+    // the z range of the region is linear in r, the extremes are at r_min or r_max
+    const float low = region.z_min + std::min(r_min * region.dzdr_min, r_max * region.dzdr_min);
+    const float high = region.z_max + std::max(r_min * region.dzdr_max, r_max * region.dzdr_max);
+    if (z_max < low || z_min > high) continue;
+    return true;
+  }
+  return false;
+}
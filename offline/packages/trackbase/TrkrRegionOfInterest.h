@@ -0,0 +1,86 @@
+/**
+ * @file trackbase/TrkrRegionOfInterest.h
+ * @brief Regions of interest for a partial tracking reconstruction
+ */
+#ifndef TRACKBASE_TRKRREGIONOFINTEREST_H
+#define TRACKBASE_TRKRREGIONOFINTEREST_H
+
+#include <phool/PHObject.h>
+
+#include <iostream>  // for cout, ostream
+#include <string>
+#include <vector>
+
+/**
+ * @brief Regions of interest for a partial tracking reconstruction
+ *
+ * Each region is a window in (eta, phi) around a seed direction, typically
+ * an EMCal cluster or a calorimeter trigger tile, for tracks coming from a
+ * vertex with z in [z_min, z_max]. The tracking modules only process the
+ * hits, clusters and seeds inside at least one region.
+ *
+ * A missing node (TRKR_ROI) means full reconstruction, an empty list of
+ * regions means there is nothing to reconstruct in this event.
+ *
+ * Tracks are taken as straight lines from the beam line, so the windows
+ * have to be wide enough for the bending of the lowest momentum of interest.
+ */
+class TrkrRegionOfInterest : public PHObject
+{
+ public:
+  struct Region
+  {
+    float eta_min;
+    float eta_max;
+    //! phi window is phi_center +/- phi_halfwidth, no wrapping needed
+    float phi_center;
+    float phi_halfwidth;
+    float z_min;
+    float z_max;
+    //! dz/dr = sinh(eta) at eta_min and eta_max
+    float dzdr_min;
+    float dzdr_max;
+  };
+  typedef std::vector<Region> List;
+  typedef List::const_iterator ConstIterator;
+
+  TrkrRegionOfInterest();
+  virtual ~TrkrRegionOfInterest() {}
+
+  void Reset();
+
+  void identify(std::ostream &os = std::cout) const;
+
+  int isValid() const { return 1; }
+
+  //! node name used by the producers and the tracking modules
+  static std::string GetNodeName() { return "TRKR_ROI"; }
+
+  //! add a region of +/- deta, +/- dphi around (eta, phi), vertex z in [z_min, z_max]
+  void addRegion(const float eta, const float phi, const float deta, const float dphi, const float z_min, const float z_max);
+
+  unsigned int size() const { return m_regions.size(); }
+  bool empty() const { return m_regions.empty(); }
+  const Region &getRegion(const unsigned int i) const { return m_regions[i]; }
+  ConstIterator begin() const { return m_regions.begin(); }
+  ConstIterator end() const { return m_regions.end(); }
+
+  //! true if the point (r, phi, z) is inside at least one region
+  bool contains(const float r, const float phi, const float z) const;
+
+  //! true if a track from the vertex z0 with direction (eta, phi) is inside at least one region
+  bool containsDirection(const float eta, const float phi, const float z0) const;
+
+  //! true if the volume r_min < r < r_max, |phi - phi_center| < phi_halfwidth, z_min < z < z_max
+  //! may intersect a region. Conservative, used to skip whole hitsets
+  bool overlaps(const float r_min, const float r_max,
+                const float phi_center, const float phi_halfwidth,
+                const float z_min, const float z_max) const;
+
+ private:
+  List m_regions;
+
+  ClassDef(TrkrRegionOfInterest, 1);
+};
+
+#endif  // TRACKBASE_TRKRREGIONOFINTEREST_H
@@ -0,0 +1,6 @@
+#ifdef __CINT__
+
+#pragma link C++ class TrkrRegionOfInterest+;
+#pragma link C++ struct TrkrRegionOfInterest::Region+;
+
+#endif /* __CINT__ */
@@ -0,0 +1,194 @@
+#include "SvtxTrackMap_v2.h"
+
+#include "SvtxTrack.h"
+#include "SvtxTrack_v2.h"
+
+#include <phool/PHObject.h>  // for PHObject
+
+#include <climits>
+#include <iterator>     // for reverse_iterator
+#include <map>          // for _Rb_tree_const_iterator, _Rb_tree_iterator
+#include <ostream>      // for operator<<, endl, ostream, basic_ostream, bas...
+#include <utility>      // for pair, make_pair
+
+using namespace std;
+
+
+SvtxTrackMap_v2::SvtxTrackMap_v2()
+  : _blocks()
+  , _map()
+  , _free_slots()
+  , _index_valid(true)
+{
+}
+
+SvtxTrackMap_v2::SvtxTrackMap_v2(const SvtxTrackMap_v2& trackmap)
+  : _blocks()
+  , _map()
+  , _free_slots()
+  , _index_valid(true)
+{
+  *this = trackmap;
+}
+
+SvtxTrackMap_v2& SvtxTrackMap_v2::operator=(const SvtxTrackMap_v2& trackmap)
+{
+  if (this == &trackmap) return *this;
+
+  Reset();
+  reserve(trackmap.size());
+  for (ConstIter iter = trackmap.begin();
+       iter != trackmap.end();
+       ++iter)
+  {
+    SvtxTrack_v2& track = new_slot();
+    track = *static_cast<const SvtxTrack_v2*>(iter->second);
+    _map.insert(make_pair(track.get_id(), &track));
+  }
+  return *this;
+}
+
+void SvtxTrackMap_v2::Reset()
+{
+  // keep the allocated blocks for the next event
+  for (auto& block : _blocks)
+  {
+    block.clear();
+  }
+  _map.clear();
+  _free_slots.clear();
+  _index_valid = true;
+}
+
+void SvtxTrackMap_v2::identify(ostream& os) const
+{
+  os << "SvtxTrackMap_v2: size = " << size() << endl;
+  return;
+}
+
+const SvtxTrack* SvtxTrackMap_v2::get(unsigned int id) const
+{
+  ConstIter iter = track_index().find(id);
+  if (iter == _map.end()) return nullptr;
+  return iter->second;
+}
+
+SvtxTrack* SvtxTrackMap_v2::get(unsigned int id)
+{
+  Iter iter = track_index().find(id);
+  if (iter == _map.end()) return nullptr;
+  return iter->second;
+}
+
+SvtxTrack* SvtxTrackMap_v2::insert(const SvtxTrack* track)
+{
+  TrackMap& index_map = track_index();
+
+  unsigned int index = 0;
+  if (!index_map.empty()) index = index_map.rbegin()->first + 1;
+
+  SvtxTrack_v2& slot = new_slot();
+  const SvtxTrack_v2* track_v2 = dynamic_cast<const SvtxTrack_v2*>(track);
+  if (track_v2)
+  {
+    slot = *track_v2;
+  }
+  else
+  {
+    slot = SvtxTrack_v2(*track);
+  }
+  slot.set_id(index);
+
+  index_map.insert(make_pair(index, &slot));
+  return &slot;
+}
+
+size_t SvtxTrackMap_v2::erase(unsigned int idkey)
+{
+  TrackMap& index_map = track_index();
+  Iter iter = index_map.find(idkey);
+  if (iter == index_map.end()) return 0;
+
+  const SvtxTrack* track = iter->second;
+  for (unsigned int iblock = 0; iblock < _blocks.size(); ++iblock)
+  {
+    std::vector<SvtxTrack_v2>& block = _blocks[iblock];
+    if (block.empty() || track < &block.front() || track > &block.back()) continue;
+
+    const unsigned int pos = static_cast<const SvtxTrack_v2*>(track) - &block.front();
+    block[pos] = SvtxTrack_v2();
+    _free_slots.push_back(make_pair(iblock, pos));
+    break;
+  }
+
+  index_map.erase(iter);
+  return 1;
+}
+
+void SvtxTrackMap_v2::reserve(size_t ntracks)
+{
+  size_t capacity = 0;
+  for (const auto& block : _blocks)
+  {
+    capacity += block.capacity() - block.size();
+  }
+  capacity += _free_slots.size();
+
+  while (capacity < ntracks)
+  {
+    _blocks.push_back(std::vector<SvtxTrack_v2>());
+    _blocks.back().reserve(kBlockSize);
+    capacity += kBlockSize;
+  }
+}
+
+SvtxTrack_v2& SvtxTrackMap_v2::new_slot()
+{
+  if (!_free_slots.empty())
+  {
+    Slot slot = _free_slots.back();
+    _free_slots.pop_back();
+    return _blocks[slot.first][slot.second];
+  }
+
+  // tracks must not move, only fill blocks up to their capacity
+  for (auto& block : _blocks)
+  {
+    if (block.size() < block.capacity())
+    {
+      block.push_back(SvtxTrack_v2());
+      return block.back();
+    }
+  }
+
+  _blocks.push_back(std::vector<SvtxTrack_v2>());
+  _blocks.back().reserve(kBlockSize);
+  _blocks.back().push_back(SvtxTrack_v2());
+  return _blocks.back().back();
+}
+
+SvtxTrackMap::TrackMap& SvtxTrackMap_v2::track_index() const
+{
+  if (!_index_valid)
+  {
+    _map.clear();
+    _free_slots.clear();
+    for (unsigned int iblock = 0; iblock < _blocks.size(); ++iblock)
+    {
+      const std::vector<SvtxTrack_v2>& block = _blocks[iblock];
+      for (unsigned int pos = 0; pos < block.size(); ++pos)
+      {
+        if (block[pos].get_id() == UINT_MAX)
+        {
+          _free_slots.push_back(make_pair(iblock, pos));
+        }
+        else
+        {
+          _map.insert(make_pair(block[pos].get_id(), const_cast<SvtxTrack_v2*>(&block[pos])));
+        }
+      }
+    }
+    _index_valid = true;
+  }
+  return _map;
+}
@@ -0,0 +1,84 @@
+#ifndef TRACKBASEHISTORIC_SVTXTRACKMAPV2_H
+#define TRACKBASEHISTORIC_SVTXTRACKMAPV2_H
+
+#include "SvtxTrack.h"
+#include "SvtxTrackMap.h"
+#include "SvtxTrack_v2.h"
+
+#include <cstddef>        // for size_t
+#include <iostream>        // for cout, ostream
+#include <utility>         // for pair
+#include <vector>
+
+class PHObject;
+
+/*!
+ * \brief SvtxTrackMap with flat track storage
+ *
+ * Same interface as SvtxTrackMap_v1. The tracks are SvtxTrack_v2 values in
+ * blocks of kBlockSize which are allocated once and never grow, so a track
+ * never moves and the pointers in the map stay valid until it is erased.
+ * Inserting any other SvtxTrack converts it to SvtxTrack_v2.
+ * An erased track leaves an empty slot which is reused by the next insert.
+ * The id => track map is a transient index, rebuilt after reading.
+ * Reset() keeps the blocks, use reserve() to allocate them up front.
+ */
+class SvtxTrackMap_v2 : public SvtxTrackMap
+{
+ public:
+  SvtxTrackMap_v2();
+  SvtxTrackMap_v2(const SvtxTrackMap_v2& trackmap);
+  SvtxTrackMap_v2& operator=(const SvtxTrackMap_v2& trackmap);
+  virtual ~SvtxTrackMap_v2() {}
+
+  void identify(std::ostream& os = std::cout) const;
+  void Reset();
+  int isValid() const { return 1; }
+  PHObject* CloneMe() const { return new SvtxTrackMap_v2(*this); }
+
+  bool empty() const { return track_index().empty(); }
+  size_t size() const { return track_index().size(); }
+  size_t count(unsigned int idkey) const { return track_index().count(idkey); }
+  void clear() { Reset(); }
+
+  const SvtxTrack* get(unsigned int idkey) const;
+  SvtxTrack* get(unsigned int idkey);
+  SvtxTrack* insert(const SvtxTrack* track);
+  size_t erase(unsigned int idkey);
+
+  ConstIter begin() const { return track_index().begin(); }
+  ConstIter find(unsigned int idkey) const { return track_index().find(idkey); }
+  ConstIter end() const { return track_index().end(); }
+
+  Iter begin() { return track_index().begin(); }
+  Iter find(unsigned int idkey) { return track_index().find(idkey); }
+  Iter end() { return track_index().end(); }
+
+  //! allocate storage for ntracks tracks
+  void reserve(size_t ntracks);
+
+  //! number of tracks per storage block
+  static const unsigned int kBlockSize = 256;
+
+ private:
+  //! (block, position) of a track slot
+  typedef std::pair<unsigned int, unsigned int> Slot;
+
+  //! a slot for a new track, reusing erased ones first
+  SvtxTrack_v2& new_slot();
+
+  //! the map of track pointers, rebuilt if it is not valid
+  TrackMap& track_index() const;
+
+  //! track storage. Empty slots have id UINT_MAX
+  std::vector<std::vector<SvtxTrack_v2> > _blocks;
+
+  //! id => track in _blocks
+  mutable TrackMap _map;  //!
+  mutable std::vector<Slot> _free_slots;  //!
+  mutable bool _index_valid;  //!
+
+  ClassDef(SvtxTrackMap_v2, 1);
+};
+
+#endif
@@ -0,0 +1,10 @@
+#ifdef __CINT__
+
+#pragma link C++ class SvtxTrackMap_v2 + ;
+#pragma link C++ class std::vector < SvtxTrack_v2 > + ;
+#pragma link C++ class std::vector < std::vector < SvtxTrack_v2 > > + ;
+
+// the track index points into _blocks, rebuild it after reading
+#pragma read sourceClass="SvtxTrackMap_v2" targetClass="SvtxTrackMap_v2" version="[1-]" source="" target="_index_valid" code="{ _index_valid = false; }"
+
+#endif /* __CINT__ */
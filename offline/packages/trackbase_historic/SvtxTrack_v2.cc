@@ -0,0 +1,294 @@
+#include "SvtxTrack_v2.h"
+#include "SvtxTrackState.h"
+#include "SvtxTrackState_v1.h"
+
+#include <trackbase/TrkrDefs.h>  // for cluskey
+
+#include <phool/PHObject.h>      // for PHObject
+
+#include <algorithm>
+#include <climits>
+#include <map>
+#include <string>
+#include <vector>                // for vector
+
+using namespace std;
+
+namespace
+{
+  // order states by path length
+  bool state_before(const SvtxTrackState_v1& state, float pathlength)
+  {
+    return state.get_pathlength() < pathlength;
+  }
+}
+
+SvtxTrack_v2::SvtxTrack_v2()
+  : _track_id(UINT_MAX)
+  , _vertex_id(UINT_MAX)
+  , _is_positive_charge(false)
+  , _chisq(NAN)
+  , _ndf(0)
+  , _dca(NAN)
+  , _dca_error(NAN)
+  , _dca2d(NAN)
+  , _dca2d_error(NAN)
+  , _dca3d_xy(NAN)
+  , _dca3d_xy_error(NAN)
+  , _dca3d_z(NAN)
+  , _dca3d_z_error(NAN)
+  , _state_list()
+  , _states()
+  , _state_index_valid(false)
+  , _cluster_ids()
+  , _cluster_keys()
+{
+  // always include the pca point
+  _state_list.push_back(SvtxTrackState_v1(0.0));
+
+  for (unsigned int i = 0; i < kNCalLayers; ++i)
+  {
+    _cal_dphi[i] = NAN;
+    _cal_deta[i] = NAN;
+    _cal_energy_3x3[i] = NAN;
+    _cal_energy_5x5[i] = NAN;
+    _cal_cluster_id[i] = -9999;
+    _cal_cluster_key[i] = -9999;
+    _cal_cluster_e[i] = NAN;
+  }
+}
+
+SvtxTrack_v2::SvtxTrack_v2(const SvtxTrack_v2& track)
+  : SvtxTrack()
+  , _state_index_valid(false)
+{
+  *this = track;
+}
+
+SvtxTrack_v2::SvtxTrack_v2(const SvtxTrack& track)
+  : SvtxTrack_v2()
+{
+  _track_id = track.get_id();
+  _vertex_id = track.get_vertex_id();
+  _is_positive_charge = track.get_positive_charge();
+  _chisq = track.get_chisq();
+  _ndf = track.get_ndf();
+  _dca = track.get_dca();
+  _dca_error = track.get_dca_error();
+  _dca2d = track.get_dca2d();
+  _dca2d_error = track.get_dca2d_error();
+  _dca3d_xy = track.get_dca3d_xy();
+  _dca3d_xy_error = track.get_dca3d_xy_error();
+  _dca3d_z = track.get_dca3d_z();
+  _dca3d_z_error = track.get_dca3d_z_error();
+
+  clear_states();
+  for (ConstStateIter iter = track.begin_states();
+       iter != track.end_states();
+       ++iter)
+  {
+    insert_state(iter->second);
+  }
+
+  _cluster_ids.insert(track.begin_clusters(), track.end_clusters());
+  _cluster_keys.insert(track.begin_cluster_keys(), track.end_cluster_keys());
+
+  for (unsigned int i = 0; i < kNCalLayers; ++i)
+  {
+    const CAL_LAYER layer = static_cast<CAL_LAYER>(i);
+    _cal_dphi[i] = track.get_cal_dphi(layer);
+    _cal_deta[i] = track.get_cal_deta(layer);
+    _cal_energy_3x3[i] = track.get_cal_energy_3x3(layer);
+    _cal_energy_5x5[i] = track.get_cal_energy_5x5(layer);
+    _cal_cluster_id[i] = track.get_cal_cluster_id(layer);
+    _cal_cluster_key[i] = track.get_cal_cluster_key(layer);
+    _cal_cluster_e[i] = track.get_cal_cluster_e(layer);
+  }
+}
+
+SvtxTrack_v2& SvtxTrack_v2::operator=(const SvtxTrack_v2& track)
+{
+  if (this == &track) return *this;
+
+  _track_id = track._track_id;
+  _vertex_id = track._vertex_id;
+  _is_positive_charge = track._is_positive_charge;
+  _chisq = track._chisq;
+  _ndf = track._ndf;
+  _dca = track._dca;
+  _dca_error = track._dca_error;
+  _dca2d = track._dca2d;
+  _dca2d_error = track._dca2d_error;
+  _dca3d_xy = track._dca3d_xy;
+  _dca3d_xy_error = track._dca3d_xy_error;
+  _dca3d_z = track._dca3d_z;
+  _dca3d_z_error = track._dca3d_z_error;
+
+  // the states are values, the index points into our own copy
+  _state_list = track._state_list;
+  _state_index_valid = false;
+
+  _cluster_ids = track._cluster_ids;
+  _cluster_keys = track._cluster_keys;
+
+  std::copy(track._cal_dphi, track._cal_dphi + kNCalLayers, _cal_dphi);
+  std::copy(track._cal_deta, track._cal_deta + kNCalLayers, _cal_deta);
+  std::copy(track._cal_energy_3x3, track._cal_energy_3x3 + kNCalLayers, _cal_energy_3x3);
+  std::copy(track._cal_energy_5x5, track._cal_energy_5x5 + kNCalLayers, _cal_energy_5x5);
+  std::copy(track._cal_cluster_id, track._cal_cluster_id + kNCalLayers, _cal_cluster_id);
+  std::copy(track._cal_cluster_key, track._cal_cluster_key + kNCalLayers, _cal_cluster_key);
+  std::copy(track._cal_cluster_e, track._cal_cluster_e + kNCalLayers, _cal_cluster_e);
+
+  return *this;
+}
+
+void SvtxTrack_v2::identify(std::ostream& os) const
+{
+  os << "SvtxTrack_v2 Object ";
+  os << "id: " << get_id() << " ";
+  os << "vertex id: " << get_vertex_id() << " ";
+  os << "charge: " << get_charge() << " ";
+  os << "chisq: " << get_chisq() << " ndf:" << get_ndf() << " ";
+  os << endl;
+
+  os << "(px,py,pz) = ("
+     << get_px() << ","
+     << get_py() << ","
+     << get_pz() << ")" << endl;
+
+  os << "(x,y,z) = (" << get_x() << "," << get_y() << "," << get_z() << ")" << endl;
+
+  if ( _cluster_ids.size() > 0 || _cluster_keys.size() > 0 )
+  {
+    os << "list of cluster IDs ";
+    for (SvtxTrack::ConstClusterIter iter = begin_clusters();
+         iter != end_clusters();
+         ++iter)
+    {
+      unsigned int cluster_id = *iter;
+      os << cluster_id << " ";
+    }
+
+    os << "list of cluster keys ";
+    for (SvtxTrack::ConstClusterKeyIter iter = begin_cluster_keys();
+         iter != end_cluster_keys();
+         ++iter)
+    {
+      TrkrDefs::cluskey cluster_key = *iter;
+      os << cluster_key << " ";
+    }
+  }
+  else
+    os << " track has no clusters " << endl;
+
+  os << endl;
+
+  return;
+}
+
+void SvtxTrack_v2::clear_states()
+{
+  _state_list.clear();
+  _state_index_valid = false;
+}
+
+size_t SvtxTrack_v2::find_state_index(float pathlength) const
+{
+  auto iter = std::lower_bound(_state_list.begin(), _state_list.end(), pathlength, state_before);
+  if (iter == _state_list.end() || iter->get_pathlength() != pathlength) return _state_list.size();
+  return iter - _state_list.begin();
+}
+
+const SvtxTrackState* SvtxTrack_v2::get_state(float pathlength) const
+{
+  const size_t index = find_state_index(pathlength);
+  if (index == _state_list.size()) return nullptr;
+  return &_state_list[index];
+}
+
+SvtxTrackState* SvtxTrack_v2::get_state(float pathlength)
+{
+  const size_t index = find_state_index(pathlength);
+  if (index == _state_list.size()) return nullptr;
+  return &_state_list[index];
+}
+
+SvtxTrackState* SvtxTrack_v2::insert_state(const SvtxTrackState* state)
+{
+  const float pathlength = state->get_pathlength();
+  auto iter = std::lower_bound(_state_list.begin(), _state_list.end(), pathlength, state_before);
+
+  // like the map in SvtxTrack_v1, an existing state is kept
+  if (iter != _state_list.end() && iter->get_pathlength() == pathlength) return &*iter;
+
+  SvtxTrackState_v1 copy(pathlength);
+  const SvtxTrackState_v1* state_v1 = dynamic_cast<const SvtxTrackState_v1*>(state);
+  if (state_v1)
+  {
+    copy = *state_v1;
+  }
+  else
+  {
+    copy.set_x(state->get_x());
+    copy.set_y(state->get_y());
+    copy.set_z(state->get_z());
+    copy.set_px(state->get_px());
+    copy.set_py(state->get_py());
+    copy.set_pz(state->get_pz());
+    for (unsigned int i = 0; i < 6; ++i)
+    {
+      for (unsigned int j = i; j < 6; ++j)
+      {
+        copy.set_error(i, j, state->get_error(i, j));
+      }
+    }
+    std::string name = const_cast<SvtxTrackState*>(state)->get_name();
+    copy.set_name(name);
+  }
+
+  iter = _state_list.insert(iter, copy);
+  _state_index_valid = false;
+  return &*iter;
+}
+
+size_t SvtxTrack_v2::erase_state(float pathlength)
+{
+  const size_t index = find_state_index(pathlength);
+  if (index == _state_list.size()) return _state_list.size();
+
+  _state_list.erase(_state_list.begin() + index);
+  _state_index_valid = false;
+  return _state_list.size();
+}
+
+SvtxTrackState_v1& SvtxTrack_v2::pca_state()
+{
+  const size_t index = find_state_index(0.0);
+  if (index < _state_list.size()) return _state_list[index];
+
+  SvtxTrackState_v1 state(0.0);
+  return *static_cast<SvtxTrackState_v1*>(insert_state(&state));
+}
+
+const SvtxTrackState_v1& SvtxTrack_v2::pca_state() const
+{
+  static const SvtxTrackState_v1 missing_state(0.0);
+
+  const size_t index = find_state_index(0.0);
+  if (index < _state_list.size()) return _state_list[index];
+  return missing_state;
+}
+
+SvtxTrack::StateMap& SvtxTrack_v2::state_index() const
+{
+  if (!_state_index_valid)
+  {
+    _states.clear();
+    for (const SvtxTrackState_v1& state : _state_list)
+    {
+      _states.insert(_states.end(), make_pair(state.get_pathlength(), const_cast<SvtxTrackState_v1*>(&state)));
+    }
+    _state_index_valid = true;
+  }
+  return _states;
+}
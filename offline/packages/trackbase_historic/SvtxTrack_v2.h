@@ -0,0 +1,255 @@
+#ifndef TRACKBASEHISTORIC_SVTXTRACKV2_H
+#define TRACKBASEHISTORIC_SVTXTRACKV2_H
+
+#include "SvtxTrack.h"
+#include "SvtxTrackState.h"
+#include "SvtxTrackState_v1.h"
+
+#include <trackbase/TrkrDefs.h>
+
+#include <cmath>
+#include <cstddef>              // for size_t
+#include <iostream>
+#include <map>
+#include <vector>
+
+class PHObject;
+
+/*!
+ * \brief SvtxTrack with flat storage
+ *
+ * Same interface as SvtxTrack_v1. The states are kept by value in one
+ * vector ordered by path length, the state map returned by begin_states()
+ * etc. is a transient index into it which is rebuilt when needed.
+ * The calorimeter projections are fixed arrays, one entry per CAL_LAYER.
+ *
+ * Pointers to states stay valid until the next insert_state or erase_state.
+ */
+class SvtxTrack_v2 : public SvtxTrack
+{
+ public:
+  SvtxTrack_v2();
+  SvtxTrack_v2(const SvtxTrack_v2& track);
+  //! copy any SvtxTrack through the base class interface
+  explicit SvtxTrack_v2(const SvtxTrack& track);
+  SvtxTrack_v2& operator=(const SvtxTrack_v2& track);
+  virtual ~SvtxTrack_v2() {}
+
+  // The "standard PHObject response" functions...
+  void identify(std::ostream& os = std::cout) const;
+  void Reset() { *this = SvtxTrack_v2(); }
+  int isValid() const { return 1; }
+  PHObject* CloneMe() const { return new SvtxTrack_v2(*this); }
+
+  //
+  // basic track information ---------------------------------------------------
+  //
+
+  unsigned int get_id() const { return _track_id; }
+  void set_id(unsigned int id) { _track_id = id; }
+
+  unsigned int get_vertex_id() const { return _vertex_id; }
+  void set_vertex_id(unsigned int id) { _vertex_id = id; }
+
+  bool get_positive_charge() const { return _is_positive_charge; }
+  void set_positive_charge(bool ispos) { _is_positive_charge = ispos; }
+
+  int get_charge() const { return (get_positive_charge()) ? 1 : -1; }
+  void set_charge(int charge) { (charge > 0) ? set_positive_charge(true) : set_positive_charge(false); }
+
+  float get_chisq() const { return _chisq; }
+  void set_chisq(float chisq) { _chisq = chisq; }
+
+  unsigned int get_ndf() const { return _ndf; }
+  void set_ndf(int ndf) { _ndf = ndf; }
+
+  float get_quality() const { return (_ndf != 0) ? _chisq / _ndf : NAN; }
+
+  float get_dca() const { return _dca; }
+  void set_dca(float dca) { _dca = dca; }
+
+  float get_dca_error() const { return _dca_error; }
+  void set_dca_error(float dca_error) { _dca_error = dca_error; }
+
+  float get_dca2d() const { return _dca2d; }
+  void set_dca2d(float dca2d) { _dca2d = dca2d; }
+
+  float get_dca2d_error() const { return _dca2d_error; }
+  void set_dca2d_error(float error) { _dca2d_error = error; }
+
+  float get_dca3d_xy() const { return _dca3d_xy; }
+  void set_dca3d_xy(float dcaxy) { _dca3d_xy = dcaxy; }
+
+  float get_dca3d_xy_error() const { return _dca3d_xy_error; }
+  void set_dca3d_xy_error(float error) { _dca3d_xy_error = error; }
+
+  float get_dca3d_z() const { return _dca3d_z; }
+  void set_dca3d_z(float dcaz) { _dca3d_z = dcaz; }
+
+  float get_dca3d_z_error() const { return _dca3d_z_error; }
+  void set_dca3d_z_error(float error) { _dca3d_z_error = error; }
+
+  float get_x() const { return pca_state().get_x(); }
+  void set_x(float x) { pca_state().set_x(x); }
+
+  float get_y() const { return pca_state().get_y(); }
+  void set_y(float y) { pca_state().set_y(y); }
+
+  float get_z() const { return pca_state().get_z(); }
+  void set_z(float z) { pca_state().set_z(z); }
+
+  float get_pos(unsigned int i) const { return pca_state().get_pos(i); }
+
+  float get_px() const { return pca_state().get_px(); }
+  void set_px(float px) { pca_state().set_px(px); }
+
+  float get_py() const { return pca_state().get_py(); }
+  void set_py(float py) { pca_state().set_py(py); }
+
+  float get_pz() const { return pca_state().get_pz(); }
+  void set_pz(float pz) { pca_state().set_pz(pz); }
+
+  float get_mom(unsigned int i) const { return pca_state().get_mom(i); }
+
+  float get_p() const { return sqrt(pow(get_px(), 2) + pow(get_py(), 2) + pow(get_pz(), 2)); }
+  float get_pt() const { return sqrt(pow(get_px(), 2) + pow(get_py(), 2)); }
+  float get_eta() const { return asinh(get_pz() / get_pt()); }
+  float get_phi() const { return atan2(get_py(), get_px()); }
+
+  float get_error(int i, int j) const { return pca_state().get_error(i, j); }
+  void set_error(int i, int j, float value) { return pca_state().set_error(i, j, value); }
+
+  //
+  // state methods -------------------------------------------------------------
+  //
+  bool empty_states() const { return _state_list.empty(); }
+  size_t size_states() const { return _state_list.size(); }
+  size_t count_states(float pathlength) const { return find_state_index(pathlength) < _state_list.size() ? 1 : 0; }
+  void clear_states();
+
+  const SvtxTrackState* get_state(float pathlength) const;
+  SvtxTrackState* get_state(float pathlength);
+  SvtxTrackState* insert_state(const SvtxTrackState* state);
+  size_t erase_state(float pathlength);
+
+  ConstStateIter begin_states() const { return state_index().begin(); }
+  ConstStateIter find_state(float pathlength) const { return state_index().find(pathlength); }
+  ConstStateIter end_states() const { return state_index().end(); }
+
+  StateIter begin_states() { return state_index().begin(); }
+  StateIter find_state(float pathlength) { return state_index().find(pathlength); }
+  StateIter end_states() { return state_index().end(); }
+
+  //
+  // associated cluster ids methods --------------------------------------------
+  //
+
+  // needed by old tracking
+  void clear_clusters() { _cluster_ids.clear(); }
+  bool empty_clusters() const { return _cluster_ids.empty(); }
+  size_t size_clusters() const { return _cluster_ids.size(); }
+
+  void insert_cluster(unsigned int clusterid) { _cluster_ids.insert(clusterid); }
+  size_t erase_cluster(unsigned int clusterid) { return _cluster_ids.erase(clusterid); }
+  ConstClusterIter begin_clusters() const { return _cluster_ids.begin(); }
+  ConstClusterIter find_cluster(unsigned int clusterid) const { return _cluster_ids.find(clusterid); }
+  ConstClusterIter end_clusters() const { return _cluster_ids.end(); }
+  ClusterIter find_cluster(unsigned int clusterid) { return _cluster_ids.find(clusterid); }
+  ClusterIter begin_clusters() { return _cluster_ids.begin(); }
+  ClusterIter end_clusters() { return _cluster_ids.end(); }
+
+  // needed by new tracking
+  void clear_cluster_keys() { _cluster_keys.clear(); }
+  bool empty_cluster_keys() const { return _cluster_keys.empty(); }
+  size_t size_cluster_keys() const { return _cluster_keys.size(); }
+
+  void insert_cluster_key(TrkrDefs::cluskey clusterid) { _cluster_keys.insert(clusterid); }
+  size_t erase_cluster_key(TrkrDefs::cluskey clusterid) { return _cluster_keys.erase(clusterid); }
+  ConstClusterKeyIter find_cluster_key(TrkrDefs::cluskey clusterid) const { return _cluster_keys.find(clusterid); }
+  ConstClusterKeyIter begin_cluster_keys() const { return _cluster_keys.begin(); }
+  ConstClusterKeyIter end_cluster_keys() const { return _cluster_keys.end(); }
+  ClusterKeyIter find_cluster_key(TrkrDefs::cluskey clusterid) { return _cluster_keys.find(clusterid); }
+  ClusterKeyIter begin_cluster_keys() { return _cluster_keys.begin(); }
+  ClusterKeyIter end_cluster_keys()  { return _cluster_keys.end(); }
+
+  //
+  // calo projection methods ---------------------------------------------------
+  //
+  float get_cal_dphi(CAL_LAYER layer) const { return valid_cal_layer(layer) ? _cal_dphi[layer] : NAN; }
+  void set_cal_dphi(CAL_LAYER layer, float dphi) { if (valid_cal_layer(layer)) _cal_dphi[layer] = dphi; }
+
+  float get_cal_deta(CAL_LAYER layer) const { return valid_cal_layer(layer) ? _cal_deta[layer] : NAN; }
+  void set_cal_deta(CAL_LAYER layer, float deta) { if (valid_cal_layer(layer)) _cal_deta[layer] = deta; }
+
+  float get_cal_energy_3x3(CAL_LAYER layer) const { return valid_cal_layer(layer) ? _cal_energy_3x3[layer] : NAN; }
+  void set_cal_energy_3x3(CAL_LAYER layer, float energy_3x3) { if (valid_cal_layer(layer)) _cal_energy_3x3[layer] = energy_3x3; }
+
+  float get_cal_energy_5x5(CAL_LAYER layer) const { return valid_cal_layer(layer) ? _cal_energy_5x5[layer] : NAN; }
+  void set_cal_energy_5x5(CAL_LAYER layer, float energy_5x5) { if (valid_cal_layer(layer)) _cal_energy_5x5[layer] = energy_5x5; }
+
+  unsigned int get_cal_cluster_id(CAL_LAYER layer) const { return valid_cal_layer(layer) ? _cal_cluster_id[layer] : -9999; }
+  void set_cal_cluster_id(CAL_LAYER layer, unsigned int id) { if (valid_cal_layer(layer)) _cal_cluster_id[layer] = id; }
+
+  TrkrDefs::cluskey get_cal_cluster_key(CAL_LAYER layer) const { return valid_cal_layer(layer) ? _cal_cluster_key[layer] : -9999; }
+  void set_cal_cluster_key(CAL_LAYER layer, TrkrDefs::cluskey id) { if (valid_cal_layer(layer)) _cal_cluster_key[layer] = id; }
+
+  float get_cal_cluster_e(CAL_LAYER layer) const { return valid_cal_layer(layer) ? _cal_cluster_e[layer] : NAN; }
+  void set_cal_cluster_e(CAL_LAYER layer, float e) { if (valid_cal_layer(layer)) _cal_cluster_e[layer] = e; }
+
+  //! number of CAL_LAYER entries
+  static const unsigned int kNCalLayers = 4;
+
+ private:
+  static bool valid_cal_layer(CAL_LAYER layer) { return (unsigned int) layer < kNCalLayers; }
+
+  //! position of the state with this path length in _state_list, _state_list.size() if there is none
+  size_t find_state_index(float pathlength) const;
+
+  //! state at path length 0, created if missing
+  SvtxTrackState_v1& pca_state();
+  const SvtxTrackState_v1& pca_state() const;
+
+  //! the map of state pointers, rebuilt if _state_list changed
+  StateMap& state_index() const;
+
+  // track information
+  unsigned int _track_id;
+  unsigned int _vertex_id;
+  bool _is_positive_charge;
+  float _chisq;
+  unsigned int _ndf;
+
+  // extended track information (non-primary tracks only)
+  float _dca;
+  float _dca_error;
+  float _dca2d;
+  float _dca2d_error;
+  float _dca3d_xy;
+  float _dca3d_xy_error;
+  float _dca3d_z;
+  float _dca3d_z_error;
+
+  // track state information, ordered by path length
+  std::vector<SvtxTrackState_v1> _state_list;
+
+  //! path length => state in _state_list
+  mutable StateMap _states;  //!
+  mutable bool _state_index_valid;  //!
+
+  // cluster contents
+  ClusterSet _cluster_ids;
+  ClusterKeySet _cluster_keys;
+
+  // calorimeter matches
+  float _cal_dphi[kNCalLayers];
+  float _cal_deta[kNCalLayers];
+  float _cal_energy_3x3[kNCalLayers];
+  float _cal_energy_5x5[kNCalLayers];
+  int _cal_cluster_id[kNCalLayers];
+  TrkrDefs::cluskey _cal_cluster_key[kNCalLayers];
+  float _cal_cluster_e[kNCalLayers];
+
+  ClassDef(SvtxTrack_v2, 1)
+};
+
+#endif
@@ -0,0 +1,9 @@
+#ifdef __CINT__
+
+#pragma link C++ class SvtxTrack_v2 + ;
+#pragma link C++ class std::vector < SvtxTrackState_v1 > + ;
+
+// the state index points into _state_list, rebuild it after reading
+#pragma read sourceClass="SvtxTrack_v2" targetClass="SvtxTrack_v2" version="[1-]" source="" target="_state_index_valid" code="{ _state_index_valid = false; }"
+
+#endif /* __CINT__ */
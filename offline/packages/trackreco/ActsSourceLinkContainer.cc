@@ -0,0 +1,64 @@
+#include "ActsSourceLinkContainer.h"
+
+#include <Acts/Surfaces/Surface.hpp>
+
+#include <algorithm>
+#include <cassert>
+
+void ActsSourceLinkContainer::clear()
+{
+  m_sourceLinks.clear();
+  m_position.clear();
+  m_clusKeys.clear();
+}
+
+void ActsSourceLinkContainer::reserve(const size_t n)
+{
+  m_sourceLinks.reserve(n);
+  m_position.reserve(n);
+  m_clusKeys.reserve(n);
+}
+
+void ActsSourceLinkContainer::add(const TrkrDefs::cluskey clusKey,
+                                  const SourceLink& sourceLink)
+{
+  assert(sourceLink.hitID() == m_sourceLinks.size());
+  assert(m_clusKeys.empty() || m_clusKeys.back() < clusKey);
+  m_sourceLinks.push_back(sourceLink);
+  m_clusKeys.push_back(clusKey);
+}
+
+void ActsSourceLinkContainer::finalize()
+{
+  /// hit ids are in order before the sort, so the stable sort keeps them
+  /// in order on each surface
+  std::stable_sort(m_sourceLinks.begin(), m_sourceLinks.end(),
+                   [](const SourceLink& lhs, const SourceLink& rhs)
+                   {
+                     return lhs.referenceSurface().geoID().value() <
+                       rhs.referenceSurface().geoID().value();
+                   });
+
+  m_position.resize(m_sourceLinks.size());
+  for (unsigned int i = 0; i < m_sourceLinks.size(); ++i)
+  {
+    m_position[m_sourceLinks[i].hitID()] = i;
+  }
+}
+
+const SourceLink* ActsSourceLinkContainer::findHitId(const unsigned int hitId) const
+{
+  if (hitId >= m_position.size())
+    return nullptr;
+  return &m_sourceLinks[m_position[hitId]];
+}
+
+bool ActsSourceLinkContainer::getHitId(const TrkrDefs::cluskey clusKey,
+                                       unsigned int& hitId) const
+{
+  const auto iter = std::lower_bound(m_clusKeys.begin(), m_clusKeys.end(), clusKey);
+  if (iter == m_clusKeys.end() || *iter != clusKey)
+    return false;
+  hitId = iter - m_clusKeys.begin();
+  return true;
+}
@@ -0,0 +1,64 @@
+#ifndef TRACKRECO_ACTSSOURCELINKCONTAINER_H
+#define TRACKRECO_ACTSSOURCELINKCONTAINER_H
+
+#include <trackbase/TrkrDefs.h>
+
+#include <ACTFW/EventData/TrkrClusterSourceLink.hpp>
+
+#include <vector>
+
+using SourceLink = FW::Data::TrkrClusterSourceLink;
+
+/**
+ * The Acts source links of one event, made by PHActsSourceLinks and read
+ * in place by the Acts modules (node TrkrClusterSourceLinkContainer).
+ *
+ * The hit id of a source link is the order in which it was added, i.e.
+ * increasing with the cluster key. After finalize() the source links are
+ * stored flat and grouped by surface (geometry id, then hit id), which is
+ * the vector handed to the track finder. Lookups by hit id and cluster key
+ * go through plain index arrays.
+ */
+class ActsSourceLinkContainer
+{
+ public:
+  ActsSourceLinkContainer() {}
+  ~ActsSourceLinkContainer() {}
+
+  /// Clears the event, keeping the capacity
+  void clear();
+  void reserve(const size_t n);
+
+  /// Adds the source link of a cluster, its hit id must be size()
+  void add(const TrkrDefs::cluskey clusKey, const SourceLink& sourceLink);
+
+  /// Sorts the source links by surface, call once all are added
+  void finalize();
+
+  size_t size() const { return m_sourceLinks.size(); }
+  bool empty() const { return m_sourceLinks.empty(); }
+
+  /// All source links grouped by surface
+  const std::vector<SourceLink>& getSourceLinks() const { return m_sourceLinks; }
+
+  /// Source link with this hit id, nullptr if there is none
+  const SourceLink* findHitId(const unsigned int hitId) const;
+
+  /// Hit id of the source link of a cluster, false if there is none
+  bool getHitId(const TrkrDefs::cluskey clusKey, unsigned int& hitId) const;
+
+  /// Cluster of a hit id
+  TrkrDefs::cluskey getClusKey(const unsigned int hitId) const { return m_clusKeys[hitId]; }
+
+ private:
+  /// Source links, grouped by surface after finalize()
+  std::vector<SourceLink> m_sourceLinks;
+
+  /// Position in m_sourceLinks of each hit id
+  std::vector<unsigned int> m_position;
+
+  /// Cluster key of each hit id, increasing
+  std::vector<TrkrDefs::cluskey> m_clusKeys;
+};
+
+#endif
@@ -5,12 +5,18 @@
 
 #include <ACTFW/EventData/TrkrClusterSourceLink.hpp>
 
+#include <climits>
+#include <utility>
+#include <vector>
+
 using SourceLink = FW::Data::TrkrClusterSourceLink;
 
 
 /**
  * A struct that contains an Acts track seed and the corresponding source links.
  * Used by a variety of the Acts track fitting classes.
+ * The track key is the key of the SvtxTrack in the SvtxTrackMap that the
+ * seed was made from, so that fit results can be written back to it.
  */
 class ActsTrack
 {
@@ -21,18 +27,30 @@ class ActsTrack
     , m_sourceLinks(links)
     {}
 
+  /// Takes over the source links, used by the batch conversion
+  ActsTrack(const unsigned int trackKey, const FW::TrackParameters &params,
+            std::vector<SourceLink> &&links)
+    : m_trackKey(trackKey)
+    , m_trackParams(params)
+    , m_sourceLinks(std::move(links))
+    {}
+
   ~ActsTrack(){}
 
-  FW::TrackParameters getTrackParams(){ return m_trackParams; }
-  void setTrackParams(FW::TrackParameters params) { m_trackParams = params; }
+  const FW::TrackParameters& getTrackParams() const { return m_trackParams; }
+  void setTrackParams(const FW::TrackParameters &params) { m_trackParams = params; }
 
-  std::vector<SourceLink> getSourceLinks(){ return m_sourceLinks; }
-  void setSourceLinks(std::vector<SourceLink> srcLinks)
+  const std::vector<SourceLink>& getSourceLinks() const { return m_sourceLinks; }
+  void setSourceLinks(const std::vector<SourceLink> &srcLinks)
   { m_sourceLinks = srcLinks; }
-  
+
+  /// Key of the SvtxTrack this track was made from, UINT_MAX if none
+  unsigned int getTrackKey() const { return m_trackKey; }
+  void setTrackKey(const unsigned int trackKey) { m_trackKey = trackKey; }
 
  private:
-  
+
+  unsigned int m_trackKey = UINT_MAX;
   FW::TrackParameters m_trackParams;
   std::vector<SourceLink> m_sourceLinks;
 
@@ -0,0 +1,266 @@
+#include "ActsTrackConverter.h"
+
+#include "ActsSourceLinkContainer.h"
+#include "ActsTrack.h"
+
+#include <phool/phool.h>
+
+#include <trackbase_historic/SvtxTrack.h>
+#include <trackbase_historic/SvtxTrackMap.h>
+#include <trackbase_historic/SvtxTrackState.h>
+#include <trackbase_historic/SvtxTrackState_v1.h>
+
+#include <Acts/Utilities/Units.hpp>
+
+#include <cmath>
+#include <iostream>
+#include <utility>
+
+FW::TrackParameters ActsTrackConverter::makeTrackParameters(const SvtxTrack &track)
+{
+  /// Get the necessary parameters and values for the TrackParameters
+  const Acts::BoundSymMatrix seedCov = makeSeedCovariance(track);
+  const Acts::Vector3D seedPos(track.get_x(),
+                               track.get_y(),
+                               track.get_z());
+  const Acts::Vector3D seedMom(track.get_px(),
+                               track.get_py(),
+                               track.get_pz());
+
+  // just set to 0 for now?
+  const double trackTime = 0;
+  const int trackQ = track.get_charge();
+
+  return FW::TrackParameters(seedCov, seedPos, seedMom, trackQ, trackTime);
+}
+
+Acts::BoundSymMatrix ActsTrackConverter::makeSeedCovariance(const SvtxTrack &track)
+{
+  Acts::BoundSymMatrix matrix = Acts::BoundSymMatrix::Zero();
+  
+  const double px = track.get_px();
+  const double py = track.get_py();
+  const double pz = track.get_pz();
+  const double p = sqrt(px * px + py * py + pz * pz);
+  const double phiPos = atan2(track.get_x(), track.get_y());
+  const int charge = track.get_charge();
+
+  // Get the track seed covariance matrix
+  // These are the variances, so the std devs are sqrt(seedCov[i][j])
+  Acts::BoundSymMatrix seedCov = Acts::BoundSymMatrix::Zero();
+  for (int i = 0; i < 6; i++)
+  {
+    for (int j = 0; j < 6; j++)
+    {
+      /// Track covariance matrix is in basis (x,y,z,px,py,pz). Need to put
+      /// it in form of (x,y,px,py,pz,time) for acts
+      if(i < 2)
+	{
+	  /// get x,y components
+	  seedCov(i, j) = track.get_error(i, j);
+	}
+      else if(i < 5) 
+	{
+	  /// get px,py,pz components 1 row up
+	  seedCov(i,j) = track.get_error(i+1, j);
+	}
+      else if (i == 5) 
+	{
+	  /// convert the global z position covariances to timing covariances
+	  /// TPC z position resolution is 0.05 cm, drift velocity is 8cm/ms
+	  seedCov(i,j) = track.get_error(2, j) * 8. * Acts::UnitConstants::ms; 
+	}
+    }
+  }
+
+  /// Need to transform from global to local coordinate frame. 
+  /// Amounts to the local transformation as in PHActsSourceLinks as well as
+  /// a rotation from cartesian to spherical coordinates for the momentum
+  /// Rotating from (x_G, y_G, px, py, pz, time) to (x_L, y_L, phi, theta, q/p,time)
+
+  /// Make a unit p vector for the rotation
+  const double uPx = px / p;
+  const double uPy = py / p;
+  const double uPz = pz / p;
+  const double uP = sqrt(uPx * uPx + uPy * uPy + uPz * uPz);
+  
+  /// This needs to rotate to (x_L, y_l, phi, theta, q/p, t)
+  Acts::BoundSymMatrix rotation = Acts::BoundSymMatrix::Zero();
+
+  /// Local position rotations
+  rotation(0,0) = cos(phiPos);
+  rotation(0,1) = sin(phiPos);
+  rotation(1,0) = -1 * sin(phiPos);
+  rotation(1,1) = cos(phiPos);
+
+  /// Momentum vector rotations
+  /// phi rotation
+  rotation(2,3) = -1 * uPy / (uPx * uPx + uPy * uPy);
+  rotation(2,4) = -1 * uPx / (uPx * uPx + uPy * uPy);
+
+  /// theta rotation
+  /// Leave uP in for clarity, even though it is trivially unity
+  rotation(3,3) = (uPx * uPz) / (uP * uP * sqrt( uPx * uPx + uPy * uPy) );
+  rotation(3,4) = (uPy * uPz) / (uP * uP * sqrt( uPx * uPx + uPy * uPy) );
+  rotation(3,5) = (-1 * sqrt(uPx * uPx + uPy * uPy)) / (uP * uP);
+  
+  /// q/p rotation
+  rotation(4,3) = charge / uPx;
+  rotation(4,4) = charge / uPy;
+  rotation(4,5) = charge / uPz;
+
+  /// time rotation
+  rotation(5,5) = 1;
+
+  /// Rotate the covariance matrix by the jacobian rotation matrix
+  matrix = rotation * seedCov * rotation.transpose();
+
+  return matrix;
+}
+
+unsigned int ActsTrackConverter::makeActsTracks(const SvtxTrackMap &trackMap,
+                                                const ActsSourceLinkContainer &sourceLinks,
+                                                std::vector<ActsTrack> &actsTracks,
+                                                const int verbosity)
+{
+  unsigned int nmissing = 0;
+
+  actsTracks.clear();
+  actsTracks.reserve(trackMap.size());
+
+  for (SvtxTrackMap::ConstIter trackIter = trackMap.begin();
+       trackIter != trackMap.end(); ++trackIter)
+  {
+    const SvtxTrack *track = trackIter->second;
+
+    if (!track)
+      continue;
+
+    if (verbosity > 1)
+    {
+      std::cout << "found SvtxTrack " << trackIter->first << std::endl;
+      track->identify();
+    }
+
+    /// The source links are collected in the vector the ActsTrack takes over
+    std::vector<SourceLink> trackSourceLinks;
+    trackSourceLinks.reserve(track->size_cluster_keys());
+    for (SvtxTrack::ConstClusterKeyIter clusIter = track->begin_cluster_keys();
+         clusIter != track->end_cluster_keys();
+         ++clusIter)
+    {
+      const TrkrDefs::cluskey key = *clusIter;
+
+      unsigned int hitId = 0;
+      if (!sourceLinks.getHitId(key, hitId))
+      {
+        std::cout << PHWHERE << "No source link for cluskey " << key
+                  << ", skipping this cluster" << std::endl;
+        ++nmissing;
+        continue;
+      }
+
+      if (verbosity > 0)
+      {
+        std::cout << "cluskey " << key
+                  << " has hitid " << hitId
+                  << std::endl;
+      }
+      trackSourceLinks.push_back(*sourceLinks.findHitId(hitId));
+    }
+
+    if (verbosity > 0)
+    {
+      for (unsigned int i = 0; i < trackSourceLinks.size(); ++i)
+      {
+        std::cout << "proto_track readback: hitid " << trackSourceLinks.at(i).hitID() << std::endl;
+      }
+    }
+
+    actsTracks.emplace_back(trackIter->first, makeTrackParameters(*track),
+                            std::move(trackSourceLinks));
+  }
+
+  return nmissing;
+}
+
+void ActsTrackConverter::fillState(const Acts::BoundParameters &params,
+                                   SvtxTrackState_v1 &state)
+{
+  const Acts::Vector3D position = params.position();
+  const Acts::Vector3D momentum = params.momentum();
+
+  state.set_x(position(0));
+  state.set_y(position(1));
+  state.set_z(position(2));
+  state.set_px(momentum(0));
+  state.set_py(momentum(1));
+  state.set_pz(momentum(2));
+
+  if (!params.covariance())
+    return;
+
+  /// Jacobian from the perigee parameters (d0, z0, phi, theta, q/p, t)
+  /// to (x, y, z, px, py, pz). The point of closest approach is
+  /// d0 * (-sin(phi), cos(phi)) in the transverse plane
+  const auto &boundParams = params.parameters();
+  const double d0 = boundParams(0);
+  const double phi = boundParams(2);
+  const double theta = boundParams(3);
+  const double qop = boundParams(4);
+  const double p = momentum.norm();
+  const double dpdqop = -p / qop;
+
+  Acts::ActsMatrixD<6, 6> jacobian = Acts::ActsMatrixD<6, 6>::Zero();
+  jacobian(0, 0) = -sin(phi);
+  jacobian(0, 2) = -d0 * cos(phi);
+  jacobian(1, 0) = cos(phi);
+  jacobian(1, 2) = -d0 * sin(phi);
+  jacobian(2, 1) = 1;
+
+  jacobian(3, 2) = -p * sin(theta) * sin(phi);
+  jacobian(3, 3) = p * cos(theta) * cos(phi);
+  jacobian(3, 4) = dpdqop * sin(theta) * cos(phi);
+
+  jacobian(4, 2) = p * sin(theta) * cos(phi);
+  jacobian(4, 3) = p * cos(theta) * sin(phi);
+  jacobian(4, 4) = dpdqop * sin(theta) * sin(phi);
+
+  jacobian(5, 3) = -p * sin(theta);
+  jacobian(5, 4) = dpdqop * cos(theta);
+
+  const Acts::ActsMatrixD<6, 6> covariance =
+      jacobian * (*params.covariance()) * jacobian.transpose();
+
+  for (unsigned int i = 0; i < 6; ++i)
+  {
+    for (unsigned int j = i; j < 6; ++j)
+    {
+      state.set_error(i, j, covariance(i, j));
+    }
+  }
+}
+
+void ActsTrackConverter::setVertexState(SvtxTrack &track, const SvtxTrackState_v1 &state)
+{
+  SvtxTrackState *vertexState = track.get_state(0.0);
+  if (!vertexState)
+  {
+    track.insert_state(&state);
+    return;
+  }
+
+  vertexState->set_x(state.get_x());
+  vertexState->set_y(state.get_y());
+  vertexState->set_z(state.get_z());
+  vertexState->set_px(state.get_px());
+  vertexState->set_py(state.get_py());
+  vertexState->set_pz(state.get_pz());
+  for (unsigned int i = 0; i < 6; ++i)
+  {
+    for (unsigned int j = i; j < 6; ++j)
+    {
+      vertexState->set_error(i, j, state.get_error(i, j));
+    }
+  }
+}
@@ -0,0 +1,54 @@
+#ifndef TRACKRECO_ACTSTRACKCONVERTER_H
+#define TRACKRECO_ACTSTRACKCONVERTER_H
+
+#include <Acts/EventData/TrackParameters.hpp>
+#include <Acts/Utilities/Definitions.hpp>
+
+#include <ACTFW/EventData/Track.hpp>
+
+#include <vector>
+
+class ActsSourceLinkContainer;
+class ActsTrack;
+class SvtxTrack;
+class SvtxTrackMap;
+class SvtxTrackState_v1;
+
+/**
+ * Conversions between SvtxTracks and the Acts track structures, shared by
+ * the Acts modules.
+ *
+ * makeActsTracks converts a whole SvtxTrackMap in one pass into an
+ * ActsTrack vector whose capacity is kept from event to event, the source
+ * links of each track are filled in place from the ActsSourceLinkContainer.
+ * The fitted perigee parameters go the other way through one
+ * SvtxTrackState_v1, which can be filled by the fitting threads and is then
+ * written into the state at path length 0 of the SvtxTrack with a single
+ * state lookup.
+ */
+class ActsTrackConverter
+{
+ public:
+  /// Acts track seed from the SvtxTrack state at the vertex
+  static FW::TrackParameters makeTrackParameters(const SvtxTrack &track);
+
+  /// Seed covariance in the Acts bound frame from the SvtxTrack covariance
+  static Acts::BoundSymMatrix makeSeedCovariance(const SvtxTrack &track);
+
+  /// Replaces actsTracks with the seeds of all tracks in the map, returns the
+  /// number of clusters without a source link
+  static unsigned int makeActsTracks(const SvtxTrackMap &trackMap,
+                                     const ActsSourceLinkContainer &sourceLinks,
+                                     std::vector<ActsTrack> &actsTracks,
+                                     const int verbosity = 0);
+
+  /// Fills the state with the global position, momentum and covariance of
+  /// fitted parameters on a perigee surface
+  static void fillState(const Acts::BoundParameters &params,
+                        SvtxTrackState_v1 &state);
+
+  /// Writes the state into the state at path length 0 of the track
+  static void setVertexState(SvtxTrack &track, const SvtxTrackState_v1 &state);
+};
+
+#endif
@@ -1,9 +1,12 @@
 #include "AssocInfoContainer.h"
 
+#include <algorithm>
+
 using namespace std;
 
 AssocInfoContainer::AssocInfoContainer()
   : _map_cluster_id_track_id()
+  , _index_valid(false)
 {
 }
 
@@ -12,6 +15,13 @@ AssocInfoContainer::~AssocInfoContainer() { Reset(); }
 void AssocInfoContainer::Reset()
 {
   _map_cluster_id_track_id.clear();
+  _index_valid = false;
+  // clear() keeps the capacity for the next event
+  _index_clusters.clear();
+  _index_cluster_offsets.clear();
+  _index_tracks.clear();
+  _index_track_offsets.clear();
+  _index_track_clusters.clear();
 }
 
 void AssocInfoContainer::identify(std::ostream& os) const
@@ -28,3 +38,77 @@ void AssocInfoContainer::identify(std::ostream& os) const
         << endl;
   }
 }
+
+void AssocInfoContainer::BuildIndex()
+{
+  _index_clusters.clear();
+  _index_cluster_offsets.clear();
+  _index_tracks.clear();
+  _index_tracks.reserve(_map_cluster_id_track_id.size());
+
+  // cluster -> tracks, the multimap is already ordered by cluster
+  unsigned int max_track_id = 0;
+  for (auto iter = _map_cluster_id_track_id.begin(); iter != _map_cluster_id_track_id.end(); ++iter)
+  {
+    if (_index_clusters.empty() || _index_clusters.back() != iter->first)
+    {
+      _index_clusters.push_back(iter->first);
+      _index_cluster_offsets.push_back(_index_tracks.size());
+    }
+    _index_tracks.push_back(iter->second);
+    max_track_id = max(max_track_id, iter->second);
+  }
+  _index_cluster_offsets.push_back(_index_tracks.size());
+
+  // track -> clusters, track ids are small and used directly as index (counting sort)
+  const unsigned int ntracks = _map_cluster_id_track_id.empty() ? 0 : max_track_id + 1;
+  _index_track_offsets.assign(ntracks + 1, 0);
+  for (auto iter = _map_cluster_id_track_id.begin(); iter != _map_cluster_id_track_id.end(); ++iter)
+  {
+    ++_index_track_offsets[iter->second + 1];
+  }
+  for (unsigned int i = 0; i < ntracks; ++i)
+  {
+    _index_track_offsets[i + 1] += _index_track_offsets[i];
+  }
+  _index_track_clusters.resize(_map_cluster_id_track_id.size());
+  vector<unsigned int> fill(_index_track_offsets.begin(), _index_track_offsets.end() - 1);
+  for (auto iter = _map_cluster_id_track_id.begin(); iter != _map_cluster_id_track_id.end(); ++iter)
+  {
+    _index_track_clusters[fill[iter->second]++] = iter->first;
+  }
+
+  _index_valid = true;
+}
+
+AssocInfoContainer::TrackSpan AssocInfoContainer::GetTracks(const TrkrDefs::cluskey cluster_id) const
+{
+  if (!_index_valid)
+  {
+    cout << "AssocInfoContainer::GetTracks - index not built, call BuildIndex()" << endl;
+    return TrackSpan();
+  }
+  auto iter = lower_bound(_index_clusters.begin(), _index_clusters.end(), cluster_id);
+  if (iter == _index_clusters.end() || *iter != cluster_id)
+  {
+    return TrackSpan();
+  }
+  const size_t i = iter - _index_clusters.begin();
+  const unsigned int* tracks = _index_tracks.data();
+  return TrackSpan(tracks + _index_cluster_offsets[i], tracks + _index_cluster_offsets[i + 1]);
+}
+
+AssocInfoContainer::ClusterSpan AssocInfoContainer::GetClusters(const unsigned int track_id) const
+{
+  if (!_index_valid)
+  {
+    cout << "AssocInfoContainer::GetClusters - index not built, call BuildIndex()" << endl;
+    return ClusterSpan();
+  }
+  if (track_id + 1 >= _index_track_offsets.size())
+  {
+    return ClusterSpan();
+  }
+  const TrkrDefs::cluskey* clusters = _index_track_clusters.data();
+  return ClusterSpan(clusters + _index_track_offsets[track_id], clusters + _index_track_offsets[track_id + 1]);
+}
@@ -10,11 +10,44 @@
 #include <utility>               // for pair
 #include <vector>                // for vector
 
+/*!
+ * cluster - track associations
+ *
+ * The associations are stored in a multimap. BuildIndex() creates a compressed
+ * table in both directions (cluster -> tracks and track -> clusters), the
+ * lookups then return ranges into it without any allocation. The index is
+ * not updated by SetClusterTrackAssoc, a stage which adds associations has to
+ * rebuild it before the next stage uses it. Once built it is only read and
+ * can be queried from several threads.
+ */
 class AssocInfoContainer : public PHObject
 {
  public:
   typedef std::multimap<TrkrDefs::cluskey, unsigned int> ClusterTrackMap;
 
+  //! contiguous range of an index
+  template <class T>
+  class Span
+  {
+   public:
+    Span(const T* begin = nullptr, const T* end = nullptr)
+      : m_begin(begin)
+      , m_end(end)
+    {
+    }
+    const T* begin() const { return m_begin; }
+    const T* end() const { return m_end; }
+    size_t size() const { return m_end - m_begin; }
+    bool empty() const { return m_begin == m_end; }
+    const T& operator[](const size_t i) const { return m_begin[i]; }
+
+   private:
+    const T* m_begin;
+    const T* m_end;
+  };
+  typedef Span<unsigned int> TrackSpan;
+  typedef Span<TrkrDefs::cluskey> ClusterSpan;
+
   AssocInfoContainer();
   virtual ~AssocInfoContainer();
 
@@ -24,22 +57,47 @@ class AssocInfoContainer : public PHObject
   void SetClusterTrackAssoc(const TrkrDefs::cluskey& cluster_id, const unsigned int& track_id)
   {
     _map_cluster_id_track_id.insert(ClusterTrackMap::value_type(cluster_id, track_id));
+    _index_valid = false;
   }
 
   std::vector<unsigned int> GetTracksFromCluster(const TrkrDefs::cluskey& cluster_id) const
   {
     std::vector<unsigned int> ret;
-    for (auto iter = _map_cluster_id_track_id.lower_bound(cluster_id);
-         iter != _map_cluster_id_track_id.upper_bound(cluster_id); ++iter)
+    const auto range = _map_cluster_id_track_id.equal_range(cluster_id);
+    for (auto iter = range.first; iter != range.second; ++iter)
     {
       ret.push_back(iter->second);
     }
     return ret;
   }
 
+  //! (re)builds the cluster <-> track index from the associations
+  void BuildIndex();
+  bool IndexValid() const { return _index_valid; }
+
+  //! tracks using a cluster, needs BuildIndex()
+  TrackSpan GetTracks(const TrkrDefs::cluskey cluster_id) const;
+  //! clusters of a track, needs BuildIndex()
+  ClusterSpan GetClusters(const unsigned int track_id) const;
+  //! number of tracks using a cluster, needs BuildIndex()
+  unsigned int NTracks(const TrkrDefs::cluskey cluster_id) const { return GetTracks(cluster_id).size(); }
+  //! true if the cluster is used by more than one track, needs BuildIndex()
+  bool IsShared(const TrkrDefs::cluskey cluster_id) const { return NTracks(cluster_id) > 1; }
+
  private:
   ClusterTrackMap _map_cluster_id_track_id;
 
+  //! index, not persistent
+  bool _index_valid; //!
+  //! sorted distinct cluster keys, the position is the dense cluster index
+  std::vector<TrkrDefs::cluskey> _index_clusters; //!
+  //! tracks of cluster i are _index_tracks[_index_cluster_offsets[i] ... _index_cluster_offsets[i+1]-1]
+  std::vector<unsigned int> _index_cluster_offsets; //!
+  std::vector<unsigned int> _index_tracks; //!
+  //! clusters of track id t are _index_track_clusters[_index_track_offsets[t] ... _index_track_offsets[t+1]-1]
+  std::vector<unsigned int> _index_track_offsets; //!
+  std::vector<TrkrDefs::cluskey> _index_track_clusters; //!
+
   ClassDef(AssocInfoContainer, 1)
 };
 
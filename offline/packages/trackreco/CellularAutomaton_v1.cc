@@ -28,6 +28,96 @@ using namespace Eigen;
 // if _FULL_TEST_ is not chosen, only triplets are translated into SimpleTrack3D
 #define _FULL_TEST_
 
+namespace
+{
+  // calculate_kappa_tangents followed by the extension chi2, for the n
+  // (segment, hit) pairs seg[p], hit[p]. Same arithmetic as the scalar
+  // version, written on flat arrays and without branches so that the loop
+  // over all pairs of one layer can be vectorized.
+  void extend_segments(const unsigned int n, const unsigned int* seg, const unsigned int* hit,
+                       const SegmentEndTable& s, const LayerHitTable& h,
+                       const float ca_sin_ang_cut, const float ca_cos_ang_cut_diff_inv,
+                       float* chi2_out, float* kappa_out, float* dkappa_out,
+                       float* ux_out, float* uy_out)
+  {
+    for (unsigned int p = 0; p < n; ++p) {
+      const unsigned int i = seg[p];
+      const unsigned int j = hit[p];
+
+      const float x1 = s.x1[i], y1 = s.y1[i], z1 = s.z1[i];
+      const float x2 = s.x2[i], y2 = s.y2[i], z2 = s.z2[i];
+      const float x3 = h.x[j], y3 = h.y[j], z3 = h.z[j];
+
+      float D12 = sqrt(pow(x2-x1,2)+pow(y2-y1,2));
+      float D23 = sqrt(pow(x3-x2,2)+pow(y3-y2,2));
+      float D13 = sqrt(pow(x3-x1,2)+pow(y3-y1,2));
+      float kappa = 1./(D12*D23*D13);
+      float num = (D12+D23+D13)*(D23+D13-D12)*(D12+D13-D23)*(D12+D23-D13);
+      num = (num<0) ? 0 : num;
+      num = sqrt(num);
+      kappa *=num;
+
+      float kappa_inv = 1/kappa;
+      float D12_inv = 1./D12;
+      float D23_inv = 1./D23;
+      float D13_inv = 1./D13;
+
+      float dr1 = sqrt(pow(s.dx1[i],2)+pow(s.dy1[i],2));
+      float dr2 = sqrt(pow(s.dx2[i],2)+pow(s.dy2[i],2));
+      float dr3 = sqrt(pow(h.dx[j],2)+pow(h.dy[j],2));
+
+      float dk1 = (dr1+dr2)* D12_inv*D12_inv;
+      float dk2 = (dr2+dr3)* D23_inv*D23_inv;
+      float dkappa = dk1+dk2;
+
+      float ux12 = (x2-x1)*D12_inv;
+      float uy12 = (y2-y1)*D12_inv;
+      float ux23 = (x3-x2)*D23_inv;
+      float uy23 = (y3-y2)*D23_inv;
+      float ux13 = (x3-x1)*D13_inv;
+      float uy13 = (y3-y1)*D13_inv;
+
+      float cosalpha = ux12*ux13 + uy12*uy13;
+      float sinalpha = uy12*ux13 - ux12*uy13;
+      float ux_mid = ux23 * cosalpha - uy23 * sinalpha;
+      float uy_mid = ux23 * sinalpha + uy23 * cosalpha;
+      float ux_end = ux23 * cosalpha + uy23 * sinalpha;
+      float uy_end = uy23 * cosalpha - ux23 * sinalpha;
+
+      float ds23 = 2.*kappa_inv*atan(sinalpha/(1.+ sqrt(1.-pow(sinalpha,2))));
+      ds23 = (kappa<=0) ? D23 : ds23;
+
+      float dz23 = z3 - z2;
+      float dzdl_2 =  dz23/sqrt(pow(ds23,2) + pow(dz23,2));
+      float ddzdl_2 = (s.dz2[i] + h.dz[j])*D23_inv;
+
+      sinalpha = ux13 *uy23 - ux23 *  uy13;
+      float ds12 = 2.*kappa_inv*atan(sinalpha/(1.+sqrt(1.-pow(sinalpha,2))));
+      ds12 = (kappa<=0) ? D12 : ds12;
+
+      float dz12 = z2 - z1;
+      float dzdl_1 = dz12/sqrt(pow(ds12,2) + pow(dz12,2));
+      float ddzdl_1 = (s.dz1[i] + s.dz2[i]) * D12_inv;
+
+      float kappa_diff = s.kappa[i] - kappa;
+      float n_dk = s.dkappa[i] + dkappa + ca_sin_ang_cut * kappa;
+      float chi2_kappa = pow(kappa_diff,2)/pow(n_dk,2);
+
+      float cos_scatter = s.ux[i] * ux_mid + s.uy[i] * uy_mid;
+      float chi2_ang = pow((1-cos_scatter)*ca_cos_ang_cut_diff_inv,2);
+
+      float sin_scatter = dzdl_1 * ca_sin_ang_cut;
+      float chi2_dzdl = 0.5*pow((dzdl_1-dzdl_2)/(ddzdl_1+ddzdl_2+fabs(sin_scatter)),2);
+
+      chi2_out[p] = s.chi2[i] + chi2_ang + chi2_kappa + chi2_dzdl;
+      kappa_out[p] = kappa;
+      dkappa_out[p] = dkappa;
+      ux_out[p] = ux_end;
+      uy_out[p] = uy_end;
+    }
+  }
+}
+
 
 CellularAutomaton_v1::CellularAutomaton_v1(std::vector<SimpleTrack3D>& input_tracks, std::vector<float>& detector_radii, std::vector<float>& detector_materials)
 	:
@@ -39,6 +129,7 @@ CellularAutomaton_v1::CellularAutomaton_v1(std::vector<SimpleTrack3D>& input_tra
 	temp_combo(std::vector<unsigned int>()),
 	combos(std::set<std::vector<unsigned int> >()),
 	layer_sorted(std::vector<std::vector<SimpleHit3D> >()),
+	n_complete_segments(0),
 	nlayers(10),
 	rlayers(8),
 	allowed_missing_inner_hits(0),
@@ -78,7 +169,9 @@ CellularAutomaton_v1::CellularAutomaton_v1(std::vector<SimpleTrack3D>& input_tra
 void CellularAutomaton_v1::Reset(){
 
         delete _hough_space;
+        _hough_space = nullptr;
         delete _kalman;
+        _kalman = nullptr;
         in_tracks.clear();
         ca_tracks.clear();
         ca_track_states.clear();
@@ -138,7 +231,6 @@ int CellularAutomaton_v1::run(std::vector<SimpleTrack3D>& output_tracks, std::ve
 	for (unsigned int i = 0; i<ca_tracks.size(); ++i) ca_tracks[i].reset();
 	ca_tracks.clear();
 	ca_track_states.clear();
-	layer_sorted.clear();
 	return 1;
 }
 
@@ -173,9 +265,16 @@ int CellularAutomaton_v1::init()
 
 	combos.clear();
 
-        std::vector<SimpleHit3D> one_layer;
-        layer_sorted.clear();
-        layer_sorted.assign(nlayers, one_layer);
+        // keep the capacity of the per layer buffers from the previous run
+        layer_sorted.resize(nlayers);
+        for (unsigned int l = 0; l < nlayers; ++l) layer_sorted[l].clear();
+
+	inv_layer.assign(nlayers, 1.);
+	for (unsigned int l = 3; l < nlayers; ++l) {
+	inv_layer[l] = 1. / (((float)l) - 2.);
+	}
+
+	fill_layer_hits();
 
 	ca_tracks.clear();
 	ca_track_states.clear();
@@ -187,6 +286,7 @@ int CellularAutomaton_v1::init()
 
 void CellularAutomaton_v1::set_hough_space(HelixHoughSpace* hough_space) {
 
+  delete _hough_space;
   _hough_space = dynamic_cast<HelixHoughSpace*> (hough_space->CloneMe());
   assert(_hough_space);
 }
@@ -223,6 +323,7 @@ void CellularAutomaton_v1::set_detector_materials(std::vector<float>& materials)
 }
 
 void CellularAutomaton_v1::set_cylinder_kalman(){
+	delete _kalman;
   	_kalman =
       	new HelixKalmanFilter(_detector_radii, _detector_materials, _mag_field);
 }
@@ -241,6 +342,49 @@ void CellularAutomaton_v1::set_input_tracks(std::vector<SimpleTrack3D>& input_tr
 
 }
 
+void CellularAutomaton_v1::add_table_hit(LayerHitTable& table, const SimpleHit3D& hit)
+{
+	float x = hit.get_x();
+	float y = hit.get_y();
+	table.id.push_back(hit.get_id());
+	table.x.push_back(x);
+	table.y.push_back(y);
+	table.z.push_back(hit.get_z());
+	table.dx.push_back(0.5*sqrt(12.0)*sqrt(hit.get_size(0,0)));
+	table.dy.push_back(0.5*sqrt(12.0)*sqrt(hit.get_size(1,1)));
+	table.dz.push_back(0.5*sqrt(12.0)*sqrt(hit.get_size(2,2)));
+	table.phi.push_back(shift_phi_range(atan2(y,x)));
+}
+
+void CellularAutomaton_v1::fill_layer_hits()
+{
+	// hits of _hits_map by layer, in map order. Extending a segment only
+	// scans the table of the next layer instead of all hits.
+	layer_hits.resize(nlayers);
+	for (unsigned int l = 0; l < nlayers; ++l) layer_hits[l].clear();
+
+	for (std::map<unsigned int,SimpleHit3D>::const_iterator it = _hits_map.begin();
+		it != _hits_map.end(); ++it) {
+		unsigned int layer = it->second.get_layer();
+		if (layer >= nlayers) continue;
+		add_table_hit(layer_hits[layer], it->second);
+	}
+}
+
+void CellularAutomaton_v1::fill_sorted_hits(unsigned int n_sorted_layers)
+{
+	// flat copy of layer_sorted[0..n_sorted_layers), hit j of layer_sorted[l]
+	// is entry sorted_offset[l]+j
+	sorted_hits.clear();
+	sorted_offset.assign(n_sorted_layers, 0);
+	for (unsigned int l = 0; l < n_sorted_layers; ++l) {
+		sorted_offset[l] = sorted_hits.size();
+		for (unsigned int j = 0; j < layer_sorted[l].size(); ++j) {
+			add_table_hit(sorted_hits, layer_sorted[l][j]);
+		}
+	}
+}
+
 int CellularAutomaton_v1::get_ca_tracks(std::vector<SimpleTrack3D>& output_tracks, std::vector<HelixKalmanState>& output_track_states)
 {
 	// push back new ca processed tracks into _tracks
@@ -296,15 +440,12 @@ int CellularAutomaton_v1::process_tracks()
 
 int CellularAutomaton_v1::process_single_triplet(SimpleTrack3D& track){ // track : from hough transform
 
-        std::vector<TrackSegment> segments1;
-        std::vector<TrackSegment> segments2;
-	
         std::vector<TrackSegment>* cur_seg = &segments1;
         std::vector<TrackSegment>* next_seg = &segments2;
         unsigned int cur_seg_size = 0;
         unsigned int next_seg_size = 0;
 
-	std::vector<TrackSegment> complete_segments;
+	n_complete_segments = 0;
 
 	// from hit triplets to a segment with estimated kappa & dzdl
 //      triplet_to_segments(track, cur_segments); // from hit triplets to a segment with estimated kappa & dzdl 
@@ -336,6 +477,7 @@ int CellularAutomaton_v1::process_single_triplet(SimpleTrack3D& track){ // track
         	return 0;
     		}
   	}
+	fill_sorted_hits(3);
 
 #ifdef _FULL_TEST_
 	float ca_cos_ang_cut_diff = 1. - ca_cos_ang_cut;
@@ -343,12 +485,7 @@ int CellularAutomaton_v1::process_single_triplet(SimpleTrack3D& track){ // track
 #endif
 	float ca_sin_ang_cut = sqrt(1. - ca_cos_ang_cut * ca_cos_ang_cut);
 
-	std::vector<float> inv_layer;
-	inv_layer.assign(nlayers, 1.);
-	for (unsigned int l = 3; l < nlayers; ++l) {
-	inv_layer[l] = 1. / (((float)l) - 2.);
-	}
-
+	// inv_layer, set in init()
 	// l = 3, 4,   5,   6,   7
 	//     1, 1/2, 1/3, 1/4, 1/5
 	//     1, 1/3, 1/5, 1/7, 1/9         
@@ -374,11 +511,6 @@ int CellularAutomaton_v1::process_single_triplet(SimpleTrack3D& track){ // track
 	float ddzdl_2;
 
 #ifdef _FULL_TEST_
-	float cur_kappa;
-	float cur_dkappa;
-	float cur_ux;
-	float cur_uy;
-	float cur_chi2;
 	float chi2;
 #endif
 	unsigned int hit1;
@@ -389,8 +521,11 @@ int CellularAutomaton_v1::process_single_triplet(SimpleTrack3D& track){ // track
 	temp_segment.hits.assign(nlayers, 0);
 
   	for (unsigned int i = 0; i < layer_sorted[0].size(); ++i) {
+		const unsigned int h1 = sorted_offset[0] + i;
 		for (unsigned int j = 0; j < layer_sorted[1].size(); ++j) {
+			const unsigned int h2 = sorted_offset[1] + j;
 			for (unsigned int k = 0; k < layer_sorted[2].size() ; ++k) {
+			const unsigned int h3 = sorted_offset[2] + k;
 
 			unsigned int layer0 = layer_sorted[0][i].get_layer();
 			unsigned int layer1 = layer_sorted[1][j].get_layer();
@@ -402,28 +537,28 @@ int CellularAutomaton_v1::process_single_triplet(SimpleTrack3D& track){ // track
 			layer2 = nlayers-layer2-1;
 			}
 
-        		x1 = layer_sorted[0][i].get_x();
-        		y1 = layer_sorted[0][i].get_y();
-       		 	z1 = layer_sorted[0][i].get_z();
+        		x1 = sorted_hits.x[h1];
+        		y1 = sorted_hits.y[h1];
+       		 	z1 = sorted_hits.z[h1];
 
-        		dx1 = 0.5*sqrt(12.0)*sqrt(layer_sorted[0][i].get_size(0,0));
-        		dy1 = 0.5*sqrt(12.0)*sqrt(layer_sorted[0][i].get_size(1,1));
-        		dz1 = 0.5*sqrt(12.0)*sqrt(layer_sorted[0][i].get_size(2,2));
+        		dx1 = sorted_hits.dx[h1];
+        		dy1 = sorted_hits.dy[h1];
+        		dz1 = sorted_hits.dz[h1];
 
-        		x2 = layer_sorted[1][j].get_x();
-        		y2 = layer_sorted[1][j].get_y();
-        		z2 = layer_sorted[1][j].get_z();
+        		x2 = sorted_hits.x[h2];
+        		y2 = sorted_hits.y[h2];
+        		z2 = sorted_hits.z[h2];
 
-        		dx2 = 0.5*sqrt(12.0)*sqrt(layer_sorted[1][j].get_size(0,0));
-        		dy2 = 0.5*sqrt(12.0)*sqrt(layer_sorted[1][j].get_size(1,1));
-        		dz2 = 0.5*sqrt(12.0)*sqrt(layer_sorted[1][j].get_size(2,2));
+        		dx2 = sorted_hits.dx[h2];
+        		dy2 = sorted_hits.dy[h2];
+        		dz2 = sorted_hits.dz[h2];
 
-        		x3 = layer_sorted[2][k].get_x();
-        		y3 = layer_sorted[2][k].get_y();
-        		z3 = layer_sorted[2][k].get_z();
-        		dx3 = 0.5*sqrt(12.0)*sqrt(layer_sorted[2][k].get_size(0,0));
-        		dy3 = 0.5*sqrt(12.0)*sqrt(layer_sorted[2][k].get_size(1,1));
-        		dz3 = 0.5*sqrt(12.0)*sqrt(layer_sorted[2][k].get_size(2,2));
+        		x3 = sorted_hits.x[h3];
+        		y3 = sorted_hits.y[h3];
+        		z3 = sorted_hits.z[h3];
+        		dx3 = sorted_hits.dx[h3];
+        		dy3 = sorted_hits.dy[h3];
+        		dz3 = sorted_hits.dz[h3];
 
         		hit1 = i;
        	 		hit2 = j;
@@ -465,7 +600,12 @@ int CellularAutomaton_v1::process_single_triplet(SimpleTrack3D& track){ // track
                        	if ((outer_layer - 2) > allowed_missing_inner_hits) continue;
           		// finish up if required number of layers is reached,
                        	if ((nlayers - 3) <= allowed_missing_inner_hits) {
-                	complete_segments.push_back(temp_segment);
+                	if (complete_segments.size() == n_complete_segments) {
+                		complete_segments.push_back(temp_segment);
+                	} else {
+                		complete_segments[n_complete_segments] = temp_segment;
+                	}
+                	++n_complete_segments;
           		}
           		if (next_seg->size() == next_seg_size) { // first new segment
                 		next_seg->push_back(temp_segment);
@@ -487,7 +627,7 @@ int CellularAutomaton_v1::process_single_triplet(SimpleTrack3D& track){ // track
   	//cout<<"number of current segments : "<< cur_seg_size<<endl;
 
   	// copy complete segments over to current segments
-       	for (unsigned int i = 0; i < complete_segments.size(); ++i) {
+       	for (unsigned int i = 0; i < n_complete_segments; ++i) {
     		if (cur_seg->size() == cur_seg_size) {
       		cur_seg->push_back(complete_segments[i]);
       		++cur_seg_size;
@@ -565,29 +705,27 @@ int CellularAutomaton_v1::process_single_triplet(SimpleTrack3D& track){ // track
  	for (unsigned int l=3; l < nlayers; ++l ) {
 ////		cout<<"nlayers "<<nlayers<<" l "<<l<<endl;
 		next_seg_size = 0;
-		next_seg->clear();
-		// Loop over current segments
+		const LayerHitTable& hits = layer_hits[l];
+		bool fit_layer = (l >= 6);
+
+		// store the last two hits of the current segments and collect all
+		// (segment, hit) pairs inside the phi and z window, in the order of the
+		// current segments and then the hits on layer l
+		seg_ends.resize(cur_seg_size);
+		pair_seg.clear();
+		pair_hit.clear();
 		for (unsigned int i = 0; i < cur_seg_size; ++i) {
 			if ((*cur_seg)[i].n_hits ==0) continue;
-			added_next_segments = 0;
-			auto search = missing_layers_map.find(i);
-                        unsigned int missing_layers = search->second;
-////			cout<<"segment "<< i <<", missing layer "<<missing_layers<<endl;
-//                next_segments(cur_segments, next_segments, n ); // search layer n
-			// loop over all hits on layer n
-			// if multiple legitimate hits in next layer, duplicate current segment, copy over missing layer and assign new segment_id
-			//// ** drop layer sorted keep good hits in layer_sorted, hits[l] : id 
 			// keep cluster ids in hits[l] for good hits of a segment
-			// for a layer without a good hit, store with hits[l] = 999
 
 			if ( (l-2) < 3){
-		        x1 = layer_sorted[l - 2][(*cur_seg)[i].hits[l - 2]].get_x();
-		        y1 = layer_sorted[l - 2][(*cur_seg)[i].hits[l - 2]].get_y();
-        		z1 = layer_sorted[l - 2][(*cur_seg)[i].hits[l - 2]].get_z();
-		        dx1 = 0.5*sqrt(12.0)*sqrt(layer_sorted[l - 2][(*cur_seg)[i].hits[l - 2]].get_size(0,0));
-                        dy1 = 0.5*sqrt(12.0)*sqrt(layer_sorted[l - 2][(*cur_seg)[i].hits[l - 2]].get_size(1,1));
-                        dz1 = 0.5*sqrt(12.0)*sqrt(layer_sorted[l - 2][(*cur_seg)[i].hits[l - 2]].get_size(2,2));
-
+			unsigned int h1 = sorted_offset[l - 2] + (*cur_seg)[i].hits[l - 2];
+			x1 = sorted_hits.x[h1];
+			y1 = sorted_hits.y[h1];
+			z1 = sorted_hits.z[h1];
+			dx1 = sorted_hits.dx[h1];
+			dy1 = sorted_hits.dy[h1];
+			dz1 = sorted_hits.dz[h1];
 			}else {
 			// get positions from hits_map
 			auto searchl2 = _hits_map.find((*cur_seg)[i].hits[l-2]);
@@ -601,12 +739,13 @@ int CellularAutomaton_v1::process_single_triplet(SimpleTrack3D& track){ // track
 			}
 
 			if  ( (l-1) < 3) {
-        		x2 = layer_sorted[l - 1][(*cur_seg)[i].hits[l - 1]].get_x();
-        		y2 = layer_sorted[l - 1][(*cur_seg)[i].hits[l - 1]].get_y();
-        		z2 = layer_sorted[l - 1][(*cur_seg)[i].hits[l - 1]].get_z();
-                        dx2 = 0.5*sqrt(12.0)*sqrt(layer_sorted[l - 1][(*cur_seg)[i].hits[l - 1]].get_size(0,0));
-                        dy2 = 0.5*sqrt(12.0)*sqrt(layer_sorted[l - 1][(*cur_seg)[i].hits[l - 1]].get_size(1,1));
-                        dz2 = 0.5*sqrt(12.0)*sqrt(layer_sorted[l - 1][(*cur_seg)[i].hits[l - 1]].get_size(2,2));
+			unsigned int h2 = sorted_offset[l - 1] + (*cur_seg)[i].hits[l - 1];
+			x2 = sorted_hits.x[h2];
+			y2 = sorted_hits.y[h2];
+			z2 = sorted_hits.z[h2];
+			dx2 = sorted_hits.dx[h2];
+			dy2 = sorted_hits.dy[h2];
+			dz2 = sorted_hits.dz[h2];
 			} else {
 			// get positions from hits_map
 			auto searchl1 = _hits_map.find((*cur_seg)[i].hits[l-1]);
@@ -618,57 +757,81 @@ int CellularAutomaton_v1::process_single_triplet(SimpleTrack3D& track){ // track
                         dy2 = 0.5*sqrt(12.0)*sqrt(clusterl1.get_size(1,1));
                         dz2 = 0.5*sqrt(12.0)*sqrt(clusterl1.get_size(2,2));
 			}
-	
-
-                        // convert segment to track to process it through kalman filter or just call fit_track
-
-			SimpleTrack3D init_track;
-			bool fit_layer = (l >= 6);
-			if (fit_layer){
-                                //init_track.hits.assign(l, SimpleHit3D());
-                                init_track.hits.assign((*cur_seg)[i].n_hits, SimpleHit3D());
-
-                		for (unsigned int ll = 0; ll < (*cur_seg)[i].n_hits; ++ll) {
-                			if (ll<3){
-                			init_track.hits[ll] = layer_sorted[ll][(*cur_seg)[i].hits[ll]];
-                			}else {
-                			auto search = _hits_map.find((*cur_seg)[i].hits[ll]);
-                			SimpleHit3D cluster = search->second;
-                			init_track.hits[ll] = cluster;
-                			}
-		                }
-			}
 
-                        	for (std::map<unsigned int,SimpleHit3D>::iterator jt = _hits_map.begin();
-                                                jt!= _hits_map.end();
-                                                ++jt) {
-
-                        	SimpleHit3D hit3d = jt->second;
-                        	unsigned int layer = hit3d.get_layer();
-                        	if (layer != l) continue;
-				which_seg = i;
-                                hit1 = hit3d.get_id();
-				
-                                x3 = hit3d.get_x();
-                                y3 = hit3d.get_y();
-                                z3 = hit3d.get_z();
-
-                                float phi_prev =shift_phi_range(atan2(y2,x2));
-                                float phi_cur = shift_phi_range(atan2(y3,x3));
+			seg_ends.x1[i] = x1;
+			seg_ends.y1[i] = y1;
+			seg_ends.z1[i] = z1;
+			seg_ends.dx1[i] = dx1;
+			seg_ends.dy1[i] = dy1;
+			seg_ends.dz1[i] = dz1;
+			seg_ends.x2[i] = x2;
+			seg_ends.y2[i] = y2;
+			seg_ends.z2[i] = z2;
+			seg_ends.dx2[i] = dx2;
+			seg_ends.dy2[i] = dy2;
+			seg_ends.dz2[i] = dz2;
+			seg_ends.kappa[i] = (*cur_seg)[i].kappa;
+			seg_ends.dkappa[i] = (*cur_seg)[i].dkappa;
+			seg_ends.ux[i] = (*cur_seg)[i].ux;
+			seg_ends.uy[i] = (*cur_seg)[i].uy;
+			seg_ends.chi2[i] = (*cur_seg)[i].chi2;
+
+			float phi_prev =shift_phi_range(atan2(y2,x2));
+			for (unsigned int j = 0; j < hits.size(); ++j) {
+				float phi_cur = hits.phi[j];
 				float phi_diff = phi_cur-phi_prev;
 				if (phi_cur< M_PI/2. && phi_prev > 3*M_PI/2.) phi_diff += 2.*M_PI;
 				else if (phi_cur>3*M_PI/2 && phi_prev<M_PI/2.) phi_diff -= 2.*M_PI;
 				if (!seeding_mode){
-                                if ((fabs(phi_diff)> ca_phi_cut || abs(z3-z2)> ca_z_cut)) continue;
+                                if ((fabs(phi_diff)> ca_phi_cut || abs(hits.z[j]-z2)> ca_z_cut)) continue;
 				} else {
-				if ((fabs(phi_diff)> ca_phi_cut || abs(z3-z2)> ca_z_cut) && cur_seg_size!=1) continue;
+				if ((fabs(phi_diff)> ca_phi_cut || abs(hits.z[j]-z2)> ca_z_cut) && cur_seg_size!=1) continue;
 				}
+				pair_seg.push_back(i);
+				pair_hit.push_back(j);
+			}
+		}
+		unsigned int npairs = pair_seg.size();
+
+		// chi2 of all extensions of this layer in one pass
+		if (!fit_layer) {
+			pair_chi2.resize(npairs);
+			pair_kappa.resize(npairs);
+			pair_dkappa.resize(npairs);
+			pair_ux.resize(npairs);
+			pair_uy.resize(npairs);
+			extend_segments(npairs, pair_seg.data(), pair_hit.data(), seg_ends, hits,
+					ca_sin_ang_cut, ca_cos_ang_cut_diff_inv,
+					pair_chi2.data(), pair_kappa.data(), pair_dkappa.data(),
+					pair_ux.data(), pair_uy.data());
+		}
 
-//                		auto search = _hits_used.find(hit1);
-//                		if(search != _hits_used.end() && search->second ) continue;
+		// convert segment to track to process it through kalman filter or just call fit_track
+		SimpleTrack3D init_track;
+		unsigned int init_seg = cur_seg_size;
+		for (unsigned int p = 0; p < npairs; ++p) {
+			which_seg = pair_seg[p];
+			hit1 = hits.id[pair_hit[p]];
+			if (p == 0 || pair_seg[p - 1] != which_seg) added_next_segments = 0;
+			auto search = missing_layers_map.find(which_seg);
+                        unsigned int missing_layers = search->second;
 
 				if (fit_layer)
 				{
+				if (init_seg != which_seg) {
+                                init_seg = which_seg;
+                                init_track.hits.assign((*cur_seg)[which_seg].n_hits, SimpleHit3D());
+                		for (unsigned int ll = 0; ll < (*cur_seg)[which_seg].n_hits; ++ll) {
+                			if (ll<3){
+                			init_track.hits[ll] = layer_sorted[ll][(*cur_seg)[which_seg].hits[ll]];
+                			}else {
+                			auto search = _hits_map.find((*cur_seg)[which_seg].hits[ll]);
+                			SimpleHit3D cluster = search->second;
+                			init_track.hits[ll] = cluster;
+                			}
+		                }
+				}
+
 				// fit init_track to get kappa to compare with new kappa
 				// copy init_track over to temp_track and add a hit in kalman filter
 				SimpleTrack3D temp_track;
@@ -677,7 +840,7 @@ int CellularAutomaton_v1::process_single_triplet(SimpleTrack3D& track){ // track
       				for (unsigned int ll = 0; ll < init_track.hits.size(); ++ll) {
         			temp_track.hits[ll] = init_track.hits[ll];
       				}
-				temp_track.hits[init_track.hits.size()] = hit3d;
+				temp_track.hits[init_track.hits.size()] = _hits_map.find(hit1)->second;
 
 				// track fitting instead of computing from triplets
 
@@ -710,27 +873,7 @@ int CellularAutomaton_v1::process_single_triplet(SimpleTrack3D& track){ // track
 		                state.z_int = 0.;
 			
 				// place holder for kalman filter
-/*
-	                	unsigned int nfits = 0;
-                		for (unsigned int h = 0; h < temp_track.hits.size(); ++h) {
-                		_kalman->addHit(temp_track.hits[h], state);
-                		nfits += 1;
-                		cout<<"nfits "<<nfits<<endl;
-                		}
-                		cout<<"z0 after kalman "<<state.z0<<endl;
-
-                		// fudge factor for non-gaussian hit sizes
-                                state.C *= 3.;
-                		state.chi2 *= 6.;
-                		// kappa cut here drives both efficiency and ghost track rates down at the same time
-                                if (!(temp_track.kappa == temp_track.kappa) ) {
-                		continue;
-                		}
-                		if (!(state.chi2 == state.chi2)) {
-                		continue;
-                		}
 
-*/
               			if (state.chi2 / (2. * ((float)(temp_track.hits.size())) - 5.) < ca_chi2_cut /* 10. */) {
 					// translate temp_track into temp_segment (only hit info is saved) and save in next segments
 					for (unsigned int ll = 0; ll < l; ++ll) {
@@ -741,16 +884,11 @@ int CellularAutomaton_v1::process_single_triplet(SimpleTrack3D& track){ // track
 
                                         if (next_seg->size() == next_seg_size) { // first new segment
                                                 next_seg->push_back(temp_segment);
-                                                missing_layers_map_next.insert(make_pair(next_seg->size()-1, missing_layers));
-                                                next_seg_size += 1;
                                         } else { // next new segments
-                                        #ifdef _DEBUG_
-                                        cout<<"Next segment size inconsistent "<<endl;
-                                        #endif
                                                 (*next_seg)[next_seg_size] = temp_segment;
-                                                missing_layers_map_next.insert(make_pair(next_seg->size()-1, missing_layers));
-                                                next_seg_size += 1;
                                         }
+                                        missing_layers_map_next.insert(make_pair(next_seg_size, missing_layers));
+                                        next_seg_size += 1;
                                         ++added_next_segments;
 #ifdef _DEBUG_
                                         cout<<"segment "<< which_seg << " added segment "<<added_next_segments<<endl;
@@ -761,44 +899,16 @@ int CellularAutomaton_v1::process_single_triplet(SimpleTrack3D& track){ // track
 				}
 				else
 				{
-	//        		x3 = layer_sorted[l][j].get_x();
-	//        		y3 = layer_sorted[l][j].get_y();
-	//        		z3 = layer_sorted[l][j].get_z();
-
-	//        		dx1 = 0.5*sqrt(12.0)*sqrt(layer_sorted[l - 2][(*cur_seg)[i].hits[l - 2]].get_size(0,0));
-	//        		dy1 = 0.5*sqrt(12.0)*sqrt(layer_sorted[l - 2][(*cur_seg)[i].hits[l - 2]].get_size(1,1));
-	//        		dz1 = 0.5*sqrt(12.0)*sqrt(layer_sorted[l - 2][(*cur_seg)[i].hits[l - 2]].get_size(2,2));
-	//        		dx2 = 0.5*sqrt(12.0)*sqrt(layer_sorted[l - 1][(*cur_seg)[i].hits[l - 1]].get_size(0,0));
-	//        		dy2 = 0.5*sqrt(12.0)*sqrt(layer_sorted[l - 1][(*cur_seg)[i].hits[l - 1]].get_size(1,1));
-	//        		dz2 = 0.5*sqrt(12.0)*sqrt(layer_sorted[l - 1][(*cur_seg)[i].hits[l - 1]].get_size(2,2));
-
-	//        		dx3 = 0.5*sqrt(12.0)*sqrt(layer_sorted[l][j].get_size(0,0));
-	//        		dy3 = 0.5*sqrt(12.0)*sqrt(layer_sorted[l][j].get_size(1,1));
-	//        		dz3 = 0.5*sqrt(12.0)*sqrt(layer_sorted[l][j].get_size(2,2));
-        	                dx3 = 0.5*sqrt(12.0)*sqrt(hit3d.get_size(0,0));
-                	        dy3 = 0.5*sqrt(12.0)*sqrt(hit3d.get_size(1,1));
-                        	dz3 = 0.5*sqrt(12.0)*sqrt(hit3d.get_size(2,2));
-
-       		 		cur_kappa = (*cur_seg)[i].kappa;
-        			cur_dkappa = (*cur_seg)[i].dkappa;
-        			cur_ux = (*cur_seg)[i].ux;
-        			cur_uy = (*cur_seg)[i].uy;
-        			cur_chi2 = (*cur_seg)[i].chi2;
-
-				chi2=9999;
-	        		calculate_kappa_tangents(
-        	      			x1, y1, z1, x2, y2, z2, x3, y3, z3,
-              				dx1, dy1, dz1, dx2, dy2, dz2, dx3, dy3, dz3,
-              				kappa, dkappa, ux_mid, uy_mid, ux_end, uy_end,
-              				dzdl_1, dzdl_2, ddzdl_1, ddzdl_2,
-              				ca_sin_ang_cut, ca_cos_ang_cut_diff_inv,
-              				cur_kappa, cur_dkappa, cur_ux, cur_uy, cur_chi2, chi2);
+				chi2 = pair_chi2[p];
+				kappa = pair_kappa[p];
+				dkappa = pair_dkappa[p];
+				ux_end = pair_ux[p];
+				uy_end = pair_uy[p];
 #ifdef _DEBUG_
         			cout<<"Extended layers for segment "<<which_seg<<endl;
         			cout<<"kappa "<<kappa<< " dkappa "<<dkappa
-        			<<" ux_mid "<<ux_mid<<" uy_mid "<<" ux_end "<<ux_end<<" uy_end " <<uy_end
-        			<<" dzdl_1 "<<dzdl_1<<" dzdl_2 "<<dzdl_2<<" ddzdl_1 "<<ddzdl_1<<" ddzdl_2 "<<ddzdl_2
-        			<<" cur_chi2 "<<cur_chi2<<" chi2 "<<chi2<<" chi2*inv_layer "<<l <<" "<<chi2*inv_layer[l]
+        			<<" ux_end "<<ux_end<<" uy_end " <<uy_end
+        			<<" chi2 "<<chi2<<" chi2*inv_layer "<<l <<" "<<chi2*inv_layer[l]
         			<<" chi2_cut " <<ca_chi2_layer_cut<<endl;
 #endif
 
@@ -820,32 +930,15 @@ int CellularAutomaton_v1::process_single_triplet(SimpleTrack3D& track){ // track
                 			temp_segment.hits[ll] = (*cur_seg)[which_seg].hits[ll];
               				}
               				temp_segment.hits[l] = hit1;
-              				//unsigned int outer_layer =
-                  			//	layer_sorted[l][temp_segment.hits[l]].get_layer();
-              				//if (!forward) outer_layer = nlayers-outer_layer-1;
               				temp_segment.n_hits = l + 1;
-              				// finish up if required number of layers is reached
-                        		//if ((nlayers - (l + 1)) <= allowed_missing) {
-                			//	complete_segments.push_back(temp_segment);
-              				//}
-              				// make sure we have required number of layers with hits
-                        		//if ((outer_layer - l) > allowed_missing) {
-                			//continue;
-              				//}
-
-		                	// Discard segment if too many missing layers                 		
+
               				if (next_seg->size() == next_seg_size) { // first new segment
                 				next_seg->push_back(temp_segment);
-                                        	missing_layers_map_next.insert(make_pair(next_seg->size()-1, missing_layers));
-                				next_seg_size += 1;
               				} else { // next new segments
-					#ifdef _DEBUG_
-					cout<<"Next segment size inconsistent "<<endl;
-					#endif
                 				(*next_seg)[next_seg_size] = temp_segment;
-				        	missing_layers_map_next.insert(make_pair(next_seg->size()-1, missing_layers));
-                				next_seg_size += 1;
               				}
+				        missing_layers_map_next.insert(make_pair(next_seg_size, missing_layers));
+                			next_seg_size += 1;
 					++added_next_segments;
 #ifdef _DEBUG_					
 					cout<<"segment "<< which_seg << " added segment "<<added_next_segments<<endl;
@@ -853,27 +946,8 @@ int CellularAutomaton_v1::process_single_triplet(SimpleTrack3D& track){ // track
          			} // chi2 cut from segment building method -> change to switch - case block
 				}
 
-			}// clusters on layer l		
-			
-/*
-			if (added_next_segments==0){
-			 ++missing_layers;
-			if (missing_layers <= allowed_missing){
-                                if (next_seg->size() == next_seg_size) { // first new segment
-                                        next_seg->push_back((*cur_seg)[i]);
-					missing_layers_map_next.insert(make_pair(next_seg->size()-1, missing_layers));
-                                        next_seg_size += 1;
-                                } else { // next new segments
-                                        (*next_seg)[next_seg_size] = (*cur_seg)[i];
-					missing_layers_map_next.insert(make_pair(next_seg->size()-1, missing_layers));
-                                        next_seg_size += 1;
-                                }
-			}
-			}
-*/
+		}// (segment, hit) pairs
 
-
-        	} // current segments
 	    	swap(cur_seg, next_seg);
     		swap(cur_seg_size, next_seg_size);
 		missing_layers_map.swap(missing_layers_map_next);
@@ -1018,24 +1092,18 @@ int CellularAutomaton_v1::process_single_triplet(SimpleTrack3D& track){ // track
         }
         }
 
-	segments1.clear();
-	segments2.clear();
 	return 1;
 }
 
 int CellularAutomaton_v1::process_single_track(SimpleTrack3D& track)
 {
 
-        std::vector<TrackSegment> segments1;
-        std::vector<TrackSegment> segments2;
-
-
   std::vector<TrackSegment>* cur_seg = &segments1;
   std::vector<TrackSegment>* next_seg = &segments2;
   unsigned int cur_seg_size = 0;
   unsigned int next_seg_size = 0;
 
-  std::vector<TrackSegment> complete_segments;
+  n_complete_segments = 0;
 
   unsigned int allowed_missing = nlayers - rlayers;
   cout<<"allowed missing "<< allowed_missing<<endl;
@@ -1068,6 +1136,7 @@ int CellularAutomaton_v1::process_single_track(SimpleTrack3D& track)
       return 0;
     }
   }
+  fill_sorted_hits(nlayers);
 
   timeval t1, t2;
   double time1 = 0.;
@@ -1079,12 +1148,6 @@ int CellularAutomaton_v1::process_single_track(SimpleTrack3D& track)
   float ca_cos_ang_cut_diff_inv = 1. / ca_cos_ang_cut_diff;
   float ca_sin_ang_cut = sqrt(1. - ca_cos_ang_cut * ca_cos_ang_cut);
 
-  std::vector<float> inv_layer;
-  inv_layer.assign(nlayers, 1.);
-  for (unsigned int l = 3; l < nlayers; ++l) {
-    inv_layer[l] = 1. / (((float)l) - 2.);
-  }
-
   float x1, x2, x3;
   float y1, y2, y3;
   float z1, z2, z3;
@@ -1106,11 +1169,6 @@ int CellularAutomaton_v1::process_single_track(SimpleTrack3D& track)
   float ddzdl_2;
 
 
-  float cur_kappa;
-  float cur_dkappa;
-  float cur_ux;
-  float cur_uy;
-  float cur_chi2;
   float chi2;
 
   unsigned int hit1;
@@ -1121,8 +1179,11 @@ int CellularAutomaton_v1::process_single_track(SimpleTrack3D& track)
   temp_segment.hits.assign(nlayers, 0);
 
   for (unsigned int i = 0; i < layer_sorted[0].size(); ++i) {
+    const unsigned int h1 = sorted_offset[0] + i;
     for (unsigned int j = 0; j < layer_sorted[1].size(); ++j) {
+      const unsigned int h2 = sorted_offset[1] + j;
       for (unsigned int k = 0; k < layer_sorted[2].size() ; ++k) {
+        const unsigned int h3 = sorted_offset[2] + k;
 
 	unsigned int layer0 = layer_sorted[0][i].get_layer(); 
 	unsigned int layer1 = layer_sorted[1][j].get_layer();
@@ -1137,29 +1198,29 @@ int CellularAutomaton_v1::process_single_track(SimpleTrack3D& track)
           continue;
         }
 
-        x1 = layer_sorted[0][i].get_x();
-        y1 = layer_sorted[0][i].get_y();
-        z1 = layer_sorted[0][i].get_z();
+        x1 = sorted_hits.x[h1];
+        y1 = sorted_hits.y[h1];
+        z1 = sorted_hits.z[h1];
 
 	// sigma ?= half pictch
-        dx1 = 0.5*sqrt(12.0)*sqrt(layer_sorted[0][i].get_size(0,0));
-        dy1 = 0.5*sqrt(12.0)*sqrt(layer_sorted[0][i].get_size(1,1));
-        dz1 = 0.5*sqrt(12.0)*sqrt(layer_sorted[0][i].get_size(2,2));
+        dx1 = sorted_hits.dx[h1];
+        dy1 = sorted_hits.dy[h1];
+        dz1 = sorted_hits.dz[h1];
 
-        x2 = layer_sorted[1][j].get_x();
-        y2 = layer_sorted[1][j].get_y();
-        z2 = layer_sorted[1][j].get_z();
+        x2 = sorted_hits.x[h2];
+        y2 = sorted_hits.y[h2];
+        z2 = sorted_hits.z[h2];
 
-        dx2 = 0.5*sqrt(12.0)*sqrt(layer_sorted[1][j].get_size(0,0));
-        dy2 = 0.5*sqrt(12.0)*sqrt(layer_sorted[1][j].get_size(1,1));
-        dz2 = 0.5*sqrt(12.0)*sqrt(layer_sorted[1][j].get_size(2,2));
+        dx2 = sorted_hits.dx[h2];
+        dy2 = sorted_hits.dy[h2];
+        dz2 = sorted_hits.dz[h2];
 
-        x3 = layer_sorted[2][k].get_x();
-        y3 = layer_sorted[2][k].get_y();
-        z3 = layer_sorted[2][k].get_z();
-        dx3 = 0.5*sqrt(12.0)*sqrt(layer_sorted[2][k].get_size(0,0));
-        dy3 = 0.5*sqrt(12.0)*sqrt(layer_sorted[2][k].get_size(1,1));
-        dz3 = 0.5*sqrt(12.0)*sqrt(layer_sorted[2][k].get_size(2,2));
+        x3 = sorted_hits.x[h3];
+        y3 = sorted_hits.y[h3];
+        z3 = sorted_hits.z[h3];
+        dx3 = sorted_hits.dx[h3];
+        dy3 = sorted_hits.dy[h3];
+        dz3 = sorted_hits.dz[h3];
 
 	// layer of hit
         hit1 = i;
@@ -1198,7 +1259,12 @@ int CellularAutomaton_v1::process_single_track(SimpleTrack3D& track)
           if ((outer_layer - 2) > allowed_missing) continue;
 	  // finish up if required number of layers is reached,
           if ((nlayers - 3) <= allowed_missing) {
-          	complete_segments.push_back(temp_segment);
+          	if (complete_segments.size() == n_complete_segments) {
+          		complete_segments.push_back(temp_segment);
+          	} else {
+          		complete_segments[n_complete_segments] = temp_segment;
+          	}
+          	++n_complete_segments;
           }
           if (next_seg->size() == next_seg_size) { // first new segment
           	next_seg->push_back(temp_segment);
@@ -1224,61 +1290,71 @@ int CellularAutomaton_v1::process_single_track(SimpleTrack3D& track)
 //	ca_chi2_cut_layer = 0.25* ca_chi2_cut;// 2.*0.25 = 0.8 less loose cut after adding all clusters 
 	}
     	next_seg_size = 0;
+
+    // last two hits of the current segments and all (segment, hit) pairs with
+    // increasing layers, in the order of the current segments and then hits
+    seg_ends.resize(cur_seg_size);
+    pair_seg.clear();
+    pair_hit.clear();
     for (unsigned int i = 0; i < cur_seg_size; ++i) {
+      unsigned int h1 = sorted_offset[l - 2] + (*cur_seg)[i].hits[l - 2];
+      unsigned int h2 = sorted_offset[l - 1] + (*cur_seg)[i].hits[l - 1];
+
+      seg_ends.x1[i] = sorted_hits.x[h1];
+      seg_ends.y1[i] = sorted_hits.y[h1];
+      seg_ends.z1[i] = sorted_hits.z[h1];
+      seg_ends.dx1[i] = sorted_hits.dx[h1];
+      seg_ends.dy1[i] = sorted_hits.dy[h1];
+      seg_ends.dz1[i] = sorted_hits.dz[h1];
+      seg_ends.x2[i] = sorted_hits.x[h2];
+      seg_ends.y2[i] = sorted_hits.y[h2];
+      seg_ends.z2[i] = sorted_hits.z[h2];
+      seg_ends.dx2[i] = sorted_hits.dx[h2];
+      seg_ends.dy2[i] = sorted_hits.dy[h2];
+      seg_ends.dz2[i] = sorted_hits.dz[h2];
+      seg_ends.kappa[i] = (*cur_seg)[i].kappa;
+      seg_ends.dkappa[i] = (*cur_seg)[i].dkappa;
+      seg_ends.ux[i] = (*cur_seg)[i].ux;
+      seg_ends.uy[i] = (*cur_seg)[i].uy;
+      seg_ends.chi2[i] = (*cur_seg)[i].chi2;
+
+      unsigned int layer0 = layer_sorted[l - 1][(*cur_seg)[i].hits[l - 1]].get_layer();
+      if (!forward) layer0 = nlayers-layer0-1;
       for (unsigned int j = 0; j < layer_sorted[l].size(); ++j) {
-
-	unsigned int layer0 = layer_sorted[l - 1][(*cur_seg)[i].hits[l - 1]].get_layer();
 	unsigned int layer1 = layer_sorted[l][j].get_layer();
-	if (!forward) 
-	{
-		layer0 = nlayers-layer0-1;
-		layer1 = nlayers-layer1-1;
-	}
+	if (!forward) layer1 = nlayers-layer1-1;
 	if (layer0 >= layer1) continue;
-
-        x1 = layer_sorted[l - 2][(*cur_seg)[i].hits[l - 2]].get_x();
-       	y1 = layer_sorted[l - 2][(*cur_seg)[i].hits[l - 2]].get_y();
-        z1 = layer_sorted[l - 2][(*cur_seg)[i].hits[l - 2]].get_z();
-        x2 = layer_sorted[l - 1][(*cur_seg)[i].hits[l - 1]].get_x();
-        y2 = layer_sorted[l - 1][(*cur_seg)[i].hits[l - 1]].get_y();
-        z2 = layer_sorted[l - 1][(*cur_seg)[i].hits[l - 1]].get_z();
-        x3 = layer_sorted[l][j].get_x();
-        y3 = layer_sorted[l][j].get_y();
-        z3 = layer_sorted[l][j].get_z();
-
-        dx1 = 0.5*sqrt(12.0)*sqrt(layer_sorted[l - 2][(*cur_seg)[i].hits[l - 2]].get_size(0,0));
-        dy1 = 0.5*sqrt(12.0)*sqrt(layer_sorted[l - 2][(*cur_seg)[i].hits[l - 2]].get_size(1,1));
-        dz1 = 0.5*sqrt(12.0)*sqrt(layer_sorted[l - 2][(*cur_seg)[i].hits[l - 2]].get_size(2,2));
-        dx2 = 0.5*sqrt(12.0)*sqrt(layer_sorted[l - 1][(*cur_seg)[i].hits[l - 1]].get_size(0,0));
-        dy2 = 0.5*sqrt(12.0)*sqrt(layer_sorted[l - 1][(*cur_seg)[i].hits[l - 1]].get_size(1,1));
-        dz2 = 0.5*sqrt(12.0)*sqrt(layer_sorted[l - 1][(*cur_seg)[i].hits[l - 1]].get_size(2,2));
-        dx3 = 0.5*sqrt(12.0)*sqrt(layer_sorted[l][j].get_size(0,0));
-        dy3 = 0.5*sqrt(12.0)*sqrt(layer_sorted[l][j].get_size(1,1));
-        dz3 = 0.5*sqrt(12.0)*sqrt(layer_sorted[l][j].get_size(2,2));
-
-        cur_kappa = (*cur_seg)[i].kappa;
-        cur_dkappa = (*cur_seg)[i].dkappa;
-        cur_ux = (*cur_seg)[i].ux;
-        cur_uy = (*cur_seg)[i].uy;
-        cur_chi2 = (*cur_seg)[i].chi2;
-
-        which_seg = i;
-        hit1 = j;
-
-	calculate_kappa_tangents(
-              x1, y1, z1, x2, y2, z2, x3, y3, z3, 
-	      dx1, dy1, dz1, dx2, dy2, dz2, dx3, dy3, dz3, 
-	      kappa, dkappa, ux_mid, uy_mid, ux_end, uy_end, 
-	      dzdl_1, dzdl_2, ddzdl_1, ddzdl_2, 
-	      ca_sin_ang_cut, ca_cos_ang_cut_diff_inv,
-              cur_kappa, cur_dkappa, cur_ux, cur_uy, cur_chi2, chi2);
+	pair_seg.push_back(i);
+	pair_hit.push_back(sorted_offset[l] + j);
+      }
+    }
+    unsigned int npairs = pair_seg.size();
+
+    // chi2 of all extensions of this layer in one pass
+    pair_chi2.resize(npairs);
+    pair_kappa.resize(npairs);
+    pair_dkappa.resize(npairs);
+    pair_ux.resize(npairs);
+    pair_uy.resize(npairs);
+    extend_segments(npairs, pair_seg.data(), pair_hit.data(), seg_ends, sorted_hits,
+                    ca_sin_ang_cut, ca_cos_ang_cut_diff_inv,
+                    pair_chi2.data(), pair_kappa.data(), pair_dkappa.data(),
+                    pair_ux.data(), pair_uy.data());
+
+    for (unsigned int p = 0; p < npairs; ++p) {
+        which_seg = pair_seg[p];
+        hit1 = pair_hit[p] - sorted_offset[l];
+        chi2 = pair_chi2[p];
+        kappa = pair_kappa[p];
+        dkappa = pair_dkappa[p];
+        ux_end = pair_ux[p];
+        uy_end = pair_uy[p];
 
 #ifdef _DEBUG_
 	cout<<"Extended layers for segment "<<which_seg<<endl;
 	cout<<"kappa "<<kappa<< " dkappa "<<dkappa
-	<<" ux_mid "<<ux_mid<<" uy_mid "<<" ux_end "<<ux_end<<" uy_end " <<uy_end
-	<<" dzdl_1 "<<dzdl_1<<" dzdl_2 "<<dzdl_2<<" ddzdl_1 "<<ddzdl_1<<" ddzdl_2 "<<ddzdl_2
-	<<" cur_chi2 "<<cur_chi2<<" chi2 "<<chi2<<" chi2*inv_layer "<<l <<" "<<chi2*inv_layer[l]
+	<<" ux_end "<<ux_end<<" uy_end " <<uy_end
+	<<" chi2 "<<chi2<<" chi2*inv_layer "<<l <<" "<<chi2*inv_layer[l]
 	<<" chi2_cut" <<ca_chi2_layer_cut<<endl;
 #endif
 	if (chi2 * inv_layer[l] < ca_chi2_layer_cut) {
@@ -1298,7 +1374,12 @@ int CellularAutomaton_v1::process_single_track(SimpleTrack3D& track)
               temp_segment.n_hits = l + 1;
 	      // finish up if required number of layers is reached
               if ((nlayers - (l + 1)) <= allowed_missing) {
-                complete_segments.push_back(temp_segment);
+                if (complete_segments.size() == n_complete_segments) {
+                  complete_segments.push_back(temp_segment);
+                } else {
+                  complete_segments[n_complete_segments] = temp_segment;
+                }
+                ++n_complete_segments;
               }
 	      // make sure we have required number of layers with hits
               if ((outer_layer - l) > allowed_missing) {
@@ -1312,8 +1393,7 @@ int CellularAutomaton_v1::process_single_track(SimpleTrack3D& track)
                 next_seg_size += 1;
               }
          }
-      }// j 
-    }// i
+    }// (segment, hit) pairs
 
     swap(cur_seg, next_seg);
     swap(cur_seg_size, next_seg_size);
@@ -1324,7 +1404,7 @@ int CellularAutomaton_v1::process_single_track(SimpleTrack3D& track)
   //cout<<"number of current segments : "<< cur_seg_size<<endl;
 
   // copy complete segments over to current segments
-  for (unsigned int i = 0; i < complete_segments.size(); ++i) {
+  for (unsigned int i = 0; i < n_complete_segments; ++i) {
     if (cur_seg->size() == cur_seg_size) {
       cur_seg->push_back(complete_segments[i]);
       ++cur_seg_size;
@@ -1529,10 +1609,6 @@ int CellularAutomaton_v1::process_single_track(SimpleTrack3D& track)
 	}
 	}
 
-        segments1.clear();
-        segments2.clear();
-
-
   return 1;
 }
 
@@ -35,6 +35,41 @@ class TrackSegment {
   unsigned int n_hits;
 };
 
+//! hits of one layer as flat arrays, in the order they are scanned by the CA
+class LayerHitTable {
+ public:
+  void clear() {
+    id.clear();
+    x.clear(); y.clear(); z.clear();
+    dx.clear(); dy.clear(); dz.clear();
+    phi.clear();
+  }
+  unsigned int size() const { return id.size(); }
+
+  std::vector<unsigned int> id;
+  std::vector<float> x, y, z;
+  std::vector<float> dx, dy, dz; // hit errors used by calculate_kappa_tangents
+  std::vector<float> phi;        // shift_phi_range(atan2(y,x))
+};
+
+//! last two hits and kappa, direction and chi2 of the current segments
+class SegmentEndTable {
+ public:
+  void resize(unsigned int n) {
+    x1.resize(n); y1.resize(n); z1.resize(n);
+    dx1.resize(n); dy1.resize(n); dz1.resize(n);
+    x2.resize(n); y2.resize(n); z2.resize(n);
+    dx2.resize(n); dy2.resize(n); dz2.resize(n);
+    kappa.resize(n); dkappa.resize(n);
+    ux.resize(n); uy.resize(n); chi2.resize(n);
+  }
+
+  std::vector<float> x1, y1, z1, dx1, dy1, dz1;
+  std::vector<float> x2, y2, z2, dx2, dy2, dz2;
+  std::vector<float> kappa, dkappa;
+  std::vector<float> ux, uy;
+  std::vector<float> chi2;
+};
 
 
 class CellularAutomaton_v1 : public CellularAutomaton {
@@ -69,6 +104,8 @@ class CellularAutomaton_v1 : public CellularAutomaton {
 	void set_seeding_mode(bool mod) {seeding_mode = mod;}
 	void set_hits_map(std::map<unsigned int, SimpleHit3D>& hits_map){_hits_map = hits_map;}
 	void set_verbose(int v) {verbose = v;}
+	//! new input for the next run(), the hit tables and segment buffers are kept
+	void set_input_tracks(std::vector<SimpleTrack3D>& input_tracks);
 
 	int run(std::vector<SimpleTrack3D>& output_tracks, std::vector<HelixKalmanState>& output_track_states, std::map<unsigned int, bool>& hits_used);	
 
@@ -77,8 +114,10 @@ class CellularAutomaton_v1 : public CellularAutomaton {
 
 	void set_detector_radii(std::vector<float>& radii);
 	void set_detector_materials(std::vector<float>& materials);
-	void set_input_tracks(std::vector<SimpleTrack3D>& input_tracks);
 	void set_cylinder_kalman();
+	void fill_layer_hits();
+	void fill_sorted_hits(unsigned int n_sorted_layers);
+	void add_table_hit(LayerHitTable& table, const SimpleHit3D& hit);
 
 	int init();
 	int process_tracks();
@@ -119,6 +158,26 @@ class CellularAutomaton_v1 : public CellularAutomaton {
   	std::set<std::vector<unsigned int> > combos;
         std::vector<std::vector<SimpleHit3D> > layer_sorted;
 
+	// buffers reused for all seeds and events, they only grow
+	std::vector<TrackSegment> segments1;
+	std::vector<TrackSegment> segments2;
+	std::vector<TrackSegment> complete_segments;
+	unsigned int n_complete_segments;
+	std::vector<float> inv_layer;
+	std::vector<LayerHitTable> layer_hits; // _hits_map split by layer
+	LayerHitTable sorted_hits;             // flat copy of layer_sorted
+	std::vector<unsigned int> sorted_offset;
+	SegmentEndTable seg_ends;
+
+	// one entry per (segment, hit) pair tested in an extension step
+	std::vector<unsigned int> pair_seg;
+	std::vector<unsigned int> pair_hit;
+	std::vector<float> pair_chi2;
+	std::vector<float> pair_kappa;
+	std::vector<float> pair_dkappa;
+	std::vector<float> pair_ux;
+	std::vector<float> pair_uy;
+
 	unsigned int nlayers; // number of layers for seeding
 	unsigned int rlayers; // number of layers with hits required for seeding
 	unsigned int allowed_missing_inner_hits;
@@ -0,0 +1,322 @@
+// Copyright CERN and copyright holders of ALICE O2. This software is
+// distributed under the terms of the GNU General Public License v3 (GPL
+// Version 3), copied verbatim in the file "COPYING".
+//
+// See http://alice-o2.web.cern.ch/license for full licensing information.
+//
+// In applying this license CERN does not waive the privileges and immunities
+// granted to it by virtue of its status as an Intergovernmental Organization
+// or submit itself to any jurisdiction.
+
+/// \file GPUTPCTrackParamBatch.cxx
+/// \author Sergey Gorbunov, Ivan Kisel, David Rohr
+
+#include "GPUTPCTrackParamBatch.h"
+
+#include "GPUTPCTrackLinearisation.h"
+#include "GPUTPCTrackParam.h"
+
+#include <algorithm>
+#include <cmath>
+
+//
+// The loops below are the GPUTPCTrackParam methods with the linearisation
+// t0, written for one track index i. All checks of a step are combined
+// into one condition, evaluated before the track is touched.
+//
+
+void GPUTPCTrackParamBatch::Resize(unsigned int n)
+{
+  mX.resize(n);
+  mZOffset.resize(n);
+  for (int j = 0; j < 5; j++) {
+    mP[j].resize(n);
+  }
+  for (int j = 0; j < 15; j++) {
+    mC[j].resize(n);
+  }
+  mSignCosPhi.resize(n);
+  mChi2.resize(n);
+  mNDF.resize(n);
+  mSinPhi0.resize(n);
+  mCosPhi0.resize(n);
+  mDzDs0.resize(n);
+  mQPt0.resize(n);
+  mOK.resize(n, 0);
+}
+
+void GPUTPCTrackParamBatch::Set(unsigned int i, const GPUTPCTrackParam& t, const GPUTPCTrackLinearisation& t0)
+{
+  mX[i] = t.GetX();
+  mZOffset[i] = t.GetParam().GetZOffset();
+  for (int j = 0; j < 5; j++) {
+    mP[j][i] = t.GetPar(j);
+  }
+  for (int j = 0; j < 15; j++) {
+    mC[j][i] = t.GetCov(j);
+  }
+  mSignCosPhi[i] = t.GetSignCosPhi();
+  mChi2[i] = t.GetChi2();
+  mNDF[i] = t.GetNDF();
+  mSinPhi0[i] = t0.SinPhi();
+  mCosPhi0[i] = t0.CosPhi();
+  mDzDs0[i] = t0.DzDs();
+  mQPt0[i] = t0.QPt();
+  mOK[i] = 1;
+}
+
+void GPUTPCTrackParamBatch::Get(unsigned int i, GPUTPCTrackParam& t, GPUTPCTrackLinearisation& t0) const
+{
+  t.SetX(mX[i]);
+  t.SetZOffset(mZOffset[i]);
+  for (int j = 0; j < 5; j++) {
+    t.SetPar(j, mP[j][i]);
+  }
+  for (int j = 0; j < 15; j++) {
+    t.SetCov(j, mC[j][i]);
+  }
+  t.SetSignCosPhi(mSignCosPhi[i]);
+  t.SetChi2(mChi2[i]);
+  t.SetNDF(mNDF[i]);
+  t0.Set(mSinPhi0[i], mCosPhi0[i], mDzDs0[i], mQPt0[i]);
+}
+
+void GPUTPCTrackParamBatch::Rotate(const float* alpha, float maxSinPhi)
+{
+  //* Rotate the coordinate system in XY on the angle alpha[i] for every track
+
+  const unsigned int n = Size();
+  float* X = mX.data();
+  float* Y = mP[0].data();
+  float* SinPhi = mP[2].data();
+  float* sinPhi0 = mSinPhi0.data();
+  float* cosPhi0 = mCosPhi0.data();
+  float* C0 = mC[0].data();
+  float* C1 = mC[1].data();
+  float* C3 = mC[3].data();
+  float* C4 = mC[4].data();
+  float* C5 = mC[5].data();
+  float* C6 = mC[6].data();
+  float* C8 = mC[8].data();
+  float* C10 = mC[10].data();
+  float* C12 = mC[12].data();
+  unsigned char* ok = mOK.data();
+
+  for (unsigned int i = 0; i < n; i++) {
+    float cA = cos(alpha[i]);
+    float sA = sin(alpha[i]);
+    float x0 = X[i], y0 = Y[i], sP = sinPhi0[i], cP = cosPhi0[i];
+    float cosPhi = cP * cA + sP * sA;
+    float sinPhi = -cP * sA + sP * cA;
+
+    bool good = ok[i] && !(std::abs(sinPhi) > maxSinPhi || std::abs(cosPhi) < 1.e-2f || std::abs(cP) < 1.e-2f);
+    if (!good) {
+      ok[i] = 0;
+      continue;
+    }
+
+    float j0 = cP / cosPhi;
+    float j2 = cosPhi / cP;
+    float d1 = SinPhi[i] - sP;
+
+    X[i] = x0 * cA + y0 * sA;
+    Y[i] = -x0 * sA + y0 * cA;
+    cosPhi0[i] = cosPhi;
+    sinPhi0[i] = sinPhi;
+
+    SinPhi[i] = sinPhi + j2 * d1;
+
+    C0[i] *= j0 * j0;
+    C1[i] *= j0;
+    C3[i] *= j0;
+    C6[i] *= j0;
+    C10[i] *= j0;
+
+    C3[i] *= j2;
+    C4[i] *= j2;
+    C5[i] *= j2 * j2;
+    C8[i] *= j2;
+    C12[i] *= j2;
+  }
+}
+
+void GPUTPCTrackParamBatch::TransportToX(const float* x, float Bz, float maxSinPhi)
+{
+  //* Transport the track parameters to X=x[i], using the linearisation of each track
+  //* and the field value Bz. The linearisation is transported as well.
+
+  const unsigned int n = Size();
+  float* X = mX.data();
+  float* P0 = mP[0].data();
+  float* P1 = mP[1].data();
+  float* P2 = mP[2].data();
+  const float* P3 = mP[3].data();
+  const float* P4 = mP[4].data();
+  float* sinPhi0 = mSinPhi0.data();
+  float* cosPhi0 = mCosPhi0.data();
+  const float* dzds0 = mDzDs0.data();
+  const float* qpt0 = mQPt0.data();
+  float* C[15];
+  for (int j = 0; j < 15; j++) {
+    C[j] = mC[j].data();
+  }
+  unsigned char* ok = mOK.data();
+
+  for (unsigned int i = 0; i < n; i++) {
+    float ex = cosPhi0[i];
+    float ey = sinPhi0[i];
+    float k = -qpt0[i] * Bz;
+    float dx = x[i] - X[i];
+
+    float ey1 = k * dx + ey;
+    float ex1 = std::sqrt(std::max(0.f, 1 - ey1 * ey1));
+    if (ex < 0) {
+      ex1 = -ex1;
+    }
+
+    float dx2 = dx * dx;
+    float ss = ey + ey1;
+    float cc = ex + ex1;
+
+    // check for intersection with X=x
+    bool good = ok[i] && !(std::abs(ey1) > maxSinPhi) &&
+                !(std::abs(cc) < 1.e-4f || std::abs(ex) < 1.e-4f || std::abs(ex1) < 1.e-4f);
+    if (!good) {
+      ok[i] = 0;
+      continue;
+    }
+
+    float tg = ss / cc;  // tanf((phi1+phi)/2)
+
+    float dy = dx * tg;
+    float dl = dx * std::sqrt(1 + tg * tg);
+
+    if (cc < 0) {
+      dl = -dl;
+    }
+    float dSin = std::min(1.f, std::max(-1.f, dl * k / 2));
+    float dS = (std::abs(k) > 1.e-4f) ? (2 * asin(dSin) / k) : dl;
+    float dz = dS * dzds0[i];
+
+    float cci = 1.f / cc;
+    float exi = 1.f / ex;
+    float ex1i = 1.f / ex1;
+
+    float d2 = P2[i] - ey;
+    float d3 = P3[i] - dzds0[i];
+    float d4 = P4[i] - qpt0[i];
+
+    float h2 = dx * (1 + ey * ey1 + ex * ex1) * exi * ex1i * cci;
+    float h4 = dx2 * (cc + ss * ey1 * ex1i) * cci * cci * (-Bz);
+    float dxBz = dx * (-Bz);
+
+    cosPhi0[i] = ex1;
+    sinPhi0[i] = ey1;
+
+    X[i] = X[i] + dx;
+    P0[i] = P0[i] + dy + h2 * d2 + h4 * d4;
+    P1[i] = P1[i] + dz + dS * d3;
+    P2[i] = ey1 + d2 + dxBz * d4;
+
+    float c00 = C[0][i];
+    float c10 = C[1][i];
+    float c11 = C[2][i];
+    float c20 = C[3][i];
+    float c21 = C[4][i];
+    float c22 = C[5][i];
+    float c30 = C[6][i];
+    float c31 = C[7][i];
+    float c32 = C[8][i];
+    float c33 = C[9][i];
+    float c40 = C[10][i];
+    float c41 = C[11][i];
+    float c42 = C[12][i];
+    float c43 = C[13][i];
+    float c44 = C[14][i];
+
+    C[0][i] = c00 + h2 * h2 * c22 + h4 * h4 * c44 + 2 * (h2 * c20 + h4 * c40 + h2 * h4 * c42);
+
+    C[1][i] = c10 + h2 * c21 + h4 * c41 + dS * (c30 + h2 * c32 + h4 * c43);
+    C[2][i] = c11 + 2 * dS * c31 + dS * dS * c33;
+
+    C[3][i] = c20 + h2 * c22 + h4 * c42 + dxBz * (c40 + h2 * c42 + h4 * c44);
+    C[4][i] = c21 + dS * c32 + dxBz * (c41 + dS * c43);
+    C[5][i] = c22 + 2 * dxBz * c42 + dxBz * dxBz * c44;
+
+    C[6][i] = c30 + h2 * c32 + h4 * c43;
+    C[7][i] = c31 + dS * c33;
+    C[8][i] = c32 + dxBz * c43;
+
+    C[10][i] = c40 + h2 * c42 + h4 * c44;
+    C[11][i] = c41 + dS * c43;
+    C[12][i] = c42 + dxBz * c44;
+  }
+}
+
+void GPUTPCTrackParamBatch::Filter(const float* y, const float* z, const float* err2Y, const float* err2Z, float maxSinPhi)
+{
+  //* Add the y[i],z[i] measurement to every track with the Kalman filter
+
+  const unsigned int n = Size();
+  float* P[5];
+  for (int j = 0; j < 5; j++) {
+    P[j] = mP[j].data();
+  }
+  float* C[15];
+  for (int j = 0; j < 15; j++) {
+    C[j] = mC[j].data();
+  }
+  float* chi2 = mChi2.data();
+  int* ndf = mNDF.data();
+  unsigned char* ok = mOK.data();
+
+  for (unsigned int i = 0; i < n; i++) {
+    float c00 = C[0][i], c11 = C[2][i], c20 = C[3][i], c31 = C[7][i], c40 = C[10][i];
+
+    float s2y = err2Y[i] + c00;
+    float s2z = err2Z[i] + c11;
+
+    float z0 = y[i] - P[0][i], z1 = z[i] - P[1][i];
+
+    float mS0 = 1.f / s2y;
+    float mS2 = 1.f / s2z;
+
+    // K = CHtS
+
+    float k00 = c00 * mS0;
+    float k20 = c20 * mS0;
+    float k40 = c40 * mS0;
+
+    float k11 = c11 * mS2;
+    float k31 = c31 * mS2;
+
+    float sinPhi = P[2][i] + k20 * z0;
+
+    bool good = ok[i] && !(s2y < 1.e-8f || s2z < 1.e-8f) &&
+                !(maxSinPhi > 0 && std::abs(sinPhi) >= maxSinPhi);
+    if (!good) {
+      ok[i] = 0;
+      continue;
+    }
+
+    P[0][i] += k00 * z0;
+    P[1][i] += k11 * z1;
+    P[2][i] = sinPhi;
+    P[3][i] += k31 * z1;
+    P[4][i] += k40 * z0;
+
+    ndf[i] += 2;
+    chi2[i] += mS0 * z0 * z0 + mS2 * z1 * z1;
+
+    C[0][i] -= k00 * c00;
+    C[3][i] -= k20 * c00;
+    C[5][i] -= k20 * c20;
+    C[10][i] -= k40 * c00;
+    C[12][i] -= k40 * c20;
+    C[14][i] -= k40 * c40;
+
+    C[2][i] -= k11 * c11;
+    C[7][i] -= k31 * c11;
+    C[9][i] -= k31 * c31;
+  }
+}
@@ -0,0 +1,89 @@
+// Copyright CERN and copyright holders of ALICE O2. This software is
+// distributed under the terms of the GNU General Public License v3 (GPL
+// Version 3), copied verbatim in the file "COPYING".
+//
+// See http://alice-o2.web.cern.ch/license for full licensing information.
+//
+// In applying this license CERN does not waive the privileges and immunities
+// granted to it by virtue of its status as an Intergovernmental Organization
+// or submit itself to any jurisdiction.
+
+/// \file GPUTPCTrackParamBatch.h
+/// \author Sergey Gorbunov, Ivan Kisel, David Rohr
+
+#ifndef GPUTPCTRACKPARAMBATCH_H
+#define GPUTPCTRACKPARAMBATCH_H
+
+#include "GPUTPCBaseTrackParam.h"
+
+#include <vector>
+
+class GPUTPCTrackLinearisation;
+class GPUTPCTrackParam;
+
+/**
+ * @class GPUTPCTrackParamBatch
+ *
+ * N GPUTPCTrackParam track states together with their linearisation points,
+ * stored as structure of arrays (one array per parameter and covariance
+ * element), so the same step can be applied to all tracks in one loop.
+ *
+ * Rotate, TransportToX and Filter do for each track exactly what the
+ * GPUTPCTrackParam methods of the same name do with the linearisation
+ * t0. The inputs are arrays with one entry per track.
+ * A track for which a step fails is left unchanged and flagged as not OK,
+ * later steps skip it until it is Set() again.
+ *
+ * PHCASeeding fits all its seeds with one batch. The per track kernels only
+ * work on plain float arrays; a GPU port would still need its own memory
+ * handling and is not provided.
+ */
+class GPUTPCTrackParamBatch
+{
+ public:
+  explicit GPUTPCTrackParamBatch(unsigned int n = 0) { Resize(n); }
+
+  void Resize(unsigned int n);
+  unsigned int Size() const { return mX.size(); }
+
+  //! copy track i in and out of the batch
+  void Set(unsigned int i, const GPUTPCTrackParam& t, const GPUTPCTrackLinearisation& t0);
+  void Get(unsigned int i, GPUTPCTrackParam& t, GPUTPCTrackLinearisation& t0) const;
+
+  //! false if one of the steps failed for track i
+  bool OK(unsigned int i) const { return mOK[i]; }
+
+  void Rotate(const float* alpha, float maxSinPhi = GPUCA_MAX_SIN_PHI);
+  void TransportToX(const float* x, float Bz, float maxSinPhi = GPUCA_MAX_SIN_PHI);
+  void Filter(const float* y, const float* z, const float* err2Y, const float* err2Z, float maxSinPhi = GPUCA_MAX_SIN_PHI);
+
+  float X(unsigned int i) const { return mX[i]; }
+  float Y(unsigned int i) const { return mP[0][i]; }
+  float Z(unsigned int i) const { return mP[1][i]; }
+  float SinPhi(unsigned int i) const { return mP[2][i]; }
+  float DzDs(unsigned int i) const { return mP[3][i]; }
+  float QPt(unsigned int i) const { return mP[4][i]; }
+  float Chi2(unsigned int i) const { return mChi2[i]; }
+  int NDF(unsigned int i) const { return mNDF[i]; }
+  float Cov(unsigned int i, int j) const { return mC[j][i]; }
+
+ private:
+  // track parameters
+  std::vector<float> mX;
+  std::vector<float> mZOffset;
+  std::vector<float> mP[5];
+  std::vector<float> mC[15];
+  std::vector<float> mSignCosPhi;
+  std::vector<float> mChi2;
+  std::vector<int> mNDF;
+
+  // linearisation points
+  std::vector<float> mSinPhi0;
+  std::vector<float> mCosPhi0;
+  std::vector<float> mDzDs0;
+  std::vector<float> mQPt0;
+
+  std::vector<unsigned char> mOK;
+};
+
+#endif // GPUTPCTRACKPARAMBATCH_H
@@ -463,24 +463,11 @@ void MakeActsGeometry::makeTpcMapPairs(TrackingVolumePtr &tpcVolume)
 	
 	  TrkrDefs::hitsetkey hitsetkey = getTpcHitSetKeyFromCoords(world_center);
 
-	  /// If there is already an entry for this hitsetkey, add the surface
-	  /// to its corresponding vector
-	  std::map<TrkrDefs::hitsetkey, std::vector<Surface>>::iterator mapIter;
-	  mapIter = m_clusterSurfaceMapTpcEdit.find(hitsetkey);
-	  
-	  if(mapIter != m_clusterSurfaceMapTpcEdit.end())
-	    {
-	      mapIter->second.push_back(surf);
-	    }
-	  else
-	    {
-	      /// Otherwise make a new map entry
-	      std::vector<Surface> dumvec;
-	      dumvec.push_back(surf);
-	      std::pair<TrkrDefs::hitsetkey, std::vector<Surface>> tmp = 
-		std::make_pair(hitsetkey, dumvec);
-	      m_clusterSurfaceMapTpcEdit.insert(tmp);
-	    }
+	  /// Add the surface to the vector of its hitsetkey, a new map
+	  /// entry is made if there is none yet
+	  m_clusterSurfaceMapTpcEdit[hitsetkey].push_back(surf);
+	  m_clusterSurfaceCenterTpc[hitsetkey].push_back(
+	    std::make_pair(atan2(world_center[1], world_center[0]), world_center[2]));
 	  
 	}
     }
@@ -547,7 +534,7 @@ void MakeActsGeometry::makeInttMapPairs(TrackingVolumePtr &inttVolume)
 
         std::cout << "Layer radius " << layer_rad << " layer " << layer << " ladderPhi " << ladderPhi << " ladderZ " << ladderZ
                   << " recover surface from m_clusterSurfaceMapSilicon " << std::endl;
-        std::map<TrkrDefs::hitsetkey, Surface>::iterator surf_iter = m_clusterSurfaceMapSilicon.find(hitsetkey);
+        auto surf_iter = m_clusterSurfaceMapSilicon.find(hitsetkey);
         std::cout << " surface type " << surf->type() << std::endl;
         surf_iter->second->toStream(m_geoCtxt, std::cout);
         auto assoc_layer = surf->associatedLayer();
@@ -627,7 +614,7 @@ void MakeActsGeometry::makeMvtxMapPairs(TrackingVolumePtr &mvtxVolume)
         // check it is in there
         std::cout << "Layer radius " << layer_rad << " Layer " << layer << " stave " << stave << " chip " << chip
                   << " recover surface from m_clusterSurfaceMapSilicon " << std::endl;
-        std::map<TrkrDefs::hitsetkey, Surface>::iterator surf_iter = m_clusterSurfaceMapSilicon.find(hitsetkey);
+        auto surf_iter = m_clusterSurfaceMapSilicon.find(hitsetkey);
         std::cout << " surface type " << surf_iter->second->type() << std::endl;
         surf_iter->second->toStream(m_geoCtxt, std::cout);
         auto assoc_layer = surf->associatedLayer();
@@ -651,8 +638,7 @@ void MakeActsGeometry::makeMvtxMapPairs(TrackingVolumePtr &mvtxVolume)
 
 Surface MakeActsGeometry::getTpcSurfaceFromCoords(TrkrDefs::hitsetkey hitsetkey, std::vector<double> &world)
 {
-  std::map<TrkrDefs::hitsetkey, std::vector<Surface>>::iterator mapIter;
-  mapIter = m_clusterSurfaceMapTpcEdit.find(hitsetkey);
+  auto mapIter = m_clusterSurfaceMapTpcEdit.find(hitsetkey);
   
   if(mapIter == m_clusterSurfaceMapTpcEdit.end())
     {
@@ -663,19 +649,14 @@ Surface MakeActsGeometry::getTpcSurfaceFromCoords(TrkrDefs::hitsetkey hitsetkey,
   double world_phi = atan2(world[1], world[0]);
   double world_z = world[2];
   
-  std::vector<Surface> surf_vec = mapIter->second;
+  const std::vector<Surface> &surf_vec = mapIter->second;
+  const std::vector<std::pair<double, double>> &surf_centers = 
+    m_clusterSurfaceCenterTpc.find(hitsetkey)->second;
   unsigned int surf_index = 999;
   for(unsigned int i=0;i<surf_vec.size(); ++i)
     {
-      Surface this_surf = surf_vec[i];
-      /*
-      cout << endl << "Stream of surface number " << i << endl;
-      this_surf->toStream(m_geoCtxt, std::cout);   cout << endl;
-  */
-      auto vec3d = this_surf->center(m_geoCtxt);
-      std::vector<double> surf_center = {vec3d(0) / 10.0, vec3d(1) / 10.0, vec3d(2) / 10.0};  // convert from mm to cm
-      double surf_phi = atan2(surf_center[1], surf_center[0]);
-      double surf_z = surf_center[2];
+      double surf_phi = surf_centers[i].first;
+      double surf_z = surf_centers[i].second;
       if( (world_phi > surf_phi - m_surfStepPhi / 2.0 && world_phi < surf_phi + m_surfStepPhi / 2.0 ) &&
 	  (world_z > surf_z -m_surfStepZ / 2.0 && world_z < surf_z + m_surfStepZ / 2.0) )
 	{
@@ -26,6 +26,8 @@
 #include <map>
 #include <memory>            
 #include <string>
+#include <unordered_map>
+#include <utility>
 #include <vector>
 
 class PHCompositeNode;
@@ -75,13 +77,15 @@ class MakeActsGeometry
   void setVerbosity(int verbosity)
   { m_verbosity = verbosity; }
 
-  std::map<TrkrDefs::hitsetkey,Surface> getSurfaceMapSilicon()
+  /// The lookup tables are returned by reference, the source link
+  /// making queries them for every cluster
+  const std::unordered_map<TrkrDefs::hitsetkey, Surface>& getSurfaceMapSilicon() const
     { return m_clusterSurfaceMapSilicon; }
   
-  std::map<TrkrDefs::hitsetkey, std::vector<Surface>> getSurfaceMapTpc()
+  const std::unordered_map<TrkrDefs::hitsetkey, std::vector<Surface>>& getSurfaceMapTpc() const
     { return m_clusterSurfaceMapTpcEdit; }
   
-  std::map<TrkrDefs::hitsetkey, TGeoNode*> getTGeoNodeMap()
+  const std::unordered_map<TrkrDefs::hitsetkey, TGeoNode*>& getTGeoNodeMap() const
     { return m_clusterNodeMap; }
    
   std::vector<std::shared_ptr<FW::IContextDecorator>> getContextDecorators()
@@ -148,9 +152,12 @@ class MakeActsGeometry
   std::vector<std::shared_ptr<FW::IContextDecorator> > m_contextDecorators;
 
   /// Several maps that connect Acts world to sPHENIX G4 world 
-  std::map<TrkrDefs::hitsetkey, TGeoNode*> m_clusterNodeMap;
-  std::map<TrkrDefs::hitsetkey, Surface> m_clusterSurfaceMapSilicon;
-  std::map<TrkrDefs::hitsetkey, std::vector<Surface>> m_clusterSurfaceMapTpcEdit;
+  std::unordered_map<TrkrDefs::hitsetkey, TGeoNode*> m_clusterNodeMap;
+  std::unordered_map<TrkrDefs::hitsetkey, Surface> m_clusterSurfaceMapSilicon;
+  std::unordered_map<TrkrDefs::hitsetkey, std::vector<Surface>> m_clusterSurfaceMapTpcEdit;
+  /// (phi, z) of the center of each surface in m_clusterSurfaceMapTpcEdit,
+  /// same order, so the surface search does not recompute them per cluster
+  std::unordered_map<TrkrDefs::hitsetkey, std::vector<std::pair<double, double>>> m_clusterSurfaceCenterTpc;
   std::map<TrkrDefs::cluskey, Surface> m_clusterSurfaceMapTpc;
   
   /// These don't change, we are building the tpc this way!
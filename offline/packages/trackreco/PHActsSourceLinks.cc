@@ -39,15 +39,12 @@
 
 /// Root includes
 #include <TGeoNode.h>
-#include <TMatrixDSym.h>
-#include <TMatrixT.h>
 #include <TVector3.h>
 
 PHActsSourceLinks::PHActsSourceLinks(const std::string &name)
   : SubsysReco(name)
   , m_clusterMap(nullptr)
   , m_actsGeometry(nullptr)
-  , m_hitIdClusKey(nullptr)
   , m_sourceLinks(nullptr)
   , m_geomContainerMvtx(nullptr)
   , m_geomContainerIntt(nullptr)
@@ -73,6 +70,10 @@ int PHActsSourceLinks::InitRun(PHCompositeNode *topNode)
   /// Check and create nodes that this module will build
   createNodes(topNode);
 
+  /// The frames are rebuilt with the geometry of this run
+  m_siliconFrames.clear();
+  m_tpcSurfaceCenters.clear();
+
   /// Check if Acts geometry has been built and is on the node tree
   m_actsGeometry = new MakeActsGeometry();
   
@@ -108,6 +109,9 @@ int PHActsSourceLinks::process_event(PHCompositeNode *topNode)
   /// unsigned int which Acts can take
   unsigned int hitId = 0;
 
+  m_sourceLinks->clear();
+  m_sourceLinks->reserve(m_clusterMap->size());
+
   TrkrClusterContainer::ConstRange clusRange = m_clusterMap->getClusters();
   TrkrClusterContainer::ConstIterator clusIter;
 
@@ -118,13 +122,11 @@ int PHActsSourceLinks::process_event(PHCompositeNode *topNode)
 
     const unsigned int layer = TrkrDefs::getLayer(clusKey);
 
-    /// Create the clusKey hitId pair to insert into the map
     const unsigned int trkrId = TrkrDefs::getTrkrId(clusKey);
-    m_hitIdClusKey->insert(std::pair<TrkrDefs::cluskey, unsigned int>(clusKey, hitId));
 
     /// Local coordinates and surface to be set by the correct tracking
     /// detector function below
-    TMatrixD localErr(3, 3);
+    Acts::ActsSymMatrixD<3> localErr = Acts::ActsSymMatrixD<3>::Zero();
     double local2D[2] = {0};
     Surface surface;
 
@@ -165,6 +167,7 @@ int PHActsSourceLinks::process_event(PHCompositeNode *topNode)
                 << std::endl
                 << "Skipping this cluster"
                 << std::endl;
+      continue;
     }
 
     /// ====================================================
@@ -175,10 +178,10 @@ int PHActsSourceLinks::process_event(PHCompositeNode *topNode)
 
     /// Get the 2D location covariance uncertainty for the cluster
     Acts::BoundMatrix cov = Acts::BoundMatrix::Zero();
-    cov(Acts::eLOC_0, Acts::eLOC_0) = localErr[0][0];
-    cov(Acts::eLOC_1, Acts::eLOC_0) = localErr[1][0];
-    cov(Acts::eLOC_0, Acts::eLOC_1) = localErr[0][1];
-    cov(Acts::eLOC_1, Acts::eLOC_1) = localErr[1][1];
+    cov(Acts::eLOC_0, Acts::eLOC_0) = localErr(0, 0);
+    cov(Acts::eLOC_1, Acts::eLOC_0) = localErr(1, 0);
+    cov(Acts::eLOC_0, Acts::eLOC_1) = localErr(0, 1);
+    cov(Acts::eLOC_1, Acts::eLOC_1) = localErr(1, 1);
 
     /// local and localErr contain the position and covariance
     /// matrix in local coords
@@ -213,25 +216,23 @@ int PHActsSourceLinks::process_event(PHCompositeNode *topNode)
     SourceLink sourceLink(hitId, surface, loc, cov);
 
     /// Add the sourceLink to the container
-    m_sourceLinks->insert(std::pair<unsigned int, SourceLink>(hitId, sourceLink));
+    m_sourceLinks->add(clusKey, sourceLink);
 
     hitId++;
   }
 
+  /// Group the source links by surface for the track finding
+  m_sourceLinks->finalize();
+
   if (Verbosity() > 10)
   {
-    //m_hitIdClusKey
-    std::map<TrkrDefs::cluskey, unsigned int>::iterator it = m_hitIdClusKey->begin();
-    while (it != m_hitIdClusKey->end())
+    for (unsigned int i = 0; i < m_sourceLinks->size(); ++i)
     {
-      std::cout << "cluskey " << it->first << " has hitid " << it->second
+      std::cout << "cluskey " << m_sourceLinks->getClusKey(i) << " has hitid " << i
                 << std::endl;
-      ++it;
     }
   }
 
-  /// Add the data to the nodes that were previously created (?)
-
   return Fun4AllReturnCodes::EVENT_OK;
 }
 
@@ -246,7 +247,7 @@ int PHActsSourceLinks::End(PHCompositeNode *topNode)
 }
 
 Surface PHActsSourceLinks::getTpcLocalCoords(double (&local2D)[2],
-                                             TMatrixD &localErr,
+                                             Acts::ActsSymMatrixD<3> &localErr,
                                              const TrkrCluster *cluster,
                                              const TrkrDefs::cluskey clusKey)
 {
@@ -254,17 +255,6 @@ Surface PHActsSourceLinks::getTpcLocalCoords(double (&local2D)[2],
   const float y = cluster->getPosition(1);
   const float z = cluster->getPosition(2);
 
-  // In local coords the covariances are in the  r*phi vs z frame
-  // They have been rotated into global coordinates in TrkrCluster
-  TMatrixD worldErr(3, 3);
-  for (int i = 0; i < 3; ++i)
-  {
-    for (int j = 0; j < 3; j++)
-    {
-      worldErr[i][j] = cluster->getError(i, j);
-    }
-  }
-
   /// Extract detector element IDs to access the correct Surface
   TVector3 world(x, y, z);
 
@@ -296,7 +286,13 @@ Surface PHActsSourceLinks::getTpcLocalCoords(double (&local2D)[2],
   /// Transformation of cluster to local surface coords
   /// Coords are r*phi relative to surface r-phi center, and z
   /// relative to surface z center
-  Acts::Vector3D center = surface->center(m_actsGeometry->getGeoContext());
+  auto centerIter = m_tpcSurfaceCenters.find(surface.get());
+  if (centerIter == m_tpcSurfaceCenters.end())
+  {
+    centerIter = m_tpcSurfaceCenters.insert(
+        std::make_pair(surface.get(), surface->center(m_actsGeometry->getGeoContext()))).first;
+  }
+  const Acts::Vector3D &center = centerIter->second;
   double surfRphiCenter = atan2(center[1], center[0]) * radius;
   double surfZCenter = center[2];
   if (Verbosity() > 0)
@@ -321,35 +317,24 @@ Surface PHActsSourceLinks::getTpcLocalCoords(double (&local2D)[2],
               << std::endl;
   }
 
-  localErr = transformCovarToLocal(clusPhi, worldErr);
+  // In local coords the covariances are in the  r*phi vs z frame
+  // They have been rotated into global coordinates in TrkrCluster
+  const Acts::RotationMatrix3D covRotation =
+      Acts::AngleAxis3D(-clusPhi, Acts::Vector3D::UnitZ()).toRotationMatrix();
+  localErr = transformCovarToLocal(covRotation, cluster);
 
   return surface;
 }
 
 Surface PHActsSourceLinks::getInttLocalCoords(double (&local2D)[2],
-                                              TMatrixD &localErr,
+                                              Acts::ActsSymMatrixD<3> &localErr,
                                               const TrkrCluster *cluster,
                                               const TrkrDefs::cluskey clusKey)
 {
-  TVector3 local(0, 0, 0);
-
-  const float x = cluster->getPosition(0);
-  const float y = cluster->getPosition(1);
-  const float z = cluster->getPosition(2);
-
-  // In local coords the covariances are in the  r*phi vs z frame
-  // They have been rotated into global coordinates in TrkrCluster
-  TMatrixD worldErr(3, 3);
-  for (int i = 0; i < 3; ++i)
-  {
-    for (int j = 0; j < 3; j++)
-    {
-      worldErr[i][j] = cluster->getError(i, j);
-    }
-  }
-
   /// Extract detector element IDs to access the correct Surface
-  const TVector3 world(x, y, z);
+  const Acts::Vector3D world(cluster->getPosition(0),
+                             cluster->getPosition(1),
+                             cluster->getPosition(2));
 
   /// Get the INTT geometry
   const unsigned int ladderZId = InttDefs::getLadderZId(clusKey);
@@ -362,43 +347,19 @@ Surface PHActsSourceLinks::getInttLocalCoords(double (&local2D)[2],
     std::cout << "Intt cluster with ladderzid " << ladderZId
               << " ladderphid " << ladderPhiId << std::endl;
   }
-  /// Get the TGeoNode
-  const TGeoNode *sensorNode = getNodeFromClusterMap(hitSetKey);
-
-  if (!sensorNode)
-  {
-    std::cout << PHWHERE << "No entry in TGeo map for cluster: layer "
-              << layer << " ladderZId " << ladderZId
-              << " ladderPhiId " << ladderPhiId
-              << " - should be impossible!" << std::endl;
-    return nullptr;
-  }
 
-  /// Now we have the geo node, so find the corresponding Acts::Surface
-  Surface surface = getSurfaceFromClusterMap(hitSetKey);
-  if (!surface)
-  {
-    std::cout << PHWHERE
-              << "Failed to find associated surface element - should be impossible!"
-              << std::endl;
+  const SiliconFrame *frame = getSiliconFrame(TrkrDefs::inttId, hitSetKey,
+                                              layer, ladderZId, ladderPhiId);
+  if (!frame)
     return nullptr;
-  }
 
   // transform position back to local coords on sensor
-  CylinderGeomIntt *layerGeom =
-      dynamic_cast<CylinderGeomIntt *>(m_geomContainerIntt->GetLayerGeom(layer));
-  local = layerGeom->get_local_from_world_coords(ladderZId,
-                                                 ladderPhiId,
-                                                 world);
+  const Acts::Vector3D local = frame->transform * world + frame->offset;
   local2D[0] = local[1];  // r*phi
   local2D[1] = local[2];  // z
 
   if (Verbosity() > 10)
   {
-    double segcent[3];
-    layerGeom->find_segment_center(ladderZId, ladderPhiId, segcent);
-    std::cout << "   segment center: " << segcent[0]
-              << " " << segcent[1] << " " << segcent[2] << std::endl;
     std::cout << "   world; " << world[0] << " " << world[1]
               << " " << world[2] << std::endl;
     std::cout << "   local; " << local[0] << " " << local[1]
@@ -406,35 +367,20 @@ Surface PHActsSourceLinks::getInttLocalCoords(double (&local2D)[2],
   }
 
   /// Get the local covariance error
-  localErr = getInttCovarLocal(layer, ladderZId, ladderPhiId, worldErr);
+  localErr = transformCovarToLocal(frame->covRotation, cluster);
 
-  return surface;
+  return frame->surface;
 }
 
 Surface PHActsSourceLinks::getMvtxLocalCoords(double (&local2D)[2],
-                                              TMatrixD &localErr,
+                                              Acts::ActsSymMatrixD<3> &localErr,
                                               const TrkrCluster *cluster,
                                               const TrkrDefs::cluskey clusKey)
 {
-  TVector3 local(0, 0, 0);
-
-  const float x = cluster->getPosition(0);
-  const float y = cluster->getPosition(1);
-  const float z = cluster->getPosition(2);
-
-  // In local coords the covariances are in the  r*phi vs z frame
-  // They have been rotated into global coordinates in TrkrCluster
-  TMatrixD worldErr(3, 3);
-  for (int i = 0; i < 3; ++i)
-  {
-    for (int j = 0; j < 3; j++)
-    {
-      worldErr[i][j] = cluster->getError(i, j);
-    }
-  }
-
   /// Extract detector element IDs to access the correct Surface
-  const TVector3 world(x, y, z);
+  const Acts::Vector3D world(cluster->getPosition(0),
+                             cluster->getPosition(1),
+                             cluster->getPosition(2));
 
   /// Get the Mvtx geometry
   const unsigned int staveId = MvtxDefs::getStaveId(clusKey);
@@ -452,21 +398,54 @@ Surface PHActsSourceLinks::getMvtxLocalCoords(double (&local2D)[2],
                                                          staveId,
                                                          chipId);
 
+  const SiliconFrame *frame = getSiliconFrame(TrkrDefs::mvtxId, hitSetKey,
+                                              layer, staveId, chipId);
+  if (!frame)
+    return nullptr;
+
+  const Acts::Vector3D local = frame->transform * world + frame->offset;
+  local2D[0] = local[0];
+  local2D[1] = local[2];
+
+  if (Verbosity() > 10)
+  {
+    std::cout << "   world; " << world[0] << " "
+              << world[1] << " " << world[2] << std::endl;
+    std::cout << "   local; " << local[0] << " "
+              << local[1] << " " << local[2] << std::endl;
+  }
+
+  // transform covariance matrix back to local coords on chip
+  localErr = transformCovarToLocal(frame->covRotation, cluster);
+
+  return frame->surface;
+}
+
+const PHActsSourceLinks::SiliconFrame *PHActsSourceLinks::getSiliconFrame(const unsigned int trkrId,
+                                                                          const TrkrDefs::hitsetkey hitSetKey,
+                                                                          const unsigned int layer,
+                                                                          const unsigned int id0,
+                                                                          const unsigned int id1)
+{
+  const auto frameIter = m_siliconFrames.find(hitSetKey);
+  if (frameIter != m_siliconFrames.end())
+    return &frameIter->second;
+
   /// Get the TGeoNode
   const TGeoNode *sensorNode = getNodeFromClusterMap(hitSetKey);
 
   if (!sensorNode)
   {
     std::cout << PHWHERE << "No entry in TGeo map for cluster: layer "
-              << layer << " staveid " << staveId
-              << " chipid " << chipId
+              << layer << " ids " << id0 << " " << id1
               << " - should be impossible!" << std::endl;
     return nullptr;
   }
 
   /// Now we have the geo node, so find the corresponding Acts::Surface
-  Surface surface = getSurfaceFromClusterMap(hitSetKey);
-  if (!surface)
+  SiliconFrame frame;
+  frame.surface = getSurfaceFromClusterMap(hitSetKey);
+  if (!frame.surface)
   {
     std::cout << PHWHERE
               << "Failed to find associated surface element - should be impossible!"
@@ -474,28 +453,55 @@ Surface PHActsSourceLinks::getMvtxLocalCoords(double (&local2D)[2],
     return nullptr;
   }
 
-  CylinderGeom_Mvtx *layerGeom = dynamic_cast<CylinderGeom_Mvtx *>(m_geomContainerMvtx->GetLayerGeom(layer));
-  local = layerGeom->get_local_from_world_coords(staveId, 0, 0,
-                                                 chipId, world);
-  local2D[0] = local[0];
-  local2D[1] = local[2];
+  /// The world to local transformation of the geometry is affine, it is
+  /// sampled at the origin and the unit vectors
+  TVector3 origin(0, 0, 0);
+  TVector3 unit[3] = {TVector3(1, 0, 0), TVector3(0, 1, 0), TVector3(0, 0, 1)};
+  double ladderLocation[3] = {0.0, 0.0, 0.0};
+  double ladderPhi = 0;
+  if (trkrId == TrkrDefs::mvtxId)
+  {
+    CylinderGeom_Mvtx *layerGeom = dynamic_cast<CylinderGeom_Mvtx *>(m_geomContainerMvtx->GetLayerGeom(layer));
+    origin = layerGeom->get_local_from_world_coords(id0, 0, 0, id1, origin);
+    for (int i = 0; i < 3; ++i)
+      unit[i] = layerGeom->get_local_from_world_coords(id0, 0, 0, id1, unit[i]);
 
-  if (Verbosity() > 10)
+    // returns the center of the sensor in world coordinates - used to get the ladder phi location
+    layerGeom->find_sensor_center(id0, 0, 0, id1, ladderLocation);
+    ladderPhi = atan2(ladderLocation[1], ladderLocation[0]);
+    ladderPhi += layerGeom->get_stave_phi_tilt();
+  }
+  else
   {
-    double segcent[3];
-    layerGeom->find_sensor_center(staveId, 0, 0, chipId, segcent);
-    std::cout << "   segment center: " << segcent[0] << " "
-              << segcent[1] << " " << segcent[2] << std::endl;
-    std::cout << "   world; " << world[0] << " "
-              << world[1] << " " << world[2] << std::endl;
-    std::cout << "   local; " << local[0] << " "
-              << local[1] << " " << local[2] << std::endl;
+    CylinderGeomIntt *layerGeom = dynamic_cast<CylinderGeomIntt *>(m_geomContainerIntt->GetLayerGeom(layer));
+    origin = layerGeom->get_local_from_world_coords(id0, id1, origin);
+    for (int i = 0; i < 3; ++i)
+      unit[i] = layerGeom->get_local_from_world_coords(id0, id1, unit[i]);
+
+    layerGeom->find_segment_center(id0, id1, ladderLocation);
+    ladderPhi = atan2(ladderLocation[1], ladderLocation[0]);
   }
 
-  // transform covariance matrix back to local coords on chip
-  localErr = getMvtxCovarLocal(layer, staveId, chipId, worldErr);
+  frame.offset = Acts::Vector3D(origin[0], origin[1], origin[2]);
+  for (int i = 0; i < 3; ++i)
+  {
+    for (int j = 0; j < 3; ++j)
+    {
+      frame.transform(j, i) = unit[i][j] - origin[j];
+    }
+  }
 
-  return surface;
+  // inverse of the rotation from local to global coords
+  frame.covRotation = Acts::AngleAxis3D(-ladderPhi, Acts::Vector3D::UnitZ()).toRotationMatrix();
+
+  if (Verbosity() > 10)
+  {
+    std::cout << "Silicon frame for hitsetkey " << hitSetKey << " ladder phi " << ladderPhi
+              << std::endl
+              << frame.transform << std::endl;
+  }
+
+  return &m_siliconFrames.insert(std::make_pair(hitSetKey, frame)).first->second;
 }
 
 int PHActsSourceLinks::getNodes(PHCompositeNode *topNode)
@@ -564,26 +570,15 @@ void PHActsSourceLinks::createNodes(PHCompositeNode *topNode)
     dstNode->addNode(svtxNode);
   }
 
-  /// See if the map is already on the node tree
-  m_hitIdClusKey = findNode::getClass<std::map<TrkrDefs::cluskey, unsigned int>>(topNode, "HitIDClusIDActsMap");
+  /// See if the SourceLink container is already on the node tree
+  m_sourceLinks = findNode::getClass<ActsSourceLinkContainer>(topNode, "TrkrClusterSourceLinkContainer");
 
   /// If not add it
-  if (!m_hitIdClusKey)
-  {
-    m_hitIdClusKey = new std::map<TrkrDefs::cluskey, unsigned int>;
-    PHDataNode<std::map<TrkrDefs::cluskey, unsigned int>> *hitMapNode =
-        new PHDataNode<std::map<TrkrDefs::cluskey, unsigned int>>(m_hitIdClusKey, "HitIDClusIDActsMap");
-    svtxNode->addNode(hitMapNode);
-  }
-
-  /// Do the same for the SourceLink container
-  m_sourceLinks = findNode::getClass<std::map<unsigned int, SourceLink>>(topNode, "TrkrClusterSourceLinks");
-
   if (!m_sourceLinks)
   {
-    m_sourceLinks = new std::map<unsigned int, SourceLink>;
-    PHDataNode<std::map<unsigned int, SourceLink>>
-        *sourceLinkNode = new PHDataNode<std::map<unsigned int, SourceLink>>(m_sourceLinks, "TrkrClusterSourceLinks");
+    m_sourceLinks = new ActsSourceLinkContainer;
+    PHDataNode<ActsSourceLinkContainer>
+        *sourceLinkNode = new PHDataNode<ActsSourceLinkContainer>(m_sourceLinks, "TrkrClusterSourceLinkContainer");
 
     svtxNode->addNode(sourceLinkNode);
   }
@@ -603,11 +598,10 @@ void PHActsSourceLinks::createNodes(PHCompositeNode *topNode)
 
 TGeoNode *PHActsSourceLinks::getNodeFromClusterMap(TrkrDefs::hitsetkey hitSetKey)
 {
-  std::map<TrkrDefs::hitsetkey, TGeoNode*> clusterNodeMap = m_actsGeometry->getTGeoNodeMap();
+  const auto &clusterNodeMap = m_actsGeometry->getTGeoNodeMap();
 
   /// Get the TGeoNode for this hit set key
-  std::map<TrkrDefs::hitsetkey, TGeoNode *>::iterator mapIter;
-  mapIter = clusterNodeMap.find(hitSetKey);
+  auto mapIter = clusterNodeMap.find(hitSetKey);
   TGeoNode *sensorNode;
 
   /// Make sure we found it
@@ -635,13 +629,9 @@ TGeoNode *PHActsSourceLinks::getNodeFromClusterMap(TrkrDefs::hitsetkey hitSetKey
 Surface PHActsSourceLinks::getSurfaceFromClusterMap(TrkrDefs::hitsetkey hitSetKey)
 {
   Surface surface;
-  std::map<TrkrDefs::hitsetkey, Surface> clusterSurfaceMap = 
-    m_actsGeometry->getSurfaceMapSilicon();
+  const auto &clusterSurfaceMap = m_actsGeometry->getSurfaceMapSilicon();
 
-  std::map<TrkrDefs::hitsetkey, Surface>::iterator
-      surfaceIter;
-
-  surfaceIter = clusterSurfaceMap.find(hitSetKey);
+  auto surfaceIter = clusterSurfaceMap.find(hitSetKey);
 
   /// Check to make sure we found the surface in the map
   if (surfaceIter != clusterSurfaceMap.end())
@@ -663,88 +653,25 @@ Surface PHActsSourceLinks::getSurfaceFromClusterMap(TrkrDefs::hitsetkey hitSetKe
   return surface;
 }
 
-TMatrixD PHActsSourceLinks::getMvtxCovarLocal(const unsigned int layer, const unsigned int staveId, const unsigned int chipId, TMatrixD worldErr)
+Acts::ActsSymMatrixD<3> PHActsSourceLinks::transformCovarToLocal(const Acts::RotationMatrix3D &covRotation,
+                                                                 const TrkrCluster *cluster) const
 {
-  TMatrixD localErr(3, 3);
-
-  // rotate errors back to local coords
-  double ladderLocation[3] = {0.0, 0.0, 0.0};
-
-  // returns the center of the sensor in world coordinates - used to get the ladder phi location
-  CylinderGeom_Mvtx *layergeom = dynamic_cast<CylinderGeom_Mvtx *>(m_geomContainerMvtx->GetLayerGeom(layer));
-  layergeom->find_sensor_center(staveId, 0, 0, chipId, ladderLocation);
-  double ladderPhi = atan2(ladderLocation[1], ladderLocation[0]);
-  ladderPhi += layergeom->get_stave_phi_tilt();
-
-  localErr = transformCovarToLocal(ladderPhi, worldErr);
-
-  if (Verbosity() > 10)
+  Acts::ActsSymMatrixD<3> worldErr;
+  for (int i = 0; i < 3; ++i)
   {
-    for (int i = 0; i < 3; ++i)
+    for (int j = 0; j < 3; j++)
     {
-      for (int j = 0; j < 3; ++j)
-      {
-        std::cout << "  " << i << "    " << j
-                  << " local_err " << localErr[i][j]
-                  << std::endl;
-      }
+      worldErr(i, j) = cluster->getError(i, j);
     }
   }
 
-  return localErr;
-}
-
-TMatrixD PHActsSourceLinks::getInttCovarLocal(const unsigned int layer, const unsigned int ladderZId, const unsigned int ladderPhiId, TMatrixD worldErr)
-{
-  TMatrixD localErr(3, 3);
-
-  // rotate errors back to local coords
-  double ladderLocation[3] = {0.0, 0.0, 0.0};
-
-  // rotate errors back to local coords
-  CylinderGeomIntt *layerGeom = dynamic_cast<CylinderGeomIntt *>(m_geomContainerIntt->GetLayerGeom(layer));
-  layerGeom->find_segment_center(ladderZId, ladderPhiId, ladderLocation);
-  double ladderPhi = atan2(ladderLocation[1], ladderLocation[0]);
-
-  localErr = transformCovarToLocal(ladderPhi, worldErr);
+  const Acts::ActsSymMatrixD<3> localErr = covRotation * worldErr * covRotation.transpose();
 
   if (Verbosity() > 10)
   {
-    for (int i = 0; i < 3; ++i)
-    {
-      for (int j = 0; j < 3; ++j)
-      {
-        std::cout << "  INTT: " << i << "    " << j
-                  << " local_err " << localErr[i][j] << std::endl;
-      }
-    }
+    std::cout << "  local_err " << std::endl
+              << localErr << std::endl;
   }
-  return localErr;
-}
-
-TMatrixD PHActsSourceLinks::transformCovarToLocal(const double ladderPhi,
-                                                  TMatrixD worldErr)
-{
-  TMatrixD localErr(3, 3);
-
-  // this is the matrix that was used to rotate from local to global coords
-  TMatrixD ROT(3, 3);
-  ROT[0][0] = cos(ladderPhi);
-  ROT[0][1] = -1.0 * sin(ladderPhi);
-  ROT[0][2] = 0.0;
-  ROT[1][0] = sin(ladderPhi);
-  ROT[1][1] = cos(ladderPhi);
-  ROT[1][2] = 0.0;
-  ROT[2][0] = 0.0;
-  ROT[2][1] = 0.0;
-  ROT[2][2] = 1.0;
-  // we want the inverse rotation
-  ROT.Invert();
-
-  TMatrixD ROT_T(3, 3);
-  ROT_T.Transpose(ROT);
-
-  localErr = ROT * worldErr * ROT_T;
 
   return localErr;
 }
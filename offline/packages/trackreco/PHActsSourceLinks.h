@@ -2,12 +2,14 @@
 #ifndef TRACKRECO_PHACTSSOURCELINKS_H
 #define TRACKRECO_PHACTSSOURCELINKS_H
 
+#include "ActsSourceLinkContainer.h"
+
 #include <fun4all/SubsysReco.h>
 #include <trackbase/TrkrDefs.h>
 
-#include <TMatrixDfwd.h>
 #include <map>
 #include <string>
+#include <unordered_map>
 #include <vector>
 
 /// Acts includes to create all necessary definitions
@@ -77,8 +79,13 @@ struct ActsTrackingGeometry{
  * the SvtxClusters. The class creates a node of TrkrClusterSourceLinks and
  * places it on the node tree for other Acts modules to use (e.g. for use of
  * track propagation or track fitting). SourceLinks are created from the 
- * SvtxClusterContainer contents (SvtxClusters) and are put into a special
- * SourceLinkContainer that is defined in TrkrClusterSourceLink.hpp
+ * SvtxClusterContainer contents (SvtxClusters) and are put into an
+ * ActsSourceLinkContainer (node TrkrClusterSourceLinkContainer), grouped by
+ * surface, which the Acts modules read in place.
+ *
+ * The local frame of each silicon sensor (surface, world to local transform
+ * and covariance rotation) is computed from the detector geometry the first
+ * time a cluster is found on it and reused for the rest of the run.
  */
 class PHActsSourceLinks : public SubsysReco
 {
@@ -111,36 +118,42 @@ class PHActsSourceLinks : public SubsysReco
   /// Get a Surface from the m_surfaceNodeMap;
   Surface getSurfaceFromClusterMap(TrkrDefs::hitsetkey hitSetKey);
 
-  /// Get the local covariance matrix for the Mvtx cluster in a form Acts
-  /// can accept
-  TMatrixD getMvtxCovarLocal(const unsigned int layer,
-                             const unsigned int staveid,
-                             const unsigned int chipid,
-                             TMatrixD world_err);
-
-  /// Get the local covariance matrix for the Intt cluster in a form Acts
-  /// can accept
-  TMatrixD getInttCovarLocal(const unsigned int layer,
-                             const unsigned int ladderZId,
-                             const unsigned int ladderPhiId,
-                             TMatrixD worldErr);
-
-  /// Transform the covariance to the local coordinate frame
-  TMatrixD transformCovarToLocal(const double ladderPhi, TMatrixD worldErr);
+  /// Local frame of a silicon sensor
+  struct SiliconFrame
+  {
+    Surface surface;
+    /// local = transform * world + offset, as get_local_from_world_coords
+    Acts::ActsMatrixD<3, 3> transform;
+    Acts::Vector3D offset;
+    /// rotation of the world covariance into the local frame
+    Acts::RotationMatrix3D covRotation;
+  };
+
+  /// Frame of the MVTX chip or INTT ladder segment, computed on first use.
+  /// The ids are (stave, chip) for the MVTX and (ladderZ, ladderPhi) for the INTT
+  const SiliconFrame *getSiliconFrame(const unsigned int trkrId,
+                                      const TrkrDefs::hitsetkey hitSetKey,
+                                      const unsigned int layer,
+                                      const unsigned int id0,
+                                      const unsigned int id1);
+
+  /// Rotate the cluster covariance to the local coordinate frame
+  Acts::ActsSymMatrixD<3> transformCovarToLocal(const Acts::RotationMatrix3D &covRotation,
+                                                const TrkrCluster *cluster) const;
 
   /// Function which returns MVTX local coordinates and error, as well as
   /// corresponding surface
-  Surface getMvtxLocalCoords(double (&local2D)[2], TMatrixD &localErr,
+  Surface getMvtxLocalCoords(double (&local2D)[2], Acts::ActsSymMatrixD<3> &localErr,
                              const TrkrCluster *cluster,
                              const TrkrDefs::cluskey clusKey);
 
   /// Same as above, except for INTT
-  Surface getInttLocalCoords(double (&local2D)[2], TMatrixD &localErr,
+  Surface getInttLocalCoords(double (&local2D)[2], Acts::ActsSymMatrixD<3> &localErr,
                              const TrkrCluster *cluster,
                              const TrkrDefs::cluskey clusKey);
 
   /// Same as above, except for TPC
-  Surface getTpcLocalCoords(double (&local2D)[2], TMatrixD &localErr,
+  Surface getTpcLocalCoords(double (&local2D)[2], Acts::ActsSymMatrixD<3> &localErr,
                             const TrkrCluster *cluster,
                             const TrkrDefs::cluskey clusKey);
 
@@ -154,12 +167,15 @@ class PHActsSourceLinks : public SubsysReco
   /// Geometry object to create all acts geometry
   MakeActsGeometry *m_actsGeometry;
 
-  /// Map relating arbitrary hitid to TrkrDef::cluskey for SourceLink, to be put
-  /// on node tree by this module
-  std::map<TrkrDefs::cluskey, unsigned int> *m_hitIdClusKey;
+  /// Source links of the event with their hit id and cluster key, to be
+  /// put on node tree by this module
+  ActsSourceLinkContainer *m_sourceLinks;
+
+  /// Local frames of the silicon sensors with clusters so far this run
+  std::unordered_map<TrkrDefs::hitsetkey, SiliconFrame> m_siliconFrames;
 
-  /// Map for source hitid:sourcelink, to be put on node tree by this module
-  std::map<unsigned int, SourceLink> *m_sourceLinks;
+  /// Centers of the TPC surfaces with clusters so far this run
+  std::unordered_map<const Acts::Surface *, Acts::Vector3D> m_tpcSurfaceCenters;
 
   /// Tracking geometry objects
   PHG4CylinderGeomContainer *m_geomContainerMvtx;
@@ -14,6 +14,7 @@
 #include <ACTFW/EventData/Track.hpp>
 #include <ACTFW/EventData/TrkrClusterSourceLink.hpp>
 
+#include "ActsSourceLinkContainer.h"
 #include "ActsTrack.h"
 
 #include <map>
@@ -58,15 +59,10 @@ class PHActsTracks : public SubsysReco
   /// Get nodes off node tree needed to execute module
   int getNodes(PHCompositeNode *topNode);
 
-  Acts::BoundSymMatrix getActsCovMatrix(const SvtxTrack *track);
-
   /**
    * Member variables
    */
 
-  /// A vector to hold the source links corresponding to a particular SvtxTrack
-  std::vector<SourceLink> m_trackSourceLinks;
-
   /// A map of an Acts track seed and Acts-sPHENIX source links corresponding
   /// to that track seed
   std::vector<ActsTrack> *m_actsProtoTracks;
@@ -74,11 +70,8 @@ class PHActsTracks : public SubsysReco
   /// Trackmap that contains SvtxTracks
   SvtxTrackMap *m_trackMap;
 
-  /// Map between cluster key and arbitrary hit id created in PHActsSourceLinks
-  std::map<TrkrDefs::cluskey, unsigned int> *m_hitIdClusKey;
-
-  /// Map of hitid:SourceLinks created in PHActsSourceLinks
-  std::map<unsigned int, SourceLink> *m_sourceLinks;
+  /// SourceLinks with their hit id and cluster key, created in PHActsSourceLinks
+  ActsSourceLinkContainer *m_sourceLinks;
 };
 
 #endif
@@ -8,11 +8,16 @@
 #include "PHActsTrkFitter.h"
 #include "MakeActsGeometry.h"
 #include "ActsTrack.h"
+#include "ActsTrackConverter.h"
 
 #include <fun4all/Fun4AllReturnCodes.h>
 #include <phool/getClass.h>
 #include <phool/phool.h>
 
+#include <trackbase_historic/SvtxTrack.h>
+#include <trackbase_historic/SvtxTrackMap.h>
+#include <trackbase_historic/SvtxTrackState_v1.h>
+
 #include <Acts/EventData/TrackParameters.hpp>
 #include <Acts/Surfaces/PerigeeSurface.hpp>
 #include <Acts/Surfaces/PlaneSurface.hpp>
@@ -22,6 +27,8 @@
 #include <ACTFW/Framework/AlgorithmContext.hpp>
 
 #include <cmath>
+#include <functional>
+#include <future>
 #include <iostream>
 #include <vector>
 
@@ -30,6 +37,7 @@ PHActsTrkFitter::PHActsTrkFitter(const std::string& name)
   , m_event(0)
   , m_actsProtoTracks(nullptr)
   , m_tGeometry(nullptr)
+  , m_nThreads(1)
 {
   Verbosity(0);
 }
@@ -43,10 +51,18 @@ int PHActsTrkFitter::Setup(PHCompositeNode* topNode)
   if (getNodes(topNode) != Fun4AllReturnCodes::EVENT_OK)
     return Fun4AllReturnCodes::ABORTEVENT;
   
-  fitCfg.fit = FW::TrkrClusterFittingAlgorithm::makeFitterFunction(
-               m_tGeometry->tGeometry,
-	       m_tGeometry->magField,
-	       Acts::Logging::VERBOSE);
+  if (m_nThreads < 1)
+    m_nThreads = 1;
+
+  /// Every thread gets its own fitter (and propagator)
+  m_fitCfgs.resize(m_nThreads);
+  for (auto& fitCfg : m_fitCfgs)
+  {
+    fitCfg.fit = FW::TrkrClusterFittingAlgorithm::makeFitterFunction(
+                 m_tGeometry->tGeometry,
+	         m_tGeometry->magField,
+	         Acts::Logging::VERBOSE);
+  }
 
   return Fun4AllReturnCodes::EVENT_OK;
 }
@@ -66,17 +82,76 @@ int PHActsTrkFitter::Process()
   auto pSurface = Acts::Surface::makeShared<Acts::PerigeeSurface>(
 	          Acts::Vector3D{0., 0., 0.});
 
-  std::vector<ActsTrack>::iterator trackIter;
+  const size_t ntracks = m_actsProtoTracks->size();
+  m_fitOk.assign(ntracks, 0);
+  m_fitCharge.resize(ntracks);
+  m_fitStates.resize(ntracks);
+
+  /// Tracks are handed out one by one, each result goes into the slot
+  /// of its proto track so the output does not depend on the scheduling
+  std::atomic<size_t> next(0);
+  unsigned int nthreads = m_nThreads;
+  if (nthreads > ntracks)
+    nthreads = ntracks;
+  if (nthreads <= 1 || Verbosity() > 10)
+  {
+    fitTracks(m_fitCfgs[0], &(*pSurface), next);
+  }
+  else
+  {
+    std::vector<std::future<void>> workers;
+    for (unsigned int ithread = 1; ithread < nthreads; ++ithread)
+    {
+      workers.push_back(std::async(std::launch::async,
+                                   &PHActsTrkFitter::fitTracks, this,
+                                   std::cref(m_fitCfgs[ithread]),
+                                   &(*pSurface), std::ref(next)));
+    }
+    fitTracks(m_fitCfgs[0], &(*pSurface), next);
+    for (auto& worker : workers)
+      worker.get();
+  }
 
-  for (trackIter = m_actsProtoTracks->begin();
-       trackIter != m_actsProtoTracks->end();
-       ++trackIter)
+  /// Write the fitted states back to the SvtxTracks in input order
+  for (size_t itrack = 0; itrack < ntracks; ++itrack)
   {
-    ActsTrack track = *trackIter;
+    if (!m_fitOk[itrack])
+      continue;
+
+    const SvtxTrackState_v1& state = m_fitStates[itrack];
+    if (Verbosity() > 10)
+    {
+      std::cout << "Fitted parameters for track" << std::endl;
+      std::cout << " position : " << state.get_x() << " "
+                << state.get_y() << " " << state.get_z()
+                << std::endl;
+      std::cout << " momentum : " << state.get_px() << " "
+                << state.get_py() << " " << state.get_pz()
+                << std::endl;
+    }
+
+    /// Update the SvtxTrack the proto track was made from
+    SvtxTrack* track = _track_map->get((*m_actsProtoTracks)[itrack].getTrackKey());
+    if (!track)
+      continue;
+
+    track->set_charge(m_fitCharge[itrack]);
+    ActsTrackConverter::setVertexState(*track, state);
+  }
+
+  return Fun4AllReturnCodes::EVENT_OK;
+}
+
+void PHActsTrkFitter::fitTracks(const FW::TrkrClusterFittingAlgorithm::Config& cfg,
+                                const Acts::Surface* pSurface,
+                                std::atomic<size_t>& next)
+{
+  const size_t ntracks = m_actsProtoTracks->size();
+  for (size_t itrack = next++; itrack < ntracks; itrack = next++)
+  {
+    /// The seed and source links are used in place on the node tree
+    const ActsTrack& track = (*m_actsProtoTracks)[itrack];
 
-    std::vector<SourceLink> sourceLinks = track.getSourceLinks();
-    FW::TrackParameters trackSeed = track.getTrackParams();
-      
     /// Call KF now. Have a vector of sourceLinks corresponding to clusters
     /// associated to this track and the corresponding track seed which
     /// corresponds to the PHGenFitTrkProp track seeds
@@ -85,9 +160,9 @@ int PHActsTrkFitter::Process()
       m_tGeometry->magFieldContext,
       m_tGeometry->calibContext,
       Acts::VoidOutlierFinder(),
-      &(*pSurface));
+      pSurface);
   
-    auto result = fitCfg.fit(sourceLinks, trackSeed, kfOptions);
+    auto result = cfg.fit(track.getSourceLinks(), track.getTrackParams(), kfOptions);
 
     /// Check that the result is okay
     if (result.ok())
@@ -96,22 +171,14 @@ int PHActsTrkFitter::Process()
       if (fitOutput.fittedParameters)
       {
         const auto& params = fitOutput.fittedParameters.value();
-        /// Get position, momentum from params
-        if (Verbosity() > 10)
-        {
-          std::cout << "Fitted parameters for track" << std::endl;
-          std::cout << " position : " << params.position().transpose()
-                    << std::endl;
-          std::cout << " momentum : " << params.momentum().transpose()
-                    << std::endl;
-        }
+        /// The conversion to the SvtxTrack frame runs in the fitting thread
+        m_fitStates[itrack] = SvtxTrackState_v1(0.0);
+        ActsTrackConverter::fillState(params, m_fitStates[itrack]);
+        m_fitCharge[itrack] = params.charge();
+        m_fitOk[itrack] = 1;
       }
     }
-
-    /// Update the acts track node on the node tree
   }
-
-  return Fun4AllReturnCodes::EVENT_OK;
 }
 
 int PHActsTrkFitter::End(PHCompositeNode* topNode)
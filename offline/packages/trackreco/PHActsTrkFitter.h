@@ -22,8 +22,12 @@
 
 #include <ACTFW/Fitting/TrkrClusterFittingAlgorithm.hpp>
 
+#include <trackbase_historic/SvtxTrackState_v1.h>
+
+#include <atomic>
 #include <memory>
 #include <string>
+#include <vector>
 
 namespace FW
 {
@@ -56,6 +60,9 @@ class PHActsTrkFitter : public PHTrackFitting
   /// Process each event by calling the fitter
   int Process();
 
+  /// Number of threads fitting the tracks of one event, default is 1
+  void NThreads(const unsigned int n) { m_nThreads = n; }
+
  private:
   /// Event counter
   int m_event;
@@ -72,9 +79,21 @@ class PHActsTrkFitter : public PHTrackFitting
   /// Options that Acts::Fitter needs to run from MakeActsGeometry
   ActsTrackingGeometry *m_tGeometry;
 
-  /// Configuration containing the fitting function instance
-  FW::TrkrClusterFittingAlgorithm::Config fitCfg;
+  /// Fit proto tracks picked from the shared counter until none are left
+  void fitTracks(const FW::TrkrClusterFittingAlgorithm::Config& cfg,
+                 const Acts::Surface* pSurface,
+                 std::atomic<size_t>& next);
+
+  /// Configuration containing the fitting function instance, one per thread
+  std::vector<FW::TrkrClusterFittingAlgorithm::Config> m_fitCfgs;
+
+  /// Number of fitting threads
+  unsigned int m_nThreads;
 
+  /// Fit results for this event, one slot per proto track in input order
+  std::vector<char> m_fitOk;
+  std::vector<int> m_fitCharge;
+  std::vector<SvtxTrackState_v1> m_fitStates;
 
 };
 
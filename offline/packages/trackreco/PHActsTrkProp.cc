@@ -17,6 +17,8 @@
 #include <trackbase_historic/SvtxTrack.h>
 #include <trackbase_historic/SvtxTrackMap.h>
 
+#include <trackbase/TrkrRegionOfInterest.h>
+
 #include <Acts/EventData/ChargePolicy.hpp>
 #include <Acts/EventData/SingleCurvilinearTrackParameters.hpp>
 #include <Acts/EventData/TrackParameters.hpp>
@@ -41,7 +43,10 @@
 
 
 #include <TMatrixDSym.h>
+#include <algorithm>
 #include <cmath>
+#include <functional>
+#include <future>
 #include <iostream>
 #include <vector>
 #include <utility>
@@ -52,8 +57,9 @@ PHActsTrkProp::PHActsTrkProp(const std::string& name)
   , m_tGeometry(nullptr)
   , m_trackMap(nullptr)
   , m_actsProtoTracks(nullptr)
-  , m_hitIdClusKey(nullptr)
   , m_sourceLinks(nullptr)
+  , m_nThreads(1)
+  , m_seedBatchSize(8)
 {
   Verbosity(0);
 }
@@ -79,10 +85,20 @@ int PHActsTrkProp::Setup(PHCompositeNode* topNode)
   // Set the allowed maximum number of source links to be large enough
   m_sourceLinkSelectorConfig.maxNumSourcelinksOnSurface = 100;
  
-  findCfg.finder = FW::TrkrClusterFindingAlgorithm::makeFinderFunction(
-                   m_tGeometry->tGeometry,
-		   m_tGeometry->magField,
-		   Acts::Logging::VERBOSE);
+  if (m_nThreads < 1)
+    m_nThreads = 1;
+  if (m_seedBatchSize < 1)
+    m_seedBatchSize = 1;
+
+  /// Every thread gets its own finder (and propagator)
+  m_findCfgs.resize(m_nThreads);
+  for (auto& findCfg : m_findCfgs)
+  {
+    findCfg.finder = FW::TrkrClusterFindingAlgorithm::makeFinderFunction(
+                     m_tGeometry->tGeometry,
+		     m_tGeometry->magField,
+		     Acts::Logging::VERBOSE);
+  }
 
 
 
@@ -104,25 +120,23 @@ int PHActsTrkProp::Process()
   PerigeeSurface pSurface = Acts::Surface::makeShared<Acts::PerigeeSurface>
     (Acts::Vector3D(0., 0., 0.));
 
-  /// Collect all source links for the CKF
-  std::vector<SourceLink> sourceLinks;
-  std::map<unsigned int, SourceLink>::iterator slIter = m_sourceLinks->begin();
-  while(slIter != m_sourceLinks->end())
+  /// The source links of the event, grouped by surface by
+  /// PHActsSourceLinks. Read only while the CKF runs, shared by all threads
+  const std::vector<SourceLink>& sourceLinks = m_sourceLinks->getSourceLinks();
+  if(Verbosity() > 10)
     {
-      sourceLinks.push_back(slIter->second);
-      
-      if(Verbosity() > 10)
+      for (const auto& sourceLink : sourceLinks)
 	{
 	  std::cout << std::endl 
 		    << "Adding source link to list for track finding: " 
-		    << slIter->second.hitID() <<" and surface : " 
+		    << sourceLink.hitID() <<" and surface : " 
 		    << std::endl;
-	  slIter->second.referenceSurface().toStream(m_tGeometry->geoContext, std::cout);
-	  
+	  sourceLink.referenceSurface().toStream(m_tGeometry->geoContext, std::cout);
 	}
-      ++slIter;
     }
 
+  /// Collect the seeds
+  m_seeds.clear();
   for (SvtxTrackMap::Iter trackIter = m_trackMap->begin();
        trackIter != m_trackMap->end(); ++trackIter)
     {
@@ -130,44 +144,117 @@ int PHActsTrkProp::Process()
       
       if (!track)
 	continue;
+
+      /// Only propagate the seeds pointing to a region of interest
+      if (_region_of_interest &&
+	  !_region_of_interest->containsDirection(track->get_eta(), track->get_phi(), track->get_z()))
+	continue;
       
       if (Verbosity() > 1)
 	{
 	  std::cout << "found SvtxTrack " << trackIter->first << std::endl;
 	  track->identify();
 	}
+
+      m_seeds.push_back(track);
+    }
+
+  const size_t nseeds = m_seeds.size();
+  m_seedProtoTracks.resize(nseeds);
+  for (auto& protoTracks : m_seedProtoTracks)
+    protoTracks.clear();
+
+  /// Seeds are handed out in batches, the proto tracks of each seed go
+  /// into its slot so the output does not depend on the scheduling
+  std::atomic<size_t> next(0);
+  size_t nthreads = m_nThreads;
+  const size_t nbatches = (nseeds + m_seedBatchSize - 1) / m_seedBatchSize;
+  if (nthreads > nbatches)
+    nthreads = nbatches;
+  if (nthreads <= 1 || Verbosity() > 10)
+  {
+    findTracks(m_findCfgs[0], &(*pSurface), next);
+  }
+  else
+  {
+    std::vector<std::future<void>> workers;
+    for (unsigned int ithread = 1; ithread < nthreads; ++ithread)
+    {
+      workers.push_back(std::async(std::launch::async,
+                                   &PHActsTrkProp::findTracks, this,
+                                   std::cref(m_findCfgs[ithread]),
+                                   &(*pSurface), std::ref(next)));
+    }
+    findTracks(m_findCfgs[0], &(*pSurface), next);
+    for (auto& worker : workers)
+      worker.get();
+  }
+
+  for (size_t iseed = 0; iseed < nseeds; ++iseed)
+    {
+      for (auto& actsProtoTrack : m_seedProtoTracks[iseed])
+	{
+	  if(Verbosity() > 10)
+	    {
+	      const auto params = actsProtoTrack.getTrackParams();
+	      std::cout << "Fitted parameters for track finder" << std::endl;
+	      std::cout << "Position : " << params.position().transpose()
+			<< std::endl;
+	      std::cout << "Momentum : " << params.momentum().transpose()
+			<< std::endl;
+	    }
+	  m_actsProtoTracks->push_back(std::move(actsProtoTrack));
+	}
+    }
+
+  return Fun4AllReturnCodes::EVENT_OK;
+}
+
+void PHActsTrkProp::findTracks(const FW::TrkrClusterFindingAlgorithm::Config& cfg,
+			       const Acts::Surface* pSurface,
+			       std::atomic<size_t>& next)
+{
+  const size_t nseeds = m_seeds.size();
+  for (size_t first = (next++) * m_seedBatchSize; first < nseeds;
+       first = (next++) * m_seedBatchSize)
+    {
+      const size_t last = std::min(first + m_seedBatchSize, nseeds);
+      for (size_t iseed = first; iseed < last; ++iseed)
+	{
+	  const SvtxTrack *track = m_seeds[iseed];
+
+	  /// Get the necessary parameters and values for the TrackParameters
+	  const Acts::BoundSymMatrix seedCov = getActsCovMatrix(track);
+	  const Acts::Vector3D seedPos(track->get_x(),
+				       track->get_y(),
+				       track->get_z());
+	  const Acts::Vector3D seedMom(track->get_px(),
+				       track->get_py(),
+				       track->get_pz());
       
-      /// Get the necessary parameters and values for the TrackParameters
-      const Acts::BoundSymMatrix seedCov = getActsCovMatrix(track);
-      const Acts::Vector3D seedPos(track->get_x(),
-				   track->get_y(),
-				   track->get_z());
-      const Acts::Vector3D seedMom(track->get_px(),
-				   track->get_py(),
-				   track->get_pz());
-      
-      // just set to 0 for now?
-      const double trackTime = 0;
-      const int trackQ = track->get_charge();
-      
-      const FW::TrackParameters trackSeed(seedCov, seedPos,
-					  seedMom, trackQ, trackTime);
+	  // just set to 0 for now?
+	  const double trackTime = 0;
+	  const int trackQ = track->get_charge();
       
+	  const FW::TrackParameters trackSeed(seedCov, seedPos,
+					      seedMom, trackQ, trackTime);
       
-      /// Construct the options to pass to the CKF.
-      /// SourceLinkSelector set in Init()
-      Acts::CombinatorialKalmanFilterOptions<SourceLinkSelector> ckfOptions(
+	  /// Construct the options to pass to the CKF.
+	  /// SourceLinkSelector set in Init()
+	  Acts::CombinatorialKalmanFilterOptions<SourceLinkSelector> ckfOptions(
 	        m_tGeometry->geoContext, 
 		m_tGeometry->magFieldContext, 
 		m_tGeometry->calibContext, 
 		m_sourceLinkSelectorConfig, 
-		&(*pSurface));
+		pSurface);
       
-      /// Run the CKF for all source links and the constructed track seed
-      auto result = findCfg.finder(sourceLinks, trackSeed, ckfOptions);
+	  /// Run the CKF for all source links and the constructed track seed
+	  const std::vector<SourceLink>& sourceLinks = m_sourceLinks->getSourceLinks();
+	  auto result = cfg.finder(sourceLinks, trackSeed, ckfOptions);
       
-      if(result.ok())
-	{
+	  if(!result.ok())
+	    continue;
+
 	  const auto& fitOutput = result.value();
 	  auto parameterMap = fitOutput.fittedParameters;
 
@@ -182,34 +269,19 @@ int PHActsTrkProp::Process()
 	
 	  for(auto element : parameterMap)
 	    {
-	      const auto& params = element.second;
-	      if(Verbosity() > 10)
-		{
-		  std::cout << "Fitted parameters for track finder" << std::endl;
-		  std::cout << "Position : " << params.position().transpose()
-			    << std::endl;
-		  std::cout << "Momentum : " << params.momentum().transpose()
-			    << std::endl;
-
-		}
-
-
 	      /// Get the finder results into a FW::TrackParameters 
-	      const FW::TrackParameters trackSeed(element.second.covariance(),
-						  element.second.position(),
-						  element.second.momentum(),
-						  element.second.charge(),
-						  element.second.time());
+	      const FW::TrackParameters trackParams(element.second.covariance(),
+						    element.second.position(),
+						    element.second.momentum(),
+						    element.second.charge(),
+						    element.second.time());
 	      
-	      ActsTrack actsProtoTrack(trackSeed, trackSourceLinks);
-	      m_actsProtoTracks->push_back(actsProtoTrack);
+	      /// Keep the seed key so the fit can be written back to it
+	      m_seedProtoTracks[iseed].emplace_back(track->get_id(), trackParams,
+						    std::vector<SourceLink>(trackSourceLinks));
 	    }
-	  
 	}
     }
-
-
-  return Fun4AllReturnCodes::EVENT_OK;
 }
 
 int PHActsTrkProp::End()
@@ -221,7 +293,7 @@ int PHActsTrkProp::End()
   return Fun4AllReturnCodes::EVENT_OK;
 }
 
-Acts::BoundSymMatrix PHActsTrkProp::getActsCovMatrix(const SvtxTrack *track)
+Acts::BoundSymMatrix PHActsTrkProp::getActsCovMatrix(const SvtxTrack *track) const
 {
   Acts::BoundSymMatrix matrix = Acts::BoundSymMatrix::Zero();
     const double px = track->get_px();
@@ -247,7 +319,8 @@ Acts::BoundSymMatrix PHActsTrkProp::getActsCovMatrix(const SvtxTrack *track)
 	seedCov(i,j) = track->get_error(2, j) * 8.; //cm per millisec drift vel
     }
   }
-  std::cout<<track->get_x()<<std::endl;
+  if (Verbosity() > 10)
+    std::cout<<track->get_x()<<std::endl;
   /// convert the global z position covariances to timing covariances
   /// TPC z position resolution is 0.05 cm, drift velocity is 8cm/ms
   /// --> therefore timing resolution is ~6 microseconds
@@ -338,11 +411,11 @@ void PHActsTrkProp::createNodes(PHCompositeNode* topNode)
 int PHActsTrkProp::getNodes(PHCompositeNode* topNode)
 {
 
-  m_sourceLinks = findNode::getClass<std::map<unsigned int, SourceLink>>(topNode, "TrkrClusterSourceLinks");
+  m_sourceLinks = findNode::getClass<ActsSourceLinkContainer>(topNode, "TrkrClusterSourceLinkContainer");
 
   if (!m_sourceLinks)
     {
-      std::cout << PHWHERE << "TrkrClusterSourceLinks node not found on node tree. Exiting."
+      std::cout << PHWHERE << "TrkrClusterSourceLinkContainer node not found on node tree. Exiting."
 		<< std::endl;
       
       return Fun4AllReturnCodes::ABORTEVENT;
@@ -367,16 +440,6 @@ int PHActsTrkProp::getNodes(PHCompositeNode* topNode)
       return Fun4AllReturnCodes::ABORTEVENT;
     }
 
-  m_hitIdClusKey = findNode::getClass<std::map<TrkrDefs::cluskey, unsigned int>>(topNode, "HitIDClusIDActsMap");
-  if(!m_hitIdClusKey)
-    {
-      std::cout << PHWHERE << "ERROR: Can't find HitIdClusIdActsMap. Exiting."
-		<< std::endl;
-      return Fun4AllReturnCodes::ABORTEVENT;
-
-    }
-  
-
   return Fun4AllReturnCodes::EVENT_OK;
 }
 
@@ -1,6 +1,7 @@
 #ifndef TRACKRECO_PHACTSTRKPROP_H
 #define TRACKRECO_PHACTSTRKPROP_H
 
+#include "ActsSourceLinkContainer.h"
 #include "PHTrackPropagating.h"
 #include "PHActsSourceLinks.h"
 
@@ -19,9 +20,11 @@
 #include <ACTFW/EventData/Track.hpp>
 #include <ACTFW/Fitting/TrkrClusterFindingAlgorithm.hpp>
 
+#include <atomic>
 #include <memory>
 #include <string>
 #include <map>
+#include <vector>
 
 class ActsTrack;
 class MakeActsGeometry;
@@ -66,6 +69,12 @@ class PHActsTrkProp : public PHTrackPropagating
   /// Process each event by calling the fitter
   int Process();
 
+  /// Number of threads running the CKF on the seeds of one event, default is 1
+  void NThreads(const unsigned int n) { m_nThreads = n; }
+
+  /// Number of seeds a thread takes at once, default is 8
+  void SeedBatchSize(const unsigned int n) { m_seedBatchSize = n; }
+
  private:
   /// Event counter
   int m_event;
@@ -76,7 +85,13 @@ class PHActsTrkProp : public PHTrackPropagating
   /// Create new nodes
   void createNodes(PHCompositeNode *topNode);
 
-  Acts::BoundSymMatrix getActsCovMatrix(const SvtxTrack *track);
+  Acts::BoundSymMatrix getActsCovMatrix(const SvtxTrack *track) const;
+
+  /// Run the CKF on batches of seeds picked from the shared counter until
+  /// none are left, the proto tracks of seed i go into m_seedProtoTracks[i]
+  void findTracks(const FW::TrkrClusterFindingAlgorithm::Config& cfg,
+                  const Acts::Surface* pSurface,
+                  std::atomic<size_t>& next);
 
   ActsTrackingGeometry *m_tGeometry;
 
@@ -86,19 +101,28 @@ class PHActsTrkProp : public PHTrackPropagating
   /// Acts proto tracks to be put on the node tree by this module
   std::vector<ActsTrack> *m_actsProtoTracks;
 
-  /// Map of cluster keys to hit ids, for debugging statements
-  std::map<TrkrDefs::cluskey, unsigned int> *m_hitIdClusKey;
-
-  /// Acts source links created by PHActsSourceLinks
+  /// Acts source links created by PHActsSourceLinks, grouped by surface
   /// SourceLink is defined as TrkrClusterSourceLink elsewhere
-  std::map<unsigned int, SourceLink> *m_sourceLinks;
+  ActsSourceLinkContainer *m_sourceLinks;
 
   /// SourceLinkSelector to help the CKF identify which source links 
   /// may belong to a track seed based on geometry considerations
   SourceLinkSelectorConfig m_sourceLinkSelectorConfig;
  
-  /// Configuration containing the finding function instance
-  FW::TrkrClusterFindingAlgorithm::Config findCfg;
+  /// Configuration containing the finding function instance, one per thread
+  std::vector<FW::TrkrClusterFindingAlgorithm::Config> m_findCfgs;
+
+  /// Number of CKF threads
+  unsigned int m_nThreads;
+
+  /// Number of seeds handed out at once
+  unsigned int m_seedBatchSize;
+
+  /// Seeds of this event in track map order
+  std::vector<const SvtxTrack*> m_seeds;
+
+  /// Proto tracks found from each seed, one slot per seed
+  std::vector<std::vector<ActsTrack>> m_seedProtoTracks;
 
 };
 
@@ -8,8 +8,11 @@
 //begin
 
 #include "PHCASeeding.h"
+
+#include "PHClusterSpatialIndex.h"
 #include "GPUTPCTrackLinearisation.h"
 #include "GPUTPCTrackParam.h"
+#include "GPUTPCTrackParamBatch.h"
 
 // trackbase_historic includes
 #include <trackbase_historic/SvtxTrackMap.h>
@@ -20,6 +23,7 @@
 #include <trackbase/TrkrCluster.h>  // for TrkrCluster
 #include <trackbase/TrkrClusterContainer.h>
 #include <trackbase/TrkrDefs.h>  // for getLayer, clu...
+#include <trackbase/TrkrRegionOfInterest.h>
 
 // sPHENIX Geant4 includes
 #include <g4detectors/PHG4CylinderCellGeom.h>
@@ -100,8 +104,6 @@ PHCASeeding::PHCASeeding(
   , _g4tracks(nullptr)
   , _g4vertexes(nullptr)
   , _svtxhitsmap(nullptr)
-  , _hit_used_map(nullptr)
-  , _hit_used_map_size(0)
   , phisr(0.005)
   , etasr(0.0035)
   , phist(0.001)
@@ -121,6 +123,7 @@ PHCASeeding::PHCASeeding(
   , _Bz(Bz)
   , _phi_scale(2)
   , _z_scale(2)
+  , _cluster_index(nullptr)
 {
 }
 
@@ -281,53 +284,25 @@ double PHCASeeding::phidiff(double phi1, double phi2)
     return d;
 }
 
-void PHCASeeding::QueryTree(const bgi::rtree<pointKey, bgi::quadratic<16>> &rtree, double phimin, double etamin, double lmin, double phimax, double etamax, double lmax, std::vector<pointKey> &returned_values)
+void PHCASeeding::QueryTree(double phimin, double etamin, double lmin, double phimax, double etamax, double lmax, std::vector<pointKey> &returned_values)
 {
-  rtree.query(bgi::intersects(box(point(phimin, etamin, lmin), point(phimax, etamax, lmax))), std::back_inserter(returned_values));
-  if (phimin < 0) rtree.query(bgi::intersects(box(point(2 * M_PI + phimin, etamin, lmin), point(2 * M_PI, etamax, lmax))), std::back_inserter(returned_values));
-  if (phimax > 2 * M_PI) rtree.query(bgi::intersects(box(point(0, etamin, lmin), point(phimax - 2 * M_PI, etamax, lmax))), std::back_inserter(returned_values));
+  // the shared index holds all layers, only use the ones this seeder was using
+  lmin = std::max(lmin, (double) (_nlayers_maps + _nlayers_intt) - 0.5);
+  if (lmax < lmin) return;
+  _cluster_index->Query(phimin, etamin, lmin, phimax, etamax, lmax, returned_values);
 }
 
-void PHCASeeding::FillTree()
+void PHCASeeding::FillTree(PHCompositeNode *topNode)
 {
-  //  bgi::rtree<pointKey, bgi::quadratic<16> > rtree;
   PHTimer *t_fill = new PHTimer("t_fill");
   t_fill->stop();
-  int n_dupli = 0;
-  int nlayer[60];
-  for (int j = 0; j < 60; ++j) nlayer[j] = 0;
-
-  TrkrClusterContainer::ConstRange clusrange = _cluster_map->getClusters();
-
-  for (TrkrClusterContainer::ConstIterator iter = clusrange.first; iter != clusrange.second; ++iter)
-  {
-    TrkrCluster *cluster = iter->second;
-    TrkrDefs::cluskey ckey = iter->first;
-    unsigned int layer = TrkrDefs::getLayer(ckey);
-    if (layer < (_nlayers_maps + _nlayers_intt)) continue;
-
-    TVector3 vec(cluster->getPosition(0) - _vertex->get_x(), cluster->getPosition(1) - _vertex->get_y(), cluster->getPosition(2) - _vertex->get_z());
-
-    double clus_phi = vec.Phi();
-    clus_phi -= 2 * M_PI * floor(clus_phi / (2 * M_PI));
-    double clus_eta = vec.Eta();
-    double clus_l = layer;  // _radii_all[layer];
-
-    vector<pointKey> testduplicate;
-    QueryTree(_rtree, clus_phi - 0.00001, clus_eta - 0.00001, layer - 0.5, clus_phi + 0.00001, clus_eta + 0.00001, layer + 0.5, testduplicate);
-    if (!testduplicate.empty())
-    {
-      ++n_dupli;
-      continue;
-    }
-    ++nlayer[layer];
-    t_fill->restart();
-    _rtree.insert(std::make_pair(point(clus_phi, clus_eta, clus_l), ckey));
-    t_fill->stop();
-  }
+  t_fill->restart();
+  _cluster_index = PHClusterSpatialIndex::GetIndex(topNode, _cluster_map, _vertex->get_x(), _vertex->get_y(), _vertex->get_z());
+  t_fill->stop();
 
   std::cout << "fill time: " << t_fill->get_accumulated_time() / 1000. << " sec" << std::endl;
-  std::cout << "number of duplicates : " << n_dupli << std::endl;
+  std::cout << "number of duplicates : " << _cluster_index->nDuplicates() << std::endl;
+  delete t_fill;
 }
 
 int PHCASeeding::Process(PHCompositeNode *topNode)
@@ -351,17 +326,16 @@ int PHCASeeding::Process(PHCompositeNode *topNode)
   t_seed->stop();
   t_seed->restart();
 
-  _rtree.clear();
-  FillTree();
+  FillTree(topNode);
 
   int numberofseeds = 0;
-  LogDebug(" entries in tree: " << _rtree.size() << endl);
+  LogDebug(" entries in tree: " << _cluster_index->size() << endl);
 
   vector<pointKey> allClusters;
   vector<keylink> belowLinks;
   vector<keylink> aboveLinks;
   // messy way of getting vector<pointKey> for all clusters
-  QueryTree(_rtree,
+  QueryTree(
             0, // phi
             -3, // eta
             -1, // layer 
@@ -369,6 +343,22 @@ int PHCASeeding::Process(PHCompositeNode *topNode)
             3, // eta
             100, // layer
             allClusters);
+  if (_region_of_interest)
+  {
+    // seeds only start from clusters inside the regions of interest
+    vector<pointKey>::iterator last = allClusters.begin();
+    for (vector<pointKey>::iterator iter = allClusters.begin(); iter != allClusters.end(); ++iter)
+    {
+      TrkrCluster *cluster = _cluster_map->findCluster(iter->second);
+      const float x = cluster->getPosition(0);
+      const float y = cluster->getPosition(1);
+      if (_region_of_interest->contains(sqrt(x * x + y * y), atan2(y, x), cluster->getPosition(2)))
+      {
+        *last++ = *iter;
+      }
+    }
+    allClusters.erase(last, allClusters.end());
+  }
   LogDebug(" number of total clusters: " << allClusters.size() << endl);
   for (vector<pointKey>::iterator StartCluster = allClusters.begin(); StartCluster != allClusters.end(); ++StartCluster)
   {
@@ -388,7 +378,7 @@ int PHCASeeding::Process(PHCompositeNode *topNode)
 
     vector<pointKey> ClustersAbove;
     vector<pointKey> ClustersBelow;
-    QueryTree(_rtree,
+    QueryTree(
               StartPhi-_neighbor_phi_width,
               StartEta-_neighbor_eta_width,
               (double) StartLayer - 1.5,
@@ -396,7 +386,7 @@ int PHCASeeding::Process(PHCompositeNode *topNode)
               StartEta+_neighbor_eta_width,
               (double) StartLayer - 0.5,
               ClustersBelow);
-    QueryTree(_rtree,
+    QueryTree(
               StartPhi-_neighbor_phi_width,
               StartEta-_neighbor_eta_width,
               (double) StartLayer + 0.5,
@@ -471,13 +461,23 @@ int PHCASeeding::Process(PHCompositeNode *topNode)
     }
 #endif
   }
+  // the links of a cluster are looked up by its dense index in the cluster container
+  // instead of searching the link lists. Every start cluster has one above and one below link
+  const unsigned int nclusters = _cluster_map->size();
+  vector<char> has_above_link(nclusters, 0);
+  vector<TrkrDefs::cluskey> above_link(nclusters, 0);
+  for(vector<keylink>::iterator aboveLink = aboveLinks.begin(); aboveLink != aboveLinks.end(); ++aboveLink)
+  {
+    const unsigned int index = _cluster_map->getIndex((*aboveLink)[0]);
+    has_above_link[index] = 1;
+    above_link[index] = (*aboveLink)[1];
+  }
   // remove all triplets for which there isn't a mutual association between two clusters
   vector<keylink> bidirectionalLinks;
   for(vector<keylink>::iterator belowLink = belowLinks.begin(); belowLink != belowLinks.end(); ++belowLink)
   {
-    keylink reversed = {(*belowLink)[1],(*belowLink)[0]};
-    vector<keylink>::iterator sameAboveLinkExists = find(aboveLinks.begin(),aboveLinks.end(),reversed);
-    if(sameAboveLinkExists != aboveLinks.end())
+    const unsigned int index = _cluster_map->getIndex((*belowLink)[1]);
+    if(index != TrkrClusterContainer::InvalidIndex && has_above_link[index] && above_link[index] == (*belowLink)[0])
     {
       bidirectionalLinks.push_back((*belowLink));
     }
@@ -490,17 +490,25 @@ int PHCASeeding::Process(PHCompositeNode *topNode)
   // follow bidirectional links to form lists of cluster keys
   // (to be fitted for track seed parameters)
   vector<keylist> trackSeedKeyLists;
+  // number of links ending at a cluster and the link starting from it, by dense cluster index
+  vector<unsigned int> n_links_to(nclusters, 0);
+  vector<char> has_link_from(nclusters, 0);
+  vector<TrkrDefs::cluskey> link_from(nclusters, 0);
+  for(vector<keylink>::iterator link = bidirectionalLinks.begin(); link != bidirectionalLinks.end(); ++link)
+  {
+    const unsigned int index = _cluster_map->getIndex((*link)[1]);
+    if(index != TrkrClusterContainer::InvalidIndex) n_links_to[index]++;
+    has_link_from[_cluster_map->getIndex((*link)[0])] = 1;
+    link_from[_cluster_map->getIndex((*link)[0])] = (*link)[1];
+  }
   // get starting cluster keys, create a keylist for each
   // (only check last element of each pair because we start from the outer layers and go inward)
   for(vector<keylink>::iterator startCand = bidirectionalLinks.begin(); startCand != bidirectionalLinks.end(); ++startCand)
   {
-    bool has_above_link = false;
-    for(vector<keylink>::iterator testlink = bidirectionalLinks.begin(); testlink != bidirectionalLinks.end(); ++testlink)
-    {
-      if((*startCand) == (*testlink)) continue;
-      if((*startCand)[0] == (*testlink)[1]) has_above_link = true;
-    }
-    if(!has_above_link)
+    // links ending at the first cluster, not counting the candidate itself
+    unsigned int n_above = n_links_to[_cluster_map->getIndex((*startCand)[0])];
+    if((*startCand)[1] == (*startCand)[0]) n_above--;
+    if(n_above == 0)
     {
       trackSeedKeyLists.push_back({(*startCand)[0],(*startCand)[1]});
     }
@@ -508,20 +516,11 @@ int PHCASeeding::Process(PHCompositeNode *topNode)
   // assemble track cluster chains from starting cluster keys (ordered from outside in)
   for(vector<keylist>::iterator trackKeyChain = trackSeedKeyLists.begin(); trackKeyChain != trackSeedKeyLists.end(); ++trackKeyChain)
   {
-    bool reached_end = false;
-    while(!reached_end)
+    while(true)
     {
-      TrkrDefs::cluskey trackHead = trackKeyChain->back();
-      bool no_next_link = true;
-      for(vector<keylink>::iterator testlink = bidirectionalLinks.begin(); testlink != bidirectionalLinks.end(); ++testlink)
-      {
-        if((*testlink)[0]==trackHead)
-        {
-          trackKeyChain->push_back((*testlink)[1]);
-          no_next_link = false;
-        }
-      }
-      if(no_next_link) reached_end = true;
+      const unsigned int index = _cluster_map->getIndex(trackKeyChain->back());
+      if(index == TrkrClusterContainer::InvalidIndex || !has_link_from[index]) break;
+      trackKeyChain->push_back(link_from[index]);
     }
   }
   LogDebug(" track key chains assembled: " << trackSeedKeyLists.size() << endl);
@@ -563,11 +562,24 @@ int PHCASeeding::Process(PHCompositeNode *topNode)
   }
   LogDebug(" Total large jumps: " << jumpcount << endl);
   // Turn track cluster chains into track candidates using ALICE simplified KF.
-
-  for(vector<keylist>::iterator trackKeyChain = trackSeedKeyLists.begin(); trackKeyChain != trackSeedKeyLists.end(); ++trackKeyChain)
+  // All seeds are stepped together in a GPUTPCTrackParamBatch, one cluster
+  // position of the chains per step. The seeds are ordered by decreasing
+  // length, so the seeds which reached their last cluster are at the end of
+  // the batch and are taken out before the next step.
+  const unsigned int nseeds = trackSeedKeyLists.size();
+  vector<unsigned int> order(nseeds);
+  iota(order.begin(), order.end(), 0);
+  stable_sort(order.begin(), order.end(), [&trackSeedKeyLists](const unsigned int a, const unsigned int b) { return trackSeedKeyLists[a].size() > trackSeedKeyLists[b].size(); });
+  vector<GPUTPCTrackParam> trackSeeds(nseeds);
+  vector<float> trackCartesian_x(nseeds, 0.);
+  vector<float> trackCartesian_y(nseeds, 0.);
+  vector<float> trackCartesian_z(nseeds, 0.);
+  GPUTPCTrackParamBatch batch(nseeds);
+  for (unsigned int slot = 0; slot < nseeds; ++slot)
   {
+    const keylist& trackKeyChain = trackSeedKeyLists[order[slot]];
     // get starting cluster from key
-    TrkrCluster* startCluster = _cluster_map->findCluster(trackKeyChain->at(0));
+    TrkrCluster* startCluster = _cluster_map->findCluster(trackKeyChain.at(0));
     // Transform sPHENIX coordinates into ALICE-compatible coordinates
     double x0 = startCluster->getPosition(0);
     double y0 = startCluster->getPosition(1);
@@ -583,17 +595,8 @@ int PHCASeeding::Process(PHCompositeNode *topNode)
     trackSeed.SetX(alice_x0);
     trackSeed.SetY(alice_y0);
     trackSeed.SetZ(alice_z0);
-    float x = x0;
-    float y = y0;
-    #if defined(_DEBUG_)
-    float z = z0;
-    float alice_x = sqrt(x0*x0+y0*y0);
-    #endif
-    float trackCartesian_x = 0.;
-    float trackCartesian_y = 0.;
-    float trackCartesian_z = 0.;
     // Pre-set momentum-based parameters to improve numerical stability
-    TrkrCluster* SecondCluster = _cluster_map->findCluster(trackKeyChain->at(1));
+    TrkrCluster* SecondCluster = _cluster_map->findCluster(trackKeyChain.at(1));
     float second_x = SecondCluster->getPosition(0);
     float second_y = SecondCluster->getPosition(1);
     float second_z = SecondCluster->getPosition(2);
@@ -609,77 +612,105 @@ int PHCASeeding::Process(PHCompositeNode *topNode)
     trackSeed.SetDzDs(init_DzDs);
     LogDebug("Set initial DzDs to " << init_DzDs << endl);
     GPUTPCTrackLinearisation trackLine(trackSeed);
-
-    LogDebug(endl << endl << "------------------------" << endl << "seed size: " << trackKeyChain->size() << endl << endl << endl);
-    int cluster_ctr = 1;
-    // starting at second cluster, perform track propagation
-    for(keylist::iterator clusterkey = next(trackKeyChain->begin()); clusterkey != trackKeyChain->end(); ++clusterkey)
+    batch.Set(slot, trackSeed, trackLine);
+  }
+  // per step inputs of the batch
+  vector<float> alpha(nseeds);
+  vector<float> nextAlice_x(nseeds);
+  vector<float> nextCluster_alice_y(nseeds, 0.);
+  vector<float> nextCluster_z(nseeds);
+  vector<float> y2_error(nseeds, _cluster_alice_y_error*_cluster_alice_y_error);
+  vector<float> z2_error(nseeds, _cluster_z_error*_cluster_z_error);
+  vector<unsigned char> seedOK(nseeds, 1);
+  GPUTPCTrackLinearisation trackLine;
+  // starting at second cluster, perform track propagation
+  for (unsigned int cluster_ctr = 1;; ++cluster_ctr)
+  {
+    // take out the seeds without a cluster at this position
+    unsigned int nactive = batch.Size();
+    while (nactive > 0 && trackSeedKeyLists[order[nactive - 1]].size() <= cluster_ctr)
     {
-      LogDebug("cluster " << cluster_ctr << " -> " << cluster_ctr + 1 << endl);
-      LogDebug("this cluster (x,y,z) = (" << x << "," << y << "," << z << ")" << endl);
-      // get cluster from key
-      TrkrCluster* nextCluster = _cluster_map->findCluster(*clusterkey);
-      // find ALICE x-coordinate
+      --nactive;
+      batch.Get(nactive, trackSeeds[order[nactive]], trackLine);
+    }
+    if (nactive == 0)
+    {
+      break;
+    }
+    batch.Resize(nactive);
+    LogDebug("cluster " << cluster_ctr << " -> " << cluster_ctr + 1 << " for " << nactive << " seeds" << endl);
+    for (unsigned int slot = 0; slot < nactive; ++slot)
+    {
+      const keylist& trackKeyChain = trackSeedKeyLists[order[slot]];
+      // this cluster (x,y) and next cluster (x,y,z)
+      TrkrCluster* thisCluster = _cluster_map->findCluster(trackKeyChain[cluster_ctr - 1]);
+      TrkrCluster* nextCluster = _cluster_map->findCluster(trackKeyChain[cluster_ctr]);
+      float x = thisCluster->getPosition(0);
+      float y = thisCluster->getPosition(1);
       float nextCluster_x = nextCluster->getPosition(0);
       float nextCluster_y = nextCluster->getPosition(1);
-      float nextCluster_z = nextCluster->getPosition(2);
-      float nextAlice_x = sqrt(nextCluster_x*nextCluster_x+nextCluster_y*nextCluster_y);
+      nextCluster_z[slot] = nextCluster->getPosition(2);
+      // find ALICE x-coordinate
+      nextAlice_x[slot] = sqrt(nextCluster_x*nextCluster_x+nextCluster_y*nextCluster_y);
       // rotate track coordinates to match orientation of next cluster
       float newPhi = atan(nextCluster_y/nextCluster_x);
-      LogDebug("new phi = " << newPhi << endl);
       float oldPhi = atan(y/x);
-      LogDebug("old phi = " << oldPhi << endl);
-      float alpha = newPhi - oldPhi;
-      LogDebug("alpha = " << alpha << endl);
-      if(!trackSeed.Rotate(alpha,trackLine,_max_sin_phi))
+      alpha[slot] = newPhi - oldPhi;
+    }
+    batch.Rotate(&alpha[0], _max_sin_phi);
+    for (unsigned int slot = 0; slot < nactive; ++slot)
+    {
+      if (seedOK[order[slot]] && !batch.OK(slot))
       {
         LogError("Rotate failed! Aborting for this seed...");
-        break;
+        seedOK[order[slot]] = 0;
       }
-      LogDebug("track coordinates (ALICE) after rotation: (" << trackSeed.GetX() << "," << trackSeed.GetY() << "," << trackSeed.GetZ() << ")" << endl);
-      LogDebug("Transporting from " << alice_x << " to " << nextAlice_x << "...");
-      if(!trackSeed.TransportToX(nextAlice_x,trackLine,_Bz,_max_sin_phi))
+    }
+    batch.TransportToX(&nextAlice_x[0], _Bz, _max_sin_phi);
+    for (unsigned int slot = 0; slot < nactive; ++slot)
+    {
+      const unsigned int iseed = order[slot];
+      if (!seedOK[iseed])
+      {
+        continue;
+      }
+      if (!batch.OK(slot))
       {
         LogError("Transport failed! Aborting for this seed...");
-        break;
+        seedOK[iseed] = 0;
+        continue;
       }
-      // convert ALICE coordinates to sPHENIX cartesian coordinates, for debugging
-      float predicted_alice_x = trackSeed.GetX();
-      LogDebug("new track ALICE x = " << trackSeed.GetX() << endl);
-      float predicted_alice_y = trackSeed.GetY();
-      LogDebug("new track ALICE y = " << trackSeed.GetY() << endl);
-      float predicted_z = trackSeed.GetZ();
-      LogDebug("new track z = " << trackSeed.GetZ() << endl);
+      // convert ALICE coordinates to sPHENIX cartesian coordinates
+      TrkrCluster* thisCluster = _cluster_map->findCluster(trackSeedKeyLists[iseed][cluster_ctr - 1]);
+      float x = thisCluster->getPosition(0);
+      float y = thisCluster->getPosition(1);
       float cos_phi = x/sqrt(x*x+y*y);
-      LogDebug("cos_phi = " << cos_phi << endl);
       float sin_phi = y/sqrt(x*x+y*y);
-      LogDebug("sin phi = " << sin_phi << endl);
-      trackCartesian_x = predicted_alice_x*cos_phi+predicted_alice_y*sin_phi;
-      trackCartesian_y = predicted_alice_x*sin_phi-predicted_alice_y*cos_phi;
-      trackCartesian_z = predicted_z;
-      LogDebug("Track transported to (x,y,z) = (" << trackCartesian_x << "," << trackCartesian_y << "," << trackCartesian_z << ")" << endl);
-      LogDebug("Next cluster is at (x,y,z) = (" << nextCluster_x << "," << nextCluster_y << "," << nextCluster_z << ")" << endl);
-      LogDebug("track coordinates (ALICE) after rotation: (" << trackSeed.GetX() << "," << trackSeed.GetY() << "," << trackSeed.GetZ() << ")" << endl);
-      //float nextCluster_alice_y = (nextCluster_x/cos(newPhi) - nextCluster_y/sin(newPhi))/(tan(newPhi)+1./tan(newPhi));
-      float nextCluster_alice_y = 0.;
-      LogDebug("next cluster ALICE y = " << nextCluster_alice_y << endl);
-      float y2_error = _cluster_alice_y_error*_cluster_alice_y_error;
-      float z2_error = _cluster_z_error*_cluster_z_error;
-      LogDebug("track ALICE SinPhi = " << trackSeed.GetSinPhi() << endl);
-      // Apply Kalman filter
-      if(!trackSeed.Filter(nextCluster_alice_y,nextCluster_z,y2_error,z2_error,_max_sin_phi))
+      trackCartesian_x[iseed] = batch.X(slot)*cos_phi+batch.Y(slot)*sin_phi;
+      trackCartesian_y[iseed] = batch.X(slot)*sin_phi-batch.Y(slot)*cos_phi;
+      trackCartesian_z[iseed] = batch.Z(slot);
+      LogDebug("Track transported to (x,y,z) = (" << trackCartesian_x[iseed] << "," << trackCartesian_y[iseed] << "," << trackCartesian_z[iseed] << ")" << endl);
+    }
+    // Apply Kalman filter
+    //float nextCluster_alice_y = (nextCluster_x/cos(newPhi) - nextCluster_y/sin(newPhi))/(tan(newPhi)+1./tan(newPhi));
+    batch.Filter(&nextCluster_alice_y[0], &nextCluster_z[0], &y2_error[0], &z2_error[0], _max_sin_phi);
+    for (unsigned int slot = 0; slot < nactive; ++slot)
+    {
+      if (seedOK[order[slot]] && !batch.OK(slot))
       {
-        LogError("Kalman filter failed for seed " << numberofseeds << "! Aborting for this seed..." << endl);
-        break;
+        LogError("Kalman filter failed for seed " << order[slot] << "! Aborting for this seed..." << endl);
+        seedOK[order[slot]] = 0;
       }
-      x = nextCluster_x;
-      y = nextCluster_y;
-      #if defined(_DEBUG_)
-      z = nextCluster_z;
-      alice_x = nextAlice_x;
-      #endif
-      ++cluster_ctr;
-    } 
+    }
+  }
+  for (unsigned int iseed = 0; iseed < nseeds; ++iseed)
+  {
+    const keylist* trackKeyChain = &trackSeedKeyLists[iseed];
+    const GPUTPCTrackParam& trackSeed = trackSeeds[iseed];
+    TrkrCluster* startCluster = _cluster_map->findCluster(trackKeyChain->at(0));
+    double x0 = startCluster->getPosition(0);
+    double y0 = startCluster->getPosition(1);
+    double z0 = startCluster->getPosition(2);
     //    pt:z:dz:phi:dphi:c:dc
     // Fill NT with track parameters
     float StartEta = -log(tan(atan(z0/sqrt(x0*x0+y0*y0))));
@@ -689,7 +720,7 @@ int PHCASeeding::Process(PHCompositeNode *topNode)
     LogDebug("Track pterr = " << track_pterr << endl);
     float track_z = trackSeed.GetZ();
     float track_zerr = sqrt(trackSeed.GetErr2Z());
-    float track_phi = atan(trackCartesian_y/trackCartesian_x);
+    float track_phi = atan(trackCartesian_y[iseed]/trackCartesian_x[iseed]);
     float last_cluster_phierr = _cluster_map->findCluster(trackKeyChain->back())->getPhiError();
     // phi error assuming error in track radial coordinate is zero
     float track_phierr = sqrt(pow(last_cluster_phierr,2)+(pow(trackSeed.GetX(),2)*trackSeed.GetErr2Y()) / 
@@ -709,9 +740,9 @@ int PHCASeeding::Process(PHCompositeNode *topNode)
     if(trackSeed.GetQPt()<0) track.set_charge(-1);
     else track.set_charge(1);
     TrkrCluster *cl = _cluster_map->findCluster(trackKeyChain->at(0));
-    track.set_x(trackCartesian_x);  //track.set_x(cl->getX());
-    track.set_y(trackCartesian_y);  //track.set_y(cl->getY());
-    track.set_z(trackCartesian_z);  //track.set_z(cl->getZ());
+    track.set_x(trackCartesian_x[iseed]);  //track.set_x(cl->getX());
+    track.set_y(trackCartesian_y[iseed]);  //track.set_y(cl->getY());
+    track.set_z(trackCartesian_z[iseed]);  //track.set_z(cl->getZ());
     track.set_px(track_pt * cos(track_phi));
     track.set_py(track_pt * sin(track_phi));
     track.set_pz(track_pt / tan(2 * atan(exp(-StartEta))));
@@ -39,6 +39,7 @@
 #endif
  
 class PHCompositeNode;  // lines 196-196
+class PHClusterSpatialIndex;
 class SvtxClusterMap;   // lines 202-202
 class SvtxHitMap;       // lines 211-211
 class SvtxTrackMap;     // lines 204-204
@@ -107,8 +108,6 @@ class PHCASeeding : public PHTrackSeeding
   SvtxVertexMap *_g4vertexes;
   //nodes to get norm vector
   SvtxHitMap *_svtxhitsmap;
-  int *_hit_used_map;
-  int _hit_used_map_size;
 
   //seed searching parameters
   double phisr, etasr, phist, etast, phixt, etaxt;
@@ -117,11 +116,11 @@ class PHCASeeding : public PHTrackSeeding
 
   double phiadd(double phi1, double phi2);
   double phidiff(double phi1, double phi2);
-  void FillTree();
+  void FillTree(PHCompositeNode *topNode);
 
 #if !defined(__CINT__) || defined(__CLING__)
   double pointKeyToTuple(pointKey *pK);
-  void QueryTree(const bgi::rtree<pointKey, bgi::quadratic<16>> &rtree, double phimin, double etamin, double lmin, double phimax, double etamax, double lmax, std::vector<pointKey> &returned_values);
+  void QueryTree(double phimin, double etamin, double lmin, double phimax, double etamax, double lmax, std::vector<pointKey> &returned_values);
 #endif
 
  private:
@@ -147,9 +146,8 @@ class PHCASeeding : public PHTrackSeeding
   float _z_scale;
   //std::vector<float> _radii_all;
 
-#if !defined(__CINT__) || defined(__CLING__)
-  bgi::rtree<pointKey, bgi::quadratic<16>> _rtree;
-#endif  // __CINT__
+  //! shared cluster index of this event
+  PHClusterSpatialIndex *_cluster_index;
 };
 
 #endif
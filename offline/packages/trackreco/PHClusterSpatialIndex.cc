@@ -0,0 +1,182 @@
+#include "PHClusterSpatialIndex.h"
+
+#include <trackbase/TrkrCluster.h>
+#include <trackbase/TrkrClusterContainer.h>
+#include <trackbase/TrkrDefs.h>
+
+#include <phool/PHCompositeNode.h>
+#include <phool/PHDataNode.h>
+#include <phool/PHNodeIterator.h>
+#include <phool/getClass.h>
+#include <phool/phool.h>  // for PHWHERE
+
+#include <boost/geometry.hpp>
+
+#include <TVector3.h>
+
+#include <algorithm>
+#include <cmath>
+#include <cstdint>
+#include <cstdlib>
+#include <iterator>  // for back_inserter
+#include <unordered_map>
+
+namespace bg = boost::geometry;
+namespace bgi = boost::geometry::index;
+
+using namespace std;
+
+namespace
+{
+  //! max distance in phi and eta of two clusters in the same layer to be considered duplicates
+  const float duplicate_distance = 0.00001;
+
+  //! cell of the duplicate search grid
+  uint64_t duplicate_cell(const unsigned int layer, const long iphi, const long ieta)
+  {
+    return (uint64_t(layer) << 48) | ((uint64_t(iphi) & 0xffffff) << 24) | (uint64_t(ieta) & 0xffffff);
+  }
+}  // namespace
+
+PHClusterSpatialIndex::PHClusterSpatialIndex()
+  : m_Built(false)
+  , m_nDuplicates(0)
+{
+  m_Vertex[0] = m_Vertex[1] = m_Vertex[2] = 0;
+}
+
+void PHClusterSpatialIndex::identify(ostream &os) const
+{
+  os << "PHClusterSpatialIndex: ";
+  if (!m_Built)
+  {
+    os << "not built" << endl;
+    return;
+  }
+  os << m_Tree.size() << " clusters, " << m_nDuplicates << " duplicates skipped, vertex ("
+     << m_Vertex[0] << ", " << m_Vertex[1] << ", " << m_Vertex[2] << ")" << endl;
+}
+
+void PHClusterSpatialIndex::Reset()
+{
+  m_Tree.clear();
+  m_Built = false;
+  m_nDuplicates = 0;
+}
+
+unsigned int PHClusterSpatialIndex::size() const
+{
+  return m_Tree.size();
+}
+
+PHClusterSpatialIndex *PHClusterSpatialIndex::GetIndex(PHCompositeNode *topNode, const TrkrClusterContainer *clusters,
+                                                       const double vx, const double vy, const double vz)
+{
+  PHClusterSpatialIndex *index = findNode::getClass<PHClusterSpatialIndex>(topNode, GetNodeName());
+  if (!index)
+  {
+    PHNodeIterator iter(topNode);
+    PHCompositeNode *dstNode = dynamic_cast<PHCompositeNode *>(iter.findFirst("PHCompositeNode", "DST"));
+    if (!dstNode)
+    {
+      cout << PHWHERE << "DST Node missing, exiting." << endl;
+      exit(1);
+    }
+    PHNodeIterator dstiter(dstNode);
+    PHCompositeNode *DetNode = dynamic_cast<PHCompositeNode *>(dstiter.findFirst("PHCompositeNode", "TRKR"));
+    if (!DetNode)
+    {
+      DetNode = new PHCompositeNode("TRKR");
+      dstNode->addNode(DetNode);
+    }
+    // transient, but under DST so it is reset after every event
+    index = new PHClusterSpatialIndex();
+    DetNode->addNode(new PHDataNode<PHObject>(index, GetNodeName(), "PHObject"));
+  }
+
+  if (!index->m_Built)
+  {
+    index->Build(clusters, vx, vy, vz);
+  }
+  else if (index->m_Vertex[0] != vx || index->m_Vertex[1] != vy || index->m_Vertex[2] != vz)
+  {
+    cout << PHWHERE << " index was built for vertex (" << index->m_Vertex[0] << ", " << index->m_Vertex[1]
+         << ", " << index->m_Vertex[2] << "), requested for (" << vx << ", " << vy << ", " << vz
+         << "), exiting" << endl;
+    exit(1);
+  }
+  return index;
+}
+
+void PHClusterSpatialIndex::Build(const TrkrClusterContainer *clusters, const double vx, const double vy, const double vz)
+{
+  m_Tree.clear();
+  m_nDuplicates = 0;
+  m_Vertex[0] = vx;
+  m_Vertex[1] = vy;
+  m_Vertex[2] = vz;
+
+  vector<pointKey> points;
+  points.reserve(clusters->size());
+
+  // accepted clusters by (layer, phi, eta) cell of the size of the duplicate distance
+  unordered_map<uint64_t, vector<unsigned int>> cells;
+  cells.reserve(clusters->size());
+
+  TrkrClusterContainer::ConstRange clusrange = clusters->getClusters();
+  for (TrkrClusterContainer::ConstIterator iter = clusrange.first; iter != clusrange.second; ++iter)
+  {
+    TrkrCluster *cluster = iter->second;
+    TrkrDefs::cluskey ckey = iter->first;
+    unsigned int layer = TrkrDefs::getLayer(ckey);
+
+    TVector3 vec(cluster->getPosition(0) - vx, cluster->getPosition(1) - vy, cluster->getPosition(2) - vz);
+
+    double clus_phi = vec.Phi();
+    clus_phi -= 2 * M_PI * floor(clus_phi / (2 * M_PI));
+    double clus_eta = vec.Eta();
+    point p(clus_phi, clus_eta, layer);
+
+    // skip clusters on top of an already accepted one
+    const long iphi = floor(bg::get<0>(p) / duplicate_distance);
+    const long ieta = floor(max(-20.f, min(20.f, bg::get<1>(p))) / duplicate_distance);
+    bool duplicate = false;
+    for (long jphi = iphi - 1; jphi <= iphi + 1 && !duplicate; ++jphi)
+    {
+      for (long jeta = ieta - 1; jeta <= ieta + 1 && !duplicate; ++jeta)
+      {
+        unordered_map<uint64_t, vector<unsigned int>>::const_iterator cell = cells.find(duplicate_cell(layer, jphi, jeta));
+        if (cell == cells.end()) continue;
+        for (unsigned int i = 0; i < cell->second.size(); ++i)
+        {
+          const point &q = points[cell->second[i]].first;
+          if (fabs(bg::get<0>(q) - bg::get<0>(p)) <= duplicate_distance &&
+              fabs(bg::get<1>(q) - bg::get<1>(p)) <= duplicate_distance)
+          {
+            duplicate = true;
+            break;
+          }
+        }
+      }
+    }
+    if (duplicate)
+    {
+      ++m_nDuplicates;
+      continue;
+    }
+    cells[duplicate_cell(layer, iphi, ieta)].push_back(points.size());
+    points.push_back(make_pair(p, ckey));
+  }
+
+  // packing algorithm, much faster than inserting one by one and gives a better tree
+  RTree tree(points.begin(), points.end());
+  m_Tree.swap(tree);
+  m_Built = true;
+}
+
+void PHClusterSpatialIndex::Query(double phimin, double etamin, double lmin, double phimax, double etamax, double lmax, vector<pointKey> &returned_values) const
+{
+  m_Tree.query(bgi::intersects(box(point(phimin, etamin, lmin), point(phimax, etamax, lmax))), back_inserter(returned_values));
+  if (phimin < 0) m_Tree.query(bgi::intersects(box(point(2 * M_PI + phimin, etamin, lmin), point(2 * M_PI, etamax, lmax))), back_inserter(returned_values));
+  if (phimax > 2 * M_PI) m_Tree.query(bgi::intersects(box(point(0, etamin, lmin), point(phimax - 2 * M_PI, etamax, lmax))), back_inserter(returned_values));
+}
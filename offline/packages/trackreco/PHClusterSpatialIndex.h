@@ -0,0 +1,81 @@
+#ifndef TRACKRECO_PHCLUSTERSPATIALINDEX_H
+#define TRACKRECO_PHCLUSTERSPATIALINDEX_H
+
+/*!
+ *  \file PHClusterSpatialIndex.h
+ *  \brief (phi, eta, layer) rtree of the clusters, shared by the seeders
+ *
+ *  The index lives as a transient node (CLUSTER_SPATIAL_INDEX) under DST/TRKR.
+ *  It is built on first use in an event with the packing (bulk load)
+ *  algorithm and cleared by the node reset at the end of the event, so all
+ *  modules running after the first one get the same tree for free.
+ *  phi and eta are calculated with respect to the vertex given on first
+ *  use, phi is in [0, 2pi). Clusters closer than 1e-5 in phi and eta to an
+ *  earlier cluster in the same layer are skipped as duplicates.
+ */
+
+#include <phool/PHObject.h>
+
+#include <trackbase/TrkrDefs.h>  // for cluskey
+
+#if !defined(__CINT__) || defined(__CLING__)
+#include <boost/geometry/geometries/box.hpp>    // for box
+#include <boost/geometry/geometries/point.hpp>  // for point
+#include <boost/geometry/index/rtree.hpp>
+#endif
+
+#include <iostream>
+#include <string>
+#include <utility>  // for pair
+#include <vector>
+
+class PHCompositeNode;
+class TrkrClusterContainer;
+
+class PHClusterSpatialIndex : public PHObject
+{
+ public:
+#if !defined(__CINT__) || defined(__CLING__)
+  typedef boost::geometry::model::point<float, 3, boost::geometry::cs::cartesian> point;
+  typedef boost::geometry::model::box<point> box;
+  typedef std::pair<point, TrkrDefs::cluskey> pointKey;
+  typedef boost::geometry::index::rtree<pointKey, boost::geometry::index::quadratic<16>> RTree;
+#endif
+
+  PHClusterSpatialIndex();
+  virtual ~PHClusterSpatialIndex() {}
+
+  void identify(std::ostream &os = std::cout) const;
+  void Reset();
+  int isValid() const { return m_Built; }
+
+  //! node holding the index for this event, the index is built if it is not yet
+  //! the vertex is only used when building, a different vertex later in the event is an error
+  static PHClusterSpatialIndex *GetIndex(PHCompositeNode *topNode, const TrkrClusterContainer *clusters,
+                                         const double vx, const double vy, const double vz);
+
+  static std::string GetNodeName() { return "CLUSTER_SPATIAL_INDEX"; }
+
+  unsigned int size() const;
+  unsigned int nDuplicates() const { return m_nDuplicates; }
+
+#if !defined(__CINT__) || defined(__CLING__)
+  //! append the clusters inside the box to returned_values, the box may extend below 0 or above 2pi in phi
+  void Query(double phimin, double etamin, double lmin, double phimax, double etamax, double lmax, std::vector<pointKey> &returned_values) const;
+
+  const RTree &GetTree() const { return m_Tree; }
+#endif
+
+ private:
+  void Build(const TrkrClusterContainer *clusters, const double vx, const double vy, const double vz);
+
+  bool m_Built;
+  double m_Vertex[3];
+  unsigned int m_nDuplicates;
+
+#if !defined(__CINT__) || defined(__CLING__)
+  RTree m_Tree;
+#endif
+};
+
+#endif
@@ -0,0 +1,265 @@
+#include "PHFastZVertexing.h"
+
+#include <trackbase_historic/SvtxVertexMap.h>
+#include <trackbase_historic/SvtxVertex.h>     // for SvtxVertex
+#include <trackbase_historic/SvtxVertex_v1.h>
+
+#include <trackbase/TrkrCluster.h>
+#include <trackbase/TrkrClusterContainer.h>
+#include <trackbase/TrkrDefs.h>                // for getLayer
+
+#include <fun4all/Fun4AllReturnCodes.h>
+
+#include <phool/phool.h>
+
+#include <algorithm>
+#include <cmath>
+#include <cstdlib>                             // for exit
+#include <iostream>                            // for operator<<, basic_ostream
+
+class PHCompositeNode;
+
+using namespace std;
+
+PHFastZVertexing::PHFastZVertexing(const std::string& name)
+  : PHInitVertexing(name)
+  , _min_layer(0)
+  , _max_layer(2)
+  , _z_min(-30.)
+  , _z_max(30.)
+  , _bin_size(0.02)
+  , _max_dphi(0.02)
+  , _max_slope(10.)
+  , _window(0.2)
+  , _min_vertex_separation(0.5)
+  , _min_pairs(3)
+  , _max_vertices(50)
+  , _beam_x(0.)
+  , _beam_y(0.)
+  , _beam_xy_err(0.01)
+  , _layer_hits()
+  , _bin_count()
+  , _bin_sum()
+  , _bin_sum2()
+  , _prefix_count()
+  , _prefix_sum()
+  , _prefix_sum2()
+{
+}
+
+int PHFastZVertexing::Setup(PHCompositeNode* topNode)
+{
+  int ret = PHInitVertexing::Setup(topNode);
+  if (ret != Fun4AllReturnCodes::EVENT_OK) return ret;
+
+  if (_max_layer <= _min_layer || _z_max <= _z_min || _bin_size <= 0)
+  {
+    cout << PHWHERE << " invalid settings, layers " << _min_layer << " - " << _max_layer
+         << " z range " << _z_min << " - " << _z_max << " bin size " << _bin_size << endl;
+    exit(1);
+  }
+
+  _layer_hits.resize(_max_layer - _min_layer + 1);
+
+  const unsigned int nbins = ceil((_z_max - _z_min) / _bin_size);
+  _bin_count.assign(nbins, 0);
+  _bin_sum.assign(nbins, 0);
+  _bin_sum2.assign(nbins, 0);
+  _prefix_count.assign(nbins + 1, 0);
+  _prefix_sum.assign(nbins + 1, 0);
+  _prefix_sum2.assign(nbins + 1, 0);
+
+  return Fun4AllReturnCodes::EVENT_OK;
+}
+
+int PHFastZVertexing::Process(PHCompositeNode* /*topNode*/)
+{
+  _vertex_map->clear();
+
+  fill_layer_hits();
+  fill_pairs();
+  find_vertices();
+
+  if (Verbosity() > 0)
+    _vertex_map->identify();
+
+  return Fun4AllReturnCodes::EVENT_OK;
+}
+
+int PHFastZVertexing::End(PHCompositeNode* /*topNode*/)
+{
+  return Fun4AllReturnCodes::EVENT_OK;
+}
+
+void PHFastZVertexing::fill_layer_hits()
+{
+  for (auto& hits : _layer_hits)
+  {
+    hits.clear();
+  }
+
+  TrkrClusterContainer::ConstRange clusrange = _cluster_map->getClusters();
+  for (TrkrClusterContainer::ConstIterator iter = clusrange.first; iter != clusrange.second; ++iter)
+  {
+    const unsigned int layer = TrkrDefs::getLayer(iter->first);
+    if (layer < _min_layer || layer > _max_layer) continue;
+
+    const TrkrCluster* cluster = iter->second;
+    const float x = cluster->getX() - _beam_x;
+    const float y = cluster->getY() - _beam_y;
+
+    LayerHit hit;
+    hit.phi = atan2(y, x);
+    hit.r = sqrt(x * x + y * y);
+    hit.z = cluster->getZ();
+    _layer_hits[layer - _min_layer].push_back(hit);
+  }
+
+  for (auto& hits : _layer_hits)
+  {
+    std::sort(hits.begin(), hits.end());
+  }
+}
+
+void PHFastZVertexing::fill_pairs()
+{
+  std::fill(_bin_count.begin(), _bin_count.end(), 0);
+  std::fill(_bin_sum.begin(), _bin_sum.end(), 0);
+  std::fill(_bin_sum2.begin(), _bin_sum2.end(), 0);
+
+  const unsigned int nbins = _bin_count.size();
+  unsigned int npairs = 0;
+
+  for (unsigned int ilayer = 0; ilayer < _layer_hits.size(); ++ilayer)
+  {
+    const vector<LayerHit>& inner = _layer_hits[ilayer];
+    for (unsigned int jlayer = ilayer + 1; jlayer < _layer_hits.size(); ++jlayer)
+    {
+      const vector<LayerHit>& outer = _layer_hits[jlayer];
+      if (inner.empty() || outer.empty()) continue;
+
+      for (const LayerHit& hit1 : inner)
+      {
+        // the phi window of the outer layer, split in two ranges where it wraps around
+        LayerHit lo, hi;
+        lo.phi = hit1.phi - _max_dphi;
+        hi.phi = hit1.phi + _max_dphi;
+        float ranges[2][2] = {{lo.phi, hi.phi}, {1, 0}};
+        if (lo.phi < -M_PI)
+        {
+          ranges[0][0] = -M_PI;
+          ranges[1][0] = lo.phi + 2 * M_PI;
+          ranges[1][1] = M_PI;
+        }
+        else if (hi.phi > M_PI)
+        {
+          ranges[0][1] = M_PI;
+          ranges[1][0] = -M_PI;
+          ranges[1][1] = hi.phi - 2 * M_PI;
+        }
+
+        for (int irange = 0; irange < 2; ++irange)
+        {
+          if (ranges[irange][0] > ranges[irange][1]) continue;
+
+          lo.phi = ranges[irange][0];
+          hi.phi = ranges[irange][1];
+          auto begin = std::lower_bound(outer.begin(), outer.end(), lo);
+          auto end = std::upper_bound(begin, outer.end(), hi);
+          for (auto hit2 = begin; hit2 != end; ++hit2)
+          {
+            const float dr = hit2->r - hit1.r;
+            if (dr <= 0) continue;
+
+            const float slope = (hit2->z - hit1.z) / dr;
+            if (fabs(slope) > _max_slope) continue;
+
+            const float z0 = hit1.z - hit1.r * slope;
+            if (z0 < _z_min || z0 >= _z_max) continue;
+
+            const unsigned int ibin = std::min(nbins - 1, (unsigned int) ((z0 - _z_min) / _bin_size));
+            _bin_count[ibin]++;
+            _bin_sum[ibin] += z0;
+            _bin_sum2[ibin] += z0 * z0;
+            ++npairs;
+          }
+        }
+      }
+    }
+  }
+
+  if (Verbosity() > 1)
+    cout << PHWHERE << " " << npairs << " cluster pairs in " << nbins << " bins" << endl;
+}
+
+void PHFastZVertexing::find_vertices()
+{
+  const int nbins = _bin_count.size();
+  const int half_window = std::max(0, (int) lround(0.5 * _window / _bin_size));
+
+  for (unsigned int ivertex = 0; ivertex < _max_vertices; ++ivertex)
+  {
+    for (int ibin = 0; ibin < nbins; ++ibin)
+    {
+      _prefix_count[ibin + 1] = _prefix_count[ibin] + _bin_count[ibin];
+      _prefix_sum[ibin + 1] = _prefix_sum[ibin] + _bin_sum[ibin];
+      _prefix_sum2[ibin + 1] = _prefix_sum2[ibin] + _bin_sum2[ibin];
+    }
+
+    // window with most pairs, the first one if several have the same count
+    unsigned int best_count = 0;
+    int best_lo = 0;
+    int best_hi = 0;
+    for (int ibin = 0; ibin < nbins; ++ibin)
+    {
+      const int lo = std::max(0, ibin - half_window);
+      const int hi = std::min(nbins, ibin + half_window + 1);
+      const unsigned int count = _prefix_count[hi] - _prefix_count[lo];
+      if (count > best_count)
+      {
+        best_count = count;
+        best_lo = lo;
+        best_hi = hi;
+      }
+    }
+
+    if (best_count < _min_pairs || best_count == 0) break;
+
+    const double z = (_prefix_sum[best_hi] - _prefix_sum[best_lo]) / best_count;
+    double var = (_prefix_sum2[best_hi] - _prefix_sum2[best_lo]) / best_count - z * z;
+    var = std::max(var, (double) _bin_size * _bin_size / 12.);
+
+    SvtxVertex* vertex = new SvtxVertex_v1();
+    vertex->set_x(_beam_x);
+    vertex->set_y(_beam_y);
+    vertex->set_z(z);
+    for (int j = 0; j < 3; ++j)
+    {
+      for (int i = j; i < 3; ++i)
+      {
+        vertex->set_error(i, j, 0);
+      }
+    }
+    vertex->set_error(0, 0, _beam_xy_err * _beam_xy_err);
+    vertex->set_error(1, 1, _beam_xy_err * _beam_xy_err);
+    vertex->set_error(2, 2, var / best_count);
+    vertex->set_t0(0);
+    vertex->set_chisq(0);
+    vertex->set_ndof(best_count);
+    _vertex_map->insert(vertex);
+
+    if (Verbosity() > 1)
+      cout << PHWHERE << " vertex " << ivertex << " z " << z << " +- " << sqrt(var / best_count)
+           << " from " << best_count << " pairs" << endl;
+
+    // remove the pairs of this vertex and of everything closer than the separation
+    const int clear_lo = std::max(0, std::min(best_lo, (int) floor((z - _min_vertex_separation - _z_min) / _bin_size)));
+    const int clear_hi = std::min(nbins, std::max(best_hi, (int) ceil((z + _min_vertex_separation - _z_min) / _bin_size)));
+    for (int ibin = clear_lo; ibin < clear_hi; ++ibin)
+    {
+      _bin_count[ibin] = 0;
+      _bin_sum[ibin] = 0;
+      _bin_sum2[ibin] = 0;
+    }
+  }
+}
@@ -0,0 +1,131 @@
+/*!
+ *  \file		PHFastZVertexing.h
+ *  \brief		Initial z vertexing from cluster pairs in the inner layers
+ */
+
+#ifndef TRACKRECO_PHFASTZVERTEXING_H
+#define TRACKRECO_PHFASTZVERTEXING_H
+
+#include "PHInitVertexing.h"
+
+#include <string>
+#include <vector>
+
+// forward declarations
+class PHCompositeNode;
+
+/// \class PHFastZVertexing
+///
+/// \brief Initial z vertexing from cluster pairs in the inner layers
+///
+/// Every pair of clusters in two different layers between min_layer and
+/// max_layer which is close in phi is extrapolated as a straight line in r-z
+/// to the beam line. The z at the beam line is filled once into an array of
+/// bins which holds the number of pairs and their sum of z and z^2.
+/// Peaks are searched with a sliding window over the prefix sums of this
+/// array, the window with most pairs is a vertex, its bins are cleared and
+/// the search is repeated for up to max_vertices (pileup) vertices.
+///
+/// Can be used in place of PHInitZVertexing, the vertices are written to
+/// SvtxVertexMap ordered by the number of pairs.
+///
+class PHFastZVertexing : public PHInitVertexing
+{
+ public:
+  PHFastZVertexing(const std::string &name = "PHFastZVertexing");
+  virtual ~PHFastZVertexing() {}
+
+  //! layers used to build pairs, default is the MVTX
+  void set_layers(const unsigned int min_layer, const unsigned int max_layer)
+  {
+    _min_layer = min_layer;
+    _max_layer = max_layer;
+  }
+
+  //! z range and bin size of the pair array, cm
+  void set_z_range(const float z_min, const float z_max, const float bin_size)
+  {
+    _z_min = z_min;
+    _z_max = z_max;
+    _bin_size = bin_size;
+  }
+
+  //! largest phi difference of the two clusters of a pair, rad
+  void set_max_dphi(const float max_dphi) { _max_dphi = max_dphi; }
+
+  //! largest |dz/dr| of a pair
+  void set_max_slope(const float max_slope) { _max_slope = max_slope; }
+
+  //! full width of the peak search window, cm
+  void set_window(const float window) { _window = window; }
+
+  //! minimum distance of two vertices, cm
+  void set_min_vertex_separation(const float separation) { _min_vertex_separation = separation; }
+
+  //! minimum number of pairs in the window for a vertex
+  void set_min_pairs(const unsigned int min_pairs) { _min_pairs = min_pairs; }
+
+  void set_max_vertices(const unsigned int max_vertices) { _max_vertices = max_vertices; }
+
+  //! transverse beam position and its size (standard dev), cm
+  void set_beam_position(const float x, const float y, const float xy_err)
+  {
+    _beam_x = x;
+    _beam_y = y;
+    _beam_xy_err = xy_err;
+  }
+
+ protected:
+  int Setup(PHCompositeNode *topNode);
+
+  int Process(PHCompositeNode *topNode);
+
+  int End(PHCompositeNode * /*topNode*/);
+
+ private:
+  //! fill the clusters of the pair layers, each layer sorted in phi
+  void fill_layer_hits();
+
+  //! fill z at the beam line of all pairs into the bins
+  void fill_pairs();
+
+  //! find peaks and write them to the vertex map
+  void find_vertices();
+
+  //! a cluster in the pair layers, relative to the beam position
+  struct LayerHit
+  {
+    float phi;
+    float r;
+    float z;
+    bool operator<(const LayerHit &other) const { return phi < other.phi; }
+  };
+
+  unsigned int _min_layer;
+  unsigned int _max_layer;
+  float _z_min;
+  float _z_max;
+  float _bin_size;
+  float _max_dphi;
+  float _max_slope;
+  float _window;
+  float _min_vertex_separation;
+  unsigned int _min_pairs;
+  unsigned int _max_vertices;
+  float _beam_x;
+  float _beam_y;
+  float _beam_xy_err;
+
+  //! clusters per pair layer, reused between events
+  std::vector<std::vector<LayerHit> > _layer_hits;
+
+  //! number of pairs, sum of z and z^2 per bin and their prefix sums
+  std::vector<unsigned int> _bin_count;
+  std::vector<double> _bin_sum;
+  std::vector<double> _bin_sum2;
+  std::vector<unsigned int> _prefix_count;
+  std::vector<double> _prefix_sum;
+  std::vector<double> _prefix_sum2;
+};
+
+#endif
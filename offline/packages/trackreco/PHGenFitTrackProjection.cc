@@ -10,6 +10,7 @@
 #include <trackbase_historic/SvtxTrack.h>
 #include <trackbase_historic/SvtxTrackState.h>  // for SvtxTrackState
 
+#include <calobase/RawTowerDefs.h>
 #include <calobase/RawTowerGeomContainer.h>
 #include <calobase/RawTowerContainer.h>
 #include <calobase/RawTower.h>
@@ -21,6 +22,7 @@
 
 #include <phgeom/PHGeomUtility.h>
 
+#include <phfield/PHField.h>
 #include <phfield/PHFieldUtility.h>
 
 #include <fun4all/Fun4AllReturnCodes.h>
@@ -42,11 +44,13 @@
 #include <TParticlePDG.h>                       // for TParticlePDG
 #include <TVector3.h>                           // for TVector3
 
+#include <CLHEP/Units/SystemOfUnits.h>
 #include <CLHEP/Vector/ThreeVector.h>           // for Hep3Vector
 
 // standard includes
 #include <cfloat>                              // for DBL_MAX
 #include <cmath>                                // for isnan, atan2, sqrt, NAN
+#include <algorithm>                             // for max
 #include <cstdlib>                             // for abs
 #include <iostream>
 #include <map>                                  // for _Rb_tree_iterator
@@ -54,7 +58,6 @@
 #include <utility>                              // for pair
 #include <vector>
 
-class PHField;
 class TGeoManager;
 
 //#define DEBUG
@@ -72,9 +75,14 @@ PHGenFitTrackProjection::PHGenFitTrackProjection(const string &name, const int p
 
 		_pid_guess(pid_guess),
 
+		_use_helix(false),
+
+		_helix_max_radius(140.),
+
 		_num_cal_layers(4)
 {
 	_cal_radii.assign(_num_cal_layers, NAN);
+	_cal_bz.assign(_num_cal_layers, 0.);
 	_cal_names.push_back("PRES"); // PRES not yet in G4
 	_cal_names.push_back("CEMC");
 	_cal_names.push_back("HCALIN");
@@ -105,6 +113,21 @@ int PHGenFitTrackProjection::InitRun(PHCompositeNode *topNode) {
 #endif
 
   PHField * field = PHFieldUtility::GetFieldMapNode(nullptr, topNode);
+
+	// effective Bz for the helix: average along the radius up to each layer
+	for (int i = 0; i < _num_cal_layers; ++i) {
+		if (std::isnan(_cal_radii[i]) || !field)
+			continue;
+		const int nsteps = 10;
+		double bzsum = 0;
+		for (int istep = 0; istep <= nsteps; ++istep) {
+			const double point[4] = {_cal_radii[i] * istep / nsteps * CLHEP::cm, 0, 0, 0};
+			double bfield[3] = {0, 0, 0};
+			field->GetFieldValue(point, bfield);
+			bzsum += bfield[2] / CLHEP::tesla;
+		}
+		_cal_bz[i] = bzsum / (nsteps + 1);
+	}
 	_fitter = PHGenFit::Fitter::getInstance(tgeo_manager,field,
 			"DafRef",
 			"RKTrackRep", false);
@@ -127,6 +150,15 @@ int PHGenFitTrackProjection::InitRun(PHCompositeNode *topNode) {
 						<< _cal_radii[i] << " cm" << endl;
 			}
 		}
+		if (_use_helix) {
+			cout << " helix projection up to " << _helix_max_radius << " cm, Bz:";
+			for (int i = 0; i < _num_cal_layers; ++i) {
+				if (!std::isnan(_cal_radii[i])) {
+					cout << " " << _cal_names[i] << " " << _cal_bz[i] << " T";
+				}
+			}
+			cout << endl;
+		}
 		cout << " projections still curl after the mag field" << endl;
 		cout
 				<< " projections start from the vertex momentum vector (M.S. effects could be large)"
@@ -156,6 +188,29 @@ int PHGenFitTrackProjection::process_event(PHCompositeNode *topNode) {
 		return Fun4AllReturnCodes::ABORTRUN;
 	}
 
+	// the outermost state of every track, projected to all layers at once
+	vector<SvtxTrack *> tracks;
+	vector<SvtxTrackState *> states;
+	for (SvtxTrackMap::Iter iter = _g4tracks->begin();
+			iter != _g4tracks->end(); ++iter) {
+		SvtxTrack *track = iter->second;
+		if(!track) {
+			if(Verbosity() >= 2) LogWarning("!track");
+			continue;
+		}
+		auto last_state_iter = --track->end_states();
+		SvtxTrackState * trackstate = last_state_iter->second;
+		if(!trackstate) {
+			if(Verbosity() >= 2) LogWarning("!trackstate");
+			continue;
+		}
+		tracks.push_back(track);
+		states.push_back(trackstate);
+	}
+	const unsigned int ntracks = tracks.size();
+	vector<double> points(3 * ntracks);
+	vector<char> projected(ntracks);
+
 	for (int i = 0; i < _num_cal_layers; ++i) {
 
 		if (std::isnan(_cal_radii[i]))
@@ -194,156 +249,65 @@ int PHGenFitTrackProjection::process_event(PHCompositeNode *topNode) {
 			return Fun4AllReturnCodes::ABORTRUN;
 		}
 
-		// loop over all tracks
-		for (SvtxTrackMap::Iter iter = _g4tracks->begin();
-				iter != _g4tracks->end(); ++iter) {
-			SvtxTrack *track = iter->second;
-#ifdef DEBUG
-			cout
-			<<__LINE__
-			<<": track->get_charge(): "<<track->get_charge()
-			<<endl;
-#endif
-			if(!track) {
-				if(Verbosity() >= 2) LogWarning("!track");
-				continue;
-			}
-
-			if (Verbosity() > 1)
-				cout << "projecting track id " << track->get_id() << endl;
-
-			if (Verbosity() > 1) {
-				cout << " track pt = " << track->get_pt() << endl;
+		// projection of all tracks to this layer, the helix inside the magnet,
+		// GenFit outside of it and for the tracks the helix cannot handle
+		const bool helix = (_use_helix && _cal_radii[i] < _helix_max_radius);
+		if (helix) {
+			ProjectHelix(tracks, states, _cal_radii[i], _cal_bz[i], points, projected);
+		} else {
+			projected.assign(ntracks, 0);
+		}
+		for (unsigned int itrk = 0; itrk < ntracks; ++itrk) {
+			if (!projected[itrk]) {
+				projected[itrk] = ProjectGenFit(tracks[itrk], states[itrk], _cal_radii[i], &points[3 * itrk]);
 			}
+		}
 
-			std::vector<double> point;
-			point.assign(3, -9999.);
-
-			auto last_state_iter = --track->end_states();
-
-			SvtxTrackState * trackstate = last_state_iter->second;
-
-			if(!trackstate) {
-				if(Verbosity() >= 2) LogWarning("!trackstate");
-				continue;
+		// tower energies in a dense eta x phi grid, the sums are O(1) lookups
+		const int phibins = towergeo->get_phibins();
+		const int etabins = towergeo->get_etabins();
+		_tower_grid.assign(phibins * etabins, 0.);
+		RawTowerContainer::ConstRange towers = towerList->getTowers();
+		for (RawTowerContainer::ConstIterator iter = towers.first; iter != towers.second; ++iter) {
+			const int ieta = RawTowerDefs::decode_index1(iter->first);
+			const int iphi = RawTowerDefs::decode_index2(iter->first);
+			if (ieta < etabins && iphi < phibins) {
+				_tower_grid[ieta * phibins + iphi] = iter->second->get_energy();
 			}
+		}
 
-			auto pdg = unique_ptr<TDatabasePDG> (TDatabasePDG::Instance());
-			int reco_charge = track->get_charge();
-			int gues_charge = pdg->GetParticle(_pid_guess)->Charge();
-			if(reco_charge*gues_charge<0) _pid_guess *= -1;
-#ifdef DEBUG
-			cout
-			<<__LINE__
-			<<": guess charge: " << gues_charge
-			<<": reco charge: " << reco_charge
-			<<": pid: " << _pid_guess
-			<<": pT: " << sqrt(trackstate->get_px()*trackstate->get_px() + trackstate->get_py()*trackstate->get_py())
-			<<endl;
-#endif
-
-			auto rep = unique_ptr<genfit::AbsTrackRep> (new genfit::RKTrackRep(_pid_guess));
-
-			unique_ptr<genfit::MeasuredStateOnPlane> msop80 = nullptr;
-
-			{
-				TVector3 pos(trackstate->get_x(), trackstate->get_y(), trackstate->get_z());
-				//pos.SetXYZ(0.01,0,0);
-
-				TVector3 mom(trackstate->get_px(), trackstate->get_py(), trackstate->get_pz());
-				//mom.SetXYZ(1,0,0);
-
-				TMatrixDSym cov(6);
-				for (int i = 0; i < 6; ++i) {
-					for (int j = 0; j < 6; ++j) {
-						cov[i][j] = trackstate->get_error(i, j);
-					}
-				}
-
-				msop80 = unique_ptr<genfit::MeasuredStateOnPlane> (new genfit::MeasuredStateOnPlane(rep.get()));
-
-				msop80->setPosMomCov(pos, mom, cov);
-			}
+		// cluster positions once per layer instead of once per track
+		const RawClusterContainer::Map &clustermap = clusterList->getClustersMap();
+		vector<unsigned int> cluster_id;
+		vector<double> cluster_eta;
+		vector<double> cluster_phi;
+		vector<double> cluster_e;
+		for (const auto & iterator : clustermap) {
+			const RawCluster *cluster = iterator.second;
+			cluster_id.push_back(iterator.first);
+			//! eta as location mark of cluster relative to (0,0,0)
+			cluster_eta.push_back(RawClusterUtility::GetPseudorapidity(*cluster, CLHEP::Hep3Vector(0,0,0)));
+			cluster_phi.push_back(cluster->get_phi());
+			cluster_e.push_back(cluster->get_energy());
+		}
 
-#ifdef DEBUG
-			{
-				double x = msop80->getPos().X();
-				double y = msop80->getPos().Y();
-				double z = msop80->getPos().Z();
-//				double px = msop80->getMom().X();
-//				double py = msop80->getMom().Y();
-				double pz = msop80->getMom().Z();
-				genfit::FieldManager *field_mgr = genfit::FieldManager::getInstance();
-				double Bx=0, By=0, Bz=0;
-				field_mgr->getFieldVal(x,y,z,Bx,By,Bz);
-				cout
-				<< __LINE__
-				<< ": { " << msop80->getPos().Perp() << ", " << msop80->getPos().Phi() << ", " << msop80->getPos().Eta() << "} @ "
-				//<< "{ " << Bx << ", " << By << ", " << Bz << "}"
-				<< "{ " << msop80->getMom().Perp() << ", " << msop80->getMom().Phi() << ", " << pz << "} "
-				<<endl;
-				//msop80->Print();
-			}
-#endif
-			try {
-				rep->extrapolateToCylinder(*msop80, _cal_radii[i], TVector3(0,0,0),  TVector3(0,0,1));
-				//rep->extrapolateToCylinder(*msop80, 5., TVector3(0,0,0),  TVector3(0,0,1));
-			} catch (...) {
-				if(Verbosity() >= 2) LogWarning("extrapolateToCylinder failed");
+		for (unsigned int itrk = 0; itrk < ntracks; ++itrk) {
+			SvtxTrack *track = tracks[itrk];
+			if (!projected[itrk])
 				continue;
-			}
-
-#ifdef DEBUG
-			{
-				cout<<__LINE__<<endl;
-				//msop80->Print();
-				double x = msop80->getPos().X();
-				double y = msop80->getPos().Y();
-				double z = msop80->getPos().Z();
-//				double px = msop80->getMom().X();
-//				double py = msop80->getMom().Y();
-				double pz = msop80->getMom().Z();
-				genfit::FieldManager *field_mgr = genfit::FieldManager::getInstance();
-				double Bx=0, By=0, Bz=0;
-				field_mgr->getFieldVal(x,y,z,Bx,By,Bz);
-				cout
-				<< __LINE__
-				<< ": { " << msop80->getPos().Perp() << ", " << msop80->getPos().Phi() << ", " << msop80->getPos().Eta() << "} @ "
-				//<< "{ " << Bx << ", " << By << ", " << Bz << "}"
-				<< "{ " << msop80->getMom().Perp() << ", " << msop80->getMom().Phi() << ", " << pz << "} "
-				<<endl;
-			}
-#endif
-
-			point[0] = msop80->getPos().X();
-			point[1] = msop80->getPos().Y();
-			point[2] = msop80->getPos().Z();
 
-#ifdef DEBUG
-			cout
-			<<__LINE__
-			<<": GenFit: {"
-			<< point[0] <<", "
-			<< point[1] <<", "
-			<< point[2] <<" }"
-			<<endl;
-#endif
+			double x = points[3 * itrk];
+			double y = points[3 * itrk + 1];
+			double z = points[3 * itrk + 2];
 
-			if (std::isnan(point[0]))
+			if (std::isnan(x) || std::isnan(y) || std::isnan(z))
 				continue;
-			if (std::isnan(point[1]))
-				continue;
-			if (std::isnan(point[2]))
-				continue;
-
-			double x = point[0];
-			double y = point[1];
-			double z = point[2];
 
 			double phi = atan2(y, x);
 			double eta = asinh(z / sqrt(x * x + y * y));
 
 			if (Verbosity() > 1) {
+				cout << "projecting track id " << track->get_id() << endl;
 				cout << " initial track phi = " << track->get_phi();
 				cout << ", eta = " << track->get_eta() << endl;
 				cout << " calorimeter phi = " << phi << ", eta = " << eta
@@ -363,35 +327,31 @@ int PHGenFitTrackProjection::process_event(PHCompositeNode *topNode) {
 			double energy_3x3 = 0.0;
 			double energy_5x5 = 0.0;
 			for (int iphi = binphi - 2; iphi <= binphi + 2; ++iphi) {
+				// wrap around
+				int wrapphi = iphi;
+				if (wrapphi < 0) {
+					wrapphi = phibins + wrapphi;
+				}
+				if (wrapphi >= phibins) {
+					wrapphi = wrapphi - phibins;
+				}
 				for (int ieta = bineta - 2; ieta <= bineta + 2; ++ieta) {
 
-					// wrap around
-					int wrapphi = iphi;
-					if (wrapphi < 0) {
-						wrapphi = towergeo->get_phibins() + wrapphi;
-					}
-					if (wrapphi >= towergeo->get_phibins()) {
-						wrapphi = wrapphi - towergeo->get_phibins();
-					}
-
 					// edges
 					if (ieta < 0)
 						continue;
-					if (ieta >= towergeo->get_etabins())
+					if (ieta >= etabins)
 						continue;
 
-					RawTower* tower = towerList->getTower(ieta, wrapphi);
-					if (tower) {
-
-						energy_5x5 += tower->get_energy();
-						if (abs(iphi - binphi) <= 1 and abs(ieta - bineta) <= 1)
-							energy_3x3 += tower->get_energy();
+					const double energy = _tower_grid[ieta * phibins + wrapphi];
+					energy_5x5 += energy;
+					if (abs(iphi - binphi) <= 1 and abs(ieta - bineta) <= 1)
+						energy_3x3 += energy;
 
-						if (Verbosity() > 1)
-							cout << " tower " << ieta << " " << wrapphi
-									<< " energy = " << tower->get_energy()
-									<< endl;
-					}
+					if (Verbosity() > 1 && energy != 0)
+						cout << " tower " << ieta << " " << wrapphi
+								<< " energy = " << energy
+								<< endl;
 				}
 			}
 
@@ -404,30 +364,18 @@ int PHGenFitTrackProjection::process_event(PHCompositeNode *topNode) {
 			double min_dphi = NAN;
 			double min_deta = NAN;
 			double min_e = NAN;
-#ifdef DEBUG
-			double min_cluster_phi = NAN;
-#endif
-			for (const auto & iterator : clusterList->getClustersMap()) {
-
-				const RawCluster *cluster = iterator.second;
-
-				//! eta as location mark of cluster relative to (0,0,0)
-				const float cluster_eta = RawClusterUtility::GetPseudorapidity(*cluster, CLHEP::Hep3Vector(0,0,0));
-
-				double dphi = atan2(sin(phi - cluster->get_phi()),
-						cos(phi - cluster->get_phi()));
-				double deta = eta - cluster_eta;
+			for (unsigned int iclus = 0; iclus < cluster_id.size(); ++iclus) {
+				double dphi = atan2(sin(phi - cluster_phi[iclus]),
+						cos(phi - cluster_phi[iclus]));
+				double deta = eta - cluster_eta[iclus];
 				double r = sqrt(pow(dphi, 2) + pow(deta, 2));
 
 				if (r < min_r) {
-					min_index = iterator.first;
+					min_index = cluster_id[iclus];
 					min_r = r;
 					min_dphi = dphi;
 					min_deta = deta;
-					min_e = cluster->get_energy();
-#ifdef DEBUG
-					min_cluster_phi = cluster->get_phi();
-#endif
+					min_e = cluster_e[iclus];
 				}
 			}
 
@@ -437,13 +385,6 @@ int PHGenFitTrackProjection::process_event(PHCompositeNode *topNode) {
 				track->set_cal_cluster_id(_cal_types[i], min_index);
 				track->set_cal_cluster_e(_cal_types[i], min_e);
 
-#ifdef DEBUG
-			cout
-			<<__LINE__
-			<<": min_cluster_phi: "<<min_cluster_phi
-			<<endl;
-#endif
-
 				if (Verbosity() > 1) {
 					cout << " nearest cluster dphi = " << min_dphi << " deta = "
 							<< min_deta << " e = " << min_e << endl;
@@ -459,6 +400,130 @@ int PHGenFitTrackProjection::process_event(PHCompositeNode *topNode) {
 	return Fun4AllReturnCodes::EVENT_OK;
 }
 
+void PHGenFitTrackProjection::ProjectHelix(const vector<SvtxTrack *> &tracks, const vector<SvtxTrackState *> &states, const double radius, const double bz,
+		vector<double> &points, vector<char> &projected) const {
+	// radius of curvature in cm: pT [GeV] / (0.3 B [T]) m
+	const double curvature_const = 0.299792458 * fabs(bz) / 100.;
+	const unsigned int ntracks = states.size();
+	projected.assign(ntracks, 0);
+	for (unsigned int itrk = 0; itrk < ntracks; ++itrk) {
+		const SvtxTrackState *state = states[itrk];
+		const double x0 = state->get_x();
+		const double y0 = state->get_y();
+		const double px = state->get_px();
+		const double py = state->get_py();
+		const double pt = sqrt(px * px + py * py);
+		// states outside of the layer go backwards, GenFit does this
+		if (pt <= 0 || x0 * x0 + y0 * y0 >= radius * radius)
+			continue;
+		const double charge = tracks[itrk]->get_charge();
+		double s = NAN;  // transverse path length to the layer
+		double *point = &points[3 * itrk];
+		const double rho = (curvature_const > 0 && charge != 0 ? pt / curvature_const : DBL_MAX);
+		if (rho > 1e6) {
+			// straight line: |p0 + s u| = R
+			const double ux = px / pt;
+			const double uy = py / pt;
+			const double b = x0 * ux + y0 * uy;
+			const double c = x0 * x0 + y0 * y0 - radius * radius;
+			s = -b + sqrt(b * b - c);
+			point[0] = x0 + s * ux;
+			point[1] = y0 + s * uy;
+		} else {
+			// +1 counterclockwise, F = q v x B
+			const double h = (charge * bz > 0 ? -1. : 1.);
+			const double phi0 = atan2(py, px);
+			const double xc = x0 - h * rho * sin(phi0);
+			const double yc = y0 + h * rho * cos(phi0);
+			const double d = sqrt(xc * xc + yc * yc);
+			// curlers never reach the layer
+			if (d > radius + rho || d < fabs(radius - rho) || d <= 0)
+				continue;
+			// the two crossings of the helix circle and the layer
+			const double a = (radius * radius - rho * rho + d * d) / (2 * d);
+			const double hh = sqrt(max(radius * radius - a * a, 0.));
+			const double mx = a * xc / d;
+			const double my = a * yc / d;
+			const double alpha0 = atan2(y0 - yc, x0 - xc);
+			double best = DBL_MAX;
+			for (int sign = -1; sign <= 1; sign += 2) {
+				const double cx = mx - sign * hh * yc / d;
+				const double cy = my + sign * hh * xc / d;
+				// turning angle from the start in the direction of motion
+				double delta = h * (atan2(cy - yc, cx - xc) - alpha0);
+				delta = fmod(delta + 4 * M_PI, 2 * M_PI);
+				if (delta < best) {
+					best = delta;
+					point[0] = cx;
+					point[1] = cy;
+				}
+			}
+			s = rho * best;
+		}
+		point[2] = state->get_z() + s * state->get_pz() / pt;
+		projected[itrk] = 1;
+	}
+}
+
+bool PHGenFitTrackProjection::ProjectGenFit(const SvtxTrack *track, const SvtxTrackState *trackstate, const double radius, double *point) {
+	TDatabasePDG *pdg = TDatabasePDG::Instance();
+	int reco_charge = track->get_charge();
+	int gues_charge = pdg->GetParticle(_pid_guess)->Charge();
+	if(reco_charge*gues_charge<0) _pid_guess *= -1;
+#ifdef DEBUG
+	cout
+	<<__LINE__
+	<<": guess charge: " << gues_charge
+	<<": reco charge: " << reco_charge
+	<<": pid: " << _pid_guess
+	<<": pT: " << sqrt(trackstate->get_px()*trackstate->get_px() + trackstate->get_py()*trackstate->get_py())
+	<<endl;
+#endif
+
+	auto rep = unique_ptr<genfit::AbsTrackRep> (new genfit::RKTrackRep(_pid_guess));
+
+	unique_ptr<genfit::MeasuredStateOnPlane> msop80 = nullptr;
+
+	{
+		TVector3 pos(trackstate->get_x(), trackstate->get_y(), trackstate->get_z());
+
+		TVector3 mom(trackstate->get_px(), trackstate->get_py(), trackstate->get_pz());
+
+		TMatrixDSym cov(6);
+		for (int i = 0; i < 6; ++i) {
+			for (int j = 0; j < 6; ++j) {
+				cov[i][j] = trackstate->get_error(i, j);
+			}
+		}
+
+		msop80 = unique_ptr<genfit::MeasuredStateOnPlane> (new genfit::MeasuredStateOnPlane(rep.get()));
+
+		msop80->setPosMomCov(pos, mom, cov);
+	}
+
+	try {
+		rep->extrapolateToCylinder(*msop80, radius, TVector3(0,0,0),  TVector3(0,0,1));
+	} catch (...) {
+		if(Verbosity() >= 2) LogWarning("extrapolateToCylinder failed");
+		return false;
+	}
+
+	point[0] = msop80->getPos().X();
+	point[1] = msop80->getPos().Y();
+	point[2] = msop80->getPos().Z();
+
+#ifdef DEBUG
+	cout
+	<<__LINE__
+	<<": GenFit: {"
+	<< point[0] <<", "
+	<< point[1] <<", "
+	<< point[2] <<" }"
+	<<endl;
+#endif
+	return true;
+}
+
 int PHGenFitTrackProjection::End(PHCompositeNode *topNode) {
 	return Fun4AllReturnCodes::EVENT_OK;
 }
@@ -17,6 +17,7 @@
 
 // forward declarations
 class PHCompositeNode;
+class SvtxTrackState;
 
 namespace PHGenFit {
 	class Fitter;
@@ -47,16 +48,39 @@ class PHGenFitTrackProjection : public SubsysReco
 		_pid_guess = pidGuess;
 	}
 
+	//! project all tracks at once on a helix in the average Bz (GenFit for the tracks the helix cannot handle)
+	void set_use_helix(bool b) {
+		_use_helix = b;
+	}
+
+	//! layers beyond this radius (cm, outside the solenoid) are always projected with GenFit
+	void set_helix_max_radius(float r) {
+		_helix_max_radius = r;
+	}
+
 
  private:
 
+  //! helix projection of all tracks to radius, projected is 0 for the tracks which need GenFit
+  void ProjectHelix(const std::vector<SvtxTrack *> &tracks, const std::vector<SvtxTrackState *> &states, const double radius, const double bz,
+      std::vector<double> &points, std::vector<char> &projected) const;
+  //! full GenFit extrapolation of a single track, false on failure
+  bool ProjectGenFit(const SvtxTrack *track, const SvtxTrackState *trackstate, const double radius, double *point);
+
   PHGenFit::Fitter * _fitter;
   int _pid_guess;
 
+  bool _use_helix;
+  float _helix_max_radius;
+
   int _num_cal_layers;
   std::vector<SvtxTrack::CAL_LAYER> _cal_types;
   std::vector<std::string> _cal_names;
   std::vector<float> _cal_radii;
+  //! average Bz (tesla) between the beam line and the layer
+  std::vector<double> _cal_bz;
+  //! tower energies of the current layer by eta bin * phibins + phi bin
+  std::vector<double> _tower_grid;
 };
 
 #endif // __PHGENFITTRACKPROJECTION_H__
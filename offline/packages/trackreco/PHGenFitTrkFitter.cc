@@ -193,6 +193,9 @@ int PHGenFitTrkFitter::InitRun(PHCompositeNode* topNode)
     return Fun4AllReturnCodes::ABORTRUN;
   }
 
+  if (_use_field_grid)
+    _fitter->use_field_grid();
+
   //LogDebug(genfit::FieldManager::getInstance()->getFieldVal(TVector3(0, 0, 0)).Z());
 
   _vertex_finder.reset( new genfit::GFRaveVertexFactory(Verbosity()) );
@@ -226,6 +226,9 @@ class PHGenFitTrkFitter : public SubsysReco
   }
   void set_track_map_name(const std::string &map_name) { _track_map_name = map_name; }
 
+  //! interpolate the field from a cartesian grid of the tracking volume, sampled at InitRun
+  void set_use_field_grid(bool b) { _use_field_grid = b; }
+
   //!@name disabled layers interface
   //@{
 
@@ -313,6 +316,9 @@ class PHGenFitTrkFitter : public SubsysReco
   //!
   bool _use_truth_vertex = false;
 
+  //! fast field lookup table in the fits
+  bool _use_field_grid = false;
+
   //! disabled layers
   /** clusters belonging to disabled layers are not included in track fit */
   std::set<int> _disabled_layers;
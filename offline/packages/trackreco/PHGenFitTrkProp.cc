@@ -57,6 +57,7 @@
 
 //ROOT includes for debugging
 #include <TFile.h>
+#include <TGeoManager.h>
 #include <TMatrixDSymfwd.h>                             // for TMatrixDSym
 #include <TMatrixTSym.h>                                // for TMatrixTSym
 #include <TMatrixTUtils.h>                              // for TMatrixTRow
@@ -72,6 +73,7 @@
 #include <cstdlib>                                     // for exit
 #include <iostream>
 #include <memory>
+#include <thread>
 
 class PHField;
 class TGeoManager;
@@ -135,6 +137,8 @@ PHGenFitTrkProp::PHGenFitTrkProp(
   , _max_merging_dz(0.1)
   , _max_share_hits(3)
   , _fitter(nullptr)
+  , _nthreads(1)
+  , _thread_fitters()
   , _track_fitting_alg_name("KalmanFitter")
   , _primary_pid_guess(211)
   , _cut_min_pT(0.2)
@@ -173,7 +177,10 @@ PHGenFitTrkProp::PHGenFitTrkProp(
   _layer_thetaID_phiID_clusterID_phiSize(0.1200 / 30)
   ,  //rad
   _layer_thetaID_phiID_clusterID_zSize(0.1700 / 30)
-  , _PHGenFitTracks()
+  , _seeds()
+  , _seed_tracks()
+  , _seed_status()
+  , _next_seed(0)
   , _init_direction(-1)
   , _blowup_factor(1.)
   , _max_consecutive_missing_layer(20)
@@ -226,6 +233,10 @@ PHGenFitTrkProp::PHGenFitTrkProp(
 PHGenFitTrkProp::~PHGenFitTrkProp()
 {
   delete _fitter;
+  for (PHGenFit::Fitter* fitter : _thread_fitters)
+  {
+    delete fitter;
+  }
 }
 
 int PHGenFitTrkProp::Setup(PHCompositeNode* topNode)
@@ -442,6 +453,26 @@ int PHGenFitTrkProp::InitializePHGenFit(PHCompositeNode* topNode)
   _fitter->set_verbosity(10);
 #endif
 
+  if (_nthreads > 1)
+  {
+    // every thread navigates the geometry with its own TGeoNavigator
+    tgeo_manager->SetMaxThreads(_nthreads);
+
+    for (unsigned int ithread = 1; ithread < _nthreads; ++ithread)
+    {
+      PHGenFit::Fitter* fitter = PHGenFit::Fitter::getInstance(tgeo_manager, field, _track_fitting_alg_name,
+                                                               "RKTrackRep", false);
+      if (!fitter)
+      {
+        cerr << PHWHERE << endl;
+        return Fun4AllReturnCodes::ABORTRUN;
+      }
+      _thread_fitters.push_back(fitter);
+    }
+    if (Verbosity() > 0)
+      cout << PHWHERE << " propagating seeds with " << _nthreads << " threads" << endl;
+  }
+
   return Fun4AllReturnCodes::EVENT_OK;
 }
 
@@ -536,150 +567,71 @@ int PHGenFitTrkProp::KalmanTrkProp()
 
   vector<genfit::Track*> evt_disp_copy;
 
-  _PHGenFitTracks.clear();
-
   //_track_map->identify();
 
   if (Verbosity() > 1){
     cout << " found " << _track_map->size() << " track seeds " << endl;
   }
 
+  /*!
+   * Propagate all seeds first, each into its own candidate list.
+   * The propagation only reads the cluster map and the event vertex, the
+   * seeds are independent of each other and can be handled by several threads.
+   */
+  _seeds.clear();
   for (auto phtrk_iter = _track_map->begin();
-       phtrk_iter != _track_map->end();)
+       phtrk_iter != _track_map->end(); ++phtrk_iter)
     {
-      SvtxTrack* tracklet = phtrk_iter->second;
-      if (Verbosity() >= 10){
-	std::cout
-	  << __LINE__
-	  << ": Processing seed itrack: " << phtrk_iter->first
-	  << ": Total tracks: " << _track_map->size()
-	  << endl;
-      }
-      /*!
-       * Translate sPHENIX track To PHGenFitTracks
-       */
-      if (Verbosity() > 1) _t_translate_to_PHGenFitTrack->restart();
-      SvtxTrackToPHGenFitTracks(tracklet);
-      
-      //if (Verbosity() > 1) _t_translate_to_PHGenFitTrack->stop();
-      
-      /*!
-       * Handle track propagation, termination, output and evt disp.
-       */
-      bool is_splitting_track = false;
-#ifdef _DEBUG_
-      int i = 0;
-#endif
-      if (_PHGenFitTracks.empty()) 
+      _seeds.push_back(phtrk_iter);
+    }
+  const unsigned int nseeds = _seeds.size();
+  _seed_tracks.assign(nseeds, MapPHGenFitTrack());
+  _seed_status.assign(nseeds, Fun4AllReturnCodes::EVENT_OK);
+
+  if (_nthreads > 1 && nseeds > 1)
+    {
+      _next_seed = 0;
+      vector<std::thread> threads;
+      for (unsigned int ithread = 1; ithread < _nthreads; ++ithread)
 	{
-	  cout << "Warning: Conversion of SvtxTrack tracklet " <<  phtrk_iter->first << " to PHGenFitTrack failed, moving to next tracklet " << endl;
-	  ++phtrk_iter;
-	  continue;
+	  threads.push_back(std::thread(&PHGenFitTrkProp::PropagateSeedsThread, this, _thread_fitters[ithread - 1]));
 	}
-      
-      for (auto gftrk_iter = _PHGenFitTracks.begin();
-	   gftrk_iter != _PHGenFitTracks.end(); ++gftrk_iter)
+      PropagateSeedsThread(_fitter);
+      for (auto& thread : threads)
 	{
-	  if(Verbosity() > 10)
-	    {
-	      cout
-		<< __LINE__
-		<< ": propagating Genfit track: " << phtrk_iter->first << endl;
-	    }
+	  thread.join();
+	}
+    }
+  else
+    {
+      for (unsigned int iseed = 0; iseed < nseeds; ++iseed)
+	{
+	  _seed_status[iseed] = PropagateSeed(iseed, _fitter);
+	}
+    }
 
-	  // associate this track with the same vertex as the seed track
-	  //	  unsigned int ivert = tracklet->get_vertex_id();
-	  unsigned int ivert = 0;
-	  gftrk_iter->second->set_vertex_id(ivert);
-	  //cout << PHWHERE << " read back track vertex ID from Genfit track " << gftrk_iter->second->get_vertex_id() << endl;
-	  if(ivert > _vertex.size())
-	    {
-	      cout << PHWHERE << " Track vertex is screwed up, have to quit! #" << ivert << " v_size: " << _vertex.size()  << endl;
-	      return Fun4AllReturnCodes::ABORTRUN;
-	    }
-	  
-	  std::vector<TrkrDefs::cluskey> clusterkeys = gftrk_iter->second->get_cluster_keys();
-	  
-	  unsigned int init_layer = UINT_MAX;
-	  
-	  if (!is_splitting_track)
-	    {
-	      if (_init_direction == 1)
-		{
-		  //init_layer = _cluster_map->get(clusterkeys.front())->get_layer();
-		  init_layer = TrkrDefs::getLayer(clusterkeys.front());
-		  TrackPropPatRec(ivert, gftrk_iter, init_layer, _nlayers_all, true);
-		  TrackPropPatRec(ivert, gftrk_iter, init_layer, 0, false);
-		}
-	      else
-		{
-		  //init_layer = _cluster_map->get(clusterkeys.back())->get_layer();
-		  init_layer = TrkrDefs::getLayer(clusterkeys.back());
-		  TrackPropPatRec(ivert, gftrk_iter, init_layer, 0, true);
-		  TrackPropPatRec(ivert, gftrk_iter, init_layer, _nlayers_all, false);
-		}
-	      is_splitting_track = true;
-	    }
-	  else
-	    {
-	      if (_init_direction == 1)
-		{
-		  //init_layer = _cluster_map->get(clusterkeys.front())->get_layer();
-		  init_layer = TrkrDefs::getLayer(clusterkeys.front());
-		  TrackPropPatRec(ivert, gftrk_iter, init_layer, _nlayers_all, false);
-		}
-	      else
-		{
-		  //init_layer = _cluster_map->get(clusterkeys.back())->get_layer();
-		  init_layer = TrkrDefs::getLayer(clusterkeys.back());
-		  TrackPropPatRec(ivert, gftrk_iter, init_layer, 0, false);
-		}
-	    }
-	  
-#ifdef _DEBUG_
-	  cout
-	    << __LINE__
-	    << ": tracki: " << i
-	    << ": clusterkeys size:  " << gftrk_iter->second->get_cluster_keys().size()
-	    << ": quality: " << gftrk_iter->first
-	    << endl;
-	  ++i;
-#endif
-	  
-	  //_trackID_PHGenFitTrack.erase(iter);
-	}  // loop _PHGenFitTracks
-      
-      
-#ifdef _DEBUG_
-      i = 0;
-      for (auto iter = _PHGenFitTracks.begin();
-	   iter != _PHGenFitTracks.end(); ++iter)
+  /*!
+   * Pick the best candidate of each seed, in the order of the seeds.
+   * The duplicate check depends on the tracks accepted before, so it
+   * stays sequential and gives the same result for any number of threads.
+   */
+  for (unsigned int iseed = 0; iseed < nseeds; ++iseed)
+    {
+      if (_seed_status[iseed] != Fun4AllReturnCodes::EVENT_OK)
 	{
-	  cout
-	    << __LINE__
-	    << ": track: " << i++
-	    << ": clusterkeys size:  " << iter->second->get_cluster_keys().size()
-	    << ": quality: " << iter->first
-	    << endl;
+	  return _seed_status[iseed];
 	}
-#endif
-      
-      //std::sort(_PHGenFitTracks.begin(), _PHGenFitTracks.end());
-      _PHGenFitTracks.sort();
-      
-#ifdef _DEBUG_
-      for (auto iter = _PHGenFitTracks.begin();
-	   iter != _PHGenFitTracks.end(); ++iter)
+
+      auto phtrk_iter = _seeds[iseed];
+      MapPHGenFitTrack& gftracks = _seed_tracks[iseed];
+
+      if (gftracks.empty()) 
 	{
-	  cout
-	    << __LINE__
-	    << ": clusterkeys size:  " << iter->second->get_cluster_keys().size()
-	    << ": quality: " << iter->first
-	    << endl;
+	  cout << "Warning: Conversion of SvtxTrack tracklet " <<  phtrk_iter->first << " to PHGenFitTrack failed, moving to next tracklet " << endl;
+	  continue;
 	}
-#endif
-      
-      auto gftrk_iter_best = _PHGenFitTracks.begin();
+
+      auto gftrk_iter_best = gftracks.begin();
       
       int track_exists = check_track_exists(gftrk_iter_best,phtrk_iter);
       
@@ -697,16 +649,13 @@ int PHGenFitTrkProp::KalmanTrkProp()
 	}
       else
 	{
-	  auto key = phtrk_iter->first;
-	  ++phtrk_iter;
-	  _track_map->erase(key);
-	  continue;
+	  _track_map->erase(phtrk_iter->first);
 	}
       
-      _PHGenFitTracks.clear();
-      
-      ++phtrk_iter;
+      gftracks.clear();
     }
+  _seeds.clear();
+  _seed_tracks.clear();
   
   if(Verbosity() > 1)
     {
@@ -728,6 +677,133 @@ int PHGenFitTrkProp::KalmanTrkProp()
   return Fun4AllReturnCodes::EVENT_OK;
 }
 
+int PHGenFitTrkProp::PropagateSeed(const unsigned int iseed, PHGenFit::Fitter* fitter)
+{
+  auto phtrk_iter = _seeds[iseed];
+  SvtxTrack* tracklet = phtrk_iter->second;
+  MapPHGenFitTrack& gftracks = _seed_tracks[iseed];
+
+  if (Verbosity() >= 10){
+    std::cout
+      << __LINE__
+      << ": Processing seed itrack: " << phtrk_iter->first
+      << ": Total tracks: " << _track_map->size()
+      << endl;
+  }
+  /*!
+   * Translate sPHENIX track To PHGenFitTracks
+   */
+  if (Verbosity() > 1 && _nthreads == 1) _t_translate_to_PHGenFitTrack->restart();
+  SvtxTrackToPHGenFitTracks(tracklet, fitter, gftracks);
+      
+  //if (Verbosity() > 1) _t_translate_to_PHGenFitTrack->stop();
+      
+  /*!
+   * Handle track propagation and termination
+   */
+  bool is_splitting_track = false;
+#ifdef _DEBUG_
+  int i = 0;
+#endif
+      
+  for (auto gftrk_iter = gftracks.begin();
+       gftrk_iter != gftracks.end(); ++gftrk_iter)
+    {
+      if(Verbosity() > 10)
+	{
+	  cout
+	    << __LINE__
+	    << ": propagating Genfit track: " << phtrk_iter->first << endl;
+	}
+
+      // associate this track with the same vertex as the seed track
+      //	  unsigned int ivert = tracklet->get_vertex_id();
+      unsigned int ivert = 0;
+      gftrk_iter->second->set_vertex_id(ivert);
+      //cout << PHWHERE << " read back track vertex ID from Genfit track " << gftrk_iter->second->get_vertex_id() << endl;
+      if(ivert > _vertex.size())
+	{
+	  cout << PHWHERE << " Track vertex is screwed up, have to quit! #" << ivert << " v_size: " << _vertex.size()  << endl;
+	  return Fun4AllReturnCodes::ABORTRUN;
+	}
+	  
+      std::vector<TrkrDefs::cluskey> clusterkeys = gftrk_iter->second->get_cluster_keys();
+	  
+      unsigned int init_layer = UINT_MAX;
+	  
+      if (!is_splitting_track)
+	{
+	  if (_init_direction == 1)
+	    {
+	      init_layer = TrkrDefs::getLayer(clusterkeys.front());
+	      TrackPropPatRec(gftracks, ivert, gftrk_iter, init_layer, _nlayers_all, true);
+	      TrackPropPatRec(gftracks, ivert, gftrk_iter, init_layer, 0, false);
+	    }
+	  else
+	    {
+	      init_layer = TrkrDefs::getLayer(clusterkeys.back());
+	      TrackPropPatRec(gftracks, ivert, gftrk_iter, init_layer, 0, true);
+	      TrackPropPatRec(gftracks, ivert, gftrk_iter, init_layer, _nlayers_all, false);
+	    }
+	  is_splitting_track = true;
+	}
+      else
+	{
+	  if (_init_direction == 1)
+	    {
+	      init_layer = TrkrDefs::getLayer(clusterkeys.front());
+	      TrackPropPatRec(gftracks, ivert, gftrk_iter, init_layer, _nlayers_all, false);
+	    }
+	  else
+	    {
+	      init_layer = TrkrDefs::getLayer(clusterkeys.back());
+	      TrackPropPatRec(gftracks, ivert, gftrk_iter, init_layer, 0, false);
+	    }
+	}
+	  
+#ifdef _DEBUG_
+      cout
+	<< __LINE__
+	<< ": tracki: " << i
+	<< ": clusterkeys size:  " << gftrk_iter->second->get_cluster_keys().size()
+	<< ": quality: " << gftrk_iter->first
+	<< endl;
+      ++i;
+#endif
+    }  // loop gftracks
+      
+  gftracks.sort();
+      
+#ifdef _DEBUG_
+  for (auto iter = gftracks.begin();
+       iter != gftracks.end(); ++iter)
+    {
+      cout
+	<< __LINE__
+	<< ": clusterkeys size:  " << iter->second->get_cluster_keys().size()
+	<< ": quality: " << iter->first
+	<< endl;
+    }
+#endif
+
+  return Fun4AllReturnCodes::EVENT_OK;
+}
+
+void PHGenFitTrkProp::PropagateSeedsThread(PHGenFit::Fitter* fitter)
+{
+  // worker threads need their own navigator on the shared geometry
+  if (gGeoManager && !gGeoManager->GetCurrentNavigator())
+  {
+    gGeoManager->AddNavigator();
+  }
+
+  const unsigned int nseeds = _seeds.size();
+  for (unsigned int iseed = _next_seed++; iseed < nseeds; iseed = _next_seed++)
+  {
+    _seed_status[iseed] = PropagateSeed(iseed, fitter);
+  }
+}
+
 int PHGenFitTrkProp::OutputPHGenFitTrack(
 					 MapPHGenFitTrack::iterator gftrk_iter,
 					 SvtxTrackMap::Iter phtrk_iter)
@@ -873,10 +949,13 @@ int PHGenFitTrkProp::OutputPHGenFitTrack(
   return 0;
 }
 
-int PHGenFitTrkProp::SvtxTrackToPHGenFitTracks(const SvtxTrack* svtxtrack)
+int PHGenFitTrkProp::SvtxTrackToPHGenFitTracks(const SvtxTrack* svtxtrack, PHGenFit::Fitter* fitter, MapPHGenFitTrack& gftracks)
 {
-  // clean up working array for each event
-  _PHGenFitTracks.clear();
+  // clean up working array for each seed
+  gftracks.clear();
+
+  // timers and the analyzing ntuple are shared, only fill them without threads
+  const bool fill_stats = (_nthreads == 1);
   
   double time1 = 0;
   double time2 = 0;
@@ -892,7 +971,7 @@ int PHGenFitTrkProp::SvtxTrackToPHGenFitTracks(const SvtxTrack* svtxtrack)
   float rec = 0;
   float dt = 0;
 
-  if (Verbosity() > 1)
+  if (Verbosity() > 1 && fill_stats)
   {
     time1 = _t_translate1->get_accumulated_time();
     time2 = _t_translate1->get_accumulated_time();
@@ -990,21 +1069,21 @@ int PHGenFitTrkProp::SvtxTrackToPHGenFitTracks(const SvtxTrack* svtxtrack)
   }
   track->addMeasurements(measurements);
 
-  if (Verbosity() > 1) _t_translate2->stop();
-  if (Verbosity() > 1) _t_translate3->restart();
+  if (Verbosity() > 1 && fill_stats) _t_translate2->stop();
+  if (Verbosity() > 1 && fill_stats) _t_translate3->restart();
 
-  if (_fitter->processTrack(track.get(), false) != 0)
+  if (fitter->processTrack(track.get(), false) != 0)
   {
     if (Verbosity() >= 1)
       LogWarning("Seed fitting failed") << std::endl;
-    if (Verbosity() > 1) _t_translate3->stop();
-    if (Verbosity() > 1)
+    if (Verbosity() > 1 && fill_stats) _t_translate3->stop();
+    if (Verbosity() > 1 && fill_stats)
     {
       _t_translate1->stop();
       time2 = _t_translate1->get_accumulated_time();
     }
     dt = time2 - time1;
-    if (_analyzing_mode == true)
+    if (_analyzing_mode == true && fill_stats)
       _analyzing_ntuple->Fill(svtxtrack->get_pt(), kappa, d, phi, dzdl, z0, nhit, ml / nhit, rec, dt);
     return -1;
   }
@@ -1015,25 +1094,26 @@ int PHGenFitTrkProp::SvtxTrackToPHGenFitTracks(const SvtxTrack* svtxtrack)
 
   if (nhits > 0 and chi2 > 0 and ndf > 0)
   {
-    _PHGenFitTracks.push_back(
+    gftracks.push_back(
         MapPHGenFitTrack::value_type(
             PHGenFitTrkProp::TrackQuality(nhits, chi2, ndf, nhits, 0, 0), track));
   }
-  if (Verbosity() > 1) _t_translate3->stop();
-  if (Verbosity() > 1)
+  if (Verbosity() > 1 && fill_stats) _t_translate3->stop();
+  if (Verbosity() > 1 && fill_stats)
   {
     _t_translate1->stop();
     time2 = _t_translate1->get_accumulated_time();
   }
   dt = time2 - time1;
   rec = 1;
-  if (_analyzing_mode == true)
+  if (_analyzing_mode == true && fill_stats)
     _analyzing_ntuple->Fill(svtxtrack->get_pt(), kappa, d, phi, dzdl, z0, nhit, rec, dt);
 
   return Fun4AllReturnCodes::EVENT_OK;
 }
 
 int PHGenFitTrkProp::TrackPropPatRec(
+				     MapPHGenFitTrack& gftracks,
 				     const unsigned int ivert,
 				     MapPHGenFitTrack::iterator& track_iter,
 				     unsigned int init_layer, unsigned int end_layer,
@@ -1125,12 +1205,12 @@ int PHGenFitTrkProp::TrackPropPatRec(
 
     bool layer_updated = false;
 
-    float layer_r = _radii_all[_layer_ilayer_map_all[layer]];
+    float layer_r = _radii_all[_layer_ilayer_map_all.at(layer)];
 
     if(Verbosity() > 10)
       {
 	std::cout << "=========================" << std::endl;
-	std::cout << __LINE__ << ": Event: " << _event << ": _PHGenFitTracks.size(): " << _PHGenFitTracks.size() << ": layer: " << layer << std::endl;
+	std::cout << __LINE__ << ": Event: " << _event << ": gftracks.size(): " << gftracks.size() << ": layer: " << layer << std::endl;
 	std::cout << "=========================" << std::endl;
       }
 
@@ -1239,8 +1319,8 @@ int PHGenFitTrkProp::TrackPropPatRec(
 #else
     TMatrixDSym cov = state->get6DCov();
 
-    float phi_window = _search_wins_phi[layer] * sqrt(cov[0][0] + cov[1][1] + cov[0][1] + cov[1][0]) / pos.Perp();
-    float theta_window = _search_wins_theta[layer] * sqrt(cov[2][2]) / pos.Perp();
+    float phi_window = _search_wins_phi.at(layer) * sqrt(cov[0][0] + cov[1][1] + cov[0][1] + cov[1][0]) / pos.Perp();
+    float theta_window = _search_wins_theta.at(layer) * sqrt(cov[2][2]) / pos.Perp();
 
     if (layer < _nlayers_maps)
     {
@@ -1286,10 +1366,10 @@ int PHGenFitTrkProp::TrackPropPatRec(
 //				);
 #endif
 
-    if (Verbosity() >= 1) _t_search_clusters->restart();
+    if (Verbosity() >= 1 && _nthreads == 1) _t_search_clusters->restart();
     std::vector<TrkrDefs::cluskey> new_cluster_keys = SearchHitsNearBy(ivert, layer,
                                                                  theta_center, phi_center, theta_window, phi_window);
-    if (Verbosity() >= 1) _t_search_clusters->stop();
+    if (Verbosity() >= 1 && _nthreads == 1) _t_search_clusters->stop();
 
 #ifdef _DEBUG_
     cout << __LINE__ << ": new_cluster_keys size: " << new_cluster_keys.size() << std::endl;
@@ -1316,11 +1396,11 @@ int PHGenFitTrkProp::TrackPropPatRec(
     cout << __LINE__ << ": measurements.size(): " << measurements.size() << endl;
 #endif
 
-    if (Verbosity() >= 1) _t_track_propagation->restart();
+    if (Verbosity() >= 1 && _nthreads == 1) _t_track_propagation->restart();
     track->updateOneMeasurementKalman(measurements, incr_chi2s_new_tracks, extrapolate_base_TP_id, direction, blowup_factor, use_fitted_state);
     use_fitted_state = false;
     blowup_factor = 1.;
-    if (Verbosity() >= 1) _t_track_propagation->stop();
+    if (Verbosity() >= 1 && _nthreads == 1) _t_track_propagation->stop();
 
 #ifdef _DEBUG_
     cout << __LINE__ << ": incr_chi2s_new_tracks.size(): " << incr_chi2s_new_tracks.size() << endl;
@@ -1333,7 +1413,7 @@ int PHGenFitTrkProp::TrackPropPatRec(
     {
       auto iter = incr_chi2s_new_tracks.begin();
 
-      if (iter->first < _max_incr_chi2s[layer] and iter->first > 0)
+      if (iter->first < _max_incr_chi2s.at(layer) and iter->first > 0)
       {
 #ifdef _DEBUG_
         cout
@@ -1399,7 +1479,7 @@ int PHGenFitTrkProp::TrackPropPatRec(
 
 	// this is a new track, have to associate it with the vertex
 	iter->second->set_vertex_id(ivert);
-        _PHGenFitTracks.push_back(
+        gftracks.push_back(
             MapPHGenFitTrack::value_type(
                 PHGenFitTrkProp::TrackQuality(
                     tq.nhits + 1,
@@ -1413,7 +1493,7 @@ int PHGenFitTrkProp::TrackPropPatRec(
 
 #ifdef _DEBUG_
       std::cout << __LINE__ << ": "
-                << "_PHGenFitTracksSize: " << _PHGenFitTracks.size() << std::endl;
+                << "_PHGenFitTracksSize: " << gftracks.size() << std::endl;
       std::cout << __LINE__ << ": " << track_iter->second->get_cluster_keys().back() << std::endl;
 #endif
     }
@@ -1622,9 +1702,9 @@ std::vector<TrkrDefs::cluskey> PHGenFitTrkProp::SearchHitsNearBy(const unsigned
     for (unsigned int irphi = lower_phi_bin; irphi <= upper_phi_bin;
          ++irphi)
     {
-      if (Verbosity() >= 2) _t_search_clusters_encoding->restart();
+      if (Verbosity() >= 2 && _nthreads == 1) _t_search_clusters_encoding->restart();
       unsigned int idx = encode_cluster_index(layer, iz, irphi);
-      if (Verbosity() >= 2) _t_search_clusters_encoding->stop();
+      if (Verbosity() >= 2 && _nthreads == 1) _t_search_clusters_encoding->stop();
       
       if(Verbosity() > 10)
 	{
@@ -1642,7 +1722,7 @@ std::vector<TrkrDefs::cluskey> PHGenFitTrkProp::SearchHitsNearBy(const unsigned
 	    }
 	}
       
-      if (Verbosity() >= 2) _t_search_clusters_map_iter->restart();
+      if (Verbosity() >= 2 && _nthreads == 1) _t_search_clusters_map_iter->restart();
       for (auto iter = _layer_thetaID_phiID_clusterID[ivert].lower_bound(idx);
       iter != _layer_thetaID_phiID_clusterID[ivert].upper_bound(idx);
       ++iter)
@@ -1650,7 +1730,7 @@ std::vector<TrkrDefs::cluskey> PHGenFitTrkProp::SearchHitsNearBy(const unsigned
       if(Verbosity() > 10) cout << "      adding cluster with key " << iter->second << endl; 
       cluster_keys.push_back(iter->second);
     }
-      if (Verbosity() >= 2) _t_search_clusters_map_iter->stop();
+      if (Verbosity() >= 2 && _nthreads == 1) _t_search_clusters_map_iter->stop();
     }
     }
       
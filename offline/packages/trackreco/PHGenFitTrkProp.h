@@ -20,6 +20,7 @@
 // shared pointer later on uses this, forward declaration does not cut it
 #include <phgenfit/Track.h> 
 #include <gsl/gsl_rng.h>
+#include <atomic>
 #else
 namespace PHGenFit
 {
@@ -431,6 +432,19 @@ class PHGenFitTrkProp : public PHTrackPropagating
     _primary_pid_guess = primaryPidGuess;
   }
 
+  unsigned int get_nthreads() const
+  {
+    return _nthreads;
+  }
+
+  //! propagate the seeds on nthreads threads, each with its own PHGenFit::Fitter.
+  //! The output does not depend on the number of threads. Needs a thread safe
+  //! GenFit/ROOT geometry setup, default is 1 (no threads)
+  void set_nthreads(unsigned int nthreads)
+  {
+    _nthreads = (nthreads > 0) ? nthreads : 1;
+  }
+
 #if !defined(__CINT__) || defined(__CLING__)
 
  private:
@@ -472,8 +486,14 @@ class PHGenFitTrkProp : public PHTrackPropagating
 
   unsigned int encode_cluster_index(const unsigned int layer, const unsigned int iz, const unsigned int irphi);
 
+  //! KalmanTrkProp Call. Convert, propagate and sort all candidates of seed iseed into _seed_tracks[iseed]
+  int PropagateSeed(const unsigned int iseed, PHGenFit::Fitter* fitter);
+
+  //! take seeds from _next_seed until none is left
+  void PropagateSeedsThread(PHGenFit::Fitter* fitter);
+
   //! KalmanTrkProp Call.
-  int SvtxTrackToPHGenFitTracks(const SvtxTrack* svtxtrack);
+  int SvtxTrackToPHGenFitTracks(const SvtxTrack* svtxtrack, PHGenFit::Fitter* fitter, MapPHGenFitTrack& gftracks);
 
   //	int TrackPropPatRec(PHCompositeNode* topNode,
   //			//const int iPHGenFitTrack, std::shared_ptr<PHGenFit::Track> &track,
@@ -481,6 +501,7 @@ class PHGenFitTrkProp : public PHTrackPropagating
   //			const unsigned int init_layer = 0, const unsigned int end_layer = 66,
   //			const bool use_fitted_state_once = false);
   int TrackPropPatRec(
+		      MapPHGenFitTrack& gftracks,
 		      const unsigned int ivert,
 		      //const int iPHGenFitTrack, std::shared_ptr<PHGenFit::Track> &track,
 		      MapPHGenFitTrack::iterator& track_iter,
@@ -570,6 +591,10 @@ class PHGenFitTrkProp : public PHTrackPropagating
 
   PHGenFit::Fitter* _fitter;
 
+  //! number of propagation threads and one extra fitter for each thread beyond the first
+  unsigned int _nthreads;
+  std::vector<PHGenFit::Fitter*> _thread_fitters;
+
   //! KalmanFitterRefTrack, KalmanFitter, DafSimple, DafRef
   //PHGenFit::Fitter::FitterType _track_fitting_alg_name;
   std::string _track_fitting_alg_name;
@@ -615,7 +640,11 @@ class PHGenFitTrkProp : public PHTrackPropagating
   float _layer_thetaID_phiID_clusterID_phiSize;
   float _layer_thetaID_phiID_clusterID_zSize;
 
-  MapPHGenFitTrack _PHGenFitTracks;
+  //! seeds of the event and their candidates, merged in seed order after propagation
+  std::vector<SvtxTrackMap::Iter> _seeds;
+  std::vector<MapPHGenFitTrack> _seed_tracks;
+  std::vector<int> _seed_status;
+  std::atomic<unsigned int> _next_seed;
   //! +1: inside out; -1: outside in
   int _init_direction;
   float _blowup_factor;
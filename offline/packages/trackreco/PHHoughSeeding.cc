@@ -27,6 +27,7 @@
 #include <trackbase/TrkrCluster.h>                      // for TrkrCluster
 #include <trackbase/TrkrDefs.h>                         // for getLayer, clu...
 #include <trackbase/TrkrClusterContainer.h>
+#include <trackbase/TrkrRegionOfInterest.h>
 
 // sPHENIX Geant4 includes
 #include <g4detectors/PHG4CylinderCellGeom.h>
@@ -113,6 +114,7 @@ PHHoughSeeding::PHHoughSeeding(
   , _magField(1.4)
   , _reject_ghosts(true)
   , _remove_hits(false)
+  , _nthreads(1)
   , _min_pt(0.2)
   , _min_z0(-14.0)
   , _max_z0(+14.0)
@@ -342,6 +344,7 @@ int PHHoughSeeding::Setup(PHCompositeNode* topNode)
          << noboolalpha << endl;
     cout << " Hit removal: " << boolalpha << _remove_hits << noboolalpha
          << endl;
+    cout << " Number of threads: " << _nthreads << endl;
     cout << " Maximum DCA: " << boolalpha << _cut_on_dca << noboolalpha
          << endl;
     if (_cut_on_dca)
@@ -1008,7 +1011,7 @@ int PHHoughSeeding::setup_tracker_object()
   }
 
   _tracker = new sPHENIXSeedFinder(zoomprofile, 1, top_range, _material,
-                                   _radii, _magField);
+                                   _radii, _magField, (_nthreads > 1), _nthreads);
   _tracker->setNLayers(_nlayers_seeding);
   _tracker->requireLayers(_min_nlayers_seeding);
   _tracker->setClusterStartBin(1);
@@ -1108,6 +1111,14 @@ int PHHoughSeeding::translate_input()
 	ilayer = it->second;
       if (ilayer >= _nlayers_seeding) continue;
 
+      // clusters outside the regions of interest are not used for seeding
+      if (_region_of_interest)
+      {
+        const float x = cluster->getPosition(0);
+        const float y = cluster->getPosition(1);
+        if (!_region_of_interest->contains(sqrt(x * x + y * y), atan2(y, x), cluster->getPosition(2))) continue;
+      }
+
       SimpleHit3D hit3d;
       nhits3d++;      
       // capture the cluster keys so the cluster can be found in the cluster container
@@ -1456,7 +1467,10 @@ int PHHoughSeeding::full_track_seeding(int ivert)
 
   _tracker->clear();
   // final track finding
-  _tracker->findHelices(_clusters, _min_combo_hits, _max_combo_hits, _tracks);
+  if (_nthreads > 1)
+    _tracker->findHelicesParallel(_clusters, _min_combo_hits, _max_combo_hits, _tracks);
+  else
+    _tracker->findHelices(_clusters, _min_combo_hits, _max_combo_hits, _tracks);
   if (Verbosity() >= 1)
     cout << "SEEDSTUDY nbefore clean (" << _min_nlayers_seeding << "): " << _tracks.size() << endl;
     // Cleanup Seeds
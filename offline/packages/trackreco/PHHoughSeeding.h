@@ -154,6 +154,12 @@ class PHHoughSeeding : public PHTrackSeeding
     _remove_hits = rh;
   }
 
+  /// number of threads for the final track finding, top level hough bins are searched in parallel
+  void NThreads(const unsigned int n)
+  {
+    _nthreads = n;
+  }
+
   /// adjusts the rate of zooming
   void setBinScale(float scale)
   {
@@ -447,6 +453,7 @@ class PHHoughSeeding : public PHTrackSeeding
 
   bool _reject_ghosts;
   bool _remove_hits;
+  unsigned int _nthreads;
 
   float _min_pt;
   float _min_z0;
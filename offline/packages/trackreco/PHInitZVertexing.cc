@@ -126,8 +126,10 @@ PHInitZVertexing::PHInitZVertexing(unsigned int nlayers,
       _bbc_vertexes(nullptr),
       _trackmap(nullptr),
       _vertex_finder(),
+      _vertex_fit_nthreads(1),
 	_hough_space(nullptr),
 	_hough_funcs(nullptr),
+	_ca(nullptr),
 	_ntp_zvtx_by_event(nullptr),
 	_ntp_zvtx_by_track(nullptr),
 	_z0_dzdl(nullptr),
@@ -168,7 +170,11 @@ PHInitZVertexing::
   if (_t_output_io)  delete _t_output_io;
   if (_hough_space) delete _hough_space;
   if (_hough_funcs) delete _hough_funcs;
-//  delete ca;
+  if (_ca)
+  {
+    _ca->Reset();
+    delete _ca;
+  }
 }
 
 void PHInitZVertexing::set_min_zvtx_tracks(unsigned int min_zvtx_tracks)
@@ -1986,29 +1992,35 @@ int PHInitZVertexing::build_triplets_to_SimpleTrack3D(std::vector<SimpleTrack3D>
 int PHInitZVertexing::cellular_automaton_zvtx_init(std::vector<SimpleTrack3D>& candidate_tracks){
 
   if(Verbosity() > 1) cout<<"Entering cellular autumaton : processing "<< candidate_tracks.size()<<" tracks. "<<endl;
-  std::unique_ptr<CellularAutomaton_v1> ca(new CellularAutomaton_v1(candidate_tracks,_radii,_material));
-	ca->set_hough_space(_hough_space);
-	ca->set_mag_field(_mag_field);
-	ca->set_pt_rescale(_pt_rescale);
-	ca->set_remove_hits(true);
-//	ca->set_propagate_forward(false);// need to implement triplet in forward propagation
-	ca->set_propagate_forward(true);
-        ca->set_verbose(Verbosity());
-//	ca->set_mode(0);
-        ca->set_triplet_mode(true); // triplet
-	ca->set_seeding_mode(false);
-        ca->set_hits_map(hits_map);
-
-	ca->set_remove_inner_hits(true);
-	ca->set_n_layers(_ca_nlayers);
-	ca->set_required_layers(_ca_nlayers);
-	ca->set_ca_chi2_layer(2.0);// 1.0
-	ca->set_ca_chi2(_ca_chi2);
-	ca->set_ca_phi_cut(_ca_phi_cut);
-	ca->set_ca_z_cut(_ca_z_cut);
-	ca->set_ca_dcaxy_cut(_dcaxy_cut);
-	int code = ca->run(_tracks, _track_states, hits_used); // push_back output tracks into _tracks
-	ca->Reset();
+  if (!_ca)
+  {
+    _ca = new CellularAutomaton_v1(candidate_tracks,_radii,_material);
+  }
+  else
+  {
+    _ca->set_input_tracks(candidate_tracks);
+  }
+	_ca->set_hough_space(_hough_space);
+	_ca->set_mag_field(_mag_field);
+	_ca->set_pt_rescale(_pt_rescale);
+	_ca->set_remove_hits(true);
+//	_ca->set_propagate_forward(false);// need to implement triplet in forward propagation
+	_ca->set_propagate_forward(true);
+        _ca->set_verbose(Verbosity());
+//	_ca->set_mode(0);
+        _ca->set_triplet_mode(true); // triplet
+	_ca->set_seeding_mode(false);
+        _ca->set_hits_map(hits_map);
+
+	_ca->set_remove_inner_hits(true);
+	_ca->set_n_layers(_ca_nlayers);
+	_ca->set_required_layers(_ca_nlayers);
+	_ca->set_ca_chi2_layer(2.0);// 1.0
+	_ca->set_ca_chi2(_ca_chi2);
+	_ca->set_ca_phi_cut(_ca_phi_cut);
+	_ca->set_ca_z_cut(_ca_z_cut);
+	_ca->set_ca_dcaxy_cut(_dcaxy_cut);
+	int code = _ca->run(_tracks, _track_states, hits_used); // push_back output tracks into _tracks
 	for(unsigned int i=0; i<candidate_tracks.size(); ++i) candidate_tracks[i].reset();
 	candidate_tracks.clear();
 	if (!code)
@@ -2247,6 +2259,13 @@ int PHInitZVertexing::fit_vertex(){
     	}
 
 	if(Verbosity() > 1) cout<<"start final fitting of vertices in _multi_vtx.. "<<endl;
+
+	// the candidates are independent, fit all of them at once, each from its own initial z guess
+	std::vector<std::vector<float> > multi_vtx_fit(_multi_vtx.size(), _vertex);
+	for (unsigned int i = 0; i<_multi_vtx.size(); ++i) multi_vtx_fit[i][2] = _multi_vtx[i];
+	const std::vector<float> fit_sigmas = {0.10, 0.02, 0.005};
+	_vertex_finder.findVertices(_multi_vtx_tracks, _multi_vtx_track_covars, multi_vtx_fit, fit_sigmas, true, _vertex_fit_nthreads);
+
 	for (unsigned int i = 0; i<_multi_vtx.size(); ++i)
 	{
 	  	if(Verbosity() > 1) cout << " _multi_vtx " << i << " has " << _multi_vtx_tracks[i].size() << " tracks " << endl;
@@ -2260,9 +2279,7 @@ int PHInitZVertexing::fit_vertex(){
     		}
 
 		// for each _multi_vtx, feed the initial vertex guess (as _vertex[2]), the list of tracks and covariances to VertexFitter for the final fit
-		_vertex_finder.findVertex( _multi_vtx_tracks[i], _multi_vtx_track_covars[i], _vertex, 0.10, true);
-		_vertex_finder.findVertex( _multi_vtx_tracks[i], _multi_vtx_track_covars[i], _vertex, 0.02, true);
-		_vertex_finder.findVertex( _multi_vtx_tracks[i], _multi_vtx_track_covars[i], _vertex, 0.005, true);
+		_vertex = multi_vtx_fit[i];
 
 		n_vtx_tracks = _multi_vtx_tracks[i].size();
 		
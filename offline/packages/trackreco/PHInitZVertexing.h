@@ -24,7 +24,7 @@
 // forward declarations
 class BbcVertexMap;
 
-//class CellularAutomaton;
+class CellularAutomaton_v1;
 class HelixHoughBin;
 class HelixHoughSpace;   
 class HelixHoughFuncs;
@@ -124,6 +124,12 @@ public:
 
 	void set_min_zvtx_tracks(unsigned int min_zvtx_tracks);
 
+	//! threads for the final fit of the vertex candidates, the result does not depend on it
+	void set_vertex_fit_nthreads(unsigned int nthreads)
+	{
+		_vertex_fit_nthreads = (nthreads > 0) ? nthreads : 1;
+	}
+
 	const std::vector<int>& get_seeding_layer() const {
 		return _seeding_layer;
 	}
@@ -280,11 +286,13 @@ private:
 
 	VertexFitter _vertex_finder;
 #endif
+	unsigned int _vertex_fit_nthreads;
 
   	HelixHoughSpace* _hough_space;
 	HelixHoughFuncs* _hough_funcs;
 
-//	CellularAutomaton* ca;
+	//! kept over events so that its hit tables and segment buffers are reused
+	CellularAutomaton_v1* _ca;
 
 	TNtuple* _ntp_zvtx_by_event;
 	TNtuple* _ntp_zvtx_by_track;
@@ -134,8 +134,10 @@ PHPatternReco::PHPatternReco(unsigned int nlayers,
       _trackmap(nullptr),
       _vertexmap(nullptr),
       _vertex_finder(),
+      _vertex_fit_nthreads(1),
 	_hough_space(nullptr),
 	_hough_funcs(nullptr),
+	_ca(nullptr),
 	_mode(0),
 	_ntp_zvtx_by_event(nullptr),
 	_ntp_zvtx_by_track(nullptr),
@@ -175,7 +177,11 @@ PHPatternReco::~PHPatternReco()
   delete _t_output_io;
   if (_hough_space != nullptr) delete _hough_space;
   if (_hough_funcs != nullptr) delete _hough_funcs;
-//  if (ca != nullptr) delete ca;
+  if (_ca != nullptr)
+  {
+    _ca->Reset();
+    delete _ca;
+  }
 }
 
 int PHPatternReco::Init(PHCompositeNode* topNode) {
@@ -2048,29 +2054,35 @@ int PHPatternReco::turnoff_hits_used_in_triplets(){
 int PHPatternReco::cellular_automaton_zvtx_init(std::vector<SimpleTrack3D>& candidate_tracks){
 
 	cout<<"Entering cellular autumaton : processing "<< candidate_tracks.size()<<" tracks. "<<endl;
-  std::unique_ptr<CellularAutomaton_v1> ca(new CellularAutomaton_v1(candidate_tracks,_radii,_material));
-	ca->set_hough_space(_hough_space);
-	ca->set_mag_field(_mag_field);
-	ca->set_pt_rescale(_pt_rescale);
-	ca->set_remove_hits(true);
-//	ca->set_propagate_forward(false);// need to implement triplet in forward propagation
-	ca->set_propagate_forward(true);
-
-//	ca->set_mode(0);
-        ca->set_triplet_mode(true); // triplet
-	ca->set_seeding_mode(true);
-        ca->set_hits_map(hits_map);
-
-	ca->set_remove_inner_hits(true);
-	ca->set_n_layers(_ca_nlayers);
-	ca->set_required_layers(_ca_nlayers);
-	ca->set_ca_chi2_layer(2.0);// 1.0
-	ca->set_ca_chi2(_ca_chi2);
-	ca->set_ca_phi_cut(_ca_phi_cut);
-	ca->set_ca_z_cut(_ca_z_cut);
-	ca->set_ca_dcaxy_cut(_dcaxy_cut);
-	int code = ca->run(_tracks, _track_states, hits_used); // push_back output tracks into _tracks
-	ca->Reset();
+  if (!_ca)
+  {
+    _ca = new CellularAutomaton_v1(candidate_tracks,_radii,_material);
+  }
+  else
+  {
+    _ca->set_input_tracks(candidate_tracks);
+  }
+	_ca->set_hough_space(_hough_space);
+	_ca->set_mag_field(_mag_field);
+	_ca->set_pt_rescale(_pt_rescale);
+	_ca->set_remove_hits(true);
+//	_ca->set_propagate_forward(false);// need to implement triplet in forward propagation
+	_ca->set_propagate_forward(true);
+
+//	_ca->set_mode(0);
+        _ca->set_triplet_mode(true); // triplet
+	_ca->set_seeding_mode(true);
+        _ca->set_hits_map(hits_map);
+
+	_ca->set_remove_inner_hits(true);
+	_ca->set_n_layers(_ca_nlayers);
+	_ca->set_required_layers(_ca_nlayers);
+	_ca->set_ca_chi2_layer(2.0);// 1.0
+	_ca->set_ca_chi2(_ca_chi2);
+	_ca->set_ca_phi_cut(_ca_phi_cut);
+	_ca->set_ca_z_cut(_ca_z_cut);
+	_ca->set_ca_dcaxy_cut(_dcaxy_cut);
+	int code = _ca->run(_tracks, _track_states, hits_used); // push_back output tracks into _tracks
 	for(unsigned int i=0; i<candidate_tracks.size(); ++i) candidate_tracks[i].reset();
 	candidate_tracks.clear();
 	if (!code)
@@ -2297,6 +2309,13 @@ int PHPatternReco::fit_vertex(){
     	}
 
 	cout<<"start fitting vertex.. "<<endl;
+
+	// the candidates are independent, fit all of them at once, each from its own initial z guess
+	std::vector<std::vector<float> > multi_vtx_fit(_multi_vtx.size(), _vertex);
+	for (unsigned int i = 0; i<_multi_vtx.size(); ++i) multi_vtx_fit[i][2] = _multi_vtx[i];
+	const std::vector<float> fit_sigmas = {0.10, 0.02, 0.005};
+	_vertex_finder.findVertices(_multi_vtx_tracks, _multi_vtx_track_covars, multi_vtx_fit, fit_sigmas, true, _vertex_fit_nthreads);
+
 	for (unsigned int i = 0; i<_multi_vtx.size(); ++i)
 	{
 		if (_multi_vtx_tracks[i].size()==0) continue;
@@ -2308,9 +2327,7 @@ int PHPatternReco::fit_vertex(){
         		<< _vertex[2] << endl;
     		}
 
-		_vertex_finder.findVertex( _multi_vtx_tracks[i], _multi_vtx_track_covars[i], _vertex, 0.10, true);
-		_vertex_finder.findVertex( _multi_vtx_tracks[i], _multi_vtx_track_covars[i], _vertex, 0.02, true);
-		_vertex_finder.findVertex( _multi_vtx_tracks[i], _multi_vtx_track_covars[i], _vertex, 0.005, true);
+		_vertex = multi_vtx_fit[i];
 
 		n_vtx_tracks = _multi_vtx_tracks[i].size();
 		cout<<"number of fitted tracks for vertex "<<i<< " : "<<n_vtx_tracks <<endl;
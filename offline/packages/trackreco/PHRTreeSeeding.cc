@@ -9,6 +9,8 @@
 
 #include "PHRTreeSeeding.h"
 
+#include "PHClusterSpatialIndex.h"
+
 // trackbase_historic includes
 #include <trackbase_historic/SvtxTrackMap.h>
 #include <trackbase_historic/SvtxTrack_v1.h>
@@ -96,6 +98,7 @@ PHRTreeSeeding::PHRTreeSeeding(
   , _start_layer(start_layer)
   , _phi_scale(2)
   , _z_scale(2)
+  , _cluster_index(nullptr)
 {
 }
 
@@ -377,11 +380,12 @@ double PHRTreeSeeding::phidiff(double phi1, double phi2)
     return d;
 }
 
-void PHRTreeSeeding::QueryTree(const bgi::rtree<pointKey, bgi::quadratic<16>> &rtree, double phimin, double etamin, double lmin, double phimax, double etamax, double lmax, std::vector<pointKey> &returned_values)
+void PHRTreeSeeding::QueryTree(double phimin, double etamin, double lmin, double phimax, double etamax, double lmax, std::vector<pointKey> &returned_values)
 {
-  rtree.query(bgi::intersects(box(point(phimin, etamin, lmin), point(phimax, etamax, lmax))), std::back_inserter(returned_values));
-  if (phimin < 0) rtree.query(bgi::intersects(box(point(2 * M_PI + phimin, etamin, lmin), point(2 * M_PI, etamax, lmax))), std::back_inserter(returned_values));
-  if (phimax > 2 * M_PI) rtree.query(bgi::intersects(box(point(0, etamin, lmin), point(phimax - 2 * M_PI, etamax, lmax))), std::back_inserter(returned_values));
+  // the shared index holds all layers, only use the ones this seeder was using
+  lmin = std::max(lmin, 38.5);
+  if (lmax < lmin) return;
+  _cluster_index->Query(phimin, etamin, lmin, phimax, etamax, lmax, returned_values);
 }
 
 /*double PHRTreeSeeding::pointKeyToTuple(pointKey *pK)
@@ -436,46 +440,17 @@ double PHRTreeSeeding::chisq(const double *xx)
   return chi2;
 }
 
-void PHRTreeSeeding::FillTree()
+void PHRTreeSeeding::FillTree(PHCompositeNode *topNode)
 {
-  //  bgi::rtree<pointKey, bgi::quadratic<16> > rtree;
   PHTimer *t_fill = new PHTimer("t_fill");
   t_fill->stop();
-  int n_dupli = 0;
-  int nlayer[60];
-  for (int j = 0; j < 60; j++) nlayer[j] = 0;
-
-  TrkrClusterContainer::ConstRange clusrange = _cluster_map->getClusters();
-
-  for (TrkrClusterContainer::ConstIterator iter = clusrange.first; iter != clusrange.second; ++iter)
-  {
-    TrkrCluster *cluster = iter->second;
-    TrkrDefs::cluskey ckey = iter->first;
-    unsigned int layer = TrkrDefs::getLayer(ckey);
-    if (layer < 39) continue;
-
-    TVector3 vec(cluster->getPosition(0) - _vertex->get_x(), cluster->getPosition(1) - _vertex->get_y(), cluster->getPosition(2) - _vertex->get_z());
-
-    double clus_phi = vec.Phi();
-    clus_phi -= 2 * M_PI * floor(clus_phi / (2 * M_PI));
-    double clus_eta = vec.Eta();
-    double clus_l = layer;  // _radii_all[layer];
-
-    vector<pointKey> testduplicate;
-    QueryTree(_rtree, clus_phi - 0.00001, clus_eta - 0.00001, layer - 0.5, clus_phi + 0.00001, clus_eta + 0.00001, layer + 0.5, testduplicate);
-    if (!testduplicate.empty())
-    {
-      n_dupli++;
-      continue;
-    }
-    nlayer[layer]++;
-    t_fill->restart();
-    _rtree.insert(std::make_pair(point(clus_phi, clus_eta, clus_l), ckey));
-    t_fill->stop();
-  }
+  t_fill->restart();
+  _cluster_index = PHClusterSpatialIndex::GetIndex(topNode, _cluster_map, _vertex->get_x(), _vertex->get_y(), _vertex->get_z());
+  t_fill->stop();
 
   std::cout << "fill time: " << t_fill->get_accumulated_time() / 1000. << " sec" << std::endl;
-  std::cout << "number of duplicates : " << n_dupli << std::endl;
+  std::cout << "number of duplicates : " << _cluster_index->nDuplicates() << std::endl;
+  delete t_fill;
 }
 
 int PHRTreeSeeding::Process(PHCompositeNode *topNode)
@@ -501,20 +476,18 @@ int PHRTreeSeeding::Process(PHCompositeNode *topNode)
   t_seed->stop();
   t_seed->restart();
 
-  _rtree.clear();
-  FillTree();
+  FillTree(topNode);
 
   int numberofseeds = 0;
-  cout << " entries in tree: " << _rtree.size() << endl;
+  cout << " entries in tree: " << _cluster_index->size() << endl;
 
   for (unsigned int iteration = 0; iteration < 1; ++iteration)
   {
     if (iteration == 1) _start_layer -= 7;
     vector<pointKey> StartLayerClusters;
-    _rtree.query(bgi::intersects(
-                     box(point(0, -3, ((double) _start_layer - 0.5)),
-                         point(2 * M_PI, 3, ((double) _start_layer + 0.5)))),
-                 std::back_inserter(StartLayerClusters));
+    QueryTree(0, -3, ((double) _start_layer - 0.5),
+              2 * M_PI, 3, ((double) _start_layer + 0.5),
+              StartLayerClusters);
 
     for (vector<pointKey>::iterator StartCluster = StartLayerClusters.begin(); StartCluster != StartLayerClusters.end(); StartCluster++)
     {
@@ -522,7 +495,7 @@ int PHRTreeSeeding::Process(PHCompositeNode *topNode)
       double StartEta = StartCluster->first.get<1>();
 
       vector<pointKey> SecondLayerClusters;
-      QueryTree(_rtree,
+      QueryTree(
                 StartPhi - phisr,
                 StartEta - etasr,
                 (double) _start_layer - 1.5,
@@ -572,7 +545,7 @@ int PHRTreeSeeding::Process(PHCompositeNode *topNode)
                << " etamin " << currenteta - etast
                << " etamax " << currenteta + etast
                << endl;
-          QueryTree(_rtree,
+          QueryTree(
                     currentphi - dphidr * (_radii_all[lastgoodlayer] - _radii_all[newlayer]) - phist,
                     currenteta - etast,
                     newlayer - 0.5,
@@ -26,6 +26,7 @@
 #include <vector>    // for vector
 
 class PHCompositeNode;  // lines 196-196
+class PHClusterSpatialIndex;
 class SvtxClusterMap;   // lines 202-202
 class SvtxHitMap;       // lines 211-211
 class SvtxTrackMap;     // lines 204-204
@@ -108,11 +109,11 @@ class PHRTreeSeeding : public PHTrackSeeding
   double phiadd(double phi1, double phi2);
   double phidiff(double phi1, double phi2);
   double costfunction(const double *xx);
-  void FillTree();
+  void FillTree(PHCompositeNode *topNode);
 
 #if !defined(__CINT__) || defined(__CLING__)
   double pointKeyToTuple(pointKey *pK);
-  void QueryTree(const bgi::rtree<pointKey, bgi::quadratic<16>> &rtree, double phimin, double etamin, double lmin, double phimax, double etamax, double lmax, std::vector<pointKey> &returned_values);
+  void QueryTree(double phimin, double etamin, double lmin, double phimax, double etamax, double lmax, std::vector<pointKey> &returned_values);
 #endif
 
  private:
@@ -131,9 +132,8 @@ class PHRTreeSeeding : public PHTrackSeeding
   float _z_scale;
   //std::vector<float> _radii_all;
 
-#if !defined(__CINT__) || defined(__CLING__)
-  bgi::rtree<pointKey, bgi::quadratic<16>> _rtree;
-#endif  // __CINT__
+  //! shared cluster index of this event
+  PHClusterSpatialIndex *_cluster_index;
 };
 
 #endif
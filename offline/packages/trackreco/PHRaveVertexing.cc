@@ -51,9 +51,12 @@
 #include <TMatrixTUtils.h>                        // for TMatrixTRow
 #include <TVector3.h>
 
+#include <algorithm>
+#include <atomic>
 #include <iostream>
 #include <map>
 #include <memory>
+#include <thread>
 #include <utility>
 #include <vector>
 
@@ -80,6 +83,9 @@ PHRaveVertexing::PHRaveVertexing(const string& name)
   , _primary_pid_guess(211)
   , _vertex_min_ndf(20)
   , _vertex_finder(nullptr)
+  , _candidate_max_dz(0)
+  , _nthreads(1)
+  , _thread_vertex_finders()
   , _vertexing_method("avf-smoothing:1")
   , _truth_container(nullptr)
   , _trackmap(nullptr)
@@ -133,6 +139,13 @@ int PHRaveVertexing::InitRun(PHCompositeNode* topNode)
     return Fun4AllReturnCodes::ABORTRUN;
   }
 
+  for (unsigned int ithread = 1; ithread < _nthreads; ++ithread)
+  {
+    genfit::GFRaveVertexFactory* vertex_finder = new genfit::GFRaveVertexFactory(Verbosity());
+    vertex_finder->setMethod(_vertexing_method.data());
+    _thread_vertex_finders.push_back(vertex_finder);
+  }
+
   _t_translate = new PHTimer("_t_translate");
   _t_translate->stop();
 
@@ -159,6 +172,8 @@ int PHRaveVertexing::process_event(PHCompositeNode* topNode)
   //! stands for Refit_GenFit_Tracks
   GenFitTrackMap gf_track_map;
   vector<genfit::Track*> gf_tracks;
+  //! z of the track and its translation, to build the vertex candidates
+  vector<pair<float, genfit::Track*> > z_tracks;
   if (Verbosity() > 1) _t_translate->restart();
   for (SvtxTrackMap::Iter iter = _trackmap->begin(); iter != _trackmap->end();
        ++iter)
@@ -176,12 +191,27 @@ int PHRaveVertexing::process_event(PHCompositeNode* topNode)
       continue;
     gf_track_map.insert({genfit_track, iter->first});
     gf_tracks.push_back(const_cast<genfit::Track*>(genfit_track));
+    z_tracks.push_back(make_pair(svtx_track->get_z(), genfit_track));
   }
   if (Verbosity() > 1) _t_translate->stop();
 
   if (Verbosity() > 1) _t_rave->restart();
   vector<genfit::GFRaveVertex*> rave_vertices;
-  if (gf_tracks.size() >= 2)
+  if (_candidate_max_dz > 0 && gf_tracks.size() >= 2)
+  {
+    // every track is translated once and used by exactly one candidate
+    vector<vector<genfit::Track*> > candidates;
+    BuildCandidates(z_tracks, candidates);
+
+    vector<vector<genfit::GFRaveVertex*> > candidate_vertices;
+    FitCandidates(candidates, candidate_vertices);
+
+    for (const auto& vertices : candidate_vertices)
+    {
+      rave_vertices.insert(rave_vertices.end(), vertices.begin(), vertices.end());
+    }
+  }
+  else if (gf_tracks.size() >= 2)
   {
     try
     {
@@ -196,6 +226,7 @@ int PHRaveVertexing::process_event(PHCompositeNode* topNode)
   if (Verbosity() > 1) _t_rave->stop();
   FillSvtxVertexMap(rave_vertices, gf_track_map);
 
+  for (genfit::GFRaveVertex* rave_vtx : rave_vertices) delete rave_vtx;
   for (auto iter : gf_track_map) delete iter.first;
 
   if (Verbosity() > 1)
@@ -227,6 +258,8 @@ PHRaveVertexing::~PHRaveVertexing()
 {
   delete _fitter;
   delete _vertex_finder;
+  for (genfit::GFRaveVertexFactory* vertex_finder : _thread_vertex_finders)
+    delete vertex_finder;
 }
 
 int PHRaveVertexing::CreateNodes(PHCompositeNode* topNode)
@@ -409,6 +442,73 @@ bool PHRaveVertexing::FillSvtxVertexMap(
   return true;
 }
 
+void PHRaveVertexing::BuildCandidates(
+    const std::vector<std::pair<float, genfit::Track*> >& z_tracks,
+    std::vector<std::vector<genfit::Track*> >& candidates) const
+{
+  candidates.clear();
+
+  // tracks are in key order, keep it for tracks with the same z
+  vector<unsigned int> order(z_tracks.size());
+  for (unsigned int i = 0; i < order.size(); ++i) order[i] = i;
+  std::stable_sort(order.begin(), order.end(), [&z_tracks](unsigned int a, unsigned int b) {
+    return z_tracks[a].first < z_tracks[b].first;
+  });
+
+  vector<genfit::Track*> candidate;
+  float last_z = 0;
+  for (unsigned int i : order)
+  {
+    if (!candidate.empty() && z_tracks[i].first - last_z > _candidate_max_dz)
+    {
+      if (candidate.size() >= 2) candidates.push_back(candidate);
+      candidate.clear();
+    }
+    candidate.push_back(z_tracks[i].second);
+    last_z = z_tracks[i].first;
+  }
+  if (candidate.size() >= 2) candidates.push_back(candidate);
+
+  if (Verbosity() > 1)
+    cout << PHWHERE << " " << z_tracks.size() << " tracks in " << candidates.size() << " vertex candidates" << endl;
+}
+
+void PHRaveVertexing::FitCandidates(
+    const std::vector<std::vector<genfit::Track*> >& candidates,
+    std::vector<std::vector<genfit::GFRaveVertex*> >& candidate_vertices)
+{
+  const unsigned int ncandidates = candidates.size();
+  candidate_vertices.assign(ncandidates, vector<genfit::GFRaveVertex*>());
+
+  // candidates are taken from a common counter, each thread has its own vertex factory
+  std::atomic<unsigned int> next_candidate(0);
+  auto fit_candidates = [&](genfit::GFRaveVertexFactory* vertex_finder) {
+    for (unsigned int i = next_candidate++; i < ncandidates; i = next_candidate++)
+    {
+      try
+      {
+        vertex_finder->findVertices(&candidate_vertices[i], candidates[i]);
+      }
+      catch (...)
+      {
+        if (Verbosity() > 1)
+          std::cout << PHWHERE << "GFRaveVertexFactory::findVertices failed for candidate " << i << std::endl;
+      }
+    }
+  };
+
+  vector<std::thread> threads;
+  for (unsigned int ithread = 1; ithread < _nthreads && ithread < ncandidates; ++ithread)
+  {
+    threads.push_back(std::thread(fit_candidates, _thread_vertex_finders[ithread - 1]));
+  }
+  fit_candidates(_vertex_finder);
+  for (auto& thread : threads)
+  {
+    thread.join();
+  }
+}
+
 genfit::Track* PHRaveVertexing::TranslateSvtxToGenFitTrack(SvtxTrack* svtx_track)
 {
   try
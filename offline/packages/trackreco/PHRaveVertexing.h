@@ -12,6 +12,7 @@
 
 #include <map>                   // for map, map<>::value_compare
 #include <string>
+#include <utility>                 // for pair
 #include <vector>
 
 namespace genfit
@@ -97,6 +98,31 @@ class PHRaveVertexing : public SubsysReco
     _vertex_min_ndf = vertexMinPT;
   }
 
+  float get_candidate_max_dz() const
+  {
+    return _candidate_max_dz;
+  }
+
+  //! split the tracks into vertex candidates where two tracks, ordered in z,
+  //! are more than maxDz apart and fit each candidate on its own.
+  //! 0 (default) fits all tracks together
+  void set_candidate_max_dz(float maxDz)
+  {
+    _candidate_max_dz = maxDz;
+  }
+
+  unsigned int get_nthreads() const
+  {
+    return _nthreads;
+  }
+
+  //! fit the vertex candidates on nthreads threads, each with its own
+  //! GFRaveVertexFactory. Needs a thread safe GenFit/Rave setup, default is 1
+  void set_nthreads(unsigned int nthreads)
+  {
+    _nthreads = (nthreads > 0) ? nthreads : 1;
+  }
+
  private:
   //! Event counter
   int _event;
@@ -109,6 +135,14 @@ class PHRaveVertexing : public SubsysReco
 
   genfit::Track* TranslateSvtxToGenFitTrack(SvtxTrack* svtx);
 
+  //! group the tracks into vertex candidates along z
+  void BuildCandidates(const std::vector<std::pair<float, genfit::Track*> >& z_tracks,
+                       std::vector<std::vector<genfit::Track*> >& candidates) const;
+
+  //! find the vertices of every candidate, candidate_vertices[i] belongs to candidates[i]
+  void FitCandidates(const std::vector<std::vector<genfit::Track*> >& candidates,
+                     std::vector<std::vector<genfit::GFRaveVertex*> >& candidate_vertices);
+
   //! Fill SvtxVertexMap from GFRaveVertexes and Tracks
   bool FillSvtxVertexMap(
       const std::vector<genfit::GFRaveVertex*>& rave_vertices,
@@ -124,6 +158,12 @@ class PHRaveVertexing : public SubsysReco
 
   genfit::GFRaveVertexFactory* _vertex_finder;
 
+  float _candidate_max_dz;
+
+  //! number of threads and one extra vertex factory for each thread beyond the first
+  unsigned int _nthreads;
+  std::vector<genfit::GFRaveVertexFactory*> _thread_vertex_finders;
+
   //! https://rave.hepforge.org/trac/wiki/RaveMethods
   std::string _vertexing_method;
 
@@ -0,0 +1,121 @@
+#include "PHRegionOfInterestMaker.h"
+
+#include <trackbase/TrkrRegionOfInterest.h>
+
+#include <calobase/RawCluster.h>
+#include <calobase/RawClusterContainer.h>
+
+#include <calotrigger/CaloTriggerInfo.h>
+
+#include <fun4all/Fun4AllReturnCodes.h>
+#include <fun4all/SubsysReco.h>  // for SubsysReco
+
+#include <phool/PHCompositeNode.h>
+#include <phool/PHIODataNode.h>
+#include <phool/PHNode.h>  // for PHNode
+#include <phool/PHNodeIterator.h>
+#include <phool/PHObject.h>  // for PHObject
+#include <phool/getClass.h>
+#include <phool/phool.h>  // for PHWHERE
+
+#include <cmath>
+#include <iostream>  // for operator<<, endl
+
+using namespace std;
+
+PHRegionOfInterestMaker::PHRegionOfInterestMaker(const std::string &name)
+  : SubsysReco(name)
+  , _regions(nullptr)
+  , _cluster_node_name("CLUSTER_CEMC")
+  , _cluster_min_energy(2.)
+  , _trigger_min_energy(-1.)
+  , _trigger_radius(95.)
+  , _deta(0.1)
+  , _dphi(0.3)
+  , _vertex_z_min(-30.)
+  , _vertex_z_max(30.)
+{
+}
+
+int PHRegionOfInterestMaker::InitRun(PHCompositeNode *topNode)
+{
+  PHNodeIterator iter(topNode);
+  PHCompositeNode *dstNode = dynamic_cast<PHCompositeNode *>(iter.findFirst("PHCompositeNode", "DST"));
+  if (!dstNode)
+  {
+    cout << PHWHERE << "DST Node missing, doing nothing." << endl;
+    return Fun4AllReturnCodes::ABORTRUN;
+  }
+
+  _regions = findNode::getClass<TrkrRegionOfInterest>(topNode, TrkrRegionOfInterest::GetNodeName());
+  if (!_regions)
+  {
+    PHNodeIterator dstiter(dstNode);
+    PHCompositeNode *DetNode = dynamic_cast<PHCompositeNode *>(dstiter.findFirst("PHCompositeNode", "TRKR"));
+    if (!DetNode)
+    {
+      DetNode = new PHCompositeNode("TRKR");
+      dstNode->addNode(DetNode);
+    }
+    _regions = new TrkrRegionOfInterest();
+    DetNode->addNode(new PHIODataNode<PHObject>(_regions, TrkrRegionOfInterest::GetNodeName(), "PHObject"));
+  }
+
+  return Fun4AllReturnCodes::EVENT_OK;
+}
+
+int PHRegionOfInterestMaker::process_event(PHCompositeNode *topNode)
+{
+  _regions->Reset();
+
+  if (!_cluster_node_name.empty())
+  {
+    RawClusterContainer *clusters = findNode::getClass<RawClusterContainer>(topNode, _cluster_node_name);
+    if (!clusters)
+    {
+      cout << PHWHERE << " ERROR: Can't find node " << _cluster_node_name << endl;
+      return Fun4AllReturnCodes::ABORTRUN;
+    }
+
+    RawClusterContainer::ConstRange range = clusters->getClusters();
+    for (RawClusterContainer::ConstIterator iter = range.first; iter != range.second; ++iter)
+    {
+      const RawCluster *cluster = iter->second;
+      if (cluster->get_energy() < _cluster_min_energy) continue;
+
+      // eta range of the straight lines from the vertex range to the cluster
+      const float r = cluster->get_r();
+      if (!(r > 0)) continue;
+      const float eta_low = asinh((cluster->get_z() - _vertex_z_max) / r);
+      const float eta_high = asinh((cluster->get_z() - _vertex_z_min) / r);
+      _regions->addRegion(0.5 * (eta_low + eta_high), cluster->get_phi(), 0.5 * (eta_high - eta_low) + _deta, _dphi, _vertex_z_min, _vertex_z_max);
+    }
+  }
+
+  if (_trigger_min_energy >= 0)
+  {
+    CaloTriggerInfo *trigger = findNode::getClass<CaloTriggerInfo>(topNode, "CaloTriggerInfo");
+    if (!trigger)
+    {
+      cout << PHWHERE << " ERROR: Can't find node CaloTriggerInfo" << endl;
+      return Fun4AllReturnCodes::ABORTRUN;
+    }
+
+    // the trigger tile eta is given for a vertex at 0, its z at the EMCal radius is
+    // seen from the vertex range as for the clusters
+    if (trigger->get_best_EMCal_4x4_E() >= _trigger_min_energy)
+    {
+      const float z = _trigger_radius * sinh(trigger->get_best_EMCal_4x4_eta());
+      const float eta_low = asinh((z - _vertex_z_max) / _trigger_radius);
+      const float eta_high = asinh((z - _vertex_z_min) / _trigger_radius);
+      _regions->addRegion(0.5 * (eta_low + eta_high), trigger->get_best_EMCal_4x4_phi(), 0.5 * (eta_high - eta_low) + _deta, _dphi, _vertex_z_min, _vertex_z_max);
+    }
+  }
+
+  if (Verbosity() > 0)
+  {
+    _regions->identify();
+  }
+
+  return Fun4AllReturnCodes::EVENT_OK;
+}
@@ -0,0 +1,69 @@
+/*!
+ *  \file		PHRegionOfInterestMaker.h
+ *  \brief		Regions of interest for the tracking from calorimeter clusters or trigger tiles
+ *  \details	Fills the TRKR_ROI node (TrkrRegionOfInterest). With the node present
+ *  			TpcClusterizer, the seeders and the propagators only process the hits,
+ *  			clusters and seeds inside the regions, for instance to reconstruct
+ *  			only the tracks pointing to high energy EMCal clusters.
+ */
+
+#ifndef TRACKRECO_PHREGIONOFINTERESTMAKER_H
+#define TRACKRECO_PHREGIONOFINTERESTMAKER_H
+
+#include <fun4all/SubsysReco.h>
+
+#include <string>
+
+class PHCompositeNode;
+class TrkrRegionOfInterest;
+
+class PHRegionOfInterestMaker : public SubsysReco
+{
+ public:
+  PHRegionOfInterestMaker(const std::string &name = "PHRegionOfInterestMaker");
+  virtual ~PHRegionOfInterestMaker() {}
+
+  int InitRun(PHCompositeNode *topNode);
+  int process_event(PHCompositeNode *topNode);
+
+  //! calorimeter cluster node used as seeds, empty to disable (default CLUSTER_CEMC)
+  void set_cluster_node_name(const std::string &name) { _cluster_node_name = name; }
+
+  //! minimum cluster energy (GeV)
+  void set_cluster_min_energy(const float e) { _cluster_min_energy = e; }
+
+  //! also use the best EMCal 4x4 trigger tile of CaloTriggerInfo if above this energy, negative to disable
+  void set_trigger_min_energy(const float e) { _trigger_min_energy = e; }
+
+  //! radius (cm) at which the trigger tile eta is converted to z, for vertices away from 0
+  void set_trigger_radius(const float r) { _trigger_radius = r; }
+
+  //! half width of the regions around the seed direction
+  void set_window(const float deta, const float dphi)
+  {
+    _deta = deta;
+    _dphi = dphi;
+  }
+
+  //! range of the vertex z of the tracks
+  void set_vertex_z_range(const float zmin, const float zmax)
+  {
+    _vertex_z_min = zmin;
+    _vertex_z_max = zmax;
+  }
+
+ private:
+  TrkrRegionOfInterest *_regions;
+
+  std::string _cluster_node_name;
+  float _cluster_min_energy;
+  float _trigger_min_energy;
+  float _trigger_radius;
+
+  float _deta;
+  float _dphi;
+  float _vertex_z_min;
+  float _vertex_z_max;
+};
+
+#endif
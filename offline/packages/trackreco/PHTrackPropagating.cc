@@ -6,6 +6,7 @@
 #include <trackbase_historic/SvtxVertexMap.h>
 
 #include <trackbase/TrkrClusterContainer.h>
+#include <trackbase/TrkrRegionOfInterest.h>
 
 #include <fun4all/Fun4AllReturnCodes.h>
 #include <fun4all/SubsysReco.h>                // for SubsysReco
@@ -23,6 +24,7 @@ PHTrackPropagating::PHTrackPropagating(const std::string& name)
   , _vertex_map(nullptr)
   , _track_map(nullptr)
   , _assoc_container(nullptr)
+  , _region_of_interest(nullptr)
   , _track_map_name("SvtxTrackMap")
 {
 }
@@ -34,6 +36,12 @@ int PHTrackPropagating::InitRun(PHCompositeNode* topNode)
 
 int PHTrackPropagating::process_event(PHCompositeNode* topNode)
 {
+  // the seeding is done, index its cluster - track associations once.
+  // Propagators with their own Setup may not use the container
+  if (_assoc_container) _assoc_container->BuildIndex();
+
+  // optional, filled per event by the region of interest producer
+  _region_of_interest = findNode::getClass<TrkrRegionOfInterest>(topNode, TrkrRegionOfInterest::GetNodeName());
   return Process();
 }
 
@@ -20,6 +20,7 @@ class TrkrClusterContainer;
 class SvtxVertexMap;
 class SvtxTrackMap;
 class AssocInfoContainer;
+class TrkrRegionOfInterest;
 
 /// \class PHTrackPropagating
 ///
@@ -55,6 +56,10 @@ class PHTrackPropagating : public SubsysReco
   SvtxTrackMap *_track_map;
   AssocInfoContainer *_assoc_container;
 
+  /// regions of interest of the event, nullptr for a full reconstruction.
+  /// Fetched before every Process, only seeds inside are propagated
+  TrkrRegionOfInterest *_region_of_interest;
+
   std::string _track_map_name;
 
  private:
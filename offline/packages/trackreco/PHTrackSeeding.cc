@@ -7,6 +7,7 @@
 #include <trackbase_historic/SvtxVertexMap.h>
 
 #include <trackbase/TrkrClusterContainer.h>
+#include <trackbase/TrkrRegionOfInterest.h>
 
 #include <fun4all/Fun4AllReturnCodes.h>
 #include <fun4all/SubsysReco.h>                  // for SubsysReco
@@ -29,6 +30,7 @@ PHTrackSeeding::PHTrackSeeding(const std::string& name)
   , _vertex_map(nullptr)
   , _track_map(nullptr)
   , _assoc_container(nullptr)
+  , _region_of_interest(nullptr)
   , _track_map_name("SvtxTrackMap")
 {
 }
@@ -40,6 +42,8 @@ int PHTrackSeeding::InitRun(PHCompositeNode* topNode)
 
 int PHTrackSeeding::process_event(PHCompositeNode* topNode)
 {
+  // optional, filled per event by the region of interest producer
+  _region_of_interest = findNode::getClass<TrkrRegionOfInterest>(topNode, TrkrRegionOfInterest::GetNodeName());
   return Process(topNode);
 }
 
@@ -21,6 +21,7 @@ class TrkrClusterContainer;
 class SvtxVertexMap;
 class SvtxTrackMap;
 class AssocInfoContainer;
+class TrkrRegionOfInterest;
 
 /// \class PHTrackSeeding
 ///
@@ -58,6 +59,10 @@ class PHTrackSeeding : public SubsysReco
   SvtxTrackMap *_track_map;
   AssocInfoContainer *_assoc_container;
 
+  /// regions of interest of the event, nullptr for a full reconstruction.
+  /// Fetched before every Process, seeders only start seeds inside
+  TrkrRegionOfInterest *_region_of_interest;
+
   std::string _track_map_name;
 
  private:
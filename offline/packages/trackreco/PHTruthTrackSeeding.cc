@@ -23,13 +23,15 @@
 #include <phool/getClass.h>
 #include <phool/phool.h>
 
+#include <algorithm>
+#include <bitset>
 #include <cstdlib>   // for exit
+#include <functional>  // for cref, ref
 #include <iostream>  // for operator<<, endl
-#include <map>       // for multimap, map<>::c...
+#include <limits>
 #include <memory>
+#include <thread>
 #include <utility>  // for pair
-#include <cassert>
-#include <set>
 
 #define LogDebug(exp) std::cout << "DEBUG: " << __FILE__ << ": " << __LINE__ << ": " << exp << std::endl
 #define LogError(exp) std::cout << "ERROR: " << __FILE__ << ": " << __LINE__ << ": " << exp << std::endl
@@ -49,6 +51,7 @@ PHTruthTrackSeeding::PHTruthTrackSeeding(const std::string& name)
   , clusterhitassoc(nullptr)
   , _min_clusters_per_track(3)
   , _min_momentum(50e-3)  // default to p > 50 MeV
+  , _nthreads(1)
 {
 }
 
@@ -67,169 +70,154 @@ int PHTruthTrackSeeding::Setup(PHCompositeNode* topNode)
 
 int PHTruthTrackSeeding::Process(PHCompositeNode* topNode)
 {
-  typedef std::map<int, std::set<TrkrCluster*> > TrkClustersMap;
-  TrkClustersMap m_trackID_clusters;
-
-  // loop over all clusters
-  TrkrClusterContainer::ConstRange clusrange = _cluster_map->getClusters();
-  for (TrkrClusterContainer::ConstIterator clusiter = clusrange.first; clusiter != clusrange.second; ++clusiter)
+  // sort the associations once, the lookups below only read them and can run on several threads
+  clusterhitassoc->finalize();
+  hittruthassoc->finalize();
+
+  // clusters are ordered by key and so grouped by hitset, index of the first cluster of every hitset
+  std::vector<unsigned int> hitset_first;
+  const unsigned int nclusters = _cluster_map->size();
+  TrkrDefs::hitsetkey last_hitsetkey = 0;
+  for (unsigned int index = 0; index < nclusters; ++index)
   {
-    TrkrCluster* cluster = clusiter->second;
-    TrkrDefs::cluskey cluskey = clusiter->first;
-    unsigned int trkrid = TrkrDefs::getTrkrId(cluskey);
-
-
-    if (Verbosity() >= 3)
+    const TrkrDefs::hitsetkey hitsetkey = TrkrDefs::getHitSetKeyFromClusKey(_cluster_map->getKey(index));
+    if (index == 0 || hitsetkey != last_hitsetkey)
     {
-      cout <<__PRETTY_FUNCTION__<<" process cluster ";
-      cluster->identify();
+      hitset_first.push_back(index);
+      last_hitsetkey = hitsetkey;
     }
+  }
+  const unsigned int nhitsets = hitset_first.size();
+  hitset_first.push_back(nclusters);
 
-    // get the hits for this cluster
-    TrkrClusterHitAssoc::ConstRange hitrange = clusterhitassoc->getHits(cluskey);  // returns range of pairs {cluster key, hit key} for this cluskey
-    for (TrkrClusterHitAssoc::ConstIterator clushititer = hitrange.first; clushititer != hitrange.second; ++clushititer)
+  // match clusters to particles, contiguous blocks of hitsets per thread
+  const unsigned int nthreads = std::max(1U, std::min(_nthreads, nhitsets));
+  std::vector<std::vector<ParticleCluster> > thread_pairs(nthreads);
+  if (nthreads > 1)
+  {
+    vector<std::thread> threads;
+    for (unsigned int ithread = 1; ithread < nthreads; ++ithread)
     {
-      TrkrDefs::hitkey hitkey = clushititer->second;
-      // TrkrHitTruthAssoc uses a map with (hitsetkey, std::pair(hitkey, g4hitkey)) - get the hitsetkey from the cluskey
-      TrkrDefs::hitsetkey hitsetkey = TrkrDefs::getHitSetKeyFromClusKey(cluskey);
-
-      // get all of the g4hits for this hitkey
-      std::multimap<TrkrDefs::hitsetkey, std::pair<TrkrDefs::hitkey, PHG4HitDefs::keytype> > temp_map;
-      hittruthassoc->getG4Hits(hitsetkey, hitkey, temp_map);  // returns pairs (hitsetkey, std::pair(hitkey, g4hitkey)) for this hitkey only
-      for (std::multimap<TrkrDefs::hitsetkey, std::pair<TrkrDefs::hitkey, PHG4HitDefs::keytype> >::iterator htiter = temp_map.begin(); htiter != temp_map.end(); ++htiter)
-      {
-        // extract the g4 hit key here and add the hits to the set
-        PHG4HitDefs::keytype g4hitkey = htiter->second.second;
-        PHG4Hit* phg4hit;
-        if (trkrid == TrkrDefs::tpcId)
-          phg4hit = phg4hits_tpc->findHit(g4hitkey);
-        else if (trkrid == TrkrDefs::inttId)
-          phg4hit = phg4hits_intt->findHit(g4hitkey);
-        else
-          phg4hit = phg4hits_mvtx->findHit(g4hitkey);
-
-        int particle_id = phg4hit->get_trkid();
-
-        // monentum cut-off
-        if (_min_momentum>0)
-        {
-          PHG4Particle* particle = _g4truth_container->GetParticle(particle_id);
-          if (!particle)
-          {
-            cout <<__PRETTY_FUNCTION__<<" - validity check failed: missing truth particle with ID of "<<particle_id<<". Exiting..."<<endl;
-            exit(1);
-          }
-          const double monentum2 =
-              particle->get_px() * particle->get_px()
-              +
-              particle->get_py() * particle->get_py()
-              +
-              particle->get_pz() * particle->get_pz()
-              ;
-
-          if (Verbosity() >= 10)
-          {
-            cout <<__PRETTY_FUNCTION__<<" check momentum for particle"<<particle_id<<" -> cluster "<<cluskey
-                <<" = "<<sqrt(monentum2)<<endl;;
-            particle->identify();
-          }
-
-          if (monentum2 < _min_momentum * _min_momentum)
-          {
-            if (Verbosity() >= 3)
-            {
-              cout <<__PRETTY_FUNCTION__<<" ignore low momentum particle"<<particle_id<<" -> cluster "<<cluskey<<endl;;
-              particle->identify();
-            }
-            continue;
-          }
-        }
-
-
-        TrkClustersMap::iterator it = m_trackID_clusters.find(particle_id);
-
-        if (it != m_trackID_clusters.end())
-        {
-          it->second.insert(cluster);
-          if (Verbosity() >= 3)
-          {
-            cout <<__PRETTY_FUNCTION__<<" append particle"<<particle_id<<" -> cluster "<<cluskey<<endl;;
-            cluster->identify();
-          }
-        }
-        else
-        {
-          std::set<TrkrCluster*> clusters;
-          clusters.insert(cluster);
-          m_trackID_clusters.insert(std::pair<int, std::set<TrkrCluster*> >(particle_id, clusters));
-
-
-          if (Verbosity() >= 3)
-          {
-            cout <<__PRETTY_FUNCTION__<<" new particle"<<particle_id<<" -> cluster "<<cluskey<<endl;;
-            cluster->identify();
-          }
-
-        }
-      }  // loop over g4hits associated with hit
-    }    // loop over hits associated with cluster
-  }      // loop over clusters
+      threads.push_back(std::thread(&PHTruthTrackSeeding::FindParticles, this, std::cref(hitset_first),
+                                    ithread * nhitsets / nthreads, (ithread + 1) * nhitsets / nthreads, std::ref(thread_pairs[ithread])));
+    }
+    FindParticles(hitset_first, 0, nhitsets / nthreads, thread_pairs[0]);
+    for (auto& thread : threads)
+    {
+      thread.join();
+    }
+  }
+  else
+  {
+    FindParticles(hitset_first, 0, nhitsets, thread_pairs[0]);
+  }
 
-  //==================================
+  // (particle, cluster) pairs grouped by particle, a cluster is counted once per particle
+  std::vector<ParticleCluster>& particle_clusters = thread_pairs[0];
+  for (unsigned int ithread = 1; ithread < nthreads; ++ithread)
+  {
+    particle_clusters.insert(particle_clusters.end(), thread_pairs[ithread].begin(), thread_pairs[ithread].end());
+  }
+  std::sort(particle_clusters.begin(), particle_clusters.end());
+  particle_clusters.erase(std::unique(particle_clusters.begin(), particle_clusters.end()), particle_clusters.end());
 
   if (Verbosity() >= 2)
   {
     cout <<__PRETTY_FUNCTION__
-        <<" _track_map->size = "<<_track_map->size()<<endl;
+        <<" _track_map->size = "<<_track_map->size()
+        <<" particle - cluster pairs: "<<particle_clusters.size()<<endl;
   }
 
   // Build track
-  for (TrkClustersMap::const_iterator trk_clusters_itr = m_trackID_clusters.begin();
-       trk_clusters_itr != m_trackID_clusters.end(); ++trk_clusters_itr)
+  std::vector<ParticleCluster>::const_iterator trk_begin = particle_clusters.begin();
+  while (trk_begin != particle_clusters.end())
   {
-    if (trk_clusters_itr->second.size() <  _min_clusters_per_track)
+    const int particle_id = trk_begin->first;
+    std::vector<ParticleCluster>::const_iterator trk_end = trk_begin;
+    while (trk_end != particle_clusters.end() && trk_end->first == particle_id)
+    {
+      ++trk_end;
+    }
+    const unsigned int nclusters_trk = trk_end - trk_begin;
+    std::vector<ParticleCluster>::const_iterator trk_clusters = trk_begin;
+    trk_begin = trk_end;
+
+    if (nclusters_trk < _min_clusters_per_track)
       continue;
 
+    // monentum cut-off, once per particle
+    if (_min_momentum > 0)
+    {
+      PHG4Particle* particle = _g4truth_container->GetParticle(particle_id);
+      if (!particle)
+      {
+        cout <<__PRETTY_FUNCTION__<<" - validity check failed: missing truth particle with ID of "<<particle_id<<". Exiting..."<<endl;
+        exit(1);
+      }
+      const double monentum2 =
+          particle->get_px() * particle->get_px()
+          +
+          particle->get_py() * particle->get_py()
+          +
+          particle->get_pz() * particle->get_pz()
+          ;
+
+      if (Verbosity() >= 10)
+      {
+        cout <<__PRETTY_FUNCTION__<<" check momentum for particle"<<particle_id
+            <<" = "<<sqrt(monentum2)<<endl;;
+        particle->identify();
+      }
+
+      if (monentum2 < _min_momentum * _min_momentum)
+      {
+        if (Verbosity() >= 3)
+        {
+          cout <<__PRETTY_FUNCTION__<<" ignore low momentum particle"<<particle_id<<endl;;
+          particle->identify();
+        }
+        continue;
+      }
+    }
+
     // check number of layers also pass the _min_clusters_per_track cut to avoid tight loopers
-    set<uint8_t> layers;
-    for (TrkrCluster* cluster : trk_clusters_itr->second)
+    std::bitset<256> layers;
+    for (std::vector<ParticleCluster>::const_iterator iter = trk_clusters; iter != trk_end; ++iter)
     {
-      assert(cluster);
-      const uint8_t layer = TrkrDefs::getLayer(cluster->getClusKey());
-      layers.insert(layer);
+      layers.set(TrkrDefs::getLayer(iter->second));
     }
     if (Verbosity()>2)
     {
-      cout <<__PRETTY_FUNCTION__<<" particle "<<trk_clusters_itr->first<<" -> "
-          <<trk_clusters_itr->second.size()<<" clusters covering "<<layers.size()<<" layers."
+      cout <<__PRETTY_FUNCTION__<<" particle "<<particle_id<<" -> "
+          <<nclusters_trk<<" clusters covering "<<layers.count()<<" layers."
           <<" Layer/clusters cuts are > "<<_min_clusters_per_track
           <<endl;
     }
 
-    if (layers.size() >=  _min_clusters_per_track)
+    if (layers.count() >=  _min_clusters_per_track)
     {
 
       std::unique_ptr<SvtxTrack_FastSim> svtx_track(new SvtxTrack_FastSim());
 
       svtx_track->set_id(_track_map->size());
-      svtx_track->set_truth_track_id(trk_clusters_itr->first);
+      svtx_track->set_truth_track_id(particle_id);
 
       // dummy values, set px to make it through the minimum pT cut
       svtx_track->set_px(10.);
       svtx_track->set_py(0.);
       svtx_track->set_pz(0.);
-      for (TrkrCluster* cluster : trk_clusters_itr->second)
+      for (std::vector<ParticleCluster>::const_iterator iter = trk_clusters; iter != trk_end; ++iter)
       {
-        svtx_track->insert_cluster_key(cluster->getClusKey());
-        _assoc_container->SetClusterTrackAssoc(cluster->getClusKey(), svtx_track->get_id());
+        svtx_track->insert_cluster_key(iter->second);
+        _assoc_container->SetClusterTrackAssoc(iter->second, svtx_track->get_id());
       }
 
       _track_map->insert(svtx_track.get());
 
       if (Verbosity() >= 2)
       {
-        cout <<__PRETTY_FUNCTION__<<" particle "<<trk_clusters_itr->first<<" -> "
-            <<trk_clusters_itr->second.size()<<" clusters"
+        cout <<__PRETTY_FUNCTION__<<" particle "<<particle_id<<" -> "
+            <<nclusters_trk<<" clusters"
             <<" _track_map->size = "<< (_track_map->size()) <<": ";
         _track_map->identify();
       }
@@ -271,6 +259,51 @@ int PHTruthTrackSeeding::Process(PHCompositeNode* topNode)
   return Fun4AllReturnCodes::EVENT_OK;
 }
 
+void PHTruthTrackSeeding::FindParticles(const std::vector<unsigned int>& hitset_first, const unsigned int first, const unsigned int last, std::vector<ParticleCluster>& pairs) const
+{
+  // (hit key, particle id) of the current hitset, sorted by hit key
+  std::vector<std::pair<TrkrDefs::hitkey, int> > hit_particles;
+  for (unsigned int ihitset = first; ihitset < last; ++ihitset)
+  {
+    const TrkrDefs::cluskey first_key = _cluster_map->getKey(hitset_first[ihitset]);
+    const TrkrDefs::hitsetkey hitsetkey = TrkrDefs::getHitSetKeyFromClusKey(first_key);
+    const unsigned int trkrid = TrkrDefs::getTrkrId(first_key);
+    PHG4HitContainer* phg4hits;
+    if (trkrid == TrkrDefs::tpcId)
+      phg4hits = phg4hits_tpc;
+    else if (trkrid == TrkrDefs::inttId)
+      phg4hits = phg4hits_intt;
+    else
+      phg4hits = phg4hits_mvtx;
+
+    // particles of the hits of this hitset, the g4hits are looked up once per association
+    hit_particles.clear();
+    const TrkrHitTruthAssoc::ConstRange truthrange = hittruthassoc->getAssocs(hitsetkey);
+    for (TrkrHitTruthAssoc::ConstIterator htiter = truthrange.first; htiter != truthrange.second; ++htiter)
+    {
+      PHG4Hit* phg4hit = phg4hits->findHit(htiter->second.second);
+      hit_particles.push_back(std::make_pair(htiter->second.first, phg4hit->get_trkid()));
+    }
+    std::sort(hit_particles.begin(), hit_particles.end());
+
+    for (unsigned int index = hitset_first[ihitset]; index < hitset_first[ihitset + 1]; ++index)
+    {
+      const TrkrDefs::cluskey cluskey = _cluster_map->getKey(index);
+      const TrkrClusterHitAssoc::ConstRange hitrange = clusterhitassoc->getHits(cluskey);
+      for (TrkrClusterHitAssoc::ConstIterator clushititer = hitrange.first; clushititer != hitrange.second; ++clushititer)
+      {
+        const TrkrDefs::hitkey hitkey = clushititer->second;
+        std::vector<std::pair<TrkrDefs::hitkey, int> >::const_iterator iter = std::lower_bound(
+            hit_particles.begin(), hit_particles.end(), std::make_pair(hitkey, std::numeric_limits<int>::min()));
+        for (; iter != hit_particles.end() && iter->first == hitkey; ++iter)
+        {
+          pairs.push_back(std::make_pair(iter->second, cluskey));
+        }
+      }
+    }
+  }
+}
+
 int PHTruthTrackSeeding::GetNodes(PHCompositeNode* topNode)
 {
   _g4truth_container = findNode::getClass<PHG4TruthInfoContainer>(topNode, "G4TruthInfo");
@@ -9,7 +9,11 @@
 
 #include "PHTrackSeeding.h"
 
-#include <string>  // for string
+#include <trackbase/TrkrDefs.h>
+
+#include <string>   // for string
+#include <utility>  // for pair
+#include <vector>
 
 // forward declarations
 class PHCompositeNode;
@@ -25,6 +29,11 @@ class TrkrHitTruthAssoc;
 ///
 /// \brief Vertexing using truth info
 ///
+/// The clusters are matched to truth particles in one pass over the
+/// cluster - hit and hit - truth associations, hitset by hitset. The
+/// (particle, cluster) pairs are then sorted and one seed is made for
+/// every particle passing the cuts. The matching can be split between
+/// threads (set_nthreads), the seeds do not depend on the number of threads.
 
 class PHTruthTrackSeeding : public PHTrackSeeding
 {
@@ -54,6 +63,17 @@ class PHTruthTrackSeeding : public PHTrackSeeding
     _min_momentum = m;
   }
 
+  unsigned int get_nthreads() const
+  {
+    return _nthreads;
+  }
+
+  //! match clusters to particles on nthreads threads, default is 1 (no threads)
+  void set_nthreads(unsigned int nthreads)
+  {
+    _nthreads = (nthreads > 0) ? nthreads : 1;
+  }
+
  protected:
   int Setup(PHCompositeNode* topNode);
 
@@ -65,6 +85,13 @@ class PHTruthTrackSeeding : public PHTrackSeeding
   /// fetch node pointers
   int GetNodes(PHCompositeNode* topNode);
 
+  //! truth particle id and cluster key
+  typedef std::pair<int, TrkrDefs::cluskey> ParticleCluster;
+
+  /// append the (particle, cluster) pairs of hitsets [first, last)
+  /// hitset_first holds the index of the first cluster of every hitset and the number of clusters
+  void FindParticles(const std::vector<unsigned int>& hitset_first, unsigned int first, unsigned int last, std::vector<ParticleCluster>& pairs) const;
+
   PHG4TruthInfoContainer* _g4truth_container;
 
   PHG4HitContainer* phg4hits_tpc;
@@ -83,6 +110,8 @@ class PHTruthTrackSeeding : public PHTrackSeeding
 
   //! minimal truth momentum cut
   double _min_momentum;
+
+  unsigned int _nthreads;
 };
 
 #endif
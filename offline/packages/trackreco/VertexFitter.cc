@@ -1,11 +1,16 @@
 #include "VertexFitter.h"
 
+#include <HelixHough/NewtonMinimizerFixed.h>
 #include <HelixHough/NewtonMinimizerGradHessian.h>
 #include <HelixHough/VertexFitFunc.h>
 
 // Eigen includes
 #include <Eigen/Core>
 
+#include <algorithm>
+#include <atomic>
+#include <thread>
+
 class SimpleTrack3D;
 
 using namespace std;
@@ -36,14 +41,36 @@ bool VertexFitter::findVertex(vector<SimpleTrack3D>& tracks, vector<float>& vert
 bool VertexFitter::findVertex(vector<SimpleTrack3D>& tracks, vector<Matrix<float,5,5> >& covariances, vector<float>& vertex, float sigma, bool fix_xy)
 {
   VertexFitFunc _vertexfit;
-  //NewtonMinimizer::NewtonMinimizerGradHessian _minimizer;
-  FitNewton::NewtonMinimizerGradHessian _minimizer;
 
   // setup function to minimize
   // expo-dca2 => ~dca^2 w/ extreme outlier de-weighting
   _vertexfit.setTracks(&tracks);
   _vertexfit.setCovariances(&covariances);
-    
+  _vertexfit.setFixedPar(0, sigma);                     // index = 0 used for x,y,z uncertainties
+
+  if(vertex.size() == 3)
+  {
+    // x,y,z: fixed size minimizer, no heap allocations or virtual calls in the iterations
+    NewtonMinimizerFixed<3, VertexFitFunc> _minimizer;
+    _minimizer.setFunction(&_vertexfit);
+    if(fix_xy)
+    {
+      _minimizer.fixParameter(0);
+      _minimizer.fixParameter(1);
+    }
+    NewtonMinimizerFixed<3, VertexFitFunc>::Vector start_point(vertex[0], vertex[1], vertex[2]);
+    NewtonMinimizerFixed<3, VertexFitFunc>::Vector min_point = NewtonMinimizerFixed<3, VertexFitFunc>::Vector::Zero();
+    _minimizer.minimize(start_point, min_point, 1.0e-12, 48, 1.0e-18);
+    for(unsigned i=0; i<3; i++)
+    {
+      vertex[i] = min_point(i);
+    }
+    return true;
+  }
+
+  //NewtonMinimizer::NewtonMinimizerGradHessian _minimizer;
+  FitNewton::NewtonMinimizerGradHessian _minimizer;
+
   // setup the minimizer
   // fast Newton gradient minimization
   _minimizer.setFunction(&_vertexfit);
@@ -59,7 +86,6 @@ bool VertexFitter::findVertex(vector<SimpleTrack3D>& tracks, vector<Matrix<float
     _minimizer.fixParameter(0);
     _minimizer.fixParameter(1);
   }
-  _vertexfit.setFixedPar(0, sigma);                     // index = 0 used for x,y,z uncertainties
 
   // output storage
   VectorXd min_point = VectorXd::Zero(vertex.size());   // output vector for minimize method below
@@ -75,3 +101,35 @@ bool VertexFitter::findVertex(vector<SimpleTrack3D>& tracks, vector<Matrix<float
 
   return true;
 }
+
+bool VertexFitter::findVertices(vector<vector<SimpleTrack3D> >& tracks, vector<vector<Matrix<float,5,5> > >& covariances, vector<vector<float> >& vertices, const vector<float>& sigmas, bool fix_xy, unsigned int nthreads)
+{
+  const unsigned int ncandidates = std::min(tracks.size(), std::min(covariances.size(), vertices.size()));
+
+  // candidates are independent, each is only touched by the thread that took it
+  std::atomic<unsigned int> next_candidate(0);
+  auto fit_candidates = [&]() {
+    for (unsigned int i = next_candidate++; i < ncandidates; i = next_candidate++)
+    {
+      if (tracks[i].empty()) continue;
+      for (float sigma : sigmas)
+      {
+        findVertex(tracks[i], covariances[i], vertices[i], sigma, fix_xy);
+      }
+    }
+  };
+
+  nthreads = std::max(1u, std::min(nthreads, ncandidates));
+  vector<std::thread> threads;
+  for (unsigned int ithread = 1; ithread < nthreads; ++ithread)
+  {
+    threads.push_back(std::thread(fit_candidates));
+  }
+  fit_candidates();
+  for (auto& thread : threads)
+  {
+    thread.join();
+  }
+
+  return true;
+}
@@ -27,6 +27,16 @@ class VertexFitter {
   bool findVertex(std::vector<SimpleTrack3D>& tracks,
                   std::vector<float>& vertex, float sigma, bool fix_xy = false);
 
+  /// fit several independent vertex candidates, each with findVertex for
+  /// every sigma in turn. Candidates without tracks are left unchanged.
+  /// The candidates are distributed over nthreads threads, the result
+  /// does not depend on the number of threads.
+  bool findVertices(std::vector<std::vector<SimpleTrack3D> >& tracks,
+                    std::vector<std::vector<Eigen::Matrix<float, 5, 5> > >& covariances,
+                    std::vector<std::vector<float> >& vertices,
+                    const std::vector<float>& sigmas, bool fix_xy = false,
+                    unsigned int nthreads = 1);
+
  protected:
 };
 
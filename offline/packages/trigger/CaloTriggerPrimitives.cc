@@ -0,0 +1,50 @@
+#include "CaloTriggerPrimitives.h"
+
+#include <cmath>
+
+unsigned char CaloTriggerPrimitives::get_max_adc(const WindowType type) const
+{
+  unsigned char max_adc = 0;
+  for (unsigned int i = begin(type); i < end(type); ++i)
+  {
+    if (get_adc(i) > max_adc)
+    {
+      max_adc = get_adc(i);
+    }
+  }
+  return max_adc;
+}
+
+const char *CaloTriggerPrimitives::get_name(const WindowType type)
+{
+  switch (type)
+  {
+  case EMCAL_2x2:
+    return "EMCal_2x2";
+  case EMCAL_4x4:
+    return "EMCal_4x4";
+  case FULLCALO_0p2x0p2:
+    return "FullCalo_0p2x0p2";
+  case FULLCALO_0p4x0p4:
+    return "FullCalo_0p4x0p4";
+  case FULLCALO_0p6x0p6:
+    return "FullCalo_0p6x0p6";
+  case FULLCALO_0p8x0p8:
+    return "FullCalo_0p8x0p8";
+  case FULLCALO_1p0x1p0:
+    return "FullCalo_1p0x1p0";
+  default:
+    break;
+  }
+  return "unknown";
+}
+
+unsigned char CaloTriggerPrimitives::energy_to_adc(const double E)
+{
+  if (!(E > 0))
+  {
+    return 0;
+  }
+  const double counts = std::floor(E / (45.0 / 256));
+  return (counts > 255 ? 255 : counts);
+}
@@ -0,0 +1,70 @@
+#ifndef TRIGGER_CALOTRIGGERPRIMITIVES_H
+#define TRIGGER_CALOTRIGGERPRIMITIVES_H
+
+#include <phool/PHObject.h>
+
+/// \class CaloTriggerPrimitives
+///
+/// \brief window sums of one event above a low floor, packed as 8 bit values
+///
+/// Every window type keeps the (ieta * nphi + iphi) index and the 8 bit
+/// sum (45 GeV / 256 per count, saturating at 255) of its windows
+/// above the floor set in CaloTriggerSim. Thresholds at or above the
+/// floor can then be applied offline without rerunning the simulation.
+///
+class CaloTriggerPrimitives : public PHObject
+{
+ public:
+  enum WindowType
+  {
+    EMCAL_2x2 = 0,
+    EMCAL_4x4 = 1,
+    FULLCALO_0p2x0p2 = 2,
+    FULLCALO_0p4x0p4 = 3,
+    FULLCALO_0p6x0p6 = 4,
+    FULLCALO_0p8x0p8 = 5,
+    FULLCALO_1p0x1p0 = 6,
+    NWINDOWTYPES = 7
+  };
+
+  virtual ~CaloTriggerPrimitives() {}
+
+  virtual void identify(std::ostream &os = std::cout) const { os << "CaloTriggerPrimitives base class" << std::endl; }
+  virtual void Reset() {}
+  virtual int isValid() const { return 0; }
+
+  /// number of windows along eta and phi, the index of a window is ieta * nphi + iphi
+  virtual void set_grid(const WindowType type, const int neta, const int nphi) {}
+  virtual int get_neta(const WindowType type) const { return 0; }
+  virtual int get_nphi(const WindowType type) const { return 0; }
+
+  /// floor in counts, windows below it are not stored
+  virtual void set_floor(const unsigned char adc) {}
+  virtual unsigned char get_floor() const { return 0; }
+
+  /// windows have to be added ordered by type
+  virtual void add_window(const WindowType type, const unsigned int index, const unsigned char adc) {}
+
+  /// the windows of a type are [begin(type), end(type))
+  virtual unsigned int begin(const WindowType type) const { return 0; }
+  virtual unsigned int end(const WindowType type) const { return 0; }
+  virtual unsigned int get_index(const unsigned int i) const { return 0; }
+  virtual unsigned char get_adc(const unsigned int i) const { return 0; }
+
+  /// highest window of a type in counts, 0 if none is stored
+  virtual unsigned char get_max_adc(const WindowType type) const;
+
+  static const char *get_name(const WindowType type);
+
+  /// same 8 bit scale as CaloTriggerSim::truncate_8bit
+  static unsigned char energy_to_adc(const double E);
+  static double adc_to_energy(const unsigned char adc) { return adc * (45.0 / 256); }
+
+ protected:
+  CaloTriggerPrimitives() {}
+
+ private:
+  ClassDef(CaloTriggerPrimitives, 1);
+};
+
+#endif  // TRIGGER_CALOTRIGGERPRIMITIVES_H
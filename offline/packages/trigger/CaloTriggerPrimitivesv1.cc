@@ -0,0 +1,59 @@
+#include "CaloTriggerPrimitivesv1.h"
+
+#include <phool/phool.h>
+
+#include <ostream>
+
+using namespace std;
+
+CaloTriggerPrimitivesv1::CaloTriggerPrimitivesv1()
+  : m_NEta(NWINDOWTYPES, 0)
+  , m_NPhi(NWINDOWTYPES, 0)
+  , m_Floor(0)
+  , m_Begin(NWINDOWTYPES + 1, 0)
+{
+}
+
+void CaloTriggerPrimitivesv1::Reset()
+{
+  m_Begin.assign(NWINDOWTYPES + 1, 0);
+  m_Index.clear();
+  m_ADC.clear();
+}
+
+void CaloTriggerPrimitivesv1::set_grid(const WindowType type, const int neta, const int nphi)
+{
+  if (neta * nphi > 0xFFFF)
+  {
+    cout << PHWHERE << " " << get_name(type) << " grid " << neta << " x " << nphi
+         << " does not fit the 16 bit window index" << endl;
+  }
+  m_NEta[type] = neta;
+  m_NPhi[type] = nphi;
+}
+
+void CaloTriggerPrimitivesv1::add_window(const WindowType type, const unsigned int index, const unsigned char adc)
+{
+  if (m_Begin[type + 1] != m_Index.size())
+  {
+    cout << PHWHERE << " " << get_name(type) << " window added after windows of a later type, ignored" << endl;
+    return;
+  }
+  m_Index.push_back(index);
+  m_ADC.push_back(adc);
+  for (unsigned int t = type + 1; t < m_Begin.size(); ++t)
+  {
+    m_Begin[t] = m_Index.size();
+  }
+}
+
+void CaloTriggerPrimitivesv1::identify(ostream &os) const
+{
+  os << "CaloTriggerPrimitivesv1: " << m_Index.size() << " windows above " << (int) m_Floor << " counts" << endl;
+  for (int t = 0; t < NWINDOWTYPES; ++t)
+  {
+    const WindowType type = static_cast<WindowType>(t);
+    os << "  " << get_name(type) << " (" << m_NEta[t] << " x " << m_NPhi[t] << "): "
+       << end(type) - begin(type) << " windows, highest " << (int) get_max_adc(type) << " counts" << endl;
+  }
+}
@@ -0,0 +1,47 @@
+#ifndef TRIGGER_CALOTRIGGERPRIMITIVESV1_H
+#define TRIGGER_CALOTRIGGERPRIMITIVESV1_H
+
+#include "CaloTriggerPrimitives.h"
+
+#include <iostream>
+#include <vector>
+
+class CaloTriggerPrimitivesv1 : public CaloTriggerPrimitives
+{
+ public:
+  CaloTriggerPrimitivesv1();
+  virtual ~CaloTriggerPrimitivesv1() {}
+
+  void identify(std::ostream &os = std::cout) const;
+  void Reset();
+  int isValid() const { return 1; }
+
+  void set_grid(const WindowType type, const int neta, const int nphi);
+  int get_neta(const WindowType type) const { return m_NEta[type]; }
+  int get_nphi(const WindowType type) const { return m_NPhi[type]; }
+
+  void set_floor(const unsigned char adc) { m_Floor = adc; }
+  unsigned char get_floor() const { return m_Floor; }
+
+  void add_window(const WindowType type, const unsigned int index, const unsigned char adc);
+
+  unsigned int begin(const WindowType type) const { return m_Begin[type]; }
+  unsigned int end(const WindowType type) const { return m_Begin[type + 1]; }
+  unsigned int get_index(const unsigned int i) const { return m_Index[i]; }
+  unsigned char get_adc(const unsigned int i) const { return m_ADC[i]; }
+
+ private:
+  /// window grid, constant within a run but small enough to keep with every event
+  std::vector<short> m_NEta;
+  std::vector<short> m_NPhi;
+  unsigned char m_Floor;
+
+  /// windows of type t are [m_Begin[t], m_Begin[t + 1])
+  std::vector<unsigned int> m_Begin;
+  std::vector<unsigned short> m_Index;
+  std::vector<unsigned char> m_ADC;
+
+  ClassDef(CaloTriggerPrimitivesv1, 1);
+};
+
+#endif  // TRIGGER_CALOTRIGGERPRIMITIVESV1_H
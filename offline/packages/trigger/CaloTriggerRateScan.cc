@@ -0,0 +1,187 @@
+#include "CaloTriggerRateScan.h"
+
+#include <fun4all/Fun4AllReturnCodes.h>
+#include <fun4all/SubsysReco.h>
+
+#include <phool/getClass.h>
+#include <phool/phool.h>
+
+#include <TFile.h>
+#include <TH1.h>
+#include <TH2.h>
+
+#include <iostream>
+
+using namespace std;
+
+CaloTriggerRateScan::CaloTriggerRateScan(const string &name, const string &filename)
+  : SubsysReco(name)
+  , m_NodeName("CaloTriggerPrimitives")
+  , m_FileName(filename)
+  , m_NEvents(0)
+  , m_Floor(0)
+  , m_MaxCounts(CaloTriggerPrimitives::NWINDOWTYPES * NADC, 0)
+  , m_Passing(CaloTriggerPrimitives::NWINDOWTYPES * NADC, 0)
+  , m_ScanDone(true)
+{
+}
+
+void CaloTriggerRateScan::add_pair(const CaloTriggerPrimitives::WindowType type_a, const CaloTriggerPrimitives::WindowType type_b)
+{
+  if (type_a < 0 || type_a >= CaloTriggerPrimitives::NWINDOWTYPES ||
+      type_b < 0 || type_b >= CaloTriggerPrimitives::NWINDOWTYPES)
+  {
+    cout << PHWHERE << " invalid window types " << type_a << ", " << type_b << endl;
+    return;
+  }
+  m_Pairs.push_back(make_pair(type_a, type_b));
+  m_PairCounts.push_back(vector<unsigned long long>(NADC * NADC, 0));
+  m_PairPassing.push_back(vector<unsigned long long>(NADC * NADC, 0));
+  m_ScanDone = false;
+}
+
+int CaloTriggerRateScan::process_event(PHCompositeNode *topNode)
+{
+  CaloTriggerPrimitives *primitives = findNode::getClass<CaloTriggerPrimitives>(topNode, m_NodeName);
+  if (!primitives)
+  {
+    cout << PHWHERE << " no " << m_NodeName << " node, aborting run" << endl;
+    return Fun4AllReturnCodes::ABORTRUN;
+  }
+  if (primitives->get_floor() > m_Floor)
+  {
+    m_Floor = primitives->get_floor();
+  }
+
+  int maxadc[CaloTriggerPrimitives::NWINDOWTYPES];
+  for (int itype = 0; itype < CaloTriggerPrimitives::NWINDOWTYPES; ++itype)
+  {
+    maxadc[itype] = primitives->get_max_adc(static_cast<CaloTriggerPrimitives::WindowType>(itype));
+    ++m_MaxCounts[itype * NADC + maxadc[itype]];
+  }
+  for (unsigned int ipair = 0; ipair < m_Pairs.size(); ++ipair)
+  {
+    ++m_PairCounts[ipair][maxadc[m_Pairs[ipair].first] * NADC + maxadc[m_Pairs[ipair].second]];
+  }
+  ++m_NEvents;
+  m_ScanDone = false;
+
+  if (Verbosity() > 1)
+  {
+    cout << "CaloTriggerRateScan::process_event - highest windows:";
+    for (int itype = 0; itype < CaloTriggerPrimitives::NWINDOWTYPES; ++itype)
+    {
+      cout << " " << CaloTriggerPrimitives::get_name(static_cast<CaloTriggerPrimitives::WindowType>(itype)) << " = " << maxadc[itype];
+    }
+    cout << endl;
+  }
+  return Fun4AllReturnCodes::EVENT_OK;
+}
+
+void CaloTriggerRateScan::Scan()
+{
+  if (m_ScanDone)
+  {
+    return;
+  }
+  // an event passes all thresholds up to its highest window
+  for (int itype = 0; itype < CaloTriggerPrimitives::NWINDOWTYPES; ++itype)
+  {
+    unsigned long long sum = 0;
+    for (int adc = NADC - 1; adc >= 0; --adc)
+    {
+      sum += m_MaxCounts[itype * NADC + adc];
+      m_Passing[itype * NADC + adc] = sum;
+    }
+  }
+  // same in two dimensions, AND(a, b) = N(a, b) + AND(a + 1, b) + AND(a, b + 1) - AND(a + 1, b + 1)
+  for (unsigned int ipair = 0; ipair < m_Pairs.size(); ++ipair)
+  {
+    const vector<unsigned long long> &counts = m_PairCounts[ipair];
+    vector<unsigned long long> &passing = m_PairPassing[ipair];
+    for (int adc_a = NADC - 1; adc_a >= 0; --adc_a)
+    {
+      unsigned long long rowsum = 0;
+      for (int adc_b = NADC - 1; adc_b >= 0; --adc_b)
+      {
+        rowsum += counts[adc_a * NADC + adc_b];
+        passing[adc_a * NADC + adc_b] = rowsum + (adc_a + 1 < NADC ? passing[(adc_a + 1) * NADC + adc_b] : 0);
+      }
+    }
+  }
+  m_ScanDone = true;
+}
+
+double CaloTriggerRateScan::get_fraction(const CaloTriggerPrimitives::WindowType type, const int adc)
+{
+  if (type < 0 || type >= CaloTriggerPrimitives::NWINDOWTYPES || adc < 0 || adc >= NADC || !m_NEvents)
+  {
+    return 0;
+  }
+  Scan();
+  return static_cast<double>(m_Passing[type * NADC + adc]) / m_NEvents;
+}
+
+double CaloTriggerRateScan::get_fraction_and(const unsigned int ipair, const int adc_a, const int adc_b)
+{
+  if (ipair >= m_Pairs.size() || adc_a < 0 || adc_a >= NADC || adc_b < 0 || adc_b >= NADC || !m_NEvents)
+  {
+    return 0;
+  }
+  Scan();
+  return static_cast<double>(m_PairPassing[ipair][adc_a * NADC + adc_b]) / m_NEvents;
+}
+
+double CaloTriggerRateScan::get_fraction_or(const unsigned int ipair, const int adc_a, const int adc_b)
+{
+  if (ipair >= m_Pairs.size())
+  {
+    return 0;
+  }
+  return get_fraction(m_Pairs[ipair].first, adc_a) + get_fraction(m_Pairs[ipair].second, adc_b) - get_fraction_and(ipair, adc_a, adc_b);
+}
+
+int CaloTriggerRateScan::End(PHCompositeNode *topNode)
+{
+  Scan();
+  if (Verbosity() > 0)
+  {
+    cout << "CaloTriggerRateScan::End - " << m_NEvents << " events, primitive floor " << m_Floor
+         << " counts, writing " << m_FileName << endl;
+  }
+
+  TFile outfile(m_FileName.c_str(), "RECREATE");
+  // bin i is the threshold of i counts, its lower edge the threshold energy
+  const double emax = CaloTriggerPrimitives::adc_to_energy(NADC - 1) + CaloTriggerPrimitives::adc_to_energy(1);
+  for (int itype = 0; itype < CaloTriggerPrimitives::NWINDOWTYPES; ++itype)
+  {
+    const CaloTriggerPrimitives::WindowType type = static_cast<CaloTriggerPrimitives::WindowType>(itype);
+    const string name = CaloTriggerPrimitives::get_name(type);
+    TH1D *h = new TH1D(("hFraction_" + name).c_str(), (name + ";threshold [GeV];accepted fraction").c_str(), NADC, 0, emax);
+    for (int adc = m_Floor; adc < NADC; ++adc)
+    {
+      h->SetBinContent(adc + 1, get_fraction(type, adc));
+    }
+    h->Write();
+  }
+  for (unsigned int ipair = 0; ipair < m_Pairs.size(); ++ipair)
+  {
+    const string name_a = CaloTriggerPrimitives::get_name(m_Pairs[ipair].first);
+    const string name_b = CaloTriggerPrimitives::get_name(m_Pairs[ipair].second);
+    const string title = ";" + name_a + " threshold [GeV];" + name_b + " threshold [GeV];accepted fraction";
+    TH2D *hand = new TH2D(("hFractionAND_" + name_a + "_" + name_b).c_str(), title.c_str(), NADC, 0, emax, NADC, 0, emax);
+    TH2D *hor = new TH2D(("hFractionOR_" + name_a + "_" + name_b).c_str(), title.c_str(), NADC, 0, emax, NADC, 0, emax);
+    for (int adc_a = m_Floor; adc_a < NADC; ++adc_a)
+    {
+      for (int adc_b = m_Floor; adc_b < NADC; ++adc_b)
+      {
+        hand->SetBinContent(adc_a + 1, adc_b + 1, get_fraction_and(ipair, adc_a, adc_b));
+        hor->SetBinContent(adc_a + 1, adc_b + 1, get_fraction_or(ipair, adc_a, adc_b));
+      }
+    }
+    hand->Write();
+    hor->Write();
+  }
+  outfile.Close();
+  return Fun4AllReturnCodes::EVENT_OK;
+}
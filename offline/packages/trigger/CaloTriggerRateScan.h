@@ -0,0 +1,79 @@
+#ifndef TRIGGER_CALOTRIGGERRATESCAN_H
+#define TRIGGER_CALOTRIGGERRATESCAN_H
+
+//===========================================================
+/// \file CaloTriggerRateScan.h
+/// \brief trigger fractions for all thresholds from stored trigger primitives
+//===========================================================
+
+#include "CaloTriggerPrimitives.h"
+
+#include <fun4all/SubsysReco.h>
+
+#include <string>
+#include <utility>
+#include <vector>
+
+class PHCompositeNode;
+
+/// \class CaloTriggerRateScan
+///
+/// \brief scans all 8 bit thresholds on the CaloTriggerPrimitives of a DST
+///
+/// Each event only adds the highest window of every type to a count
+/// histogram (and the pair of highest windows to a 256 x 256 count map
+/// for each pair from add_pair()). The accepted fractions for all
+/// thresholds, and for all threshold combinations of a pair with OR and
+/// AND, are cumulative sums of these counts. Thresholds below the floor
+/// the primitives were stored with are not meaningful.
+///
+class CaloTriggerRateScan : public SubsysReco
+{
+ public:
+  static const int NADC = 256;
+
+  CaloTriggerRateScan(const std::string &name = "CaloTriggerRateScan", const std::string &filename = "CaloTriggerRateScan.root");
+  virtual ~CaloTriggerRateScan() {}
+
+  int process_event(PHCompositeNode *topNode);
+  int End(PHCompositeNode *topNode);
+
+  /// CaloTriggerPrimitives (default) or CaloTriggerPrimitives_Truncate
+  void set_node_name(const std::string &name) { m_NodeName = name; }
+
+  /// scan all threshold combinations of the two window types
+  void add_pair(const CaloTriggerPrimitives::WindowType type_a, const CaloTriggerPrimitives::WindowType type_b);
+
+  unsigned long long get_nevents() const { return m_NEvents; }
+
+  /// fraction of the events with a window of this type at or above adc counts
+  double get_fraction(const CaloTriggerPrimitives::WindowType type, const int adc);
+  /// fraction of the events passing both (AND) or either (OR) threshold of pair ipair
+  double get_fraction_and(const unsigned int ipair, const int adc_a, const int adc_b);
+  double get_fraction_or(const unsigned int ipair, const int adc_a, const int adc_b);
+
+ private:
+  /// cumulative sums of the counts, redone after new events only
+  void Scan();
+
+  std::string m_NodeName;
+  std::string m_FileName;
+
+  unsigned long long m_NEvents;
+  int m_Floor;
+
+  /// events by highest window, [type * NADC + adc]
+  std::vector<unsigned long long> m_MaxCounts;
+  /// events with the highest window at or above the threshold, [type * NADC + threshold]
+  std::vector<unsigned long long> m_Passing;
+
+  std::vector<std::pair<CaloTriggerPrimitives::WindowType, CaloTriggerPrimitives::WindowType> > m_Pairs;
+  /// per pair events by highest windows, [adc_a * NADC + adc_b]
+  std::vector<std::vector<unsigned long long> > m_PairCounts;
+  /// per pair events passing both thresholds, [threshold_a * NADC + threshold_b]
+  std::vector<std::vector<unsigned long long> > m_PairPassing;
+
+  bool m_ScanDone;
+};
+
+#endif  // TRIGGER_CALOTRIGGERRATESCAN_H
@@ -2,6 +2,7 @@
 
 #include "CaloTriggerInfo.h"
 #include "CaloTriggerInfov1.h"
+#include "CaloTriggerPrimitivesv1.h"
 
 // sPHENIX includes
 #include <calobase/RawTower.h>
@@ -36,6 +37,7 @@ using namespace std;
 CaloTriggerSim::CaloTriggerSim(const std::string &name)
   : SubsysReco(name)
   , m_EmulateTruncationFlag(0)
+  , m_PrimitiveFloor(-1)
   // initiate sizes as -1 to tell module they can be set when it sees
   // the EMCal geometry for the first time
   , m_EMCAL_1x1_NETA(-1)
@@ -142,9 +144,56 @@ int CaloTriggerSim::process_event(PHCompositeNode *topNode)
     m_EMCAL_4x4_NPHI = geom_phibins / 2;
 
     // reset all maps
-    m_EMCAL_1x1_MAP.resize(m_EMCAL_1x1_NETA, std::vector<double>(m_EMCAL_1x1_NPHI, 0));
-    m_EMCAL_2x2_MAP.resize(m_EMCAL_2x2_NETA, std::vector<double>(m_EMCAL_2x2_NPHI, 0));
-    m_EMCAL_4x4_MAP.resize(m_EMCAL_4x4_NETA, std::vector<double>(m_EMCAL_4x4_NPHI, 0));
+    m_EMCAL_1x1_MAP.assign(m_EMCAL_1x1_NETA * m_EMCAL_1x1_NPHI, 0);
+    m_EMCAL_2x2_MAP.assign(m_EMCAL_2x2_NETA * m_EMCAL_2x2_NPHI, 0);
+    m_EMCAL_4x4_MAP.assign(m_EMCAL_4x4_NETA * m_EMCAL_4x4_NPHI, 0);
+
+    // window positions only depend on the geometry, compute them once
+    m_EMCAL_2x2_ETA.resize(m_EMCAL_2x2_NETA);
+    m_EMCAL_2x2_PHI.resize(m_EMCAL_2x2_NPHI);
+    for (int ieta = 0; ieta < m_EMCAL_2x2_NETA; ieta++)
+    {
+      // to calculate the eta, phi position, take the average of that of the 1x1's
+      m_EMCAL_2x2_ETA[ieta] = 0.5 * (geomEM->get_etacenter(2 * ieta) + geomEM->get_etacenter(2 * ieta + 1));
+    }
+    for (int iphi = 0; iphi < m_EMCAL_2x2_NPHI; iphi++)
+    {
+      double this_phi = 0.5 * (geomEM->get_phicenter(2 * iphi) + geomEM->get_phicenter(2 * iphi + 1));
+      // wrap-around phi (apparently needed for 2D geometry?)
+      if (this_phi > M_PI) this_phi -= 2 * M_PI;
+      if (this_phi < -M_PI) this_phi += 2 * M_PI;
+      m_EMCAL_2x2_PHI[iphi] = this_phi;
+    }
+
+    m_EMCAL_4x4_ETA.resize(m_EMCAL_4x4_NETA);
+    m_EMCAL_4x4_PHI.resize(m_EMCAL_4x4_NPHI);
+    for (int ieta = 0; ieta < m_EMCAL_4x4_NETA; ieta++)
+    {
+      // for eta calculation (since eta distribution is potentially
+      // non-uniform), average positions of all four towers
+      m_EMCAL_4x4_ETA[ieta] = 0.25 * (geomEM->get_etacenter(2 * ieta) + geomEM->get_etacenter(2 * ieta + 1) + geomEM->get_etacenter(2 * ieta + 2) + geomEM->get_etacenter(2 * ieta + 3));
+    }
+    for (int iphi = 0; iphi < m_EMCAL_4x4_NPHI; iphi++)
+    {
+      // for phi calculation (since phi distribution is uniform), take
+      // first tower and add 1.5 tower widths
+      double this_phi = geomEM->get_phicenter(2 * iphi) + 1.5 * (geomEM->get_phicenter(2 * iphi + 1) - geomEM->get_phicenter(2 * iphi));
+      // wrap-around phi (apparently needed for 2D geometry?)
+      if (this_phi > M_PI) this_phi -= 2 * M_PI;
+      if (this_phi < -M_PI) this_phi += 2 * M_PI;
+      m_EMCAL_4x4_PHI[iphi] = this_phi;
+    }
+
+    // the eta/phi bin search is a loop over all bins, do it once per
+    // tower instead of once per tower and event
+    m_geomEM.build(geomEM);
+    m_EMCAL_1x1_BIN.resize(m_geomEM.size());
+    for (unsigned int itower = 0; itower < m_geomEM.size(); itower++)
+    {
+      int this_etabin = geomEM->get_etabin(m_geomEM.get_eta(itower));
+      int this_phibin = geomEM->get_phibin(m_geomEM.get_phi(itower));
+      m_EMCAL_1x1_BIN[itower] = this_etabin * m_EMCAL_1x1_NPHI + this_phibin;
+    }
 
     if (Verbosity() > 0)
     {
@@ -156,32 +205,28 @@ int CaloTriggerSim::process_event(PHCompositeNode *topNode)
   }
 
   // reset 1x1 map
-  fill(m_EMCAL_1x1_MAP.begin(), m_EMCAL_1x1_MAP.end(), vector<double>(m_EMCAL_1x1_NPHI, 0));
+  fill(m_EMCAL_1x1_MAP.begin(), m_EMCAL_1x1_MAP.end(), 0);
 
   // iterate over EMCal towers, constructing 1x1's
   RawTowerContainer::ConstRange begin_end = towersEM3->getTowers();
   for (RawTowerContainer::ConstIterator rtiter = begin_end.first; rtiter != begin_end.second; ++rtiter)
   {
     RawTower *tower = rtiter->second;
-    RawTowerGeom *tower_geom = geomEM->get_tower_geometry(tower->get_key());
+    int itower = m_geomEM.find(tower->get_key());
+    if (itower < 0) continue;
 
-    double this_eta = tower_geom->get_eta();
-    double this_phi = tower_geom->get_phi();
-    int this_etabin = geomEM->get_etabin(this_eta);
-    int this_phibin = geomEM->get_phibin(this_phi);
+    int this_bin = m_EMCAL_1x1_BIN[itower];
     double this_E = tower->get_energy();
 
-    m_EMCAL_1x1_MAP[this_etabin][this_phibin] += this_E;
+    m_EMCAL_1x1_MAP[this_bin] += this_E;
 
     if (Verbosity() > 1 && tower->get_energy() > 1)
     {
-      std::cout << "CaloTriggerSim::process_event: EMCal 1x1 tower eta ( bin ) / phi ( bin ) / E = " << std::setprecision(6) << this_eta << " ( " << this_etabin << " ) / " << this_phi << " ( " << this_phibin << " ) / " << this_E << std::endl;
+      std::cout << "CaloTriggerSim::process_event: EMCal 1x1 tower eta ( bin ) / phi ( bin ) / E = " << std::setprecision(6) << m_geomEM.get_eta(itower) << " ( " << this_bin / m_EMCAL_1x1_NPHI << " ) / " << m_geomEM.get_phi(itower) << " ( " << this_bin % m_EMCAL_1x1_NPHI << " ) / " << this_E << std::endl;
     }
   }
 
-  // reset 2x2 map and best
-  fill(m_EMCAL_2x2_MAP.begin(), m_EMCAL_2x2_MAP.end(), vector<double>(m_EMCAL_2x2_NPHI, 0));
-
+  // reset 2x2 best
   m_EMCAL_2x2_BEST_E = 0;
   m_EMCAL_2x2_BEST_PHI = 0;
   m_EMCAL_2x2_BEST_ETA = 0;
@@ -189,14 +234,18 @@ int CaloTriggerSim::process_event(PHCompositeNode *topNode)
   // now reconstruct 2x2 map from 1x1 map
   for (int ieta = 0; ieta < m_EMCAL_2x2_NETA; ieta++)
   {
+    // 2 * ieta + 1 is safe, since m_EMCAL_2x2_NETA = m_EMCAL_1x1_NETA / 2
+    const double *row1 = &m_EMCAL_1x1_MAP[2 * ieta * m_EMCAL_1x1_NPHI];
+    const double *row2 = row1 + m_EMCAL_1x1_NPHI;
+
     for (int iphi = 0; iphi < m_EMCAL_2x2_NPHI; iphi++)
     {
       double this_sum = 0;
 
-      this_sum += m_EMCAL_1x1_MAP[2 * ieta][2 * iphi];
-      this_sum += m_EMCAL_1x1_MAP[2 * ieta][2 * iphi + 1];  // 2 * iphi + 1 is safe, since m_EMCAL_2x2_NPHI = m_EMCAL_1x1_NPHI / 2
-      this_sum += m_EMCAL_1x1_MAP[2 * ieta + 1][2 * iphi];  // 2 * ieta + 1 is safe, since m_EMCAL_2x2_NETA = m_EMCAL_1x1_NETA / 2
-      this_sum += m_EMCAL_1x1_MAP[2 * ieta + 1][2 * iphi + 1];
+      this_sum += row1[2 * iphi];
+      this_sum += row1[2 * iphi + 1];  // 2 * iphi + 1 is safe, since m_EMCAL_2x2_NPHI = m_EMCAL_1x1_NPHI / 2
+      this_sum += row2[2 * iphi];
+      this_sum += row2[2 * iphi + 1];
 
       if (m_EmulateTruncationFlag)
       {
@@ -204,25 +253,18 @@ int CaloTriggerSim::process_event(PHCompositeNode *topNode)
       }
 
       // populate 2x2 map
-      m_EMCAL_2x2_MAP[ieta][iphi] = this_sum;
-
-      // to calculate the eta, phi position, take the average of that of the 1x1's
-      double this_eta = 0.5 * (geomEM->get_etacenter(2 * ieta) + geomEM->get_etacenter(2 * ieta + 1));
-      double this_phi = 0.5 * (geomEM->get_phicenter(2 * iphi) + geomEM->get_phicenter(2 * iphi + 1));
-      // wrap-around phi (apparently needed for 2D geometry?)
-      if (this_phi > M_PI) this_phi -= 2 * M_PI;
-      if (this_phi < -M_PI) this_phi += 2 * M_PI;
+      m_EMCAL_2x2_MAP[ieta * m_EMCAL_2x2_NPHI + iphi] = this_sum;
 
       if (Verbosity() > 1 && this_sum > 1)
       {
-        std::cout << "CaloTriggerSim::process_event: EMCal 2x2 tower eta ( bin ) / phi ( bin ) / E = " << std::setprecision(6) << this_eta << " ( " << ieta << " ) / " << this_phi << " ( " << iphi << " ) / " << this_sum << std::endl;
+        std::cout << "CaloTriggerSim::process_event: EMCal 2x2 tower eta ( bin ) / phi ( bin ) / E = " << std::setprecision(6) << m_EMCAL_2x2_ETA[ieta] << " ( " << ieta << " ) / " << m_EMCAL_2x2_PHI[iphi] << " ( " << iphi << " ) / " << this_sum << std::endl;
       }
 
       if (this_sum > m_EMCAL_2x2_BEST_E)
       {
         m_EMCAL_2x2_BEST_E = this_sum;
-        m_EMCAL_2x2_BEST_PHI = this_phi;
-        m_EMCAL_2x2_BEST_ETA = this_eta;
+        m_EMCAL_2x2_BEST_PHI = m_EMCAL_2x2_PHI[iphi];
+        m_EMCAL_2x2_BEST_ETA = m_EMCAL_2x2_ETA[ieta];
       }
     }
   }
@@ -232,67 +274,13 @@ int CaloTriggerSim::process_event(PHCompositeNode *topNode)
     std::cout << "CaloTriggerSim::process_event: best EMCal 2x2 window is at eta / phi = " << m_EMCAL_2x2_BEST_ETA << " / " << m_EMCAL_2x2_BEST_PHI << " and E = " << m_EMCAL_2x2_BEST_E << std::endl;
   }
 
-  // reset 4x4 map & best
-  fill(m_EMCAL_4x4_MAP.begin(), m_EMCAL_4x4_MAP.end(), vector<double>(m_EMCAL_4x4_NPHI, 0));
-
-  m_EMCAL_4x4_BEST_E = 0;
-  m_EMCAL_4x4_BEST_PHI = 0;
-  m_EMCAL_4x4_BEST_ETA = 0;
-
-  int emcal_4x4_best_iphi = -1;
-  int emcal_4x4_best_ieta = -1;
-
   // now reconstruct (sliding) 4x4 map from 2x2 map
-  for (int ieta = 0; ieta < m_EMCAL_4x4_NETA; ieta++)
-  {
-    for (int iphi = 0; iphi < m_EMCAL_4x4_NPHI; iphi++)
-    {
-      // for eta calculation (since eta distribution is potentially
-      // non-uniform), average positions of all four towers
-      double this_eta = 0.25 * (geomEM->get_etacenter(2 * ieta) + geomEM->get_etacenter(2 * ieta + 1) + geomEM->get_etacenter(2 * ieta + 2) + geomEM->get_etacenter(2 * ieta + 3));
-      // for phi calculation (since phi distribution is uniform), take
-      // first tower and add 1.5 tower widths
-      double this_phi = geomEM->get_phicenter(2 * iphi) + 1.5 * (geomEM->get_phicenter(2 * iphi + 1) - geomEM->get_phicenter(2 * iphi));
-      // wrap-around phi (apparently needed for 2D geometry?)
-      if (this_phi > M_PI) this_phi -= 2 * M_PI;
-      if (this_phi < -M_PI) this_phi += 2 * M_PI;
-
-      double this_sum = 0;
-
-      this_sum += m_EMCAL_2x2_MAP[ieta][iphi];
-      this_sum += m_EMCAL_2x2_MAP[ieta + 1][iphi];  // ieta + 1 is safe, since m_EMCAL_4x4_NETA = m_EMCAL_2x2_NETA - 1
-
-      if (iphi != m_EMCAL_4x4_NPHI - 1)
-      {
-        // if we are not in the last phi row, can safely access 'iphi+1'
-        this_sum += m_EMCAL_2x2_MAP[ieta][iphi + 1];
-        this_sum += m_EMCAL_2x2_MAP[ieta + 1][iphi + 1];
-      }
-      else
-      {
-        // if we are in the last phi row, wrap back around to zero
-        this_sum += m_EMCAL_2x2_MAP[ieta][0];
-        this_sum += m_EMCAL_2x2_MAP[ieta + 1][0];
-      }
+  int emcal_4x4_best = FillSlidingWindows(m_EMCAL_2x2_MAP, m_EMCAL_2x2_NPHI, 2, m_EMCAL_4x4_NETA, m_EMCAL_4x4_NPHI, m_EMCAL_4x4_MAP, m_EMCAL_4x4_BEST_E);
+  SetBestWindow(emcal_4x4_best, m_EMCAL_4x4_NPHI, m_EMCAL_4x4_ETA, m_EMCAL_4x4_PHI, m_EMCAL_4x4_BEST_ETA, m_EMCAL_4x4_BEST_PHI);
+  if (Verbosity() > 1) PrintWindows("EMCal 4x4", m_EMCAL_4x4_MAP, m_EMCAL_4x4_ETA, m_EMCAL_4x4_PHI, 1);
 
-      m_EMCAL_4x4_MAP[ieta][iphi] = this_sum;
-
-      if (Verbosity() > 1 && this_sum > 1)
-      {
-        std::cout << "CaloTriggerSim::process_event: EMCal 4x4 tower eta ( bin ) / phi ( bin ) / E = " << std::setprecision(6) << this_eta << " ( " << ieta << " ) / " << this_phi << " ( " << iphi << " ) / " << this_sum << std::endl;
-      }
-
-      if (this_sum > m_EMCAL_4x4_BEST_E)
-      {
-        m_EMCAL_4x4_BEST_E = this_sum;
-        m_EMCAL_4x4_BEST_PHI = this_phi;
-        m_EMCAL_4x4_BEST_ETA = this_eta;
-
-        emcal_4x4_best_iphi = iphi;
-        emcal_4x4_best_ieta = ieta;
-      }
-    }
-  }
+  int emcal_4x4_best_iphi = (emcal_4x4_best < 0 ? -1 : emcal_4x4_best % m_EMCAL_4x4_NPHI);
+  int emcal_4x4_best_ieta = (emcal_4x4_best < 0 ? -1 : emcal_4x4_best / m_EMCAL_4x4_NPHI);
 
   m_EMCAL_4x4_BEST2_E = 0;
   m_EMCAL_4x4_BEST2_PHI = 0;
@@ -309,19 +297,13 @@ int CaloTriggerSim::process_event(PHCompositeNode *topNode)
       if (abs(deta) < 1.5 && abs(dphi) < 1.5)
         continue;
 
-      double this_eta = 0.25 * (geomEM->get_etacenter(2 * ieta) + geomEM->get_etacenter(2 * ieta + 1) + geomEM->get_etacenter(2 * ieta + 2) + geomEM->get_etacenter(2 * ieta + 3));
-      double this_phi = geomEM->get_phicenter(2 * iphi) + 1.5 * (geomEM->get_phicenter(2 * iphi + 1) - geomEM->get_phicenter(2 * iphi));
-
-      if (this_phi > M_PI) this_phi -= 2 * M_PI;
-      if (this_phi < -M_PI) this_phi += 2 * M_PI;
-
-      double this_sum = m_EMCAL_4x4_MAP[ieta][iphi];
+      double this_sum = m_EMCAL_4x4_MAP[ieta * m_EMCAL_4x4_NPHI + iphi];
 
       if (this_sum > m_EMCAL_4x4_BEST2_E)
       {
         m_EMCAL_4x4_BEST2_E = this_sum;
-        m_EMCAL_4x4_BEST2_PHI = this_phi;
-        m_EMCAL_4x4_BEST2_ETA = this_eta;
+        m_EMCAL_4x4_BEST2_PHI = m_EMCAL_4x4_PHI[iphi];
+        m_EMCAL_4x4_BEST2_ETA = m_EMCAL_4x4_ETA[ieta];
       }
     }
   }
@@ -374,12 +356,39 @@ int CaloTriggerSim::process_event(PHCompositeNode *topNode)
     m_FULLCALO_1p0x1p0_NPHI = geomOH_phibins / 2;
 
     // reset all maps
-    m_FULLCALO_0p1x0p1_MAP.resize(m_FULLCALO_0p1x0p1_NETA, std::vector<double>(m_FULLCALO_0p1x0p1_NPHI, 0));
-    m_FULLCALO_0p2x0p2_MAP.resize(m_FULLCALO_0p2x0p2_NETA, std::vector<double>(m_FULLCALO_0p2x0p2_NPHI, 0));
-    m_FULLCALO_0p4x0p4_MAP.resize(m_FULLCALO_0p4x0p4_NETA, std::vector<double>(m_FULLCALO_0p4x0p4_NPHI, 0));
-    m_FULLCALO_0p6x0p6_MAP.resize(m_FULLCALO_0p6x0p6_NETA, std::vector<double>(m_FULLCALO_0p6x0p6_NPHI, 0));
-    m_FULLCALO_0p8x0p8_MAP.resize(m_FULLCALO_0p8x0p8_NETA, std::vector<double>(m_FULLCALO_0p8x0p8_NPHI, 0));
-    m_FULLCALO_1p0x1p0_MAP.resize(m_FULLCALO_1p0x1p0_NETA, std::vector<double>(m_FULLCALO_1p0x1p0_NPHI, 0));
+    m_FULLCALO_0p1x0p1_MAP.assign(m_FULLCALO_0p1x0p1_NETA * m_FULLCALO_0p1x0p1_NPHI, 0);
+    m_FULLCALO_0p2x0p2_MAP.assign(m_FULLCALO_0p2x0p2_NETA * m_FULLCALO_0p2x0p2_NPHI, 0);
+    m_FULLCALO_0p4x0p4_MAP.assign(m_FULLCALO_0p4x0p4_NETA * m_FULLCALO_0p4x0p4_NPHI, 0);
+    m_FULLCALO_0p6x0p6_MAP.assign(m_FULLCALO_0p6x0p6_NETA * m_FULLCALO_0p6x0p6_NPHI, 0);
+    m_FULLCALO_0p8x0p8_MAP.assign(m_FULLCALO_0p8x0p8_NETA * m_FULLCALO_0p8x0p8_NPHI, 0);
+    m_FULLCALO_1p0x1p0_MAP.assign(m_FULLCALO_1p0x1p0_NETA * m_FULLCALO_1p0x1p0_NPHI, 0);
+
+    // to calculate the eta, phi position of the 0.2x0.2 windows, take
+    // the average of that of the contributing 0.1x0.1's (which are
+    // defined by the OHCal geometry)
+    m_FULLCALO_0p2x0p2_ETA.resize(m_FULLCALO_0p2x0p2_NETA);
+    for (int ieta = 0; ieta < m_FULLCALO_0p2x0p2_NETA; ieta++)
+      m_FULLCALO_0p2x0p2_ETA[ieta] = 0.5 * (geomOH->get_etacenter(2 * ieta) + geomOH->get_etacenter(2 * ieta + 1));
+    m_FULLCALO_0p2x0p2_PHI.resize(m_FULLCALO_0p2x0p2_NPHI);
+    for (int iphi = 0; iphi < m_FULLCALO_0p2x0p2_NPHI; iphi++)
+      m_FULLCALO_0p2x0p2_PHI[iphi] = 0.5 * (geomOH->get_phicenter(2 * iphi) + geomOH->get_phicenter(2 * iphi + 1));
+
+    // for the sliding windows, use position of corner tower and add
+    // 1.5 (0.4x0.4), 2.5 (0.6x0.6), 3.5 (0.8x0.8) or 4.5 (1.0x1.0)
+    // tower widths in eta and phi
+    SetSlidingWindowPositions(geomOH, 1.5, m_FULLCALO_0p4x0p4_NETA, m_FULLCALO_0p4x0p4_NPHI, m_FULLCALO_0p4x0p4_ETA, m_FULLCALO_0p4x0p4_PHI);
+    SetSlidingWindowPositions(geomOH, 2.5, m_FULLCALO_0p6x0p6_NETA, m_FULLCALO_0p6x0p6_NPHI, m_FULLCALO_0p6x0p6_ETA, m_FULLCALO_0p6x0p6_PHI);
+    SetSlidingWindowPositions(geomOH, 3.5, m_FULLCALO_0p8x0p8_NETA, m_FULLCALO_0p8x0p8_NPHI, m_FULLCALO_0p8x0p8_ETA, m_FULLCALO_0p8x0p8_PHI);
+    SetSlidingWindowPositions(geomOH, 4.5, m_FULLCALO_1p0x1p0_NETA, m_FULLCALO_1p0x1p0_NPHI, m_FULLCALO_1p0x1p0_ETA, m_FULLCALO_1p0x1p0_PHI);
+
+    // note: look up eta/phi index based on OHCal geometry for all
+    // three calorimeters, since this defines the 0.1x0.1 regions (for
+    // the IHCal it is by construction the same as its own geometry)
+    m_geomIH.build(geomIH);
+    m_geomOH.build(geomOH);
+    SetFullCaloBins(geomOH, m_geomEM, m_FULLCALO_BIN_EM);
+    SetFullCaloBins(geomOH, m_geomIH, m_FULLCALO_BIN_IH);
+    SetFullCaloBins(geomOH, m_geomOH, m_FULLCALO_BIN_OH);
 
     if (Verbosity() > 0)
     {
@@ -395,89 +404,14 @@ int CaloTriggerSim::process_event(PHCompositeNode *topNode)
   }
 
   // reset 0.1x0.1 map
-  fill(m_FULLCALO_0p1x0p1_MAP.begin(), m_FULLCALO_0p1x0p1_MAP.end(), vector<double>(m_FULLCALO_0p1x0p1_NPHI, 0));
-
-  // iterate over EMCal towers, filling in the 0.1x0.1 region they contribute to
-  RawTowerContainer::ConstRange begin_end_EM = towersEM3->getTowers();
-  for (RawTowerContainer::ConstIterator rtiter = begin_end_EM.first; rtiter != begin_end_EM.second; ++rtiter)
-  {
-    RawTower *tower = rtiter->second;
-    RawTowerGeom *tower_geom = geomEM->get_tower_geometry(tower->get_key());
-
-    double this_eta = tower_geom->get_eta();
-    double this_phi = tower_geom->get_phi();
-    if (this_phi < m_FULLCALO_PHI_START) this_phi += 2 * M_PI;
-    if (this_phi > m_FULLCALO_PHI_END) this_phi -= 2 * M_PI;
-
-    // note: look up eta/phi index based on OHCal geometry, since this
-    // defines the 0.1x0.1 regions
-    int this_etabin = geomOH->get_etabin(this_eta);
-    int this_phibin = geomOH->get_phibin(this_phi);
-    double this_E = tower->get_energy();
-
-    m_FULLCALO_0p1x0p1_MAP[this_etabin][this_phibin] += this_E;
-
-    if (Verbosity() > 1 && tower->get_energy() > 1)
-    {
-      std::cout << "CaloTriggerSim::process_event: EMCal tower at eta / phi (added to fullcalo map with etabin / phibin ) / E = " << std::setprecision(6) << this_eta << " / " << this_phi << " ( " << this_etabin << " / " << this_phibin << " ) / " << this_E << std::endl;
-    }
-  }
-
-  // iterate over IHCal towers, filling in the 0.1x0.1 region they contribute to
-  RawTowerContainer::ConstRange begin_end_IH = towersIH3->getTowers();
-  for (RawTowerContainer::ConstIterator rtiter = begin_end_IH.first; rtiter != begin_end_IH.second; ++rtiter)
-  {
-    RawTower *tower = rtiter->second;
-    RawTowerGeom *tower_geom = geomIH->get_tower_geometry(tower->get_key());
-
-    double this_eta = tower_geom->get_eta();
-    double this_phi = tower_geom->get_phi();
-    if (this_phi < m_FULLCALO_PHI_START) this_phi += 2 * M_PI;
-    if (this_phi > m_FULLCALO_PHI_END) this_phi -= 2 * M_PI;
-
-    // note: look up eta/phi index based on OHCal geometry, even though I
-    // think it is by construction the same as the IHCal geometry...
-    int this_etabin = geomOH->get_etabin(this_eta);
-    int this_phibin = geomOH->get_phibin(this_phi);
-    double this_E = tower->get_energy();
-
-    m_FULLCALO_0p1x0p1_MAP[this_etabin][this_phibin] += this_E;
-
-    if (Verbosity() > 1 && tower->get_energy() > 0.5)
-    {
-      std::cout << "CaloTriggerSim::process_event: IHCal tower at eta / phi (added to fullcalo map with etabin / phibin ) / E = " << std::setprecision(6) << this_eta << " / " << this_phi << " ( " << this_etabin << " / " << this_phibin << " ) / " << this_E << std::endl;
-    }
-  }
-
-  // iterate over OHCal towers, filling in the 0.1x0.1 region they contribute to
-  RawTowerContainer::ConstRange begin_end_OH = towersOH3->getTowers();
-  for (RawTowerContainer::ConstIterator rtiter = begin_end_OH.first; rtiter != begin_end_OH.second; ++rtiter)
-  {
-    RawTower *tower = rtiter->second;
-    RawTowerGeom *tower_geom = geomOH->get_tower_geometry(tower->get_key());
-
-    double this_eta = tower_geom->get_eta();
-    double this_phi = tower_geom->get_phi();
-    if (this_phi < m_FULLCALO_PHI_START) this_phi += 2 * M_PI;
-    if (this_phi > m_FULLCALO_PHI_END) this_phi -= 2 * M_PI;
-
-    // note: use the nominal eta/phi index, since the fullcalo 0.1x0.1
-    // map is defined by the OHCal geometry itself
-    int this_etabin = geomOH->get_etabin(this_eta);
-    int this_phibin = geomOH->get_phibin(this_phi);
-    double this_E = tower->get_energy();
+  fill(m_FULLCALO_0p1x0p1_MAP.begin(), m_FULLCALO_0p1x0p1_MAP.end(), 0);
 
-    m_FULLCALO_0p1x0p1_MAP[this_etabin][this_phibin] += this_E;
-
-    if (Verbosity() > 1 && tower->get_energy() > 0.5)
-    {
-      std::cout << "CaloTriggerSim::process_event: OHCal tower at eta / phi (added to fullcalo map with etabin / phibin ) / E = " << std::setprecision(6) << this_eta << " / " << this_phi << " ( " << this_etabin << " / " << this_phibin << " ) / " << this_E << std::endl;
-    }
-  }
-
-  // reset 0.2x0.2 map and best
-  fill(m_FULLCALO_0p2x0p2_MAP.begin(), m_FULLCALO_0p2x0p2_MAP.end(), vector<double>(m_FULLCALO_0p2x0p2_NPHI, 0));
+  // iterate over EMCal, IHCal and OHCal towers, filling in the 0.1x0.1 region they contribute to
+  FillFullCaloMap(towersEM3, m_geomEM, m_FULLCALO_BIN_EM, "EMCal", 1);
+  FillFullCaloMap(towersIH3, m_geomIH, m_FULLCALO_BIN_IH, "IHCal", 0.5);
+  FillFullCaloMap(towersOH3, m_geomOH, m_FULLCALO_BIN_OH, "OHCal", 0.5);
 
+  // reset 0.2x0.2 best
   m_FULLCALO_0p2x0p2_BEST_E = 0;
   m_FULLCALO_0p2x0p2_BEST_PHI = 0;
   m_FULLCALO_0p2x0p2_BEST_ETA = 0;
@@ -485,33 +419,32 @@ int CaloTriggerSim::process_event(PHCompositeNode *topNode)
   // now reconstruct (non-sliding) 0.2x0.2 map from 0.1x0.1 map
   for (int ieta = 0; ieta < m_FULLCALO_0p2x0p2_NETA; ieta++)
   {
+    // 2 * ieta + 1 is safe, since m_FULLCALO_0p2x0p2_NETA = m_FULLCALO_0p1x0p1_NETA / 2
+    const double *row1 = &m_FULLCALO_0p1x0p1_MAP[2 * ieta * m_FULLCALO_0p1x0p1_NPHI];
+    const double *row2 = row1 + m_FULLCALO_0p1x0p1_NPHI;
+
     for (int iphi = 0; iphi < m_FULLCALO_0p2x0p2_NPHI; iphi++)
     {
       double this_sum = 0;
 
-      this_sum += m_FULLCALO_0p1x0p1_MAP[2 * ieta][2 * iphi];
-      this_sum += m_FULLCALO_0p1x0p1_MAP[2 * ieta][2 * iphi + 1];  // 2 * iphi + 1 is safe, since m_FULLCALO_0p2x0p2_NPHI = m_FULLCALO_0p1x0p1_NPHI / 2
-      this_sum += m_FULLCALO_0p1x0p1_MAP[2 * ieta + 1][2 * iphi];  // 2 * ieta + 1 is safe, since m_FULLCALO_0p2x0p2_NETA = m_FULLCALO_0p1x0p1_NETA / 2
-      this_sum += m_FULLCALO_0p1x0p1_MAP[2 * ieta + 1][2 * iphi + 1];
+      this_sum += row1[2 * iphi];
+      this_sum += row1[2 * iphi + 1];  // 2 * iphi + 1 is safe, since m_FULLCALO_0p2x0p2_NPHI = m_FULLCALO_0p1x0p1_NPHI / 2
+      this_sum += row2[2 * iphi];
+      this_sum += row2[2 * iphi + 1];
 
       // populate 0.2x0.2 map
-      m_FULLCALO_0p2x0p2_MAP[ieta][iphi] = this_sum;
-
-      // to calculate the eta, phi position, take the average of that
-      // of the contributing 0.1x0.1's (which are defined by the OHCal geometry)
-      double this_eta = 0.5 * (geomOH->get_etacenter(2 * ieta) + geomOH->get_etacenter(2 * ieta + 1));
-      double this_phi = 0.5 * (geomOH->get_phicenter(2 * iphi) + geomOH->get_phicenter(2 * iphi + 1));
+      m_FULLCALO_0p2x0p2_MAP[ieta * m_FULLCALO_0p2x0p2_NPHI + iphi] = this_sum;
 
       if (Verbosity() > 1 && this_sum > 1)
       {
-        std::cout << "CaloTriggerSim::process_event: FullCalo 0.2x0.2 window eta ( bin ) / phi ( bin ) / E = " << std::setprecision(6) << this_eta << " ( " << ieta << " ) / " << this_phi << " ( " << iphi << " ) / " << this_sum << std::endl;
+        std::cout << "CaloTriggerSim::process_event: FullCalo 0.2x0.2 window eta ( bin ) / phi ( bin ) / E = " << std::setprecision(6) << m_FULLCALO_0p2x0p2_ETA[ieta] << " ( " << ieta << " ) / " << m_FULLCALO_0p2x0p2_PHI[iphi] << " ( " << iphi << " ) / " << this_sum << std::endl;
       }
 
       if (this_sum > m_FULLCALO_0p2x0p2_BEST_E)
       {
         m_FULLCALO_0p2x0p2_BEST_E = this_sum;
-        m_FULLCALO_0p2x0p2_BEST_PHI = this_phi;
-        m_FULLCALO_0p2x0p2_BEST_ETA = this_eta;
+        m_FULLCALO_0p2x0p2_BEST_PHI = m_FULLCALO_0p2x0p2_PHI[iphi];
+        m_FULLCALO_0p2x0p2_BEST_ETA = m_FULLCALO_0p2x0p2_ETA[ieta];
       }
     }
   }
@@ -521,261 +454,156 @@ int CaloTriggerSim::process_event(PHCompositeNode *topNode)
     std::cout << "CaloTriggerSim::process_event: best FullCalo 0.2x0.2 window is at eta / phi = " << m_FULLCALO_0p2x0p2_BEST_ETA << " / " << m_FULLCALO_0p2x0p2_BEST_PHI << " and E = " << m_FULLCALO_0p2x0p2_BEST_E << std::endl;
   }
 
-  // reset fullcalo 0.4x0.4 map & best
-  fill(m_FULLCALO_0p4x0p4_MAP.begin(), m_FULLCALO_0p4x0p4_MAP.end(), vector<double>(m_FULLCALO_0p4x0p4_NPHI, 0));
-
-  m_FULLCALO_0p4x0p4_BEST_E = 0;
-  m_FULLCALO_0p4x0p4_BEST_PHI = 0;
-  m_FULLCALO_0p4x0p4_BEST_ETA = 0;
-
-  // now reconstruct (sliding) 0.4x0.4 map from 0.2x0.2 map
-  for (int ieta = 0; ieta < m_FULLCALO_0p4x0p4_NETA; ieta++)
+  // now reconstruct (sliding) 0.4x0.4, 0.6x0.6, 0.8x0.8 and 1.0x1.0 maps from 0.2x0.2 map
+  int best = FillSlidingWindows(m_FULLCALO_0p2x0p2_MAP, m_FULLCALO_0p2x0p2_NPHI, 2, m_FULLCALO_0p4x0p4_NETA, m_FULLCALO_0p4x0p4_NPHI, m_FULLCALO_0p4x0p4_MAP, m_FULLCALO_0p4x0p4_BEST_E);
+  SetBestWindow(best, m_FULLCALO_0p4x0p4_NPHI, m_FULLCALO_0p4x0p4_ETA, m_FULLCALO_0p4x0p4_PHI, m_FULLCALO_0p4x0p4_BEST_ETA, m_FULLCALO_0p4x0p4_BEST_PHI);
+  if (Verbosity() > 1) PrintWindows("FullCalo  0.4x0.4", m_FULLCALO_0p4x0p4_MAP, m_FULLCALO_0p4x0p4_ETA, m_FULLCALO_0p4x0p4_PHI, 2);
+  if (Verbosity() > 0)
   {
-    for (int iphi = 0; iphi < m_FULLCALO_0p4x0p4_NPHI; iphi++)
-    {
-      // for eta calculation, use position of corner tower and add 1.5
-      // tower widths
-      double this_eta = geomOH->get_etacenter(2 * ieta) + 1.5 * (geomOH->get_etacenter(1) - geomOH->get_etacenter(0));
-      // for phi calculation, use position of corner tower and add 1.5
-      // tower widths
-      double this_phi = geomOH->get_phicenter(2 * iphi) + 1.5 * (geomOH->get_phicenter(1) - geomOH->get_phicenter(0));
-
-      double this_sum = 0;
-
-      this_sum += m_FULLCALO_0p2x0p2_MAP[ieta][iphi];
-      this_sum += m_FULLCALO_0p2x0p2_MAP[ieta + 1][iphi];  // 2 * ieta + 1 is safe, since m_FULLCALO_0p4x0p4_NETA = m_FULLCALO_0p4x0p4_NETA - 1
-
-      // add 1 to phi, but take modulus w.r.t. m_FULLCALO_0p2x0p2_NPHI
-      // in case we have wrapped back around
-      this_sum += m_FULLCALO_0p2x0p2_MAP[ieta][(iphi + 1) % m_FULLCALO_0p2x0p2_NPHI];
-      this_sum += m_FULLCALO_0p2x0p2_MAP[ieta + 1][(iphi + 1) % m_FULLCALO_0p2x0p2_NPHI];
-
-      m_FULLCALO_0p4x0p4_MAP[ieta][iphi] = this_sum;
-
-      if (Verbosity() > 1 && this_sum > 2)
-      {
-        std::cout << "CaloTriggerSim::process_event: FullCalo  0.4x0.4 tower eta ( bin ) / phi ( bin ) / E = " << std::setprecision(6) << this_eta << " ( " << ieta << " ) / " << this_phi << " ( " << iphi << " ) / " << this_sum << std::endl;
-      }
-
-      if (this_sum > m_FULLCALO_0p4x0p4_BEST_E)
-      {
-        m_FULLCALO_0p4x0p4_BEST_E = this_sum;
-        m_FULLCALO_0p4x0p4_BEST_PHI = this_phi;
-        m_FULLCALO_0p4x0p4_BEST_ETA = this_eta;
-      }
-    }
+    std::cout << "CaloTriggerSim::process_event: best FullCalo 0.4x0.4 window is at eta / phi = " << m_FULLCALO_0p4x0p4_BEST_ETA << " / " << m_FULLCALO_0p4x0p4_BEST_PHI << " and E = " << m_FULLCALO_0p4x0p4_BEST_E << std::endl;
   }
 
+  best = FillSlidingWindows(m_FULLCALO_0p2x0p2_MAP, m_FULLCALO_0p2x0p2_NPHI, 3, m_FULLCALO_0p6x0p6_NETA, m_FULLCALO_0p6x0p6_NPHI, m_FULLCALO_0p6x0p6_MAP, m_FULLCALO_0p6x0p6_BEST_E);
+  SetBestWindow(best, m_FULLCALO_0p6x0p6_NPHI, m_FULLCALO_0p6x0p6_ETA, m_FULLCALO_0p6x0p6_PHI, m_FULLCALO_0p6x0p6_BEST_ETA, m_FULLCALO_0p6x0p6_BEST_PHI);
+  if (Verbosity() > 1) PrintWindows("FullCalo  0.6x0.6", m_FULLCALO_0p6x0p6_MAP, m_FULLCALO_0p6x0p6_ETA, m_FULLCALO_0p6x0p6_PHI, 3);
   if (Verbosity() > 0)
   {
-    std::cout << "CaloTriggerSim::process_event: best FullCalo 0.4x0.4 window is at eta / phi = " << m_FULLCALO_0p4x0p4_BEST_ETA << " / " << m_FULLCALO_0p4x0p4_BEST_PHI << " and E = " << m_FULLCALO_0p4x0p4_BEST_E << std::endl;
+    std::cout << "CaloTriggerSim::process_event: best FullCalo 0.6x0.6 window is at eta / phi = " << m_FULLCALO_0p6x0p6_BEST_ETA << " / " << m_FULLCALO_0p6x0p6_BEST_PHI << " and E = " << m_FULLCALO_0p6x0p6_BEST_E << std::endl;
   }
 
-  // reset fullcalo 0.6x0.6 map & best
-  fill(m_FULLCALO_0p6x0p6_MAP.begin(), m_FULLCALO_0p6x0p6_MAP.end(), vector<double>(m_FULLCALO_0p6x0p6_NPHI, 0));
-
-  m_FULLCALO_0p6x0p6_BEST_E = 0;
-  m_FULLCALO_0p6x0p6_BEST_PHI = 0;
-  m_FULLCALO_0p6x0p6_BEST_ETA = 0;
-
-  // now reconstruct (sliding) 0.6x0.6 map from 0.2x0.2 map
-  for (int ieta = 0; ieta < m_FULLCALO_0p6x0p6_NETA; ieta++)
+  best = FillSlidingWindows(m_FULLCALO_0p2x0p2_MAP, m_FULLCALO_0p2x0p2_NPHI, 4, m_FULLCALO_0p8x0p8_NETA, m_FULLCALO_0p8x0p8_NPHI, m_FULLCALO_0p8x0p8_MAP, m_FULLCALO_0p8x0p8_BEST_E);
+  SetBestWindow(best, m_FULLCALO_0p8x0p8_NPHI, m_FULLCALO_0p8x0p8_ETA, m_FULLCALO_0p8x0p8_PHI, m_FULLCALO_0p8x0p8_BEST_ETA, m_FULLCALO_0p8x0p8_BEST_PHI);
+  if (Verbosity() > 1) PrintWindows("FullCalo  0.8x0.8", m_FULLCALO_0p8x0p8_MAP, m_FULLCALO_0p8x0p8_ETA, m_FULLCALO_0p8x0p8_PHI, 4);
+  if (Verbosity() > 0)
   {
-    for (int iphi = 0; iphi < m_FULLCALO_0p6x0p6_NPHI; iphi++)
-    {
-      // for eta calculation, use position of corner tower and add 2.5
-      // tower widths
-      double this_eta = geomOH->get_etacenter(2 * ieta) + 2.5 * (geomOH->get_etacenter(1) - geomOH->get_etacenter(0));
-      // for phi calculation, use position of corner tower and add 2.5
-      // tower widths
-      double this_phi = geomOH->get_phicenter(2 * iphi) + 2.5 * (geomOH->get_phicenter(1) - geomOH->get_phicenter(0));
-
-      double this_sum = 0;
-
-      this_sum += m_FULLCALO_0p2x0p2_MAP[ieta][iphi];
-      this_sum += m_FULLCALO_0p2x0p2_MAP[ieta + 1][iphi];  // ieta + 1 is safe, since m_FULLCALO_0p6x0p6_NETA = m_FULLCALO_0p2x0p2_NETA - 2
-      this_sum += m_FULLCALO_0p2x0p2_MAP[ieta + 2][iphi];  // ieta + 2 is safe, since m_FULLCALO_0p6x0p6_NETA = m_FULLCALO_0p2x0p2_NETA - 2
-
-      // add 1 to phi, but take modulus w.r.t. m_FULLCALO_0p2x0p2_NPHI
-      // in case we have wrapped back around
-      this_sum += m_FULLCALO_0p2x0p2_MAP[ieta][(iphi + 1) % m_FULLCALO_0p2x0p2_NPHI];
-      this_sum += m_FULLCALO_0p2x0p2_MAP[ieta + 1][(iphi + 1) % m_FULLCALO_0p2x0p2_NPHI];
-      this_sum += m_FULLCALO_0p2x0p2_MAP[ieta + 2][(iphi + 1) % m_FULLCALO_0p2x0p2_NPHI];
-      // add 2 to phi, but take modulus w.r.t. m_FULLCALO_0p2x0p2_NPHI
-      // in case we have wrapped back around
-      this_sum += m_FULLCALO_0p2x0p2_MAP[ieta][(iphi + 2) % m_FULLCALO_0p2x0p2_NPHI];
-      this_sum += m_FULLCALO_0p2x0p2_MAP[ieta + 1][(iphi + 2) % m_FULLCALO_0p2x0p2_NPHI];
-      this_sum += m_FULLCALO_0p2x0p2_MAP[ieta + 2][(iphi + 2) % m_FULLCALO_0p2x0p2_NPHI];
-
-      m_FULLCALO_0p6x0p6_MAP[ieta][iphi] = this_sum;
-
-      if (Verbosity() > 1 && this_sum > 3)
-      {
-        std::cout << "CaloTriggerSim::process_event: FullCalo  0.6x0.6 tower eta ( bin ) / phi ( bin ) / E = " << std::setprecision(6) << this_eta << " ( " << ieta << " ) / " << this_phi << " ( " << iphi << " ) / " << this_sum << std::endl;
-      }
-
-      if (this_sum > m_FULLCALO_0p6x0p6_BEST_E)
-      {
-        m_FULLCALO_0p6x0p6_BEST_E = this_sum;
-        m_FULLCALO_0p6x0p6_BEST_PHI = this_phi;
-        m_FULLCALO_0p6x0p6_BEST_ETA = this_eta;
-      }
-    }
+    std::cout << "CaloTriggerSim::process_event: best FullCalo 0.8x0.8 window is at eta / phi = " << m_FULLCALO_0p8x0p8_BEST_ETA << " / " << m_FULLCALO_0p8x0p8_BEST_PHI << " and E = " << m_FULLCALO_0p8x0p8_BEST_E << std::endl;
   }
 
+  best = FillSlidingWindows(m_FULLCALO_0p2x0p2_MAP, m_FULLCALO_0p2x0p2_NPHI, 5, m_FULLCALO_1p0x1p0_NETA, m_FULLCALO_1p0x1p0_NPHI, m_FULLCALO_1p0x1p0_MAP, m_FULLCALO_1p0x1p0_BEST_E);
+  SetBestWindow(best, m_FULLCALO_1p0x1p0_NPHI, m_FULLCALO_1p0x1p0_ETA, m_FULLCALO_1p0x1p0_PHI, m_FULLCALO_1p0x1p0_BEST_ETA, m_FULLCALO_1p0x1p0_BEST_PHI);
+  if (Verbosity() > 1) PrintWindows("FullCalo  1.0x1.0", m_FULLCALO_1p0x1p0_MAP, m_FULLCALO_1p0x1p0_ETA, m_FULLCALO_1p0x1p0_PHI, 5);
   if (Verbosity() > 0)
   {
-    std::cout << "CaloTriggerSim::process_event: best FullCalo 0.6x0.6 window is at eta / phi = " << m_FULLCALO_0p6x0p6_BEST_ETA << " / " << m_FULLCALO_0p6x0p6_BEST_PHI << " and E = " << m_FULLCALO_0p6x0p6_BEST_E << std::endl;
+    std::cout << "CaloTriggerSim::process_event: best FullCalo 1.0x1.0 window is at eta / phi = " << m_FULLCALO_1p0x1p0_BEST_ETA << " / " << m_FULLCALO_1p0x1p0_BEST_PHI << " and E = " << m_FULLCALO_1p0x1p0_BEST_E << std::endl;
   }
 
-  // reset fullcalo 0.8x0.8 map & best
-  fill(m_FULLCALO_0p8x0p8_MAP.begin(), m_FULLCALO_0p8x0p8_MAP.end(), vector<double>(m_FULLCALO_0p8x0p8_NPHI, 0));
+  FillNode(topNode);
+  if (m_PrimitiveFloor >= 0)
+  {
+    FillPrimitives(topNode);
+  }
+
+  if (Verbosity() > 0) std::cout << "CaloTriggerSim::process_event: exiting" << std::endl;
+
+  return Fun4AllReturnCodes::EVENT_OK;
+}
 
-  m_FULLCALO_0p8x0p8_BEST_E = 0;
-  m_FULLCALO_0p8x0p8_BEST_PHI = 0;
-  m_FULLCALO_0p8x0p8_BEST_ETA = 0;
+int CaloTriggerSim::FillSlidingWindows(const std::vector<double> &map, const int map_nphi, const int size, const int neta, const int nphi, std::vector<double> &window_map, float &best_E) const
+{
+  int best = -1;
+  best_E = 0;
 
-  // now reconstruct (sliding) 0.8x0.8 map from 0.2x0.2 map
-  for (int ieta = 0; ieta < m_FULLCALO_0p8x0p8_NETA; ieta++)
+  for (int ieta = 0; ieta < neta; ieta++)
   {
-    for (int iphi = 0; iphi < m_FULLCALO_0p8x0p8_NPHI; iphi++)
+    for (int iphi = 0; iphi < nphi; iphi++)
     {
-      // for eta calculation, use position of corner tower and add 3.5
-      // tower widths
-      double this_eta = geomOH->get_etacenter(2 * ieta) + 3.5 * (geomOH->get_etacenter(1) - geomOH->get_etacenter(0));
-      // for phi calculation, use position of corner tower and add 3.5
-      // tower widths
-      double this_phi = geomOH->get_phicenter(2 * iphi) + 3.5 * (geomOH->get_phicenter(1) - geomOH->get_phicenter(0));
-
       double this_sum = 0;
 
-      this_sum += m_FULLCALO_0p2x0p2_MAP[ieta][iphi];
-      this_sum += m_FULLCALO_0p2x0p2_MAP[ieta + 1][iphi];  // ieta + 1 is safe, since m_FULLCALO_0p8x0p8_NETA = m_FULLCALO_0p2x0p2_NETA - 3
-      this_sum += m_FULLCALO_0p2x0p2_MAP[ieta + 2][iphi];  // ieta + 2 is safe, since m_FULLCALO_0p8x0p8_NETA = m_FULLCALO_0p2x0p2_NETA - 3
-      this_sum += m_FULLCALO_0p2x0p2_MAP[ieta + 3][iphi];  // ieta + 3 is safe, since m_FULLCALO_0p8x0p8_NETA = m_FULLCALO_0p2x0p2_NETA - 3
-
-      // add 1 to phi, but take modulus w.r.t. m_FULLCALO_0p2x0p2_NPHI
-      // in case we have wrapped back around
-      this_sum += m_FULLCALO_0p2x0p2_MAP[ieta][(iphi + 1) % m_FULLCALO_0p2x0p2_NPHI];
-      this_sum += m_FULLCALO_0p2x0p2_MAP[ieta + 1][(iphi + 1) % m_FULLCALO_0p2x0p2_NPHI];
-      this_sum += m_FULLCALO_0p2x0p2_MAP[ieta + 2][(iphi + 1) % m_FULLCALO_0p2x0p2_NPHI];
-      this_sum += m_FULLCALO_0p2x0p2_MAP[ieta + 3][(iphi + 1) % m_FULLCALO_0p2x0p2_NPHI];
-      // add 2 to phi, but take modulus w.r.t. m_FULLCALO_0p2x0p2_NPHI
-      // in case we have wrapped back around
-      this_sum += m_FULLCALO_0p2x0p2_MAP[ieta][(iphi + 2) % m_FULLCALO_0p2x0p2_NPHI];
-      this_sum += m_FULLCALO_0p2x0p2_MAP[ieta + 1][(iphi + 2) % m_FULLCALO_0p2x0p2_NPHI];
-      this_sum += m_FULLCALO_0p2x0p2_MAP[ieta + 2][(iphi + 2) % m_FULLCALO_0p2x0p2_NPHI];
-      this_sum += m_FULLCALO_0p2x0p2_MAP[ieta + 3][(iphi + 2) % m_FULLCALO_0p2x0p2_NPHI];
-      // add 3 to phi, but take modulus w.r.t. m_FULLCALO_0p2x0p2_NPHI
-      // in case we have wrapped back around
-      this_sum += m_FULLCALO_0p2x0p2_MAP[ieta][(iphi + 3) % m_FULLCALO_0p2x0p2_NPHI];
-      this_sum += m_FULLCALO_0p2x0p2_MAP[ieta + 1][(iphi + 3) % m_FULLCALO_0p2x0p2_NPHI];
-      this_sum += m_FULLCALO_0p2x0p2_MAP[ieta + 2][(iphi + 3) % m_FULLCALO_0p2x0p2_NPHI];
-      this_sum += m_FULLCALO_0p2x0p2_MAP[ieta + 3][(iphi + 3) % m_FULLCALO_0p2x0p2_NPHI];
-
-      m_FULLCALO_0p8x0p8_MAP[ieta][iphi] = this_sum;
-
-      if (Verbosity() > 1 && this_sum > 4)
+      // ieta + size - 1 is safe, since neta = map_neta - (size - 1);
+      // take the modulus w.r.t. map_nphi in case we have wrapped back
+      // around in phi
+      for (int dphi = 0; dphi < size; dphi++)
       {
-        std::cout << "CaloTriggerSim::process_event: FullCalo  0.8x0.8 tower eta ( bin ) / phi ( bin ) / E = " << std::setprecision(6) << this_eta << " ( " << ieta << " ) / " << this_phi << " ( " << iphi << " ) / " << this_sum << std::endl;
+        const int this_iphi = (iphi + dphi) % map_nphi;
+        for (int deta = 0; deta < size; deta++)
+        {
+          this_sum += map[(ieta + deta) * map_nphi + this_iphi];
+        }
       }
 
-      if (this_sum > m_FULLCALO_0p8x0p8_BEST_E)
+      window_map[ieta * nphi + iphi] = this_sum;
+
+      if (this_sum > best_E)
       {
-        m_FULLCALO_0p8x0p8_BEST_E = this_sum;
-        m_FULLCALO_0p8x0p8_BEST_PHI = this_phi;
-        m_FULLCALO_0p8x0p8_BEST_ETA = this_eta;
+        best_E = this_sum;
+        best = ieta * nphi + iphi;
       }
     }
   }
 
-  if (Verbosity() > 0)
+  return best;
+}
+
+void CaloTriggerSim::SetBestWindow(const int best, const int nphi, const std::vector<double> &window_eta, const std::vector<double> &window_phi, float &best_eta, float &best_phi) const
+{
+  best_eta = (best < 0 ? 0 : window_eta[best / nphi]);
+  best_phi = (best < 0 ? 0 : window_phi[best % nphi]);
+}
+
+void CaloTriggerSim::PrintWindows(const std::string &label, const std::vector<double> &window_map, const std::vector<double> &window_eta, const std::vector<double> &window_phi, const double threshold) const
+{
+  const int nphi = window_phi.size();
+  for (unsigned int iwindow = 0; iwindow < window_map.size(); iwindow++)
   {
-    std::cout << "CaloTriggerSim::process_event: best FullCalo 0.8x0.8 window is at eta / phi = " << m_FULLCALO_0p8x0p8_BEST_ETA << " / " << m_FULLCALO_0p8x0p8_BEST_PHI << " and E = " << m_FULLCALO_0p8x0p8_BEST_E << std::endl;
+    const double this_sum = window_map[iwindow];
+    if (this_sum <= threshold) continue;
+
+    const int ieta = iwindow / nphi;
+    const int iphi = iwindow % nphi;
+    std::cout << "CaloTriggerSim::process_event: " << label << " tower eta ( bin ) / phi ( bin ) / E = " << std::setprecision(6) << window_eta[ieta] << " ( " << ieta << " ) / " << window_phi[iphi] << " ( " << iphi << " ) / " << this_sum << std::endl;
   }
+}
 
-  // reset fullcalo 1.0x1.0 map & best
-  fill(m_FULLCALO_1p0x1p0_MAP.begin(), m_FULLCALO_1p0x1p0_MAP.end(), vector<double>(m_FULLCALO_1p0x1p0_NPHI, 0));
+void CaloTriggerSim::SetSlidingWindowPositions(RawTowerGeomContainer *geomOH, const double offset, const int neta, const int nphi, std::vector<double> &window_eta, std::vector<double> &window_phi) const
+{
+  window_eta.resize(neta);
+  for (int ieta = 0; ieta < neta; ieta++)
+    window_eta[ieta] = geomOH->get_etacenter(2 * ieta) + offset * (geomOH->get_etacenter(1) - geomOH->get_etacenter(0));
 
-  m_FULLCALO_1p0x1p0_BEST_E = 0;
-  m_FULLCALO_1p0x1p0_BEST_PHI = 0;
-  m_FULLCALO_1p0x1p0_BEST_ETA = 0;
+  window_phi.resize(nphi);
+  for (int iphi = 0; iphi < nphi; iphi++)
+    window_phi[iphi] = geomOH->get_phicenter(2 * iphi) + offset * (geomOH->get_phicenter(1) - geomOH->get_phicenter(0));
+}
 
-  // now reconstruct (sliding) 1.0x1.0 map from 0.2x0.2 map
-  for (int ieta = 0; ieta < m_FULLCALO_1p0x1p0_NETA; ieta++)
+void CaloTriggerSim::SetFullCaloBins(RawTowerGeomContainer *geomOH, const RawTowerGeomTable &geom, std::vector<int> &bins) const
+{
+  bins.resize(geom.size());
+  for (unsigned int itower = 0; itower < geom.size(); itower++)
   {
-    for (int iphi = 0; iphi < m_FULLCALO_1p0x1p0_NPHI; iphi++)
-    {
-      // for eta calculation, use position of corner tower and add 4.5
-      // tower widths
-      double this_eta = geomOH->get_etacenter(2 * ieta) + 4.5 * (geomOH->get_etacenter(1) - geomOH->get_etacenter(0));
-      // for phi calculation, use position of corner tower and add 4.5
-      // tower widths
-      double this_phi = geomOH->get_phicenter(2 * iphi) + 4.5 * (geomOH->get_phicenter(1) - geomOH->get_phicenter(0));
-
-      double this_sum = 0;
-
-      this_sum += m_FULLCALO_0p2x0p2_MAP[ieta][iphi];
-      this_sum += m_FULLCALO_0p2x0p2_MAP[ieta + 1][iphi];  // ieta + 1 is safe, since m_FULLCALO_1p0x1p0_NETA = m_FULLCALO_0p2x0p2_NETA - 4
-      this_sum += m_FULLCALO_0p2x0p2_MAP[ieta + 2][iphi];  // ieta + 2 is safe, since m_FULLCALO_1p0x1p0_NETA = m_FULLCALO_0p2x0p2_NETA - 4
-      this_sum += m_FULLCALO_0p2x0p2_MAP[ieta + 3][iphi];  // ieta + 3 is safe, since m_FULLCALO_1p0x1p0_NETA = m_FULLCALO_0p2x0p2_NETA - 4
-      this_sum += m_FULLCALO_0p2x0p2_MAP[ieta + 4][iphi];  // ieta + 4 is safe, since m_FULLCALO_1p0x1p0_NETA = m_FULLCALO_0p2x0p2_NETA - 4
-
-      // add 1 to phi, but take modulus w.r.t. m_FULLCALO_0p2x0p2_NPHI
-      // in case we have wrapped back around
-      this_sum += m_FULLCALO_0p2x0p2_MAP[ieta][(iphi + 1) % m_FULLCALO_0p2x0p2_NPHI];
-      this_sum += m_FULLCALO_0p2x0p2_MAP[ieta + 1][(iphi + 1) % m_FULLCALO_0p2x0p2_NPHI];
-      this_sum += m_FULLCALO_0p2x0p2_MAP[ieta + 2][(iphi + 1) % m_FULLCALO_0p2x0p2_NPHI];
-      this_sum += m_FULLCALO_0p2x0p2_MAP[ieta + 3][(iphi + 1) % m_FULLCALO_0p2x0p2_NPHI];
-      this_sum += m_FULLCALO_0p2x0p2_MAP[ieta + 4][(iphi + 1) % m_FULLCALO_0p2x0p2_NPHI];
-      // add 2 to phi, but take modulus w.r.t. m_FULLCALO_0p2x0p2_NPHI
-      // in case we have wrapped back around
-      this_sum += m_FULLCALO_0p2x0p2_MAP[ieta][(iphi + 2) % m_FULLCALO_0p2x0p2_NPHI];
-      this_sum += m_FULLCALO_0p2x0p2_MAP[ieta + 1][(iphi + 2) % m_FULLCALO_0p2x0p2_NPHI];
-      this_sum += m_FULLCALO_0p2x0p2_MAP[ieta + 2][(iphi + 2) % m_FULLCALO_0p2x0p2_NPHI];
-      this_sum += m_FULLCALO_0p2x0p2_MAP[ieta + 3][(iphi + 2) % m_FULLCALO_0p2x0p2_NPHI];
-      this_sum += m_FULLCALO_0p2x0p2_MAP[ieta + 4][(iphi + 2) % m_FULLCALO_0p2x0p2_NPHI];
-      // add 3 to phi, but take modulus w.r.t. m_FULLCALO_0p2x0p2_NPHI
-      // in case we have wrapped back around
-      this_sum += m_FULLCALO_0p2x0p2_MAP[ieta][(iphi + 3) % m_FULLCALO_0p2x0p2_NPHI];
-      this_sum += m_FULLCALO_0p2x0p2_MAP[ieta + 1][(iphi + 3) % m_FULLCALO_0p2x0p2_NPHI];
-      this_sum += m_FULLCALO_0p2x0p2_MAP[ieta + 2][(iphi + 3) % m_FULLCALO_0p2x0p2_NPHI];
-      this_sum += m_FULLCALO_0p2x0p2_MAP[ieta + 3][(iphi + 3) % m_FULLCALO_0p2x0p2_NPHI];
-      this_sum += m_FULLCALO_0p2x0p2_MAP[ieta + 4][(iphi + 3) % m_FULLCALO_0p2x0p2_NPHI];
-      // add 4 to phi, but take modulus w.r.t. m_FULLCALO_0p2x0p2_NPHI
-      // in case we have wrapped back around
-      this_sum += m_FULLCALO_0p2x0p2_MAP[ieta][(iphi + 4) % m_FULLCALO_0p2x0p2_NPHI];
-      this_sum += m_FULLCALO_0p2x0p2_MAP[ieta + 1][(iphi + 4) % m_FULLCALO_0p2x0p2_NPHI];
-      this_sum += m_FULLCALO_0p2x0p2_MAP[ieta + 2][(iphi + 4) % m_FULLCALO_0p2x0p2_NPHI];
-      this_sum += m_FULLCALO_0p2x0p2_MAP[ieta + 3][(iphi + 4) % m_FULLCALO_0p2x0p2_NPHI];
-      this_sum += m_FULLCALO_0p2x0p2_MAP[ieta + 4][(iphi + 4) % m_FULLCALO_0p2x0p2_NPHI];
-
-      m_FULLCALO_1p0x1p0_MAP[ieta][iphi] = this_sum;
-
-      if (Verbosity() > 1 && this_sum > 5)
-      {
-        std::cout << "CaloTriggerSim::process_event: FullCalo  1.0x1.0 tower eta ( bin ) / phi ( bin ) / E = " << std::setprecision(6) << this_eta << " ( " << ieta << " ) / " << this_phi << " ( " << iphi << " ) / " << this_sum << std::endl;
-      }
+    double this_eta = geom.get_eta(itower);
+    double this_phi = geom.get_phi(itower);
+    if (this_phi < m_FULLCALO_PHI_START) this_phi += 2 * M_PI;
+    if (this_phi > m_FULLCALO_PHI_END) this_phi -= 2 * M_PI;
 
-      if (this_sum > m_FULLCALO_1p0x1p0_BEST_E)
-      {
-        m_FULLCALO_1p0x1p0_BEST_E = this_sum;
-        m_FULLCALO_1p0x1p0_BEST_PHI = this_phi;
-        m_FULLCALO_1p0x1p0_BEST_ETA = this_eta;
-      }
-    }
+    int this_etabin = geomOH->get_etabin(this_eta);
+    int this_phibin = geomOH->get_phibin(this_phi);
+    bins[itower] = this_etabin * m_FULLCALO_0p1x0p1_NPHI + this_phibin;
   }
+}
 
-  if (Verbosity() > 0)
+void CaloTriggerSim::FillFullCaloMap(RawTowerContainer *towers, const RawTowerGeomTable &geom, const std::vector<int> &bins, const std::string &label, const double print_threshold)
+{
+  RawTowerContainer::ConstRange begin_end = towers->getTowers();
+  for (RawTowerContainer::ConstIterator rtiter = begin_end.first; rtiter != begin_end.second; ++rtiter)
   {
-    std::cout << "CaloTriggerSim::process_event: best FullCalo 1.0x1.0 window is at eta / phi = " << m_FULLCALO_1p0x1p0_BEST_ETA << " / " << m_FULLCALO_1p0x1p0_BEST_PHI << " and E = " << m_FULLCALO_1p0x1p0_BEST_E << std::endl;
-  }
+    RawTower *tower = rtiter->second;
+    int itower = geom.find(tower->get_key());
+    if (itower < 0) continue;
 
-  FillNode(topNode);
+    int this_bin = bins[itower];
+    double this_E = tower->get_energy();
 
-  if (Verbosity() > 0) std::cout << "CaloTriggerSim::process_event: exiting" << std::endl;
+    m_FULLCALO_0p1x0p1_MAP[this_bin] += this_E;
 
-  return Fun4AllReturnCodes::EVENT_OK;
+    if (Verbosity() > 1 && tower->get_energy() > print_threshold)
+    {
+      double this_phi = geom.get_phi(itower);
+      if (this_phi < m_FULLCALO_PHI_START) this_phi += 2 * M_PI;
+      if (this_phi > m_FULLCALO_PHI_END) this_phi -= 2 * M_PI;
+
+      std::cout << "CaloTriggerSim::process_event: " << label << " tower at eta / phi (added to fullcalo map with etabin / phibin ) / E = " << std::setprecision(6) << geom.get_eta(itower) << " / " << this_phi << " ( " << this_bin / m_FULLCALO_0p1x0p1_NPHI << " / " << this_bin % m_FULLCALO_0p1x0p1_NPHI << " ) / " << this_E << std::endl;
+    }
+  }
 }
 
 int CaloTriggerSim::CreateNode(PHCompositeNode *topNode)
@@ -812,6 +640,18 @@ int CaloTriggerSim::CreateNode(PHCompositeNode *topNode)
     exit(-1);
   }
 
+  if (m_PrimitiveFloor >= 0)
+  {
+    const std::string primitivesname = !m_EmulateTruncationFlag ? "CaloTriggerPrimitives" : "CaloTriggerPrimitives_Truncate";
+    if (findNode::getClass<CaloTriggerPrimitives>(topNode, primitivesname))
+    {
+      std::cout << PHWHERE << "::ERROR - " << primitivesname << " pre-exists, but should not" << std::endl;
+      exit(-1);
+    }
+    CaloTriggerPrimitives *primitives = new CaloTriggerPrimitivesv1();
+    trigNode->addNode(new PHIODataNode<PHObject>(primitives, primitivesname, "PHObject"));
+  }
+
   return Fun4AllReturnCodes::EVENT_OK;
 }
 
@@ -860,3 +700,39 @@ void CaloTriggerSim::FillNode(PHCompositeNode *topNode)
 
   return;
 }
+
+void CaloTriggerSim::FillPrimitives(PHCompositeNode *topNode)
+{
+  CaloTriggerPrimitives *primitives = findNode::getClass<CaloTriggerPrimitives>(topNode, !m_EmulateTruncationFlag ? "CaloTriggerPrimitives" : "CaloTriggerPrimitives_Truncate");
+  if (!primitives)
+  {
+    std::cout << " ERROR -- can't find CaloTriggerPrimitives node after it should have been created" << std::endl;
+    return;
+  }
+  primitives->Reset();
+  const unsigned char floor = CaloTriggerPrimitives::energy_to_adc(m_PrimitiveFloor);
+  primitives->set_floor(floor);
+
+  AddPrimitives(primitives, CaloTriggerPrimitives::EMCAL_2x2, m_EMCAL_2x2_MAP, m_EMCAL_2x2_NETA, m_EMCAL_2x2_NPHI, floor);
+  AddPrimitives(primitives, CaloTriggerPrimitives::EMCAL_4x4, m_EMCAL_4x4_MAP, m_EMCAL_4x4_NETA, m_EMCAL_4x4_NPHI, floor);
+  AddPrimitives(primitives, CaloTriggerPrimitives::FULLCALO_0p2x0p2, m_FULLCALO_0p2x0p2_MAP, m_FULLCALO_0p2x0p2_NETA, m_FULLCALO_0p2x0p2_NPHI, floor);
+  AddPrimitives(primitives, CaloTriggerPrimitives::FULLCALO_0p4x0p4, m_FULLCALO_0p4x0p4_MAP, m_FULLCALO_0p4x0p4_NETA, m_FULLCALO_0p4x0p4_NPHI, floor);
+  AddPrimitives(primitives, CaloTriggerPrimitives::FULLCALO_0p6x0p6, m_FULLCALO_0p6x0p6_MAP, m_FULLCALO_0p6x0p6_NETA, m_FULLCALO_0p6x0p6_NPHI, floor);
+  AddPrimitives(primitives, CaloTriggerPrimitives::FULLCALO_0p8x0p8, m_FULLCALO_0p8x0p8_MAP, m_FULLCALO_0p8x0p8_NETA, m_FULLCALO_0p8x0p8_NPHI, floor);
+  AddPrimitives(primitives, CaloTriggerPrimitives::FULLCALO_1p0x1p0, m_FULLCALO_1p0x1p0_MAP, m_FULLCALO_1p0x1p0_NETA, m_FULLCALO_1p0x1p0_NPHI, floor);
+
+  if (Verbosity() > 0) primitives->identify();
+}
+
+void CaloTriggerSim::AddPrimitives(CaloTriggerPrimitives *primitives, const CaloTriggerPrimitives::WindowType type, const std::vector<double> &window_map, const int neta, const int nphi, const unsigned char floor) const
+{
+  primitives->set_grid(type, neta, nphi);
+  for (unsigned int iwindow = 0; iwindow < window_map.size(); iwindow++)
+  {
+    const unsigned char adc = CaloTriggerPrimitives::energy_to_adc(window_map[iwindow]);
+    if (adc >= floor && adc > 0)
+    {
+      primitives->add_window(type, iwindow, adc);
+    }
+  }
+}
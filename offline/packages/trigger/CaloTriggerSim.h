@@ -7,7 +7,11 @@
 /// \author Dennis V. Perepelitsa
 //===========================================================
 
+#include "CaloTriggerPrimitives.h"
+
 // sPHENIX includes
+#include <calobase/RawTowerGeomTable.h>
+
 #include <fun4all/SubsysReco.h>
 
 // standard includes
@@ -16,6 +20,8 @@
 
 // forward declarations
 class PHCompositeNode;
+class RawTowerContainer;
+class RawTowerGeomContainer;
 
 /// \class CaloTriggerSim
 ///
@@ -35,12 +41,33 @@ class CaloTriggerSim : public SubsysReco
   void set_truncation(const int emulate_truncation) { m_EmulateTruncationFlag = emulate_truncation; }
   double truncate_8bit(const double raw_E) const;
 
+  /// also store all window sums at or above floor_E (GeV) as 8 bit
+  /// CaloTriggerPrimitives, for threshold scans with CaloTriggerRateScan
+  void set_primitive_output(const double floor_E) { m_PrimitiveFloor = floor_E; }
+
  private:
   int CreateNode(PHCompositeNode *topNode);
   void FillNode(PHCompositeNode *topNode);
+  void FillPrimitives(PHCompositeNode *topNode);
+  void AddPrimitives(CaloTriggerPrimitives *primitives, const CaloTriggerPrimitives::WindowType type, const std::vector<double> &window_map, const int neta, const int nphi, const unsigned char floor) const;
+
+  /// fill window_map (neta x nphi) with the sums of the sliding size x
+  /// size windows of map, wrapping around in phi, and return the index
+  /// of the highest window (-1 if none is above 0)
+  int FillSlidingWindows(const std::vector<double> &map, const int map_nphi, const int size, const int neta, const int nphi, std::vector<double> &window_map, float &best_E) const;
+  void SetBestWindow(const int best, const int nphi, const std::vector<double> &window_eta, const std::vector<double> &window_phi, float &best_eta, float &best_phi) const;
+  void PrintWindows(const std::string &label, const std::vector<double> &window_map, const std::vector<double> &window_eta, const std::vector<double> &window_phi, const double threshold) const;
+  void SetSlidingWindowPositions(RawTowerGeomContainer *geomOH, const double offset, const int neta, const int nphi, std::vector<double> &window_eta, std::vector<double> &window_phi) const;
+
+  /// tower index in geom => bin in the full calo 0.1x0.1 map
+  void SetFullCaloBins(RawTowerGeomContainer *geomOH, const RawTowerGeomTable &geom, std::vector<int> &bins) const;
+  void FillFullCaloMap(RawTowerContainer *towers, const RawTowerGeomTable &geom, const std::vector<int> &bins, const std::string &label, const double print_threshold);
 
   int m_EmulateTruncationFlag;
 
+  /// floor of the stored trigger primitives in GeV, negative for none
+  double m_PrimitiveFloor;
+
   int m_EMCAL_1x1_NETA;
   int m_EMCAL_1x1_NPHI;
 
@@ -106,15 +133,41 @@ class CaloTriggerSim : public SubsysReco
   float m_FULLCALO_1p0x1p0_BEST_PHI;
   float m_FULLCALO_1p0x1p0_BEST_ETA;
 
-  std::vector<std::vector<double> > m_EMCAL_1x1_MAP;
-  std::vector<std::vector<double> > m_EMCAL_2x2_MAP;
-  std::vector<std::vector<double> > m_EMCAL_4x4_MAP;
-  std::vector<std::vector<double> > m_FULLCALO_0p1x0p1_MAP;
-  std::vector<std::vector<double> > m_FULLCALO_0p2x0p2_MAP;
-  std::vector<std::vector<double> > m_FULLCALO_0p4x0p4_MAP;
-  std::vector<std::vector<double> > m_FULLCALO_0p6x0p6_MAP;
-  std::vector<std::vector<double> > m_FULLCALO_0p8x0p8_MAP;
-  std::vector<std::vector<double> > m_FULLCALO_1p0x1p0_MAP;
+  // maps are stored flat, [ieta * NPHI + iphi], and kept between events
+  std::vector<double> m_EMCAL_1x1_MAP;
+  std::vector<double> m_EMCAL_2x2_MAP;
+  std::vector<double> m_EMCAL_4x4_MAP;
+  std::vector<double> m_FULLCALO_0p1x0p1_MAP;
+  std::vector<double> m_FULLCALO_0p2x0p2_MAP;
+  std::vector<double> m_FULLCALO_0p4x0p4_MAP;
+  std::vector<double> m_FULLCALO_0p6x0p6_MAP;
+  std::vector<double> m_FULLCALO_0p8x0p8_MAP;
+  std::vector<double> m_FULLCALO_1p0x1p0_MAP;
+
+  // window positions, per eta bin and per phi bin
+  std::vector<double> m_EMCAL_2x2_ETA;
+  std::vector<double> m_EMCAL_2x2_PHI;
+  std::vector<double> m_EMCAL_4x4_ETA;
+  std::vector<double> m_EMCAL_4x4_PHI;
+  std::vector<double> m_FULLCALO_0p2x0p2_ETA;
+  std::vector<double> m_FULLCALO_0p2x0p2_PHI;
+  std::vector<double> m_FULLCALO_0p4x0p4_ETA;
+  std::vector<double> m_FULLCALO_0p4x0p4_PHI;
+  std::vector<double> m_FULLCALO_0p6x0p6_ETA;
+  std::vector<double> m_FULLCALO_0p6x0p6_PHI;
+  std::vector<double> m_FULLCALO_0p8x0p8_ETA;
+  std::vector<double> m_FULLCALO_0p8x0p8_PHI;
+  std::vector<double> m_FULLCALO_1p0x1p0_ETA;
+  std::vector<double> m_FULLCALO_1p0x1p0_PHI;
+
+  // tower geometries and the map bin of each tower, set with the map sizes
+  RawTowerGeomTable m_geomEM;
+  RawTowerGeomTable m_geomIH;
+  RawTowerGeomTable m_geomOH;
+  std::vector<int> m_EMCAL_1x1_BIN;
+  std::vector<int> m_FULLCALO_BIN_EM;
+  std::vector<int> m_FULLCALO_BIN_IH;
+  std::vector<int> m_FULLCALO_BIN_OH;
 };
 
 #endif  // TRIGGER_CALOTRIGGERSIM_H
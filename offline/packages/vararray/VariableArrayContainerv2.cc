@@ -0,0 +1,80 @@
+#include "VariableArrayContainerv2.h"
+
+#include <algorithm>
+#include <ostream>
+
+using namespace std;
+
+VariableArrayContainerv2::VariableArrayContainerv2()
+  : m_Offsets(1, 0)
+{
+  return;
+}
+
+void VariableArrayContainerv2::identify(ostream &os) const
+{
+  os << "contain " << size() << " arrays with " << m_Values.size() << " values" << endl;
+  for (unsigned int i = 0; i < size(); i++)
+  {
+    os << "n: " << i << " id: " << m_Ids[i] << " size: " << get_array_size(i) << endl;
+  }
+  return;
+}
+
+void VariableArrayContainerv2::Reset()
+{
+  m_Ids.clear();
+  m_Offsets.resize(1);
+  m_Offsets[0] = 0;
+  m_Values.clear();
+  return;
+}
+
+void VariableArrayContainerv2::Reserve(const unsigned int narrays, const unsigned int nvalues)
+{
+  m_Ids.reserve(m_Ids.size() + narrays);
+  m_Offsets.reserve(m_Offsets.size() + narrays);
+  m_Values.reserve(m_Values.size() + nvalues);
+  return;
+}
+
+void VariableArrayContainerv2::AddArray(const int id, const short *values, const unsigned int n)
+{
+  m_Ids.push_back(id);
+  m_Values.insert(m_Values.end(), values, values + n);
+  m_Offsets.push_back(m_Values.size());
+  return;
+}
+
+void VariableArrayContainerv2::AddArrays(const unsigned int narrays, const int *ids, const unsigned int *sizes, const short *values)
+{
+  unsigned int nvalues = 0;
+  m_Ids.insert(m_Ids.end(), ids, ids + narrays);
+  m_Offsets.reserve(m_Offsets.size() + narrays);
+  for (unsigned int i = 0; i < narrays; i++)
+  {
+    nvalues += sizes[i];
+    m_Offsets.push_back(m_Values.size() + nvalues);
+  }
+  // one copy for all arrays
+  m_Values.insert(m_Values.end(), values, values + nvalues);
+  return;
+}
+
+VariableArrayContainerv2::Span VariableArrayContainerv2::get_array(const unsigned int i) const
+{
+  Span span;
+  span.data = m_Values.data() + m_Offsets[i];
+  span.size = m_Offsets[i + 1] - m_Offsets[i];
+  return span;
+}
+
+int VariableArrayContainerv2::find(const int id) const
+{
+  vector<int>::const_iterator iter = std::find(m_Ids.begin(), m_Ids.end(), id);
+  if (iter == m_Ids.end())
+  {
+    return -1;
+  }
+  return iter - m_Ids.begin();
+}
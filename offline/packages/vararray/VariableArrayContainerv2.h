@@ -0,0 +1,65 @@
+#ifndef VARARRAY_VARIABLEARRAYCONTAINERV2_H
+#define VARARRAY_VARIABLEARRAYCONTAINERV2_H
+
+#include <phool/PHObject.h>
+
+#include <iostream>
+#include <vector>
+
+/*!
+  \brief many variable length short arrays in one contiguous buffer
+
+  Unlike VariableArrayContainer, which holds one VariableArray (with its own
+  heap allocated buffer) per array, all values are appended to a single vector
+  and array i is the range [offsets[i], offsets[i+1]). On file these are flat
+  arrays, and reading an array returns a view into the buffer without copying.
+  Reset() keeps the capacity for the next event.
+*/
+class VariableArrayContainerv2 : public PHObject
+{
+ public:
+  //! read only view of one array, valid until the container is modified
+  struct Span
+  {
+    const short *data;
+    unsigned int size;
+    const short *begin() const { return data; }
+    const short *end() const { return data + size; }
+    short operator[](const unsigned int i) const { return data[i]; }
+  };
+
+  VariableArrayContainerv2();
+  virtual ~VariableArrayContainerv2() {}
+
+  void identify(std::ostream &os = std::cout) const;
+  void Reset();
+  int isValid() const { return !m_Ids.empty(); }
+
+  //! reserve space for narrays arrays with nvalues values in total
+  void Reserve(const unsigned int narrays, const unsigned int nvalues);
+
+  void AddArray(const int id, const short *values, const unsigned int n);
+  void AddArray(const int id, const std::vector<short> &values) { AddArray(id, values.data(), values.size()); }
+  //! appends narrays arrays, the values of all arrays are concatenated in values
+  void AddArrays(const unsigned int narrays, const int *ids, const unsigned int *sizes, const short *values);
+
+  unsigned int size() const { return m_Ids.size(); }
+  int get_id(const unsigned int i) const { return m_Ids[i]; }
+  Span get_array(const unsigned int i) const;
+  unsigned int get_array_size(const unsigned int i) const { return m_Offsets[i + 1] - m_Offsets[i]; }
+  //! index of the first array with this id, -1 if there is none
+  int find(const int id) const;
+
+  //! all values of all arrays
+  const std::vector<short> &get_values() const { return m_Values; }
+
+ protected:
+  std::vector<int> m_Ids;
+  //! size()+1 entries, the first one is 0
+  std::vector<unsigned int> m_Offsets;
+  std::vector<short> m_Values;
+
+  ClassDef(VariableArrayContainerv2, 1)
+};
+
+#endif
@@ -0,0 +1,421 @@
+// micro benchmarks of the containers and keys which are used in every event.
+// The inputs mimic central Au+Au occupancies, they are generated with a fixed
+// seed so numbers of different builds can be compared directly.
+//
+// usage: g4microbenchmark [-f <substring>] [-t <min seconds>] [-j <json file>]
+
+#include <tpc/TpcDefs.h>
+#include <tpc/TpcHit.h>
+
+#include <trackbase/TrkrDefs.h>
+#include <trackbase/TrkrHitSet.h>
+#include <trackbase/TrkrHitSetContainer.h>
+
+#include <calobase/RawTowerContainer.h>
+#include <calobase/RawTowerDefs.h>
+#include <calobase/RawTowerv1.h>
+
+#include <g4main/PHG4HitContainer.h>
+#include <g4main/PHG4Hitv1.h>
+#include <g4main/PHG4Particlev1.h>
+#include <g4main/PHG4TruthInfoContainer.h>
+
+#include <algorithm>
+#include <chrono>
+#include <cstdlib>
+#include <fstream>
+#include <functional>
+#include <iomanip>
+#include <iostream>
+#include <limits>
+#include <random>
+#include <string>
+#include <unistd.h>
+#include <utility>
+#include <vector>
+
+using namespace std;
+
+namespace
+{
+  // central Au+Au event
+  const unsigned int kTpcLayers = 48;
+  const unsigned int kTpcFirstLayer = 7;
+  const unsigned int kTpcSectors = 12;
+  const unsigned int kTpcTBins = 498;
+  const double kTpcOccupancy = 0.1;  // inner layers are higher, outer lower
+  const unsigned int kG4Hits = 100000;
+  const unsigned int kCemcEta = 96;
+  const unsigned int kCemcPhi = 256;
+  const double kCemcOccupancy = 0.3;
+  const unsigned int kPrimaries = 10000;
+  const unsigned int kSecondaries = 50000;
+
+  // results end up here so the compiler cannot drop the loops
+  volatile unsigned long sink = 0;
+
+  typedef chrono::steady_clock Clock;
+
+  double Seconds(const Clock::time_point &start)
+  {
+    return chrono::duration<double>(Clock::now() - start).count();
+  }
+
+  //! one event of a benchmark, returns the seconds spent in the measured part, sets the number of operations
+  typedef function<double(unsigned long &operations)> Event;
+
+  struct Benchmark
+  {
+    string name;
+    Event event;
+  };
+
+  struct Result
+  {
+    string name;
+    unsigned long events;
+    unsigned long operations;  // per event
+    double mean_ns;            // per operation
+    double min_ns;
+  };
+
+  unsigned int TpcPads(const unsigned int layer)
+  {
+    // pads per sector of the three TPC modules
+    if (layer < kTpcFirstLayer + 16)
+    {
+      return 96;
+    }
+    if (layer < kTpcFirstLayer + 32)
+    {
+      return 128;
+    }
+    return 192;
+  }
+
+  //! (hitset key, hit key) of the fired TPC pads in the order Geant4 produces them (random)
+  vector<pair<TrkrDefs::hitsetkey, TrkrDefs::hitkey> > TpcHits(const unsigned int nlayers)
+  {
+    mt19937 rng(12345);
+    bernoulli_distribution fired(kTpcOccupancy);
+    vector<pair<TrkrDefs::hitsetkey, TrkrDefs::hitkey> > hits;
+    for (unsigned int layer = kTpcFirstLayer; layer < kTpcFirstLayer + nlayers; layer++)
+    {
+      for (unsigned int side = 0; side < 2; side++)
+      {
+        for (unsigned int sector = 0; sector < kTpcSectors; sector++)
+        {
+          TrkrDefs::hitsetkey hitsetkey = TpcDefs::genHitSetKey(layer, sector, side);
+          for (unsigned int pad = 0; pad < TpcPads(layer); pad++)
+          {
+            for (unsigned int tbin = 0; tbin < kTpcTBins; tbin++)
+            {
+              if (fired(rng))
+              {
+                hits.push_back(make_pair(hitsetkey, TpcDefs::genHitKey(pad, tbin)));
+              }
+            }
+          }
+        }
+      }
+    }
+    shuffle(hits.begin(), hits.end(), rng);
+    return hits;
+  }
+
+  double TrkrKeyEncode(unsigned long &operations)
+  {
+    static const vector<pair<TrkrDefs::hitsetkey, TrkrDefs::hitkey> > hits = TpcHits(4);
+    Clock::time_point start = Clock::now();
+    unsigned long sum = 0;
+    for (auto &hit : hits)
+    {
+      uint8_t layer = TrkrDefs::getLayer(hit.first);
+      TrkrDefs::hitsetkey hitsetkey = TpcDefs::genHitSetKey(layer, TpcDefs::getSectorId(hit.first), TpcDefs::getSide(hit.first));
+      TrkrDefs::cluskey cluskey = TpcDefs::genClusKey(hitsetkey, hit.second);
+      sum += cluskey + TpcDefs::genHitKey(TpcDefs::getPad(hit.second), TpcDefs::getTBin(hit.second));
+    }
+    double seconds = Seconds(start);
+    sink = sum;
+    operations = hits.size();
+    return seconds;
+  }
+
+  double TrkrKeyDecode(unsigned long &operations)
+  {
+    static const vector<pair<TrkrDefs::hitsetkey, TrkrDefs::hitkey> > hits = TpcHits(4);
+    Clock::time_point start = Clock::now();
+    unsigned long sum = 0;
+    for (auto &hit : hits)
+    {
+      sum += TrkrDefs::getTrkrId(hit.first) + TrkrDefs::getLayer(hit.first) + TpcDefs::getSectorId(hit.first) + TpcDefs::getSide(hit.first) + TpcDefs::getPad(hit.second) + TpcDefs::getTBin(hit.second);
+    }
+    double seconds = Seconds(start);
+    sink = sum;
+    operations = hits.size();
+    return seconds;
+  }
+
+  double HitSetFindOrAdd(unsigned long &operations)
+  {
+    // every g4hit looks up its hitset, the hitsets of all layers are filled
+    static const vector<pair<TrkrDefs::hitsetkey, TrkrDefs::hitkey> > hits = TpcHits(kTpcLayers);
+    TrkrHitSetContainer container;
+    Clock::time_point start = Clock::now();
+    for (auto &hit : hits)
+    {
+      container.findOrAddHitSet(hit.first);
+    }
+    double seconds = Seconds(start);
+    sink = container.size();
+    operations = hits.size();
+    return seconds;
+  }
+
+  double HitSetAddHit(unsigned long &operations)
+  {
+    // the fired pads of one inner layer sector
+    static vector<TrkrDefs::hitkey> keys;
+    if (keys.empty())
+    {
+      for (auto &hit : TpcHits(1))
+      {
+        if (TpcDefs::getSectorId(hit.first) == 0 && TpcDefs::getSide(hit.first) == 0)
+        {
+          keys.push_back(hit.second);
+        }
+      }
+    }
+    vector<TrkrHit *> tpchits;
+    tpchits.reserve(keys.size());
+    for (unsigned int i = 0; i < keys.size(); i++)
+    {
+      tpchits.push_back(new TpcHit());
+    }
+    TrkrHitSet hitset;
+    Clock::time_point start = Clock::now();
+    for (unsigned int i = 0; i < keys.size(); i++)
+    {
+      hitset.addHitSpecificKey(keys[i], tpchits[i]);
+    }
+    double seconds = Seconds(start);
+    sink = hitset.size();
+    operations = keys.size();
+    return seconds;
+  }
+
+  double G4HitAdd(unsigned long &operations)
+  {
+    static vector<unsigned int> layers;
+    if (layers.empty())
+    {
+      mt19937 rng(12345);
+      uniform_int_distribution<unsigned int> layer(0, kTpcLayers - 1);
+      for (unsigned int i = 0; i < kG4Hits; i++)
+      {
+        layers.push_back(layer(rng));
+      }
+    }
+    vector<PHG4Hit *> g4hits;
+    g4hits.reserve(layers.size());
+    for (unsigned int i = 0; i < layers.size(); i++)
+    {
+      g4hits.push_back(new PHG4Hitv1());
+    }
+    PHG4HitContainer container("G4HIT_BENCHMARK");
+    Clock::time_point start = Clock::now();
+    for (unsigned int i = 0; i < layers.size(); i++)
+    {
+      container.AddHit(layers[i], g4hits[i]);
+    }
+    double seconds = Seconds(start);
+    sink = container.size();
+    container.Reset();
+    operations = layers.size();
+    return seconds;
+  }
+
+  double TowerGet(unsigned long &operations)
+  {
+    // clustering looks up the fired towers and their (mostly empty) neighbours
+    static RawTowerContainer *container = nullptr;
+    static vector<pair<unsigned int, unsigned int> > lookups;
+    if (!container)
+    {
+      container = new RawTowerContainer(RawTowerDefs::CEMC);
+      mt19937 rng(12345);
+      bernoulli_distribution fired(kCemcOccupancy);
+      for (unsigned int ieta = 0; ieta < kCemcEta; ieta++)
+      {
+        for (unsigned int iphi = 0; iphi < kCemcPhi; iphi++)
+        {
+          if (fired(rng))
+          {
+            container->AddTower(ieta, iphi, new RawTowerv1(RawTowerDefs::CEMC, ieta, iphi));
+            for (int deta = -1; deta <= 1; deta++)
+            {
+              for (int dphi = -1; dphi <= 1; dphi++)
+              {
+                lookups.push_back(make_pair((ieta + kCemcEta + deta) % kCemcEta, (iphi + kCemcPhi + dphi) % kCemcPhi));
+              }
+            }
+          }
+        }
+      }
+    }
+    Clock::time_point start = Clock::now();
+    unsigned long found = 0;
+    for (auto &lookup : lookups)
+    {
+      if (container->getTower(lookup.first, lookup.second))
+      {
+        found++;
+      }
+    }
+    double seconds = Seconds(start);
+    sink = found;
+    operations = lookups.size();
+    return seconds;
+  }
+
+  double TruthAddParticle(unsigned long &operations)
+  {
+    // primaries have positive, Geant4 secondaries negative track ids
+    static vector<int> trackids;
+    if (trackids.empty())
+    {
+      for (unsigned int i = 1; i <= kPrimaries; i++)
+      {
+        trackids.push_back(i);
+      }
+      for (unsigned int i = 1; i <= kSecondaries; i++)
+      {
+        trackids.push_back(-static_cast<int>(i));
+      }
+    }
+    vector<PHG4Particle *> particles;
+    particles.reserve(trackids.size());
+    for (unsigned int i = 0; i < trackids.size(); i++)
+    {
+      particles.push_back(new PHG4Particlev1("pi+", 211, 0.1, 0.2, 0.3));
+    }
+    PHG4TruthInfoContainer container;
+    Clock::time_point start = Clock::now();
+    for (unsigned int i = 0; i < trackids.size(); i++)
+    {
+      container.AddParticle(trackids[i], particles[i]);
+    }
+    double seconds = Seconds(start);
+    sink = container.size();
+    container.Reset();
+    operations = trackids.size();
+    return seconds;
+  }
+
+  Result Run(const Benchmark &benchmark, const double min_time)
+  {
+    Result result;
+    result.name = benchmark.name;
+    result.events = 0;
+    result.operations = 0;
+    result.min_ns = numeric_limits<double>::max();
+    // the first event fills the static inputs and warms up the caches
+    unsigned long operations = 0;
+    benchmark.event(operations);
+    double total = 0;
+    while (total < min_time || result.events < 3)
+    {
+      double seconds = benchmark.event(operations);
+      total += seconds;
+      result.events++;
+      result.operations = operations;
+      if (operations > 0)
+      {
+        result.min_ns = min(result.min_ns, seconds * 1e9 / operations);
+      }
+    }
+    result.mean_ns = (result.operations > 0 ? total * 1e9 / (result.events * result.operations) : 0);
+    return result;
+  }
+
+  int WriteJson(const string &filename, const vector<Result> &results)
+  {
+    ofstream json(filename.c_str());
+    if (!json.is_open())
+    {
+      cout << "could not open " << filename << endl;
+      return -1;
+    }
+    json << "{\"benchmarks\":[" << endl;
+    for (auto iter = results.begin(); iter != results.end(); ++iter)
+    {
+      if (iter != results.begin())
+      {
+        json << "," << endl;
+      }
+      json << "{\"name\":\"" << iter->name << "\",\"events\":" << iter->events
+           << ",\"operations_per_event\":" << iter->operations
+           << ",\"mean_ns_per_operation\":" << iter->mean_ns
+           << ",\"min_ns_per_operation\":" << iter->min_ns << "}";
+    }
+    json << endl
+         << "]}" << endl;
+    return 0;
+  }
+}  // namespace
+
+int main(int argc, char *argv[])
+{
+  string filter;
+  string jsonfile;
+  double min_time = 1.;
+  int opt;
+  while ((opt = getopt(argc, argv, "f:j:t:")) != -1)
+  {
+    switch (opt)
+    {
+    case 'f':
+      filter = optarg;
+      break;
+    case 'j':
+      jsonfile = optarg;
+      break;
+    case 't':
+      min_time = atof(optarg);
+      break;
+    default:
+      cout << "usage: " << argv[0] << " [-f <substring>] [-t <min seconds>] [-j <json file>]" << endl;
+      return 1;
+    }
+  }
+
+  vector<Benchmark> benchmarks = {
+      {"TrkrDefs_encode", TrkrKeyEncode},
+      {"TrkrDefs_decode", TrkrKeyDecode},
+      {"TrkrHitSetContainer_findOrAddHitSet", HitSetFindOrAdd},
+      {"TrkrHitSet_addHitSpecificKey", HitSetAddHit},
+      {"PHG4HitContainer_AddHit", G4HitAdd},
+      {"RawTowerContainer_getTower", TowerGet},
+      {"PHG4TruthInfoContainer_AddParticle", TruthAddParticle}};
+
+  vector<Result> results;
+  cout << left << setw(40) << "benchmark" << right << setw(10) << "events"
+       << setw(12) << "ops/event" << setw(12) << "ns/op" << setw(12) << "min ns/op" << endl;
+  for (auto &benchmark : benchmarks)
+  {
+    if (!filter.empty() && benchmark.name.find(filter) == string::npos)
+    {
+      continue;
+    }
+    Result result = Run(benchmark, min_time);
+    cout << left << setw(40) << result.name << right << setw(10) << result.events
+         << setw(12) << result.operations << setw(12) << setprecision(4) << result.mean_ns
+         << setw(12) << result.min_ns << endl;
+    results.push_back(result);
+  }
+  if (!jsonfile.empty())
+  {
+    return WriteJson(jsonfile, results);
+  }
+  return 0;
+}
@@ -6,8 +6,11 @@
 #include <calobase/RawTowerGeomContainer.h>             // for RawTowerGeomC...
 #include <calobase/RawTowerGeomContainer_Cylinderv1.h>
 #include <calobase/RawTowerGeomv1.h>
+#include <calobase/RawTowerCellTable.h>
+#include <calobase/RawTowerShowerTable.h>
 #include <calobase/RawTower.h>                          // for RawTower
 #include <calobase/RawTowerv1.h>
+#include <calobase/RawTowerv3.h>
 
 #include <g4detectors/PHG4Cell.h>
 #include <g4detectors/PHG4CellContainer.h>
@@ -16,6 +19,7 @@
 
 #include <phparameter/PHParameters.h>
 #include <phparameter/PHParameterInterface.h>           // for PHParameterIn...
+#include <phparameter/PHParametersStore.h>
 
 #include <g4main/PHG4Utils.h>
 
@@ -49,11 +53,16 @@ HcalRawTowerBuilder::HcalRawTowerBuilder(const std::string &name)
   , PHParameterInterface(name)
   , m_Towers(nullptr)
   , m_RawTowerGeom(nullptr)
+  , m_ShowerTable(nullptr)
+  , m_CellTable(nullptr)
+  , m_Cells(nullptr)
   , m_Detector("NONE")
   , m_Emin(NAN)
   , m_ChkEnergyConservationFlag(0)
   , m_TowerEnergySrc(enu_tower_energy_src::unknown)
   , m_NcellToTower(-1)
+  , m_ShowerStorage(kShowerTowerMaps)
+  , m_CellStorage(kCellTowerMaps)
 {
   InitializeParameters();
 }
@@ -226,6 +235,16 @@ int HcalRawTowerBuilder::InitRun(PHCompositeNode *topNode)
 }
 
 int HcalRawTowerBuilder::process_event(PHCompositeNode *topNode)
+{
+  int ret = GetCells(topNode);
+  if (ret != Fun4AllReturnCodes::EVENT_OK)
+  {
+    return ret;
+  }
+  return BuildTowers();
+}
+
+int HcalRawTowerBuilder::GetCells(PHCompositeNode *topNode)
 {
   if (Verbosity() > 3)
   {
@@ -234,13 +253,19 @@ int HcalRawTowerBuilder::process_event(PHCompositeNode *topNode)
 
   // get cells
   std::string cellnodename = "G4CELL_" + m_Detector;
-  PHG4CellContainer *slats = findNode::getClass<PHG4CellContainer>(topNode, cellnodename);
-  if (!slats)
+  m_Cells = findNode::getClass<PHG4CellContainer>(topNode, cellnodename);
+  if (!m_Cells)
   {
     std::cerr << PHWHERE << " " << cellnodename
               << " Node missing, doing nothing." << std::endl;
     return Fun4AllReturnCodes::ABORTEVENT;
   }
+  return Fun4AllReturnCodes::EVENT_OK;
+}
+
+int HcalRawTowerBuilder::BuildTowers()
+{
+  PHG4CellContainer *slats = m_Cells;
 
   // loop over all slats in an event
   PHG4CellContainer::ConstIterator cell_iter;
@@ -261,7 +286,14 @@ int HcalRawTowerBuilder::process_event(PHCompositeNode *topNode)
     RawTower *tower = m_Towers->getTower(PHG4CellDefs::ScintillatorSlatBinning::get_column(cell->get_cellid()), twrrow);
     if (!tower)
     {
-      tower = new RawTowerv1();
+      if (m_CellStorage == kCellTowerMaps || m_ShowerStorage == kShowerTowerMaps)
+      {
+        tower = new RawTowerv1();
+      }
+      else
+      {
+        tower = new RawTowerv3();
+      }
       tower->set_energy(0);
       m_Towers->AddTower(PHG4CellDefs::ScintillatorSlatBinning::get_column(cell->get_cellid()), twrrow, tower);
     }
@@ -285,14 +317,31 @@ int HcalRawTowerBuilder::process_event(PHCompositeNode *topNode)
       gSystem->Exit(1);
     }
 
-    tower->add_ecell(cell->get_cellid(), cell_weight);
+    if (m_CellStorage == kCellTable)
+    {
+      m_CellTable->add(RawTowerDefs::encode_towerid(m_Towers->getCalorimeterID(), PHG4CellDefs::ScintillatorSlatBinning::get_column(cell->get_cellid()), twrrow), cell->get_cellid(), cell_weight);
+    }
+    else if (m_CellStorage == kCellTowerMaps)
+    {
+      tower->add_ecell(cell->get_cellid(), cell_weight);
+    }
 
-    PHG4Cell::ShowerEdepConstRange range = cell->get_g4showers();
-    for (PHG4Cell::ShowerEdepConstIterator shower_iter = range.first;
-         shower_iter != range.second;
-         ++shower_iter)
+    if (m_ShowerStorage != kShowerNone)
     {
-      tower->add_eshower(shower_iter->first, shower_iter->second);
+      PHG4Cell::ShowerEdepConstRange range = cell->get_g4showers();
+      for (PHG4Cell::ShowerEdepConstIterator shower_iter = range.first;
+           shower_iter != range.second;
+           ++shower_iter)
+      {
+        if (m_ShowerStorage == kShowerTable)
+        {
+          m_ShowerTable->add(RawTowerDefs::encode_towerid(m_Towers->getCalorimeterID(), PHG4CellDefs::ScintillatorSlatBinning::get_column(cell->get_cellid()), twrrow), shower_iter->first, shower_iter->second);
+        }
+        else
+        {
+          tower->add_eshower(shower_iter->first, shower_iter->second);
+        }
+      }
     }
     tower->set_energy(tower->get_energy() + cell_weight);
   }
@@ -313,6 +362,18 @@ int HcalRawTowerBuilder::process_event(PHCompositeNode *topNode)
   }
 
   m_Towers->compress(m_Emin);
+  // tables sorted and without the entries of the dropped towers
+  RawTowerContainer *towers = m_Towers;
+  if (m_CellStorage == kCellTable)
+  {
+    m_CellTable->finalize();
+    m_CellTable->keep_towers([towers](const RawTowerDefs::keytype key) { return towers->getTower(key) != nullptr; });
+  }
+  if (m_ShowerStorage == kShowerTable)
+  {
+    m_ShowerTable->finalize();
+    m_ShowerTable->keep_towers([towers](const RawTowerDefs::keytype key) { return towers->getTower(key) != nullptr; });
+  }
   if (Verbosity())
   {
     cout << "Energy lost by dropping towers with less than " << m_Emin
@@ -378,6 +439,29 @@ void HcalRawTowerBuilder::CreateNodes(PHCompositeNode *topNode)
                                                                    m_TowerNodeName, "PHObject");
     DetNode->addNode(towerNode);
   }
+
+  if (m_ShowerStorage == kShowerTable)
+  {
+    // same name as the towers with TOWERSHOWER_ instead of TOWER_
+    const std::string tablenodename = "TOWERSHOWER_" + m_TowerNodeName.substr(6);
+    m_ShowerTable = findNode::getClass<RawTowerShowerTable>(DetNode, tablenodename);
+    if (!m_ShowerTable)
+    {
+      m_ShowerTable = new RawTowerShowerTable();
+      DetNode->addNode(new PHIODataNode<PHObject>(m_ShowerTable, tablenodename, "PHObject"));
+    }
+  }
+
+  if (m_CellStorage == kCellTable)
+  {
+    const std::string cellnodename = "TOWERCELL_" + m_TowerNodeName.substr(6);
+    m_CellTable = findNode::getClass<RawTowerCellTable>(DetNode, cellnodename);
+    if (!m_CellTable)
+    {
+      m_CellTable = new RawTowerCellTable();
+      DetNode->addNode(new PHIODataNode<PHObject>(m_CellTable, cellnodename, "PHObject"));
+    }
+  }
   return;
 }
 
@@ -401,23 +485,31 @@ void HcalRawTowerBuilder::SetDefaultParameters()
 
 void HcalRawTowerBuilder::ReadParamsFromNodeTree(PHCompositeNode *topNode)
 {
-  PHParameters *pars = new PHParameters("temp");
-  // we need the number of scintillator plates per tower
-  string geonodename = "G4GEOPARAM_" + m_Detector;
-  PdbParameterMapContainer *saveparams = findNode::getClass<PdbParameterMapContainer>(topNode, geonodename);
-  if (!saveparams)
+  // the parameters of the simulation in this job, without a copy
+  const PHParametersStore *store = PHParametersStore::GetStore(topNode);
+  const PHParameters *pars = (store ? store->GetParameters(m_Detector, 0) : nullptr);
+  PHParameters *readpars = nullptr;
+  if (!pars)
   {
-    cout << "could not find " << geonodename << endl;
-    Fun4AllServer *se = Fun4AllServer::instance();
-    se->Print("NODETREE");
-    return;
+    // we need the number of scintillator plates per tower
+    string geonodename = "G4GEOPARAM_" + m_Detector;
+    PdbParameterMapContainer *saveparams = findNode::getClass<PdbParameterMapContainer>(topNode, geonodename);
+    if (!saveparams)
+    {
+      cout << "could not find " << geonodename << endl;
+      Fun4AllServer *se = Fun4AllServer::instance();
+      se->Print("NODETREE");
+      return;
+    }
+    readpars = new PHParameters("temp");
+    readpars->FillFrom(saveparams, 0);
+    pars = readpars;
   }
-  pars->FillFrom(saveparams, 0);
   set_int_param(PHG4HcalDefs::scipertwr, pars->get_int_param(PHG4HcalDefs::scipertwr));
   set_int_param(PHG4HcalDefs::n_towers, pars->get_int_param(PHG4HcalDefs::n_towers));
   set_int_param("etabins", 2 * pars->get_int_param(PHG4HcalDefs::n_scinti_tiles));
   set_double_param(PHG4HcalDefs::innerrad, pars->get_double_param(PHG4HcalDefs::innerrad));
   set_double_param(PHG4HcalDefs::outerrad, pars->get_double_param(PHG4HcalDefs::outerrad));
-  delete pars;
+  delete readpars;
   return;
 }
@@ -8,8 +8,11 @@
 #include <string>
 
 class PHCompositeNode;
+class PHG4CellContainer;
+class RawTowerCellTable;
 class RawTowerContainer;
 class RawTowerGeomContainer;
+class RawTowerShowerTable;
 
 class HcalRawTowerBuilder : public SubsysReco, public PHParameterInterface
 {
@@ -19,6 +22,11 @@ class HcalRawTowerBuilder : public SubsysReco, public PHParameterInterface
 
   int InitRun(PHCompositeNode *topNode);
   int process_event(PHCompositeNode *topNode);
+
+  //! process_event in two steps, see RawTowerBuilder
+  int GetCells(PHCompositeNode *topNode);
+  int BuildTowers();
+
   void Detector(const std::string &d) { m_Detector = d; }
   void EminCut(const double e) { m_Emin = e; }
   void checkenergy(const int i = 1) { m_ChkEnergyConservationFlag = i; }
@@ -42,6 +50,27 @@ class HcalRawTowerBuilder : public SubsysReco, public PHParameterInterface
     return m_TowerEnergySrc;
   }
 
+  //! storage of the truth shower energies, as RawTowerBuilder::enu_shower_storage
+  enum enu_shower_storage
+  {
+    kShowerTowerMaps,
+    kShowerTable,
+    kShowerNone
+  };
+
+  void set_shower_storage(enu_shower_storage s) { m_ShowerStorage = s; }
+
+  //! storage of the cell energies, as RawTowerBuilder::enu_cell_storage
+  enum enu_cell_storage
+  {
+    kCellTowerMaps,
+    kCellTable,
+    kCellNone
+  };
+
+  //! with neither cells nor showers in the tower maps the towers are RawTowerv3 (energy, time and status only)
+  void set_cell_storage(enu_cell_storage s) { m_CellStorage = s; }
+
   std::string
   get_sim_tower_node_prefix() const
   {
@@ -64,6 +93,9 @@ class HcalRawTowerBuilder : public SubsysReco, public PHParameterInterface
 
   RawTowerContainer *m_Towers;
   RawTowerGeomContainer *m_RawTowerGeom;
+  RawTowerShowerTable *m_ShowerTable;
+  RawTowerCellTable *m_CellTable;
+  PHG4CellContainer *m_Cells;
 
   std::string m_Detector;
   std::string m_TowerNodeName;
@@ -74,6 +106,8 @@ class HcalRawTowerBuilder : public SubsysReco, public PHParameterInterface
   int m_ChkEnergyConservationFlag;
   int m_TowerEnergySrc;
   int m_NcellToTower;
+  enu_shower_storage m_ShowerStorage;
+  enu_cell_storage m_CellStorage;
 };
 
 #endif /* G4CALO_HCALRAWTOWERBUILDER_H */
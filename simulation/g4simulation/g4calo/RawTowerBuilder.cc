@@ -2,12 +2,15 @@
 
 #include <calobase/RawTower.h>                          // for RawTower
 #include <calobase/RawTowerv1.h>
+#include <calobase/RawTowerv3.h>
+#include <calobase/RawTowerCellTable.h>
 #include <calobase/RawTowerContainer.h>
 #include <calobase/RawTowerDefs.h>                      // for encode_towerid
 #include <calobase/RawTowerGeomContainer.h>             // for RawTowerGeomC...
 #include <calobase/RawTowerGeomContainer_Cylinderv1.h>
 #include <calobase/RawTowerGeom.h>                      // for RawTowerGeom
 #include <calobase/RawTowerGeomv1.h>
+#include <calobase/RawTowerShowerTable.h>
 
 #include <g4detectors/PHG4CylinderCellGeom.h>
 #include <g4detectors/PHG4CylinderCellGeomContainer.h>
@@ -45,8 +48,13 @@ RawTowerBuilder::RawTowerBuilder(const std::string &name)
   : SubsysReco(name)
   , m_TowerContainer(nullptr)
   , m_RawTowerGeomContainer(nullptr)
+  , m_ShowerTable(nullptr)
+  , m_CellTable(nullptr)
+  , m_Cells(nullptr)
   , m_Detector("NONE")
   , m_TowerEnergySrcEnum(kLightYield)
+  , m_ShowerStorage(kShowerTowerMaps)
+  , m_CellStorage(kCellTowerMaps)
   , m_CellBinning(PHG4CellDefs::undefined)
   , m_ChkEnergyConservationFlag(0)
   , m_NumLayers(-1)
@@ -115,6 +123,16 @@ int RawTowerBuilder::InitRun(PHCompositeNode *topNode)
 }
 
 int RawTowerBuilder::process_event(PHCompositeNode *topNode)
+{
+  int ret = GetCells(topNode);
+  if (ret != Fun4AllReturnCodes::EVENT_OK)
+  {
+    return ret;
+  }
+  return BuildTowers();
+}
+
+int RawTowerBuilder::GetCells(PHCompositeNode *topNode)
 {
   if (Verbosity())
   {
@@ -123,13 +141,19 @@ int RawTowerBuilder::process_event(PHCompositeNode *topNode)
 
   // get cells
   std::string cellnodename = "G4CELL_" + m_Detector;
-  PHG4CellContainer *cells = findNode::getClass<PHG4CellContainer>(topNode, cellnodename);
-  if (!cells)
+  m_Cells = findNode::getClass<PHG4CellContainer>(topNode, cellnodename);
+  if (!m_Cells)
   {
     cout << PHWHERE << " " << cellnodename
          << " Node missing, doing nothing." << std::endl;
     return Fun4AllReturnCodes::ABORTEVENT;
   }
+  return Fun4AllReturnCodes::EVENT_OK;
+}
+
+int RawTowerBuilder::BuildTowers()
+{
+  PHG4CellContainer *cells = m_Cells;
 
   // loop over all cells in an event
   PHG4CellContainer::ConstIterator cell_iter;
@@ -167,7 +191,14 @@ int RawTowerBuilder::process_event(PHCompositeNode *topNode)
     tower = m_TowerContainer->getTower(firstpar, secondpar);
     if (!tower)
     {
-      tower = new RawTowerv1();
+      if (m_CellStorage == kCellTowerMaps || m_ShowerStorage == kShowerTowerMaps)
+      {
+        tower = new RawTowerv1();
+      }
+      else
+      {
+        tower = new RawTowerv3();
+      }
       tower->set_energy(0);
       m_TowerContainer->AddTower(firstpar, secondpar, tower);
     }
@@ -181,21 +212,37 @@ int RawTowerBuilder::process_event(PHCompositeNode *topNode)
       cell_weight = cell->get_light_yield();
     }
 
-    tower->add_ecell(cell->get_cellid(), cell_weight);
+    if (m_CellStorage == kCellTable)
+    {
+      m_CellTable->add(RawTowerDefs::encode_towerid(m_TowerContainer->getCalorimeterID(), firstpar, secondpar), cell->get_cellid(), cell_weight);
+    }
+    else if (m_CellStorage == kCellTowerMaps)
+    {
+      tower->add_ecell(cell->get_cellid(), cell_weight);
+    }
 
-    PHG4Cell::ShowerEdepConstRange range = cell->get_g4showers();
-    for (PHG4Cell::ShowerEdepConstIterator shower_iter = range.first;
-         shower_iter != range.second;
-         ++shower_iter)
+    if (m_ShowerStorage != kShowerNone)
     {
-      tower->add_eshower(shower_iter->first, shower_iter->second);
+      PHG4Cell::ShowerEdepConstRange range = cell->get_g4showers();
+      for (PHG4Cell::ShowerEdepConstIterator shower_iter = range.first;
+           shower_iter != range.second;
+           ++shower_iter)
+      {
+        if (m_ShowerStorage == kShowerTable)
+        {
+          m_ShowerTable->add(RawTowerDefs::encode_towerid(m_TowerContainer->getCalorimeterID(), firstpar, secondpar), shower_iter->first, shower_iter->second);
+        }
+        else
+        {
+          tower->add_eshower(shower_iter->first, shower_iter->second);
+        }
+      }
     }
 
     tower->set_energy(tower->get_energy() + cell_weight);
 
     if (Verbosity() > 2)
     {
-      m_RawTowerGeomContainer = findNode::getClass<RawTowerGeomContainer>(topNode, m_TowerGeomNodeName);
       tower->identify();
     }
   }
@@ -216,6 +263,18 @@ int RawTowerBuilder::process_event(PHCompositeNode *topNode)
   }
 
   m_TowerContainer->compress(m_Emin);
+  // tables sorted and without the entries of the dropped towers
+  RawTowerContainer *towers = m_TowerContainer;
+  if (m_CellStorage == kCellTable)
+  {
+    m_CellTable->finalize();
+    m_CellTable->keep_towers([towers](const RawTowerDefs::keytype key) { return towers->getTower(key) != nullptr; });
+  }
+  if (m_ShowerStorage == kShowerTable)
+  {
+    m_ShowerTable->finalize();
+    m_ShowerTable->keep_towers([towers](const RawTowerDefs::keytype key) { return towers->getTower(key) != nullptr; });
+  }
   if (Verbosity())
   {
     cout << "Energy lost by dropping towers with less than " << m_Emin
@@ -605,5 +664,28 @@ void RawTowerBuilder::CreateNodes(PHCompositeNode *topNode)
     DetNode->addNode(towerNode);
   }
 
+  if (m_ShowerStorage == kShowerTable)
+  {
+    // same name as the towers with TOWERSHOWER_ instead of TOWER_
+    const std::string tablenodename = "TOWERSHOWER_" + m_TowerNodeName.substr(6);
+    m_ShowerTable = findNode::getClass<RawTowerShowerTable>(DetNode, tablenodename);
+    if (!m_ShowerTable)
+    {
+      m_ShowerTable = new RawTowerShowerTable();
+      DetNode->addNode(new PHIODataNode<PHObject>(m_ShowerTable, tablenodename, "PHObject"));
+    }
+  }
+
+  if (m_CellStorage == kCellTable)
+  {
+    const std::string cellnodename = "TOWERCELL_" + m_TowerNodeName.substr(6);
+    m_CellTable = findNode::getClass<RawTowerCellTable>(DetNode, cellnodename);
+    if (!m_CellTable)
+    {
+      m_CellTable = new RawTowerCellTable();
+      DetNode->addNode(new PHIODataNode<PHObject>(m_CellTable, cellnodename, "PHObject"));
+    }
+  }
+
   return;
 }
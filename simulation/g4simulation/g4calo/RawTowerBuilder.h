@@ -6,8 +6,11 @@
 #include <string>
 
 class PHCompositeNode;
+class PHG4CellContainer;
+class RawTowerCellTable;
 class RawTowerContainer;
 class RawTowerGeomContainer;
+class RawTowerShowerTable;
 
 class RawTowerBuilder : public SubsysReco
 {
@@ -16,6 +19,13 @@ class RawTowerBuilder : public SubsysReco
   virtual ~RawTowerBuilder() {}
   int InitRun(PHCompositeNode *topNode);
   int process_event(PHCompositeNode *topNode);
+
+  //! process_event in two steps, for RawTowerBuilderGroup which runs the second one
+  //! of several calorimeters in parallel. GetCells reads the node tree (not thread safe),
+  //! BuildTowers only touches the cells and the towers of this calorimeter
+  int GetCells(PHCompositeNode *topNode);
+  int BuildTowers();
+
   void Detector(const std::string &d) { m_Detector = d; }
   void EminCut(const double e) { m_Emin = e; }
   void checkenergy(const int i = 1) { m_ChkEnergyConservationFlag = i; }
@@ -41,6 +51,35 @@ class RawTowerBuilder : public SubsysReco
     m_TowerEnergySrcEnum = towerEnergySrc;
   }
 
+  enum enu_shower_storage
+  {
+    //! truth shower energies in the shower map of each tower (default)
+    kShowerTowerMaps,
+
+    //! truth shower energies in one RawTowerShowerTable node (TOWERSHOWER_...)
+    kShowerTable,
+
+    //! no truth shower energies
+    kShowerNone
+  };
+
+  void set_shower_storage(enu_shower_storage s) { m_ShowerStorage = s; }
+
+  enum enu_cell_storage
+  {
+    //! cell energies in the cell map of each tower (default)
+    kCellTowerMaps,
+
+    //! cell energies in one RawTowerCellTable node (TOWERCELL_...)
+    kCellTable,
+
+    //! no cell energies
+    kCellNone
+  };
+
+  //! with neither cells nor showers in the tower maps the towers are RawTowerv3 (energy, time and status only)
+  void set_cell_storage(enu_cell_storage s) { m_CellStorage = s; }
+
   std::string
   get_sim_tower_node_prefix() const
   {
@@ -58,6 +97,9 @@ class RawTowerBuilder : public SubsysReco
 
   RawTowerContainer *m_TowerContainer;
   RawTowerGeomContainer *m_RawTowerGeomContainer;
+  RawTowerShowerTable *m_ShowerTable;
+  RawTowerCellTable *m_CellTable;
+  PHG4CellContainer *m_Cells;
 
   std::string m_Detector;
   std::string m_TowerNodeName;
@@ -65,6 +107,8 @@ class RawTowerBuilder : public SubsysReco
   std::string m_SimTowerNodePrefix;
 
   enu_tower_energy_src m_TowerEnergySrcEnum;
+  enu_shower_storage m_ShowerStorage;
+  enu_cell_storage m_CellStorage;
   int m_CellBinning;
   int m_ChkEnergyConservationFlag;
   int m_NumLayers;
@@ -0,0 +1,153 @@
+#include "RawTowerBuilderGroup.h"
+
+#include "HcalRawTowerBuilder.h"
+#include "RawTowerBuilder.h"
+
+#include <fun4all/Fun4AllReturnCodes.h>
+#include <fun4all/SubsysReco.h>
+
+#include <algorithm>
+#include <iostream>
+#include <thread>
+
+using namespace std;
+
+namespace
+{
+  // the most severe of two return codes
+  int worse(const int a, const int b)
+  {
+    if (a == Fun4AllReturnCodes::ABORTRUN || b == Fun4AllReturnCodes::ABORTRUN) return Fun4AllReturnCodes::ABORTRUN;
+    if (a == Fun4AllReturnCodes::ABORTEVENT || b == Fun4AllReturnCodes::ABORTEVENT) return Fun4AllReturnCodes::ABORTEVENT;
+    return (a != Fun4AllReturnCodes::EVENT_OK) ? a : b;
+  }
+}  // namespace
+
+RawTowerBuilderGroup::RawTowerBuilderGroup(const std::string &name)
+  : SubsysReco(name)
+  , m_NThreads(1)
+{
+}
+
+RawTowerBuilderGroup::~RawTowerBuilderGroup()
+{
+  for (unsigned int i = 0; i < m_Builders.size(); ++i)
+  {
+    delete m_Builders[i].reco;
+  }
+}
+
+void RawTowerBuilderGroup::AddBuilder(RawTowerBuilder *builder)
+{
+  Builder entry;
+  entry.reco = builder;
+  entry.get_cells = [builder](PHCompositeNode *topNode) { return builder->GetCells(topNode); };
+  entry.build_towers = [builder]() { return builder->BuildTowers(); };
+  m_Builders.push_back(entry);
+}
+
+void RawTowerBuilderGroup::AddBuilder(HcalRawTowerBuilder *builder)
+{
+  Builder entry;
+  entry.reco = builder;
+  entry.get_cells = [builder](PHCompositeNode *topNode) { return builder->GetCells(topNode); };
+  entry.build_towers = [builder]() { return builder->BuildTowers(); };
+  m_Builders.push_back(entry);
+}
+
+int RawTowerBuilderGroup::Init(PHCompositeNode *topNode)
+{
+  int ret = Fun4AllReturnCodes::EVENT_OK;
+  for (unsigned int i = 0; i < m_Builders.size(); ++i)
+  {
+    ret = worse(ret, m_Builders[i].reco->Init(topNode));
+  }
+  return ret;
+}
+
+int RawTowerBuilderGroup::InitRun(PHCompositeNode *topNode)
+{
+  int ret = Fun4AllReturnCodes::EVENT_OK;
+  for (unsigned int i = 0; i < m_Builders.size(); ++i)
+  {
+    ret = worse(ret, m_Builders[i].reco->InitRun(topNode));
+  }
+  return ret;
+}
+
+int RawTowerBuilderGroup::End(PHCompositeNode *topNode)
+{
+  int ret = Fun4AllReturnCodes::EVENT_OK;
+  for (unsigned int i = 0; i < m_Builders.size(); ++i)
+  {
+    ret = worse(ret, m_Builders[i].reco->End(topNode));
+  }
+  return ret;
+}
+
+void RawTowerBuilderGroup::BuildTowers(const unsigned int first, const unsigned int last, std::vector<int> &rets)
+{
+  for (unsigned int i = first; i < last; ++i)
+  {
+    rets[i] = m_Builders[i].build_towers();
+  }
+}
+
+int RawTowerBuilderGroup::process_event(PHCompositeNode *topNode)
+{
+  const unsigned int nbuilders = m_Builders.size();
+  vector<int> rets(nbuilders, Fun4AllReturnCodes::EVENT_OK);
+
+  // node lookups, not thread safe
+  vector<unsigned int> active;
+  for (unsigned int i = 0; i < nbuilders; ++i)
+  {
+    rets[i] = m_Builders[i].get_cells(topNode);
+    if (rets[i] == Fun4AllReturnCodes::EVENT_OK)
+    {
+      active.push_back(i);
+    }
+  }
+  if (active.size() != nbuilders)
+  {
+    // same as running the builders one after the other, the event is aborted anyway
+    int ret = Fun4AllReturnCodes::EVENT_OK;
+    for (unsigned int i = 0; i < nbuilders; ++i)
+    {
+      ret = worse(ret, rets[i]);
+    }
+    return ret;
+  }
+
+  // contiguous blocks of calorimeters per thread
+  const unsigned int nthreads = max(1U, min(m_NThreads, nbuilders));
+  if (nthreads > 1)
+  {
+    vector<std::thread> threads;
+    for (unsigned int ithread = 1; ithread < nthreads; ++ithread)
+    {
+      threads.push_back(std::thread(&RawTowerBuilderGroup::BuildTowers, this,
+                                    ithread * nbuilders / nthreads, (ithread + 1) * nbuilders / nthreads, std::ref(rets)));
+    }
+    BuildTowers(0, nbuilders / nthreads, rets);
+    for (auto &thread : threads)
+    {
+      thread.join();
+    }
+  }
+  else
+  {
+    BuildTowers(0, nbuilders, rets);
+  }
+
+  int ret = Fun4AllReturnCodes::EVENT_OK;
+  for (unsigned int i = 0; i < nbuilders; ++i)
+  {
+    if (Verbosity() > 1 && rets[i] != Fun4AllReturnCodes::EVENT_OK)
+    {
+      cout << Name() << ": " << m_Builders[i].reco->Name() << " returned " << rets[i] << endl;
+    }
+    ret = worse(ret, rets[i]);
+  }
+  return ret;
+}
@@ -0,0 +1,58 @@
+#ifndef G4CALO_RAWTOWERBUILDERGROUP_H
+#define G4CALO_RAWTOWERBUILDERGROUP_H
+
+#include <fun4all/SubsysReco.h>
+
+#include <functional>
+#include <string>
+#include <vector>
+
+class HcalRawTowerBuilder;
+class PHCompositeNode;
+class RawTowerBuilder;
+
+/// \class RawTowerBuilderGroup
+///
+/// \brief Runs the tower builders of several calorimeters as one module
+///
+/// The builders added here are owned by the group and must not be
+/// registered with Fun4AllServer themselves. Init, InitRun and End are
+/// forwarded in the order the builders were added. In process_event the
+/// cell nodes of all builders are looked up first (the node tree is not
+/// thread safe), then the towers of the calorimeters are built on up to
+/// set_nthreads() threads, each builder only touches its own cells and
+/// towers.
+class RawTowerBuilderGroup : public SubsysReco
+{
+ public:
+  RawTowerBuilderGroup(const std::string &name = "RawTowerBuilderGroup");
+  virtual ~RawTowerBuilderGroup();
+
+  int Init(PHCompositeNode *topNode);
+  int InitRun(PHCompositeNode *topNode);
+  int process_event(PHCompositeNode *topNode);
+  int End(PHCompositeNode *topNode);
+
+  //! adds a builder, the group takes ownership
+  void AddBuilder(RawTowerBuilder *builder);
+  void AddBuilder(HcalRawTowerBuilder *builder);
+
+  //! number of threads building towers, default is 1 (no threads)
+  void set_nthreads(unsigned int nthreads) { m_NThreads = (nthreads > 0) ? nthreads : 1; }
+  unsigned int get_nthreads() const { return m_NThreads; }
+
+ private:
+  struct Builder
+  {
+    SubsysReco *reco;
+    std::function<int(PHCompositeNode *)> get_cells;
+    std::function<int()> build_towers;
+  };
+
+  void BuildTowers(const unsigned int first, const unsigned int last, std::vector<int> &rets);
+
+  std::vector<Builder> m_Builders;
+  unsigned int m_NThreads;
+};
+
+#endif
@@ -7,6 +7,7 @@
 #include <calobase/RawTowerGeom.h>
 #include <calobase/RawTowerGeomContainer.h>
 #include <calobase/RawTowerv1.h>
+#include <calobase/RawTowerv3.h>
 
 #include <fun4all/Fun4AllBase.h>  // for Fun4AllBase::VERBOSITY_MORE
 #include <fun4all/Fun4AllReturnCodes.h>
@@ -17,7 +18,7 @@
 #include <phool/PHNode.h>  // for PHNode
 #include <phool/PHNodeIterator.h>
 #include <phool/PHObject.h>  // for PHObject
-#include <phool/PHRandomSeed.h>
+#include <phool/PHCounterRng.h>
 #include <phool/getClass.h>
 
 #include <gsl/gsl_cdf.h>
@@ -34,6 +35,19 @@
 
 using namespace std;
 
+namespace
+{
+  // digitized copy in the class of the sim tower, compact towers stay compact
+  RawTower *copy_tower(const RawTower *sim_tower)
+  {
+    if (dynamic_cast<const RawTowerv3 *>(sim_tower))
+    {
+      return new RawTowerv3(*sim_tower);
+    }
+    return copy_tower(sim_tower);
+  }
+}  // namespace
+
 RawTowerDigitizer::RawTowerDigitizer(const std::string &name)
   : SubsysReco(name)
   , m_DigiAlgorithm(kNo_digitization)
@@ -52,21 +66,21 @@ RawTowerDigitizer::RawTowerDigitizer(const std::string &name)
   , m_TowerType(-1)
   , m_SiPMEffectivePixel(40000 * 4)  // sPHENIX EMCal default, 4x Hamamatsu S12572-015P MPPC [sPHENIX TDR]
 {
-  m_RandomGenerator = gsl_rng_alloc(gsl_rng_mt19937);
-  m_Seed = PHRandomSeed();  // fixed seed handled in PHRandomSeed()
-  // cout << Name() << " Random Seed: " << m_Seed << endl;
-  gsl_rng_set(m_RandomGenerator, m_Seed);
+  // 0: the stream is keyed by the master seed (fixed seed handled in PHRandomSeed())
+  m_Seed = 0;
+  m_Rng = new PHCounterRng(Name());
+  m_RandomGenerator = m_Rng->get_gsl_rng();
 }
 
 RawTowerDigitizer::~RawTowerDigitizer()
 {
-  gsl_rng_free(m_RandomGenerator);
+  delete m_Rng;
 }
 
 void RawTowerDigitizer::set_seed(const unsigned int iseed)
 {
   m_Seed = iseed;
-  gsl_rng_set(m_RandomGenerator, m_Seed);
+  m_Rng->Seed(m_Seed);
 }
 
 int RawTowerDigitizer::InitRun(PHCompositeNode *topNode)
@@ -92,6 +106,31 @@ int RawTowerDigitizer::InitRun(PHCompositeNode *topNode)
     cout << e.what() << endl;
     return Fun4AllReturnCodes::ABORTRUN;
   }
+
+  // the channels to digitize and the dead map do not change during a run
+  m_ChannelKeys.clear();
+  m_ChannelDead.clear();
+  m_ChannelKeys.reserve(m_RawTowerGeom->size());
+  m_ChannelDead.reserve(m_RawTowerGeom->size());
+
+  RawTowerGeomContainer::ConstRange all_towers = m_RawTowerGeom->get_tower_geometries();
+  for (RawTowerGeomContainer::ConstIterator it = all_towers.first;
+       it != all_towers.second; ++it)
+  {
+    if (m_TowerType >= 0)
+    {
+      // Skip towers that don't match the type we are supposed to digitize
+      if (m_TowerType != it->second->get_tower_type())
+      {
+        continue;
+      }
+    }
+
+    const RawTowerDefs::keytype key = it->second->get_id();
+    m_ChannelKeys.push_back(key);
+    m_ChannelDead.push_back(m_DeadMap && m_DeadMap->isDeadTower(key));
+  }
+
   return Fun4AllReturnCodes::EVENT_OK;
 }
 
@@ -115,37 +154,23 @@ int RawTowerDigitizer::process_event(PHCompositeNode *topNode)
   }
   // loop over all possible towers, even empty ones. The digitization can add towers containing
   // pedestals
-  RawTowerGeomContainer::ConstRange all_towers = m_RawTowerGeom->get_tower_geometries();
-
   double deadChanEnergy = 0;
 
-  for (RawTowerGeomContainer::ConstIterator it = all_towers.first;
-       it != all_towers.second; ++it)
+  for (unsigned int ichannel = 0; ichannel < m_ChannelKeys.size(); ++ichannel)
   {
-    const RawTowerDefs::keytype key = it->second->get_id();
-    if (m_TowerType >= 0)
-    {
-      // Skip towers that don't match the type we are supposed to digitize
-      if (m_TowerType != it->second->get_tower_type())
-      {
-        continue;
-      }
-    }
+    const RawTowerDefs::keytype key = m_ChannelKeys[ichannel];
 
     RawTower *sim_tower = m_SimTowers->getTower(key);
-    if (m_DeadMap)
+    if (m_ChannelDead[ichannel])
     {
-      if (m_DeadMap->isDeadTower(key))
-      {
-        if (sim_tower) deadChanEnergy += sim_tower->get_energy();
+      if (sim_tower) deadChanEnergy += sim_tower->get_energy();
 
-        sim_tower = nullptr;
+      sim_tower = nullptr;
 
-        if (Verbosity() >= VERBOSITY_MORE)
-        {
-          cout << Name() << "::" << m_Detector << "::" << __PRETTY_FUNCTION__
-               << " apply dead tower " << key << endl;
-        }
+      if (Verbosity() >= VERBOSITY_MORE)
+      {
+        cout << Name() << "::" << m_Detector << "::" << __PRETTY_FUNCTION__
+             << " apply dead tower " << key << endl;
       }
     }
 
@@ -156,7 +181,7 @@ int RawTowerDigitizer::process_event(PHCompositeNode *topNode)
       // for no digitization just copy existing towers
       if (sim_tower)
       {
-        digi_tower = new RawTowerv1(*sim_tower);
+        digi_tower = copy_tower(sim_tower);
       }
     }
     else if (m_DigiAlgorithm == kSimple_photon_digitization)
@@ -225,7 +250,7 @@ RawTowerDigitizer::simple_photon_digitization(RawTower *sim_tower)
     // create new digitalizaed tower
     if (sim_tower)
     {
-      digi_tower = new RawTowerv1(*sim_tower);
+      digi_tower = copy_tower(sim_tower);
     }
     else
     {
@@ -294,7 +319,7 @@ RawTowerDigitizer::sipm_photon_digitization(RawTower *sim_tower)
     // create new digitalizaed tower
     if (sim_tower)
     {
-      digi_tower = new RawTowerv1(*sim_tower);
+      digi_tower = copy_tower(sim_tower);
     }
     else
     {
@@ -1,11 +1,15 @@
 #ifndef G4CALO_RAWTOWERDIGITIZER_H
 #define G4CALO_RAWTOWERDIGITIZER_H
 
+#include <calobase/RawTowerDefs.h>
+
 #include <fun4all/SubsysReco.h>
 
 #include <string>
+#include <vector>
 
 class PHCompositeNode;
+class PHCounterRng;
 class RawTowerContainer;
 class RawTowerGeomContainer;
 class RawTowerDeadMap;
@@ -169,6 +173,10 @@ class RawTowerDigitizer : public SubsysReco
   RawTowerGeomContainer *m_RawTowerGeom;
   RawTowerDeadMap *m_DeadMap;
 
+  //! towers of m_TowerType in geometry order and their dead map status, built in InitRun
+  std::vector<RawTowerDefs::keytype> m_ChannelKeys;
+  std::vector<bool> m_ChannelDead;
+
   std::string m_Detector;
 
   std::string m_SimTowerNodePrefix;
@@ -198,6 +206,7 @@ class RawTowerDigitizer : public SubsysReco
   unsigned int m_SiPMEffectivePixel;
 
 #if !defined(__CINT__) || defined(__CLING__)
+  PHCounterRng *m_Rng;
   gsl_rng *m_RandomGenerator;
 #endif
 };
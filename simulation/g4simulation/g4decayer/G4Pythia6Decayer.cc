@@ -50,6 +50,7 @@
 #include <CLHEP/Vector/LorentzVector.h>
 
 #include <cstdlib>   // for abs
+#include <map>
 #include <iostream>  // for operator<<, basic_ostream:...
 #include <string>    // for operator<<
 
@@ -62,12 +63,9 @@ G4Pythia6Decayer::G4Pythia6Decayer()
   , fMessenger(this)
   , fVerboseLevel(0)
   , fDecayType(fgkDefaultDecayType)
-  , fDecayProductsArray(0)
 {
   /// Standard constructor
 
-  fDecayProductsArray = new ParticleVector();
-
   ForceDecay(fDecayType);
 }
 
@@ -76,8 +74,6 @@ G4Pythia6Decayer::G4Pythia6Decayer()
 G4Pythia6Decayer::~G4Pythia6Decayer()
 {
   /// Destructor
-
-  delete fDecayProductsArray;
 }
 
 //
@@ -91,12 +87,24 @@ G4ParticleDefinition* G4Pythia6Decayer::
 {
   /// Return G4 particle definition for given TParticle
 
-  // get particle definition from G4ParticleTable
+  // get particle definition from G4ParticleTable, the table does not
+  // change once the run started so the lookups are cached
   G4int pdgEncoding = particle->fKF;
-  G4ParticleTable* particleTable = G4ParticleTable::GetParticleTable();
   G4ParticleDefinition* particleDefinition = 0;
   if (pdgEncoding != 0)
-    particleDefinition = particleTable->FindParticle(pdgEncoding);
+  {
+    std::map<G4int, G4ParticleDefinition*>::const_iterator it =
+        fParticleDefinitions.find(pdgEncoding);
+    if (it != fParticleDefinitions.end())
+    {
+      particleDefinition = it->second;
+    }
+    else
+    {
+      particleDefinition = G4ParticleTable::GetParticleTable()->FindParticle(pdgEncoding);
+      fParticleDefinitions[pdgEncoding] = particleDefinition;
+    }
+  }
 
   if (particleDefinition == 0 && warn)
   {
@@ -157,6 +165,20 @@ G4ThreeVector G4Pythia6Decayer::GetParticleMomentum(
 
 //....oooOO0OOooo........oooOO0OOooo........oooOO0OOooo........oooOO0OOooo......
 
+G4int G4Pythia6Decayer::GetKC(G4int pdg)
+{
+  /// Return the Pythia6 compressed code of a PDG code
+
+  std::map<G4int, G4int>::const_iterator it = fKCCodes.find(pdg);
+  if (it != fKCCodes.end()) return it->second;
+
+  G4int kc = Pythia6::Instance()->Pycomp(pdg);
+  fKCCodes[pdg] = kc;
+  return kc;
+}
+
+//....oooOO0OOooo........oooOO0OOooo........oooOO0OOooo........oooOO0OOooo......
+
 G4int G4Pythia6Decayer::CountProducts(G4int channel, G4int particle)
 {
   /// Count number of decay products
@@ -176,7 +198,7 @@ void G4Pythia6Decayer::ForceParticleDecay(G4int particle, G4int product, G4int m
 
   Pythia6* pythia6 = Pythia6::Instance();
 
-  G4int kc = pythia6->Pycomp(particle);
+  G4int kc = GetKC(particle);
   pythia6->SetMDCY(kc, 1, 1);
 
   G4int ifirst = pythia6->GetMDCY(kc, 2);
@@ -206,7 +228,7 @@ void G4Pythia6Decayer::ForceParticleDecay(G4int particle, G4int* products,
 
   Pythia6* pythia6 = Pythia6::Instance();
 
-  G4int kc = pythia6->Pycomp(particle);
+  G4int kc = GetKC(particle);
   pythia6->SetMDCY(kc, 1, 1);
   G4int ifirst = pythia6->GetMDCY(kc, 2);
   G4int ilast = ifirst + pythia6->GetMDCY(kc, 3) - 1;
@@ -265,7 +287,7 @@ void G4Pythia6Decayer::ForceHadronicD()
   Pythia6* pythia6 = Pythia6::Instance();
   for (G4int ihadron = 0; ihadron < kNHadrons; ihadron++)
   {
-    G4int kc = pythia6->Pycomp(hadron[ihadron]);
+    G4int kc = GetKC(hadron[ihadron]);
     pythia6->SetMDCY(kc, 1, 1);
     G4int ifirst = pythia6->GetMDCY(kc, 2);
     G4int ilast = ifirst + pythia6->GetMDCY(kc, 3) - 1;
@@ -302,7 +324,7 @@ void G4Pythia6Decayer::ForceOmega()
   G4int iLambda0 = 3122;
   G4int iKMinus = -321;
 
-  G4int kc = pythia6->Pycomp(3334);
+  G4int kc = GetKC(3334);
   pythia6->SetMDCY(kc, 1, 1);
   G4int ifirst = pythia6->GetMDCY(kc, 2);
   G4int ilast = ifirst + pythia6->GetMDCY(kc, 3) - 1;
@@ -534,11 +556,11 @@ void G4Pythia6Decayer::Decay(G4int pdg, const CLHEP::HepLorentzVector& p)
 
 //....oooOO0OOooo........oooOO0OOooo........oooOO0OOooo........oooOO0OOooo......
 
-G4int G4Pythia6Decayer::ImportParticles(ParticleVector* particles)
+G4int G4Pythia6Decayer::ImportParticles(std::vector<Pythia6Particle>& particles)
 {
   /// Get the decay products into the passed PARTICLES vector
 
-  return Pythia6::Instance()->ImportParticles(particles, "All");
+  return Pythia6::Instance()->ImportParticles(particles);
 }
 
 //
@@ -571,7 +593,7 @@ G4DecayProducts* G4Pythia6Decayer::ImportDecayProducts(const G4Track& track)
   // let Pythia6Decayer decay the particle
   // and import the decay products
   Decay(pdgEncoding, p);
-  G4int nofParticles = ImportParticles(fDecayProductsArray);
+  G4int nofParticles = ImportParticles(fDecayProducts);
 
   if (fVerboseLevel > 0)
   {
@@ -586,7 +608,7 @@ G4DecayProducts* G4Pythia6Decayer::ImportDecayProducts(const G4Track& track)
   for (G4int i = 0; i < nofParticles; i++)
   {
     // get particle from ParticleVector
-    Pythia6Particle* particle = (*fDecayProductsArray)[i];
+    const Pythia6Particle* particle = &fDecayProducts[i];
 
     G4int status = particle->fKS;
     G4int pdg = particle->fKF;
@@ -40,6 +40,9 @@
 #include <Geant4/G4Types.hh>                    // for G4int, G4bool
 #include <Geant4/G4VExtDecayer.hh>
 
+#include <map>
+#include <vector>
+
 class G4DecayProducts;
 class G4DynamicParticle;
 class G4ParticleDefinition;
@@ -79,6 +82,7 @@ class G4Pythia6Decayer : public G4VExtDecayer
     G4ThreeVector GetParticlePosition(const Pythia6Particle* particle) const;
     G4ThreeVector GetParticleMomentum(const Pythia6Particle* particle) const; 
                            
+    G4int GetKC(G4int pdg);
     G4int CountProducts(G4int channel, G4int particle);
     void  ForceParticleDecay(G4int particle, G4int product, G4int mult);
     void  ForceParticleDecay(G4int particle, 
@@ -89,14 +93,19 @@ class G4Pythia6Decayer : public G4VExtDecayer
     
     
     void  Decay(G4int pdg, const CLHEP::HepLorentzVector& p);
-    G4int ImportParticles(ParticleVector* particles);
+    G4int ImportParticles(std::vector<Pythia6Particle>& particles);
     
     static const EDecayType fgkDefaultDecayType; ///< default decay type
 
     G4Pythia6DecayerMessenger fMessenger;  ///< command messenger 
     G4int            fVerboseLevel;        ///< verbose level
     EDecayType       fDecayType;           ///< selected decay type
-    ParticleVector*  fDecayProductsArray ; ///< array of decay products
+    std::vector<Pythia6Particle> fDecayProducts; ///< products of the last decay, reused
+
+    /// PDG code -> G4 particle definition, filled on first use
+    mutable std::map<G4int, G4ParticleDefinition*> fParticleDefinitions;
+    /// PDG code -> Pythia6 compressed code
+    std::map<G4int, G4int> fKCCodes;
 };
 
 // ----------------------------------------------------------------------------
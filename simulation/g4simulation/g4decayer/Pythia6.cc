@@ -289,3 +289,38 @@ int Pythia6::ImportParticles(ParticleVector* particles, const char* option)
 }
 
 //....oooOO0OOooo........oooOO0OOooo........oooOO0OOooo........oooOO0OOooo......
+
+int Pythia6::ImportParticles(std::vector<Pythia6Particle>& particles)
+{
+  ///  Same as the option "All" above, but the particles are stored by value.
+  ///  The vector keeps its capacity, so refilling it for every decay does
+  ///  not allocate.
+
+  particles.clear();
+
+  int numpart = fPyjets->N;
+  for (int i = 0; i < numpart; i++)
+  {
+    particles.push_back(
+        Pythia6Particle(
+            fPyjets->K[0][i],
+            fPyjets->K[1][i],
+            fPyjets->K[2][i],
+            fPyjets->K[3][i],
+            fPyjets->K[4][i],
+            fPyjets->P[0][i],
+            fPyjets->P[1][i],
+            fPyjets->P[2][i],
+            fPyjets->P[3][i],
+            fPyjets->P[4][i],
+            fPyjets->V[0][i],
+            fPyjets->V[1][i],
+            fPyjets->V[2][i],
+            fPyjets->V[3][i],
+            fPyjets->V[4][i]));
+  }
+
+  return numpart;
+}
+
+//....oooOO0OOooo........oooOO0OOooo........oooOO0OOooo........oooOO0OOooo......
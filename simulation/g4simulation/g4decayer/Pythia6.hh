@@ -176,6 +176,7 @@ class Pythia6
    void  Py1ent(int line, int kf, double pe, double theta, double phi);
    ParticleVector*  ImportParticles();
    int   ImportParticles(ParticleVector* particles, const char* option="");
+   int   ImportParticles(std::vector<Pythia6Particle>& particles);
 
    // ****** /PYDAT1/
    //
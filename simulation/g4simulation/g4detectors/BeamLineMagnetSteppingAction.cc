@@ -64,6 +64,12 @@ BeamLineMagnetSteppingAction::~BeamLineMagnetSteppingAction()
   delete m_Hit;
 }
 
+//____________________________________________________________________________..
+bool BeamLineMagnetSteppingAction::HandlesVolume(G4VPhysicalVolume* volume)
+{
+  return m_Detector->IsInBeamLineMagnet(volume) != 0;
+}
+
 //____________________________________________________________________________..
 bool BeamLineMagnetSteppingAction::UserSteppingAction(const G4Step* aStep, bool was_used)
 {
@@ -25,6 +25,9 @@ class BeamLineMagnetSteppingAction : public PHG4SteppingAction
   //! stepping action
   virtual bool UserSteppingAction(const G4Step*, bool);
 
+  //! only steps in our own volumes are dispatched to this stepping action
+  virtual bool HandlesVolume(G4VPhysicalVolume* volume);
+
   //! reimplemented from base class
   virtual void SetInterfacePointers(PHCompositeNode*);
 
@@ -66,6 +66,12 @@ PHG4BlockSteppingAction::~PHG4BlockSteppingAction()
   delete m_Hit;
 }
 
+//____________________________________________________________________________..
+bool PHG4BlockSteppingAction::HandlesVolume(G4VPhysicalVolume* volume)
+{
+  return m_Detector->IsInBlock(volume);
+}
+
 //____________________________________________________________________________..
 bool PHG4BlockSteppingAction::UserSteppingAction(const G4Step* aStep, bool)
 {
@@ -42,6 +42,7 @@
 
 #include <iostream>
 #include <string>                              // for basic_string, string
+#include <utility>                             // for pair, make_pair
 
 class PHCompositeNode;
 
@@ -95,7 +96,9 @@ bool PHG4CrystalCalorimeterSteppingAction::UserSteppingAction(const G4Step* aSte
   if (whichactive > 0)  // in crystal
   {
     /* Find indizes of crystal containing this step */
-    if (touch->GetVolume(2)->GetName().find("_j_") != string::npos)
+    int j_2, k_2;
+    ParseG4VolumeName(touch->GetVolume(2), j_2, k_2);
+    if (j_2 >= 0)  // the name of the volume 2 levels up has an _j_ index
       FindTowerIndex2LevelUp(touch, idx_j, idx_k);
     else
       FindTowerIndex(touch, idx_j, idx_k);
@@ -368,6 +371,16 @@ int PHG4CrystalCalorimeterSteppingAction::FindTowerIndex2LevelUp(G4TouchableHand
 
 int PHG4CrystalCalorimeterSteppingAction::ParseG4VolumeName(G4VPhysicalVolume* volume, int& j, int& k)
 {
+  // the names do not change, so every physical volume is parsed only once
+  map<const G4VPhysicalVolume*, pair<int, int> >::const_iterator cacheiter = m_VolumeIndexCache.find(volume);
+  if (cacheiter != m_VolumeIndexCache.end())
+  {
+    j = cacheiter->second.first;
+    k = cacheiter->second.second;
+    return 0;
+  }
+  j = -1;
+  k = -1;
   boost::char_separator<char> sep("_");
   boost::tokenizer<boost::char_separator<char> > tok(volume->GetName(), sep);
   boost::tokenizer<boost::char_separator<char> >::const_iterator tokeniter;
@@ -386,6 +399,7 @@ int PHG4CrystalCalorimeterSteppingAction::ParseG4VolumeName(G4VPhysicalVolume* v
       k = boost::lexical_cast<int>(*tokeniter);
     }
   }
+  m_VolumeIndexCache[volume] = make_pair(j, k);
 
   return 0;
 }
@@ -7,6 +7,9 @@
 
 #include <Geant4/G4TouchableHandle.hh>  // for G4TouchableHandle
 
+#include <map>
+#include <utility>
+
 class G4Step;
 class G4VPhysicalVolume;
 class PHCompositeNode;
@@ -37,6 +40,7 @@ class PHG4CrystalCalorimeterSteppingAction : public PHG4SteppingAction
   //! Find combined tower index of volume, mother volume, and mother+1 volume
   int FindTowerIndex2LevelUp(G4TouchableHandle touch, int& j, int& k);
 
+  //! j and k index from the volume name, -1 if the name has none
   int ParseG4VolumeName(G4VPhysicalVolume* volume, int& j, int& k);
 
   //! pointer to the detector
@@ -49,6 +53,9 @@ class PHG4CrystalCalorimeterSteppingAction : public PHG4SteppingAction
   PHG4HitContainer* savehitcontainer;
   PHG4Shower* saveshower;
 
+  //! parsed j and k index of every physical volume seen so far
+  std::map<const G4VPhysicalVolume*, std::pair<int, int> > m_VolumeIndexCache;
+
   //  int light_scint_model;
 };
 
@@ -27,25 +27,36 @@
 #include <phool/getClass.h>
 #include <phool/phool.h>  // for PHWHERE
 
+#include <boost/functional/hash.hpp>
+
+#include <algorithm>  // for min, max
+#include <atomic>
 #include <cmath>
 #include <cstdlib>
-#include <cstring>  // for memset
 #include <iostream>
-#include <iterator>  // for reverse_iterator
 #include <sstream>
+#include <thread>
 #include <vector>  // for vector
 
 using namespace std;
 
+namespace
+{
+  // largest phi x z (eta) segmentation of a layer which gets a dense cell array
+  const unsigned long kMaxDenseCells = 1UL << 20;
+}  // namespace
+
 PHG4CylinderCellReco::PHG4CylinderCellReco(const string &name)
   : SubsysReco(name)
   , PHParameterContainerInterface(name)
   , chkenergyconservation(0)
+  , m_NThreads(1)
+  , m_SegGeo(nullptr)
+  , m_GeomHash(0)
   , sum_energy_before_cuts(0.)
   , sum_energy_g4hit(0.)
 {
   SetDefaultParameters();
-  memset(nbins, 0, sizeof(nbins));
 }
 
 int PHG4CylinderCellReco::ResetEvent(PHCompositeNode *topNode)
@@ -133,9 +144,76 @@ int PHG4CylinderCellReco::InitRun(PHCompositeNode *topNode)
 
   UpdateParametersWithMacro();
 
+  // the cell geometry only depends on the parameters and the layer geometry,
+  // for multi run jobs it is only rebuilt if one of them changed
+  size_t geomhash = GeometryHash(geo);
+  if (seggeo == m_SegGeo && geomhash == m_GeomHash)
+  {
+    if (Verbosity() > 0)
+    {
+      cout << Name() << ": geometry unchanged (hash 0x" << hex << geomhash << dec
+           << "), reusing the cell geometry of the previous run" << endl;
+    }
+  }
+  else
+  {
+    BuildCellGeometry(geo, seggeo);
+    m_SegGeo = seggeo;
+    m_GeomHash = geomhash;
+  }
+
+  // print out settings
+  if (Verbosity() > 0)
+  {
+    cout << "===================== PHG4CylinderCellReco::InitRun() =====================" << endl;
+    cout << " " << outdetector << " Segmentation Description: " << endl;
+    int firstlayer = -1;
+    int lastlayer = -1;
+    for (unsigned int layer = 0; layer < m_Layers.size(); ++layer)
+    {
+      if (m_Layers[layer].binning != PHG4CellDefs::undefined)
+      {
+        if (firstlayer < 0)
+        {
+          firstlayer = layer;
+        }
+        lastlayer = layer;
+      }
+    }
+    for (unsigned int layer = 0; layer < m_Layers.size(); ++layer)
+    {
+      const LayerCells &layercells = m_Layers[layer];
+      if (layercells.binning == PHG4CellDefs::etaphibinning)
+      {
+        // phi & eta bin is usually used to make projective towers
+        // so just print the first layer
+        cout << " Layer #" << firstlayer << "-" << lastlayer << endl;
+        cout << "   Nbins (phi,eta): (" << layercells.nphibins << ", " << layercells.nzbins << ")" << endl;
+        cout << "   Cell Size (phi,eta): (" << layercells.cell_size[0] << " rad, " << layercells.cell_size[1] << " units)" << endl;
+        break;
+      }
+      else if (layercells.binning == PHG4CellDefs::sizebinning)
+      {
+        cout << " Layer #" << layer << endl;
+        cout << "   Nbins (phi,z): (" << layercells.nphibins << ", " << layercells.nzbins << ")" << endl;
+        cout << "   Cell Size (phi,z): (" << layercells.cell_size[0] << " cm, " << layercells.cell_size[1] << " cm)" << endl;
+      }
+    }
+    if (m_NThreads > 1)
+    {
+      cout << " processing the layers in " << m_NThreads << " threads" << endl;
+    }
+    cout << "===========================================================================" << endl;
+  }
+  string nodename = "G4CELLPARAM_" + GetParamsContainer()->Name();
+  SaveToNodeTree(RunDetNode, nodename);
+  return Fun4AllReturnCodes::EVENT_OK;
+}
+
+void PHG4CylinderCellReco::BuildCellGeometry(PHG4CylinderGeomContainer *geo, PHG4CylinderCellGeomContainer *seggeo)
+{
   map<int, PHG4CylinderGeom *>::const_iterator miter;
   pair<map<int, PHG4CylinderGeom *>::const_iterator, map<int, PHG4CylinderGeom *>::const_iterator> begin_end = geo->get_begin_end();
-  map<int, std::pair<double, double> >::iterator sizeiter;
   for (miter = begin_end.first; miter != begin_end.second; ++miter)
   {
     PHG4CylinderGeom *layergeom = miter->second;
@@ -146,30 +224,39 @@ int PHG4CylinderCellReco::InitRun(PHCompositeNode *topNode)
            << ", hits from this detid/layer will not be accumulated into cells" << endl;
       continue;
     }
-    implemented_detid.insert(layer);
+    if (layer < 0)
+    {
+      cout << Name() << ": negative detid/layer " << layer
+           << ", hits from this detid/layer will not be accumulated into cells" << endl;
+      continue;
+    }
+    LayerCells &layercells = GetLayer(layer);
+    if (layercells.binning != PHG4CellDefs::sizebinning && layercells.binning != PHG4CellDefs::etaphibinning)
+    {
+      cout << Name() << ": No cell size for detid/layer " << layer
+           << ", hits from this detid/layer will not be accumulated into cells" << endl;
+      continue;
+    }
+    layercells.implemented = true;
     set_size(layer, get_double_param(layer, "size_long"), get_double_param(layer, "size_perp"));
-    tmin_max.insert(std::make_pair(layer, std::make_pair(get_double_param(layer, "tmin"), get_double_param(layer, "tmax"))));
+    layercells.tmin = get_double_param(layer, "tmin");
+    layercells.tmax = get_double_param(layer, "tmax");
     double circumference = layergeom->get_radius() * 2 * M_PI;
     double length_in_z = layergeom->get_zmax() - layergeom->get_zmin();
-    sizeiter = cell_size.find(layer);
-    if (sizeiter == cell_size.end())
-    {
-      cout << "no cell sizes for layer " << layer << endl;
-      exit(1);
-    }
     // create geo object and fill with variables common to all binning methods
     PHG4CylinderCellGeom *layerseggeo = new PHG4CylinderCellGeom();
     layerseggeo->set_layer(layergeom->get_layer());
     layerseggeo->set_radius(layergeom->get_radius());
     layerseggeo->set_thickness(layergeom->get_thickness());
-    if (binning[layer] == PHG4CellDefs::etaphibinning)
+    if (layercells.binning == PHG4CellDefs::etaphibinning)
     {
       // calculate eta at radius+ thickness (outer radius)
       // length via eta coverage is calculated using the outer radius
       double etamin = PHG4Utils::get_eta(layergeom->get_radius() + layergeom->get_thickness(), layergeom->get_zmin());
       double etamax = PHG4Utils::get_eta(layergeom->get_radius() + layergeom->get_thickness(), layergeom->get_zmax());
-      zmin_max[layer] = make_pair(etamin, etamax);
-      double etastepsize = (sizeiter->second).first;
+      layercells.zmin_max[0] = etamin;
+      layercells.zmin_max[1] = etamax;
+      double etastepsize = layercells.cell_size[0];
       double d_etabins;
 // if the eta cell size is larger than the eta range, make one bin
       if (etastepsize > etamax - etamin)
@@ -188,7 +275,7 @@ int PHG4CylinderCellReco::InitRun(PHCompositeNode *topNode)
 	}
       }
       etastepsize = (etamax - etamin) / d_etabins;
-      (sizeiter->second).first = etastepsize;
+      layercells.cell_size[0] = etastepsize;
       int etabins = d_etabins;
       double etalow = etamin;
       double etahi = etalow + etastepsize;
@@ -203,7 +290,7 @@ int PHG4CylinderCellReco::InitRun(PHCompositeNode *topNode)
 
       double phimin = -M_PI;
       double phimax = M_PI;
-      double phistepsize = (sizeiter->second).second;
+      double phistepsize = layercells.cell_size[1];
       double d_phibins;
       if (phistepsize >= phimax-phimin)
       {
@@ -221,7 +308,7 @@ int PHG4CylinderCellReco::InitRun(PHCompositeNode *topNode)
 	}
       }
       phistepsize = (phimax - phimin) / d_phibins;
-      (sizeiter->second).second = phistepsize;
+      layercells.cell_size[1] = phistepsize;
       int phibins = d_phibins;
       double philow = phimin;
       double phihi = philow + phistepsize;
@@ -233,8 +320,8 @@ int PHG4CylinderCellReco::InitRun(PHCompositeNode *topNode)
         }
         phihi += phistepsize;
       }
-      pair<int, int> phi_z_bin = make_pair(phibins, etabins);
-      n_phi_z_bins[layer] = phi_z_bin;
+      layercells.nphibins = phibins;
+      layercells.nzbins = etabins;
       layerseggeo->set_binning(PHG4CellDefs::etaphibinning);
       layerseggeo->set_etabins(etabins);
       layerseggeo->set_etamin(etamin);
@@ -242,14 +329,15 @@ int PHG4CylinderCellReco::InitRun(PHCompositeNode *topNode)
       layerseggeo->set_phimin(phimin);
       layerseggeo->set_phibins(phibins);
       layerseggeo->set_phistep(phistepsize);
-      phistep[layer] = phistepsize;
-      etastep[layer] = etastepsize;
+      layercells.phistep = phistepsize;
     }
-    else if (binning[layer] == PHG4CellDefs::sizebinning)
+    else if (layercells.binning == PHG4CellDefs::sizebinning)
     {
-      zmin_max[layer] = make_pair(layergeom->get_zmin(), layergeom->get_zmax());
-      double size_z = (sizeiter->second).second;
-      double size_r = (sizeiter->second).first;
+      layercells.zmin_max[0] = layergeom->get_zmin();
+      layercells.zmin_max[1] = layergeom->get_zmax();
+      double size_z = layercells.cell_size[1];
+      double size_r = layercells.cell_size[0];
+      int nbins[2];
       double bins_r;
       // if the size is larger than circumference, make it one bin
       if (size_r >= circumference)
@@ -269,11 +357,11 @@ int PHG4CylinderCellReco::InitRun(PHCompositeNode *topNode)
       }
       nbins[0] = bins_r;
       size_r = circumference / bins_r;
-      (sizeiter->second).first = size_r;
+      layercells.cell_size[0] = size_r;
       double phistepsize = 2 * M_PI / bins_r;
       double phimin = -M_PI;
       double phimax = phimin + phistepsize;
-      phistep[layer] = phistepsize;
+      layercells.phistep = phistepsize;
       for (int i = 0; i < nbins[0]; i++)
       {
         if (phimax > (M_PI + 1e-9))
@@ -300,11 +388,11 @@ int PHG4CylinderCellReco::InitRun(PHCompositeNode *topNode)
 	}
       }
       nbins[1] = bins_r;
-      pair<int, int> phi_z_bin = make_pair(nbins[0], nbins[1]);
-      n_phi_z_bins[layer] = phi_z_bin;
+      layercells.nphibins = nbins[0];
+      layercells.nzbins = nbins[1];
       // update our map with the new sizes
       size_z = length_in_z / bins_r;
-      (sizeiter->second).second = size_z;
+      layercells.cell_size[1] = size_z;
       double zlow = layergeom->get_zmin();
       double zhigh = zlow + size_z;
       ;
@@ -326,45 +414,63 @@ int PHG4CylinderCellReco::InitRun(PHCompositeNode *topNode)
       layerseggeo->set_phibins(nbins[0]);
       layerseggeo->set_phistep(phistepsize);
     }
-    // add geo object filled by different binning methods
-    seggeo->AddLayerCellGeom(layerseggeo);
+    // add geo object filled by different binning methods, a layer which is
+    // already on the node tree (previous run) is updated in place
+    PHG4CylinderCellGeom *oldgeo = nullptr;
+    for (auto iter = seggeo->get_begin_end().first; iter != seggeo->get_begin_end().second; ++iter)
+    {
+      if (iter->first == layer)
+      {
+        oldgeo = iter->second;
+        break;
+      }
+    }
+    if (oldgeo)
+    {
+      *oldgeo = *layerseggeo;
+      delete layerseggeo;
+      layerseggeo = oldgeo;
+    }
+    else
+    {
+      seggeo->AddLayerCellGeom(layerseggeo);
+    }
+    layercells.geo = layerseggeo;
     if (Verbosity() > 1)
     {
       layerseggeo->identify();
     }
-  }
 
-  // print out settings
-  if (Verbosity() > 0)
-  {
-    cout << "===================== PHG4CylinderCellReco::InitRun() =====================" << endl;
-    cout << " " << outdetector << " Segmentation Description: " << endl;
-    for (std::map<int, int>::iterator iter = binning.begin();
-         iter != binning.end(); ++iter)
+    // the dense cell array is allocated once and reused for every event,
+    // very fine segmentations (silicon pixels) use a sparse map instead
+    const unsigned long ncells = static_cast<unsigned long>(layercells.nphibins) * layercells.nzbins;
+    if (ncells <= kMaxDenseCells)
     {
-      int layer = iter->first;
-
-      if (binning[layer] == PHG4CellDefs::etaphibinning)
-      {
-        // phi & eta bin is usually used to make projective towers
-        // so just print the first layer
-        cout << " Layer #" << binning.begin()->first << "-" << binning.rbegin()->first << endl;
-        cout << "   Nbins (phi,eta): (" << n_phi_z_bins[layer].first << ", " << n_phi_z_bins[layer].second << ")" << endl;
-        cout << "   Cell Size (phi,eta): (" << cell_size[layer].first << " rad, " << cell_size[layer].second << " units)" << endl;
-        break;
-      }
-      else if (binning[layer] == PHG4CellDefs::sizebinning)
-      {
-        cout << " Layer #" << layer << endl;
-        cout << "   Nbins (phi,z): (" << n_phi_z_bins[layer].first << ", " << n_phi_z_bins[layer].second << ")" << endl;
-        cout << "   Cell Size (phi,z): (" << cell_size[layer].first << " cm, " << cell_size[layer].second << " cm)" << endl;
-      }
+      layercells.cells.assign(ncells, nullptr);
     }
-    cout << "===========================================================================" << endl;
+    else
+    {
+      layercells.cells.clear();
+    }
+    layercells.fired.clear();
+    layercells.sparsecells.clear();
   }
-  string nodename = "G4CELLPARAM_" + GetParamsContainer()->Name();
-  SaveToNodeTree(RunDetNode, nodename);
-  return Fun4AllReturnCodes::EVENT_OK;
+  return;
+}
+
+size_t PHG4CylinderCellReco::GeometryHash(const PHG4CylinderGeomContainer *geo)
+{
+  size_t seed = GetParamsContainer()->get_hash();
+  pair<map<int, PHG4CylinderGeom *>::const_iterator, map<int, PHG4CylinderGeom *>::const_iterator> begin_end = geo->get_begin_end();
+  for (map<int, PHG4CylinderGeom *>::const_iterator miter = begin_end.first; miter != begin_end.second; ++miter)
+  {
+    boost::hash_combine(seed, miter->first);
+    boost::hash_combine(seed, miter->second->get_radius());
+    boost::hash_combine(seed, miter->second->get_thickness());
+    boost::hash_combine(seed, miter->second->get_zmin());
+    boost::hash_combine(seed, miter->second->get_zmax());
+  }
+  return seed;
 }
 
 int PHG4CylinderCellReco::process_event(PHCompositeNode *topNode)
@@ -382,517 +488,312 @@ int PHG4CylinderCellReco::process_event(PHCompositeNode *topNode)
     exit(1);
   }
 
-  PHG4CylinderCellGeomContainer *seggeo = findNode::getClass<PHG4CylinderCellGeomContainer>(topNode, seggeonodename.c_str());
-  if (!seggeo)
-  {
-    cout << "could not locate geo node " << seggeonodename << endl;
-    exit(1);
-  }
-
-  map<int, std::pair<double, double> >::iterator sizeiter;
-  PHG4HitContainer::LayerIter layer;
+  // only handle layers/detector ids which have parameters set
+  vector<int> layers;
+  vector<vector<PHG4Hit *> > layerhits;
   pair<PHG4HitContainer::LayerIter, PHG4HitContainer::LayerIter> layer_begin_end = g4hit->getLayers();
-  //   cout << "number of layers: " << g4hit->num_layers() << endl;
-  //   cout << "number of hits: " << g4hit->size() << endl;
-  //   for (layer = layer_begin_end.first; layer != layer_begin_end.second; layer++)
-  //     {
-  //       cout << "layer number: " << *layer << endl;
-  //     }
-  for (layer = layer_begin_end.first; layer != layer_begin_end.second; layer++)
+  for (PHG4HitContainer::LayerIter layer = layer_begin_end.first; layer != layer_begin_end.second; ++layer)
   {
-    // only handle layers/detector ids which have parameters set
-    if (implemented_detid.find(*layer) == implemented_detid.end())
+    if (*layer >= m_Layers.size() || !m_Layers[*layer].implemented)
     {
       continue;
     }
-    PHG4HitContainer::ConstIterator hiter;
-    PHG4HitContainer::ConstRange hit_begin_end = g4hit->getHits(*layer);
-    PHG4CylinderCellGeom *geo = seggeo->GetLayerCellGeom(*layer);
-    int nphibins = n_phi_z_bins[*layer].first;
-    int nzbins = n_phi_z_bins[*layer].second;
-
-    // ------- eta/phi binning ------------------------------------------------------------------------
-    if (binning[*layer] == PHG4CellDefs::etaphibinning)
+    LayerCells &layercells = m_Layers[*layer];
+    layers.push_back(*layer);
+    // ADC timing integration window, with pile up most hits are outside
+    layerhits.push_back(vector<PHG4Hit *>());
+    g4hit->getHits(*layer, layercells.tmin, layercells.tmax, layerhits.back());
+    // the cells sum up the hits in key order as without the window
+    sort(layerhits.back().begin(), layerhits.back().end(),
+         [](const PHG4Hit *a, const PHG4Hit *b) { return a->get_hit_id() < b->get_hit_id(); });
+    if (chkenergyconservation)
     {
-      for (hiter = hit_begin_end.first; hiter != hit_begin_end.second; hiter++)
+      PHG4HitContainer::ConstRange hit_begin_end = g4hit->getHits(*layer);
+      for (PHG4HitContainer::ConstIterator hiter = hit_begin_end.first; hiter != hit_begin_end.second; ++hiter)
       {
-        sum_energy_before_cuts += hiter->second->get_edep();
-        // checking ADC timing integration window cut
-        if (hiter->second->get_t(0) > tmin_max[*layer].second) continue;
-        if (hiter->second->get_t(1) < tmin_max[*layer].first) continue;
-
-        pair<double, double> etaphi[2];
-        double phibin[2];
-        double etabin[2];
-        for (int i = 0; i < 2; i++)
-        {
-          etaphi[i] = PHG4Utils::get_etaphi(hiter->second->get_x(i), hiter->second->get_y(i), hiter->second->get_z(i));
-          etabin[i] = geo->get_etabin(etaphi[i].first);
-          phibin[i] = geo->get_phibin(etaphi[i].second);
-        }
-        // check bin range
-        if (phibin[0] < 0 || phibin[0] >= nphibins || phibin[1] < 0 || phibin[1] >= nphibins)
-        {
-          continue;
-        }
-        if (etabin[0] < 0 || etabin[0] >= nzbins || etabin[1] < 0 || etabin[1] >= nzbins)
-        {
-          continue;
-        }
+        layercells.sum_energy_before_cuts += hiter->second->get_edep();
+      }
+    }
+  }
 
-        if (etabin[0] < 0)
-        {
-          if (Verbosity() > 0)
-          {
-            hiter->second->identify();
-          }
-          continue;
-        }
-        sum_energy_g4hit += hiter->second->get_edep();
-        int intphibin = phibin[0];
-        int intetabin = etabin[0];
-        int intphibinout = phibin[1];
-        int intetabinout = etabin[1];
-
-        // Determine all fired cells
-
-        double ax = (etaphi[0]).second;  // phi
-        double ay = (etaphi[0]).first;   // eta
-        double bx = (etaphi[1]).second;
-        double by = (etaphi[1]).first;
-        if (intphibin > intphibinout)
-        {
-          int tmp = intphibin;
-          intphibin = intphibinout;
-          intphibinout = tmp;
-        }
-        if (intetabin > intetabinout)
-        {
-          int tmp = intetabin;
-          intetabin = intetabinout;
-          intetabinout = tmp;
-        }
+  // the layers only read the hits and fill their own cells
+  atomic<unsigned int> next_layer(0);
+  auto run_layers = [&]() {
+    for (unsigned int ilayer = next_layer++; ilayer < layers.size(); ilayer = next_layer++)
+    {
+      ProcessLayer(layers[ilayer], layerhits[ilayer]);
+    }
+  };
 
-        double trklen = sqrt((ax - bx) * (ax - bx) + (ay - by) * (ay - by));
-        // if entry and exit hit are the same (seems to happen rarely), trklen = 0
-        // which leads to a 0/0 and an NaN in edep later on
-        // this code does for particles in the same cell a trklen/trklen (vdedx[ii]/trklen)
-        // so setting this to any non zero number will do just fine
-        // I just pick -1 here to flag those strange hits in case I want t oanalyze them
-        // later on
-        if (trklen == 0)
-        {
-          trklen = -1.;
-        }
-        vector<int> vphi;
-        vector<int> veta;
-        vector<double> vdedx;
+  vector<thread> threads;
+  for (unsigned int ithread = 1; ithread < m_NThreads && ithread < layers.size(); ++ithread)
+  {
+    threads.push_back(thread(run_layers));
+  }
 
-        if (intphibin == intphibinout && intetabin == intetabinout)  // single cell fired
-        {
-          if (Verbosity() > 0) cout << "SINGLE CELL FIRED: " << intphibin << " " << intetabin << endl;
-          vphi.push_back(intphibin);
-          veta.push_back(intetabin);
-          vdedx.push_back(trklen);
-        }
-        else
-        {
-          double phistep_half = geo->get_phistep() / 2.;
-          double etastep_half = geo->get_etastep() / 2.;
-          for (int ibp = intphibin; ibp <= intphibinout; ibp++)
-          {
-            double cx = geo->get_phicenter(ibp) - phistep_half;
-            double dx = geo->get_phicenter(ibp) + phistep_half;
-            for (int ibz = intetabin; ibz <= intetabinout; ibz++)
-            {
-              double cy = geo->get_etacenter(ibz) - etastep_half;
-              double dy = geo->get_etacenter(ibz) + etastep_half;
-
-              //cout << "##### line: " << ax << " " << ay << " " << bx << " " << by << endl;
-              //cout << "####### cell: " << cx << " " << cy << " " << dx << " " << dy << endl;
-              pair<bool, double> intersect = PHG4Utils::line_and_rectangle_intersect(ax, ay, bx, by, cx, cy, dx, dy);
-              if (intersect.first)
-              {
-                if (Verbosity() > 0) cout << "CELL FIRED: " << ibp << " " << ibz << " " << intersect.second << endl;
-                vphi.push_back(ibp);
-                veta.push_back(ibz);
-                vdedx.push_back(intersect.second);
-              }
-            }
-          }
-        }
-        if (Verbosity() > 0) cout << "NUMBER OF FIRED CELLS = " << vphi.size() << endl;
+  run_layers();
 
-        double tmpsum = 0.;
-        for (unsigned int ii = 0; ii < vphi.size(); ii++)
-        {
-          tmpsum += vdedx[ii];
-          vdedx[ii] = vdedx[ii] / trklen;
-          if (Verbosity() > 0) cout << "  CELL " << ii << "  dE/dX = " << vdedx[ii] << endl;
-        }
-        if (Verbosity() > 0) cout << "    TOTAL TRACK LENGTH = " << tmpsum << " " << trklen << endl;
+  for (unsigned int ithread = 0; ithread < threads.size(); ++ithread)
+  {
+    threads[ithread].join();
+  }
 
-        for (unsigned int i1 = 0; i1 < vphi.size(); i1++)  // loop over all fired cells
-        {
-          int iphibin = vphi[i1];
-          int ietabin = veta[i1];
-
-          // This is the key for cellptmap
-          // It is constructed using the phi and z (or eta) bin index values
-          // It will be unique for a given phi and z (or eta) bin combination
-          unsigned long long tmp = iphibin;
-          unsigned long long key = tmp << 32;
-          key += ietabin;
-          if (Verbosity() > 1)
-          {
-            cout << " iphibin " << iphibin << " ietabin " << ietabin << " key 0x" << hex << key << dec << endl;
-          }
-          PHG4Cell *cell = nullptr;
-          it = cellptmap.find(key);
-          if (it != cellptmap.end())
-          {
-            cell = it->second;
-          }
-          else
-          {
-            PHG4CellDefs::keytype cellkey = PHG4CellDefs::EtaPhiBinning::genkey(*layer, ietabin, iphibin);
-            cell = new PHG4Cellv1(cellkey);
-            cellptmap[key] = cell;
-          }
-          if (!isfinite(hiter->second->get_edep() * vdedx[i1]))
-          {
-            cout << "hit 0x" << hex << hiter->first << dec << " not finite, edep: "
-                 << hiter->second->get_edep() << " weight " << vdedx[i1] << endl;
-          }
-          cell->add_edep(hiter->first, hiter->second->get_edep() * vdedx[i1]);  // add hit with edep to g4hit list
-          cell->add_edep(hiter->second->get_edep() * vdedx[i1]);                // add edep to cell
-          if (hiter->second->has_property(PHG4Hit::prop_light_yield))
-          {
-            cell->add_light_yield(hiter->second->get_light_yield() * vdedx[i1]);
-          }
-          cell->add_shower_edep(hiter->second->get_shower_id(), hiter->second->get_edep() * vdedx[i1]);
-          // just a sanity check - we don't want to mess up by having Nan's or Infs in our energy deposition
-          if (!isfinite(hiter->second->get_edep() * vdedx[i1]))
-          {
-            cout << PHWHERE << " invalid energy dep " << hiter->second->get_edep()
-                 << " or path length: " << vdedx[i1] << endl;
-          }
-        }
-        vphi.clear();
-        veta.clear();
+  // move the cells to the node tree and reset the accumulators for the next event
+  for (unsigned int ilayer = 0; ilayer < layers.size(); ++ilayer)
+  {
+    LayerCells &layercells = m_Layers[layers[ilayer]];
+    sum_energy_before_cuts += layercells.sum_energy_before_cuts;
+    sum_energy_g4hit += layercells.sum_energy_g4hit;
+    layercells.sum_energy_before_cuts = 0.;
+    layercells.sum_energy_g4hit = 0.;
+    int numcells = 0;
+    // Assumes that memmory is freed by the cylinder cell container when it is destroyed
+    for (const unsigned int index : layercells.fired)
+    {
+      cells->AddCell(layercells.cells[index]);
+      layercells.cells[index] = nullptr;
+      numcells++;
+    }
+    layercells.fired.clear();
+    for (map<unsigned long long, PHG4Cell *>::const_iterator iter = layercells.sparsecells.begin(); iter != layercells.sparsecells.end(); ++iter)
+    {
+      cells->AddCell(iter->second);
+      numcells++;
+    }
+    layercells.sparsecells.clear();
+    if (Verbosity() > 0)
+    {
+      cout << Name() << ": found " << numcells << " cells with energy deposition in layer " << layers[ilayer] << endl;
+    }
+  }
 
-      }  // end loop over g4hits
+  if (chkenergyconservation)
+  {
+    CheckEnergy(topNode);
+  }
 
-      int numcells = 0;
+  return Fun4AllReturnCodes::EVENT_OK;
+}
 
-      for (it = cellptmap.begin(); it != cellptmap.end(); ++it)
+void PHG4CylinderCellReco::ProcessLayer(const int layer, const vector<PHG4Hit *> &hits)
+{
+  LayerCells &layercells = m_Layers[layer];
+  const PHG4CylinderCellGeom *geo = layercells.geo;
+  const bool etaphi = (layercells.binning == PHG4CellDefs::etaphibinning);
+  const int nphibins = layercells.nphibins;
+  const int nzbins = layercells.nzbins;
+  const double phistep_half = geo->get_phistep() / 2.;
+  const double zstep_half = (etaphi ? geo->get_etastep() : geo->get_zstep()) / 2.;
+
+  // fired cells of a hit, reused for all hits
+  vector<int> vphi;
+  vector<int> vz;
+  vector<double> vdedx;
+
+  for (const PHG4Hit *hit : hits)
+  {
+
+    // phi and z (eta) of entry and exit
+    double phi[2];
+    double z[2];
+    int phibin[2];
+    int zbin[2];
+    for (int i = 0; i < 2; i++)
+    {
+      if (etaphi)
       {
-        cells->AddCell(it->second);
-        numcells++;
-        if (Verbosity() > 1)
-        {
-          cout << "Adding cell in bin phi: " << PHG4CellDefs::EtaPhiBinning::get_phibin(it->second->get_cellid())
-               << " phi: " << geo->get_phicenter(PHG4CellDefs::EtaPhiBinning::get_phibin(it->second->get_cellid())) * 180. / M_PI
-               << ", eta bin: " << PHG4CellDefs::EtaPhiBinning::get_etabin(it->second->get_cellid())
-               << ", eta: " << geo->get_etacenter(PHG4CellDefs::EtaPhiBinning::get_etabin(it->second->get_cellid()))
-               << ", energy dep: " << it->second->get_edep()
-               << endl;
-        }
+        pair<double, double> etaphi_in_out = PHG4Utils::get_etaphi(hit->get_x(i), hit->get_y(i), hit->get_z(i));
+        z[i] = etaphi_in_out.first;
+        phi[i] = etaphi_in_out.second;
+        zbin[i] = geo->get_etabin(z[i]);
       }
-
-      if (Verbosity() > 0)
+      else
       {
-        cout << Name() << ": found " << numcells << " eta/phi cells with energy deposition" << endl;
+        phi[i] = atan2(hit->get_y(i), hit->get_x(i));
+        z[i] = hit->get_z(i);
+        zbin[i] = geo->get_zbin(z[i]);
       }
+      phibin[i] = geo->get_phibin(phi[i]);
     }
-
-    else  // ------ size binning ---------------------------------------------------------------
+    // check bin range
+    if (phibin[0] < 0 || phibin[0] >= nphibins || phibin[1] < 0 || phibin[1] >= nphibins)
     {
-      sizeiter = cell_size.find(*layer);
-      if (sizeiter == cell_size.end())
-      {
-        cout << "logical screwup!!! no sizes for layer " << *layer << endl;
-        exit(1);
-      }
-      double zstepsize = (sizeiter->second).second;
-      double phistepsize = phistep[*layer];
+      continue;
+    }
+    if (zbin[0] < 0 || zbin[0] >= nzbins || zbin[1] < 0 || zbin[1] >= nzbins)
+    {
+      continue;
+    }
+    layercells.sum_energy_g4hit += hit->get_edep();
+
+    int intphibin = min(phibin[0], phibin[1]);
+    int intphibinout = max(phibin[0], phibin[1]);
+    int intzbin = min(zbin[0], zbin[1]);
+    int intzbinout = max(zbin[0], zbin[1]);
+
+    // Determine all fired cells
+
+    double ax = phi[0];
+    double ay = z[0];
+    double bx = phi[1];
+    double by = z[1];
+
+    double trklen = sqrt((ax - bx) * (ax - bx) + (ay - by) * (ay - by));
+    // if entry and exit hit are the same (seems to happen rarely), trklen = 0
+    // which leads to a 0/0 and an NaN in edep later on
+    // this code does for particles in the same cell a trklen/trklen (vdedx[ii]/trklen)
+    // so setting this to any non zero number will do just fine
+    // I just pick -1 here to flag those strange hits in case I want to analyze them
+    // later on
+    if (trklen == 0)
+    {
+      trklen = -1.;
+    }
+    vphi.clear();
+    vz.clear();
+    vdedx.clear();
 
-      for (hiter = hit_begin_end.first; hiter != hit_begin_end.second; hiter++)
+    if (intphibin == intphibinout && intzbin == intzbinout)  // single cell fired
+    {
+      if (Verbosity() > 0) cout << "SINGLE CELL FIRED: " << intphibin << " " << intzbin << endl;
+      vphi.push_back(intphibin);
+      vz.push_back(intzbin);
+      vdedx.push_back(trklen);
+    }
+    else
+    {
+      for (int ibp = intphibin; ibp <= intphibinout; ibp++)
       {
-        sum_energy_before_cuts += hiter->second->get_edep();
-        // checking ADC timing integration window cut
-        if (hiter->second->get_t(0) > tmin_max[*layer].second) continue;
-        if (hiter->second->get_t(1) < tmin_max[*layer].first) continue;
-
-        double xinout[2];
-        double yinout[2];
-        double px[2];
-        double py[2];
-        double phi[2];
-        double z[2];
-        double phibin[2];
-        double zbin[2];
-        if (Verbosity() > 0) cout << "--------- new hit in layer # " << *layer << endl;
-
-        for (int i = 0; i < 2; i++)
-        {
-          xinout[i] = hiter->second->get_x(i);
-          yinout[i] = hiter->second->get_y(i);
-          px[i] = hiter->second->get_px(i);
-          py[i] = hiter->second->get_py(i);
-          phi[i] = atan2(hiter->second->get_y(i), hiter->second->get_x(i));
-          z[i] = hiter->second->get_z(i);
-          phibin[i] = geo->get_phibin(phi[i]);
-          zbin[i] = geo->get_zbin(hiter->second->get_z(i));
-
-          if (Verbosity() > 0) cout << " " << i << "  phibin: " << phibin[i] << ", phi: " << phi[i] << ", stepsize: " << phistepsize << endl;
-          if (Verbosity() > 0) cout << " " << i << "  zbin: " << zbin[i] << ", z = " << hiter->second->get_z(i) << ", stepsize: " << zstepsize << " offset: " << zmin_max[*layer].first << endl;
-        }
-        // check bin range
-        if (phibin[0] < 0 || phibin[0] >= nphibins || phibin[1] < 0 || phibin[1] >= nphibins)
-        {
-          continue;
-        }
-        if (zbin[0] < 0 || zbin[0] >= nzbins || zbin[1] < 0 || zbin[1] >= nzbins)
-        {
-          continue;
-        }
-
-        if (zbin[0] < 0)
-        {
-          hiter->second->identify();
-          continue;
-        }
-        sum_energy_g4hit += hiter->second->get_edep();
-
-        int intphibin = phibin[0];
-        int intzbin = zbin[0];
-        int intphibinout = phibin[1];
-        int intzbinout = zbin[1];
-
-        if (Verbosity() > 0)
-        {
-          cout << "    phi bin range: " << intphibin << " to " << intphibinout << " phi: " << phi[0] << " to " << phi[1] << endl;
-          cout << "    Z bin range: " << intzbin << " to " << intzbinout << " Z: " << z[0] << " to " << z[1] << endl;
-          cout << "    phi difference: " << (phi[1] - phi[0]) * 1000. << " milliradians." << endl;
-          cout << "    phi difference: " << 2.5 * (phi[1] - phi[0]) * 10000. << " microns." << endl;
-          cout << "    path length = " << sqrt((xinout[1] - xinout[0]) * (xinout[1] - xinout[0]) + (yinout[1] - yinout[0]) * (yinout[1] - yinout[0])) << endl;
-          cout << "       px = " << px[0] << " " << px[1] << endl;
-          cout << "       py = " << py[0] << " " << py[1] << endl;
-          cout << "       x = " << xinout[0] << " " << xinout[1] << endl;
-          cout << "       y = " << yinout[0] << " " << yinout[1] << endl;
-        }
-
-        // Determine all fired cells
-
-        double ax = phi[0];
-        double ay = z[0];
-        double bx = phi[1];
-        double by = z[1];
-        if (intphibin > intphibinout)
-        {
-          int tmp = intphibin;
-          intphibin = intphibinout;
-          intphibinout = tmp;
-        }
-        if (intzbin > intzbinout)
-        {
-          int tmp = intzbin;
-          intzbin = intzbinout;
-          intzbinout = tmp;
-        }
-
-        double trklen = sqrt((ax - bx) * (ax - bx) + (ay - by) * (ay - by));
-        // if entry and exit hit are the same (seems to happen rarely), trklen = 0
-        // which leads to a 0/0 and an NaN in edep later on
-        // this code does for particles in the same cell a trklen/trklen (vdedx[ii]/trklen)
-        // so setting this to any non zero number will do just fine
-        // I just pick -1 here to flag those strange hits in case I want to analyze them
-        // later on
-        if (trklen == 0)
-        {
-          trklen = -1.;
-        }
-        vector<int> vphi;
-        vector<int> vz;
-        vector<double> vdedx;
-
-        if (intphibin == intphibinout && intzbin == intzbinout)  // single cell fired
-        {
-          if (Verbosity() > 0)
-          {
-            cout << "SINGLE CELL FIRED: " << intphibin << " " << intzbin << endl;
-          }
-          vphi.push_back(intphibin);
-          vz.push_back(intzbin);
-          vdedx.push_back(trklen);
-        }
-        else
+        double cx = geo->get_phicenter(ibp) - phistep_half;
+        double dx = geo->get_phicenter(ibp) + phistep_half;
+        for (int ibz = intzbin; ibz <= intzbinout; ibz++)
         {
-          double phistep_half = geo->get_phistep() / 2.;
-          double zstep_half = geo->get_zstep() / 2.;
-          for (int ibp = intphibin; ibp <= intphibinout; ibp++)
+          double zcenter = (etaphi ? geo->get_etacenter(ibz) : geo->get_zcenter(ibz));
+          double cy = zcenter - zstep_half;
+          double dy = zcenter + zstep_half;
+          pair<bool, double> intersect = PHG4Utils::line_and_rectangle_intersect(ax, ay, bx, by, cx, cy, dx, dy);
+          if (intersect.first)
           {
-            double cx = geo->get_phicenter(ibp) - phistep_half;
-            double dx = geo->get_phicenter(ibp) + phistep_half;
-            for (int ibz = intzbin; ibz <= intzbinout; ibz++)
-            {
-              double cy = geo->get_zcenter(ibz) - zstep_half;
-              double dy = geo->get_zcenter(ibz) + zstep_half;
-              //cout << "##### line: " << ax << " " << ay << " " << bx << " " << by << endl;
-              //cout << "####### cell: " << cx << " " << cy << " " << dx << " " << dy << endl;
-              pair<bool, double> intersect = PHG4Utils::line_and_rectangle_intersect(ax, ay, bx, by, cx, cy, dx, dy);
-              if (intersect.first)
-              {
-                if (Verbosity() > 0) cout << "CELL FIRED: " << ibp << " " << ibz << " " << intersect.second << endl;
-                vphi.push_back(ibp);
-                vz.push_back(ibz);
-                vdedx.push_back(intersect.second);
-              }
-            }
+            if (Verbosity() > 0) cout << "CELL FIRED: " << ibp << " " << ibz << " " << intersect.second << endl;
+            vphi.push_back(ibp);
+            vz.push_back(ibz);
+            vdedx.push_back(intersect.second);
           }
         }
-        if (Verbosity() > 0) cout << "NUMBER OF FIRED CELLS = " << vz.size() << endl;
-
-        double tmpsum = 0.;
-        for (unsigned int ii = 0; ii < vz.size(); ii++)
-        {
-          tmpsum += vdedx[ii];
-          vdedx[ii] = vdedx[ii] / trklen;
-          if (Verbosity() > 0) cout << "  CELL " << ii << "  dE/dX = " << vdedx[ii] << endl;
-        }
-        if (Verbosity() > 0) cout << "    TOTAL TRACK LENGTH = " << tmpsum << " " << trklen << endl;
-
-        for (unsigned int i1 = 0; i1 < vphi.size(); i1++)  // loop over all fired cells
-        {
-          int iphibin = vphi[i1];
-          int izbin = vz[i1];
-
-          unsigned long long tmp = iphibin;
-          unsigned long long key = tmp << 32;
-          key += izbin;
-          if (Verbosity() > 1)
-          {
-            cout << " iphibin " << iphibin << " izbin " << izbin << " key 0x" << hex << key << dec << endl;
-          }
-          // check to see if there is already an entry for this cell
-          PHG4Cell *cell = nullptr;
-          it = cellptmap.find(key);
-
-          if (it != cellptmap.end())
-          {
-            cell = it->second;
-            if (Verbosity() > 1)
-            {
-              cout << "  add energy to existing cell for key = " << cellptmap.find(key)->first << endl;
-            }
-
-            if (Verbosity() > 1 && hiter->second->has_property(PHG4Hit::prop_light_yield) && std::isnan(hiter->second->get_light_yield() * vdedx[i1]))
-            {
-              cout << "    NAN lighy yield with vdedx[i1] = " << vdedx[i1]
-                   << " and hiter->second->get_light_yield() = " << hiter->second->get_light_yield() << endl;
-            }
-          }
-          else
-          {
-            if (Verbosity() > 1)
-            {
-              cout << "    did not find a previous entry for key = 0x" << hex << key << dec << " create a new one" << endl;
-            }
-            PHG4CellDefs::keytype cellkey = PHG4CellDefs::SizeBinning::genkey(*layer, izbin, iphibin);
-            cell = new PHG4Cellv1(cellkey);
-            cellptmap[key] = cell;
-          }
-          if (!isfinite(hiter->second->get_edep() * vdedx[i1]))
-          {
-            cout << "hit 0x" << hex << hiter->first << dec << " not finite, edep: "
-                 << hiter->second->get_edep() << " weight " << vdedx[i1] << endl;
-          }
-          cell->add_edep(hiter->first, hiter->second->get_edep() * vdedx[i1]);
-          cell->add_edep(hiter->second->get_edep() * vdedx[i1]);  // add edep to cell
-          if (hiter->second->has_property(PHG4Hit::prop_light_yield))
-          {
-            cell->add_light_yield(hiter->second->get_light_yield() * vdedx[i1]);
-            if (Verbosity() > 1 && !std::isfinite(hiter->second->get_light_yield() * vdedx[i1]))
-            {
-              cout << "    NAN lighy yield with vdedx[i1] = " << vdedx[i1]
-                   << " and hiter->second->get_light_yield() = " << hiter->second->get_light_yield() << endl;
-            }
-          }
-          cell->add_shower_edep(hiter->second->get_shower_id(), hiter->second->get_edep() * vdedx[i1]);
-        }
-        vphi.clear();
-        vz.clear();
-
-      }  // end loop over hits
+      }
+    }
+    if (Verbosity() > 0) cout << "NUMBER OF FIRED CELLS = " << vphi.size() << endl;
 
-      int numcells = 0;
+    for (unsigned int ii = 0; ii < vphi.size(); ii++)
+    {
+      vdedx[ii] = vdedx[ii] / trklen;
+    }
 
-      for (it = cellptmap.begin(); it != cellptmap.end(); ++it)
+    for (unsigned int i1 = 0; i1 < vphi.size(); i1++)  // loop over all fired cells
+    {
+      PHG4Cell *cell = GetCell(layercells, layer, vphi[i1], vz[i1]);
+      const double edep = hit->get_edep() * vdedx[i1];
+      // just a sanity check - we don't want to mess up by having Nan's or Infs in our energy deposition
+      if (!isfinite(edep))
       {
-        cells->AddCell(it->second);
-        numcells++;
-        if (Verbosity() > 1)
-        {
-          cout << "Adding cell for key " << hex << it->first << dec << " in bin phi: " << PHG4CellDefs::SizeBinning::get_phibin(it->second->get_cellid())
-               << " phi: " << geo->get_phicenter(PHG4CellDefs::SizeBinning::get_phibin(it->second->get_cellid())) * 180. / M_PI
-               << ", z bin: " << PHG4CellDefs::SizeBinning::get_zbin(it->second->get_cellid())
-               << ", z: " << geo->get_zcenter(PHG4CellDefs::SizeBinning::get_zbin(it->second->get_cellid()))
-               << ", energy dep: " << it->second->get_edep()
-               << endl;
-        }
+        cout << "hit 0x" << hex << hit->get_hit_id() << dec << " not finite, edep: "
+             << hit->get_edep() << " weight " << vdedx[i1] << endl;
       }
-
-      if (Verbosity() > 0)
+      cell->add_edep(hit->get_hit_id(), edep);  // add hit with edep to g4hit list
+      cell->add_edep(edep);                // add edep to cell
+      if (hit->has_property(PHG4Hit::prop_light_yield))
       {
-        cout << "found " << numcells << " z/phi cells with energy deposition" << endl;
+        cell->add_light_yield(hit->get_light_yield() * vdedx[i1]);
       }
+      cell->add_shower_edep(hit->get_shower_id(), edep);
     }
+  }  // end loop over g4hits
+}
 
-    //==========================================================
-    // now reset the cell map before moving on to the next layer
-    if (Verbosity() > 1)
-    {
-      cout << "cellptmap for layer " << *layer << " has final length " << cellptmap.size();
-    }
-    while (cellptmap.begin() != cellptmap.end())
-    {
-      // Assumes that memmory is freed by the cylinder cell container when it is destroyed
-      cellptmap.erase(cellptmap.begin());
-    }
-    if (Verbosity() > 1)
+PHG4Cell *PHG4CylinderCellReco::GetCell(LayerCells &layercells, const int layer, const int iphibin, const int izbin)
+{
+  PHG4Cell **cell = nullptr;
+  if (!layercells.cells.empty())
+  {
+    const unsigned int index = iphibin * layercells.nzbins + izbin;
+    cell = &layercells.cells[index];
+    if (!*cell)
     {
-      cout << " reset it to " << cellptmap.size() << endl;
+      layercells.fired.push_back(index);
     }
   }
-  if (chkenergyconservation)
+  else
   {
-    CheckEnergy(topNode);
+    // It is constructed using the phi and z (or eta) bin index values
+    // It will be unique for a given phi and z (or eta) bin combination
+    unsigned long long tmp = iphibin;
+    unsigned long long key = tmp << 32;
+    key += izbin;
+    cell = &layercells.sparsecells[key];
+  }
+  if (!*cell)
+  {
+    PHG4CellDefs::keytype cellkey = (layercells.binning == PHG4CellDefs::etaphibinning) ? PHG4CellDefs::EtaPhiBinning::genkey(layer, izbin, iphibin) : PHG4CellDefs::SizeBinning::genkey(layer, izbin, iphibin);
+    *cell = new PHG4Cellv1(cellkey);
   }
+  return *cell;
+}
 
-  return Fun4AllReturnCodes::EVENT_OK;
+PHG4CylinderCellReco::LayerCells &PHG4CylinderCellReco::GetLayer(const int layer)
+{
+  if (layer >= static_cast<int>(m_Layers.size()))
+  {
+    m_Layers.resize(layer + 1);
+  }
+  return m_Layers[layer];
+}
+
+PHG4CylinderCellReco::LayerCells::LayerCells()
+  : binning(PHG4CellDefs::undefined)
+  , implemented(false)
+  , phistep(NAN)
+  , nphibins(0)
+  , nzbins(0)
+  , tmin(NAN)
+  , tmax(NAN)
+  , geo(nullptr)
+  , sum_energy_before_cuts(0.)
+  , sum_energy_g4hit(0.)
+{
+  cell_size[0] = cell_size[1] = NAN;
+  zmin_max[0] = zmin_max[1] = NAN;
 }
 
 void PHG4CylinderCellReco::cellsize(const int detid, const double sr, const double sz)
 {
-  if (binning.find(detid) != binning.end())
+  if (detid < 0)
+  {
+    cout << "invalid layer " << detid << endl;
+    return;
+  }
+  if (GetLayer(detid).binning != PHG4CellDefs::undefined)
   {
     cout << "size for layer " << detid << " already set" << endl;
     return;
   }
-  binning[detid] = PHG4CellDefs::sizebinning;
+  GetLayer(detid).binning = PHG4CellDefs::sizebinning;
   set_double_param(detid, "size_long", sz);
   set_double_param(detid, "size_perp", sr);
 }
 
 void PHG4CylinderCellReco::etaphisize(const int detid, const double deltaeta, const double deltaphi)
 {
-  if (binning.find(detid) != binning.end())
+  if (detid < 0)
+  {
+    cout << "invalid layer " << detid << endl;
+    return;
+  }
+  if (GetLayer(detid).binning != PHG4CellDefs::undefined)
   {
     cout << "size for layer " << detid << " already set" << endl;
     return;
   }
-  binning[detid] = PHG4CellDefs::etaphibinning;
+  GetLayer(detid).binning = PHG4CellDefs::etaphibinning;
   set_double_param(detid, "size_long", deltaeta);
   set_double_param(detid, "size_perp", deltaphi);
   return;
@@ -900,10 +801,30 @@ void PHG4CylinderCellReco::etaphisize(const int detid, const double deltaeta, co
 
 void PHG4CylinderCellReco::set_size(const int i, const double sizeA, const double sizeB)
 {
-  cell_size[i] = std::make_pair(sizeA, sizeB);
+  LayerCells &layercells = GetLayer(i);
+  layercells.cell_size[0] = sizeA;
+  layercells.cell_size[1] = sizeB;
   return;
 }
 
+double PHG4CylinderCellReco::get_timing_window_min(const int i)
+{
+  if (i < 0 || i >= static_cast<int>(m_Layers.size()))
+  {
+    return NAN;
+  }
+  return m_Layers[i].tmin;
+}
+
+double PHG4CylinderCellReco::get_timing_window_max(const int i)
+{
+  if (i < 0 || i >= static_cast<int>(m_Layers.size()))
+  {
+    return NAN;
+  }
+  return m_Layers[i].tmax;
+}
+
 void PHG4CylinderCellReco::set_timing_window(const int detid, const double tmin, const double tmax)
 {
   set_double_param(detid, "tmin", tmin);
@@ -5,15 +5,20 @@
 
 #include <phparameter/PHParameterContainerInterface.h>
 
+#include <g4main/PHG4HitContainer.h>
+
 #include <fun4all/SubsysReco.h>
 
+#include <cstddef>
 #include <map>
-#include <set>
 #include <string>
-#include <utility>  // for pair
+#include <vector>
 
 class PHCompositeNode;
 class PHG4Cell;
+class PHG4CylinderCellGeom;
+class PHG4CylinderCellGeomContainer;
+class PHG4CylinderGeomContainer;
 
 class PHG4CylinderCellReco : public SubsysReco, public PHParameterContainerInterface
 {
@@ -38,33 +43,71 @@ class PHG4CylinderCellReco : public SubsysReco, public PHParameterContainerInter
   void checkenergy(const int i = 1) { chkenergyconservation = i; }
   void OutputDetector(const std::string &d) { outdetector = d; }
 
-  double get_timing_window_min(const int i) { return tmin_max[i].first; }
-  double get_timing_window_max(const int i) { return tmin_max[i].second; }
+  double get_timing_window_min(const int i);
+  double get_timing_window_max(const int i);
   void set_timing_window(const int detid, const double tmin, const double tmax);
 
+  //! the layers are independent, process them in nthreads threads
+  void set_nthreads(const unsigned int nthreads) { m_NThreads = (nthreads > 0 ? nthreads : 1); }
+
  protected:
+  //! configuration and cell accumulator of one layer
+  struct LayerCells
+  {
+    LayerCells();
+
+    int binning;  // PHG4CellDefs binning, undefined if the layer has no cells
+    bool implemented;
+    double cell_size[2];  // cell size in phi/z
+    double zmin_max[2];   // zmin/zmax (etamin/etamax)
+    double phistep;
+    int nphibins;
+    int nzbins;
+    double tmin;
+    double tmax;
+    PHG4CylinderCellGeom *geo;
+
+    //! cells of this event by phibin * nzbins + zbin, empty if the layer is too
+    //! finely segmented, then sparsecells is used. Reused for every event
+    std::vector<PHG4Cell *> cells;
+    std::vector<unsigned int> fired;
+    std::map<unsigned long long, PHG4Cell *> sparsecells;
+
+    double sum_energy_before_cuts;
+    double sum_energy_g4hit;
+  };
+
+  //! configuration of a layer, created on first use
+  LayerCells &GetLayer(const int layer);
+
+  //! accumulate the hits of one layer inside its timing window into its cells
+  void ProcessLayer(const int layer, const std::vector<PHG4Hit *> &hits);
+
+  //! cell of a phi/z (eta) bin, created on first use in this event
+  PHG4Cell *GetCell(LayerCells &layercells, const int layer, const int iphibin, const int izbin);
+
   void set_size(const int i, const double sizeA, const double sizeB);
+  //! creates (or updates) the cell geometry of all layers from the layer geometry
+  void BuildCellGeometry(PHG4CylinderGeomContainer *geo, PHG4CylinderCellGeomContainer *seggeo);
+  //! hash of the parameters and the layer geometry the cell geometry is built from
+  size_t GeometryHash(const PHG4CylinderGeomContainer *geo);
   int CheckEnergy(PHCompositeNode *topNode);
 
-  std::map<int, int> binning;
-  std::map<int, std::pair<double, double> > cell_size;  // cell size in phi/z
-  std::map<int, std::pair<double, double> > zmin_max;   // zmin/zmax for each layer for faster lookup
-  std::map<int, double> phistep;
-  std::map<int, double> etastep;
-  std::set<int> implemented_detid;
+  //! per layer configuration, indexed by layer
+  std::vector<LayerCells> m_Layers;
   std::string detector;
   std::string outdetector;
   std::string hitnodename;
   std::string cellnodename;
   std::string geonodename;
   std::string seggeonodename;
-  std::map<int, std::pair<int, int> > n_phi_z_bins;
-  std::map<unsigned long long, PHG4Cell *> cellptmap;  // This map holds the hit cells
-  std::map<unsigned long long, PHG4Cell *>::iterator it;
-  std::map<int, std::pair<double, double> > tmin_max;
 
-  int nbins[2];
   int chkenergyconservation;
+  unsigned int m_NThreads;
+
+  //! cell geometry node and geometry hash of the previous run
+  PHG4CylinderCellGeomContainer *m_SegGeo;
+  size_t m_GeomHash;
 
   double sum_energy_before_cuts;
   double sum_energy_g4hit;
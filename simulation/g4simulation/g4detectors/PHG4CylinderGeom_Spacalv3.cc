@@ -39,6 +39,29 @@ PHG4CylinderGeom_Spacalv3::~PHG4CylinderGeom_Spacalv3()
   sector_tower_map.erase(sector_tower_map.begin(), sector_tower_map.end());
 }
 
+const PHG4CylinderGeom_Spacalv3::geom_tower*
+PHG4CylinderGeom_Spacalv3::get_tower(const int tower_ID) const
+{
+  if (tower_table.empty() and not sector_tower_map.empty())
+    {
+      // tower IDs are bounded by scint_id_coder::ktower_bit, the map is ordered
+      tower_table.resize(sector_tower_map.rbegin()->first + 1);
+      for (tower_map_t::const_iterator it = sector_tower_map.begin();
+          it != sector_tower_map.end(); ++it)
+        {
+          if (it->first >= 0)
+            tower_table[it->first] = it->second;
+        }
+    }
+
+  if (tower_ID < 0 or tower_ID >= (int) tower_table.size())
+    return nullptr;
+  const geom_tower & tower = tower_table[tower_ID];
+  if (tower.id != tower_ID)
+    return nullptr;
+  return &tower;
+}
+
 void
 PHG4CylinderGeom_Spacalv3::identify(std::ostream& os) const
 {
@@ -130,6 +153,7 @@ PHG4CylinderGeom_Spacalv3::ImportParameters(const PHParameters & param)
   if (param.exist_int_param("sector_tower_map_size"))
     {
       sector_tower_map.clear();
+      tower_table.clear();
 
       const int n = param.get_int_param("sector_tower_map_size");
 
@@ -473,6 +497,7 @@ PHG4CylinderGeom_Spacalv3::load_demo_sector_tower_map1()
   sidewall_thickness = 0.075000;
   sidewall_outer_torr = 0.030000;
   sector_tower_map.clear();
+  tower_table.clear();
 
     {
       // tower 1023 based Row/Col = 102/3
@@ -548,6 +573,7 @@ PHG4CylinderGeom_Spacalv3::load_demo_sector_tower_map2()
   sidewall_thickness = 0.075000;
   sidewall_outer_torr = 0.030000;
   sector_tower_map.clear();
+  tower_table.clear();
 
     {
       // tower 541 based Row/Col = 54/1
@@ -817,6 +843,7 @@ PHG4CylinderGeom_Spacalv3::load_demo_sector_tower_map4()
   sidewall_thickness = 0;
   sidewall_outer_torr = 0;
   sector_tower_map.clear();
+  tower_table.clear();
 
   for (int y = 0; y < ny; y++)
     {
@@ -18,6 +18,7 @@
 #include <map>
 #include <string>
 #include <utility>  // std::pair, std::make_pair
+#include <vector>
 
 class PHParameters;
 
@@ -196,6 +197,11 @@ class PHG4CylinderGeom_Spacalv3 : public PHG4CylinderGeom_Spacalv2
     return sector_tower_map;
   }
 
+  //! tower by tower_ID through a dense table instead of the map, for per hit lookups.
+  //! @return: nullptr if there is no such tower
+  const geom_tower*
+  get_tower(const int tower_ID) const;
+
   //! get approximate radial position of tower
   double
   get_tower_radial_position(const geom_tower& tower) const;
@@ -264,6 +270,10 @@ class PHG4CylinderGeom_Spacalv3 : public PHG4CylinderGeom_Spacalv2
 
   tower_map_t sector_tower_map;
 
+  //! copy of sector_tower_map indexed by tower_ID (id INT_MIN for unused IDs),
+  //! built on first use by get_tower() and cleared with sector_tower_map
+  mutable std::vector<geom_tower> tower_table;  //!
+
   //! wdith along the approximate radial direction
   double divider_width;
   //! material for divider
@@ -43,6 +43,7 @@ PHG4CylinderGeom_Spacalv3::load_demo_sector_tower_map_2015_Chris_Cullen_2D_spaca
   sidewall_thickness = 0.075000;
   sidewall_outer_torr = 0.030000;
   sector_tower_map.clear();
+  tower_table.clear();
     {
       // tower 1021 based Row/Col = 102/1
       geom_tower geom;
@@ -6,7 +6,6 @@
 
 #include <g4main/PHG4Hit.h>
 #include <g4main/PHG4HitContainer.h>
-#include <g4main/PHG4Hitv1.h>
 #include <g4main/PHG4Shower.h>
 #include <g4main/PHG4SteppingAction.h>         // for PHG4SteppingAction
 
@@ -48,6 +47,7 @@ PHG4CylinderSteppingAction::PHG4CylinderSteppingAction(PHG4CylinderDetector* det
   , m_Params(parameters)
   , m_HitContainer(nullptr)
   , m_Hit(nullptr)
+  , m_HitVersion(PHG4HitContainer::HitVersion())
   , m_SaveShower(nullptr)
   , m_SaveVolPre(nullptr)
   , m_SaveVolPost(nullptr)
@@ -77,6 +77,12 @@ PHG4CylinderSteppingAction::~PHG4CylinderSteppingAction()
   delete m_Hit;
 }
 
+//____________________________________________________________________________..
+bool PHG4CylinderSteppingAction::HandlesVolume(G4VPhysicalVolume* volume)
+{
+  return m_Detector->IsInCylinder(volume);
+}
+
 //____________________________________________________________________________..
 bool PHG4CylinderSteppingAction::UserSteppingAction(const G4Step* aStep, bool)
 {
@@ -153,7 +159,7 @@ bool PHG4CylinderSteppingAction::UserSteppingAction(const G4Step* aStep, bool)
 
       if (!m_Hit)
       {
-        m_Hit = new PHG4Hitv1();
+        m_Hit = PHG4HitContainer::NewHit(m_HitVersion);
       }
 
       m_Hit->set_layer((unsigned int) layer_id);
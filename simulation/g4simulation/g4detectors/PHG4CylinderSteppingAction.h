@@ -26,6 +26,9 @@ class PHG4CylinderSteppingAction : public PHG4SteppingAction
   //! stepping action
   bool UserSteppingAction(const G4Step *, bool);
 
+  //! only steps in our own volumes are dispatched to this stepping action
+  bool HandlesVolume(G4VPhysicalVolume *volume);
+
   //! reimplemented from base class
   void SetInterfacePointers(PHCompositeNode *);
 
@@ -40,6 +43,8 @@ class PHG4CylinderSteppingAction : public PHG4SteppingAction
   //! pointer to hit container
   PHG4HitContainer *m_HitContainer;
   PHG4Hit *m_Hit;
+  //! PHG4Hit version created, PHG4HitContainer::HitVersion()
+  int m_HitVersion;
   PHG4Shower *m_SaveShower;
   G4VPhysicalVolume *m_SaveVolPre;
   G4VPhysicalVolume *m_SaveVolPost;
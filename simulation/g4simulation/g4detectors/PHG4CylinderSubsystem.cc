@@ -147,6 +147,17 @@ int PHG4CylinderSubsystem::process_event(PHCompositeNode *topNode)
   return 0;
 }
 
+//_______________________________________________________________________
+PHG4SteppingAction *PHG4CylinderSubsystem::CreateWorkerSteppingAction()
+{
+  // same as the stepping action of the master, none for passive cylinders
+  if (!m_SteppingAction)
+  {
+    return nullptr;
+  }
+  return new PHG4CylinderSteppingAction(m_Detector, GetParams());
+}
+
 void PHG4CylinderSubsystem::SetDefaultParameters()
 {
   set_default_double_param("length", NAN);
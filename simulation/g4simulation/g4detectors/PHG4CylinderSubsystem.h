@@ -48,6 +48,10 @@ class PHG4CylinderSubsystem : public PHG4DetectorSubsystem
   PHG4Detector* GetDetector(void) const;
   PHG4SteppingAction* GetSteppingAction(void) const { return m_SteppingAction; }
 
+  //! each worker gets its own stepping action, filling the hits of its sub event
+  bool SupportsWorkerThreads() const { return true; }
+  PHG4SteppingAction* CreateWorkerSteppingAction();
+
   PHG4DisplayAction* GetDisplayAction() const { return m_DisplayAction; }
   void set_color(const double red, const double green, const double blue, const double alpha = 1.)
   {
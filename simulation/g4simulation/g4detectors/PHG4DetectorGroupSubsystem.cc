@@ -4,6 +4,7 @@
 
 #include <phparameter/PHParameters.h>
 #include <phparameter/PHParametersContainer.h>
+#include <phparameter/PHParametersStore.h>
 
 #include <pdbcalbase/PdbParameterMapContainer.h>
 
@@ -58,7 +59,6 @@ int PHG4DetectorGroupSubsystem::InitRun(PHCompositeNode *topNode)
 {
   PHNodeIterator iter(topNode);
   PHCompositeNode *parNode = dynamic_cast<PHCompositeNode *>(iter.findFirst("PHCompositeNode", "PAR"));
-  PHCompositeNode *runNode = dynamic_cast<PHCompositeNode *>(iter.findFirst("PHCompositeNode", "RUN"));
 
   string g4geonodename = "G4GEO_";
   string paramnodename = "G4GEOPARAM_";
@@ -133,26 +133,19 @@ int PHG4DetectorGroupSubsystem::InitRun(PHCompositeNode *topNode)
   // parameters set in the macro always override whatever is read from
   // the node tree, DB or file
   UpdateParametersWithMacro();
-  // save updated persistant copy on node tree
-  PHCompositeNode *RunDetNode = runNode;
-  if (m_SuperDetector != "NONE")
+  // the parameters are written to the RUN node by PHG4Reco once all subsystems are
+  // initialized, so changes made by the subsystem itself end up there as well
+  PHParametersStore *store = PHParametersStore::GetStore(topNode, true);
+  PHParametersContainer::Range range = m_ParamsContainer->GetAllParametersToModify();
+  for (PHParametersContainer::Iterator piter = range.first; piter != range.second; ++piter)
   {
-    PHNodeIterator runIter(runNode);
-    RunDetNode = dynamic_cast<PHCompositeNode *>(runIter.findFirst("PHCompositeNode", SuperDetector()));
-    if (!RunDetNode)
-    {
-      RunDetNode = new PHCompositeNode(SuperDetector());
-      runNode->addNode(RunDetNode);
-    }
+    store->Register(calibdetname, piter->first, piter->second, isSuperDetector);
   }
-  m_ParamsContainer->SaveToNodeTree(RunDetNode, paramnodename);
   int iret = InitRunSubsystem(topNode);
-  m_ParamsContainer->UpdateNodeTree(RunDetNode, paramnodename);
   if (Verbosity() > 0)
   {
-    PdbParameterMapContainer *nodeparams = findNode::getClass<PdbParameterMapContainer>(topNode, paramnodename);
     cout << Name() << endl;
-    nodeparams->print();
+    m_ParamsContainer->Print();
   }
   m_BeginRunExecutedFlag = 1;
   return iret;
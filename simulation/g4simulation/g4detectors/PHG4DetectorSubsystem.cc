@@ -2,11 +2,14 @@
 
 #include <phparameter/PHParameters.h>
 #include <phparameter/PHParametersContainer.h>
+#include <phparameter/PHParametersStore.h>
 
 #include <pdbcalbase/PdbParameterMapContainer.h>
 
 #include <g4main/PHG4Subsystem.h>  // for PHG4Subsystem
 
+#include <fun4all/Fun4AllServer.h>
+
 #include <phool/PHCompositeNode.h>
 #include <phool/PHDataNode.h>
 #include <phool/PHNode.h>  // for PHNode
@@ -14,6 +17,8 @@
 #include <phool/getClass.h>
 #include <phool/phool.h>
 
+#include <boost/functional/hash.hpp>
+
 #include <cstdlib>  // for exit, NULL
 #include <iostream>
 #include <sstream>
@@ -45,6 +50,24 @@ int PHG4DetectorSubsystem::Init(PHCompositeNode *topNode)
 {
   savetopNode = topNode;
   params->set_name(Name());
+  if (ReadDB())
+  {
+    // fetched together with all other calibrations at BeginRun
+    const string name = Name();
+    const string superdet = superdetector;
+    const int lyr = layer;
+    Fun4AllServer *se = Fun4AllServer::instance();
+    se->registerCalibrationRequest(CalibrationKey(), [name, superdet, lyr](const int /*runnumber*/) {
+      PHParameters *dbparams = new PHParameters(name);
+      int iret = (superdet != "NONE") ? dbparams->ReadFromDB(superdet, lyr) : dbparams->ReadFromDB();
+      if (iret)
+      {
+        delete dbparams;
+        return static_cast<PHObject *>(nullptr);
+      }
+      return static_cast<PHObject *>(dbparams);
+    });
+  }
   int iret = InitSubsystem(topNode);
   return iret;
 }
@@ -53,7 +76,6 @@ int PHG4DetectorSubsystem::InitRun(PHCompositeNode *topNode)
 {
   PHNodeIterator iter(topNode);
   PHCompositeNode *parNode = dynamic_cast<PHCompositeNode *>(iter.findFirst("PHCompositeNode", "PAR"));
-  PHCompositeNode *runNode = dynamic_cast<PHCompositeNode *>(iter.findFirst("PHCompositeNode", "RUN"));
 
   string g4geonodename = "G4GEO_";
   string paramnodename = "G4GEOPARAM_";
@@ -115,34 +137,33 @@ int PHG4DetectorSubsystem::InitRun(PHCompositeNode *topNode)
   // parameters set in the macro always override whatever is read from
   // the node tree, DB or file
   UpdateParametersWithMacro();
-  // save updated persistant copy on node tree
-  PHCompositeNode *RunDetNode = runNode;
-  if (superdetector != "NONE")
-  {
-    PHNodeIterator runIter(runNode);
-    RunDetNode = dynamic_cast<PHCompositeNode *>(runIter.findFirst("PHCompositeNode", SuperDetector()));
-    if (!RunDetNode)
-    {
-      RunDetNode = new PHCompositeNode(SuperDetector());
-      runNode->addNode(RunDetNode);
-    }
-  }
-  // put parameters on the node tree so the subsystem can read them from there (it does not have to)
-  params->SaveToNodeTree(RunDetNode, paramnodename, layer);
+  // the parameters are written to the RUN node by PHG4Reco once all subsystems are
+  // initialized, so changes made by the subsystem itself end up there as well
+  PHParametersStore *store = PHParametersStore::GetStore(topNode, true);
+  store->Register(calibdetname, layer, params, isSuperDetector);
   int iret = InitRunSubsystem(topNode);
-  // update parameters on node tree in case the subsystem has changed them
-  // In the end the parameters on the node tree must reflect what was actually used
-  params->UpdateNodeTree(RunDetNode, paramnodename, layer);
   if (Verbosity() > 0)
   {
-    PdbParameterMapContainer *nodeparams = findNode::getClass<PdbParameterMapContainer>(topNode, paramnodename);
     cout << Name() << endl;
-    nodeparams->print();
+    params->Print();
   }
   beginrunexecuted = 1;
   return iret;
 }
 
+size_t PHG4DetectorSubsystem::GetGeometryHash() const
+{
+  if (!params)
+  {
+    return 0;
+  }
+  size_t seed = params->get_hash();
+  boost::hash_combine(seed, Name());
+  boost::hash_combine(seed, superdetector);
+  boost::hash_combine(seed, layer);
+  return seed;
+}
+
 void PHG4DetectorSubsystem::SuperDetector(const std::string &name)
 {
   superdetector = name;
@@ -314,8 +335,21 @@ int PHG4DetectorSubsystem::SaveParamsToDB()
   return iret;
 }
 
+string PHG4DetectorSubsystem::CalibrationKey() const
+{
+  return Name() + "_GEOPARAMS";
+}
+
 int PHG4DetectorSubsystem::ReadParamsFromDB(const string &name, const int issuper)
 {
+  // use the copy prefetched by the Fun4AllServer if there is one
+  Fun4AllServer *se = Fun4AllServer::instance();
+  PHParameters *prefetched = dynamic_cast<PHParameters *>(se->getCalibration(CalibrationKey()));
+  if (prefetched)
+  {
+    params->FillFrom(prefetched);
+    return 0;
+  }
   int iret = 0;
   if (issuper)
   {
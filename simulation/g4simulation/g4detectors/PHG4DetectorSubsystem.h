@@ -44,6 +44,9 @@ class PHG4DetectorSubsystem : public PHG4Subsystem
 
   PHParameters *GetParams() const { return params; }
 
+  //! hash of the name, layer and all parameters, a superset of what determines the geometry
+  size_t GetGeometryHash() const;
+
   // Get/Set parameters from macro
   void set_double_param(const std::string &name, const double dval);
   double get_double_param(const std::string &name) const;
@@ -86,6 +89,9 @@ class PHG4DetectorSubsystem : public PHG4Subsystem
   int BeginRunExecuted() const { return beginrunexecuted; }
 
  private:
+  //! key of the DB parameters in the Fun4AllServer calibration prefetch
+  std::string CalibrationKey() const;
+
   PHParameters *params;
   PHParametersContainer *paramscontainer;
   PHCompositeNode *savetopNode;
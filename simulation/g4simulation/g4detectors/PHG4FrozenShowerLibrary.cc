@@ -0,0 +1,285 @@
+#include "PHG4FrozenShowerLibrary.h"
+
+#include <TFile.h>
+#include <TTree.h>
+
+#include <algorithm>  // for upper_bound, min, max
+#include <iostream>
+
+using namespace std;
+
+PHG4FrozenShowerLibrary::PHG4FrozenShowerLibrary()
+  // GeV, frozen showers are meant for the low energy part of the showers
+  : m_EnergyBins({0., 0.005, 0.01, 0.02, 0.05, 0.1, 0.2, 0.5, 1.})
+  , m_CosIncidenceBins({-1., 0., 0.5, 0.7, 0.8, 0.9, 0.95, 1.})
+  , m_EtaBins({-1.2, -0.9, -0.6, -0.3, 0., 0.3, 0.6, 0.9, 1.2})
+{
+  FillBins();
+}
+
+int PHG4FrozenShowerLibrary::GetParticleType(const int pdgcode)
+{
+  switch (pdgcode)
+  {
+  case 11:
+    return kElectron;
+  case -11:
+    return kPositron;
+  case 22:
+    return kPhoton;
+  default:
+    break;
+  }
+  return -1;
+}
+
+int PHG4FrozenShowerLibrary::Load(const string &filename)
+{
+  TFile *file = TFile::Open(filename.c_str());
+  if (!file || file->IsZombie())
+  {
+    cout << "PHG4FrozenShowerLibrary::Load - could not open " << filename << endl;
+    delete file;
+    return -1;
+  }
+  TTree *tree = dynamic_cast<TTree *>(file->Get("frozenshowers"));
+  if (!tree)
+  {
+    cout << "PHG4FrozenShowerLibrary::Load - no frozenshowers tree in " << filename << endl;
+    delete file;
+    return -1;
+  }
+  int type = -1;
+  float energy = 0;
+  float cos_incidence = 0;
+  float eta = 0;
+  vector<float> *longitudinal = nullptr;
+  vector<float> *transverse_x = nullptr;
+  vector<float> *transverse_y = nullptr;
+  vector<float> *time = nullptr;
+  vector<float> *edep = nullptr;
+  vector<float> *light_yield = nullptr;
+  tree->SetBranchAddress("type", &type);
+  tree->SetBranchAddress("energy", &energy);
+  tree->SetBranchAddress("cos_incidence", &cos_incidence);
+  tree->SetBranchAddress("eta", &eta);
+  tree->SetBranchAddress("longitudinal", &longitudinal);
+  tree->SetBranchAddress("transverse_x", &transverse_x);
+  tree->SetBranchAddress("transverse_y", &transverse_y);
+  tree->SetBranchAddress("time", &time);
+  tree->SetBranchAddress("edep", &edep);
+  tree->SetBranchAddress("light_yield", &light_yield);
+
+  const Long64_t nentries = tree->GetEntries();
+  m_Showers.reserve(m_Showers.size() + nentries);
+  for (Long64_t i = 0; i < nentries; ++i)
+  {
+    tree->GetEntry(i);
+    Shower shower;
+    shower.type = type;
+    shower.energy = energy;
+    shower.cos_incidence = cos_incidence;
+    shower.eta = eta;
+    shower.spots.resize(edep->size());
+    for (unsigned int j = 0; j < edep->size(); ++j)
+    {
+      Spot &spot = shower.spots[j];
+      spot.longitudinal = (*longitudinal)[j];
+      spot.transverse_x = (*transverse_x)[j];
+      spot.transverse_y = (*transverse_y)[j];
+      spot.time = (*time)[j];
+      spot.edep = (*edep)[j];
+      spot.light_yield = (*light_yield)[j];
+    }
+    m_Showers.push_back(shower);
+  }
+  // the tree owns the vectors it allocated, it is deleted with the file
+  file->Close();
+  delete file;
+
+  FillBins();
+  return 0;
+}
+
+int PHG4FrozenShowerLibrary::Save(const string &filename) const
+{
+  TFile *file = TFile::Open(filename.c_str(), "RECREATE");
+  if (!file || file->IsZombie())
+  {
+    cout << "PHG4FrozenShowerLibrary::Save - could not open " << filename << endl;
+    delete file;
+    return -1;
+  }
+  int type = -1;
+  float energy = 0;
+  float cos_incidence = 0;
+  float eta = 0;
+  vector<float> longitudinal;
+  vector<float> transverse_x;
+  vector<float> transverse_y;
+  vector<float> time;
+  vector<float> edep;
+  vector<float> light_yield;
+  TTree *tree = new TTree("frozenshowers", "frozen em showers");
+  tree->Branch("type", &type, "type/I");
+  tree->Branch("energy", &energy, "energy/F");
+  tree->Branch("cos_incidence", &cos_incidence, "cos_incidence/F");
+  tree->Branch("eta", &eta, "eta/F");
+  tree->Branch("longitudinal", &longitudinal);
+  tree->Branch("transverse_x", &transverse_x);
+  tree->Branch("transverse_y", &transverse_y);
+  tree->Branch("time", &time);
+  tree->Branch("edep", &edep);
+  tree->Branch("light_yield", &light_yield);
+  for (const Shower &shower : m_Showers)
+  {
+    type = shower.type;
+    energy = shower.energy;
+    cos_incidence = shower.cos_incidence;
+    eta = shower.eta;
+    longitudinal.clear();
+    transverse_x.clear();
+    transverse_y.clear();
+    time.clear();
+    edep.clear();
+    light_yield.clear();
+    for (const Spot &spot : shower.spots)
+    {
+      longitudinal.push_back(spot.longitudinal);
+      transverse_x.push_back(spot.transverse_x);
+      transverse_y.push_back(spot.transverse_y);
+      time.push_back(spot.time);
+      edep.push_back(spot.edep);
+      light_yield.push_back(spot.light_yield);
+    }
+    tree->Fill();
+  }
+  tree->Write();
+  file->Close();
+  delete file;
+  return 0;
+}
+
+void PHG4FrozenShowerLibrary::AddShower(const Shower &shower)
+{
+  if (shower.type < 0 || shower.type >= kNParticleTypes || shower.energy <= 0)
+  {
+    cout << "PHG4FrozenShowerLibrary::AddShower - invalid shower, type " << shower.type
+         << ", energy " << shower.energy << endl;
+    return;
+  }
+  m_Showers.push_back(shower);
+  const int ibin = GetBin(shower.type,
+                          FindBin(m_EnergyBins, shower.energy),
+                          FindBin(m_CosIncidenceBins, shower.cos_incidence),
+                          FindBin(m_EtaBins, shower.eta));
+  m_Bins[ibin].push_back(m_Showers.size() - 1);
+}
+
+const PHG4FrozenShowerLibrary::Shower *PHG4FrozenShowerLibrary::Find(const int type, const double energy, const double cos_incidence, const double eta, const double random) const
+{
+  if (type < 0 || type >= kNParticleTypes)
+  {
+    return nullptr;
+  }
+  const int nenergy = m_EnergyBins.size() - 1;
+  const int ienergy = FindBin(m_EnergyBins, energy);
+  const int icos = FindBin(m_CosIncidenceBins, cos_incidence);
+  const int ieta = FindBin(m_EtaBins, eta);
+  // look outwards from the energy bin of the particle for a filled one
+  for (int distance = 0; distance < nenergy; ++distance)
+  {
+    for (int sign = -1; sign <= 1; sign += 2)
+    {
+      const int ibin = ienergy + sign * distance;
+      if (ibin < 0 || ibin >= nenergy)
+      {
+        continue;
+      }
+      const vector<unsigned int> &showers = m_Bins[GetBin(type, ibin, icos, ieta)];
+      if (!showers.empty())
+      {
+        const unsigned int ishower = min(static_cast<unsigned int>(random * showers.size()), static_cast<unsigned int>(showers.size() - 1));
+        return &m_Showers[showers[ishower]];
+      }
+      if (distance == 0)
+      {
+        break;
+      }
+    }
+  }
+  return nullptr;
+}
+
+void PHG4FrozenShowerLibrary::SetEnergyBins(const vector<double> &edges)
+{
+  m_EnergyBins = edges;
+  FillBins();
+}
+
+void PHG4FrozenShowerLibrary::SetCosIncidenceBins(const vector<double> &edges)
+{
+  m_CosIncidenceBins = edges;
+  FillBins();
+}
+
+void PHG4FrozenShowerLibrary::SetEtaBins(const vector<double> &edges)
+{
+  m_EtaBins = edges;
+  FillBins();
+}
+
+void PHG4FrozenShowerLibrary::Print() const
+{
+  cout << "PHG4FrozenShowerLibrary: " << m_Showers.size() << " showers in "
+       << kNParticleTypes << " x " << m_EnergyBins.size() - 1 << " x "
+       << m_CosIncidenceBins.size() - 1 << " x " << m_EtaBins.size() - 1
+       << " (type x energy x cos incidence x eta) bins" << endl;
+  int nempty = 0;
+  for (const vector<unsigned int> &showers : m_Bins)
+  {
+    if (showers.empty())
+    {
+      ++nempty;
+    }
+  }
+  cout << "empty bins: " << nempty << endl;
+}
+
+void PHG4FrozenShowerLibrary::FillBins()
+{
+  // one bin at least, a single edge would give none
+  if (m_EnergyBins.size() < 2)
+  {
+    m_EnergyBins = {0., 1.};
+  }
+  if (m_CosIncidenceBins.size() < 2)
+  {
+    m_CosIncidenceBins = {-1., 1.};
+  }
+  if (m_EtaBins.size() < 2)
+  {
+    m_EtaBins = {-1., 1.};
+  }
+  m_Bins.assign(kNParticleTypes * (m_EnergyBins.size() - 1) * (m_CosIncidenceBins.size() - 1) * (m_EtaBins.size() - 1), vector<unsigned int>());
+  for (unsigned int i = 0; i < m_Showers.size(); ++i)
+  {
+    const Shower &shower = m_Showers[i];
+    const int ibin = GetBin(shower.type,
+                            FindBin(m_EnergyBins, shower.energy),
+                            FindBin(m_CosIncidenceBins, shower.cos_incidence),
+                            FindBin(m_EtaBins, shower.eta));
+    m_Bins[ibin].push_back(i);
+  }
+}
+
+int PHG4FrozenShowerLibrary::GetBin(const int type, const int ienergy, const int icos, const int ieta) const
+{
+  return ((type * (m_EnergyBins.size() - 1) + ienergy) * (m_CosIncidenceBins.size() - 1) + icos) * (m_EtaBins.size() - 1) + ieta;
+}
+
+int PHG4FrozenShowerLibrary::FindBin(const vector<double> &edges, const double value)
+{
+  const int ibin = (upper_bound(edges.begin(), edges.end(), value) - edges.begin()) - 1;
+  return max(0, min(ibin, static_cast<int>(edges.size()) - 2));
+}
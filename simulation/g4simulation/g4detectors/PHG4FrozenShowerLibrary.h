@@ -0,0 +1,98 @@
+// Tell emacs that this is a C++ source
+//  -*- C++ -*-.
+#ifndef G4DETECTORS_PHG4FROZENSHOWERLIBRARY_H
+#define G4DETECTORS_PHG4FROZENSHOWERLIBRARY_H
+
+#include <string>
+#include <vector>
+
+/*!
+ * \brief library of pre-simulated (frozen) electromagnetic showers
+ *
+ * A shower is the list of energy deposits (spots) of an e+, e- or photon
+ * which entered a calorimeter, in the frame of the particle at the entry
+ * point: longitudinal along its direction, transverse_x along
+ * direction x z-axis, transverse_y completing the right handed frame.
+ * The showers are indexed by particle type, energy, cosine of the
+ * incidence angle with respect to the radial direction and eta of the
+ * entry point. Find() picks one of the showers in the bin of a particle,
+ * the deposits are then scaled by the energy ratio.
+ *
+ * The library is a root file with the TTree "frozenshowers", written by
+ * Save() from the showers recorded with AddShower().
+ */
+class PHG4FrozenShowerLibrary
+{
+ public:
+  enum ParticleType
+  {
+    kElectron = 0,
+    kPositron = 1,
+    kPhoton = 2,
+    kNParticleTypes = 3
+  };
+
+  //! one energy deposit, positions in cm, time in ns since the entry, energies in GeV
+  struct Spot
+  {
+    float longitudinal;
+    float transverse_x;
+    float transverse_y;
+    float time;
+    float edep;
+    float light_yield;
+  };
+
+  struct Shower
+  {
+    int type;
+    float energy;
+    float cos_incidence;
+    float eta;
+    std::vector<Spot> spots;
+  };
+
+  PHG4FrozenShowerLibrary();
+  virtual ~PHG4FrozenShowerLibrary() {}
+
+  //! library type of a pdg code, -1 if this is not an em particle
+  static int GetParticleType(const int pdgcode);
+
+  //! read the showers of a library file, returns 0 on success
+  int Load(const std::string &filename);
+
+  //! write all showers to a library file, returns 0 on success
+  int Save(const std::string &filename) const;
+
+  void AddShower(const Shower &shower);
+
+  //! a shower of the bin of this particle (random in [0,1) selects one of them),
+  //! the closest filled energy bin if the bin is empty, nullptr if there is none
+  const Shower *Find(const int type, const double energy, const double cos_incidence, const double eta, const double random) const;
+
+  //! bin edges of the lookup, showers outside the edges go to the first/last bin
+  void SetEnergyBins(const std::vector<double> &edges);
+  void SetCosIncidenceBins(const std::vector<double> &edges);
+  void SetEtaBins(const std::vector<double> &edges);
+
+  unsigned int size() const { return m_Showers.size(); }
+
+  void Print() const;
+
+ private:
+  //! rebuild the bin lists after a change of the bins
+  void FillBins();
+  int GetBin(const int type, const int ienergy, const int icos, const int ieta) const;
+  static int FindBin(const std::vector<double> &edges, const double value);
+
+  std::vector<Shower> m_Showers;
+
+  std::vector<double> m_EnergyBins;
+  std::vector<double> m_CosIncidenceBins;
+  std::vector<double> m_EtaBins;
+
+  //! indices into m_Showers of each bin
+  std::vector<std::vector<unsigned int> > m_Bins;
+};
+
+#endif
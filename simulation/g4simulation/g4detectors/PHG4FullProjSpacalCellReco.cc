@@ -395,9 +395,9 @@ PHG4FullProjSpacalCellReco::process_event(PHCompositeNode *topNode)
       const int & tower_ID_z = tower_z_phi_ID.first;
       const int & tower_ID_phi = tower_z_phi_ID.second;
 
-      PHG4CylinderGeom_Spacalv3::tower_map_t::const_iterator it_tower =
-	layergeom->get_sector_tower_map().find(decoder.tower_ID);
-      assert(it_tower != layergeom->get_sector_tower_map().end());
+      const PHG4CylinderGeom_Spacalv3::geom_tower * tower =
+	layergeom->get_tower(decoder.tower_ID);
+      assert(tower);
 
       unsigned int key = static_cast<unsigned int>(scint_id);
       PHG4Cell *cell = nullptr;
@@ -428,8 +428,8 @@ PHG4FullProjSpacalCellReco::process_event(PHCompositeNode *topNode)
 	      exit(1);
 	    }
 
-	  const int sub_tower_ID_x = it_tower->second.get_sub_tower_ID_x(decoder.fiber_ID);
-	  const int sub_tower_ID_y = it_tower->second.get_sub_tower_ID_y(decoder.fiber_ID);
+	  const int sub_tower_ID_x = tower->get_sub_tower_ID_x(decoder.fiber_ID);
+	  const int sub_tower_ID_y = tower->get_sub_tower_ID_y(decoder.fiber_ID);
 	  unsigned short fiber_ID = decoder.fiber_ID;
 	  unsigned short etabinshort  =  etabin * layergeom->get_n_subtower_eta() + sub_tower_ID_y;
 	  unsigned short phibin = tower_ID_phi * layergeom->get_n_subtower_phi() + sub_tower_ID_x;
@@ -454,8 +454,8 @@ PHG4FullProjSpacalCellReco::process_event(PHCompositeNode *topNode)
       // light yield correction from light guide collection efficiency:
       if (light_collection_model.use_fiber_model())
 	{
-	  const double x = it_tower->second.get_position_fraction_x_in_sub_tower(decoder.fiber_ID);
-	  const double y = it_tower->second.get_position_fraction_y_in_sub_tower(decoder.fiber_ID);
+	  const double x = tower->get_position_fraction_x_in_sub_tower(decoder.fiber_ID);
+	  const double y = tower->get_position_fraction_y_in_sub_tower(decoder.fiber_ID);
 
 	  light_yield *= light_collection_model.get_light_guide_efficiency(x, y);
 	}
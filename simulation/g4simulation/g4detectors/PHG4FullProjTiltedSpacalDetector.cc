@@ -43,6 +43,7 @@
 #include <numeric>   // std::accumulate
 #include <sstream>
 #include <string>  // std::string, std::to_string
+#include <utility>  // for pair
 #include <vector>  // for vector
 
 class G4VSolid;
@@ -50,6 +51,23 @@ class PHCompositeNode;
 
 using namespace std;
 
+namespace
+{
+  //! everything which goes into the shape and the content of a tower volume,
+  //! towers with the same key share one logical volume
+  vector<double> tower_shape_key(const PHG4CylinderGeom_Spacalv3::geom_tower& g_tower)
+  {
+    return {g_tower.pDz,
+            g_tower.pDy1, g_tower.pDx1, g_tower.pDx2,
+            g_tower.pDy2, g_tower.pDx3, g_tower.pDx4,
+            g_tower.pTheta, g_tower.pPhi, g_tower.pAlp1, g_tower.pAlp2,
+            g_tower.ModuleSkinThickness,
+            static_cast<double>(g_tower.NFiberX), static_cast<double>(g_tower.NFiberY),
+            static_cast<double>(g_tower.NSubtowerX), static_cast<double>(g_tower.NSubtowerY),
+            g_tower.LightguideHeight, g_tower.LightguideTaperRatio};
+  }
+}  // namespace
+
 //_______________________________________________________________
 //note this inactive thickness is ~1.5% of a radiation length
 PHG4FullProjTiltedSpacalDetector::PHG4FullProjTiltedSpacalDetector(PHG4Subsystem* subsys, PHCompositeNode* Node,
@@ -468,6 +486,11 @@ PHG4FullProjTiltedSpacalDetector::Construct_AzimuthalSeg()
 
   //  // construct towers
   //
+  // The towers only differ by their placement in many cases, those share one
+  // logical volume with all its fibers. Tower and fiber ids are the copy numbers
+  // of the placements, so the stepping action does not care
+  map<vector<double>, G4LogicalVolume*> tower_logic_cache;
+  map<pair<vector<double>, string>, G4LogicalVolume*> lightguide_logic_cache;
   BOOST_FOREACH (const SpacalGeom_t::tower_map_t::value_type& val, get_geom_v3()->get_sector_tower_map())
   {
     SpacalGeom_t::geom_tower g_tower = val.second;
@@ -479,7 +502,12 @@ PHG4FullProjTiltedSpacalDetector::Construct_AzimuthalSeg()
 
     const auto& block_azimuth_geom = block_azimuth_geoms.at(tower_phi_id_in_sec);
 
-    G4LogicalVolume* LV_tower = Construct_Tower(g_tower);
+    const vector<double> shape_key = tower_shape_key(g_tower);
+    G4LogicalVolume*& LV_tower = tower_logic_cache[shape_key];
+    if (!LV_tower)
+    {
+      LV_tower = Construct_Tower(g_tower);
+    }
 
     G4Transform3D block_trans =
         G4TranslateX3D(block_azimuth_geom.projection_center_x) *
@@ -509,8 +537,14 @@ PHG4FullProjTiltedSpacalDetector::Construct_AzimuthalSeg()
         for (int iy = 0; iy < g_tower.NSubtowerY; iy++)
         //        int iy = 0;
         {
-          G4LogicalVolume* LV_lg = Construct_LightGuide(g_tower, ix,
-                                                        iy);
+          vector<double> lg_key(shape_key);
+          lg_key.push_back(ix);
+          lg_key.push_back(iy);
+          G4LogicalVolume*& LV_lg = lightguide_logic_cache[make_pair(lg_key, g_tower.LightguideMaterial)];
+          if (!LV_lg)
+          {
+            LV_lg = Construct_LightGuide(g_tower, ix, iy);
+          }
 
           G4PVPlacement* lg_phys = new G4PVPlacement(block_trans, LV_lg, LV_lg->GetName(),
                                                      sec_logic, false, g_tower.id, overlapcheck_block);
@@ -526,7 +560,7 @@ PHG4FullProjTiltedSpacalDetector::Construct_AzimuthalSeg()
 
   cout << "PHG4FullProjTiltedSpacalDetector::Construct_AzimuthalSeg::" << GetName()
        << " - constructed " << get_geom_v3()->get_sector_tower_map().size()
-       << " unique towers" << endl;
+       << " towers from " << tower_logic_cache.size() << " unique tower volumes" << endl;
 
   return make_pair(sec_logic, G4Transform3D::Identity);
 }
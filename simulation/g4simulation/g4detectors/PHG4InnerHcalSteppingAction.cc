@@ -1,13 +1,13 @@
 #include "PHG4InnerHcalSteppingAction.h"
 
 #include "PHG4InnerHcalDetector.h"
+#include "PHG4SlatCellAccumulator.h"
 #include "PHG4StepStatusDecode.h"
 
 #include <phparameter/PHParameters.h>
 
 #include <g4main/PHG4Hit.h>
 #include <g4main/PHG4HitContainer.h>
-#include <g4main/PHG4Hitv1.h>
 #include <g4main/PHG4Shower.h>
 #include <g4main/PHG4SteppingAction.h>         // for PHG4SteppingAction
 #include <g4main/PHG4TrackUserInfoV1.h>
@@ -32,6 +32,7 @@
 #include <Geant4/G4VTouchable.hh>              // for G4VTouchable
 #include <Geant4/G4VUserTrackInformation.hh>   // for G4VUserTrackInformation
 
+#include <climits>                             // for INT_MIN
 #include <cmath>                               // for isfinite
 #include <iostream>
 #include <string>                              // for operator<<, operator+
@@ -47,7 +48,9 @@ PHG4InnerHcalSteppingAction::PHG4InnerHcalSteppingAction(PHG4InnerHcalDetector*
   , m_Hits(nullptr)
   , m_AbsorberHits(nullptr)
   , m_Hit(nullptr)
+  , m_HitVersion(PHG4HitContainer::HitVersion())
   , m_Params(parameters)
+  , m_CellAccumulator(nullptr)
   , m_SaveHitContainer(nullptr)
   , m_SaveShower(nullptr)
   , m_SaveVolPre(nullptr)
@@ -58,6 +61,8 @@ PHG4InnerHcalSteppingAction::PHG4InnerHcalSteppingAction(PHG4InnerHcalDetector*
   , m_IsActive(m_Params->get_int_param("active"))
   , m_IsBlackHole(m_Params->get_int_param("blackhole"))
   , m_LightScintModel(m_Params->get_int_param("light_scint_model"))
+  , m_CellTmin(m_Params->get_double_param("direct_cells_tmin"))
+  , m_CellTmax(m_Params->get_double_param("direct_cells_tmax"))
 {
   SetLightCorrection(m_Params->get_double_param("light_balance_inner_radius") * cm,
                      m_Params->get_double_param("light_balance_inner_corr"),
@@ -73,6 +78,12 @@ PHG4InnerHcalSteppingAction::~PHG4InnerHcalSteppingAction()
   // legal to delete (it results in a no operation)
   delete m_Hit;
 }
+//____________________________________________________________________________..
+bool PHG4InnerHcalSteppingAction::HandlesVolume(G4VPhysicalVolume* volume)
+{
+  return m_Detector->IsInInnerHcal(volume) != 0;
+}
+
 //____________________________________________________________________________..
 bool PHG4InnerHcalSteppingAction::UserSteppingAction(const G4Step* aStep, bool)
 {
@@ -124,6 +135,13 @@ bool PHG4InnerHcalSteppingAction::UserSteppingAction(const G4Step* aStep, bool)
   // make sure we are in a volume
   if (m_IsActive)
   {
+    // direct to cell mode, scintillator steps are summed per slat without hits
+    if (m_CellAccumulator && whichactive > 0)
+    {
+      AddStepToCells(aStep, layer_id, tower_id, edep, eion);
+      return true;
+    }
+
     bool geantino = false;
 
     // the check for the pdg code speeds things up, I do not want to make
@@ -166,7 +184,7 @@ bool PHG4InnerHcalSteppingAction::UserSteppingAction(const G4Step* aStep, bool)
       // and we have to make a new one
       if (!m_Hit)
       {
-        m_Hit = new PHG4Hitv1();
+        m_Hit = PHG4HitContainer::NewHit(m_HitVersion);
       }
       //here we set the entrance values in cm
       m_Hit->set_x(0, prePoint->GetPosition().x() / cm);
@@ -317,6 +335,38 @@ bool PHG4InnerHcalSteppingAction::UserSteppingAction(const G4Step* aStep, bool)
   }
 }
 
+//____________________________________________________________________________..
+void PHG4InnerHcalSteppingAction::AddStepToCells(const G4Step* aStep, const int layer_id, const int tower_id, const double edep, const double eion)
+{
+  // the timing window of PHG4HcalCellReco, applied to steps instead of hits
+  G4StepPoint* prePoint = aStep->GetPreStepPoint();
+  G4StepPoint* postPoint = aStep->GetPostStepPoint();
+  if (prePoint->GetGlobalTime() / nanosecond > m_CellTmax || postPoint->GetGlobalTime() / nanosecond < m_CellTmin)
+  {
+    return;
+  }
+  if (edep <= 0)
+  {
+    return;
+  }
+  double light_yield = eion;
+  if (m_LightScintModel)
+  {
+    light_yield = GetVisibleEnergyDeposition(aStep);  // for scintillator only, calculate light yields
+  }
+  light_yield = light_yield * GetLightCorrection(postPoint->GetPosition().x(), postPoint->GetPosition().y());
+  int showerid = INT_MIN;  // PHG4Hitv1 default for hits without shower
+  if (G4VUserTrackInformation* p = aStep->GetTrack()->GetUserInformation())
+  {
+    if (PHG4TrackUserInfoV1* pp = dynamic_cast<PHG4TrackUserInfoV1*>(p))
+    {
+      showerid = pp->GetShower()->get_id();
+      pp->SetKeep(1);  // we want to keep the track
+    }
+  }
+  m_CellAccumulator->AddStep(layer_id, tower_id, edep, eion, light_yield, showerid);
+}
+
 //____________________________________________________________________________..
 void PHG4InnerHcalSteppingAction::SetInterfacePointers(PHCompositeNode* topNode)
 {
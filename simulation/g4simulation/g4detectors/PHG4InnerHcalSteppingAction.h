@@ -13,6 +13,7 @@ class PHParameters;
 class PHG4Hit;
 class PHG4HitContainer;
 class PHG4Shower;
+class PHG4SlatCellAccumulator;
 
 class PHG4InnerHcalSteppingAction : public PHG4SteppingAction
 {
@@ -26,10 +27,19 @@ class PHG4InnerHcalSteppingAction : public PHG4SteppingAction
   //! stepping action
   virtual bool UserSteppingAction(const G4Step *, bool);
 
+  //! only steps in our own volumes are dispatched to this stepping action
+  virtual bool HandlesVolume(G4VPhysicalVolume *volume);
+
   //! reimplemented from base class
   virtual void SetInterfacePointers(PHCompositeNode *);
 
+  //! direct to cell mode: sum the scintillator steps in cells instead of making hits
+  void SetCellAccumulator(PHG4SlatCellAccumulator *cells) { m_CellAccumulator = cells; }
+
  private:
+  //! add a scintillator step to the slat cells (direct to cell mode)
+  void AddStepToCells(const G4Step *aStep, const int layer_id, const int tower_id, const double edep, const double eion);
+
   //! pointer to the detector
   PHG4InnerHcalDetector *m_Detector;
 
@@ -37,7 +47,10 @@ class PHG4InnerHcalSteppingAction : public PHG4SteppingAction
   PHG4HitContainer *m_Hits;
   PHG4HitContainer *m_AbsorberHits;
   PHG4Hit *m_Hit;
+  //! PHG4Hit version created, PHG4HitContainer::HitVersion()
+  int m_HitVersion;
   const PHParameters *m_Params;
+  PHG4SlatCellAccumulator *m_CellAccumulator;
   PHG4HitContainer *m_SaveHitContainer;
   PHG4Shower *m_SaveShower;
   G4VPhysicalVolume *m_SaveVolPre;
@@ -51,6 +64,9 @@ class PHG4InnerHcalSteppingAction : public PHG4SteppingAction
   int m_IsActive;
   int m_IsBlackHole;
   int m_LightScintModel;
+  // timing window of the direct to cell mode
+  double m_CellTmin;
+  double m_CellTmax;
 };
 
 #endif  // G4DETECTORS_PHG4INNERHCALSTEPPINGACTION_H
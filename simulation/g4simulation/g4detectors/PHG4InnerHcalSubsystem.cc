@@ -1,9 +1,11 @@
 #include "PHG4InnerHcalSubsystem.h"
 
+#include "PHG4CellContainer.h"
 #include "PHG4HcalDefs.h"
 #include "PHG4InnerHcalDetector.h"
 #include "PHG4InnerHcalDisplayAction.h"
 #include "PHG4InnerHcalSteppingAction.h"
+#include "PHG4SlatCellAccumulator.h"
 
 #include <phparameter/PHParameters.h>
 
@@ -17,6 +19,7 @@
 #include <phool/PHNodeIterator.h>         // for PHNodeIterator
 #include <phool/PHObject.h>               // for PHObject
 #include <phool/getClass.h>
+#include <phool/phool.h>                 // for PHWHERE
 
 #include <boost/foreach.hpp>
 
@@ -35,6 +38,7 @@ PHG4InnerHcalSubsystem::PHG4InnerHcalSubsystem(const std::string &name, const in
   , m_Detector(nullptr)
   , m_SteppingAction(nullptr)
   , m_DisplayAction(nullptr)
+  , m_CellAccumulator(nullptr)
 {
   InitializeParameters();
 }
@@ -43,6 +47,7 @@ PHG4InnerHcalSubsystem::PHG4InnerHcalSubsystem(const std::string &name, const in
 PHG4InnerHcalSubsystem::~PHG4InnerHcalSubsystem()
 {
   delete m_DisplayAction;
+  delete m_CellAccumulator;
 }
 
 //_______________________________________________________________________
@@ -103,7 +108,23 @@ int PHG4InnerHcalSubsystem::InitRunSubsystem(PHCompositeNode *topNode)
     }
 
     // create stepping action
-    m_SteppingAction = new PHG4InnerHcalSteppingAction(m_Detector, GetParams());
+    PHG4InnerHcalSteppingAction *steppingaction = new PHG4InnerHcalSteppingAction(m_Detector, GetParams());
+    m_SteppingAction = steppingaction;
+
+    // direct to cell mode, the scintillator energy goes to G4CELL without hits
+    if (GetParams()->get_int_param("direct_cells"))
+    {
+      m_CellNodeName = "G4CELL_" + ((SuperDetector() != "NONE") ? SuperDetector() : Name());
+      PHG4CellContainer *cells = findNode::getClass<PHG4CellContainer>(topNode, m_CellNodeName);
+      if (!cells)
+      {
+        cells = new PHG4CellContainer();
+        DetNode->addNode(new PHIODataNode<PHObject>(cells, m_CellNodeName, "PHObject"));
+      }
+      m_CellAccumulator = new PHG4SlatCellAccumulator(GetParams()->get_int_param(PHG4HcalDefs::n_towers) * GetParams()->get_int_param(PHG4HcalDefs::scipertwr),
+                                                      2 * GetParams()->get_int_param(PHG4HcalDefs::n_scinti_tiles));
+      steppingaction->SetCellAccumulator(m_CellAccumulator);
+    }
   }
   else
   {
@@ -128,6 +149,22 @@ int PHG4InnerHcalSubsystem::process_event(PHCompositeNode *topNode)
   return 0;
 }
 
+//_______________________________________________________________________
+int PHG4InnerHcalSubsystem::process_after_geant(PHCompositeNode *topNode)
+{
+  if (m_CellAccumulator)
+  {
+    PHG4CellContainer *cells = findNode::getClass<PHG4CellContainer>(topNode, m_CellNodeName);
+    if (!cells)
+    {
+      cout << PHWHERE << " could not locate cell node " << m_CellNodeName << endl;
+      return -1;
+    }
+    m_CellAccumulator->AddToCells(cells);
+  }
+  return 0;
+}
+
 void PHG4InnerHcalSubsystem::Print(const string &what) const
 {
   cout << Name() << " Parameters: " << endl;
@@ -152,6 +189,9 @@ PHG4Detector *PHG4InnerHcalSubsystem::GetDetector(void) const
 
 void PHG4InnerHcalSubsystem::SetDefaultParameters()
 {
+  // timing window of the direct to cell mode, as in PHG4HcalCellReco
+  set_default_double_param("direct_cells_tmax", 60.0);
+  set_default_double_param("direct_cells_tmin", -20.0);
   set_default_double_param(PHG4HcalDefs::innerrad, 117.27);
   set_default_double_param("light_balance_inner_corr", NAN);
   set_default_double_param("light_balance_inner_radius", NAN);
@@ -178,6 +218,8 @@ void PHG4InnerHcalSubsystem::SetDefaultParameters()
   set_default_double_param("tilt_angle", 36.15);  // engineering drawing
                                                   // corresponds very closely to 4 crossinge (35.5497 deg)
 
+  // sum the scintillator energy directly in G4CELL instead of G4HIT (no PHG4HcalCellReco)
+  set_default_int_param("direct_cells", 0);
   set_default_int_param("light_scint_model", 1);
   // if ncross is set (and tilt_angle is NAN) tilt_angle is calculated
   // from number of crossings
@@ -11,6 +11,7 @@ class PHCompositeNode;
 class PHG4Detector;
 class PHG4DisplayAction;
 class PHG4InnerHcalDetector;
+class PHG4SlatCellAccumulator;
 class PHG4SteppingAction;
 
 class PHG4InnerHcalSubsystem : public PHG4DetectorSubsystem
@@ -36,6 +37,9 @@ class PHG4InnerHcalSubsystem : public PHG4DetectorSubsystem
   */
   int process_event(PHCompositeNode*);
 
+  //! direct to cell mode (int parameter "direct_cells"): move the slat sums to the G4CELL node
+  int process_after_geant(PHCompositeNode*);
+
   //! Print info (from SubsysReco)
   void Print(const std::string& what = "ALL") const;
 
@@ -61,6 +65,10 @@ class PHG4InnerHcalSubsystem : public PHG4DetectorSubsystem
   /*! derives from PHG4DisplayAction */
   PHG4DisplayAction* m_DisplayAction;
 
+  //! scintillator slat sums of the direct to cell mode, replaces the hits and PHG4HcalCellReco
+  PHG4SlatCellAccumulator* m_CellAccumulator;
+  std::string m_CellNodeName;
+
 };
 
 #endif  // G4DETECTORS_PHG4INNERHCALSUBSYSTEM_H
@@ -3,6 +3,7 @@
 
 #include "PHG4HcalDefs.h"
 #include "PHG4OuterHcalDetector.h"
+#include "PHG4SlatCellAccumulator.h"
 #include "PHG4StepStatusDecode.h"
 
 // our own headers in alphabetical order
@@ -13,7 +14,6 @@
 
 #include <g4main/PHG4Hit.h>
 #include <g4main/PHG4HitContainer.h>
-#include <g4main/PHG4Hitv1.h>
 #include <g4main/PHG4Shower.h>
 #include <g4main/PHG4SteppingAction.h>         // for PHG4SteppingAction
 #include <g4main/PHG4TrackUserInfoV1.h>
@@ -50,6 +50,7 @@
 
 // finally system headers
 #include <cassert>
+#include <climits>                             // for INT_MIN
 #include <cmath>                               // for isfinite, sqrt
 #include <iostream>
 #include <string>                              // for operator<<, string
@@ -65,7 +66,9 @@ PHG4OuterHcalSteppingAction::PHG4OuterHcalSteppingAction(PHG4OuterHcalDetector*
   , m_Hits(nullptr)
   , m_AbsorberHits(nullptr)
   , m_Hit(nullptr)
+  , m_HitVersion(PHG4HitContainer::HitVersion())
   , m_Params(parameters)
+  , m_CellAccumulator(nullptr)
   , m_SaveHitContainer(nullptr)
   , m_SaveShower(nullptr)
   , m_SaveVolPre(nullptr)
@@ -78,6 +81,8 @@ PHG4OuterHcalSteppingAction::PHG4OuterHcalSteppingAction(PHG4OuterHcalDetector*
   , m_IsBlackHoleFlag(m_Params->get_int_param("blackhole"))
   , m_NScintiPlates(m_Params->get_int_param(PHG4HcalDefs::scipertwr) * m_Params->get_int_param("n_towers"))
   , m_LightScintModelFlag(m_Params->get_int_param("light_scint_model"))
+  , m_CellTmin(m_Params->get_double_param("direct_cells_tmin"))
+  , m_CellTmax(m_Params->get_double_param("direct_cells_tmax"))
 {
   SetName(m_Detector->GetName());
 }
@@ -104,6 +109,12 @@ int PHG4OuterHcalSteppingAction::Init()
   return 0;
 }
 
+//____________________________________________________________________________..
+bool PHG4OuterHcalSteppingAction::HandlesVolume(G4VPhysicalVolume* volume)
+{
+  return m_Detector->IsInOuterHcal(volume) != 0;
+}
+
 //____________________________________________________________________________..
 bool PHG4OuterHcalSteppingAction::UserSteppingAction(const G4Step* aStep, bool)
 {
@@ -160,6 +171,13 @@ bool PHG4OuterHcalSteppingAction::UserSteppingAction(const G4Step* aStep, bool)
   // make sure we are in a volume
   if (m_IsActiveFlag)
   {
+    // direct to cell mode, scintillator steps are summed per slat without hits
+    if (m_CellAccumulator && whichactive > 0)
+    {
+      AddStepToCells(aStep, layer_id, tower_id, edep, eion);
+      return true;
+    }
+
     bool geantino = false;
 
     // the check for the pdg code speeds things up, I do not want to make
@@ -200,7 +218,7 @@ bool PHG4OuterHcalSteppingAction::UserSteppingAction(const G4Step* aStep, bool)
     case fUndefined:
       if (!m_Hit)
       {
-        m_Hit = new PHG4Hitv1();
+        m_Hit = PHG4HitContainer::NewHit(m_HitVersion);
       }
       //here we set the entrance values in cm
       m_Hit->set_x(0, prePoint->GetPosition().x() / cm);
@@ -362,6 +380,41 @@ cout << "applying cor: " << cor << endl;
   }
 }
 
+//____________________________________________________________________________..
+void PHG4OuterHcalSteppingAction::AddStepToCells(const G4Step* aStep, const int layer_id, const int tower_id, const double edep, const double eion)
+{
+  // the timing window of PHG4HcalCellReco, applied to steps instead of hits
+  G4StepPoint* prePoint = aStep->GetPreStepPoint();
+  G4StepPoint* postPoint = aStep->GetPostStepPoint();
+  if (prePoint->GetGlobalTime() / nanosecond > m_CellTmax || postPoint->GetGlobalTime() / nanosecond < m_CellTmin)
+  {
+    return;
+  }
+  if (edep <= 0)
+  {
+    return;
+  }
+  double light_yield = eion;
+  if (m_LightScintModelFlag)
+  {
+    light_yield = GetVisibleEnergyDeposition(aStep);
+  }
+  if (ValidCorrection())
+  {
+    light_yield = light_yield * GetLightCorrection(postPoint->GetPosition().x(), postPoint->GetPosition().y());
+  }
+  int showerid = INT_MIN;  // PHG4Hitv1 default for hits without shower
+  if (G4VUserTrackInformation* p = aStep->GetTrack()->GetUserInformation())
+  {
+    if (PHG4TrackUserInfoV1* pp = dynamic_cast<PHG4TrackUserInfoV1*>(p))
+    {
+      showerid = pp->GetShower()->get_id();
+      pp->SetKeep(1);  // we want to keep the track
+    }
+  }
+  m_CellAccumulator->AddStep(layer_id, tower_id, edep, eion, light_yield, showerid);
+}
+
 //____________________________________________________________________________..
 void PHG4OuterHcalSteppingAction::SetInterfacePointers(PHCompositeNode* topNode)
 {
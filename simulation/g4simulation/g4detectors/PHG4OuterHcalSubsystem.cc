@@ -1,8 +1,10 @@
 #include "PHG4OuterHcalSubsystem.h"
 
+#include "PHG4CellContainer.h"
 #include "PHG4OuterHcalDetector.h"
 #include "PHG4OuterHcalDisplayAction.h"
 #include "PHG4OuterHcalSteppingAction.h"
+#include "PHG4SlatCellAccumulator.h"
 #include "PHG4HcalDefs.h"
 
 #include <phparameter/PHParameters.h>
@@ -17,6 +19,7 @@
 #include <phool/PHNodeIterator.h>         // for PHNodeIterator
 #include <phool/PHObject.h>               // for PHObject
 #include <phool/getClass.h>
+#include <phool/phool.h>                 // for PHWHERE
 
 #include <boost/foreach.hpp>
 
@@ -34,7 +37,8 @@ PHG4OuterHcalSubsystem::PHG4OuterHcalSubsystem( const std::string &name, const i
   PHG4DetectorSubsystem( name, lyr ),
   m_Detector( nullptr ),
   m_SteppingAction( nullptr ),
-  m_DisplayAction(nullptr)
+  m_DisplayAction(nullptr),
+  m_CellAccumulator(nullptr)
 {
   InitializeParameters();
 }
@@ -43,6 +47,7 @@ PHG4OuterHcalSubsystem::PHG4OuterHcalSubsystem( const std::string &name, const i
 PHG4OuterHcalSubsystem::~PHG4OuterHcalSubsystem()
 {
   delete m_DisplayAction;
+  delete m_CellAccumulator;
 }
 
 //_______________________________________________________________________
@@ -102,8 +107,24 @@ PHG4OuterHcalSubsystem::InitRunSubsystem( PHCompositeNode* topNode )
 	    }
 	}
       // create stepping action
-      m_SteppingAction = new PHG4OuterHcalSteppingAction(m_Detector, GetParams());
+      PHG4OuterHcalSteppingAction *steppingaction = new PHG4OuterHcalSteppingAction(m_Detector, GetParams());
+      m_SteppingAction = steppingaction;
       m_SteppingAction->Init();
+
+      // direct to cell mode, the scintillator energy goes to G4CELL without hits
+      if (GetParams()->get_int_param("direct_cells"))
+	{
+	  m_CellNodeName = "G4CELL_" + ((SuperDetector() != "NONE") ? SuperDetector() : Name());
+	  PHG4CellContainer *cells = findNode::getClass<PHG4CellContainer>(topNode, m_CellNodeName);
+	  if (!cells)
+	    {
+	      cells = new PHG4CellContainer();
+	      DetNode->addNode(new PHIODataNode<PHObject>(cells, m_CellNodeName, "PHObject"));
+	    }
+	  m_CellAccumulator = new PHG4SlatCellAccumulator(GetParams()->get_int_param("n_towers") * GetParams()->get_int_param(PHG4HcalDefs::scipertwr),
+							  2 * GetParams()->get_int_param("n_scinti_tiles"));
+	  steppingaction->SetCellAccumulator(m_CellAccumulator);
+	}
     }
   else
     {
@@ -130,6 +151,23 @@ PHG4OuterHcalSubsystem::process_event( PHCompositeNode * topNode )
     return 0;
 }
 
+//_______________________________________________________________________
+int
+PHG4OuterHcalSubsystem::process_after_geant( PHCompositeNode * topNode )
+{
+  if (m_CellAccumulator)
+    {
+      PHG4CellContainer *cells = findNode::getClass<PHG4CellContainer>(topNode, m_CellNodeName);
+      if (! cells)
+	{
+	  cout << PHWHERE << " could not locate cell node " << m_CellNodeName << endl;
+	  return -1;
+	}
+      m_CellAccumulator->AddToCells(cells);
+    }
+  return 0;
+}
+
 void
 PHG4OuterHcalSubsystem::Print(const string &what) const
 {
@@ -162,6 +200,9 @@ PHG4OuterHcalSubsystem::SetLightCorrection(const double inner_radius, const doub
 void
 PHG4OuterHcalSubsystem::SetDefaultParameters()
 {
+  // timing window of the direct to cell mode, as in PHG4HcalCellReco
+  set_default_double_param("direct_cells_tmax", 60.0);
+  set_default_double_param("direct_cells_tmin", -20.0);
   set_default_double_param("inner_radius", 183.3);
   set_default_double_param("light_balance_inner_corr", NAN);
   set_default_double_param("light_balance_inner_radius", NAN);
@@ -197,6 +238,8 @@ PHG4OuterHcalSubsystem::SetDefaultParameters()
   set_default_double_param("tilt_angle", -11.23); // engineering drawing
 // corresponds very closely to 4 crossinge (-11.7826 deg)
 
+  // sum the scintillator energy directly in G4CELL instead of G4HIT (no PHG4HcalCellReco)
+  set_default_int_param("direct_cells", 0);
   set_default_int_param("field_check", 0);
   set_default_int_param("light_scint_model", 1);
   set_default_int_param("magnet_cutout_first_scinti", 8); // tile start at 0, drawing tile starts at 1
@@ -0,0 +1,112 @@
+#include "PHG4SlatCellAccumulator.h"
+
+#include "PHG4CellContainer.h"
+#include "PHG4CellDefs.h"  // for genkey, keytype
+#include "PHG4Cellv1.h"
+
+#include <algorithm>  // for sort, max
+#include <iostream>
+
+using namespace std;
+
+PHG4SlatCellAccumulator::PHG4SlatCellAccumulator(const int nlayers, const int ntowers)
+  : m_NLayers(max(nlayers, 1))
+  , m_NTowers(max(ntowers, 1))
+  , m_Edep(m_NLayers * m_NTowers, 0.)
+  , m_Eion(m_NLayers * m_NTowers, 0.)
+  , m_LightYield(m_NLayers * m_NTowers, 0.)
+  , m_ShowerEdep(m_NLayers * m_NTowers)
+  , m_Used(m_NLayers * m_NTowers, 0)
+{
+}
+
+void PHG4SlatCellAccumulator::AddStep(const int layer_id, const int tower_id, const double edep, const double eion, const double light_yield, const int showerid)
+{
+  if (layer_id < 0 || tower_id < 0)
+  {
+    cout << "PHG4SlatCellAccumulator::AddStep - invalid slat, layer " << layer_id
+         << ", tower " << tower_id << endl;
+    return;
+  }
+  if (layer_id >= m_NLayers || tower_id >= m_NTowers)
+  {
+    Grow(layer_id, tower_id);
+  }
+  const int index = layer_id * m_NTowers + tower_id;
+  if (!m_Used[index])
+  {
+    m_Used[index] = 1;
+    m_UsedIndex.push_back(index);
+  }
+  m_Edep[index] += edep;
+  m_Eion[index] += eion;
+  m_LightYield[index] += light_yield;
+
+  // consecutive steps are mostly from the same shower, search from the back
+  vector<pair<int, double> > &showers = m_ShowerEdep[index];
+  for (vector<pair<int, double> >::reverse_iterator iter = showers.rbegin(); iter != showers.rend(); ++iter)
+  {
+    if (iter->first == showerid)
+    {
+      iter->second += edep;
+      return;
+    }
+  }
+  showers.push_back(make_pair(showerid, edep));
+}
+
+void PHG4SlatCellAccumulator::AddToCells(PHG4CellContainer *cells)
+{
+  sort(m_UsedIndex.begin(), m_UsedIndex.end());
+  for (const int index : m_UsedIndex)
+  {
+    const unsigned short layer_id = index / m_NTowers;
+    const unsigned short tower_id = index % m_NTowers;
+    // same key as PHG4HcalCellReco, hcal has no layers use 0 as layer number
+    PHG4Cell *cell = new PHG4Cellv1(PHG4CellDefs::ScintillatorSlatBinning::genkey(0, tower_id, layer_id));
+    cell->add_edep(m_Edep[index]);
+    cell->add_eion(m_Eion[index]);
+    cell->add_light_yield(m_LightYield[index]);
+    for (const pair<int, double> &shower : m_ShowerEdep[index])
+    {
+      cell->add_shower_edep(shower.first, shower.second);
+    }
+    cells->AddCell(cell);
+
+    m_Edep[index] = 0.;
+    m_Eion[index] = 0.;
+    m_LightYield[index] = 0.;
+    m_ShowerEdep[index].clear();
+    m_Used[index] = 0;
+  }
+  m_UsedIndex.clear();
+}
+
+void PHG4SlatCellAccumulator::Grow(const int layer_id, const int tower_id)
+{
+  const int nlayers = max(m_NLayers, layer_id + 1);
+  const int ntowers = max(m_NTowers, tower_id + 1);
+  const int ncells = nlayers * ntowers;
+  vector<double> edep(ncells, 0.);
+  vector<double> eion(ncells, 0.);
+  vector<double> light_yield(ncells, 0.);
+  vector<vector<pair<int, double> > > shower_edep(ncells);
+  vector<char> used(ncells, 0);
+  for (int &index : m_UsedIndex)
+  {
+    const int newindex = (index / m_NTowers) * ntowers + index % m_NTowers;
+    edep[newindex] = m_Edep[index];
+    eion[newindex] = m_Eion[index];
+    light_yield[newindex] = m_LightYield[index];
+    shower_edep[newindex].swap(m_ShowerEdep[index]);
+    used[newindex] = 1;
+    index = newindex;
+  }
+  m_NLayers = nlayers;
+  m_NTowers = ntowers;
+  m_Edep.swap(edep);
+  m_Eion.swap(eion);
+  m_LightYield.swap(light_yield);
+  m_ShowerEdep.swap(shower_edep);
+  m_Used.swap(used);
+}
@@ -0,0 +1,53 @@
+// Tell emacs that this is a C++ source
+//  -*- C++ -*-.
+#ifndef G4DETECTORS_PHG4SLATCELLACCUMULATOR_H
+#define G4DETECTORS_PHG4SLATCELLACCUMULATOR_H
+
+#include <utility>  // for pair
+#include <vector>
+
+class PHG4CellContainer;
+
+/*!
+ * \brief per event sums of the scintillator slats of a hcal, filled step by step
+ *
+ * Direct to cell mode of the hcal stepping actions: the energy of the
+ * scintillator steps goes into a dense (layer, tower) grid instead of
+ * PHG4Hits, AddToCells then stores the slats with energy as the same
+ * PHG4Cells PHG4HcalCellReco makes from the hits. The truth is kept as
+ * the list of (shower id, edep) of each slat, the PHG4Cells have no g4hit ids.
+ * The grid grows if a slat is outside of it.
+ */
+class PHG4SlatCellAccumulator
+{
+ public:
+  //! nlayers scintillator layers (the hit layer) with ntowers slats (the scint id)
+  PHG4SlatCellAccumulator(const int nlayers, const int ntowers);
+  virtual ~PHG4SlatCellAccumulator() {}
+
+  //! add one step
+  void AddStep(const int layer_id, const int tower_id, const double edep, const double eion, const double light_yield, const int showerid);
+
+  //! move the slats with energy to the cells (ScintillatorSlatBinning as in
+  //! PHG4HcalCellReco) and clear the grid for the next event
+  void AddToCells(PHG4CellContainer *cells);
+
+ private:
+  //! resize the grid to contain the slat
+  void Grow(const int layer_id, const int tower_id);
+
+  int m_NLayers;
+  int m_NTowers;
+
+  //! sums per slat, index layer_id * m_NTowers + tower_id
+  std::vector<double> m_Edep;
+  std::vector<double> m_Eion;
+  std::vector<double> m_LightYield;
+  std::vector<std::vector<std::pair<int, double> > > m_ShowerEdep;
+
+  //! slats which got a step in this event
+  std::vector<char> m_Used;
+  std::vector<int> m_UsedIndex;
+};
+
+#endif
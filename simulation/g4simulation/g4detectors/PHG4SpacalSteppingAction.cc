@@ -8,11 +8,11 @@
 
 #include "PHG4SpacalSteppingAction.h"
 #include "PHG4CylinderGeom_Spacalv3.h"
+#include "PHG4FrozenShowerLibrary.h"
 #include "PHG4SpacalDetector.h"
 
 #include <g4main/PHG4HitContainer.h>
 #include <g4main/PHG4Hit.h>                   // for PHG4Hit
-#include <g4main/PHG4Hitv1.h>
 #include <g4main/PHG4Shower.h>
 #include <g4main/PHG4SteppingAction.h>        // for PHG4SteppingAction
 #include <g4main/PHG4TrackUserInfoV1.h>
@@ -22,6 +22,8 @@
 #include <Geant4/G4IonisParamMat.hh>          // for G4IonisParamMat
 #include <Geant4/G4Material.hh>               // for G4Material
 #include <Geant4/G4MaterialCutsCouple.hh>
+#include <Geant4/G4NavigationHistory.hh>
+#include <Geant4/G4Navigator.hh>
 #include <Geant4/G4ParticleDefinition.hh>     // for G4ParticleDefinition
 #include <Geant4/G4Step.hh>
 #include <Geant4/G4StepPoint.hh>              // for G4StepPoint
@@ -30,16 +32,22 @@
 #include <Geant4/G4SystemOfUnits.hh>
 #include <Geant4/G4ThreeVector.hh>            // for G4ThreeVector
 #include <Geant4/G4TouchableHandle.hh>        // for G4TouchableHandle
+#include <Geant4/G4TouchableHistory.hh>
 #include <Geant4/G4Track.hh>                  // for G4Track
 #include <Geant4/G4TrackStatus.hh>            // for fStopAndKill
+#include <Geant4/G4TransportationManager.hh>
 #include <Geant4/G4Types.hh>                  // for G4double
 #include <Geant4/G4VTouchable.hh>             // for G4VTouchable
 #include <Geant4/G4VUserTrackInformation.hh>  // for G4VUserTrackInformation
+#include <Geant4/Randomize.hh>                // for G4UniformRand
 
 #include <cmath>                              // for isfinite
 #include <cstdlib>                           // for exit
 #include <iostream>
+#include <map>
 #include <string>                             // for operator<<, char_traits
+#include <utility>                            // for pair
+#include <vector>
 
 class G4VPhysicalVolume;
 class PHCompositeNode;
@@ -51,10 +59,18 @@ PHG4SpacalSteppingAction::PHG4SpacalSteppingAction(PHG4SpacalDetector* detector)
                                                                                    hits_(nullptr),
                                                                                    absorberhits_(nullptr),
                                                                                    hit(nullptr),
+                                                                                   m_HitVersion(PHG4HitContainer::HitVersion()),
                                                                                    savehitcontainer(nullptr),
                                                                                    saveshower(nullptr),
                                                                                    savetrackid(-1),
-                                                                                   savepoststepstatus(-1)
+                                                                                   savepoststepstatus(-1),
+                                                                                   m_FrozenShowers(nullptr),
+                                                                                   m_FrozenShowerEmax(0),
+                                                                                   m_Navigator(nullptr),
+                                                                                   m_Touchable(nullptr),
+                                                                                   m_ShowerRecorder(nullptr),
+                                                                                   m_RecordingShower(false),
+                                                                                   m_RecordT0(0)
 {
 }
 
@@ -65,6 +81,8 @@ PHG4SpacalSteppingAction::~PHG4SpacalSteppingAction()
   // if the last hit was saved, hit is a nullptr pointer which are
   // legal to delete (it results in a no operation)
   delete hit;
+  delete m_Touchable;
+  delete m_Navigator;
 }
 
 //____________________________________________________________________________..
@@ -87,6 +105,16 @@ bool PHG4SpacalSteppingAction::UserSteppingAction(const G4Step* aStep, bool)
   int isactive = detector_->IsInCylinderActive(volume);
   if (isactive > PHG4SpacalDetector::INACTIVE)
   {
+    // fast simulation, e+/e-/photons entering the calorimeter deposit a frozen shower
+    if (m_FrozenShowers && FrozenShower(aStep))
+    {
+      return true;
+    }
+    if (m_ShowerRecorder)
+    {
+      RecordStep(aStep, isactive);
+    }
+
     bool geantino = false;
     // the check for the pdg code speeds things up, I do not want to make
     // an expensive string compare for every track when we know
@@ -97,65 +125,7 @@ bool PHG4SpacalSteppingAction::UserSteppingAction(const G4Step* aStep, bool)
     }
     G4StepPoint* prePoint = aStep->GetPreStepPoint();
     G4StepPoint* postPoint = aStep->GetPostStepPoint();
-    int scint_id = -1;
-
-    if (                                                                                                                          //
-        detector_->get_geom()->get_config() == PHG4SpacalDetector::SpacalGeom_t::kFullProjective_2DTaper                          //
-        or                                                                                                                        //
-        detector_->get_geom()->get_config() == PHG4SpacalDetector::SpacalGeom_t::kFullProjective_2DTaper_SameLengthFiberPerTower  //
-        or                                                                                                                        //
-        detector_->get_geom()->get_config() == PHG4SpacalDetector::SpacalGeom_t::kFullProjective_2DTaper_Tilted  //
-        or                                                                                                                        //
-        detector_->get_geom()->get_config() == PHG4SpacalDetector::SpacalGeom_t::kFullProjective_2DTaper_Tilted_SameLengthFiberPerTower  //
-        )
-    {
-      //SPACAL ID that is associated with towers
-      int sector_ID = 0;
-      int tower_ID = 0;
-      int fiber_ID = 0;
-
-      if (isactive == PHG4SpacalDetector::FIBER_CORE)
-      {
-        fiber_ID = prePoint->GetTouchable()->GetReplicaNumber(1);
-        tower_ID = prePoint->GetTouchable()->GetReplicaNumber(2);
-        sector_ID = prePoint->GetTouchable()->GetReplicaNumber(3);
-      }
-
-      else if (isactive == PHG4SpacalDetector::FIBER_CLADING)
-      {
-        fiber_ID = prePoint->GetTouchable()->GetReplicaNumber(0);
-        tower_ID = prePoint->GetTouchable()->GetReplicaNumber(1);
-        sector_ID = prePoint->GetTouchable()->GetReplicaNumber(2);
-      }
-
-      else if (isactive == PHG4SpacalDetector::ABSORBER)
-      {
-        tower_ID = prePoint->GetTouchable()->GetReplicaNumber(0);
-        sector_ID = prePoint->GetTouchable()->GetReplicaNumber(1);
-      }
-
-      else if (isactive == PHG4SpacalDetector::SUPPORT)
-      {
-        tower_ID = prePoint->GetTouchable()->GetReplicaNumber(0);
-        sector_ID = prePoint->GetTouchable()->GetReplicaNumber(1);
-        fiber_ID =  (1 << (PHG4CylinderGeom_Spacalv3::scint_id_coder::kfiber_bit)) - 1; // use max fiber ID to flag for support strucrtures.
-
-//        cout <<"PHG4SpacalSteppingAction::UserSteppingAction - SUPPORT tower_ID = "<<tower_ID<<endl;
-      }
-
-      // compact the tower/sector/fiber ID into 32 bit scint_id, so we could save some space for SPACAL hits
-      scint_id = PHG4CylinderGeom_Spacalv3::scint_id_coder(sector_ID, tower_ID, fiber_ID).scint_ID;
-    }
-    else
-    {
-      // other configuraitons
-      if (isactive == PHG4SpacalDetector::FIBER_CORE)
-        scint_id = prePoint->GetTouchable()->GetReplicaNumber(2);
-      else if (isactive == PHG4SpacalDetector::FIBER_CLADING)
-        scint_id = prePoint->GetTouchable()->GetReplicaNumber(1);
-      else
-        scint_id = prePoint->GetTouchable()->GetReplicaNumber(0);
-    }
+    int scint_id = GetScintId(prePoint->GetTouchable(), isactive);
 
     //       cout << "track id " << aTrack->GetTrackID() << endl;
     //        cout << "time prepoint: " << prePoint->GetGlobalTime() << endl;
@@ -168,7 +138,7 @@ bool PHG4SpacalSteppingAction::UserSteppingAction(const G4Step* aStep, bool)
       // and we have to make a new one
       if (!hit)
       {
-        hit = new PHG4Hitv1();
+        hit = PHG4HitContainer::NewHit(m_HitVersion);
       }
       hit->set_layer((unsigned int) layer_id);
       hit->set_scint_id(scint_id);  // isactive contains the scintillator slat id
@@ -346,6 +316,304 @@ bool PHG4SpacalSteppingAction::UserSteppingAction(const G4Step* aStep, bool)
   }
 }
 
+//____________________________________________________________________________..
+int PHG4SpacalSteppingAction::GetScintId(const G4VTouchable* touch, const int isactive) const
+{
+  int scint_id = -1;
+
+  if (                                                                                                                          //
+        detector_->get_geom()->get_config() == PHG4SpacalDetector::SpacalGeom_t::kFullProjective_2DTaper                          //
+        or                                                                                                                        //
+        detector_->get_geom()->get_config() == PHG4SpacalDetector::SpacalGeom_t::kFullProjective_2DTaper_SameLengthFiberPerTower  //
+        or                                                                                                                        //
+        detector_->get_geom()->get_config() == PHG4SpacalDetector::SpacalGeom_t::kFullProjective_2DTaper_Tilted  //
+        or                                                                                                                        //
+        detector_->get_geom()->get_config() == PHG4SpacalDetector::SpacalGeom_t::kFullProjective_2DTaper_Tilted_SameLengthFiberPerTower  //
+        )
+  {
+    //SPACAL ID that is associated with towers
+    int sector_ID = 0;
+    int tower_ID = 0;
+    int fiber_ID = 0;
+
+    if (isactive == PHG4SpacalDetector::FIBER_CORE)
+    {
+      fiber_ID = touch->GetReplicaNumber(1);
+      tower_ID = touch->GetReplicaNumber(2);
+      sector_ID = touch->GetReplicaNumber(3);
+    }
+
+    else if (isactive == PHG4SpacalDetector::FIBER_CLADING)
+    {
+      fiber_ID = touch->GetReplicaNumber(0);
+      tower_ID = touch->GetReplicaNumber(1);
+      sector_ID = touch->GetReplicaNumber(2);
+    }
+
+    else if (isactive == PHG4SpacalDetector::ABSORBER)
+    {
+      tower_ID = touch->GetReplicaNumber(0);
+      sector_ID = touch->GetReplicaNumber(1);
+    }
+
+    else if (isactive == PHG4SpacalDetector::SUPPORT)
+    {
+      tower_ID = touch->GetReplicaNumber(0);
+      sector_ID = touch->GetReplicaNumber(1);
+      fiber_ID =  (1 << (PHG4CylinderGeom_Spacalv3::scint_id_coder::kfiber_bit)) - 1; // use max fiber ID to flag for support strucrtures.
+
+//        cout <<"PHG4SpacalSteppingAction::UserSteppingAction - SUPPORT tower_ID = "<<tower_ID<<endl;
+    }
+
+    // compact the tower/sector/fiber ID into 32 bit scint_id, so we could save some space for SPACAL hits
+    scint_id = PHG4CylinderGeom_Spacalv3::scint_id_coder(sector_ID, tower_ID, fiber_ID).scint_ID;
+  }
+  else
+  {
+    // other configuraitons
+    if (isactive == PHG4SpacalDetector::FIBER_CORE)
+      scint_id = touch->GetReplicaNumber(2);
+    else if (isactive == PHG4SpacalDetector::FIBER_CLADING)
+      scint_id = touch->GetReplicaNumber(1);
+    else
+      scint_id = touch->GetReplicaNumber(0);
+  }
+  return scint_id;
+}
+
+//____________________________________________________________________________..
+void PHG4SpacalSteppingAction::SetFrozenShowers(const PHG4FrozenShowerLibrary* library, const double emax)
+{
+  m_FrozenShowers = library;
+  m_FrozenShowerEmax = emax;
+}
+
+//____________________________________________________________________________..
+bool PHG4SpacalSteppingAction::FrozenShower(const G4Step* aStep)
+{
+  const G4Track* aTrack = aStep->GetTrack();
+  G4StepPoint* prePoint = aStep->GetPreStepPoint();
+  // only where the particle enters the calorimeter or is created in it
+  if (prePoint->GetStepStatus() != fGeomBoundary && aTrack->GetCurrentStepNumber() != 1)
+  {
+    return false;
+  }
+  const int type = PHG4FrozenShowerLibrary::GetParticleType(aTrack->GetParticleDefinition()->GetPDGEncoding());
+  if (type < 0)
+  {
+    return false;
+  }
+  const double energy = prePoint->GetKineticEnergy() / GeV;
+  if (energy > m_FrozenShowerEmax || energy <= 0)
+  {
+    return false;
+  }
+  const G4ThreeVector& entry = prePoint->GetPosition();
+  const G4ThreeVector& direction = prePoint->GetMomentumDirection();
+  const PHG4FrozenShowerLibrary::Shower* shower = m_FrozenShowers->Find(type, energy, CosIncidence(entry, direction), entry.eta(), G4UniformRand());
+  if (!shower)
+  {
+    // nothing in the library, geant continues with this particle
+    return false;
+  }
+  DepositShower(aStep, *shower, energy / shower->energy);
+
+  // the library shower replaces everything this particle would have done
+  G4Track* killtrack = const_cast<G4Track*>(aTrack);
+  killtrack->SetTrackStatus(fStopAndKill);
+  const std::vector<const G4Track*>* secondaries = aStep->GetSecondaryInCurrentStep();
+  for (const G4Track* secondary : *secondaries)
+  {
+    const_cast<G4Track*>(secondary)->SetTrackStatus(fStopAndKill);
+  }
+  return true;
+}
+
+//____________________________________________________________________________..
+void PHG4SpacalSteppingAction::DepositShower(const G4Step* aStep, const PHG4FrozenShowerLibrary::Shower& shower, const double scale)
+{
+  if (!m_Navigator)
+  {
+    m_Navigator = new G4Navigator();
+    m_Navigator->SetWorldVolume(G4TransportationManager::GetTransportationManager()->GetNavigatorForTracking()->GetWorldVolume());
+    m_Touchable = new G4TouchableHistory();
+  }
+  const G4Track* aTrack = aStep->GetTrack();
+  G4StepPoint* prePoint = aStep->GetPreStepPoint();
+  const G4ThreeVector& entry = prePoint->GetPosition();
+  const G4ThreeVector& direction = prePoint->GetMomentumDirection();
+  const double t0 = prePoint->GetGlobalTime() / nanosecond;
+  G4ThreeVector transverse_x;
+  G4ThreeVector transverse_y;
+  ShowerFrame(direction, transverse_x, transverse_y);
+
+  int trkid = aTrack->GetTrackID();
+  PHG4Shower* shower_truth = nullptr;
+  if (G4VUserTrackInformation* p = aTrack->GetUserInformation())
+  {
+    if (PHG4TrackUserInfoV1* pp = dynamic_cast<PHG4TrackUserInfoV1*>(p))
+    {
+      trkid = pp->GetUserTrackId();
+      shower_truth = pp->GetShower();
+      pp->SetKeep(1);  // we want to keep the track
+    }
+  }
+
+  // one hit per volume as for a single track, key is (isactive, scint_id)
+  map<pair<int, int>, PHG4Hit*> showerhits;
+  const int layer_id = detector_->get_Layer();
+  for (const PHG4FrozenShowerLibrary::Spot& spot : shower.spots)
+  {
+    const G4ThreeVector position = entry + (spot.longitudinal * direction + spot.transverse_x * transverse_x + spot.transverse_y * transverse_y) * cm;
+    m_Navigator->LocateGlobalPointAndUpdateTouchable(position, m_Touchable, false);
+    G4VPhysicalVolume* volume = m_Touchable->GetVolume();
+    if (!volume)
+    {
+      continue;
+    }
+    // deposits outside of the calorimeter are lost
+    const int isactive = detector_->IsInCylinderActive(volume);
+    if (isactive <= PHG4SpacalDetector::INACTIVE)
+    {
+      continue;
+    }
+    if (isactive != PHG4SpacalDetector::FIBER_CORE && !absorberhits_)
+    {
+      continue;
+    }
+    const int scint_id = GetScintId(m_Touchable, isactive);
+    const double t = t0 + spot.time;
+    const G4ThreeVector localPosition = m_Touchable->GetHistory()->GetTopTransform().TransformPoint(position);
+    PHG4Hit*& showerhit = showerhits[make_pair(isactive, scint_id)];
+    if (!showerhit)
+    {
+      showerhit = PHG4HitContainer::NewHit(m_HitVersion);
+      showerhit->set_layer((unsigned int) layer_id);
+      showerhit->set_scint_id(scint_id);
+      showerhit->set_x(0, position.x() / cm);
+      showerhit->set_y(0, position.y() / cm);
+      showerhit->set_z(0, position.z() / cm);
+      showerhit->set_t(0, t);
+      showerhit->set_trkid(trkid);
+      if (shower_truth)
+      {
+        showerhit->set_shower_id(shower_truth->get_id());
+      }
+      showerhit->set_edep(0);
+      if (isactive == PHG4SpacalDetector::FIBER_CORE)
+      {
+        showerhit->set_local_x(0, localPosition.x() / cm);
+        showerhit->set_local_y(0, localPosition.y() / cm);
+        showerhit->set_local_z(0, localPosition.z() / cm);
+        showerhit->set_eion(0);
+        showerhit->set_light_yield(0);
+      }
+    }
+    showerhit->set_x(1, position.x() / cm);
+    showerhit->set_y(1, position.y() / cm);
+    showerhit->set_z(1, position.z() / cm);
+    showerhit->set_t(1, t);
+    showerhit->set_edep(showerhit->get_edep() + spot.edep * scale);
+    if (isactive == PHG4SpacalDetector::FIBER_CORE)
+    {
+      showerhit->set_local_x(1, localPosition.x() / cm);
+      showerhit->set_local_y(1, localPosition.y() / cm);
+      showerhit->set_local_z(1, localPosition.z() / cm);
+      // the library keeps the total deposit, all of it counts as ionization
+      showerhit->set_eion(showerhit->get_eion() + spot.edep * scale);
+      showerhit->set_light_yield(showerhit->get_light_yield() + spot.light_yield * scale);
+    }
+  }
+
+  for (map<pair<int, int>, PHG4Hit*>::const_iterator iter = showerhits.begin(); iter != showerhits.end(); ++iter)
+  {
+    PHG4HitContainer* container = (iter->first.first == PHG4SpacalDetector::FIBER_CORE) ? hits_ : absorberhits_;
+    container->AddHit(layer_id, iter->second);
+    if (shower_truth)
+    {
+      shower_truth->add_g4hit_id(container->GetID(), iter->second->get_hit_id());
+    }
+  }
+}
+
+//____________________________________________________________________________..
+void PHG4SpacalSteppingAction::RecordStep(const G4Step* aStep, const int isactive)
+{
+  const G4Track* aTrack = aStep->GetTrack();
+  G4StepPoint* prePoint = aStep->GetPreStepPoint();
+  G4StepPoint* postPoint = aStep->GetPostStepPoint();
+  // the shower starts where the primary particle enters the calorimeter,
+  // all deposits of the event belong to it (single particle events)
+  if (!m_RecordingShower)
+  {
+    const int type = PHG4FrozenShowerLibrary::GetParticleType(aTrack->GetParticleDefinition()->GetPDGEncoding());
+    if (aTrack->GetParentID() != 0 || type < 0)
+    {
+      return;
+    }
+    m_RecordingShower = true;
+    m_RecordEntry = prePoint->GetPosition();
+    m_RecordDirection = prePoint->GetMomentumDirection();
+    ShowerFrame(m_RecordDirection, m_RecordTransverseX, m_RecordTransverseY);
+    m_RecordT0 = prePoint->GetGlobalTime() / nanosecond;
+    m_RecordedShower.type = type;
+    m_RecordedShower.energy = prePoint->GetKineticEnergy() / GeV;
+    m_RecordedShower.cos_incidence = CosIncidence(m_RecordEntry, m_RecordDirection);
+    m_RecordedShower.eta = m_RecordEntry.eta();
+    m_RecordedShower.spots.clear();
+  }
+  const double edep = aStep->GetTotalEnergyDeposit() / GeV;
+  if (edep <= 0)
+  {
+    return;
+  }
+  const G4ThreeVector position = 0.5 * (prePoint->GetPosition() + postPoint->GetPosition()) - m_RecordEntry;
+  PHG4FrozenShowerLibrary::Spot spot;
+  spot.longitudinal = position.dot(m_RecordDirection) / cm;
+  spot.transverse_x = position.dot(m_RecordTransverseX) / cm;
+  spot.transverse_y = position.dot(m_RecordTransverseY) / cm;
+  spot.time = 0.5 * (prePoint->GetGlobalTime() + postPoint->GetGlobalTime()) / nanosecond - m_RecordT0;
+  spot.edep = edep;
+  spot.light_yield = (isactive == PHG4SpacalDetector::FIBER_CORE) ? GetVisibleEnergyDeposition(aStep) : 0;
+  m_RecordedShower.spots.push_back(spot);
+}
+
+//____________________________________________________________________________..
+void PHG4SpacalSteppingAction::EndRecordedShower()
+{
+  if (m_ShowerRecorder && m_RecordingShower && !m_RecordedShower.spots.empty())
+  {
+    m_ShowerRecorder->AddShower(m_RecordedShower);
+  }
+  m_RecordingShower = false;
+  m_RecordedShower.spots.clear();
+}
+
+//____________________________________________________________________________..
+double PHG4SpacalSteppingAction::CosIncidence(const G4ThreeVector& entry, const G4ThreeVector& direction)
+{
+  // incidence with respect to the radial direction, the normal of the cylinder
+  G4ThreeVector radial(entry.x(), entry.y(), 0);
+  if (radial.mag2() <= 0)
+  {
+    return 1.;
+  }
+  return direction.dot(radial.unit());
+}
+
+//____________________________________________________________________________..
+void PHG4SpacalSteppingAction::ShowerFrame(const G4ThreeVector& direction, G4ThreeVector& transverse_x, G4ThreeVector& transverse_y)
+{
+  // fixed with respect to the detector, the fibers are not symmetric around the shower axis
+  transverse_x = direction.cross(G4ThreeVector(0, 0, 1));
+  if (transverse_x.mag2() < 1e-12)
+  {
+    transverse_x = direction.orthogonal();
+  }
+  transverse_x = transverse_x.unit();
+  transverse_y = direction.cross(transverse_x);
+}
+
 //____________________________________________________________________________..
 void PHG4SpacalSteppingAction::SetInterfacePointers(PHCompositeNode* topNode)
 {
@@ -11,9 +11,16 @@
 #ifndef G4DETECTORS_PHG4SPACALSTEPPINGACTION_H
 #define G4DETECTORS_PHG4SPACALSTEPPINGACTION_H
 
+#include "PHG4FrozenShowerLibrary.h"
+
 #include <g4main/PHG4SteppingAction.h>
 
+#include <Geant4/G4ThreeVector.hh>
+
+class G4Navigator;
 class G4Step;
+class G4TouchableHistory;
+class G4VTouchable;
 class PHCompositeNode;
 class PHG4SpacalDetector;
 class PHG4Hit;
@@ -43,7 +50,27 @@ class PHG4SpacalSteppingAction : public PHG4SteppingAction
   double
   get_zmax();
 
+  //! fast simulation: e+/e-/photons up to emax (GeV) which enter the calorimeter
+  //! are killed and deposit a shower of the library instead
+  void SetFrozenShowers(const PHG4FrozenShowerLibrary *library, const double emax);
+
+  //! library generation: the shower of the primary particle of each event is
+  //! recorded, EndRecordedShower() adds it to the library
+  void RecordFrozenShowers(PHG4FrozenShowerLibrary *library) { m_ShowerRecorder = library; }
+  void EndRecordedShower();
+
  private:
+  //! tower/sector/fiber id of a volume, isactive from PHG4SpacalDetector::IsInCylinderActive
+  int GetScintId(const G4VTouchable *touch, const int isactive) const;
+
+  //! replace the particle by a frozen shower, false if it is not parameterized
+  bool FrozenShower(const G4Step *aStep);
+  void DepositShower(const G4Step *aStep, const PHG4FrozenShowerLibrary::Shower &shower, const double scale);
+  void RecordStep(const G4Step *aStep, const int isactive);
+
+  static double CosIncidence(const G4ThreeVector &entry, const G4ThreeVector &direction);
+  static void ShowerFrame(const G4ThreeVector &direction, G4ThreeVector &transverse_x, G4ThreeVector &transverse_y);
+
   //! pointer to the detector
   PHG4SpacalDetector *detector_;
 
@@ -51,10 +78,29 @@ class PHG4SpacalSteppingAction : public PHG4SteppingAction
   PHG4HitContainer *hits_;
   PHG4HitContainer *absorberhits_;
   PHG4Hit *hit;
+  //! PHG4Hit version created, PHG4HitContainer::HitVersion()
+  int m_HitVersion;
   PHG4HitContainer *savehitcontainer;
   PHG4Shower *saveshower;
   int savetrackid;
   int savepoststepstatus;
+
+  //! frozen shower library of the fast simulation (not owned)
+  const PHG4FrozenShowerLibrary *m_FrozenShowers;
+  double m_FrozenShowerEmax;
+  //! locates the deposits of the frozen showers
+  G4Navigator *m_Navigator;
+  G4TouchableHistory *m_Touchable;
+
+  //! library generation (not owned)
+  PHG4FrozenShowerLibrary *m_ShowerRecorder;
+  bool m_RecordingShower;
+  PHG4FrozenShowerLibrary::Shower m_RecordedShower;
+  G4ThreeVector m_RecordEntry;
+  G4ThreeVector m_RecordDirection;
+  G4ThreeVector m_RecordTransverseX;
+  G4ThreeVector m_RecordTransverseY;
+  double m_RecordT0;
 };
 
 #endif  // PHG4VHcalSteppingAction_h
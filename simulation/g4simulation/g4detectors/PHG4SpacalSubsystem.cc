@@ -9,6 +9,7 @@
 
 #include "PHG4SpacalDisplayAction.h"
 #include "PHG4CylinderGeom_Spacalv1.h"         // for PHG4CylinderGeom_Spacalv1
+#include "PHG4FrozenShowerLibrary.h"
 #include "PHG4FullProjSpacalDetector.h"
 #include "PHG4FullProjTiltedSpacalDetector.h"
 #include "PHG4SpacalDetector.h"
@@ -42,6 +43,7 @@ PHG4SpacalSubsystem::PHG4SpacalSubsystem(const std::string& na, const int lyr)
   , detector_(nullptr)
   , steppingAction_(nullptr)
   , m_DisplayAction(nullptr)
+  , m_FrozenShowers(nullptr)
 {
   InitializeParameters();
 }
@@ -50,6 +52,7 @@ PHG4SpacalSubsystem::PHG4SpacalSubsystem(const std::string& na, const int lyr)
 PHG4SpacalSubsystem::~PHG4SpacalSubsystem()
 {
   delete m_DisplayAction;
+  delete m_FrozenShowers;
 }
 
 //_______________________________________________________________________
@@ -136,7 +139,33 @@ int PHG4SpacalSubsystem::InitRunSubsystem(PHCompositeNode* topNode)
       }
       absorber_hits->AddLayer(GetLayer());
     }
-    steppingAction_ = new PHG4SpacalSteppingAction(detector_);
+    PHG4SpacalSteppingAction* steppingaction = new PHG4SpacalSteppingAction(detector_);
+    steppingAction_ = steppingaction;
+
+    // frozen showers: fast simulation with a shower library or generation of the library
+    const string library = GetParams()->get_string_param("frozen_shower_library");
+    if (!library.empty())
+    {
+      m_FrozenShowers = new PHG4FrozenShowerLibrary();
+      if (GetParams()->get_int_param("frozen_shower_record"))
+      {
+        steppingaction->RecordFrozenShowers(m_FrozenShowers);
+      }
+      else
+      {
+        if (m_FrozenShowers->Load(library))
+        {
+          cout << "PHG4SpacalSubsystem::InitRun - could not load frozen shower library "
+               << library << ", exiting" << endl;
+          gSystem->Exit(1);
+        }
+        if (Verbosity() > 0)
+        {
+          m_FrozenShowers->Print();
+        }
+        steppingaction->SetFrozenShowers(m_FrozenShowers, GetParams()->get_double_param("frozen_shower_emax"));
+      }
+    }
   }
   return 0;
 }
@@ -153,6 +182,35 @@ int PHG4SpacalSubsystem::process_event(PHCompositeNode* topNode)
   return 0;
 }
 
+//_______________________________________________________________________
+int PHG4SpacalSubsystem::process_after_geant(PHCompositeNode* topNode)
+{
+  if (m_FrozenShowers && GetParams()->get_int_param("frozen_shower_record"))
+  {
+    PHG4SpacalSteppingAction* steppingaction = dynamic_cast<PHG4SpacalSteppingAction*>(steppingAction_);
+    steppingaction->EndRecordedShower();
+  }
+  return 0;
+}
+
+//_______________________________________________________________________
+int PHG4SpacalSubsystem::End(PHCompositeNode* topNode)
+{
+  if (m_FrozenShowers && GetParams()->get_int_param("frozen_shower_record"))
+  {
+    const string library = GetParams()->get_string_param("frozen_shower_library");
+    if (Verbosity() > 0)
+    {
+      m_FrozenShowers->Print();
+    }
+    if (m_FrozenShowers->Save(library))
+    {
+      cout << "PHG4SpacalSubsystem::End - could not write frozen shower library " << library << endl;
+    }
+  }
+  return 0;
+}
+
 //_______________________________________________________________________
 PHG4Detector* PHG4SpacalSubsystem::GetDetector(void) const
 {
@@ -186,5 +244,11 @@ void PHG4SpacalSubsystem::SetDefaultParameters()
   set_default_double_param("divider_width", 0);       // radial size of the divider between blocks. <=0 means no dividers
   set_default_string_param("divider_mat", "G4_AIR");  // materials of the divider. G4_AIR is equivalent to not installing one in the term of material distribution
 
+  // frozen shower library (root file), empty for full simulation. With
+  // frozen_shower_record the showers of this run are written to it instead
+  set_default_string_param("frozen_shower_library", "");
+  set_default_int_param("frozen_shower_record", 0);
+  set_default_double_param("frozen_shower_emax", 1.);  // GeV, e+/e-/photons below are parameterized
+
   return;
 }
@@ -18,6 +18,7 @@
 class PHCompositeNode;
 class PHG4Detector;
 class PHG4DisplayAction;
+class PHG4FrozenShowerLibrary;
 class PHG4SpacalDetector;
 class PHG4SteppingAction;
 
@@ -47,6 +48,12 @@ class PHG4SpacalSubsystem : public PHG4DetectorSubsystem
    */
   int process_event(PHCompositeNode *);
 
+  //! frozen shower library generation: add the shower of this event
+  int process_after_geant(PHCompositeNode *);
+
+  //! frozen shower library generation: write the library
+  int End(PHCompositeNode *);
+
   //! accessors (reimplemented)
   virtual PHG4Detector *GetDetector() const;
   virtual PHG4SteppingAction *GetSteppingAction() const { return steppingAction_; }
@@ -71,6 +78,9 @@ class PHG4SpacalSubsystem : public PHG4DetectorSubsystem
   //! display attribute setting
   /*! derives from PHG4DisplayAction */
   PHG4DisplayAction *m_DisplayAction;
+
+  //! frozen showers of the fast simulation or the recorded ones
+  PHG4FrozenShowerLibrary *m_FrozenShowers;
 };
 
 #endif
@@ -132,6 +132,31 @@ G4LogicalVolume* PHG4mRICHDetector::Construct_a_mRICH(G4LogicalVolume* logicWorl
     }
   }
 
+  // same for all modules, in the frame of the hollow volume
+  BoxPar* aerogelPar = parameters->GetBoxPar("aerogel");
+  fastOpticsGeometry.aerogel_z = aerogelPar->pos.z();
+  for (int i = 0; i < 3; i++) fastOpticsGeometry.aerogel_half[i] = aerogelPar->halfXYZ[i];
+  fastOpticsGeometry.aerogel_material = aerogelPar->material;
+  BoxPar* sensorPar = parameters->GetBoxPar("sensor");
+  fastOpticsGeometry.sensor_z = sensorPar->pos.z() - sensorPar->halfXYZ[2];
+  fastOpticsGeometry.sensor_half = sensorPar->halfXYZ[0];
+  if (detectorSetup)
+  {
+    LensPar* lensPar = parameters->GetLensPar("fresnelLens");
+    fastOpticsGeometry.lens_material = lensPar->material;
+    fastOpticsGeometry.lens_z = lensPar->pos.z();
+    fastOpticsGeometry.lens_f = lensPar->f;
+    fastOpticsGeometry.lens_half = lensPar->halfXYZ[0];
+    fastOpticsGeometry.lens_eff_radius = lensPar->eff_diameter / 2.0;
+    fastOpticsGeometry.lens_thickness = 2 * lensPar->halfXYZ[2];
+    PolyPar* mirrorPar = parameters->GetPolyPar("mirror");
+    for (int i = 0; i < 2; i++)
+    {
+      fastOpticsGeometry.mirror_z[i] = mirrorPar->z[i];
+      fastOpticsGeometry.mirror_r[i] = mirrorPar->rinner[i];
+    }
+  }
+
   return hollowVol->GetMotherLogical();  //return detector holder box.
                                          //you have more than 1 daugthers,
                                          //but you can only have one mother.
@@ -698,6 +723,7 @@ void PHG4mRICHDetector::build_mirror(mRichParameter* detectorParameter, G4VPhysi
   OpticalAirMirror->SetMaterialPropertiesTable(AirMirrorMPT);
 
   new G4LogicalBorderSurface("Air/Mirror Surface", motherPV, mirror, OpticalAirMirror);
+  fastOpticsGeometry.mirror_reflectivity = ICEREFLECTIVITY[0];
 }
 //________________________________________________________________________//
 void PHG4mRICHDetector::build_sensor(mRichParameter* detectorParameter, G4LogicalVolume* motherLV)
@@ -728,6 +754,8 @@ void PHG4mRICHDetector::build_sensor(mRichParameter* detectorParameter, G4Logica
     sensor_PV[i] = build_box(detectorParameter->GetBoxPar("sensor"), motherLV);
 
     sensor_vol[sensor_PV[i]] = i;
+    fastOpticsGeometry.sensor_xy[i][0] = x;
+    fastOpticsGeometry.sensor_xy[i][1] = y;
     // cout << "in build_sensor: sensor_vol = " << sensor_vol[sensor_PV[i]] << endl;
 
     last_x = x;
@@ -7,6 +7,8 @@
 #ifndef G4DETECTORS_PHG4MRICHDETECTOR_H
 #define G4DETECTORS_PHG4MRICHDETECTOR_H
 
+#include "PHG4mRICHFastOptics.h"
+
 #include <g4main/PHG4Detector.h>
 
 #include <Geant4/G4Colour.hh>
@@ -57,6 +59,9 @@ class PHG4mRICHDetector : public PHG4Detector
   const std::string SuperDetector() const { return superdetector; }
   int get_Layer() const { return layer; }
 
+  //! geometry of a module for the parameterized optics, valid after ConstructMe()
+  const PHG4mRICHFastOptics::Geometry& GetFastOpticsGeometry() const { return fastOpticsGeometry; }
+
   enum
   {
     SENSOR = 1,
@@ -107,6 +112,8 @@ class PHG4mRICHDetector : public PHG4Detector
 
   std::map<const G4VPhysicalVolume*, int> sensor_vol;   // physical volume of senseors
   std::map<const G4VPhysicalVolume*, int> aerogel_vol;  // physical volume of senseors
+
+  PHG4mRICHFastOptics::Geometry fastOpticsGeometry;
 };
 //___________________________________________________________________________
 class PHG4mRICHDetector::mRichParameter
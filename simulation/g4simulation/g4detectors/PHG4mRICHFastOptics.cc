@@ -0,0 +1,283 @@
+#include "PHG4mRICHFastOptics.h"
+
+#include <Geant4/G4Material.hh>
+#include <Geant4/G4MaterialPropertiesTable.hh>
+#include <Geant4/G4PhysicalConstants.hh>
+#include <Geant4/G4Poisson.hh>
+#include <Geant4/G4SystemOfUnits.hh>
+#include <Geant4/Randomize.hh>
+
+#include <algorithm>
+#include <cmath>
+#include <iostream>
+
+using namespace std;
+
+namespace
+{
+  //! Cherenkov photons per energy and path length for unit charge (as G4Cerenkov)
+  const double cerenkov_rfact = 369.81 / (eV * cm);
+  //! more reflections are only possible for photons running along the mirrors
+  const int max_reflections = 10;
+}  // namespace
+
+PHG4mRICHFastOptics::Geometry::Geometry()
+  : aerogel_z(0)
+  , aerogel_half{0, 0, 0}
+  , aerogel_material(nullptr)
+  , lens_material(nullptr)
+  , lens_z(0)
+  , lens_f(0)
+  , lens_half(0)
+  , lens_eff_radius(0)
+  , lens_thickness(0)
+  , mirror_z{0, 0}
+  , mirror_r{0, 0}
+  , mirror_reflectivity(0)
+  , sensor_z(0)
+  , sensor_half(0)
+  , sensor_xy{{0, 0}, {0, 0}, {0, 0}, {0, 0}}
+{
+}
+
+PHG4mRICHFastOptics::PHG4mRICHFastOptics(const Geometry &geom, const double photon_fraction)
+  : m_Geometry(geom)
+  , m_PhotonFraction(photon_fraction)
+  , m_Weight(1. / photon_fraction)
+  , m_AerogelRindex(nullptr)
+  , m_AerogelAbsorption(nullptr)
+  , m_AerogelRayleigh(nullptr)
+  , m_LensAbsorption(nullptr)
+  , m_EnergyMin(0)
+  , m_EnergyMax(0)
+  , m_RindexMax(0)
+{
+  if (geom.aerogel_material && geom.aerogel_material->GetMaterialPropertiesTable())
+  {
+    G4MaterialPropertiesTable *mpt = geom.aerogel_material->GetMaterialPropertiesTable();
+    m_AerogelRindex = mpt->GetProperty("RINDEX");
+    m_AerogelAbsorption = mpt->GetProperty("ABSLENGTH");
+    m_AerogelRayleigh = mpt->GetProperty("RAYLEIGH");
+  }
+  if (geom.lens_material && geom.lens_material->GetMaterialPropertiesTable())
+  {
+    m_LensAbsorption = geom.lens_material->GetMaterialPropertiesTable()->GetProperty("ABSLENGTH");
+  }
+  if (!m_AerogelRindex)
+  {
+    cout << "PHG4mRICHFastOptics: aerogel without refractive index, no photons will be generated" << endl;
+    return;
+  }
+  const size_t n = m_AerogelRindex->GetVectorLength();
+  m_EnergyMin = m_AerogelRindex->Energy(0);
+  m_EnergyMax = m_AerogelRindex->Energy(n - 1);
+  for (size_t i = 0; i < n; ++i)
+  {
+    m_RindexMax = max(m_RindexMax, (*m_AerogelRindex)[i]);
+  }
+}
+
+double PHG4mRICHFastOptics::CerenkovIntegral(const double beta) const
+{
+  // trapezoidal rule over the points of the refractive index table
+  double integral = 0;
+  double last_sin2 = 0;
+  const size_t n = m_AerogelRindex->GetVectorLength();
+  for (size_t i = 0; i < n; ++i)
+  {
+    const double betan = beta * (*m_AerogelRindex)[i];
+    const double sin2 = (betan > 1 ? 1. - 1. / (betan * betan) : 0.);
+    if (i > 0)
+    {
+      integral += 0.5 * (sin2 + last_sin2) * (m_AerogelRindex->Energy(i) - m_AerogelRindex->Energy(i - 1));
+    }
+    last_sin2 = sin2;
+  }
+  return integral;
+}
+
+void PHG4mRICHFastOptics::ProcessStep(const G4ThreeVector &pre, const G4ThreeVector &post, const G4ThreeVector &dir,
+                                      const double t_pre, const double t_post, const double beta, const double charge,
+                                      vector<Photon> &photons) const
+{
+  if (!m_AerogelRindex || beta * m_RindexMax <= 1.)
+  {
+    return;
+  }
+  const double step = (post - pre).mag();
+  const double mean = cerenkov_rfact * charge * charge * CerenkovIntegral(beta) * step;
+  const long nphotons = G4Poisson(mean * m_PhotonFraction);
+  const double max_sin2 = 1. - 1. / (beta * beta * m_RindexMax * m_RindexMax);
+  for (long iphot = 0; iphot < nphotons; ++iphot)
+  {
+    const double u = G4UniformRand();
+    G4ThreeVector pos = pre + u * (post - pre);
+    double time = t_pre + u * (t_post - t_pre);
+
+    // photon energy with the sin^2 of the emission angle as weight (as G4Cerenkov)
+    double energy = 0;
+    double n = 0;
+    double sin2 = 0;
+    do
+    {
+      energy = m_EnergyMin + G4UniformRand() * (m_EnergyMax - m_EnergyMin);
+      n = m_AerogelRindex->Value(energy);
+      const double betan = beta * n;
+      sin2 = (betan > 1 ? 1. - 1. / (betan * betan) : 0.);
+    } while (G4UniformRand() * max_sin2 > sin2);
+
+    const double sint = sqrt(sin2);
+    const double phi = twopi * G4UniformRand();
+    G4ThreeVector photondir(sint * cos(phi), sint * sin(phi), sqrt(1. - sin2));
+    photondir.rotateUz(dir.unit());
+
+    // the optics works in the frame of the module
+    pos.setZ(pos.z() + m_Geometry.aerogel_z);
+    if (!Propagate(pos, photondir, time, energy, n))
+    {
+      continue;
+    }
+    for (int i = 0; i < 4; ++i)
+    {
+      if (fabs(pos.x() - m_Geometry.sensor_xy[i][0]) <= m_Geometry.sensor_half &&
+          fabs(pos.y() - m_Geometry.sensor_xy[i][1]) <= m_Geometry.sensor_half)
+      {
+        Photon photon;
+        photon.pos = G4ThreeVector(pos.x(), pos.y(), pos.z() - m_Geometry.aerogel_z);
+        photon.time = time;
+        photon.energy = energy;
+        photon.sensor = i;
+        photons.push_back(photon);
+        break;
+      }
+    }
+  }
+}
+
+bool PHG4mRICHFastOptics::Propagate(G4ThreeVector &pos, G4ThreeVector &dir, double &time, const double energy, const double n) const
+{
+  // to the back face of the aerogel, photons leaving through the front or
+  // the sides end up in the foam holder
+  if (dir.z() <= 0)
+  {
+    return false;
+  }
+  double s = (m_Geometry.aerogel_z + m_Geometry.aerogel_half[2] - pos.z()) / dir.z();
+  pos += s * dir;
+  time += s * n / c_light;
+  if (fabs(pos.x()) > m_Geometry.aerogel_half[0] || fabs(pos.y()) > m_Geometry.aerogel_half[1])
+  {
+    return false;
+  }
+  // scattered photons count as lost
+  if (G4UniformRand() > Transmission(m_AerogelAbsorption, energy, s) * Transmission(m_AerogelRayleigh, energy, s))
+  {
+    return false;
+  }
+
+  // refraction into the air behind the aerogel
+  const double tx = dir.x() * n;
+  const double ty = dir.y() * n;
+  const double t2 = tx * tx + ty * ty;
+  if (t2 >= 1.)
+  {
+    return false;  // total reflection
+  }
+  dir.set(tx, ty, sqrt(1. - t2));
+
+  if (m_Geometry.lens_material)
+  {
+    s = (m_Geometry.lens_z - pos.z()) / dir.z();
+    pos += s * dir;
+    time += s / c_light;
+    if (fabs(pos.x()) > m_Geometry.lens_half || fabs(pos.y()) > m_Geometry.lens_half || pos.perp() > m_Geometry.lens_eff_radius)
+    {
+      return false;
+    }
+    if (G4UniformRand() > Transmission(m_LensAbsorption, energy, m_Geometry.lens_thickness / dir.z()))
+    {
+      return false;
+    }
+    // thin lens, a parallel bundle meets in the focal plane
+    dir = G4ThreeVector(dir.x() / dir.z() - pos.x() / m_Geometry.lens_f,
+                        dir.y() / dir.z() - pos.y() / m_Geometry.lens_f, 1.)
+              .unit();
+
+    // photons outside of the mirror opening hit the holder
+    s = (m_Geometry.mirror_z[0] - pos.z()) / dir.z();
+    if (s > 0)
+    {
+      pos += s * dir;
+      time += s / c_light;
+    }
+    if (fabs(pos.x()) > m_Geometry.mirror_r[0] || fabs(pos.y()) > m_Geometry.mirror_r[0])
+    {
+      return false;
+    }
+    int nreflections = 0;
+    while (Reflect(pos, dir, time))
+    {
+      if (++nreflections > max_reflections || G4UniformRand() > m_Geometry.mirror_reflectivity || dir.z() <= 0)
+      {
+        return false;
+      }
+    }
+  }
+
+  s = (m_Geometry.sensor_z - pos.z()) / dir.z();
+  pos += s * dir;
+  time += s / c_light;
+  return true;
+}
+
+bool PHG4mRICHFastOptics::Reflect(G4ThreeVector &pos, G4ThreeVector &dir, double &time) const
+{
+  // the four mirrors are planes s * a = r0 + k * (z - z0), a = x or y and s = +-1
+  const double z0 = m_Geometry.mirror_z[0];
+  const double z1 = min(m_Geometry.mirror_z[1], m_Geometry.sensor_z);
+  const double k = (m_Geometry.mirror_r[1] - m_Geometry.mirror_r[0]) / (m_Geometry.mirror_z[1] - m_Geometry.mirror_z[0]);
+  const double r = m_Geometry.mirror_r[0] + k * (pos.z() - z0);
+
+  double tmin = -1;
+  int axis = -1;
+  double sign = 0;
+  for (int a = 0; a < 2; ++a)
+  {
+    for (double s = -1; s <= 1; s += 2)
+    {
+      const double denom = s * dir[a] - k * dir.z();
+      if (denom <= 0)
+      {
+        continue;  // moving away from this mirror
+      }
+      const double t = (r - s * pos[a]) / denom;
+      const double z = pos.z() + t * dir.z();
+      if (t > 0 && z >= z0 && z <= z1 && (tmin < 0 || t < tmin))
+      {
+        tmin = t;
+        axis = a;
+        sign = s;
+      }
+    }
+  }
+  if (axis < 0)
+  {
+    return false;
+  }
+  pos += tmin * dir;
+  time += tmin / c_light;
+  G4ThreeVector normal(0, 0, -k);
+  normal[axis] = sign;
+  normal = normal.unit();
+  dir -= 2. * dir.dot(normal) * normal;
+  return true;
+}
+
+double PHG4mRICHFastOptics::Transmission(G4MaterialPropertyVector *abslength, const double energy, const double length) const
+{
+  if (!abslength)
+  {
+    return 1.;
+  }
+  return exp(-length / abslength->Value(energy));
+}
@@ -0,0 +1,100 @@
+// Tell emacs that this is a C++ source
+//  -*- C++ -*-.
+#ifndef G4DETECTORS_PHG4MRICHFASTOPTICS_H
+#define G4DETECTORS_PHG4MRICHFASTOPTICS_H
+
+#include <Geant4/G4MaterialPropertyVector.hh>  // a typedef, cannot be forward declared
+#include <Geant4/G4ThreeVector.hh>
+
+#include <vector>
+
+class G4Material;
+
+/*!
+ * Parameterized optics of a single mRICH module. Instead of tracking the
+ * Cherenkov photons of the aerogel with Geant4, the photons of a charged
+ * step in the aerogel are generated analytically (yield and angle from the
+ * refractive index of the aerogel, absorption and Rayleigh scattering count
+ * as losses), refracted at the back face of the aerogel, focused by a thin
+ * lens in the Fresnel lens plane, reflected by the four planar mirrors and
+ * stopped in the sensor plane.
+ *
+ * Only a fraction of the photons is generated (photon biasing), every
+ * photon reaching a sensor then stands for 1/fraction photons.
+ */
+class PHG4mRICHFastOptics
+{
+ public:
+  //! module geometry in the frame of the hollow volume of the module (Geant4 units)
+  struct Geometry
+  {
+    Geometry();
+
+    double aerogel_z;  //< center of the aerogel block
+    double aerogel_half[3];
+    const G4Material *aerogel_material;
+
+    const G4Material *lens_material;  //< nullptr without lens and mirrors (skeleton setup)
+    double lens_z;                    //< center of the lens, the thin lens plane
+    double lens_f;
+    double lens_half;          //< half width of the lens plate
+    double lens_eff_radius;    //< radius of the grooved part
+    double lens_thickness;
+
+    double mirror_z[2];  //< front and back end of the mirrors
+    double mirror_r[2];  //< distance of the mirror surfaces from the axis at mirror_z
+    double mirror_reflectivity;
+
+    double sensor_z;  //< front face of the sensors
+    double sensor_half;
+    double sensor_xy[4][2];  //< centers of the four sensors
+  };
+
+  //! photon reaching a sensor, in the frame of the aerogel volume
+  struct Photon
+  {
+    G4ThreeVector pos;
+    double time;
+    double energy;
+    int sensor;
+  };
+
+  PHG4mRICHFastOptics(const Geometry &geom, const double photon_fraction);
+  virtual ~PHG4mRICHFastOptics() {}
+
+  //! generates the photons of a charged step inside the aerogel and appends the ones reaching a sensor
+  /*!
+    \param pre, post step points in the frame of the aerogel volume
+    \param dir direction of the particle in the frame of the aerogel volume
+  */
+  void ProcessStep(const G4ThreeVector &pre, const G4ThreeVector &post, const G4ThreeVector &dir,
+                   const double t_pre, const double t_post, const double beta, const double charge,
+                   std::vector<Photon> &photons) const;
+
+  //! number of real photons a generated photon stands for
+  double Weight() const { return m_Weight; }
+
+ private:
+  //! integral of sin^2(theta_c) over the photon energies of the aerogel for this beta
+  double CerenkovIntegral(const double beta) const;
+  //! follows a photon from the aerogel to the sensor plane, false if it is lost
+  bool Propagate(G4ThreeVector &pos, G4ThreeVector &dir, double &time, const double energy, const double n) const;
+  //! reflects the photon on the nearest mirror before the sensor plane, false if it reaches the sensor plane first
+  bool Reflect(G4ThreeVector &pos, G4ThreeVector &dir, double &time) const;
+  //! survival probability over a path length in a material, 1 without absorption data
+  double Transmission(G4MaterialPropertyVector *abslength, const double energy, const double length) const;
+
+  Geometry m_Geometry;
+  double m_PhotonFraction;
+  double m_Weight;
+
+  G4MaterialPropertyVector *m_AerogelRindex;
+  G4MaterialPropertyVector *m_AerogelAbsorption;
+  G4MaterialPropertyVector *m_AerogelRayleigh;
+  G4MaterialPropertyVector *m_LensAbsorption;
+  double m_EnergyMin;
+  double m_EnergyMax;
+  double m_RindexMax;
+};
+
+#endif
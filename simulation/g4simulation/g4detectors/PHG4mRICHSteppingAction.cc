@@ -20,7 +20,11 @@
 #include <phool/getClass.h>
 #include <phool/phool.h>                       // for PHWHERE
 
+#include <Geant4/G4AffineTransform.hh>         // for G4AffineTransform
+#include <Geant4/G4NavigationHistory.hh>
+#include <Geant4/G4OpticalPhoton.hh>
 #include <Geant4/G4ParticleDefinition.hh>      // for G4ParticleDefinition
+#include <Geant4/G4PhysicalConstants.hh>
 #include <Geant4/G4ReferenceCountedHandle.hh>  // for G4ReferenceCountedHandle
 #include <Geant4/G4Step.hh>
 #include <Geant4/G4StepPoint.hh>               // for G4StepPoint
@@ -73,13 +77,18 @@ PHG4mRICHSteppingAction::PHG4mRICHSteppingAction( PHG4mRICHDetector* detector,PH
   savehitcontainer(nullptr),
   saveshower(nullptr),
   savetrackid(-1),
-  savepoststepstatus(-1)
+  savepoststepstatus(-1),
+  fastOpticsMode(params->get_int_param("fast_optics")),
+  photonFraction(params->get_double_param("fast_optics_photon_fraction")),
+  fastOptics(nullptr),
+  fasthits_(nullptr)
 {
 }
 //____________________________________________________________________________..
 PHG4mRICHSteppingAction::~PHG4mRICHSteppingAction()
 {
   delete hit;
+  delete fastOptics;
 }
 //____________________________________________________________________________..
 bool PHG4mRICHSteppingAction::UserSteppingAction( const G4Step* aStep, bool )
@@ -115,6 +124,24 @@ bool PHG4mRICHSteppingAction::UserSteppingAction( const G4Step* aStep, bool )
     int PID=aTrack->GetDefinition()->GetPDGEncoding();
     string PName = aTrack->GetDefinition()->GetParticleName();
 
+    if (fastOptics && isactive == PHG4mRICHDetector::AEROGEL)
+    {
+      if (aTrack->GetDefinition() == G4OpticalPhoton::OpticalPhotonDefinition())
+      {
+        if (fastOpticsMode == 1)
+        {
+          // replaced by the parameterized photons of the charged particle
+          G4Track* killtrack = const_cast<G4Track *> (aTrack);
+          killtrack->SetTrackStatus(fStopAndKill);
+          return true;
+        }
+      }
+      else if (aTrack->GetDefinition()->GetPDGCharge() != 0)
+      {
+        FastOptics(aStep, touch(), module_id);
+      }
+    }
+
     //-----------------------------------------------------------------------------------//
     // if this block stops everything, just put all kinetic energy into edep
     if (IsBlackHole) 
@@ -298,6 +325,89 @@ void PHG4mRICHSteppingAction::SetInterfacePointers( PHCompositeNode* topNode )
       cout << "PHG4mRICHSteppingAction::SetTopNode - unable to find " << absorbernodename << endl;
     }
   }
+  if (fastOpticsMode > 0)
+  {
+    // the geometry exists only after the detector construction
+    if (!fastOptics)
+    {
+      fastOptics = new PHG4mRICHFastOptics(detector_->GetFastOpticsGeometry(), photonFraction);
+    }
+    if (fastOpticsMode == 2)
+    {
+      const string fastnodename = "G4HIT_FASTOPTICS_" + (superdetector != "NONE" ? superdetector : detectorname);
+      fasthits_ = findNode::getClass<PHG4HitContainer>(topNode, fastnodename);
+      if (!fasthits_)
+      {
+        cout << "PHG4mRICHSteppingAction::SetTopNode - unable to find " << fastnodename << endl;
+      }
+    }
+  }
+}
+//____________________________________________________________________________..
+void PHG4mRICHSteppingAction::FastOptics(const G4Step* aStep, const G4VTouchable* touch, const int module_id)
+{
+  PHG4HitContainer* container = (fastOpticsMode == 2 ? fasthits_ : hits_);
+  if (!container)
+  {
+    return;
+  }
+  G4StepPoint* prePoint = aStep->GetPreStepPoint();
+  G4StepPoint* postPoint = aStep->GetPostStepPoint();
+  const G4Track* aTrack = aStep->GetTrack();
+
+  // the optics works in the frame of the aerogel
+  const G4AffineTransform& toLocal = touch->GetHistory()->GetTopTransform();
+  const G4AffineTransform toGlobal = toLocal.Inverse();
+  photons.clear();
+  fastOptics->ProcessStep(toLocal.TransformPoint(prePoint->GetPosition()),
+                          toLocal.TransformPoint(postPoint->GetPosition()),
+                          toLocal.TransformAxis(prePoint->GetMomentumDirection()),
+                          prePoint->GetGlobalTime(), postPoint->GetGlobalTime(),
+                          0.5 * (prePoint->GetBeta() + postPoint->GetBeta()),
+                          aTrack->GetDefinition()->GetPDGCharge() / eplus,
+                          photons);
+  if (photons.empty())
+  {
+    return;
+  }
+
+  int trkid = aTrack->GetTrackID();
+  PHG4Shower* shower = nullptr;
+  PHG4TrackUserInfoV1* userinfo = dynamic_cast<PHG4TrackUserInfoV1*>(aTrack->GetUserInformation());
+  if (userinfo)
+  {
+    trkid = userinfo->GetUserTrackId();
+    shower = userinfo->GetShower();
+    userinfo->SetKeep(1);  // the photon hits point to this track
+  }
+  for (vector<PHG4mRICHFastOptics::Photon>::const_iterator iter = photons.begin(); iter != photons.end(); ++iter)
+  {
+    // same content as the hit of a Geant4 optical photon entering a sensor,
+    // the light yield is the number of photons this one stands for
+    const G4ThreeVector pos = toGlobal.TransformPoint(iter->pos);
+    PHG4Hit* fasthit = new PHG4Hitv1();
+    for (int i = 0; i < 2; i++)
+    {
+      fasthit->set_x(i, pos.x() / cm);
+      fasthit->set_y(i, pos.y() / cm);
+      fasthit->set_z(i, pos.z() / cm);
+      fasthit->set_t(i, iter->time / nanosecond);
+    }
+    fasthit->set_trkid(trkid);
+    fasthit->set_edep(iter->energy / GeV);
+    fasthit->set_eion(0);
+    fasthit->set_scint_id(module_id);
+    fasthit->set_light_yield(fastOptics->Weight());
+    if (shower)
+    {
+      fasthit->set_shower_id(shower->get_id());
+    }
+    container->AddHit(module_id, fasthit);
+    if (shower)
+    {
+      shower->add_g4hit_id(container->GetID(), fasthit->get_hit_id());
+    }
+  }
 }
 //____________________________________________________________________________..
 int PHG4mRICHSteppingAction::GetModuleID(G4VPhysicalVolume* volume)
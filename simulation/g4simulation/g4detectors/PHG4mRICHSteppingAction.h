@@ -3,12 +3,16 @@
 #ifndef G4DETECTORS_PHG4MRICHSTEPPINGACTION_H
 #define G4DETECTORS_PHG4MRICHSTEPPINGACTION_H
 
+#include "PHG4mRICHFastOptics.h"
+
 #include <g4main/PHG4SteppingAction.h>
 
 #include <string>                       // for string
+#include <vector>
 
 class G4Step;
 class G4VPhysicalVolume;
+class G4VTouchable;
 class PHCompositeNode;
 class PHG4mRICHDetector;
 class PHG4Hit;
@@ -55,6 +59,16 @@ class PHG4mRICHSteppingAction : public PHG4SteppingAction
   int savepoststepstatus;
 
   int GetModuleID(G4VPhysicalVolume* volume);
+
+  //! parameterized photons of a charged step in the aerogel
+  void FastOptics(const G4Step* aStep, const G4VTouchable* touch, const int module_id);
+
+  //! 0: Geant4 optical photons, 1: parameterized optics, 2: both, parameterized hits in G4HIT_FASTOPTICS_<name>
+  int fastOpticsMode;
+  double photonFraction;
+  PHG4mRICHFastOptics* fastOptics;
+  PHG4HitContainer* fasthits_;
+  std::vector<PHG4mRICHFastOptics::Photon> photons;
 };
 
 
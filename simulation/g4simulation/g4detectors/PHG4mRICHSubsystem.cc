@@ -19,9 +19,13 @@
 #include <phool/PHNodeIterator.h>  // for PHNodeIterator
 #include <phool/PHObject.h>        // for PHObject
 #include <phool/getClass.h>
+#include <phool/phool.h>  // for PHWHERE
+
+#include <TSystem.h>
 
 #include <boost/foreach.hpp>
 
+#include <iostream>
 #include <set>  // for set
 #include <sstream>
 
@@ -100,6 +104,25 @@ int PHG4mRICHSubsystem::InitRunSubsystem(PHCompositeNode* topNode)
       nodes.insert(nodename.str());
     }
 
+    // parameterized photon hits next to the Geant4 ones to validate the fast optics
+    if (GetParams()->get_int_param("fast_optics") == 2)
+    {
+      ostringstream fastnodename;
+      fastnodename << "G4HIT_FASTOPTICS_" << GetParams()->get_string_param("detectorname");
+      if (!findNode::getClass<PHG4HitContainer>(topNode, fastnodename.str().c_str()))
+      {
+        PHG4HitContainer* fast_hits = new PHG4HitContainer(fastnodename.str());
+        dstNode->addNode(new PHIODataNode<PHObject>(fast_hits, fastnodename.str().c_str(), "PHObject"));
+      }
+    }
+    const double photon_fraction = GetParams()->get_double_param("fast_optics_photon_fraction");
+    if (photon_fraction <= 0 || photon_fraction > 1)
+    {
+      cout << PHWHERE << " fast_optics_photon_fraction " << photon_fraction
+           << " has to be in (0,1]" << endl;
+      gSystem->Exit(1);
+    }
+
     // create stepping action
     _steppingAction = new PHG4mRICHSteppingAction(_detector, GetParams());
 
@@ -149,4 +172,10 @@ void PHG4mRICHSubsystem::SetDefaultParameters()
   set_default_double_param("eta_max", 1.9);
 
   set_default_int_param("use_g4steps", 0);  //for stepping function
+
+  set_default_int_param("fast_optics", 0);  //0: Geant4 optical photons
+                                            //1: parameterized optics for the aerogel photons
+                                            //2: both, parameterized hits in G4HIT_FASTOPTICS_<detectorname>
+  set_default_double_param("fast_optics_photon_fraction", 1.);  //generated fraction of the parameterized photons,
+                                                                //their hits carry 1/fraction as light yield
 }
@@ -1,5 +1,7 @@
 #include "CaloEvaluator.h"
 
+#include "EvalColumns.h"
+#include "EvalNtuple.h"
 #include "CaloRawClusterEval.h"
 #include "CaloEvalStack.h"
 #include "CaloRawTowerEval.h"
@@ -28,7 +30,6 @@
 #include <phool/phool.h>
 
 #include <TFile.h>
-#include <TNtuple.h>
 
 #include <CLHEP/Vector/ThreeVector.h>
 
@@ -37,9 +38,42 @@
 #include <iostream>
 #include <set>
 #include <utility>
+#include <vector>
 
 using namespace std;
 
+namespace
+{
+  // columns of the ntuples and the columns of each which are stored as integer
+
+  const char* gpoint_varlist =
+      "event:gvx:gvy:gvz:"
+      "vx:vy:vz";
+  const char* gpoint_intcolumns = "event";
+
+  const char* gshower_varlist =
+      "event:gparticleID:gflavor:gnhits:"
+      "geta:gphi:ge:gpt:gvx:gvy:gvz:gembed:gedep:"
+      "clusterID:ntowers:eta:x:y:z:phi:e:efromtruth";
+  const char* gshower_intcolumns = "event:gparticleID:gflavor:gnhits:gembed:clusterID:ntowers";
+
+  const char* tower_varlist =
+      "event:towerID:ieta:iphi:eta:phi:e:x:y:z:"
+      "gparticleID:gflavor:gnhits:"
+      "geta:gphi:ge:gpt:gvx:gvy:gvz:"
+      "gembed:gedep:"
+      "efromtruth";
+  const char* tower_intcolumns = "event:towerID:gparticleID:gflavor:gnhits:gembed";
+
+  const char* cluster_varlist =
+      "event:clusterID:ntowers:eta:x:y:z:phi:e:"
+      "gparticleID:gflavor:gnhits:"
+      "geta:gphi:ge:gpt:gvx:gvy:gvz:"
+      "gembed:gedep:"
+      "efromtruth";
+  const char* cluster_intcolumns = "event:clusterID:ntowers:gparticleID:gflavor:gnhits:gembed";
+}  // namespace
+
 CaloEvaluator::CaloEvaluator(const string& name, const string& caloname, const string& filename)
   : SubsysReco(name)
   , _caloname(caloname)
@@ -80,23 +114,22 @@ int CaloEvaluator::Init(PHCompositeNode* topNode)
 
   _tfile = new TFile(_filename.c_str(), "RECREATE");
 
-  if (_do_gpoint_eval) _ntp_gpoint = new TNtuple("ntp_gpoint", "primary vertex => best (first) vertex",
-                                                 "event:gvx:gvy:gvz:"
-                                                 "vx:vy:vz");
+  if (_do_gpoint_eval) _ntp_gpoint = new EvalNtuple("ntp_gpoint", "primary vertex => best (first) vertex",
+                                                 gpoint_varlist,
+                                                 gpoint_intcolumns,
+                                                 _selected_columns["ntp_gpoint"]);
 
-  if (_do_gshower_eval) _ntp_gshower = new TNtuple("ntp_gshower", "truth shower => best cluster",
-                                                   "event:gparticleID:gflavor:gnhits:"
-                                                   "geta:gphi:ge:gpt:gvx:gvy:gvz:gembed:gedep:"
-                                                   "clusterID:ntowers:eta:x:y:z:phi:e:efromtruth");
+  if (_do_gshower_eval) _ntp_gshower = new EvalNtuple("ntp_gshower", "truth shower => best cluster",
+                                                   gshower_varlist,
+                                                   gshower_intcolumns,
+                                                   _selected_columns["ntp_gshower"]);
   
   //Barak: Added TTree to will allow the TowerID to be set correctly as integer
   if (_do_tower_eval){
-    _ntp_tower = new TNtuple("ntp_tower", "tower => max truth primary",
-                                               "event:towerID:ieta:iphi:eta:phi:e:x:y:z:"
-                                               "gparticleID:gflavor:gnhits:"
-                                               "geta:gphi:ge:gpt:gvx:gvy:gvz:"
-                                               "gembed:gedep:"
-                                               "efromtruth");
+    _ntp_tower = new EvalNtuple("ntp_tower", "tower => max truth primary",
+                                               tower_varlist,
+                                               tower_intcolumns,
+                                               _selected_columns["ntp_tower"]);
 
     //Make Tree
     _tower_debug = new TTree("tower_debug","tower => max truth primary");
@@ -114,12 +147,10 @@ int CaloEvaluator::Init(PHCompositeNode* topNode)
 
   }
   
-  if (_do_cluster_eval) _ntp_cluster = new TNtuple("ntp_cluster", "cluster => max truth primary",
-                                                   "event:clusterID:ntowers:eta:x:y:z:phi:e:"
-                                                   "gparticleID:gflavor:gnhits:"
-                                                   "geta:gphi:ge:gpt:gvx:gvy:gvz:"
-                                                   "gembed:gedep:"
-                                                   "efromtruth");
+  if (_do_cluster_eval) _ntp_cluster = new EvalNtuple("ntp_cluster", "cluster => max truth primary",
+                                                   cluster_varlist,
+                                                   cluster_intcolumns,
+                                                   _selected_columns["ntp_cluster"]);
 
   return Fun4AllReturnCodes::EVENT_OK;
 }
@@ -172,6 +203,10 @@ int CaloEvaluator::End(PHCompositeNode* topNode)
   _tfile->Close();
 
   delete _tfile;
+  delete _ntp_gpoint;
+  delete _ntp_gshower;
+  delete _ntp_tower;
+  delete _ntp_cluster;
 
   if (Verbosity() > 0)
   {
@@ -389,7 +424,9 @@ void CaloEvaluator::fillOutputNtuples(PHCompositeNode* topNode)
 
   CaloRawClusterEval* clustereval = _caloevalstack->get_rawcluster_eval();
   CaloRawTowerEval* towereval = _caloevalstack->get_rawtower_eval();
-  CaloTruthEval* trutheval = _caloevalstack->get_truth_eval();
+
+  // need things off of the DST...
+  GlobalVertexMap* vertexmap = findNode::getClass<GlobalVertexMap>(topNode, "GlobalVertexMap");
 
   //----------------------
   // fill the Event NTuple
@@ -405,38 +442,33 @@ void CaloEvaluator::fillOutputNtuples(PHCompositeNode* topNode)
       exit(-1);
     }
 
-    // need things off of the DST...
-    GlobalVertexMap* vertexmap = findNode::getClass<GlobalVertexMap>(topNode, "GlobalVertexMap");
-
-    PHG4VtxPoint* gvertex = truthinfo->GetPrimaryVtx(truthinfo->GetPrimaryVertexIndex());
-    float gvx = gvertex->get_x();
-    float gvy = gvertex->get_y();
-    float gvz = gvertex->get_z();
-
-    float vx = NAN;
-    float vy = NAN;
-    float vz = NAN;
-    if (vertexmap)
-    {
-      if (!vertexmap->empty())
-      {
-        GlobalVertex* vertex = (vertexmap->begin()->second);
-
-        vx = vertex->get_x();
-        vy = vertex->get_y();
-        vz = vertex->get_z();
-      }
-    }
-
-    float gpoint_data[7] = {(float) _ievent,
-                            gvx,
-                            gvy,
-                            gvz,
-                            vx,
-                            vy,
-                            vz};
-
-    _ntp_gpoint->Fill(gpoint_data);
+    // a single row for the primary vertex
+    EvalColumns columns(gpoint_varlist);
+    columns.set_verbosity(Verbosity());
+
+    columns.add("event", "event", "",
+                [&](const unsigned int n) {
+                  columns.column("event").assign(n, _ievent);
+                });
+
+    columns.add("gvertex", "gvx:gvy:gvz", "",
+                [&](const unsigned int n) {
+                  PHG4VtxPoint* gvertex = truthinfo->GetPrimaryVtx(truthinfo->GetPrimaryVertexIndex());
+                  columns.column("gvx").assign(n, gvertex->get_x());
+                  columns.column("gvy").assign(n, gvertex->get_y());
+                  columns.column("gvz").assign(n, gvertex->get_z());
+                });
+
+    columns.add("vertex", "vx:vy:vz", "",
+                [&](const unsigned int n) {
+                  if (!vertexmap || vertexmap->empty()) return;
+                  GlobalVertex* vertex = (vertexmap->begin()->second);
+                  columns.column("vx").assign(n, vertex->get_x());
+                  columns.column("vy").assign(n, vertex->get_y());
+                  columns.column("vz").assign(n, vertex->get_z());
+                });
+
+    columns.evaluate(_ntp_gpoint, 1);
   }
 
   //------------------------
@@ -447,8 +479,6 @@ void CaloEvaluator::fillOutputNtuples(PHCompositeNode* topNode)
   {
     if (Verbosity() > 1) cout << Name() << " CaloEvaluator::filling gshower ntuple..." << endl;
 
-    GlobalVertexMap* vertexmap = findNode::getClass<GlobalVertexMap>(topNode, "GlobalVertexMap");
-
     PHG4TruthInfoContainer* truthinfo = findNode::getClass<PHG4TruthInfoContainer>(topNode, "G4TruthInfo");
     if (!truthinfo)
     {
@@ -456,6 +486,9 @@ void CaloEvaluator::fillOutputNtuples(PHCompositeNode* topNode)
       exit(-1);
     }
 
+    // one row per traced primary particle
+    CaloTruthEval* trutheval = _caloevalstack->get_truth_eval();
+    vector<PHG4Particle*> primaries;
     PHG4TruthInfoContainer::ConstRange range = truthinfo->GetPrimaryParticleRange();
     for (PHG4TruthInfoContainer::ConstIterator iter = range.first;
          iter != range.second;
@@ -470,99 +503,48 @@ void CaloEvaluator::fillOutputNtuples(PHCompositeNode* topNode)
         if (_truth_trace_embed_flags.find(trutheval->get_embed(primary)) ==
             _truth_trace_embed_flags.end()) continue;
       }
-
-      float gparticleID = primary->get_track_id();
-      float gflavor = primary->get_pid();
-
-      PHG4Shower* shower = trutheval->get_primary_shower(primary);
-      float gnhits = NAN;
-      if (shower)
-        gnhits = shower->get_nhits(trutheval->get_caloid());
-      else
-        gnhits = 0.0;
-      float gpx = primary->get_px();
-      float gpy = primary->get_py();
-      float gpz = primary->get_pz();
-      float ge = primary->get_e();
-
-      float gpt = sqrt(gpx * gpx + gpy * gpy);
-      float geta = NAN;
-      if (gpt != 0.0) geta = asinh(gpz / gpt);
-      float gphi = atan2(gpy, gpx);
-
-      PHG4VtxPoint* vtx = trutheval->get_vertex(primary);
-      float gvx = vtx->get_x();
-      float gvy = vtx->get_y();
-      float gvz = vtx->get_z();
-
-      float gembed = trutheval->get_embed(primary);
-      float gedep = trutheval->get_shower_energy_deposit(primary);
-
-      RawCluster* cluster = clustereval->best_cluster_from(primary);
-
-      float clusterID = NAN;
-      float ntowers = NAN;
-      float eta = NAN;
-      float x = NAN;
-      float y = NAN;
-      float z = NAN;
-      float phi = NAN;
-      float e = NAN;
-
-      float efromtruth = NAN;
-
-      if (cluster)
-      {
-        clusterID = cluster->get_id();
-        ntowers = cluster->getNTowers();
-	x = cluster->get_x();
-        y = cluster->get_y();
-        z = cluster->get_z();
-        phi = cluster->get_phi();
-        e = cluster->get_energy();
-
-        efromtruth = clustereval->get_energy_contribution(cluster, primary);
-
-        // require vertex for cluster eta calculation
-        if (vertexmap)
-        {
-          if (!vertexmap->empty())
-          {
-            GlobalVertex* vertex = (vertexmap->begin()->second);
-
-            eta =
-                RawClusterUtility::GetPseudorapidity(
-                    *cluster,
-                    CLHEP::Hep3Vector(vertex->get_x(), vertex->get_y(), vertex->get_z()));
-          }
-        }
-      }
-
-      float shower_data[] = {(float) _ievent,
-                             gparticleID,
-                             gflavor,
-                             gnhits,
-                             geta,
-                             gphi,
-                             ge,
-                             gpt,
-                             gvx,
-                             gvy,
-                             gvz,
-                             gembed,
-                             gedep,
-                             clusterID,
-                             ntowers,
-                             eta,
-			     x,
-			     y,
-                             z,
-                             phi,
-                             e,
-                             efromtruth};
-
-      _ntp_gshower->Fill(shower_data);
+      primaries.push_back(primary);
     }
+
+    vector<RawCluster*> clusters;
+
+    EvalColumns columns(gshower_varlist);
+    columns.set_verbosity(Verbosity());
+
+    columns.add("event", "event", "",
+                [&](const unsigned int n) {
+                  columns.column("event").assign(n, _ievent);
+                });
+
+    columns.add("gparticle", "gparticleID:gflavor:gnhits:geta:gphi:ge:gpt:gvx:gvy:gvz:gembed:gedep", "",
+                [&](const unsigned int n) {
+                  fill_primary_columns(columns, primaries);
+                });
+
+    columns.add("cluster", "", "",
+                [&](const unsigned int n) {
+                  clusters.resize(n);
+                  for (unsigned int i = 0; i < n; ++i)
+                  {
+                    clusters[i] = clustereval->best_cluster_from(primaries[i]);
+                  }
+                });
+
+    columns.add("reco", "clusterID:ntowers:eta:x:y:z:phi:e", "cluster",
+                [&](const unsigned int n) {
+                  fill_cluster_columns(columns, clusters, vertexmap);
+                });
+
+    columns.add("efromtruth", "efromtruth", "cluster",
+                [&](const unsigned int n) {
+                  vector<float>& efromtruth = columns.column("efromtruth");
+                  for (unsigned int i = 0; i < n; ++i)
+                  {
+                    if (clusters[i]) efromtruth[i] = clustereval->get_energy_contribution(clusters[i], primaries[i]);
+                  }
+                });
+
+    columns.evaluate(_ntp_gshower, primaries.size());
   }
 
   //----------------------
@@ -589,6 +571,9 @@ void CaloEvaluator::fillOutputNtuples(PHCompositeNode* topNode)
       exit(-1);
     }
 
+    // one row per tower above threshold, the debug tree is filled with them
+    vector<RawTower*> tower_rows;
+    vector<RawTowerGeom*> tower_geoms;
     RawTowerContainer::ConstRange begin_end = towers->getTowers();
     RawTowerContainer::ConstIterator rtiter;
     for (rtiter = begin_end.first; rtiter != begin_end.second; ++rtiter)
@@ -604,17 +589,8 @@ void CaloEvaluator::fillOutputNtuples(PHCompositeNode* topNode)
         tower->identify();
         exit(-1);
       }
-
-      //cout<<"Tower ID = "<<tower->get_id()<<" for bin(j,k)= "<<tower->get_bineta()<<","<<tower->get_binphi()<<endl; //Added by Barak
-      const float towerid = tower->get_id();
-      const float ieta = tower->get_bineta();
-      const float iphi = tower->get_binphi();
-      const float eta = tower_geom->get_eta();
-      const float phi = tower_geom->get_phi();
-      const float e = tower->get_energy();
-      const float x = tower_geom->get_center_x();
-      const float y = tower_geom->get_center_y();
-      const float z = tower_geom->get_center_z();
+      tower_rows.push_back(tower);
+      tower_geoms.push_back(tower_geom);
 
       //Added by Barak
       _towerID_debug = tower->get_id();
@@ -626,91 +602,68 @@ void CaloEvaluator::fillOutputNtuples(PHCompositeNode* topNode)
       _x_debug = tower_geom->get_center_x();
       _y_debug = tower_geom->get_center_y();
       _z_debug = tower_geom->get_center_z();
-
-      PHG4Particle* primary = towereval->max_truth_primary_particle_by_energy(tower);
-
-      float gparticleID = NAN;
-      float gflavor = NAN;
-      float gnhits = NAN;
-      float gpx = NAN;
-      float gpy = NAN;
-      float gpz = NAN;
-      float ge = NAN;
-
-      float gpt = NAN;
-      float geta = NAN;
-      float gphi = NAN;
-
-      float gvx = NAN;
-      float gvy = NAN;
-      float gvz = NAN;
-
-      float gembed = NAN;
-      float gedep = NAN;
-
-      float efromtruth = NAN;
-
-      if (primary)
-      {
-        gparticleID = primary->get_track_id();
-        gflavor = primary->get_pid();
-
-        PHG4Shower* shower = trutheval->get_primary_shower(primary);
-        if (shower)
-          gnhits = shower->get_nhits(trutheval->get_caloid());
-        else
-          gnhits = 0.0;
-        gpx = primary->get_px();
-        gpy = primary->get_py();
-        gpz = primary->get_pz();
-        ge = primary->get_e();
-
-        gpt = sqrt(gpx * gpx + gpy * gpy);
-        if (gpt != 0.0) geta = asinh(gpz / gpt);
-        gphi = atan2(gpy, gpx);
-
-        PHG4VtxPoint* vtx = trutheval->get_vertex(primary);
-
-        if (vtx)
-        {
-          gvx = vtx->get_x();
-          gvy = vtx->get_y();
-          gvz = vtx->get_z();
-        }
-
-        gembed = trutheval->get_embed(primary);
-        gedep = trutheval->get_shower_energy_deposit(primary);
-
-        efromtruth = towereval->get_energy_contribution(tower, primary);
-      }
-
-      float tower_data[] = {(float) _ievent,
-			    towerid,
-			    ieta,
-			    iphi,
-			    eta,
-			    phi,
-			    e,
-			    x,
-			    y,
-			    z,
-			    gparticleID,
-			    gflavor,
-			    gnhits,
-			    geta,
-			    gphi,
-			    ge,
-			    gpt,
-			    gvx,
-			    gvy,
-			    gvz,
-			    gembed,
-			    gedep,
-			    efromtruth};
-
-      _ntp_tower->Fill(tower_data);
       _tower_debug->Fill(); //Added by Barak (see above for explanation)
     }
+
+    vector<PHG4Particle*> primaries;
+
+    EvalColumns columns(tower_varlist);
+    columns.set_verbosity(Verbosity());
+
+    columns.add("event", "event", "",
+                [&](const unsigned int n) {
+                  columns.column("event").assign(n, _ievent);
+                });
+
+    columns.add("tower", "towerID:ieta:iphi:eta:phi:e:x:y:z", "",
+                [&](const unsigned int n) {
+                  vector<float>& towerid = columns.column("towerID");
+                  vector<float>& ieta = columns.column("ieta");
+                  vector<float>& iphi = columns.column("iphi");
+                  vector<float>& eta = columns.column("eta");
+                  vector<float>& phi = columns.column("phi");
+                  vector<float>& e = columns.column("e");
+                  vector<float>& x = columns.column("x");
+                  vector<float>& y = columns.column("y");
+                  vector<float>& z = columns.column("z");
+                  for (unsigned int i = 0; i < n; ++i)
+                  {
+                    towerid[i] = tower_rows[i]->get_id();
+                    ieta[i] = tower_rows[i]->get_bineta();
+                    iphi[i] = tower_rows[i]->get_binphi();
+                    eta[i] = tower_geoms[i]->get_eta();
+                    phi[i] = tower_geoms[i]->get_phi();
+                    e[i] = tower_rows[i]->get_energy();
+                    x[i] = tower_geoms[i]->get_center_x();
+                    y[i] = tower_geoms[i]->get_center_y();
+                    z[i] = tower_geoms[i]->get_center_z();
+                  }
+                });
+
+    columns.add("primary", "", "",
+                [&](const unsigned int n) {
+                  primaries.resize(n);
+                  for (unsigned int i = 0; i < n; ++i)
+                  {
+                    primaries[i] = towereval->max_truth_primary_particle_by_energy(tower_rows[i]);
+                  }
+                });
+
+    columns.add("gparticle", "gparticleID:gflavor:gnhits:geta:gphi:ge:gpt:gvx:gvy:gvz:gembed:gedep", "primary",
+                [&](const unsigned int n) {
+                  fill_primary_columns(columns, primaries);
+                });
+
+    columns.add("efromtruth", "efromtruth", "primary",
+                [&](const unsigned int n) {
+                  vector<float>& efromtruth = columns.column("efromtruth");
+                  for (unsigned int i = 0; i < n; ++i)
+                  {
+                    if (primaries[i]) efromtruth[i] = towereval->get_energy_contribution(tower_rows[i], primaries[i]);
+                  }
+                });
+
+    columns.evaluate(_ntp_tower, tower_rows.size());
   }
 
   //------------------------
@@ -721,136 +674,157 @@ void CaloEvaluator::fillOutputNtuples(PHCompositeNode* topNode)
   {
     if (Verbosity() > 1) cout << "CaloEvaluator::filling gcluster ntuple..." << endl;
 
-    GlobalVertexMap* vertexmap = findNode::getClass<GlobalVertexMap>(topNode, "GlobalVertexMap");
-
     string clusternode = "CLUSTER_" + _caloname;
-    RawClusterContainer* clusters = findNode::getClass<RawClusterContainer>(topNode, clusternode.c_str());
-    if (!clusters)
+    RawClusterContainer* clustermap = findNode::getClass<RawClusterContainer>(topNode, clusternode.c_str());
+    if (!clustermap)
     {
       cerr << PHWHERE << " ERROR: Can't find " << clusternode << endl;
       exit(-1);
     }
 
-    // for every cluster
-
-    for (const auto& iterator : clusters->getClustersMap())
+    // one row per cluster above threshold
+    vector<RawCluster*> clusters;
+    for (const auto& iterator : clustermap->getClustersMap())
     {
       RawCluster* cluster = iterator.second;
 
-      //    for (unsigned int icluster = 0; icluster < clusters->size(); icluster++)
-      //    {
-      //      RawCluster* cluster = clusters->getCluster(icluster);
-
       if (cluster->get_energy() < _reco_e_threshold) continue;
+      clusters.push_back(cluster);
+    }
 
-      float clusterID = cluster->get_id();
-      float ntowers = cluster->getNTowers();
-      float x = cluster->get_x();
-      float y = cluster->get_y();
-      float z = cluster->get_z();
-      float eta = NAN;
-      float phi = cluster->get_phi();
-      float e = cluster->get_energy();
-
-      // require vertex for cluster eta calculation
-      if (vertexmap)
-      {
-        if (!vertexmap->empty())
-        {
-          GlobalVertex* vertex = (vertexmap->begin()->second);
-
-          eta =
-              RawClusterUtility::GetPseudorapidity(
-                  *cluster,
-                  CLHEP::Hep3Vector(vertex->get_x(), vertex->get_y(), vertex->get_z()));
-        }
-      }
-
-      PHG4Particle* primary = clustereval->max_truth_primary_particle_by_energy(cluster);
+    vector<PHG4Particle*> primaries;
+
+    EvalColumns columns(cluster_varlist);
+    columns.set_verbosity(Verbosity());
+
+    columns.add("event", "event", "",
+                [&](const unsigned int n) {
+                  columns.column("event").assign(n, _ievent);
+                });
+
+    columns.add("cluster", "clusterID:ntowers:eta:x:y:z:phi:e", "",
+                [&](const unsigned int n) {
+                  fill_cluster_columns(columns, clusters, vertexmap);
+                });
+
+    columns.add("primary", "", "",
+                [&](const unsigned int n) {
+                  primaries.resize(n);
+                  for (unsigned int i = 0; i < n; ++i)
+                  {
+                    primaries[i] = clustereval->max_truth_primary_particle_by_energy(clusters[i]);
+                  }
+                });
+
+    columns.add("gparticle", "gparticleID:gflavor:gnhits:geta:gphi:ge:gpt:gvx:gvy:gvz:gembed:gedep", "primary",
+                [&](const unsigned int n) {
+                  fill_primary_columns(columns, primaries);
+                });
+
+    columns.add("efromtruth", "efromtruth", "primary",
+                [&](const unsigned int n) {
+                  vector<float>& efromtruth = columns.column("efromtruth");
+                  for (unsigned int i = 0; i < n; ++i)
+                  {
+                    if (primaries[i]) efromtruth[i] = clustereval->get_energy_contribution(clusters[i], primaries[i]);
+                  }
+                });
+
+    columns.evaluate(_ntp_cluster, clusters.size());
+  }
 
-      float gparticleID = NAN;
-      float gflavor = NAN;
+  return;
+}
 
-      float gnhits = NAN;
-      float gpx = NAN;
-      float gpy = NAN;
-      float gpz = NAN;
-      float ge = NAN;
+void CaloEvaluator::fill_primary_columns(EvalColumns& columns, const vector<PHG4Particle*>& primaries)
+{
+  CaloTruthEval* trutheval = _caloevalstack->get_truth_eval();
 
-      float gpt = NAN;
-      float geta = NAN;
-      float gphi = NAN;
+  vector<float>& gparticleID = columns.column("gparticleID");
+  vector<float>& gflavor = columns.column("gflavor");
+  vector<float>& gnhits = columns.column("gnhits");
+  vector<float>& geta = columns.column("geta");
+  vector<float>& gphi = columns.column("gphi");
+  vector<float>& ge = columns.column("ge");
+  vector<float>& gpt = columns.column("gpt");
+  vector<float>& gvx = columns.column("gvx");
+  vector<float>& gvy = columns.column("gvy");
+  vector<float>& gvz = columns.column("gvz");
+  vector<float>& gembed = columns.column("gembed");
+  vector<float>& gedep = columns.column("gedep");
+  for (unsigned int i = 0; i < primaries.size(); ++i)
+  {
+    PHG4Particle* primary = primaries[i];
+    if (!primary) continue;
 
-      float gvx = NAN;
-      float gvy = NAN;
-      float gvz = NAN;
+    gparticleID[i] = primary->get_track_id();
+    gflavor[i] = primary->get_pid();
 
-      float gembed = NAN;
-      float gedep = NAN;
+    PHG4Shower* shower = trutheval->get_primary_shower(primary);
+    if (shower)
+      gnhits[i] = shower->get_nhits(trutheval->get_caloid());
+    else
+      gnhits[i] = 0.0;
+    float gpx = primary->get_px();
+    float gpy = primary->get_py();
+    float gpz = primary->get_pz();
+    ge[i] = primary->get_e();
 
-      float efromtruth = NAN;
+    gpt[i] = sqrt(gpx * gpx + gpy * gpy);
+    if (gpt[i] != 0.0) geta[i] = asinh(gpz / gpt[i]);
+    gphi[i] = atan2(gpy, gpx);
 
-      if (primary)
-      {
-        gparticleID = primary->get_track_id();
-        gflavor = primary->get_pid();
-
-        PHG4Shower* shower = trutheval->get_primary_shower(primary);
-        if (shower)
-          gnhits = shower->get_nhits(trutheval->get_caloid());
-        else
-          gnhits = 0.0;
-        gpx = primary->get_px();
-        gpy = primary->get_py();
-        gpz = primary->get_pz();
-        ge = primary->get_e();
-
-        gpt = sqrt(gpx * gpx + gpy * gpy);
-        if (gpt != 0.0) geta = asinh(gpz / gpt);
-        gphi = atan2(gpy, gpx);
-
-        PHG4VtxPoint* vtx = trutheval->get_vertex(primary);
-
-        if (vtx)
-        {
-          gvx = vtx->get_x();
-          gvy = vtx->get_y();
-          gvz = vtx->get_z();
-        }
-
-        gembed = trutheval->get_embed(primary);
-        gedep = trutheval->get_shower_energy_deposit(primary);
-
-        efromtruth = clustereval->get_energy_contribution(cluster,
-                                                          primary);
-      }
+    PHG4VtxPoint* vtx = trutheval->get_vertex(primary);
 
-      float cluster_data[] = {(float) _ievent,
-                              clusterID,
-                              ntowers,
-                              eta,
-			      x,
-			      y,
-                              z,
-                              phi,
-                              e,
-                              gparticleID,
-                              gflavor,
-                              gnhits,
-                              geta,
-                              gphi,
-                              ge,
-                              gpt,
-                              gvx,
-                              gvy,
-                              gvz,
-                              gembed,
-                              gedep,
-                              efromtruth};
-
-      _ntp_cluster->Fill(cluster_data);
+    if (vtx)
+    {
+      gvx[i] = vtx->get_x();
+      gvy[i] = vtx->get_y();
+      gvz[i] = vtx->get_z();
     }
+
+    gembed[i] = trutheval->get_embed(primary);
+    gedep[i] = trutheval->get_shower_energy_deposit(primary);
   }
+}
 
-  return;
+void CaloEvaluator::fill_cluster_columns(EvalColumns& columns, const vector<RawCluster*>& clusters, GlobalVertexMap* vertexmap)
+{
+  vector<float>& clusterID = columns.column("clusterID");
+  vector<float>& ntowers = columns.column("ntowers");
+  vector<float>& eta = columns.column("eta");
+  vector<float>& x = columns.column("x");
+  vector<float>& y = columns.column("y");
+  vector<float>& z = columns.column("z");
+  vector<float>& phi = columns.column("phi");
+  vector<float>& e = columns.column("e");
+
+  // require vertex for cluster eta calculation
+  GlobalVertex* vertex = nullptr;
+  if (vertexmap && !vertexmap->empty())
+  {
+    vertex = (vertexmap->begin()->second);
+  }
+
+  for (unsigned int i = 0; i < clusters.size(); ++i)
+  {
+    RawCluster* cluster = clusters[i];
+    if (!cluster) continue;
+
+    clusterID[i] = cluster->get_id();
+    ntowers[i] = cluster->getNTowers();
+    x[i] = cluster->get_x();
+    y[i] = cluster->get_y();
+    z[i] = cluster->get_z();
+    phi[i] = cluster->get_phi();
+    e[i] = cluster->get_energy();
+
+    if (vertex)
+    {
+      eta[i] =
+          RawClusterUtility::GetPseudorapidity(
+              *cluster,
+              CLHEP::Hep3Vector(vertex->get_x(), vertex->get_y(), vertex->get_z()));
+    }
+  }
 }
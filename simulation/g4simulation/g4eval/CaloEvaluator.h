@@ -9,13 +9,19 @@
 
 #include <fun4all/SubsysReco.h>
 
+#include <map>
 #include <set>
 #include <string>
+#include <vector>
 
 class CaloEvalStack;
+class EvalColumns;
+class GlobalVertexMap;
 class PHCompositeNode;
 class TFile;
-class TNtuple;
+class EvalNtuple;
+class PHG4Particle;
+class RawCluster;
 class TTree; //Added by Barak
 
 /// \class CaloEvaluator
@@ -77,6 +83,11 @@ class CaloEvaluator : public SubsysReco
   void set_do_tower_eval(bool b) { _do_tower_eval = b; }
   void set_do_cluster_eval(bool b) { _do_cluster_eval = b; }
 
+  //! write only these columns ("a:b:c") of the given ntuple,
+  //! e.g. select_columns("ntp_cluster", "event:clusterID:e:ge")
+  //! Only the selected columns and what they depend on are computed (EvalColumns)
+  void select_columns(const std::string &ntuple, const std::string &columns) { _selected_columns[ntuple] = columns; }
+
  private:
   std::string _caloname;
 
@@ -109,16 +120,24 @@ class CaloEvaluator : public SubsysReco
   bool _do_tower_eval;
   bool _do_cluster_eval;
 
-  TNtuple *_ntp_gpoint;
-  TNtuple *_ntp_gshower;
-  TNtuple *_ntp_tower;
+  EvalNtuple *_ntp_gpoint;
+  EvalNtuple *_ntp_gshower;
+  EvalNtuple *_ntp_tower;
   TTree *_tower_debug; //Added by Barak
-  TNtuple *_ntp_cluster;
+  EvalNtuple *_ntp_cluster;
+
+  //! column selection per ntuple name, all columns if not set
+  std::map<std::string, std::string> _selected_columns;
 
   // evaluator output file
   std::string _filename;
   TFile *_tfile;
 
+  //! truth columns (gparticleID, gflavor, ..., gedep) of the primaries, rows without primary are NAN
+  void fill_primary_columns(EvalColumns &columns, const std::vector<PHG4Particle *> &primaries);
+  //! cluster columns (clusterID, ntowers, eta, ..., e), eta needs a vertex, rows without cluster are NAN
+  void fill_cluster_columns(EvalColumns &columns, const std::vector<RawCluster *> &clusters, GlobalVertexMap *vertexmap);
+
   // subroutines
   void printInputInfo(PHCompositeNode *topNode);     ///< print out the input object information (debugging upstream components)
   void fillOutputNtuples(PHCompositeNode *topNode);  ///< dump the evaluator information into ntuple for external analysis
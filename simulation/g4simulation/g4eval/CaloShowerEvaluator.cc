@@ -0,0 +1,195 @@
+#include "CaloShowerEvaluator.h"
+
+#include "EvalNtuple.h"
+
+#include <g4main/PHG4Hit.h>
+#include <g4main/PHG4HitContainer.h>
+#include <g4main/PHG4Particle.h>
+#include <g4main/PHG4TruthInfoContainer.h>
+#include <g4main/PHG4VtxPoint.h>
+
+#include <fun4all/Fun4AllReturnCodes.h>
+#include <fun4all/SubsysReco.h>
+
+#include <phool/getClass.h>
+#include <phool/phool.h>
+
+#include <TFile.h>
+
+#include <CLHEP/Vector/ThreeVector.h>
+
+#include <cmath>
+#include <cstdlib>
+#include <iostream>
+
+using namespace std;
+
+CaloShowerEvaluator::CaloShowerEvaluator(const string &name,
+                                         const string &caloname,
+                                         const string &filename)
+  : SubsysReco(name)
+  , _caloname(caloname)
+  , _ievent(0)
+  , _ntp_shower(nullptr)
+  , _filename(filename)
+  , _tfile(nullptr)
+{
+}
+
+int CaloShowerEvaluator::Init(PHCompositeNode *topNode)
+{
+  _ievent = 0;
+
+  _tfile = new TFile(_filename.c_str(), "RECREATE");
+
+  _ntp_shower = new EvalNtuple("ntp_shower", "calorimeter g4hit sums => leading primary",
+                               "event:gflavor:ge:geta:gphi:"
+                               "edep:lightyield:absedep:nhits:nabshits:"
+                               "radius:width:time",
+                               "event:gflavor:nhits:nabshits",
+                               _selected_columns);
+
+  return Fun4AllReturnCodes::EVENT_OK;
+}
+
+int CaloShowerEvaluator::process_event(PHCompositeNode *topNode)
+{
+  PHG4TruthInfoContainer *truthinfo = findNode::getClass<PHG4TruthInfoContainer>(topNode, "G4TruthInfo");
+  if (!truthinfo)
+  {
+    cerr << PHWHERE << " ERROR: Can't find G4TruthInfo" << endl;
+    exit(-1);
+  }
+  PHG4HitContainer *hits = findNode::getClass<PHG4HitContainer>(topNode, "G4HIT_" + _caloname);
+  if (!hits)
+  {
+    cerr << PHWHERE << " ERROR: Can't find G4HIT_" << _caloname << endl;
+    exit(-1);
+  }
+  PHG4HitContainer *absorberhits = findNode::getClass<PHG4HitContainer>(topNode, "G4HIT_ABSORBER_" + _caloname);
+
+  // the shower axis is the direction of the leading primary
+  PHG4Particle *leading = nullptr;
+  PHG4TruthInfoContainer::ConstRange range = truthinfo->GetPrimaryParticleRange();
+  for (PHG4TruthInfoContainer::ConstIterator iter = range.first; iter != range.second; ++iter)
+  {
+    if (!leading || iter->second->get_e() > leading->get_e())
+    {
+      leading = iter->second;
+    }
+  }
+
+  float gflavor = NAN;
+  float ge = NAN;
+  float geta = NAN;
+  float gphi = NAN;
+  CLHEP::Hep3Vector vertex(0, 0, 0);
+  CLHEP::Hep3Vector axis(0, 0, 0);
+  if (leading)
+  {
+    gflavor = leading->get_pid();
+    ge = leading->get_e();
+    axis = CLHEP::Hep3Vector(leading->get_px(), leading->get_py(), leading->get_pz());
+    if (axis.mag2() > 0)
+    {
+      geta = axis.eta();
+      gphi = axis.phi();
+      axis = axis.unit();
+    }
+    if (PHG4VtxPoint *vtx = truthinfo->GetVtx(leading->get_vtx_id()))
+    {
+      vertex = CLHEP::Hep3Vector(vtx->get_x(), vtx->get_y(), vtx->get_z());
+    }
+  }
+
+  float edep = 0;
+  float lightyield = 0;
+  float nhits = 0;
+  // light yield weighted moments
+  double sumradius = 0;
+  double sumdist2 = 0;
+  double sumtime = 0;
+  PHG4HitContainer::ConstRange hit_range = hits->getHits();
+  for (PHG4HitContainer::ConstIterator hit_iter = hit_range.first; hit_iter != hit_range.second; ++hit_iter)
+  {
+    const PHG4Hit *hit = hit_iter->second;
+    edep += hit->get_edep();
+    const float light = hit->get_light_yield();
+    ++nhits;
+    if (!isfinite(light))
+    {
+      continue;
+    }
+    lightyield += light;
+    const CLHEP::Hep3Vector position(hit->get_avg_x(), hit->get_avg_y(), hit->get_avg_z());
+    sumradius += light * position.perp();
+    sumtime += light * hit->get_avg_t();
+    const CLHEP::Hep3Vector fromvertex = position - vertex;
+    sumdist2 += light * (fromvertex - fromvertex.dot(axis) * axis).mag2();
+  }
+
+  float absedep = NAN;
+  float nabshits = NAN;
+  if (absorberhits)
+  {
+    absedep = 0;
+    nabshits = 0;
+    hit_range = absorberhits->getHits();
+    for (PHG4HitContainer::ConstIterator hit_iter = hit_range.first; hit_iter != hit_range.second; ++hit_iter)
+    {
+      absedep += hit_iter->second->get_edep();
+      ++nabshits;
+    }
+  }
+
+  float radius = NAN;
+  float width = NAN;
+  float time = NAN;
+  if (lightyield > 0)
+  {
+    radius = sumradius / lightyield;
+    width = sqrt(sumdist2 / lightyield);
+    time = sumtime / lightyield;
+  }
+
+  float shower_data[13] = {(float) _ievent,
+                           gflavor,
+                           ge,
+                           geta,
+                           gphi,
+                           edep,
+                           lightyield,
+                           absedep,
+                           nhits,
+                           nabshits,
+                           radius,
+                           width,
+                           time};
+
+  _ntp_shower->Fill(shower_data);
+
+  ++_ievent;
+
+  return Fun4AllReturnCodes::EVENT_OK;
+}
+
+int CaloShowerEvaluator::End(PHCompositeNode *topNode)
+{
+  _tfile->cd();
+
+  _ntp_shower->Write();
+
+  _tfile->Close();
+
+  delete _tfile;
+  delete _ntp_shower;
+
+  if (Verbosity() > 0)
+  {
+    cout << "========================= CaloShowerEvaluator::End() ==========================" << endl;
+    cout << " " << _ievent << " events of output written to: " << _filename << endl;
+    cout << "===============================================================================" << endl;
+  }
+
+  return Fun4AllReturnCodes::EVENT_OK;
+}
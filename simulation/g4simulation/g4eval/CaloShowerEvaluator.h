@@ -0,0 +1,54 @@
+#ifndef G4EVAL_CALOSHOWEREVALUATOR_H
+#define G4EVAL_CALOSHOWEREVALUATOR_H
+
+//===============================================
+/// \file CaloShowerEvaluator.h
+/// \brief Per event g4hit sums and shower shapes of a calorimeter
+//===============================================
+
+#include <fun4all/SubsysReco.h>
+
+#include <string>
+
+class EvalNtuple;
+class PHCompositeNode;
+class TFile;
+
+/// \class CaloShowerEvaluator
+///
+/// \brief Validation of the frozen shower mode against full simulation
+///
+/// Writes one entry per event with the leading primary and the sums of
+/// the G4HIT_<caloname> and G4HIT_ABSORBER_<caloname> hits: edep, light
+/// yield, number of hits, light yield weighted mean radius, transverse
+/// width around the primary direction and time. Running the same single
+/// particle events with full simulation and with a frozen shower library
+/// gives the two distributions to compare.
+///
+class CaloShowerEvaluator : public SubsysReco
+{
+ public:
+  CaloShowerEvaluator(const std::string &name = "CALOSHOWEREVALUATOR",
+                      const std::string &caloname = "CEMC",
+                      const std::string &filename = "g4eval_cemc_shower.root");
+  virtual ~CaloShowerEvaluator() {}
+
+  int Init(PHCompositeNode *topNode);
+  int process_event(PHCompositeNode *topNode);
+  int End(PHCompositeNode *topNode);
+
+  //! write only these columns of the ntuple ("a:b:c")
+  void set_selected_columns(const std::string &columns) { _selected_columns = columns; }
+
+ private:
+  std::string _caloname;
+  unsigned long _ievent;
+
+  EvalNtuple *_ntp_shower;
+  std::string _selected_columns;
+
+  std::string _filename;
+  TFile *_tfile;
+};
+
+#endif  // G4EVAL_CALOSHOWEREVALUATOR_H
@@ -0,0 +1,5 @@
+#ifdef __CINT__
+
+#pragma link C++ class CaloShowerEvaluator - !;
+
+#endif /* __CINT__ */
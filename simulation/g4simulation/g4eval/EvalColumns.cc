@@ -0,0 +1,154 @@
+#include "EvalColumns.h"
+
+#include "EvalNtuple.h"
+
+#include <cmath>
+#include <iostream>
+#include <sstream>
+
+using namespace std;
+
+namespace
+{
+  vector<string> split_list(const string &list)
+  {
+    vector<string> items;
+    istringstream stream(list);
+    string item;
+    while (getline(stream, item, ':'))
+    {
+      if (!item.empty())
+      {
+        items.push_back(item);
+      }
+    }
+    return items;
+  }
+}  // namespace
+
+EvalColumns::EvalColumns(const string &varlist)
+  : m_Columns(split_list(varlist))
+  , m_Verbosity(0)
+{
+}
+
+void EvalColumns::add(const string &name, const string &columns, const string &depends, Producer producer)
+{
+  Entry entry;
+  entry.name = name;
+  entry.columns = split_list(columns);
+  entry.producer = producer;
+  entry.needed = false;
+
+  const vector<string> depend_names = split_list(depends);
+  for (unsigned int i = 0; i < depend_names.size(); ++i)
+  {
+    unsigned int j = 0;
+    while (j < m_Producers.size() && m_Producers[j].name != depend_names[i])
+    {
+      ++j;
+    }
+    if (j == m_Producers.size())
+    {
+      cout << "EvalColumns::add - " << name << " depends on " << depend_names[i]
+           << " which was not added before, ignored" << endl;
+      continue;
+    }
+    entry.depends.push_back(j);
+  }
+
+  for (unsigned int i = 0; i < entry.columns.size(); ++i)
+  {
+    m_ColumnProducer[entry.columns[i]] = m_Producers.size();
+  }
+  m_Producers.push_back(entry);
+}
+
+bool EvalColumns::needed(const string &name) const
+{
+  for (unsigned int i = 0; i < m_Producers.size(); ++i)
+  {
+    if (m_Producers[i].name == name)
+    {
+      return m_Producers[i].needed;
+    }
+  }
+  return false;
+}
+
+void EvalColumns::evaluate(EvalNtuple *ntuple, const unsigned int n)
+{
+  // producers of the selected columns ...
+  for (unsigned int i = 0; i < m_Producers.size(); ++i)
+  {
+    m_Producers[i].needed = false;
+  }
+  for (unsigned int i = 0; i < m_Columns.size(); ++i)
+  {
+    if (!ntuple->selected(m_Columns[i]))
+    {
+      continue;
+    }
+    map<string, unsigned int>::const_iterator iter = m_ColumnProducer.find(m_Columns[i]);
+    if (iter == m_ColumnProducer.end())
+    {
+      if (m_Verbosity > 0)
+      {
+        cout << "EvalColumns::evaluate - no producer for column " << m_Columns[i] << endl;
+      }
+      continue;
+    }
+    m_Producers[iter->second].needed = true;
+  }
+
+  // ... and their dependencies, which are always added before
+  for (unsigned int i = m_Producers.size(); i-- > 0;)
+  {
+    if (!m_Producers[i].needed)
+    {
+      continue;
+    }
+    for (unsigned int j = 0; j < m_Producers[i].depends.size(); ++j)
+    {
+      m_Producers[m_Producers[i].depends[j]].needed = true;
+    }
+  }
+
+  for (unsigned int i = 0; i < m_Producers.size(); ++i)
+  {
+    Entry &entry = m_Producers[i];
+    if (!entry.needed)
+    {
+      continue;
+    }
+    for (unsigned int j = 0; j < entry.columns.size(); ++j)
+    {
+      m_Data[entry.columns[j]].assign(n, NAN);
+    }
+    if (m_Verbosity > 1)
+    {
+      cout << "EvalColumns::evaluate - running " << entry.name << " for " << n << " rows" << endl;
+    }
+    entry.producer(n);
+  }
+
+  // fill the rows, columns which were not computed are NAN
+  vector<const vector<float> *> values(m_Columns.size(), nullptr);
+  for (unsigned int i = 0; i < m_Columns.size(); ++i)
+  {
+    map<string, unsigned int>::const_iterator iter = m_ColumnProducer.find(m_Columns[i]);
+    if (iter != m_ColumnProducer.end() && m_Producers[iter->second].needed)
+    {
+      values[i] = &m_Data[m_Columns[i]];
+    }
+  }
+  vector<float> row(m_Columns.size());
+  for (unsigned int irow = 0; irow < n; ++irow)
+  {
+    for (unsigned int i = 0; i < m_Columns.size(); ++i)
+    {
+      row[i] = values[i] ? (*values[i])[irow] : NAN;
+    }
+    ntuple->Fill(row.data());
+  }
+}
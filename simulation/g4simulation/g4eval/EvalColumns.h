@@ -0,0 +1,74 @@
+#ifndef G4EVAL_EVALCOLUMNS_H
+#define G4EVAL_EVALCOLUMNS_H
+
+#include <functional>
+#include <map>
+#include <string>
+#include <vector>
+
+class EvalNtuple;
+
+/// \class EvalColumns
+///
+/// \brief Lazily computed columns of one evaluator ntuple
+///
+/// The columns of an ntuple are filled by producers registered with add().
+/// A producer has a name, the columns it fills and the producers it depends
+/// on, and computes its columns for all n objects (rows) of the event in one
+/// call. Producers without columns hold intermediate per object results
+/// (matched truth hits, particles, ...) for the others.
+///
+/// evaluate() only runs the producers needed for the columns selected in the
+/// ntuple (EvalNtuple::selected) and their dependencies, in the order they
+/// were added, then fills the ntuple row by row. Columns which were not
+/// computed are NAN.
+///
+/// The rows themselves (and any truth matching which decides whether an
+/// object gets a row, e.g. with SvtxEvaluator::scan_for_embedded) are
+/// determined before by the evaluator.
+class EvalColumns
+{
+ public:
+  //! computes the columns of the producer for rows 0 ... n-1
+  typedef std::function<void(const unsigned int n)> Producer;
+
+  //! varlist in the "a:b:c" order of the ntuple
+  explicit EvalColumns(const std::string &varlist);
+  virtual ~EvalColumns() {}
+
+  //! columns and depends are ":" separated lists, dependencies have to be added before
+  void add(const std::string &name, const std::string &columns, const std::string &depends, Producer producer);
+
+  //! values of a column, n entries initialised to NAN when its producer runs
+  std::vector<float> &column(const std::string &name) { return m_Data[name]; }
+
+  //! true if the producer runs in the current evaluate()
+  bool needed(const std::string &name) const;
+
+  //! runs the producers needed for the selected columns and fills n rows
+  void evaluate(EvalNtuple *ntuple, const unsigned int n);
+
+  void set_verbosity(const int v) { m_Verbosity = v; }
+
+ private:
+  struct Entry
+  {
+    std::string name;
+    std::vector<std::string> columns;
+    std::vector<unsigned int> depends;
+    Producer producer;
+    bool needed;
+  };
+
+  std::vector<std::string> m_Columns;
+  std::vector<Entry> m_Producers;
+
+  //! producer of each column
+  std::map<std::string, unsigned int> m_ColumnProducer;
+
+  std::map<std::string, std::vector<float> > m_Data;
+
+  int m_Verbosity;
+};
+
+#endif
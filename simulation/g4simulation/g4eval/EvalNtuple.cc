@@ -0,0 +1,103 @@
+#include "EvalNtuple.h"
+
+#include <TTree.h>
+
+#include <cmath>
+#include <sstream>
+
+using namespace std;
+
+namespace
+{
+  set<string> split_columns(const string &varlist)
+  {
+    set<string> columns;
+    istringstream stream(varlist);
+    string column;
+    while (getline(stream, column, ':'))
+    {
+      if (!column.empty())
+      {
+        columns.insert(column);
+      }
+    }
+    return columns;
+  }
+}  // namespace
+
+EvalNtuple::EvalNtuple(const string &name, const string &title,
+                       const string &varlist, const string &intcolumns,
+                       const string &selection)
+  : m_Tree(new TTree(name.c_str(), title.c_str()))
+{
+  const set<string> selected_columns = split_columns(selection);
+  const set<string> integer_columns = split_columns(intcolumns);
+
+  istringstream stream(varlist);
+  string column;
+  while (getline(stream, column, ':'))
+  {
+    m_Columns.push_back(column);
+    if (!selected_columns.empty() && selected_columns.find(column) == selected_columns.end())
+    {
+      continue;
+    }
+    m_Index.push_back(m_Columns.size() - 1);
+    m_IsInteger.push_back(integer_columns.find(column) != integer_columns.end());
+  }
+
+  // buffers must not move once the branches point to them
+  m_FloatData.resize(m_Index.size());
+  m_IntData.resize(m_Index.size());
+  for (unsigned int i = 0; i < m_Index.size(); ++i)
+  {
+    const string &col = m_Columns[m_Index[i]];
+    if (m_IsInteger[i])
+    {
+      m_Tree->Branch(col.c_str(), &m_IntData[i], (col + "/L").c_str());
+    }
+    else
+    {
+      m_Tree->Branch(col.c_str(), &m_FloatData[i], (col + "/F").c_str());
+    }
+  }
+}
+
+void EvalNtuple::Fill(const float *data)
+{
+  if (m_Index.empty())
+  {
+    return;
+  }
+  for (unsigned int i = 0; i < m_Index.size(); ++i)
+  {
+    const float value = data[m_Index[i]];
+    if (m_IsInteger[i])
+    {
+      // NAN marks a missing value (negative ids are valid g4 secondaries)
+      m_IntData[i] = (std::isfinite(value) && std::fabs(value) < 9.2e18) ? static_cast<long long>(value) : kMissing;
+    }
+    else
+    {
+      m_FloatData[i] = value;
+    }
+  }
+  m_Tree->Fill();
+}
+
+int EvalNtuple::Write()
+{
+  return m_Tree->Write();
+}
+
+bool EvalNtuple::selected(const string &column) const
+{
+  for (unsigned int i = 0; i < m_Index.size(); ++i)
+  {
+    if (m_Columns[m_Index[i]] == column)
+    {
+      return true;
+    }
+  }
+  return false;
+}
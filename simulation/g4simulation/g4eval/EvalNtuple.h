@@ -0,0 +1,61 @@
+#ifndef G4EVAL_EVALNTUPLE_H
+#define G4EVAL_EVALNTUPLE_H
+
+#include <set>
+#include <string>
+#include <vector>
+
+class TTree;
+
+/// \class EvalNtuple
+///
+/// \brief Typed, column selectable replacement for the evaluator TNtuples
+///
+/// Takes the same "a:b:c" column list and the same Fill(float*) array as
+/// TNtuple, so the evaluators keep their fill code. The output is a split
+/// TTree with one branch per column: the columns listed in intcolumns
+/// (counts, ids and flags, declared where the ntuple is booked) are
+/// written as 64 bit integers, all others as floats. If a column selection
+/// is given only those columns get a branch,
+/// the evaluators can ask selected() to skip computing the others.
+/// The tree belongs to the directory which is current at construction
+/// (the evaluator output file).
+class EvalNtuple
+{
+ public:
+  //! intcolumns: the columns of varlist stored as integer, "a:b"
+  EvalNtuple(const std::string &name, const std::string &title,
+             const std::string &varlist,
+             const std::string &intcolumns,
+             const std::string &selection = "");
+  virtual ~EvalNtuple() {}
+
+  //! data has one entry per column of varlist (selected or not)
+  void Fill(const float *data);
+  int Write();
+
+  //! true if the column is written out
+  bool selected(const std::string &column) const;
+  //! true if no column of the list is written out
+  bool empty() const { return m_Index.empty(); }
+
+  TTree *tree() { return m_Tree; }
+
+  //! integer column value for a NAN in the Fill array
+  static const long long kMissing = -9223372036854775807LL - 1;
+
+ private:
+  TTree *m_Tree;
+
+  std::vector<std::string> m_Columns;
+
+  //! index into the Fill array of each written column
+  std::vector<unsigned int> m_Index;
+  std::vector<bool> m_IsInteger;
+
+  //! branch buffers, one of them is used per written column
+  std::vector<float> m_FloatData;
+  std::vector<long long> m_IntData;
+};
+
+#endif
@@ -1,5 +1,6 @@
 #include "JetEvaluator.h"
 
+#include "EvalNtuple.h"
 #include "JetEvalStack.h"
 #include "JetRecoEval.h"
 
@@ -13,7 +14,6 @@
 #include <phool/phool.h>
 
 #include <TFile.h>
-#include <TNtuple.h>
 
 #include <cstdlib>
 #include <cmath>
@@ -48,15 +48,19 @@ int JetEvaluator::Init(PHCompositeNode *topNode)
 
   _tfile = new TFile(_filename.c_str(), "RECREATE");
 
-  if (_do_recojet_eval) _ntp_recojet = new TNtuple("ntp_recojet", "reco jet => max truth jet",
+  if (_do_recojet_eval) _ntp_recojet = new EvalNtuple("ntp_recojet", "reco jet => max truth jet",
                                                    "event:id:ncomp:eta:phi:e:pt:"
                                                    "gid:gncomp:geta:gphi:ge:gpt:"
-                                                   "efromtruth");
+                                                   "efromtruth",
+                                                   "event:id:ncomp:gid:gncomp",
+                                                   _selected_columns["ntp_recojet"]);
 
-  if (_do_truthjet_eval) _ntp_truthjet = new TNtuple("ntp_truthjet", "truth jet => best reco jet",
+  if (_do_truthjet_eval) _ntp_truthjet = new EvalNtuple("ntp_truthjet", "truth jet => best reco jet",
                                                      "event:gid:gncomp:geta:gphi:ge:gpt:"
                                                      "id:ncomp:eta:phi:e:pt:"
-                                                     "efromtruth");
+                                                     "efromtruth",
+                                                     "event:gid:gncomp:id:ncomp",
+                                                     _selected_columns["ntp_truthjet"]);
 
   return Fun4AllReturnCodes::EVENT_OK;
 }
@@ -107,6 +111,8 @@ int JetEvaluator::End(PHCompositeNode *topNode)
   _tfile->Close();
 
   delete _tfile;
+  delete _ntp_recojet;
+  delete _ntp_truthjet;
 
   if (Verbosity() > 0)
   {
@@ -9,12 +9,13 @@
 
 #include <fun4all/SubsysReco.h>
 
+#include <map>
 #include <string>
 
 class JetEvalStack;
 class PHCompositeNode;
 class TFile;
-class TNtuple;
+class EvalNtuple;
 
 /// \class JetEvaluator
 ///
@@ -39,6 +40,10 @@ class JetEvaluator : public SubsysReco
 
   void set_strict(bool b) { _strict = b; }
 
+  //! write only these columns ("a:b:c") of the given ntuple,
+  //! e.g. select_columns("ntp_recojet", "event:id:e:ge")
+  void select_columns(const std::string &ntuple, const std::string &columns) { _selected_columns[ntuple] = columns; }
+
  private:
   std::string _recojetname;
   std::string _truthjetname;
@@ -55,8 +60,11 @@ class JetEvaluator : public SubsysReco
   bool _do_recojet_eval;
   bool _do_truthjet_eval;
 
-  TNtuple *_ntp_recojet;
-  TNtuple *_ntp_truthjet;
+  EvalNtuple *_ntp_recojet;
+  EvalNtuple *_ntp_truthjet;
+
+  //! column selection per ntuple name, all columns if not set
+  std::map<std::string, std::string> _selected_columns;
 
   // evaluator output file
   std::string _filename;
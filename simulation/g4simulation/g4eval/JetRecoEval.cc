@@ -31,6 +31,8 @@
 #include <map>
 #include <set>
 #include <string>
+#include <utility>
+#include <vector>
 
 using namespace std;
 
@@ -66,6 +68,9 @@ JetRecoEval::JetRecoEval(PHCompositeNode* topNode,
   , _cache_get_energy_contribution()
   , _cache_get_energy_contribution_src()
   , _cache_all_truth_hits()
+  , _overlap_built(false)
+  , _overlap_by_reco()
+  , _overlap_by_truth()
 {
   get_node_pointers(topNode);
 }
@@ -93,6 +98,10 @@ void JetRecoEval::next_event(PHCompositeNode* topNode)
   _cache_get_energy_contribution_src.clear();
   _cache_all_truth_hits.clear();
 
+  _overlap_built = false;
+  _overlap_by_reco.clear();
+  _overlap_by_truth.clear();
+
   _jettrutheval.next_event(topNode);
 
   get_node_pointers(topNode);
@@ -756,6 +765,29 @@ Jet* JetRecoEval::max_truth_jet_by_energy(Jet* recojet)
   Jet* truthjet = nullptr;
   float max_energy = FLT_MAX * -1.0;
 
+  if (_do_cache)
+  {
+    build_overlap_table();
+    std::map<Jet*, std::map<Jet*, float> >::const_iterator row = _overlap_by_reco.find(recojet);
+    if (row != _overlap_by_reco.end())
+    {
+      // same candidates and order as the loop below
+      for (std::map<Jet*, float>::const_iterator iter = row->second.begin();
+           iter != row->second.end();
+           ++iter)
+      {
+        if (iter->second > max_energy)
+        {
+          truthjet = iter->first;
+          max_energy = iter->second;
+        }
+      }
+
+      _cache_max_truth_jet_by_energy.insert(make_pair(recojet, truthjet));
+      return truthjet;
+    }
+  }
+
   std::set<Jet*> truthjets = all_truth_jets(recojet);
   for (std::set<Jet*>::iterator iter = truthjets.begin();
        iter != truthjets.end();
@@ -872,6 +904,29 @@ Jet* JetRecoEval::best_jet_from(Jet* truthjet)
   Jet* bestrecojet = nullptr;
   float max_energy = FLT_MAX * -1.0;
 
+  if (_do_cache)
+  {
+    build_overlap_table();
+    std::map<Jet*, std::map<Jet*, float> >::const_iterator column = _overlap_by_truth.find(truthjet);
+    if (column != _overlap_by_truth.end())
+    {
+      // same candidates and order as the loop below
+      for (std::map<Jet*, float>::const_iterator iter = column->second.begin();
+           iter != column->second.end();
+           ++iter)
+      {
+        if (iter->second > max_energy)
+        {
+          bestrecojet = iter->first;
+          max_energy = iter->second;
+        }
+      }
+
+      _cache_best_jet_from.insert(make_pair(truthjet, bestrecojet));
+      return bestrecojet;
+    }
+  }
+
   std::set<Jet*> recojets = all_jets_from(truthjet);
   for (std::set<Jet*>::iterator iter = recojets.begin();
        iter != recojets.end();
@@ -978,6 +1033,12 @@ float JetRecoEval::get_energy_contribution(Jet* recojet, Jet* truthjet)
     {
       return iter->second;
     }
+
+    float energy = 0.0;
+    if (get_overlap(recojet, truthjet, energy))
+    {
+      return energy;
+    }
   }
 
   float energy_contribution = 0.0;
@@ -1711,6 +1772,229 @@ std::set<PHG4Hit*> JetRecoEval::all_truth_hits(Jet* recojet)
   return truth_hits;
 }
 
+void JetRecoEval::build_overlap_table()
+{
+  if (_overlap_built) return;
+  _overlap_built = true;
+
+  _overlap_by_reco.clear();
+  _overlap_by_truth.clear();
+
+  if (!_recojets || !_truthjets) return;
+
+  // truth particle => truth jet
+  std::map<int, Jet*> truthjet_of_particle;
+  for (JetMap::Iter iter = _truthjets->begin();
+       iter != _truthjets->end();
+       ++iter)
+  {
+    Jet* truthjet = iter->second;
+    _overlap_by_truth[truthjet];
+
+    for (Jet::ConstIter jter = truthjet->begin_comp();
+         jter != truthjet->end_comp();
+         ++jter)
+    {
+      truthjet_of_particle[jter->second] = truthjet;
+    }
+  }
+
+  std::vector<std::pair<int, float> > contributions;
+  for (JetMap::Iter iter = _recojets->begin();
+       iter != _recojets->end();
+       ++iter)
+  {
+    Jet* recojet = iter->second;
+    std::map<Jet*, float>& row = _overlap_by_reco[recojet];
+
+    // candidates as in max_truth_jet_by_energy, also those without energy
+    std::set<Jet*> candidates = all_truth_jets(recojet);
+    for (std::set<Jet*>::iterator jter = candidates.begin();
+         jter != candidates.end();
+         ++jter)
+    {
+      if (*jter) row[*jter] = 0.0;
+    }
+
+    // each constituent is attributed once, instead of once per truth jet
+    for (Jet::ConstIter jter = recojet->begin_comp();
+         jter != recojet->end_comp();
+         ++jter)
+    {
+      contributions.clear();
+      if (!get_truth_contributions(jter->first, jter->second, contributions)) continue;
+
+      for (unsigned int i = 0; i < contributions.size(); ++i)
+      {
+        std::map<int, Jet*>::const_iterator truthjet = truthjet_of_particle.find(contributions[i].first);
+        if (truthjet == truthjet_of_particle.end()) continue;
+
+        row[truthjet->second] += contributions[i].second;
+      }
+    }
+
+    for (std::map<Jet*, float>::const_iterator jter = row.begin();
+         jter != row.end();
+         ++jter)
+    {
+      _overlap_by_truth[jter->first][recojet] = jter->second;
+    }
+  }
+}
+
+bool JetRecoEval::get_overlap(Jet* recojet, Jet* truthjet, float& energy)
+{
+  build_overlap_table();
+
+  std::map<Jet*, std::map<Jet*, float> >::const_iterator row = _overlap_by_reco.find(recojet);
+  if (row == _overlap_by_reco.end()) return false;
+  if (_overlap_by_truth.find(truthjet) == _overlap_by_truth.end()) return false;
+
+  std::map<Jet*, float>::const_iterator iter = row->second.find(truthjet);
+  energy = (iter == row->second.end()) ? 0.0 : iter->second;
+  return true;
+}
+
+bool JetRecoEval::get_truth_contributions(Jet::SRC source, unsigned int index,
+                                          std::vector<std::pair<int, float> >& contributions)
+{
+  if (source == Jet::TRACK)
+  {
+    SvtxTrack* track = _trackmap ? _trackmap->get(index) : nullptr;
+
+    if (_strict)
+    {
+      assert(track);
+    }
+    else if (!track)
+    {
+      ++_errors;
+      return false;
+    }
+
+    PHG4Particle* maxtruthparticle = get_svtx_eval_stack()->get_track_eval()->max_truth_particle_by_nclusters(track);
+
+    if (_strict)
+    {
+      assert(maxtruthparticle);
+    }
+    else if (!maxtruthparticle)
+    {
+      ++_errors;
+      return false;
+    }
+
+    contributions.push_back(make_pair(maxtruthparticle->get_track_id(), track->get_p()));
+    return true;
+  }
+
+  CaloEvalStack* evalstack = nullptr;
+  RawTowerContainer* towers = nullptr;
+  RawClusterContainer* clusters = nullptr;
+  bool is_cluster = false;
+  switch (source)
+  {
+  case Jet::CEMC_TOWER:
+    evalstack = get_cemc_eval_stack();
+    towers = _cemctowers;
+    break;
+  case Jet::CEMC_CLUSTER:
+    evalstack = get_cemc_eval_stack();
+    clusters = _cemcclusters;
+    is_cluster = true;
+    break;
+  case Jet::HCALIN_TOWER:
+    evalstack = get_hcalin_eval_stack();
+    towers = _hcalintowers;
+    break;
+  case Jet::HCALIN_CLUSTER:
+    evalstack = get_hcalin_eval_stack();
+    clusters = _hcalinclusters;
+    is_cluster = true;
+    break;
+  case Jet::HCALOUT_TOWER:
+    evalstack = get_hcalout_eval_stack();
+    towers = _hcalouttowers;
+    break;
+  case Jet::HCALOUT_CLUSTER:
+    evalstack = get_hcalout_eval_stack();
+    clusters = _hcaloutclusters;
+    is_cluster = true;
+    break;
+  case Jet::FEMC_TOWER:
+    evalstack = get_femc_eval_stack();
+    towers = _femctowers;
+    break;
+  case Jet::FEMC_CLUSTER:
+    evalstack = get_femc_eval_stack();
+    clusters = _femcclusters;
+    is_cluster = true;
+    break;
+  case Jet::FHCAL_TOWER:
+    evalstack = get_fhcal_eval_stack();
+    towers = _fhcaltowers;
+    break;
+  case Jet::FHCAL_CLUSTER:
+    evalstack = get_fhcal_eval_stack();
+    clusters = _fhcalclusters;
+    is_cluster = true;
+    break;
+  default:
+    // no truth energy from other sources, as in get_energy_contribution(recojet, truthjet)
+    return false;
+  }
+
+  if (is_cluster)
+  {
+    RawCluster* cluster = clusters ? clusters->getCluster(index) : nullptr;
+
+    if (_strict)
+    {
+      assert(cluster);
+    }
+    else if (!cluster)
+    {
+      ++_errors;
+      return false;
+    }
+
+    // particles without a contribution add no energy
+    std::set<PHG4Particle*> particles = evalstack->get_rawcluster_eval()->all_truth_primary_particles(cluster);
+    for (std::set<PHG4Particle*>::iterator iter = particles.begin();
+         iter != particles.end();
+         ++iter)
+    {
+      contributions.push_back(make_pair((*iter)->get_track_id(),
+                                        evalstack->get_rawcluster_eval()->get_energy_contribution(cluster, *iter)));
+    }
+  }
+  else
+  {
+    RawTower* tower = towers ? towers->getTower(index) : nullptr;
+
+    if (_strict)
+    {
+      assert(tower);
+    }
+    else if (!tower)
+    {
+      ++_errors;
+      return false;
+    }
+
+    std::set<PHG4Particle*> particles = evalstack->get_rawtower_eval()->all_truth_primary_particles(tower);
+    for (std::set<PHG4Particle*>::iterator iter = particles.begin();
+         iter != particles.end();
+         ++iter)
+    {
+      contributions.push_back(make_pair((*iter)->get_track_id(),
+                                        evalstack->get_rawtower_eval()->get_energy_contribution(tower, *iter)));
+    }
+  }
+
+  return true;
+}
+
 void JetRecoEval::get_node_pointers(PHCompositeNode* topNode)
 {
   // need things off of the DST...
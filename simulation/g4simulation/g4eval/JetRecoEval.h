@@ -9,6 +9,7 @@
 #include <set>
 #include <string>
 #include <utility>
+#include <vector>
 
 class CaloEvalStack;
 
@@ -127,6 +128,18 @@ class JetRecoEval
  private:
   void get_node_pointers(PHCompositeNode* topNode);
 
+  /// fills the reco x truth jet energy overlaps of the event, once per event
+  /// (used when caching is on): every reco jet constituent is attributed to
+  /// its truth primaries once, then summed per truth jet
+  void build_overlap_table();
+
+  /// overlap of the two jets from the table, false if either is not in it
+  bool get_overlap(Jet* recojet, Jet* truthjet, float& energy);
+
+  /// (truth track id, energy) contributions to a reco jet constituent
+  bool get_truth_contributions(Jet::SRC source, unsigned int index,
+                               std::vector<std::pair<int, float> >& contributions);
+
   JetTruthEval _jettrutheval;
   std::string _recojetname;
   std::string _truthjetname;
@@ -160,6 +173,12 @@ class JetRecoEval
   std::map<std::pair<Jet*, Jet*>, float> _cache_get_energy_contribution;
   std::map<std::pair<Jet*, Jet::SRC>, float> _cache_get_energy_contribution_src;  /// used in get_energy_contribution (Jet* recojet, Jet::SRC src);
   std::map<Jet*, std::set<PHG4Hit*> > _cache_all_truth_hits;
+
+  /// reco jet => truth jet => energy, for the candidate truth jets of all_truth_jets()
+  bool _overlap_built;
+  std::map<Jet*, std::map<Jet*, float> > _overlap_by_reco;
+  /// truth jet => reco jet => energy, the same entries, every truth jet has a column
+  std::map<Jet*, std::map<Jet*, float> > _overlap_by_truth;
 };
 
 #endif  // G4EVAL_JETRECOEVAL_H
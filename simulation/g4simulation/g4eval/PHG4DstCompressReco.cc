@@ -6,10 +6,14 @@
 #include <g4main/PHG4Shower.h>
 #include <g4main/PHG4TruthInfoContainer.h>
 
+#include <g4detectors/PHG4Cell.h>
 #include <g4detectors/PHG4CellContainer.h>
 
+#include <calobase/RawCluster.h>
+#include <calobase/RawClusterContainer.h>
 #include <calobase/RawTower.h>
 #include <calobase/RawTowerContainer.h>
+#include <calobase/RawTowerv2.h>
 
 #include <fun4all/Fun4AllReturnCodes.h>
 #include <fun4all/SubsysReco.h>
@@ -18,25 +22,106 @@
 #include <phool/PHIODataNode.h>
 #include <phool/PHNode.h>
 #include <phool/PHNodeIterator.h>
+#include <phool/PHObject.h>
 #include <phool/PHPointerListIterator.h>
 #include <phool/getClass.h>
 
+#include <TClass.h>
+
+#include <algorithm>
+#include <atomic>
+#include <cmath>
+#include <iomanip>
 #include <iostream>
+#include <thread>
+#include <unordered_set>
 #include <utility>
 
 using namespace std;
 
+namespace
+{
+  // in memory size of an object, used for the estimate of the saved bytes
+  double ObjectSize(const PHObject* obj)
+  {
+    return obj->IsA()->Size();
+  }
+}  // namespace
+
+PHG4DstCompressReco::CompressPolicy::CompressPolicy()
+  : drop_all(false)
+  , energy_threshold(-INFINITY)
+  , keep_primary_energy(NAN)
+  , drop_g4cells(false)
+  , reduce_precision(false)
+{
+}
+
 PHG4DstCompressReco::PHG4DstCompressReco(const string& name)
   : SubsysReco(name)
   , _truth_info(nullptr)
-  , _compress_g4hit_names()
-  , _compress_g4cell_names()
-  , _g4cells()
-  , _g4hits()
+  , _threads(4)
   , _keep_g4hits()
 {
 }
 
+void PHG4DstCompressReco::AddHitContainer(const string& name)
+{
+  CompressPolicy policy;
+  policy.drop_all = true;
+  SetPolicy(name, kHits, policy);
+}
+
+void PHG4DstCompressReco::AddCellContainer(const string& name)
+{
+  CompressPolicy policy;
+  policy.drop_all = true;
+  SetPolicy(name, kCells, policy);
+}
+
+void PHG4DstCompressReco::AddTowerContainer(const string& name)
+{
+  CompressPolicy policy;
+  policy.drop_g4cells = true;
+  SetPolicy(name, kTowers, policy);
+}
+
+void PHG4DstCompressReco::SetHitPolicy(const string& name, const CompressPolicy& policy)
+{
+  SetPolicy(name, kHits, policy);
+}
+
+void PHG4DstCompressReco::SetCellPolicy(const string& name, const CompressPolicy& policy)
+{
+  SetPolicy(name, kCells, policy);
+}
+
+void PHG4DstCompressReco::SetTowerPolicy(const string& name, const CompressPolicy& policy)
+{
+  SetPolicy(name, kTowers, policy);
+}
+
+void PHG4DstCompressReco::SetPolicy(const string& name, const ContainerType type, const CompressPolicy& policy)
+{
+  for (auto& container : _containers)
+  {
+    if (container.name == name && container.type == type)
+    {
+      container.policy = policy;
+      return;
+    }
+  }
+  Container container;
+  container.name = name;
+  container.type = type;
+  container.policy = policy;
+  container.object = nullptr;
+  container.clusters = nullptr;
+  container.removed = 0;
+  container.bytes = 0;
+  _containers.push_back(container);
+}
+
 int PHG4DstCompressReco::InitRun(PHCompositeNode* topNode)
 {
   _truth_info = findNode::getClass<PHG4TruthInfoContainer>(topNode, "G4TruthInfo");
@@ -46,29 +131,38 @@ int PHG4DstCompressReco::InitRun(PHCompositeNode* topNode)
     return Fun4AllReturnCodes::ABORTRUN;
   }
 
+  _keep_g4hits.clear();
   SearchG4HitNodes(topNode);
 
-  for (std::set<std::string>::iterator iter = _compress_g4cell_names.begin();
-       iter != _compress_g4cell_names.end(); ++iter)
+  for (auto& container : _containers)
   {
-    std::string name = *iter;
-
-    PHG4CellContainer* g4cells = findNode::getClass<PHG4CellContainer>(topNode, name.c_str());
-    if (g4cells)
+    container.object = nullptr;
+    container.clusters = nullptr;
+    switch (container.type)
     {
-      _g4cells.insert(g4cells);
+    case kHits:
+      container.object = findNode::getClass<PHG4HitContainer>(topNode, container.name);
+      break;
+    case kCells:
+      container.object = findNode::getClass<PHG4CellContainer>(topNode, container.name);
+      break;
+    case kTowers:
+      container.object = findNode::getClass<RawTowerContainer>(topNode, container.name);
+      if (!container.policy.cluster_node.empty())
+      {
+        container.clusters = findNode::getClass<RawClusterContainer>(topNode, container.policy.cluster_node);
+        if (!container.clusters)
+        {
+          cout << "PHG4DstCompressReco::InitRun(): Can't find " << container.policy.cluster_node
+               << " for " << container.name << endl;
+          return Fun4AllReturnCodes::ABORTRUN;
+        }
+      }
+      break;
     }
-  }
-
-  for (std::set<std::string>::iterator iter = _compress_tower_names.begin();
-       iter != _compress_tower_names.end(); ++iter)
-  {
-    std::string name = *iter;
-
-    RawTowerContainer* towers = findNode::getClass<RawTowerContainer>(topNode, name.c_str());
-    if (towers)
+    if (!container.object && Verbosity() > 0)
     {
-      _towers.insert(towers);
+      cout << "PHG4DstCompressReco::InitRun(): " << container.name << " not found, not compressed" << endl;
     }
   }
 
@@ -77,33 +171,56 @@ int PHG4DstCompressReco::InitRun(PHCompositeNode* topNode)
 
 int PHG4DstCompressReco::process_event(PHCompositeNode* topNode)
 {
-  if (_g4hits.empty() && _g4cells.empty() && _towers.empty()) return Fun4AllReturnCodes::EVENT_OK;
+  if (_containers.empty()) return Fun4AllReturnCodes::EVENT_OK;
 
-  //---cells--------------------------------------------------------------------
+  //---selection, containers are independent so they are done in parallel------
 
-  for (std::set<PHG4CellContainer*>::iterator iter = _g4cells.begin();
-       iter != _g4cells.end();
-       ++iter)
+  atomic<unsigned int> next(0);
+  auto worker = [this, &next]() {
+    unsigned int i;
+    while ((i = next++) < _containers.size())
+    {
+      Select(_containers[i]);
+    }
+  };
+  unsigned int nthreads = min(_threads, static_cast<unsigned int>(_containers.size()));
+  if (nthreads > 1)
   {
-    PHG4CellContainer* cells = *iter;
-    cells->Reset();  // DROP ALL COMPRESSED G4CELLS
+    vector<thread> workers;
+    for (unsigned int i = 0; i < nthreads; i++)
+    {
+      workers.push_back(thread(worker));
+    }
+    for (auto& t : workers)
+    {
+      t.join();
+    }
+  }
+  else
+  {
+    worker();
   }
 
-  //---hits---------------------------------------------------------------------
+  //---removal------------------------------------------------------------------
 
-  for (std::set<PHG4HitContainer*>::iterator iter = _g4hits.begin();
-       iter != _g4hits.end();
-       ++iter)
+  for (auto& container : _containers)
   {
-    PHG4HitContainer* hits = *iter;
-    hits->Reset();  // DROP ALL COMPRESSED G4HITS
+    Apply(container);
   }
 
   //---secondary particles and vertexes-----------------------------------------
 
+  std::set<PHG4HitContainer*> keep_g4hits = _keep_g4hits;
+  for (auto& container : _containers)
+  {
+    if (container.type == kHits && container.object && !container.policy.drop_all)
+    {
+      keep_g4hits.insert(static_cast<PHG4HitContainer*>(container.object));
+    }
+  }
   std::set<int> keep_particle_ids;
-  for (std::set<PHG4HitContainer*>::iterator iter = _keep_g4hits.begin();
-       iter != _keep_g4hits.end();
+  for (std::set<PHG4HitContainer*>::iterator iter = keep_g4hits.begin();
+       iter != keep_g4hits.end();
        ++iter)
   {
     PHG4HitContainer* hits = *iter;
@@ -170,23 +287,6 @@ int PHG4DstCompressReco::process_event(PHCompositeNode* topNode)
     shower->clear_g4hit_id();
   }
 
-  //---tower cell entries-------------------------------------------------------
-  for (std::set<RawTowerContainer*>::iterator iter = _towers.begin();
-       iter != _towers.end();
-       ++iter)
-  {
-    RawTowerContainer* towers = *iter;
-
-    // loop over all the towers
-    for (RawTowerContainer::Iterator jter = towers->getTowers().first;
-         jter != towers->getTowers().second;
-         ++jter)
-    {
-      RawTower* tower = jter->second;
-      tower->clear_g4cells();
-    }
-  }
-
   return Fun4AllReturnCodes::EVENT_OK;
 }
 
@@ -221,12 +321,16 @@ void PHG4DstCompressReco::SearchG4HitNodes(PHCompositeNode* top)
               dynamic_cast<PHG4HitContainer*>(DNode->getData());
           if (object)
           {
-            if (_compress_g4hit_names.find(thisNode->getName()) !=
-                _compress_g4hit_names.end())
+            bool compressed = false;
+            for (auto& container : _containers)
             {
-              _g4hits.insert(object);
+              if (container.type == kHits && container.name == thisNode->getName())
+              {
+                compressed = true;
+                break;
+              }
             }
-            else
+            if (!compressed)
             {
               _keep_g4hits.insert(object);
             }
@@ -236,3 +340,256 @@ void PHG4DstCompressReco::SearchG4HitNodes(PHCompositeNode* top)
     }
   }
 }
+
+void PHG4DstCompressReco::Select(Container& container)
+{
+  container.drop.clear();
+  if (!container.object || container.policy.drop_all)
+  {
+    return;
+  }
+  const CompressPolicy& policy = container.policy;
+  switch (container.type)
+  {
+  case kHits:
+  {
+    PHG4HitContainer* hits = static_cast<PHG4HitContainer*>(container.object);
+    for (PHG4HitContainer::ConstIterator iter = hits->getHits().first;
+         iter != hits->getHits().second;
+         ++iter)
+    {
+      PHG4Hit* hit = iter->second;
+      if (hit->get_edep() >= policy.energy_threshold)
+      {
+        continue;
+      }
+      if (std::isfinite(policy.keep_primary_energy))
+      {
+        // keep everything produced by an energetic primary
+        PHG4Particle* particle = _truth_info->GetParticle(hit->get_trkid());
+        PHG4Particle* primary = (particle ? _truth_info->GetPrimaryParticle(particle->get_primary_id()) : nullptr);
+        if (primary && primary->get_e() >= policy.keep_primary_energy)
+        {
+          continue;
+        }
+      }
+      container.drop.push_back(iter->first);
+    }
+    break;
+  }
+  case kCells:
+  {
+    PHG4CellContainer* cells = static_cast<PHG4CellContainer*>(container.object);
+    for (PHG4CellContainer::ConstIterator iter = cells->getCells().first;
+         iter != cells->getCells().second;
+         ++iter)
+    {
+      if (iter->second->get_edep() < policy.energy_threshold)
+      {
+        container.drop.push_back(iter->first);
+      }
+    }
+    break;
+  }
+  case kTowers:
+  {
+    RawTowerContainer* towers = static_cast<RawTowerContainer*>(container.object);
+    unordered_set<RawTowerDefs::keytype> clustered;
+    if (container.clusters)
+    {
+      for (RawClusterContainer::ConstIterator iter = container.clusters->getClusters().first;
+           iter != container.clusters->getClusters().second;
+           ++iter)
+      {
+        for (RawCluster::TowerConstIterator jter = iter->second->get_towers().first;
+             jter != iter->second->get_towers().second;
+             ++jter)
+        {
+          clustered.insert(jter->first);
+        }
+      }
+    }
+    for (RawTowerContainer::ConstIterator iter = towers->getTowers().first;
+         iter != towers->getTowers().second;
+         ++iter)
+    {
+      if (iter->second->get_energy() < policy.energy_threshold ||
+          (container.clusters && clustered.find(iter->first) == clustered.end()))
+      {
+        container.drop.push_back(iter->first);
+      }
+    }
+    break;
+  }
+  }
+}
+
+void PHG4DstCompressReco::Apply(Container& container)
+{
+  if (!container.object)
+  {
+    return;
+  }
+  switch (container.type)
+  {
+  case kHits:
+  {
+    PHG4HitContainer* hits = static_cast<PHG4HitContainer*>(container.object);
+    if (container.policy.drop_all)
+    {
+      for (PHG4HitContainer::ConstIterator iter = hits->getHits().first;
+           iter != hits->getHits().second;
+           ++iter)
+      {
+        container.bytes += ObjectSize(iter->second);
+      }
+      container.removed += hits->size();
+      hits->Reset();  // DROP ALL COMPRESSED G4HITS
+      break;
+    }
+    for (auto key : container.drop)
+    {
+      container.bytes += ObjectSize(hits->findHit(key));
+      hits->RemoveHit(key);
+    }
+    container.removed += container.drop.size();
+    break;
+  }
+  case kCells:
+  {
+    PHG4CellContainer* cells = static_cast<PHG4CellContainer*>(container.object);
+    if (container.policy.drop_all)
+    {
+      for (PHG4CellContainer::ConstIterator iter = cells->getCells().first;
+           iter != cells->getCells().second;
+           ++iter)
+      {
+        container.bytes += ObjectSize(iter->second);
+      }
+      container.removed += cells->size();
+      cells->Reset();  // DROP ALL COMPRESSED G4CELLS
+      break;
+    }
+    for (auto key : container.drop)
+    {
+      // RemoveCell only takes the cell out of the map
+      PHG4Cell* cell = cells->findCell(key);
+      container.bytes += ObjectSize(cell);
+      cells->RemoveCell(key);
+      delete cell;
+    }
+    container.removed += container.drop.size();
+    break;
+  }
+  case kTowers:
+  {
+    RawTowerContainer* towers = static_cast<RawTowerContainer*>(container.object);
+    if (container.policy.drop_all)
+    {
+      for (RawTowerContainer::ConstIterator iter = towers->getTowers().first;
+           iter != towers->getTowers().second;
+           ++iter)
+      {
+        container.bytes += ObjectSize(iter->second);
+      }
+      container.removed += towers->size();
+      towers->Reset();
+      break;
+    }
+    for (auto key : container.drop)
+    {
+      container.bytes += ObjectSize(towers->getTower(key));
+      towers->RemoveTower(key);
+    }
+    container.removed += container.drop.size();
+
+    if (!container.policy.drop_g4cells && !container.policy.reduce_precision)
+    {
+      break;
+    }
+    for (RawTowerContainer::Iterator iter = towers->getTowers().first;
+         iter != towers->getTowers().second;
+         ++iter)
+    {
+      RawTower* tower = iter->second;
+      if (container.policy.drop_g4cells)
+      {
+        container.bytes += tower->size_g4cells() * (sizeof(RawTower::CellKeyType) + sizeof(float));
+        tower->clear_g4cells();
+      }
+      if (container.policy.reduce_precision && !dynamic_cast<RawTowerv2*>(tower))
+      {
+        RawTower* compact = new RawTowerv2(*tower);
+        container.bytes += ObjectSize(tower) - ObjectSize(compact);
+        container.bytes += tower->size_g4cells() * (sizeof(RawTower::CellKeyType) + sizeof(float));
+        container.bytes += tower->size_g4showers() * (sizeof(int) + sizeof(float));
+        // same key, replaces the map entry and the grid pointer
+        towers->AddTower(iter->first, compact);
+        delete tower;
+      }
+    }
+    break;
+  }
+  }
+  container.drop.clear();
+}
+
+int PHG4DstCompressReco::End(PHCompositeNode* topNode)
+{
+  if (!_containers.empty())
+  {
+    Print("STATISTICS");
+  }
+  return Fun4AllReturnCodes::EVENT_OK;
+}
+
+void PHG4DstCompressReco::Print(const string& what) const
+{
+  static const char* typenames[] = {"hits", "cells", "towers"};
+  if (what == "ALL" || what == "POLICY")
+  {
+    cout << Name() << " compression policies:" << endl;
+    for (auto& container : _containers)
+    {
+      const CompressPolicy& policy = container.policy;
+      cout << "  " << container.name << " (" << typenames[container.type] << "): ";
+      if (policy.drop_all)
+      {
+        cout << "drop all" << endl;
+        continue;
+      }
+      if (std::isfinite(policy.energy_threshold))
+      {
+        cout << "energy threshold " << policy.energy_threshold << " ";
+      }
+      if (std::isfinite(policy.keep_primary_energy))
+      {
+        cout << "keep primaries above " << policy.keep_primary_energy << " ";
+      }
+      if (!policy.cluster_node.empty())
+      {
+        cout << "keep towers in " << policy.cluster_node << " ";
+      }
+      if (policy.drop_g4cells)
+      {
+        cout << "drop g4cells ";
+      }
+      if (policy.reduce_precision)
+      {
+        cout << "half precision ";
+      }
+      cout << endl;
+    }
+  }
+  if (what == "ALL" || what == "STATISTICS")
+  {
+    cout << Name() << " estimated bytes saved (uncompressed):" << endl;
+    for (auto& container : _containers)
+    {
+      cout << "  " << setw(30) << left << container.name << right
+           << " removed " << setw(12) << container.removed << " " << typenames[container.type]
+           << ", " << setw(14) << static_cast<unsigned long long>(container.bytes) << " bytes" << endl;
+    }
+  }
+  return;
+}
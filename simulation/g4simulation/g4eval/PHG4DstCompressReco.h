@@ -5,18 +5,39 @@
 
 #include <set>
 #include <string>
+#include <vector>
 
 class PHCompositeNode;
+class PHObject;
 
 class PHG4CellContainer;
 class PHG4HitContainer;
 class PHG4TruthInfoContainer;
 
+class RawClusterContainer;
 class RawTowerContainer;
 
 class PHG4DstCompressReco : public SubsysReco
 {
  public:
+  //! reduction rules of a single container, the defaults keep everything
+  struct CompressPolicy
+  {
+    CompressPolicy();
+    //! drop the whole content of the container
+    bool drop_all;
+    //! hits, cells, towers: drop entries with less energy
+    double energy_threshold;
+    //! hits: keep hits below the threshold if their primary has at least this energy (NAN: off)
+    double keep_primary_energy;
+    //! towers: keep only towers which are part of a cluster in this node (empty: off)
+    std::string cluster_node;
+    //! towers: drop the g4cell truth
+    bool drop_g4cells;
+    //! towers: store as RawTowerv2 (half precision energy and time, no truth)
+    bool reduce_precision;
+  };
+
   PHG4DstCompressReco(const std::string &name = "PHG4DstCompressReco");
   virtual ~PHG4DstCompressReco() {}
 
@@ -26,23 +47,58 @@ class PHG4DstCompressReco : public SubsysReco
   //! event processing
   int process_event(PHCompositeNode *topNode);
 
-  void AddHitContainer(const std::string &name) { _compress_g4hit_names.insert(name); }
-  void AddCellContainer(const std::string &name) { _compress_g4cell_names.insert(name); }
-  void AddTowerContainer(const std::string &name) { _compress_tower_names.insert(name); }
+  //! prints the bytes saved per container
+  int End(PHCompositeNode *topNode);
+
+  void Print(const std::string &what = "ALL") const;
+
+  //! drop all hits/cells, drop the g4cells of the towers
+  void AddHitContainer(const std::string &name);
+  void AddCellContainer(const std::string &name);
+  void AddTowerContainer(const std::string &name);
+
+  void SetHitPolicy(const std::string &name, const CompressPolicy &policy);
+  void SetCellPolicy(const std::string &name, const CompressPolicy &policy);
+  void SetTowerPolicy(const std::string &name, const CompressPolicy &policy);
+
+  //! number of threads selecting the entries to drop, one container per thread
+  void Threads(const unsigned int n) { _threads = n; }
 
  private:
+  enum ContainerType
+  {
+    kHits,
+    kCells,
+    kTowers
+  };
+
+  struct Container
+  {
+    std::string name;
+    ContainerType type;
+    CompressPolicy policy;
+    PHObject *object;
+    RawClusterContainer *clusters;
+    //! keys selected for removal in the current event
+    std::vector<unsigned long long> drop;
+    unsigned long long removed;
+    //! in memory size of the removed objects, an estimate of the saved bytes before compression
+    double bytes;
+  };
+
+  void SetPolicy(const std::string &name, const ContainerType type, const CompressPolicy &policy);
   void SearchG4HitNodes(PHCompositeNode *topNode);
+  //! thread safe, only reads the containers
+  void Select(Container &container);
+  //! removes the selected entries, in the main thread since the object pools are per thread
+  void Apply(Container &container);
 
   PHG4TruthInfoContainer *_truth_info;
-  std::set<std::string> _compress_g4hit_names;
-  std::set<std::string> _compress_g4cell_names;
-  std::set<std::string> _compress_tower_names;
+  unsigned int _threads;
 
-  std::set<PHG4CellContainer *> _g4cells;
-  std::set<PHG4HitContainer *> _g4hits;
-  std::set<PHG4HitContainer *> _keep_g4hits;
+  std::vector<Container> _containers;
 
-  std::set<RawTowerContainer *> _towers;
+  std::set<PHG4HitContainer *> _keep_g4hits;
 };
 
 #endif
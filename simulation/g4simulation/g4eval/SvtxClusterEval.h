@@ -1,6 +1,7 @@
 #ifndef G4EVAL_SVTXCLUSTEREVAL_H
 #define G4EVAL_SVTXCLUSTEREVAL_H
 
+#include "SvtxClusterTruthIndex.h"
 #include "SvtxHitEval.h"
 
 #include <trackbase/TrkrDefs.h>
@@ -23,7 +24,6 @@ class TrkrHitTruthAssoc;
 class SvtxTruthEval;
 
 using namespace std;
-typedef multimap<float, TrkrDefs::cluskey> innerMap;
 
 class SvtxClusterEval
 {
@@ -52,6 +52,9 @@ class SvtxClusterEval
   SvtxHitEval* get_hit_eval() { return &_hiteval; }
   SvtxTruthEval* get_truth_eval() { return _hiteval.get_truth_eval(); }
 
+  //! cluster <-> g4hit <-> track id association of this event, built on first use
+  const SvtxClusterTruthIndex& get_truth_index();
+
   // backtrace through to PHG4Hits
   std::set<PHG4Hit*> all_truth_hits(TrkrDefs::cluskey cluster);
   PHG4Hit* max_truth_hit_by_energy(TrkrDefs::cluskey);
@@ -73,15 +76,8 @@ class SvtxClusterEval
 
  private:
   void get_node_pointers(PHCompositeNode* topNode);
-  void fill_cluster_layer_map();
-  //  void fill_g4hit_layer_map();
   bool has_node_pointers();
 
-  //! Fast approximation of atan2() for cluster searching
-  //! From https://www.dsprelated.com/showarticle/1052.php
-  float fast_approx_atan2(float y, float x);
-  float fast_approx_atan2(float y2x);
-
   SvtxHitEval _hiteval;
   TrkrClusterContainer* _clustermap;
   TrkrClusterHitAssoc* _cluster_hit_map;
@@ -96,23 +92,16 @@ class SvtxClusterEval
   int _verbosity;
   unsigned int _errors;
 
+  //! replaces the per query caches of truth hits and clusters
+  SvtxClusterTruthIndex _truth_index;
+
   bool _do_cache;
-  std::map<TrkrDefs::cluskey, std::set<PHG4Hit*> > _cache_all_truth_hits;
   std::map<TrkrDefs::cluskey, PHG4Hit*> _cache_max_truth_hit_by_energy;
   std::map<TrkrDefs::cluskey, std::set<PHG4Particle*> > _cache_all_truth_particles;
   std::map<TrkrDefs::cluskey, PHG4Particle*> _cache_max_truth_particle_by_energy;
-  std::map<PHG4Particle*, std::set<TrkrDefs::cluskey> > _cache_all_clusters_from_particle;
-  std::map<PHG4Hit*, std::set<TrkrDefs::cluskey> > _cache_all_clusters_from_g4hit;
   std::map<PHG4Hit*, TrkrDefs::cluskey> _cache_best_cluster_from_g4hit;
   std::map<std::pair<TrkrDefs::cluskey, PHG4Particle*>, float> _cache_get_energy_contribution_g4particle;
   std::map<std::pair<TrkrDefs::cluskey, PHG4Hit*>, float> _cache_get_energy_contribution_g4hit;
-
-#if !defined(__CINT__) || defined(__CLING__)
-  //! cluster azimuthal searching window in _clusters_per_layer. Unit: rad
-  static constexpr float _clusters_searching_window = 0.1f;
-  std::multimap<unsigned int, innerMap> _clusters_per_layer;
-//  std::multimap<unsigned int, PHG4Hit*> _g4hits_per_layer;
-#endif
 };
 
 #endif  // G4EVAL_SVTXCLUSTEREVAL_H
@@ -0,0 +1,154 @@
+#include "SvtxClusterTruthIndex.h"
+
+#include <trackbase/TrkrClusterContainer.h>
+#include <trackbase/TrkrClusterHitAssoc.h>
+#include <trackbase/TrkrHitTruthAssoc.h>
+
+#include <g4main/PHG4Hit.h>
+#include <g4main/PHG4HitContainer.h>
+#include <g4main/PHG4HitDefs.h>
+
+#include <algorithm>
+#include <tuple>
+#include <utility>
+
+using namespace std;
+
+template <class K, class V>
+void SvtxClusterTruthIndex::Table<K, V>::fill(const vector<pair<K, V> > &pairs)
+{
+  clear();
+  values.reserve(pairs.size());
+  for (unsigned int i = 0; i < pairs.size(); ++i)
+  {
+    if (i > 0 && pairs[i] == pairs[i - 1])
+    {
+      continue;
+    }
+    if (keys.empty() || keys.back() != pairs[i].first)
+    {
+      keys.push_back(pairs[i].first);
+      offsets.push_back(values.size());
+    }
+    values.push_back(pairs[i].second);
+  }
+  offsets.push_back(values.size());
+}
+
+template <class K, class V>
+SvtxClusterTruthIndex::Range<V> SvtxClusterTruthIndex::Table<K, V>::find(const K &key) const
+{
+  Range<V> range = {nullptr, nullptr};
+  typename vector<K>::const_iterator iter = lower_bound(keys.begin(), keys.end(), key);
+  if (iter == keys.end() || *iter != key)
+  {
+    return range;
+  }
+  const unsigned int i = iter - keys.begin();
+  range.first = values.data() + offsets[i];
+  range.second = values.data() + offsets[i + 1];
+  return range;
+}
+
+void SvtxClusterTruthIndex::clear()
+{
+  m_ClusterG4Hits.clear();
+  m_G4HitClusters.clear();
+  m_TrackClusters.clear();
+  m_Built = false;
+}
+
+void SvtxClusterTruthIndex::build(TrkrClusterContainer *clustermap,
+                                  TrkrClusterHitAssoc *cluster_hit_map,
+                                  TrkrHitTruthAssoc *hit_truth_map,
+                                  PHG4HitContainer *g4hits_tpc,
+                                  PHG4HitContainer *g4hits_intt,
+                                  PHG4HitContainer *g4hits_mvtx)
+{
+  clear();
+  m_Built = true;
+  if (!clustermap || !cluster_hit_map || !hit_truth_map)
+  {
+    return;
+  }
+
+  // flat, sorted copy of the hit -> g4hit association, so every hit is
+  // one binary search instead of a scan over its hitset
+  typedef tuple<TrkrDefs::hitsetkey, TrkrDefs::hitkey, PHG4HitDefs::keytype> HitTruth;
+  vector<HitTruth> hit_truth;
+  TrkrHitTruthAssoc::ConstRange assocs = hit_truth_map->getAssocs();
+  for (TrkrHitTruthAssoc::ConstIterator iter = assocs.first; iter != assocs.second; ++iter)
+  {
+    hit_truth.push_back(make_tuple(iter->first, iter->second.first, iter->second.second));
+  }
+  sort(hit_truth.begin(), hit_truth.end());
+
+  vector<pair<TrkrDefs::cluskey, PHG4Hit *> > cluster_g4hits;
+  TrkrClusterContainer::ConstRange all_clusters = clustermap->getClusters();
+  for (TrkrClusterContainer::ConstIterator clusiter = all_clusters.first; clusiter != all_clusters.second; ++clusiter)
+  {
+    const TrkrDefs::cluskey cluster_key = clusiter->first;
+    const TrkrDefs::hitsetkey hitsetkey = TrkrDefs::getHitSetKeyFromClusKey(cluster_key);
+    const unsigned int trkrid = TrkrDefs::getTrkrId(hitsetkey);
+    PHG4HitContainer *g4hits = g4hits_mvtx;
+    if (trkrid == TrkrDefs::tpcId)
+      g4hits = g4hits_tpc;
+    else if (trkrid == TrkrDefs::inttId)
+      g4hits = g4hits_intt;
+    if (!g4hits)
+    {
+      continue;
+    }
+
+    TrkrClusterHitAssoc::ConstRange hitrange = cluster_hit_map->getHits(cluster_key);
+    for (TrkrClusterHitAssoc::ConstIterator clushititer = hitrange.first; clushititer != hitrange.second; ++clushititer)
+    {
+      const TrkrDefs::hitkey hitkey = clushititer->second;
+      vector<HitTruth>::const_iterator htiter = lower_bound(hit_truth.begin(), hit_truth.end(),
+                                                            make_tuple(hitsetkey, hitkey, PHG4HitDefs::keytype(0)));
+      for (; htiter != hit_truth.end() && get<0>(*htiter) == hitsetkey && get<1>(*htiter) == hitkey; ++htiter)
+      {
+        PHG4Hit *g4hit = g4hits->findHit(get<2>(*htiter));
+        if (g4hit)
+        {
+          cluster_g4hits.push_back(make_pair(cluster_key, g4hit));
+        }
+      }
+    }
+  }
+
+  sort(cluster_g4hits.begin(), cluster_g4hits.end());
+  m_ClusterG4Hits.fill(cluster_g4hits);
+
+  // reverse directions
+  vector<pair<PHG4Hit *, TrkrDefs::cluskey> > g4hit_clusters;
+  vector<pair<int, TrkrDefs::cluskey> > track_clusters;
+  g4hit_clusters.reserve(cluster_g4hits.size());
+  track_clusters.reserve(cluster_g4hits.size());
+  for (const auto &assoc : cluster_g4hits)
+  {
+    g4hit_clusters.push_back(make_pair(assoc.second, assoc.first));
+    track_clusters.push_back(make_pair(assoc.second->get_trkid(), assoc.first));
+  }
+  sort(g4hit_clusters.begin(), g4hit_clusters.end());
+  m_G4HitClusters.fill(g4hit_clusters);
+  sort(track_clusters.begin(), track_clusters.end());
+  m_TrackClusters.fill(track_clusters);
+
+  return;
+}
+
+SvtxClusterTruthIndex::Range<PHG4Hit *> SvtxClusterTruthIndex::g4hits(const TrkrDefs::cluskey cluster_key) const
+{
+  return m_ClusterG4Hits.find(cluster_key);
+}
+
+SvtxClusterTruthIndex::Range<TrkrDefs::cluskey> SvtxClusterTruthIndex::clusters_from_g4hit(PHG4Hit *g4hit) const
+{
+  return m_G4HitClusters.find(g4hit);
+}
+
+SvtxClusterTruthIndex::Range<TrkrDefs::cluskey> SvtxClusterTruthIndex::clusters_from_track(const int trackid) const
+{
+  return m_TrackClusters.find(trackid);
+}
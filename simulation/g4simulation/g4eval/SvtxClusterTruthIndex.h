@@ -0,0 +1,87 @@
+#ifndef G4EVAL_SVTXCLUSTERTRUTHINDEX_H
+#define G4EVAL_SVTXCLUSTERTRUTHINDEX_H
+
+#include <trackbase/TrkrDefs.h>
+
+#include <cstddef>
+#include <utility>
+#include <vector>
+
+class PHG4Hit;
+class PHG4HitContainer;
+class TrkrClusterContainer;
+class TrkrClusterHitAssoc;
+class TrkrHitTruthAssoc;
+
+/// \class SvtxClusterTruthIndex
+///
+/// \brief cluster <-> g4hit <-> g4 track id association of one event
+///
+/// Built in one pass over TrkrClusterHitAssoc and TrkrHitTruthAssoc, each
+/// direction is stored as a sorted key array with offsets into one flat
+/// value array (CSR). Queries are a binary search and return a range into
+/// the flat array, no set is allocated. The ranges are valid until the
+/// next clear()/build().
+class SvtxClusterTruthIndex
+{
+ public:
+  //! [first, second) range of values
+  template <class T>
+  struct Range
+  {
+    const T *first;
+    const T *second;
+    const T *begin() const { return first; }
+    const T *end() const { return second; }
+    size_t size() const { return second - first; }
+    bool empty() const { return first == second; }
+  };
+
+  SvtxClusterTruthIndex()
+    : m_Built(false)
+  {
+  }
+
+  void clear();
+  bool is_built() const { return m_Built; }
+  void build(TrkrClusterContainer *clustermap,
+             TrkrClusterHitAssoc *cluster_hit_map,
+             TrkrHitTruthAssoc *hit_truth_map,
+             PHG4HitContainer *g4hits_tpc,
+             PHG4HitContainer *g4hits_intt,
+             PHG4HitContainer *g4hits_mvtx);
+
+  //! g4hits of a cluster, ordered by pointer like the std::set<PHG4Hit*> they replace
+  Range<PHG4Hit *> g4hits(const TrkrDefs::cluskey cluster_key) const;
+  //! clusters a g4hit contributes to, ordered by cluster key
+  Range<TrkrDefs::cluskey> clusters_from_g4hit(PHG4Hit *g4hit) const;
+  //! clusters with a g4hit of this g4 track, ordered by cluster key
+  Range<TrkrDefs::cluskey> clusters_from_track(const int trackid) const;
+
+ private:
+  //! sorted keys, key i owns values [offset[i], offset[i+1])
+  template <class K, class V>
+  struct Table
+  {
+    std::vector<K> keys;
+    std::vector<unsigned int> offsets;
+    std::vector<V> values;
+
+    void clear()
+    {
+      keys.clear();
+      offsets.clear();
+      values.clear();
+    }
+    //! fill from (key, value) pairs sorted by key then value, duplicates removed
+    void fill(const std::vector<std::pair<K, V> > &pairs);
+    Range<V> find(const K &key) const;
+  };
+
+  bool m_Built;
+  Table<TrkrDefs::cluskey, PHG4Hit *> m_ClusterG4Hits;
+  Table<PHG4Hit *, TrkrDefs::cluskey> m_G4HitClusters;
+  Table<int, TrkrDefs::cluskey> m_TrackClusters;
+};
+
+#endif  // G4EVAL_SVTXCLUSTERTRUTHINDEX_H
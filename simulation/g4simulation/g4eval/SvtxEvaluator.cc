@@ -1,5 +1,7 @@
 #include "SvtxEvaluator.h"
 
+#include "EvalColumns.h"
+#include "EvalNtuple.h"
 #include "SvtxEvalStack.h"
 
 #include "SvtxClusterEval.h"
@@ -43,7 +45,6 @@
 #include <phool/phool.h>
 
 #include <TFile.h>
-#include <TNtuple.h>
 #include <TVector3.h>
 
 #include <cmath>
@@ -55,6 +56,137 @@
 
 using namespace std;
 
+namespace
+{
+  // columns of the ntuples, shared by the ntuples and their lazily evaluated columns,
+  // and the columns of each which are stored as integer
+
+  const char* vertex_varlist =
+      "event:vx:vy:vz:ntracks:"
+      "gvx:gvy:gvz:gvt:gembed:gntracks:gntracksmaps:"
+      "gnembed:nfromtruth:"
+      "nhittpcall:nhittpcin:nhittpcmid:nhittpcout:nclusall:nclustpc:nclusintt:nclusmaps";
+  const char* vertex_intcolumns =
+      "event:ntracks:gembed:gntracks:gntracksmaps:gnembed:nfromtruth:"
+      "nhittpcall:nhittpcin:nhittpcmid:nhittpcout:nclusall:nclustpc:nclusintt:nclusmaps";
+
+  const char* gpoint_varlist =
+      "event:gvx:gvy:gvz:gvt:gntracks:gembed:"
+      "vx:vy:vz:ntracks:"
+      "nfromtruth:"
+      "nhittpcall:nhittpcin:nhittpcmid:nhittpcout:nclusall:nclustpc:nclusintt:nclusmaps";
+  const char* gpoint_intcolumns =
+      "event:gntracks:gembed:ntracks:nfromtruth:"
+      "nhittpcall:nhittpcin:nhittpcmid:nhittpcout:nclusall:nclustpc:nclusintt:nclusmaps";
+
+  const char* g4hit_varlist =
+      "event:g4hitID:gx:gy:gz:gt:gedep:geta:gphi:"
+      "gdphi:gdz:"
+      "glayer:gtrackID:gflavor:"
+      "gpx:gpy:gpz:"
+      "gvx:gvy:gvz:"
+      "gfpx:gfpy:gfpz:gfx:gfy:gfz:"
+      "gembed:gprimary:nclusters:"
+      "clusID:x:y:z:eta:phi:e:adc:layer:size:"
+      "phisize:zsize:efromtruth:dphitru:detatru:dztru:drtru:"
+      "nhittpcall:nhittpcin:nhittpcmid:nhittpcout:nclusall:nclustpc:nclusintt:nclusmaps";
+  const char* g4hit_intcolumns =
+      "event:g4hitID:glayer:gtrackID:gflavor:gembed:gprimary:nclusters:clusID:layer:"
+      "nhittpcall:nhittpcin:nhittpcmid:nhittpcout:nclusall:nclustpc:nclusintt:nclusmaps";
+
+  const char* hit_varlist =
+      "event:hitID:e:adc:layer:"
+      "cellID:ecell:phibin:zbin:phi:z:"
+      "g4hitID:gedep:gx:gy:gz:gt:"
+      "gtrackID:gflavor:"
+      "gpx:gpy:gpz:gvx:gvy:gvz:gvt:"
+      "gfpx:gfpy:gfpz:gfx:gfy:gfz:"
+      "gembed:gprimary:efromtruth:"
+      "nhittpcall:nhittpcin:nhittpcmid:nhittpcout:nclusall:nclustpc:nclusintt:nclusmaps";
+  const char* hit_intcolumns =
+      "event:hitID:layer:cellID:g4hitID:gtrackID:gflavor:gembed:gprimary:"
+      "nhittpcall:nhittpcin:nhittpcmid:nhittpcout:nclusall:nclustpc:nclusintt:nclusmaps";
+
+  const char* cluster_varlist =
+      "event:hitID:x:y:z:r:phi:eta:ex:ey:ez:ephi:"
+      "e:adc:layer:size:phisize:"
+      "zsize:trackID:g4hitID:gx:"
+      "gy:gz:gr:gphi:geta:gt:gtrackID:gflavor:"
+      "gpx:gpy:gpz:gvx:gvy:gvz:gvt:"
+      "gfpx:gfpy:gfpz:gfx:gfy:gfz:"
+      "gembed:gprimary:efromtruth:nparticles:"
+      "nhittpcall:nhittpcin:nhittpcmid:nhittpcout:nclusall:nclustpc:nclusintt:nclusmaps";
+  const char* cluster_intcolumns =
+      "event:hitID:layer:trackID:g4hitID:gtrackID:gflavor:gembed:gprimary:nparticles:"
+      "nhittpcall:nhittpcin:nhittpcmid:nhittpcout:nclusall:nclustpc:nclusintt:nclusmaps";
+
+  const char* g4cluster_varlist =
+      "event:layer:gx:gy:gz:gt:gedep:gr:gphi:geta:gtrackID:gflavor:gembed:gprimary:g4phisize:g4zsize:"
+      "x:y:z:r:phi:eta:ex:ey:ez:ephi:phisize:zsize:adc";
+  const char* g4cluster_intcolumns =
+      "event:layer:gtrackID:gflavor:gembed:gprimary";
+
+  const char* gtrack_varlist =
+      "event:gntracks:gtrackID:gflavor:gnhits:gnmaps:gnintt:"
+      "gnintt1:gnintt2:gnintt3:gnintt4:"
+      "gnintt5:gnintt6:gnintt7:gnintt8:"
+      "gntpc:gnlmaps:gnlintt:gnltpc:"
+      "gpx:gpy:gpz:gpt:geta:gphi:"
+      "gvx:gvy:gvz:gvt:"
+      "gfpx:gfpy:gfpz:gfx:gfy:gfz:"
+      "gembed:gprimary:"
+      "trackID:px:py:pz:pt:eta:phi:deltapt:deltaeta:deltaphi:"
+      "charge:quality:chisq:ndf:nhits:layers:nmaps:nintt:ntpc:nlmaps:nlintt:nltpc:"
+      "dca2d:dca2dsigma:dca3dxy:dca3dxysigma:dca3dz:dca3dzsigma:pcax:pcay:pcaz:nfromtruth:nwrong:ntrumaps:ntruintt:ntrutpc:layersfromtruth:"
+      "nhittpcall:nhittpcin:nhittpcmid:nhittpcout:nclusall:nclustpc:nclusintt:nclusmaps";
+  const char* gtrack_intcolumns =
+      "event:gntracks:gtrackID:gflavor:gnhits:gnmaps:gnintt:gnintt1:gnintt2:gnintt3:gnintt4:gnintt5:gnintt6:gnintt7:gnintt8:gntpc:gnlmaps:gnlintt:gnltpc:gembed:gprimary:"
+      "trackID:charge:nhits:nmaps:nintt:ntpc:nlmaps:nlintt:nltpc:nfromtruth:nwrong:ntrumaps:ntruintt:ntrutpc:"
+      "nhittpcall:nhittpcin:nhittpcmid:nhittpcout:nclusall:nclustpc:nclusintt:nclusmaps";
+
+  const char* track_varlist =
+      "event:trackID:px:py:pz:pt:eta:phi:deltapt:deltaeta:deltaphi:charge:"
+      "quality:chisq:ndf:nhits:nmaps:nintt:ntpc:nlmaps:nlintt:nltpc:layers:"
+      "dca2d:dca2dsigma:dca3dxy:dca3dxysigma:dca3dz:dca3dzsigma:pcax:pcay:pcaz:"
+      "presdphi:presdeta:prese3x3:prese:"
+      "cemcdphi:cemcdeta:cemce3x3:cemce:"
+      "hcalindphi:hcalindeta:hcaline3x3:hcaline:"
+      "hcaloutdphi:hcaloutdeta:hcaloute3x3:hcaloute:"
+      "gtrackID:gflavor:gnhits:gnmaps:gnintt:gntpc:gnlmaps:gnlintt:gnltpc:"
+      "gpx:gpy:gpz:gpt:geta:gphi:"
+      "gvx:gvy:gvz:gvt:"
+      "gfpx:gfpy:gfpz:gfx:gfy:gfz:"
+      "gembed:gprimary:nfromtruth:nwrong:ntrumaps:ntruintt:ntrutpc:layersfromtruth:"
+      "nhittpcall:nhittpcin:nhittpcmid:nhittpcout:nclusall:nclustpc:nclusintt:nclusmaps";
+  const char* track_intcolumns =
+      "event:trackID:charge:nhits:nmaps:nintt:ntpc:nlmaps:nlintt:nltpc:"
+      "gtrackID:gflavor:gnhits:gnmaps:gnintt:gntpc:gnlmaps:gnlintt:gnltpc:gembed:gprimary:nfromtruth:nwrong:ntrumaps:ntruintt:ntrutpc:"
+      "nhittpcall:nhittpcin:nhittpcmid:nhittpcout:nclusall:nclustpc:nclusintt:nclusmaps";
+
+  const char* gseed_varlist =
+      "event:ntrk:gx:gy:gz:gr:geta:gphi:"
+      "glayer:"
+      "gpx:gpy:gpz:gtpt:gtphi:gteta:"
+      "gvx:gvy:gvz:"
+      "gembed:gprimary:gflav:"
+      "dphiprev:detaprev:"
+      "nhittpcall:nhittpcin:nhittpcmid:nhittpcout:nclusall:nclustpc:nclusintt:nclusmaps";
+  const char* gseed_intcolumns =
+      "event:ntrk:glayer:gembed:gprimary:gflav:"
+      "nhittpcall:nhittpcin:nhittpcmid:nhittpcout:nclusall:nclustpc:nclusintt:nclusmaps";
+
+  //! adds the producer of the event number and the hit and cluster counts,
+  //! which are the same for all rows, values in this order
+  void add_event_columns(EvalColumns& columns, const vector<float>& values)
+  {
+    columns.add("event", "event:nhittpcall:nhittpcin:nhittpcmid:nhittpcout:nclusall:nclustpc:nclusintt:nclusmaps", "",
+                [&columns, values](const unsigned int n) {
+                  const char* names[] = {"event", "nhittpcall", "nhittpcin", "nhittpcmid", "nhittpcout", "nclusall", "nclustpc", "nclusintt", "nclusmaps"};
+                  for (unsigned int j = 0; j < 9; ++j) columns.column(names[j]).assign(n, values[j]);
+                });
+  }
+}  // namespace
+
 SvtxEvaluator::SvtxEvaluator(const string& name, const string& filename, const string& trackmapname,
                              unsigned int nlayers_maps,
                              unsigned int nlayers_intt,
@@ -107,90 +239,50 @@ int SvtxEvaluator::Init(PHCompositeNode* topNode)
 
   _tfile = new TFile(_filename.c_str(), "RECREATE");
 
-  if (_do_vertex_eval) _ntp_vertex = new TNtuple("ntp_vertex", "vertex => max truth",
-                                                 "event:vx:vy:vz:ntracks:"
-                                                 "gvx:gvy:gvz:gvt:gembed:gntracks:gntracksmaps:"
-                                                 "gnembed:nfromtruth:"
-                                                 "nhittpcall:nhittpcin:nhittpcmid:nhittpcout:nclusall:nclustpc:nclusintt:nclusmaps");
-
-  if (_do_gpoint_eval) _ntp_gpoint = new TNtuple("ntp_gpoint", "g4point => best vertex",
-                                                 "event:gvx:gvy:gvz:gvt:gntracks:gembed:"
-                                                 "vx:vy:vz:ntracks:"
-                                                 "nfromtruth:"
-                                                 "nhittpcall:nhittpcin:nhittpcmid:nhittpcout:nclusall:nclustpc:nclusintt:nclusmaps");
-
-  if (_do_g4hit_eval) _ntp_g4hit = new TNtuple("ntp_g4hit", "g4hit => best svtxcluster",
-                                               "event:g4hitID:gx:gy:gz:gt:gedep:geta:gphi:"
-                                               "gdphi:gdz:"
-                                               "glayer:gtrackID:gflavor:"
-                                               "gpx:gpy:gpz:"
-                                               "gvx:gvy:gvz:"
-                                               "gfpx:gfpy:gfpz:gfx:gfy:gfz:"
-                                               "gembed:gprimary:nclusters:"
-                                               "clusID:x:y:z:eta:phi:e:adc:layer:size:"
-                                               "phisize:zsize:efromtruth:dphitru:detatru:dztru:drtru:"
-                                               "nhittpcall:nhittpcin:nhittpcmid:nhittpcout:nclusall:nclustpc:nclusintt:nclusmaps");
-
-  if (_do_hit_eval) _ntp_hit = new TNtuple("ntp_hit", "svtxhit => max truth",
-                                           "event:hitID:e:adc:layer:"
-                                           "cellID:ecell:phibin:zbin:phi:z:"
-                                           "g4hitID:gedep:gx:gy:gz:gt:"
-                                           "gtrackID:gflavor:"
-                                           "gpx:gpy:gpz:gvx:gvy:gvz:gvt:"
-                                           "gfpx:gfpy:gfpz:gfx:gfy:gfz:"
-                                           "gembed:gprimary:efromtruth:"
-                                           "nhittpcall:nhittpcin:nhittpcmid:nhittpcout:nclusall:nclustpc:nclusintt:nclusmaps");
-
-  if (_do_cluster_eval) _ntp_cluster = new TNtuple("ntp_cluster", "svtxcluster => max truth",
-                                                   "event:hitID:x:y:z:r:phi:eta:ex:ey:ez:ephi:"
-                                                   "e:adc:layer:size:phisize:"
-                                                   "zsize:trackID:g4hitID:gx:"
-                                                   "gy:gz:gr:gphi:geta:gt:gtrackID:gflavor:"
-                                                   "gpx:gpy:gpz:gvx:gvy:gvz:gvt:"
-                                                   "gfpx:gfpy:gfpz:gfx:gfy:gfz:"
-                                                   "gembed:gprimary:efromtruth:nparticles:"
-                                                   "nhittpcall:nhittpcin:nhittpcmid:nhittpcout:nclusall:nclustpc:nclusintt:nclusmaps");
-
-  if (_do_g4cluster_eval) _ntp_g4cluster = new TNtuple("ntp_g4cluster", "g4cluster => max truth",
-						       "event:layer:gx:gy:gz:gt:gedep:gr:gphi:geta:gtrackID:gflavor:gembed:gprimary:g4phisize:g4zsize:x:y:z:r:phi:eta:ex:ey:ez:ephi:phisize:zsize:adc"); 
-                                                       
-  if (_do_gtrack_eval) _ntp_gtrack = new TNtuple("ntp_gtrack", "g4particle => best svtxtrack",
-                                                 "event:gntracks:gtrackID:gflavor:gnhits:gnmaps:gnintt:"
-                                                 "gnintt1:gnintt2:gnintt3:gnintt4:"
-                                                 "gnintt5:gnintt6:gnintt7:gnintt8:"
-                                                 "gntpc:gnlmaps:gnlintt:gnltpc:"
-                                                 "gpx:gpy:gpz:gpt:geta:gphi:"
-                                                 "gvx:gvy:gvz:gvt:"
-                                                 "gfpx:gfpy:gfpz:gfx:gfy:gfz:"
-                                                 "gembed:gprimary:"
-                                                 "trackID:px:py:pz:pt:eta:phi:deltapt:deltaeta:deltaphi:"
-                                                 "charge:quality:chisq:ndf:nhits:layers:nmaps:nintt:ntpc:nlmaps:nlintt:nltpc:"
-                                                 "dca2d:dca2dsigma:dca3dxy:dca3dxysigma:dca3dz:dca3dzsigma:pcax:pcay:pcaz:nfromtruth:nwrong:ntrumaps:ntruintt:ntrutpc:layersfromtruth:"
-                                                 "nhittpcall:nhittpcin:nhittpcmid:nhittpcout:nclusall:nclustpc:nclusintt:nclusmaps");
-
-  if (_do_track_eval) _ntp_track = new TNtuple("ntp_track", "svtxtrack => max truth",
-                                               "event:trackID:px:py:pz:pt:eta:phi:deltapt:deltaeta:deltaphi:charge:"
-                                               "quality:chisq:ndf:nhits:nmaps:nintt:ntpc:nlmaps:nlintt:nltpc:layers:"
-                                               "dca2d:dca2dsigma:dca3dxy:dca3dxysigma:dca3dz:dca3dzsigma:pcax:pcay:pcaz:"
-                                               "presdphi:presdeta:prese3x3:prese:"
-                                               "cemcdphi:cemcdeta:cemce3x3:cemce:"
-                                               "hcalindphi:hcalindeta:hcaline3x3:hcaline:"
-                                               "hcaloutdphi:hcaloutdeta:hcaloute3x3:hcaloute:"
-                                               "gtrackID:gflavor:gnhits:gnmaps:gnintt:gntpc:gnlmaps:gnlintt:gnltpc:"
-                                               "gpx:gpy:gpz:gpt:geta:gphi:"
-                                               "gvx:gvy:gvz:gvt:"
-                                               "gfpx:gfpy:gfpz:gfx:gfy:gfz:"
-                                               "gembed:gprimary:nfromtruth:nwrong:ntrumaps:ntruintt:ntrutpc:layersfromtruth:"
-                                               "nhittpcall:nhittpcin:nhittpcmid:nhittpcout:nclusall:nclustpc:nclusintt:nclusmaps");
-
-  if (_do_gseed_eval) _ntp_gseed = new TNtuple("ntp_gseed", "seeds from truth",
-                                               "event:ntrk:gx:gy:gz:gr:geta:gphi:"
-                                               "glayer:"
-                                               "gpx:gpy:gpz:gtpt:gtphi:gteta:"
-                                               "gvx:gvy:gvz:"
-                                               "gembed:gprimary:gflav:"
-                                               "dphiprev:detaprev:"
-                                               "nhittpcall:nhittpcin:nhittpcmid:nhittpcout:nclusall:nclustpc:nclusintt:nclusmaps");
+  if (_do_vertex_eval) _ntp_vertex = new EvalNtuple("ntp_vertex", "vertex => max truth",
+                                                    vertex_varlist,
+                                                    vertex_intcolumns,
+                                                    _selected_columns["ntp_vertex"]);
+
+  if (_do_gpoint_eval) _ntp_gpoint = new EvalNtuple("ntp_gpoint", "g4point => best vertex",
+                                                    gpoint_varlist,
+                                                    gpoint_intcolumns,
+                                                    _selected_columns["ntp_gpoint"]);
+
+  if (_do_g4hit_eval) _ntp_g4hit = new EvalNtuple("ntp_g4hit", "g4hit => best svtxcluster",
+                                                  g4hit_varlist,
+                                                  g4hit_intcolumns,
+                                                  _selected_columns["ntp_g4hit"]);
+
+  if (_do_hit_eval) _ntp_hit = new EvalNtuple("ntp_hit", "svtxhit => max truth",
+                                              hit_varlist,
+                                              hit_intcolumns,
+                                              _selected_columns["ntp_hit"]);
+
+  if (_do_cluster_eval) _ntp_cluster = new EvalNtuple("ntp_cluster", "svtxcluster => max truth",
+                                                      cluster_varlist,
+                                                      cluster_intcolumns,
+                                                      _selected_columns["ntp_cluster"]);
+
+  if (_do_g4cluster_eval) _ntp_g4cluster = new EvalNtuple("ntp_g4cluster", "g4cluster => max truth",
+                                                          g4cluster_varlist,
+                                                          g4cluster_intcolumns,
+                                                          _selected_columns["ntp_g4cluster"]);
+
+  if (_do_gtrack_eval) _ntp_gtrack = new EvalNtuple("ntp_gtrack", "g4particle => best svtxtrack",
+                                                    gtrack_varlist,
+                                                    gtrack_intcolumns,
+                                                    _selected_columns["ntp_gtrack"]);
+
+  if (_do_track_eval) _ntp_track = new EvalNtuple("ntp_track", "svtxtrack => max truth",
+                                                  track_varlist,
+                                                  track_intcolumns,
+                                                  _selected_columns["ntp_track"]);
+
+  if (_do_gseed_eval) _ntp_gseed = new EvalNtuple("ntp_gseed", "seeds from truth",
+                                                  gseed_varlist,
+                                                  gseed_intcolumns,
+                                                  _selected_columns["ntp_gseed"]);
 
   _timer = new PHTimer("_eval_timer");
   _timer->stop();
@@ -260,6 +352,15 @@ int SvtxEvaluator::End(PHCompositeNode* topNode)
   _tfile->Close();
 
   delete _tfile;
+  delete _ntp_vertex;
+  delete _ntp_gpoint;
+  delete _ntp_g4hit;
+  delete _ntp_hit;
+  delete _ntp_cluster;
+  delete _ntp_g4cluster;
+  delete _ntp_gtrack;
+  delete _ntp_track;
+  delete _ntp_gseed;
 
   if (Verbosity() > 0)
   {
@@ -761,11 +862,14 @@ void SvtxEvaluator::fillOutputNtuples(PHCompositeNode* topNode)
       if (layer >= _nlayers_maps + _nlayers_intt) nclus_tpc++;
   }
 
+  // the same for all rows of the event
+  const vector<float> event_values = {(float) _ievent, nhit_tpc_all, nhit_tpc_in, nhit_tpc_mid, nhit_tpc_out, nclus_all, nclus_tpc, nclus_intt, nclus_maps};
+
   //-----------------------
   // fill the Vertex NTuple
   //-----------------------
   bool doit = true;
-  if (_ntp_vertex && doit)
+  if (_ntp_vertex && doit && !_ntp_vertex->empty())
   {
     if (Verbosity() > 0)
     {
@@ -784,7 +888,6 @@ void SvtxEvaluator::fillOutputNtuples(PHCompositeNode* topNode)
     {
       const auto prange = truthinfo->GetPrimaryParticleRange();
       map<int, unsigned int> embedvtxid_particle_count;
-      map<int, unsigned int> embedvtxid_maps_particle_count;
       map<int, unsigned int> vertex_particle_count;
 
       if (_do_eval_light == false)
@@ -792,56 +895,8 @@ void SvtxEvaluator::fillOutputNtuples(PHCompositeNode* topNode)
         for (auto iter = prange.first; iter != prange.second; ++iter)  // process all primary paricle
         {
           const int point_id = iter->second->get_vtx_id();
-          int gembed = truthinfo->isEmbededVtx(iter->second->get_vtx_id());
           ++vertex_particle_count[point_id];
-          ++embedvtxid_particle_count[gembed];
-          PHG4Particle* g4particle = iter->second;
-
-          if (_scan_for_embedded && gembed <= 0) continue;
-
-          std::set<TrkrDefs::cluskey> g4clusters = clustereval->all_clusters_from(g4particle);
-          unsigned int nglmaps = 0;
-
-          int lmaps[_nlayers_maps + 1];
-          if (_nlayers_maps > 0)
-          {
-            for (unsigned int i = 0; i < _nlayers_maps; i++)
-            {
-              lmaps[i] = 0;
-            }
-          }
-          for (const TrkrDefs::cluskey g4cluster : g4clusters)
-          {
-            unsigned int layer = TrkrDefs::getLayer(g4cluster);
-            //cout<<__LINE__<<": " << _ievent <<": " <<gtrackID << ": " << layer <<": " <<g4cluster->get_id() <<endl;
-            if (_nlayers_maps > 0 && layer < _nlayers_maps)
-            {
-              lmaps[layer] = 1;
-            }
-          }
-          if (_nlayers_maps > 0)
-          {
-            for (unsigned int i = 0; i < _nlayers_maps; i++)
-            {
-              nglmaps += lmaps[i];
-            }
-          }
-          float gpx = g4particle->get_px();
-          float gpy = g4particle->get_py();
-          float gpz = g4particle->get_pz();
-          float gpt = NAN;
-          float geta = NAN;
-
-          if (gpx != 0 && gpy != 0)
-          {
-            TVector3 gv(gpx, gpy, gpz);
-            gpt = gv.Pt();
-            geta = gv.Eta();
-            //          gphi = gv.Phi();
-          }
-
-          if (nglmaps == 3 && fabs(geta) < 1.0 && gpt > 0.5)
-            ++embedvtxid_maps_particle_count[gembed];
+          ++embedvtxid_particle_count[truthinfo->isEmbededVtx(point_id)];
         }
       }
 
@@ -881,61 +936,24 @@ void SvtxEvaluator::fillOutputNtuples(PHCompositeNode* topNode)
         ++ngembed;
       }
 
+      // one row per reconstructed vertex and its max truth point, the matching
+      // decides which embedded truth vertices get a row of their own below
+      vector<SvtxVertex*> vertices;
+      vector<PHG4VtxPoint*> points;
+      vector<int> embeds;
       for (SvtxVertexMap::Iter iter = vertexmap->begin();
            iter != vertexmap->end();
            ++iter)
       {
-        SvtxVertex* vertex = iter->second;
-        PHG4VtxPoint* point = vertexeval->max_truth_point_by_ntracks(vertex);
-        float vx = vertex->get_x();
-        float vy = vertex->get_y();
-        float vz = vertex->get_z();
-        float ntracks = vertex->size_tracks();
-        float gvx = NAN;
-        float gvy = NAN;
-        float gvz = NAN;
-        float gvt = NAN;
-        float gembed = NAN;
-        float gntracks = truthinfo->GetNumPrimaryVertexParticles();
-        float gntracksmaps = NAN;
-        float gnembed = NAN;
-        float nfromtruth = NAN;
+        PHG4VtxPoint* point = vertexeval->max_truth_point_by_ntracks(iter->second);
+        vertices.push_back(iter->second);
+        points.push_back(point);
+        embeds.push_back(0);
         if (point)
         {
-          const int point_id = point->get_id();
-          gvx = point->get_x();
-          gvy = point->get_y();
-          gvz = point->get_z();
-          gvt = point->get_t();
-          gembed = truthinfo->isEmbededVtx(point_id);
-          gntracks = embedvtxid_particle_count[(int) gembed];
-          if (embedvtxid_maps_particle_count[(int) gembed] > 0 && fabs(gvt) < 2000. && fabs(gvz) < 13.0)
-            gntracksmaps = embedvtxid_maps_particle_count[(int) gembed];
-          gnembed = (float) ngembed;
-          nfromtruth = vertexeval->get_ntracks_contribution(vertex, point);
-          embedvtxid_found[(int) gembed] = true;
+          embeds.back() = truthinfo->isEmbededVtx(point->get_id());
+          embedvtxid_found[embeds.back()] = true;
         }
-	
-        float vertex_data[] = {(float) _ievent,
-                               vx,
-                               vy,
-                               vz,
-                               ntracks,
-                               gvx,
-                               gvy,
-                               gvz,
-                               gvt,
-                               gembed,
-                               gntracks,
-                               gntracksmaps,
-                               gnembed,
-                               nfromtruth,
-                               nhit_tpc_all,
-                               nhit_tpc_in,
-                               nhit_tpc_mid,
-                               nhit_tpc_out, nclus_all, nclus_tpc, nclus_intt, nclus_maps};
-
-        _ntp_vertex->Fill(vertex_data);
       }
 
       if (!_scan_for_embedded)
@@ -944,63 +962,143 @@ void SvtxEvaluator::fillOutputNtuples(PHCompositeNode* topNode)
              iter != embedvtxid_found.end();
              ++iter)
         {
-          if (embedvtxid_found[iter->first]) continue;
-
-          float vx = NAN;
-          float vy = NAN;
-          float vz = NAN;
-          float ntracks = NAN;
-
-          float gvx = NAN;
-          float gvy = NAN;
-          float gvz = NAN;
-          float gvt = NAN;
-          float gembed = iter->first;
-          float gntracks = NAN;
-          float gntracksmaps = NAN;
-          float gnembed = NAN;
-          float nfromtruth = NAN;
-
-          PHG4VtxPoint* point = embedvtxid_vertex[gembed];
-
-          if (point)
-          {
-            const int point_id = point->get_id();
-            gvx = point->get_x();
-            gvy = point->get_y();
-            gvz = point->get_z();
-            gvt = point->get_t();
-            gembed = truthinfo->isEmbededVtx(point_id);
-            gntracks = embedvtxid_particle_count[(int) gembed];
-            if (embedvtxid_maps_particle_count[(int) gembed] > 0 && fabs(gvt) < 2000 && fabs(gvz) < 13.0)
-              gntracksmaps = embedvtxid_maps_particle_count[(int) gembed];
-            gnembed = (float) ngembed;
-            //        nfromtruth = vertexeval->get_ntracks_contribution(vertex,point);
-          }
-
-          float vertex_data[] = {(float) _ievent,
-                                 vx,
-                                 vy,
-                                 vz,
-                                 ntracks,
-                                 gvx,
-                                 gvy,
-                                 gvz,
-                                 gvt,
-                                 gembed,
-                                 gntracks,
-                                 gntracksmaps,
-                                 gnembed,
-                                 nfromtruth,
-                                 nhit_tpc_all,
-                                 nhit_tpc_in,
-                                 nhit_tpc_mid,
-                                 nhit_tpc_out, nclus_all, nclus_tpc, nclus_intt, nclus_maps};
-
-          _ntp_vertex->Fill(vertex_data);
+          if (iter->second) continue;
+          vertices.push_back(nullptr);
+          points.push_back(embedvtxid_vertex[iter->first]);
+          embeds.push_back(iter->first);
         }
       }
 
+      EvalColumns columns(vertex_varlist);
+      columns.set_verbosity(Verbosity());
+
+      add_event_columns(columns, event_values);
+
+      columns.add("vertex", "vx:vy:vz:ntracks", "",
+                  [&](const unsigned int n) {
+                    vector<float>& vx = columns.column("vx");
+                    vector<float>& vy = columns.column("vy");
+                    vector<float>& vz = columns.column("vz");
+                    vector<float>& ntracks = columns.column("ntracks");
+                    for (unsigned int i = 0; i < n; ++i)
+                    {
+                      if (!vertices[i]) continue;
+                      vx[i] = vertices[i]->get_x();
+                      vy[i] = vertices[i]->get_y();
+                      vz[i] = vertices[i]->get_z();
+                      ntracks[i] = vertices[i]->size_tracks();
+                    }
+                  });
+
+      columns.add("gpoint", "gvx:gvy:gvz:gvt:gembed:gntracks:gnembed", "",
+                  [&](const unsigned int n) {
+                    vector<float>& gvx = columns.column("gvx");
+                    vector<float>& gvy = columns.column("gvy");
+                    vector<float>& gvz = columns.column("gvz");
+                    vector<float>& gvt = columns.column("gvt");
+                    vector<float>& gembed = columns.column("gembed");
+                    vector<float>& gntracks = columns.column("gntracks");
+                    vector<float>& gnembed = columns.column("gnembed");
+                    for (unsigned int i = 0; i < n; ++i)
+                    {
+                      if (vertices[i])
+                      {
+                        gntracks[i] = truthinfo->GetNumPrimaryVertexParticles();
+                      }
+                      else
+                      {
+                        // embedded truth vertex without reconstructed vertex
+                        gembed[i] = embeds[i];
+                      }
+                      PHG4VtxPoint* point = points[i];
+                      if (!point) continue;
+                      gvx[i] = point->get_x();
+                      gvy[i] = point->get_y();
+                      gvz[i] = point->get_z();
+                      gvt[i] = point->get_t();
+                      gembed[i] = truthinfo->isEmbededVtx(point->get_id());
+                      gntracks[i] = embedvtxid_particle_count[(int) gembed[i]];
+                      gnembed[i] = (float) ngembed;
+                    }
+                  });
+
+      columns.add("gntracksmaps", "gntracksmaps", "",
+                  [&](const unsigned int n) {
+                    // primary particles with clusters in all mvtx layers, per embedding id
+                    map<int, unsigned int> embedvtxid_maps_particle_count;
+                    if (_do_eval_light == false)
+                    {
+                      for (auto iter = prange.first; iter != prange.second; ++iter)  // process all primary paricle
+                      {
+                        PHG4Particle* g4particle = iter->second;
+                        int gembed = truthinfo->isEmbededVtx(g4particle->get_vtx_id());
+                        if (_scan_for_embedded && gembed <= 0) continue;
+
+                        std::set<TrkrDefs::cluskey> g4clusters = clustereval->all_clusters_from(g4particle);
+                        unsigned int nglmaps = 0;
+
+                        int lmaps[_nlayers_maps + 1];
+                        if (_nlayers_maps > 0)
+                        {
+                          for (unsigned int j = 0; j < _nlayers_maps; j++)
+                          {
+                            lmaps[j] = 0;
+                          }
+                        }
+                        for (const TrkrDefs::cluskey g4cluster : g4clusters)
+                        {
+                          unsigned int layer = TrkrDefs::getLayer(g4cluster);
+                          if (_nlayers_maps > 0 && layer < _nlayers_maps)
+                          {
+                            lmaps[layer] = 1;
+                          }
+                        }
+                        if (_nlayers_maps > 0)
+                        {
+                          for (unsigned int j = 0; j < _nlayers_maps; j++)
+                          {
+                            nglmaps += lmaps[j];
+                          }
+                        }
+                        float gpx = g4particle->get_px();
+                        float gpy = g4particle->get_py();
+                        float gpz = g4particle->get_pz();
+                        float gpt = NAN;
+                        float geta = NAN;
+
+                        if (gpx != 0 && gpy != 0)
+                        {
+                          TVector3 gv(gpx, gpy, gpz);
+                          gpt = gv.Pt();
+                          geta = gv.Eta();
+                        }
+
+                        if (nglmaps == 3 && fabs(geta) < 1.0 && gpt > 0.5)
+                          ++embedvtxid_maps_particle_count[gembed];
+                      }
+                    }
+
+                    vector<float>& gntracksmaps = columns.column("gntracksmaps");
+                    for (unsigned int i = 0; i < n; ++i)
+                    {
+                      PHG4VtxPoint* point = points[i];
+                      if (!point) continue;
+                      const int gembed = truthinfo->isEmbededVtx(point->get_id());
+                      if (embedvtxid_maps_particle_count[gembed] > 0 && fabs(point->get_t()) < 2000. && fabs(point->get_z()) < 13.0)
+                        gntracksmaps[i] = embedvtxid_maps_particle_count[gembed];
+                    }
+                  });
+
+      columns.add("nfromtruth", "nfromtruth", "",
+                  [&](const unsigned int n) {
+                    vector<float>& nfromtruth = columns.column("nfromtruth");
+                    for (unsigned int i = 0; i < n; ++i)
+                    {
+                      if (vertices[i] && points[i]) nfromtruth[i] = vertexeval->get_ntracks_contribution(vertices[i], points[i]);
+                    }
+                  });
+
+      columns.evaluate(_ntp_vertex, vertices.size());
     }
     if (Verbosity() >= 1)
     {
@@ -1013,7 +1111,7 @@ void SvtxEvaluator::fillOutputNtuples(PHCompositeNode* topNode)
   // fill the gpoint NTuple
   //-----------------------
 
-  if (_ntp_gpoint)
+  if (_ntp_gpoint && !_ntp_gpoint->empty())
   {
     if (Verbosity() > 0)
     {
@@ -1024,68 +1122,79 @@ void SvtxEvaluator::fillOutputNtuples(PHCompositeNode* topNode)
 
     if (truthinfo)
     {
+      // one row per primary vertex
+      vector<int> point_ids;
+      vector<PHG4VtxPoint*> points;
       auto vrange = truthinfo->GetPrimaryVtxRange();
-      const auto prange = truthinfo->GetPrimaryParticleRange();
-
-      map<int, unsigned int> vertex_particle_count;
-      for (auto iter = prange.first; iter != prange.second; ++iter)  // process all primary paricle
-      {
-        ++vertex_particle_count[iter->second->get_vtx_id()];
-      }
-
       for (auto iter = vrange.first; iter != vrange.second; ++iter)  // process all primary vertexes
       {
-        const int point_id = iter->first;
-        PHG4VtxPoint* point = iter->second;
-
-        //      PHG4VtxPoint* point =  truthinfo->GetPrimaryVtx(truthinfo->GetPrimaryVertexIndex());
-
-        if (point)
-        {
-          SvtxVertex* vertex = vertexeval->best_vertex_from(point);
-
-          float gvx = point->get_x();
-          float gvy = point->get_y();
-          float gvz = point->get_z();
-          float gvt = point->get_t();
-          float gntracks = vertex_particle_count[point_id];
-
-          float gembed = truthinfo->isEmbededVtx(point_id);
-          float vx = NAN;
-          float vy = NAN;
-          float vz = NAN;
-          float ntracks = NAN;
-          float nfromtruth = NAN;
-
-          if (vertex)
-          {
-            vx = vertex->get_x();
-            vy = vertex->get_y();
-            vz = vertex->get_z();
-            ntracks = vertex->size_tracks();
-            nfromtruth = vertexeval->get_ntracks_contribution(vertex, point);
-          }
-
-          float gpoint_data[] = {(float) _ievent,
-                                 gvx,
-                                 gvy,
-                                 gvz,
-                                 gvt,
-                                 gntracks,
-                                 gembed,
-                                 vx,
-                                 vy,
-                                 vz,
-                                 ntracks,
-                                 nfromtruth,
-                                 nhit_tpc_all,
-                                 nhit_tpc_in,
-                                 nhit_tpc_mid,
-                                 nhit_tpc_out, nclus_all, nclus_tpc, nclus_intt, nclus_maps};
-
-          _ntp_gpoint->Fill(gpoint_data);
-        }
+        if (!iter->second) continue;
+        point_ids.push_back(iter->first);
+        points.push_back(iter->second);
       }
+
+      vector<SvtxVertex*> vertices;
+
+      EvalColumns columns(gpoint_varlist);
+      columns.set_verbosity(Verbosity());
+
+      add_event_columns(columns, event_values);
+
+      columns.add("gpoint", "gvx:gvy:gvz:gvt:gntracks:gembed", "",
+                  [&](const unsigned int n) {
+                    map<int, unsigned int> vertex_particle_count;
+                    const auto prange = truthinfo->GetPrimaryParticleRange();
+                    for (auto iter = prange.first; iter != prange.second; ++iter)  // process all primary paricle
+                    {
+                      ++vertex_particle_count[iter->second->get_vtx_id()];
+                    }
+
+                    vector<float>& gvx = columns.column("gvx");
+                    vector<float>& gvy = columns.column("gvy");
+                    vector<float>& gvz = columns.column("gvz");
+                    vector<float>& gvt = columns.column("gvt");
+                    vector<float>& gntracks = columns.column("gntracks");
+                    vector<float>& gembed = columns.column("gembed");
+                    for (unsigned int i = 0; i < n; ++i)
+                    {
+                      gvx[i] = points[i]->get_x();
+                      gvy[i] = points[i]->get_y();
+                      gvz[i] = points[i]->get_z();
+                      gvt[i] = points[i]->get_t();
+                      gntracks[i] = vertex_particle_count[point_ids[i]];
+                      gembed[i] = truthinfo->isEmbededVtx(point_ids[i]);
+                    }
+                  });
+
+      columns.add("vertex", "", "",
+                  [&](const unsigned int n) {
+                    vertices.resize(n);
+                    for (unsigned int i = 0; i < n; ++i)
+                    {
+                      vertices[i] = vertexeval->best_vertex_from(points[i]);
+                    }
+                  });
+
+      columns.add("reco", "vx:vy:vz:ntracks:nfromtruth", "vertex",
+                  [&](const unsigned int n) {
+                    vector<float>& vx = columns.column("vx");
+                    vector<float>& vy = columns.column("vy");
+                    vector<float>& vz = columns.column("vz");
+                    vector<float>& ntracks = columns.column("ntracks");
+                    vector<float>& nfromtruth = columns.column("nfromtruth");
+                    for (unsigned int i = 0; i < n; ++i)
+                    {
+                      SvtxVertex* vertex = vertices[i];
+                      if (!vertex) continue;
+                      vx[i] = vertex->get_x();
+                      vy[i] = vertex->get_y();
+                      vz[i] = vertex->get_z();
+                      ntracks[i] = vertex->size_tracks();
+                      nfromtruth[i] = vertexeval->get_ntracks_contribution(vertex, points[i]);
+                    }
+                  });
+
+      columns.evaluate(_ntp_gpoint, points.size());
     }
     if (Verbosity() >= 1)
     {
@@ -1098,208 +1207,219 @@ void SvtxEvaluator::fillOutputNtuples(PHCompositeNode* topNode)
   // fill the G4hit NTuple
   //---------------------
 
-  if (_ntp_g4hit)
+  if (_ntp_g4hit && !_ntp_g4hit->empty())
   {
     if (Verbosity() > 0)
     {
       cout << "Filling ntp_g4hit " << endl;
       _timer->restart();
     }
-    std::set<PHG4Hit*> g4hits = trutheval->all_truth_hits();
-    for (std::set<PHG4Hit*>::iterator iter = g4hits.begin();
-         iter != g4hits.end();
+    TrkrClusterContainer* clustermap = findNode::getClass<TrkrClusterContainer>(topNode, "TRKR_CLUSTER");
+    TrkrClusterHitAssoc* clusterhitmap = findNode::getClass<TrkrClusterHitAssoc>(topNode, "TRKR_CLUSTERHITASSOC");
+
+    // one row per truth hit, with scan_for_embedded only those of embedded particles
+    vector<PHG4Hit*> g4hits;
+    vector<PHG4Particle*> g4particles;
+    std::set<PHG4Hit*> all_g4hits = trutheval->all_truth_hits();
+    for (std::set<PHG4Hit*>::iterator iter = all_g4hits.begin();
+         iter != all_g4hits.end();
          ++iter)
     {
-      PHG4Hit* g4hit = *iter;
-      PHG4Particle* g4particle = trutheval->get_particle(g4hit);
-
-      float g4hitID = g4hit->get_hit_id();
-      float gx = g4hit->get_avg_x();
-      float gy = g4hit->get_avg_y();
-      float gz = g4hit->get_avg_z();
-      TVector3 vg4(gx, gy, gz);
-      float gt = g4hit->get_avg_t();
-      TVector3 vin(g4hit->get_x(0), g4hit->get_y(0), g4hit->get_z(0));
-      TVector3 vout(g4hit->get_x(1), g4hit->get_y(1), g4hit->get_z(1));
-      float gdphi = vin.DeltaPhi(vout);
-      float gdz = fabs(g4hit->get_z(1) - g4hit->get_z(0));
-      float gedep = g4hit->get_edep();
-      float glayer = g4hit->get_layer();
-
-      float gtrackID = g4hit->get_trkid();
-
-      float gflavor = NAN;
-      float gpx = NAN;
-      float gpy = NAN;
-      float gpz = NAN;
-      TVector3 vec(g4hit->get_avg_x(), g4hit->get_avg_y(), g4hit->get_avg_z());
-      float geta = vec.Eta();
-      float gphi = vec.Phi();
-      float gvx = NAN;
-      float gvy = NAN;
-      float gvz = NAN;
-
-      float gembed = NAN;
-      float gprimary = NAN;
-
-      float gfpx = 0.;
-      float gfpy = 0.;
-      float gfpz = 0.;
-      float gfx = 0.;
-      float gfy = 0.;
-      float gfz = 0.;
-
-      if (g4particle)
-      {
-        if (_scan_for_embedded)
-        {
-          if (trutheval->get_embed(g4particle) <= 0) continue;
-        }
-
-        gflavor = g4particle->get_pid();
-        gpx = g4particle->get_px();
-        gpy = g4particle->get_py();
-        gpz = g4particle->get_pz();
-
-        PHG4VtxPoint* vtx = trutheval->get_vertex(g4particle);
-
-        if (vtx)
-        {
-          gvx = vtx->get_x();
-          gvy = vtx->get_y();
-          gvz = vtx->get_z();
-        }
-        PHG4Hit* outerhit = nullptr;
-        if (_do_eval_light == false)
-          outerhit = trutheval->get_outermost_truth_hit(g4particle);
-
-        if (outerhit)
-        {
-          gfpx = outerhit->get_px(1);
-          gfpy = outerhit->get_py(1);
-          gfpz = outerhit->get_pz(1);
-          gfx = outerhit->get_x(1);
-          gfy = outerhit->get_y(1);
-          gfz = outerhit->get_z(1);
-        }
-
-        gembed = trutheval->get_embed(g4particle);
-        gprimary = trutheval->is_primary(g4particle);
-      }  //       if (g4particle)
-
-      std::set<TrkrDefs::cluskey> clusters = clustereval->all_clusters_from(g4hit);
-      float nclusters = clusters.size();
-
-      // best cluster reco'd
-      TrkrDefs::cluskey cluster_key = clustereval->best_cluster_from(g4hit);
-      
-      float clusID = NAN;
-      float x = NAN;
-      float y = NAN;
-      float z = NAN;
-      float eta = NAN;
-      float phi = NAN;
-      float e = NAN;
-      float adc = NAN;
-      float layer = NAN;
-      float size = NAN;
-      float phisize = NAN;
-      float zsize = NAN;
-      float efromtruth = NAN;
-      float dphitru = NAN;
-      float detatru = NAN;
-      float dztru = NAN;
-      float drtru = NAN;
-
-      TrkrClusterContainer* clustermap = findNode::getClass<TrkrClusterContainer>(topNode, "TRKR_CLUSTER");
-      TrkrCluster *cluster = clustermap->findCluster(cluster_key);
-
-      if (cluster)
+      PHG4Particle* g4particle = trutheval->get_particle(*iter);
+      if (g4particle && _scan_for_embedded)
       {
-        clusID = cluster_key;
-        x = cluster->getX();
-        y = cluster->getY();
-        z = cluster->getZ();
-        TVector3 vec2(x, y, z);
-        eta = vec2.Eta();
-        phi = vec2.Phi();
-        e = cluster->getAdc();
-        adc = cluster->getAdc();
-        layer = (float) TrkrDefs::getLayer(cluster_key);
-        size = 0.0;
-	// count all hits for this cluster
-
-	TrkrClusterHitAssoc *cluster_hit_map = findNode::getClass<TrkrClusterHitAssoc>(topNode, "TRKR_CLUSTERHITASSOC");
-	TrkrClusterHitAssoc::ConstRange hitrange = cluster_hit_map->getHits(cluster_key);  
-	for(TrkrClusterHitAssoc::ConstIterator clushititer = hitrange.first; clushititer != hitrange.second; ++clushititer)
-	  {
-	    ++size; 
-	  }
-        phisize = cluster->getPhiSize();
-        zsize = cluster->getZSize();
-        dphitru = vec2.DeltaPhi(vg4);
-        detatru = eta - geta;
-        dztru = z - gz;
-        drtru = vec2.DeltaR(vg4);
-        if (g4particle)
-        {
-          efromtruth = clustereval->get_energy_contribution(cluster_key, g4particle);
-        }
+        if (trutheval->get_embed(g4particle) <= 0) continue;
       }
-
-      float g4hit_data[] = {(float) _ievent,
-                            g4hitID,
-                            gx,
-                            gy,
-                            gz,
-                            gt,
-                            gedep,
-                            geta,
-                            gphi,
-                            gdphi,
-                            gdz,
-                            glayer,
-                            gtrackID,
-                            gflavor,
-                            gpx,
-                            gpy,
-                            gpz,
-                            gvx,
-                            gvy,
-                            gvz,
-                            gfpx,
-                            gfpy,
-                            gfpz,
-                            gfx,
-                            gfy,
-                            gfz,
-                            gembed,
-                            gprimary,
-                            nclusters,
-                            clusID,
-                            x,
-                            y,
-                            z,
-                            eta,
-                            phi,
-                            e,
-                            adc,
-                            layer,
-                            size,
-                            phisize,
-                            zsize,
-                            efromtruth,
-                            dphitru,
-                            detatru,
-                            dztru,
-                            drtru,
-                            nhit_tpc_all,
-                            nhit_tpc_in,
-                            nhit_tpc_mid,
-                            nhit_tpc_out, nclus_all, nclus_tpc, nclus_intt, nclus_maps};
-
-      _ntp_g4hit->Fill(g4hit_data);
+      g4hits.push_back(*iter);
+      g4particles.push_back(g4particle);
     }
+
+    vector<TrkrDefs::cluskey> cluster_keys;
+    vector<TrkrCluster*> clusters;
+
+    EvalColumns columns(g4hit_varlist);
+    columns.set_verbosity(Verbosity());
+
+    add_event_columns(columns, event_values);
+
+    columns.add("g4hit", "g4hitID:gx:gy:gz:gt:gedep:geta:gphi:gdphi:gdz:glayer:gtrackID", "",
+                [&](const unsigned int n) {
+                  vector<float>& g4hitID = columns.column("g4hitID");
+                  vector<float>& gx = columns.column("gx");
+                  vector<float>& gy = columns.column("gy");
+                  vector<float>& gz = columns.column("gz");
+                  vector<float>& gt = columns.column("gt");
+                  vector<float>& gedep = columns.column("gedep");
+                  vector<float>& geta = columns.column("geta");
+                  vector<float>& gphi = columns.column("gphi");
+                  vector<float>& gdphi = columns.column("gdphi");
+                  vector<float>& gdz = columns.column("gdz");
+                  vector<float>& glayer = columns.column("glayer");
+                  vector<float>& gtrackID = columns.column("gtrackID");
+                  for (unsigned int i = 0; i < n; ++i)
+                  {
+                    PHG4Hit* g4hit = g4hits[i];
+                    g4hitID[i] = g4hit->get_hit_id();
+                    gx[i] = g4hit->get_avg_x();
+                    gy[i] = g4hit->get_avg_y();
+                    gz[i] = g4hit->get_avg_z();
+                    gt[i] = g4hit->get_avg_t();
+                    gedep[i] = g4hit->get_edep();
+                    TVector3 vec(gx[i], gy[i], gz[i]);
+                    geta[i] = vec.Eta();
+                    gphi[i] = vec.Phi();
+                    TVector3 vin(g4hit->get_x(0), g4hit->get_y(0), g4hit->get_z(0));
+                    TVector3 vout(g4hit->get_x(1), g4hit->get_y(1), g4hit->get_z(1));
+                    gdphi[i] = vin.DeltaPhi(vout);
+                    gdz[i] = fabs(g4hit->get_z(1) - g4hit->get_z(0));
+                    glayer[i] = g4hit->get_layer();
+                    gtrackID[i] = g4hit->get_trkid();
+                  }
+                });
+
+    columns.add("gparticle", "gflavor:gpx:gpy:gpz:gvx:gvy:gvz:gembed:gprimary", "",
+                [&](const unsigned int n) {
+                  vector<float>& gflavor = columns.column("gflavor");
+                  vector<float>& gpx = columns.column("gpx");
+                  vector<float>& gpy = columns.column("gpy");
+                  vector<float>& gpz = columns.column("gpz");
+                  vector<float>& gvx = columns.column("gvx");
+                  vector<float>& gvy = columns.column("gvy");
+                  vector<float>& gvz = columns.column("gvz");
+                  vector<float>& gembed = columns.column("gembed");
+                  vector<float>& gprimary = columns.column("gprimary");
+                  for (unsigned int i = 0; i < n; ++i)
+                  {
+                    PHG4Particle* g4particle = g4particles[i];
+                    if (!g4particle) continue;
+                    gflavor[i] = g4particle->get_pid();
+                    gpx[i] = g4particle->get_px();
+                    gpy[i] = g4particle->get_py();
+                    gpz[i] = g4particle->get_pz();
+
+                    PHG4VtxPoint* vtx = trutheval->get_vertex(g4particle);
+                    if (vtx)
+                    {
+                      gvx[i] = vtx->get_x();
+                      gvy[i] = vtx->get_y();
+                      gvz[i] = vtx->get_z();
+                    }
+
+                    gembed[i] = trutheval->get_embed(g4particle);
+                    gprimary[i] = trutheval->is_primary(g4particle);
+                  }
+                });
+
+    columns.add("goutermost", "gfpx:gfpy:gfpz:gfx:gfy:gfz", "",
+                [&](const unsigned int n) {
+                  const char* names[] = {"gfpx", "gfpy", "gfpz", "gfx", "gfy", "gfz"};
+                  for (unsigned int j = 0; j < 6; ++j) columns.column(names[j]).assign(n, 0.);
+                  if (_do_eval_light) return;
+                  vector<float>& gfpx = columns.column("gfpx");
+                  vector<float>& gfpy = columns.column("gfpy");
+                  vector<float>& gfpz = columns.column("gfpz");
+                  vector<float>& gfx = columns.column("gfx");
+                  vector<float>& gfy = columns.column("gfy");
+                  vector<float>& gfz = columns.column("gfz");
+                  for (unsigned int i = 0; i < n; ++i)
+                  {
+                    if (!g4particles[i]) continue;
+                    PHG4Hit* outerhit = trutheval->get_outermost_truth_hit(g4particles[i]);
+                    if (!outerhit) continue;
+                    gfpx[i] = outerhit->get_px(1);
+                    gfpy[i] = outerhit->get_py(1);
+                    gfpz[i] = outerhit->get_pz(1);
+                    gfx[i] = outerhit->get_x(1);
+                    gfy[i] = outerhit->get_y(1);
+                    gfz[i] = outerhit->get_z(1);
+                  }
+                });
+
+    columns.add("nclusters", "nclusters", "",
+                [&](const unsigned int n) {
+                  vector<float>& nclusters = columns.column("nclusters");
+                  for (unsigned int i = 0; i < n; ++i)
+                  {
+                    nclusters[i] = clustereval->all_clusters_from(g4hits[i]).size();
+                  }
+                });
+
+    columns.add("cluster", "", "",
+                [&](const unsigned int n) {
+                  // best cluster reco'd
+                  cluster_keys.resize(n);
+                  clusters.resize(n);
+                  for (unsigned int i = 0; i < n; ++i)
+                  {
+                    cluster_keys[i] = clustereval->best_cluster_from(g4hits[i]);
+                    clusters[i] = clustermap->findCluster(cluster_keys[i]);
+                  }
+                });
+
+    columns.add("reco", "clusID:x:y:z:eta:phi:e:adc:layer:phisize:zsize:dphitru:detatru:dztru:drtru", "cluster",
+                [&](const unsigned int n) {
+                  vector<float>& clusID = columns.column("clusID");
+                  vector<float>& x = columns.column("x");
+                  vector<float>& y = columns.column("y");
+                  vector<float>& z = columns.column("z");
+                  vector<float>& eta = columns.column("eta");
+                  vector<float>& phi = columns.column("phi");
+                  vector<float>& e = columns.column("e");
+                  vector<float>& adc = columns.column("adc");
+                  vector<float>& layer = columns.column("layer");
+                  vector<float>& phisize = columns.column("phisize");
+                  vector<float>& zsize = columns.column("zsize");
+                  vector<float>& dphitru = columns.column("dphitru");
+                  vector<float>& detatru = columns.column("detatru");
+                  vector<float>& dztru = columns.column("dztru");
+                  vector<float>& drtru = columns.column("drtru");
+                  for (unsigned int i = 0; i < n; ++i)
+                  {
+                    TrkrCluster* cluster = clusters[i];
+                    if (!cluster) continue;
+                    clusID[i] = cluster_keys[i];
+                    x[i] = cluster->getX();
+                    y[i] = cluster->getY();
+                    z[i] = cluster->getZ();
+                    TVector3 vec2(x[i], y[i], z[i]);
+                    eta[i] = vec2.Eta();
+                    phi[i] = vec2.Phi();
+                    e[i] = cluster->getAdc();
+                    adc[i] = cluster->getAdc();
+                    layer[i] = (float) TrkrDefs::getLayer(cluster_keys[i]);
+                    phisize[i] = cluster->getPhiSize();
+                    zsize[i] = cluster->getZSize();
+                    TVector3 vg4(g4hits[i]->get_avg_x(), g4hits[i]->get_avg_y(), g4hits[i]->get_avg_z());
+                    dphitru[i] = vec2.DeltaPhi(vg4);
+                    detatru[i] = eta[i] - vg4.Eta();
+                    dztru[i] = z[i] - vg4.z();
+                    drtru[i] = vec2.DeltaR(vg4);
+                  }
+                });
+
+    columns.add("size", "size", "cluster",
+                [&](const unsigned int n) {
+                  // count all hits for this cluster
+                  vector<float>& size = columns.column("size");
+                  for (unsigned int i = 0; i < n; ++i)
+                  {
+                    if (!clusters[i]) continue;
+                    TrkrClusterHitAssoc::ConstRange hitrange = clusterhitmap->getHits(cluster_keys[i]);
+                    size[i] = distance(hitrange.first, hitrange.second);
+                  }
+                });
+
+    columns.add("efromtruth", "efromtruth", "cluster",
+                [&](const unsigned int n) {
+                  vector<float>& efromtruth = columns.column("efromtruth");
+                  for (unsigned int i = 0; i < n; ++i)
+                  {
+                    if (clusters[i] && g4particles[i]) efromtruth[i] = clustereval->get_energy_contribution(cluster_keys[i], g4particles[i]);
+                  }
+                });
+
+    columns.evaluate(_ntp_g4hit, g4hits.size());
+
     if (Verbosity() >= 1)
     {
       _timer->stop();
@@ -1311,7 +1431,7 @@ void SvtxEvaluator::fillOutputNtuples(PHCompositeNode* topNode)
   // fill the Hit NTuple
   //--------------------
 
-  if (_ntp_hit)
+  if (_ntp_hit && !_ntp_hit->empty())
   {
     if (Verbosity() > 0)
     {
@@ -1330,171 +1450,181 @@ void SvtxEvaluator::fillOutputNtuples(PHCompositeNode* topNode)
 
     if (hitmap)
     {
+      // one row per hit, with scan_for_embedded the truth match of each hit
+      // decides whether it gets a row, otherwise it is only done when needed
+      vector<TrkrDefs::hitsetkey> hitset_keys;
+      vector<TrkrDefs::hitkey> hit_keys;
+      vector<TrkrHit*> hits;
+      vector<PHG4Hit*> g4hits;
+      vector<PHG4Particle*> g4particles;
       TrkrHitSetContainer::ConstRange all_hitsets = hitmap->getHitSets();
       for (TrkrHitSetContainer::ConstIterator iter = all_hitsets.first;
            iter != all_hitsets.second;
            ++iter)
       {
-	TrkrDefs::hitsetkey hitset_key = iter->first;
-	TrkrHitSet *hitset = iter->second;
-
-	// get all hits for this hitset
-	TrkrHitSet::ConstRange hitrangei = hitset->getHits();
-	for (TrkrHitSet::ConstIterator hitr = hitrangei.first;
-	     hitr != hitrangei.second;
-	     ++hitr)
-	  {
-	    TrkrDefs::hitkey hit_key = hitr->first;	    
-	    TrkrHit *hit = hitr->second;
-	    PHG4Hit* g4hit = hiteval->max_truth_hit_by_energy(hit_key);
-	    PHG4Particle* g4particle = trutheval->get_particle(g4hit);
-	    
-	    float event = _ievent;
-	    float hitID = hit_key;
-	    float e = hit->getEnergy();
-	    float adc = hit->getAdc();
-	    float layer = TrkrDefs::getLayer(hitset_key);
-	    float cellID = 0;
-	    float ecell = hit->getAdc();
-	    
-	    int phibin = -1;
-	    int zbin = -1;
-	    float phi = NAN;
-	    float z = NAN;
-	    
-	    if (layer >= _nlayers_maps + _nlayers_intt)
-	      {
-		PHG4CylinderCellGeom* GeoLayer = geom_container->GetLayerCellGeom(layer);
-		phibin = TpcDefs::getPad(hit_key);
-		zbin = TpcDefs::getTBin(hit_key);
-		phi = GeoLayer->get_phicenter(phibin);
-		z = GeoLayer->get_zcenter(zbin);
-	      }
-
-	    float g4hitID = NAN;
-	    float gedep = NAN;
-	    float gx = NAN;
-	    float gy = NAN;
-	    float gz = NAN;
-	    float gt = NAN;
-	    float gtrackID = NAN;
-	    float gflavor = NAN;
-	    float gpx = NAN;
-	    float gpy = NAN;
-	    float gpz = NAN;
-	    float gvx = NAN;
-	    float gvy = NAN;
-	    float gvz = NAN;
-	    float gvt = NAN;
-	    float gfpx = NAN;
-	    float gfpy = NAN;
-	    float gfpz = NAN;
-	    float gfx = NAN;
-	    float gfy = NAN;
-	    float gfz = NAN;
-	    float gembed = NAN;
-	    float gprimary = NAN;
-	    
-	    float efromtruth = NAN;
-	    
-	    if (g4hit)
-	      {
-		g4hitID = g4hit->get_hit_id();
-		gedep = g4hit->get_edep();
-		gx = g4hit->get_avg_x();
-		gy = g4hit->get_avg_y();
-		gz = g4hit->get_avg_z();
-		gt = g4hit->get_avg_t();
-		
-		if (g4particle)
-		  {
-		    if (_scan_for_embedded)
-		      {
-			if (trutheval->get_embed(g4particle) <= 0) continue;
-		      }
-		    
-		    gtrackID = g4particle->get_track_id();
-		    gflavor = g4particle->get_pid();
-		    gpx = g4particle->get_px();
-		    gpy = g4particle->get_py();
-		    gpz = g4particle->get_pz();
-		    
-		    PHG4VtxPoint* vtx = trutheval->get_vertex(g4particle);
-		    
-		    if (vtx)
-		      {
-			gvx = vtx->get_x();
-			gvy = vtx->get_y();
-			gvz = vtx->get_z();
-			gvt = vtx->get_t();
-		      }
-
-		    PHG4Hit* outerhit = nullptr;
-		    if (_do_eval_light == false)
-		      outerhit = trutheval->get_outermost_truth_hit(g4particle);
-		    if (outerhit)
-		      {
-			gfpx = outerhit->get_px(1);
-			gfpy = outerhit->get_py(1);
-			gfpz = outerhit->get_pz(1);
-			gfx = outerhit->get_x(1);
-			gfy = outerhit->get_y(1);
-			gfz = outerhit->get_z(1);
-		      }
-		    gembed = trutheval->get_embed(g4particle);
-		    gprimary = trutheval->is_primary(g4particle);
-		  }  //   if (g4particle){
-	      }
-	    
-	    if (g4particle)
-	      {
-		efromtruth = hiteval->get_energy_contribution(hit_key, g4particle);
-	      }
-	    
-	    float hit_data[] = {
-	      event,
-	      hitID,
-	      e,
-	      adc,
-	      layer,
-	      cellID,
-	      ecell,
-	      (float) phibin,
-	      (float) zbin,
-	      phi,
-	      z,
-	      g4hitID,
-	      gedep,
-	      gx,
-	      gy,
-	      gz,
-	      gt,
-	      gtrackID,
-	      gflavor,
-	      gpx,
-	      gpy,
-	      gpz,
-	      gvx,
-	      gvy,
-	      gvz,
-	      gvt,
-	      gfpx,
-	      gfpy,
-	      gfpz,
-	      gfx,
-	      gfy,
-	      gfz,
-	      gembed,
-	      gprimary,
-	      efromtruth,
-	      nhit_tpc_all,
-	      nhit_tpc_in,
-	      nhit_tpc_mid,
-	      nhit_tpc_out, nclus_all, nclus_tpc, nclus_intt, nclus_maps};
-	    
-	    _ntp_hit->Fill(hit_data);
-	  }
+        // get all hits for this hitset
+        TrkrHitSet::ConstRange hitrangei = iter->second->getHits();
+        for (TrkrHitSet::ConstIterator hitr = hitrangei.first;
+             hitr != hitrangei.second;
+             ++hitr)
+        {
+          if (_scan_for_embedded)
+          {
+            PHG4Hit* g4hit = hiteval->max_truth_hit_by_energy(hitr->first);
+            PHG4Particle* g4particle = trutheval->get_particle(g4hit);
+            if (g4hit && g4particle && trutheval->get_embed(g4particle) <= 0) continue;
+            g4hits.push_back(g4hit);
+            g4particles.push_back(g4particle);
+          }
+          hitset_keys.push_back(iter->first);
+          hit_keys.push_back(hitr->first);
+          hits.push_back(hitr->second);
+        }
       }
+
+      EvalColumns columns(hit_varlist);
+      columns.set_verbosity(Verbosity());
+
+      add_event_columns(columns, event_values);
+
+      columns.add("hit", "hitID:e:adc:layer:cellID:ecell:phibin:zbin:phi:z", "",
+                  [&](const unsigned int n) {
+                    vector<float>& hitID = columns.column("hitID");
+                    vector<float>& e = columns.column("e");
+                    vector<float>& adc = columns.column("adc");
+                    vector<float>& layer = columns.column("layer");
+                    vector<float>& cellID = columns.column("cellID");
+                    vector<float>& ecell = columns.column("ecell");
+                    vector<float>& phibin = columns.column("phibin");
+                    vector<float>& zbin = columns.column("zbin");
+                    vector<float>& phi = columns.column("phi");
+                    vector<float>& z = columns.column("z");
+                    for (unsigned int i = 0; i < n; ++i)
+                    {
+                      hitID[i] = hit_keys[i];
+                      e[i] = hits[i]->getEnergy();
+                      adc[i] = hits[i]->getAdc();
+                      layer[i] = TrkrDefs::getLayer(hitset_keys[i]);
+                      cellID[i] = 0;
+                      ecell[i] = hits[i]->getAdc();
+                      phibin[i] = -1;
+                      zbin[i] = -1;
+                      if (layer[i] >= _nlayers_maps + _nlayers_intt)
+                      {
+                        PHG4CylinderCellGeom* GeoLayer = geom_container->GetLayerCellGeom(layer[i]);
+                        const int pad = TpcDefs::getPad(hit_keys[i]);
+                        const int tbin = TpcDefs::getTBin(hit_keys[i]);
+                        phibin[i] = pad;
+                        zbin[i] = tbin;
+                        phi[i] = GeoLayer->get_phicenter(pad);
+                        z[i] = GeoLayer->get_zcenter(tbin);
+                      }
+                    }
+                  });
+
+      columns.add("g4hit", "", "",
+                  [&](const unsigned int n) {
+                    if (_scan_for_embedded) return;  // matched with the rows
+                    g4hits.resize(n);
+                    g4particles.resize(n);
+                    for (unsigned int i = 0; i < n; ++i)
+                    {
+                      g4hits[i] = hiteval->max_truth_hit_by_energy(hit_keys[i]);
+                      g4particles[i] = trutheval->get_particle(g4hits[i]);
+                    }
+                  });
+
+      columns.add("gtruth", "g4hitID:gedep:gx:gy:gz:gt", "g4hit",
+                  [&](const unsigned int n) {
+                    vector<float>& g4hitID = columns.column("g4hitID");
+                    vector<float>& gedep = columns.column("gedep");
+                    vector<float>& gx = columns.column("gx");
+                    vector<float>& gy = columns.column("gy");
+                    vector<float>& gz = columns.column("gz");
+                    vector<float>& gt = columns.column("gt");
+                    for (unsigned int i = 0; i < n; ++i)
+                    {
+                      PHG4Hit* g4hit = g4hits[i];
+                      if (!g4hit) continue;
+                      g4hitID[i] = g4hit->get_hit_id();
+                      gedep[i] = g4hit->get_edep();
+                      gx[i] = g4hit->get_avg_x();
+                      gy[i] = g4hit->get_avg_y();
+                      gz[i] = g4hit->get_avg_z();
+                      gt[i] = g4hit->get_avg_t();
+                    }
+                  });
+
+      columns.add("gparticle", "gtrackID:gflavor:gpx:gpy:gpz:gvx:gvy:gvz:gvt:gembed:gprimary", "g4hit",
+                  [&](const unsigned int n) {
+                    vector<float>& gtrackID = columns.column("gtrackID");
+                    vector<float>& gflavor = columns.column("gflavor");
+                    vector<float>& gpx = columns.column("gpx");
+                    vector<float>& gpy = columns.column("gpy");
+                    vector<float>& gpz = columns.column("gpz");
+                    vector<float>& gvx = columns.column("gvx");
+                    vector<float>& gvy = columns.column("gvy");
+                    vector<float>& gvz = columns.column("gvz");
+                    vector<float>& gvt = columns.column("gvt");
+                    vector<float>& gembed = columns.column("gembed");
+                    vector<float>& gprimary = columns.column("gprimary");
+                    for (unsigned int i = 0; i < n; ++i)
+                    {
+                      PHG4Particle* g4particle = g4particles[i];
+                      if (!g4hits[i] || !g4particle) continue;
+                      gtrackID[i] = g4particle->get_track_id();
+                      gflavor[i] = g4particle->get_pid();
+                      gpx[i] = g4particle->get_px();
+                      gpy[i] = g4particle->get_py();
+                      gpz[i] = g4particle->get_pz();
+
+                      PHG4VtxPoint* vtx = trutheval->get_vertex(g4particle);
+                      if (vtx)
+                      {
+                        gvx[i] = vtx->get_x();
+                        gvy[i] = vtx->get_y();
+                        gvz[i] = vtx->get_z();
+                        gvt[i] = vtx->get_t();
+                      }
+
+                      gembed[i] = trutheval->get_embed(g4particle);
+                      gprimary[i] = trutheval->is_primary(g4particle);
+                    }
+                  });
+
+      columns.add("goutermost", "gfpx:gfpy:gfpz:gfx:gfy:gfz", "g4hit",
+                  [&](const unsigned int n) {
+                    if (_do_eval_light) return;
+                    vector<float>& gfpx = columns.column("gfpx");
+                    vector<float>& gfpy = columns.column("gfpy");
+                    vector<float>& gfpz = columns.column("gfpz");
+                    vector<float>& gfx = columns.column("gfx");
+                    vector<float>& gfy = columns.column("gfy");
+                    vector<float>& gfz = columns.column("gfz");
+                    for (unsigned int i = 0; i < n; ++i)
+                    {
+                      if (!g4hits[i] || !g4particles[i]) continue;
+                      PHG4Hit* outerhit = trutheval->get_outermost_truth_hit(g4particles[i]);
+                      if (!outerhit) continue;
+                      gfpx[i] = outerhit->get_px(1);
+                      gfpy[i] = outerhit->get_py(1);
+                      gfpz[i] = outerhit->get_pz(1);
+                      gfx[i] = outerhit->get_x(1);
+                      gfy[i] = outerhit->get_y(1);
+                      gfz[i] = outerhit->get_z(1);
+                    }
+                  });
+
+      columns.add("efromtruth", "efromtruth", "g4hit",
+                  [&](const unsigned int n) {
+                    vector<float>& efromtruth = columns.column("efromtruth");
+                    for (unsigned int i = 0; i < n; ++i)
+                    {
+                      if (g4particles[i]) efromtruth[i] = hiteval->get_energy_contribution(hit_keys[i], g4particles[i]);
+                    }
+                  });
+
+      columns.evaluate(_ntp_hit, hits.size());
     }
     if (Verbosity() >= 1)
     {
@@ -1513,404 +1643,262 @@ void SvtxEvaluator::fillOutputNtuples(PHCompositeNode* topNode)
     _timer->restart();
   }
 
-  if (_ntp_cluster && !_scan_for_embedded)
+  if (_ntp_cluster && !_ntp_cluster->empty())
   {
-    if (Verbosity() > 0) cout << "Filling ntp_cluster (all of them) " << endl;
     // need things off of the DST...
     TrkrClusterContainer* clustermap = findNode::getClass<TrkrClusterContainer>(topNode, "TRKR_CLUSTER");
     TrkrClusterHitAssoc* clusterhitmap = findNode::getClass<TrkrClusterHitAssoc>(topNode, "TRKR_CLUSTERHITASSOC");
-    if (clustermap && clusterhitmap)
+    SvtxTrackMap* trackmap = findNode::getClass<SvtxTrackMap>(topNode, _trackmapname.c_str());
+    if (clustermap && clusterhitmap && (trackmap || !_scan_for_embedded))
     {
-      TrkrClusterContainer::ConstRange all_clusters = clustermap->getClusters();
-      for (TrkrClusterContainer::ConstIterator iter = all_clusters.first;
-           iter != all_clusters.second;
-           ++iter)
+      // one row per cluster, only the selected columns and what they need are computed,
+      // each step for all clusters at once
+      vector<TrkrDefs::cluskey> keys;
+      vector<TrkrCluster*> clusters;
+      vector<SvtxTrack*> tracks;
+      if (!_scan_for_embedded)
       {
-	TrkrDefs::cluskey cluster_key = iter->first;
-	TrkrCluster *cluster = clustermap->findCluster(cluster_key);
-        SvtxTrack* track = trackeval->best_track_from(cluster_key);
-        PHG4Hit* g4hit = clustereval->max_truth_hit_by_energy(cluster_key);
-        PHG4Particle* g4particle = trutheval->get_particle(g4hit);
-
-        float hitID = (float) cluster_key;
-        float x = cluster->getX();
-        float y = cluster->getY();
-	float z = cluster->getZ();
-        TVector3 pos(x, y, z);
-        float r = pos.Perp();
-        float phi = pos.Phi();
-        float eta = pos.Eta();
-
-        float ex = sqrt(cluster->getError(0, 0));
-        float ey = sqrt(cluster->getError(1, 1));
-        float ez = cluster->getZError();
-        float ephi = cluster->getRPhiError();
-
-        float e = cluster->getAdc();
-        float adc = cluster->getAdc();
-        float layer = (float) TrkrDefs::getLayer(cluster_key);
-        float size = 0;
-	// count all hits for this cluster
-	TrkrClusterHitAssoc::ConstRange hitrange = clusterhitmap->getHits(cluster_key);  
-	for(TrkrClusterHitAssoc::ConstIterator clushititer = hitrange.first; clushititer != hitrange.second; ++clushititer)
-	  {
-	    ++size; 
-	  }
-        float phisize = cluster->getPhiSize();
-        float zsize = cluster->getZSize();
-
-        float trackID = NAN;
-        if (track) trackID = track->get_id();
-
-        float g4hitID = NAN;
-        float gx = NAN;
-        float gy = NAN;
-        float gz = NAN;
-        float gr = NAN;
-        float gphi = NAN;
-        float gedep = NAN;
-        float geta = NAN;
-        float gt = NAN;
-        float gtrackID = NAN;
-        float gflavor = NAN;
-        float gpx = NAN;
-        float gpy = NAN;
-        float gpz = NAN;
-        float gvx = NAN;
-        float gvy = NAN;
-        float gvz = NAN;
-        float gvt = NAN;
-        float gfpx = NAN;
-        float gfpy = NAN;
-        float gfpz = NAN;
-        float gfx = NAN;
-        float gfy = NAN;
-        float gfz = NAN;
-        float gembed = NAN;
-        float gprimary = NAN;
-
-        float efromtruth = NAN;
-
-        if (g4hit)
-        {
-	  // cluster the associated truth hits within the same layer to get the truth cluster position
-	   std::set<PHG4Hit*> truth_hits = clustereval->all_truth_hits(cluster_key);
-	   std::vector<PHG4Hit*> contributing_hits;
-	   std::vector<double> contributing_hits_energy;
-	   std::vector<std::vector<double>> contributing_hits_entry;
-	   std::vector<std::vector<double>> contributing_hits_exit;
-	   LayerClusterG4Hits(topNode, truth_hits, contributing_hits, contributing_hits_energy, contributing_hits_entry, contributing_hits_exit, layer, gx, gy, gz, gt, gedep);
-
-	    g4hitID = g4hit->get_hit_id();
-	    TVector3 gpos(gx, gy, gz);
-	    gr = gpos.Perp();  // c ould also be just the center of gthe layer
-	    gphi = gpos.Phi();
-	    geta = gpos.Eta();
-
-          if (g4particle)
-          {
-            gtrackID = g4particle->get_track_id();
-            gflavor = g4particle->get_pid();
-            gpx = g4particle->get_px();
-            gpy = g4particle->get_py();
-            gpz = g4particle->get_pz();
-
-            PHG4VtxPoint* vtx = trutheval->get_vertex(g4particle);
-            if (vtx)
-            {
-              gvx = vtx->get_x();
-              gvy = vtx->get_y();
-              gvz = vtx->get_z();
-              gvt = vtx->get_t();
-            }
-
-            PHG4Hit* outerhit = nullptr;
-            if (_do_eval_light == false)
-              outerhit = trutheval->get_outermost_truth_hit(g4particle);
-            if (outerhit)
-            {
-              gfpx = outerhit->get_px(1);
-              gfpy = outerhit->get_py(1);
-              gfpz = outerhit->get_pz(1);
-              gfx = outerhit->get_x(1);
-              gfy = outerhit->get_y(1);
-              gfz = outerhit->get_z(1);
-            }
-
-            gembed = trutheval->get_embed(g4particle);
-            gprimary = trutheval->is_primary(g4particle);
-
-          }  //   if (g4particle){
-        }    //  if (g4hit) {
-
-        if (g4particle)
+        if (Verbosity() > 0) cout << "Filling ntp_cluster (all of them) " << endl;
+        keys.reserve(clustermap->size());
+        clusters.reserve(clustermap->size());
+        TrkrClusterContainer::ConstRange all_clusters = clustermap->getClusters();
+        for (TrkrClusterContainer::ConstIterator iter = all_clusters.first;
+             iter != all_clusters.second;
+             ++iter)
         {
-          efromtruth = clustereval->get_energy_contribution(cluster_key, g4particle);
+          keys.push_back(iter->first);
+          clusters.push_back(iter->second);
         }
-
-        float nparticles = clustereval->all_truth_particles(cluster_key).size();
-        float cluster_data[] = {(float) _ievent,
-                                hitID,
-                                x,
-                                y,
-                                z,
-                                r,
-                                phi,
-                                eta,
-                                ex,
-                                ey,
-                                ez,
-                                ephi,
-                                e,
-                                adc,
-                                layer,
-                                size,
-                                phisize,
-                                zsize,
-                                trackID,
-                                g4hitID,
-                                gx,
-                                gy,
-                                gz,
-                                gr,
-                                gphi,
-                                geta,
-                                gt,
-                                gtrackID,
-                                gflavor,
-                                gpx,
-                                gpy,
-                                gpz,
-                                gvx,
-                                gvy,
-                                gvz,
-                                gvt,
-                                gfpx,
-                                gfpy,
-                                gfpz,
-                                gfx,
-                                gfy,
-                                gfz,
-                                gembed,
-                                gprimary,
-                                efromtruth,
-                                nparticles,
-                                nhit_tpc_all,
-                                nhit_tpc_in,
-                                nhit_tpc_mid,
-                                nhit_tpc_out, nclus_all, nclus_tpc, nclus_intt, nclus_maps};
-
-        _ntp_cluster->Fill(cluster_data);
       }
-    }
-  }
-  else if (_ntp_cluster && _scan_for_embedded)
-  {
-    if (Verbosity() > 0) cout << "Filling ntp_cluster (embedded only) " << endl;
-
-    // if only scanning embedded signals, loop over all the tracks from
-    // embedded particles and report all of their clusters, including those
-    // from other sources (noise hits on the embedded track)
-
-    // need things off of the DST...
-    SvtxTrackMap* trackmap = findNode::getClass<SvtxTrackMap>(topNode, _trackmapname.c_str());
-    TrkrClusterContainer* clustermap = findNode::getClass<TrkrClusterContainer>(topNode, "TRKR_CLUSTER");
-    TrkrClusterHitAssoc* clusterhitmap = findNode::getClass<TrkrClusterHitAssoc>(topNode, "TRKR_CLUSTERHITASSOC");
-    if (trackmap)
-    {
-      for (SvtxTrackMap::Iter iter = trackmap->begin();
-           iter != trackmap->end();
-           ++iter)
+      else
       {
-        SvtxTrack* track = iter->second;
+        if (Verbosity() > 0) cout << "Filling ntp_cluster (embedded only) " << endl;
 
-        PHG4Particle* truth = trackeval->max_truth_particle_by_nclusters(track);
-        if (truth)
-        {
-          if (trutheval->get_embed(truth) <= 0) continue;
-        }
-
-        for (SvtxTrack::ConstClusterKeyIter iter = track->begin_cluster_keys();
-             iter != track->end_cluster_keys();
+        // if only scanning embedded signals, loop over all the tracks from
+        // embedded particles and report all of their clusters, including those
+        // from other sources (noise hits on the embedded track)
+        for (SvtxTrackMap::Iter iter = trackmap->begin();
+             iter != trackmap->end();
              ++iter)
-	  {
-	  TrkrDefs::cluskey cluster_key = *iter;
-          TrkrCluster* cluster = clustermap->findCluster(cluster_key);
-
-          PHG4Hit* g4hit = clustereval->max_truth_hit_by_energy(cluster_key);
-          PHG4Particle* g4particle = trutheval->get_particle(g4hit);
-
-          float hitID = cluster_key;
-          float x = cluster->getX();
-          float y = cluster->getY();
-          float z = cluster->getZ();
-          TVector3 pos(x, y, z);
-          float r = pos.Perp();
-          float phi = pos.Phi();
-          float eta = pos.Eta();
-          float ex = sqrt(cluster->getError(0, 0));
-          float ey = sqrt(cluster->getError(1, 1));
-          float ez = cluster->getZError();
-
-          float ephi = cluster->getRPhiError();
-
-          float e = cluster->getAdc();
-          float adc = cluster->getAdc();
-          float layer = (float) TrkrDefs::getLayer(cluster_key);
-
-	  // count all hits for this cluster
-	  float size = 0;
-	  TrkrClusterHitAssoc::ConstRange hitrange = clusterhitmap->getHits(cluster_key);  
-	  for(TrkrClusterHitAssoc::ConstIterator clushititer = hitrange.first; clushititer != hitrange.second; ++clushititer)
-	    {
-	      ++size; 
-	    }	  
-          float phisize = cluster->getPhiSize();
-          float zsize = cluster->getZSize();
-
-          float trackID = NAN;
-          trackID = track->get_id();
-
-	  float g4hitID = NAN;
-	  float gx = NAN;
-	  float gy = NAN;
-	  float gz = NAN;
-	  float gr = NAN;
-	  float gphi = NAN;
-	  float gedep = NAN;
-	  float geta = NAN;
-	  float gt = NAN;
-	  float gtrackID = NAN;
-	  float gflavor = NAN;
-	  float gpx = NAN;
-	  float gpy = NAN;
-	  float gpz = NAN;
-	  float gvx = NAN;
-	  float gvy = NAN;
-	  float gvz = NAN;
-	  float gvt = NAN;
-	  float gfpx = NAN;
-	  float gfpy = NAN;
-	  float gfpz = NAN;
-	  float gfx = NAN;
-	  float gfy = NAN;
-	  float gfz = NAN;
-	  float gembed = NAN;
-	  float gprimary = NAN;
-	  
-          float efromtruth = NAN;
+        {
+          SvtxTrack* track = iter->second;
 
-          if (g4hit)
+          PHG4Particle* truth = trackeval->max_truth_particle_by_nclusters(track);
+          if (truth)
           {
-	    // cluster truth hits in layer
-	   std::set<PHG4Hit*> truth_hits = clustereval->all_truth_hits(cluster_key);
-	   std::vector<PHG4Hit*> contributing_hits;
-	   std::vector<double> contributing_hits_energy;
-	   std::vector<std::vector<double>> contributing_hits_entry;
-	   std::vector<std::vector<double>> contributing_hits_exit;
-	   LayerClusterG4Hits(topNode, truth_hits, contributing_hits, contributing_hits_energy, contributing_hits_entry, contributing_hits_exit, layer, gx, gy, gz, gt, gedep);
-
-	    g4hitID = g4hit->get_hit_id();
-	    TVector3 gpos(gx, gy, gz);
-	    gr = gpos.Perp();
-	    gphi = gpos.Phi();
-	    geta = gpos.Eta();
-
-	  if (g4particle)
-            {
-              gtrackID = g4particle->get_track_id();
-              gflavor = g4particle->get_pid();
-              gpx = g4particle->get_px();
-              gpy = g4particle->get_py();
-              gpz = g4particle->get_pz();
-
-              PHG4VtxPoint* vtx = trutheval->get_vertex(g4particle);
-              if (vtx)
-              {
-                gvx = vtx->get_x();
-                gvy = vtx->get_y();
-                gvz = vtx->get_z();
-		gvt = vtx->get_t();
-              }
-              PHG4Hit* outerhit = nullptr;
-              if (_do_eval_light == false)
-                outerhit = trutheval->get_outermost_truth_hit(g4particle);
-              if (outerhit)
-              {
-                gfpx = outerhit->get_px(1);
-                gfpy = outerhit->get_py(1);
-                gfpz = outerhit->get_pz(1);
-                gfx = outerhit->get_x(1);
-                gfy = outerhit->get_y(1);
-                gfz = outerhit->get_z(1);
-              }
-
-              gembed = trutheval->get_embed(g4particle);
-              gprimary = trutheval->is_primary(g4particle);
-            }  //   if (g4particle){
-          }    //  if (g4hit) {
+            if (trutheval->get_embed(truth) <= 0) continue;
+          }
 
-          if (g4particle)
+          for (SvtxTrack::ConstClusterKeyIter iter = track->begin_cluster_keys();
+               iter != track->end_cluster_keys();
+               ++iter)
           {
-            efromtruth = clustereval->get_energy_contribution(cluster_key, g4particle);
+            keys.push_back(*iter);
+            clusters.push_back(clustermap->findCluster(*iter));
+            tracks.push_back(track);
           }
-
-          float nparticles = clustereval->all_truth_particles(cluster_key).size();
-
-          float cluster_data[] = {(float) _ievent,
-                                hitID,
-                                x,
-                                y,
-                                z,
-                                r,
-                                phi,
-                                eta,
-                                ex,
-                                ey,
-                                ez,
-                                ephi,
-                                e,
-                                adc,
-                                layer,
-                                size,
-                                phisize,
-                                zsize,
-                                trackID,
-                                g4hitID,
-                                gx,
-                                gy,
-                                gz,
-                                gr,
-                                gphi,
-                                geta,
-                                gt,
-                                gtrackID,
-                                gflavor,
-                                gpx,
-                                gpy,
-                                gpz,
-                                gvx,
-                                gvy,
-                                gvz,
-                                gvt,
-                                gfpx,
-                                gfpy,
-                                gfpz,
-                                gfx,
-                                gfy,
-                                gfz,
-                                gembed,
-                                gprimary,
-                                efromtruth,
-                                nparticles,
-                                nhit_tpc_all,
-                                nhit_tpc_in,
-                                nhit_tpc_mid,
-                                nhit_tpc_out, nclus_all, nclus_tpc, nclus_intt, nclus_maps};
-
-          _ntp_cluster->Fill(cluster_data);
         }
       }
+
+      vector<PHG4Hit*> g4hits;
+      vector<PHG4Particle*> g4particles;
+
+      EvalColumns columns(cluster_varlist);
+      columns.set_verbosity(Verbosity());
+
+      add_event_columns(columns, event_values);
+
+
+      columns.add("cluster", "hitID:x:y:z:r:phi:eta:ex:ey:ez:ephi:e:adc:layer:phisize:zsize", "",
+                  [&](const unsigned int n) {
+                    vector<float>& hitID = columns.column("hitID");
+                    vector<float>& x = columns.column("x");
+                    vector<float>& y = columns.column("y");
+                    vector<float>& z = columns.column("z");
+                    vector<float>& r = columns.column("r");
+                    vector<float>& phi = columns.column("phi");
+                    vector<float>& eta = columns.column("eta");
+                    vector<float>& ex = columns.column("ex");
+                    vector<float>& ey = columns.column("ey");
+                    vector<float>& ez = columns.column("ez");
+                    vector<float>& ephi = columns.column("ephi");
+                    vector<float>& e = columns.column("e");
+                    vector<float>& adc = columns.column("adc");
+                    vector<float>& layer = columns.column("layer");
+                    vector<float>& phisize = columns.column("phisize");
+                    vector<float>& zsize = columns.column("zsize");
+                    for (unsigned int i = 0; i < n; ++i)
+                    {
+                      const TrkrCluster* cluster = clusters[i];
+                      hitID[i] = (float) keys[i];
+                      x[i] = cluster->getX();
+                      y[i] = cluster->getY();
+                      z[i] = cluster->getZ();
+                      TVector3 pos(x[i], y[i], z[i]);
+                      r[i] = pos.Perp();
+                      phi[i] = pos.Phi();
+                      eta[i] = pos.Eta();
+                      ex[i] = sqrt(cluster->getError(0, 0));
+                      ey[i] = sqrt(cluster->getError(1, 1));
+                      ez[i] = cluster->getZError();
+                      ephi[i] = cluster->getRPhiError();
+                      e[i] = cluster->getAdc();
+                      adc[i] = cluster->getAdc();
+                      layer[i] = (float) TrkrDefs::getLayer(keys[i]);
+                      phisize[i] = cluster->getPhiSize();
+                      zsize[i] = cluster->getZSize();
+                    }
+                  });
+
+      columns.add("size", "size", "",
+                  [&](const unsigned int n) {
+                    // count all hits for this cluster
+                    vector<float>& size = columns.column("size");
+                    for (unsigned int i = 0; i < n; ++i)
+                    {
+                      TrkrClusterHitAssoc::ConstRange hitrange = clusterhitmap->getHits(keys[i]);
+                      size[i] = distance(hitrange.first, hitrange.second);
+                    }
+                  });
+
+      columns.add("track", "trackID", "",
+                  [&](const unsigned int n) {
+                    vector<float>& trackID = columns.column("trackID");
+                    for (unsigned int i = 0; i < n; ++i)
+                    {
+                      // the embedded scan knows the track of each cluster
+                      SvtxTrack* track = tracks.empty() ? trackeval->best_track_from(keys[i]) : tracks[i];
+                      if (track) trackID[i] = track->get_id();
+                    }
+                  });
+
+      columns.add("g4hit", "", "",
+                  [&](const unsigned int n) {
+                    g4hits.resize(n);
+                    for (unsigned int i = 0; i < n; ++i)
+                    {
+                      g4hits[i] = clustereval->max_truth_hit_by_energy(keys[i]);
+                    }
+                  });
+
+      columns.add("g4particle", "", "g4hit",
+                  [&](const unsigned int n) {
+                    g4particles.resize(n);
+                    for (unsigned int i = 0; i < n; ++i)
+                    {
+                      g4particles[i] = trutheval->get_particle(g4hits[i]);
+                    }
+                  });
+
+      columns.add("gcluster", "g4hitID:gx:gy:gz:gr:gphi:geta:gt", "g4hit",
+                  [&](const unsigned int n) {
+                    vector<float>& g4hitID = columns.column("g4hitID");
+                    vector<float>& gx = columns.column("gx");
+                    vector<float>& gy = columns.column("gy");
+                    vector<float>& gz = columns.column("gz");
+                    vector<float>& gr = columns.column("gr");
+                    vector<float>& gphi = columns.column("gphi");
+                    vector<float>& geta = columns.column("geta");
+                    vector<float>& gt = columns.column("gt");
+                    for (unsigned int i = 0; i < n; ++i)
+                    {
+                      if (!g4hits[i]) continue;
+                      // cluster the associated truth hits within the same layer to get the truth cluster position
+                      std::set<PHG4Hit*> truth_hits = clustereval->all_truth_hits(keys[i]);
+                      std::vector<PHG4Hit*> contributing_hits;
+                      std::vector<double> contributing_hits_energy;
+                      std::vector<std::vector<double>> contributing_hits_entry;
+                      std::vector<std::vector<double>> contributing_hits_exit;
+                      float gedep = NAN;
+                      LayerClusterG4Hits(topNode, truth_hits, contributing_hits, contributing_hits_energy, contributing_hits_entry, contributing_hits_exit, TrkrDefs::getLayer(keys[i]), gx[i], gy[i], gz[i], gt[i], gedep);
+
+                      g4hitID[i] = g4hits[i]->get_hit_id();
+                      TVector3 gpos(gx[i], gy[i], gz[i]);
+                      gr[i] = gpos.Perp();  // could also be just the center of the layer
+                      gphi[i] = gpos.Phi();
+                      geta[i] = gpos.Eta();
+                    }
+                  });
+
+      columns.add("gparticle", "gtrackID:gflavor:gpx:gpy:gpz:gvx:gvy:gvz:gvt:gembed:gprimary", "g4particle",
+                  [&](const unsigned int n) {
+                    vector<float>& gtrackID = columns.column("gtrackID");
+                    vector<float>& gflavor = columns.column("gflavor");
+                    vector<float>& gpx = columns.column("gpx");
+                    vector<float>& gpy = columns.column("gpy");
+                    vector<float>& gpz = columns.column("gpz");
+                    vector<float>& gvx = columns.column("gvx");
+                    vector<float>& gvy = columns.column("gvy");
+                    vector<float>& gvz = columns.column("gvz");
+                    vector<float>& gvt = columns.column("gvt");
+                    vector<float>& gembed = columns.column("gembed");
+                    vector<float>& gprimary = columns.column("gprimary");
+                    for (unsigned int i = 0; i < n; ++i)
+                    {
+                      PHG4Particle* g4particle = g4particles[i];
+                      if (!g4particle) continue;
+                      gtrackID[i] = g4particle->get_track_id();
+                      gflavor[i] = g4particle->get_pid();
+                      gpx[i] = g4particle->get_px();
+                      gpy[i] = g4particle->get_py();
+                      gpz[i] = g4particle->get_pz();
+
+                      PHG4VtxPoint* vtx = trutheval->get_vertex(g4particle);
+                      if (vtx)
+                      {
+                        gvx[i] = vtx->get_x();
+                        gvy[i] = vtx->get_y();
+                        gvz[i] = vtx->get_z();
+                        gvt[i] = vtx->get_t();
+                      }
+
+                      gembed[i] = trutheval->get_embed(g4particle);
+                      gprimary[i] = trutheval->is_primary(g4particle);
+                    }
+                  });
+
+      columns.add("goutermost", "gfpx:gfpy:gfpz:gfx:gfy:gfz", "g4particle",
+                  [&](const unsigned int n) {
+                    if (_do_eval_light) return;
+                    vector<float>& gfpx = columns.column("gfpx");
+                    vector<float>& gfpy = columns.column("gfpy");
+                    vector<float>& gfpz = columns.column("gfpz");
+                    vector<float>& gfx = columns.column("gfx");
+                    vector<float>& gfy = columns.column("gfy");
+                    vector<float>& gfz = columns.column("gfz");
+                    for (unsigned int i = 0; i < n; ++i)
+                    {
+                      if (!g4particles[i]) continue;
+                      PHG4Hit* outerhit = trutheval->get_outermost_truth_hit(g4particles[i]);
+                      if (!outerhit) continue;
+                      gfpx[i] = outerhit->get_px(1);
+                      gfpy[i] = outerhit->get_py(1);
+                      gfpz[i] = outerhit->get_pz(1);
+                      gfx[i] = outerhit->get_x(1);
+                      gfy[i] = outerhit->get_y(1);
+                      gfz[i] = outerhit->get_z(1);
+                    }
+                  });
+
+      columns.add("efromtruth", "efromtruth", "g4particle",
+                  [&](const unsigned int n) {
+                    vector<float>& efromtruth = columns.column("efromtruth");
+                    for (unsigned int i = 0; i < n; ++i)
+                    {
+                      if (g4particles[i]) efromtruth[i] = clustereval->get_energy_contribution(keys[i], g4particles[i]);
+                    }
+                  });
+
+      columns.add("nparticles", "nparticles", "",
+                  [&](const unsigned int n) {
+                    vector<float>& nparticles = columns.column("nparticles");
+                    for (unsigned int i = 0; i < n; ++i)
+                    {
+                      nparticles[i] = clustereval->all_truth_particles(keys[i]).size();
+                    }
+                  });
+
+      columns.evaluate(_ntp_cluster, keys.size());
     }
   }
   if (Verbosity() >= 1)
@@ -1928,198 +1916,204 @@ void SvtxEvaluator::fillOutputNtuples(PHCompositeNode* topNode)
     _timer->restart();
   }
 
-  if (_ntp_g4cluster)
+  if (_ntp_g4cluster && !_ntp_g4cluster->empty())
     {
       if (Verbosity() > 0) cout << "Filling ntp_g4cluster " << endl;
 
       TrkrClusterContainer* clustermap = findNode::getClass<TrkrClusterContainer>(topNode, "TRKR_CLUSTER");
-      
-      PHG4TruthInfoContainer* truthinfo = findNode::getClass<PHG4TruthInfoContainer>(topNode, "G4TruthInfo");      
+
+      // one row per particle and layer with truth energy, the truth hits of the
+      // particle are clustered per layer to find the rows
+      struct G4ClusterRow
+      {
+        PHG4Particle* g4particle;
+        unsigned int layer;
+        float gx;
+        float gy;
+        float gz;
+        float gt;
+        float gedep;
+        std::vector<PHG4Hit*> contributing_hits;
+        std::vector<std::vector<double>> contributing_hits_entry;
+        std::vector<std::vector<double>> contributing_hits_exit;
+      };
+      vector<G4ClusterRow> rows;
+
+      PHG4TruthInfoContainer* truthinfo = findNode::getClass<PHG4TruthInfoContainer>(topNode, "G4TruthInfo");
       PHG4TruthInfoContainer::ConstRange range = truthinfo->GetParticleRange();
       for (PHG4TruthInfoContainer::ConstIterator iter = range.first;
            iter != range.second;
            ++iter)
 	{
-	  
+
 	  PHG4Particle* g4particle = iter->second;
-	  
+
 	  if (_scan_for_embedded)
 	    {
 	      if (trutheval->get_embed(g4particle) <= 0) continue;
 	    }
-	  
-	  float gtrackID = g4particle->get_track_id();
-	  float gflavor = g4particle->get_pid();
-	  
+
 	  std::set<PHG4Hit*> g4hits = trutheval->all_truth_hits(g4particle);
-	  
+
 	  float ng4hits = g4hits.size();
 
 	  if(ng4hits == 0)  continue;
 
 	  if(Verbosity() > 0)
-	    cout << " ntp_g4cluster: gtrackID " << gtrackID << " gflavor " << gflavor << " ng4hits " << ng4hits << endl;
+	    cout << " ntp_g4cluster: gtrackID " << g4particle->get_track_id() << " gflavor " << g4particle->get_pid() << " ng4hits " << ng4hits << endl;
 
 	  // convert truth hits for this particle to truth clusters in each TPC layer
 
 	  // loop over layers
 	  for(float layer = 0; layer < _nlayers_maps + _nlayers_intt + _nlayers_tpc; ++layer)
 	    {
-	      float gx = NAN;
-	      float gy = NAN;
-	      float gz = NAN;
-	      float gt = NAN;
-	      float gedep = NAN;
+	      G4ClusterRow row;
+	      row.g4particle = g4particle;
+	      row.layer = layer;
+	      row.gx = NAN;
+	      row.gy = NAN;
+	      row.gz = NAN;
+	      row.gt = NAN;
+	      row.gedep = NAN;
 
-	      std::vector<PHG4Hit*> contributing_hits;
 	      std::vector<double> contributing_hits_energy;
-	      std::vector<std::vector<double>> contributing_hits_entry;
-	      std::vector<std::vector<double>> contributing_hits_exit;
-	      LayerClusterG4Hits(topNode, g4hits, contributing_hits, contributing_hits_energy, contributing_hits_entry, contributing_hits_exit, layer, gx, gy, gz, gt, gedep);
-	      if(!(gedep > 0)) continue;
- 
-	      float gr = NAN;
-	      float gphi = NAN;
-	      float geta = NAN;
-
-	      TVector3 gpos(gx, gy, gz);
-	      gr = sqrt(gx*gx+gy*gy);
-	      gphi = gpos.Phi();
-	      geta = gpos.Eta();
-	      
-	      float gembed = NAN;
-	      gembed = trutheval->get_embed(g4particle);
-	      float gprimary = NAN;
-              gprimary = trutheval->is_primary(g4particle);
+	      LayerClusterG4Hits(topNode, g4hits, row.contributing_hits, contributing_hits_energy, row.contributing_hits_entry, row.contributing_hits_exit, layer, row.gx, row.gy, row.gz, row.gt, row.gedep);
+	      if(!(row.gedep > 0)) continue;
 
 	      if(Verbosity() > 0)
-		cout << "layer " << layer << " gr " << gr << " gx " << gx << " gy " << gy << " gz " << gz << " gedep " << gedep << endl; 
-
-	      // Estimate the size of the truth cluster
-	      float g4phisize = NAN;
-	      float g4zsize = NAN;
-	      G4ClusterSize( topNode, layer, contributing_hits_entry, contributing_hits_exit, g4phisize, g4zsize);
-
-	      // Find the matching TrkrCluster, if it exists
-	      float x = NAN;
-	      float y = NAN;
-	      float z = NAN;
-	      float r = NAN;
-	      float phi = NAN;
-	      float eta = NAN;
-	      float ex = NAN;
-	      float ey = NAN;
-	      float ez = NAN;
-	      float ephi = NAN;
-	      float phisize = NAN;
-	      float zsize = NAN;
-	      float adc = NAN;
-
-	      TrkrDefs::cluskey reco_cluskey = 0;
-
-	      // loop over all conteributing hits, look up the associated clusters, pick the one in this layer.
-	      for(unsigned int i=0; i< contributing_hits.size(); ++i)
-		{
-
-		  PHG4Hit* cont_g4hit = contributing_hits[i];
-		  double energy = contributing_hits_energy[i];
-
-		  std::set<TrkrDefs::cluskey> clusters = clustereval->all_clusters_from(cont_g4hit);  // this returns clusters from this hit in any layer
-		  float nclusters = clusters.size();
-		  if(Verbosity() > 0)
-		    cout << "       contributing g4hitID " << cont_g4hit->get_hit_id() << " nclusters " << nclusters << " energy " << energy << endl;
+		cout << "layer " << layer << " gx " << row.gx << " gy " << row.gy << " gz " << row.gz << " gedep " << row.gedep << endl;
 
-		  for (std::set<TrkrDefs::cluskey>::iterator iter = clusters.begin();
-		       iter != clusters.end();
-		       ++iter)
-		    {
-		      TrkrDefs::cluskey this_cluskey = *iter;
-		      unsigned int clus_layer = TrkrDefs::getLayer(this_cluskey);
-		      if(clus_layer != layer)  continue;
-
-		      if(Verbosity() > 0)
-			cout << "             associated: this_cluskey " << this_cluskey << " clus_layer " << clus_layer << endl;
-
-		      // For now, we assume only one reco cluster matches, if there are multiple matches, keep the last one
-		      // In future, can make a list of clusters matching this g4cluster 
-		      reco_cluskey = this_cluskey;
-		    }
-		}
-
-	      if(reco_cluskey)
-		{
-		  TrkrCluster* cluster = clustermap->findCluster(reco_cluskey);
-		  
-		  x = cluster->getX();
-		  y = cluster->getY();
-		  z = cluster->getZ();
-
-		  TVector3 pos(x, y, z);
-		  r = sqrt(x*x+y*y);
-		  phi = pos.Phi();
-		  eta = pos.Eta();
-
-		  ex = sqrt(cluster->getError(0, 0));
-		  ey = sqrt(cluster->getError(1, 1));
-		  ez = cluster->getZError();		  
-		  ephi = cluster->getRPhiError();
-
-		  phisize = cluster->getPhiSize();  
-		  zsize = cluster->getZSize();   
-		  
-		  adc = cluster->getAdc();
-
-		  if(Verbosity() > 0)
-		    cout << "             reco cluster r " << r << " x " << x << " y " << y << " z " << z << " phisize " << phisize << " zsize " << zsize << endl;
-
-		}
-
-	      // add this cluster to the ntuple
-
-	      float g4cluster_data[] = {(float) _ievent,
-					layer,
-					gx,
-					gy,
-					gz,
-					gt,
-					gedep,
-					gr,
-					gphi,
-					geta,
-					gtrackID,
-					gflavor,
-					gembed,
-					gprimary,
-					g4phisize,
-					g4zsize,
-					x,
-					y,
-					z,
-					r,
-					phi,
-					eta,
-					ex,
-					ey,
-					ez,
-					ephi,
-					phisize,
-					zsize,
-					adc };
-	      _ntp_g4cluster->Fill(g4cluster_data);
+	      rows.push_back(row);
 	    }
 	}
+
+      vector<TrkrCluster*> clusters;
+
+      EvalColumns columns(g4cluster_varlist);
+      columns.set_verbosity(Verbosity());
+
+      columns.add("event", "event", "",
+                  [&](const unsigned int n) {
+                    columns.column("event").assign(n, _ievent);
+                  });
+
+      columns.add("gcluster", "layer:gx:gy:gz:gt:gedep:gr:gphi:geta:gtrackID:gflavor:gembed:gprimary", "",
+                  [&](const unsigned int n) {
+                    vector<float>& layer = columns.column("layer");
+                    vector<float>& gx = columns.column("gx");
+                    vector<float>& gy = columns.column("gy");
+                    vector<float>& gz = columns.column("gz");
+                    vector<float>& gt = columns.column("gt");
+                    vector<float>& gedep = columns.column("gedep");
+                    vector<float>& gr = columns.column("gr");
+                    vector<float>& gphi = columns.column("gphi");
+                    vector<float>& geta = columns.column("geta");
+                    vector<float>& gtrackID = columns.column("gtrackID");
+                    vector<float>& gflavor = columns.column("gflavor");
+                    vector<float>& gembed = columns.column("gembed");
+                    vector<float>& gprimary = columns.column("gprimary");
+                    for (unsigned int i = 0; i < n; ++i)
+                    {
+                      const G4ClusterRow& row = rows[i];
+                      layer[i] = row.layer;
+                      gx[i] = row.gx;
+                      gy[i] = row.gy;
+                      gz[i] = row.gz;
+                      gt[i] = row.gt;
+                      gedep[i] = row.gedep;
+                      TVector3 gpos(row.gx, row.gy, row.gz);
+                      gr[i] = sqrt(row.gx * row.gx + row.gy * row.gy);
+                      gphi[i] = gpos.Phi();
+                      geta[i] = gpos.Eta();
+                      gtrackID[i] = row.g4particle->get_track_id();
+                      gflavor[i] = row.g4particle->get_pid();
+                      gembed[i] = trutheval->get_embed(row.g4particle);
+                      gprimary[i] = trutheval->is_primary(row.g4particle);
+                    }
+                  });
+
+      columns.add("gsize", "g4phisize:g4zsize", "",
+                  [&](const unsigned int n) {
+                    // Estimate the size of the truth cluster
+                    vector<float>& g4phisize = columns.column("g4phisize");
+                    vector<float>& g4zsize = columns.column("g4zsize");
+                    for (unsigned int i = 0; i < n; ++i)
+                    {
+                      G4ClusterSize(topNode, rows[i].layer, rows[i].contributing_hits_entry, rows[i].contributing_hits_exit, g4phisize[i], g4zsize[i]);
+                    }
+                  });
+
+      columns.add("cluster", "", "",
+                  [&](const unsigned int n) {
+                    // Find the matching TrkrCluster, if it exists
+                    clusters.assign(n, nullptr);
+                    for (unsigned int i = 0; i < n; ++i)
+                    {
+                      TrkrDefs::cluskey reco_cluskey = 0;
+
+                      // loop over all contributing hits, look up the associated clusters, pick the one in this layer.
+                      for (PHG4Hit* cont_g4hit : rows[i].contributing_hits)
+                      {
+                        std::set<TrkrDefs::cluskey> hit_clusters = clustereval->all_clusters_from(cont_g4hit);  // this returns clusters from this hit in any layer
+                        for (const TrkrDefs::cluskey this_cluskey : hit_clusters)
+                        {
+                          if (TrkrDefs::getLayer(this_cluskey) != rows[i].layer) continue;
+
+                          // For now, we assume only one reco cluster matches, if there are multiple matches, keep the last one
+                          // In future, can make a list of clusters matching this g4cluster
+                          reco_cluskey = this_cluskey;
+                        }
+                      }
+                      if (reco_cluskey) clusters[i] = clustermap->findCluster(reco_cluskey);
+                    }
+                  });
+
+      columns.add("reco", "x:y:z:r:phi:eta:ex:ey:ez:ephi:phisize:zsize:adc", "cluster",
+                  [&](const unsigned int n) {
+                    vector<float>& x = columns.column("x");
+                    vector<float>& y = columns.column("y");
+                    vector<float>& z = columns.column("z");
+                    vector<float>& r = columns.column("r");
+                    vector<float>& phi = columns.column("phi");
+                    vector<float>& eta = columns.column("eta");
+                    vector<float>& ex = columns.column("ex");
+                    vector<float>& ey = columns.column("ey");
+                    vector<float>& ez = columns.column("ez");
+                    vector<float>& ephi = columns.column("ephi");
+                    vector<float>& phisize = columns.column("phisize");
+                    vector<float>& zsize = columns.column("zsize");
+                    vector<float>& adc = columns.column("adc");
+                    for (unsigned int i = 0; i < n; ++i)
+                    {
+                      TrkrCluster* cluster = clusters[i];
+                      if (!cluster) continue;
+                      x[i] = cluster->getX();
+                      y[i] = cluster->getY();
+                      z[i] = cluster->getZ();
+                      TVector3 pos(x[i], y[i], z[i]);
+                      r[i] = sqrt(x[i] * x[i] + y[i] * y[i]);
+                      phi[i] = pos.Phi();
+                      eta[i] = pos.Eta();
+                      ex[i] = sqrt(cluster->getError(0, 0));
+                      ey[i] = sqrt(cluster->getError(1, 1));
+                      ez[i] = cluster->getZError();
+                      ephi[i] = cluster->getRPhiError();
+                      phisize[i] = cluster->getPhiSize();
+                      zsize[i] = cluster->getZSize();
+                      adc[i] = cluster->getAdc();
+                    }
+                  });
+
+      columns.evaluate(_ntp_g4cluster, rows.size());
     }
-  
+
   //------------------------
   // fill the Gtrack NTuple
   //------------------------
-  
+
   // need things off of the DST...
-  
-  //cout << "check for ntp_gtrack" << endl;
-  
-  //#ifdef FUCKER
-  if (_ntp_gtrack)
+
+  if (_ntp_gtrack && !_ntp_gtrack->empty())
   {
     if (Verbosity() > 0)
     {
@@ -2130,416 +2124,194 @@ void SvtxEvaluator::fillOutputNtuples(PHCompositeNode* topNode)
     PHG4TruthInfoContainer* truthinfo = findNode::getClass<PHG4TruthInfoContainer>(topNode, "G4TruthInfo");
     if (truthinfo)
     {
+      // one row per primary particle
+      vector<PHG4Particle*> g4particles;
       PHG4TruthInfoContainer::ConstRange range = truthinfo->GetPrimaryParticleRange();
-      Float_t gntracks = (Float_t) truthinfo->GetNumPrimaryVertexParticles();
       for (PHG4TruthInfoContainer::ConstIterator iter = range.first;
            iter != range.second;
            ++iter)
       {
-
         PHG4Particle* g4particle = iter->second;
 
         if (_scan_for_embedded)
         {
           if (trutheval->get_embed(g4particle) <= 0) continue;
         }
-
-        float gtrackID = g4particle->get_track_id();
-        float gflavor = g4particle->get_pid();
-
-        std::set<TrkrDefs::cluskey> g4clusters = clustereval->all_clusters_from(g4particle);
-
-        float ng4hits = g4clusters.size();
-        unsigned int ngmaps = 0;
-        unsigned int ngintt = 0;
-        unsigned int ngintt1 = 0;
-        unsigned int ngintt2 = 0;
-        unsigned int ngintt3 = 0;
-        unsigned int ngintt4 = 0;
-        unsigned int ngintt5 = 0;
-        unsigned int ngintt6 = 0;
-        unsigned int ngintt7 = 0;
-        unsigned int ngintt8 = 0;
-        unsigned int ngtpc = 0;
-        unsigned int nglmaps = 0;
-        unsigned int nglintt = 0;
-        unsigned int ngltpc = 0;
-
-        int lmaps[_nlayers_maps + 1];
-        if (_nlayers_maps > 0)
-          for (unsigned int i = 0; i < _nlayers_maps; i++) lmaps[i] = 0;
-
-        int lintt[_nlayers_intt + 1];
-        if (_nlayers_intt > 0)
-          for (unsigned int i = 0; i < _nlayers_intt; i++) lintt[i] = 0;
-
-        int ltpc[_nlayers_tpc + 1];
-        if (_nlayers_tpc > 0)
-          for (unsigned int i = 0; i < _nlayers_tpc; i++) ltpc[i] = 0;
-
-        for (const TrkrDefs::cluskey g4cluster : g4clusters)
-        {
-          unsigned int layer = TrkrDefs::getLayer(g4cluster);
-          //cout<<__LINE__<<": " << _ievent <<": " <<gtrackID << ": " << layer <<": " <<g4cluster->get_id() <<endl;
-          if (_nlayers_maps > 0 && layer < _nlayers_maps)
-          {
-            lmaps[layer] = 1;
-            ngmaps++;
-          }
-
-          if (_nlayers_intt > 0 && layer >= _nlayers_maps && layer < _nlayers_maps + _nlayers_intt)
-          {
-            lintt[layer - _nlayers_maps] = 1;
-            ngintt++;
-          }
-
-          if (_nlayers_intt > 0 && layer == _nlayers_maps && layer < _nlayers_maps + _nlayers_intt)
-          {
-            ngintt1++;
-          }
-
-          if (_nlayers_intt > 1 && layer == _nlayers_maps + 1 && layer < _nlayers_maps + _nlayers_intt)
-          {
-            ngintt2++;
-          }
-
-          if (_nlayers_intt > 2 && layer == _nlayers_maps + 2 && layer < _nlayers_maps + _nlayers_intt)
-          {
-            ngintt3++;
-          }
-
-          if (_nlayers_intt > 3 && layer == _nlayers_maps + 3 && layer < _nlayers_maps + _nlayers_intt)
-          {
-            ngintt4++;
-          }
-
-          if (_nlayers_intt > 4 && layer == _nlayers_maps + 4 && layer < _nlayers_maps + _nlayers_intt)
-          {
-            ngintt5++;
-          }
-
-          if (_nlayers_intt > 5 && layer == _nlayers_maps + 5 && layer < _nlayers_maps + _nlayers_intt)
-          {
-            ngintt6++;
-          }
-
-          if (_nlayers_intt > 6 && layer == _nlayers_maps + 6 && layer < _nlayers_maps + _nlayers_intt)
-          {
-            ngintt7++;
-          }
-
-          if (_nlayers_intt > 7 && layer == _nlayers_maps + 7 && layer < _nlayers_maps + _nlayers_intt)
-          {
-            ngintt8++;
-          }
-          if (_nlayers_tpc > 0 && layer >= _nlayers_maps + _nlayers_intt && layer < _nlayers_maps + _nlayers_intt + _nlayers_tpc)
-          {
-            ltpc[layer - (_nlayers_maps + _nlayers_intt)] = 1;
-            ngtpc++;
-          }
-        }
-        if (_nlayers_maps > 0)
-          for (unsigned int i = 0; i < _nlayers_maps; i++) nglmaps += lmaps[i];
-        if (_nlayers_intt > 0)
-          for (unsigned int i = 0; i < _nlayers_intt; i++) nglintt += lintt[i];
-        if (_nlayers_tpc > 0)
-          for (unsigned int i = 0; i < _nlayers_tpc; i++) ngltpc += ltpc[i];
-
-        float gpx = g4particle->get_px();
-        float gpy = g4particle->get_py();
-        float gpz = g4particle->get_pz();
-        float gpt = NAN;
-        float geta = NAN;
-        float gphi = NAN;
-        if (gpx != 0 && gpy != 0)
-        {
-          TVector3 gv(gpx, gpy, gpz);
-          gpt = gv.Pt();
-          geta = gv.Eta();
-          gphi = gv.Phi();
-        }
-        PHG4VtxPoint* vtx = trutheval->get_vertex(g4particle);
-        float gvx = vtx->get_x();
-        float gvy = vtx->get_y();
-        float gvz = vtx->get_z();
-        float gvt = vtx->get_t();
-
-        float gfpx = 0.;
-        float gfpy = 0.;
-        float gfpz = 0.;
-        float gfx = 0.;
-        float gfy = 0.;
-        float gfz = 0.;
-
-        PHG4Hit* outerhit = nullptr;
-        if (_do_eval_light == false)
-          outerhit = trutheval->get_outermost_truth_hit(g4particle);
-
-        if (outerhit)
-        {
-          gfpx = outerhit->get_px(1);
-          gfpy = outerhit->get_py(1);
-          gfpz = outerhit->get_pz(1);
-          gfx = outerhit->get_x(1);
-          gfy = outerhit->get_y(1);
-          gfz = outerhit->get_z(1);
-        }
-
-        float gembed = trutheval->get_embed(g4particle);
-        float gprimary = trutheval->is_primary(g4particle);
-
-        float trackID = NAN;
-        float charge = NAN;
-        float quality = NAN;
-        float chisq = NAN;
-        float ndf = NAN;
-        float nhits = NAN;
-        float nmaps = 0;
-        float nintt = 0;
-        float ntpc = 0;
-        float nlintt = 0;
-        float nlmaps = 0;
-        float nltpc = 0;
-        unsigned int layers = 0x0;
-        float dca2d = NAN;
-        float dca2dsigma = NAN;
-        float dca3dxy = NAN;
-        float dca3dxysigma = NAN;
-        float dca3dz = NAN;
-        float dca3dzsigma = NAN;
-        float px = NAN;
-        float py = NAN;
-        float pz = NAN;
-        float pt = NAN;
-        float eta = NAN;
-        float phi = NAN;
-	float deltapt = NAN;
-	float deltaeta = NAN;
-	float deltaphi = NAN;
-        float pcax = NAN;
-        float pcay = NAN;
-        float pcaz = NAN;
-
-        float nfromtruth = NAN;
-        float nwrong = NAN;
-        float ntrumaps = NAN;
-        float ntruintt = NAN;
-        float ntrutpc = NAN;
-        float layersfromtruth = NAN;
-
-        if (_do_track_match)
-        {
-          SvtxTrack* track = trackeval->best_track_from(g4particle);
-
-          if (track)
-          {
-            trackID = track->get_id();
-            charge =  track->get_charge();
-            quality = track->get_quality();
-            chisq =   track->get_chisq();
-            ndf =     track->get_ndf();
-            nhits =   track->size_cluster_keys();
-
-            int maps[_nlayers_maps];
-            int intt[_nlayers_intt];
-            int tpc[_nlayers_tpc];
-
-            if (_nlayers_maps > 0)
-            {
-              for (unsigned int i = 0; i < _nlayers_maps; i++) maps[i] = 0;
-            }
-            if (_nlayers_intt > 0)
-            {
-              for (unsigned int i = 0; i < _nlayers_intt; i++) intt[i] = 0;
-            }
-            if (_nlayers_tpc > 0)
-            {
-              for (unsigned int i = 0; i < _nlayers_tpc; i++) tpc[i] = 0;
-            }
-
-            for (SvtxTrack::ConstClusterKeyIter iter = track->begin_cluster_keys();
-                 iter != track->end_cluster_keys();
-                 ++iter)
-            {
-	      TrkrDefs::cluskey cluster_key = *iter;
-              //TrkrCluster* cluster = clustermap->findCluster(cluster_key);
-              unsigned int layer = TrkrDefs::getLayer(cluster_key);
-              if (_nlayers_maps > 0 && layer < _nlayers_maps)
-              {
-                maps[layer] = 1;
-                nmaps++;
-              }
-              if (_nlayers_intt > 0 && layer >= _nlayers_maps && layer < _nlayers_maps + _nlayers_intt)
-              {
-                intt[layer - _nlayers_maps] = 1;
-                nintt++;
-              }
-              if (_nlayers_tpc > 0 &&
-                  layer >= (_nlayers_maps + _nlayers_intt) &&
-                  layer < (_nlayers_maps + _nlayers_intt + _nlayers_tpc))
-              {
-                tpc[layer - (_nlayers_maps + _nlayers_intt)] = 1;
-                ntpc++;
-              }
-            }
-            if (_nlayers_maps > 0)
-              for (unsigned int i = 0; i < _nlayers_maps; i++) nlmaps += maps[i];
-            if (_nlayers_intt > 0)
-              for (unsigned int i = 0; i < _nlayers_intt; i++) nlintt += intt[i];
-            if (_nlayers_tpc > 0)
-              for (unsigned int i = 0; i < _nlayers_tpc; i++) nltpc += tpc[i];
-
-            layers = nlmaps + nlintt + nltpc;
-	    /* cout << " layers " << layers 
-		 << " nmaps " << nmaps 
-		 << " nintt " << nintt 
-		 << " ntpc  " << ntpc 
-		 << " nlmaps "<< nlmaps  
-		 << " nlintt " << nlintt 
-		 << " nltpc  " << nltpc
-		 << endl;
-	    */
-            dca2d = track->get_dca2d();
-            dca2dsigma = track->get_dca2d_error();
-            dca3dxy = track->get_dca3d_xy();
-            dca3dxysigma = track->get_dca3d_xy_error();
-            dca3dz = track->get_dca3d_z();
-            dca3dzsigma = track->get_dca3d_z_error();
-            px = track->get_px();
-            py = track->get_py();
-            pz = track->get_pz();
-            TVector3 v(px, py, pz);
-            pt = v.Pt();
-            eta = v.Eta();
-            phi = v.Phi();
-	    float CVxx = track->get_error(3,3);
-	    float CVxy = track->get_error(3,4);
-	    float CVxz = track->get_error(3,5);
-	    float CVyy = track->get_error(4,4);
-	    float CVyz = track->get_error(4,5);
-	    float CVzz = track->get_error(5,5);
-	    deltapt = sqrt((CVxx*px*px+2*CVxy*px*py+CVyy*py*py)/(px*px+py*py));
-	    deltaeta = sqrt((CVzz*(px*px+py*py)*(px*px+py*py)+pz*(-2*(CVxz*px+CVyz*py)*(px*px+py*py)+CVxx*px*px*pz+CVyy*py*py*pz+2*CVxy*px*py*pz))/((px*px+py*py)*(px*px+py*py)*(px*px+py*py+pz*pz)));
-	    deltaphi = sqrt((CVyy*px*px-2*CVxy*px*py+CVxx*py*py)/((px*px+py*py)*(px*px+py*py)));
-            pcax = track->get_x();
-            pcay = track->get_y();
-            pcaz = track->get_z();
-
-            nfromtruth = trackeval->get_nclusters_contribution(track, g4particle);
-            nwrong = trackeval->get_nwrongclusters_contribution(track, g4particle);
-
-            if (_nlayers_maps == 0)
-            {
-              ntrumaps = 0;
-            }
-            else
-            {
-              ntrumaps = trackeval->get_layer_range_contribution(track, g4particle, 0, _nlayers_maps);
-            }
-            if (_nlayers_intt == 0)
-            {
-              ntruintt = 0;
-            }
-            else
-            {
-              ntruintt = trackeval->get_layer_range_contribution(track, g4particle, _nlayers_maps, _nlayers_maps + _nlayers_intt);
-            }
-            ntrutpc = trackeval->get_layer_range_contribution(track, g4particle, _nlayers_maps + _nlayers_intt, _nlayers_maps + _nlayers_intt + _nlayers_tpc);
-
-            layersfromtruth = trackeval->get_nclusters_contribution_by_layer(track, g4particle);
-          }
-        }
-	float gtrack_data[] = {(float) _ievent,
-                               gntracks,
-                               gtrackID,
-                               gflavor,
-                               ng4hits,
-                               (float) ngmaps,
-                               (float) ngintt,
-                               (float) ngintt1,
-                               (float) ngintt2,
-                               (float) ngintt3,
-                               (float) ngintt4,
-                               (float) ngintt5,
-                               (float) ngintt6,
-                               (float) ngintt7,
-                               (float) ngintt8,
-                               (float) ngtpc,
-                               (float) nglmaps,
-                               (float) nglintt,
-                               (float) ngltpc,
-                               gpx,
-                               gpy,
-                               gpz,
-                               gpt,
-                               geta,
-                               gphi,
-                               gvx,
-                               gvy,
-                               gvz,
-                               gvt,
-                               gfpx,
-                               gfpy,
-                               gfpz,
-                               gfx,
-                               gfy,
-                               gfz,
-                               gembed,
-                               gprimary,
-                               trackID,
-                               px,
-                               py,
-                               pz,
-                               pt,
-                               eta,
-                               phi,
-			       deltapt,
-			       deltaeta,
-			       deltaphi,
-                               charge,
-                               quality,
-                               chisq,
-                               ndf,
-                               nhits,
-                               (float) layers,
-                               nmaps,
-                               nintt,
-                               ntpc,
-                               nlmaps,
-                               nlintt,
-                               nltpc,
-                               dca2d,
-                               dca2dsigma,
-                               dca3dxy,
-                               dca3dxysigma,
-                               dca3dz,
-                               dca3dzsigma,
-                               pcax,
-                               pcay,
-                               pcaz,
-                               nfromtruth,
-                               nwrong,
-                               ntrumaps,
-                               ntruintt,
-                               ntrutpc,
-                               layersfromtruth,
-                               nhit_tpc_all,
-                               nhit_tpc_in,
-                               nhit_tpc_mid,
-                               nhit_tpc_out, nclus_all, nclus_tpc, nclus_intt, nclus_maps};
-
-        /*
-	cout << " ievent " << _ievent
-	     << " gtrackID " << gtrackID
-	     << " gflavor " << gflavor
-	     << " ng4hits " << ng4hits
-	     << endl;
-	*/
-
-        _ntp_gtrack->Fill(gtrack_data);
-
+        g4particles.push_back(g4particle);
       }
 
+      vector<SvtxTrack*> tracks;
+
+      EvalColumns columns(gtrack_varlist);
+      columns.set_verbosity(Verbosity());
+
+      add_event_columns(columns, event_values);
+
+      columns.add("gparticle", "gntracks:gtrackID:gflavor:gpx:gpy:gpz:gpt:geta:gphi:gvx:gvy:gvz:gvt:gembed:gprimary", "",
+                  [&](const unsigned int n) {
+                    columns.column("gntracks").assign(n, truthinfo->GetNumPrimaryVertexParticles());
+                    vector<float>& gtrackID = columns.column("gtrackID");
+                    vector<float>& gflavor = columns.column("gflavor");
+                    vector<float>& gpx = columns.column("gpx");
+                    vector<float>& gpy = columns.column("gpy");
+                    vector<float>& gpz = columns.column("gpz");
+                    vector<float>& gpt = columns.column("gpt");
+                    vector<float>& geta = columns.column("geta");
+                    vector<float>& gphi = columns.column("gphi");
+                    vector<float>& gvx = columns.column("gvx");
+                    vector<float>& gvy = columns.column("gvy");
+                    vector<float>& gvz = columns.column("gvz");
+                    vector<float>& gvt = columns.column("gvt");
+                    vector<float>& gembed = columns.column("gembed");
+                    vector<float>& gprimary = columns.column("gprimary");
+                    for (unsigned int i = 0; i < n; ++i)
+                    {
+                      PHG4Particle* g4particle = g4particles[i];
+                      gtrackID[i] = g4particle->get_track_id();
+                      gflavor[i] = g4particle->get_pid();
+                      gpx[i] = g4particle->get_px();
+                      gpy[i] = g4particle->get_py();
+                      gpz[i] = g4particle->get_pz();
+                      if (gpx[i] != 0 && gpy[i] != 0)
+                      {
+                        TVector3 gv(gpx[i], gpy[i], gpz[i]);
+                        gpt[i] = gv.Pt();
+                        geta[i] = gv.Eta();
+                        gphi[i] = gv.Phi();
+                      }
+                      PHG4VtxPoint* vtx = trutheval->get_vertex(g4particle);
+                      gvx[i] = vtx->get_x();
+                      gvy[i] = vtx->get_y();
+                      gvz[i] = vtx->get_z();
+                      gvt[i] = vtx->get_t();
+
+                      gembed[i] = trutheval->get_embed(g4particle);
+                      gprimary[i] = trutheval->is_primary(g4particle);
+                    }
+                  });
+
+      columns.add("gclusters", "gnhits:gnmaps:gnintt:gnintt1:gnintt2:gnintt3:gnintt4:gnintt5:gnintt6:gnintt7:gnintt8:gntpc:gnlmaps:gnlintt:gnltpc", "",
+                  [&](const unsigned int n) {
+                    vector<float>& ng4hits = columns.column("gnhits");
+                    vector<float>& ngmaps = columns.column("gnmaps");
+                    vector<float>& ngintt = columns.column("gnintt");
+                    vector<float>& ngtpc = columns.column("gntpc");
+                    vector<float>& nglmaps = columns.column("gnlmaps");
+                    vector<float>& nglintt = columns.column("gnlintt");
+                    vector<float>& ngltpc = columns.column("gnltpc");
+                    vector<float>* ngintt_layer[8];
+                    for (unsigned int j = 0; j < 8; ++j)
+                    {
+                      ngintt_layer[j] = &columns.column("gnintt" + to_string(j + 1));
+                    }
+                    for (unsigned int i = 0; i < n; ++i)
+                    {
+                      std::set<TrkrDefs::cluskey> g4clusters = clustereval->all_clusters_from(g4particles[i]);
+
+                      ng4hits[i] = g4clusters.size();
+                      ngmaps[i] = 0;
+                      ngintt[i] = 0;
+                      ngtpc[i] = 0;
+                      nglmaps[i] = 0;
+                      nglintt[i] = 0;
+                      ngltpc[i] = 0;
+                      for (unsigned int j = 0; j < 8; ++j)
+                      {
+                        (*ngintt_layer[j])[i] = 0;
+                      }
+
+                      int lmaps[_nlayers_maps + 1];
+                      if (_nlayers_maps > 0)
+                        for (unsigned int j = 0; j < _nlayers_maps; j++) lmaps[j] = 0;
+
+                      int lintt[_nlayers_intt + 1];
+                      if (_nlayers_intt > 0)
+                        for (unsigned int j = 0; j < _nlayers_intt; j++) lintt[j] = 0;
+
+                      int ltpc[_nlayers_tpc + 1];
+                      if (_nlayers_tpc > 0)
+                        for (unsigned int j = 0; j < _nlayers_tpc; j++) ltpc[j] = 0;
+
+                      for (const TrkrDefs::cluskey g4cluster : g4clusters)
+                      {
+                        unsigned int layer = TrkrDefs::getLayer(g4cluster);
+                        if (_nlayers_maps > 0 && layer < _nlayers_maps)
+                        {
+                          lmaps[layer] = 1;
+                          ngmaps[i]++;
+                        }
+
+                        if (_nlayers_intt > 0 && layer >= _nlayers_maps && layer < _nlayers_maps + _nlayers_intt)
+                        {
+                          lintt[layer - _nlayers_maps] = 1;
+                          ngintt[i]++;
+                          // per intt layer, the first eight
+                          if (layer - _nlayers_maps < 8) (*ngintt_layer[layer - _nlayers_maps])[i]++;
+                        }
+
+                        if (_nlayers_tpc > 0 && layer >= _nlayers_maps + _nlayers_intt && layer < _nlayers_maps + _nlayers_intt + _nlayers_tpc)
+                        {
+                          ltpc[layer - (_nlayers_maps + _nlayers_intt)] = 1;
+                          ngtpc[i]++;
+                        }
+                      }
+                      if (_nlayers_maps > 0)
+                        for (unsigned int j = 0; j < _nlayers_maps; j++) nglmaps[i] += lmaps[j];
+                      if (_nlayers_intt > 0)
+                        for (unsigned int j = 0; j < _nlayers_intt; j++) nglintt[i] += lintt[j];
+                      if (_nlayers_tpc > 0)
+                        for (unsigned int j = 0; j < _nlayers_tpc; j++) ngltpc[i] += ltpc[j];
+                    }
+                  });
+
+      columns.add("goutermost", "gfpx:gfpy:gfpz:gfx:gfy:gfz", "",
+                  [&](const unsigned int n) {
+                    const char* names[] = {"gfpx", "gfpy", "gfpz", "gfx", "gfy", "gfz"};
+                    for (unsigned int j = 0; j < 6; ++j) columns.column(names[j]).assign(n, 0.);
+                    if (_do_eval_light) return;
+                    vector<float>& gfpx = columns.column("gfpx");
+                    vector<float>& gfpy = columns.column("gfpy");
+                    vector<float>& gfpz = columns.column("gfpz");
+                    vector<float>& gfx = columns.column("gfx");
+                    vector<float>& gfy = columns.column("gfy");
+                    vector<float>& gfz = columns.column("gfz");
+                    for (unsigned int i = 0; i < n; ++i)
+                    {
+                      PHG4Hit* outerhit = trutheval->get_outermost_truth_hit(g4particles[i]);
+                      if (!outerhit) continue;
+                      gfpx[i] = outerhit->get_px(1);
+                      gfpy[i] = outerhit->get_py(1);
+                      gfpz[i] = outerhit->get_pz(1);
+                      gfx[i] = outerhit->get_x(1);
+                      gfy[i] = outerhit->get_y(1);
+                      gfz[i] = outerhit->get_z(1);
+                    }
+                  });
+
+      columns.add("track", "", "",
+                  [&](const unsigned int n) {
+                    tracks.assign(n, nullptr);
+                    if (!_do_track_match) return;
+                    for (unsigned int i = 0; i < n; ++i)
+                    {
+                      tracks[i] = trackeval->best_track_from(g4particles[i]);
+                    }
+                  });
+
+      columns.add("reco", "trackID:px:py:pz:pt:eta:phi:deltapt:deltaeta:deltaphi:"
+                          "charge:quality:chisq:ndf:nhits:layers:nmaps:nintt:ntpc:nlmaps:nlintt:nltpc:"
+                          "dca2d:dca2dsigma:dca3dxy:dca3dxysigma:dca3dz:dca3dzsigma:pcax:pcay:pcaz",
+                  "track",
+                  [&](const unsigned int n) {
+                    fill_track_columns(columns, tracks);
+                  });
+
+      columns.add("truth", "nfromtruth:nwrong:ntrumaps:ntruintt:ntrutpc:layersfromtruth", "track",
+                  [&](const unsigned int n) {
+                    fill_track_truth_columns(columns, tracks, g4particles);
+                  });
+
+      columns.evaluate(_ntp_gtrack, g4particles.size());
     }
     if (Verbosity() >= 1)
     {
@@ -2552,7 +2324,7 @@ void SvtxEvaluator::fillOutputNtuples(PHCompositeNode* topNode)
   // fill the Track NTuple
   //------------------------
 
-  if (_ntp_track)
+  if (_ntp_track && !_ntp_track->empty())
   {
     if (Verbosity() > 0)
     {
@@ -2564,353 +2336,207 @@ void SvtxEvaluator::fillOutputNtuples(PHCompositeNode* topNode)
     SvtxTrackMap* trackmap = findNode::getClass<SvtxTrackMap>(topNode, _trackmapname.c_str());
     if (trackmap)
     {
+      // one row per track, with scan_for_embedded the truth match of each track
+      // decides whether it gets a row, otherwise it is only done when needed
+      vector<SvtxTrack*> tracks;
+      vector<PHG4Particle*> g4particles;
       for (SvtxTrackMap::Iter iter = trackmap->begin();
            iter != trackmap->end();
            ++iter)
       {
         SvtxTrack* track = iter->second;
-        float trackID = track->get_id();
-        float charge = track->get_charge();
-        float quality = track->get_quality();
-        float chisq = track->get_chisq();
-        float ndf = track->get_ndf();
-        float nhits = track->size_cluster_keys();
-        unsigned int layers = 0x0;
-        int maps[_nlayers_maps];
-        int intt[_nlayers_intt];
-        int tpc[_nlayers_tpc];
-        if (_nlayers_maps > 0)
-        {
-          for (unsigned int i = 0; i < _nlayers_maps; i++) maps[i] = 0;
-        }
-        if (_nlayers_intt > 0)
-        {
-          for (unsigned int i = 0; i < _nlayers_intt; i++) intt[i] = 0;
-        }
-        if (_nlayers_tpc > 0)
-        {
-          for (unsigned int i = 0; i < _nlayers_tpc; i++) tpc[i] = 0;
-        }
-
-        float nmaps = 0;
-        float nintt = 0;
-        float ntpc = 0;
-        float nlmaps = 0;
-        float nlintt = 0;
-        float nltpc = 0;
-
-        for (SvtxTrack::ConstClusterKeyIter iter = track->begin_cluster_keys();
-             iter != track->end_cluster_keys();
-             ++iter)
-        {
-	  TrkrDefs::cluskey cluster_key = *iter;
-          //TrkrCluster* cluster = clustermap->findCluster(cluster_key);
-          unsigned int layer = TrkrDefs::getLayer(cluster_key);
-
-          if (_nlayers_maps > 0 && layer < _nlayers_maps)
-          {
-            maps[layer] = 1;
-            nmaps++;
-          }
-          if (_nlayers_intt > 0 && layer >= _nlayers_maps && layer < _nlayers_maps + _nlayers_intt)
-          {
-            intt[layer - _nlayers_maps] = 1;
-            nintt++;
-          }
-          if (_nlayers_tpc > 0 && layer >= (_nlayers_maps + _nlayers_intt) && layer < (_nlayers_maps + _nlayers_intt + _nlayers_tpc))
-          {
-            tpc[layer - (_nlayers_maps + _nlayers_intt)] = 1;
-            ntpc++;
-          }
-        }
-        if (_nlayers_maps > 0)
-          for (unsigned int i = 0; i < _nlayers_maps; i++) nlmaps += maps[i];
-        if (_nlayers_intt > 0)
-          for (unsigned int i = 0; i < _nlayers_intt; i++) nlintt += intt[i];
-        if (_nlayers_tpc > 0)
-          for (unsigned int i = 0; i < _nlayers_tpc; i++) nltpc += tpc[i];
-        layers = nlmaps + nlintt + nltpc;
-        float dca2d = track->get_dca2d();
-        float dca2dsigma = track->get_dca2d_error();
-        float dca3dxy = track->get_dca3d_xy();
-        float dca3dxysigma = track->get_dca3d_xy_error();
-        float dca3dz = track->get_dca3d_z();
-        float dca3dzsigma = track->get_dca3d_z_error();
-        float px = track->get_px();
-        float py = track->get_py();
-        float pz = track->get_pz();
-        TVector3 v(px, py, pz);
-        float pt = v.Pt();
-        float eta = v.Eta();
-        float phi = v.Phi();
-	float CVxx = track->get_error(3,3);
-	float CVxy = track->get_error(3,4);
-	float CVxz = track->get_error(3,5);
-	float CVyy = track->get_error(4,4);
-	float CVyz = track->get_error(4,5);
-	float CVzz = track->get_error(5,5);
-	float deltapt = sqrt((CVxx*px*px+2*CVxy*px*py+CVyy*py*py)/(px*px+py*py));
-        float deltaeta = sqrt((CVzz*(px*px+py*py)*(px*px+py*py)+pz*(-2*(CVxz*px+CVyz*py)*(px*px+py*py)+CVxx*px*px*pz+CVyy*py*py*pz+2*CVxy*px*py*pz))/((px*px+py*py)*(px*px+py*py)*(px*px+py*py+pz*pz)));
-	float deltaphi = sqrt((CVyy*px*px-2*CVxy*px*py+CVxx*py*py)/((px*px+py*py)*(px*px+py*py)));
-        float pcax = track->get_x();
-        float pcay = track->get_y();
-        float pcaz = track->get_z();
-
-        float presdphi = track->get_cal_dphi(SvtxTrack::PRES);
-        float presdeta = track->get_cal_deta(SvtxTrack::PRES);
-        float prese3x3 = track->get_cal_energy_3x3(SvtxTrack::PRES);
-        float prese = track->get_cal_cluster_e(SvtxTrack::PRES);
-
-        float cemcdphi = track->get_cal_dphi(SvtxTrack::CEMC);
-        float cemcdeta = track->get_cal_deta(SvtxTrack::CEMC);
-        float cemce3x3 = track->get_cal_energy_3x3(SvtxTrack::CEMC);
-        float cemce = track->get_cal_cluster_e(SvtxTrack::CEMC);
-
-        float hcalindphi = track->get_cal_dphi(SvtxTrack::HCALIN);
-        float hcalindeta = track->get_cal_deta(SvtxTrack::HCALIN);
-        float hcaline3x3 = track->get_cal_energy_3x3(SvtxTrack::HCALIN);
-        float hcaline = track->get_cal_cluster_e(SvtxTrack::HCALIN);
-
-        float hcaloutdphi = track->get_cal_dphi(SvtxTrack::HCALOUT);
-        float hcaloutdeta = track->get_cal_deta(SvtxTrack::HCALOUT);
-        float hcaloute3x3 = track->get_cal_energy_3x3(SvtxTrack::HCALOUT);
-        float hcaloute = track->get_cal_cluster_e(SvtxTrack::HCALOUT);
-
-        float gtrackID = NAN;
-        float gflavor = NAN;
-        float ng4hits = NAN;
-        unsigned int ngmaps = 0;
-        unsigned int ngintt = 0;
-        unsigned int ngtpc = 0;
-        unsigned int nglmaps = 0;
-        unsigned int nglintt = 0;
-        unsigned int ngltpc = 0;
-        float gpx = NAN;
-        float gpy = NAN;
-        float gpt = NAN;
-        float geta = NAN;
-        float gphi = NAN;
-        float gpz = NAN;
-        float gvx = NAN;
-        float gvy = NAN;
-        float gvz = NAN;
-        float gvt = NAN;
-        float gfpx = NAN;
-        float gfpy = NAN;
-        float gfpz = NAN;
-        float gfx = NAN;
-        float gfy = NAN;
-        float gfz = NAN;
-        float gembed = NAN;
-        float gprimary = NAN;
-
-        float nfromtruth = NAN;
-        float nwrong = NAN;
-        float ntrumaps = NAN;
-        float ntruintt = NAN;
-        float ntrutpc = NAN;
-        float layersfromtruth = NAN;
-
-        if (_do_track_match)
+        if (_scan_for_embedded && _do_track_match)
         {
           PHG4Particle* g4particle = trackeval->max_truth_particle_by_nclusters(track);
-          if (g4particle)
-          {
-            if (_scan_for_embedded)
-            {
-              if (trutheval->get_embed(g4particle) <= 0) continue;
-            }
-
-            gtrackID = g4particle->get_track_id();
-            gflavor = g4particle->get_pid();
-
-            std::set<TrkrDefs::cluskey> g4clusters = clustereval->all_clusters_from(g4particle);
-            ng4hits = g4clusters.size();
-            gpx = g4particle->get_px();
-            gpy = g4particle->get_py();
-            gpz = g4particle->get_pz();
-
-            int lmaps[_nlayers_maps + 1];
-            if (_nlayers_maps > 0)
-              for (unsigned int i = 0; i < _nlayers_maps; i++) lmaps[i] = 0;
-
-            int lintt[_nlayers_intt + 1];
-            if (_nlayers_intt > 0)
-              for (unsigned int i = 0; i < _nlayers_intt; i++) lintt[i] = 0;
-
-            int ltpc[_nlayers_tpc + 1];
-            if (_nlayers_tpc > 0)
-              for (unsigned int i = 0; i < _nlayers_tpc; i++) ltpc[i] = 0;
-
-            for (const TrkrDefs::cluskey g4cluster : g4clusters)
-            {
-              unsigned int layer = TrkrDefs::getLayer(g4cluster);
-              if (_nlayers_maps > 0 && layer < _nlayers_maps)
-              {
-                lmaps[layer] = 1;
-                ngmaps++;
-              }
-
-              if (_nlayers_intt > 0 && layer >= _nlayers_maps && layer < _nlayers_maps + _nlayers_intt)
-              {
-                lintt[layer - _nlayers_maps] = 1;
-                ngintt++;
-              }
-
-              if (_nlayers_tpc > 0 && layer >= _nlayers_maps + _nlayers_intt && layer < _nlayers_maps + _nlayers_intt + _nlayers_tpc)
-              {
-                ltpc[layer - (_nlayers_maps + _nlayers_intt)] = 1;
-                ngtpc++;
-              }
-            }
-            if (_nlayers_maps > 0)
-              for (unsigned int i = 0; i < _nlayers_maps; i++) nglmaps += lmaps[i];
-            if (_nlayers_intt > 0)
-              for (unsigned int i = 0; i < _nlayers_intt; i++) nglintt += lintt[i];
-            if (_nlayers_tpc > 0)
-              for (unsigned int i = 0; i < _nlayers_tpc; i++) ngltpc += ltpc[i];
-
-            TVector3 gv(gpx, gpy, gpz);
-            gpt = gv.Pt();
-            geta = gv.Eta();
-            gphi = gv.Phi();
-            PHG4VtxPoint* vtx = trutheval->get_vertex(g4particle);
-            gvx = vtx->get_x();
-            gvy = vtx->get_y();
-            gvz = vtx->get_z();
-            gvt = vtx->get_t();
-
-            PHG4Hit* outerhit = nullptr;
-            if (_do_eval_light == false)
-              outerhit = trutheval->get_outermost_truth_hit(g4particle);
-            if (outerhit)
-            {
-              gfpx = outerhit->get_px(1);
-              gfpy = outerhit->get_py(1);
-              gfpz = outerhit->get_pz(1);
-              gfx = outerhit->get_x(1);
-              gfy = outerhit->get_y(1);
-              gfz = outerhit->get_z(1);
-            }
-            gembed = trutheval->get_embed(g4particle);
-            gprimary = trutheval->is_primary(g4particle);
-
-            nfromtruth = trackeval->get_nclusters_contribution(track, g4particle);
-            nwrong = trackeval->get_nwrongclusters_contribution(track, g4particle);
-            if (_nlayers_maps == 0)
-            {
-              ntrumaps = 0;
-            }
-            else
-            {
-              ntrumaps = trackeval->get_layer_range_contribution(track, g4particle, 0, _nlayers_maps);
-            }
-            if (_nlayers_intt == 0)
-            {
-              ntruintt = 0;
-            }
-            else
-            {
-              ntruintt = trackeval->get_layer_range_contribution(track, g4particle, _nlayers_maps, _nlayers_maps + _nlayers_intt);
-            }
-            ntrutpc = trackeval->get_layer_range_contribution(track, g4particle, _nlayers_maps + _nlayers_intt, _nlayers_maps + _nlayers_intt + _nlayers_tpc);
-            layersfromtruth = trackeval->get_nclusters_contribution_by_layer(track, g4particle);
-          }
+          if (g4particle && trutheval->get_embed(g4particle) <= 0) continue;
+          g4particles.push_back(g4particle);
         }
-
-        float track_data[] = {(float) _ievent,
-                              trackID,
-                              px,
-                              py,
-                              pz,
-                              pt,
-                              eta,
-                              phi,
-			      deltapt,
-			      deltaeta,
-			      deltaphi,
-                              charge,
-                              quality,
-                              chisq,
-                              ndf,
-                              nhits, nmaps, nintt, ntpc, nlmaps, nlintt, nltpc,
-                              (float) layers,
-                              dca2d,
-                              dca2dsigma,
-                              dca3dxy,
-                              dca3dxysigma,
-                              dca3dz,
-                              dca3dzsigma,
-                              pcax,
-                              pcay,
-                              pcaz,
-                              presdphi,
-                              presdeta,
-                              prese3x3,
-                              prese,
-                              cemcdphi,
-                              cemcdeta,
-                              cemce3x3,
-                              cemce,
-                              hcalindphi,
-                              hcalindeta,
-                              hcaline3x3,
-                              hcaline,
-                              hcaloutdphi,
-                              hcaloutdeta,
-                              hcaloute3x3,
-                              hcaloute,
-                              gtrackID,
-                              gflavor,
-                              ng4hits,
-                              (float) ngmaps,
-                              (float) ngintt,
-                              (float) ngtpc,
-                              (float) nglmaps,
-                              (float) nglintt,
-                              (float) ngltpc,
-                              gpx,
-                              gpy,
-                              gpz,
-                              gpt,
-                              geta,
-                              gphi,
-                              gvx,
-                              gvy,
-                              gvz,
-                              gvt,
-                              gfpx,
-                              gfpy,
-                              gfpz,
-                              gfx,
-                              gfy,
-                              gfz,
-                              gembed,
-                              gprimary,
-                              nfromtruth,
-                              nwrong,
-                              ntrumaps,
-                              ntruintt,
-                              ntrutpc,
-                              layersfromtruth,
-                              nhit_tpc_all,
-                              nhit_tpc_in,
-                              nhit_tpc_mid,
-                              nhit_tpc_out, nclus_all, nclus_tpc, nclus_intt, nclus_maps};
-
-        /*
-	cout << "ievent " << _ievent
-	     << " trackID " << trackID
-	     << " nhits " << nhits
-	     << " px " << px
-	     << " py " << py
-	     << " pz " << pz
-	     << " gembed " << gembed
-	     << " gprimary " << gprimary 
-	     << endl;
-	*/
-        _ntp_track->Fill(track_data);
+        tracks.push_back(track);
       }
+
+      EvalColumns columns(track_varlist);
+      columns.set_verbosity(Verbosity());
+
+      add_event_columns(columns, event_values);
+
+      columns.add("track", "trackID:px:py:pz:pt:eta:phi:deltapt:deltaeta:deltaphi:"
+                           "charge:quality:chisq:ndf:nhits:layers:nmaps:nintt:ntpc:nlmaps:nlintt:nltpc:"
+                           "dca2d:dca2dsigma:dca3dxy:dca3dxysigma:dca3dz:dca3dzsigma:pcax:pcay:pcaz",
+                  "",
+                  [&](const unsigned int n) {
+                    fill_track_columns(columns, tracks);
+                  });
+
+      columns.add("calo", "presdphi:presdeta:prese3x3:prese:"
+                          "cemcdphi:cemcdeta:cemce3x3:cemce:"
+                          "hcalindphi:hcalindeta:hcaline3x3:hcaline:"
+                          "hcaloutdphi:hcaloutdeta:hcaloute3x3:hcaloute",
+                  "",
+                  [&](const unsigned int n) {
+                    const SvtxTrack::CAL_LAYER layers[] = {SvtxTrack::PRES, SvtxTrack::CEMC, SvtxTrack::HCALIN, SvtxTrack::HCALOUT};
+                    const char* names[] = {"pres", "cemc", "hcalin", "hcalout"};
+                    for (unsigned int j = 0; j < 4; ++j)
+                    {
+                      const string name = names[j];
+                      vector<float>& dphi = columns.column(name + "dphi");
+                      vector<float>& deta = columns.column(name + "deta");
+                      vector<float>& e3x3 = columns.column(name + "e3x3");
+                      vector<float>& e = columns.column(name + "e");
+                      for (unsigned int i = 0; i < n; ++i)
+                      {
+                        dphi[i] = tracks[i]->get_cal_dphi(layers[j]);
+                        deta[i] = tracks[i]->get_cal_deta(layers[j]);
+                        e3x3[i] = tracks[i]->get_cal_energy_3x3(layers[j]);
+                        e[i] = tracks[i]->get_cal_cluster_e(layers[j]);
+                      }
+                    }
+                  });
+
+      columns.add("g4particle", "", "",
+                  [&](const unsigned int n) {
+                    if (_scan_for_embedded && _do_track_match) return;  // matched with the rows
+                    g4particles.assign(n, nullptr);
+                    if (!_do_track_match) return;
+                    for (unsigned int i = 0; i < n; ++i)
+                    {
+                      g4particles[i] = trackeval->max_truth_particle_by_nclusters(tracks[i]);
+                    }
+                  });
+
+      columns.add("gparticle", "gtrackID:gflavor:gpx:gpy:gpz:gpt:geta:gphi:gvx:gvy:gvz:gvt:gembed:gprimary", "g4particle",
+                  [&](const unsigned int n) {
+                    vector<float>& gtrackID = columns.column("gtrackID");
+                    vector<float>& gflavor = columns.column("gflavor");
+                    vector<float>& gpx = columns.column("gpx");
+                    vector<float>& gpy = columns.column("gpy");
+                    vector<float>& gpz = columns.column("gpz");
+                    vector<float>& gpt = columns.column("gpt");
+                    vector<float>& geta = columns.column("geta");
+                    vector<float>& gphi = columns.column("gphi");
+                    vector<float>& gvx = columns.column("gvx");
+                    vector<float>& gvy = columns.column("gvy");
+                    vector<float>& gvz = columns.column("gvz");
+                    vector<float>& gvt = columns.column("gvt");
+                    vector<float>& gembed = columns.column("gembed");
+                    vector<float>& gprimary = columns.column("gprimary");
+                    for (unsigned int i = 0; i < n; ++i)
+                    {
+                      PHG4Particle* g4particle = g4particles[i];
+                      if (!g4particle) continue;
+                      gtrackID[i] = g4particle->get_track_id();
+                      gflavor[i] = g4particle->get_pid();
+                      gpx[i] = g4particle->get_px();
+                      gpy[i] = g4particle->get_py();
+                      gpz[i] = g4particle->get_pz();
+                      TVector3 gv(gpx[i], gpy[i], gpz[i]);
+                      gpt[i] = gv.Pt();
+                      geta[i] = gv.Eta();
+                      gphi[i] = gv.Phi();
+                      PHG4VtxPoint* vtx = trutheval->get_vertex(g4particle);
+                      gvx[i] = vtx->get_x();
+                      gvy[i] = vtx->get_y();
+                      gvz[i] = vtx->get_z();
+                      gvt[i] = vtx->get_t();
+
+                      gembed[i] = trutheval->get_embed(g4particle);
+                      gprimary[i] = trutheval->is_primary(g4particle);
+                    }
+                  });
+
+      columns.add("gclusters", "gnhits:gnmaps:gnintt:gntpc:gnlmaps:gnlintt:gnltpc", "g4particle",
+                  [&](const unsigned int n) {
+                    vector<float>& ng4hits = columns.column("gnhits");
+                    vector<float>& ngmaps = columns.column("gnmaps");
+                    vector<float>& ngintt = columns.column("gnintt");
+                    vector<float>& ngtpc = columns.column("gntpc");
+                    vector<float>& nglmaps = columns.column("gnlmaps");
+                    vector<float>& nglintt = columns.column("gnlintt");
+                    vector<float>& ngltpc = columns.column("gnltpc");
+                    for (unsigned int i = 0; i < n; ++i)
+                    {
+                      // without matched particle the counts are 0 and gnhits is NAN
+                      ngmaps[i] = 0;
+                      ngintt[i] = 0;
+                      ngtpc[i] = 0;
+                      nglmaps[i] = 0;
+                      nglintt[i] = 0;
+                      ngltpc[i] = 0;
+                      if (!g4particles[i]) continue;
+
+                      std::set<TrkrDefs::cluskey> g4clusters = clustereval->all_clusters_from(g4particles[i]);
+                      ng4hits[i] = g4clusters.size();
+
+                      int lmaps[_nlayers_maps + 1];
+                      if (_nlayers_maps > 0)
+                        for (unsigned int j = 0; j < _nlayers_maps; j++) lmaps[j] = 0;
+
+                      int lintt[_nlayers_intt + 1];
+                      if (_nlayers_intt > 0)
+                        for (unsigned int j = 0; j < _nlayers_intt; j++) lintt[j] = 0;
+
+                      int ltpc[_nlayers_tpc + 1];
+                      if (_nlayers_tpc > 0)
+                        for (unsigned int j = 0; j < _nlayers_tpc; j++) ltpc[j] = 0;
+
+                      for (const TrkrDefs::cluskey g4cluster : g4clusters)
+                      {
+                        unsigned int layer = TrkrDefs::getLayer(g4cluster);
+                        if (_nlayers_maps > 0 && layer < _nlayers_maps)
+                        {
+                          lmaps[layer] = 1;
+                          ngmaps[i]++;
+                        }
+
+                        if (_nlayers_intt > 0 && layer >= _nlayers_maps && layer < _nlayers_maps + _nlayers_intt)
+                        {
+                          lintt[layer - _nlayers_maps] = 1;
+                          ngintt[i]++;
+                        }
+
+                        if (_nlayers_tpc > 0 && layer >= _nlayers_maps + _nlayers_intt && layer < _nlayers_maps + _nlayers_intt + _nlayers_tpc)
+                        {
+                          ltpc[layer - (_nlayers_maps + _nlayers_intt)] = 1;
+                          ngtpc[i]++;
+                        }
+                      }
+                      if (_nlayers_maps > 0)
+                        for (unsigned int j = 0; j < _nlayers_maps; j++) nglmaps[i] += lmaps[j];
+                      if (_nlayers_intt > 0)
+                        for (unsigned int j = 0; j < _nlayers_intt; j++) nglintt[i] += lintt[j];
+                      if (_nlayers_tpc > 0)
+                        for (unsigned int j = 0; j < _nlayers_tpc; j++) ngltpc[i] += ltpc[j];
+                    }
+                  });
+
+      columns.add("goutermost", "gfpx:gfpy:gfpz:gfx:gfy:gfz", "g4particle",
+                  [&](const unsigned int n) {
+                    if (_do_eval_light) return;
+                    vector<float>& gfpx = columns.column("gfpx");
+                    vector<float>& gfpy = columns.column("gfpy");
+                    vector<float>& gfpz = columns.column("gfpz");
+                    vector<float>& gfx = columns.column("gfx");
+                    vector<float>& gfy = columns.column("gfy");
+                    vector<float>& gfz = columns.column("gfz");
+                    for (unsigned int i = 0; i < n; ++i)
+                    {
+                      if (!g4particles[i]) continue;
+                      PHG4Hit* outerhit = trutheval->get_outermost_truth_hit(g4particles[i]);
+                      if (!outerhit) continue;
+                      gfpx[i] = outerhit->get_px(1);
+                      gfpy[i] = outerhit->get_py(1);
+                      gfpz[i] = outerhit->get_pz(1);
+                      gfx[i] = outerhit->get_x(1);
+                      gfy[i] = outerhit->get_y(1);
+                      gfz[i] = outerhit->get_z(1);
+                    }
+                  });
+
+      columns.add("truth", "nfromtruth:nwrong:ntrumaps:ntruintt:ntrutpc:layersfromtruth", "g4particle",
+                  [&](const unsigned int n) {
+                    fill_track_truth_columns(columns, tracks, g4particles);
+                  });
+
+      columns.evaluate(_ntp_track, tracks.size());
     }
     if (Verbosity() >= 1)
     {
@@ -2922,44 +2548,30 @@ void SvtxEvaluator::fillOutputNtuples(PHCompositeNode* topNode)
   //---------------------
   // fill the Gseed NTuple
   //---------------------
-  
-  if (_ntp_gseed)
+
+  if (_ntp_gseed && !_ntp_gseed->empty())
     {
       if (Verbosity() > 0)
 	{
 	  cout << "Filling ntp_gseed " << endl;
 	  _timer->restart();
 	}
-      
+
       PHG4TruthInfoContainer* truthinfo = findNode::getClass<PHG4TruthInfoContainer>(topNode, "G4TruthInfo");
-      
-      float gx = NAN;
-      float gy = NAN;
-      float gz = NAN;
-      float gr = NAN;
-      float geta = NAN;
-      float gphi = NAN;
-      float glayer = NAN;
-      float gpx = NAN;
-      float gpy = NAN;
-      float gpz = NAN;
-      float gtpt = NAN;
-      float gtphi = NAN;
-      float gteta = NAN;
-      float gvx = NAN;
-      float gvy = NAN;
-      float gvz = NAN;
-      float gembed = NAN;
-      float gprimary = NAN;
-      float gflav = NAN;
-      float dphiprev = NAN;
-      float detaprev = NAN;
-      
-      float xval[_nlayers_maps + _nlayers_intt + _nlayers_tpc];
-      float yval[_nlayers_maps + _nlayers_intt + _nlayers_tpc];
-      float zval[_nlayers_maps + _nlayers_intt + _nlayers_tpc];
+
       if (truthinfo)
 	{
+	  // one row per primary particle and layer with a truth hit, the average
+	  // position of the last truth hit in the layer
+	  vector<PHG4Particle*> g4particles;
+	  vector<int> ntrks;
+	  vector<unsigned int> layers;
+	  vector<TVector3> positions;
+	  // position in the layer before, (0,0,0) if it has no hit
+	  vector<TVector3> previous;
+
+	  const unsigned int nlayers = _nlayers_maps + _nlayers_intt + _nlayers_tpc;
+	  vector<TVector3> layer_positions;
 	  int ntrk = 0;
 	  PHG4TruthInfoContainer::ConstRange range = truthinfo->GetPrimaryParticleRange();
 	  for (PHG4TruthInfoContainer::ConstIterator iter = range.first;
@@ -2968,12 +2580,7 @@ void SvtxEvaluator::fillOutputNtuples(PHCompositeNode* topNode)
 	    {
 	      ntrk++;
 	      PHG4Particle* g4particle = iter->second;
-	      for (unsigned int i = 0; i < _nlayers_maps + _nlayers_intt + _nlayers_tpc; i++)
-		{
-		  xval[i] = 0;
-		  yval[i] = 0;
-		  zval[i] = 0;
-		}
+	      layer_positions.assign(nlayers, TVector3(0, 0, 0));
 	      std::set<PHG4Hit*> truth_hits = trutheval->all_truth_hits(g4particle);
 	      for (std::set<PHG4Hit*>::iterator iter = truth_hits.begin();
 		   iter != truth_hits.end();
@@ -2981,95 +2588,102 @@ void SvtxEvaluator::fillOutputNtuples(PHCompositeNode* topNode)
 		{
 		  PHG4Hit* g4hit = *iter;
 		  unsigned int layer = g4hit->get_layer();
-		  //cout << "  g4hit " << g4hit->get_hit_id() << " layer = " << layer << endl;
-		  if (layer >= _nlayers_maps + _nlayers_intt + _nlayers_tpc)
+		  if (layer >= nlayers)
 		    {
-		      //cout << PHWHERE << " skipping out of bounds detector id " << layer << endl;
 		      continue;
 		    }
-		  xval[layer] = g4hit->get_avg_x();
-		  yval[layer] = g4hit->get_avg_y();
-		  zval[layer] = g4hit->get_avg_z();
+		  layer_positions[layer].SetXYZ(g4hit->get_avg_x(), g4hit->get_avg_y(), g4hit->get_avg_z());
 		}
-	      
-	      for (unsigned int i = 0; i < _nlayers_maps + _nlayers_intt + _nlayers_tpc; i++)
+
+	      for (unsigned int i = 0; i < nlayers; i++)
 		{
-		  gx = xval[i];
-		  gy = yval[i];
-		  gz = zval[i];
-		  if (gx == 0 && gy == 0) continue;
-		  
-		  TVector3 vg4(gx, gy, gz);
-		  glayer = i;
-		  gr = vg4.Perp();
-		  geta = vg4.Eta();
-		  gphi = vg4.Phi();
-		  gpx = g4particle->get_px();
-		  gpy = g4particle->get_py();
-		  gpz = g4particle->get_pz();
-		  TVector3 vg4p(gpx, gpy, gpz);
-		  
-		  gtpt = vg4p.Perp();
-		  gtphi = vg4p.Phi();
-		  gteta = vg4p.Eta();
-		  
-		  PHG4VtxPoint* vtx = trutheval->get_vertex(g4particle);
-		  
-		  if (vtx)
-		    {
-		      gvx = vtx->get_x();
-		      gvy = vtx->get_y();
-		      gvz = vtx->get_z();
-		    }
-		  
-		  gembed = trutheval->get_embed(g4particle);
-		  gprimary = trutheval->is_primary(g4particle);
-		  gflav = g4particle->get_pid();
-		  if (i >= 1)
-		    {
-		      if (xval[i - 1] != 0 && yval[i - 1] != 0)
-			{
-			  TVector3 vg4prev(xval[i - 1], yval[i - 1], zval[i - 1]);
-			  dphiprev = vg4.DeltaPhi(vg4prev);
-			  detaprev = geta - vg4prev.Eta();
-			}
-		    }
-		  
-		  float ntrk_f = ntrk;
-		  float _ievent_f = _ievent;
-		  float gseed_data[] = {_ievent_f,
-					ntrk_f,
-					gx,
-					gy,
-					gz,
-					gr,
-					geta,
-					gphi,
-					glayer,
-					gpx,
-					gpy,
-					gpz,
-					gtpt,
-					gtphi,
-					gteta,
-					gvx,
-					gvy,
-					gvz,
-					gembed,
-					gprimary,
-					gflav,
-					dphiprev,
-					detaprev,
-					nhit_tpc_all,
-					nhit_tpc_in,
-					nhit_tpc_mid,
-					nhit_tpc_out, nclus_all, nclus_tpc, nclus_intt, nclus_maps};
-		  
-		  _ntp_gseed->Fill(gseed_data);
+		  if (layer_positions[i].x() == 0 && layer_positions[i].y() == 0) continue;
+		  g4particles.push_back(g4particle);
+		  ntrks.push_back(ntrk);
+		  layers.push_back(i);
+		  positions.push_back(layer_positions[i]);
+		  previous.push_back(i >= 1 ? layer_positions[i - 1] : TVector3(0, 0, 0));
 		}
 	    }
+
+	  EvalColumns columns(gseed_varlist);
+	  columns.set_verbosity(Verbosity());
+
+	  add_event_columns(columns, event_values);
+
+	  columns.add("gseed", "ntrk:gx:gy:gz:gr:geta:gphi:glayer:dphiprev:detaprev", "",
+		      [&](const unsigned int n) {
+			vector<float>& ntrk = columns.column("ntrk");
+			vector<float>& gx = columns.column("gx");
+			vector<float>& gy = columns.column("gy");
+			vector<float>& gz = columns.column("gz");
+			vector<float>& gr = columns.column("gr");
+			vector<float>& geta = columns.column("geta");
+			vector<float>& gphi = columns.column("gphi");
+			vector<float>& glayer = columns.column("glayer");
+			vector<float>& dphiprev = columns.column("dphiprev");
+			vector<float>& detaprev = columns.column("detaprev");
+			for (unsigned int i = 0; i < n; ++i)
+			  {
+			    const TVector3& vg4 = positions[i];
+			    ntrk[i] = ntrks[i];
+			    gx[i] = vg4.x();
+			    gy[i] = vg4.y();
+			    gz[i] = vg4.z();
+			    gr[i] = vg4.Perp();
+			    geta[i] = vg4.Eta();
+			    gphi[i] = vg4.Phi();
+			    glayer[i] = layers[i];
+			    if (previous[i].x() != 0 && previous[i].y() != 0)
+			      {
+				dphiprev[i] = vg4.DeltaPhi(previous[i]);
+				detaprev[i] = geta[i] - previous[i].Eta();
+			      }
+			  }
+		      });
+
+	  columns.add("gparticle", "gpx:gpy:gpz:gtpt:gtphi:gteta:gvx:gvy:gvz:gembed:gprimary:gflav", "",
+		      [&](const unsigned int n) {
+			vector<float>& gpx = columns.column("gpx");
+			vector<float>& gpy = columns.column("gpy");
+			vector<float>& gpz = columns.column("gpz");
+			vector<float>& gtpt = columns.column("gtpt");
+			vector<float>& gtphi = columns.column("gtphi");
+			vector<float>& gteta = columns.column("gteta");
+			vector<float>& gvx = columns.column("gvx");
+			vector<float>& gvy = columns.column("gvy");
+			vector<float>& gvz = columns.column("gvz");
+			vector<float>& gembed = columns.column("gembed");
+			vector<float>& gprimary = columns.column("gprimary");
+			vector<float>& gflav = columns.column("gflav");
+			for (unsigned int i = 0; i < n; ++i)
+			  {
+			    PHG4Particle* g4particle = g4particles[i];
+			    gpx[i] = g4particle->get_px();
+			    gpy[i] = g4particle->get_py();
+			    gpz[i] = g4particle->get_pz();
+			    TVector3 vg4p(gpx[i], gpy[i], gpz[i]);
+			    gtpt[i] = vg4p.Perp();
+			    gtphi[i] = vg4p.Phi();
+			    gteta[i] = vg4p.Eta();
+
+			    PHG4VtxPoint* vtx = trutheval->get_vertex(g4particle);
+			    if (vtx)
+			      {
+				gvx[i] = vtx->get_x();
+				gvy[i] = vtx->get_y();
+				gvz[i] = vtx->get_z();
+			      }
+
+			    gembed[i] = trutheval->get_embed(g4particle);
+			    gprimary[i] = trutheval->is_primary(g4particle);
+			    gflav[i] = g4particle->get_pid();
+			  }
+		      });
+
+	  columns.evaluate(_ntp_gseed, positions.size());
 	}
-      
+
       if (Verbosity() >= 1)
 	{
 	  _timer->stop();
@@ -3080,6 +2694,177 @@ void SvtxEvaluator::fillOutputNtuples(PHCompositeNode* topNode)
 
 }
 
+void SvtxEvaluator::fill_track_columns(EvalColumns& columns, const vector<SvtxTrack*>& tracks)
+{
+  vector<float>& trackID = columns.column("trackID");
+  vector<float>& px = columns.column("px");
+  vector<float>& py = columns.column("py");
+  vector<float>& pz = columns.column("pz");
+  vector<float>& pt = columns.column("pt");
+  vector<float>& eta = columns.column("eta");
+  vector<float>& phi = columns.column("phi");
+  vector<float>& deltapt = columns.column("deltapt");
+  vector<float>& deltaeta = columns.column("deltaeta");
+  vector<float>& deltaphi = columns.column("deltaphi");
+  vector<float>& charge = columns.column("charge");
+  vector<float>& quality = columns.column("quality");
+  vector<float>& chisq = columns.column("chisq");
+  vector<float>& ndf = columns.column("ndf");
+  vector<float>& nhits = columns.column("nhits");
+  vector<float>& layers = columns.column("layers");
+  vector<float>& nmaps = columns.column("nmaps");
+  vector<float>& nintt = columns.column("nintt");
+  vector<float>& ntpc = columns.column("ntpc");
+  vector<float>& nlmaps = columns.column("nlmaps");
+  vector<float>& nlintt = columns.column("nlintt");
+  vector<float>& nltpc = columns.column("nltpc");
+  vector<float>& dca2d = columns.column("dca2d");
+  vector<float>& dca2dsigma = columns.column("dca2dsigma");
+  vector<float>& dca3dxy = columns.column("dca3dxy");
+  vector<float>& dca3dxysigma = columns.column("dca3dxysigma");
+  vector<float>& dca3dz = columns.column("dca3dz");
+  vector<float>& dca3dzsigma = columns.column("dca3dzsigma");
+  vector<float>& pcax = columns.column("pcax");
+  vector<float>& pcay = columns.column("pcay");
+  vector<float>& pcaz = columns.column("pcaz");
+
+  for (unsigned int i = 0; i < tracks.size(); ++i)
+  {
+    // the cluster counts are 0 for rows without track
+    layers[i] = 0;
+    nmaps[i] = 0;
+    nintt[i] = 0;
+    ntpc[i] = 0;
+    nlmaps[i] = 0;
+    nlintt[i] = 0;
+    nltpc[i] = 0;
+
+    SvtxTrack* track = tracks[i];
+    if (!track) continue;
+
+    trackID[i] = track->get_id();
+    charge[i] = track->get_charge();
+    quality[i] = track->get_quality();
+    chisq[i] = track->get_chisq();
+    ndf[i] = track->get_ndf();
+    nhits[i] = track->size_cluster_keys();
+
+    int maps[_nlayers_maps];
+    int intt[_nlayers_intt];
+    int tpc[_nlayers_tpc];
+    if (_nlayers_maps > 0)
+    {
+      for (unsigned int j = 0; j < _nlayers_maps; j++) maps[j] = 0;
+    }
+    if (_nlayers_intt > 0)
+    {
+      for (unsigned int j = 0; j < _nlayers_intt; j++) intt[j] = 0;
+    }
+    if (_nlayers_tpc > 0)
+    {
+      for (unsigned int j = 0; j < _nlayers_tpc; j++) tpc[j] = 0;
+    }
+
+    for (SvtxTrack::ConstClusterKeyIter iter = track->begin_cluster_keys();
+         iter != track->end_cluster_keys();
+         ++iter)
+    {
+      unsigned int layer = TrkrDefs::getLayer(*iter);
+      if (_nlayers_maps > 0 && layer < _nlayers_maps)
+      {
+        maps[layer] = 1;
+        nmaps[i]++;
+      }
+      if (_nlayers_intt > 0 && layer >= _nlayers_maps && layer < _nlayers_maps + _nlayers_intt)
+      {
+        intt[layer - _nlayers_maps] = 1;
+        nintt[i]++;
+      }
+      if (_nlayers_tpc > 0 && layer >= (_nlayers_maps + _nlayers_intt) && layer < (_nlayers_maps + _nlayers_intt + _nlayers_tpc))
+      {
+        tpc[layer - (_nlayers_maps + _nlayers_intt)] = 1;
+        ntpc[i]++;
+      }
+    }
+    if (_nlayers_maps > 0)
+      for (unsigned int j = 0; j < _nlayers_maps; j++) nlmaps[i] += maps[j];
+    if (_nlayers_intt > 0)
+      for (unsigned int j = 0; j < _nlayers_intt; j++) nlintt[i] += intt[j];
+    if (_nlayers_tpc > 0)
+      for (unsigned int j = 0; j < _nlayers_tpc; j++) nltpc[i] += tpc[j];
+    layers[i] = nlmaps[i] + nlintt[i] + nltpc[i];
+
+    dca2d[i] = track->get_dca2d();
+    dca2dsigma[i] = track->get_dca2d_error();
+    dca3dxy[i] = track->get_dca3d_xy();
+    dca3dxysigma[i] = track->get_dca3d_xy_error();
+    dca3dz[i] = track->get_dca3d_z();
+    dca3dzsigma[i] = track->get_dca3d_z_error();
+
+    const float x = track->get_px();
+    const float y = track->get_py();
+    const float z = track->get_pz();
+    px[i] = x;
+    py[i] = y;
+    pz[i] = z;
+    TVector3 v(x, y, z);
+    pt[i] = v.Pt();
+    eta[i] = v.Eta();
+    phi[i] = v.Phi();
+    float CVxx = track->get_error(3, 3);
+    float CVxy = track->get_error(3, 4);
+    float CVxz = track->get_error(3, 5);
+    float CVyy = track->get_error(4, 4);
+    float CVyz = track->get_error(4, 5);
+    float CVzz = track->get_error(5, 5);
+    deltapt[i] = sqrt((CVxx * x * x + 2 * CVxy * x * y + CVyy * y * y) / (x * x + y * y));
+    deltaeta[i] = sqrt((CVzz * (x * x + y * y) * (x * x + y * y) + z * (-2 * (CVxz * x + CVyz * y) * (x * x + y * y) + CVxx * x * x * z + CVyy * y * y * z + 2 * CVxy * x * y * z)) / ((x * x + y * y) * (x * x + y * y) * (x * x + y * y + z * z)));
+    deltaphi[i] = sqrt((CVyy * x * x - 2 * CVxy * x * y + CVxx * y * y) / ((x * x + y * y) * (x * x + y * y)));
+    pcax[i] = track->get_x();
+    pcay[i] = track->get_y();
+    pcaz[i] = track->get_z();
+  }
+}
+
+void SvtxEvaluator::fill_track_truth_columns(EvalColumns& columns, const vector<SvtxTrack*>& tracks, const vector<PHG4Particle*>& g4particles)
+{
+  vector<float>& nfromtruth = columns.column("nfromtruth");
+  vector<float>& nwrong = columns.column("nwrong");
+  vector<float>& ntrumaps = columns.column("ntrumaps");
+  vector<float>& ntruintt = columns.column("ntruintt");
+  vector<float>& ntrutpc = columns.column("ntrutpc");
+  vector<float>& layersfromtruth = columns.column("layersfromtruth");
+
+  SvtxTrackEval* trackeval = _svtxevalstack->get_track_eval();
+  for (unsigned int i = 0; i < tracks.size(); ++i)
+  {
+    SvtxTrack* track = tracks[i];
+    PHG4Particle* g4particle = g4particles[i];
+    if (!track || !g4particle) continue;
+
+    nfromtruth[i] = trackeval->get_nclusters_contribution(track, g4particle);
+    nwrong[i] = trackeval->get_nwrongclusters_contribution(track, g4particle);
+    if (_nlayers_maps == 0)
+    {
+      ntrumaps[i] = 0;
+    }
+    else
+    {
+      ntrumaps[i] = trackeval->get_layer_range_contribution(track, g4particle, 0, _nlayers_maps);
+    }
+    if (_nlayers_intt == 0)
+    {
+      ntruintt[i] = 0;
+    }
+    else
+    {
+      ntruintt[i] = trackeval->get_layer_range_contribution(track, g4particle, _nlayers_maps, _nlayers_maps + _nlayers_intt);
+    }
+    ntrutpc[i] = trackeval->get_layer_range_contribution(track, g4particle, _nlayers_maps + _nlayers_intt, _nlayers_maps + _nlayers_intt + _nlayers_tpc);
+    layersfromtruth[i] = trackeval->get_nclusters_contribution_by_layer(track, g4particle);
+  }
+}
+
 void SvtxEvaluator::G4ClusterSize(PHCompositeNode* topNode, unsigned int layer, std::vector<std::vector<double>> contributing_hits_entry,std::vector<std::vector<double>> contributing_hits_exit, float &g4phisize, float &g4zsize)
 {
 
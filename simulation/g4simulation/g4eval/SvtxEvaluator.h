@@ -9,6 +9,7 @@
 
 #include <fun4all/SubsysReco.h>
 
+#include <map>
 #include <string>
 #include <set>
 #include <vector>
@@ -17,8 +18,11 @@ class PHCompositeNode;
 class PHTimer;
 class SvtxEvalStack;
 class TFile;
-class TNtuple;
+class EvalColumns;
+class EvalNtuple;
 class PHG4Hit;
+class PHG4Particle;
+class SvtxTrack;
 
 /// \class SvtxEvaluator
 ///
@@ -56,6 +60,12 @@ class SvtxEvaluator : public SubsysReco
   void do_track_eval(bool b) { _do_track_eval = b; }
   void do_gseed_eval(bool b) { _do_gseed_eval = b; }
 
+  //! write only these columns ("a:b:c") of the given ntuple,
+  //! e.g. select_columns("ntp_track", "event:px:py:pz:gpx:gpy:gpz")
+  //! Only the selected columns and what they depend on are computed (EvalColumns),
+  //! ntuples without selected column are skipped
+  void select_columns(const std::string &ntuple, const std::string &columns) { _selected_columns[ntuple] = columns; }
+
   void do_track_match(bool b) { _do_track_match = b; }
   void do_eval_light(bool b) { _do_eval_light = b; }
   void scan_for_embedded(bool b) { _scan_for_embedded = b; }
@@ -92,15 +102,18 @@ class SvtxEvaluator : public SubsysReco
   unsigned int _nlayers_intt = 8;
   unsigned int _nlayers_tpc = 60;
 
-  TNtuple *_ntp_vertex;
-  TNtuple *_ntp_gpoint;
-  TNtuple *_ntp_g4hit;
-  TNtuple *_ntp_hit;
-  TNtuple *_ntp_cluster;
-  TNtuple *_ntp_g4cluster;
-  TNtuple *_ntp_gtrack;
-  TNtuple *_ntp_track;
-  TNtuple *_ntp_gseed;
+  EvalNtuple *_ntp_vertex;
+  EvalNtuple *_ntp_gpoint;
+  EvalNtuple *_ntp_g4hit;
+  EvalNtuple *_ntp_hit;
+  EvalNtuple *_ntp_cluster;
+  EvalNtuple *_ntp_g4cluster;
+  EvalNtuple *_ntp_gtrack;
+  EvalNtuple *_ntp_track;
+  EvalNtuple *_ntp_gseed;
+
+  //! column selection per ntuple name, all columns if not set
+  std::map<std::string, std::string> _selected_columns;
 
   // evaluator output file
   std::string _filename;
@@ -117,6 +130,11 @@ class SvtxEvaluator : public SubsysReco
   
   float line_circle_intersection(float x[], float y[], float z[], float radius);
 
+  //! track columns of ntp_track and ntp_gtrack (trackID, momentum, cluster counts, dca, ...), rows without track are NAN with cluster counts 0
+  void fill_track_columns(EvalColumns &columns, const std::vector<SvtxTrack *> &tracks);
+  //! truth contribution columns (nfromtruth, nwrong, ...) for the rows with track and particle
+  void fill_track_truth_columns(EvalColumns &columns, const std::vector<SvtxTrack *> &tracks, const std::vector<PHG4Particle *> &g4particles);
+
   // output subroutines
   void fillOutputNtuples(PHCompositeNode *topNode);  ///< dump the evaluator information into ntuple for external analysis
   void printInputInfo(PHCompositeNode *topNode);     ///< print out the input object information (debugging upstream components)
@@ -286,30 +286,18 @@ void PHG4GDMLWriteMaterials::MaterialsWrite(xercesc::DOMElement* element)
 
 void PHG4GDMLWriteMaterials::AddIsotope(const G4Isotope* const isotopePtr)
 {
-   for (size_t i=0; i<isotopeList.size(); i++)   // Check if isotope is
-   {                                             // already in the list!
-     if (isotopeList[i] == isotopePtr)  { return; }
-   }
-   isotopeList.push_back(isotopePtr);
+   if (!isotopeList.insert(isotopePtr).second)  { return; }   // already written
    IsotopeWrite(isotopePtr);
 }
 
 void PHG4GDMLWriteMaterials::AddElement(const G4Element* const elementPtr)
 {
-   for (size_t i=0;i<elementList.size();i++)     // Check if element is
-   {                                             // already in the list!
-      if (elementList[i] == elementPtr) { return; }
-   }
-   elementList.push_back(elementPtr);
+   if (!elementList.insert(elementPtr).second)  { return; }   // already written
    ElementWrite(elementPtr);
 }
 
 void PHG4GDMLWriteMaterials::AddMaterial(const G4Material* const materialPtr)
 {
-   for (size_t i=0;i<materialList.size();i++)    // Check if material is
-   {                                             // already in the list!
-      if (materialList[i] == materialPtr)  { return; }
-   }
-   materialList.push_back(materialPtr);
+   if (!materialList.insert(materialPtr).second)  { return; }   // already written
    MaterialWrite(materialPtr);
 }
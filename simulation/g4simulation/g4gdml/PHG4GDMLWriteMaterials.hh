@@ -41,6 +41,7 @@
 #define _PHG4GDMLWRITEMATERIALS_INCLUDED_
 
 #include <Geant4/G4Types.hh>
+#include <set>
 #include <vector>
 
 #include "PHG4GDMLWriteDefine.hh"
@@ -79,9 +80,9 @@ class PHG4GDMLWriteMaterials : public PHG4GDMLWriteDefine
                             const G4PhysicsOrderedFreeVector* const);
  protected:
 
-   std::vector<const G4Isotope*> isotopeList;
-   std::vector<const G4Element*> elementList;
-   std::vector<const G4Material*> materialList;
+   std::set<const G4Isotope*> isotopeList;
+   std::set<const G4Element*> elementList;
+   std::set<const G4Material*> materialList;
    xercesc::DOMElement* materialsElement;
 };
 
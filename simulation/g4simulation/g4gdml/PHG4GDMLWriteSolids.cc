@@ -69,6 +69,10 @@
 #include <Geant4/G4OpticalSurface.hh>
 #include <Geant4/G4SurfaceProperty.hh>
 
+#include <sstream>
+#include <string>
+#include <utility>
+
 PHG4GDMLWriteSolids::PHG4GDMLWriteSolids()
   : PHG4GDMLWriteMaterials(), solidsElement(0)
 {
@@ -1024,16 +1028,35 @@ void PHG4GDMLWriteSolids::SolidsWrite(xercesc::DOMElement* gdmlElement)
    gdmlElement->appendChild(solidsElement);
 
    solidList.clear();
+   solidShapeMap.clear();
 }
 
-void PHG4GDMLWriteSolids::AddSolid(const G4VSolid* const solidPtr)
+const G4VSolid* PHG4GDMLWriteSolids::SharedSolid(const G4VSolid* const solidPtr)
 {
-   for (size_t i=0; i<solidList.size(); i++)   // Check if solid is
-   {                                           // already in the list!
-      if (solidList[i] == solidPtr)  { return; }
+   // only primitives whose dump contains all of their parameters
+   const G4String type = solidPtr->GetEntityType();
+   if (type != "G4Box" && type != "G4Tubs" && type != "G4Cons" &&
+       type != "G4Trd" && type != "G4Trap" && type != "G4Para" &&
+       type != "G4Sphere")
+   {
+     return solidPtr;
+   }
+   std::ostringstream os;
+   os.precision(17);
+   solidPtr->StreamInfo(os);
+   std::string shape = os.str();
+   // the name is in the header of the dump, everything else is the shape
+   const std::string::size_type namepos = shape.find(solidPtr->GetName());
+   if (namepos != std::string::npos)
+   {
+     shape.erase(namepos, solidPtr->GetName().size());
    }
+   return solidShapeMap.insert(std::make_pair(shape, solidPtr)).first->second;
+}
 
-   solidList.push_back(solidPtr);
+void PHG4GDMLWriteSolids::AddSolid(const G4VSolid* const solidPtr)
+{
+   if (!solidList.insert(solidPtr).second)  { return; }   // already written
 
    if (const G4BooleanSolid* const booleanPtr
      = dynamic_cast<const G4BooleanSolid*>(solidPtr))
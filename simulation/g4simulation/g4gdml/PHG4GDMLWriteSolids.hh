@@ -43,6 +43,10 @@
 #include <Geant4/G4Types.hh>
 #include <Geant4/G4MultiUnion.hh>
 
+#include <set>
+#include <string>
+#include <unordered_map>
+
 #include "PHG4GDMLWriteMaterials.hh"
 
 class G4BooleanSolid;
@@ -101,6 +105,11 @@ class PHG4GDMLWriteSolids : public PHG4GDMLWriteMaterials
    virtual void AddSolid(const G4VSolid* const);
    virtual void SolidsWrite(xercesc::DOMElement*);
 
+   // Returns an already seen solid with the same type and parameters,
+   // so identical solids are written only once. Solids which cannot be
+   // compared safely are returned unchanged.
+   const G4VSolid* SharedSolid(const G4VSolid* const);
+
   protected:
 
    PHG4GDMLWriteSolids();
@@ -142,7 +151,8 @@ class PHG4GDMLWriteSolids : public PHG4GDMLWriteMaterials
 
   protected:
 
-   std::vector<const G4VSolid*> solidList;
+   std::set<const G4VSolid*> solidList;
+   std::unordered_map<std::string, const G4VSolid*> solidShapeMap;
    xercesc::DOMElement* solidsElement;
    static const G4int maxTransforms = 8; // Constant for limiting the number
                                          // of displacements/reflections
@@ -454,6 +454,9 @@ TraverseVolumeTree(const G4LogicalVolume* const volumePtr, const G4int depth)
    //
    if (trans>0) { invR = R.inverse(); }
 
+   // identical solids of different volumes are written once
+   solidPtr = const_cast<G4VSolid*>(SharedSolid(solidPtr));
+
    const G4String name
      = GenerateName(tmplv->GetName(), tmplv);
    const G4String materialref
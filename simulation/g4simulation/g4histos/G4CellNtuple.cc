@@ -1,5 +1,7 @@
 #include "G4CellNtuple.h"
 
+#include "G4ColumnWriter.h"
+
 #include <g4detectors/PHG4Cell.h>
 #include <g4detectors/PHG4CellContainer.h>
 #include <g4detectors/PHG4CylinderCellGeom.h>
@@ -12,7 +14,6 @@
 
 #include <TFile.h>
 #include <TH1.h>
-#include <TNtuple.h>
 
 #include <cassert>
 #include <cmath>     // for isfinite
@@ -22,6 +23,18 @@
 
 using namespace std;
 
+namespace
+{
+  enum CellColumn
+  {
+    kDetId,
+    kLayer,
+    kPhi,
+    kEta,
+    kEdep
+  };
+}  // namespace
+
 G4CellNtuple::G4CellNtuple(const std::string &name, const std::string &filename)
   : SubsysReco(name)
   , nblocks(0)
@@ -29,12 +42,13 @@ G4CellNtuple::G4CellNtuple(const std::string &name, const std::string &filename)
   , _filename(filename)
   , ntup(nullptr)
   , outfile(nullptr)
+  , m_BackgroundFlush(false)
 {
 }
 
 G4CellNtuple::~G4CellNtuple()
 {
-  //  delete ntup;
+  delete ntup;
   delete hm;
 }
 
@@ -42,7 +56,13 @@ int G4CellNtuple::Init(PHCompositeNode *)
 {
   hm = new Fun4AllHistoManager(Name());
   outfile = new TFile(_filename.c_str(), "RECREATE");
-  ntup = new TNtuple("cellntup", "G4Cells", "detid:layer:phi:eta:edep");
+  ntup = new G4ColumnWriter("cellntup", "G4Cells");
+  ntup->AddIntColumn("detid");
+  ntup->AddIntColumn("layer");
+  ntup->AddFloatColumn("phi");
+  ntup->AddFloatColumn("eta");
+  ntup->AddFloatColumn("edep");
+  ntup->SetBackgroundFlush(m_BackgroundFlush);
   //  ntup->SetDirectory(0);
   TH1 *h1 = new TH1F("edep1GeV", "edep 0-1GeV", 1000, 0, 1);
   eloss.push_back(h1);
@@ -79,8 +99,15 @@ int G4CellNtuple::process_event(PHCompositeNode *topNode)
       //          double numcells = cells->size();
       //          ncells[i]->Fill(numcells);
       //	  cout << "number of cells: " << cells->size() << endl;
+      // all cells of the container in one block of rows
+      size_t row = ntup->AppendRows(cells->size());
+      int *col_detid = ntup->IntColumn(kDetId);
+      int *col_layer = ntup->IntColumn(kLayer);
+      float *col_phi = ntup->FloatColumn(kPhi);
+      float *col_eta = ntup->FloatColumn(kEta);
+      float *col_edep = ntup->FloatColumn(kEdep);
       PHG4CellContainer::ConstRange cell_range = cells->getCells();
-      for (PHG4CellContainer::ConstIterator cell_iter = cell_range.first; cell_iter != cell_range.second; cell_iter++)
+      for (PHG4CellContainer::ConstIterator cell_iter = cell_range.first; cell_iter != cell_range.second; cell_iter++, row++)
 
       {
         double edep = cell_iter->second->get_edep();
@@ -115,11 +142,11 @@ int G4CellNtuple::process_event(PHCompositeNode *topNode)
           eta = cellgeom->get_zcenter(etabin);
         }
         assert(cellgeom != nullptr);
-        ntup->Fill(detid,
-                   cell_iter->second->get_layer(),
-                   phi,
-                   eta,
-                   cell_iter->second->get_edep());
+        col_detid[row] = detid;
+        col_layer[row] = layer;
+        col_phi[row] = phi;
+        col_eta[row] = eta;
+        col_edep[row] = edep;
       }
       for (eiter = eloss.begin(); eiter != eloss.end(); ++eiter)
       {
@@ -127,6 +154,7 @@ int G4CellNtuple::process_event(PHCompositeNode *topNode)
       }
     }
   }
+  ntup->Commit();
   return 0;
 }
 
@@ -10,10 +10,10 @@
 
 // Forward declerations
 class Fun4AllHistoManager;
+class G4ColumnWriter;
 class PHCompositeNode;
 class TFile;
 class TH1;
-class TNtuple;
 
 class G4CellNtuple : public SubsysReco
 {
@@ -35,6 +35,9 @@ class G4CellNtuple : public SubsysReco
 
   void AddNode(const std::string &name, const int detid = 0);
 
+  //! fill the ntuple in a separate thread
+  void SetBackgroundFlush(const bool b) { m_BackgroundFlush = b; }
+
  protected:
   int nblocks;
   Fun4AllHistoManager *hm;
@@ -44,8 +47,9 @@ class G4CellNtuple : public SubsysReco
   std::string _filename;
   std::set<std::string> _node_postfix;
   std::map<std::string, int> _detid;
-  TNtuple *ntup;
+  G4ColumnWriter *ntup;
   TFile *outfile;
+  bool m_BackgroundFlush;
 };
 
 #endif
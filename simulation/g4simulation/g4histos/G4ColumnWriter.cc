@@ -0,0 +1,231 @@
+#include "G4ColumnWriter.h"
+
+#include <TROOT.h>
+#include <TTree.h>
+
+#include <phool/phool.h>
+
+#include <iostream>
+
+using namespace std;
+
+namespace
+{
+  //! committed events the flush thread may lag behind
+  const size_t max_queued_blocks = 4;
+}  // namespace
+
+G4ColumnWriter::G4ColumnWriter(const string &name, const string &title)
+  : m_Tree(new TTree(name.c_str(), title.c_str()))
+  , m_Current(nullptr)
+  , m_BackgroundFlush(false)
+  , m_StopFlush(false)
+{
+}
+
+G4ColumnWriter::~G4ColumnWriter()
+{
+  StopFlush();
+  delete m_Current;
+  for (auto block : m_Queue)
+  {
+    delete block;
+  }
+  for (auto block : m_Free)
+  {
+    delete block;
+  }
+  // the tree belongs to its directory
+}
+
+unsigned int G4ColumnWriter::AddFloatColumn(const string &name)
+{
+  return AddColumn(name, true);
+}
+
+unsigned int G4ColumnWriter::AddIntColumn(const string &name)
+{
+  return AddColumn(name, false);
+}
+
+unsigned int G4ColumnWriter::AddColumn(const string &name, const bool isfloat)
+{
+  if (m_Current)
+  {
+    cout << PHWHERE << " column " << name << " added after the first row, ignored" << endl;
+    return 0;
+  }
+  m_ColumnIndex.push_back(isfloat ? m_FloatRow.size() : m_IntRow.size());
+  if (isfloat)
+  {
+    m_FloatRow.push_back(0);
+  }
+  else
+  {
+    m_IntRow.push_back(0);
+  }
+  m_ColumnNames.push_back(name);
+  m_ColumnIsFloat.push_back(isfloat);
+  return m_ColumnNames.size() - 1;
+}
+
+void G4ColumnWriter::SetBackgroundFlush(const bool b)
+{
+  if (!b)
+  {
+    StopFlush();
+  }
+  m_BackgroundFlush = b;
+}
+
+void G4ColumnWriter::MakeBranches()
+{
+  // the row buffers do not grow anymore, their addresses are the branch addresses
+  for (unsigned int i = 0; i < m_ColumnNames.size(); ++i)
+  {
+    const string &name = m_ColumnNames[i];
+    if (m_ColumnIsFloat[i])
+    {
+      m_Tree->Branch(name.c_str(), &m_FloatRow[m_ColumnIndex[i]], (name + "/F").c_str());
+    }
+    else
+    {
+      m_Tree->Branch(name.c_str(), &m_IntRow[m_ColumnIndex[i]], (name + "/I").c_str());
+    }
+  }
+  m_Current = NewBlock();
+}
+
+G4ColumnWriter::Block *G4ColumnWriter::NewBlock() const
+{
+  Block *block = new Block();
+  block->floats.resize(m_FloatRow.size());
+  block->ints.resize(m_IntRow.size());
+  block->nrows = 0;
+  return block;
+}
+
+size_t G4ColumnWriter::AppendRows(const size_t n)
+{
+  if (!m_Current)
+  {
+    MakeBranches();
+  }
+  const size_t first = m_Current->nrows;
+  m_Current->nrows += n;
+  for (auto &column : m_Current->floats)
+  {
+    column.resize(m_Current->nrows);
+  }
+  for (auto &column : m_Current->ints)
+  {
+    column.resize(m_Current->nrows);
+  }
+  return first;
+}
+
+void G4ColumnWriter::Commit()
+{
+  if (!m_Current || m_Current->nrows == 0)
+  {
+    return;
+  }
+  if (!m_BackgroundFlush)
+  {
+    Flush(m_Current);
+    return;
+  }
+
+  if (!m_Flusher.joinable())
+  {
+    // the flush thread uses ROOT concurrently with the event loop
+    ROOT::EnableThreadSafety();
+    m_StopFlush = false;
+    m_Flusher = thread(&G4ColumnWriter::FlushLoop, this);
+  }
+  Block *next = nullptr;
+  {
+    unique_lock<mutex> lock(m_QueueMutex);
+    m_QueueCondition.wait(lock, [this] { return m_Queue.size() < max_queued_blocks; });
+    m_Queue.push_back(m_Current);
+    if (!m_Free.empty())
+    {
+      next = m_Free.back();
+      m_Free.pop_back();
+    }
+  }
+  m_QueueCondition.notify_all();
+  m_Current = (next ? next : NewBlock());
+}
+
+void G4ColumnWriter::Flush(Block *block)
+{
+  for (size_t row = 0; row < block->nrows; ++row)
+  {
+    for (unsigned int i = 0; i < block->floats.size(); ++i)
+    {
+      m_FloatRow[i] = block->floats[i][row];
+    }
+    for (unsigned int i = 0; i < block->ints.size(); ++i)
+    {
+      m_IntRow[i] = block->ints[i][row];
+    }
+    m_Tree->Fill();
+  }
+  // keep the capacity for the next event
+  block->nrows = 0;
+  for (auto &column : block->floats)
+  {
+    column.clear();
+  }
+  for (auto &column : block->ints)
+  {
+    column.clear();
+  }
+}
+
+void G4ColumnWriter::FlushLoop()
+{
+  while (true)
+  {
+    Block *block = nullptr;
+    {
+      unique_lock<mutex> lock(m_QueueMutex);
+      m_QueueCondition.wait(lock, [this] { return !m_Queue.empty() || m_StopFlush; });
+      if (m_Queue.empty())
+      {
+        return;
+      }
+      block = m_Queue.front();
+    }
+    Flush(block);
+    {
+      lock_guard<mutex> lock(m_QueueMutex);
+      m_Queue.pop_front();
+      m_Free.push_back(block);
+    }
+    m_QueueCondition.notify_all();
+  }
+}
+
+void G4ColumnWriter::StopFlush()
+{
+  if (!m_Flusher.joinable())
+  {
+    return;
+  }
+  {
+    // the queue is flushed before the thread ends
+    lock_guard<mutex> lock(m_QueueMutex);
+    m_StopFlush = true;
+  }
+  m_QueueCondition.notify_all();
+  m_Flusher.join();
+}
+
+void G4ColumnWriter::Write()
+{
+  Commit();
+  StopFlush();
+  m_Tree->Write();
+}
@@ -0,0 +1,98 @@
+// Tell emacs that this is a C++ source
+//  -*- C++ -*-.
+#ifndef G4HISTOS_G4COLUMNWRITER_H
+#define G4HISTOS_G4COLUMNWRITER_H
+
+#include <cstddef>
+#include <string>
+#include <vector>
+
+#if !defined(__CINT__) || defined(__CLING__)
+#include <condition_variable>
+#include <deque>
+#include <mutex>
+#include <thread>
+#endif
+
+class TTree;
+
+/**
+ * Flat TTree with typed (float or int) columns, one entry per row, used by
+ * the g4histos ntuple modules instead of TNtuple.
+ *
+ * The rows of an event are filled column by column into plain arrays: a
+ * module appends the rows of a whole container with AppendRows() and
+ * writes the values through FloatColumn()/IntColumn(), Commit() hands the
+ * rows to the tree. With SetBackgroundFlush(true) the TTree::Fill() calls
+ * and the basket compression run in a separate thread while the next event
+ * is filled, at most a few events are queued.
+ *
+ * The tree is created in the current directory, like a TNtuple.
+ */
+class G4ColumnWriter
+{
+ public:
+  G4ColumnWriter(const std::string &name, const std::string &title);
+  ~G4ColumnWriter();
+
+  //! columns have to be added before the first row, returns the column index
+  unsigned int AddFloatColumn(const std::string &name);
+  unsigned int AddIntColumn(const std::string &name);
+
+  //! fill the tree in a separate thread
+  void SetBackgroundFlush(const bool b);
+
+  //! appends n rows to the current event, returns the index of the first
+  size_t AppendRows(const size_t n);
+  //! values of a column for all rows of the current event
+  float *FloatColumn(const unsigned int column) { return m_Current->floats[m_ColumnIndex[column]].data(); }
+  int *IntColumn(const unsigned int column) { return m_Current->ints[m_ColumnIndex[column]].data(); }
+
+  //! hands the rows of the current event to the tree
+  void Commit();
+
+  //! commits, waits for the flush and writes the tree into its directory
+  void Write();
+
+  TTree *GetTree() const { return m_Tree; }
+
+ private:
+  //! the rows of one event, one vector per column
+  struct Block
+  {
+    std::vector<std::vector<float> > floats;
+    std::vector<std::vector<int> > ints;
+    size_t nrows;
+  };
+
+  unsigned int AddColumn(const std::string &name, const bool isfloat);
+  void MakeBranches();
+  Block *NewBlock() const;
+  void Flush(Block *block);
+  void FlushLoop();
+  void StopFlush();
+
+  TTree *m_Tree;
+  //! position of each column in the float or int columns
+  std::vector<unsigned int> m_ColumnIndex;
+  //! branch buffers of the float and int columns
+  std::vector<float> m_FloatRow;
+  std::vector<int> m_IntRow;
+  std::vector<std::string> m_ColumnNames;
+  std::vector<bool> m_ColumnIsFloat;
+
+  Block *m_Current;
+  bool m_BackgroundFlush;
+#if !defined(__CINT__) || defined(__CLING__)
+  //! committed blocks waiting for the flush thread (front is being flushed)
+  std::deque<Block *> m_Queue;
+  //! flushed blocks for reuse
+  std::vector<Block *> m_Free;
+  std::mutex m_QueueMutex;
+  std::condition_variable m_QueueCondition;
+  std::thread m_Flusher;
+  bool m_StopFlush;
+#endif
+};
+
+#endif  // G4HISTOS_G4COLUMNWRITER_H
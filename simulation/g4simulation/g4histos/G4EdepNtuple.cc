@@ -1,5 +1,7 @@
 #include "G4EdepNtuple.h"
 
+#include "G4ColumnWriter.h"
+
 #include <g4main/PHG4Hit.h>
 #include <g4main/PHG4HitContainer.h>
 
@@ -9,13 +11,22 @@
 #include <phool/getClass.h>
 
 #include <TFile.h>
-#include <TNtuple.h>
 
 #include <sstream>
 #include <utility>                        // for pair
 
 using namespace std;
 
+namespace
+{
+  enum EdepColumn
+  {
+    kDetId,
+    kLayer,
+    kEdep
+  };
+}  // namespace
+
 G4EdepNtuple::G4EdepNtuple(const std::string &name, const std::string &filename)
   : SubsysReco(name)
   , nblocks(0)
@@ -23,11 +34,13 @@ G4EdepNtuple::G4EdepNtuple(const std::string &name, const std::string &filename)
   , _filename(filename)
   , ntup(nullptr)
   , outfile(nullptr)
+  , m_BackgroundFlush(false)
 {
 }
 
 G4EdepNtuple::~G4EdepNtuple()
 {
+  delete ntup;
   delete hm;
 }
 
@@ -35,7 +48,11 @@ int G4EdepNtuple::Init(PHCompositeNode *)
 {
   hm = new Fun4AllHistoManager(Name());
   outfile = new TFile(_filename.c_str(), "RECREATE");
-  ntup = new TNtuple("edepntup", "G4Edeps", "detid:layer:edep");
+  ntup = new G4ColumnWriter("edepntup", "G4Edeps");
+  ntup->AddIntColumn("detid");
+  ntup->AddIntColumn("layer");
+  ntup->AddFloatColumn("edep");
+  ntup->SetBackgroundFlush(m_BackgroundFlush);
   return 0;
 }
 
@@ -64,13 +81,23 @@ int G4EdepNtuple::process_event(PHCompositeNode *topNode)
         layer_edep_map[hit_iter->second->get_layer()] += hit_iter->second->get_edep();
         esum += hit_iter->second->get_edep();
       }
-      for (edepiter = layer_edep_map.begin(); edepiter != layer_edep_map.end(); ++edepiter)
+      size_t row = ntup->AppendRows(layer_edep_map.size() + 1);
+      int *col_detid = ntup->IntColumn(kDetId);
+      int *col_layer = ntup->IntColumn(kLayer);
+      float *col_edep = ntup->FloatColumn(kEdep);
+      for (edepiter = layer_edep_map.begin(); edepiter != layer_edep_map.end(); ++edepiter, ++row)
       {
-        ntup->Fill(detid, edepiter->first, edepiter->second);
+        col_detid[row] = detid;
+        col_layer[row] = edepiter->first;
+        col_edep[row] = edepiter->second;
       }
-      ntup->Fill(detid, -1, esum);  // fill sum over all layers for each detector
+      // fill sum over all layers for each detector
+      col_detid[row] = detid;
+      col_layer[row] = -1;
+      col_edep[row] = esum;
     }
   }
+  ntup->Commit();
   return 0;
 }
 
@@ -9,9 +9,9 @@
 
 // Forward declerations
 class Fun4AllHistoManager;
+class G4ColumnWriter;
 class PHCompositeNode;
 class TFile;
-class TNtuple;
 
 class G4EdepNtuple : public SubsysReco
 {
@@ -33,14 +33,18 @@ class G4EdepNtuple : public SubsysReco
 
   void AddNode(const std::string &name, const int detid = 0);
 
+  //! fill the ntuple in a separate thread
+  void SetBackgroundFlush(const bool b) { m_BackgroundFlush = b; }
+
  protected:
   int nblocks;
   Fun4AllHistoManager *hm;
   std::string _filename;
   std::set<std::string> _node_postfix;
   std::map<std::string, int> _detid;
-  TNtuple *ntup;
+  G4ColumnWriter *ntup;
   TFile *outfile;
+  bool m_BackgroundFlush;
 };
 
 #endif
@@ -1,5 +1,7 @@
 #include "G4HitNtuple.h"
 
+#include "G4ColumnWriter.h"
+
 #include <g4main/PHG4Hit.h>
 #include <g4main/PHG4HitContainer.h>
 
@@ -10,13 +12,29 @@
 
 #include <TFile.h>
 #include <TH1.h>
-#include <TNtuple.h>
 
 #include <sstream>
 #include <utility>                        // for pair
 
 using namespace std;
 
+namespace
+{
+  enum HitColumn
+  {
+    kDetId,
+    kLayer,
+    kSlat,
+    kX0,
+    kY0,
+    kZ0,
+    kX1,
+    kY1,
+    kZ1,
+    kEdep
+  };
+}  // namespace
+
 G4HitNtuple::G4HitNtuple(const std::string &name, const std::string &filename)
   : SubsysReco(name)
   , nblocks(0)
@@ -24,12 +42,13 @@ G4HitNtuple::G4HitNtuple(const std::string &name, const std::string &filename)
   , _filename(filename)
   , ntup(nullptr)
   , outfile(nullptr)
+  , m_BackgroundFlush(false)
 {
 }
 
 G4HitNtuple::~G4HitNtuple()
 {
-  //  delete ntup;
+  delete ntup;
   delete hm;
 }
 
@@ -37,7 +56,18 @@ int G4HitNtuple::Init(PHCompositeNode *)
 {
   hm = new Fun4AllHistoManager(Name());
   outfile = new TFile(_filename.c_str(), "RECREATE");
-  ntup = new TNtuple("hitntup", "G4Hits", "detid:lyr:slat:x0:y0:z0:x1:y1:z1:edep");
+  ntup = new G4ColumnWriter("hitntup", "G4Hits");
+  ntup->AddIntColumn("detid");
+  ntup->AddIntColumn("lyr");
+  ntup->AddIntColumn("slat");
+  ntup->AddFloatColumn("x0");
+  ntup->AddFloatColumn("y0");
+  ntup->AddFloatColumn("z0");
+  ntup->AddFloatColumn("x1");
+  ntup->AddFloatColumn("y1");
+  ntup->AddFloatColumn("z1");
+  ntup->AddFloatColumn("edep");
+  ntup->SetBackgroundFlush(m_BackgroundFlush);
   //  ntup->SetDirectory(0);
   TH1 *h1 = new TH1F("edep1GeV", "edep 0-1GeV", 1000, 0, 1);
   eloss.push_back(h1);
@@ -62,21 +92,34 @@ int G4HitNtuple::process_event(PHCompositeNode *topNode)
       double esum = 0;
       //          double numhits = hits->size();
       //          nhits[i]->Fill(numhits);
+      // all hits of the container in one block of rows
+      size_t row = ntup->AppendRows(hits->size());
+      int *col_detid = ntup->IntColumn(kDetId);
+      int *col_layer = ntup->IntColumn(kLayer);
+      int *col_slat = ntup->IntColumn(kSlat);
+      float *col_x0 = ntup->FloatColumn(kX0);
+      float *col_y0 = ntup->FloatColumn(kY0);
+      float *col_z0 = ntup->FloatColumn(kZ0);
+      float *col_x1 = ntup->FloatColumn(kX1);
+      float *col_y1 = ntup->FloatColumn(kY1);
+      float *col_z1 = ntup->FloatColumn(kZ1);
+      float *col_edep = ntup->FloatColumn(kEdep);
       PHG4HitContainer::ConstRange hit_range = hits->getHits();
-      for (PHG4HitContainer::ConstIterator hit_iter = hit_range.first; hit_iter != hit_range.second; hit_iter++)
+      for (PHG4HitContainer::ConstIterator hit_iter = hit_range.first; hit_iter != hit_range.second; hit_iter++, row++)
 
       {
-        esum += hit_iter->second->get_edep();
-        ntup->Fill(detid,
-                   hit_iter->second->get_layer(),
-                   hit_iter->second->get_scint_id(),
-                   hit_iter->second->get_x(0),
-                   hit_iter->second->get_y(0),
-                   hit_iter->second->get_z(0),
-                   hit_iter->second->get_x(1),
-                   hit_iter->second->get_y(1),
-                   hit_iter->second->get_z(1),
-                   hit_iter->second->get_edep());
+        const PHG4Hit *hit = hit_iter->second;
+        esum += hit->get_edep();
+        col_detid[row] = detid;
+        col_layer[row] = hit->get_layer();
+        col_slat[row] = hit->get_scint_id();
+        col_x0[row] = hit->get_x(0);
+        col_y0[row] = hit->get_y(0);
+        col_z0[row] = hit->get_z(0);
+        col_x1[row] = hit->get_x(1);
+        col_y1[row] = hit->get_y(1);
+        col_z1[row] = hit->get_z(1);
+        col_edep[row] = hit->get_edep();
       }
       for (eiter = eloss.begin(); eiter != eloss.end(); ++eiter)
       {
@@ -84,6 +127,7 @@ int G4HitNtuple::process_event(PHCompositeNode *topNode)
       }
     }
   }
+  ntup->Commit();
   return 0;
 }
 
@@ -1,5 +1,7 @@
 #include "G4SnglNtuple.h"
 
+#include "G4ColumnWriter.h"
+
 #include <g4main/PHG4Hit.h>
 #include <g4main/PHG4HitContainer.h>
 #include <g4main/PHG4Particle.h>
@@ -12,7 +14,6 @@
 
 #include <TFile.h>
 #include <TH1.h>
-#include <TNtuple.h>
 
 #include <cmath>                           // for atan2, sqrt
 #include <sstream>
@@ -20,6 +21,35 @@
 
 using namespace std;
 
+namespace
+{
+  enum SnglColumn
+  {
+    kPhi,
+    kTheta,
+    kE,
+    kDetId,
+    kLayer,
+    kX0,
+    kY0,
+    kZ0,
+    kX1,
+    kY1,
+    kZ1,
+    kEdep
+  };
+
+  enum SnglEdepColumn
+  {
+    kEdepPhi,
+    kEdepTheta,
+    kEdepE,
+    kEdepDetId,
+    kEdepLayer,
+    kEdepEdep
+  };
+}  // namespace
+
 G4SnglNtuple::G4SnglNtuple(const std::string &name, const std::string &filename)
   : SubsysReco(name)
   , nblocks(0)
@@ -28,12 +58,14 @@ G4SnglNtuple::G4SnglNtuple(const std::string &name, const std::string &filename)
   , ntup(nullptr)
   , ntup_e(nullptr)
   , outfile(nullptr)
+  , m_BackgroundFlush(false)
 {
 }
 
 G4SnglNtuple::~G4SnglNtuple()
 {
-  //  delete ntup;
+  delete ntup;
+  delete ntup_e;
   delete hm;
 }
 
@@ -41,8 +73,28 @@ int G4SnglNtuple::Init(PHCompositeNode *)
 {
   hm = new Fun4AllHistoManager(Name());
   outfile = new TFile(_filename.c_str(), "RECREATE");
-  ntup = new TNtuple("snglntup", "G4Sngls", "phi:theta:e:detid:layer:x0:y0:z0:x1:y1:z1:edep");
-  ntup_e = new TNtuple("sngl_e", "G4SnglEdeps", "phi:theta:e:detid:layer:edep");
+  ntup = new G4ColumnWriter("snglntup", "G4Sngls");
+  ntup->AddFloatColumn("phi");
+  ntup->AddFloatColumn("theta");
+  ntup->AddFloatColumn("e");
+  ntup->AddIntColumn("detid");
+  ntup->AddIntColumn("layer");
+  ntup->AddFloatColumn("x0");
+  ntup->AddFloatColumn("y0");
+  ntup->AddFloatColumn("z0");
+  ntup->AddFloatColumn("x1");
+  ntup->AddFloatColumn("y1");
+  ntup->AddFloatColumn("z1");
+  ntup->AddFloatColumn("edep");
+  ntup->SetBackgroundFlush(m_BackgroundFlush);
+  ntup_e = new G4ColumnWriter("sngl_e", "G4SnglEdeps");
+  ntup_e->AddFloatColumn("phi");
+  ntup_e->AddFloatColumn("theta");
+  ntup_e->AddFloatColumn("e");
+  ntup_e->AddIntColumn("detid");
+  ntup_e->AddIntColumn("layer");
+  ntup_e->AddFloatColumn("edep");
+  ntup_e->SetBackgroundFlush(m_BackgroundFlush);
   //  ntup->SetDirectory(0);
   TH1 *h1 = new TH1F("edep1GeV", "edep 0-1GeV", 1000, 0, 1);
   eloss.push_back(h1);
@@ -82,26 +134,63 @@ int G4SnglNtuple::process_event(PHCompositeNode *topNode)
     if (hits)
     {
       double esum = 0;
+      // all hits of the container in one block of rows
+      size_t row = ntup->AppendRows(hits->size());
+      float *col_phi = ntup->FloatColumn(kPhi);
+      float *col_theta = ntup->FloatColumn(kTheta);
+      float *col_e = ntup->FloatColumn(kE);
+      int *col_detid = ntup->IntColumn(kDetId);
+      int *col_layer = ntup->IntColumn(kLayer);
+      float *col_x0 = ntup->FloatColumn(kX0);
+      float *col_y0 = ntup->FloatColumn(kY0);
+      float *col_z0 = ntup->FloatColumn(kZ0);
+      float *col_x1 = ntup->FloatColumn(kX1);
+      float *col_y1 = ntup->FloatColumn(kY1);
+      float *col_z1 = ntup->FloatColumn(kZ1);
+      float *col_edep = ntup->FloatColumn(kEdep);
       PHG4HitContainer::ConstRange hit_range = hits->getHits();
-      for (PHG4HitContainer::ConstIterator hit_iter = hit_range.first; hit_iter != hit_range.second; hit_iter++)
+      for (PHG4HitContainer::ConstIterator hit_iter = hit_range.first; hit_iter != hit_range.second; hit_iter++, row++)
       {
-        layer_edep_map[hit_iter->second->get_layer()] += hit_iter->second->get_edep();
-        esum += hit_iter->second->get_edep();
-        ntup->Fill(phi, theta, e, detid,
-                   hit_iter->second->get_detid(),
-                   hit_iter->second->get_x(0),
-                   hit_iter->second->get_y(0),
-                   hit_iter->second->get_z(0),
-                   hit_iter->second->get_x(1),
-                   hit_iter->second->get_y(1),
-                   hit_iter->second->get_z(1),
-                   hit_iter->second->get_edep());
+        const PHG4Hit *hit = hit_iter->second;
+        layer_edep_map[hit->get_layer()] += hit->get_edep();
+        esum += hit->get_edep();
+        col_phi[row] = phi;
+        col_theta[row] = theta;
+        col_e[row] = e;
+        col_detid[row] = detid;
+        col_layer[row] = hit->get_detid();
+        col_x0[row] = hit->get_x(0);
+        col_y0[row] = hit->get_y(0);
+        col_z0[row] = hit->get_z(0);
+        col_x1[row] = hit->get_x(1);
+        col_y1[row] = hit->get_y(1);
+        col_z1[row] = hit->get_z(1);
+        col_edep[row] = hit->get_edep();
       }
-      for (edepiter = layer_edep_map.begin(); edepiter != layer_edep_map.end(); ++edepiter)
+
+      row = ntup_e->AppendRows(layer_edep_map.size() + 1);
+      float *col_e_phi = ntup_e->FloatColumn(kEdepPhi);
+      float *col_e_theta = ntup_e->FloatColumn(kEdepTheta);
+      float *col_e_e = ntup_e->FloatColumn(kEdepE);
+      int *col_e_detid = ntup_e->IntColumn(kEdepDetId);
+      int *col_e_layer = ntup_e->IntColumn(kEdepLayer);
+      float *col_e_edep = ntup_e->FloatColumn(kEdepEdep);
+      for (edepiter = layer_edep_map.begin(); edepiter != layer_edep_map.end(); ++edepiter, ++row)
       {
-        ntup_e->Fill(phi, theta, e, detid, edepiter->first, edepiter->second);
+        col_e_phi[row] = phi;
+        col_e_theta[row] = theta;
+        col_e_e[row] = e;
+        col_e_detid[row] = detid;
+        col_e_layer[row] = edepiter->first;
+        col_e_edep[row] = edepiter->second;
       }
-      ntup_e->Fill(phi, theta, e, detid, -1, esum);  // fill sum over all layers for each detector
+      // fill sum over all layers for each detector
+      col_e_phi[row] = phi;
+      col_e_theta[row] = theta;
+      col_e_e[row] = e;
+      col_e_detid[row] = detid;
+      col_e_layer[row] = -1;
+      col_e_edep[row] = esum;
 
       for (eiter = eloss.begin(); eiter != eloss.end(); ++eiter)
       {
@@ -109,6 +198,8 @@ int G4SnglNtuple::process_event(PHCompositeNode *topNode)
       }
     }
   }
+  ntup->Commit();
+  ntup_e->Commit();
   return 0;
 }
 
@@ -116,6 +207,7 @@ int G4SnglNtuple::End(PHCompositeNode *topNode)
 {
   outfile->cd();
   ntup->Write();
+  ntup_e->Write();
   outfile->Write();
   outfile->Close();
   delete outfile;
@@ -10,10 +10,10 @@
 
 // Forward declerations
 class Fun4AllHistoManager;
+class G4ColumnWriter;
 class PHCompositeNode;
 class TFile;
 class TH1;
-class TNtuple;
 
 class G4SnglNtuple : public SubsysReco
 {
@@ -35,6 +35,9 @@ class G4SnglNtuple : public SubsysReco
 
   void AddNode(const std::string &name, const int detid = 0);
 
+  //! fill the ntuple in a separate thread
+  void SetBackgroundFlush(const bool b) { m_BackgroundFlush = b; }
+
  protected:
   int nblocks;
   Fun4AllHistoManager *hm;
@@ -44,9 +47,10 @@ class G4SnglNtuple : public SubsysReco
   std::string _filename;
   std::set<std::string> _node_postfix;
   std::map<std::string, int> _detid;
-  TNtuple *ntup;
-  TNtuple *ntup_e;
+  G4ColumnWriter *ntup;
+  G4ColumnWriter *ntup_e;
   TFile *outfile;
+  bool m_BackgroundFlush;
 };
 
 #endif
@@ -1,5 +1,7 @@
 #include "G4TowerNtuple.h"
 
+#include "G4ColumnWriter.h"
+
 #include <calobase/RawTower.h>
 #include <calobase/RawTowerContainer.h>
 #include <calobase/RawTowerGeomContainer.h>
@@ -11,7 +13,6 @@
 
 #include <TFile.h>
 #include <TH1.h>
-#include <TNtuple.h>
 
 #include <cmath>                             // for isfinite
 #include <iostream>                          // for operator<<, basic_ostream
@@ -20,6 +21,17 @@
 
 using namespace std;
 
+namespace
+{
+  enum TowerColumn
+  {
+    kDetId,
+    kPhi,
+    kEta,
+    kEnergy
+  };
+}  // namespace
+
 G4TowerNtuple::G4TowerNtuple(const std::string &name, const std::string &filename)
   : SubsysReco(name)
   , nblocks(0)
@@ -27,12 +39,13 @@ G4TowerNtuple::G4TowerNtuple(const std::string &name, const std::string &filenam
   , _filename(filename)
   , ntup(nullptr)
   , outfile(nullptr)
+  , m_BackgroundFlush(false)
 {
 }
 
 G4TowerNtuple::~G4TowerNtuple()
 {
-  //  delete ntup;
+  delete ntup;
   delete hm;
 }
 
@@ -40,7 +53,12 @@ int G4TowerNtuple::Init(PHCompositeNode *)
 {
   hm = new Fun4AllHistoManager(Name());
   outfile = new TFile(_filename.c_str(), "RECREATE");
-  ntup = new TNtuple("towerntup", "G4Towers", "detid:phi:eta:energy");
+  ntup = new G4ColumnWriter("towerntup", "G4Towers");
+  ntup->AddIntColumn("detid");
+  ntup->AddFloatColumn("phi");
+  ntup->AddFloatColumn("eta");
+  ntup->AddFloatColumn("energy");
+  ntup->SetBackgroundFlush(m_BackgroundFlush);
   //  ntup->SetDirectory(0);
   TH1 *h1 = new TH1F("energy1GeV", "energy 0-1GeV", 1000, 0, 1);
   eloss.push_back(h1);
@@ -75,8 +93,14 @@ int G4TowerNtuple::process_event(PHCompositeNode *topNode)
       //          double numtowers = towers->size();
       //          ntowers[i]->Fill(numtowers);
       //	  cout << "number of towers: " << towers->size() << endl;
+      // all towers of the container in one block of rows
+      size_t row = ntup->AppendRows(towers->size());
+      int *col_detid = ntup->IntColumn(kDetId);
+      float *col_phi = ntup->FloatColumn(kPhi);
+      float *col_eta = ntup->FloatColumn(kEta);
+      float *col_energy = ntup->FloatColumn(kEnergy);
       RawTowerContainer::ConstRange tower_range = towers->getTowers();
-      for (RawTowerContainer::ConstIterator tower_iter = tower_range.first; tower_iter != tower_range.second; tower_iter++)
+      for (RawTowerContainer::ConstIterator tower_iter = tower_range.first; tower_iter != tower_range.second; tower_iter++, row++)
 
       {
         double energy = tower_iter->second->get_energy();
@@ -90,10 +114,10 @@ int G4TowerNtuple::process_event(PHCompositeNode *topNode)
         // to search the map fewer times, cache the geom object until the layer changes
         double phi = towergeom->get_phicenter(phibin);
         double eta = towergeom->get_etacenter(etabin);
-        ntup->Fill(detid,
-                   phi,
-                   eta,
-                   tower_iter->second->get_energy());
+        col_detid[row] = detid;
+        col_phi[row] = phi;
+        col_eta[row] = eta;
+        col_energy[row] = energy;
       }
       for (eiter = eloss.begin(); eiter != eloss.end(); ++eiter)
       {
@@ -101,6 +125,7 @@ int G4TowerNtuple::process_event(PHCompositeNode *topNode)
       }
     }
   }
+  ntup->Commit();
   return 0;
 }
 
@@ -10,10 +10,10 @@
 
 // Forward declerations
 class Fun4AllHistoManager;
+class G4ColumnWriter;
 class PHCompositeNode;
 class TFile;
 class TH1;
-class TNtuple;
 
 class G4TowerNtuple : public SubsysReco
 {
@@ -35,6 +35,9 @@ class G4TowerNtuple : public SubsysReco
 
   void AddNode(const std::string &name, const std::string &twrtype, const int detid);
 
+  //! fill the ntuple in a separate thread
+  void SetBackgroundFlush(const bool b) { m_BackgroundFlush = b; }
+
  protected:
   int nblocks;
   Fun4AllHistoManager *hm;
@@ -45,8 +48,9 @@ class G4TowerNtuple : public SubsysReco
   std::set<std::string> _node_postfix;
   std::map<std::string, std::string> _tower_type;
   std::map<std::string, int> _detid;
-  TNtuple *ntup;
+  G4ColumnWriter *ntup;
   TFile *outfile;
+  bool m_BackgroundFlush;
 };
 
 #endif
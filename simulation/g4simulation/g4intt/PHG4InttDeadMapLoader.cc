@@ -16,6 +16,7 @@
 #include <phparameter/PHParameters.h>
 
 #include <fun4all/Fun4AllReturnCodes.h>
+#include <fun4all/Fun4AllServer.h>
 #include <fun4all/SubsysReco.h>                // for SubsysReco
 
 #include <phool/PHCompositeNode.h>
@@ -43,6 +44,7 @@
 #include <cassert>
 #include <iostream>
 #include <map>
+#include <memory>
 #include <stdexcept>
 #include <string>
 #include <utility>                             // for pair
@@ -59,6 +61,28 @@ PHG4InttDeadMapLoader::~PHG4InttDeadMapLoader()
 {
 }
 
+string PHG4InttDeadMapLoader::CalibrationKey(const unsigned int layer) const
+{
+  return Name() + "_DEADMAP_" + to_string(layer);
+}
+
+int PHG4InttDeadMapLoader::Init(PHCompositeNode * /*topNode*/)
+{
+  // the dead map files are read together with all other calibrations at BeginRun
+  Fun4AllServer *se = Fun4AllServer::instance();
+  for (const auto pathiter : m_deadMapPathMap)
+  {
+    const string detector = m_detector;
+    const string deadMapPath = pathiter.second;
+    se->registerCalibrationRequest(CalibrationKey(pathiter.first), [detector, deadMapPath](const int /*runnumber*/) {
+      PHParameters *deadMapParam = new PHParameters(detector);
+      deadMapParam->ReadFromFile(detector, "xml", 0, 0, deadMapPath);
+      return static_cast<PHObject *>(deadMapParam);
+    });
+  }
+  return Fun4AllReturnCodes::EVENT_OK;
+}
+
 int PHG4InttDeadMapLoader::InitRun(PHCompositeNode *topNode)
 {
   PHNodeIterator topiter(topNode);
@@ -91,6 +115,7 @@ int PHG4InttDeadMapLoader::InitRun(PHCompositeNode *topNode)
 
   assert(deadmap);
 
+  Fun4AllServer *se = Fun4AllServer::instance();
   for (const auto pathiter : m_deadMapPathMap)
   {
     const unsigned int ilayer = pathiter.first;
@@ -98,10 +123,17 @@ int PHG4InttDeadMapLoader::InitRun(PHCompositeNode *topNode)
 
     int counter = 0;
 
-    PHParameters deadMapParam(m_detector);
-    deadMapParam.ReadFromFile(m_detector, "xml", 0, 0, deadMapPath);
+    // prefetched by the Fun4AllServer, read it here if that did not work
+    PHParameters *deadMapParam = dynamic_cast<PHParameters *>(se->getCalibration(CalibrationKey(ilayer)));
+    unique_ptr<PHParameters> localParam;
+    if (!deadMapParam)
+    {
+      localParam.reset(new PHParameters(m_detector));
+      localParam->ReadFromFile(m_detector, "xml", 0, 0, deadMapPath);
+      deadMapParam = localParam.get();
+    }
 
-    const auto in_par_ranges = deadMapParam.get_all_int_params();
+    const auto in_par_ranges = deadMapParam->get_all_int_params();
 
     for (auto iter = in_par_ranges.first; iter != in_par_ranges.second; ++iter)
     {
@@ -28,6 +28,9 @@ class PHG4InttDeadMapLoader : public SubsysReco
 
   virtual ~PHG4InttDeadMapLoader();
 
+  //! registers the dead maps with the calibration prefetch of the Fun4AllServer
+  virtual int Init(PHCompositeNode* topNode);
+
   virtual int InitRun(PHCompositeNode* topNode);
 
   void deadMapPath(unsigned int layer, const std::string& deadMapPath)
@@ -46,6 +49,8 @@ class PHG4InttDeadMapLoader : public SubsysReco
   }
 
  private:
+  std::string CalibrationKey(const unsigned int layer) const;
+
   std::map<unsigned int, std::string> m_deadMapPathMap;
 
   std::string m_detector;
@@ -3,6 +3,7 @@
 #include "PHG4InttDefs.h"  // for SEGMENTATION_Z
 #include "PHG4InttDisplayAction.h"
 #include "PHG4InttFPHXParameterisation.h"
+#include "PHG4InttLadderParameterisation.h"
 
 #include <intt/CylinderGeomIntt.h>
 
@@ -40,7 +41,7 @@
 #include <Geant4/G4Tubs.hh>
 #include <Geant4/G4TwoVector.hh>        // for G4TwoVector
 #include <Geant4/G4VPhysicalVolume.hh>  // for G4VPhysicalVolume
-#include <Geant4/geomdefs.hh>           // for kZAxis
+#include <Geant4/geomdefs.hh>           // for kZAxis, kUndefined
 
 #include <boost/format.hpp>
 
@@ -935,6 +936,14 @@ int PHG4InttDetector::ConstructIntt(G4LogicalVolume *trackerenvelope)
       //    The type 0 ladders are more complicated because the sensor center is perpendicular to the radial vector and the sensor is not at the ladder center
       //         We made the stave box symmetric in y around the sensor center to simplify things
 
+      // All ladders of this layer and sensor type share one parameterised volume at negative and one at positive Z,
+      // the copy number is the ladder phi index. kUndefined lets them sit next to the other daughters of the envelope
+      PHG4InttLadderParameterisation *ladderparam_negz = new PHG4InttLadderParameterisation(-m_PosZ[inttlayer][itype]);
+      PHG4InttLadderParameterisation *ladderparam_posz = new PHG4InttLadderParameterisation(+m_PosZ[inttlayer][itype]);
+      // We have added the outer sensor above, the HDI extension tab goes to the end of the outer sensor HDI
+      const double posz_ext = (hdi_z_arr[inttlayer][0] + hdi_z) + hdiext_z / 2.;
+      PHG4InttLadderParameterisation *ladderextparam_negz = new PHG4InttLadderParameterisation(-posz_ext);
+      PHG4InttLadderParameterisation *ladderextparam_posz = new PHG4InttLadderParameterisation(+posz_ext);
       for (int icopy = 0; icopy < nladders_layer; icopy++)
       {
         // sensor center
@@ -959,40 +968,45 @@ int PHG4InttDetector::ConstructIntt(G4LogicalVolume *trackerenvelope)
         const double posx = radius * cos(phi - p);
         const double posy = radius * sin(phi - p);
         const double fRotate = p + (phi - p) + offsetrot;  // rotate in its own frame to make sensor perp to radial vector (p), then additionally rotate to account for ladder phi
-        G4RotationMatrix ladderrotation;
-        ladderrotation.rotateZ(fRotate);
-
-        // this placement version rotates the ladder in its own frame by fRotate, then translates the center to posx, posy, +/- m_PosZ
-        auto pointer_negz = new G4PVPlacement(G4Transform3D(ladderrotation, G4ThreeVector(posx, posy, -m_PosZ[inttlayer][itype])), ladder_volume,
-                                              (boost::format("ladder_%d_%d_%d_negz") % inttlayer % itype % icopy).str(), trackerenvelope, false, 0, OverlapCheck());
-        auto pointer_posz = new G4PVPlacement(G4Transform3D(ladderrotation, G4ThreeVector(posx, posy, +m_PosZ[inttlayer][itype])), ladder_volume,
-                                              (boost::format("ladder_%d_%d_%d_posz") % inttlayer % itype % icopy).str(), trackerenvelope, false, 0, OverlapCheck());
-        if (m_IsActiveMap.find(inttlayer) != m_IsActiveMap.end())
-        {
-          m_ActiveVolumeTuple.insert(make_pair(pointer_negz, make_tuple(inttlayer, itype, icopy, -1)));
-          m_ActiveVolumeTuple.insert(make_pair(pointer_posz, make_tuple(inttlayer, itype, icopy, 1)));
-        }
+
+        // the ladder is rotated in its own frame by fRotate, then the center is translated to posx, posy, +/- m_PosZ
+        ladderparam_negz->AddLadder(posx, posy, fRotate);
+        ladderparam_posz->AddLadder(posx, posy, fRotate);
+        ladderextparam_negz->AddLadder(posx, posy, fRotate);
+        ladderextparam_posz->AddLadder(posx, posy, fRotate);
 
         // The net effect of the above manipulations for the Z sensitive ladders is that the center of the sensor is at dphi * icopy and at the requested radius
         // That us all that the geometry object needs to know, so no changes to that are necessary
 
-        if (itype != 0)
-        {
-          // We have added the outer sensor above, now we add the HDI extension tab to the end of the outer sensor HDI
-          const double posz_ext = (hdi_z_arr[inttlayer][0] + hdi_z) + hdiext_z / 2.;
-
-          new G4PVPlacement(G4Transform3D(ladderrotation, G4ThreeVector(posx, posy, -posz_ext)), ladderext_volume,
-                            (boost::format("ladderext_%d_%d_%d_negz") % inttlayer % itype % icopy).str(), trackerenvelope, false, 0, OverlapCheck());
-          new G4PVPlacement(G4Transform3D(ladderrotation, G4ThreeVector(posx, posy, +posz_ext)), ladderext_volume,
-                            (boost::format("ladderext_%d_%d_%d_posz") % inttlayer % itype % icopy).str(), trackerenvelope, false, 0, OverlapCheck());
-        }
-
         if (Verbosity() > 100)
           cout << "   Ladder copy " << icopy << " radius " << radius << " phi " << phi << " itype " << itype << " posz " << m_PosZ[inttlayer][itype]
                << " fRotate " << fRotate << " posx " << posx << " posy " << posy
                << endl;
 
-      }  // end loop over ladder copy placement in phi and positive and negative Z
+      }  // end loop over ladder copy placement in phi
+
+      auto pointer_negz = new G4PVParameterised((boost::format("ladder_%d_%d_negz") % inttlayer % itype).str(), ladder_volume, trackerenvelope,
+                                                kUndefined, nladders_layer, ladderparam_negz, OverlapCheck());
+      auto pointer_posz = new G4PVParameterised((boost::format("ladder_%d_%d_posz") % inttlayer % itype).str(), ladder_volume, trackerenvelope,
+                                                kUndefined, nladders_layer, ladderparam_posz, OverlapCheck());
+      if (m_IsActiveMap.find(inttlayer) != m_IsActiveMap.end())
+      {
+        m_ActiveVolumeTuple.insert(make_pair(pointer_negz, make_tuple(inttlayer, itype, -1)));
+        m_ActiveVolumeTuple.insert(make_pair(pointer_posz, make_tuple(inttlayer, itype, 1)));
+      }
+      if (itype != 0)
+      {
+        new G4PVParameterised((boost::format("ladderext_%d_%d_negz") % inttlayer % itype).str(), ladderext_volume, trackerenvelope,
+                              kUndefined, nladders_layer, ladderextparam_negz, OverlapCheck());
+        new G4PVParameterised((boost::format("ladderext_%d_%d_posz") % inttlayer % itype).str(), ladderext_volume, trackerenvelope,
+                              kUndefined, nladders_layer, ladderextparam_posz, OverlapCheck());
+      }
+      else
+      {
+        // the inner sensor has no HDI extension
+        delete ladderextparam_negz;
+        delete ladderextparam_posz;
+      }
     }    // end loop over inner or outer sensor
   }      // end loop over layers
 
@@ -1290,7 +1304,7 @@ void PHG4InttDetector::AddGeometryNode()
   }
 }
 
-map<G4VPhysicalVolume *, std::tuple<int, int, int, int>>::const_iterator
+map<G4VPhysicalVolume *, std::tuple<int, int, int>>::const_iterator
 PHG4InttDetector::get_ActiveVolumeTuple(G4VPhysicalVolume *physvol) const
 {
   auto iter = m_ActiveVolumeTuple.find(physvol);
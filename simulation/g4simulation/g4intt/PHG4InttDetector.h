@@ -52,7 +52,8 @@ class PHG4InttDetector : public PHG4Detector
     return m_DetectorType;
   }
 
-  std::map<G4VPhysicalVolume *, std::tuple<int, int, int, int>>::const_iterator get_ActiveVolumeTuple(G4VPhysicalVolume *physvol) const;
+  //! layer, sensor type and z side (-1, +1) of the parameterised ladder volume, the ladder phi index is its copy number
+  std::map<G4VPhysicalVolume *, std::tuple<int, int, int>>::const_iterator get_ActiveVolumeTuple(G4VPhysicalVolume *physvol) const;
   std::map<G4LogicalVolume *, std::tuple<int, int>>::const_iterator get_PassiveVolumeTuple(G4LogicalVolume *logvol) const;
 
  private:
@@ -76,7 +77,7 @@ class PHG4InttDetector : public PHG4Detector
   std::map<int, int> m_IsActiveMap;
   std::map<int, int> m_IsAbsorberActiveMap;
   std::pair<std::vector<std::pair<int, int>>::const_iterator, std::vector<std::pair<int, int>>::const_iterator> m_LayerBeginEndIteratorPair;
-  std::map<G4VPhysicalVolume *, std::tuple<int, int, int, int>> m_ActiveVolumeTuple;
+  std::map<G4VPhysicalVolume *, std::tuple<int, int, int>> m_ActiveVolumeTuple;
   std::map<G4LogicalVolume *, std::tuple<int, int>> m_PassiveVolumeTuple;
 };
 
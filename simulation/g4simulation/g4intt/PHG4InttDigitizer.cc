@@ -4,6 +4,8 @@
 
 #include "InttDeadMap.h"
 
+#include <intt/CylinderGeomIntt.h>
+
 #include <g4detectors/PHG4CylinderGeom.h>
 #include <g4detectors/PHG4CylinderGeomContainer.h>
 
@@ -25,7 +27,7 @@
 #include <phool/PHCompositeNode.h>
 #include <phool/PHNode.h>                           // for PHNode
 #include <phool/PHNodeIterator.h>
-#include <phool/PHRandomSeed.h>
+#include <phool/PHCounterRng.h>
 #include <phool/getClass.h>
 #include <phool/phool.h>                            // for PHWHERE
 
@@ -52,17 +54,18 @@ PHG4InttDigitizer::PHG4InttDigitizer(const string &name)
   , mEnergyPerPair(3.62e-9)  // GeV/e-h
   , m_nCells(0)
   , m_nDeadCells(0)
+  , m_DeadMap(nullptr)
+  , m_GeomContainer(nullptr)
+  , m_FusedFlag(false)
 {
   InitializeParameters();
-  unsigned int seed = PHRandomSeed();  // fixed seed is handled in this funtcion
-  cout << Name() << " random seed: " << seed << endl;
-  RandomGenerator = gsl_rng_alloc(gsl_rng_mt19937);
-  gsl_rng_set(RandomGenerator, seed);
+  m_Rng = new PHCounterRng(Name());
+  RandomGenerator = m_Rng->get_gsl_rng();
 }
 
 PHG4InttDigitizer::~PHG4InttDigitizer()
 {
-  gsl_rng_free(RandomGenerator);
+  delete m_Rng;
 }
 
 int PHG4InttDigitizer::InitRun(PHCompositeNode *topNode)
@@ -85,6 +88,21 @@ int PHG4InttDigitizer::InitRun(PHCompositeNode *topNode)
 
   CalculateLadderCellADCScale(topNode);
 
+  // the adc ranges in GeV, so the hits need no lookups
+  m_AdcEnergyRange.clear();
+  for (std::map<int, float>::const_iterator iter1 = _energy_scale.begin(); iter1 != _energy_scale.end(); ++iter1)
+  {
+    std::vector<std::pair<double, double> > &vadcrange = m_AdcEnergyRange[iter1->first];
+    vadcrange = _max_fphx_adc[iter1->first];
+    for (unsigned int irange = 0; irange < vadcrange.size(); ++irange)
+    {
+      vadcrange[irange].first *= (double) iter1->second;
+      vadcrange[irange].second *= (double) iter1->second;
+    }
+  }
+  m_DeadStrips.clear();
+  m_DeadMap = findNode::getClass<InttDeadMap>(topNode, "DEADMAP_INTT");
+
   // Create the run and par nodes
   PHCompositeNode *runNode = dynamic_cast<PHCompositeNode *>(iter.findFirst("PHCompositeNode", "RUN"));
   PHCompositeNode *parNode = dynamic_cast<PHCompositeNode *>(iter.findFirst("PHCompositeNode", "PAR"));
@@ -155,6 +173,7 @@ void PHG4InttDigitizer::CalculateLadderCellADCScale(PHCompositeNode *topNode)
   PHG4CylinderGeomContainer *geom_container = findNode::getClass<PHG4CylinderGeomContainer>(topNode, "CYLINDERGEOM_INTT");
 
   //if (!geom_container || !cells) return;
+  m_GeomContainer = geom_container;
   if (!geom_container) return;
 
   PHG4CylinderGeomContainer::ConstRange layerrange = geom_container->get_begin_end();
@@ -181,19 +200,24 @@ void PHG4InttDigitizer::DigitizeLadderCells(PHCompositeNode *topNode)
   //---------------------------
   // Get common Nodes
   //---------------------------
-  const InttDeadMap *deadmap = findNode::getClass<InttDeadMap>(topNode, "DEADMAP_INTT");
+  m_DeadMap = findNode::getClass<InttDeadMap>(topNode, "DEADMAP_INTT");
   if (Verbosity() >= VERBOSITY_MORE)
   {
-    if (deadmap)
+    if (m_DeadMap)
     {
       cout << "PHG4InttDigitizer::DigitizeLadderCells - Use deadmap ";
-      deadmap->identify();
+      m_DeadMap->identify();
     }
     else
     {
       cout << "PHG4InttDigitizer::DigitizeLadderCells - Can not find deadmap, all channels enabled " << endl;
     }
   }
+  // PHG4InttHitReco has digitized the hits already
+  if (m_FusedFlag)
+  {
+    return;
+  }
 
   // Get the TrkrHitSetContainer node
   TrkrHitSetContainer *trkrhitsetcontainer = findNode::getClass<TrkrHitSetContainer>(topNode, "TRKR_HITSET");
@@ -213,9 +237,49 @@ void PHG4InttDigitizer::DigitizeLadderCells(PHCompositeNode *topNode)
        hitset_iter != hitset_range.second;
        ++hitset_iter)
     {
-     // we have an itrator to one TrkrHitSet for the intt from the trkrHitSetContainer
+      DigitizeHitSet(hitset_iter->first, hitset_iter->second);
+    } // end loop over hitsets
+  
+  return;
+}
+
+const PHG4InttDigitizer::SensorDeadStrips &PHG4InttDigitizer::GetDeadStrips(const TrkrDefs::hitsetkey hitsetkey)
+{
+  std::map<TrkrDefs::hitsetkey, SensorDeadStrips>::const_iterator iter = m_DeadStrips.find(hitsetkey);
+  if (iter != m_DeadStrips.end())
+  {
+    return iter->second;
+  }
+  SensorDeadStrips &sensor = m_DeadStrips[hitsetkey];
+  sensor.nrows = 0;
+  const int layer = TrkrDefs::getLayer(hitsetkey);
+  const int ladder_phi = InttDefs::getLadderPhiId(hitsetkey);
+  const int ladder_z = InttDefs::getLadderZId(hitsetkey);
+  CylinderGeomIntt *layergeom = (m_GeomContainer ? dynamic_cast<CylinderGeomIntt *>(m_GeomContainer->GetLayerGeom(layer)) : nullptr);
+  if (!layergeom)
+  {
+    return sensor;
+  }
+  // the dead map with its wild cards is evaluated once for all strips of the sensor
+  sensor.nrows = layergeom->get_nstrips_phi_cell();
+  const int ncols = layergeom->get_nstrips_z_sensor(ladder_z);
+  sensor.dead.assign(ncols * sensor.nrows, 0);
+  for (int strip_col = 0; strip_col < ncols; strip_col++)
+  {
+    for (int strip_row = 0; strip_row < sensor.nrows; strip_row++)
+    {
+      if (m_DeadMap->isDeadChannelIntt(layer, ladder_phi, ladder_z, strip_col, strip_row))
+      {
+        sensor.dead[strip_col * sensor.nrows + strip_row] = 1;
+      }
+    }
+  }
+  return sensor;
+}
+
+void PHG4InttDigitizer::DigitizeHitSet(const TrkrDefs::hitsetkey hitsetkey, TrkrHitSet *hitset)
+{
       // get the hitset key so we can find the layer
-      TrkrDefs::hitsetkey hitsetkey = hitset_iter->first;
       const int layer = TrkrDefs::getLayer(hitsetkey);
       const int ladder_phi = InttDefs::getLadderPhiId(hitsetkey);
       const int ladder_z = InttDefs::getLadderZId(hitsetkey);
@@ -223,8 +287,13 @@ void PHG4InttDigitizer::DigitizeLadderCells(PHCompositeNode *topNode)
       if(Verbosity() > 1) 
 	cout << "PHG4InttDigitizer: found hitset with key: " << hitsetkey << " in layer " << layer << endl;
 
+      if (_energy_scale.count(layer) > 1)
+	assert(!"Error: _energy_scale has two or more keys.");
+
+      const std::vector<std::pair<double, double> > &vadcrange = m_AdcEnergyRange[layer];
+      const SensorDeadStrips *deadstrips = (m_DeadMap ? &GetDeadStrips(hitsetkey) : nullptr);
+
       // get all of the hits from this hitset      
-      TrkrHitSet *hitset = hitset_iter->second;
       TrkrHitSet::ConstRange hit_range = hitset->getHits();
       for(TrkrHitSet::ConstIterator hit_iter = hit_range.first;
 	  hit_iter != hit_range.second;
@@ -238,15 +307,13 @@ void PHG4InttDigitizer::DigitizeLadderCells(PHCompositeNode *topNode)
 	  int strip_row =   InttDefs::getRow(hitkey);  // strip phi index
 
 	  // Apply deadmap here if desired
-	  if (deadmap)
+	  if (deadstrips)
 	    {
-	      if (deadmap->isDeadChannelIntt(
-					     layer, 
-					     ladder_phi,
-					     ladder_z,
-					     strip_col,
-					     strip_row
-					     ))
+	      const unsigned int istrip = strip_col * deadstrips->nrows + strip_row;
+	      const bool dead = (strip_row < deadstrips->nrows && istrip < deadstrips->dead.size())
+				    ? deadstrips->dead[istrip]
+				    : m_DeadMap->isDeadChannelIntt(layer, ladder_phi, ladder_z, strip_col, strip_row);
+	      if (dead)
 		{
 		  ++m_nDeadCells;
 		  if (Verbosity() >= VERBOSITY_MORE)
@@ -258,16 +325,10 @@ void PHG4InttDigitizer::DigitizeLadderCells(PHCompositeNode *topNode)
 		}
 	    }  //    if (deadmap)
 
-	  if (_energy_scale.count(layer) > 1)
-	    assert(!"Error: _energy_scale has two or more keys.");
-
-	  const float mip_e = _energy_scale[layer];
-
-	  std::vector<std::pair<double, double> > vadcrange = _max_fphx_adc[layer];
-
+	  const double energy = hit->getEnergy();
 	  int adc = -1;
 	  for (unsigned int irange = 0; irange < vadcrange.size(); ++irange)
-	    if (hit->getEnergy() >= vadcrange[irange].first * (double) mip_e && hit->getEnergy() < vadcrange[irange].second * (double) mip_e)
+	    if (energy >= vadcrange[irange].first && energy < vadcrange[irange].second)
 	      adc = (int) irange;
 
 	  if(adc == -1)
@@ -281,8 +342,7 @@ void PHG4InttDigitizer::DigitizeLadderCells(PHCompositeNode *topNode)
 		 << " strip_col " << strip_col << " strip_row " << strip_row << " adc " << adc << endl;
  
 	} // end loop over hits in this hitset
-    } // end loop over hitsets
-  
+
   return;
 }
 
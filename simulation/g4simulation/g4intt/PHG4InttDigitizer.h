@@ -5,6 +5,8 @@
 
 #include <fun4all/SubsysReco.h>
 
+#include <trackbase/TrkrDefs.h>
+
 // rootcint barfs with this header so we need to hide it
 #if !defined(__CINT__) || defined(__CLING__)
 #include <gsl/gsl_rng.h>
@@ -15,7 +17,11 @@
 #include <utility>                             // for pair
 #include <vector>
 
+class InttDeadMap;
 class PHCompositeNode;
+class PHCounterRng;
+class PHG4CylinderGeomContainer;
+class TrkrHitSet;
 
 class PHG4InttDigitizer : public SubsysReco, public PHParameterInterface
 {
@@ -38,11 +44,26 @@ class PHG4InttDigitizer : public SubsysReco, public PHParameterInterface
 
   void set_adc_scale(const int &layer, const std::vector<double> &userrange);
 
+  //! ADC conversion of the hits of one sensor in one pass, dead strips are skipped
+  void DigitizeHitSet(const TrkrDefs::hitsetkey hitsetkey, TrkrHitSet *hitset);
+
+  //! set by PHG4InttHitReco::set_digitizer(), which calls DigitizeHitSet() for every
+  //! sensor it fills. process_event() then only picks up the dead map
+  void set_fused(const bool b) { m_FusedFlag = b; }
+
  private:
   void CalculateLadderCellADCScale(PHCompositeNode *topNode);
 
   void DigitizeLadderCells(PHCompositeNode *topNode);
 
+  //! dead flags of the strips of one sensor, built from the dead map when the sensor is first seen
+  struct SensorDeadStrips
+  {
+    int nrows;
+    std::vector<unsigned char> dead;  // strip_col * nrows + strip_row
+  };
+  const SensorDeadStrips &GetDeadStrips(const TrkrDefs::hitsetkey hitsetkey);
+
   std::string detector;
   // noise electrons
   float added_noise();
@@ -60,12 +81,20 @@ class PHG4InttDigitizer : public SubsysReco, public PHParameterInterface
 
   const unsigned int nadcbins = 8;
   std::map<int, std::vector<std::pair<double, double> > > _max_fphx_adc;
+  //! _max_fphx_adc times the mip energy of the layer
+  std::map<int, std::vector<std::pair<double, double> > > m_AdcEnergyRange;
+
+  const InttDeadMap *m_DeadMap;
+  PHG4CylinderGeomContainer *m_GeomContainer;
+  std::map<TrkrDefs::hitsetkey, SensorDeadStrips> m_DeadStrips;
+  bool m_FusedFlag;
 
   unsigned int m_nCells;
   unsigned int m_nDeadCells;
 
 #if !defined(__CINT__) || defined(__CLING__)
   //! random generator that conform with sPHENIX standard
+  PHCounterRng *m_Rng;
   gsl_rng *RandomGenerator;
 #endif
 };
@@ -1,4 +1,5 @@
 #include "PHG4InttHitReco.h"
+#include "PHG4InttDigitizer.h"
 
 #include <intt/CylinderGeomIntt.h>
 
@@ -33,6 +34,7 @@
 
 #include <TSystem.h>
 
+#include <algorithm>  // for stable_sort
 #include <cmath>
 #include <cstdlib>
 #include <iostream>
@@ -49,6 +51,8 @@ PHG4InttHitReco::PHG4InttHitReco(const std::string &name)
   , m_Detector("INTT")
   , m_Tmin(NAN)
   , m_Tmax(NAN)
+  , m_Digitizer(nullptr)
+  , m_NRows(0)
 {
   InitializeParameters();
 
@@ -67,6 +71,22 @@ PHG4InttHitReco::~PHG4InttHitReco()
   gsl_vector_free(m_SegmentVec);
 }
 
+void PHG4InttHitReco::set_digitizer(PHG4InttDigitizer *digitizer)
+{
+  m_Digitizer = digitizer;
+  m_Digitizer->set_fused(true);
+}
+
+namespace
+{
+  // order g4hits by the sensor (hitset) they are in
+  bool SensorLess(const pair<TrkrDefs::hitsetkey, PHG4HitContainer::ConstIterator> &a,
+                  const pair<TrkrDefs::hitsetkey, PHG4HitContainer::ConstIterator> &b)
+  {
+    return a.first < b.first;
+  }
+}  // namespace
+
 int PHG4InttHitReco::InitRun(PHCompositeNode *topNode)
 {
   PHNodeIterator iter(topNode);
@@ -213,11 +233,43 @@ int PHG4InttHitReco::process_event(PHCompositeNode *topNode)
   // we need the geometry object for this layer
   if (Verbosity() > 2) cout << " PHG4InttHitReco: Loop over hits" << endl;
   PHG4HitContainer::ConstRange hit_begin_end = g4hit->getHits();
+  // the strips of one sensor at a time are summed in a dense buffer, so the
+  // g4hits are grouped by sensor (keeping their order within the sensor)
+  vector<pair<TrkrDefs::hitsetkey, PHG4HitContainer::ConstIterator> > sensorhits;
   for (PHG4HitContainer::ConstIterator hiter = hit_begin_end.first; hiter != hit_begin_end.second; ++hiter)
   {
+    sensorhits.push_back(make_pair(InttDefs::genHitSetKey(hiter->second->get_detid(),
+                                                          hiter->second->get_ladder_z_index(),
+                                                          hiter->second->get_ladder_phi_index()),
+                                   hiter));
+  }
+  stable_sort(sensorhits.begin(), sensorhits.end(), SensorLess);
+
+  int ncols = 0;
+  for (unsigned int isensorhit = 0; isensorhit < sensorhits.size(); isensorhit++)
+  {
+    PHG4HitContainer::ConstIterator hiter = sensorhits[isensorhit].second;
+    const TrkrDefs::hitsetkey hitsetkey = sensorhits[isensorhit].first;
     const int sphxlayer = hiter->second->get_detid();
     CylinderGeomIntt *layergeom = dynamic_cast<CylinderGeomIntt *>(geo->GetLayerGeom(sphxlayer));
 
+    if (isensorhit == 0 || hitsetkey != sensorhits[isensorhit - 1].first)
+    {
+      // the previous sensor is complete
+      if (isensorhit > 0)
+      {
+        StoreSensorStrips(sensorhits[isensorhit - 1].first, hitsetcontainer, hittruthassoc);
+      }
+      // StoreSensorStrips() leaves the buffers empty, they only need to be large enough
+      m_NRows = layergeom->get_nstrips_phi_cell();
+      ncols = layergeom->get_nstrips_z_sensor(hiter->second->get_ladder_z_index());
+      if (m_StripEnergy.size() < static_cast<unsigned int>(m_NRows * ncols))
+      {
+        m_StripEnergy.assign(m_NRows * ncols, 0);
+        m_StripFired.assign(m_NRows * ncols, 0);
+      }
+    }
+
     // checking ADC timing integration window cut
     // uses default values for now
     // these should depend on layer radius
@@ -230,7 +282,6 @@ int PHG4InttHitReco::process_event(PHCompositeNode *topNode)
     double diffusion_width = 5.0e-04;  // diffusion radius 5 microns, in cm
 
     const int ladder_z_index = hiter->second->get_ladder_z_index();
-    const int ladder_phi_index = hiter->second->get_ladder_phi_index();
 
     // What we have is a hit in the sensor. We have not yet assigned the strip(s) that were hit, we do that here
     //========================================================================
@@ -262,10 +313,6 @@ int PHG4InttHitReco::process_event(PHCompositeNode *topNode)
 
     // Use an algorithm similar to the one for the MVTX pixels, since it facilitates adding charge diffusion
     // for now we assume small charge diffusion
-    vector<int> vybin;
-    vector<int> vzbin;
-    //vector<double> vlen;
-    vector<pair<double, double> > venergy;
 
     //====================================================
     // Beginning of charge sharing implementation
@@ -283,12 +330,8 @@ int PHG4InttHitReco::process_event(PHCompositeNode *topNode)
     {
       continue;
     }
-    // this hit is skipped above if this dimensioning would be exceeded
-    double stripenergy[13][13] = {};  // init to 0
-    double stripeion[13][13] = {};    // init to 0
-
-    int nsegments = 10;
-    // Loop over track segments and diffuse charge at each segment location, collect energy in pixels
+    const int nsegments = 10;
+    // Find the tracklet segment locations
     // Get the entry point of the hit in sensor local coordinates
     gsl_vector_set(m_PathVec, 0, hiter->second->get_local_x(0));
     gsl_vector_set(m_PathVec, 1, hiter->second->get_local_y(0));
@@ -297,9 +340,10 @@ int PHG4InttHitReco::process_event(PHCompositeNode *topNode)
     gsl_vector_set(m_LocalOutVec, 1, hiter->second->get_local_y(1));
     gsl_vector_set(m_LocalOutVec, 2, hiter->second->get_local_z(1));
     gsl_vector_sub(m_PathVec, m_LocalOutVec);
+    double segy[nsegments];
+    double segz[nsegments];
     for (int i = 0; i < nsegments; i++)
     {
-      // Find the tracklet segment location
       // If there are n segments of equal length, we want 2*n intervals
       // The 1st segment is centered at interval 1, the 2nd at interval 3, the nth at interval 2n -1
       double interval = 2 * (double) i + 1;
@@ -307,9 +351,8 @@ int PHG4InttHitReco::process_event(PHCompositeNode *topNode)
       gsl_vector_memcpy(m_SegmentVec, m_PathVec);
       gsl_vector_scale(m_SegmentVec, frac);
       gsl_vector_add(m_SegmentVec, m_LocalOutVec);
-      // Caculate the charge diffusion over this drift distance
-      // increases from diffusion width_min to diffusion_width_max
-      double diffusion_radius = diffusion_width;
+      segy[i] = gsl_vector_get(m_SegmentVec, 1);
+      segz[i] = gsl_vector_get(m_SegmentVec, 2);
 
       if (Verbosity() > 5)
         cout << " segment " << i
@@ -324,55 +367,61 @@ int PHG4InttHitReco::process_event(PHCompositeNode *topNode)
              << " segvec.X " << gsl_vector_get(m_SegmentVec, 0)
              << " segvec.Z " << gsl_vector_get(m_SegmentVec, 2)
              << " segvec.Y " << gsl_vector_get(m_SegmentVec, 1) << endl
-             << " diffusion_radius " << diffusion_radius
+             << " diffusion_radius " << diffusion_width
              << endl;
+    }
+    // Caculate the charge diffusion over this drift distance
+    // increases from diffusion width_min to diffusion_width_max
+    const double diffusion_radius = diffusion_width;
 
-      // Now find the area of overlap of the diffusion circle with each pixel and apportion the energy
-      for (int iz = minstrip_z; iz <= maxstrip_z; iz++)
+    // Now find the area of overlap of the diffusion circles with each strip and apportion the energy,
+    // the strip corners are computed once for all segments
+    for (int iz = minstrip_z; iz <= maxstrip_z; iz++)
+    {
+      for (int iy = minstrip_y; iy <= maxstrip_y; iy++)
       {
-        for (int iy = minstrip_y; iy <= maxstrip_y; iy++)
+        // Find the pixel corners for this pixel number
+        double location[3] = {-1, -1, -1};
+        layergeom->find_strip_center_localcoords(ladder_z_index, iy, iz, location);
+        // note that (y1,z1) is the top left corner, (y2,z2) is the bottom right corner of the pixel - circle_rectangle_intersection expects this ordering
+        double y1 = location[1] - layergeom->get_strip_y_spacing() / 2.0;
+        double y2 = location[1] + layergeom->get_strip_y_spacing() / 2.0;
+        double z1 = location[2] + layergeom->get_strip_z_spacing() / 2.0;
+        double z2 = location[2] - layergeom->get_strip_z_spacing() / 2.0;
+
+        double stripenergy = 0;
+        for (int i = 0; i < nsegments; i++)
         {
-          // Find the pixel corners for this pixel number
-          double location[3] = {-1, -1, -1};
-          layergeom->find_strip_center_localcoords(ladder_z_index, iy, iz, location);
-          // note that (y1,z1) is the top left corner, (y2,z2) is the bottom right corner of the pixel - circle_rectangle_intersection expects this ordering
-          double y1 = location[1] - layergeom->get_strip_y_spacing() / 2.0;
-          double y2 = location[1] + layergeom->get_strip_y_spacing() / 2.0;
-          double z1 = location[2] + layergeom->get_strip_z_spacing() / 2.0;
-          double z2 = location[2] - layergeom->get_strip_z_spacing() / 2.0;
-
-          // here m_SegmentVec.1 (Y) and m_SegmentVec.2 (Z) are the center of the circle, and diffusion_radius is the circle radius
+          // here segy and segz are the center of the circle, and diffusion_radius is the circle radius
           // circle_rectangle_intersection returns the overlap area of the circle and the pixel. It is very fast if there is no overlap.
-          double striparea_frac = PHG4Utils::circle_rectangle_intersection(y1, z1, y2, z2, gsl_vector_get(m_SegmentVec, 1), gsl_vector_get(m_SegmentVec, 2), diffusion_radius) / (M_PI * (diffusion_radius * diffusion_radius));
+          double striparea_frac = PHG4Utils::circle_rectangle_intersection(y1, z1, y2, z2, segy[i], segz[i], diffusion_radius) / (M_PI * (diffusion_radius * diffusion_radius));
           // assume that the energy is deposited uniformly along the tracklet length, so that this segment gets the fraction 1/nsegments of the energy
-          stripenergy[iy - minstrip_y][iz - minstrip_z] += striparea_frac * hiter->second->get_edep() / (float) nsegments;
-          if (hiter->second->has_property(PHG4Hit::prop_eion))
+          stripenergy += striparea_frac * hiter->second->get_edep() / (float) nsegments;
+        }
+        if (Verbosity() > 5)
+        {
+          cout << "    strip y index " << iy << " strip z index  " << iz
+               << " strip energy " << stripenergy
+               << endl;
+        }
+        // add the strips with energy to the sensor accumulator
+        if (stripenergy > 0.0)
+        {
+          if (iy < 0 || iy >= m_NRows || iz < 0 || iz >= ncols)
           {
-            stripeion[iy - minstrip_y][iz - minstrip_z] += striparea_frac * hiter->second->get_eion() / (float) nsegments;
+            cout << PHWHERE << " strip y index " << iy << " z index " << iz << " outside of the sensor, dropped" << endl;
+            continue;
           }
-          if (Verbosity() > 5)
+          unsigned int istrip = iz * m_NRows + iy;
+          if (!m_StripFired[istrip])
           {
-            cout << "    strip y index " << iy << " strip z index  " << iz
-                 << " strip area fraction of circle " << striparea_frac << " accumulated pixel energy " << stripenergy[iy - minstrip_y][iz - minstrip_z]
-                 << endl;
+            m_StripFired[istrip] = 1;
+            m_FiredStrips.push_back(istrip);
           }
-        }
-      }
-    }  // end loop over segments
-    // now we have the energy deposited in each pixel, summed over all tracklet segments. We make a vector of all pixels with non-zero energy deposited
-
-    for (int iz = minstrip_z; iz <= maxstrip_z; iz++)
-    {
-      for (int iy = minstrip_y; iy <= maxstrip_y; iy++)
-      {
-        if (stripenergy[iy - minstrip_y][iz - minstrip_z] > 0.0)
-        {
-          vybin.push_back(iy);
-          vzbin.push_back(iz);
-          pair<double, double> tmppair = make_pair(stripenergy[iy - minstrip_y][iz - minstrip_z], stripeion[iy - minstrip_y][iz - minstrip_z]);
-          venergy.push_back(tmppair);
+          m_StripEnergy[istrip] += stripenergy;
+          m_StripTruth.push_back(make_pair(istrip, hiter->first));
           if (Verbosity() > 1)
-            cout << " Added ybin " << iy << " zbin " << iz << " to vectors with energy " << stripenergy[iy - minstrip_y][iz - minstrip_z] << endl;
+            cout << " Added ybin " << iy << " zbin " << iz << " with energy " << stripenergy << endl;
         }
       }
     }
@@ -380,42 +429,14 @@ int PHG4InttHitReco::process_event(PHCompositeNode *topNode)
     //===================================
     // End of charge sharing implementation
     //===================================
-
-    for (unsigned int i1 = 0; i1 < vybin.size(); i1++)  // loop over all fired cells
-    {
-      // We add the Intt TrkrHitsets directly to the node using hitsetcontainer
-
-      // We need to create the TrkrHitSet if not already made - each TrkrHitSet should correspond to a sensor for the Intt ?
-      // The hitset key includes the layer, the ladder_z_index (sensors numbered 0-3) and  ladder_phi_index (azimuthal location of ladder) for this hit
-      TrkrDefs::hitsetkey hitsetkey = InttDefs::genHitSetKey(sphxlayer, ladder_z_index, ladder_phi_index);
-      // Use existing hitset or add new one if needed
-      TrkrHitSetContainer::Iterator hitsetit = hitsetcontainer->findOrAddHitSet(hitsetkey);
-
-      // generate the key for this hit
-      TrkrDefs::hitkey hitkey = InttDefs::genHitKey(vzbin[i1], vybin[i1]);
-      // See if this hit already exists
-      TrkrHit *hit = hitsetit->second->getHit(hitkey);
-      if (!hit)
-      {
-        // Otherwise, create a new one
-        hit = new InttHit();
-        hitsetit->second->addHitSpecificKey(hitkey, hit);
-      }
-
-      // Either way, add the energy to it
-      if (Verbosity() > 2)
-        cout << "add energy " << venergy[i1].first << " to intthit " << endl;
-      hit->addEnergy(venergy[i1].first);
-
-      // Add this hit to the association map
-      hittruthassoc->addAssoc(hitsetkey, hitkey, hiter->first);
-
-      if (Verbosity() > 2)
-        cout << "PHG4InttHitReco: added hit wirh hitsetkey " << hitsetkey << " hitkey " << hitkey << " g4hitkey " << hiter->first << endl;
-    }
-
   }  // end loop over g4hits
 
+  if (!sensorhits.empty())
+  {
+    StoreSensorStrips(sensorhits.back().first, hitsetcontainer, hittruthassoc);
+  }
+  hittruthassoc->finalize();
+
   // print the list of entries in the association table
   if (Verbosity() > 0)
   {
@@ -426,6 +447,50 @@ int PHG4InttHitReco::process_event(PHCompositeNode *topNode)
   return Fun4AllReturnCodes::EVENT_OK;
 }
 
+void PHG4InttHitReco::StoreSensorStrips(const TrkrDefs::hitsetkey hitsetkey, TrkrHitSetContainer *hitsetcontainer,
+                                        TrkrHitTruthAssoc *hittruthassoc)
+{
+  if (m_FiredStrips.empty())
+  {
+    return;
+  }
+  // We need to create the TrkrHitSet if not already made - each TrkrHitSet corresponds to a sensor for the Intt
+  // The hitset key includes the layer, the ladder_z_index (sensors numbered 0-3) and  ladder_phi_index (azimuthal location of ladder) for this hit
+  TrkrHitSet *hitset = hitsetcontainer->findOrAddHitSet(hitsetkey)->second;
+  for (unsigned int i = 0; i < m_FiredStrips.size(); i++)
+  {
+    const unsigned int istrip = m_FiredStrips[i];
+    // generate the key for this hit
+    TrkrDefs::hitkey hitkey = InttDefs::genHitKey(istrip / m_NRows, istrip % m_NRows);
+    if (Verbosity() > 2)
+      cout << "add energy " << m_StripEnergy[istrip] << " to intthit " << endl;
+    hitset->stageHit(hitkey, m_StripEnergy[istrip]);
+    m_StripEnergy[istrip] = 0;
+    m_StripFired[istrip] = 0;
+  }
+  // existing hits get the energy added, the others are created
+  hitset->addStagedHits<InttHit>();
+
+  // Add the hits to the association map
+  for (unsigned int i = 0; i < m_StripTruth.size(); i++)
+  {
+    const unsigned int istrip = m_StripTruth[i].first;
+    TrkrDefs::hitkey hitkey = InttDefs::genHitKey(istrip / m_NRows, istrip % m_NRows);
+    hittruthassoc->addAssoc(hitsetkey, hitkey, m_StripTruth[i].second);
+    if (Verbosity() > 2)
+      cout << "PHG4InttHitReco: added hit wirh hitsetkey " << hitsetkey << " hitkey " << hitkey << " g4hitkey " << m_StripTruth[i].second << endl;
+  }
+  m_FiredStrips.clear();
+  m_StripTruth.clear();
+
+  // the hits of this sensor are complete and still in the cache
+  if (m_Digitizer)
+  {
+    m_Digitizer->DigitizeHitSet(hitsetkey, hitset);
+  }
+  return;
+}
+
 void PHG4InttHitReco::SetDefaultParameters()
 {
   // if we ever need separate timing windows, don't patch around here!
@@ -7,13 +7,22 @@
 
 #include <fun4all/SubsysReco.h>
 
+#include <trackbase/TrkrDefs.h>
+
+#include <g4main/PHG4HitDefs.h>
+
 #if !defined(__CINT__) || defined(__CLING__)
 #include <gsl/gsl_vector.h>  // for gsl_vector
 #endif
 
 #include <string>
+#include <utility>  // for pair
+#include <vector>
 
 class PHCompositeNode;
+class PHG4InttDigitizer;
+class TrkrHitSetContainer;
+class TrkrHitTruthAssoc;
 
 class PHG4InttHitReco : public SubsysReco, public PHParameterInterface
 {
@@ -32,6 +41,10 @@ class PHG4InttHitReco : public SubsysReco, public PHParameterInterface
 
   void Detector(const std::string &d) { m_Detector = d; }
 
+  //! digitize every sensor right after its strips are stored, instead of a second pass of the
+  //! digitizer over all hits. The digitizer still has to be registered, after this module
+  void set_digitizer(PHG4InttDigitizer *digitizer);
+
  protected:
   std::string m_Detector;
   std::string m_HitNodeName;
@@ -41,6 +54,22 @@ class PHG4InttHitReco : public SubsysReco, public PHParameterInterface
   double m_Tmin;
   double m_Tmax;
 
+  PHG4InttDigitizer *m_Digitizer;
+
+ private:
+  //! store the fired strips of the dense strip buffer of one sensor and reset it
+  void StoreSensorStrips(const TrkrDefs::hitsetkey hitsetkey, TrkrHitSetContainer *hitsetcontainer,
+                         TrkrHitTruthAssoc *hittruthassoc);
+
+  // dense strip accumulator of the sensor being processed, reused for all sensors and events
+  int m_NRows;
+  std::vector<double> m_StripEnergy;
+  std::vector<unsigned char> m_StripFired;
+  //! strips fired on this sensor (strip_z * m_NRows + strip_y), in order of their first energy
+  std::vector<unsigned int> m_FiredStrips;
+  //! strip and g4hit key of every contribution, for the truth association
+  std::vector<std::pair<unsigned int, PHG4HitDefs::keytype> > m_StripTruth;
+
 #if !defined(__CINT__) || defined(__CLING__)
   gsl_vector *m_LocalOutVec;
   gsl_vector *m_PathVec;
@@ -0,0 +1,26 @@
+#include "PHG4InttLadderParameterisation.h"
+
+#include <Geant4/G4VPhysicalVolume.hh>
+
+//....oooOO0OOooo........oooOO0OOooo........oooOO0OOooo........oooOO0OOooo......
+
+PHG4InttLadderParameterisation::PHG4InttLadderParameterisation(const double posz)
+  : fPosZ(posz)
+{
+}
+
+G4int PHG4InttLadderParameterisation::AddLadder(const double posx, const double posy, const double rotz)
+{
+  G4RotationMatrix rotation;
+  rotation.rotateZ(rotz);
+  fTranslation.push_back(G4ThreeVector(posx, posy, fPosZ));
+  fRotation.push_back(rotation.inverse());
+  return fTranslation.size() - 1;
+}
+
+void PHG4InttLadderParameterisation::ComputeTransformation(const G4int icopy, G4VPhysicalVolume *physVol) const
+{
+  physVol->SetTranslation(fTranslation[icopy]);
+  // the physical volume keeps the pointer, the matrices live as long as this parameterisation
+  physVol->SetRotation(const_cast<G4RotationMatrix *>(&fRotation[icopy]));
+}
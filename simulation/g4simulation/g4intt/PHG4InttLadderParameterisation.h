@@ -0,0 +1,36 @@
+// Tell emacs that this is a C++ source
+// This file is really -*- C++ -*-.
+#ifndef G4INTT_PHG4INTTLADDERPARAMETERISATION_H
+#define G4INTT_PHG4INTTLADDERPARAMETERISATION_H
+
+#include <Geant4/G4RotationMatrix.hh>
+#include <Geant4/G4ThreeVector.hh>
+#include <Geant4/G4Types.hh>  // for G4double, G4int
+#include <Geant4/G4VPVParameterisation.hh>
+
+#include <vector>
+
+class G4VPhysicalVolume;
+
+/*
+ * ladder locations in phi of one layer and sensor type at a given z,
+ * the copy number is the ladder phi index
+ */
+class PHG4InttLadderParameterisation : public G4VPVParameterisation
+{
+ public:
+  explicit PHG4InttLadderParameterisation(const double posz);
+  virtual ~PHG4InttLadderParameterisation() {}
+  virtual void ComputeTransformation(const G4int icopy, G4VPhysicalVolume *physVol) const;
+
+  //! ladder center at posx, posy rotated by rotz around its own z axis, returns the copy number
+  G4int AddLadder(const double posx, const double posy, const double rotz);
+
+ private:
+  G4double fPosZ;
+  std::vector<G4ThreeVector> fTranslation;
+  //! frame rotations (the inverse of the ladder rotation, as in G4PVPlacement)
+  std::vector<G4RotationMatrix> fRotation;
+};
+
+#endif
@@ -7,7 +7,6 @@
 
 #include <g4main/PHG4Hit.h>
 #include <g4main/PHG4HitContainer.h>
-#include <g4main/PHG4Hitv1.h>
 #include <g4main/PHG4Shower.h>
 #include <g4main/PHG4SteppingAction.h>          // for PHG4SteppingAction
 #include <g4main/PHG4TrackUserInfoV1.h>
@@ -49,6 +48,7 @@ PHG4InttSteppingAction::PHG4InttSteppingAction(PHG4InttDetector* detector, const
   , m_Hits(nullptr)
   , m_AbsorberHits(nullptr)
   , m_Hit(nullptr)
+  , m_HitVersion(PHG4HitContainer::HitVersion())
   , m_SaveHitContainer(nullptr)
   , m_SaveShower(nullptr)
   , m_ParamsContainer(parameters)
@@ -84,6 +84,12 @@ PHG4InttSteppingAction::~PHG4InttSteppingAction()
   delete m_Hit;
 }
 
+//____________________________________________________________________________..
+bool PHG4InttSteppingAction::HandlesVolume(G4VPhysicalVolume* volume)
+{
+  return m_Detector->IsInIntt(volume) != 0;
+}
+
 //____________________________________________________________________________..
 bool PHG4InttSteppingAction::UserSteppingAction(const G4Step* aStep, bool)
 {
@@ -123,7 +129,9 @@ bool PHG4InttSteppingAction::UserSteppingAction(const G4Step* aStep, bool)
     // the ladder also contains inactive volumes but we check in m_Detector->IsInIntt(volume)
     // if we are in an active logical volume whioch is located in this ladder
     auto iter = m_Detector->get_ActiveVolumeTuple(touch->GetVolume(1));
-    tie(inttlayer, ladderz, ladderphi, zposneg) = iter->second;
+    tie(inttlayer, ladderz, zposneg) = iter->second;
+    // all ladders of a layer are copies of one parameterised volume
+    ladderphi = touch->GetReplicaNumber(1);
     if (Verbosity() > 0)
       cout << "     inttlayer " << inttlayer << " ladderz_base " << ladderz << " ladderphi " << ladderphi << " zposneg " << zposneg << endl;
     if (inttlayer < 0 || inttlayer > 7)
@@ -192,7 +200,7 @@ bool PHG4InttSteppingAction::UserSteppingAction(const G4Step* aStep, bool)
     // and we have to make a new one
     if (!m_Hit)
     {
-      m_Hit = new PHG4Hitv1();
+      m_Hit = PHG4HitContainer::NewHit(m_HitVersion);
     }
 
     // set the index values needed to locate the sensor strip
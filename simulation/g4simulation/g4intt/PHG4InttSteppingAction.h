@@ -10,6 +10,7 @@
 #include <utility>                      // for pair
 
 class G4Step;
+class G4VPhysicalVolume;
 class PHCompositeNode;
 class PHG4InttDetector;
 class PHG4Hit;
@@ -26,6 +27,11 @@ class PHG4InttSteppingAction : public PHG4SteppingAction
 
   virtual bool UserSteppingAction(const G4Step *, bool);
 
+
+  //! only steps in our own volumes are dispatched to this stepping action
+
+  virtual bool HandlesVolume(G4VPhysicalVolume *volume);
+
   virtual void SetInterfacePointers(PHCompositeNode *);
 
  private:
@@ -36,6 +42,8 @@ class PHG4InttSteppingAction : public PHG4SteppingAction
   PHG4HitContainer *m_Hits;
   PHG4HitContainer *m_AbsorberHits;
   PHG4Hit *m_Hit;
+  //! PHG4Hit version created, PHG4HitContainer::HitVersion()
+  int m_HitVersion;
   PHG4HitContainer *m_SaveHitContainer;
   PHG4Shower *m_SaveShower;
   const PHParametersContainer *m_ParamsContainer;
@@ -49,12 +49,10 @@ void FastJetAlgo::identify(std::ostream& os)
   os << endl;
 }
 
-std::vector<Jet*> FastJetAlgo::get_jets(std::vector<Jet*> particles)
+std::vector<fastjet::PseudoJet> FastJetAlgo::get_pseudojets(const std::vector<Jet*>& particles)
 {
-  if (_verbosity > 1) cout << "FastJetAlgo::process_event -- entered" << endl;
-
-  // translate to fastjet
   std::vector<fastjet::PseudoJet> pseudojets;
+  pseudojets.reserve(particles.size());
   for (unsigned int ipart = 0; ipart < particles.size(); ++ipart)
   {
     // fastjet performs strangely with exactly (px,py,pz,E) =
@@ -70,15 +68,54 @@ std::vector<Jet*> FastJetAlgo::get_jets(std::vector<Jet*> particles)
     pseudojets.push_back(pseudojet);
   }
 
-  // run fast jet
-  fastjet::JetDefinition* jetdef = nullptr;
+  return pseudojets;
+}
+
+std::vector<Jet*> FastJetAlgo::get_jets(std::vector<Jet*> particles)
+{
+  // translate to fastjet
+  return get_jets_from_pseudojets(particles, get_pseudojets(particles));
+}
+
+std::vector<fastjet::PseudoJet> FastJetAlgo::get_pseudojets(const JetParticles& particles)
+{
+  std::vector<fastjet::PseudoJet> pseudojets;
+  pseudojets.reserve(particles.size());
+  for (unsigned int ipart = 0; ipart < particles.size(); ++ipart)
+  {
+    // same zero energy catch as above
+    if (particles.get_e(ipart) == 0.) continue;
+
+    fastjet::PseudoJet pseudojet(particles.get_px(ipart),
+                                 particles.get_py(ipart),
+                                 particles.get_pz(ipart),
+                                 particles.get_e(ipart));
+    pseudojet.set_user_index(ipart);
+    pseudojets.push_back(pseudojet);
+  }
+
+  return pseudojets;
+}
+
+fastjet::JetDefinition* FastJetAlgo::new_jet_definition() const
+{
   if (_algo == Jet::ANTIKT)
-    jetdef = new fastjet::JetDefinition(fastjet::antikt_algorithm, _par, fastjet::E_scheme, fastjet::Best);
+    return new fastjet::JetDefinition(fastjet::antikt_algorithm, _par, fastjet::E_scheme, fastjet::Best);
   else if (_algo == Jet::KT)
-    jetdef = new fastjet::JetDefinition(fastjet::kt_algorithm, _par, fastjet::E_scheme, fastjet::Best);
+    return new fastjet::JetDefinition(fastjet::kt_algorithm, _par, fastjet::E_scheme, fastjet::Best);
   else if (_algo == Jet::CAMBRIDGE)
-    jetdef = new fastjet::JetDefinition(fastjet::cambridge_algorithm, _par, fastjet::E_scheme, fastjet::Best);
-  else
+    return new fastjet::JetDefinition(fastjet::cambridge_algorithm, _par, fastjet::E_scheme, fastjet::Best);
+  return nullptr;
+}
+
+std::vector<Jet*> FastJetAlgo::get_jets_from_pseudojets(const std::vector<Jet*>& particles,
+                                                        const std::vector<fastjet::PseudoJet>& pseudojets)
+{
+  if (_verbosity > 1) cout << "FastJetAlgo::process_event -- entered" << endl;
+
+  // run fast jet
+  fastjet::JetDefinition* jetdef = new_jet_definition();
+  if (!jetdef)
     return std::vector<Jet*>();
   fastjet::ClusterSequence jetFinder(pseudojets, *jetdef);
   std::vector<fastjet::PseudoJet> fastjets = jetFinder.inclusive_jets();
@@ -116,3 +153,43 @@ std::vector<Jet*> FastJetAlgo::get_jets(std::vector<Jet*> particles)
 
   return jets;
 }
+
+std::vector<Jet*> FastJetAlgo::get_jets_from_particles(const JetParticles& particles,
+                                                       const std::vector<fastjet::PseudoJet>& pseudojets)
+{
+  if (_verbosity > 1) cout << "FastJetAlgo::process_event -- entered" << endl;
+
+  // run fast jet
+  fastjet::JetDefinition* jetdef = new_jet_definition();
+  if (!jetdef)
+    return std::vector<Jet*>();
+  fastjet::ClusterSequence jetFinder(pseudojets, *jetdef);
+  std::vector<fastjet::PseudoJet> fastjets = jetFinder.inclusive_jets();
+  delete jetdef;
+
+  // translate into jet output, the constituents come straight from the buffer
+  std::vector<Jet*> jets;
+  jets.reserve(fastjets.size());
+  for (unsigned int ijet = 0; ijet < fastjets.size(); ++ijet)
+  {
+    Jet* jet = new Jetv1();
+    jet->set_px(fastjets[ijet].px());
+    jet->set_py(fastjets[ijet].py());
+    jet->set_pz(fastjets[ijet].pz());
+    jet->set_e(fastjets[ijet].e());
+    jet->set_id(ijet);
+
+    std::vector<fastjet::PseudoJet> comps = fastjets[ijet].constituents();
+    for (unsigned int icomp = 0; icomp < comps.size(); ++icomp)
+    {
+      const unsigned int ipart = comps[icomp].user_index();
+      jet->insert_comp(particles.get_src(ipart), particles.get_index(ipart));
+    }
+
+    jets.push_back(jet);
+  }
+
+  if (_verbosity > 1) cout << "FastJetAlgo::process_event -- exited" << endl;
+
+  return jets;
+}
@@ -3,10 +3,16 @@
 
 #include "Jet.h"
 #include "JetAlgo.h"
+#include "JetParticles.h"
 
 #include <iostream>   // for cout, ostream
 #include <vector>     // for vector
 
+namespace fastjet
+{
+  class JetDefinition;
+}
+
 class FastJetAlgo : public JetAlgo
 {
  public:
@@ -18,8 +24,19 @@ class FastJetAlgo : public JetAlgo
   float get_par() { return _par; }
 
   std::vector<Jet*> get_jets(std::vector<Jet*> particles);
+  std::vector<Jet*> get_jets_from_pseudojets(const std::vector<Jet*>& particles,
+                                             const std::vector<fastjet::PseudoJet>& pseudojets);
+  std::vector<Jet*> get_jets_from_particles(const JetParticles& particles,
+                                            const std::vector<fastjet::PseudoJet>& pseudojets);
+
+  /// translate particles to fastjet, the user index is the particle index
+  static std::vector<fastjet::PseudoJet> get_pseudojets(const std::vector<Jet*>& particles);
+  static std::vector<fastjet::PseudoJet> get_pseudojets(const JetParticles& particles);
 
  private:
+  /// jet definition of the algorithm, nullptr if unknown, the caller owns it
+  fastjet::JetDefinition* new_jet_definition() const;
+
   int _verbosity;
   Jet::ALGO _algo;
   float _par;
@@ -2,8 +2,15 @@
 #define G4JET_JETALGO_H
 
 #include "Jet.h"
+#include "JetParticles.h"
 
 #include <cmath>
+#include <vector>
+
+namespace fastjet
+{
+  class PseudoJet;
+}
 
 class JetAlgo
 {
@@ -23,6 +30,26 @@ class JetAlgo
     return std::vector<Jet*>();
   }
 
+  /// same as get_jets, with the particles already translated by
+  /// FastJetAlgo::get_pseudojets, shared by all algorithms of an event;
+  /// must not modify the particles, JetReco may call it from several threads
+  virtual std::vector<Jet*> get_jets_from_pseudojets(const std::vector<Jet*>& particles,
+                                                     const std::vector<fastjet::PseudoJet>& pseudojets)
+  {
+    return get_jets(particles);
+  }
+
+  /// same as get_jets_from_pseudojets, with the particles in the flat buffer
+  /// filled by the JetInputs; by default translated to Jets for get_jets
+  virtual std::vector<Jet*> get_jets_from_particles(const JetParticles& particles,
+                                                    const std::vector<fastjet::PseudoJet>& pseudojets)
+  {
+    std::vector<Jet*> parts = particles.make_jets();
+    std::vector<Jet*> jets = get_jets_from_pseudojets(parts, pseudojets);
+    for (unsigned int i = 0; i < parts.size(); ++i) delete parts[i];
+    return jets;
+  }
+
  protected:
   JetAlgo() {}
 
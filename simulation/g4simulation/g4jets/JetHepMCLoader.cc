@@ -43,6 +43,8 @@
 
 #include <cassert>
 #include <iostream>
+#include <map>
+#include <vector>
 
 using namespace std;
 
@@ -123,17 +125,27 @@ int JetHepMCLoader::process_event(PHCompositeNode *topNode)
     h_norm->Fill("Event count", 1);
   }  //   if (m_saveQAPlots)
 
-  for (const hepmc_jet_src &src : m_jetSrc)
+  vector<JetMap *> jetmaps(m_jetSrc.size(), nullptr);
+  for (unsigned int isrc = 0; isrc < m_jetSrc.size(); ++isrc)
   {
+    const hepmc_jet_src &src = m_jetSrc[isrc];
     JetMap *jets = findNode::getClass<JetMap>(topNode, src.m_name);
     assert(jets);
 
     jets->set_algo(src.m_algorithmID);
     jets->set_par(src.m_parameter);
     jets->insert_src(Jet::HEPMC_IMPORT);
+    jetmaps[isrc] = jets;
+  }
+
+  // all jet sources of one HepMC event are filled in a single pass over its particles
+  for (map<int, vector<unsigned int> >::const_iterator embed_iter = m_embeddingSrc.begin();
+       embed_iter != m_embeddingSrc.end(); ++embed_iter)
+  {
+    const vector<unsigned int> &isrcs = embed_iter->second;
 
     PHHepMCGenEvent *genevt =
-        genevtmap->get(src.m_embeddingID);
+        genevtmap->get(embed_iter->first);
 
     if (genevt == nullptr) continue;
 
@@ -145,9 +157,9 @@ int JetHepMCLoader::process_event(PHCompositeNode *topNode)
       return Fun4AllReturnCodes::ABORTEVENT;
     }
 
-    assert(genevt->get_embedding_id() == src.m_embeddingID);
+    assert(genevt->get_embedding_id() == embed_iter->first);
 
-    TH2F *hjet = nullptr;
+    vector<TH2F *> hjets(isrcs.size(), nullptr);
 
     if (m_saveQAPlots)
     {
@@ -155,11 +167,14 @@ int JetHepMCLoader::process_event(PHCompositeNode *topNode)
       assert(hm);
       TH1D *h_norm = dynamic_cast<TH1D *>(hm->getHisto("hNormalization"));
       assert(h_norm);
-      h_norm->Fill((string("SubEvent ") + src.m_name).c_str(), 1);
-
-      hjet = dynamic_cast<TH2F *>(hm->getHisto(string("hJetEtEta_") + src.m_name));
-      assert(hjet);
+      for (unsigned int i = 0; i < isrcs.size(); ++i)
+      {
+        const hepmc_jet_src &src = m_jetSrc[isrcs[i]];
+        h_norm->Fill((string("SubEvent ") + src.m_name).c_str(), 1);
 
+        hjets[i] = dynamic_cast<TH2F *>(hm->getHisto(string("hJetEtEta_") + src.m_name));
+        assert(hjets[i]);
+      }
     }  //   if (m_saveQAPlots)
 
     const double mom_factor = HepMC::Units::conversion_factor(evt->momentum_unit(), HepMC::Units::GEV);
@@ -173,27 +188,31 @@ int JetHepMCLoader::process_event(PHCompositeNode *topNode)
       if (Verbosity() >= VERBOSITY_A_LOT)
         part->print();
 
-      if (part->status() == src.m_tagStatus and part->pdg_id() == src.m_tagPID)
+      for (unsigned int i = 0; i < isrcs.size(); ++i)
       {
-        Jet *jet = new Jetv1();
+        const hepmc_jet_src &src = m_jetSrc[isrcs[i]];
+        if (part->status() == src.m_tagStatus and part->pdg_id() == src.m_tagPID)
+        {
+          Jet *jet = new Jetv1();
 
-        jet->set_px(part->momentum().px() * mom_factor);
-        jet->set_py(part->momentum().py() * mom_factor);
-        jet->set_pz(part->momentum().pz() * mom_factor);
-        jet->set_e(part->momentum().e() * mom_factor);
+          jet->set_px(part->momentum().px() * mom_factor);
+          jet->set_py(part->momentum().py() * mom_factor);
+          jet->set_pz(part->momentum().pz() * mom_factor);
+          jet->set_e(part->momentum().e() * mom_factor);
 
-        jet->insert_comp(Jet::HEPMC_IMPORT, part->barcode());
+          jet->insert_comp(Jet::HEPMC_IMPORT, part->barcode());
 
-        jets->insert(jet);
+          jet = jetmaps[isrcs[i]]->insert(jet);
 
-        if (hjet)
-        {
-          hjet->Fill(jet->get_eta(), jet->get_et());
-        }
+          if (hjets[i])
+          {
+            hjets[i]->Fill(jet->get_eta(), jet->get_et());
+          }
 
-      }  //       if (part->status() == src.m_tagStatus and part->pdg_id() == src.m_tagPID)
+        }  //       if (part->status() == src.m_tagStatus and part->pdg_id() == src.m_tagPID)
+      }
     }
-  }  //  for (const hepmc_jet_src &src : m_jetSrc)
+  }  //  for (embed_iter = m_embeddingSrc.begin() ...
 
   return Fun4AllReturnCodes::EVENT_OK;
 }
@@ -243,6 +262,7 @@ void JetHepMCLoader::addJet(
 
   hepmc_jet_src src{name, embeddingID, algorithmName, algorithm, parameter, tagPID, tagStatus};
 
+  m_embeddingSrc[embeddingID].push_back(m_jetSrc.size());
   m_jetSrc.push_back(src);
 }
 
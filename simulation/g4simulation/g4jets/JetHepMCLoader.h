@@ -14,6 +14,7 @@
 #include "Jet.h"
 
 #include <fun4all/SubsysReco.h>
+#include <map>
 #include <string>
 #include <vector>
 
@@ -104,6 +105,9 @@ class JetHepMCLoader : public SubsysReco
   };
 
   std::vector<hepmc_jet_src> m_jetSrc;
+
+  //! embedding ID => indices of its jet sources in m_jetSrc
+  std::map<int, std::vector<unsigned int> > m_embeddingSrc;
 };
 
 #endif /* JETHEPMCLOADER_H_ */
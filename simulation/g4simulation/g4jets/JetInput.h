@@ -2,6 +2,7 @@
 #define G4JET_JETINPUT_H
 
 #include "Jet.h"
+#include "JetParticles.h"
 
 #include <iostream>
 #include <vector>
@@ -20,11 +21,23 @@ class JetInput
 
   virtual Jet::SRC get_src() { return Jet::VOID; }
 
+  /// called from JetReco::InitRun, to set up per run tables
+  virtual int InitRun(PHCompositeNode* topNode) { return 0; }
+
   virtual std::vector<Jet*> get_input(PHCompositeNode* topNode)
   {
     return std::vector<Jet*>();
   }
 
+  /// appends the input particles to the flat buffer used by JetReco,
+  /// by default translated from get_input()
+  virtual void fill_input(PHCompositeNode* topNode, JetParticles& particles)
+  {
+    std::vector<Jet*> parts = get_input(topNode);
+    particles.add(parts);
+    for (unsigned int i = 0; i < parts.size(); ++i) delete parts[i];
+  }
+
  protected:
   JetInput() {}
 
@@ -0,0 +1,241 @@
+#include "JetMapv2.h"
+
+#include "Jet.h"
+#include "Jetv2.h"
+
+#include <phool/PHObject.h>  // for PHObject
+
+#include <cmath>
+#include <iterator>  // for reverse_iterator
+#include <ostream>   // for operator<<, endl, ostream, basic_ostream::operat...
+#include <utility>   // for pair, make_pair
+
+using namespace std;
+
+JetMapv2::JetMapv2()
+  : _algo(Jet::NONE)
+  , _par(NAN)
+  , _src()
+  , _jets()
+  , _comp_src()
+  , _comp_id()
+  , _ncomp(0)
+  , _map()
+  , _free_slots()
+  , _index_valid(true)
+{
+}
+
+JetMapv2::JetMapv2(const JetMap* jets)
+  : JetMapv2()
+{
+  copy_from(jets);
+}
+
+JetMapv2::JetMapv2(const JetMapv2& jets)
+  : JetMapv2()
+{
+  copy_from(&jets);
+}
+
+JetMapv2& JetMapv2::operator=(const JetMapv2& jets)
+{
+  if (this == &jets) return *this;
+
+  Reset();
+  copy_from(&jets);
+  return *this;
+}
+
+void JetMapv2::copy_from(const JetMap* jets)
+{
+  _algo = jets->get_algo();
+  _par = jets->get_par();
+
+  for (ConstSrcIter iter = jets->begin_src();
+       iter != jets->end_src();
+       ++iter)
+  {
+    _src.insert(*iter);
+  }
+
+  for (ConstIter iter = jets->begin();
+       iter != jets->end();
+       ++iter)
+  {
+    Jetv2& jet = new_slot();
+    const Jetv2* jet_v2 = dynamic_cast<const Jetv2*>(iter->second);
+    if (jet_v2)
+    {
+      jet = *jet_v2;
+    }
+    else
+    {
+      jet = Jetv2(*iter->second);
+    }
+    _map.insert(make_pair(jet.get_id(), &jet));
+  }
+}
+
+void JetMapv2::Reset()
+{
+  _algo = Jet::NONE;
+  _par = NAN;
+  _src.clear();
+  _jets.clear();
+  _comp_src.clear();
+  _comp_id.clear();
+  _ncomp = 0;
+  _map.clear();
+  _free_slots.clear();
+  _index_valid = true;
+}
+
+void JetMapv2::identify(ostream& os) const
+{
+  os << "JetMapv2: size = " << size() << endl;
+  os << "          par = " << _par << endl;
+  os << "          source = ";
+  for (ConstSrcIter i = begin_src(); i != end_src(); ++i)
+  {
+    os << (*i) << ",";
+  }
+  os << endl;
+  os << "          constituents = " << _ncomp;
+  if (!has_comp()) os << " (not read)";
+  os << endl;
+
+  return;
+}
+
+const Jet* JetMapv2::get(unsigned int id) const
+{
+  ConstIter iter = jet_index().find(id);
+  if (iter == _map.end()) return nullptr;
+  return iter->second;
+}
+
+Jet* JetMapv2::get(unsigned int id)
+{
+  Iter iter = jet_index().find(id);
+  if (iter == _map.end()) return nullptr;
+  return iter->second;
+}
+
+Jet* JetMapv2::insert(Jet* jet)
+{
+  typ_JetMap& index_map = jet_index();
+
+  unsigned int index = 0;
+  if (!index_map.empty()) index = index_map.rbegin()->first + 1;
+
+  Jetv2& slot = new_slot();
+  const Jetv2* jet_v2 = dynamic_cast<const Jetv2*>(jet);
+  if (jet_v2)
+  {
+    slot = *jet_v2;
+  }
+  else
+  {
+    slot = Jetv2(*jet);
+  }
+  slot.set_id(index);
+  // the map owns the jet, which is stored as the copy
+  delete jet;
+
+  index_map.insert(make_pair(index, &slot));
+  return &slot;
+}
+
+size_t JetMapv2::erase(unsigned int idkey)
+{
+  typ_JetMap& index_map = jet_index();
+  Iter iter = index_map.find(idkey);
+  if (iter == index_map.end()) return 0;
+
+  Jetv2* jet = static_cast<Jetv2*>(iter->second);
+  for (unsigned int pos = 0; pos < _jets.size(); ++pos)
+  {
+    if (&_jets[pos] != jet) continue;
+
+    jet->Reset();
+    _free_slots.push_back(pos);
+    break;
+  }
+
+  index_map.erase(iter);
+  return 1;
+}
+
+Jetv2& JetMapv2::new_slot()
+{
+  Jetv2* jet = nullptr;
+  if (!_free_slots.empty())
+  {
+    jet = &_jets[_free_slots.back()];
+    _free_slots.pop_back();
+  }
+  else
+  {
+    // deque::push_back does not move the other jets
+    _jets.push_back(Jetv2());
+    jet = &_jets.back();
+  }
+
+  // new constituents go to the end of the buffer
+  jet->_jetmap = this;
+  jet->_comp_begin = _comp_id.size();
+  jet->_comp_size = 0;
+  jet->_comp_ids_valid = false;
+  return *jet;
+}
+
+void JetMapv2::shift_comp(const Jetv2* jet, unsigned int pos, int delta)
+{
+  for (Jetv2& other : _jets)
+  {
+    if (&other == jet || other._comp_begin < pos) continue;
+
+    if (delta > 0)
+    {
+      // an empty span at the start of jet may stay in front of it,
+      // all other spans starting at pos are behind the inserted constituents
+      if (other._comp_begin == pos && other._comp_size == 0 && pos == jet->_comp_begin) continue;
+      other._comp_begin += delta;
+    }
+    else
+    {
+      if (other._comp_begin == pos) continue;
+      // only empty spans start inside the erased range, they move to its start
+      if (other._comp_begin < pos + static_cast<unsigned int>(-delta))
+        other._comp_begin = pos;
+      else
+        other._comp_begin += delta;
+    }
+  }
+}
+
+JetMap::typ_JetMap& JetMapv2::jet_index() const
+{
+  if (!_index_valid)
+  {
+    _map.clear();
+    _free_slots.clear();
+    for (unsigned int pos = 0; pos < _jets.size(); ++pos)
+    {
+      Jetv2& jet = const_cast<Jetv2&>(_jets[pos]);
+      jet._jetmap = const_cast<JetMapv2*>(this);
+      jet._comp_ids_valid = false;
+      if (jet.get_id() == 0xFFFFFFFF)
+      {
+        _free_slots.push_back(pos);
+      }
+      else
+      {
+        _map.insert(make_pair(jet.get_id(), &jet));
+      }
+    }
+    _index_valid = true;
+  }
+  return _map;
+}
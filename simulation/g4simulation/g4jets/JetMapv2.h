@@ -0,0 +1,128 @@
+#ifndef G4JET_JETMAPV2_H
+#define G4JET_JETMAPV2_H
+
+#include "JetMap.h"
+
+#include "Jet.h"
+#include "Jetv2.h"
+
+#include <cstddef>  // for size_t
+#include <deque>
+#include <iostream>
+#include <set>
+#include <vector>
+
+class PHObject;
+
+/*!
+ * \brief JetMap with flat jet and constituent storage
+ *
+ * Same interface as JetMapv1. The jets are Jetv2 values in a deque, so a jet
+ * never moves and the pointers in the map stay valid until it is erased.
+ * insert() copies the jet to a Jetv2 and deletes it, use the returned jet.
+ * An erased jet leaves an empty slot which is reused by the next insert.
+ * The constituents of all jets are one buffer in which each jet has a
+ * contiguous span. The buffer is a separate branch on the DST, readers which
+ * do not need the constituents can disable the _comp_src and _comp_id
+ * branches, the jets then have no constituents (has_comp() is false).
+ * The id => jet map is a transient index, rebuilt after reading.
+ */
+class JetMapv2 : public JetMap
+{
+ public:
+  JetMapv2();
+  JetMapv2(const JetMap* jets);
+  JetMapv2(const JetMapv2& jets);
+  JetMapv2& operator=(const JetMapv2& jets);
+  virtual ~JetMapv2() {}
+
+  void identify(std::ostream& os = std::cout) const;
+  void Reset();
+  int isValid() const { return 1; }
+  PHObject* CloneMe() const { return new JetMapv2(*this); }
+
+  // map content info ----------------------------------------------------------
+
+  void set_algo(Jet::ALGO algo) { _algo = algo; }
+  Jet::ALGO get_algo() const { return _algo; }
+
+  void set_par(float par) { _par = par; }
+  float get_par() const { return _par; }
+
+  // set access to source identifiers ------------------------------------------
+
+  bool empty_src() const { return _src.empty(); }
+  void insert_src(Jet::SRC src) { _src.insert(src); }
+
+  ConstSrcIter begin_src() const { return _src.begin(); }
+  ConstSrcIter find_src(Jet::SRC src) const { return _src.find(src); }
+  ConstSrcIter end_src() const { return _src.end(); }
+
+  SrcIter begin_src() { return _src.begin(); }
+  SrcIter find_src(Jet::SRC src) { return _src.find(src); }
+  SrcIter end_src() { return _src.end(); }
+
+  // map access to jets --------------------------------------------------------
+
+  bool empty() const { return jet_index().empty(); }
+  size_t size() const { return jet_index().size(); }
+  size_t count(unsigned int idkey) const { return jet_index().count(idkey); }
+  void clear() { Reset(); }
+
+  const Jet* get(unsigned int idkey) const;
+  Jet* get(unsigned int idkey);
+
+  /// copy jet to the map and delete it, returns the stored jet
+  Jet* insert(Jet* jet);
+  size_t erase(unsigned int idkey);
+
+  ConstIter begin() const { return jet_index().begin(); }
+  ConstIter find(unsigned int idkey) const { return jet_index().find(idkey); }
+  ConstIter end() const { return jet_index().end(); }
+
+  Iter begin() { return jet_index().begin(); }
+  Iter find(unsigned int idkey) { return jet_index().find(idkey); }
+  Iter end() { return jet_index().end(); }
+
+  //! false if the constituents were not read
+  bool has_comp() const { return _comp_id.size() == _comp_src.size() && _comp_id.size() == _ncomp; }
+
+ private:
+  friend class Jetv2;
+
+  //! copy the jets of jets, converted to Jetv2
+  void copy_from(const JetMap* jets);
+
+  //! a slot for a new jet, reusing erased ones first
+  Jetv2& new_slot();
+
+  //! move the constituent spans of all jets but jet after delta constituents
+  //! were inserted (delta > 0) or erased (delta < 0) at position pos of the buffer
+  void shift_comp(const Jetv2* jet, unsigned int pos, int delta);
+
+  //! the map of jet pointers, rebuilt if it is not valid
+  typ_JetMap& jet_index() const;
+
+  Jet::ALGO _algo;          //< algorithm used to reconstruct jets
+  float _par;               //< algorithm parameter setting (e.g. radius)
+  std::set<Jet::SRC> _src;  //< list of sources (clusters, towers, etc)
+
+  //! jet storage. Empty slots have id 0xFFFFFFFF
+  std::deque<Jetv2> _jets;
+
+  //! constituents (source, component id) of all jets
+  std::vector<unsigned char> _comp_src;
+  std::vector<unsigned int> _comp_id;
+
+  //! number of constituents written, to tell if the buffer was read
+  unsigned int _ncomp;
+
+  //! id => jet in _jets
+  mutable typ_JetMap _map;                    //!
+  mutable std::vector<unsigned int> _free_slots;  //!
+  mutable bool _index_valid;                  //!
+
+  ClassDef(JetMapv2, 1);
+};
+
+#endif
@@ -0,0 +1,9 @@
+#ifdef __CINT__
+
+#pragma link C++ class JetMapv2 + ;
+#pragma link C++ class std::deque < Jetv2 > + ;
+
+// the jet index points into _jets, rebuild it after reading
+#pragma read sourceClass="JetMapv2" targetClass="JetMapv2" version="[1-]" source="" target="_index_valid" code="{ _index_valid = false; }"
+
+#endif /* __CINT__ */
@@ -0,0 +1,64 @@
+#include "JetParticles.h"
+
+#include "Jet.h"
+#include "Jetv1.h"
+
+#include <vector>
+
+using namespace std;
+
+void JetParticles::clear()
+{
+  m_px.clear();
+  m_py.clear();
+  m_pz.clear();
+  m_e.clear();
+  m_src.clear();
+  m_index.clear();
+}
+
+void JetParticles::reserve(const unsigned int n)
+{
+  m_px.reserve(n);
+  m_py.reserve(n);
+  m_pz.reserve(n);
+  m_e.reserve(n);
+  m_src.reserve(n);
+  m_index.reserve(n);
+}
+
+void JetParticles::add(const vector<Jet *> &particles)
+{
+  reserve(size() + particles.size());
+  for (unsigned int ipart = 0; ipart < particles.size(); ++ipart)
+  {
+    const Jet *particle = particles[ipart];
+    Jet::SRC src = Jet::VOID;
+    unsigned int index = 0;
+    Jet::ConstIter iter = particle->begin_comp();
+    if (iter != particle->end_comp())
+    {
+      src = iter->first;
+      index = iter->second;
+    }
+    add(particle->get_px(), particle->get_py(), particle->get_pz(), particle->get_e(), src, index);
+  }
+}
+
+vector<Jet *> JetParticles::make_jets() const
+{
+  vector<Jet *> jets;
+  jets.reserve(size());
+  for (unsigned int i = 0; i < size(); ++i)
+  {
+    Jet *jet = new Jetv1();
+    jet->set_px(m_px[i]);
+    jet->set_py(m_py[i]);
+    jet->set_pz(m_pz[i]);
+    jet->set_e(m_e[i]);
+    jet->set_id(i);
+    jet->insert_comp(m_src[i], m_index[i]);
+    jets.push_back(jet);
+  }
+  return jets;
+}
@@ -0,0 +1,60 @@
+#ifndef G4JET_JETPARTICLES_H
+#define G4JET_JETPARTICLES_H
+
+#include "Jet.h"
+
+#include <vector>
+
+/// \class JetParticles
+///
+/// \brief flat jet input particles of one event
+///
+/// The inputs of JetReco as plain arrays, one entry per particle with its
+/// four momentum, source and index in the source (tower, track, ...), which
+/// is the constituent stored in the jets. Filled by JetInput::fill_input,
+/// cleared (keeping the capacity) at the start of each event.
+class JetParticles
+{
+ public:
+  JetParticles() {}
+  virtual ~JetParticles() {}
+
+  void clear();
+  void reserve(const unsigned int n);
+
+  unsigned int size() const { return m_e.size(); }
+  bool empty() const { return m_e.empty(); }
+
+  void add(const float px, const float py, const float pz, const float e, const Jet::SRC src, const unsigned int index)
+  {
+    m_px.push_back(px);
+    m_py.push_back(py);
+    m_pz.push_back(pz);
+    m_e.push_back(e);
+    m_src.push_back(src);
+    m_index.push_back(index);
+  }
+
+  float get_px(const unsigned int i) const { return m_px[i]; }
+  float get_py(const unsigned int i) const { return m_py[i]; }
+  float get_pz(const unsigned int i) const { return m_pz[i]; }
+  float get_e(const unsigned int i) const { return m_e[i]; }
+  Jet::SRC get_src(const unsigned int i) const { return m_src[i]; }
+  unsigned int get_index(const unsigned int i) const { return m_index[i]; }
+
+  //! appends the particles, using the first component of each as source and index
+  void add(const std::vector<Jet*>& particles);
+
+  //! one Jetv1 per particle with id i, the caller owns them
+  std::vector<Jet*> make_jets() const;
+
+ private:
+  std::vector<float> m_px;
+  std::vector<float> m_py;
+  std::vector<float> m_pz;
+  std::vector<float> m_e;
+  std::vector<Jet::SRC> m_src;
+  std::vector<unsigned int> m_index;
+};
+
+#endif
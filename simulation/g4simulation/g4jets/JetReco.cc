@@ -1,11 +1,14 @@
 
 #include "JetReco.h"
 
+#include "FastJetAlgo.h"
 #include "Jet.h"
 #include "JetAlgo.h"
 #include "JetInput.h"
 #include "JetMap.h"
 #include "JetMapv1.h"
+#include "JetMapv2.h"
+#include "JetParticles.h"
 
 // PHENIX includes
 #include <fun4all/Fun4AllReturnCodes.h>
@@ -20,10 +23,15 @@
 #include <phool/getClass.h>
 #include <phool/phool.h>                 // for PHWHERE
 
+// fastjet includes
+#include <fastjet/PseudoJet.hh>
+
 // standard includes
+#include <atomic>
 #include <cstdlib>                      // for exit
 #include <iostream>
 #include <memory>                        // for allocator_traits<>::value_type
+#include <thread>
 #include <vector>
 
 using namespace std;
@@ -35,6 +43,9 @@ JetReco::JetReco(const string &name)
   , _algonode()
   , _inputnode()
   , _outputs()
+  , _nthreads(1)
+  , _use_jetmapv2(false)
+  , _particles()
 {
 }
 
@@ -64,6 +75,15 @@ int JetReco::InitRun(PHCompositeNode *topNode)
     cout << "===========================================================================" << endl;
   }
 
+  for (unsigned int i = 0; i < _inputs.size(); ++i)
+  {
+    if (_inputs[i]->InitRun(topNode) != 0)
+    {
+      cout << PHWHERE << " InitRun of input " << i << " failed" << endl;
+      return Fun4AllReturnCodes::ABORTRUN;
+    }
+  }
+
   return CreateNodes(topNode);
 }
 
@@ -75,32 +95,46 @@ int JetReco::process_event(PHCompositeNode *topNode)
   // Get Objects off of the Node Tree
   //---------------------------------
 
-  std::vector<Jet *> inputs;  // owns memory
+  // flat input buffer, the capacity is kept from event to event
+  _particles.clear();
   for (unsigned int iselect = 0; iselect < _inputs.size(); ++iselect)
   {
-    std::vector<Jet *> parts = _inputs[iselect]->get_input(topNode);
-    for (unsigned int ipart = 0; ipart < parts.size(); ++ipart)
-    {
-      inputs.push_back(parts[ipart]);
-      inputs.back()->set_id(inputs.size() - 1);  // unique ids ensured
-    }
+    _inputs[iselect]->fill_input(topNode, _particles);
   }
 
   //---------------------------
   // Run the jet reconstruction
   //---------------------------
+
+  // the inputs are translated to fastjet once, for all algorithms
+  std::vector<fastjet::PseudoJet> pseudojets = FastJetAlgo::get_pseudojets(_particles);
+
+  // the algorithms only read the inputs, so they run independently
+  std::vector<std::vector<Jet *> > jets(_algos.size());  // owns memory
+  std::atomic<unsigned int> next_algo(0);
+
+  auto run_algos = [&]() {
+    for (unsigned int ialgo = next_algo++; ialgo < _algos.size(); ialgo = next_algo++)
+    {
+      jets[ialgo] = _algos[ialgo]->get_jets_from_particles(_particles, pseudojets);
+    }
+  };
+
+  std::vector<std::thread> threads;
+  for (unsigned int ithread = 1; ithread < _nthreads && ithread < _algos.size(); ++ithread)
+    threads.push_back(std::thread(run_algos));
+
+  run_algos();
+
+  for (unsigned int ithread = 0; ithread < threads.size(); ++ithread)
+    threads[ithread].join();
+
   for (unsigned int ialgo = 0; ialgo < _algos.size(); ++ialgo)
   {
-    std::vector<Jet *> jets = _algos[ialgo]->get_jets(inputs);  // owns memory
-
     // send the output somewhere on the DST
-    FillJetNode(topNode, ialgo, jets);
+    FillJetNode(topNode, ialgo, jets[ialgo]);
   }
 
-  // clean up input vector
-  for (unsigned int i = 0; i < inputs.size(); ++i) delete inputs[i];
-  inputs.clear();
-
   if (Verbosity() > 1) cout << "JetReco::process_event -- exited" << endl;
 
   return Fun4AllReturnCodes::EVENT_OK;
@@ -144,7 +178,10 @@ int JetReco::CreateNodes(PHCompositeNode *topNode)
     JetMap *jets = findNode::getClass<JetMap>(topNode, _outputs[i]);
     if (!jets)
     {
-      jets = new JetMapv1();
+      if (_use_jetmapv2)
+        jets = new JetMapv2();
+      else
+        jets = new JetMapv1();
       PHIODataNode<PHObject> *JetMapNode = new PHIODataNode<PHObject>(jets, _outputs[i].c_str(), "PHObject");
       InputNode->addNode(JetMapNode);
     }
@@ -7,6 +7,8 @@
 /// \author Mike McCumber
 //===========================================================
 
+#include "JetParticles.h"
+
 // PHENIX includes
 #include <fun4all/SubsysReco.h>
 
@@ -49,6 +51,13 @@ class JetReco : public SubsysReco
   void set_algo_node(const std::string &algonode) { _algonode = algonode; }
   void set_input_node(const std::string &inputnode) { _inputnode = inputnode; }
 
+  /// run the algorithms in nthreads threads, the jet maps are filled in the
+  /// order the algorithms were added (needs a thread safe fastjet build)
+  void set_nthreads(unsigned int nthreads) { _nthreads = (nthreads > 0 ? nthreads : 1); }
+
+  /// write the jets as JetMapv2 (flat jet and constituent storage) instead of JetMapv1
+  void use_jetmapv2(bool b = true) { _use_jetmapv2 = b; }
+
  private:
   int CreateNodes(PHCompositeNode *topNode);
   void FillJetNode(PHCompositeNode *topNode, int ialgo, std::vector<Jet *> jets);
@@ -58,6 +67,11 @@ class JetReco : public SubsysReco
   std::string _algonode;
   std::string _inputnode;
   std::vector<std::string> _outputs;
+  unsigned int _nthreads;
+  bool _use_jetmapv2;
+
+  /// input particles of all inputs in the current event
+  JetParticles _particles;
 };
 
 #endif  // G4JET_JETRECO_H
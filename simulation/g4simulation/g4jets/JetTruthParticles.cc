@@ -0,0 +1,133 @@
+#include "JetTruthParticles.h"
+
+#include "Jet.h"
+#include "JetParticles.h"
+
+#include <g4main/PHG4Particle.h>
+#include <g4main/PHG4TruthInfoContainer.h>
+
+#include <phool/PHCompositeNode.h>
+#include <phool/PHDataNode.h>
+#include <phool/PHNodeIterator.h>
+#include <phool/getClass.h>
+#include <phool/phool.h>  // for PHWHERE
+
+#include <algorithm>  // std::find
+#include <cmath>      // for asinh, sqrt
+#include <cstdlib>
+#include <map>        // for _Rb_tree_const_iterator
+#include <utility>    // for pair
+
+using namespace std;
+
+JetTruthParticles::JetTruthParticles()
+  : m_Built(false)
+{
+}
+
+void JetTruthParticles::identify(ostream &os) const
+{
+  os << "JetTruthParticles: ";
+  if (!m_Built)
+  {
+    os << "not built" << endl;
+    return;
+  }
+  os << size() << " primary particles" << endl;
+}
+
+void JetTruthParticles::Reset()
+{
+  // clear() keeps the capacity for the next event
+  m_Px.clear();
+  m_Py.clear();
+  m_Pz.clear();
+  m_E.clear();
+  m_Eta.clear();
+  m_TrackId.clear();
+  m_EmbedId.clear();
+  m_Reject.clear();
+  m_Built = false;
+}
+
+JetTruthParticles *JetTruthParticles::GetParticles(PHCompositeNode *topNode, const PHG4TruthInfoContainer *truthinfo)
+{
+  JetTruthParticles *particles = findNode::getClass<JetTruthParticles>(topNode, GetNodeName());
+  if (!particles)
+  {
+    PHNodeIterator iter(topNode);
+    PHCompositeNode *dstNode = dynamic_cast<PHCompositeNode *>(iter.findFirst("PHCompositeNode", "DST"));
+    if (!dstNode)
+    {
+      cout << PHWHERE << "DST Node missing, exiting." << endl;
+      exit(1);
+    }
+    // transient, but under DST so it is reset after every event
+    particles = new JetTruthParticles();
+    dstNode->addNode(new PHDataNode<PHObject>(particles, GetNodeName(), "PHObject"));
+  }
+
+  if (!particles->m_Built)
+  {
+    particles->Build(truthinfo);
+  }
+  return particles;
+}
+
+void JetTruthParticles::Build(const PHG4TruthInfoContainer *truthinfo)
+{
+  Reset();
+
+  PHG4TruthInfoContainer::ConstRange range = truthinfo->GetPrimaryParticleRange();
+  for (PHG4TruthInfoContainer::ConstIterator iter = range.first;
+       iter != range.second;
+       ++iter)
+  {
+    const PHG4Particle *part = iter->second;
+
+    unsigned int reject = 0;
+
+    // remove some particles (muons, taus, neutrinos)...
+    // 12 == nu_e
+    // 13 == muons
+    // 14 == nu_mu
+    // 15 == taus
+    // 16 == nu_tau
+    if ((abs(part->get_pid()) >= 12) && (abs(part->get_pid()) <= 16)) reject |= kRejectPID;
+
+    float eta = NAN;
+    if ((part->get_px() == 0.0) && (part->get_py() == 0.0))  // avoid pt=0
+      reject |= kRejectNoPt;
+    else
+      eta = asinh(part->get_pz() / sqrt(pow(part->get_px(), 2) + pow(part->get_py(), 2)));
+
+    m_Px.push_back(part->get_px());
+    m_Py.push_back(part->get_py());
+    m_Pz.push_back(part->get_pz());
+    m_E.push_back(part->get_e());
+    m_Eta.push_back(eta);
+    m_TrackId.push_back(part->get_track_id());
+    m_EmbedId.push_back(truthinfo->isEmbeded(part->get_track_id()));
+    m_Reject.push_back(reject);
+  }
+
+  m_Built = true;
+}
+
+void JetTruthParticles::select(const float eta_min, const float eta_max, const vector<int> &embed_ids, JetParticles &particles) const
+{
+  const bool use_embed_stream = !embed_ids.empty();
+  for (unsigned int i = 0; i < size(); ++i)
+  {
+    if (m_Reject[i]) continue;
+    if (m_Eta[i] < eta_min) continue;
+    if (m_Eta[i] > eta_max) continue;
+
+    if (use_embed_stream && std::find(embed_ids.begin(), embed_ids.end(), m_EmbedId[i]) == embed_ids.end())
+    {
+      continue;  // reject particle as it is not in the interested embedding stream.
+    }
+
+    particles.add(m_Px[i], m_Py[i], m_Pz[i], m_E[i], Jet::PARTICLE, m_TrackId[i]);
+  }
+}
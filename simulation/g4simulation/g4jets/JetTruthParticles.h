@@ -0,0 +1,81 @@
+#ifndef G4JET_JETTRUTHPARTICLES_H
+#define G4JET_JETTRUTHPARTICLES_H
+
+/*!
+ *  \file JetTruthParticles.h
+ *  \brief primary truth particles of the event in flat arrays, shared by the truth jet inputs
+ *
+ *  The buffer lives as a transient node (JET_TRUTH_PARTICLES) under DST.
+ *  It is filled from G4TruthInfo on first use in an event and cleared by
+ *  the node reset at the end of the event, so the truth record is walked
+ *  once however many TruthJetInputs (and JetReco modules) use it. The
+ *  selections common to all truth jets are stored per particle as reject
+ *  bits, the eta range and embedding streams of each input are applied
+ *  when the particles are selected.
+ */
+
+#include <phool/PHObject.h>
+
+#include <iostream>
+#include <string>
+#include <vector>
+
+class JetParticles;
+class PHCompositeNode;
+class PHG4TruthInfoContainer;
+
+class JetTruthParticles : public PHObject
+{
+ public:
+  //! reasons to reject a particle for all truth jets
+  enum REJECT
+  {
+    //! neutrinos, muons and taus
+    kRejectPID = 1 << 0,
+    //! px = py = 0, no eta
+    kRejectNoPt = 1 << 1,
+  };
+
+  JetTruthParticles();
+  virtual ~JetTruthParticles() {}
+
+  void identify(std::ostream &os = std::cout) const;
+  void Reset();
+  int isValid() const { return m_Built; }
+
+  //! node holding the particles of this event, filled from truthinfo if it is not yet
+  static JetTruthParticles *GetParticles(PHCompositeNode *topNode, const PHG4TruthInfoContainer *truthinfo);
+
+  static std::string GetNodeName() { return "JET_TRUTH_PARTICLES"; }
+
+  unsigned int size() const { return m_TrackId.size(); }
+
+  double get_px(const unsigned int i) const { return m_Px[i]; }
+  double get_py(const unsigned int i) const { return m_Py[i]; }
+  double get_pz(const unsigned int i) const { return m_Pz[i]; }
+  double get_e(const unsigned int i) const { return m_E[i]; }
+  float get_eta(const unsigned int i) const { return m_Eta[i]; }
+  int get_track_id(const unsigned int i) const { return m_TrackId[i]; }
+  int get_embed_id(const unsigned int i) const { return m_EmbedId[i]; }
+  unsigned int get_reject(const unsigned int i) const { return m_Reject[i]; }
+
+  //! appends the particles without reject bits in [eta_min, eta_max] as Jet::PARTICLE,
+  //! only those of the listed embedding streams if embed_ids is not empty
+  void select(const float eta_min, const float eta_max, const std::vector<int> &embed_ids, JetParticles &particles) const;
+
+ private:
+  void Build(const PHG4TruthInfoContainer *truthinfo);
+
+  bool m_Built;
+
+  std::vector<double> m_Px;
+  std::vector<double> m_Py;
+  std::vector<double> m_Pz;
+  std::vector<double> m_E;
+  std::vector<float> m_Eta;
+  std::vector<int> m_TrackId;
+  std::vector<int> m_EmbedId;
+  std::vector<unsigned int> m_Reject;
+};
+
+#endif
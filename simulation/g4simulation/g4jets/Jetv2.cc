@@ -0,0 +1,389 @@
+#include "Jetv2.h"
+
+#include "JetMapv2.h"
+
+#include <algorithm>
+#include <cmath>
+#include <iostream>
+#include <iterator>  // for distance
+#include <utility>   // for make_pair
+
+using namespace std;
+
+Jetv2::Jetv2()
+  : _id(0xFFFFFFFF)
+  , _mom()
+  , _e(NAN)
+  , _property()
+  , _property_set(0)
+  , _property_map()
+  , _comp_src()
+  , _comp_id()
+  , _comp_begin(0)
+  , _comp_size(0)
+  , _jetmap(nullptr)
+  , _comp_ids()
+  , _comp_ids_valid(false)
+{
+  for (int i = 0; i < 3; ++i) _mom[i] = NAN;
+  for (unsigned int i = 0; i < kNumProperties; ++i) _property[i] = NAN;
+}
+
+Jetv2::Jetv2(const Jet& jet)
+  : Jetv2()
+{
+  copy_info(jet);
+  _comp_src.reserve(jet.size_comp());
+  _comp_id.reserve(jet.size_comp());
+  // the multimap is sorted by source already
+  for (ConstIter iter = jet.begin_comp(); iter != jet.end_comp(); ++iter)
+  {
+    _comp_src.push_back(iter->first);
+    _comp_id.push_back(iter->second);
+  }
+  _comp_size = _comp_id.size();
+}
+
+Jetv2::Jetv2(const Jetv2& jet)
+  : Jetv2()
+{
+  *this = jet;
+}
+
+Jetv2& Jetv2::operator=(const Jetv2& jet)
+{
+  if (this == &jet) return *this;
+
+  // a jet in a map keeps its span in the map buffer, standalone ones get their own arrays
+  copy_info(jet);
+  const size_t ncomp = jet.size_comp();
+  if (_jetmap)
+  {
+    clear_comp();
+    if (jet._jetmap == _jetmap)
+    {
+      // the buffer may move while inserting
+      const vector<unsigned char> src(jet.comp_src(), jet.comp_src() + ncomp);
+      const vector<unsigned int> id(jet.comp_id(), jet.comp_id() + ncomp);
+      insert_comp_range(0, src.data(), id.data(), ncomp);
+    }
+    else
+    {
+      insert_comp_range(0, jet.comp_src(), jet.comp_id(), ncomp);
+    }
+  }
+  else
+  {
+    _comp_src.assign(jet.comp_src(), jet.comp_src() + ncomp);
+    _comp_id.assign(jet.comp_id(), jet.comp_id() + ncomp);
+    _comp_begin = 0;
+    _comp_size = ncomp;
+    _comp_ids_valid = false;
+  }
+  return *this;
+}
+
+void Jetv2::copy_info(const Jet& jet)
+{
+  _id = jet.get_id();
+  _mom[0] = jet.get_px();
+  _mom[1] = jet.get_py();
+  _mom[2] = jet.get_pz();
+  _e = jet.get_e();
+
+  const Jetv2* jet_v2 = dynamic_cast<const Jetv2*>(&jet);
+  if (jet_v2)
+  {
+    copy(jet_v2->_property, jet_v2->_property + kNumProperties, _property);
+    _property_set = jet_v2->_property_set;
+    _property_map = jet_v2->_property_map;
+    return;
+  }
+
+  // the Jet interface has no loop over properties, ask for each known one
+  for (unsigned int i = 0; i < kNumProperties; ++i) _property[i] = NAN;
+  _property_set = 0;
+  _property_map.clear();
+  for (unsigned int i = 0; i < kNumProperties; ++i)
+  {
+    const Jet::PROPERTY prop_id = static_cast<Jet::PROPERTY>(i);
+    if (jet.has_property(prop_id)) set_property(prop_id, jet.get_property(prop_id));
+  }
+}
+
+void Jetv2::identify(ostream& os) const
+{
+  os << "---Jet v2-----------------------" << endl;
+  os << "jetid: " << get_id() << endl;
+  os << " (px,py,pz,e) =  (" << get_px() << ", " << get_py() << ", ";
+  os << get_pz() << ", " << get_e() << ") GeV" << endl;
+  print_property(os);
+  for (size_t i = 0; i < size_comp(); ++i)
+  {
+    os << get_comp_src(i) << " -> " << get_comp_id(i) << endl;
+  }
+  os << "-----------------------------------------------" << endl;
+
+  return;
+}
+
+void Jetv2::Reset()
+{
+  _id = 0xFFFFFFFF;
+  for (int i = 0; i < 3; ++i) _mom[i] = NAN;
+  _e = NAN;
+  for (unsigned int i = 0; i < kNumProperties; ++i) _property[i] = NAN;
+  _property_set = 0;
+  _property_map.clear();
+  clear_comp();
+}
+
+int Jetv2::isValid() const
+{
+  if (_id == 0xFFFFFFFF) return 0;
+  for (int i = 0; i < 3; ++i)
+  {
+    if (isnan(_mom[i])) return 0;
+  }
+  if (isnan(_e)) return 0;
+  if (empty_comp()) return 0;
+  return 1;
+}
+
+float Jetv2::get_p() const
+{
+  return sqrt(get_px() * get_px() + get_py() * get_py() + get_pz() * get_pz());
+}
+
+float Jetv2::get_pt() const
+{
+  return sqrt(get_px() * get_px() + get_py() * get_py());
+}
+
+float Jetv2::get_et() const
+{
+  return get_pt() / get_p() * get_e();
+}
+
+float Jetv2::get_eta() const
+{
+  return asinh(get_pz() / get_pt());
+}
+
+float Jetv2::get_phi() const
+{
+  return atan2(get_py(), get_px());
+}
+
+float Jetv2::get_mass() const
+{
+  // follow CLHEP convention and return negative mass if E^2 - p^2 < 0
+  float mass2 = get_mass2();
+  if (mass2 < 0)
+    return -1 * sqrt(fabs(mass2));
+  else
+    return sqrt(mass2);
+}
+
+float Jetv2::get_mass2() const
+{
+  float p2 = get_px() * get_px() + get_py() * get_py() + get_pz() * get_pz();
+  return get_e() * get_e() - p2;
+}
+
+bool Jetv2::has_property(Jet::PROPERTY prop_id) const
+{
+  const unsigned int i = prop_id;
+  if (i < kNumProperties) return _property_set & (1U << i);
+  return _property_map.find(prop_id) != _property_map.end();
+}
+
+float Jetv2::get_property(Jet::PROPERTY prop_id) const
+{
+  const unsigned int i = prop_id;
+  if (i < kNumProperties) return _property[i];
+
+  typ_property_map::const_iterator citer = _property_map.find(prop_id);
+  if (citer == _property_map.end())
+    return NAN;
+  else
+    return citer->second;
+}
+
+void Jetv2::set_property(Jet::PROPERTY prop_id, float value)
+{
+  const unsigned int i = prop_id;
+  if (i < kNumProperties)
+  {
+    _property[i] = value;
+    _property_set |= (1U << i);
+  }
+  else
+  {
+    _property_map[prop_id] = value;
+  }
+}
+
+void Jetv2::print_property(ostream& os) const
+{
+  for (unsigned int i = 0; i < kNumProperties; ++i)
+  {
+    if (_property_set & (1U << i)) print_property(os, static_cast<Jet::PROPERTY>(i), _property[i]);
+  }
+  for (typ_property_map::const_iterator citer = _property_map.begin();
+       citer != _property_map.end(); ++citer)
+  {
+    print_property(os, citer->first, citer->second);
+  }
+}
+
+void Jetv2::print_property(ostream& os, Jet::PROPERTY prop_id, float value)
+{
+  os << " ";  //indent
+
+  switch (prop_id)
+  {
+  case prop_JetCharge:
+    os << "Jet Charge";
+    break;
+  case prop_BFrac:
+    os << "Jet B-quark fraction";
+    break;
+  default:
+    os << "Property[" << prop_id << "]";
+    break;
+  }
+
+  os << "\t= " << value << endl;
+}
+
+size_t Jetv2::size_comp() const
+{
+  if (_jetmap && !_jetmap->has_comp()) return 0;
+  return _comp_size;
+}
+
+size_t Jetv2::count_comp(SRC source) const
+{
+  return comp_bound(source, true) - comp_bound(source, false);
+}
+
+void Jetv2::clear_comp()
+{
+  erase_comp_range(0, size_comp());
+}
+
+void Jetv2::insert_comp(SRC source, unsigned int compid)
+{
+  // like the multimap, after the constituents from the same source
+  insert_comp_at(comp_bound(source, true), source, compid);
+}
+
+size_t Jetv2::erase_comp(SRC source)
+{
+  const size_t first = comp_bound(source, false);
+  const size_t last = comp_bound(source, true);
+  erase_comp_range(first, last);
+  return last - first;
+}
+
+void Jetv2::erase_comp(Iter iter)
+{
+  // the multimap view has the order of the array
+  const size_t pos = distance(_comp_ids.begin(), iter);
+  erase_comp_range(pos, pos + 1);
+}
+
+void Jetv2::erase_comp(Iter first, Iter last)
+{
+  const size_t pos = distance(_comp_ids.begin(), first);
+  erase_comp_range(pos, pos + distance(first, last));
+}
+
+const unsigned char* Jetv2::comp_src() const
+{
+  if (_jetmap) return _jetmap->_comp_src.data() + _comp_begin;
+  return _comp_src.data();
+}
+
+const unsigned int* Jetv2::comp_id() const
+{
+  if (_jetmap) return _jetmap->_comp_id.data() + _comp_begin;
+  return _comp_id.data();
+}
+
+void Jetv2::insert_comp_at(size_t pos, SRC source, unsigned int compid)
+{
+  const unsigned char src = source;
+  insert_comp_range(pos, &src, &compid, 1);
+}
+
+void Jetv2::insert_comp_range(size_t pos, const unsigned char* src, const unsigned int* id, size_t n)
+{
+  if (n == 0) return;
+
+  if (_jetmap)
+  {
+    if (!_jetmap->has_comp())
+    {
+      cout << "Jetv2::insert_comp - constituents of the jet map were not read, not inserting " << n << " constituents" << endl;
+      return;
+    }
+    const unsigned int buffer_pos = _comp_begin + pos;
+    _jetmap->_comp_src.insert(_jetmap->_comp_src.begin() + buffer_pos, src, src + n);
+    _jetmap->_comp_id.insert(_jetmap->_comp_id.begin() + buffer_pos, id, id + n);
+    _jetmap->_ncomp = _jetmap->_comp_id.size();
+    _jetmap->shift_comp(this, buffer_pos, n);
+  }
+  else
+  {
+    _comp_src.insert(_comp_src.begin() + pos, src, src + n);
+    _comp_id.insert(_comp_id.begin() + pos, id, id + n);
+  }
+  _comp_size += n;
+  _comp_ids_valid = false;
+}
+
+void Jetv2::erase_comp_range(size_t first, size_t last)
+{
+  if (first >= last) return;
+
+  if (_jetmap)
+  {
+    const unsigned int buffer_pos = _comp_begin + first;
+    _jetmap->_comp_src.erase(_jetmap->_comp_src.begin() + buffer_pos, _jetmap->_comp_src.begin() + _comp_begin + last);
+    _jetmap->_comp_id.erase(_jetmap->_comp_id.begin() + buffer_pos, _jetmap->_comp_id.begin() + _comp_begin + last);
+    _jetmap->_ncomp = _jetmap->_comp_id.size();
+    _jetmap->shift_comp(this, buffer_pos, -static_cast<int>(last - first));
+  }
+  else
+  {
+    _comp_src.erase(_comp_src.begin() + first, _comp_src.begin() + last);
+    _comp_id.erase(_comp_id.begin() + first, _comp_id.begin() + last);
+  }
+  _comp_size -= last - first;
+  _comp_ids_valid = false;
+}
+
+size_t Jetv2::comp_bound(SRC source, bool upper) const
+{
+  const unsigned char* begin = comp_src();
+  const unsigned char* end = begin + size_comp();
+  const unsigned char src = source;
+  if (upper) return upper_bound(begin, end, src) - begin;
+  return lower_bound(begin, end, src) - begin;
+}
+
+Jet::typ_comp_ids& Jetv2::comp_ids() const
+{
+  if (!_comp_ids_valid)
+  {
+    _comp_ids.clear();
+    for (size_t i = 0; i < size_comp(); ++i)
+    {
+      _comp_ids.insert(_comp_ids.end(), make_pair(get_comp_src(i), get_comp_id(i)));
+    }
+    _comp_ids_valid = true;
+  }
+  return _comp_ids;
+}
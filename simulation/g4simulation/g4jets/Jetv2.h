@@ -0,0 +1,169 @@
+#ifndef G4JET_JETV2_H
+#define G4JET_JETV2_H
+
+#include "Jet.h"
+
+#include <cstddef>  // for size_t
+#include <iostream>
+#include <map>
+#include <vector>
+
+class JetMapv2;
+class PHObject;
+
+/*!
+ * \brief Jet with flat property and constituent storage
+ *
+ * Same interface as Jetv1. The properties of the Jet::PROPERTY enum are a
+ * fixed array, properties added to the enum later go to a map.
+ * The constituents are a contiguous array sorted by source, in the order of
+ * the multimap of Jetv1. A jet in a JetMapv2 keeps them as a span of the
+ * constituent buffer shared by all jets of the map, a standalone jet (new,
+ * or a copy of a jet in a map) in its own arrays.
+ * get_comp_src(i) and get_comp_id(i) read the array directly. The multimap
+ * iterators of the Jet interface point into a transient copy which is built
+ * on first use; changing iter->second through it is not stored in the jet.
+ */
+class Jetv2 : public Jet
+{
+ public:
+  Jetv2();
+  explicit Jetv2(const Jet& jet);
+  Jetv2(const Jetv2& jet);
+  Jetv2& operator=(const Jetv2& jet);
+  virtual ~Jetv2() {}
+
+  // PHObject virtual overloads
+
+  void identify(std::ostream& os = std::cout) const;
+  void Reset();
+  int isValid() const;
+  PHObject* CloneMe() const { return new Jetv2(*this); }
+
+  // jet info
+
+  unsigned int get_id() const { return _id; }
+  void set_id(unsigned int id) { _id = id; }
+
+  float get_px() const { return _mom[0]; }
+  void set_px(float px) { _mom[0] = px; }
+
+  float get_py() const { return _mom[1]; }
+  void set_py(float py) { _mom[1] = py; }
+
+  float get_pz() const { return _mom[2]; }
+  void set_pz(float pz) { _mom[2] = pz; }
+
+  float get_e() const { return _e; }
+  void set_e(float e) { _e = e; }
+
+  float get_p() const;
+  float get_pt() const;
+  float get_et() const;
+  float get_eta() const;
+  float get_phi() const;
+  float get_mass() const;
+  float get_mass2() const;
+
+  // extended jet info
+
+  bool has_property(Jet::PROPERTY prop_id) const;
+  float get_property(Jet::PROPERTY prop_id) const;
+  void set_property(Jet::PROPERTY prop_id, float value);
+  void print_property(std::ostream& os) const;
+
+  //
+  // clustered component methods (multimap interface based)
+  // source type id --> unique id within that storage
+  //
+  bool empty_comp() const { return size_comp() == 0; }
+  size_t size_comp() const;
+  size_t count_comp(SRC source) const;
+
+  void clear_comp();
+  void insert_comp(SRC source, unsigned int compid);
+  size_t erase_comp(SRC source);
+  void erase_comp(Iter iter);
+  void erase_comp(Iter first, Iter last);
+
+  ConstIter begin_comp() const { return comp_ids().begin(); }
+  ConstIter lower_bound_comp(SRC source) const { return comp_ids().lower_bound(source); }
+  ConstIter upper_bound_comp(SRC source) const { return comp_ids().upper_bound(source); }
+  ConstIter find(SRC source) const { return comp_ids().find(source); }
+  ConstIter end_comp() const { return comp_ids().end(); }
+
+  Iter begin_comp() { return comp_ids().begin(); }
+  Iter lower_bound_comp(SRC source) { return comp_ids().lower_bound(source); }
+  Iter upper_bound_comp(SRC source) { return comp_ids().upper_bound(source); }
+  Iter find(SRC source) { return comp_ids().find(source); }
+  Iter end_comp() { return comp_ids().end(); }
+
+  //! \name flat constituent access, 0 <= i < size_comp()
+  //@{
+  Jet::SRC get_comp_src(size_t i) const { return static_cast<Jet::SRC>(comp_src()[i]); }
+  unsigned int get_comp_id(size_t i) const { return comp_id()[i]; }
+  //@}
+
+  //! properties with an id below this are stored in the fixed array
+  static const unsigned int kNumProperties = 5;
+
+ private:
+  friend class JetMapv2;
+
+  //! copy the kinematics and properties of jet
+  void copy_info(const Jet& jet);
+
+  static void print_property(std::ostream& os, Jet::PROPERTY prop_id, float value);
+
+  //! first constituent of this jet
+  const unsigned char* comp_src() const;
+  const unsigned int* comp_id() const;
+
+  //! insert (source, compid) at position pos in the constituents of this jet
+  void insert_comp_at(size_t pos, SRC source, unsigned int compid);
+  void insert_comp_range(size_t pos, const unsigned char* src, const unsigned int* id, size_t n);
+
+  //! erase constituents [first, last) of this jet
+  void erase_comp_range(size_t first, size_t last);
+
+  //! position of the first constituent from source (upper = false) or after it (upper = true)
+  size_t comp_bound(SRC source, bool upper) const;
+
+  //! the multimap view of the constituents, rebuilt if it is not valid
+  typ_comp_ids& comp_ids() const;
+
+  /// unique identifier within container
+  unsigned int _id;
+
+  /// jet momentum vector (px,py,pz)
+  float _mom[3];
+
+  /// jet energy
+  float _e;
+
+  /// properties with id < kNumProperties, bit prop_id of _property_set is set if it is filled
+  float _property[kNumProperties];
+  unsigned int _property_set;
+
+  typedef std::map<Jet::PROPERTY, float> typ_property_map;
+  /// properties with id >= kNumProperties
+  typ_property_map _property_map;
+
+  /// constituents of a standalone jet (source, component id)
+  std::vector<unsigned char> _comp_src;
+  std::vector<unsigned int> _comp_id;
+
+  /// constituent span in the buffer of the map holding this jet
+  unsigned int _comp_begin;
+  unsigned int _comp_size;
+
+  /// map holding this jet, nullptr for a standalone jet
+  JetMapv2* _jetmap;  //!
+
+  mutable typ_comp_ids _comp_ids;  //!
+  mutable bool _comp_ids_valid;    //!
+
+  ClassDef(Jetv2, 1);
+};
+
+#endif  // G4JET_JETV2_H
@@ -1,12 +1,12 @@
 #include "TowerJetInput.h"
 
 #include "Jet.h"
-#include "Jetv1.h"
+#include "JetParticles.h"
 
 #include <calobase/RawTower.h>
 #include <calobase/RawTowerContainer.h>
-#include <calobase/RawTowerGeom.h>
 #include <calobase/RawTowerGeomContainer.h>
+#include <calobase/RawTowerGeomTable.h>
 
 #include <g4vertex/GlobalVertex.h>
 #include <g4vertex/GlobalVertexMap.h>
@@ -17,6 +17,7 @@
 #include <cmath>                             // for asinh, atan2, cos, cosh
 #include <iostream>
 #include <map>                               // for _Rb_tree_const_iterator
+#include <string>
 #include <utility>                           // for pair
 #include <vector>
 
@@ -25,6 +26,7 @@ using namespace std;
 TowerJetInput::TowerJetInput(Jet::SRC input)
   : _verbosity(0)
   , _input(input)
+  , _geom(nullptr)
 {
 }
 
@@ -44,7 +46,101 @@ void TowerJetInput::identify(std::ostream &os)
   os << endl;
 }
 
+bool TowerJetInput::get_node_names(std::string &tower_node, std::string &geom_node) const
+{
+  switch (_input)
+  {
+  case Jet::CEMC_TOWER:
+    tower_node = "TOWER_CALIB_CEMC";
+    geom_node = "TOWERGEOM_CEMC";
+    break;
+  case Jet::HCALIN_TOWER:
+    tower_node = "TOWER_CALIB_HCALIN";
+    geom_node = "TOWERGEOM_HCALIN";
+    break;
+  case Jet::HCALOUT_TOWER:
+    tower_node = "TOWER_CALIB_HCALOUT";
+    geom_node = "TOWERGEOM_HCALOUT";
+    break;
+  case Jet::FEMC_TOWER:
+    tower_node = "TOWER_CALIB_FEMC";
+    geom_node = "TOWERGEOM_FEMC";
+    break;
+  case Jet::FHCAL_TOWER:
+    tower_node = "TOWER_CALIB_FHCAL";
+    geom_node = "TOWERGEOM_FHCAL";
+    break;
+  case Jet::CEMC_TOWER_RETOWER:
+    tower_node = "TOWER_CALIB_CEMC_RETOWER";
+    geom_node = "TOWERGEOM_HCALIN";
+    break;
+  case Jet::CEMC_TOWER_SUB1:
+    tower_node = "TOWER_CALIB_CEMC_RETOWER_SUB1";
+    geom_node = "TOWERGEOM_HCALIN";
+    break;
+  case Jet::HCALIN_TOWER_SUB1:
+    tower_node = "TOWER_CALIB_HCALIN_SUB1";
+    geom_node = "TOWERGEOM_HCALIN";
+    break;
+  case Jet::HCALOUT_TOWER_SUB1:
+    tower_node = "TOWER_CALIB_HCALOUT_SUB1";
+    geom_node = "TOWERGEOM_HCALOUT";
+    break;
+  case Jet::CEMC_TOWER_SUB1CS:
+    tower_node = "TOWER_CALIB_CEMC_RETOWER_SUB1CS";
+    geom_node = "TOWERGEOM_HCALIN";
+    break;
+  case Jet::HCALIN_TOWER_SUB1CS:
+    tower_node = "TOWER_CALIB_HCALIN_SUB1CS";
+    geom_node = "TOWERGEOM_HCALIN";
+    break;
+  case Jet::HCALOUT_TOWER_SUB1CS:
+    tower_node = "TOWER_CALIB_HCALOUT_SUB1CS";
+    geom_node = "TOWERGEOM_HCALOUT";
+    break;
+  default:
+    return false;
+  }
+  return true;
+}
+
+void TowerJetInput::build_geometry(RawTowerGeomContainer *geom)
+{
+  _geom_table.build(geom);
+  _geom = geom;
+
+  // the tower directions in the transverse plane do not depend on the vertex
+  const unsigned int ntowers = _geom_table.size();
+  _radius.resize(ntowers);
+  _cos_phi.resize(ntowers);
+  _sin_phi.resize(ntowers);
+  for (unsigned int i = 0; i < ntowers; ++i)
+  {
+    const double x = _geom_table.get_center_x(i);
+    const double y = _geom_table.get_center_y(i);
+    _radius[i] = sqrt(x * x + y * y);
+    const double phi = atan2(y, x);
+    _cos_phi[i] = cos(phi);
+    _sin_phi[i] = sin(phi);
+  }
+}
+
+int TowerJetInput::InitRun(PHCompositeNode *topNode)
+{
+  // the tables are rebuilt from the geometry of this run on the next event
+  _geom = nullptr;
+  _geom_table.clear();
+  return 0;
+}
+
 std::vector<Jet *> TowerJetInput::get_input(PHCompositeNode *topNode)
+{
+  JetParticles particles;
+  fill_input(topNode, particles);
+  return particles.make_jets();
+}
+
+void TowerJetInput::fill_input(PHCompositeNode *topNode, JetParticles &particles)
 {
   if (_verbosity > 0) cout << "TowerJetInput::process_event -- entered" << endl;
 
@@ -54,128 +150,26 @@ std::vector<Jet *> TowerJetInput::get_input(PHCompositeNode *topNode)
     cout << "TowerJetInput::get_input - Fatal Error - GlobalVertexMap node is missing. Please turn on the do_global flag in the main macro in order to reconstruct the global vertex." << endl;
     assert(vertexmap);  // force quit
 
-    return std::vector<Jet *>();
+    return;
   }
 
   if (vertexmap->empty())
   {
     cout << "TowerJetInput::get_input - Fatal Error - GlobalVertexMap node is empty. Please turn on the do_bbc or tracking reco flags in the main macro in order to reconstruct the global vertex." << endl;
-    return std::vector<Jet *>();
+    return;
   }
 
-  RawTowerContainer *towers = nullptr;
-  RawTowerGeomContainer *geom = nullptr;
-  if (_input == Jet::CEMC_TOWER)
-  {
-    towers = findNode::getClass<RawTowerContainer>(topNode, "TOWER_CALIB_CEMC");
-    geom = findNode::getClass<RawTowerGeomContainer>(topNode, "TOWERGEOM_CEMC");
-    if (!towers || !geom)
-    {
-      return std::vector<Jet *>();
-    }
-  }
-  else if (_input == Jet::HCALIN_TOWER)
+  std::string tower_node;
+  std::string geom_node;
+  if (!get_node_names(tower_node, geom_node))
   {
-    towers = findNode::getClass<RawTowerContainer>(topNode, "TOWER_CALIB_HCALIN");
-    geom = findNode::getClass<RawTowerGeomContainer>(topNode, "TOWERGEOM_HCALIN");
-    if (!towers || !geom)
-    {
-      return std::vector<Jet *>();
-    }
-  }
-  else if (_input == Jet::HCALOUT_TOWER)
-  {
-    towers = findNode::getClass<RawTowerContainer>(topNode, "TOWER_CALIB_HCALOUT");
-    geom = findNode::getClass<RawTowerGeomContainer>(topNode, "TOWERGEOM_HCALOUT");
-    if (!towers || !geom)
-    {
-      return std::vector<Jet *>();
-    }
+    return;
   }
-  else if (_input == Jet::FEMC_TOWER)
+  RawTowerContainer *towers = findNode::getClass<RawTowerContainer>(topNode, tower_node);
+  RawTowerGeomContainer *geom = findNode::getClass<RawTowerGeomContainer>(topNode, geom_node);
+  if (!towers || !geom)
   {
-    towers = findNode::getClass<RawTowerContainer>(topNode, "TOWER_CALIB_FEMC");
-    geom = findNode::getClass<RawTowerGeomContainer>(topNode, "TOWERGEOM_FEMC");
-    if (!towers || !geom)
-    {
-      return std::vector<Jet *>();
-    }
-  }
-  else if (_input == Jet::FHCAL_TOWER)
-  {
-    towers = findNode::getClass<RawTowerContainer>(topNode, "TOWER_CALIB_FHCAL");
-    geom = findNode::getClass<RawTowerGeomContainer>(topNode, "TOWERGEOM_FHCAL");
-    if (!towers || !geom)
-    {
-      return std::vector<Jet *>();
-    }
-  }
-  else if (_input == Jet::CEMC_TOWER_RETOWER)
-  {
-    towers = findNode::getClass<RawTowerContainer>(topNode, "TOWER_CALIB_CEMC_RETOWER");
-    geom = findNode::getClass<RawTowerGeomContainer>(topNode, "TOWERGEOM_HCALIN");
-    if (!towers || !geom)
-    {
-      return std::vector<Jet *>();
-    }
-  }
-  else if (_input == Jet::CEMC_TOWER_SUB1)
-  {
-    towers = findNode::getClass<RawTowerContainer>(topNode, "TOWER_CALIB_CEMC_RETOWER_SUB1");
-    geom = findNode::getClass<RawTowerGeomContainer>(topNode, "TOWERGEOM_HCALIN");
-    if (!towers || !geom)
-    {
-      return std::vector<Jet *>();
-    }
-  }
-  else if (_input == Jet::HCALIN_TOWER_SUB1)
-  {
-    towers = findNode::getClass<RawTowerContainer>(topNode, "TOWER_CALIB_HCALIN_SUB1");
-    geom = findNode::getClass<RawTowerGeomContainer>(topNode, "TOWERGEOM_HCALIN");
-    if (!towers || !geom)
-    {
-      return std::vector<Jet *>();
-    }
-  }
-  else if (_input == Jet::HCALOUT_TOWER_SUB1)
-  {
-    towers = findNode::getClass<RawTowerContainer>(topNode, "TOWER_CALIB_HCALOUT_SUB1");
-    geom = findNode::getClass<RawTowerGeomContainer>(topNode, "TOWERGEOM_HCALOUT");
-    if (!towers || !geom)
-    {
-      return std::vector<Jet *>();
-    }
-  }
-  else if (_input == Jet::CEMC_TOWER_SUB1CS)
-  {
-    towers = findNode::getClass<RawTowerContainer>(topNode, "TOWER_CALIB_CEMC_RETOWER_SUB1CS");
-    geom = findNode::getClass<RawTowerGeomContainer>(topNode, "TOWERGEOM_HCALIN");
-    if (!towers || !geom)
-    {
-      return std::vector<Jet *>();
-    }
-  }
-  else if (_input == Jet::HCALIN_TOWER_SUB1CS)
-  {
-    towers = findNode::getClass<RawTowerContainer>(topNode, "TOWER_CALIB_HCALIN_SUB1CS");
-    geom = findNode::getClass<RawTowerGeomContainer>(topNode, "TOWERGEOM_HCALIN");
-    if (!towers || !geom)
-    {
-      return std::vector<Jet *>();
-    }
-  }
-  else if (_input == Jet::HCALOUT_TOWER_SUB1CS)
-  {
-    towers = findNode::getClass<RawTowerContainer>(topNode, "TOWER_CALIB_HCALOUT_SUB1CS");
-    geom = findNode::getClass<RawTowerGeomContainer>(topNode, "TOWERGEOM_HCALOUT");
-    if (!towers || !geom)
-    {
-      return std::vector<Jet *>();
-    }
-  }
-  else
-  {
-    return std::vector<Jet *>();
+    return;
   }
 
   // first grab the event vertex or bail
@@ -184,7 +178,7 @@ std::vector<Jet *> TowerJetInput::get_input(PHCompositeNode *topNode)
   if (vtx)
     vtxz = vtx->get_z();
   else
-    return std::vector<Jet *>();
+    return;
 
   if (isnan(vtxz))
   {
@@ -196,44 +190,38 @@ std::vector<Jet *> TowerJetInput::get_input(PHCompositeNode *topNode)
       cout << "TowerJetInput::get_input - WARNING - vertex is NAN. Drop all tower inputs (further NAN-vertex warning will be suppressed)." << endl;
     }
 
-    return std::vector<Jet *>();
+    return;
+  }
+
+  if (geom != _geom || _geom_table.empty())
+  {
+    build_geometry(geom);
   }
 
-  std::vector<Jet *> pseudojets;
+  particles.reserve(particles.size() + towers->size());
   RawTowerContainer::ConstRange begin_end = towers->getTowers();
   RawTowerContainer::ConstIterator rtiter;
   for (rtiter = begin_end.first; rtiter != begin_end.second; ++rtiter)
   {
     RawTower *tower = rtiter->second;
 
-    RawTowerGeom *tower_geom =
-        geom->get_tower_geometry(tower->get_key());
-    assert(tower_geom);
-
-    double r = tower_geom->get_center_radius();
-    double phi = atan2(tower_geom->get_center_y(), tower_geom->get_center_x());
-    double z0 = tower_geom->get_center_z();
-
-    double z = z0 - vtxz;
-
-    double eta = asinh(z / r);  // eta after shift from vertex
-
-    double pt = tower->get_energy() / cosh(eta);
-    double px = pt * cos(phi);
-    double py = pt * sin(phi);
-    double pz = pt * sinh(eta);
+    const int igeom = _geom_table.find(tower->get_key());
+    if (igeom < 0)
+    {
+      cout << "TowerJetInput::get_input - tower " << tower->get_id()
+           << " has no geometry in " << geom_node << ", skipped" << endl;
+      continue;
+    }
 
-    Jet *jet = new Jetv1();
-    jet->set_px(px);
-    jet->set_py(py);
-    jet->set_pz(pz);
-    jet->set_e(tower->get_energy());
-    jet->insert_comp(_input, tower->get_id());
+    // eta after shift from vertex, pt = e / cosh(eta), pz = pt * sinh(eta)
+    const double r = _radius[igeom];
+    const double z = _geom_table.get_center_z(igeom) - vtxz;
+    const double e = tower->get_energy();
+    const double pt = e * r / sqrt(r * r + z * z);
+    const double pz = e * z / sqrt(r * r + z * z);
 
-    pseudojets.push_back(jet);
+    particles.add(pt * _cos_phi[igeom], pt * _sin_phi[igeom], pz, e, _input, tower->get_id());
   }
 
   if (_verbosity > 0) cout << "TowerJetInput::process_event -- exited" << endl;
-
-  return pseudojets;
 }
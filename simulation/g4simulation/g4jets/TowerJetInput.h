@@ -5,11 +5,15 @@
 
 #include "Jet.h"
 
+#include <calobase/RawTowerGeomTable.h>
+
 #include <iostream>    // for cout, ostream
+#include <string>
 #include <vector>
 
 // forward declarations
 class PHCompositeNode;
+class RawTowerGeomContainer;
 
 class TowerJetInput : public JetInput
 {
@@ -21,11 +25,25 @@ class TowerJetInput : public JetInput
 
   Jet::SRC get_src() { return _input; }
 
+  int InitRun(PHCompositeNode* topNode);
+
   std::vector<Jet*> get_input(PHCompositeNode* topNode);
+  void fill_input(PHCompositeNode* topNode, JetParticles& particles);
 
  private:
+  bool get_node_names(std::string& tower_node, std::string& geom_node) const;
+
+  //! flat copy of the geometry with the transverse tower directions, per run
+  void build_geometry(RawTowerGeomContainer* geom);
+
   int _verbosity;
   Jet::SRC _input;
+
+  RawTowerGeomContainer* _geom;
+  RawTowerGeomTable _geom_table;
+  std::vector<double> _radius;
+  std::vector<double> _cos_phi;
+  std::vector<double> _sin_phi;
 };
 
 #endif
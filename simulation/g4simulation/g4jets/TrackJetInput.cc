@@ -1,7 +1,7 @@
 #include "TrackJetInput.h"
 
 #include "Jet.h"
-#include "Jetv1.h"
+#include "JetParticles.h"
 
 #include <trackbase_historic/SvtxTrack.h>
 #include <trackbase_historic/SvtxTrackMap.h>
@@ -28,6 +28,13 @@ void TrackJetInput::identify(std::ostream &os)
 }
 
 std::vector<Jet *> TrackJetInput::get_input(PHCompositeNode *topNode)
+{
+  JetParticles particles;
+  fill_input(topNode, particles);
+  return particles.make_jets();
+}
+
+void TrackJetInput::fill_input(PHCompositeNode *topNode, JetParticles &particles)
 {
   if (_verbosity > 0) cout << "TrackJetInput::process_event -- entered" << endl;
 
@@ -35,26 +42,18 @@ std::vector<Jet *> TrackJetInput::get_input(PHCompositeNode *topNode)
   SvtxTrackMap *trackmap = findNode::getClass<SvtxTrackMap>(topNode, "SvtxTrackMap");
   if (!trackmap)
   {
-    return std::vector<Jet *>();
+    return;
   }
 
-  std::vector<Jet *> pseudojets;
+  particles.reserve(particles.size() + trackmap->size());
   for (SvtxTrackMap::ConstIter iter = trackmap->begin();
        iter != trackmap->end();
        ++iter)
   {
     const SvtxTrack *track = iter->second;
-
-    Jet *jet = new Jetv1();
-    jet->set_px(track->get_px());
-    jet->set_py(track->get_py());
-    jet->set_pz(track->get_pz());
-    jet->set_e(track->get_p());
-    jet->insert_comp(Jet::TRACK, track->get_id());
-    pseudojets.push_back(jet);
+    particles.add(track->get_px(), track->get_py(), track->get_pz(), track->get_p(),
+                  Jet::TRACK, track->get_id());
   }
 
   if (_verbosity > 0) cout << "TrackJetInput::process_event -- exited" << endl;
-
-  return pseudojets;
 }
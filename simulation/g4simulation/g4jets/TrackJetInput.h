@@ -21,6 +21,7 @@ class TrackJetInput : public JetInput
   Jet::SRC get_src() { return _input; }
 
   std::vector<Jet*> get_input(PHCompositeNode* topNode);
+  void fill_input(PHCompositeNode* topNode, JetParticles& particles);
 
  private:
   int _verbosity;
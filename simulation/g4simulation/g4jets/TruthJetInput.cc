@@ -2,21 +2,16 @@
 #include "TruthJetInput.h"
 
 #include "Jet.h"
-#include "Jetv1.h"
+#include "JetParticles.h"
+#include "JetTruthParticles.h"
 
-#include <g4main/PHG4Particle.h>
 #include <g4main/PHG4TruthInfoContainer.h>
 
 #include <phool/getClass.h>
 #include <phool/phool.h>                    // for PHWHERE
 
 // standard includes
-#include <algorithm>  // std::find
-#include <cmath>                           // for asinh, sqrt
-#include <cstdlib>
 #include <iostream>
-#include <map>                              // for _Rb_tree_const_iterator
-#include <utility>                          // for pair
 #include <vector>
 
 using namespace std;
@@ -44,6 +39,13 @@ void TruthJetInput::identify(std::ostream &os)
 }
 
 std::vector<Jet *> TruthJetInput::get_input(PHCompositeNode *topNode)
+{
+  JetParticles particles;
+  fill_input(topNode, particles);
+  return particles.make_jets();
+}
+
+void TruthJetInput::fill_input(PHCompositeNode *topNode, JetParticles &particles)
 {
   if (_verbosity > 0) cout << "TruthJetInput::process_event -- entered" << endl;
 
@@ -52,51 +54,12 @@ std::vector<Jet *> TruthJetInput::get_input(PHCompositeNode *topNode)
   if (!truthinfo)
   {
     cerr << PHWHERE << " ERROR: Can't find G4TruthInfo" << endl;
-    return std::vector<Jet *>();
+    return;
   }
 
-  std::vector<Jet *> pseudojets;
-  PHG4TruthInfoContainer::ConstRange range = truthinfo->GetPrimaryParticleRange();
-  for (PHG4TruthInfoContainer::ConstIterator iter = range.first;
-       iter != range.second;
-       ++iter)
-  {
-    PHG4Particle *part = iter->second;
-
-    if (use_embed_stream())
-    {
-      const int this_embed_id = truthinfo->isEmbeded(part->get_track_id());
-
-      if (std::find(_embed_id.begin(), _embed_id.end(), this_embed_id) == _embed_id.end())
-      {
-        continue;  // reject particle as it is not in the interested embedding stream.
-      }
-    }
-
-    // remove some particles (muons, taus, neutrinos)...
-    // 12 == nu_e
-    // 13 == muons
-    // 14 == nu_mu
-    // 15 == taus
-    // 16 == nu_tau
-    if ((abs(part->get_pid()) >= 12) && (abs(part->get_pid()) <= 16)) continue;
-
-    // remove acceptance... _etamin,_etamax
-    if ((part->get_px() == 0.0) && (part->get_py() == 0.0)) continue;  // avoid pt=0
-    float eta = asinh(part->get_pz() / sqrt(pow(part->get_px(), 2) + pow(part->get_py(), 2)));
-    if (eta < _eta_min) continue;
-    if (eta > _eta_max) continue;
-
-    Jet *jet = new Jetv1();
-    jet->set_px(part->get_px());
-    jet->set_py(part->get_py());
-    jet->set_pz(part->get_pz());
-    jet->set_e(part->get_e());
-    jet->insert_comp(Jet::PARTICLE, part->get_track_id());
-    pseudojets.push_back(jet);
-  }
+  // the truth record is converted once per event, for all truth inputs
+  JetTruthParticles *truthparticles = JetTruthParticles::GetParticles(topNode, truthinfo);
+  truthparticles->select(_eta_min, _eta_max, _embed_id, particles);
 
   if (_verbosity > 0) cout << "TruthJetInput::process_event -- exited" << endl;
-
-  return pseudojets;
 }
@@ -30,6 +30,7 @@ class TruthJetInput : public JetInput
   Jet::SRC get_src() { return _input; }
 
   std::vector<Jet*> get_input(PHCompositeNode* topNode);
+  void fill_input(PHCompositeNode* topNode, JetParticles& particles);
 
   void set_eta_range(float eta_min, float eta_max)
   {
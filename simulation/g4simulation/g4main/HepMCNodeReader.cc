@@ -1,7 +1,6 @@
 #include "HepMCNodeReader.h"
 #include "PHG4InEvent.h"
 #include "PHG4Particle.h"
-#include "PHG4Particlev1.h"
 
 #include <fun4all/Fun4AllReturnCodes.h>
 
@@ -25,6 +24,9 @@
 #include <HepMC/SimpleVector.h>
 #include <HepMC/Units.h>
 
+#include <TDatabasePDG.h>
+#include <TParticlePDG.h>
+
 #include <gsl/gsl_const.h>
 #include <gsl/gsl_randist.h>
 #include <gsl/gsl_rng.h>
@@ -62,6 +64,19 @@ class IsStateFinal
 
 static IsStateFinal isfinal;
 
+//! Lorentz boost of (x, y, z, t) by beta, t in the units of x (ct or E)
+static void boost(const double beta[3], double &x, double &y, double &z, double &t)
+{
+  const double beta2 = beta[0] * beta[0] + beta[1] * beta[1] + beta[2] * beta[2];
+  const double gamma = 1. / sqrt(1. - beta2);
+  const double bp = beta[0] * x + beta[1] * y + beta[2] * z;
+  const double factor = (gamma - 1.) * bp / beta2 + gamma * t;
+  x += factor * beta[0];
+  y += factor * beta[1];
+  z += factor * beta[2];
+  t = gamma * (t + bp);
+}
+
 HepMCNodeReader::HepMCNodeReader(const std::string &name)
   : SubsysReco(name)
   , use_seed(0)
@@ -73,6 +88,12 @@ HepMCNodeReader::HepMCNodeReader(const std::string &name)
   , width_vx(0.0)
   , width_vy(0.0)
   , width_vz(0.0)
+  , filter_etamin(NAN)
+  , filter_etamax(NAN)
+  , filter_eta_boost(0.0)
+  , filter_ptmin(NAN)
+  , filter_reach_radius(NAN)
+  , filter_reach_bz(0.0)
 {
   RandomGenerator = gsl_rng_alloc(gsl_rng_mt19937);
   return;
@@ -212,8 +233,14 @@ int HepMCNodeReader::process_event(PHCompositeNode *topNode)
     else if (width_vz < 0.0)
       zshift += smearflat(width_vz);
 
-    std::list<HepMC::GenParticle *> finalstateparticles;
-    std::list<HepMC::GenParticle *>::const_iterator fiter;
+    // the boost of the collision is applied here, the HepMC record stays as it is
+    const double beta[3] = {genevt->get_boost_beta_vector().x(), genevt->get_boost_beta_vector().y(), genevt->get_boost_beta_vector().z()};
+    const bool boosted = (beta[0] != 0 || beta[1] != 0 || beta[2] != 0);
+    const double c_cm_per_ns = GSL_CONST_CGS_SPEED_OF_LIGHT * 1e-9;
+
+    // final state particles with their momentum in GeV in the Hall frame
+    std::list<std::pair<HepMC::GenParticle *, HepMC::FourVector> > finalstateparticles;
+    std::list<std::pair<HepMC::GenParticle *, HepMC::FourVector> >::const_iterator fiter;
 
     // units in G4 interface are GeV and CM as in PHENIX convention
     const double mom_factor = HepMC::Units::conversion_factor(evt->momentum_unit(), HepMC::Units::GEV);
@@ -225,6 +252,21 @@ int HepMCNodeReader::process_event(PHCompositeNode *topNode)
          ++v)
     {
       finalstateparticles.clear();
+      double xpos = (*v)->position().x() * length_factor;
+      double ypos = (*v)->position().y() * length_factor;
+      double zpos = (*v)->position().z() * length_factor;
+      double time = (*v)->position().t() * time_factor;
+      if (boosted)
+      {
+        double ct = time * c_cm_per_ns;
+        boost(beta, xpos, ypos, zpos, ct);
+        time = ct / c_cm_per_ns;
+      }
+      xpos += xshift;
+      ypos += yshift;
+      zpos += zshift;
+      time += tshift;
+      const double vtxradius = hypot(xpos, ypos);
       for (HepMC::GenVertex::particle_iterator p =
                (*v)->particles_begin(HepMC::children);
            p != (*v)->particles_end(HepMC::children); ++p)
@@ -234,11 +276,24 @@ int HepMCNodeReader::process_event(PHCompositeNode *topNode)
 	  (*p)->print();
 	  cout<<"end vertex "<<(*p)->end_vertex()<<endl;
 	}
-        if (isfinal(*p))
+        if (!isfinal(*p))
+        {
+          continue;
+        }
+        double px = (*p)->momentum().px() * mom_factor;
+        double py = (*p)->momentum().py() * mom_factor;
+        double pz = (*p)->momentum().pz() * mom_factor;
+        double e = (*p)->momentum().e() * mom_factor;
+        if (boosted)
+        {
+          boost(beta, px, py, pz, e);
+        }
+        const HepMC::FourVector momentum(px, py, pz, e);
+        if (pass_filter(*p, momentum, vtxradius))
         {
 	  if(Verbosity()>1)
 	    cout<<"partile passed "<<endl;
-          finalstateparticles.push_back(*p);
+          finalstateparticles.push_back(make_pair(*p, momentum));
         }else{
 	  if(Verbosity()>1)
 	    cout<<"partivle failed"<<endl;
@@ -248,11 +303,6 @@ int HepMCNodeReader::process_event(PHCompositeNode *topNode)
 
       if (!finalstateparticles.empty())
       {
-        double xpos = (*v)->position().x() * length_factor + xshift;
-        double ypos = (*v)->position().y() * length_factor + yshift;
-        double zpos = (*v)->position().z() * length_factor + zshift;
-        double time = (*v)->position().t() * time_factor + tshift;
-
         if (Verbosity() > 1)
         {
           cout << "Vertex : " << endl;
@@ -303,14 +353,15 @@ int HepMCNodeReader::process_event(PHCompositeNode *topNode)
              ++fiter)
         {
 
-          if (Verbosity() > 1) (*fiter)->print();
+          if (Verbosity() > 1) fiter->first->print();
 
-          PHG4Particle *particle = new PHG4Particlev1();
-          particle->set_pid((*fiter)->pdg_id());
-          particle->set_px((*fiter)->momentum().px() * mom_factor);
-          particle->set_py((*fiter)->momentum().py() * mom_factor);
-          particle->set_pz((*fiter)->momentum().pz() * mom_factor);
-          particle->set_barcode((*fiter)->barcode());
+          // from the particle pool of PHG4InEvent, no allocation per particle
+          PHG4Particle *particle = ineve->NewParticle();
+          particle->set_pid(fiter->first->pdg_id());
+          particle->set_px(fiter->second.px());
+          particle->set_py(fiter->second.py());
+          particle->set_pz(fiter->second.pz());
+          particle->set_barcode(fiter->first->barcode());
 
           ineve->AddParticle(vtxindex, particle);
 
@@ -327,6 +378,57 @@ int HepMCNodeReader::process_event(PHCompositeNode *topNode)
   return Fun4AllReturnCodes::EVENT_OK;
 }
 
+bool HepMCNodeReader::pass_filter(const HepMC::GenParticle *p, const HepMC::FourVector &momentum, const double vtxradius) const
+{
+  if (!filter_pids.empty() && filter_pids.find(p->pdg_id()) == filter_pids.end())
+  {
+    return false;
+  }
+  const double px = momentum.px();
+  const double py = momentum.py();
+  const double pt = sqrt(px * px + py * py);
+  if (isfinite(filter_ptmin) && pt < filter_ptmin)
+  {
+    return false;
+  }
+  if (isfinite(filter_etamin) || isfinite(filter_etamax))
+  {
+    if (pt <= 0)
+    {
+      return false;
+    }
+    // longitudinal boost into the frame of the eta cut
+    const double pz = cosh(filter_eta_boost) * momentum.pz() - sinh(filter_eta_boost) * momentum.e();
+    const double eta = asinh(pz / pt);
+    if ((isfinite(filter_etamin) && eta < filter_etamin) ||
+        (isfinite(filter_etamax) && eta > filter_etamax))
+    {
+      return false;
+    }
+  }
+  if (isfinite(filter_reach_radius))
+  {
+    const int abspid = abs(p->pdg_id());
+    if (abspid == 12 || abspid == 14 || abspid == 16)
+    {
+      return false;
+    }
+    TParticlePDG *pdg_p = TDatabasePDG::Instance()->GetParticle(p->pdg_id());
+    // TParticlePDG charge is in units of |e|/3, unknown particles (nuclei) are kept
+    const double charge = (pdg_p ? fabs(pdg_p->Charge()) / 3. : 0);
+    if (charge > 0 && filter_reach_bz != 0)
+    {
+      // the helix gets at most two radii (pt/0.3 q B in m) away from its production point
+      const double helix_diameter = 2 * 100. * pt / (0.3 * charge * fabs(filter_reach_bz));
+      if (vtxradius + helix_diameter < filter_reach_radius)
+      {
+        return false;
+      }
+    }
+  }
+  return true;
+}
+
 double HepMCNodeReader::smeargauss(const double width)
 {
   if (width == 0) return 0;
@@ -10,10 +10,17 @@
 #include <gsl/gsl_rng.h>
 #endif
 
+#include <set>
 #include <string>
 
 class PHCompositeNode;
 
+namespace HepMC
+{
+  class FourVector;
+  class GenParticle;
+}
+
 //! HepMCNodeReader take input from all subevents from PHHepMCGenEventMap and send them to simulation in Geant4
 //! For HepMC subevent which is already simulated, they will not be simulated again in Geant4.
 class HepMCNodeReader : public SubsysReco
@@ -51,7 +58,30 @@ class HepMCNodeReader : public SubsysReco
     use_seed = 1;
   }
 
+  //! generator level filter, applied to the final state HepMC particles before they
+  //! are converted into PHG4Particles, default is to keep everything
+
+  //! keep only these particle species (pdg id with sign)
+  void AddPid(const int pid) { filter_pids.insert(pid); }
+  void set_eta_range(const double min, const double max)
+  {
+    filter_etamin = min;
+    filter_etamax = max;
+  }
+  //! rapidity of the frame in which the eta range is applied (e.g. the center of mass of asymmetric beams)
+  void set_eta_boost(const double y) { filter_eta_boost = y; }
+  void set_ptmin(const double pt) { filter_ptmin = pt; }
+  //! drop neutrinos and charged particles which cannot get further than radius r (cm) from the beam axis
+  //! in a solenoid field of bz (Tesla), use the inner radius of the innermost detector
+  void set_reach_radius(const double r, const double bz)
+  {
+    filter_reach_radius = r;
+    filter_reach_bz = bz;
+  }
+
  private:
+  //! generator level filter, momentum in GeV in the Hall frame, vtxradius is the distance of the production vertex from the beam axis in cm
+  bool pass_filter(const HepMC::GenParticle *p, const HepMC::FourVector &momentum, const double vtxradius) const;
   double smeargauss(const double width);
   double smearflat(const double width);
   int use_seed;
@@ -64,6 +94,14 @@ class HepMCNodeReader : public SubsysReco
   double width_vy;
   double width_vz;
 
+  std::set<int> filter_pids;
+  double filter_etamin;
+  double filter_etamax;
+  double filter_eta_boost;
+  double filter_ptmin;
+  double filter_reach_radius;
+  double filter_reach_bz;
+
 #if !defined(__CINT__) || defined(__CLING__)
   gsl_rng *RandomGenerator;
 #endif
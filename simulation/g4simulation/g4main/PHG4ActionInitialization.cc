@@ -0,0 +1,149 @@
+#include "PHG4ActionInitialization.h"
+
+#include "PHG4EventAction.h"
+#include "PHG4PhenixEventAction.h"
+#include "PHG4PhenixSteppingAction.h"
+#include "PHG4PhenixTrackingAction.h"
+#include "PHG4PrimaryGeneratorAction.h"
+#include "PHG4SteppingAction.h"
+#include "PHG4SubEventStore.h"
+#include "PHG4Subsystem.h"
+#include "PHG4TrackingAction.h"
+
+#include <Geant4/G4Event.hh>
+#include <Geant4/G4EventManager.hh>
+#include <Geant4/G4Threading.hh>
+
+#include <iostream>
+#include <vector>
+
+class G4TrackingManager;
+class PHCompositeNode;
+
+using namespace std;
+
+namespace
+{
+  //! first event action of a worker: resets the worker actions of the
+  //! subsystems and points them to the node tree of the new sub event,
+  //! as Fun4All and the subsystems do for the actions of the event
+  class PHG4SubEventAction : public PHG4EventAction
+  {
+   public:
+    explicit PHG4SubEventAction(PHG4SubEventStore *store)
+      : m_Store(store)
+    {
+    }
+
+    virtual ~PHG4SubEventAction() {}
+
+    void BeginOfEventAction(const G4Event *evt)
+    {
+      PHCompositeNode *topNode = m_Store->GetSubEvent(evt->GetEventID());
+      for (PHG4EventAction *action : m_EventActions)
+      {
+        action->ResetEvent(topNode);
+        action->SetInterfacePointers(topNode);
+      }
+      for (PHG4SteppingAction *action : m_SteppingActions)
+      {
+        action->SetInterfacePointers(topNode);
+      }
+      for (PHG4TrackingAction *action : m_TrackingActions)
+      {
+        action->ResetEvent(topNode);
+        action->SetInterfacePointers(topNode);
+      }
+    }
+
+    //! the actions are owned by the PHG4Phenix... actions of the worker
+    std::vector<PHG4EventAction *> m_EventActions;
+    std::vector<PHG4SteppingAction *> m_SteppingActions;
+    std::vector<PHG4TrackingAction *> m_TrackingActions;
+
+   private:
+    PHG4SubEventStore *m_Store;
+  };
+}  // namespace
+
+PHG4ActionInitialization::PHG4ActionInitialization(const list<PHG4Subsystem *> &subsystems, PHG4SubEventStore *store, const bool disable_user_actions)
+  : m_SubsystemList(subsystems)
+  , m_SubEventStore(store)
+  , m_disableUserActions(disable_user_actions)
+  , m_Verbosity(0)
+  , m_InEvent(nullptr)
+  , m_NSubEvents(1)
+{
+}
+
+void PHG4ActionInitialization::Build() const
+{
+  lock_guard<mutex> lock(m_Mutex);
+
+  if (m_Verbosity > 0)
+  {
+    cout << "PHG4ActionInitialization::Build - creating actions for worker thread " << G4Threading::G4GetThreadId() << endl;
+  }
+
+  // the threads are started by the first BeamOn, after SetInEvent
+  PHG4PrimaryGeneratorAction *generator = new PHG4PrimaryGeneratorAction();
+  generator->SetInEvent(m_InEvent);
+  generator->SetSubEvents(m_NSubEvents);
+  m_GeneratorActions.push_back(generator);
+  SetUserAction(generator);
+
+  if (m_disableUserActions)
+  {
+    return;
+  }
+
+  PHG4PhenixEventAction *eventaction = new PHG4PhenixEventAction();
+  PHG4PhenixSteppingAction *steppingaction = new PHG4PhenixSteppingAction();
+  PHG4PhenixTrackingAction *trackingaction = new PHG4PhenixTrackingAction();
+  // runs before the event actions of the subsystems
+  PHG4SubEventAction *subeventaction = new PHG4SubEventAction(m_SubEventStore);
+  eventaction->AddAction(subeventaction);
+  for (PHG4Subsystem *g4sub : m_SubsystemList)
+  {
+    PHG4EventAction *evtact = g4sub->CreateWorkerEventAction();
+    if (evtact)
+    {
+      eventaction->AddAction(evtact);
+      subeventaction->m_EventActions.push_back(evtact);
+    }
+
+    PHG4SteppingAction *stpact = g4sub->CreateWorkerSteppingAction();
+    if (stpact)
+    {
+      steppingaction->AddAction(stpact);
+      subeventaction->m_SteppingActions.push_back(stpact);
+    }
+
+    PHG4TrackingAction *trkact = g4sub->CreateWorkerTrackingAction();
+    if (trkact)
+    {
+      trackingaction->AddAction(trkact);
+      subeventaction->m_TrackingActions.push_back(trkact);
+      // the tracking manager of this thread
+      if (G4TrackingManager *trackingManager = G4EventManager::GetEventManager()->GetTrackingManager())
+      {
+        trkact->SetTrackingManagerPointer(trackingManager);
+      }
+    }
+  }
+  SetUserAction(eventaction);
+  SetUserAction(steppingaction);
+  SetUserAction(trackingaction);
+}
+
+void PHG4ActionInitialization::SetInEvent(PHG4InEvent *inevt, const int nsub)
+{
+  lock_guard<mutex> lock(m_Mutex);
+  m_InEvent = inevt;
+  m_NSubEvents = nsub;
+  for (PHG4PrimaryGeneratorAction *generator : m_GeneratorActions)
+  {
+    generator->SetInEvent(inevt);
+    generator->SetSubEvents(nsub);
+  }
+}
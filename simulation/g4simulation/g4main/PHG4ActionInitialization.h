@@ -0,0 +1,55 @@
+// Tell emacs that this is a C++ source
+//  -*- C++ -*-.
+#ifndef G4MAIN_PHG4ACTIONINITIALIZATION_H
+#define G4MAIN_PHG4ACTIONINITIALIZATION_H
+
+#include <Geant4/G4VUserActionInitialization.hh>
+
+#include <list>
+#include <mutex>
+#include <vector>
+
+class PHG4InEvent;
+class PHG4PrimaryGeneratorAction;
+class PHG4SubEventStore;
+class PHG4Subsystem;
+
+//! creates the user actions of the Geant4 worker threads. Each worker gets
+//! its own generator and PHG4Phenix event, stepping and tracking actions
+//! holding the worker actions of the subsystems (PHG4Subsystem::CreateWorker...).
+//! At the start of each G4Event the actions are reset and pointed to the
+//! node tree of that sub event (PHG4SubEventStore)
+class PHG4ActionInitialization : public G4VUserActionInitialization
+{
+ public:
+  PHG4ActionInitialization(const std::list<PHG4Subsystem *> &subsystems, PHG4SubEventStore *store, const bool disable_user_actions);
+
+  virtual ~PHG4ActionInitialization() {}
+
+  //! called by geant on each worker thread
+  virtual void Build() const;
+
+  //! input event for the generators of all workers, its primaries split into nsub G4Events.
+  //! Call before BeamOn(nsub), the workers are idle then
+  void SetInEvent(PHG4InEvent *inevt, const int nsub);
+
+  void Verbosity(const int verb) { m_Verbosity = verb; }
+
+ private:
+  std::list<PHG4Subsystem *> m_SubsystemList;
+  PHG4SubEventStore *m_SubEventStore;
+  bool m_disableUserActions;
+  int m_Verbosity;
+
+  //! current input event, for workers started during BeamOn
+  PHG4InEvent *m_InEvent;
+  int m_NSubEvents;
+
+  //! Build() runs on all workers at the same time, the subsystems do not expect that
+  mutable std::mutex m_Mutex;
+
+  //! generators of the workers (owned by their run managers)
+  mutable std::vector<PHG4PrimaryGeneratorAction *> m_GeneratorActions;
+};
+
+#endif
@@ -6,9 +6,15 @@
 #include <Geant4/G4LogicalVolume.hh>
 #include <Geant4/G4Material.hh>
 #include <Geant4/G4PVPlacement.hh>
+#include <Geant4/G4ProductionCuts.hh>
+#include <Geant4/G4Region.hh>
+#include <Geant4/G4RegionStore.hh>
 #include <Geant4/G4ThreeVector.hh>  // for G4ThreeVector
+#include <Geant4/G4VPhysicalVolume.hh>
 #include <Geant4/G4VisAttributes.hh>
 
+#include <iostream>
+
 PHG4Detector::PHG4Detector(PHG4Subsystem *subsys, PHCompositeNode *Node, const std::string &nam)
   : m_topNode(Node)
   , m_MySubsystem(subsys)
@@ -16,23 +22,51 @@ PHG4Detector::PHG4Detector(PHG4Subsystem *subsys, PHCompositeNode *Node, const s
   , m_OverlapCheck(false)
   , m_ColorIndex(0)
   , m_Name(nam)
+  , m_Region("")
 {
 }
 
 void PHG4Detector::Construct(G4LogicalVolume *world)
 {
   PHG4Subsystem *MyMotherSubsystem = m_MySubsystem->GetMotherSubsystem();
-  if (MyMotherSubsystem)
+  G4LogicalVolume *mother = (MyMotherSubsystem ? MyMotherSubsystem->GetLogicalVolume() : world);
+  const int ndaughters = mother->GetNoDaughters();
+  ConstructMe(mother);
+  if (m_Region.empty())
+  {
+    return;
+  }
+  // everything this detector placed in its mother volume goes into the region,
+  // the daughters of these volumes inherit it
+  G4Region *region = FindOrCreateRegion(m_Region);
+  for (int i = ndaughters; i < mother->GetNoDaughters(); ++i)
   {
-    ConstructMe(MyMotherSubsystem->GetLogicalVolume());
+    G4LogicalVolume *logvol = mother->GetDaughter(i)->GetLogicalVolume();
+    if (!logvol->IsRootRegion())
+    {
+      region->AddRootLogicalVolume(logvol);
+    }
   }
-  else
+  if (Verbosity() > 0)
   {
-    ConstructMe(world);
+    std::cout << GetName() << ": " << mother->GetNoDaughters() - ndaughters
+              << " volumes in region " << m_Region << std::endl;
   }
   return;
 }
 
+G4Region *PHG4Detector::FindOrCreateRegion(const std::string &name)
+{
+  G4RegionStore *regionstore = G4RegionStore::GetInstance();
+  G4Region *region = regionstore->GetRegion(name, false);
+  if (!region)
+  {
+    region = new G4Region(name);
+    region->SetProductionCuts(new G4ProductionCuts(*(regionstore->GetRegion("DefaultRegionForTheWorld")->GetProductionCuts())));
+  }
+  return region;
+}
+
 int PHG4Detector::DisplayVolume(G4VSolid *volume, G4LogicalVolume *logvol, G4RotationMatrix *rotm)
 {
   G4LogicalVolume *checksolid = new G4LogicalVolume(volume, G4Material::GetMaterial("G4_POLYSTYRENE"), "DISPLAYLOGICAL", 0, 0, 0);
@@ -9,6 +9,7 @@
 #include <string>
 
 class G4LogicalVolume;
+class G4Region;
 class G4UserSteppingAction;
 class G4VSolid;
 class PHCompositeNode;
@@ -55,6 +56,13 @@ class PHG4Detector
   virtual PHCompositeNode *topNode() { return m_topNode; }
   virtual PHG4Subsystem *GetMySubsystem() {return m_MySubsystem;}
 
+  //! put the volumes placed by ConstructMe() into this G4Region (e.g. for production cuts)
+  void SetRegion(const std::string &name) { m_Region = name; }
+  const std::string &GetRegion() const { return m_Region; }
+
+  //! existing region or new one with the production cuts of the world
+  static G4Region *FindOrCreateRegion(const std::string &name);
+
  private:
   PHCompositeNode *m_topNode;
   PHG4Subsystem *m_MySubsystem;
@@ -62,6 +70,7 @@ class PHG4Detector
   bool m_OverlapCheck;
   int m_ColorIndex;
   std::string m_Name;
+  std::string m_Region;
 };
 
 #endif  // G4MAIN_PHG4DETECTOR_H
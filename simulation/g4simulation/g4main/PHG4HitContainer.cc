@@ -2,22 +2,25 @@
 
 #include "PHG4Hit.h"
 #include "PHG4Hitv1.h"
+#include "PHG4Hitv2.h"
 
 #include <phool/phool.h>
+#include <phool/recoConsts.h>
 
 #include <TSystem.h>
 
+#include <algorithm>
 #include <cstdlib>
 
 using namespace std;
 
 PHG4HitContainer::PHG4HitContainer()
-  : id(-1), hitmap(), layers()
+  : id(-1), hitmap(), layers(), m_TimeIndexValid(false)
 {
 }
 
 PHG4HitContainer::PHG4HitContainer(const std::string &nodename)
-  : id(PHG4HitDefs::get_volume_id(nodename)), hitmap(), layers()
+  : id(PHG4HitDefs::get_volume_id(nodename)), hitmap(), layers(), m_TimeIndexValid(false)
 {
 }
 
@@ -29,6 +32,7 @@ PHG4HitContainer::Reset()
        delete hitmap.begin()->second;
        hitmap.erase(hitmap.begin());
      }
+  m_TimeIndexValid = false;
   return;
 }
 
@@ -66,12 +70,9 @@ PHG4HitContainer::getmaxkey(const unsigned int detid)
     {
       return  0;
     }
-  PHG4HitDefs::keytype detidlong = detid;
-  PHG4HitDefs::keytype shiftval = detidlong << PHG4HitDefs::hit_idbits;
   ConstIterator lastlayerentry = miter.second;
   --lastlayerentry;
-  PHG4HitDefs::keytype iret = lastlayerentry->first - shiftval; // subtract layer mask
-  return iret;
+  return PHG4HitDefs::get_index(lastlayerentry->first);
 }
 
 
@@ -84,14 +85,13 @@ PHG4HitContainer::genkey(const unsigned int detid)
       cout << PHWHERE << " detector id too large: " << detid << endl;
       gSystem->Exit(1);
     }
-  PHG4HitDefs::keytype shiftval = detidlong << PHG4HitDefs::hit_idbits;
   //  cout << "max index: " << (detminmax->second)->first << endl;
   // after removing hits with no energy deposition, we have holes
   // in our hit ranges. This construct will get us the last hit in
   // a layer and return it's hit id. Adding 1 will put us at the end of this layer
   PHG4HitDefs::keytype hitid = getmaxkey(detid);
   hitid++;
-  PHG4HitDefs::keytype newkey = hitid | shiftval;
+  PHG4HitDefs::keytype newkey = PHG4HitDefs::genkey(detid, hitid);
   if (hitmap.find(newkey) != hitmap.end())
     {
       cout << PHWHERE << " duplicate key: 0x" 
@@ -113,10 +113,9 @@ PHG4HitContainer::AddHit(PHG4Hit *newhit)
       cout << "hit with id  0x" << hex << key << dec << " exists already" << endl;
       return hitmap.find(key);
     }
-  PHG4HitDefs::keytype detidlong = key >>  PHG4HitDefs::hit_idbits;
-  unsigned int detid = detidlong;
-  layers.insert(detid);
+  layers.insert(PHG4HitDefs::get_detid(key));
   hitmap[key] = newhit;
+  m_TimeIndexValid = false;
   return hitmap.find(key);
 }
 
@@ -127,6 +126,7 @@ PHG4HitContainer::AddHit(const unsigned int detid, PHG4Hit *newhit)
   layers.insert(detid);
   newhit->set_hit_id(key);
   hitmap[key] = newhit;
+  m_TimeIndexValid = false;
   return hitmap.find(key);
 }
 
@@ -138,8 +138,8 @@ PHG4HitContainer::ConstRange PHG4HitContainer::getHits(const unsigned int detid)
       cout << " detector id too large: " << detid << endl;
       exit(1);
     }
-  PHG4HitDefs::keytype keylow = detidlong << PHG4HitDefs::hit_idbits;
-  PHG4HitDefs::keytype keyup = ((detidlong + 1) << PHG4HitDefs::hit_idbits) -1 ;
+  PHG4HitDefs::keytype keylow = PHG4HitDefs::get_first_key(detid);
+  PHG4HitDefs::keytype keyup = PHG4HitDefs::get_last_key(detid);
   ConstRange retpair;
   retpair.first = hitmap.lower_bound(keylow);
   retpair.second = hitmap.upper_bound(keyup);
@@ -149,6 +149,81 @@ PHG4HitContainer::ConstRange PHG4HitContainer::getHits(const unsigned int detid)
 PHG4HitContainer::ConstRange PHG4HitContainer::getHits( void ) const
 { return std::make_pair( hitmap.begin(), hitmap.end() ); }
 
+void PHG4HitContainer::getHits(const unsigned int detid, const double tmin, const double tmax, std::vector<PHG4Hit *> &hits) const
+{
+  if (!m_TimeIndexValid)
+  {
+    BuildTimeIndex();
+  }
+  auto index = m_TimeIndex.find(detid);
+  if (index == m_TimeIndex.end())
+  {
+    return;
+  }
+  // no hit of this detid starting before tmin - maxduration reaches into the window
+  const std::vector<pair<double, PHG4Hit *> > &sorted = index->second;
+  auto iter = lower_bound(sorted.begin(), sorted.end(), tmin - m_MaxDuration[detid],
+                          [](const pair<double, PHG4Hit *> &entry, const double t) { return entry.first < t; });
+  for (; iter != sorted.end() && iter->first <= tmax; ++iter)
+  {
+    if (iter->second->get_t(1) >= tmin)
+    {
+      hits.push_back(iter->second);
+    }
+  }
+  return;
+}
+
+void PHG4HitContainer::getHits(const double tmin, const double tmax, std::vector<PHG4Hit *> &hits) const
+{
+  for (set<unsigned int>::const_iterator iter = layers.begin(); iter != layers.end(); ++iter)
+  {
+    getHits(*iter, tmin, tmax, hits);
+  }
+  return;
+}
+
+void PHG4HitContainer::BuildTimeIndex() const
+{
+  m_TimeIndex.clear();
+  m_MaxDuration.clear();
+  for (ConstIterator iter = hitmap.begin(); iter != hitmap.end(); ++iter)
+  {
+    const unsigned int detid = PHG4HitDefs::get_detid(iter->first);
+    PHG4Hit *hit = iter->second;
+    m_TimeIndex[detid].push_back(make_pair(hit->get_t(0), hit));
+    double &maxduration = m_MaxDuration[detid];
+    maxduration = max(maxduration, static_cast<double>(hit->get_t(1)) - hit->get_t(0));
+  }
+  // hits with the same time stay in key order
+  for (auto &index : m_TimeIndex)
+  {
+    stable_sort(index.second.begin(), index.second.end(),
+                [](const pair<double, PHG4Hit *> &a, const pair<double, PHG4Hit *> &b) { return a.first < b.first; });
+  }
+  m_TimeIndexValid = true;
+  return;
+}
+
+
+int PHG4HitContainer::HitVersion()
+{
+  recoConsts *rc = recoConsts::instance();
+  if (rc->FlagExist("PHG4HIT_VERSION"))
+  {
+    return rc->get_IntFlag("PHG4HIT_VERSION");
+  }
+  return 1;
+}
+
+PHG4Hit *PHG4HitContainer::NewHit(const int version)
+{
+  if (version == 2)
+  {
+    return new PHG4Hitv2();
+  }
+  return new PHG4Hitv1();
+}
 
 PHG4HitContainer::Iterator PHG4HitContainer::findOrAddHit(PHG4HitDefs::keytype key)
 {
@@ -161,6 +236,7 @@ PHG4HitContainer::Iterator PHG4HitContainer::findOrAddHit(PHG4HitDefs::keytype k
     mhit->set_hit_id(key);
     mhit->set_edep(0.);
     layers.insert(mhit->get_layer()); // add layer to our set of layers
+    m_TimeIndexValid = false;
   }
   return it;
 }
@@ -176,6 +252,19 @@ PHG4Hit* PHG4HitContainer::findHit(PHG4HitDefs::keytype key)
   return nullptr;
 }
 
+void
+PHG4HitContainer::RemoveHit(PHG4HitDefs::keytype key)
+{
+  Iterator it = hitmap.find(key);
+  if (it != hitmap.end())
+  {
+    delete it->second;
+    hitmap.erase(it);
+    m_TimeIndexValid = false;
+  }
+  return;
+}
+
 void
 PHG4HitContainer::RemoveZeroEDep()
 {
@@ -195,6 +284,7 @@ PHG4HitContainer::RemoveZeroEDep()
           ++itr;
         }
     }
+  m_TimeIndexValid = false;
 //   unsigned int hitsafter = hitmap.size();
 //   cout << "hist before: " << hitsbef
 //        << ", hits after: " << hitsafter << endl;
@@ -12,6 +12,7 @@
 #include <set>
 #include <string>
 #include <utility>
+#include <vector>
 
 class PHG4Hit;
 
@@ -45,8 +46,18 @@ class PHG4HitContainer: public PHObject
   
   Iterator findOrAddHit(PHG4HitDefs::keytype key);
 
+  //! hit version the producers create, from the PHG4HIT_VERSION flag:
+  //! 1 (default) PHG4Hitv1, 2 PHG4Hitv2. Read it once per run, not per hit
+  static int HitVersion();
+
+  //! new empty hit of the given version
+  static PHG4Hit *NewHit(const int version);
+
   PHG4Hit* findHit(PHG4HitDefs::keytype key );
 
+  //! removes and deletes the hit
+  void RemoveHit(PHG4HitDefs::keytype key);
+
   PHG4HitDefs::keytype genkey(const unsigned int detid);
 
   //! return all hits matching a given detid
@@ -55,6 +66,18 @@ class PHG4HitContainer: public PHObject
   //! return all hist
   ConstRange getHits( void ) const;
 
+  //! appends the hits of a detid overlapping the time window, get_t(0) <= tmax and get_t(1) >= tmin, in time order
+  /*!
+    The hits are found with a binary search in an index of the hits sorted by
+    their entry time. The index is built by the first time window query after
+    the container changed and is shared by all later queries. Changing the
+    times of hits which are already in the container is not noticed.
+  */
+  void getHits(const unsigned int detid, const double tmin, const double tmax, std::vector<PHG4Hit *> &hits) const;
+
+  //! appends the hits of all detids overlapping the time window
+  void getHits(const double tmin, const double tmax, std::vector<PHG4Hit *> &hits) const;
+
   unsigned int size( void ) const
   { return hitmap.size(); }
   unsigned int num_layers(void) const
@@ -66,11 +89,22 @@ class PHG4HitContainer: public PHObject
   PHG4HitDefs::keytype getmaxkey(const unsigned int detid);
 
  protected:
+  //! moves the hits of sub events into the event
+  friend class PHG4SubEventMerger;
+
+  //! sorts the hits of every detid by entry time
+  void BuildTimeIndex() const;
 
   int id; //< unique identifier from hash of node name. Defined following PHG4HitDefs::get_volume_id
   Map hitmap;
   std::set<unsigned int> layers; // layers is not reset since layers must not change event by event
 
+  //! entry time and hit by detid, sorted by time. Valid until the next change of the container
+  mutable std::map<unsigned int, std::vector<std::pair<double, PHG4Hit *> > > m_TimeIndex; //!
+  //! longest get_t(1) - get_t(0) of a detid, how far back in time the search has to start
+  mutable std::map<unsigned int, double> m_MaxDuration; //!
+  mutable bool m_TimeIndexValid; //!
+
   ClassDef(PHG4HitContainer,1)
 };
 
@@ -3,6 +3,7 @@
 #ifndef G4MAIN_PHG4HITDEFS_H
 #define G4MAIN_PHG4HITDEFS_H
 
+#include <cstddef>
 #include <string>
 
 namespace PHG4HitDefs
@@ -11,6 +12,32 @@ namespace PHG4HitDefs
   static const unsigned int keybits = 32;
   static const unsigned int hit_idbits = sizeof(keytype)*8-keybits;
 
+#if !defined(__CINT__) || defined(__CLING__)
+  //! first key of a detector id, its hits are in [get_first_key(detid), get_first_key(detid + 1))
+  constexpr keytype get_first_key(const unsigned int detid) { return static_cast<keytype>(detid) << hit_idbits; }
+
+  //! last possible key of a detector id
+  constexpr keytype get_last_key(const unsigned int detid) { return get_first_key(detid) | ~get_first_key(~0U); }
+
+  //! hit key of detector id and hit index
+  constexpr keytype genkey(const unsigned int detid, const keytype index) { return get_first_key(detid) | index; }
+
+  //! detector id of a hit key
+  constexpr unsigned int get_detid(const keytype key) { return key >> hit_idbits; }
+
+  //! hit index of a hit key within its detector id
+  constexpr keytype get_index(const keytype key) { return key & ((static_cast<keytype>(1) << hit_idbits) - 1); }
+
+  //! detector ids of n hit keys
+  inline void get_detids(const keytype *keys, const size_t n, unsigned int *detids)
+  {
+    for (size_t i = 0; i < n; ++i)
+    {
+      detids[i] = get_detid(keys[i]);
+    }
+  }
+#endif
+
   //! convert PHG4HitContainer node names in to ID number for the container.
   //! used in indexing volume ID in PHG4Shower
   int get_volume_id(const std::string & nodename);
@@ -10,12 +10,14 @@
 #include <iostream>
 #include <map>                           // for _Rb_tree_const_iterator
 #include <utility>                       // for pair
+#include <vector>
 
 class PHCompositeNode;
 
 using namespace std;
 
 PHG4HitReadBack::PHG4HitReadBack(const string &name): SubsysReco(name)
+  , m_NEvents(0)
 {
   return;
 }
@@ -28,6 +30,52 @@ PHG4HitReadBack::InitRun(PHCompositeNode *topNode)
 
 int
 PHG4HitReadBack::process_event(PHCompositeNode *topNode)
+{
+  if (m_NodeNames.empty())
+    {
+      return DumpHits(topNode);
+    }
+
+  // the containers are only looked up, which reads them with lazy DST
+  // loading, the digitizers use them in place
+  for (vector<string>::const_iterator iter = m_NodeNames.begin(); iter != m_NodeNames.end(); ++iter)
+    {
+      PHG4HitContainer *hits = findNode::getClass<PHG4HitContainer>(topNode, *iter);
+      if (!hits)
+	{
+	  cout << Name() << ": no " << *iter << " node found" << endl;
+	  return Fun4AllReturnCodes::ABORTEVENT;
+	}
+      m_NHits[*iter] += hits->size();
+      if (Verbosity() > 1)
+	{
+	  cout << Name() << ": " << *iter << " has " << hits->size() << " hits" << endl;
+	}
+      if (Verbosity() > 2)
+	{
+	  hits->identify();
+	}
+    }
+  m_NEvents++;
+  return Fun4AllReturnCodes::EVENT_OK;
+}
+
+int
+PHG4HitReadBack::End(PHCompositeNode *topNode)
+{
+  if (Verbosity() > 0 && m_NEvents > 0)
+    {
+      for (map<string, unsigned long>::const_iterator iter = m_NHits.begin(); iter != m_NHits.end(); ++iter)
+	{
+	  cout << Name() << ": " << iter->first << " read back " << iter->second << " hits in "
+	       << m_NEvents << " events" << endl;
+	}
+    }
+  return Fun4AllReturnCodes::EVENT_OK;
+}
+
+int
+PHG4HitReadBack::DumpHits(PHCompositeNode *topNode)
 {
   PHG4HitContainer *phc = findNode::getClass<PHG4HitContainer>(topNode,"PHG4Hit");
   if (!phc)
@@ -5,17 +5,37 @@
 
 #include <fun4all/SubsysReco.h>
 
+#include <map>
 #include <string>                // for string
+#include <vector>
 
 class PHCompositeNode;
 
+//! Reads back G4 hit containers from a DST.
+//! Without nodes added it dumps the PHG4Hit node (debugging).
+//! With AddNode() it is the read back of a re-digitization pass: only the
+//! named hit containers are requested, so with
+//! Fun4AllDstInputManager::LazyLoading(true) only their branches are read,
+//! and the digitizers running after it use the containers in place.
+//! A missing container aborts the event.
 class PHG4HitReadBack : public SubsysReco
 {
  public:
   PHG4HitReadBack(const std::string &name="PHG4HITREADBACK");
   int InitRun(PHCompositeNode *topNode);
   int process_event(PHCompositeNode *topNode);
+  int End(PHCompositeNode *topNode);
+
+  //! hit container to read back, e.g. G4HIT_TPC
+  void AddNode(const std::string &nodename) { m_NodeNames.push_back(nodename); }
+
  protected:
+  int DumpHits(PHCompositeNode *topNode);
+
+  std::vector<std::string> m_NodeNames;
+  //! hits read back per node
+  std::map<std::string, unsigned long> m_NHits;
+  unsigned long m_NEvents;
 };
 
 
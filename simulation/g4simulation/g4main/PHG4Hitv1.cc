@@ -1,6 +1,7 @@
 #include "PHG4Hitv1.h"
 #include "PHG4HitDefs.h"
 
+#include <phool/PHObjectPool.h>
 #include <phool/phool.h>
 
 #include <climits>
@@ -430,3 +431,13 @@ PHG4Hitv1::identify(ostream& os) const
       cout <<endl;
     }
 }
+
+void *PHG4Hitv1::operator new(size_t size)
+{
+  return PHObjectPool<PHG4Hitv1>::allocate(size);
+}
+
+void PHG4Hitv1::operator delete(void *ptr, size_t size)
+{
+  PHObjectPool<PHG4Hitv1>::deallocate(ptr, size);
+}
@@ -11,6 +11,7 @@
 #else
 #include <stdint.h>
 #endif
+#include <cstddef>
 #include <iostream>
 #include <map>
 
@@ -20,6 +21,12 @@ class PHG4Hitv1 : public PHG4Hit
   PHG4Hitv1();
   explicit PHG4Hitv1(const PHG4Hit *g4hit);
   virtual ~PHG4Hitv1() {}
+
+#if !defined(__CINT__) || defined(__CLING__)
+  //! storage is recycled through PHObjectPool
+  static void *operator new(size_t size);
+  static void operator delete(void *ptr, size_t size);
+#endif
   void identify(std::ostream& os  = std::cout) const;
   void Reset();
 
@@ -0,0 +1,496 @@
+#include "PHG4Hitv2.h"
+#include "PHG4HitDefs.h"
+
+#include <phool/PHObjectPool.h>
+#include <phool/phool.h>
+
+#include <algorithm>
+#include <climits>
+#include <cmath>
+#include <cstdlib>
+#include <string>
+#include <utility>
+
+using namespace std;
+
+PHG4Hitv2::PHG4Hitv2()
+  : nprop(0)
+  , nalloc(0)
+  , prop_id(nullptr)
+  , prop_value(nullptr)
+{
+  Reset();
+}
+
+PHG4Hitv2::PHG4Hitv2(const PHG4Hit *g4hit)
+  : nprop(0)
+  , nalloc(0)
+  , prop_id(nullptr)
+  , prop_value(nullptr)
+{
+  Reset();
+  CopyFrom(g4hit);
+}
+
+PHG4Hitv2::PHG4Hitv2(const PHG4Hitv2 &g4hit)
+  : PHG4Hit(g4hit)
+  , nprop(0)
+  , nalloc(0)
+  , prop_id(nullptr)
+  , prop_value(nullptr)
+{
+  Reset();
+  CopyFrom(&g4hit);
+}
+
+PHG4Hitv2 &
+PHG4Hitv2::operator=(const PHG4Hitv2 &g4hit)
+{
+  if (this != &g4hit)
+    {
+      Reset();
+      CopyFrom(&g4hit);
+    }
+  return *this;
+}
+
+PHG4Hitv2::~PHG4Hitv2()
+{
+  delete [] prop_id;
+  delete [] prop_value;
+}
+
+void
+PHG4Hitv2::Reset()
+{
+  hitid = ULONG_LONG_MAX;
+  trackid = INT_MIN;
+  showerid = INT_MIN;
+  edep = NAN;
+  eion = NAN;
+  light_yield = NAN;
+  path_length = NAN;
+  for (int i = 0; i<2;i++)
+    {
+      set_x(i,NAN);
+      set_y(i,NAN);
+      set_z(i,NAN);
+      set_t(i,NAN);
+      local_x[i] = NAN;
+      local_y[i] = NAN;
+      local_z[i] = NAN;
+    }
+  // the property arrays are kept for the next hit
+  nprop = 0;
+}
+
+int
+PHG4Hitv2::get_detid() const
+{
+  // a compile time check if the hit_idbits are within range (1-32)
+  static_assert (PHG4HitDefs::hit_idbits <= sizeof(unsigned int)*8,"hit_idbits < 32, fix in PHG4HitDefs.h");
+  int detid = (hitid>>PHG4HitDefs::hit_idbits);
+  return detid;
+}
+
+float *
+PHG4Hitv2::fixed_property(const PROPERTY prop)
+{
+  return const_cast<float *>(static_cast<const PHG4Hitv2 *>(this)->fixed_property(prop));
+}
+
+const float *
+PHG4Hitv2::fixed_property(const PROPERTY prop) const
+{
+  switch(prop)
+    {
+    case prop_eion:
+      return &eion;
+    case prop_light_yield:
+      return &light_yield;
+    case prop_path_length:
+      return &path_length;
+    case prop_local_x_0:
+      return &local_x[0];
+    case prop_local_x_1:
+      return &local_x[1];
+    case prop_local_y_0:
+      return &local_y[0];
+    case prop_local_y_1:
+      return &local_y[1];
+    case prop_local_z_0:
+      return &local_z[0];
+    case prop_local_z_1:
+      return &local_z[1];
+    default:
+      return nullptr;
+    }
+}
+
+int
+PHG4Hitv2::find_property(const PROPERTY prop) const
+{
+  for (int i = 0; i < nprop; i++)
+    {
+      if (prop_id[i] == prop)
+	{
+	  return i;
+	}
+    }
+  return -1;
+}
+
+void
+PHG4Hitv2::store_property(const PROPERTY prop, const prop_storage_t value)
+{
+  int index = find_property(prop);
+  if (index >= 0)
+    {
+      prop_value[index] = value;
+      return;
+    }
+  if (nprop >= nalloc)
+    {
+      // arrays read from a file have exactly nprop entries (nalloc is 0 then)
+      int newalloc = max(4, 2 * nprop);
+      prop_id_t *newid = new prop_id_t[newalloc];
+      prop_storage_t *newvalue = new prop_storage_t[newalloc];
+      copy(prop_id, prop_id + nprop, newid);
+      copy(prop_value, prop_value + nprop, newvalue);
+      delete [] prop_id;
+      delete [] prop_value;
+      prop_id = newid;
+      prop_value = newvalue;
+      nalloc = newalloc;
+    }
+  prop_id[nprop] = prop;
+  prop_value[nprop] = value;
+  nprop++;
+}
+
+void
+PHG4Hitv2::print() const {
+  std::cout<<"New Hitv2  0x"<< hex << hitid
+	   << dec << "  on track "<<trackid<<" EDep "<<edep<<std::endl;
+  std::cout<<"Location: X "<<x[0]<<"/"<<x[1]<<"  Y "<<y[0]<<"/"<<y[1]<<"  Z "<<z[0]<<"/"<<z[1]<<std::endl;
+  std::cout<<"Time        "<<t[0]<<"/"<<t[1]<<std::endl;
+  std::cout<<"eion "<<eion<<" light yield "<<light_yield<<" path length "<<path_length<<std::endl;
+  std::cout<<"Local: X "<<local_x[0]<<"/"<<local_x[1]<<"  Y "<<local_y[0]<<"/"<<local_y[1]<<"  Z "<<local_z[0]<<"/"<<local_z[1]<<std::endl;
+
+  for (int i = 0; i < nprop; i++)
+    {
+      PROPERTY prop = static_cast<PROPERTY>(prop_id[i]);
+      pair<const string, PROPERTY_TYPE> property_info = get_property_info(prop);
+      cout << "\t" << prop << ":\t" << property_info.first << " = \t";
+      switch(property_info.second)
+	{
+	case type_int:
+	  cout << get_property_int(prop);
+	  break;
+	case type_uint:
+	  cout << get_property_uint(prop);
+	  break;
+	case type_float:
+	  cout << get_property_float(prop);
+	  break;
+	default:
+	  cout << " unknown type ";
+	}
+      cout <<endl;
+    }
+}
+
+bool
+PHG4Hitv2::has_property(const PROPERTY prop) const
+{
+  const float *fixed = fixed_property(prop);
+  if (fixed)
+    {
+      return !std::isnan(*fixed);
+    }
+  return (find_property(prop) >= 0);
+}
+
+float
+PHG4Hitv2::get_property_float(const PROPERTY prop) const
+{
+  if (!check_property(prop,type_float))
+    {
+      pair<const string,PROPERTY_TYPE> property_info =get_property_info(prop);
+      cout << PHWHERE << " Property " << property_info.first << " with id "
+           << prop << " is of type " << get_property_type(property_info.second)
+	   << " not " << get_property_type(type_float) << endl;
+      exit(1);
+    }
+  const float *fixed = fixed_property(prop);
+  if (fixed)
+    {
+      return *fixed;
+    }
+  int index = find_property(prop);
+  if (index >= 0) return u_property(prop_value[index]).fdata;
+
+  return   NAN ;
+}
+
+int
+PHG4Hitv2::get_property_int(const PROPERTY prop) const
+{
+  if (!check_property(prop,type_int))
+    {
+      pair<const string,PROPERTY_TYPE> property_info =get_property_info(prop);
+      cout << PHWHERE << " Property " << property_info.first << " with id "
+           << prop << " is of type " << get_property_type(property_info.second)
+	   << " not " << get_property_type(type_int) << endl;
+      exit(1);
+    }
+  int index = find_property(prop);
+  if (index >= 0) return u_property(prop_value[index]).idata;
+
+  return INT_MIN;
+}
+
+unsigned int
+PHG4Hitv2::get_property_uint(const PROPERTY prop) const
+{
+  if (!check_property(prop,type_uint))
+    {
+      pair<const string,PROPERTY_TYPE> property_info =get_property_info(prop);
+      cout << PHWHERE << " Property " << property_info.first << " with id "
+           << prop << " is of type " << get_property_type(property_info.second)
+	   << " not " << get_property_type(type_uint) << endl;
+      exit(1);
+    }
+  int index = find_property(prop);
+  if (index >= 0) return u_property(prop_value[index]).uidata;
+
+  return UINT_MAX ;
+}
+
+void
+PHG4Hitv2::set_property(const PROPERTY prop, const float value)
+{
+  if (!check_property(prop,type_float))
+    {
+      pair<const string,PROPERTY_TYPE> property_info = get_property_info(prop);
+      cout << PHWHERE << " Property " << property_info.first << " with id "
+           << prop << " is of type " << get_property_type(property_info.second)
+	   << " not " << get_property_type(type_float) << endl;
+      exit(1);
+    }
+  float *fixed = fixed_property(prop);
+  if (fixed)
+    {
+      *fixed = value;
+      return;
+    }
+  store_property(prop, u_property(value).get_storage());
+}
+
+void
+PHG4Hitv2::set_property(const PROPERTY prop, const int value)
+{
+  if (!check_property(prop,type_int))
+    {
+      pair<const string,PROPERTY_TYPE> property_info = get_property_info(prop);
+      cout << PHWHERE << " Property " << property_info.first << " with id "
+           << prop << " is of type " << get_property_type(property_info.second)
+	   << " not " << get_property_type(type_int) << endl;
+      exit(1);
+    }
+  store_property(prop, u_property(value).get_storage());
+}
+
+void
+PHG4Hitv2::set_property(const PROPERTY prop, const unsigned int value)
+{
+  if (!check_property(prop,type_uint))
+    {
+      pair<const string,PROPERTY_TYPE> property_info = get_property_info(prop);
+      cout << PHWHERE << " Property " << property_info.first << " with id "
+           << prop << " is of type " << get_property_type(property_info.second)
+	   << " not " << get_property_type(type_uint) << endl;
+      exit(1);
+    }
+  store_property(prop, u_property(value).get_storage());
+}
+
+unsigned int
+PHG4Hitv2::get_property_nocheck(const PROPERTY prop) const
+{
+  const float *fixed = fixed_property(prop);
+  if (fixed)
+    {
+      return u_property(*fixed).get_storage();
+    }
+  int index = find_property(prop);
+  if (index >= 0)
+    {
+      return prop_value[index];
+    }
+  return UINT_MAX;
+}
+
+void
+PHG4Hitv2::set_property_nocheck(const PROPERTY prop, const unsigned int ui)
+{
+  float *fixed = fixed_property(prop);
+  if (fixed)
+    {
+      *fixed = u_property(ui).fdata;
+      return;
+    }
+  store_property(prop, ui);
+}
+
+float
+PHG4Hitv2::get_px(const int i) const
+{
+  switch(i)
+    {
+    case 0:
+      return  get_property_float(prop_px_0);
+    case 1:
+      return  get_property_float(prop_px_1);
+    default:
+      cout << "Invalid index in get_px: " << i << endl;
+      exit(1);
+    }
+}
+
+float
+PHG4Hitv2::get_py(const int i) const
+{
+  switch(i)
+    {
+    case 0:
+      return  get_property_float(prop_py_0);
+    case 1:
+      return  get_property_float(prop_py_1);
+    default:
+      cout << "Invalid index in get_py: " << i << endl;
+      exit(1);
+    }
+}
+
+float
+PHG4Hitv2::get_pz(const int i) const
+{
+  switch(i)
+    {
+    case 0:
+      return  get_property_float(prop_pz_0);
+    case 1:
+      return  get_property_float(prop_pz_1);
+    default:
+      cout << "Invalid index in get_pz: " << i << endl;
+      exit(1);
+    }
+}
+
+void
+PHG4Hitv2::set_px(const int i, const float f)
+{
+  switch(i)
+    {
+    case 0:
+      set_property(prop_px_0,f);
+      return;
+    case 1:
+      set_property(prop_px_1,f);
+      return;
+    default:
+      cout << "Invalid index in set_px: " << i << endl;
+      exit(1);
+    }
+}
+
+void
+PHG4Hitv2::set_py(const int i, const float f)
+{
+  switch(i)
+    {
+    case 0:
+      set_property(prop_py_0,f);
+      return;
+    case 1:
+      set_property(prop_py_1,f);
+      return;
+    default:
+      cout << "Invalid index in set_py: " << i << endl;
+      exit(1);
+    }
+}
+
+void
+PHG4Hitv2::set_pz(const int i, const float f)
+{
+  switch(i)
+    {
+    case 0:
+      set_property(prop_pz_0,f);
+      return;
+    case 1:
+      set_property(prop_pz_1,f);
+      return;
+    default:
+      cout << "Invalid index in set_pz: " << i << endl;
+      exit(1);
+    }
+}
+
+void
+PHG4Hitv2::identify(ostream& os) const
+{
+  os << "Class " << this->ClassName() << endl;
+  os << "hitid: 0x" << hex << hitid << dec << endl;
+  os << "x0: " << get_x(0)
+     << ", y0: " << get_y(0)
+     << ", z0: " << get_z(0)
+     << ", t0: " << get_t(0) << endl;
+  os << "x1: " << get_x(1)
+     << ", y1: " << get_y(1)
+     << ", z1: " << get_z(1)
+     << ", t1: " << get_t(1) << endl;
+  os << "trackid: " << trackid << ", showerid: " << showerid
+     << ", edep: " << edep << endl;
+  os << "eion: " << eion << ", light_yield: " << light_yield
+     << ", path_length: " << path_length << endl;
+  for (int i = 0; i < 2; i++)
+    {
+      os << "local x" << i << ": " << local_x[i]
+	 << ", local y" << i << ": " << local_y[i]
+	 << ", local z" << i << ": " << local_z[i] << endl;
+    }
+  for (int i = 0; i < nprop; i++)
+    {
+      PROPERTY prop = static_cast<PROPERTY>(prop_id[i]);
+      pair<const string, PROPERTY_TYPE> property_info = get_property_info(prop);
+      os << "\t" << prop << ":\t" << property_info.first << " = \t";
+      switch(property_info.second)
+	{
+	case type_int:
+	  os << get_property_int(prop);
+	  break;
+	case type_uint:
+	  os << get_property_uint(prop);
+	  break;
+	case type_float:
+	  os << get_property_float(prop);
+	  break;
+	default:
+	  os << " unknown type ";
+	}
+      os <<endl;
+    }
+}
+
+void *PHG4Hitv2::operator new(size_t size)
+{
+  return PHObjectPool<PHG4Hitv2>::allocate(size);
+}
+
+void PHG4Hitv2::operator delete(void *ptr, size_t size)
+{
+  PHObjectPool<PHG4Hitv2>::deallocate(ptr, size);
+}
@@ -0,0 +1,176 @@
+// Tell emacs that this is a C++ source
+//  -*- C++ -*-.
+#ifndef G4MAIN_PHG4HITV2_H
+#define G4MAIN_PHG4HITV2_H
+
+#include "PHG4Hit.h"
+#include "PHG4HitDefs.h"
+
+#if !defined(__CINT__) || defined (__CLING__)
+#include <cstdint>
+#else
+#include <stdint.h>
+#endif
+#include <cstddef>
+#include <iostream>
+
+/*!
+ * \brief PHG4Hit with fixed layout property storage
+ *
+ * Same interface as PHG4Hitv1 but without the std::map for the optional
+ * properties. eion, light yield, path length and the local coordinates are
+ * data members (NAN if not set), all other properties go into two small
+ * arrays of ids and values which are searched linearly. The arrays are
+ * allocated when the first property is set and grow as needed, only the
+ * nprop used entries are written out. No tree walk in get_property.
+ */
+class PHG4Hitv2 : public PHG4Hit
+{
+ public:
+  PHG4Hitv2();
+  explicit PHG4Hitv2(const PHG4Hit *g4hit);
+  PHG4Hitv2(const PHG4Hitv2 &g4hit);
+  PHG4Hitv2 &operator=(const PHG4Hitv2 &g4hit);
+  virtual ~PHG4Hitv2();
+
+#if !defined(__CINT__) || defined(__CLING__)
+  //! storage is recycled through PHObjectPool
+  static void *operator new(size_t size);
+  static void operator delete(void *ptr, size_t size);
+#endif
+  void identify(std::ostream& os  = std::cout) const;
+  void Reset();
+
+  // The indices here represent the entry and exit points of the particle
+  float get_x(const int i) const {return x[i];}
+  float get_y(const int i) const {return y[i];}
+  float get_z(const int i) const {return z[i];}
+  float get_t(const int i) const {return t[i];}
+  float get_edep() const {return edep;}
+  PHG4HitDefs::keytype get_hit_id() const {return hitid;}
+  int get_detid() const;
+  int get_shower_id() const {return showerid;}
+  int get_trkid() const {return trackid;}
+
+  void set_x(const int i, const float f) {x[i]=f;}
+  void set_y(const int i, const float f) {y[i]=f;}
+  void set_z(const int i, const float f) {z[i]=f;}
+  void set_t(const int i, const float f) {t[i]=f;}
+  void set_edep(const float f) {edep = f;}
+  void set_hit_id(const PHG4HitDefs::keytype i) {hitid=i;}
+  void set_shower_id(const int i) {showerid = i;}
+  void set_trkid(const int i) {trackid=i;}
+
+  virtual void print() const;
+
+  bool  has_property(const PROPERTY prop_id) const;
+  float get_property_float(const PROPERTY prop_id) const;
+  int   get_property_int(const PROPERTY prop_id) const;
+  unsigned int   get_property_uint(const PROPERTY prop_id) const;
+  void  set_property(const PROPERTY prop_id, const float value);
+  void  set_property(const PROPERTY prop_id, const int value);
+  void  set_property(const PROPERTY prop_id, const unsigned int value);
+
+  virtual float get_px(const int i) const;
+  virtual float get_py(const int i) const;
+  virtual float get_pz(const int i) const;
+  virtual float get_local_x(const int i) const {return local_x[i];}
+  virtual float get_local_y(const int i) const {return local_y[i];}
+  virtual float get_local_z(const int i) const {return local_z[i];}
+  virtual float get_eion() const          {return eion;}
+  virtual float get_light_yield() const   {return light_yield;}
+  virtual float get_path_length() const   {return path_length;}
+  virtual unsigned int get_layer() const  {return  get_property_uint(prop_layer);}
+  virtual int get_scint_id() const        {return  get_property_int(prop_scint_id);}
+  virtual int get_row() const {return  get_property_int(prop_row);}
+  virtual int get_strip_z_index() const   {return  get_property_int(prop_strip_z_index);}
+  virtual int get_strip_y_index() const   {return  get_property_int(prop_strip_y_index);}
+  virtual int get_ladder_z_index() const  {return  get_property_int(prop_ladder_z_index);}
+  virtual int get_ladder_phi_index() const{return  get_property_int(prop_ladder_phi_index);}
+  virtual int get_index_i() const {return  get_property_int(prop_index_i);}
+  virtual int get_index_j() const {return  get_property_int(prop_index_j);}
+  virtual int get_index_k() const {return  get_property_int(prop_index_k);}
+  virtual int get_index_l() const {return  get_property_int(prop_index_l);}
+  virtual int get_hit_type() const {return  get_property_int(prop_hit_type);}
+
+  virtual void set_px(const int i, const float f);
+  virtual void set_py(const int i, const float f);
+  virtual void set_pz(const int i, const float f);
+  virtual void set_local_x(const int i, const float f) {local_x[i] = f;}
+  virtual void set_local_y(const int i, const float f) {local_y[i] = f;}
+  virtual void set_local_z(const int i, const float f) {local_z[i] = f;}
+  virtual void set_eion(const float f)            {eion = f;}
+  virtual void set_light_yield(const float f)     {light_yield = f;}
+  virtual void set_path_length(const float f)     {path_length = f;}
+  virtual void set_layer(const unsigned int i)    {set_property(prop_layer,i);}
+  virtual void set_scint_id(const int i)          {set_property(prop_scint_id,i);}
+  virtual void set_row(const int i)          {set_property(prop_row,i);}
+  virtual void set_strip_z_index(const int i)     {set_property(prop_strip_z_index,i);}
+  virtual void set_strip_y_index(const int i)     {set_property(prop_strip_y_index,i);}
+  virtual void set_ladder_z_index(const int i)    {set_property(prop_ladder_z_index,i);}
+  virtual void set_ladder_phi_index(const int i)  {set_property(prop_ladder_phi_index,i);}
+  virtual void set_index_i(const int i)  {set_property(prop_index_i,i);}
+  virtual void set_index_j(const int i)  {set_property(prop_index_j,i);}
+  virtual void set_index_k(const int i)  {set_property(prop_index_k,i);}
+  virtual void set_index_l(const int i)  {set_property(prop_index_l,i);}
+  virtual void set_hit_type(const int i) {set_property(prop_hit_type,i);}
+
+ protected:
+  unsigned int get_property_nocheck(const PROPERTY prop_id) const;
+  void set_property_nocheck(const PROPERTY prop_id,const unsigned int ui);
+
+  //! storage types for additional property
+  typedef uint8_t prop_id_t;
+  typedef uint32_t prop_storage_t;
+
+  //! pointer to the data member of a fixed property, nullptr otherwise
+  float *fixed_property(const PROPERTY prop_id);
+  const float *fixed_property(const PROPERTY prop_id) const;
+
+  //! index in the property arrays, -1 if not set
+  int find_property(const PROPERTY prop_id) const;
+  void store_property(const PROPERTY prop_id, const prop_storage_t value);
+
+  //! convert between 32bit inputs and storage type prop_storage_t
+  union u_property{
+    float fdata;
+    int32_t idata;
+    uint32_t uidata;
+
+    u_property(int32_t in): idata(in) {}
+    u_property(uint32_t in): uidata(in) {}
+    u_property(float in): fdata(in) {}
+    u_property(): uidata(0) {}
+
+    prop_storage_t get_storage() const {return uidata;}
+  };
+
+  // Store both the entry and exit points of the particle
+  // Remember, particles do not always enter on the inner edge!
+  float x[2];
+  float y[2];
+  float z[2];
+  float t[2];
+  PHG4HitDefs::keytype hitid;
+  int trackid;
+  int showerid;
+  float edep;
+
+  //! common properties as fixed members
+  float eion;
+  float light_yield;
+  float path_length;
+  float local_x[2];
+  float local_y[2];
+  float local_z[2];
+
+  //! all other properties
+  int nprop;
+  int nalloc;                  //! allocated entries of prop_id and prop_value
+  prop_id_t *prop_id;          //[nprop]
+  prop_storage_t *prop_value;  //[nprop]
+
+  ClassDef(PHG4Hitv2,1)
+};
+
+#endif
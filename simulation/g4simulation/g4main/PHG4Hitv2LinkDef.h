@@ -0,0 +1,7 @@
+#ifdef __CINT__
+
+#pragma link C++ class PHG4Hitv2+;
+// the property arrays are allocated with nprop entries when they are read
+#pragma read sourceClass="PHG4Hitv2" targetClass="PHG4Hitv2" version="[1-]" source="" target="nalloc" code="{ nalloc = 0; }"
+
+#endif /* __CINT__ */
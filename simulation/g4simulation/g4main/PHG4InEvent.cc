@@ -1,19 +1,29 @@
 #include "PHG4InEvent.h"
 
 #include "PHG4Particle.h"
+#include "PHG4Particlev1.h"
 #include "PHG4VtxPoint.h"
 #include "PHG4VtxPointv1.h"
 
 #include <cmath>
 #include <cstdlib>
+#include <functional>
 
 using namespace std;
 
+namespace
+{
+  // particles per pool block, a HIJING event needs a few dozen blocks
+  const unsigned int poolblocksize = 1024;
+}
+
 PHG4InEvent::~PHG4InEvent()
 {
-  
-  vtxlist.clear();
-  particlelist.clear();
+  Reset();
+  for (vector<PHG4Particlev1 *>::iterator iter = particlepool.begin(); iter != particlepool.end(); ++iter)
+    {
+      delete [] *iter;
+    }
   return;
 }
 
@@ -30,6 +40,7 @@ PHG4InEvent::AddVtxHepMC(const int id, const double x, const double y, const dou
 {
   PHG4VtxPoint *newvtx = new PHG4VtxPointv1(x,y,z,t0);
   vtxlist[id]=newvtx;
+  vtxzindex.insert(make_pair(newvtx->get_z(), id));
   return 0;
 }
 
@@ -44,17 +55,28 @@ PHG4InEvent::AddVtx(const double x, const double y, const double z, const double
 int
 PHG4InEvent::AddVtxCommon(PHG4VtxPoint *newvtx)
 {
-  std::pair< std::map<int, PHG4VtxPoint *>::const_iterator, std::map<int, PHG4VtxPoint *>::const_iterator > vtxbegin_end =  GetVertices();
-  for (map<int, PHG4VtxPoint *>::const_iterator viter = vtxbegin_end.first; viter != vtxbegin_end.second; ++viter)
+  // an identical vertex has the same z, with several the lowest id is
+  // returned, entries of replaced vertices fail the comparison
+  bool found = false;
+  int foundid = 0;
+  pair<multimap<double,int>::const_iterator, multimap<double,int>::const_iterator> zrange = vtxzindex.equal_range(newvtx->get_z());
+  for (multimap<double,int>::const_iterator ziter = zrange.first; ziter != zrange.second; ++ziter)
     {
-      if (*newvtx == *(viter->second))
+      map<int, PHG4VtxPoint *>::const_iterator viter = vtxlist.find(ziter->second);
+      if (viter != vtxlist.end() && *newvtx == *(viter->second) && (!found || viter->first < foundid))
 	{
-	  delete newvtx;
-	  return viter->first;
+	  found = true;
+	  foundid = viter->first;
 	}
     }
+  if (found)
+    {
+      delete newvtx;
+      return foundid;
+    }
   int id = GetNVtx()+1;
   vtxlist[id]=newvtx;
+  vtxzindex.insert(make_pair(newvtx->get_z(), id));
   return id;
 }
 
@@ -79,24 +101,70 @@ PHG4InEvent::AddParticle(const int vtxid, PHG4Particle *particle)
 // 	  return -1;
 // 	}
 //     }
-  particlelist.insert(pair<int,PHG4Particle *>(vtxid, particle) );
+  // generators add the particles in vertex order, appending at the end
+  // is then constant time and keeps the insertion order of equal vertices
+  if (particlelist.empty() || particlelist.rbegin()->first <= vtxid)
+    {
+      particlelist.insert(particlelist.end(), pair<int,PHG4Particle *>(vtxid, particle) );
+    }
+  else
+    {
+      particlelist.insert(pair<int,PHG4Particle *>(vtxid, particle) );
+    }
   return 0;
 }
 
+PHG4Particle *
+PHG4InEvent::NewParticle()
+{
+  const unsigned int block = npooled / poolblocksize;
+  if (block == particlepool.size())
+    {
+      particlepool.push_back(new PHG4Particlev1[poolblocksize]);
+    }
+  PHG4Particlev1 *particle = &particlepool[block][npooled % poolblocksize];
+  ++npooled;
+  // clear what a previous event left in it
+  *particle = PHG4Particlev1();
+  return particle;
+}
+
+bool
+PHG4InEvent::isPooled(const PHG4Particle *particle) const
+{
+  less<const PHG4Particle *> before;
+  for (vector<PHG4Particlev1 *>::const_iterator iter = particlepool.begin(); iter != particlepool.end(); ++iter)
+    {
+      const PHG4Particle *first = &(*iter)[0];
+      const PHG4Particle *last = &(*iter)[poolblocksize - 1];
+      if (!before(particle, first) && !before(last, particle))
+	{
+	  return true;
+	}
+    }
+  return false;
+}
+
 void
 PHG4InEvent::Reset()
 {
   embedded_particlelist.clear(); // just pointers - we can clear it without deleting
+  vtxzindex.clear();
   while(vtxlist.begin() != vtxlist.end())
     {
       delete vtxlist.begin()->second;
       vtxlist.erase(vtxlist.begin());
     }
-  while(particlelist.begin() != particlelist.end())
+  for (multimap<int,PHG4Particle *>::iterator iter = particlelist.begin(); iter != particlelist.end(); ++iter)
     {
-      delete particlelist.begin()->second;
-      particlelist.erase(particlelist.begin());
+      // pooled particles stay in their pool
+      if (!npooled || !isPooled(iter->second))
+	{
+	  delete iter->second;
+	}
     }
+  particlelist.clear();
+  npooled = 0;
   return;
 }
 
@@ -174,6 +242,9 @@ PHG4InEvent::isEmbeded(PHG4Particle *p) const
 void
 PHG4InEvent::DeleteParticle(std::multimap<int, PHG4Particle *>::iterator &iter)
 {
-  delete iter->second;
+  if (!npooled || !isPooled(iter->second))
+    {
+      delete iter->second;
+    }
   particlelist.erase(iter);
 }
@@ -8,14 +8,19 @@
 #include <iostream>
 #include <map>
 #include <utility>
+#include <vector>
 
 class PHG4Particle;
+class PHG4Particlev1;
 class PHG4VtxPoint;
 
 class PHG4InEvent: public PHObject
 {
  public:
-  PHG4InEvent() {}
+  PHG4InEvent()
+    : npooled(0)
+  {
+  }
   virtual ~PHG4InEvent();
 
   virtual void identify(std::ostream& os = std::cout) const;
@@ -25,6 +30,10 @@ class PHG4InEvent: public PHObject
   int AddVtx(const double x, const double y, const double z, const double t);
   int AddVtx(const int id,const PHG4VtxPoint &);
   int AddParticle(const int vtxid, PHG4Particle *particle);
+  //! PHG4Particlev1 from a pool owned by this event whose storage is reused
+  //! in every event (no allocation per particle), add it with AddParticle
+  //! like a particle from new, it is gone after Reset()
+  PHG4Particle *NewParticle();
   void AddEmbeddedParticle(PHG4Particle *particle, int flag) {embedded_particlelist.insert(std::make_pair(particle,flag));}
 
   //  PHG4VtxPoint *GetVtx() {return vtxlist.begin()->second;}
@@ -37,14 +46,21 @@ class PHG4InEvent: public PHObject
   int isEmbeded(PHG4Particle *) const;
   int GetNEmbedded() const {return embedded_particlelist.size();}
   int GetNVtx() const {return vtxlist.size();}
+  int GetNParticles() const {return particlelist.size();}
   void DeleteParticle(std::multimap<int,PHG4Particle *>::iterator &iter);
 
  protected:
 
   int AddVtxCommon(PHG4VtxPoint *newvtx);
+  bool isPooled(const PHG4Particle *particle) const;
   std::map<int,PHG4VtxPoint *> vtxlist;
+  //! vertex ids by z for finding existing vertices in AddVtx
+  std::multimap<double,int> vtxzindex; //!
   std::multimap<int,PHG4Particle *> particlelist;
   std::map<PHG4Particle *,int> embedded_particlelist;
+  //! blocks of pooled particles and the number handed out in this event
+  std::vector<PHG4Particlev1 *> particlepool; //!
+  unsigned int npooled; //!
 
   ClassDef(PHG4InEvent,1)
 };
@@ -64,40 +64,38 @@ PHG4InEventReadBack::process_event(PHCompositeNode *topNode)
       return Fun4AllReturnCodes::EVENT_OK;
     }
   inEvent->Reset();
-  unsigned int size = vtxarray->get_array_size();
+
+  // both arrays hold records of 5 shorts, a truncated record is dropped
+  // instead of reading past the end of the array
+  const unsigned int nvtx = vtxarray->get_array_size() / 5;
+  const unsigned int nparticles = particlearray->get_array_size() / 5;
+  if (vtxarray->get_array_size() % 5 || particlearray->get_array_size() % 5)
+    {
+      cout << Name() << ": truncated vertex or particle record, ignoring it" << endl;
+    }
+
+  // vertex id, x, y, z, t
   const short int *sval = vtxarray->get_array();
   PHG4VtxPointv1 vtx;
-  while(size > 0)
+  for (unsigned int i = 0; i < nvtx; i++, sval += 5)
     {
-      int vtxid = *sval++;
-      size --;
-      vtx.set_x(VariableArrayUtils::ShortBitsToFloat(*sval++));
-      size --;
-      vtx.set_y(VariableArrayUtils::ShortBitsToFloat(*sval++));
-      size --;
-      vtx.set_z(VariableArrayUtils::ShortBitsToFloat(*sval++));
-      size--;
-      vtx.set_t(VariableArrayUtils::ShortBitsToFloat(*sval++));
-      size--;
-      inEvent->AddVtx(vtxid,vtx);
-     }
+      vtx.set_x(VariableArrayUtils::ShortBitsToFloat(sval[1]));
+      vtx.set_y(VariableArrayUtils::ShortBitsToFloat(sval[2]));
+      vtx.set_z(VariableArrayUtils::ShortBitsToFloat(sval[3]));
+      vtx.set_t(VariableArrayUtils::ShortBitsToFloat(sval[4]));
+      inEvent->AddVtx(sval[0], vtx);
+    }
 
-  size = particlearray->get_array_size();
+  // vertex id, pid, px, py, pz
   sval = particlearray->get_array();
-  while(size > 0)
+  for (unsigned int i = 0; i < nparticles; i++, sval += 5)
     {
       PHG4Particle *particle = new PHG4Particlev1();
-      int vtxid = *sval++;
-      size --;
-      particle->set_pid(*sval++);
-      size --;
-      particle->set_px(VariableArrayUtils::ShortBitsToFloat(*sval++));
-      size --;
-      particle->set_py(VariableArrayUtils::ShortBitsToFloat(*sval++));
-      size --;
-      particle->set_pz(VariableArrayUtils::ShortBitsToFloat(*sval++));
-      size --;
-      inEvent->AddParticle(vtxid, particle);
+      particle->set_pid(sval[1]);
+      particle->set_px(VariableArrayUtils::ShortBitsToFloat(sval[2]));
+      particle->set_py(VariableArrayUtils::ShortBitsToFloat(sval[3]));
+      particle->set_pz(VariableArrayUtils::ShortBitsToFloat(sval[4]));
+      inEvent->AddParticle(sval[0], particle);
     }
   //  inEvent->identify();
   return Fun4AllReturnCodes::EVENT_OK;
@@ -58,7 +58,7 @@ void PHG4ParticleGenerator::set_mom_range(const double min, const double max)
   return;
 }
 
-int PHG4ParticleGenerator::process_event(PHCompositeNode *topNode)
+int PHG4ParticleGenerator::GenerateEvent(PHCompositeNode *topNode, const unsigned int ibatch)
 {
   PHG4InEvent *ineve = findNode::getClass<PHG4InEvent>(topNode, "PHG4INEVENT");
 
@@ -66,7 +66,7 @@ int PHG4ParticleGenerator::process_event(PHCompositeNode *topNode)
   {
     vtx_z = (z_max - z_min) * gsl_rng_uniform_pos(RandomGenerator) + z_min;
   }
-  int vtxindex = ineve->AddVtx(vtx_x, vtx_y, vtx_z, t0);
+  int vtxindex = ineve->AddVtx(vtx_x, vtx_y, vtx_z, t0 + ibatch * batch_spacing);
 
   vector<PHG4Particle *>::iterator iter;
   for (iter = particlelist.begin(); iter != particlelist.end(); ++iter)
@@ -91,7 +91,7 @@ int PHG4ParticleGenerator::process_event(PHCompositeNode *topNode)
     (*iter)->set_pz(particle->get_pz());
     ineve->AddParticle(vtxindex, particle);
   }
-  if (Verbosity() > 0)
+  if (Verbosity() > 0 && ibatch + 1 == batch_size)
   {
     ineve->identify();
   }
@@ -15,7 +15,6 @@ class PHG4ParticleGenerator : public PHG4ParticleGeneratorBase
   PHG4ParticleGenerator(const std::string &name = "PGENERATOR");
   virtual ~PHG4ParticleGenerator() {}
 
-  int process_event(PHCompositeNode *topNode);
   void set_z_range(const double z_min, const double z_max);
   void set_eta_range(const double eta_min, const double eta_max);
   void set_phi_range(const double phi_min, const double phi_max);
@@ -23,6 +22,8 @@ class PHG4ParticleGenerator : public PHG4ParticleGeneratorBase
   void Print(const std::string &what = "ALL") const;
 
  protected:
+  int GenerateEvent(PHCompositeNode *topNode, const unsigned int ibatch);
+
   double z_min;
   double z_max;
   double eta_min;
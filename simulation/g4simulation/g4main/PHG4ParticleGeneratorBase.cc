@@ -10,6 +10,8 @@
 #include <phhepmc/PHHepMCGenEvent.h>
 #include <phhepmc/PHHepMCGenEventMap.h>
 
+#include <fun4all/Fun4AllReturnCodes.h>
+
 #include <phool/getClass.h>
 #include <phool/PHCompositeNode.h>
 #include <phool/PHDataNode.h>              // for PHDataNode
@@ -18,6 +20,7 @@
 #include <phool/PHObject.h>                // for PHObject
 #include <phool/PHRandomSeed.h>
 #include <phool/phool.h>                   // for PHWHERE
+#include <phool/recoConsts.h>
 
 #include <Geant4/G4ParticleDefinition.hh>
 #include <Geant4/G4ParticleTable.hh>
@@ -29,6 +32,7 @@
 #include <gsl/gsl_rng.h>
 
 #include <cassert>
+#include <cmath>                           // for floor
 #include <cstdlib>                        // for exit
 #include <iostream>                        // for operator<<, basic_ostream
 #include <iterator>                        // for operator!=, reverse_iterator
@@ -45,6 +49,8 @@ PHG4ParticleGeneratorBase::PHG4ParticleGeneratorBase(const string &name)
   , vtx_y(0)
   , vtx_z(0)
   , t0(0)
+  , batch_size(1)
+  , batch_spacing(0)
 {
   RandomGenerator = gsl_rng_alloc(gsl_rng_mt19937);
   seed = PHRandomSeed();  // fixed seed is handled in this funtcion
@@ -148,9 +154,53 @@ int PHG4ParticleGeneratorBase::InitRun(PHCompositeNode *topNode)
 }
 
 int PHG4ParticleGeneratorBase::process_event(PHCompositeNode *topNode)
+{
+  for (unsigned int ibatch = 0; ibatch < batch_size; ++ibatch)
+  {
+    int iret = GenerateEvent(topNode, ibatch);
+    if (iret != Fun4AllReturnCodes::EVENT_OK)
+    {
+      return iret;
+    }
+  }
+  return Fun4AllReturnCodes::EVENT_OK;
+}
+
+int PHG4ParticleGeneratorBase::GenerateEvent(PHCompositeNode *topNode, const unsigned int ibatch)
 {
   cout << PHWHERE << " " << Name() << " using empty process_event" << endl;
-  return 0;
+  return Fun4AllReturnCodes::EVENT_OK;
+}
+
+void PHG4ParticleGeneratorBase::set_batch(const unsigned int nevents, const double spacing)
+{
+  if (nevents == 0 || (nevents > 1 && spacing <= 0))
+  {
+    cout << PHWHERE << " " << Name() << " invalid batch of " << nevents
+         << " events with spacing " << spacing << " ns" << endl;
+    exit(1);
+  }
+  batch_size = nevents;
+  batch_spacing = spacing;
+  // saved with the run so the truth can be split into the logical events later on
+  recoConsts *rc = recoConsts::instance();
+  rc->set_IntFlag("G4BATCH_SIZE", batch_size);
+  rc->set_DoubleFlag("G4BATCH_SPACING", batch_spacing);
+}
+
+int PHG4ParticleGeneratorBase::BatchIndex(const double t, const double tstart, const double spacing, const unsigned int nevents)
+{
+  if (nevents <= 1 || spacing <= 0)
+  {
+    return 0;
+  }
+  // primary vertices sit exactly on the grid, round to the nearest slot
+  const double index = floor((t - tstart) / spacing + 0.5);
+  if (index < 0 || index >= nevents)
+  {
+    return -1;
+  }
+  return index;
 }
 
 void PHG4ParticleGeneratorBase::PrintParticles(const std::string &what) const
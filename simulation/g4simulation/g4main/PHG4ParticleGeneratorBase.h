@@ -48,8 +48,19 @@ class PHG4ParticleGeneratorBase : public SubsysReco
   void set_seed(const unsigned int iseed);
   unsigned int get_seed() const { return seed; }
 
+  //! pack nevents logical events into one Geant4 event, logical event i starts at t0 + i * spacing (ns)
+  //! the spacing has to be larger than the time the showers take to develop
+  void set_batch(const unsigned int nevents, const double spacing);
+  unsigned int get_batch_size() const { return batch_size; }
+  double get_batch_spacing() const { return batch_spacing; }
+
+  //! logical event of a primary vertex with time t, -1 if it is outside the batch
+  static int BatchIndex(const double t, const double tstart, const double spacing, const unsigned int nevents);
+
  protected:
   PHG4ParticleGeneratorBase(const std::string &name = "GENERATORBASE");
+  //! generates logical event ibatch of the batch, process_event calls it batch_size times
+  virtual int GenerateEvent(PHCompositeNode *topNode, const unsigned int ibatch);
   int get_pdgcode(const std::string &name) const;
   std::string get_pdgname(const int pdgcode) const;
   double get_mass(const int pdgcode) const;
@@ -63,6 +74,8 @@ class PHG4ParticleGeneratorBase : public SubsysReco
   double t0;
   std::vector<PHG4Particle *> particlelist;
   unsigned int seed;
+  unsigned int batch_size;
+  double batch_spacing;
 #if !defined(__CINT__) || defined(__CLING__)
   gsl_rng *RandomGenerator;
 #endif
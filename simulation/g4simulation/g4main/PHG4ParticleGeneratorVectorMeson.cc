@@ -267,7 +267,7 @@ int PHG4ParticleGeneratorVectorMeson::InitRun(PHCompositeNode *topNode)
   return 0;
 }
 
-int PHG4ParticleGeneratorVectorMeson::process_event(PHCompositeNode *topNode)
+int PHG4ParticleGeneratorVectorMeson::GenerateEvent(PHCompositeNode *topNode, const unsigned int ibatch)
 {
   if (!ineve) cout << " G4InEvent not found " << endl;
 
@@ -362,11 +362,11 @@ int PHG4ParticleGeneratorVectorMeson::process_event(PHCompositeNode *topNode)
       x1 *= r;
       y1 *= r;
       z1 *= r;
-      vtxindex = ineve->AddVtx(vtx_x + x1, vtx_y + y1, vtx_z + z1, t0);
+      vtxindex = ineve->AddVtx(vtx_x + x1, vtx_y + y1, vtx_z + z1, t0 + ibatch * batch_spacing);
     }
     else if (decay_id == 0)
     {
-      vtxindex = ineve->AddVtx(vtx_x, vtx_y, vtx_z, t0);
+      vtxindex = ineve->AddVtx(vtx_x, vtx_y, vtx_z, t0 + ibatch * batch_spacing);
     }
 
     // Now decay it
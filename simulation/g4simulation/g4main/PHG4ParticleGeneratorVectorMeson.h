@@ -27,7 +27,6 @@ class PHG4ParticleGeneratorVectorMeson : public PHG4ParticleGeneratorBase
   virtual ~PHG4ParticleGeneratorVectorMeson();
 
   int InitRun(PHCompositeNode *topNode);
-  int process_event(PHCompositeNode *topNode);
 
   //! interface for adding particles by name
   void add_decay_particles(const std::string &name1, const std::string &name2, const unsigned int decay_id);
@@ -73,6 +72,8 @@ class PHG4ParticleGeneratorVectorMeson : public PHG4ParticleGeneratorBase
   std::map<unsigned int, double> decay_vtx_offset_z;
 
  protected:
+  int GenerateEvent(PHCompositeNode *topNode, const unsigned int ibatch);
+
   FUNCTION _vertex_func_x;
   FUNCTION _vertex_func_y;
   FUNCTION _vertex_func_z;
@@ -1,11 +1,14 @@
 #include "PHG4PhenixDetector.h"
 
+#include "G4TBMagneticFieldSetup.hh"
 #include "PHG4Detector.h"
 #include "PHG4DisplayAction.h"              // for PHG4DisplayAction
 #include "PHG4PhenixDisplayAction.h"
 #include "PHG4Reco.h"
 #include "PHG4RegionInformation.h"
 
+#include <phfield/PHFieldUtility.h>
+
 #include <phool/recoConsts.h>
 
 #include <Geant4/G4Box.hh>
@@ -20,6 +23,7 @@
 #include <Geant4/G4String.hh>               // for G4String
 #include <Geant4/G4SolidStore.hh>
 #include <Geant4/G4SystemOfUnits.hh>
+#include <Geant4/G4Threading.hh>
 #include <Geant4/G4ThreeVector.hh>                 // for G4ThreeVector
 #include <Geant4/G4Tubs.hh>
 #include <Geant4/G4VSolid.hh>               // for G4GeometryType, G4VSolid
@@ -37,6 +41,7 @@ using namespace std;
 PHG4PhenixDetector::PHG4PhenixDetector(PHG4Reco *subsys)
   : m_DisplayAction(dynamic_cast<PHG4PhenixDisplayAction *>(subsys->GetDisplayAction()))
   , m_Verbosity(0)
+  , m_WorkerFieldConfig(nullptr)
   , logicWorld(nullptr)
   , physiWorld(nullptr)
   , WorldSizeX(1000 * cm)
@@ -112,3 +117,21 @@ G4VPhysicalVolume *PHG4PhenixDetector::Construct()
 
   return physiWorld;
 }
+
+//_______________________________________________________________________________________________
+void PHG4PhenixDetector::ConstructSDandField()
+{
+  // the master (and the sequential run manager) uses the field of PHG4Reco
+  if (!m_WorkerFieldConfig || !G4Threading::IsWorkerThread())
+  {
+    return;
+  }
+
+  // the global field manager is thread local. The field map caches its last
+  // lookup, so every worker gets its own
+  static G4ThreadLocal G4TBMagneticFieldSetup *worker_field = nullptr;
+  if (!worker_field)
+  {
+    worker_field = new G4TBMagneticFieldSetup(PHFieldUtility::BuildFieldMap(m_WorkerFieldConfig));
+  }
+}
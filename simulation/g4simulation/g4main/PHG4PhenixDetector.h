@@ -11,6 +11,7 @@
 
 class G4LogicalVolume;
 class G4VPhysicalVolume;
+class PHFieldConfig;
 class PHG4Detector;
 class PHG4PhenixDisplayAction;
 class PHG4Reco;
@@ -37,6 +38,13 @@ class PHG4PhenixDetector : public G4VUserDetectorConstruction
   //! this is called by geant to actually construct all detectors
   virtual G4VPhysicalVolume* Construct();
 
+  //! called by geant on each thread after Construct(). The geometry is
+  //! shared, worker threads set up their own magnetic field here
+  virtual void ConstructSDandField();
+
+  //! field of the worker threads, nullptr without worker threads
+  void SetWorkerFieldConfig(const PHFieldConfig* config) { m_WorkerFieldConfig = config; }
+
   G4double GetWorldSizeX() const { return WorldSizeX; }
 
   G4double GetWorldSizeY() const { return WorldSizeY; }
@@ -55,6 +63,8 @@ class PHG4PhenixDetector : public G4VUserDetectorConstruction
 
   int m_Verbosity;
 
+  const PHFieldConfig* m_WorkerFieldConfig;
+
   //! list of detectors to be constructed
 
   std::list<PHG4Detector*> m_DetectorList;
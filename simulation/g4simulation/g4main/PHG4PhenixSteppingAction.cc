@@ -1,6 +1,11 @@
 #include "PHG4PhenixSteppingAction.h"
 #include "PHG4SteppingAction.h"
 
+#include <Geant4/G4Step.hh>
+#include <Geant4/G4StepPoint.hh>
+#include <Geant4/G4TouchableHandle.hh>
+#include <Geant4/G4VTouchable.hh>
+
 PHG4PhenixSteppingAction::~PHG4PhenixSteppingAction()
 {
   while (actions_.begin() != actions_.end())
@@ -14,14 +19,31 @@ PHG4PhenixSteppingAction::~PHG4PhenixSteppingAction()
 //_________________________________________________________________
 void PHG4PhenixSteppingAction::UserSteppingAction( const G4Step* aStep )
 {
-  // loop over registered actions, and process
+  // loop over the actions registered for the volume of this step, and process
   bool hit_was_used = false;
-  for( ActionList::const_iterator iter = actions_.begin(); iter != actions_.end(); ++iter )
+  const std::vector<PHG4SteppingAction*>& actions = VolumeActions( aStep->GetPreStepPoint()->GetTouchableHandle()->GetVolume() );
+  for( std::vector<PHG4SteppingAction*>::const_iterator iter = actions.begin(); iter != actions.end(); ++iter )
   {
-    if(*iter)
+    hit_was_used |= (*iter)->UserSteppingAction( aStep, hit_was_used );
+  }
+
+}
+
+//_________________________________________________________________
+const std::vector<PHG4SteppingAction*>& PHG4PhenixSteppingAction::VolumeActions( G4VPhysicalVolume* volume )
+{
+  VolumeActionMap::iterator iter = volume_actions_.find( volume );
+  if (iter != volume_actions_.end())
+  {
+    return iter->second;
+  }
+  std::vector<PHG4SteppingAction*>& actions = volume_actions_[volume];
+  for( ActionList::const_iterator action = actions_.begin(); action != actions_.end(); ++action )
+  {
+    if (*action && (*action)->HandlesVolume( volume ))
     {
-      hit_was_used |= (*iter)->UserSteppingAction( aStep, hit_was_used );
+      actions.push_back( *action );
     }
   }
-
+  return actions;
 }
@@ -5,8 +5,11 @@
 
 #include <Geant4/G4UserSteppingAction.hh>
 #include <list>
+#include <unordered_map>
+#include <vector>
 
 class G4Step;
+class G4VPhysicalVolume;
 class PHG4SteppingAction;
 
 class PHG4PhenixSteppingAction : public G4UserSteppingAction
@@ -25,6 +28,7 @@ class PHG4PhenixSteppingAction : public G4UserSteppingAction
     if (action)
       {
 	actions_.push_back( action );
+	volume_actions_.clear();
       }
   }
 
@@ -32,10 +36,18 @@ class PHG4PhenixSteppingAction : public G4UserSteppingAction
 
   private:
 
+  //! actions which handle steps in this volume, in registration order
+  const std::vector<PHG4SteppingAction*>& VolumeActions( G4VPhysicalVolume* volume );
+
   //! list of subsystem specific stepping actions
   typedef std::list<PHG4SteppingAction*> ActionList;
   ActionList actions_;
 
+  //! per volume dispatch table, filled on first use of a volume
+  /*! every worker thread has its own PHG4PhenixSteppingAction, no locking needed */
+  typedef std::unordered_map<G4VPhysicalVolume*, std::vector<PHG4SteppingAction*> > VolumeActionMap;
+  VolumeActionMap volume_actions_;
+
 };
 
 
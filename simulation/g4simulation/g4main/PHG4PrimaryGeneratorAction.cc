@@ -21,6 +21,7 @@
 #include <cmath>                                // for sqrt
 #include <cstdlib>
 #include <iostream>
+#include <iterator>                              // for distance
 #include <map>
 #include <string>                                // for operator<<
 #include <utility>                               // for pair
@@ -37,16 +38,45 @@ void PHG4PrimaryGeneratorAction::GeneratePrimaries(G4Event* anEvent)
   multimap<int, PHG4Particle*>::const_iterator particle_iter;
   std::pair<std::map<int, PHG4VtxPoint*>::const_iterator, std::map<int, PHG4VtxPoint*>::const_iterator> vtxbegin_end = inEvent->GetVertices();
 
+  // with sub events only the primaries [first, last) go into this event
+  int first = 0;
+  int last = inEvent->GetNParticles();
+  if (nsubevents > 1)
+  {
+    const long nparticles = last;
+    const int isub = anEvent->GetEventID() % nsubevents;
+    first = isub * nparticles / nsubevents;
+    last = (isub + 1) * nparticles / nsubevents;
+  }
+  int iparticle = 0;
+  // most events have no embedded particles, no lookup per particle then
+  const int nembedded = inEvent->GetNEmbedded();
   for (vtxiter = vtxbegin_end.first; vtxiter != vtxbegin_end.second; ++vtxiter)
   {
+    pair<multimap<int, PHG4Particle*>::const_iterator, multimap<int, PHG4Particle*>::const_iterator> particlebegin_end = inEvent->GetParticles(vtxiter->first);
+    if (nsubevents > 1)
+    {
+      const int vtxfirst = iparticle;
+      iparticle += distance(particlebegin_end.first, particlebegin_end.second);
+      // no particle of this vertex in this sub event
+      if (iparticle <= first || vtxfirst >= last)
+      {
+        continue;
+      }
+      iparticle = vtxfirst;
+    }
     //       cout << "vtx number: " << vtxiter->first << endl;
     //       (*vtxiter->second).identify();
     // expected units are cm !
     G4ThreeVector position((*vtxiter->second).get_x() * cm, (*vtxiter->second).get_y() * cm, (*vtxiter->second).get_z() * cm);
     G4PrimaryVertex* vertex = new G4PrimaryVertex(position, (*vtxiter->second).get_t() * nanosecond);
-    pair<multimap<int, PHG4Particle*>::const_iterator, multimap<int, PHG4Particle*>::const_iterator> particlebegin_end = inEvent->GetParticles(vtxiter->first);
     for (particle_iter = particlebegin_end.first; particle_iter != particlebegin_end.second; ++particle_iter)
     {
+      const int ithis = iparticle++;
+      if (ithis < first || ithis >= last)
+      {
+        continue;
+      }
       // cout << "PHG4PrimaryGeneratorAction: dealing with" << endl;
       //  (particle_iter->second)->identify();
 
@@ -131,7 +161,7 @@ void PHG4PrimaryGeneratorAction::GeneratePrimaries(G4Event* anEvent)
       // Do this for all primaries, not just the embedded particle, so that
       // we can carry the barcode information forward.
       //  {
-      PHG4UserPrimaryParticleInformation* userdata = new PHG4UserPrimaryParticleInformation(inEvent->isEmbeded(particle_iter->second));
+      PHG4UserPrimaryParticleInformation* userdata = new PHG4UserPrimaryParticleInformation(nembedded ? inEvent->isEmbeded(particle_iter->second) : 0);
       userdata->set_user_barcode((*particle_iter->second).get_barcode());
       g4part->SetUserInformation(userdata);
       //  }
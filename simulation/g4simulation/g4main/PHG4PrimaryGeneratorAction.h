@@ -13,6 +13,7 @@ class PHG4PrimaryGeneratorAction : public G4VUserPrimaryGeneratorAction
  public:
   PHG4PrimaryGeneratorAction()
     : verbosity(0)
+    , nsubevents(1)
     , inEvent(0)
   {
   }
@@ -29,12 +30,18 @@ class PHG4PrimaryGeneratorAction : public G4VUserPrimaryGeneratorAction
     inEvent = inevt;
   }
 
+  //! split the primaries of the input event (in vertex order) into nsub
+  //! chunks of equal size, G4Event i gets chunk i % nsub and the vertices
+  //! of its particles (sub events, see PHG4SubEventMerger)
+  void SetSubEvents(const int nsub) { nsubevents = nsub; }
+
   //! Set/Get verbosity
   void Verbosity(const int val) { verbosity = val; }
   int Verbosity() const { return verbosity; }
 
  protected:
   int verbosity;
+  int nsubevents;
 
  private:
   //! temporary pointer to input event on node tree
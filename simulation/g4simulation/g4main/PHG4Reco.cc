@@ -2,6 +2,8 @@
 
 #include "Fun4AllMessenger.h"
 #include "G4TBMagneticFieldSetup.hh"
+#include "PHG4ActionInitialization.h"
+#include "PHG4Detector.h"
 #include "PHG4DisplayAction.h"
 #include "PHG4InEvent.h"
 #include "PHG4PhenixDetector.h"
@@ -10,10 +12,12 @@
 #include "PHG4PhenixSteppingAction.h"
 #include "PHG4PhenixTrackingAction.h"
 #include "PHG4PrimaryGeneratorAction.h"
+#include "PHG4SubEventStore.h"
 #include "PHG4Subsystem.h"
 #include "PHG4TrackingAction.h"
 #include "PHG4UIsession.h"
 #include "PHG4Utils.h"
+#include "PHG4WorkerInitialization.h"
 
 #include <g4decayer/EDecayType.hh>
 #include <g4decayer/P6DExtDecayerPhysics.hh>
@@ -26,6 +30,8 @@
 #include <phfield/PHFieldConfigv2.h>
 #include <phfield/PHFieldUtility.h>
 
+#include <phparameter/PHParametersStore.h>
+
 #include <fun4all/Fun4AllReturnCodes.h>
 #include <fun4all/Fun4AllServer.h>
 
@@ -50,6 +56,8 @@
 #include <Geant4/G4EventManager.hh>  // for G4EventManager
 #include <Geant4/G4HadronicProcessStore.hh>
 #include <Geant4/G4IonisParamMat.hh>  // for G4IonisParamMat
+#include <Geant4/G4LogicalVolume.hh>
+#include <Geant4/G4LogicalVolumeStore.hh>
 #include <Geant4/G4LossTableManager.hh>
 #include <Geant4/G4Material.hh>
 #include <Geant4/G4MaterialPropertiesTable.hh>  // for G4MaterialProperties...
@@ -69,6 +77,9 @@
 #include <Geant4/G4Region.hh>
 #include <Geant4/G4RegionStore.hh>
 #include <Geant4/G4RunManager.hh>
+#ifdef G4MULTITHREADED
+#include <Geant4/G4MTRunManager.hh>
+#endif
 #include <Geant4/G4StepLimiterPhysics.hh>
 #include <Geant4/G4String.hh>  // for G4String
 #include <Geant4/G4SystemOfUnits.hh>
@@ -76,7 +87,10 @@
 #include <Geant4/G4UIExecutive.hh>
 #include <Geant4/G4UImanager.hh>
 #include <Geant4/G4UImessenger.hh>          // for G4UImessenger
+#include <Geant4/G4UserLimits.hh>
+#include <Geant4/G4VPhysicalVolume.hh>
 #include <Geant4/G4VModularPhysicsList.hh>  // for G4VModularPhysicsList
+#include <Geant4/G4VUserPhysicsList.hh>     // for G4VUserPhysicsList
 #include <Geant4/G4Version.hh>
 #include <Geant4/G4VisExecutive.hh>
 #include <Geant4/G4VisManager.hh>  // for G4VisManager
@@ -95,17 +109,22 @@
 
 #include <boost/filesystem.hpp>
 #include <boost/foreach.hpp>
+#include <boost/functional/hash.hpp>
 
+#include <algorithm>  // for max
 #include <cassert>
 #include <cstdlib>
 #include <exception>  // for exception
 #include <iostream>   // for operator<<, endl
+#include <map>
 #include <memory>
 #include <set>     // for set, _Rb_tree_const_...
+#include <sstream>
 #include <vector>  // for vector, vector<>::it...
 
+#include <unistd.h>  // for getpid
+
 class G4TrackingManager;
-class G4VPhysicalVolume;
 class PHField;
 class PHG4EventAction;
 class PHG4SteppingAction;
@@ -118,6 +137,7 @@ PHG4Reco::PHG4Reco(const string &name)
   , m_MagneticField(0.)
   , m_MagneticFieldRescale(1.0)
   , m_Field(nullptr)
+  , m_PrebuiltField(nullptr)
   , m_RunManager(nullptr)
   , m_UISession(nullptr)
   , m_Detector(nullptr)
@@ -144,6 +164,14 @@ PHG4Reco::PHG4Reco(const string &name)
   , m_ForceDecayType(kAll)
   , m_SaveDstGeometryFlag(true)
   , m_disableUserActions(false)
+  , m_NThreads(1)
+  , m_PrimariesPerSubEvent(100)
+  , m_ActionInitialization(nullptr)
+  , m_SubEventStore(nullptr)
+  , m_WorkerFieldConfig(nullptr)
+  , m_GeometryCacheDir("")
+  , m_PhysicsTableCacheDir("")
+  , m_PhysicsTableStoreDir("")
 {
   for (int i = 0; i < 3; i++)
   {
@@ -158,7 +186,10 @@ PHG4Reco::~PHG4Reco(void)
   // one can delete null pointer (it results in a nop), so checking if
   // they are non zero is not needed
   delete m_Field;
+  delete m_PrebuiltField;
   delete m_RunManager;
+  // after the run manager, the worker actions use it
+  delete m_SubEventStore;
   delete m_UISession;
   delete m_VisManager;
   delete m_Fun4AllMessenger;
@@ -193,7 +224,38 @@ int PHG4Reco::Init(PHCompositeNode *topNode)
     uimanager->SetCoutDestination(m_UISession);
   }
 
-  m_RunManager = new G4RunManager();
+  // worker threads need the support of all subsystems
+  if (m_NThreads > 1)
+  {
+#ifdef G4MULTITHREADED
+    BOOST_FOREACH (PHG4Subsystem *g4sub, m_SubsystemList)
+    {
+      if (!g4sub->SupportsWorkerThreads())
+      {
+        cout << "PHG4Reco::Init - " << g4sub->Name() << " does not support worker threads, running Geant4 single threaded" << endl;
+        m_NThreads = 1;
+        break;
+      }
+    }
+#else
+    cout << "PHG4Reco::Init - Geant4 is not built multithreaded, running single threaded instead of " << m_NThreads << " threads" << endl;
+    m_NThreads = 1;
+#endif
+  }
+
+#ifdef G4MULTITHREADED
+  if (m_NThreads > 1)
+  {
+    if (Verbosity() > 0) cout << "PHG4Reco::Init - create multithreaded run manager with " << m_NThreads << " threads" << endl;
+    G4MTRunManager *mt_runmanager = new G4MTRunManager();
+    mt_runmanager->SetNumberOfThreads(m_NThreads);
+    m_RunManager = mt_runmanager;
+  }
+  else
+#endif
+  {
+    m_RunManager = new G4RunManager();
+  }
 
   DefineMaterials();
   // create physics processes
@@ -263,6 +325,20 @@ int PHG4Reco::Init(PHCompositeNode *topNode)
     myphysicslist->RegisterPhysics(decayer);
   }
   myphysicslist->RegisterPhysics(new G4StepLimiterPhysics());
+  if (!m_PhysicsTableCacheDir.empty())
+  {
+    const string tabledir = GetPhysicsTableCacheDir();
+    if (boost::filesystem::exists(tabledir))
+    {
+      cout << "PHG4Reco::Init - retrieve physics tables from " << tabledir << endl;
+      myphysicslist->SetPhysicsTableRetrieved(tabledir);
+    }
+    else
+    {
+      // stored after the tables were built in the first event
+      m_PhysicsTableStoreDir = tabledir;
+    }
+  }
   // initialize cuts so we can ask the world region for it's default
   // cuts to propagate them to other regions in DefineRegions()
   myphysicslist->SetCutsWithDefault();
@@ -289,28 +365,50 @@ int PHG4Reco::Init(PHCompositeNode *topNode)
   return 0;
 }
 
-int PHG4Reco::InitField(PHCompositeNode *topNode)
+PHFieldConfig *PHG4Reco::MakeFieldConfig() const
 {
-  if (Verbosity() > 1) cout << "PHG4Reco::InitField - create magnetic field setup" << endl;
-
-  unique_ptr<PHFieldConfig> default_field_cfg(nullptr);
-
   if (m_FieldMapFile != "NONE")
   {
-    default_field_cfg.reset(new PHFieldConfigv1(m_FieldConfigType, m_FieldMapFile, m_MagneticFieldRescale));
+    return new PHFieldConfigv1(m_FieldConfigType, m_FieldMapFile, m_MagneticFieldRescale);
   }
-  else
+  return new PHFieldConfigv2(0, 0, m_MagneticField * m_MagneticFieldRescale);
+}
+
+int PHG4Reco::InitRunIndependent(const int /*runnumber*/)
+{
+  // InitRun only sets up the field once (see there)
+  if (m_Field || m_PrebuiltField)
   {
-    default_field_cfg.reset(new PHFieldConfigv2(0, 0, m_MagneticField * m_MagneticFieldRescale));
+    return Fun4AllReturnCodes::EVENT_OK;
   }
+  // reading the map is the slow part of InitField, it does not need the node
+  // tree. If the DST brings its own field configuration InitField discards it
+  unique_ptr<PHFieldConfig> default_field_cfg(MakeFieldConfig());
+  m_PrebuiltField = PHFieldUtility::BuildFieldMap(default_field_cfg.get(), Verbosity());
+  return Fun4AllReturnCodes::EVENT_OK;
+}
 
+int PHG4Reco::InitField(PHCompositeNode *topNode)
+{
   if (Verbosity() > 1) cout << "PHG4Reco::InitField - create magnetic field setup" << endl;
 
-  PHField *phfield = PHFieldUtility::GetFieldMapNode(default_field_cfg.get(), topNode, Verbosity() + 1);
+  unique_ptr<PHFieldConfig> default_field_cfg(MakeFieldConfig());
+
+  if (Verbosity() > 1) cout << "PHG4Reco::InitField - create magnetic field setup" << endl;
+
+  // the node tree takes the field map from InitRunIndependent (or deletes it)
+  PHField *phfield = PHFieldUtility::GetFieldMapNode(default_field_cfg.get(), topNode, Verbosity() + 1, m_PrebuiltField);
+  m_PrebuiltField = nullptr;
   assert(phfield);
 
   m_Field = new G4TBMagneticFieldSetup(phfield);
 
+  // the field maps cache their last lookup, each worker thread builds its own
+  if (m_NThreads > 1)
+  {
+    m_WorkerFieldConfig = PHFieldUtility::GetFieldConfigNode(default_field_cfg.get(), topNode, Verbosity());
+  }
+
   return Fun4AllReturnCodes::EVENT_OK;
 }
 
@@ -354,6 +452,14 @@ int PHG4Reco::InitRun(PHCompositeNode *topNode)
     }
     reco->InitRun(topNode);
   }
+  // the subsystems registered their geometry parameters, save them all in one go
+  PHParametersStore *paramstore = PHParametersStore::GetStore(topNode);
+  if (paramstore)
+  {
+    PHNodeIterator iter(topNode);
+    PHCompositeNode *runNode = dynamic_cast<PHCompositeNode *>(iter.findFirst("PHCompositeNode", "RUN"));
+    paramstore->SaveToNodeTree(runNode);
+  }
 
   // create phenix detector, add subsystems, and register to GEANT
   // create display settings before detector
@@ -366,6 +472,7 @@ int PHG4Reco::InitRun(PHCompositeNode *topNode)
   m_Detector->SetWorldSizeZ(m_WorldSize[2] * cm);
   m_Detector->SetWorldShape(m_WorldShape);
   m_Detector->SetWorldMaterial(m_WorldMaterial);
+  m_Detector->SetWorkerFieldConfig(m_WorkerFieldConfig);
 
   rc->set_FloatFlag("WorldSizex", m_WorldSize[0]);
   rc->set_FloatFlag("WorldSizey", m_WorldSize[1]);
@@ -375,6 +482,11 @@ int PHG4Reco::InitRun(PHCompositeNode *topNode)
   {
     if (g4sub->GetDetector())
     {
+      map<string, string>::const_iterator region = m_RegionSubsystems.find(g4sub->Name());
+      if (region != m_RegionSubsystems.end())
+      {
+        g4sub->GetDetector()->SetRegion(region->second);
+      }
       m_Detector->AddDetector(g4sub->GetDetector());
     }
   }
@@ -387,6 +499,21 @@ int PHG4Reco::InitRun(PHCompositeNode *topNode)
          << "Meanwhile, it will disable all Geant4 based analysis. Toggle this feature on/off with PHG4Reco::setDisableUserActions()" << endl;
   }
 
+  // the worker threads get their own actions from the subsystems, the master has none
+  if (m_NThreads > 1)
+  {
+    // the subsystems created their hit nodes in their InitRun
+    if (!m_SubEventStore)
+    {
+      m_SubEventStore = new PHG4SubEventStore();
+    }
+    m_SubEventStore->Configure(topNode);
+    m_ActionInitialization = new PHG4ActionInitialization(m_SubsystemList, m_SubEventStore, m_disableUserActions);
+    m_ActionInitialization->Verbosity(Verbosity());
+    m_RunManager->SetUserInitialization(m_ActionInitialization);
+    m_RunManager->SetUserInitialization(new PHG4WorkerInitialization());
+  }
+
   setupInputEventNodeReader(topNode);
   // create main event action, add subsystemts and register to GEANT
   m_EventAction = new PHG4PhenixEventAction();
@@ -400,7 +527,7 @@ int PHG4Reco::InitRun(PHCompositeNode *topNode)
     }
   }
 
-  if (not m_disableUserActions)
+  if (not m_disableUserActions && not m_ActionInitialization)
   {
     m_RunManager->SetUserAction(m_EventAction);
   }
@@ -421,7 +548,7 @@ int PHG4Reco::InitRun(PHCompositeNode *topNode)
     }
   }
 
-  if (not m_disableUserActions)
+  if (not m_disableUserActions && not m_ActionInitialization)
   {
     m_RunManager->SetUserAction(m_SteppingAction);
   }
@@ -443,15 +570,80 @@ int PHG4Reco::InitRun(PHCompositeNode *topNode)
     }
   }
 
-  if (not m_disableUserActions)
+  if (not m_disableUserActions && not m_ActionInitialization)
   {
     m_RunManager->SetUserAction(m_TrackingAction);
   }
 
   // initialize
   m_RunManager->Initialize();
+  ApplyRegionSettings();
+
+  // add cerenkov and optical photon processes, the workers add their own
+  // in PHG4WorkerInitialization::WorkerRunStart()
+  DefineOpticalProcesses();
+
+  // needs large amount of memory which kills central hijing events
+  // store generated trajectories
+  //if( G4TrackingManager* trackingManager = G4EventManager::GetEventManager()->GetTrackingManager() ){
+  //  trackingManager->SetStoreTrajectory( true );
+  //}
+
+  // quiet some G4 print-outs (EM and Hadronic settings during first event)
+  G4HadronicProcessStore::Instance()->SetVerbose(0);
+  G4LossTableManager::Instance()->SetVerbose(1);
 
-  // add cerenkov and optical photon processes
+  if ((Verbosity() < 1) && (m_UISession))
+  {
+    m_UISession->Verbosity(1);  // let messages after setup come through
+  }
+
+  // Geometry export to DST
+  if (m_SaveDstGeometryFlag)
+  {
+    const string cachefile = GetGeometryCacheFile();
+    if (!cachefile.empty())
+    {
+      // the closed TGeo geometry is cached next to the GDML file
+      if (PHGeomUtility::GetGeometryCacheDir().empty())
+      {
+        PHGeomUtility::SetGeometryCacheDir(m_GeometryCacheDir);
+      }
+      if (!boost::filesystem::exists(cachefile))
+      {
+        cout << "PHG4Reco::InitRun - export geometry to cache file " << cachefile << endl;
+        Dump_GDML(cachefile);
+      }
+      else
+      {
+        cout << "PHG4Reco::InitRun - import DST geometry from cache file " << cachefile << endl;
+      }
+      PHGeomUtility::ImportGeomFile(topNode, cachefile);
+    }
+    else
+    {
+      const string filename = PHGeomUtility::GenerateGeometryFileName("gdml");
+      cout << "PHG4Reco::InitRun - export geometry to DST via tmp file " << filename << endl;
+
+      Dump_GDML(filename);
+
+      PHGeomUtility::ImportGeomFile(topNode, filename);
+
+      PHGeomUtility::RemoveGeometryFile(filename);
+    }
+  }
+
+  if (Verbosity() > 0)
+  {
+    cout << "===========================================================================" << endl;
+  }
+
+  return 0;
+}
+
+//________________________________________________________________
+void PHG4Reco::DefineOpticalProcesses()
+{
   // cout << endl << "Ignore the next message - we implemented this correctly" << endl;
   G4Cerenkov *theCerenkovProcess = new G4Cerenkov("Cerenkov");
   // cout << "End of bogus warning message" << endl << endl;
@@ -506,48 +698,90 @@ int PHG4Reco::InitRun(PHCompositeNode *topNode)
   pmanager->AddDiscreteProcess(new G4OpWLS());
   pmanager->AddDiscreteProcess(new G4PhotoElectricEffect());
   // pmanager->DumpInfo();
+}
 
-  // needs large amount of memory which kills central hijing events
-  // store generated trajectories
-  //if( G4TrackingManager* trackingManager = G4EventManager::GetEventManager()->GetTrackingManager() ){
-  //  trackingManager->SetStoreTrajectory( true );
-  //}
-
-  // quiet some G4 print-outs (EM and Hadronic settings during first event)
-  G4HadronicProcessStore::Instance()->SetVerbose(0);
-  G4LossTableManager::Instance()->SetVerbose(1);
+//________________________________________________________________
+//Dump TGeo File
+void PHG4Reco::Dump_GDML(const std::string &filename)
+{
+  PHG4GDMLUtility ::Dump_GDML(filename, m_Detector->GetPhysicalVolume());
+}
 
-  if ((Verbosity() < 1) && (m_UISession))
+//________________________________________________________________
+string PHG4Reco::GetGeometryCacheFile() const
+{
+  if (m_GeometryCacheDir.empty())
   {
-    m_UISession->Verbosity(1);  // let messages after setup come through
+    return "";
   }
-
-  // Geometry export to DST
-  if (m_SaveDstGeometryFlag)
+  size_t seed = 0;
+  boost::hash_combine(seed, m_WorldShape);
+  boost::hash_combine(seed, m_WorldMaterial);
+  for (int i = 0; i < 3; i++)
   {
-    const string filename = PHGeomUtility::GenerateGeometryFileName("gdml");
-    cout << "PHG4Reco::InitRun - export geometry to DST via tmp file " << filename << endl;
-
-    Dump_GDML(filename);
-
-    PHGeomUtility::ImportGeomFile(topNode, filename);
-
-    PHGeomUtility::RemoveGeometryFile(filename);
+    boost::hash_combine(seed, m_WorldSize[i]);
   }
-
-  if (Verbosity() > 0)
+  BOOST_FOREACH (PHG4Subsystem *g4sub, m_SubsystemList)
   {
-    cout << "===========================================================================" << endl;
+    if (!g4sub->GetDetector())
+    {
+      continue;
+    }
+    const size_t hash = g4sub->GetGeometryHash();
+    if (!hash)
+    {
+      cout << "PHG4Reco::GetGeometryCacheFile - " << g4sub->Name()
+           << " does not provide a geometry hash, not using the geometry cache" << endl;
+      return "";
+    }
+    boost::hash_combine(seed, hash);
   }
+  ostringstream filename;
+  filename << m_GeometryCacheDir << "/PHG4Reco_geometry_0x" << hex << seed << ".gdml";
+  return filename.str();
+}
 
-  return 0;
+//________________________________________________________________
+string PHG4Reco::GetPhysicsTableCacheDir() const
+{
+  // everything registered with the physics list in Init()
+  size_t seed = 0;
+  boost::hash_combine(seed, m_PhysicsList);
+  boost::hash_combine(seed, m_ActiveDecayerFlag);
+  boost::hash_combine(seed, m_ActiveForceDecayFlag);
+  boost::hash_combine(seed, static_cast<int>(m_ForceDecayType));
+  // the cuts change the material-cuts couples of the tables
+  boost::hash_combine(seed, m_RegionCuts);
+  boost::hash_combine(seed, m_RegionVolumes);
+  boost::hash_combine(seed, m_RegionSubsystems);
+  ostringstream dirname;
+  dirname << m_PhysicsTableCacheDir << "/PHG4Reco_physics_" << m_PhysicsList
+          << "_G4" << G4VERSION_NUMBER << "_0x" << hex << seed;
+  return dirname.str();
 }
 
 //________________________________________________________________
-//Dump TGeo File
-void PHG4Reco::Dump_GDML(const std::string &filename)
+void PHG4Reco::StorePhysicsTables()
 {
-  PHG4GDMLUtility ::Dump_GDML(filename, m_Detector->GetPhysicalVolume());
+  // write into a directory of this job and rename it, so jobs sharing the cache
+  // never read a partially written one. If another job was faster keep its tables
+  ostringstream tmpdir;
+  tmpdir << m_PhysicsTableStoreDir << ".tmp" << getpid();
+  cout << "PHG4Reco::process_event - store physics tables in " << m_PhysicsTableStoreDir << endl;
+  try
+  {
+    boost::filesystem::create_directories(tmpdir.str());
+    G4VUserPhysicsList *physicslist = const_cast<G4VUserPhysicsList *>(m_RunManager->GetUserPhysicsList());
+    physicslist->StorePhysicsTable(tmpdir.str());
+    boost::filesystem::rename(tmpdir.str(), m_PhysicsTableStoreDir);
+  }
+  catch (const boost::filesystem::filesystem_error &e)
+  {
+    cout << "PHG4Reco::StorePhysicsTables - physics tables not stored: " << e.what() << endl;
+    boost::system::error_code ec;
+    boost::filesystem::remove_all(tmpdir.str(), ec);
+  }
+  m_PhysicsTableStoreDir.clear();
 }
 
 //_________________________________________________________________
@@ -592,6 +826,15 @@ int PHG4Reco::process_event(PHCompositeNode *topNode)
   PHG4InEvent *ineve = findNode::getClass<PHG4InEvent>(topNode, "PHG4INEVENT");
   m_GeneratorAction->SetInEvent(ineve);
 
+  // with worker threads each chunk of primaries is a G4Event of its own
+  int nsubevents = 1;
+  if (m_ActionInitialization)
+  {
+    const int chunksize = std::max(1, m_PrimariesPerSubEvent);
+    nsubevents = std::max(1, (ineve->GetNParticles() + chunksize - 1) / chunksize);
+    m_ActionInitialization->SetInEvent(ineve, nsubevents);
+  }
+
   BOOST_FOREACH (SubsysReco *reco, m_SubsystemList)
   {
     if (Verbosity() >= 2)
@@ -617,7 +860,30 @@ int PHG4Reco::process_event(PHCompositeNode *topNode)
          << "run one event :" << endl;
     ineve->identify();
   }
-  m_RunManager->BeamOn(1);
+  m_RunManager->BeamOn(nsubevents);
+  if (!m_PhysicsTableStoreDir.empty())
+  {
+    StorePhysicsTables();
+  }
+
+  if (m_ActionInitialization)
+  {
+    // truth and hits of the sub events first, subsystems may have buffers of their own
+    if (m_SubEventStore->Merge(topNode) != Fun4AllReturnCodes::EVENT_OK)
+    {
+      return Fun4AllReturnCodes::ABORTEVENT;
+    }
+    BOOST_FOREACH (PHG4Subsystem *g4sub, m_SubsystemList)
+    {
+      if (Verbosity() >= 2)
+        cout << " PHG4Reco::process_event - " << g4sub->Name() << "->MergeWorkerOutput" << endl;
+      if (g4sub->MergeWorkerOutput(topNode) != Fun4AllReturnCodes::EVENT_OK)
+      {
+        cout << PHWHERE << " merging the worker thread output of " << g4sub->Name() << " failed" << endl;
+        return Fun4AllReturnCodes::ABORTEVENT;
+      }
+    }
+  }
 
   BOOST_FOREACH (PHG4Subsystem *g4sub, m_SubsystemList)
   {
@@ -647,6 +913,15 @@ int PHG4Reco::ResetEvent(PHCompositeNode *topNode)
   return 0;
 }
 
+int PHG4Reco::End(PHCompositeNode *topNode)
+{
+  BOOST_FOREACH (SubsysReco *reco, m_SubsystemList)
+  {
+    reco->End(topNode);
+  }
+  return 0;
+}
+
 void PHG4Reco::Print(const std::string &what) const
 {
   BOOST_FOREACH (SubsysReco *reco, m_SubsystemList)
@@ -679,7 +954,11 @@ int PHG4Reco::setupInputEventNodeReader(PHCompositeNode *topNode)
   {
     m_GeneratorAction = new PHG4PrimaryGeneratorAction();
   }
-  m_RunManager->SetUserAction(m_GeneratorAction);
+  // with worker threads the generators are created by PHG4ActionInitialization
+  if (!m_ActionInitialization)
+  {
+    m_RunManager->SetUserAction(m_GeneratorAction);
+  }
   return 0;
 }
 
@@ -1381,6 +1660,91 @@ void PHG4Reco::DefineRegions()
   return;
 }
 
+void PHG4Reco::ApplyRegionSettings()
+{
+  // the couples of the regions are only built at the start of the first run
+  G4LogicalVolumeStore *volumestore = G4LogicalVolumeStore::GetInstance();
+  for (multimap<string, string>::const_iterator iter = m_RegionVolumes.begin(); iter != m_RegionVolumes.end(); ++iter)
+  {
+    G4LogicalVolume *logvol = volumestore->GetVolume(iter->second, false);
+    if (!logvol)
+    {
+      cout << PHWHERE << " cannot find logical volume " << iter->second
+           << " for region " << iter->first << endl;
+      gSystem->Exit(1);
+    }
+    PHG4Detector::FindOrCreateRegion(iter->first)->AddRootLogicalVolume(logvol);
+  }
+  for (map<string, double>::const_iterator iter = m_RegionCuts.begin(); iter != m_RegionCuts.end(); ++iter)
+  {
+    G4Region *region = PHG4Detector::FindOrCreateRegion(iter->first);
+    if (region->GetNumberOfRootVolumes() == 0)
+    {
+      cout << PHWHERE << " region " << iter->first << " has no volumes, cut of "
+           << iter->second << " cm has no effect" << endl;
+    }
+    G4ProductionCuts *cuts = new G4ProductionCuts();
+    cuts->SetProductionCut(iter->second * cm);
+    region->SetProductionCuts(cuts);
+    if (Verbosity() > 0)
+    {
+      cout << "PHG4Reco: production cut " << iter->second << " cm in region " << iter->first << endl;
+    }
+  }
+
+  // kill volumes use the G4UserSpecialCuts process of G4StepLimiterPhysics, it stops
+  // tracks above their maximum track length or below their minimum kinetic energy
+  for (map<string, double>::const_iterator iter = m_KillVolumes.begin(); iter != m_KillVolumes.end(); ++iter)
+  {
+    G4LogicalVolume *logvol = volumestore->GetVolume(iter->first, false);
+    if (!logvol)
+    {
+      cout << PHWHERE << " cannot find logical volume " << iter->first << " to kill particles" << endl;
+      gSystem->Exit(1);
+    }
+    // volumes placed many times are only visited once
+    set<G4LogicalVolume *> done;
+    vector<G4LogicalVolume *> volumes(1, logvol);
+    while (!volumes.empty())
+    {
+      G4LogicalVolume *vol = volumes.back();
+      volumes.pop_back();
+      if (!done.insert(vol).second)
+      {
+        continue;
+      }
+      for (int i = 0; i < vol->GetNoDaughters(); ++i)
+      {
+        volumes.push_back(vol->GetDaughter(i)->GetLogicalVolume());
+      }
+      // user limits can be shared between volumes, keep the step limits of the original
+      G4UserLimits *limits = (vol->GetUserLimits() ? new G4UserLimits(*vol->GetUserLimits()) : new G4UserLimits());
+      if (iter->second < 0)
+      {
+        limits->SetUserMaxTrackLength(0.);
+      }
+      else
+      {
+        limits->SetUserMinEkine(iter->second * GeV);
+      }
+      vol->SetUserLimits(limits);
+    }
+    if (Verbosity() > 0)
+    {
+      cout << "PHG4Reco: kill particles in " << iter->first;
+      if (iter->second >= 0)
+      {
+        cout << " below " << iter->second << " GeV";
+      }
+      cout << endl;
+    }
+  }
+  if (!m_RegionVolumes.empty() || !m_RegionCuts.empty() || !m_KillVolumes.empty())
+  {
+    m_RunManager->GeometryHasBeenModified();
+  }
+}
+
 PHG4Subsystem *
 PHG4Reco::getSubsystem(const string &name)
 {
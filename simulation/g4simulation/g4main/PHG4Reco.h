@@ -10,7 +10,9 @@
 #include <phfield/PHFieldConfig.h>
 
 #include <list>
+#include <map>
 #include <string>  // for string
+#include <utility>
 
 // Forward declerations
 class G4RunManager;
@@ -19,12 +21,16 @@ class G4UImanager;
 class G4UImessenger;
 class G4VisManager;
 class PHCompositeNode;
+class PHField;
+class PHFieldConfig;
+class PHG4ActionInitialization;
 class PHG4DisplayAction;
 class PHG4PhenixDetector;
 class PHG4PhenixEventAction;
 class PHG4PhenixSteppingAction;
 class PHG4PhenixTrackingAction;
 class PHG4PrimaryGeneratorAction;
+class PHG4SubEventStore;
 class PHG4Subsystem;
 class PHG4UIsession;
 
@@ -45,6 +51,9 @@ class PHG4Reco : public SubsysReco
   //! full initialization
   int Init(PHCompositeNode *);
 
+  //! builds the field map of the macro settings, concurrently with the other modules
+  int InitRunIndependent(const int runnumber);
+
   int InitRun(PHCompositeNode *topNode);
 
   //! event processing method
@@ -53,6 +62,9 @@ class PHG4Reco : public SubsysReco
   //! Clean up after each event.
   int ResetEvent(PHCompositeNode *);
 
+  //! end of job, calls End of the subsystems
+  int End(PHCompositeNode *);
+
   //! print info
   void Print(const std::string &what = std::string()) const;
 
@@ -70,6 +82,9 @@ class PHG4Reco : public SubsysReco
 
   int InitField(PHCompositeNode *topNode);
 
+  //! field configuration of the macro settings, caller owns it
+  PHFieldConfig *MakeFieldConfig() const;
+
   //! set default magnetic field strength with a constant magnetic field. Only valid if set_field_map() is not used. If available, Field map setting on DST take higher priority.
   void set_field(const float tesla)
   {
@@ -98,6 +113,10 @@ class PHG4Reco : public SubsysReco
 
   //! Save geometry from Geant4 to DST
   void save_DST_geometry(bool b) { m_SaveDstGeometryFlag = b; }
+  //! keep the exported DST geometry in this directory, keyed by the hash of the world
+  //! and of the parameters of all subsystems. Later jobs with the same parameters
+  //! import it from there instead of writing the GDML of the constructed world again
+  void set_geometry_cache_dir(const std::string &dir) { m_GeometryCacheDir = dir; }
   void SetWorldSizeX(const double sx) { m_WorldSize[0] = sx; }
   void SetWorldSizeY(const double sy) { m_WorldSize[1] = sy; }
   void SetWorldSizeZ(const double sz) { m_WorldSize[2] = sz; }
@@ -107,6 +126,9 @@ class PHG4Reco : public SubsysReco
   void SetWorldShape(const std::string &s) { m_WorldShape = s; }
   void SetWorldMaterial(const std::string &s) { m_WorldMaterial = s; }
   void SetPhysicsList(const std::string &s) { m_PhysicsList = s; }
+  //! retrieve the Geant4 physics tables from this directory instead of building them,
+  //! keyed by the physics list configuration. Missing tables are stored there after the first event
+  void set_physics_table_cache_dir(const std::string &dir) { m_PhysicsTableCacheDir = dir; }
   void set_rapidity_coverage(const double eta);
 
   int setupInputEventNodeReader(PHCompositeNode *);
@@ -123,11 +145,44 @@ class PHG4Reco : public SubsysReco
   void setDisableUserActions(bool b = true) { m_disableUserActions = b; }
   void ApplyDisplayAction();
 
+  //! run Geant4 with n worker threads (needs a multithreaded Geant4 build).
+  //! The primaries of an event are simulated in chunks (sub events) as
+  //! separate G4Events on the workers. Only if all registered subsystems
+  //! support worker threads (PHG4Subsystem::SupportsWorkerThreads()),
+  //! otherwise G4 runs single threaded. The truth and the G4HIT_ containers
+  //! of the sub events are merged into the event (PHG4SubEventStore)
+  void set_nthreads(const int n) { m_NThreads = n; }
+
+  //! number of primaries per sub event with worker threads (default 100).
+  //! The chunks do not depend on the number of threads, so the merged
+  //! numbering of the output (PHG4SubEventMerger) does not either
+  void set_primaries_per_subevent(const int n) { m_PrimariesPerSubEvent = n; }
+
+  //! production range cut (cm) for gammas, electrons, positrons and protons in a region.
+  //! The region is created if it does not exist yet, its volumes are given by
+  //! add_region_volume() and add_region_subsystem()
+  void set_region_cuts(const std::string &region, const double range_cm) { m_RegionCuts[region] = range_cm; }
+  //! put a logical volume (by name) and its daughters into a region
+  void add_region_volume(const std::string &region, const std::string &volume) { m_RegionVolumes.insert(std::make_pair(region, volume)); }
+  //! put the volumes of a subsystem (by name) into a region
+  void add_region_subsystem(const std::string &region, const std::string &subsys) { m_RegionSubsystems[subsys] = region; }
+
+  //! kill every particle entering this logical volume (by name) or its daughters,
+  //! the kinetic energy is deposited where the particle enters
+  void add_kill_volume(const std::string &volume) { m_KillVolumes[volume] = -1; }
+  //! kill particles below this kinetic energy (GeV) in a logical volume (by name) and its daughters
+  void set_kill_threshold(const std::string &volume, const double ekin_gev) { m_KillVolumes[volume] = ekin_gev; }
+
+  //! add cerenkov and optical photon processes, on each thread after the physics is initialized
+  static void DefineOpticalProcesses();
+
  private:
   static void g4guithread(void *ptr);
   int InitUImanager();
   void DefineMaterials();
   void DefineRegions();
+  //! region cuts, region volumes and kill volumes, after the geometry is constructed
+  void ApplyRegionSettings();
 
   float m_MagneticField;
   float m_MagneticFieldRescale;
@@ -136,6 +191,9 @@ class PHG4Reco : public SubsysReco
   //! magnetic field
   G4TBMagneticFieldSetup *m_Field;
 
+  //! field map built in InitRunIndependent, handed to the node tree in InitField
+  PHField *m_PrebuiltField;
+
   //! pointer to geant run manager
   G4RunManager *m_RunManager;
 
@@ -179,6 +237,15 @@ class PHG4Reco : public SubsysReco
   std::string m_WorldMaterial;
   std::string m_PhysicsList;
 
+  //! production range cut (cm) by region
+  std::map<std::string, double> m_RegionCuts;
+  //! region -> logical volume names
+  std::multimap<std::string, std::string> m_RegionVolumes;
+  //! subsystem -> region
+  std::map<std::string, std::string> m_RegionSubsystems;
+  //! logical volume -> kinetic energy threshold (GeV), negative kills everything
+  std::map<std::string, double> m_KillVolumes;
+
   // settings for the external Pythia6 decayer
   bool m_ActiveDecayerFlag;     //< turn on/off decayer
   bool m_ActiveForceDecayFlag;  //< turn on/off force decay channels
@@ -186,6 +253,31 @@ class PHG4Reco : public SubsysReco
 
   bool m_SaveDstGeometryFlag;
   bool m_disableUserActions;
+
+  //! number of Geant4 worker threads, 1 runs the sequential G4RunManager
+  int m_NThreads;
+
+  //! chunk size of the primaries of an event with worker threads
+  int m_PrimariesPerSubEvent;
+
+  //! actions of the worker threads (owned by the G4MTRunManager)
+  PHG4ActionInitialization *m_ActionInitialization;
+
+  //! node trees of the sub events filled by the workers, merged after BeamOn
+  PHG4SubEventStore *m_SubEventStore;
+
+  //! field configuration (node tree) for the worker field maps
+  PHFieldConfig *m_WorkerFieldConfig;
+
+  //! cache file of the DST geometry, empty if not all subsystems provide a geometry hash
+  std::string GetGeometryCacheFile() const;
+  std::string m_GeometryCacheDir;
+
+  std::string GetPhysicsTableCacheDir() const;
+  void StorePhysicsTables();
+  std::string m_PhysicsTableCacheDir;
+  //! tables to be stored after the first event, empty if retrieved or stored already
+  std::string m_PhysicsTableStoreDir;
 };
 
 #endif
@@ -30,11 +30,15 @@
 #include <TDatabasePDG.h>
 #include <TH1.h>
 #include <TH3.h>           // for TH3, TH3D
+#include <THnSparse.h>
 #include <TNamed.h>        // for TNamed
 #include <TParticlePDG.h>  // for TParticlePDG
 #include <TVector3.h>
 
 #include <Geant4/G4RunManager.hh>
+#ifdef G4MULTITHREADED
+#include <Geant4/G4MTRunManager.hh>
+#endif
 #include <Geant4/G4ScoringManager.hh>
 #include <Geant4/G4String.hh>  // for G4String
 #include <Geant4/G4SystemOfUnits.hh>
@@ -58,9 +62,19 @@ using namespace std;
 
 PHG4ScoringManager::PHG4ScoringManager()
   : SubsysReco("PHG4ScoringManager")
+  , m_sparseOutput(false)
 {
 }
 
+int PHG4ScoringManager::Init(PHCompositeNode *topNode)
+{
+  // the multithreaded run manager hands the master scoring manager to the workers
+  // when they are started in its Initialize(), it has to exist by then
+  G4ScoringManager *scoringManager = G4ScoringManager::GetScoringManager();
+  assert(scoringManager);
+  return Fun4AllReturnCodes::EVENT_OK;
+}
+
 int PHG4ScoringManager::InitRun(PHCompositeNode *topNode)
 {
   //1. check G4RunManager
@@ -71,6 +85,13 @@ int PHG4ScoringManager::InitRun(PHCompositeNode *topNode)
     return Fun4AllReturnCodes::ABORTRUN;
   }
 
+#ifdef G4MULTITHREADED
+  if (Verbosity() >= VERBOSITY_SOME && dynamic_cast<G4MTRunManager *>(runManager))
+  {
+    cout << "PHG4ScoringManager::InitRun - scoring in the worker threads of the multithreaded run manager" << endl;
+  }
+#endif
+
   //2. Init scoring manager
   G4ScoringManager *scoringManager = G4ScoringManager::GetScoringManager();
   assert(scoringManager);
@@ -341,6 +362,34 @@ void PHG4ScoringManager::makeScoringHistograms()
              << " Saving to histogram " << hname << " : " << htitle
              << endl;
       }
+      // only the filled bins are in the score map, decode their index instead of looking up every bin
+      // idx = x * nMeshSegments[1] * nMeshSegments[2] + y * nMeshSegments[2] + z
+      if (m_sparseOutput)
+      {
+        double xmin[3] = {meshBoundMin[0], meshBoundMin[1], meshBoundMin[2]};
+        double xmax[3] = {meshBoundMax[0], meshBoundMax[1], meshBoundMax[2]};
+        THnSparse *h = new THnSparseD(hname.c_str(), htitle.c_str(), 3, nMeshSegments, xmin, xmax);
+        hm->registerHisto(h);
+        for (int i = 0; i < 3; ++i)
+        {
+          h->GetAxis(i)->SetTitle(divisionAxisNames[i].data());
+        }
+        for (auto value = score.begin(); value != score.end(); ++value)
+        {
+          int bin[3];
+          if (!decodeMeshIndex(value->first, nMeshSegments, bin))
+          {
+            continue;
+          }
+#if G4VERSION_NUMBER >= 1040
+          h->SetBinContent(bin, (value->second->mean()) / unitValue);
+#else
+          h->SetBinContent(bin, *(value->second) / unitValue);
+#endif
+        }
+        continue;
+      }
+
       //book histogram
       TH3 *h = new TH3D(hname.c_str(),   //
                         htitle.c_str(),  //
@@ -357,37 +406,38 @@ void PHG4ScoringManager::makeScoringHistograms()
       h->GetZaxis()->SetTitle(divisionAxisNames[2].data());
 
       // write quantity
-      for (int x = 0; x < nMeshSegments[0]; x++)
+      for (auto value = score.begin(); value != score.end(); ++value)
       {
-        for (int y = 0; y < nMeshSegments[1]; y++)
+        int bin[3];
+        if (!decodeMeshIndex(value->first, nMeshSegments, bin))
         {
-          for (int z = 0; z < nMeshSegments[2]; z++)
-          {
-            const int idx = x * nMeshSegments[1] * nMeshSegments[2] + y * nMeshSegments[2] + z;
-
-#if G4VERSION_NUMBER >= 1040
-            std::map<G4int, G4StatDouble *>::iterator value = score.find(idx);
-#else
-            std::map<G4int, G4double *>::iterator value = score.find(idx);
-#endif
-            if (value != score.end())
-            {
+          continue;
+        }
 #if G4VERSION_NUMBER >= 1040
-              h->SetBinContent(x + 1, y + 1, z + 1, (value->second->mean()) / unitValue);
+        h->SetBinContent(bin[0], bin[1], bin[2], (value->second->mean()) / unitValue);
 #else
-              h->SetBinContent(x + 1, y + 1, z + 1, *(value->second) / unitValue);
+        h->SetBinContent(bin[0], bin[1], bin[2], *(value->second) / unitValue);
 #endif
-            }
-
-          }  //           for (int z = 0; z < fNMeshSegments[2]; z++)
-        }
-      }  //       for (int x = 0; x < nMeshSegments[0]; x++)
+      }
 
     }  //     for (; msMapItr != fSMap.end(); msMapItr++)
 
   }  //   for (int imesh = 0; imesh < scoringManager->GetNumberOfMesh(); ++imesh)
 }
 
+bool PHG4ScoringManager::decodeMeshIndex(const int idx, const int nMeshSegments[3], int bin[3])
+{
+  if (idx < 0 || idx >= nMeshSegments[0] * nMeshSegments[1] * nMeshSegments[2])
+  {
+    return false;
+  }
+  // histogram bins start at 1
+  bin[0] = idx / (nMeshSegments[1] * nMeshSegments[2]) + 1;
+  bin[1] = (idx / nMeshSegments[2]) % nMeshSegments[1] + 1;
+  bin[2] = idx % nMeshSegments[2] + 1;
+  return true;
+}
+
 Fun4AllHistoManager *
 PHG4ScoringManager::getHistoManager()
 {
@@ -35,6 +35,9 @@ class PHG4ScoringManager : public SubsysReco
 
   virtual ~PHG4ScoringManager() {}
 
+  //! instantiate G4ScoringManager before the Geant4 worker threads are started
+  int Init(PHCompositeNode *topNode);
+
   //! full initialization
   int InitRun(PHCompositeNode *topNode);
 
@@ -47,6 +50,9 @@ class PHG4ScoringManager : public SubsysReco
   //! Output result to a ROOT file with this name
   void setOutputFileName(const std::string &outputfilename) { m_outputFileName = outputfilename; };
 
+  //! save the meshes as THnSparseD instead of TH3D, for large meshes which are mostly empty
+  void setSparseOutput(const bool b) { m_sparseOutput = b; }
+
   //! \brief Run this Geant4 command after initialization of G4ScoringManager in the InitRun() stage
   //! You can call this command multiple times to stage multiple commands to run
   /*!
@@ -62,16 +68,25 @@ class PHG4ScoringManager : public SubsysReco
       g4score->G4Command("/score/close");
 
       \endcode
+   *
+   *  With PHG4Reco::set_nthreads() every Geant4 worker thread scores into its own copy
+   *  of the meshes, Geant4 merges them into the master meshes at the end of each event.
+   *  This module has to be registered after PHG4Reco so its Init() runs before the
+   *  worker threads are started.
    */
   void G4Command(const std::string &cmd);
 
  private:
   Fun4AllHistoManager *getHistoManager();
   void makeScoringHistograms();
+  //! bins (starting at 1) of the G4THitsMap index of a mesh cell, false if out of range
+  static bool decodeMeshIndex(const int idx, const int nMeshSegments[3], int bin[3]);
 
   std::vector<std::string> m_commands;
 
   std::string m_outputFileName;
+
+  bool m_sparseOutput;
 };
 
 #endif /* PHG4SCORINGMANAGER_H_ */
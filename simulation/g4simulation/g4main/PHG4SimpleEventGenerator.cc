@@ -239,7 +239,7 @@ int PHG4SimpleEventGenerator::InitRun(PHCompositeNode *topNode) {
   return Fun4AllReturnCodes::EVENT_OK;
 }
 
-int PHG4SimpleEventGenerator::process_event(PHCompositeNode *topNode) {
+int PHG4SimpleEventGenerator::GenerateEvent(PHCompositeNode *topNode, const unsigned int ibatch) {
 
   if (Verbosity() > 0) {
     cout << "====================== PHG4SimpleEventGenerator::process_event() =====================" << endl;
@@ -267,8 +267,13 @@ int PHG4SimpleEventGenerator::process_event(PHCompositeNode *topNode) {
       <<endl;
   }
 
+  // the logical events of a batch are separated in time and continue the track ids
+  const double t = _t0 + ibatch * batch_spacing;
   int vtxindex = -1;
   int trackid = -1;
+  for (unsigned int i=0; i<_particle_names.size(); ++i) {
+    trackid += ibatch * _particle_names[i].second;
+  }
   for (unsigned int i=0; i<_particle_names.size(); ++i) {
 
     string pdgname = _particle_names[i].first;
@@ -289,9 +294,9 @@ int PHG4SimpleEventGenerator::process_event(PHCompositeNode *topNode) {
         y *= r;
         z *= r;
 
-	vtxindex = _ineve->AddVtx(vtx_x+x,vtx_y+y,vtx_z+z,_t0);
+	vtxindex = _ineve->AddVtx(vtx_x+x,vtx_y+y,vtx_z+z,t);
       } else if ((i==0)&&(j==0)) {
-	vtxindex = _ineve->AddVtx(vtx_x,vtx_y,vtx_z,_t0);
+	vtxindex = _ineve->AddVtx(vtx_x,vtx_y,vtx_z,t);
       }
 
       ++trackid;
@@ -331,7 +336,7 @@ int PHG4SimpleEventGenerator::process_event(PHCompositeNode *topNode) {
     }
   }
 
-  if (Verbosity() > 0) {
+  if (Verbosity() > 0 && ibatch+1 == batch_size) {
     _ineve->identify();
     cout << "======================================================================================" << endl;
   } 
@@ -23,7 +23,6 @@ public:
   virtual ~PHG4SimpleEventGenerator(){}
 
   int InitRun(PHCompositeNode *topNode);
-  int process_event(PHCompositeNode *topNode);
 
   //! interface for adding particles by name
   void add_particles(const std::string &name, const unsigned int count);
@@ -66,6 +65,10 @@ public:
   //! set the dimensions of the distribution of particles about the vertex
   void set_vertex_size_parameters(const double mean, const double width);
 
+protected:
+
+  int GenerateEvent(PHCompositeNode *topNode, const unsigned int ibatch);
+
 private:
 
   double smearvtx(const double position, const double width, FUNCTION dist) const;
@@ -7,6 +7,7 @@
 #include <string>
 
 class G4Step;
+class G4VPhysicalVolume;
 class PHCompositeNode;
 class PHG4Hit;
 
@@ -26,6 +27,16 @@ class PHG4SteppingAction
   */
   virtual bool UserSteppingAction(const G4Step* step, bool was_used) = 0;
 
+  //! true if steps starting in this volume may concern this stepping action
+  /*!
+  PHG4PhenixSteppingAction asks this once per volume and afterwards calls
+  UserSteppingAction only for the steps in volumes it returned true for.
+  Only override it if UserSteppingAction returns false without doing anything
+  else for steps whose pre step point is outside of the returned volumes
+  \param volume pre step point volume
+  */
+  virtual bool HandlesVolume(G4VPhysicalVolume* volume) { return true; }
+
   virtual void Verbosity(const int i) { m_Verbosity = i; }
   virtual int Verbosity() const { return m_Verbosity; }
   virtual int Init() { return 0; }
@@ -0,0 +1,158 @@
+#include "PHG4SubEventMerger.h"
+
+#include "PHG4Hit.h"
+#include "PHG4HitContainer.h"
+#include "PHG4Particle.h"
+#include "PHG4Shower.h"
+#include "PHG4TruthInfoContainer.h"
+#include "PHG4VtxPoint.h"
+
+#include <climits>  // for INT_MIN
+#include <set>
+#include <utility>  // for pair, make_pair
+#include <vector>
+
+using namespace std;
+
+PHG4SubEventMerger::PHG4SubEventMerger(PHG4TruthInfoContainer *truth)
+  : m_Truth(truth)
+  , m_SubEventOpen(false)
+  , m_PrimaryOffset(0)
+  , m_SecondaryOffset(0)
+{
+  // vertices of the event which were there before the first sub event
+  PHG4TruthInfoContainer::ConstVtxRange range = m_Truth->GetVtxRange();
+  for (PHG4TruthInfoContainer::ConstVtxIterator iter = range.first; iter != range.second; ++iter)
+  {
+    const PHG4VtxPoint *vtx = iter->second;
+    m_VertexIds.insert(make_pair(make_tuple(vtx->get_x(), vtx->get_y(), vtx->get_z()), iter->first));
+  }
+}
+
+void PHG4SubEventMerger::BeginSubEvent()
+{
+  if (m_SubEventOpen) return;
+  m_PrimaryOffset = m_Truth->maxtrkindex();
+  m_SecondaryOffset = m_Truth->mintrkindex();
+  m_SubEventOpen = true;
+}
+
+int PHG4SubEventMerger::TrackId(const int subid) const
+{
+  if (subid > 0) return subid + m_PrimaryOffset;
+  if (subid < 0) return subid + m_SecondaryOffset;
+  return 0;
+}
+
+void PHG4SubEventMerger::MergeHits(PHG4HitContainer *hits, PHG4HitContainer *subhits)
+{
+  BeginSubEvent();
+  map<PHG4HitDefs::keytype, PHG4HitDefs::keytype> &keys = m_HitKeys[hits->GetID()];
+
+  // in key order, the hits of a layer keep their order behind the hits already there
+  for (PHG4HitContainer::Iterator iter = subhits->hitmap.begin(); iter != subhits->hitmap.end(); ++iter)
+  {
+    PHG4Hit *hit = iter->second;
+    const unsigned int layer = PHG4HitDefs::get_detid(iter->first);
+    const PHG4HitDefs::keytype key = hits->genkey(layer);
+    hit->set_hit_id(key);
+    if (hit->get_trkid() != INT_MIN) hit->set_trkid(TrackId(hit->get_trkid()));
+    if (hit->get_shower_id() != INT_MIN) hit->set_shower_id(TrackId(hit->get_shower_id()));
+    hits->hitmap[key] = hit;
+    hits->layers.insert(layer);
+    keys.insert(make_pair(iter->first, key));
+  }
+  subhits->hitmap.clear();
+  hits->m_TimeIndexValid = false;
+  subhits->m_TimeIndexValid = false;
+}
+
+void PHG4SubEventMerger::MergeTruth(PHG4TruthInfoContainer *subtruth)
+{
+  BeginSubEvent();
+
+  // vertices in the order they were created: primaries 1, 2, ... and secondaries -1, -2, ...
+  map<int, int> vtxids;
+  vector<pair<int, PHG4VtxPoint *> > vertices(subtruth->vtxmap.upper_bound(0), subtruth->vtxmap.end());
+  vertices.insert(vertices.end(), PHG4TruthInfoContainer::VtxMap::reverse_iterator(subtruth->vtxmap.upper_bound(-1)), subtruth->vtxmap.rend());
+  for (const pair<int, PHG4VtxPoint *> &subvtx : vertices)
+  {
+    const int subid = subvtx.first;
+    PHG4VtxPoint *vtx = subvtx.second;
+    pair<map<tuple<double, double, double>, int>::iterator, bool> inserted =
+        m_VertexIds.insert(make_pair(make_tuple(vtx->get_x(), vtx->get_y(), vtx->get_z()), 0));
+    if (!inserted.second)
+    {
+      // same position as a vertex of an earlier sub event
+      vtxids[subid] = inserted.first->second;
+      delete vtx;
+      continue;
+    }
+    const int vtxid = (subid > 0) ? m_Truth->maxvtxindex() + 1 : m_Truth->minvtxindex() - 1;
+    inserted.first->second = vtxid;
+    vtxids[subid] = vtxid;
+    vtx->set_id(vtxid);
+    m_Truth->vtxmap.insert(make_pair(vtxid, vtx));
+  }
+  subtruth->vtxmap.clear();
+
+  for (PHG4TruthInfoContainer::Iterator iter = subtruth->particlemap.begin(); iter != subtruth->particlemap.end(); ++iter)
+  {
+    PHG4Particle *particle = iter->second;
+    const int trackid = TrackId(iter->first);
+    particle->set_track_id(trackid);
+    particle->set_parent_id(TrackId(particle->get_parent_id()));
+    particle->set_primary_id(TrackId(particle->get_primary_id()));
+    particle->set_vtx_id(vtxids[particle->get_vtx_id()]);
+    m_Truth->particlemap.insert(make_pair(trackid, particle));
+  }
+  subtruth->particlemap.clear();
+
+  for (PHG4TruthInfoContainer::ShowerIterator iter = subtruth->showermap.begin(); iter != subtruth->showermap.end(); ++iter)
+  {
+    PHG4Shower *shower = iter->second;
+    const int showerid = TrackId(iter->first);
+    shower->set_id(showerid);
+    shower->set_parent_particle_id(TrackId(shower->get_parent_particle_id()));
+    shower->set_parent_shower_id(TrackId(shower->get_parent_shower_id()));
+
+    const set<int> particleids(shower->begin_g4particle_id(), shower->end_g4particle_id());
+    shower->clear_g4particle_id();
+    for (const int id : particleids) shower->add_g4particle_id(TrackId(id));
+
+    const set<int> vertexids(shower->begin_g4vertex_id(), shower->end_g4vertex_id());
+    shower->clear_g4vertex_id();
+    for (const int id : vertexids) shower->add_g4vertex_id(vtxids[id]);
+
+    // hits which were not merged (volume not merged, zero energy hits removed) are dropped
+    const PHG4Shower::HitIdMap hitids(shower->begin_g4hit_id(), shower->end_g4hit_id());
+    shower->clear_g4hit_id();
+    for (PHG4Shower::HitIdConstIter hiter = hitids.begin(); hiter != hitids.end(); ++hiter)
+    {
+      map<int, map<PHG4HitDefs::keytype, PHG4HitDefs::keytype> >::const_iterator keys = m_HitKeys.find(hiter->first);
+      if (keys == m_HitKeys.end()) continue;
+      for (const PHG4HitDefs::keytype key : hiter->second)
+      {
+        map<PHG4HitDefs::keytype, PHG4HitDefs::keytype>::const_iterator kiter = keys->second.find(key);
+        if (kiter != keys->second.end()) shower->add_g4hit_id(hiter->first, kiter->second);
+      }
+    }
+    m_Truth->showermap.insert(make_pair(showerid, shower));
+  }
+  subtruth->showermap.clear();
+
+  for (map<int, int>::const_iterator iter = subtruth->particle_embed_flags.begin(); iter != subtruth->particle_embed_flags.end(); ++iter)
+  {
+    m_Truth->particle_embed_flags[TrackId(iter->first)] = iter->second;
+  }
+  subtruth->particle_embed_flags.clear();
+  for (map<int, int>::const_iterator iter = subtruth->vertex_embed_flags.begin(); iter != subtruth->vertex_embed_flags.end(); ++iter)
+  {
+    m_Truth->vertex_embed_flags[vtxids[iter->first]] = iter->second;
+  }
+  subtruth->vertex_embed_flags.clear();
+
+  // next sub event
+  m_HitKeys.clear();
+  m_SubEventOpen = false;
+}
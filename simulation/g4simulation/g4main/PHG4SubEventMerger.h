@@ -0,0 +1,70 @@
+// Tell emacs that this is a C++ source
+//  -*- C++ -*-.
+#ifndef G4MAIN_PHG4SUBEVENTMERGER_H
+#define G4MAIN_PHG4SUBEVENTMERGER_H
+
+#include "PHG4HitDefs.h"
+
+#include <map>
+#include <tuple>
+
+class PHG4HitContainer;
+class PHG4TruthInfoContainer;
+
+/*!
+ * \brief merges the output of sub events into the containers of the event
+ *
+ * With PHG4Reco::set_primaries_per_subevent the primaries of one event are
+ * simulated in chunks, each chunk is a G4Event of its own with its own hit
+ * and truth containers (the node trees of PHG4SubEventStore, filled by the
+ * worker actions of the subsystems, which PHG4Reco merges with this class
+ * after BeamOn). For each sub event, in the order of the sub events
+ * (not the order in which the workers finished), call MergeHits for every
+ * hit container and then MergeTruth. The result is numbered as if the sub
+ * events had been simulated one after the other into the same containers:
+ * - primary track ids continue after the highest id of the event,
+ *   secondary ones below the lowest, 0 stays 0 (showers follow their track)
+ * - vertices at the same position are one vertex, new ones get the next
+ *   primary/secondary vertex id
+ * - hits are appended to their layer and get the next key of the layer
+ * The hits, particles, vertices and showers are moved, the sub event
+ * containers are empty afterwards. Use one merger per event.
+ */
+class PHG4SubEventMerger
+{
+ public:
+  //! merge into the truth container of the event
+  explicit PHG4SubEventMerger(PHG4TruthInfoContainer *truth);
+  virtual ~PHG4SubEventMerger() {}
+
+  //! move the hits of the current sub event to hits, with the track and
+  //! shower ids this sub event will get in the truth container
+  void MergeHits(PHG4HitContainer *hits, PHG4HitContainer *subhits);
+
+  //! move the truth of the current sub event, afterwards the next sub event
+  //! can be merged. The hit ids of the showers refer to the merged hits,
+  //! so MergeHits must be called first for all hit containers of this sub event
+  void MergeTruth(PHG4TruthInfoContainer *subtruth);
+
+ private:
+  //! take the id offsets for the current sub event, if not done yet
+  void BeginSubEvent();
+
+  //! track (and shower) id in the event of a track id in the sub event
+  int TrackId(const int subid) const;
+
+  PHG4TruthInfoContainer *m_Truth;
+
+  //! offsets for the track ids of the current sub event
+  bool m_SubEventOpen;
+  int m_PrimaryOffset;
+  int m_SecondaryOffset;
+
+  //! volume id => (hit key in the sub event => key in the event)
+  std::map<int, std::map<PHG4HitDefs::keytype, PHG4HitDefs::keytype> > m_HitKeys;
+
+  //! vertex ids of the event by position
+  std::map<std::tuple<double, double, double>, int> m_VertexIds;
+};
+
+#endif
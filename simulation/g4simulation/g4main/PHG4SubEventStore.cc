@@ -0,0 +1,133 @@
+#include "PHG4SubEventStore.h"
+
+#include "PHG4HitContainer.h"
+#include "PHG4SubEventMerger.h"
+#include "PHG4TruthInfoContainer.h"
+
+#include <fun4all/Fun4AllReturnCodes.h>
+
+#include <phool/PHCompositeNode.h>
+#include <phool/PHIODataNode.h>
+#include <phool/PHNode.h>
+#include <phool/PHNodeIterator.h>
+#include <phool/PHObject.h>
+#include <phool/PHPointerListIterator.h>
+#include <phool/getClass.h>
+#include <phool/phool.h>
+
+#include <iostream>
+
+using namespace std;
+
+namespace
+{
+  //! all G4HIT_ containers below a node
+  void FindHitNodes(PHCompositeNode *top, vector<pair<string, set<unsigned int> > > &hitnodes)
+  {
+    PHNodeIterator nodeiter(top);
+    PHPointerListIterator<PHNode> iter(nodeiter.ls());
+    PHNode *thisNode;
+    while ((thisNode = iter()))
+    {
+      if (thisNode->getType() == "PHCompositeNode")
+      {
+        FindHitNodes(static_cast<PHCompositeNode *>(thisNode), hitnodes);
+      }
+      else if (thisNode->getType() == "PHIODataNode" && thisNode->getName().find("G4HIT_") == 0)
+      {
+        PHG4HitContainer *hits = dynamic_cast<PHG4HitContainer *>(static_cast<PHIODataNode<PHObject> *>(thisNode)->getData());
+        if (hits)
+        {
+          pair<PHG4HitContainer::LayerIter, PHG4HitContainer::LayerIter> layers = hits->getLayers();
+          hitnodes.push_back(make_pair(thisNode->getName(), set<unsigned int>(layers.first, layers.second)));
+        }
+      }
+    }
+  }
+}  // namespace
+
+PHG4SubEventStore::~PHG4SubEventStore()
+{
+  Clear();
+}
+
+void PHG4SubEventStore::Configure(PHCompositeNode *topNode)
+{
+  lock_guard<mutex> lock(m_Mutex);
+  m_HitNodes.clear();
+  PHNodeIterator iter(topNode);
+  PHCompositeNode *dstNode = dynamic_cast<PHCompositeNode *>(iter.findFirst("PHCompositeNode", "DST"));
+  if (dstNode)
+  {
+    FindHitNodes(dstNode, m_HitNodes);
+  }
+}
+
+PHCompositeNode *PHG4SubEventStore::GetSubEvent(const int subevent)
+{
+  lock_guard<mutex> lock(m_Mutex);
+  map<int, PHCompositeNode *>::const_iterator iter = m_SubEvents.find(subevent);
+  if (iter != m_SubEvents.end())
+  {
+    return iter->second;
+  }
+  PHCompositeNode *topNode = new PHCompositeNode("TOP");
+  PHCompositeNode *dstNode = new PHCompositeNode("DST");
+  topNode->addNode(dstNode);
+  dstNode->addNode(new PHIODataNode<PHObject>(new PHG4TruthInfoContainer(), "G4TruthInfo", "PHObject"));
+  for (const pair<string, set<unsigned int> > &hitnode : m_HitNodes)
+  {
+    PHG4HitContainer *hits = new PHG4HitContainer(hitnode.first);
+    for (const unsigned int layer : hitnode.second)
+    {
+      hits->AddLayer(layer);
+    }
+    dstNode->addNode(new PHIODataNode<PHObject>(hits, hitnode.first, "PHObject"));
+  }
+  m_SubEvents[subevent] = topNode;
+  return topNode;
+}
+
+int PHG4SubEventStore::Merge(PHCompositeNode *topNode)
+{
+  if (m_SubEvents.empty())
+  {
+    // no worker actions (PHG4Reco::setDisableUserActions)
+    return Fun4AllReturnCodes::EVENT_OK;
+  }
+  PHG4TruthInfoContainer *truth = findNode::getClass<PHG4TruthInfoContainer>(topNode, "G4TruthInfo");
+  if (!truth)
+  {
+    cout << PHWHERE << " G4TruthInfo node missing, cannot merge the sub events" << endl;
+    Clear();
+    return Fun4AllReturnCodes::ABORTEVENT;
+  }
+  // the workers are done, the map is ordered by sub event id
+  PHG4SubEventMerger merger(truth);
+  for (map<int, PHCompositeNode *>::const_iterator iter = m_SubEvents.begin(); iter != m_SubEvents.end(); ++iter)
+  {
+    for (const pair<string, set<unsigned int> > &hitnode : m_HitNodes)
+    {
+      PHG4HitContainer *hits = findNode::getClass<PHG4HitContainer>(topNode, hitnode.first);
+      PHG4HitContainer *subhits = findNode::getClass<PHG4HitContainer>(iter->second, hitnode.first);
+      if (hits && subhits)
+      {
+        merger.MergeHits(hits, subhits);
+      }
+    }
+    merger.MergeTruth(findNode::getClass<PHG4TruthInfoContainer>(iter->second, "G4TruthInfo"));
+  }
+  Clear();
+  return Fun4AllReturnCodes::EVENT_OK;
+}
+
+void PHG4SubEventStore::Clear()
+{
+  lock_guard<mutex> lock(m_Mutex);
+  for (map<int, PHCompositeNode *>::const_iterator iter = m_SubEvents.begin(); iter != m_SubEvents.end(); ++iter)
+  {
+    // deletes the containers with their remaining content
+    delete iter->second;
+  }
+  m_SubEvents.clear();
+}
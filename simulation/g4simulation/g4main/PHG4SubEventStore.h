@@ -0,0 +1,52 @@
+// Tell emacs that this is a C++ source
+//  -*- C++ -*-.
+#ifndef G4MAIN_PHG4SUBEVENTSTORE_H
+#define G4MAIN_PHG4SUBEVENTSTORE_H
+
+#include <map>
+#include <mutex>
+#include <set>
+#include <string>
+#include <utility>
+#include <vector>
+
+class PHCompositeNode;
+
+/*!
+ * \brief node trees of the sub events simulated by the Geant4 worker threads
+ *
+ * Every sub event (G4Event) gets a small node tree of its own with a
+ * G4TruthInfo container and a copy (same name, id and layers) of every
+ * G4HIT_ container of the event. The worker actions are pointed to it with
+ * SetInterfacePointers at the start of the sub event, so the actions which
+ * fill the node tree of the event in sequential mode fill the sub event.
+ * After BeamOn the sub events are merged in event id order into the event
+ * with PHG4SubEventMerger.
+ */
+class PHG4SubEventStore
+{
+ public:
+  PHG4SubEventStore() {}
+  virtual ~PHG4SubEventStore();
+
+  //! take the hit containers the sub events get from the node tree of the
+  //! event, after the subsystems created their nodes
+  void Configure(PHCompositeNode *topNode);
+
+  //! top node of a sub event, created on first use. Called by the workers
+  PHCompositeNode *GetSubEvent(const int subevent);
+
+  //! move the truth and hits of all sub events into the event, the sub events are deleted
+  int Merge(PHCompositeNode *topNode);
+
+ private:
+  void Clear();
+
+  //! names and layers of the G4HIT_ containers
+  std::vector<std::pair<std::string, std::set<unsigned int> > > m_HitNodes;
+
+  std::mutex m_Mutex;
+  std::map<int, PHCompositeNode *> m_SubEvents;
+};
+
+#endif
@@ -6,6 +6,7 @@
 #include <fun4all/Fun4AllReturnCodes.h>
 #include <fun4all/SubsysReco.h>
 
+#include <cstddef>  // for size_t
 #include <iostream>
 #include <string>
 
@@ -68,6 +69,30 @@ class PHG4Subsystem : public SubsysReco
     return nullptr;
   }
 
+  //! true if the subsystem can run with Geant4 worker threads. Its actions
+  //! for the workers then come from the CreateWorker... methods
+  virtual bool SupportsWorkerThreads() const { return false; }
+
+  //! new event/stepping/tracking action for one worker thread, called on
+  //! that thread in this order. At the start of every sub event the actions
+  //! get ResetEvent and SetInterfacePointers with the node tree of the sub
+  //! event (G4TruthInfo and the G4HIT_ containers), which PHG4Reco merges
+  virtual PHG4EventAction *CreateWorkerEventAction() { return nullptr; }
+  virtual PHG4SteppingAction *CreateWorkerSteppingAction() { return nullptr; }
+  virtual PHG4TrackingAction *CreateWorkerTrackingAction() { return nullptr; }
+
+  //! move other output of the worker threads to the node tree, called after each
+  //! event once the sub event trees are merged. The G4Events are sub events of one
+  //! event, merge them in the order of their event ids
+  virtual int MergeWorkerOutput(PHCompositeNode *)
+  {
+    return Fun4AllReturnCodes::EVENT_OK;
+  }
+
+  //! hash of everything which determines the geometry of this subsystem,
+  //! 0 if that is not known (then PHG4Reco does not use its geometry cache)
+  virtual size_t GetGeometryHash() const { return 0; }
+
   void OverlapCheck(const bool chk = true) { overlapcheck = chk; }
 
   bool CheckOverlap() const { return overlapcheck; }
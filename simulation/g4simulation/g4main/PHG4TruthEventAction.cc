@@ -7,6 +7,7 @@
 #include "PHG4Shower.h"
 #include "PHG4TruthInfoContainer.h"
 #include "PHG4UserPrimaryParticleInformation.h"
+#include "PHG4VtxPointv1.h"
 
 #include <phool/PHCompositeNode.h>
 #include <phool/PHIODataNode.h>  // for PHIODataNode
@@ -41,6 +42,8 @@ PHG4TruthEventAction::PHG4TruthEventAction()
   : m_TruthInfoContainer(nullptr)
   , m_LowerKeyPrevExist(0)
   , m_UpperKeyPrevExist(0)
+  , m_MaxPendingVtxId(0)
+  , m_MinPendingVtxId(0)
 {
 }
 
@@ -71,6 +74,7 @@ void PHG4TruthEventAction::EndOfEventAction(const G4Event* evt)
     std::cout << "PHG4TruthEventAction::EndOfEventAction - unable to find G4TruthInfo node" << std::endl;
     return;
   }
+  FlushVertices();
   // First deal with the showers - they do need the info which
   // is removed from the maps in the subsequent cleanup to reduce the
   // output file size
@@ -220,6 +224,37 @@ void PHG4TruthEventAction::AddTrackidToWritelist(const int trackid)
   m_WriteSet.insert(trackid);
 }
 
+//___________________________________________________
+int PHG4TruthEventAction::AddVertex(const bool primary, const double x, const double y, const double z, const double t)
+{
+  // continue the numbering of vertices already in the container (previous geant passes)
+  if (m_PendingVertices.empty())
+  {
+    m_MaxPendingVtxId = m_TruthInfoContainer->maxvtxindex();
+    m_MinPendingVtxId = m_TruthInfoContainer->minvtxindex();
+  }
+  PendingVertex vtx;
+  vtx.id = (primary ? ++m_MaxPendingVtxId : --m_MinPendingVtxId);
+  vtx.x = x;
+  vtx.y = y;
+  vtx.z = z;
+  vtx.t = t;
+  m_PendingVertices.push_back(vtx);
+  return vtx.id;
+}
+
+//___________________________________________________
+void PHG4TruthEventAction::FlushVertices()
+{
+  for (std::vector<PendingVertex>::const_iterator iter = m_PendingVertices.begin();
+       iter != m_PendingVertices.end();
+       ++iter)
+  {
+    m_TruthInfoContainer->AddVertex(iter->id, new PHG4VtxPointv1(iter->x, iter->y, iter->z, iter->t));
+  }
+  m_PendingVertices.clear();
+}
+
 //___________________________________________________
 void PHG4TruthEventAction::SetInterfacePointers(PHCompositeNode* topNode)
 {
@@ -271,6 +306,7 @@ void PHG4TruthEventAction::SearchNode(PHCompositeNode* top)
 int PHG4TruthEventAction::ResetEvent(PHCompositeNode*)
 {
   m_WriteSet.clear();
+  m_PendingVertices.clear();
   return 0;
 }
 
@@ -7,6 +7,7 @@
 
 #include <map>
 #include <set>
+#include <vector>
 
 class G4Event;
 class PHG4HitContainer;
@@ -34,7 +35,25 @@ class PHG4TruthEventAction : public PHG4EventAction
   //! add id into track list
   void AddTrackidToWritelist(const int trackid);
 
+  //! book a new vertex and return its id (positive for primaries, negative for secondaries),
+  //! the PHG4VtxPoints of the event are created together in EndOfEventAction
+  int AddVertex(const bool primary, const double x, const double y, const double z, const double t);
+
+  //! g4hit containers of this event by their id
+  const std::map<int, PHG4HitContainer*>& GetHitContainerMap() const { return m_HitContainerMap; }
+
  private:
+  struct PendingVertex
+  {
+    int id;
+    double x;
+    double y;
+    double z;
+    double t;
+  };
+
+  //! create the booked vertices and add them to the truth container
+  void FlushVertices();
   void SearchNode(PHCompositeNode* topNode);
   void PruneShowers();
   void ProcessShowers();
@@ -42,6 +61,11 @@ class PHG4TruthEventAction : public PHG4EventAction
   //! set of track ids to be written out
   std::set<int> m_WriteSet;
 
+  //! vertices booked during this event, reused between events
+  std::vector<PendingVertex> m_PendingVertices;
+  int m_MaxPendingVtxId;
+  int m_MinPendingVtxId;
+
   //! pointer to truth information container
   PHG4TruthInfoContainer* m_TruthInfoContainer;
 
@@ -0,0 +1,169 @@
+#include "PHG4TruthInfoCompact.h"
+
+#include "PHG4Particle.h"
+#include "PHG4TruthInfoContainer.h"
+#include "PHG4VtxPoint.h"
+
+#include <algorithm>  // for lower_bound
+#include <set>
+#include <utility>  // for pair
+
+using namespace std;
+
+void PHG4TruthInfoCompact::Reset()
+{
+  m_TrackId.clear();
+  m_ParentIndex.clear();
+  m_VtxIndex.clear();
+  m_Pid.clear();
+  m_Px.clear();
+  m_Py.clear();
+  m_Pz.clear();
+  m_E.clear();
+  m_Edep.clear();
+  m_Embed.clear();
+
+  m_VtxId.clear();
+  m_VtxX.clear();
+  m_VtxY.clear();
+  m_VtxZ.clear();
+  m_VtxT.clear();
+  m_VtxEmbed.clear();
+  return;
+}
+
+void PHG4TruthInfoCompact::identify(ostream &os) const
+{
+  os << "PHG4TruthInfoCompact: " << size() << " particles, "
+     << vtx_size() << " vertices" << endl;
+  for (unsigned int i = 0; i < size(); ++i)
+  {
+    os << "track id " << m_TrackId[i]
+       << ", parent index " << m_ParentIndex[i]
+       << ", vtx index " << m_VtxIndex[i]
+       << ", pid " << m_Pid[i]
+       << ", p (" << m_Px[i] << ", " << m_Py[i] << ", " << m_Pz[i] << ")"
+       << ", e " << m_E[i]
+       << ", edep " << m_Edep[i]
+       << ", embed " << m_Embed[i] << endl;
+  }
+  for (unsigned int i = 0; i < vtx_size(); ++i)
+  {
+    os << "vtx id " << m_VtxId[i]
+       << ", (" << m_VtxX[i] << ", " << m_VtxY[i] << ", " << m_VtxZ[i] << ")"
+       << ", t " << m_VtxT[i]
+       << ", embed " << m_VtxEmbed[i] << endl;
+  }
+  return;
+}
+
+void PHG4TruthInfoCompact::Fill(const PHG4TruthInfoContainer *truth, const map<int, double> &trackedep, const double threshold)
+{
+  Reset();
+  const PHG4TruthInfoContainer::Map &particlemap = truth->GetMap();
+
+  // primaries and tracks above threshold, plus everything up their parent chain
+  set<int> keep;
+  for (PHG4TruthInfoContainer::ConstIterator iter = particlemap.begin(); iter != particlemap.end(); ++iter)
+  {
+    if (iter->second->get_parent_id() != 0)
+    {
+      map<int, double>::const_iterator edepiter = trackedep.find(iter->first);
+      if (edepiter == trackedep.end() || edepiter->second <= threshold)
+      {
+        continue;
+      }
+    }
+    int trackid = iter->first;
+    while (trackid != 0 && keep.insert(trackid).second)
+    {
+      PHG4TruthInfoContainer::ConstIterator parent = particlemap.find(trackid);
+      if (parent == particlemap.end())
+      {
+        break;
+      }
+      trackid = parent->second->get_parent_id();
+    }
+  }
+
+  // the map is ordered by track id, so are the arrays
+  set<int> keepvtx;
+  m_TrackId.reserve(keep.size());
+  for (set<int>::const_iterator iter = keep.begin(); iter != keep.end(); ++iter)
+  {
+    PHG4TruthInfoContainer::ConstIterator piter = particlemap.find(*iter);
+    if (piter == particlemap.end())
+    {
+      // parent which was already removed from the full record
+      continue;
+    }
+    const PHG4Particle *particle = piter->second;
+    m_TrackId.push_back(*iter);
+    m_Pid.push_back(particle->get_pid());
+    m_Px.push_back(particle->get_px());
+    m_Py.push_back(particle->get_py());
+    m_Pz.push_back(particle->get_pz());
+    m_E.push_back(particle->get_e());
+    map<int, double>::const_iterator edepiter = trackedep.find(*iter);
+    m_Edep.push_back(edepiter == trackedep.end() ? 0. : edepiter->second);
+    m_Embed.push_back(truth->isEmbeded(*iter));
+    keepvtx.insert(particle->get_vtx_id());
+  }
+
+  const PHG4TruthInfoContainer::VtxMap &vtxmap = truth->GetVtxMap();
+  for (set<int>::const_iterator iter = keepvtx.begin(); iter != keepvtx.end(); ++iter)
+  {
+    PHG4TruthInfoContainer::ConstVtxIterator viter = vtxmap.find(*iter);
+    if (viter == vtxmap.end())
+    {
+      continue;
+    }
+    m_VtxId.push_back(*iter);
+    m_VtxX.push_back(viter->second->get_x());
+    m_VtxY.push_back(viter->second->get_y());
+    m_VtxZ.push_back(viter->second->get_z());
+    m_VtxT.push_back(viter->second->get_t());
+    m_VtxEmbed.push_back(truth->isEmbededVtx(*iter));
+  }
+
+  // translate parent and vertex ids into indices now that the arrays are complete
+  m_ParentIndex.resize(m_TrackId.size());
+  m_VtxIndex.resize(m_TrackId.size());
+  for (unsigned int i = 0; i < m_TrackId.size(); ++i)
+  {
+    const PHG4Particle *particle = particlemap.find(m_TrackId[i])->second;
+    m_ParentIndex[i] = find(particle->get_parent_id());
+    m_VtxIndex[i] = find_vtx(particle->get_vtx_id());
+  }
+  return;
+}
+
+int PHG4TruthInfoCompact::find(const int trackid) const
+{
+  vector<int>::const_iterator iter = lower_bound(m_TrackId.begin(), m_TrackId.end(), trackid);
+  if (iter == m_TrackId.end() || *iter != trackid)
+  {
+    return -1;
+  }
+  return iter - m_TrackId.begin();
+}
+
+int PHG4TruthInfoCompact::find_vtx(const int vtxid) const
+{
+  vector<int>::const_iterator iter = lower_bound(m_VtxId.begin(), m_VtxId.end(), vtxid);
+  if (iter == m_VtxId.end() || *iter != vtxid)
+  {
+    return -1;
+  }
+  return iter - m_VtxId.begin();
+}
+
+int PHG4TruthInfoCompact::get_primary_index(const unsigned int i) const
+{
+  int index = i;
+  while (m_ParentIndex[index] >= 0)
+  {
+    index = m_ParentIndex[index];
+  }
+  return index;
+}
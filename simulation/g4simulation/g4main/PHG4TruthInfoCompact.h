@@ -0,0 +1,103 @@
+// Tell emacs that this is a C++ source
+//  -*- C++ -*-.
+#ifndef G4MAIN_PHG4TRUTHINFOCOMPACT_H
+#define G4MAIN_PHG4TRUTHINFOCOMPACT_H
+
+#include <phool/PHObject.h>
+
+#include <iostream>
+#include <map>
+#include <vector>
+
+class PHG4TruthInfoContainer;
+
+/*!
+ * \brief reduced truth record in contiguous arrays
+ *
+ * Keeps the primaries, every particle whose g4hits sum up to more than
+ * an energy threshold and the ancestry of those. One entry per particle
+ * in each of the arrays, sorted by track id, so a track id is found by
+ * a binary search (find()). Parents and vertices are referenced by their
+ * index in these arrays (-1 if there is none) instead of their id.
+ *
+ * This is filled from the full G4TruthInfo by PHG4TruthSubsystem and is the
+ * truth record written to the DST by default. Modules running in the same job
+ * can still use G4TruthInfo, it is kept outside of the DST node unless
+ * PHG4TruthSubsystem::SetSaveFullTruth() is set.
+ */
+class PHG4TruthInfoCompact : public PHObject
+{
+ public:
+  PHG4TruthInfoCompact() {}
+  virtual ~PHG4TruthInfoCompact() {}
+
+  void Reset();
+  void identify(std::ostream &os = std::cout) const;
+  int isValid() const { return !m_TrackId.empty(); }
+
+  //! fill the reduced record from the full truth container, trackedep is the
+  //! sum of the g4hit energy of each track, tracks with more than threshold are kept
+  void Fill(const PHG4TruthInfoContainer *truth, const std::map<int, double> &trackedep, const double threshold);
+
+  // --- particles -------------------------------------------------------------
+
+  unsigned int size() const { return m_TrackId.size(); }
+
+  //! index of a track id, -1 if the track was not kept
+  int find(const int trackid) const;
+
+  int get_track_id(const unsigned int i) const { return m_TrackId[i]; }
+  int get_parent_index(const unsigned int i) const { return m_ParentIndex[i]; }
+  int get_vtx_index(const unsigned int i) const { return m_VtxIndex[i]; }
+  int get_pid(const unsigned int i) const { return m_Pid[i]; }
+  float get_px(const unsigned int i) const { return m_Px[i]; }
+  float get_py(const unsigned int i) const { return m_Py[i]; }
+  float get_pz(const unsigned int i) const { return m_Pz[i]; }
+  float get_e(const unsigned int i) const { return m_E[i]; }
+  //! sum of the g4hit energy of this particle alone (not its daughters)
+  float get_edep(const unsigned int i) const { return m_Edep[i]; }
+  int get_embed(const unsigned int i) const { return m_Embed[i]; }
+
+  bool is_primary(const unsigned int i) const { return m_ParentIndex[i] < 0 && m_TrackId[i] > 0; }
+  //! index of the primary this particle descends from
+  int get_primary_index(const unsigned int i) const;
+
+  // --- vertices --------------------------------------------------------------
+
+  unsigned int vtx_size() const { return m_VtxId.size(); }
+
+  //! index of a vertex id, -1 if the vertex was not kept
+  int find_vtx(const int vtxid) const;
+
+  int get_vtx_id(const unsigned int i) const { return m_VtxId[i]; }
+  float get_vtx_x(const unsigned int i) const { return m_VtxX[i]; }
+  float get_vtx_y(const unsigned int i) const { return m_VtxY[i]; }
+  float get_vtx_z(const unsigned int i) const { return m_VtxZ[i]; }
+  float get_vtx_t(const unsigned int i) const { return m_VtxT[i]; }
+  int get_vtx_embed(const unsigned int i) const { return m_VtxEmbed[i]; }
+
+ private:
+  // particles, sorted by track id
+  std::vector<int> m_TrackId;
+  std::vector<int> m_ParentIndex;
+  std::vector<int> m_VtxIndex;
+  std::vector<int> m_Pid;
+  std::vector<float> m_Px;
+  std::vector<float> m_Py;
+  std::vector<float> m_Pz;
+  std::vector<float> m_E;
+  std::vector<float> m_Edep;
+  std::vector<int> m_Embed;
+
+  // vertices, sorted by vertex id
+  std::vector<int> m_VtxId;
+  std::vector<float> m_VtxX;
+  std::vector<float> m_VtxY;
+  std::vector<float> m_VtxZ;
+  std::vector<float> m_VtxT;
+  std::vector<int> m_VtxEmbed;
+
+  ClassDef(PHG4TruthInfoCompact, 1)
+};
+
+#endif
@@ -190,6 +190,9 @@ class PHG4TruthInfoContainer : public PHObject
   int minshowerindex() const;
 
  private:
+  //! moves the objects of sub events into the event
+  friend class PHG4SubEventMerger;
+
   /// particle storage map format description:
   /// primary particles are appended in the positive direction
   /// secondary particles are appended in the negative direction
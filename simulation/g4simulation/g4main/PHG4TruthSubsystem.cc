@@ -1,8 +1,11 @@
 #include "PHG4TruthSubsystem.h"
 
+#include "PHG4Hit.h"
+#include "PHG4HitContainer.h"
 #include "PHG4Particle.h"                // for PHG4Particle
 #include "PHG4TruthEventAction.h"
 #include "PHG4TruthTrackingAction.h"
+#include "PHG4TruthInfoCompact.h"
 #include "PHG4TruthInfoContainer.h"
 
 #include <fun4all/Fun4AllReturnCodes.h>
@@ -18,6 +21,7 @@
 #include <cassert>
 #include <cstdlib>                      // for exit
 #include <iostream>
+#include <map>
 #include <set>                           // for _Rb_tree_iterator, set, _Rb_...
 #include <utility>                       // for pair
 
@@ -31,7 +35,12 @@ PHG4TruthSubsystem::PHG4TruthSubsystem(const string& name)
   : PHG4Subsystem(name)
   , m_EventAction(nullptr)
   , m_TrackingAction(nullptr)
+  , m_WorkerEventAction(nullptr)
   , m_SaveOnlyEmbededFlag(false)
+  , m_CompactTruthFlag(true)
+  , m_SaveFullTruthFlag(false)
+  , m_FullTruthTransient(false)
+  , m_CompactEdepThreshold(0.)
 {
 }
 
@@ -41,12 +50,38 @@ int PHG4TruthSubsystem::InitRun(PHCompositeNode* topNode)
   PHNodeIterator iter(topNode);
   PHCompositeNode* dstNode = dynamic_cast<PHCompositeNode*>(iter.findFirst("PHCompositeNode", "DST"));
 
-  // create truth information container
+  // create truth information container, with the compact record it is kept
+  // outside of the DST node so it is not written out
   PHG4TruthInfoContainer* truthInfoList = findNode::getClass<PHG4TruthInfoContainer>(topNode, "G4TruthInfo");
   if (!truthInfoList)
   {
     truthInfoList = new PHG4TruthInfoContainer();
-    dstNode->addNode(new PHIODataNode<PHObject>(truthInfoList, "G4TruthInfo", "PHObject"));
+    if (m_CompactTruthFlag && !m_SaveFullTruthFlag)
+    {
+      PHCompositeNode* truthNode = dynamic_cast<PHCompositeNode*>(iter.findFirst("PHCompositeNode", "G4TRUTH"));
+      if (!truthNode)
+      {
+        truthNode = new PHCompositeNode("G4TRUTH");
+        topNode->addNode(truthNode);
+      }
+      truthNode->addNode(new PHIODataNode<PHObject>(truthInfoList, "G4TruthInfo", "PHObject"));
+      // only the DST node is reset by the framework
+      m_FullTruthTransient = true;
+    }
+    else
+    {
+      dstNode->addNode(new PHIODataNode<PHObject>(truthInfoList, "G4TruthInfo", "PHObject"));
+    }
+  }
+
+  if (m_CompactTruthFlag)
+  {
+    PHG4TruthInfoCompact* truthcompact = findNode::getClass<PHG4TruthInfoCompact>(topNode, "G4TruthInfoCompact");
+    if (!truthcompact)
+    {
+      truthcompact = new PHG4TruthInfoCompact();
+      dstNode->addNode(new PHIODataNode<PHObject>(truthcompact, "G4TruthInfoCompact", "PHObject"));
+    }
   }
 
   // event action
@@ -137,6 +172,32 @@ int PHG4TruthSubsystem::process_after_geant(PHCompositeNode* topNode)
     }
   }
 
+  if (m_CompactTruthFlag)
+  {
+    PHG4TruthInfoContainer* truthInfoList = findNode::getClass<PHG4TruthInfoContainer>(topNode, "G4TruthInfo");
+    PHG4TruthInfoCompact* truthcompact = findNode::getClass<PHG4TruthInfoCompact>(topNode, "G4TruthInfoCompact");
+    assert(truthInfoList);
+    assert(truthcompact);
+
+    // energy left by each track in all g4hit containers
+    map<int, double> trackedep;
+    const map<int, PHG4HitContainer*>& hitcontainers = m_EventAction->GetHitContainerMap();
+    for (map<int, PHG4HitContainer*>::const_iterator iter = hitcontainers.begin(); iter != hitcontainers.end(); ++iter)
+    {
+      PHG4HitContainer::ConstRange hit_range = iter->second->getHits();
+      for (PHG4HitContainer::ConstIterator hit_iter = hit_range.first; hit_iter != hit_range.second; ++hit_iter)
+      {
+        trackedep[hit_iter->second->get_trkid()] += hit_iter->second->get_edep();
+      }
+    }
+    truthcompact->Fill(truthInfoList, trackedep, m_CompactEdepThreshold);
+    if (Verbosity() > 1)
+    {
+      cout << Name() << ": kept " << truthcompact->size() << " of " << truthInfoList->size()
+           << " particles in the compact truth record" << endl;
+    }
+  }
+
   return 0;
 }
 
@@ -144,6 +205,14 @@ int PHG4TruthSubsystem::ResetEvent(PHCompositeNode* topNode)
 {
   m_TrackingAction->ResetEvent(topNode);
   m_EventAction->ResetEvent(topNode);
+  if (m_FullTruthTransient)
+  {
+    PHG4TruthInfoContainer* truthInfoList = findNode::getClass<PHG4TruthInfoContainer>(topNode, "G4TruthInfo");
+    if (truthInfoList)
+    {
+      truthInfoList->Reset();
+    }
+  }
   return 0;
 }
 
@@ -160,3 +229,23 @@ PHG4TruthSubsystem::GetTrackingAction(void) const
 {
   return m_TrackingAction;
 }
+
+//_______________________________________________________________________
+PHG4EventAction* PHG4TruthSubsystem::CreateWorkerEventAction()
+{
+  m_WorkerEventAction = new PHG4TruthEventAction();
+  return m_WorkerEventAction;
+}
+
+//_______________________________________________________________________
+PHG4TrackingAction* PHG4TruthSubsystem::CreateWorkerTrackingAction()
+{
+  if (!m_WorkerEventAction)
+  {
+    cout << PHWHERE << " worker tracking action requested before the event action" << endl;
+    exit(1);
+  }
+  PHG4TrackingAction* trackingaction = new PHG4TruthTrackingAction(m_WorkerEventAction);
+  m_WorkerEventAction = nullptr;
+  return trackingaction;
+}
@@ -40,16 +40,44 @@ class PHG4TruthSubsystem : public PHG4Subsystem
   virtual PHG4EventAction *GetEventAction(void) const;
   virtual PHG4TrackingAction *GetTrackingAction(void) const;
 
+  //! the worker actions fill the truth container of their sub event
+  bool SupportsWorkerThreads() const { return true; }
+  PHG4EventAction *CreateWorkerEventAction();
+  PHG4TrackingAction *CreateWorkerTrackingAction();
+
   //! only save the G4 truth information that is associated with the embedded particle
   void SetSaveOnlyEmbeded(bool b = true) { m_SaveOnlyEmbededFlag = b; };
 
+  //! write the reduced truth record G4TruthInfoCompact (default): primaries, particles whose
+  //! g4hits sum up to more than edep_threshold (GeV) and their ancestry. The full G4TruthInfo
+  //! is then only available to the modules of this job, SetCompactTruth(false) writes it instead
+  void SetCompactTruth(bool b = true, const double edep_threshold = 0.)
+  {
+    m_CompactTruthFlag = b;
+    m_CompactEdepThreshold = edep_threshold;
+  }
+
+  //! write the full G4TruthInfo to the DST next to the compact record
+  void SetSaveFullTruth(bool b = true) { m_SaveFullTruthFlag = b; }
+
  private:
   PHG4TruthEventAction *m_EventAction;
 
   PHG4TruthTrackingAction *m_TrackingAction;
 
+  //! event action of the worker whose actions are being created, its
+  //! tracking action is created right after it on the same thread
+  PHG4TruthEventAction *m_WorkerEventAction;
+
   //! only save the G4 truth information that is associated with the embedded particle
   bool m_SaveOnlyEmbededFlag;
+
+  bool m_CompactTruthFlag;
+  bool m_SaveFullTruthFlag;
+
+  //! G4TruthInfo was created outside of the DST node and has to be reset here
+  bool m_FullTruthTransient;
+  double m_CompactEdepThreshold;
 };
 
 #endif
@@ -9,7 +9,6 @@
 #include "PHG4TruthEventAction.h"
 #include "PHG4TruthInfoContainer.h"
 #include "PHG4UserPrimaryParticleInformation.h"
-#include "PHG4VtxPointv1.h"
 
 #include <phool/getClass.h>
 
@@ -23,18 +22,44 @@
 #include <Geant4/G4TrackVector.hh>               // for G4TrackVector
 #include <Geant4/G4VUserTrackInformation.hh>     // for G4VUserTrackInformation
 
-#include <cmath>                                // for sqrt
+#include <cmath>                                // for sqrt, llround
 #include <cstddef>                              // for size_t
 #include <iostream>                              // for operator<<, endl
 #include <utility>                               // for pair
 
 using namespace std;
 
+namespace
+{
+  // vertices closer than 1 nm are merged, geant4 units are mm
+  const double kVertexQuantum = 1e-6;
+}  // namespace
+
 //________________________________________________________
 PHG4TruthTrackingAction::PHG4TruthTrackingAction(PHG4TruthEventAction* eventAction)
   : m_EventAction(eventAction)
   , m_TruthInfoList(nullptr)
 {
+  // enough for a central event, the table keeps its buckets between events
+  m_VertexMap.reserve(100000);
+}
+
+size_t PHG4TruthTrackingAction::VertexKeyHash::operator()(const VertexKey& key) const
+{
+  // mix the three coordinates, the multipliers are large odd constants
+  size_t h = static_cast<size_t>(key.x) * 0x9E3779B97F4A7C15ULL;
+  h ^= static_cast<size_t>(key.y) * 0xC2B2AE3D27D4EB4FULL + (h >> 29);
+  h ^= static_cast<size_t>(key.z) * 0x165667B19E3779F9ULL + (h >> 31);
+  return h;
+}
+
+PHG4TruthTrackingAction::VertexKey PHG4TruthTrackingAction::GetVertexKey(const G4ThreeVector& v)
+{
+  VertexKey key;
+  key.x = llround(v.x() / kVertexQuantum);
+  key.y = llround(v.y() / kVertexQuantum);
+  key.z = llround(v.z() / kVertexQuantum);
+  return key;
 }
 
 void PHG4TruthTrackingAction::PreUserTrackingAction(const G4Track* track)
@@ -111,29 +136,18 @@ void PHG4TruthTrackingAction::PreUserTrackingAction(const G4Track* track)
   }
 
   // create a new vertex object ------------------------------------------------
+  // the vertex records are created by the event action at the end of the event
   G4ThreeVector v = track->GetVertexPosition();
-  map<G4ThreeVector, int>::const_iterator viter = m_VertexMap.find(v);
-  int vtxindex = 0;
-  if (viter != m_VertexMap.end())
+  pair<unordered_map<VertexKey, int, VertexKeyHash>::iterator, bool> vinsert = m_VertexMap.insert(make_pair(GetVertexKey(v), 0));
+  if (vinsert.second)
   {
-    vtxindex = viter->second;
-  }
-  else
-  {
-    vtxindex = m_TruthInfoList->maxvtxindex() + 1;
-    if (track->GetParentID())
-    {
-      vtxindex = m_TruthInfoList->minvtxindex() - 1;
-    }
-
-    m_VertexMap[v] = vtxindex;
-    PHG4VtxPointv1* vtxpt = new PHG4VtxPointv1(v[0] / cm,
-                                               v[1] / cm,
-                                               v[2] / cm,
-                                               track->GetGlobalTime() / ns);
-    // insert new vertex into the output
-    m_TruthInfoList->AddVertex(vtxindex, vtxpt);
+    vinsert.first->second = m_EventAction->AddVertex(!track->GetParentID(),
+                                                     v[0] / cm,
+                                                     v[1] / cm,
+                                                     v[2] / cm,
+                                                     track->GetGlobalTime() / ns);
   }
+  const int vtxindex = vinsert.first->second;
 
   ti->set_vtx_id(vtxindex);
 
@@ -7,7 +7,8 @@
 
 #include <Geant4/G4ThreeVector.hh>
 
-#include <map>
+#include <cstddef>  // for size_t
+#include <unordered_map>
 
 class G4Track;
 class PHCompositeNode;
@@ -34,7 +35,24 @@ class PHG4TruthTrackingAction : public PHG4TrackingAction
   int ResetEvent(PHCompositeNode*);
 
  private:
-  std::map<G4ThreeVector, int> m_VertexMap;
+  //! production vertex rounded to kVertexQuantum, vertices closer than that are one vertex
+  struct VertexKey
+  {
+    long long x;
+    long long y;
+    long long z;
+    bool operator==(const VertexKey& other) const { return x == other.x && y == other.y && z == other.z; }
+  };
+
+  struct VertexKeyHash
+  {
+    size_t operator()(const VertexKey& key) const;
+  };
+
+  static VertexKey GetVertexKey(const G4ThreeVector& v);
+
+  //! vertex ids of this event, cleared but not deallocated between events
+  std::unordered_map<VertexKey, int, VertexKeyHash> m_VertexMap;
 
   //! pointer to the "owning" event action
   PHG4TruthEventAction* m_EventAction;
@@ -0,0 +1,16 @@
+#include "PHG4WorkerInitialization.h"
+
+#include "PHG4Reco.h"
+
+#include <Geant4/G4Types.hh>  // for G4ThreadLocal
+
+void PHG4WorkerInitialization::WorkerRunStart() const
+{
+  // every BeamOn is a run, the processes are added only once per thread
+  static G4ThreadLocal bool optical_processes_done = false;
+  if (!optical_processes_done)
+  {
+    PHG4Reco::DefineOpticalProcesses();
+    optical_processes_done = true;
+  }
+}
@@ -0,0 +1,21 @@
+// Tell emacs that this is a C++ source
+//  -*- C++ -*-.
+#ifndef G4MAIN_PHG4WORKERINITIALIZATION_H
+#define G4MAIN_PHG4WORKERINITIALIZATION_H
+
+#include <Geant4/G4UserWorkerInitialization.hh>
+
+//! per thread setup of the Geant4 workers which has to wait for their
+//! physics: PHG4Reco adds the optical processes after the physics list is
+//! initialized, the workers have their own process managers
+class PHG4WorkerInitialization : public G4UserWorkerInitialization
+{
+ public:
+  PHG4WorkerInitialization() {}
+  virtual ~PHG4WorkerInitialization() {}
+
+  //! called by geant on each worker at the start of a run (BeamOn)
+  virtual void WorkerRunStart() const;
+};
+
+#endif
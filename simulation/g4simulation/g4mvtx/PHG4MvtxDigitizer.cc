@@ -17,7 +17,7 @@
 #include <phool/PHCompositeNode.h>
 #include <phool/PHNode.h>                           // for PHNode
 #include <phool/PHNodeIterator.h>
-#include <phool/PHRandomSeed.h>
+#include <phool/PHCounterRng.h>
 #include <phool/getClass.h>
 #include <phool/phool.h>                            // for PHWHERE
 
@@ -31,10 +31,8 @@ using namespace std;
 PHG4MvtxDigitizer::PHG4MvtxDigitizer(const string &name)
   : SubsysReco(name)
 {
-  unsigned int seed = PHRandomSeed();  // fixed seed is handled in this funtcion
-  cout << Name() << " random seed: " << seed << endl;
-  RandomGenerator = gsl_rng_alloc(gsl_rng_mt19937);
-  gsl_rng_set(RandomGenerator, seed);
+  m_Rng = new PHCounterRng(Name());
+  RandomGenerator = m_Rng->get_gsl_rng();
 
   if (Verbosity() > 0)
     cout << "Creating PHG4MvtxDigitizer with name = " << name << endl;
@@ -42,7 +40,7 @@ PHG4MvtxDigitizer::PHG4MvtxDigitizer(const string &name)
 
 PHG4MvtxDigitizer::~PHG4MvtxDigitizer()
 {
-  gsl_rng_free(RandomGenerator);
+  delete m_Rng;
 }
 
 int PHG4MvtxDigitizer::InitRun(PHCompositeNode *topNode)
@@ -164,6 +162,10 @@ void PHG4MvtxDigitizer::DigitizeMvtxLadderCells(PHCompositeNode *topNode)
     int layer = TrkrDefs::getLayer(hitsetkey);
     if (Verbosity() > 1) cout << "PHG4MvtxDigitizer: found hitset with key: " << hitsetkey << " in layer " << layer << endl;
 
+    // the layer settings are looked up once per chip
+    const float energy_scale = _energy_scale[layer];
+    const unsigned int max_adc = _max_adc[layer];
+
     // get all of the hits from this hitset
     TrkrHitSet *hitset = hitset_iter->second;
     TrkrHitSet::ConstRange hit_range = hitset->getHits();
@@ -174,8 +176,8 @@ void PHG4MvtxDigitizer::DigitizeMvtxLadderCells(PHCompositeNode *topNode)
       TrkrHit *hit = hit_iter->second;
 
       // Convert the signal value to an ADC value and write that to the hit
-      unsigned int adc = hit->getEnergy() / _energy_scale[layer];
-      if (adc > _max_adc[layer]) adc = _max_adc[layer];
+      unsigned int adc = hit->getEnergy() / energy_scale;
+      if (adc > max_adc) adc = max_adc;
       hit->setAdc(adc);
 
       if (Verbosity() > 0) cout << "    PHG4MvtxDigitizer: found hit with key: " << hit_iter->first << " and signal " << hit->getEnergy() << " and adc " << adc << endl;
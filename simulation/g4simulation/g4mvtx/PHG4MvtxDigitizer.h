@@ -18,6 +18,7 @@
 
 
 class PHCompositeNode;
+class PHCounterRng;
 
 class PHG4MvtxDigitizer : public SubsysReco
 {
@@ -56,6 +57,7 @@ class PHG4MvtxDigitizer : public SubsysReco
 
 #if !defined(__CINT__) || defined(__CLING__)
   //! random generator that conform with sPHENIX standard
+  PHCounterRng *m_Rng;
   gsl_rng *RandomGenerator;
 #endif
 };
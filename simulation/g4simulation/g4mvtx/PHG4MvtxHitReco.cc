@@ -32,8 +32,14 @@
 #include <phool/getClass.h>
 #include <phool/phool.h>  // for PHWHERE
 
+#include <phool/PHRandomSeed.h>
+
 #include <TVector3.h>  // for TVector3, ope...
 
+#include <gsl/gsl_randist.h>
+#include <gsl/gsl_rng.h>
+
+#include <algorithm>  // for stable_sort
 #include <cmath>
 #include <cstdlib>
 #include <iostream>
@@ -46,12 +52,32 @@ PHG4MvtxHitReco::PHG4MvtxHitReco(const string &name)
   : SubsysReco(name)
   , PHParameterContainerInterface(name)
   , detector(name)
+  , m_PixelThreshold(0)
+  , m_PixelNoise(0)
 {
   SetDefaultParameters();  // sets default timing window
+  unsigned int seed = PHRandomSeed();  // fixed seed is handled in this funtcion
+  m_RandomGenerator = gsl_rng_alloc(gsl_rng_mt19937);
+  gsl_rng_set(m_RandomGenerator, seed);
   if (Verbosity() > 0)
     cout << "Creating PHG4MvtxHitReco for name = " << name << endl;
 }
 
+PHG4MvtxHitReco::~PHG4MvtxHitReco()
+{
+  gsl_rng_free(m_RandomGenerator);
+}
+
+namespace
+{
+  // order g4hits by the chip (hitset) they are in
+  bool ChipLess(const pair<TrkrDefs::hitsetkey, PHG4HitContainer::ConstIterator> &a,
+                const pair<TrkrDefs::hitsetkey, PHG4HitContainer::ConstIterator> &b)
+  {
+    return a.first < b.first;
+  }
+}  // namespace
+
 int PHG4MvtxHitReco::InitRun(PHCompositeNode *topNode)
 {
   PHNodeIterator iter(topNode);
@@ -182,9 +208,35 @@ int PHG4MvtxHitReco::process_event(PHCompositeNode *topNode)
     int maxNX = layergeom->get_NX();
     int maxNZ = layergeom->get_NZ();
 
-    // Now loop over all g4 hits for this layer
+    // the pixels of one chip at a time are summed in a dense buffer, so the
+    // g4hits are grouped by chip (keeping their order within the chip)
+    vector<pair<TrkrDefs::hitsetkey, PHG4HitContainer::ConstIterator> > chiphits;
     for (hiter = hit_begin_end.first; hiter != hit_begin_end.second; ++hiter)
     {
+      chiphits.push_back(make_pair(MvtxDefs::genHitSetKey(*layer,
+                                                          hiter->second->get_property_int(PHG4Hit::prop_stave_index),
+                                                          hiter->second->get_property_int(PHG4Hit::prop_chip_index)),
+                                   hiter));
+    }
+    stable_sort(chiphits.begin(), chiphits.end(), ChipLess);
+    // StoreChipPixels() leaves the buffers empty, they only need resizing
+    if (m_PixelEnergy.size() != static_cast<unsigned int>(maxNX * maxNZ))
+    {
+      m_PixelEnergy.assign(maxNX * maxNZ, 0);
+      m_PixelFired.assign(maxNX * maxNZ, 0);
+    }
+
+    // Now loop over all g4 hits for this layer
+    for (unsigned int ichiphit = 0; ichiphit < chiphits.size(); ichiphit++)
+    {
+      hiter = chiphits[ichiphit].second;
+      TrkrDefs::hitsetkey hitsetkey = chiphits[ichiphit].first;
+      // the previous chip is complete
+      if (ichiphit > 0 && hitsetkey != chiphits[ichiphit - 1].first)
+      {
+        StoreChipPixels(chiphits[ichiphit - 1].first, maxNZ, trkrhitsetcontainer, hittruthassoc);
+      }
+
       //cout << "From PHG4MvtxHitReco: Call hit print method: " << endl;
       if (Verbosity() > 4)
         hiter->second->print();
@@ -304,12 +356,6 @@ int PHG4MvtxHitReco::process_event(PHCompositeNode *topNode)
       if (Verbosity() > 0)
         cout << "entry pixel number " << pixel_number_in << " exit pixel number " << pixel_number_out << endl;
 
-      vector<int> vpixel;
-      vector<int> vxbin;
-      vector<int> vzbin;
-      vector<pair<double, double> > venergy;
-      //double trklen = 0.0;
-
       //===================================================
       // OK, now we have found which sensor the hit is in, extracted the hit
       // position in local sensor coordinates,  and found the pixel numbers of the
@@ -337,7 +383,7 @@ int PHG4MvtxHitReco::process_event(PHCompositeNode *topNode)
       double diffusion_width_min = 8.0e-04;   // minimum diffusion radius 12 microns, in cm
 
       double ydrift_max = pathvec.Y();
-      int nsegments = 4;
+      const int nsegments = 4;
 
       // we want to make a list of all pixels possibly affected by this hit
       // we take the entry and exit locations in local coordinates, and build
@@ -378,7 +424,7 @@ int PHG4MvtxHitReco::process_event(PHCompositeNode *topNode)
       if (xbin_min < 0) xbin_min = 0;
       if (zbin_min < 0) zbin_min = 0;
       if (xbin_max >= maxNX) xbin_max = maxNX-1;
-      if (zbin_max >= maxNZ) xbin_max = maxNZ-1;
+      if (zbin_max >= maxNZ) zbin_max = maxNZ - 1;
 
       if (Verbosity() > 1)
       {
@@ -391,11 +437,10 @@ int PHG4MvtxHitReco::process_event(PHCompositeNode *topNode)
       if (xbin_max - xbin_min > 12 || zbin_max - zbin_min > 12)
         continue;
 
-      // this hit is skipped earlier if this dimensioning would be exceeded
-      double pixenergy[12][12] = {};  // init to 0
-      double pixeion[12][12] = {};    // init to 0
-
-      // Loop over track segments and diffuse charge at each segment location, collect energy in pixels
+      // Find the tracklet segment locations and the charge diffusion at each of them
+      double segx[nsegments];
+      double segz[nsegments];
+      double segradius[nsegments];
       for (int i = 0; i < nsegments; i++)
       {
         // Find the tracklet segment location
@@ -413,6 +458,9 @@ int PHG4MvtxHitReco::process_event(PHCompositeNode *topNode)
         // Caculate the charge diffusion over this drift distance
         // increases from diffusion width_min to diffusion_width_max
         double ydiffusion_radius = diffusion_width_min + (ydrift / ydrift_max) * (diffusion_width_max - diffusion_width_min);
+        segx[i] = segvec.X();
+        segz[i] = segvec.Z();
+        segradius[i] = ydiffusion_radius;
 
         if (Verbosity() > 5)
           cout << " segment " << i
@@ -431,67 +479,64 @@ int PHG4MvtxHitReco::process_event(PHCompositeNode *topNode)
                << " ydrift_max " << ydrift_max
                << " ydiffusion_radius " << ydiffusion_radius
                << endl;
+      }
 
-        // Now find the area of overlap of the diffusion circle with each pixel and apportion the energy
-        for (int ix = xbin_min; ix <= xbin_max; ix++)
+      // Now find the area of overlap of the diffusion circles with each pixel and apportion the energy,
+      // the pixel corners are looked up once for all segments
+      for (int ix = xbin_min; ix <= xbin_max; ix++)
+      {
+        for (int iz = zbin_min; iz <= zbin_max; iz++)
         {
-          for (int iz = zbin_min; iz <= zbin_max; iz++)
-          {
-            // Find the pixel corners for this pixel number
-            int pixnum = layergeom->get_pixel_number_from_xbin_zbin(ix, iz);
+          // Find the pixel corners for this pixel number
+          int pixnum = layergeom->get_pixel_number_from_xbin_zbin(ix, iz);
 
-            if (pixnum < 0)
-            {
-              cout << " pixnum < 0 , pixnum = " << pixnum << endl;
-              cout << " ix " << ix << " iz " << iz << endl;
-              cout << " xbin_min " << xbin_min << " zbin_min " << zbin_min
-                   << " xbin_max " << xbin_max << " zbin_max " << zbin_max
-                   << endl;
-              cout << " maxNX " << maxNX << " maxNZ " << maxNZ
-                   << endl;
-            }
+          if (pixnum < 0)
+          {
+            cout << " pixnum < 0 , pixnum = " << pixnum << endl;
+            cout << " ix " << ix << " iz " << iz << endl;
+            cout << " xbin_min " << xbin_min << " zbin_min " << zbin_min
+                 << " xbin_max " << xbin_max << " zbin_max " << zbin_max
+                 << endl;
+            cout << " maxNX " << maxNX << " maxNZ " << maxNZ
+                 << endl;
+          }
 
-            TVector3 tmp = layergeom->get_local_coords_from_pixel(pixnum);
-            // note that (x1,z1) is the top left corner, (x2,z2) is the bottom right corner of the pixel - circle_rectangle_intersection expects this ordering
-            double x1 = tmp.X() - xpixw_half;
-            double z1 = tmp.Z() + zpixw_half;
-            double x2 = tmp.X() + xpixw_half;
-            double z2 = tmp.Z() - zpixw_half;
+          TVector3 tmp = layergeom->get_local_coords_from_pixel(pixnum);
+          // note that (x1,z1) is the top left corner, (x2,z2) is the bottom right corner of the pixel - circle_rectangle_intersection expects this ordering
+          double x1 = tmp.X() - xpixw_half;
+          double z1 = tmp.Z() + zpixw_half;
+          double x2 = tmp.X() + xpixw_half;
+          double z2 = tmp.Z() - zpixw_half;
 
-            // here segvec.X and segvec.Z are the center of the circle, and diffusion_radius is the circle radius
+          double pixenergy = 0;
+          for (int i = 0; i < nsegments; i++)
+          {
+            // here segx and segz are the center of the circle, and segradius is the circle radius
             // circle_rectangle_intersection returns the overlap area of the circle and the pixel. It is very fast if there is no overlap.
-            double pixarea_frac = PHG4Utils::circle_rectangle_intersection(x1, z1, x2, z2, segvec.X(), segvec.Z(), ydiffusion_radius) / (M_PI * pow(ydiffusion_radius, 2));
+            double pixarea_frac = PHG4Utils::circle_rectangle_intersection(x1, z1, x2, z2, segx[i], segz[i], segradius[i]) / (M_PI * pow(segradius[i], 2));
             // assume that the energy is deposited uniformly along the tracklet length, so that this segment gets the fraction 1/nsegments of the energy
-            pixenergy[ix - xbin_min][iz - zbin_min] += pixarea_frac * hiter->second->get_edep() / (float) nsegments;
-            if (hiter->second->has_property(PHG4Hit::prop_eion))
-            {
-              pixeion[ix - xbin_min][iz - zbin_min] += pixarea_frac * hiter->second->get_eion() / (float) nsegments;
-            }
-            if (Verbosity() > 5)
-            {
-              cout << "    pixnum " << pixnum << " xbin " << ix << " zbin " << iz
-                   << " pixel_area fraction of circle " << pixarea_frac << " accumulated pixel energy " << pixenergy[ix - xbin_min][iz - zbin_min]
-                   << endl;
-            }
+            pixenergy += pixarea_frac * hiter->second->get_edep() / (float) nsegments;
+          }
+          if (Verbosity() > 5)
+          {
+            cout << "    pixnum " << pixnum << " xbin " << ix << " zbin " << iz
+                 << " pixel energy " << pixenergy
+                 << endl;
           }
-        }
-      }  // end loop over segments
 
-      // now we have the energy deposited in each pixel, summed over all tracklet segments. We make a vector of all pixels with non-zero energy deposited
-      for (int ix = xbin_min; ix <= xbin_max; ix++)
-      {
-        for (int iz = zbin_min; iz <= zbin_max; iz++)
-        {
-          if (pixenergy[ix - xbin_min][iz - zbin_min] > 0.0)
+          // add the pixels with energy to the chip accumulator
+          if (pixenergy > 0.0)
           {
-            int pixnum = layergeom->get_pixel_number_from_xbin_zbin(ix, iz);
-            vpixel.push_back(pixnum);
-            vxbin.push_back(ix);
-            vzbin.push_back(iz);
-            pair<double, double> tmppair = make_pair(pixenergy[ix - xbin_min][iz - zbin_min], pixeion[ix - xbin_min][iz - zbin_min]);
-            venergy.push_back(tmppair);
+            unsigned int ipix = ix * maxNZ + iz;
+            if (!m_PixelFired[ipix])
+            {
+              m_PixelFired[ipix] = 1;
+              m_FiredPixels.push_back(ipix);
+            }
+            m_PixelEnergy[ipix] += pixenergy;
+            m_PixelTruth.push_back(make_pair(ipix, hiter->first));
             if (Verbosity() > 1)
-              cout << " Added pixel number " << pixnum << " xbin " << ix << " zbin " << iz << " to vectors with energy " << pixenergy[ix - xbin_min][iz - zbin_min] << endl;
+              cout << " Added pixel number " << pixnum << " xbin " << ix << " zbin " << iz << " with energy " << pixenergy << endl;
           }
         }
       }
@@ -499,45 +544,14 @@ int PHG4MvtxHitReco::process_event(PHCompositeNode *topNode)
       //===================================
       // End of charge sharing implementation
       //===================================
+    }  // end loop over g4hits for this layer
 
-      // loop over all fired cells for this g4hit and add them to the TrkrHitSet
-      for (unsigned int i1 = 0; i1 < vpixel.size(); i1++)  // loop over all fired cells
-      {
-        // This is the new storage object version
-        //====================================
-
-        // We need to create the TrkrHitSet if not already made - each TrkrHitSet should correspond to a chip for the Mvtx
-        TrkrDefs::hitsetkey hitsetkey = MvtxDefs::genHitSetKey(*layer, stave_number, chip_number);
-        // Use existing hitset or add new one if needed
-        TrkrHitSetContainer::Iterator hitsetit = trkrhitsetcontainer->findOrAddHitSet(hitsetkey);
-
-        // generate the key for this hit
-        TrkrDefs::hitkey hitkey = MvtxDefs::genHitKey(vzbin[i1], vxbin[i1]);
-        // See if this hit already exists
-        TrkrHit *hit = nullptr;
-        hit = hitsetit->second->getHit(hitkey);
-        if (!hit)
-        {
-          // Otherwise, create a new one
-          hit = new MvtxHit();
-          hitsetit->second->addHitSpecificKey(hitkey, hit);
-        }
-
-        // Either way, add the energy to it
-        hit->addEnergy(venergy[i1].first);
-
-        // now we update the TrkrHitTruthAssoc map - the map contains <hitsetkey, std::pair <hitkey, g4hitkey> >
-        // There is only one TrkrHit per pixel, but there may be multiple g4hits
-        // How do we know how much energy from PHG4Hit went into TrkrHit? We don't, have to sort it out in evaluator to save memory
-
-        // How do we check if this association already exists?
-        //cout << "PHG4MvtxHitReco: adding association entry for hitkey " << hitkey << " and g4hitkey " << hiter->first << endl;
-        hittruthassoc->addAssoc(hitsetkey, hitkey, hiter->first);
-
-      }  // end loop over hit cells
-    }    // end loop over g4hits for this layer
-
+    if (!chiphits.empty())
+    {
+      StoreChipPixels(chiphits.back().first, maxNZ, trkrhitsetcontainer, hittruthassoc);
+    }
   }  // end loop over layers
+  hittruthassoc->finalize();
 
   // print the list of entries in the association table
   if (Verbosity() > 2)
@@ -549,6 +563,59 @@ int PHG4MvtxHitReco::process_event(PHCompositeNode *topNode)
   return Fun4AllReturnCodes::EVENT_OK;
 }
 
+void PHG4MvtxHitReco::StoreChipPixels(const TrkrDefs::hitsetkey hitsetkey, const int maxNZ,
+                                      TrkrHitSetContainer *hitsetcontainer, TrkrHitTruthAssoc *hittruthassoc)
+{
+  // threshold and noise in one pass over the fired pixels, only the survivors are stored
+  TrkrHitSet *hitset = nullptr;
+  for (unsigned int i = 0; i < m_FiredPixels.size(); i++)
+  {
+    unsigned int ipix = m_FiredPixels[i];
+    double energy = m_PixelEnergy[ipix];
+    m_PixelEnergy[ipix] = 0;
+    if (m_PixelNoise > 0)
+    {
+      energy += gsl_ran_gaussian(m_RandomGenerator, m_PixelNoise);
+    }
+    if (energy <= m_PixelThreshold)
+    {
+      m_PixelFired[ipix] = 0;
+      continue;
+    }
+    if (!hitset)
+    {
+      // each TrkrHitSet corresponds to a chip for the Mvtx
+      hitset = hitsetcontainer->findOrAddHitSet(hitsetkey)->second;
+    }
+    hitset->stageHit(MvtxDefs::genHitKey(ipix % maxNZ, ipix / maxNZ), energy);
+  }
+  // another module may have filled some of the pixels already, their energies are added
+  if (hitset)
+  {
+    hitset->addStagedHits<MvtxHit>();
+  }
+
+  // now we update the TrkrHitTruthAssoc map - the map contains <hitsetkey, std::pair <hitkey, g4hitkey> >
+  // There is only one TrkrHit per pixel, but there may be multiple g4hits
+  // How do we know how much energy from PHG4Hit went into TrkrHit? We don't, have to sort it out in evaluator to save memory
+  for (unsigned int i = 0; i < m_PixelTruth.size(); i++)
+  {
+    unsigned int ipix = m_PixelTruth[i].first;
+    if (m_PixelFired[ipix])
+    {
+      hittruthassoc->addAssoc(hitsetkey, MvtxDefs::genHitKey(ipix % maxNZ, ipix / maxNZ), m_PixelTruth[i].second);
+    }
+  }
+
+  for (unsigned int i = 0; i < m_FiredPixels.size(); i++)
+  {
+    m_PixelFired[m_FiredPixels[i]] = 0;
+  }
+  m_FiredPixels.clear();
+  m_PixelTruth.clear();
+  return;
+}
+
 void PHG4MvtxHitReco::set_timing_window(const int detid, const double tmin, const double tmax)
 {
   // first have to erase the default value
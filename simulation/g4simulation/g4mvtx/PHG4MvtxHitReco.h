@@ -5,18 +5,30 @@
 
 #include <fun4all/SubsysReco.h>
 
+#include <trackbase/TrkrDefs.h>
+
+#include <g4main/PHG4HitDefs.h>
+
+// rootcint barfs with this header so we need to hide it
+#if !defined(__CINT__) || defined(__CLING__)
+#include <gsl/gsl_rng.h>
+#endif
+
 #include <map>
 #include <string>
 #include <utility>  // for pair
+#include <vector>
 
 class PHCompositeNode;
+class TrkrHitSetContainer;
+class TrkrHitTruthAssoc;
 
 class PHG4MvtxHitReco : public SubsysReco, public PHParameterContainerInterface
 {
  public:
   explicit PHG4MvtxHitReco(const std::string &name = "PHG4MvtxRECO");
 
-  virtual ~PHG4MvtxHitReco() {}
+  virtual ~PHG4MvtxHitReco();
 
   //! module initialization
   int InitRun(PHCompositeNode *topNode);
@@ -30,6 +42,11 @@ class PHG4MvtxHitReco : public SubsysReco, public PHParameterContainerInterface
   double get_timing_window_max(const int i) { return tmin_max[i].second; }
   void set_timing_window(const int detid, const double tmin, const double tmax);
 
+  //! pixels need more than this energy (GeV) summed over all g4hits to be stored
+  void set_pixel_threshold(const double e) { m_PixelThreshold = e; }
+  //! gaussian noise (GeV) added to the energy of every fired pixel before the threshold
+  void set_pixel_noise(const double e) { m_PixelNoise = e; }
+
   void SetDefaultParameters();
 
  protected:
@@ -37,6 +54,27 @@ class PHG4MvtxHitReco : public SubsysReco, public PHParameterContainerInterface
   std::string hitnodename;
   std::string geonodename;
   std::map<int, std::pair<double, double> > tmin_max;
+
+ private:
+  //! threshold and noise on the accumulated pixels of one chip, stores the survivors
+  void StoreChipPixels(const TrkrDefs::hitsetkey hitsetkey, const int maxNZ,
+                       TrkrHitSetContainer *hitsetcontainer, TrkrHitTruthAssoc *hittruthassoc);
+
+  double m_PixelThreshold;
+  double m_PixelNoise;
+
+  // dense pixel accumulator of the chip being processed, reused for all chips and events
+  std::vector<double> m_PixelEnergy;
+  std::vector<unsigned char> m_PixelFired;
+  //! pixels fired on this chip, in order of their first energy
+  std::vector<unsigned int> m_FiredPixels;
+  //! pixel and g4hit key of every contribution, for the truth association
+  std::vector<std::pair<unsigned int, PHG4HitDefs::keytype> > m_PixelTruth;
+
+#if !defined(__CINT__) || defined(__CLING__)
+  //! random generator that conform with sPHENIX standard
+  gsl_rng *m_RandomGenerator;
+#endif
 };
 
 #endif
@@ -4,7 +4,6 @@
 
 #include <g4main/PHG4Hit.h>
 #include <g4main/PHG4HitContainer.h>
-#include <g4main/PHG4Hitv1.h>
 #include <g4main/PHG4Shower.h>
 #include <g4main/PHG4SteppingAction.h>         // for PHG4SteppingAction
 #include <g4main/PHG4TrackUserInfoV1.h>
@@ -58,6 +57,7 @@ PHG4MvtxSteppingAction::PHG4MvtxSteppingAction(PHG4MvtxDetector* detector)
   , m_HitContainer(nullptr)
   , m_AbsorberhitContainer(nullptr)
   , m_Hit(nullptr)
+  , m_HitVersion(PHG4HitContainer::HitVersion())
   , m_SaveShower(nullptr)
 {
 }
@@ -72,6 +72,12 @@ PHG4MvtxSteppingAction::~PHG4MvtxSteppingAction()
   delete m_Hit;
 }
 
+//____________________________________________________________________________..
+bool PHG4MvtxSteppingAction::HandlesVolume(G4VPhysicalVolume* volume)
+{
+  return m_Detector->IsSensor(volume) != 0;
+}
+
 //____________________________________________________________________________..
 bool PHG4MvtxSteppingAction::UserSteppingAction(const G4Step* aStep, bool)
 {
@@ -238,7 +244,7 @@ bool PHG4MvtxSteppingAction::UserSteppingAction(const G4Step* aStep, bool)
     case fUndefined:
       if (!m_Hit)
       {
-        m_Hit = new PHG4Hitv1();
+        m_Hit = PHG4HitContainer::NewHit(m_HitVersion);
       }
       m_Hit->set_layer((unsigned int) layer_id);
 
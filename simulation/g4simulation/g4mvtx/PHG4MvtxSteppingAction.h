@@ -6,6 +6,7 @@
 #include <g4main/PHG4SteppingAction.h>
 
 class G4Step;
+class G4VPhysicalVolume;
 class PHCompositeNode;
 class PHG4MvtxDetector;
 class PHG4Hit;
@@ -24,6 +25,9 @@ class PHG4MvtxSteppingAction : public PHG4SteppingAction
   //! stepping action
   virtual bool UserSteppingAction(const G4Step *, bool);
 
+  //! only steps in our own volumes are dispatched to this stepping action
+  virtual bool HandlesVolume(G4VPhysicalVolume *volume);
+
   //! reimplemented from base class
   virtual void SetInterfacePointers(PHCompositeNode *);
 
@@ -35,6 +39,8 @@ class PHG4MvtxSteppingAction : public PHG4SteppingAction
   PHG4HitContainer *m_HitContainer;
   PHG4HitContainer *m_AbsorberhitContainer;
   PHG4Hit *m_Hit;
+  //! PHG4Hit version created, PHG4HitContainer::HitVersion()
+  int m_HitVersion;
   PHG4Shower *m_SaveShower;
 };
 
@@ -0,0 +1,235 @@
+#include "PHG4BackgroundLibrary.h"
+
+#include <g4detectors/PHG4Cell.h>
+#include <g4detectors/PHG4CellContainer.h>
+
+#include <calobase/RawTower.h>
+#include <calobase/RawTowerContainer.h>
+
+#include <trackbase/TrkrHit.h>
+#include <trackbase/TrkrHitSet.h>
+#include <trackbase/TrkrHitSetContainer.h>
+
+#include <phool/phool.h>
+
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+#include <cstring>
+#include <iostream>
+
+using namespace std;
+
+const char PHG4BackgroundLibrary::magic[8] = {'P', 'H', 'G', '4', 'B', 'K', 'G', 'L'};
+const uint32_t PHG4BackgroundLibrary::version = 1;
+
+PHG4BackgroundLibrary::PHG4BackgroundLibrary()
+  : m_Mapped(nullptr)
+  , m_MappedSize(0)
+  , m_Header(nullptr)
+  , m_Nodes(nullptr)
+  , m_Index(nullptr)
+{
+}
+
+PHG4BackgroundLibrary::~PHG4BackgroundLibrary()
+{
+  Close();
+}
+
+bool PHG4BackgroundLibrary::Open(const string &filename)
+{
+  Close();
+  int fd = open(filename.c_str(), O_RDONLY);
+  if (fd < 0)
+  {
+    cout << PHWHERE << " could not open " << filename << endl;
+    return false;
+  }
+  struct stat filestat;
+  if (fstat(fd, &filestat) != 0 || filestat.st_size < (off_t) sizeof(FileHeader))
+  {
+    cout << PHWHERE << " " << filename << " is too short for a background library" << endl;
+    close(fd);
+    return false;
+  }
+  m_MappedSize = filestat.st_size;
+  // read only shared mapping, the pages are shared with every job using the library
+  m_Mapped = mmap(nullptr, m_MappedSize, PROT_READ, MAP_SHARED, fd, 0);
+  close(fd);
+  if (m_Mapped == MAP_FAILED)
+  {
+    cout << PHWHERE << " could not mmap " << filename << endl;
+    m_Mapped = nullptr;
+    return false;
+  }
+  // events are sampled at random, read ahead would only waste page cache
+  madvise(m_Mapped, m_MappedSize, MADV_RANDOM);
+  m_FileName = filename;
+
+  const char *base = static_cast<const char *>(m_Mapped);
+  const FileHeader *header = reinterpret_cast<const FileHeader *>(base);
+  if (memcmp(header->magic, magic, sizeof(magic)) != 0 || header->version != version)
+  {
+    cout << PHWHERE << " " << filename << " is not a background library (version " << version << ")" << endl;
+    Close();
+    return false;
+  }
+  const size_t nodes_end = sizeof(FileHeader) + (size_t) header->nnodes * sizeof(NodeEntry);
+  const size_t index_size = header->nevents * header->nnodes * sizeof(IndexEntry);
+  if (nodes_end > m_MappedSize || header->index_offset < nodes_end ||
+      header->index_offset % alignof(IndexEntry) != 0 ||
+      header->index_offset + index_size != m_MappedSize)
+  {
+    cout << PHWHERE << " " << filename << " is truncated or corrupt" << endl;
+    Close();
+    return false;
+  }
+  const NodeEntry *nodes = reinterpret_cast<const NodeEntry *>(base + sizeof(FileHeader));
+  for (uint32_t i = 0; i < header->nnodes; ++i)
+  {
+    if (nodes[i].type > kTower || nodes[i].record_size != RecordSize(static_cast<NodeType>(nodes[i].type)))
+    {
+      cout << PHWHERE << " " << filename << " was written with other record types" << endl;
+      Close();
+      return false;
+    }
+  }
+  const IndexEntry *index = reinterpret_cast<const IndexEntry *>(base + header->index_offset);
+  for (uint64_t i = 0; i < header->nevents * header->nnodes; ++i)
+  {
+    const NodeEntry &node = nodes[i % header->nnodes];
+    if (index[i].offset < nodes_end || index[i].offset % 8 != 0 ||
+        index[i].offset + index[i].count * node.record_size > header->index_offset)
+    {
+      cout << PHWHERE << " " << filename << " has a corrupt index" << endl;
+      Close();
+      return false;
+    }
+  }
+
+  m_Header = header;
+  m_Nodes = nodes;
+  m_Index = index;
+  return true;
+}
+
+void PHG4BackgroundLibrary::Close()
+{
+  if (m_Mapped)
+  {
+    munmap(m_Mapped, m_MappedSize);
+  }
+  m_Mapped = nullptr;
+  m_MappedSize = 0;
+  m_Header = nullptr;
+  m_Nodes = nullptr;
+  m_Index = nullptr;
+  m_FileName.clear();
+}
+
+int PHG4BackgroundLibrary::FindNode(const string &name, const NodeType type) const
+{
+  if (!m_Header)
+  {
+    return -1;
+  }
+  for (uint32_t i = 0; i < m_Header->nnodes; ++i)
+  {
+    if (m_Nodes[i].type == static_cast<uint32_t>(type) &&
+        strncmp(m_Nodes[i].name, name.c_str(), sizeof(m_Nodes[i].name)) == 0)
+    {
+      return i;
+    }
+  }
+  return -1;
+}
+
+const void *PHG4BackgroundLibrary::GetRecords(const uint64_t event, const int node, size_t &n) const
+{
+  const IndexEntry &entry = m_Index[event * m_Header->nnodes + node];
+  n = entry.count;
+  return static_cast<const char *>(m_Mapped) + entry.offset;
+}
+
+const PHG4BackgroundLibrary::HitRecord *PHG4BackgroundLibrary::GetHits(const uint64_t event, const int node, size_t &n) const
+{
+  return static_cast<const HitRecord *>(GetRecords(event, node, n));
+}
+
+const PHG4BackgroundLibrary::CellRecord *PHG4BackgroundLibrary::GetCells(const uint64_t event, const int node, size_t &n) const
+{
+  return static_cast<const CellRecord *>(GetRecords(event, node, n));
+}
+
+const PHG4BackgroundLibrary::TowerRecord *PHG4BackgroundLibrary::GetTowers(const uint64_t event, const int node, size_t &n) const
+{
+  return static_cast<const TowerRecord *>(GetRecords(event, node, n));
+}
+
+size_t PHG4BackgroundLibrary::RecordSize(const NodeType type)
+{
+  switch (type)
+  {
+  case kHitSet:
+    return sizeof(HitRecord);
+  case kCell:
+    return sizeof(CellRecord);
+  case kTower:
+    return sizeof(TowerRecord);
+  }
+  return 0;
+}
+
+void PHG4BackgroundLibrary::FillRecords(TrkrHitSetContainer *hitsets, vector<HitRecord> &records)
+{
+  records.clear();
+  TrkrHitSetContainer::ConstRange hitsetrange = hitsets->getHitSets();
+  for (TrkrHitSetContainer::ConstIterator hitsetiter = hitsetrange.first; hitsetiter != hitsetrange.second; ++hitsetiter)
+  {
+    TrkrHitSet::ConstRange hitrange = hitsetiter->second->getHits();
+    for (TrkrHitSet::ConstIterator hititer = hitrange.first; hititer != hitrange.second; ++hititer)
+    {
+      HitRecord record;
+      record.hitsetkey = hitsetiter->first;
+      record.hitkey = hititer->first;
+      record.edep = hititer->second->getEnergy();
+      record.adc = hititer->second->getAdc();
+      records.push_back(record);
+    }
+  }
+}
+
+void PHG4BackgroundLibrary::FillRecords(const PHG4CellContainer *cells, vector<CellRecord> &records)
+{
+  records.clear();
+  records.reserve(cells->size());
+  PHG4CellContainer::ConstRange cellrange = cells->getCells();
+  for (PHG4CellContainer::ConstIterator celliter = cellrange.first; celliter != cellrange.second; ++celliter)
+  {
+    const PHG4Cell *cell = celliter->second;
+    CellRecord record;
+    record.key = celliter->first;
+    record.edep = cell->get_edep();
+    record.eion = cell->get_eion();
+    record.light_yield = cell->get_light_yield();
+    records.push_back(record);
+  }
+}
+
+void PHG4BackgroundLibrary::FillRecords(const RawTowerContainer *towers, vector<TowerRecord> &records)
+{
+  records.clear();
+  records.reserve(towers->size());
+  RawTowerContainer::ConstRange towerrange = towers->getTowers();
+  for (RawTowerContainer::ConstIterator toweriter = towerrange.first; toweriter != towerrange.second; ++toweriter)
+  {
+    TowerRecord record;
+    record.key = toweriter->first;
+    record.energy = toweriter->second->get_energy();
+    record.time = toweriter->second->get_time();
+    records.push_back(record);
+  }
+}
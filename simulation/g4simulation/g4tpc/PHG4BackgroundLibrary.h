@@ -0,0 +1,130 @@
+// Tell emacs that this is a C++ source
+//  -*- C++ -*-.
+#ifndef G4TPC_PHG4BACKGROUNDLIBRARY_H
+#define G4TPC_PHG4BACKGROUNDLIBRARY_H
+
+#include <g4detectors/PHG4CellDefs.h>
+
+#include <calobase/RawTowerDefs.h>
+
+#include <trackbase/TrkrDefs.h>
+
+#include <cstddef>
+#include <cstdint>
+#include <string>
+#include <vector>
+
+class PHG4CellContainer;
+class RawTowerContainer;
+class TrkrHitSetContainer;
+
+/**
+ * Background library: the hit payloads of background events in one flat
+ * binary file (native byte order). It is written by
+ * PHG4BackgroundLibraryWriter and memory mapped read only by
+ * PHG4BackgroundOverlay, so all jobs on a node share the pages and any
+ * event can be sampled without reading the ones before it.
+ *
+ * Layout: FileHeader, one NodeEntry per stored node, the record arrays of
+ * every event and node (sorted by key, 8 byte aligned) and at the end the
+ * index with one IndexEntry per event and node.
+ */
+class PHG4BackgroundLibrary
+{
+ public:
+  enum NodeType
+  {
+    kHitSet = 0,
+    kCell = 1,
+    kTower = 2
+  };
+
+  //! one TrkrHit
+  struct HitRecord
+  {
+    TrkrDefs::hitsetkey hitsetkey;
+    TrkrDefs::hitkey hitkey;
+    float edep;
+    uint32_t adc;
+  };
+
+  //! one PHG4Cell, properties the cell does not have are NaN
+  struct CellRecord
+  {
+    PHG4CellDefs::keytype key;
+    float edep;
+    float eion;
+    float light_yield;
+  };
+
+  //! one RawTower
+  struct TowerRecord
+  {
+    RawTowerDefs::keytype key;
+    float energy;
+    float time;
+  };
+
+  struct FileHeader
+  {
+    char magic[8];
+    uint32_t version;
+    uint32_t nnodes;
+    uint64_t nevents;
+    //! position of the index
+    uint64_t index_offset;
+  };
+
+  struct NodeEntry
+  {
+    uint32_t type;
+    uint32_t record_size;
+    char name[56];
+  };
+
+  struct IndexEntry
+  {
+    uint64_t offset;
+    uint64_t count;
+  };
+
+  static const char magic[8];
+  static const uint32_t version;
+
+  PHG4BackgroundLibrary();
+  ~PHG4BackgroundLibrary();
+
+  //! maps the library, false if it is not a valid library
+  bool Open(const std::string &filename);
+  void Close();
+  bool IsOpen() const { return m_Mapped != nullptr; }
+
+  uint64_t NEvents() const { return m_Header ? m_Header->nevents : 0; }
+
+  //! position of a node in the library, -1 if it is not stored with this type
+  int FindNode(const std::string &name, const NodeType type) const;
+
+  //! records of a node in an event
+  const HitRecord *GetHits(const uint64_t event, const int node, size_t &n) const;
+  const CellRecord *GetCells(const uint64_t event, const int node, size_t &n) const;
+  const TowerRecord *GetTowers(const uint64_t event, const int node, size_t &n) const;
+
+  //! records of all objects of a container, sorted by key
+  static void FillRecords(TrkrHitSetContainer *hitsets, std::vector<HitRecord> &records);
+  static void FillRecords(const PHG4CellContainer *cells, std::vector<CellRecord> &records);
+  static void FillRecords(const RawTowerContainer *towers, std::vector<TowerRecord> &records);
+
+  static size_t RecordSize(const NodeType type);
+
+ private:
+  const void *GetRecords(const uint64_t event, const int node, size_t &n) const;
+
+  std::string m_FileName;
+  void *m_Mapped;
+  size_t m_MappedSize;
+  const FileHeader *m_Header;
+  const NodeEntry *m_Nodes;
+  const IndexEntry *m_Index;
+};
+
+#endif  // G4TPC_PHG4BACKGROUNDLIBRARY_H
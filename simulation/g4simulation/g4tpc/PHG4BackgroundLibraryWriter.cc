@@ -0,0 +1,183 @@
+#include "PHG4BackgroundLibraryWriter.h"
+
+#include <g4detectors/PHG4CellContainer.h>
+
+#include <calobase/RawTowerContainer.h>
+
+#include <trackbase/TrkrHitSetContainer.h>
+
+#include <fun4all/Fun4AllReturnCodes.h>
+
+#include <phool/getClass.h>
+#include <phool/phool.h>
+
+#include <cstdio>  // for rename
+#include <cstring>
+#include <iostream>
+#include <sstream>
+
+#include <unistd.h>
+
+using namespace std;
+
+PHG4BackgroundLibraryWriter::PHG4BackgroundLibraryWriter(const string &filename, const string &name)
+  : SubsysReco(name)
+  , m_FileName(filename)
+  , m_Position(0)
+  , m_NEvents(0)
+{
+}
+
+void PHG4BackgroundLibraryWriter::AddNode(const string &nodename, const PHG4BackgroundLibrary::NodeType type)
+{
+  if (nodename.size() >= sizeof(PHG4BackgroundLibrary::NodeEntry::name))
+  {
+    cout << PHWHERE << " node name " << nodename << " is too long, not stored" << endl;
+    return;
+  }
+  m_NodeNames.push_back(nodename);
+  m_NodeTypes.push_back(type);
+}
+
+int PHG4BackgroundLibraryWriter::InitRun(PHCompositeNode *topNode)
+{
+  if (m_Output.is_open())
+  {
+    // the library spans all runs of the input
+    return Fun4AllReturnCodes::EVENT_OK;
+  }
+  if (m_NodeNames.empty())
+  {
+    cout << PHWHERE << " no nodes to store, exiting" << endl;
+    return Fun4AllReturnCodes::ABORTRUN;
+  }
+
+  // written under a private name and renamed in End, so a library which is
+  // in use is never seen partially written
+  ostringstream tmpname;
+  tmpname << m_FileName << "." << getpid();
+  m_Output.open(tmpname.str().c_str(), ios::binary | ios::trunc);
+  if (!m_Output)
+  {
+    cout << PHWHERE << " could not open " << tmpname.str() << ", exiting" << endl;
+    return Fun4AllReturnCodes::ABORTRUN;
+  }
+
+  // the header is written again with the final counts in End
+  PHG4BackgroundLibrary::FileHeader header;
+  memset(&header, 0, sizeof(header));
+  m_Output.write(reinterpret_cast<const char *>(&header), sizeof(header));
+  for (unsigned int i = 0; i < m_NodeNames.size(); ++i)
+  {
+    PHG4BackgroundLibrary::NodeEntry node;
+    memset(&node, 0, sizeof(node));
+    node.type = m_NodeTypes[i];
+    node.record_size = PHG4BackgroundLibrary::RecordSize(m_NodeTypes[i]);
+    strncpy(node.name, m_NodeNames[i].c_str(), sizeof(node.name) - 1);
+    m_Output.write(reinterpret_cast<const char *>(&node), sizeof(node));
+  }
+  m_Position = sizeof(header) + m_NodeNames.size() * sizeof(PHG4BackgroundLibrary::NodeEntry);
+  return Fun4AllReturnCodes::EVENT_OK;
+}
+
+int PHG4BackgroundLibraryWriter::process_event(PHCompositeNode *topNode)
+{
+  vector<PHG4BackgroundLibrary::HitRecord> hits;
+  vector<PHG4BackgroundLibrary::CellRecord> cells;
+  vector<PHG4BackgroundLibrary::TowerRecord> towers;
+  for (unsigned int i = 0; i < m_NodeNames.size(); ++i)
+  {
+    PHG4BackgroundLibrary::IndexEntry entry;
+    entry.count = 0;
+    switch (m_NodeTypes[i])
+    {
+    case PHG4BackgroundLibrary::kHitSet:
+    {
+      TrkrHitSetContainer *hitsets = findNode::getClass<TrkrHitSetContainer>(topNode, m_NodeNames[i]);
+      if (hitsets)
+      {
+        PHG4BackgroundLibrary::FillRecords(hitsets, hits);
+        entry.count = hits.size();
+      }
+      entry.offset = WriteRecords(hits.data(), entry.count * sizeof(PHG4BackgroundLibrary::HitRecord));
+      break;
+    }
+    case PHG4BackgroundLibrary::kCell:
+    {
+      PHG4CellContainer *cellcontainer = findNode::getClass<PHG4CellContainer>(topNode, m_NodeNames[i]);
+      if (cellcontainer)
+      {
+        PHG4BackgroundLibrary::FillRecords(cellcontainer, cells);
+        entry.count = cells.size();
+      }
+      entry.offset = WriteRecords(cells.data(), entry.count * sizeof(PHG4BackgroundLibrary::CellRecord));
+      break;
+    }
+    case PHG4BackgroundLibrary::kTower:
+    {
+      RawTowerContainer *towercontainer = findNode::getClass<RawTowerContainer>(topNode, m_NodeNames[i]);
+      if (towercontainer)
+      {
+        PHG4BackgroundLibrary::FillRecords(towercontainer, towers);
+        entry.count = towers.size();
+      }
+      entry.offset = WriteRecords(towers.data(), entry.count * sizeof(PHG4BackgroundLibrary::TowerRecord));
+      break;
+    }
+    }
+    if (!entry.count && Verbosity() > 1)
+    {
+      cout << Name() << ": node " << m_NodeNames[i] << " empty or missing" << endl;
+    }
+    m_Index.push_back(entry);
+  }
+  if (!m_Output)
+  {
+    cout << PHWHERE << " error writing " << m_FileName << ", exiting" << endl;
+    return Fun4AllReturnCodes::ABORTRUN;
+  }
+  ++m_NEvents;
+  return Fun4AllReturnCodes::EVENT_OK;
+}
+
+int PHG4BackgroundLibraryWriter::End(PHCompositeNode *topNode)
+{
+  if (!m_Output.is_open())
+  {
+    return Fun4AllReturnCodes::EVENT_OK;
+  }
+  PHG4BackgroundLibrary::FileHeader header;
+  memset(&header, 0, sizeof(header));
+  memcpy(header.magic, PHG4BackgroundLibrary::magic, sizeof(header.magic));
+  header.version = PHG4BackgroundLibrary::version;
+  header.nnodes = m_NodeNames.size();
+  header.nevents = m_NEvents;
+  header.index_offset = WriteRecords(m_Index.data(), m_Index.size() * sizeof(PHG4BackgroundLibrary::IndexEntry));
+  m_Output.seekp(0);
+  m_Output.write(reinterpret_cast<const char *>(&header), sizeof(header));
+  m_Output.close();
+
+  ostringstream tmpname;
+  tmpname << m_FileName << "." << getpid();
+  if (!m_Output || rename(tmpname.str().c_str(), m_FileName.c_str()) != 0)
+  {
+    cout << PHWHERE << " error writing background library " << m_FileName << endl;
+    unlink(tmpname.str().c_str());
+    return Fun4AllReturnCodes::ABORTRUN;
+  }
+  cout << Name() << ": wrote " << m_NEvents << " background events to " << m_FileName
+       << " (" << m_Position / 1024 / 1024 << " MB)" << endl;
+  return Fun4AllReturnCodes::EVENT_OK;
+}
+
+uint64_t PHG4BackgroundLibraryWriter::WriteRecords(const void *data, const size_t size)
+{
+  static const char padding[8] = {0};
+  const size_t npad = (8 - m_Position % 8) % 8;
+  m_Output.write(padding, npad);
+  m_Position += npad;
+  const uint64_t offset = m_Position;
+  m_Output.write(static_cast<const char *>(data), size);
+  m_Position += size;
+  return offset;
+}
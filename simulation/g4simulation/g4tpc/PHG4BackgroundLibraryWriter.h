@@ -0,0 +1,63 @@
+// Tell emacs that this is a C++ source
+//  -*- C++ -*-.
+#ifndef G4TPC_PHG4BACKGROUNDLIBRARYWRITER_H
+#define G4TPC_PHG4BACKGROUNDLIBRARYWRITER_H
+
+#include "PHG4BackgroundLibrary.h"
+
+#include <fun4all/SubsysReco.h>
+
+#include <cstdint>
+#include <fstream>
+#include <string>
+#include <vector>
+
+class PHCompositeNode;
+
+/**
+ * Writes the selected hitset, cell and tower nodes of every event into a
+ * background library (see PHG4BackgroundLibrary), which
+ * PHG4BackgroundOverlay::SetBackgroundLibrary() samples from. Run it once
+ * over the background DSTs, a node missing in an event is stored empty.
+ */
+class PHG4BackgroundLibraryWriter : public SubsysReco
+{
+ public:
+  PHG4BackgroundLibraryWriter(const std::string &filename, const std::string &name = "PHG4BackgroundLibraryWriter");
+  virtual ~PHG4BackgroundLibraryWriter() {}
+
+  //! opens the library
+  int InitRun(PHCompositeNode *topNode);
+
+  //! appends the nodes of this event
+  int process_event(PHCompositeNode *topNode);
+
+  //! writes the index and closes the library
+  int End(PHCompositeNode *topNode);
+
+  //! TrkrHitSetContainer node to store, e.g. TRKR_HITSET
+  void AddHitSetNode(const std::string &nodename) { AddNode(nodename, PHG4BackgroundLibrary::kHitSet); }
+
+  //! PHG4CellContainer node to store, e.g. G4CELL_CEMC
+  void AddCellNode(const std::string &nodename) { AddNode(nodename, PHG4BackgroundLibrary::kCell); }
+
+  //! RawTowerContainer node to store, e.g. TOWER_SIM_CEMC
+  void AddTowerNode(const std::string &nodename) { AddNode(nodename, PHG4BackgroundLibrary::kTower); }
+
+ private:
+  void AddNode(const std::string &nodename, const PHG4BackgroundLibrary::NodeType type);
+  //! writes the records at the next 8 byte boundary, returns their offset
+  uint64_t WriteRecords(const void *data, const size_t size);
+
+  std::string m_FileName;
+  std::vector<std::string> m_NodeNames;
+  std::vector<PHG4BackgroundLibrary::NodeType> m_NodeTypes;
+
+  std::ofstream m_Output;
+  uint64_t m_Position;
+  //! (offset, count) of every event and node
+  std::vector<PHG4BackgroundLibrary::IndexEntry> m_Index;
+  uint64_t m_NEvents;
+};
+
+#endif  // G4TPC_PHG4BACKGROUNDLIBRARYWRITER_H
@@ -0,0 +1,5 @@
+#ifdef __CINT__
+
+#pragma link C++ class PHG4BackgroundLibraryWriter - !;
+
+#endif /* __CINT__ */
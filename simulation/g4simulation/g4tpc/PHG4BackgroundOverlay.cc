@@ -0,0 +1,479 @@
+#include "PHG4BackgroundOverlay.h"
+
+#include <g4detectors/PHG4Cell.h>
+#include <g4detectors/PHG4CellContainer.h>
+
+#include <calobase/RawTower.h>
+#include <calobase/RawTowerContainer.h>
+#include <calobase/RawTowerv1.h>
+
+#include <trackbase/TrkrHit.h>
+#include <trackbase/TrkrHitSet.h>
+#include <trackbase/TrkrHitSetContainer.h>
+
+#include <tpc/TpcDefs.h>
+
+#include <fun4all/Fun4AllReturnCodes.h>
+
+#include <phool/PHCompositeNode.h>
+#include <phool/PHNodeIOManager.h>
+#include <phool/PHRandomSeed.h>
+#include <phool/getClass.h>
+#include <phool/phool.h>
+
+#include <gsl/gsl_rng.h>
+
+#include <cmath>
+#include <iostream>
+
+using namespace std;
+
+PHG4BackgroundOverlay::PHG4BackgroundOverlay(const string &name)
+  : SubsysReco(name)
+  , m_PoolSize(1)
+  , m_Reuse(1)
+  , m_TpcTimeBinShift(0)
+  , m_IManager(nullptr)
+  , m_BackgroundNode(nullptr)
+  , m_FileIndex(-1)
+  , m_PoolIndex(0)
+  , m_NBackgroundEvents(0)
+  , m_NOverlays(0)
+{
+  unsigned int seed = PHRandomSeed();  // fixed seed is handled in this funtcion
+  m_RandomGenerator = gsl_rng_alloc(gsl_rng_mt19937);
+  gsl_rng_set(m_RandomGenerator, seed);
+}
+
+PHG4BackgroundOverlay::~PHG4BackgroundOverlay()
+{
+  // the io manager detaches from the nodes when it is deleted
+  delete m_IManager;
+  delete m_BackgroundNode;
+  for (auto &prototype : m_HitPrototypes)
+  {
+    delete prototype.second;
+  }
+  gsl_rng_free(m_RandomGenerator);
+}
+
+int PHG4BackgroundOverlay::InitRun(PHCompositeNode *topNode)
+{
+  if (m_FileNames.empty() && m_LibraryName.empty())
+  {
+    cout << PHWHERE << " no background file given, exiting" << endl;
+    return Fun4AllReturnCodes::ABORTRUN;
+  }
+  for (const auto &nodename : m_HitSetNodes)
+  {
+    if (!findNode::getClass<TrkrHitSetContainer>(topNode, nodename))
+    {
+      cout << PHWHERE << " signal node " << nodename << " missing, exiting" << endl;
+      return Fun4AllReturnCodes::ABORTRUN;
+    }
+  }
+  for (const auto &nodename : m_CellNodes)
+  {
+    if (!findNode::getClass<PHG4CellContainer>(topNode, nodename))
+    {
+      cout << PHWHERE << " signal node " << nodename << " missing, exiting" << endl;
+      return Fun4AllReturnCodes::ABORTRUN;
+    }
+  }
+  for (const auto &nodename : m_TowerNodes)
+  {
+    if (!findNode::getClass<RawTowerContainer>(topNode, nodename))
+    {
+      cout << PHWHERE << " signal node " << nodename << " missing, exiting" << endl;
+      return Fun4AllReturnCodes::ABORTRUN;
+    }
+  }
+
+  if (!m_LibraryName.empty())
+  {
+    if (!m_Library.IsOpen())
+    {
+      if (!m_Library.Open(m_LibraryName))
+      {
+        return Fun4AllReturnCodes::ABORTRUN;
+      }
+      if (m_Library.NEvents() == 0)
+      {
+        cout << PHWHERE << " background library " << m_LibraryName << " has no events, exiting" << endl;
+        return Fun4AllReturnCodes::ABORTRUN;
+      }
+      // the nodes in the order hitsets, cells, towers
+      m_LibraryNodes.clear();
+      const vector<string> *nodenames[3] = {&m_HitSetNodes, &m_CellNodes, &m_TowerNodes};
+      const PHG4BackgroundLibrary::NodeType types[3] = {PHG4BackgroundLibrary::kHitSet, PHG4BackgroundLibrary::kCell, PHG4BackgroundLibrary::kTower};
+      for (int itype = 0; itype < 3; ++itype)
+      {
+        for (const auto &nodename : *nodenames[itype])
+        {
+          const int node = m_Library.FindNode(nodename, types[itype]);
+          if (node < 0)
+          {
+            cout << PHWHERE << " node " << nodename << " not in background library " << m_LibraryName << ", exiting" << endl;
+            return Fun4AllReturnCodes::ABORTRUN;
+          }
+          m_LibraryNodes.push_back(node);
+        }
+      }
+    }
+    if (Verbosity() > 0)
+    {
+      cout << Name() << ": sampling from " << m_Library.NEvents() << " background events in " << m_LibraryName << endl;
+    }
+    return Fun4AllReturnCodes::EVENT_OK;
+  }
+
+  // fill the pool, an event is replaced once it was used m_Reuse times
+  if (m_Pool.empty())
+  {
+    m_Pool.resize(m_PoolSize);
+    for (auto &event : m_Pool)
+    {
+      if (!ReadEvent(event))
+      {
+        return Fun4AllReturnCodes::ABORTRUN;
+      }
+    }
+  }
+
+  if (Verbosity() > 0)
+  {
+    cout << Name() << ": pool of " << m_Pool.size() << " background events, each used "
+         << m_Reuse << " times, TPC time bin shift " << m_TpcTimeBinShift << endl;
+  }
+  return Fun4AllReturnCodes::EVENT_OK;
+}
+
+int PHG4BackgroundOverlay::process_event(PHCompositeNode *topNode)
+{
+  const int iret = m_Library.IsOpen() ? OverlayLibraryEvent(topNode) : OverlayPoolEvent(topNode);
+  if (iret == Fun4AllReturnCodes::EVENT_OK)
+  {
+    ++m_NOverlays;
+  }
+  return iret;
+}
+
+int PHG4BackgroundOverlay::End(PHCompositeNode *topNode)
+{
+  if (Verbosity() > 0)
+  {
+    cout << Name() << ": " << m_NBackgroundEvents << " background events read for "
+         << m_NOverlays << " signal events" << endl;
+  }
+  return Fun4AllReturnCodes::EVENT_OK;
+}
+
+int PHG4BackgroundOverlay::OverlayPoolEvent(PHCompositeNode *topNode)
+{
+  BackgroundEvent &event = m_Pool[m_PoolIndex];
+  if (event.nused >= m_Reuse)
+  {
+    if (!ReadEvent(event))
+    {
+      return Fun4AllReturnCodes::ABORTRUN;
+    }
+  }
+
+  const int tbinshift = static_cast<int>(event.nused) * m_TpcTimeBinShift;
+  for (unsigned int i = 0; i < m_HitSetNodes.size(); ++i)
+  {
+    TrkrHitSetContainer *hitsets = findNode::getClass<TrkrHitSetContainer>(topNode, m_HitSetNodes[i]);
+    if (!hitsets)
+    {
+      cout << PHWHERE << " signal node " << m_HitSetNodes[i] << " missing" << endl;
+      return Fun4AllReturnCodes::ABORTEVENT;
+    }
+    OverlayHits(hitsets, event.hits[i].data(), event.hits[i].size(), tbinshift);
+  }
+  for (unsigned int i = 0; i < m_CellNodes.size(); ++i)
+  {
+    PHG4CellContainer *cells = findNode::getClass<PHG4CellContainer>(topNode, m_CellNodes[i]);
+    if (!cells)
+    {
+      cout << PHWHERE << " signal node " << m_CellNodes[i] << " missing" << endl;
+      return Fun4AllReturnCodes::ABORTEVENT;
+    }
+    OverlayCells(cells, event.cells[i].data(), event.cells[i].size());
+  }
+  for (unsigned int i = 0; i < m_TowerNodes.size(); ++i)
+  {
+    RawTowerContainer *towers = findNode::getClass<RawTowerContainer>(topNode, m_TowerNodes[i]);
+    if (!towers)
+    {
+      cout << PHWHERE << " signal node " << m_TowerNodes[i] << " missing" << endl;
+      return Fun4AllReturnCodes::ABORTEVENT;
+    }
+    OverlayTowers(towers, event.towers[i].data(), event.towers[i].size());
+  }
+
+  ++event.nused;
+  // consecutive signal events get different background events
+  m_PoolIndex = (m_PoolIndex + 1) % m_Pool.size();
+  return Fun4AllReturnCodes::EVENT_OK;
+}
+
+int PHG4BackgroundOverlay::OverlayLibraryEvent(PHCompositeNode *topNode)
+{
+  const uint64_t event = gsl_rng_uniform_int(m_RandomGenerator, m_Library.NEvents());
+  if (Verbosity() > 1)
+  {
+    cout << Name() << ": overlaying background library event " << event << endl;
+  }
+
+  vector<int>::const_iterator node = m_LibraryNodes.begin();
+  size_t n = 0;
+  for (const auto &nodename : m_HitSetNodes)
+  {
+    TrkrHitSetContainer *hitsets = findNode::getClass<TrkrHitSetContainer>(topNode, nodename);
+    if (!hitsets)
+    {
+      cout << PHWHERE << " signal node " << nodename << " missing" << endl;
+      return Fun4AllReturnCodes::ABORTEVENT;
+    }
+    const HitRecord *records = m_Library.GetHits(event, *node++, n);
+    OverlayHits(hitsets, records, n, 0);
+  }
+  for (const auto &nodename : m_CellNodes)
+  {
+    PHG4CellContainer *cells = findNode::getClass<PHG4CellContainer>(topNode, nodename);
+    if (!cells)
+    {
+      cout << PHWHERE << " signal node " << nodename << " missing" << endl;
+      return Fun4AllReturnCodes::ABORTEVENT;
+    }
+    const CellRecord *records = m_Library.GetCells(event, *node++, n);
+    OverlayCells(cells, records, n);
+  }
+  for (const auto &nodename : m_TowerNodes)
+  {
+    RawTowerContainer *towers = findNode::getClass<RawTowerContainer>(topNode, nodename);
+    if (!towers)
+    {
+      cout << PHWHERE << " signal node " << nodename << " missing" << endl;
+      return Fun4AllReturnCodes::ABORTEVENT;
+    }
+    const TowerRecord *records = m_Library.GetTowers(event, *node++, n);
+    OverlayTowers(towers, records, n);
+  }
+  ++m_NBackgroundEvents;
+  return Fun4AllReturnCodes::EVENT_OK;
+}
+
+bool PHG4BackgroundOverlay::OpenNextFile()
+{
+  delete m_IManager;
+  delete m_BackgroundNode;
+
+  m_FileIndex = (m_FileIndex + 1) % m_FileNames.size();
+  m_BackgroundNode = new PHCompositeNode("BACKGROUND");
+  m_IManager = new PHNodeIOManager(m_FileNames[m_FileIndex], PHReadOnly);
+  if (!m_IManager->isFunctional())
+  {
+    cout << PHWHERE << " could not open " << m_FileNames[m_FileIndex] << endl;
+    return false;
+  }
+  // only the overlaid nodes are deserialized
+  m_IManager->SetLazyLoading(true);
+  if (Verbosity() > 0)
+  {
+    cout << Name() << ": reading background from " << m_FileNames[m_FileIndex] << endl;
+  }
+  return true;
+}
+
+bool PHG4BackgroundOverlay::ReadEvent(BackgroundEvent &event)
+{
+  // at the end of a file continue with the next one, the files wrap around
+  bool ok = m_IManager && m_IManager->read(m_BackgroundNode);
+  for (unsigned int i = 0; !ok && i < m_FileNames.size(); ++i)
+  {
+    ok = OpenNextFile() && m_IManager->read(m_BackgroundNode);
+  }
+  if (!ok)
+  {
+    cout << PHWHERE << " no background events could be read, exiting" << endl;
+    return false;
+  }
+
+  event.hits.resize(m_HitSetNodes.size());
+  for (unsigned int i = 0; i < m_HitSetNodes.size(); ++i)
+  {
+    event.hits[i].clear();
+    TrkrHitSetContainer *hitsets = findNode::getClass<TrkrHitSetContainer>(m_BackgroundNode, m_HitSetNodes[i]);
+    if (!hitsets)
+    {
+      cout << PHWHERE << " background node " << m_HitSetNodes[i] << " missing in "
+           << m_FileNames[m_FileIndex] << endl;
+      continue;
+    }
+    PHG4BackgroundLibrary::FillRecords(hitsets, event.hits[i]);
+    // the background hits are prototypes for the trackers without signal hits
+    for (const auto &record : event.hits[i])
+    {
+      GetPrototype(hitsets, record.hitsetkey);
+    }
+  }
+
+  event.cells.resize(m_CellNodes.size());
+  for (unsigned int i = 0; i < m_CellNodes.size(); ++i)
+  {
+    event.cells[i].clear();
+    PHG4CellContainer *cells = findNode::getClass<PHG4CellContainer>(m_BackgroundNode, m_CellNodes[i]);
+    if (!cells)
+    {
+      cout << PHWHERE << " background node " << m_CellNodes[i] << " missing in "
+           << m_FileNames[m_FileIndex] << endl;
+      continue;
+    }
+    PHG4BackgroundLibrary::FillRecords(cells, event.cells[i]);
+  }
+
+  event.towers.resize(m_TowerNodes.size());
+  for (unsigned int i = 0; i < m_TowerNodes.size(); ++i)
+  {
+    event.towers[i].clear();
+    RawTowerContainer *towers = findNode::getClass<RawTowerContainer>(m_BackgroundNode, m_TowerNodes[i]);
+    if (!towers)
+    {
+      cout << PHWHERE << " background node " << m_TowerNodes[i] << " missing in "
+           << m_FileNames[m_FileIndex] << endl;
+      continue;
+    }
+    PHG4BackgroundLibrary::FillRecords(towers, event.towers[i]);
+  }
+
+  event.nused = 0;
+  ++m_NBackgroundEvents;
+  return true;
+}
+
+TrkrHit *PHG4BackgroundOverlay::GetPrototype(TrkrHitSetContainer *hitsets, const TrkrDefs::hitsetkey hitsetkey)
+{
+  const TrkrDefs::TrkrId trkrid = static_cast<TrkrDefs::TrkrId>(TrkrDefs::getTrkrId(hitsetkey));
+  auto iter = m_HitPrototypes.find(trkrid);
+  if (iter != m_HitPrototypes.end())
+  {
+    return iter->second;
+  }
+  // clone any hit of this tracker in the container
+  TrkrHitSetContainer::ConstRange hitsetrange = hitsets->getHitSets(trkrid);
+  for (TrkrHitSetContainer::ConstIterator hitsetiter = hitsetrange.first; hitsetiter != hitsetrange.second; ++hitsetiter)
+  {
+    TrkrHitSet::ConstRange hitrange = hitsetiter->second->getHits();
+    if (hitrange.first != hitrange.second)
+    {
+      TrkrHit *prototype = static_cast<TrkrHit *>(hitrange.first->second->CloneMe());
+      if (prototype)
+      {
+        prototype->Reset();
+        m_HitPrototypes[trkrid] = prototype;
+      }
+      return prototype;
+    }
+  }
+  return nullptr;
+}
+
+void PHG4BackgroundOverlay::OverlayHits(TrkrHitSetContainer *hitsets, const HitRecord *records, const size_t n, const int tbinshift)
+{
+  // hitsets which are not in the signal, added at the end in one go
+  TrkrHitSetContainer::Map newhitsets;
+
+  const HitRecord *record = records;
+  const HitRecord *end = records + n;
+  while (record != end)
+  {
+    const TrkrDefs::hitsetkey hitsetkey = record->hitsetkey;
+    const bool istpc = (TrkrDefs::getTrkrId(hitsetkey) == TrkrDefs::tpcId);
+    TrkrHit *prototype = GetPrototype(hitsets, hitsetkey);
+    if (!prototype && Verbosity() > 0)
+    {
+      cout << PHWHERE << " no hit type known for hitset " << hitsetkey << ", background hits dropped" << endl;
+    }
+
+    TrkrHitSet *hitset = hitsets->findHitSet(hitsetkey);
+    if (!hitset && prototype)
+    {
+      hitset = new TrkrHitSet();
+      hitset->setHitSetKey(hitsetkey);
+      newhitsets.push_back(make_pair(hitsetkey, hitset));
+    }
+
+    for (; record != end && record->hitsetkey == hitsetkey; ++record)
+    {
+      if (!prototype)
+      {
+        continue;
+      }
+      TrkrDefs::hitkey hitkey = record->hitkey;
+      if (istpc && tbinshift != 0)
+      {
+        const int tbin = TpcDefs::getTBin(hitkey) + tbinshift;
+        if (tbin < 0 || tbin >= TpcDefs::MAXTBIN)
+        {
+          continue;
+        }
+        hitkey = TpcDefs::genHitKey(TpcDefs::getPad(hitkey), tbin);
+      }
+      TrkrHit *hit = hitset->getHit(hitkey);
+      if (!hit)
+      {
+        hit = static_cast<TrkrHit *>(prototype->CloneMe());
+        hitset->addHitSpecificKey(hitkey, hit);
+      }
+      hit->addEnergy(record->edep);
+      hit->setAdc(hit->getAdc() + record->adc);
+    }
+  }
+
+  if (!newhitsets.empty())
+  {
+    hitsets->addHitSets(newhitsets);
+  }
+}
+
+void PHG4BackgroundOverlay::OverlayCells(PHG4CellContainer *cells, const CellRecord *records, const size_t n) const
+{
+  for (const CellRecord *record = records; record != records + n; ++record)
+  {
+    PHG4Cell *cell = cells->findOrAddCell(record->key)->second;
+    // properties the background cell did not have are NaN
+    if (isfinite(record->edep))
+    {
+      cell->add_edep(record->edep);
+    }
+    if (isfinite(record->eion))
+    {
+      cell->add_eion(record->eion);
+    }
+    if (isfinite(record->light_yield))
+    {
+      cell->add_light_yield(record->light_yield);
+    }
+  }
+}
+
+void PHG4BackgroundOverlay::OverlayTowers(RawTowerContainer *towers, const TowerRecord *records, const size_t n) const
+{
+  for (const TowerRecord *record = records; record != records + n; ++record)
+  {
+    RawTower *tower = towers->getTower(record->key);
+    if (tower)
+    {
+      // the signal keeps its time
+      tower->set_energy(tower->get_energy() + record->energy);
+    }
+    else
+    {
+      tower = new RawTowerv1(record->key);
+      tower->set_energy(record->energy);
+      tower->set_time(record->time);
+      towers->AddTower(record->key, tower);
+    }
+  }
+}
@@ -0,0 +1,155 @@
+// Tell emacs that this is a C++ source
+//  -*- C++ -*-.
+#ifndef G4TPC_PHG4BACKGROUNDOVERLAY_H
+#define G4TPC_PHG4BACKGROUNDOVERLAY_H
+
+#include "PHG4BackgroundLibrary.h"
+
+#include <fun4all/SubsysReco.h>
+
+#include <trackbase/TrkrDefs.h>
+
+#include <cstddef>
+#include <map>
+#include <string>
+#include <vector>
+
+// rootcint barfs with this header so we need to hide it
+#if !defined(__CINT__) || defined(__CLING__)
+#include <gsl/gsl_rng.h>
+#endif
+
+class PHCompositeNode;
+class PHG4CellContainer;
+class PHNodeIOManager;
+class RawTowerContainer;
+class TrkrHit;
+class TrkrHitSetContainer;
+
+/**
+ * Overlays background events on the signal hits of the current event.
+ *
+ * The background DSTs are read by the module itself (lazy loading, only the
+ * selected hitset, cell and tower nodes are deserialized) and kept in a pool
+ * of events in compact form: per node one flat vector of
+ * PHG4BackgroundLibrary records sorted by key. Each event the next pool
+ * entry is added to the signal containers of the same name, hitset by
+ * hitset, the hitsets which only exist in the background are added to the
+ * container in one go.
+ *
+ * A background event is used set_reuse() times before it is replaced by
+ * the next event of the files (which wrap around). In the TPC the n-th use
+ * is shifted by n * set_tpc_time_bin_shift() time bins, hits shifted out of
+ * the readout window are dropped. Truth associations are not overlaid.
+ *
+ * With SetBackgroundLibrary() the background is instead sampled at random
+ * from a memory mapped background library (PHG4BackgroundLibraryWriter)
+ * and overlaid from the mapped records, without shift. The pool settings
+ * and background files are not used then.
+ *
+ * Run it after the signal hits are made and before the digitizers.
+ */
+class PHG4BackgroundOverlay : public SubsysReco
+{
+ public:
+  PHG4BackgroundOverlay(const std::string &name = "PHG4BackgroundOverlay");
+  virtual ~PHG4BackgroundOverlay();
+
+  //! run initialization
+  int InitRun(PHCompositeNode *topNode);
+
+  //! event processing
+  int process_event(PHCompositeNode *topNode);
+
+  //! end of process
+  int End(PHCompositeNode *topNode);
+
+  //! background DST, used in the order they are added
+  void AddBackgroundFile(const std::string &filename) { m_FileNames.push_back(filename); }
+
+  //! TrkrHitSetContainer node to overlay, e.g. TRKR_HITSET
+  void AddHitSetNode(const std::string &nodename) { m_HitSetNodes.push_back(nodename); }
+
+  //! PHG4CellContainer node to overlay, e.g. G4CELL_CEMC
+  void AddCellNode(const std::string &nodename) { m_CellNodes.push_back(nodename); }
+
+  //! RawTowerContainer node to overlay, e.g. TOWER_SIM_CEMC
+  void AddTowerNode(const std::string &nodename) { m_TowerNodes.push_back(nodename); }
+
+  //! sample the background from a background library instead of DSTs
+  void SetBackgroundLibrary(const std::string &filename) { m_LibraryName = filename; }
+
+  //! number of background events kept in memory
+  void set_pool_size(const unsigned int n) { m_PoolSize = (n > 0 ? n : 1); }
+
+  //! number of signal events each background event is overlaid on
+  void set_reuse(const unsigned int n) { m_Reuse = (n > 0 ? n : 1); }
+
+  //! TPC time bin shift between two uses of the same background event
+  void set_tpc_time_bin_shift(const int shift) { m_TpcTimeBinShift = shift; }
+
+ private:
+  typedef PHG4BackgroundLibrary::HitRecord HitRecord;
+  typedef PHG4BackgroundLibrary::CellRecord CellRecord;
+  typedef PHG4BackgroundLibrary::TowerRecord TowerRecord;
+
+  struct BackgroundEvent
+  {
+    //! one vector per hitset node, sorted by hitset and hit key
+    std::vector<std::vector<HitRecord> > hits;
+    //! one vector per cell node, sorted by cell key
+    std::vector<std::vector<CellRecord> > cells;
+    //! one vector per tower node, sorted by tower key
+    std::vector<std::vector<TowerRecord> > towers;
+    //! number of signal events it was overlaid on
+    unsigned int nused;
+  };
+
+  //! opens the next background file, false if none has events
+  bool OpenNextFile();
+  //! reads the next background event into the pool entry
+  bool ReadEvent(BackgroundEvent &event);
+  //! overlays the next pool entry
+  int OverlayPoolEvent(PHCompositeNode *topNode);
+  //! overlays a random event of the library
+  int OverlayLibraryEvent(PHCompositeNode *topNode);
+  void OverlayHits(TrkrHitSetContainer *hitsets, const HitRecord *records, const size_t n, const int tbinshift);
+  void OverlayCells(PHG4CellContainer *cells, const CellRecord *records, const size_t n) const;
+  void OverlayTowers(RawTowerContainer *towers, const TowerRecord *records, const size_t n) const;
+  //! empty hit of the tracker of a hitset, nullptr if no hit of it was seen yet
+  TrkrHit *GetPrototype(TrkrHitSetContainer *hitsets, const TrkrDefs::hitsetkey hitsetkey);
+
+  std::vector<std::string> m_FileNames;
+  std::vector<std::string> m_HitSetNodes;
+  std::vector<std::string> m_CellNodes;
+  std::vector<std::string> m_TowerNodes;
+
+  unsigned int m_PoolSize;
+  unsigned int m_Reuse;
+  int m_TpcTimeBinShift;
+
+  //! background input
+  PHNodeIOManager *m_IManager;
+  PHCompositeNode *m_BackgroundNode;
+  int m_FileIndex;
+
+  std::vector<BackgroundEvent> m_Pool;
+  unsigned int m_PoolIndex;
+
+  //! background library input
+  std::string m_LibraryName;
+  PHG4BackgroundLibrary m_Library;
+  //! position of each hitset, cell and tower node in the library
+  std::vector<int> m_LibraryNodes;
+#if !defined(__CINT__) || defined(__CLING__)
+  gsl_rng *m_RandomGenerator;
+#endif
+
+  //! empty hit of each tracker, cloned for hits which only exist in the background
+  std::map<TrkrDefs::TrkrId, TrkrHit *> m_HitPrototypes;
+
+  unsigned long m_NBackgroundEvents;
+  unsigned long m_NOverlays;
+};
+
+#endif  // G4TPC_PHG4BACKGROUNDOVERLAY_H
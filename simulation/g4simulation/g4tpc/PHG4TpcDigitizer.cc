@@ -16,19 +16,19 @@
 #include <fun4all/SubsysReco.h>                         // for SubsysReco
 #
 #include <phool/PHCompositeNode.h>
+#include <phool/PHCounterRng.h>
 #include <phool/PHNode.h>                               // for PHNode
 #include <phool/PHNodeIterator.h>
-#include <phool/PHRandomSeed.h>
 #include <phool/getClass.h>
 #include <phool/phool.h>                                // for PHWHERE
 
-#include <gsl/gsl_rng.h>                                // for gsl_rng_alloc
-#include <gsl/gsl_randist.h>
-
+#include <algorithm>                                    // for max, min
+#include <atomic>
 #include <cstdlib>                                     // for exit
 #include <iostream>
 #include <limits>
 #include <memory>                                       // for allocator_tra...
+#include <thread>
 
 using namespace std;
 
@@ -46,11 +46,9 @@ PHG4TpcDigitizer::PHG4TpcDigitizer(const string &name)
   ADCSignalConversionGain(numeric_limits<float>::signaling_NaN())
   ,  // will be assigned in PHG4TpcDigitizer::InitRun
   ADCNoiseConversionGain(numeric_limits<float>::signaling_NaN())  // will be assigned in PHG4TpcDigitizer::InitRun
+  , m_NThreads(1)
 {
-  unsigned int seed = PHRandomSeed();  // fixed seed is handled in this funtcion
-  cout << Name() << " random seed: " << seed << endl;
-  RandomGenerator = gsl_rng_alloc(gsl_rng_mt19937);
-  gsl_rng_set(RandomGenerator, seed);
+  m_Rng = new PHCounterRng(Name());
 
   if (Verbosity() > 0)
     cout << "Creating PHG4TpcDigitizer with name = " << name << endl;
@@ -58,7 +56,7 @@ PHG4TpcDigitizer::PHG4TpcDigitizer(const string &name)
 
 PHG4TpcDigitizer::~PHG4TpcDigitizer()
 {
-  gsl_rng_free(RandomGenerator);
+  delete m_Rng;
 }
 
 int PHG4TpcDigitizer::InitRun(PHCompositeNode *topNode)
@@ -245,255 +243,78 @@ void PHG4TpcDigitizer::DigitizeCylinderCells(PHCompositeNode *topNode)
   // Digitization
   //-------------
 
-  // Loop over all hitsets for the Tpc
+  // the noise of every bin is drawn by its index in the event stream, so the
+  // result is the same for any number of threads. The workers only change
+  // existing hits, the hits for noise above threshold are created afterwards
+  struct HitSetTask
+  {
+    TrkrHitSet *hitset;
+    int nzbins;
+    std::vector<NoiseHit> noisehits;
+  };
+  std::vector<HitSetTask> tasks;
   TrkrHitSetContainer::ConstRange hitset_range = trkrhitsetcontainer->getHitSets(TrkrDefs::TrkrId::tpcId);
   for (TrkrHitSetContainer::ConstIterator hitset_iter = hitset_range.first;
        hitset_iter != hitset_range.second;
        ++hitset_iter)
     {
-      // we have an itrator to one TrkrHitSet for the Tpc from the trkrHitSetContainer
-      // get the hitset key so we can find the layer
-      TrkrDefs::hitsetkey hitsetkey = hitset_iter->first;
-      const unsigned int layer = TrkrDefs::getLayer(hitsetkey);
+      const unsigned int layer = TrkrDefs::getLayer(hitset_iter->first);
 
       if(Verbosity() > 2)
 	if(layer == print_layer) 
-	  cout << "new: PHG4TpcDigitizer:  processing hits for layer " << layer << " hitsetkey " << hitsetkey << endl;
+	  cout << "new: PHG4TpcDigitizer:  processing hits for layer " << layer << " hitsetkey " << hitset_iter->first << endl;
 
       // we need the geometry object for this layer
       PHG4CylinderCellGeom *layergeom = geom_container->GetLayerCellGeom(layer);
       if (!layergeom)
 	exit(1);
 
-      // for this hitset, make a vector of a vector of cells for each phibin
-      phi_sorted_hits.clear();
-      
-      // start with an empty vector of cells for each phibin      
-      int nphibins = layergeom->get_phibins();
-      for (int iphi = 0; iphi < nphibins; iphi++)
-	{
-	  phi_sorted_hits.push_back(std::vector<TrkrHitSet::ConstIterator>());
-	}      
-      
-      // get all of the hits from this hitset      
-      TrkrHitSet *hitset = hitset_iter->second;
-      TrkrHitSet::ConstRange hit_range = hitset->getHits();
-      for(TrkrHitSet::ConstIterator hit_iter = hit_range.first;
-	  hit_iter != hit_range.second;
-	  ++hit_iter)
+      HitSetTask task;
+      task.hitset = hitset_iter->second;
+      task.nzbins = layergeom->get_zbins();
+      tasks.push_back(task);
+    }
+
+  // the hitsets are independent, the workers take the next one until all are done
+  std::atomic<unsigned int> next_task(0);
+  auto worker = [&]() {
+    std::vector<double> noise;
+    std::vector<float> adc_input;
+    std::vector<unsigned char> above;
+    for (unsigned int itask = next_task++; itask < tasks.size(); itask = next_task++)
+    {
+      DigitizeHitSet(tasks[itask].hitset, tasks[itask].nzbins, noise, adc_input, above, tasks[itask].noisehits);
+    }
+  };
+  const unsigned int nthreads = std::min<unsigned int>(m_NThreads, tasks.size());
+  if (nthreads <= 1)
+    {
+      worker();
+    }
+  else
+    {
+      std::vector<std::thread> threads;
+      for (unsigned int i = 0; i < nthreads; i++)
 	{
-	  // Fill the vector of hits for each phibin
-	  unsigned int phibin = TpcDefs::getPad(hit_iter->first);
-	  phi_sorted_hits[phibin].push_back(hit_iter);
+	  threads.push_back(std::thread(worker));
 	}
-	  	  
-      // For this hitset we have the hits sorted into vectors for each phi
-      // process these vectors one phi bin at a time
-      for (unsigned int iphi = 0; iphi < phi_sorted_hits.size(); iphi++)
+      for (unsigned int i = 0; i < threads.size(); i++)
 	{
-	  if (phi_sorted_hits[iphi].size() == 0)
-	    continue;
-	  
-	  // Populate a vector of hits ordered by Z for each phibin
-	  int nzbins = layergeom->get_zbins();
-	  is_populated.clear();
-	  is_populated.assign(nzbins, 2);  // mark all as noise only for now
-	  z_sorted_hits.clear();
-	      
-	  // add an empty vector for each z bin
-	  for (int iz = 0; iz < nzbins; iz++)
-	    z_sorted_hits.push_back(std::vector<TrkrHitSet::ConstIterator>());
-
-	  if(Verbosity() > 2)
-	    if(layer == print_layer) cout << endl;	  
+	  threads[i].join();
+	}
+    }
 
-	  // add a hit for each z bin that has one
-	  for (unsigned int iz = 0; iz < phi_sorted_hits[iphi].size(); iz++)
-	    {
-	      int zbin = TpcDefs::getTBin(phi_sorted_hits[iphi][iz]->first);
-	      is_populated[zbin] = 1;  // this bin is a associated with a hit
-	      z_sorted_hits[zbin].push_back(phi_sorted_hits[iphi][iz]);
-
-	      if(Verbosity() > 2)
-		if(layer == print_layer)  
-		  {
-		    TrkrDefs::hitkey hitkey =  phi_sorted_hits[iphi][iz]->first ;
-		    cout << "Adding hit to z vector for zbin " << zbin << "  hitkey " << hitkey << " pad " << TpcDefs::getPad(hitkey) 
-			 << " z bin " << TpcDefs::getTBin(hitkey)   << "  energy " <<( phi_sorted_hits[iphi][iz]->second)->getEnergy() 
-			 << endl;
-		  }
-	    }
-	      
-	  adc_input.clear();
-	  adc_hitid.clear();
-	  // Now for this phibin we process all bins ordered by Z into hits with noise
-	  //======================================================
-	  // For this step we take the edep value and convert it to mV at the ADC input
-	  // See comments above for how to do this for signal and noise
-	      
-	  for (int iz = 0; iz < nzbins; iz++)
-	    {
-	      if (is_populated[iz] == 1)
-		{
-		  // This zbin has a hit, add noise
-		  float noise = added_noise();                                                                                       // in electrons
-		  float noise_voltage = (Pedestal + noise) * ADCNoiseConversionGain;                      // mV - from definition of noise charge and pedestal charge
-		  float adc_input_voltage = (z_sorted_hits[iz][0]->second)->getEnergy() * ADCSignalConversionGain;  // mV, see comments above
-		  
-		  adc_input.push_back(adc_input_voltage + noise_voltage);
-		  adc_hitid.push_back(z_sorted_hits[iz][0]->first);
-
-		  if(Verbosity() > 2)
-		  if(layer == print_layer) 
-		      cout << "new: iphi " << iphi  << " iz " << iz << " edep " <<  (z_sorted_hits[iz][0]->second)->getEnergy() 
-			   << " adc gain " << ADCSignalConversionGain << " adc_input_voltage " << adc_input_voltage << " noise voltage " << noise_voltage 
-			   <<  " adc_input " << adc_input[iz] << endl;
-		}
-	      else if (is_populated[iz] == 2)
-		{
-		  // This z bin does not have a filled cell, add noise
-		  float noise = added_noise();                                        // returns "electrons"
-		  float noise_voltage = (Pedestal + noise) * ADCNoiseConversionGain;  // mV - noise "electrons" x conversion gain
-		  
-		  adc_input.push_back(noise_voltage);  // mV
-		  adc_hitid.push_back(0);             // there is no hit, just add a placeholder in the vector for now, replace it later
-		}
-	      else
-		{
-		  // Cannot happen
-		  cout << "Impossible value of is_populated, iz = " << iz << " is_populated = " << is_populated[iz] << endl;
-		  exit(-1);
-		}
-	    }
-	  
-	  // Now we can digitize the entire stream of z bins for this phi bin
-	      
-	  // start with negative z, the first to arrive is bin 0
-	  //================================
-	  int binpointer = 0;
-	  for (int iz = 0; iz < nzbins / 2; iz++)  // 0-247
-	    {
-	      if (iz < binpointer) continue;
-
-	      if (adc_input[iz] > ADCThreshold * ADCNoiseConversionGain)  // convert threshold in "equivalent electrons" to mV
-		{
-		  // digitize this bin and the following 4 bins
-		  
-		  if (Verbosity() > 100)
-		    if (layer == print_layer) cout << endl
-						   << "new:   (neg z) Above threshold of " << ADCThreshold * ADCNoiseConversionGain << " for phibin " << iphi
-						   << " iz " << iz << " with adc_input " << adc_input[iz] << " digitize this and 4 following bins: " << endl;
-		  
-		  for (int izup = 0; izup < 5; izup++)
-		    {
-		      if (iz + izup < nzbins / 2 && iz + izup >= 0)   // stay within the bin limits for negative z
-			{
-			  unsigned int adc_output = (unsigned int) (adc_input[iz + izup] * 1024.0 / 2200.0);  // input voltage x 1024 channels over 2200 mV max range
-			  if (adc_input[iz + izup] < 0) adc_output = 0;
-			  if (adc_output > 1023) adc_output = 1023;
-			  
-			  if (Verbosity() > 100)
-			  if (layer == print_layer) cout << "new:  iphi " << iphi << "  (neg z) iz+izup " << iz + izup << " adc_hitid " << adc_hitid[iz + izup]
-							   << "  adc_input " << adc_input[iz + izup] << " ADCThreshold " << ADCThreshold * ADCNoiseConversionGain
-							   << " adc_output " << adc_output << endl;
-			  
-			  // Get the hitkey
-			  TrkrDefs::hitkey hitkey = TpcDefs::genHitKey(iphi, iz+izup);
-			  TrkrHit *hit = nullptr;
-			  hit = hitset_iter->second->getHit(hitkey);
-			  
-			  // noise bins do not have TrkrHits associated with them, have to make one
-			  if(!hit)
-			    {
-			      hit = new TpcHit();
-			      hitset_iter->second->addHitSpecificKey(hitkey, hit);
-			      hit->addEnergy(adc_input[iz+izup]);
-			      
-			      if (Verbosity() > 100)
-				if (layer == print_layer) cout << "new:  adding noise hit for iphi " << iphi << " zbin " << iz + izup
-							       << " created new hit with hitkey " << hitkey
-							       << " energy " << adc_input[iz + izup] << " adc " << adc_output << endl;
-			    }
-
-			  hit->setAdc(adc_output);
-			  
-			}  // end boundary check
-		      binpointer++;   // skip this bin in future
-		    }    // end izup loop
-		  
-		}  //  adc threshold if
-	      else
-		{
-		  // below threshold, move on
-		  binpointer++;
-		}  // end adc threshold if/else
-	      
-	    }  // end iz loop for negative z
-	  
-	  // now positive z, the first to arrive is bin 497
-	  //===============================
-	  binpointer = nzbins - 1;
-	  for (int iz = nzbins - 1; iz >= nzbins / 2; iz--)  // 495 - 248
-	    {
-	      if (iz > binpointer) continue;
-	      
-	      if (adc_input[iz] > ADCThreshold * ADCNoiseConversionGain)  // convert threshold in electrons to mV
-		{
-		  // digitize this bin and the following 4 bins
-		  
-		  if (Verbosity() > 100)
-		    if (layer == print_layer) cout << endl
-						   << "new:  (pos z) Above threshold  of " << ADCThreshold * ADCNoiseConversionGain << " for iphi " << iphi << "  iz " << iz
-						   << " with adc_input " << adc_input[iz] << " digitize this and 4 following bins: " << endl;
-		  
-		  for (int izup = 0; izup < 5; izup++)
-		    {
-		      if (iz - izup < nzbins && iz - izup >= nzbins / 2)
-			{
-			  unsigned int adc_output = (unsigned int) (adc_input[iz - izup] * 1024.0 / 2200.0);  // input voltage x 1024 channels over 2200 mV max range
-			  if (adc_input[iz - izup] < 0) adc_output = 0;
-			  if (adc_output > 1023) adc_output = 1023;
-			  
-			  if (Verbosity() > 100)
-			  if (layer == print_layer) cout << "new:  iphi " << iphi << "  (pos z) iz-izup " << iz - izup << " adc_hitid " << adc_hitid[iz - izup]
-							   << "  adc_input " << adc_input[iz - izup] << " ADCThreshold " << ADCThreshold * ADCNoiseConversionGain
-							   << " adc_output " << adc_output << endl;
-
-			  // Get the hitkey
-			  TrkrDefs::hitkey hitkey = TpcDefs::genHitKey(iphi, iz-izup);
-			  TrkrHit *hit = nullptr;
-			  hit = hitset_iter->second->getHit(hitkey);
-			  
-			  // noise bins do not have TrkrHits associated with them, have to make one
-			  if(!hit)
-			    {
-			      hit = new TpcHit();
-			      hitset_iter->second->addHitSpecificKey(hitkey, hit);
-			      hit->addEnergy(adc_input[iz+izup]);
-			      
-			      if (Verbosity() > 100)
-				if (layer == print_layer) cout << "new:  adding noise hit for iphi " << iphi << " zbin " << iz + izup
-							       << " created new hit with hitkey " << hitkey
-							       << " energy " << adc_input[iz + izup] << " adc " << adc_output << endl;
-			    }
-
-			  hit->setAdc(adc_output);
-			} // end boundary check
-			  binpointer--;
-		    } // end izup loop
-		  
-		}  //  adc threshold if
-	      else
-		{
-		  // below threshold, move on
-		  binpointer--;
-		}  // end adc threshold if/else
-
-	    }  // end iz loop for positive z
-			      
-	}  // end phibins loop
-      
-    }  // end loop over hitsets
+  // noise bins do not have TrkrHits associated with them, have to make one
+  for (unsigned int itask = 0; itask < tasks.size(); itask++)
+    {
+      for (const NoiseHit &noisehit : tasks[itask].noisehits)
+	{
+	  TrkrHit *hit = new TpcHit();
+	  tasks[itask].hitset->addHitSpecificKey(noisehit.key, hit);
+	  hit->addEnergy(noisehit.adc_input);
+	  hit->setAdc(noisehit.adc);
+	}
+    }
 
   //======================================================  
   if(Verbosity() > 2) 
@@ -551,6 +372,8 @@ void PHG4TpcDigitizer::DigitizeCylinderCells(PHCompositeNode *topNode)
       // should also delete all entries with this hitkey from the TrkrHitTruthAssoc map
       hittruthassoc->removeAssoc(delete_hitkey_list[i].first, delete_hitkey_list[i].second);
     }
+  // the removals are applied in one pass
+  hittruthassoc->finalize();
 
 
   // Final hitset dump
@@ -596,9 +419,95 @@ void PHG4TpcDigitizer::DigitizeCylinderCells(PHCompositeNode *topNode)
   return;
 }
 
-float PHG4TpcDigitizer::added_noise()
+void PHG4TpcDigitizer::DigitizeHitSet(TrkrHitSet *hitset, const int nzbins, std::vector<double> &noise, std::vector<float> &adc_input,
+                                      std::vector<unsigned char> &above, std::vector<NoiseHit> &noisehits) const
 {
-  float noise = gsl_ran_gaussian(RandomGenerator, TpcEnc);
+  // every hitset owns 2^32 numbers of the event stream, a pad nzbins + 1 of them
+  const uint64_t firstindex = static_cast<uint64_t>(hitset->getHitSetKey()) << 32;
+  noise.resize(nzbins);
+  adc_input.resize(nzbins);
+  above.resize(nzbins);
+  const float threshold = ADCThreshold * ADCNoiseConversionGain;  // convert threshold in "equivalent electrons" to mV
+
+  // the hits are ordered by pad and then z bin, every pad with hits is one contiguous row of z bins
+  TrkrHitSet::ConstRange hit_range = hitset->getHits();
+  TrkrHitSet::ConstIterator hit_iter = hit_range.first;
+  while (hit_iter != hit_range.second)
+  {
+    const unsigned int pad = TpcDefs::getPad(hit_iter->first);
 
-  return noise;
+    // noise on every z bin of the pad, in electrons
+    m_Rng->GausAt(firstindex + static_cast<uint64_t>(pad) * (nzbins + 1), noise.data(), nzbins, TpcEnc);
+    // mV - from definition of noise charge and pedestal charge, the loop has no branches
+    for (int iz = 0; iz < nzbins; iz++)
+    {
+      adc_input[iz] = (Pedestal + noise[iz]) * ADCNoiseConversionGain;
+    }
+    // add the signal of the bins with hits, this leaves hit_iter at the next pad
+    for (; hit_iter != hit_range.second && TpcDefs::getPad(hit_iter->first) == pad; ++hit_iter)
+    {
+      const int zbin = TpcDefs::getTBin(hit_iter->first);
+      if (zbin < nzbins)
+      {
+        float adc_input_voltage = hit_iter->second->getEnergy() * ADCSignalConversionGain;  // mV, see comments above
+        adc_input[zbin] = adc_input_voltage + adc_input[zbin];
+      }
+    }
+    // zero suppression, one compare per bin
+    for (int iz = 0; iz < nzbins; iz++)
+    {
+      above[iz] = (adc_input[iz] > threshold);
+    }
+
+    // Now we can digitize the entire stream of z bins for this phi bin
+    // start with negative z, the first to arrive is bin 0
+    // a bin above threshold is digitized with the following 4 bins, which are then skipped
+    for (int iz = 0; iz < nzbins / 2; iz++)
+    {
+      if (!above[iz])
+      {
+        continue;
+      }
+      const int izend = std::min(iz + 5, nzbins / 2);
+      for (int izup = iz; izup < izend; izup++)
+      {
+        StoreAdc(hitset, pad, izup, adc_input[izup], noisehits);
+      }
+      iz += 4;
+    }
+    // now positive z, the first to arrive is the last bin
+    for (int iz = nzbins - 1; iz >= nzbins / 2; iz--)
+    {
+      if (!above[iz])
+      {
+        continue;
+      }
+      const int izend = std::max(iz - 5, nzbins / 2 - 1);
+      for (int izdown = iz; izdown > izend; izdown--)
+      {
+        StoreAdc(hitset, pad, izdown, adc_input[izdown], noisehits);
+      }
+      iz -= 4;
+    }
+  }
+}
+
+void PHG4TpcDigitizer::StoreAdc(TrkrHitSet *hitset, const unsigned int pad, const int zbin, const float adc_input, std::vector<NoiseHit> &noisehits) const
+{
+  unsigned int adc_output = (unsigned int) (adc_input * 1024.0 / 2200.0);  // input voltage x 1024 channels over 2200 mV max range
+  if (adc_input < 0) adc_output = 0;
+  if (adc_output > 1023) adc_output = 1023;
+
+  TrkrDefs::hitkey hitkey = TpcDefs::genHitKey(pad, zbin);
+  TrkrHit *hit = hitset->getHit(hitkey);
+  if (!hit)
+  {
+    NoiseHit noisehit;
+    noisehit.key = hitkey;
+    noisehit.adc_input = adc_input;
+    noisehit.adc = adc_output;
+    noisehits.push_back(noisehit);
+    return;
+  }
+  hit->setAdc(adc_output);
 }
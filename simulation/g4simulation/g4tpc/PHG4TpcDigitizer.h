@@ -13,12 +13,8 @@
 #include <utility>                 // for pair, make_pair
 #include <vector>
 
-// rootcint barfs with this header so we need to hide it
-#if !defined(__CINT__) || defined(__CLING__)
-#include <gsl/gsl_rng.h>
-#endif
-
 class PHCompositeNode;
+class PHCounterRng;
 
 class PHG4TpcDigitizer : public SubsysReco
 {
@@ -47,11 +43,25 @@ class PHG4TpcDigitizer : public SubsysReco
   void SetTpcMinLayer(const int minlayer) { TpcMinLayer = minlayer; };
   void SetADCThreshold(const float thresh) { ADCThreshold = thresh; };
   void SetENC(const float enc) { TpcEnc = enc; };
+  //! hitsets are digitized in parallel by this many threads, the result does not depend on it
+  void set_nthreads(const unsigned int n) { m_NThreads = (n > 0 ? n : 1); }
 
  private:
   void CalculateCylinderCellADCScale(PHCompositeNode *topNode);
   void DigitizeCylinderCells(PHCompositeNode *topNode);
-  float added_noise();
+  //! noise bin above threshold without a TrkrHit, the hit is created after all hitsets are done
+  struct NoiseHit
+  {
+    TrkrDefs::hitkey key;
+    float adc_input;
+    unsigned int adc;
+  };
+
+  //! noise, zero suppression and adc of all pads of one hitset. The noise is drawn by index
+  //! from the event stream (hitset key, pad, z bin), so it does not depend on the thread
+  void DigitizeHitSet(TrkrHitSet *hitset, const int nzbins, std::vector<double> &noise, std::vector<float> &adc_input,
+                      std::vector<unsigned char> &above, std::vector<NoiseHit> &noisehits) const;
+  void StoreAdc(TrkrHitSet *hitset, const unsigned int pad, const int zbin, const float adc_input, std::vector<NoiseHit> &noisehits) const;
 
   unsigned int TpcMinLayer;
   float ADCThreshold;
@@ -62,21 +72,14 @@ class PHG4TpcDigitizer : public SubsysReco
   float ADCSignalConversionGain;
   float ADCNoiseConversionGain;
 
-  std::vector<std::vector<TrkrHitSet::ConstIterator> > phi_sorted_hits;
-  std::vector<std::vector<TrkrHitSet::ConstIterator> > z_sorted_hits;
-
-  std::vector<float> adc_input;
-  std::vector<TrkrDefs::hitkey> adc_hitid;
-  std::vector<int> is_populated;
+  unsigned int m_NThreads;
 
   // settings
   std::map<int, unsigned int> _max_adc;
   std::map<int, float> _energy_scale;
 
-#if !defined(__CINT__) || defined(__CLING__)
-  //! random generator that conform with sPHENIX standard
-  gsl_rng *RandomGenerator;
-#endif
+  //! counter based random stream, the noise of a bin is drawn by its index
+  PHCounterRng *m_Rng;
 };
 
 #endif
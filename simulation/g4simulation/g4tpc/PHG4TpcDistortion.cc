@@ -26,3 +26,14 @@ PHG4TpcDistortion::~PHG4TpcDistortion()
 {
   gsl_rng_free(RandomGenerator);
 }
+
+void PHG4TpcDistortion::get_distortions(const unsigned int n, const double *r, const double *phi, const double *z,
+                                        double *dr, double *drphi, double *dz)
+{
+  for (unsigned int i = 0; i < n; i++)
+  {
+    dr[i] = get_r_distortion(r[i], phi[i], z[i]);
+    drphi[i] = get_rphi_distortion(r[i], phi[i], z[i]);
+    dz[i] = get_z_distortion(r[i], phi[i], z[i]);
+  }
+}
@@ -40,6 +40,11 @@ class PHG4TpcDistortion
   virtual double
   get_z_distortion(double r, double phi, double z) = 0;
 
+  //! distortions of n primary ionizations at once, calls the single point methods unless overridden
+  virtual void
+  get_distortions(const unsigned int n, const double *r, const double *phi, const double *z,
+                  double *dr, double *drphi, double *dz);
+
   //! Sets the verbosity of this module (0 by default=quiet).
   virtual void
   Verbosity(const int ival)
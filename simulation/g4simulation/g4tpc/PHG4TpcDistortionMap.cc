@@ -0,0 +1,165 @@
+#include "PHG4TpcDistortionMap.h"
+
+#include <TAxis.h>
+#include <TH3.h>
+
+#include <algorithm>
+#include <cmath>
+#include <iostream>
+
+using namespace std;
+
+namespace
+{
+  bool IsUniform(const TAxis *axis)
+  {
+    return (axis->GetXbins()->GetSize() == 0);
+  }
+}  // namespace
+
+PHG4TpcDistortionMap::PHG4TpcDistortionMap()
+  : m_MapSize(0)
+  , m_PhiDependent(true)
+{
+  for (int i = 0; i < 3; i++)
+  {
+    m_Axis[i].min = 0;
+    m_Axis[i].inv_step = 0;
+    m_Axis[i].n = 0;
+  }
+}
+
+void PHG4TpcDistortionMap::Clear()
+{
+  m_Times.clear();
+  m_Values.clear();
+  m_MapSize = 0;
+}
+
+bool PHG4TpcDistortionMap::AddMap(TH3 *hist, const double time)
+{
+  if (!hist)
+  {
+    return false;
+  }
+  const TAxis *axes[3] = {hist->GetXaxis(), hist->GetYaxis(), hist->GetZaxis()};
+  Axis grid[3];
+  for (int i = 0; i < 3; i++)
+  {
+    grid[i].n = axes[i]->GetNbins();
+    grid[i].min = axes[i]->GetBinCenter(1);
+    const double max = axes[i]->GetBinCenter(grid[i].n);
+    grid[i].inv_step = (grid[i].n > 1 ? (grid[i].n - 1) / (max - grid[i].min) : 0);
+  }
+  if (empty())
+  {
+    copy(grid, grid + 3, m_Axis);
+    m_MapSize = grid[0].n * grid[1].n * grid[2].n;
+  }
+  else
+  {
+    for (int i = 0; i < 3; i++)
+    {
+      if (grid[i].n != m_Axis[i].n ||
+          fabs(grid[i].min - m_Axis[i].min) > 1e-6 * (1 + fabs(m_Axis[i].min)) ||
+          fabs(grid[i].inv_step - m_Axis[i].inv_step) > 1e-6 * m_Axis[i].inv_step)
+      {
+        cout << "PHG4TpcDistortionMap::AddMap - binning of " << hist->GetName()
+             << " differs from the first map, not added" << endl;
+        return false;
+      }
+    }
+  }
+
+  vector<float> values(m_MapSize);
+  const bool uniform = IsUniform(axes[0]) && IsUniform(axes[1]) && IsUniform(axes[2]);
+  vector<float>::iterator iter = values.begin();
+  for (int ir = 0; ir < m_Axis[0].n; ir++)
+  {
+    for (int iphi = 0; iphi < m_Axis[1].n; iphi++)
+    {
+      for (int iz = 0; iz < m_Axis[2].n; iz++)
+      {
+        if (uniform)
+        {
+          *iter++ = hist->GetBinContent(ir + 1, iphi + 1, iz + 1);
+        }
+        else
+        {
+          // resample at the grid points between the first and last bin centers
+          const double r = m_Axis[0].min + (m_Axis[0].n > 1 ? ir / m_Axis[0].inv_step : 0);
+          const double phi = m_Axis[1].min + (m_Axis[1].n > 1 ? iphi / m_Axis[1].inv_step : 0);
+          const double z = m_Axis[2].min + (m_Axis[2].n > 1 ? iz / m_Axis[2].inv_step : 0);
+          *iter++ = hist->Interpolate(r, phi, z);
+        }
+      }
+    }
+  }
+
+  // keep the maps ordered in time
+  const vector<double>::iterator pos = upper_bound(m_Times.begin(), m_Times.end(), time);
+  const size_t index = pos - m_Times.begin();
+  m_Times.insert(pos, time);
+  m_Values.insert(m_Values.begin() + index * m_MapSize, values.begin(), values.end());
+  return true;
+}
+
+void PHG4TpcDistortionMap::LocateTime(const double time, unsigned int &map, double &w) const
+{
+  map = 0;
+  w = 0;
+  if (m_Times.size() < 2 || time <= m_Times.front())
+  {
+    return;
+  }
+  if (time >= m_Times.back())
+  {
+    map = m_Times.size() - 1;
+    return;
+  }
+  map = (upper_bound(m_Times.begin(), m_Times.end(), time) - m_Times.begin()) - 1;
+  w = (time - m_Times[map]) / (m_Times[map + 1] - m_Times[map]);
+}
+
+void PHG4TpcDistortionMap::Interpolate(const unsigned int n, const double *r, const double *phi, const double *z, double *out, const double time) const
+{
+  unsigned int map;
+  double w;
+  LocateTime(time, map, w);
+  // the time weight is the same for all points, no blending for a single map
+  if (w > 0)
+  {
+    for (unsigned int i = 0; i < n; i++)
+    {
+      const double v0 = InterpolateMap(map, r[i], phi[i], z[i]);
+      out[i] = v0 + w * (InterpolateMap(map + 1, r[i], phi[i], z[i]) - v0);
+    }
+  }
+  else
+  {
+    for (unsigned int i = 0; i < n; i++)
+    {
+      out[i] = InterpolateMap(map, r[i], phi[i], z[i]);
+    }
+  }
+}
+
+void PHG4TpcDistortionMap::Print() const
+{
+  static const char *names[3] = {"r", "phi", "z"};
+  cout << "PHG4TpcDistortionMap: " << m_Times.size() << " maps"
+       << (m_PhiDependent ? "" : ", phi independent") << endl;
+  for (int i = 0; i < 3; i++)
+  {
+    cout << " " << names[i] << ": " << m_Axis[i].n << " points from " << m_Axis[i].min;
+    if (m_Axis[i].n > 1)
+    {
+      cout << " to " << m_Axis[i].min + (m_Axis[i].n - 1) / m_Axis[i].inv_step;
+    }
+    cout << endl;
+  }
+  for (unsigned int i = 0; i < m_Times.size(); i++)
+  {
+    cout << " map " << i << " at time " << m_Times[i] << endl;
+  }
+}
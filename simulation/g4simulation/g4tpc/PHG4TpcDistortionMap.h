@@ -0,0 +1,123 @@
+// Tell emacs that this is a C++ source
+//  -*- C++ -*-.
+#ifndef G4TPC_PHG4TPCDISTORTIONMAP_H
+#define G4TPC_PHG4TPCDISTORTIONMAP_H
+
+#include <vector>
+
+class TH3;
+
+/*!
+ * \brief distortion map on a uniform (r, phi, z) grid with trilinear interpolation
+ *
+ * The values are copied from the TH3 (x: r, y: phi, z: z) into a flat float
+ * array, the bin lookup is a multiplication instead of the TAxis::FindBin()
+ * of TH3::Interpolate. Maps with variable binning are resampled onto a uniform
+ * grid with the same number of bins. Outside the first/last bin centers the
+ * value at the edge is used.
+ *
+ * Several maps can be added for different times (fluctuating space charge),
+ * the value at a given time is interpolated linearly between the two
+ * neighbouring maps. All maps must have the same binning as the first one.
+ */
+class PHG4TpcDistortionMap
+{
+ public:
+  PHG4TpcDistortionMap();
+  virtual ~PHG4TpcDistortionMap() {}
+
+  //! adds the map for the given time, false if the binning differs from the maps added before
+  bool AddMap(TH3 *hist, const double time = 0);
+  void Clear();
+
+  unsigned int NMaps() const { return m_Times.size(); }
+  bool empty() const { return m_Times.empty(); }
+
+  //! maps without phi dependence: the first phi bin is used for all phi
+  void PhiDependent(const bool b) { m_PhiDependent = b; }
+  bool PhiDependent() const { return m_PhiDependent; }
+
+  //! value at (r, phi, z) of the map at time
+  double Interpolate(const double r, const double phi, const double z, const double time = 0) const
+  {
+    unsigned int map;
+    double w;
+    LocateTime(time, map, w);
+    double value = InterpolateMap(map, r, phi, z);
+    if (w > 0)
+    {
+      value += w * (InterpolateMap(map + 1, r, phi, z) - value);
+    }
+    return value;
+  }
+
+  //! n points at once, the time is the same for all of them
+  void Interpolate(const unsigned int n, const double *r, const double *phi, const double *z, double *out, const double time = 0) const;
+
+  void Print() const;
+
+ private:
+  struct Axis
+  {
+    //! first bin center
+    double min;
+    double inv_step;
+    int n;
+  };
+
+  //! lower grid point and weight of the upper one, clamped to the grid
+  static void Locate(const Axis &axis, const double x, int &i, double &f)
+  {
+    double u = (x - axis.min) * axis.inv_step;
+    const double umax = axis.n - 1;
+    u = (u < 0 ? 0 : (u > umax ? umax : u));
+    i = static_cast<int>(u);
+    if (i > axis.n - 2)
+    {
+      i = (axis.n > 1 ? axis.n - 2 : 0);
+    }
+    f = u - i;
+  }
+
+  double InterpolateMap(const unsigned int map, const double r, const double phi, const double z) const
+  {
+    int ir, iphi, iz;
+    double fr, fphi, fz;
+    Locate(m_Axis[0], r, ir, fr);
+    Locate(m_Axis[2], z, iz, fz);
+    if (m_PhiDependent)
+    {
+      Locate(m_Axis[1], phi, iphi, fphi);
+    }
+    else
+    {
+      iphi = 0;
+      fphi = 0;
+    }
+    // neighbour offsets are 0 for axes with a single bin
+    const int sz = (m_Axis[2].n > 1 ? 1 : 0);
+    const int sphi = (m_Axis[1].n > 1 ? m_Axis[2].n : 0);
+    const int sr = (m_Axis[0].n > 1 ? m_Axis[1].n * m_Axis[2].n : 0);
+    const float *v = &m_Values[map * m_MapSize + (ir * m_Axis[1].n + iphi) * m_Axis[2].n + iz];
+    const double c00 = v[0] + fz * (v[sz] - v[0]);
+    const double c01 = v[sphi] + fz * (v[sphi + sz] - v[sphi]);
+    const double c10 = v[sr] + fz * (v[sr + sz] - v[sr]);
+    const double c11 = v[sr + sphi] + fz * (v[sr + sphi + sz] - v[sr + sphi]);
+    const double c0 = c00 + fphi * (c01 - c00);
+    const double c1 = c10 + fphi * (c11 - c10);
+    return c0 + fr * (c1 - c0);
+  }
+
+  //! map before time and the weight of the one after it
+  void LocateTime(const double time, unsigned int &map, double &w) const;
+
+  Axis m_Axis[3];
+  unsigned int m_MapSize;
+  bool m_PhiDependent;
+  //! sorted
+  std::vector<double> m_Times;
+  //! map, r, phi, z with z running fastest
+  std::vector<float> m_Values;
+};
+
+#endif
@@ -2,6 +2,7 @@
 // it uses the same MapToPadPlane as the old containers version
 
 #include "PHG4TpcElectronDrift.h"
+#include "PHG4TpcDistortion.h"
 #include "PHG4TpcPadPlane.h"                            // for PHG4TpcPadPlane
 
 #include <g4main/PHG4Hit.h>
@@ -16,6 +17,7 @@
 #include <tpc/TpcDefs.h>
 #include <tpc/TpcHit.h>
 
+#include <g4detectors/PHG4CylinderCellGeom.h>
 #include <g4detectors/PHG4CylinderCellGeomContainer.h>
 
 #include <phparameter/PHParameters.h>
@@ -35,7 +37,7 @@
 #include <phool/PHNode.h>                               // for PHNode
 #include <phool/PHNodeIterator.h>
 #include <phool/PHObject.h>                             // for PHObject
-#include <phool/PHRandomSeed.h>
+#include <phool/PHCounterRng.h>
 #include <phool/getClass.h>
 #include <phool/phool.h>                                // for PHWHERE
 
@@ -47,6 +49,7 @@
 #include <gsl/gsl_randist.h>
 #include <gsl/gsl_rng.h>                                // for gsl_rng_alloc
 
+#include <algorithm>                                     // for max, min
 #include <cassert>
 #include <cmath>                                       // for sqrt, fabs, NAN
 #include <cstdlib>                                     // for exit
@@ -56,13 +59,45 @@
 
 using namespace std;
 
+namespace
+{
+  // number of uniform deviates used per electron
+  const unsigned int kRandomsPerElectron = 6;
+}  // namespace
+
+void PHG4TpcElectronDrift::DriftBatch::resize(const unsigned int n, const bool distortion)
+{
+  x_start.resize(n);
+  y_start.resize(n);
+  z_start.resize(n);
+  t_start.resize(n);
+  t_sigma.resize(n);
+  t_final.resize(n);
+  x_final.resize(n);
+  y_final.resize(n);
+  z_final.resize(n);
+  rad_final.resize(n);
+  accept.resize(n);
+  random.resize(static_cast<size_t>(n) * kRandomsPerElectron);
+  if (distortion)
+  {
+    r_start.resize(n);
+    phi_start.resize(n);
+    dr.resize(n);
+    drphi.resize(n);
+    dz.resize(n);
+    x_distorted.resize(n);
+    y_distorted.resize(n);
+  }
+}
+
 PHG4TpcElectronDrift::PHG4TpcElectronDrift(const std::string &name)
   : SubsysReco(name)
   , PHParameterInterface(name)
   , hitsetcontainer(nullptr)
-  , temp_hitsetcontainer(new TrkrHitSetContainer())// this is used as a buffer for charge collection from a single g4hit
   , hittruthassoc(nullptr)
   , padplane(nullptr)
+  , m_Distortion(nullptr)
   , dlong(nullptr)
   , dtrans(nullptr)
   , m_outf(nullptr)
@@ -78,20 +113,31 @@ PHG4TpcElectronDrift::PHG4TpcElectronDrift(const std::string &name)
   , max_active_radius(NAN)
   , min_time(NAN)
   , max_time(NAN)
+  , m_TimeFrameFlag(false)
+  , m_CrossingSpacing(NAN)
+  , m_SliceLength(NAN)
+  , m_NZBins(0)
+  , m_TimeBinWidth(NAN)
+  , m_SliceBins(0)
+  , m_Crossing(0)
+  , m_CrossingBin(0)
+  , m_NextSliceStart(0)
 {
   //cout << "Constructor of PHG4TpcElectronDrift" << endl;
   InitializeParameters();
-  RandomGenerator = gsl_rng_alloc(gsl_rng_mt19937);
-  set_seed(PHRandomSeed());  // fixed seed is handled in this funtcion
+  // counter based stream keyed by the module name, the numbers of an event do not depend on other modules
+  m_Rng = new PHCounterRng(Name());
+  RandomGenerator = m_Rng->get_gsl_rng();
+  seed = 0;  // 0: keyed by the master seed, set_seed() overrides it
 
   return;
 }
 
 PHG4TpcElectronDrift::~PHG4TpcElectronDrift()
 {
-  gsl_rng_free(RandomGenerator);
+  delete m_Rng;
   delete padplane;
-  delete temp_hitsetcontainer;
+  delete m_Distortion;
 }
 
 int PHG4TpcElectronDrift::Init(PHCompositeNode *topNode)
@@ -251,6 +297,30 @@ int PHG4TpcElectronDrift::InitRun(PHCompositeNode *topNode)
   padplane->InitRun(topNode);
   padplane->CreateReadoutGeometry(topNode, seggeo);
 
+  if (m_TimeFrameFlag)
+  {
+    // all tpc layers share the z (time) binning
+    PHG4CylinderCellGeomContainer::ConstRange layerrange = seggeo->get_begin_end();
+    if (layerrange.first == layerrange.second)
+    {
+      cout << PHWHERE << " no readout geometry for the time frame mode" << endl;
+      return Fun4AllReturnCodes::ABORTRUN;
+    }
+    m_NZBins = layerrange.first->second->get_zbins();
+    m_TimeBinWidth = layerrange.first->second->get_zstep() / drift_velocity;
+    // a slice is at least one crossing long, so at most one slice closes per crossing,
+    // and at most as long as the readout window, so the digitizer can handle it
+    const int crossing_bins = ceil(m_CrossingSpacing / m_TimeBinWidth);
+    m_SliceBins = lrint(m_SliceLength / m_TimeBinWidth);
+    m_SliceBins = std::max(crossing_bins, std::min(m_SliceBins, m_NZBins));
+    m_TimeFrameRing.clear();
+    m_TimeFrameRing.resize(m_SliceBins + m_NZBins + crossing_bins + 2);
+    m_Crossing = 0;
+    m_NextSliceStart = 0;
+    cout << "PHG4TpcElectronDrift: time frame mode with " << m_CrossingSpacing << " ns crossing spacing, slices of "
+         << m_SliceBins << " time bins of " << m_TimeBinWidth << " ns" << endl;
+  }
+
   return Fun4AllReturnCodes::EVENT_OK;
 }
 
@@ -268,6 +338,11 @@ int PHG4TpcElectronDrift::process_event(PHCompositeNode *topNode)
   PHG4HitContainer::ConstIterator hiter;
   PHG4HitContainer::ConstRange hit_begin_end = g4hit->getHits();
 
+  if (m_TimeFrameFlag)
+  {
+    m_CrossingBin = floor(m_Crossing * m_CrossingSpacing / m_TimeBinWidth);
+  }
+
   double ecollectedhits = 0.0;
   int ncollectedhits = 0;
   double ihit = 0;
@@ -280,7 +355,7 @@ int PHG4TpcElectronDrift::process_event(PHCompositeNode *topNode)
 	}
 
       // for very high occupancy events, accessing the TrkrHitsets on the node tree for every drifted electron seems to be very slow
-      // Instead, use a temporary map to accumulate the charge from all drifted electrons, then copy to the node tree later
+      // Instead, accumulate the charge from all drifted electrons in m_HitBuffer, then copy to the node tree later
 
       double eion = hiter->second->get_eion();
       unsigned int n_electrons = gsl_ran_poisson(RandomGenerator, eion * electrons_per_gev);
@@ -306,155 +381,77 @@ int PHG4TpcElectronDrift::process_event(PHCompositeNode *topNode)
 	       << " radius " << sqrt(pow(hiter->second->get_x(1), 2) + pow(hiter->second->get_y(1), 2)) << endl;
 	}
 
-      for (unsigned int i = 0; i < n_electrons; i++)
+      unsigned int n_accepted = DriftElectrons(hiter->second, n_electrons);
+      for (unsigned int i = 0; i < n_accepted && Verbosity() > 0; i++)
 	{
-	  // We choose the electron starting position at random from a flat distribution along the path length
-	  // the parameter t is the fraction of the distance along the path betwen entry and exit points, it has values between 0 and 1
-	  double f = gsl_ran_flat(RandomGenerator, 0.0, 1.0);
-
-	  double x_start = hiter->second->get_x(0) + f * (hiter->second->get_x(1) - hiter->second->get_x(0));
-	  double y_start = hiter->second->get_y(0) + f * (hiter->second->get_y(1) - hiter->second->get_y(0));
-	  double z_start = hiter->second->get_z(0) + f * (hiter->second->get_z(1) - hiter->second->get_z(0));
-	  double t_start = hiter->second->get_t(0) + f * (hiter->second->get_t(1) - hiter->second->get_t(0));
-
-	  double radstart = sqrt(x_start * x_start + y_start * y_start);
-	  double r_sigma = diffusion_trans * sqrt(tpc_length / 2. - fabs(z_start));
-	  double rantrans = gsl_ran_gaussian(RandomGenerator, r_sigma);
-	  rantrans += gsl_ran_gaussian(RandomGenerator, added_smear_sigma_trans);
-
-	  double t_path = (tpc_length / 2. - fabs(z_start)) / drift_velocity;
-	  double t_sigma = diffusion_long * sqrt(tpc_length / 2. - fabs(z_start)) / drift_velocity;
-	  double rantime = gsl_ran_gaussian(RandomGenerator, t_sigma);
-	  rantime += gsl_ran_gaussian(RandomGenerator, added_smear_sigma_long) / drift_velocity;
-	  double t_final = t_start + t_path + rantime;
-
-	  double z_final;
-	  if (z_start < 0)
-	    z_final = -tpc_length / 2. + t_final * drift_velocity;
-	  else
-	    z_final = tpc_length / 2. - t_final * drift_velocity;
-
-	  if (t_final < min_time || t_final > max_time)
-	    {
-	      //cout << "skip this, t_final = " << t_final << " is out of range " << min_time <<  " to " << max_time << endl;
-	      continue;
-	    }
-	  double ranphi = gsl_ran_flat(RandomGenerator, -M_PI, M_PI);
-	  double x_final = x_start + rantrans * cos(ranphi);
-	  double y_final = y_start + rantrans * sin(ranphi);
-	  double rad_final = sqrt(x_final * x_final + y_final * y_final);
-	  // remove electrons outside of our acceptance. Careful though, electrons from just inside 30 cm can contribute in the 1st active layer readout, so leave a little margin
-	  if (rad_final < min_active_radius - 2.0 || rad_final > max_active_radius + 1.0)
-	    {
-	      continue;
-	    }
-
 	  if (Verbosity() > 1000)
 	    {
-	      cout << "ihit " << ihit << " electron " << i << " g4hitid " << hiter->first << " f " << f << endl;
-	      cout << "radstart " << radstart << " x_start: " << x_start
-		   << ", y_start: " << y_start
-		   << ",z_start: " << z_start
-		   << " t_start " << t_start
-		   << " t_path " << t_path
-		   << " t_sigma " << t_sigma
-		   << " rantime " << rantime
+	      double radstart = sqrt(m_Batch.x_start[i] * m_Batch.x_start[i] + m_Batch.y_start[i] * m_Batch.y_start[i]);
+	      cout << "ihit " << ihit << " electron " << i << " g4hitid " << hiter->first << endl;
+	      cout << "radstart " << radstart << " x_start: " << m_Batch.x_start[i]
+		   << ", y_start: " << m_Batch.y_start[i]
+		   << ",z_start: " << m_Batch.z_start[i]
+		   << " t_start " << m_Batch.t_start[i]
+		   << " t_sigma " << m_Batch.t_sigma[i]
 		   << endl;
 
-	      //if( sqrt(x_start*x_start+y_start*y_start) > 68.0 && sqrt(x_start*x_start+y_start*y_start) < 72.0)
-	      cout << "       rad_final " << rad_final << " x_final " << x_final << " y_final " << y_final
-		   << " z_final " << z_final << " t_final " << t_final << " zdiff " << z_final - z_start << endl;
+	      cout << "       rad_final " << m_Batch.rad_final[i] << " x_final " << m_Batch.x_final[i] << " y_final " << m_Batch.y_final[i]
+		   << " z_final " << m_Batch.z_final[i] << " t_final " << m_Batch.t_final[i] << " zdiff " << m_Batch.z_final[i] - m_Batch.z_start[i] << endl;
 	    }
 
-	  if (Verbosity() > 0)
-	  {
-	    assert(nt);
-      nt->Fill(ihit, t_start, t_final, t_sigma, rad_final, z_start, z_final);
-	  }
-
-	  // this fills the cells and updates the hits in temp_hitsetcontainer for this drifted electron hitting the GEM stack
-	  MapToPadPlane(x_final, y_final, z_final, hiter, ntpad, nthit);
-	}  // end loop over electrons for this g4hit
+	  assert(nt);
+	  nt->Fill(ihit, m_Batch.t_start[i], m_Batch.t_final[i], m_Batch.t_sigma[i], m_Batch.rad_final[i], m_Batch.z_start[i], m_Batch.z_final[i]);
+	}
+      // this sums the charge of the drifted electrons hitting the GEM stack in m_HitBuffer
+      padplane->MapToPadPlane(&m_HitBuffer, n_accepted, m_Batch.x_final.data(), m_Batch.y_final.data(), m_Batch.z_final.data(), hiter, ntpad, nthit);
 
       if(Verbosity() > 100)
 	cout << "Finished drifting " << n_electrons << " electrons from ihit " << ihit 
-	     << " now process temp_hitsetcontainer  " << endl;
-
-      // transfer the hits from temp_hitsetcontainer to hitsetcontainer on the node tree
-      double eg4hit = 0.0;
-      TrkrHitSetContainer::ConstRange temp_hitset_range = temp_hitsetcontainer->getHitSets(TrkrDefs::TrkrId::tpcId);
-      for (TrkrHitSetContainer::ConstIterator temp_hitset_iter = temp_hitset_range.first;
-	   temp_hitset_iter != temp_hitset_range.second;
-	   ++temp_hitset_iter)
-	{
+	     << " now process " << m_HitBuffer.entries().size() << " buffered hits" << endl;
 
-	  // we have an iterator to one TrkrHitSet for the Tpc from the temp_hitsetcontainer
-	  TrkrDefs::hitsetkey node_hitsetkey = temp_hitset_iter->first;
-	  const unsigned int layer = TrkrDefs::getLayer(node_hitsetkey);
-	  const int sector = TpcDefs::getSectorId(node_hitsetkey);
-	  const int side = TpcDefs::getSide(node_hitsetkey);
-	  if(Verbosity()>100 && layer)
-	    cout << "PHG4TpcElectronDrift: temp_hitset with key: " << node_hitsetkey << " in layer " << layer << " with sector " << sector << " side " << side << endl;
-
-	  // find or add this hitset on the node tree
-	  TrkrHitSetContainer::Iterator node_hitsetit = hitsetcontainer->findOrAddHitSet(node_hitsetkey);
-
-	  // get all of the hits from the temporary hitset
-	  TrkrHitSet::ConstRange temp_hit_range = temp_hitset_iter->second->getHits();
-	  for(TrkrHitSet::ConstIterator temp_hit_iter = temp_hit_range.first;
-	      temp_hit_iter != temp_hit_range.second;
-	      ++temp_hit_iter)
+      if (m_TimeFrameFlag)
+	{
+	  AddToTimeFrame();
+	}
+      else
+	{
+	  if (Verbosity() > 100)
 	    {
-	      TrkrDefs::hitkey temp_hitkey = temp_hit_iter->first;
-	      TrkrHit *temp_tpchit = temp_hit_iter->second;
-
-
-
-	      if(Verbosity() > 100 && layer == print_layer)
+	      double eg4hit = 0.0;
+	      for (const PHG4TpcHitBuffer::Entry &entry : m_HitBuffer.entries())
 		{
-		  cout << "      temp_hitkey " << temp_hitkey << " l;ayer " << layer << " pad " << TpcDefs::getPad(temp_hitkey) 
-		       << " z bin " << TpcDefs::getTBin(temp_hitkey)
-		       << "  energy " << temp_tpchit->getEnergy() << " eg4hit " << eg4hit << endl;
-
-		  eg4hit +=  temp_tpchit->getEnergy();
-		  ecollectedhits +=  temp_tpchit->getEnergy();
+		  if (entry.layer != print_layer) continue;
+		  eg4hit += entry.charge;
+		  ecollectedhits += entry.charge;
 		  ncollectedhits++;
+		  cout << "      hitkey " << entry.hitkey << " layer " << entry.layer << " pad " << entry.phibin
+		       << " z bin " << entry.zbin << "  energy " << entry.charge << endl;
 		}
-
-	      // find or add this hit to the node tree
-	      TrkrHit *node_hit = node_hitsetit->second->getHit(temp_hitkey);
-	      if(!node_hit)
-		{
-		  // Otherwise, create a new one
-		  node_hit = new TpcHit();
-		  node_hitsetit->second->addHitSpecificKey(temp_hitkey, node_hit);
-
-		  // Add the hit-g4hit association
-		  // no need to check for duplicates, since the hit is new
-		  hittruthassoc->addAssoc(node_hitsetkey, temp_hitkey, hiter->first);
-		} else {
-		// Add the hit-g4hit association
-		// TODO: check if duplication can happen
-		hittruthassoc->findOrAddAssoc(node_hitsetkey, temp_hitkey, hiter->first);
-	      }
-
-	      // Either way, add the energy to it
-	      node_hit->addEnergy(temp_tpchit->getEnergy());
-
-	    }  // end loop over temp hits
-
-	  if(Verbosity() > 100 && layer == print_layer)
-	    cout << "  ihit " << ihit << " collected energy = " << eg4hit << endl;
-	  
-	} // end loop over temp hitsets
-      
-      // erase all entries in the temp hitsetcontainer
-      temp_hitsetcontainer->Reset();
+	      cout << "  ihit " << ihit << " collected energy = " << eg4hit << endl;
+	    }
+	  FlushHitBuffer(hiter->first);
+	}
+      m_HitBuffer.clear();
 
       ihit++;
 
     } // end loop over g4hits
 
+  if (m_TimeFrameFlag)
+    {
+      m_Crossing++;
+      WriteClosedSlices();
+    }
+  else
+    {
+      // make the hits of all g4hits, one sorted insertion per hitset
+      for (TrkrHitSet *hitset : m_StagedHitSets)
+	{
+	  hitset->addStagedHits<TpcHit>();
+	}
+      m_StagedHitSets.clear();
+    }
+
   if(Verbosity() > 2)
     {
       cout << "From PHG4TpcElectronDrift: hitsetcontainer printout at end:" << endl;
@@ -503,6 +500,9 @@ int PHG4TpcElectronDrift::process_event(PHCompositeNode *topNode)
     }
 
 
+  // sort the associations of this event once
+  hittruthassoc->finalize();
+
   if(Verbosity() > 1000)
     {
       cout << "From PHG4TpcElectronDrift: hittruthassoc dump:" << endl;
@@ -512,9 +512,223 @@ int PHG4TpcElectronDrift::process_event(PHCompositeNode *topNode)
   return Fun4AllReturnCodes::EVENT_OK;
 }
 
+void PHG4TpcElectronDrift::FlushHitBuffer(const PHG4HitDefs::keytype g4hitkey)
+{
+  // ordered by hitset, so every hitset on the node tree is looked up once per g4hit
+  m_HitBuffer.sort();
+  TrkrHitSet *hitset = nullptr;
+  TrkrDefs::hitsetkey hitsetkey = 0;
+  for (const PHG4TpcHitBuffer::Entry &entry : m_HitBuffer.entries())
+  {
+    if (!hitset || entry.hitsetkey != hitsetkey)
+    {
+      hitsetkey = entry.hitsetkey;
+      hitset = hitsetcontainer->findOrAddHitSet(hitsetkey)->second;
+      if (!hitset->stagedSize())
+      {
+        m_StagedHitSets.push_back(hitset);
+      }
+    }
+    hitset->stageHit(entry.hitkey, entry.charge);
+    // every bin appears once in the buffer and every g4hit is flushed once,
+    // so this association cannot exist yet
+    hittruthassoc->addAssoc(hitsetkey, entry.hitkey, g4hitkey);
+  }
+}
+
+void PHG4TpcElectronDrift::AddToTimeFrame()
+{
+  const long long ringsize = m_TimeFrameRing.size();
+  for (const PHG4TpcHitBuffer::Entry &entry : m_HitBuffer.entries())
+  {
+    // the z bin counts the drift time from the readout plane of its side
+    const int side = TpcDefs::getSide(entry.hitsetkey);
+    const int zbin = entry.zbin;
+    const int driftbins = (side == 1) ? m_NZBins - 1 - zbin : zbin;
+    const long long tbin = m_CrossingBin + std::max(driftbins, 0);
+    m_TimeFrameRing[tbin % ringsize][std::make_pair(entry.hitsetkey, entry.phibin)] += entry.charge;
+  }
+}
+
+void PHG4TpcElectronDrift::WriteClosedSlices()
+{
+  // later crossings only add charge at or after their own time bin
+  const long long closed_bin = floor(m_Crossing * m_CrossingSpacing / m_TimeBinWidth);
+  const long long ringsize = m_TimeFrameRing.size();
+  const long long first_slice_start = m_NextSliceStart;
+  std::vector<TrkrHitSet *> staged;
+  while (m_NextSliceStart + m_SliceBins <= closed_bin)
+  {
+    if (Verbosity() > 0)
+    {
+      cout << "PHG4TpcElectronDrift: writing time slice from "
+           << m_NextSliceStart * m_TimeBinWidth << " ns to " << (m_NextSliceStart + m_SliceBins) * m_TimeBinWidth << " ns" << endl;
+    }
+    for (long long tbin = m_NextSliceStart; tbin < m_NextSliceStart + m_SliceBins; tbin++)
+    {
+      std::map<std::pair<TrkrDefs::hitsetkey, unsigned int>, double> &slot = m_TimeFrameRing[tbin % ringsize];
+      for (std::map<std::pair<TrkrDefs::hitsetkey, unsigned int>, double>::const_iterator iter = slot.begin(); iter != slot.end(); ++iter)
+      {
+        TrkrHitSetContainer::Iterator node_hitsetit = hitsetcontainer->findOrAddHitSet(iter->first.first);
+        if (!node_hitsetit->second->stagedSize())
+        {
+          staged.push_back(node_hitsetit->second);
+        }
+        node_hitsetit->second->stageHit(TpcDefs::genHitKey(iter->first.second, (unsigned int) (tbin - first_slice_start)), iter->second);
+      }
+      slot.clear();
+    }
+    m_NextSliceStart += m_SliceBins;
+  }
+  for (TrkrHitSet *hitset : staged)
+  {
+    hitset->addStagedHits<TpcHit>();
+  }
+}
+
+unsigned int PHG4TpcElectronDrift::DriftElectrons(const PHG4Hit *g4hit, const unsigned int n_electrons)
+{
+  m_Batch.resize(n_electrons, m_Distortion != nullptr);
+  // all random numbers of the g4hit in one call, the same numbers as drawing them one by one
+  m_Rng->Uniform(m_Batch.random.data(), n_electrons * kRandomsPerElectron);
+  const double *random = m_Batch.random.data();
+
+  const double x0 = g4hit->get_x(0);
+  const double y0 = g4hit->get_y(0);
+  const double z0 = g4hit->get_z(0);
+  const double t0 = g4hit->get_t(0);
+  const double dx = g4hit->get_x(1) - x0;
+  const double dy = g4hit->get_y(1) - y0;
+  const double dz = g4hit->get_z(1) - z0;
+  const double dt = g4hit->get_t(1) - t0;
+  const double half_length = tpc_length / 2.;
+  const double min_rad = min_active_radius - 2.0;
+  const double max_rad = max_active_radius + 1.0;
+
+  double *x_start = m_Batch.x_start.data();
+  double *y_start = m_Batch.y_start.data();
+  double *z_start = m_Batch.z_start.data();
+  double *t_start = m_Batch.t_start.data();
+  double *t_sigma = m_Batch.t_sigma.data();
+  double *t_final = m_Batch.t_final.data();
+  double *x_final = m_Batch.x_final.data();
+  double *y_final = m_Batch.y_final.data();
+  double *z_final = m_Batch.z_final.data();
+  double *rad_final = m_Batch.rad_final.data();
+  char *accept = m_Batch.accept.data();
+
+  // We choose the electron starting position at random from a flat distribution along the path length
+  // the parameter f is the fraction of the distance along the path betwen entry and exit points, it has values between 0 and 1
+  for (unsigned int i = 0; i < n_electrons; i++)
+  {
+    const double f = random[static_cast<size_t>(i) * kRandomsPerElectron];
+    x_start[i] = x0 + f * dx;
+    y_start[i] = y0 + f * dy;
+    z_start[i] = z0 + f * dz;
+    t_start[i] = t0 + f * dt;
+  }
+
+  // the diffusion starts from the distorted position, the distortions
+  // of all electrons are looked up in one call
+  const double *x_origin = x_start;
+  const double *y_origin = y_start;
+  if (m_Distortion)
+  {
+    double *r_start = m_Batch.r_start.data();
+    double *phi_start = m_Batch.phi_start.data();
+    double *dr = m_Batch.dr.data();
+    double *drphi = m_Batch.drphi.data();
+    double *x_distorted = m_Batch.x_distorted.data();
+    double *y_distorted = m_Batch.y_distorted.data();
+    for (unsigned int i = 0; i < n_electrons; i++)
+    {
+      r_start[i] = sqrt(x_start[i] * x_start[i] + y_start[i] * y_start[i]);
+      phi_start[i] = atan2(y_start[i], x_start[i]);
+    }
+    m_Distortion->get_distortions(n_electrons, r_start, phi_start, z_start, dr, drphi, m_Batch.dz.data());
+    for (unsigned int i = 0; i < n_electrons; i++)
+    {
+      const double r = r_start[i] + dr[i];
+      const double phi = phi_start[i] + drphi[i] / r_start[i];
+      x_distorted[i] = r * cos(phi);
+      y_distorted[i] = r * sin(phi);
+    }
+    x_origin = x_distorted;
+    y_origin = y_distorted;
+  }
+
+  // straight loop without branches over all electrons
+  for (unsigned int i = 0; i < n_electrons; i++)
+  {
+    const double *u = random + static_cast<size_t>(i) * kRandomsPerElectron;
+    const double ranphi = -M_PI + 2. * M_PI * u[1];
+    // two pairs of gaussians (Box-Muller) for the transverse and longitudinal diffusion and smearing,
+    // the uniforms are in [0,1) so 1-u goes into the log
+    const double rg1 = sqrt(-2. * log(1. - u[2]));
+    const double ag1 = 2. * M_PI * u[3];
+    const double rg2 = sqrt(-2. * log(1. - u[4]));
+    const double ag2 = 2. * M_PI * u[5];
+
+    const double drift_length = half_length - fabs(z_start[i]);
+    const double r_sigma = diffusion_trans * sqrt(drift_length);
+    const double rantrans = rg1 * cos(ag1) * r_sigma + rg1 * sin(ag1) * added_smear_sigma_trans;
+
+    const double t_path = drift_length / drift_velocity;
+    t_sigma[i] = diffusion_long * sqrt(drift_length) / drift_velocity;
+    const double rantime = rg2 * cos(ag2) * t_sigma[i] + rg2 * sin(ag2) * added_smear_sigma_long / drift_velocity;
+    t_final[i] = t_start[i] + t_path + rantime;
+
+    const double zsign = (z_start[i] < 0) ? -1. : 1.;
+    z_final[i] = zsign * (half_length - t_final[i] * drift_velocity);
+
+    x_final[i] = x_origin[i] + rantrans * cos(ranphi);
+    y_final[i] = y_origin[i] + rantrans * sin(ranphi);
+    rad_final[i] = sqrt(x_final[i] * x_final[i] + y_final[i] * y_final[i]);
+    // remove electrons outside of our time window and acceptance. Careful though, electrons from just
+    // inside 30 cm can contribute in the 1st active layer readout, so leave a little margin
+    accept[i] = (t_final[i] >= min_time && t_final[i] <= max_time &&
+                 rad_final[i] >= min_rad && rad_final[i] <= max_rad);
+  }
+
+  if (m_Distortion)
+  {
+    const double *dz_distortion = m_Batch.dz.data();
+    for (unsigned int i = 0; i < n_electrons; i++)
+    {
+      z_final[i] += dz_distortion[i];
+    }
+  }
+
+  // move the accepted electrons to the front
+  unsigned int n_accepted = 0;
+  for (unsigned int i = 0; i < n_electrons; i++)
+  {
+    if (!accept[i])
+    {
+      continue;
+    }
+    if (n_accepted != i)
+    {
+      x_start[n_accepted] = x_start[i];
+      y_start[n_accepted] = y_start[i];
+      z_start[n_accepted] = z_start[i];
+      t_start[n_accepted] = t_start[i];
+      t_sigma[n_accepted] = t_sigma[i];
+      t_final[n_accepted] = t_final[i];
+      x_final[n_accepted] = x_final[i];
+      y_final[n_accepted] = y_final[i];
+      z_final[n_accepted] = z_final[i];
+      rad_final[n_accepted] = rad_final[i];
+    }
+    n_accepted++;
+  }
+  return n_accepted;
+}
+
 void PHG4TpcElectronDrift::MapToPadPlane(const double x_gem, const double y_gem, const double t_gem, PHG4HitContainer::ConstIterator hiter, TNtuple *ntpad, TNtuple *nthit)
 {
-  padplane->MapToPadPlane(temp_hitsetcontainer, hittruthassoc, x_gem, y_gem, t_gem, hiter, ntpad, nthit);
+  // the charge goes to m_HitBuffer and is added to the hits with the current g4hit
+  padplane->MapToPadPlane(&m_HitBuffer, 1, &x_gem, &y_gem, &t_gem, hiter, ntpad, nthit);
 
   return;
 }
@@ -543,7 +757,7 @@ int PHG4TpcElectronDrift::End(PHCompositeNode *topNode)
 void PHG4TpcElectronDrift::set_seed(const unsigned int iseed)
 {
   seed = iseed;
-  gsl_rng_set(RandomGenerator, seed);
+  m_Rng->Seed(seed);
 }
 
 void PHG4TpcElectronDrift::SetDefaultParameters()
@@ -586,3 +800,9 @@ void PHG4TpcElectronDrift::registerPadPlane(PHG4TpcPadPlane *inpadplane)
 
   return;
 }
+
+void PHG4TpcElectronDrift::setTpcDistortion(PHG4TpcDistortion *distortion)
+{
+  delete m_Distortion;
+  m_Distortion = distortion;
+}
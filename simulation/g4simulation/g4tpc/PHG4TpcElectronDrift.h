@@ -9,18 +9,29 @@
 
 #include <phparameter/PHParameterInterface.h>
 
+#include <trackbase/TrkrDefs.h>
+
 // rootcint barfs with this header so we need to hide it
 #if !defined(__CINT__) || defined(__CLING__)
+#include "PHG4TpcHitBuffer.h"
+
 #include <gsl/gsl_rng.h>
 #endif
 
+#include <map>
 #include <string>                              // for string
+#include <utility>                             // for pair
+#include <vector>
 
+class PHG4Hit;
+class PHG4TpcDistortion;
 class PHG4TpcPadPlane;
 class PHCompositeNode;
+class PHCounterRng;
 class TH1;
 class TNtuple;
 class TFile;
+class TrkrHitSet;
 class TrkrHitSetContainer;
 class TrkrHitTruthAssoc;
 
@@ -42,11 +53,89 @@ class PHG4TpcElectronDrift : public SubsysReco, public PHParameterInterface
   void MapToPadPlane(const double x, const double y, const double z, PHG4HitContainer::ConstIterator hiter, TNtuple *ntpad, TNtuple *nthit);
   void registerPadPlane(PHG4TpcPadPlane *padplane);
 
+  //! distortion of the drifting electrons (e.g. PHG4TpcSpaceChargeDistortion), takes ownership
+  void setTpcDistortion(PHG4TpcDistortion *distortion);
+
+  //! time frame (streaming readout) mode: every event is one bunch crossing, crossing_spacing (ns)
+  //! after the previous one. The charge is kept in a ring buffer of readout time bins and each
+  //! slice of slice_length (ns) goes to TRKR_HITSET in the event in which it closes, i.e. when
+  //! no later crossing can add charge to it. The time bin of the hits is counted from the start
+  //! of the first slice written in that event. Memory is bounded by the maximum drift time plus
+  //! one slice. There is no hit-g4hit association in this mode, and slices still open at the end
+  //! of the run are not written
+  void set_time_frame_mode(const double crossing_spacing, const double slice_length)
+  {
+    m_TimeFrameFlag = true;
+    m_CrossingSpacing = crossing_spacing;
+    m_SliceLength = slice_length;
+  }
+
  private:
+  //! drift all electrons of one g4hit, the accepted ones end up at the front of m_Batch
+  unsigned int DriftElectrons(const PHG4Hit *g4hit, const unsigned int n_electrons);
+
+  //! electrons of one g4hit as structure of arrays
+  struct DriftBatch
+  {
+    //! the distortion arrays are only needed with a distortion
+    void resize(const unsigned int n, const bool distortion);
+    std::vector<double> x_start;
+    std::vector<double> y_start;
+    std::vector<double> z_start;
+    std::vector<double> t_start;
+    std::vector<double> t_sigma;
+    std::vector<double> t_final;
+    std::vector<double> x_final;
+    std::vector<double> y_final;
+    std::vector<double> z_final;
+    std::vector<double> rad_final;
+    std::vector<char> accept;
+    //! primary ionization in (r, phi), its distortion and the distorted (x, y) start of the diffusion
+    std::vector<double> r_start;
+    std::vector<double> phi_start;
+    std::vector<double> dr;
+    std::vector<double> drphi;
+    std::vector<double> dz;
+    std::vector<double> x_distorted;
+    std::vector<double> y_distorted;
+    //! kRandomsPerElectron uniforms per electron, drawn in one go from m_Rng
+    std::vector<double> random;
+  };
+  DriftBatch m_Batch;
+
+  //! adds the charge of m_HitBuffer from g4hit g4hitkey to the staged hits of TRKR_HITSET and its truth associations
+  void FlushHitBuffer(const PHG4HitDefs::keytype g4hitkey);
+
+  //! time frame mode: add the charge of m_HitBuffer to the ring buffer
+  void AddToTimeFrame();
+  //! time frame mode: write the slices which are closed after this crossing to hitsetcontainer
+  void WriteClosedSlices();
+
+  bool m_TimeFrameFlag;
+  double m_CrossingSpacing;
+  double m_SliceLength;
+  int m_NZBins;
+  //! readout time bin width in ns
+  double m_TimeBinWidth;
+  int m_SliceBins;
+  long long m_Crossing;
+  //! readout time bin of the current crossing
+  long long m_CrossingBin;
+  //! first time bin which has not been written yet
+  long long m_NextSliceStart;
+  //! charge per (hitset, pad), indexed by time bin modulo the ring size
+  std::vector<std::map<std::pair<TrkrDefs::hitsetkey, unsigned int>, double> > m_TimeFrameRing;
+
   TrkrHitSetContainer *hitsetcontainer;
-  TrkrHitSetContainer *temp_hitsetcontainer;
   TrkrHitTruthAssoc *hittruthassoc;
+#if !defined(__CINT__) || defined(__CLING__)
+  //! charge of the current g4hit per (layer, phibin, zbin)
+  PHG4TpcHitBuffer m_HitBuffer;
+  //! hitsets of TRKR_HITSET with staged hits of this event
+  std::vector<TrkrHitSet *> m_StagedHitSets;
+#endif
   PHG4TpcPadPlane *padplane;
+  PHG4TpcDistortion *m_Distortion;
   TH1 *dlong;
   TH1 *dtrans;
   TFile *m_outf;
@@ -71,6 +160,7 @@ class PHG4TpcElectronDrift : public SubsysReco, public PHParameterInterface
   double max_time;
 
 #if !defined(__CINT__) || defined(__CLING__)
+  PHCounterRng *m_Rng;
   gsl_rng *RandomGenerator;
 #endif
 };
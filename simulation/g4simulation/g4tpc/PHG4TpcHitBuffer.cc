@@ -0,0 +1,33 @@
+#include "PHG4TpcHitBuffer.h"
+
+#include <algorithm>
+
+namespace
+{
+  bool EntryLess(const PHG4TpcHitBuffer::Entry &lhs, const PHG4TpcHitBuffer::Entry &rhs)
+  {
+    if (lhs.hitsetkey != rhs.hitsetkey)
+    {
+      return lhs.hitsetkey < rhs.hitsetkey;
+    }
+    return lhs.hitkey < rhs.hitkey;
+  }
+}  // namespace
+
+void PHG4TpcHitBuffer::sort()
+{
+  // the slots still point to the old positions, they are only used again after clear()
+  if (!std::is_sorted(m_Entries.begin(), m_Entries.end(), EntryLess))
+  {
+    std::sort(m_Entries.begin(), m_Entries.end(), EntryLess);
+  }
+}
+
+void PHG4TpcHitBuffer::clear()
+{
+  for (const Entry &entry : m_Entries)
+  {
+    m_Slots[entry.layer][entry.phibin][entry.zbin] = -1;
+  }
+  m_Entries.clear();
+}
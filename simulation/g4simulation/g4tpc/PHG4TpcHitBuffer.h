@@ -0,0 +1,82 @@
+// Tell emacs that this is a C++ source
+//  -*- C++ -*-.
+#ifndef G4TPC_PHG4TPCHITBUFFER_H
+#define G4TPC_PHG4TPCHITBUFFER_H
+
+#include <trackbase/TrkrDefs.h>
+
+#include <vector>
+
+/*!
+ * \brief scratch buffer for the charge of one g4hit on the tpc pads
+ *
+ * The charge is summed in a dense (layer, phibin, zbin) table of slots,
+ * each touched bin gets one entry in a flat list. Adding charge is an
+ * array lookup instead of a search in the hit maps of a TrkrHitSet.
+ * The table grows to the largest bins seen and is kept between g4hits,
+ * clear() only resets the bins which were touched.
+ */
+class PHG4TpcHitBuffer
+{
+ public:
+  struct Entry
+  {
+    TrkrDefs::hitsetkey hitsetkey;
+    TrkrDefs::hitkey hitkey;
+    double charge;
+    unsigned int layer;
+    unsigned int phibin;
+    unsigned int zbin;
+  };
+
+  PHG4TpcHitBuffer() {}
+  virtual ~PHG4TpcHitBuffer() {}
+
+  //! adds charge to the bin, the keys are only used when the bin is touched first
+  void add(const TrkrDefs::hitsetkey hitsetkey, const TrkrDefs::hitkey hitkey, const unsigned int layer, const unsigned int phibin, const unsigned int zbin, const double charge)
+  {
+    int &slot = Slot(layer, phibin, zbin);
+    if (slot < 0)
+    {
+      slot = m_Entries.size();
+      Entry entry = {hitsetkey, hitkey, 0, layer, phibin, zbin};
+      m_Entries.push_back(entry);
+    }
+    m_Entries[slot].charge += charge;
+  }
+
+  //! orders the entries by hitset and hit key, no add() after this until clear()
+  void sort();
+
+  //! touched bins in the order they were touched (or sorted)
+  const std::vector<Entry> &entries() const { return m_Entries; }
+  bool empty() const { return m_Entries.empty(); }
+
+  void clear();
+
+ private:
+  int &Slot(const unsigned int layer, const unsigned int phibin, const unsigned int zbin)
+  {
+    if (layer >= m_Slots.size())
+    {
+      m_Slots.resize(layer + 1);
+    }
+    std::vector<std::vector<int> > &pads = m_Slots[layer];
+    if (phibin >= pads.size())
+    {
+      pads.resize(phibin + 1);
+    }
+    std::vector<int> &bins = pads[phibin];
+    if (zbin >= bins.size())
+    {
+      bins.resize(zbin + 1, -1);
+    }
+    return bins[zbin];
+  }
+
+  //! index into m_Entries per [layer][phibin][zbin], -1 if not touched
+  std::vector<std::vector<std::vector<int> > > m_Slots;
+  std::vector<Entry> m_Entries;
+};
+
+#endif  // G4TPC_PHG4TPCHITBUFFER_H
@@ -10,6 +10,7 @@
 #include <string>                              // for string
 
 class PHG4CellContainer;
+class PHG4TpcHitBuffer;
 class TrkrHitSetContainer;
 class TrkrHitTruthAssoc;
 
@@ -40,6 +41,16 @@ class PHG4TpcPadPlane : public SubsysReco, public PHParameterInterface
   virtual void UpdateInternalParameters() { return; }
   virtual void MapToPadPlane(PHG4CellContainer *g4cells, const double x_gem, const double y_gem, const double t_gem, PHG4HitContainer::ConstIterator hiter, TNtuple *ntpad, TNtuple *nthit) {}
   virtual void MapToPadPlane(TrkrHitSetContainer *hitsetcontainer, TrkrHitTruthAssoc * hittruthassoc, const double x_gem, const double y_gem, const double t_gem, PHG4HitContainer::ConstIterator hiter, TNtuple *ntpad, TNtuple *nthit) {}
+  //! all n drifted electrons of one g4hit at once, readouts can override this to process them as a batch
+  virtual void MapToPadPlane(TrkrHitSetContainer *hitsetcontainer, TrkrHitTruthAssoc *hittruthassoc, const unsigned int n, const double *x_gem, const double *y_gem, const double *t_gem, PHG4HitContainer::ConstIterator hiter, TNtuple *ntpad, TNtuple *nthit)
+  {
+    for (unsigned int i = 0; i < n; i++)
+    {
+      MapToPadPlane(hitsetcontainer, hittruthassoc, x_gem[i], y_gem[i], t_gem[i], hiter, ntpad, nthit);
+    }
+  }
+  //! adds the charge of the n drifted electrons of one g4hit to the buffer, the caller makes the hits from it
+  virtual void MapToPadPlane(PHG4TpcHitBuffer *hitbuffer, const unsigned int n, const double *x_gem, const double *y_gem, const double *t_gem, PHG4HitContainer::ConstIterator hiter, TNtuple *ntpad, TNtuple *nthit) {}
   void Detector(const std::string &name) { detector = name; }
 
  protected:
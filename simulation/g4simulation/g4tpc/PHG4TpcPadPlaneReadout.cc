@@ -1,4 +1,5 @@
 #include "PHG4TpcPadPlaneReadout.h"
+#include "PHG4TpcHitBuffer.h"
 
 #include <g4detectors/PHG4Cell.h>                       // for PHG4Cell
 #include <g4detectors/PHG4CellDefs.h>                   // for genkey, keytype
@@ -9,7 +10,7 @@
 
 #include <g4main/PHG4Hit.h>                             // for PHG4Hit
 #include <g4main/PHG4HitContainer.h>
-#include <phool/PHRandomSeed.h>
+#include <phool/PHCounterRng.h>
 
 // Move to new storage containers
 #include <trackbase/TrkrDefs.h>                         // for hitkey, hitse...
@@ -27,6 +28,7 @@
 #include <gsl/gsl_randist.h>
 #include <gsl/gsl_rng.h>                                // for gsl_rng_alloc
 
+#include <algorithm>                                   // for min, max
 #include <cmath>
 #include <cassert>
 #include <climits>                                     // for INT_MAX
@@ -64,15 +66,15 @@ PHG4TpcPadPlaneReadout::PHG4TpcPadPlaneReadout(const string &name)
     _gauss_weights[i] = std::exp( -square( x )/2 );
   }
 
-  RandomGenerator = gsl_rng_alloc(gsl_rng_mt19937);
-  gsl_rng_set(RandomGenerator, PHRandomSeed());  // fixed seed is handled in this funtcion
+  m_Rng = new PHCounterRng(Name());
+  RandomGenerator = m_Rng->get_gsl_rng();
 
   return;
 }
 
 PHG4TpcPadPlaneReadout::~PHG4TpcPadPlaneReadout()
 {
-  gsl_rng_free(RandomGenerator);
+  delete m_Rng;
 }
 
 int PHG4TpcPadPlaneReadout::CreateReadoutGeometry(PHCompositeNode *topNode, PHG4CylinderCellGeomContainer *seggeo)
@@ -117,9 +119,134 @@ int PHG4TpcPadPlaneReadout::CreateReadoutGeometry(PHCompositeNode *topNode, PHG4
 
   GeomContainer = seggeo;
 
+  build_pad_response();
+
   return 0;
 }
 
+void PHG4TpcPadPlaneReadout::build_pad_response()
+{
+  // The charge shared between the pads only depends on the position of the electron
+  // relative to the center of its pad (in units of the pad pitch) and the cloud
+  // sigma, which is the same for all electrons. Tabulate it per layer and interpolate
+  // instead of integrating the gaussian for every electron
+  _pad_response.clear();
+  PHG4CylinderCellGeomContainer::ConstRange layerrange = GeomContainer->get_begin_end();
+  for (PHG4CylinderCellGeomContainer::ConstIterator layeriter = layerrange.first;
+       layeriter != layerrange.second;
+       ++layeriter)
+  {
+    const PHG4CylinderCellGeom *layergeom = layeriter->second;
+    const unsigned int layer = layergeom->get_layer();
+    if (_pad_response.size() <= layer)
+    {
+      _pad_response.resize(layer + 1);
+    }
+    PadResponseTable &table = _pad_response[layer];
+
+    const double pitch = layergeom->get_radius() * layergeom->get_phistep();
+    table.sigma = sigmaT;
+    table.noffsets = _pad_response_offsets;
+    if (zigzag_pads)
+    {
+      // the gaussian is sampled from -4.5 to +5.5 sigma and a zigzag pad extends one pitch on each side
+      table.npads_side = int((_nsigmas + 0.5) * sigmaT / pitch + 1.5) + 1;
+    }
+    else
+    {
+      // consider phi bins up and down 3 sigma in r-phi
+      table.npads_side = int(3 * sigmaT / pitch + 1);
+    }
+    const int npads = 2 * table.npads_side + 1;
+    table.share.assign(table.noffsets * npads, 0);
+
+    for (int ioffset = 0; ioffset < table.noffsets; ++ioffset)
+    {
+      const double disp = (-0.5 + (double) ioffset / (table.noffsets - 1)) * pitch;
+      double *share = &table.share[ioffset * npads];
+      if (zigzag_pads)
+      {
+        // zigzag pads have a triangular response of half width pad_rphi/2 = pitch
+        const double xstep = 2.0 * _nsigmas * sigmaT / (double) _ngauss_steps;
+        for (int i = 0; i < _ngauss_steps; i++)
+        {
+          const double x = disp - 4.5 * sigmaT + (double) i * xstep;
+          for (int ipad = 0; ipad < npads; ipad++)
+          {
+            const double pad_response = get_pad_response(x, {{pitch, (ipad - table.npads_side) * pitch}});
+            if (pad_response > 0)
+            {
+              share[ipad] += _gauss_weights[i] * pad_response;
+            }
+          }
+        }
+      }
+      else
+      {
+        for (int ipad = 0; ipad < npads; ipad++)
+        {
+          const int iphi = ipad - table.npads_side;
+          double phiLim1 = 0.5 * M_SQRT2 * ((iphi + 0.5) * pitch - disp) / sigmaT;
+          double phiLim2 = 0.5 * M_SQRT2 * ((iphi - 0.5) * pitch - disp) / sigmaT;
+          share[ipad] = 0.5 * (erf(phiLim1) - erf(phiLim2));
+        }
+      }
+    }
+    if (Verbosity())
+    {
+      cout << "PHG4TpcPadPlaneReadout: pad response table for layer " << layer
+           << " pitch " << pitch << " sigma " << sigmaT << " pads " << npads
+           << " offsets " << table.noffsets << endl;
+    }
+  }
+}
+
+bool PHG4TpcPadPlaneReadout::lookup_pad_response(const unsigned int layernum, const double phi, const double cloud_sig_rp, std::vector<int> &pad_phibin, std::vector<double> &pad_phibin_share) const
+{
+  if (layernum >= _pad_response.size())
+  {
+    return false;
+  }
+  const PadResponseTable &table = _pad_response[layernum];
+  if (table.noffsets == 0 || table.sigma != cloud_sig_rp)
+  {
+    return false;
+  }
+
+  const int phibin = LayerGeom->get_phibin(phi);
+  const int nphibins = LayerGeom->get_phibins();
+  const double phistep = LayerGeom->get_phistep();
+
+  // position inside the pad, the phi of the electron can be off by 2pi from the pad center
+  double offset = (phi - LayerGeom->get_phicenter(phibin)) / phistep;
+  offset -= nphibins * std::round(offset / nphibins);
+
+  // linear interpolation between the two nearest offsets
+  const double pos = std::min(std::max(offset + 0.5, 0.), 1.) * (table.noffsets - 1);
+  const int ioffset = std::min((int) pos, table.noffsets - 2);
+  const double frac = pos - ioffset;
+  const int npads = 2 * table.npads_side + 1;
+  const double *low = &table.share[ioffset * npads];
+  const double *high = low + npads;
+
+  for (int ipad = 0; ipad < npads; ipad++)
+  {
+    const double share = low[ipad] + frac * (high[ipad] - low[ipad]);
+    if (share <= 0) continue;
+
+    int cur_phi_bin = phibin + ipad - table.npads_side;
+    // correcting for continuity in phi
+    if (cur_phi_bin < 0)
+      cur_phi_bin += nphibins;
+    else if (cur_phi_bin >= nphibins)
+      cur_phi_bin -= nphibins;
+
+    pad_phibin.push_back(cur_phi_bin);
+    pad_phibin_share.push_back(share);
+  }
+  return true;
+}
+
 // This is obsolete, it uses the old PHG4Cell containers
 void PHG4TpcPadPlaneReadout::MapToPadPlane(PHG4CellContainer *g4cells, const double x_gem, const double y_gem, const double z_gem, PHG4HitContainer::ConstIterator hiter, TNtuple *ntpad, TNtuple *nthit)
 {
@@ -320,7 +447,51 @@ double PHG4TpcPadPlaneReadout::getSingleEGEMAmplification()
   return nelec;
 }
 
-void PHG4TpcPadPlaneReadout::MapToPadPlane(TrkrHitSetContainer *hitsetcontainer, TrkrHitTruthAssoc *hittruthassoc, const double x_gem, const double y_gem, const double z_gem, PHG4HitContainer::ConstIterator hiter, TNtuple *ntpad, TNtuple *nthit)
+void PHG4TpcPadPlaneReadout::MapToPadPlane(TrkrHitSetContainer *hitsetcontainer, TrkrHitTruthAssoc * /*hittruthassoc*/, const double x_gem, const double y_gem, const double z_gem, PHG4HitContainer::ConstIterator hiter, TNtuple *ntpad, TNtuple *nthit)
+{
+  StageElectron(&m_HitBuffer, x_gem, y_gem, z_gem, hiter, ntpad, nthit);
+  AddBufferedHits(hitsetcontainer);
+}
+
+void PHG4TpcPadPlaneReadout::MapToPadPlane(TrkrHitSetContainer *hitsetcontainer, TrkrHitTruthAssoc * /*hittruthassoc*/, const unsigned int n, const double *x_gem, const double *y_gem, const double *t_gem, PHG4HitContainer::ConstIterator hiter, TNtuple *ntpad, TNtuple *nthit)
+{
+  MapToPadPlane(&m_HitBuffer, n, x_gem, y_gem, t_gem, hiter, ntpad, nthit);
+  AddBufferedHits(hitsetcontainer);
+}
+
+void PHG4TpcPadPlaneReadout::MapToPadPlane(PHG4TpcHitBuffer *hitbuffer, const unsigned int n, const double *x_gem, const double *y_gem, const double *t_gem, PHG4HitContainer::ConstIterator hiter, TNtuple *ntpad, TNtuple *nthit)
+{
+  for (unsigned int i = 0; i < n; i++)
+  {
+    StageElectron(hitbuffer, x_gem[i], y_gem[i], t_gem[i], hiter, ntpad, nthit);
+  }
+}
+
+void PHG4TpcPadPlaneReadout::AddBufferedHits(TrkrHitSetContainer *hitsetcontainer)
+{
+  // ordered by hitset, so every hitset is looked up once
+  m_HitBuffer.sort();
+  TrkrHitSet *hitset = nullptr;
+  TrkrDefs::hitsetkey hitsetkey = 0;
+  std::vector<TrkrHitSet *> staged;
+  for (const PHG4TpcHitBuffer::Entry &entry : m_HitBuffer.entries())
+  {
+    if (!hitset || entry.hitsetkey != hitsetkey)
+    {
+      hitsetkey = entry.hitsetkey;
+      hitset = hitsetcontainer->findOrAddHitSet(hitsetkey)->second;
+      staged.push_back(hitset);
+    }
+    hitset->stageHit(entry.hitkey, entry.charge);
+  }
+  for (TrkrHitSet *stagedset : staged)
+  {
+    stagedset->addStagedHits<TpcHit>();
+  }
+  m_HitBuffer.clear();
+}
+
+void PHG4TpcPadPlaneReadout::StageElectron(PHG4TpcHitBuffer *hitbuffer, const double x_gem, const double y_gem, const double z_gem, PHG4HitContainer::ConstIterator hiter, TNtuple *ntpad, TNtuple *nthit)
 {
   // One electron per call of this method
   // The x_gem and y_gem values have already been randomized within the transverse drift diffusion width
@@ -475,23 +646,11 @@ void PHG4TpcPadPlaneReadout::MapToPadPlane(TrkrHitSetContainer *hitsetcontainer,
       unsigned int pads_per_sector = phibins / 12;
       unsigned int sector = pad_num / pads_per_sector;
       TrkrDefs::hitsetkey hitsetkey = TpcDefs::genHitSetKey(layernum, sector, side);
-      // Use existing hitset or add new one if needed
-      TrkrHitSetContainer::Iterator hitsetit = hitsetcontainer->findOrAddHitSet(hitsetkey);
 
       // generate the key for this hit, requires zbin and phibin
       TrkrDefs::hitkey hitkey = TpcDefs::genHitKey((unsigned int) pad_num, (unsigned int) zbin_num);
-      // See if this hit already exists
-      TrkrHit *hit = nullptr;
-      hit = hitsetit->second->getHit(hitkey);
-      if (!hit)
-      {
-        // create a new one
-        hit = new TpcHit();
-        hitsetit->second->addHitSpecificKey(hitkey, hit);
-      }
-
-      // Either way, add the energy to it  -- adc values will be added at digitization
-      hit->addEnergy(neffelectrons);
+      // the charge is summed in the buffer, the hits are made from it by the caller -- adc values will be added at digitization
+      hitbuffer->add(hitsetkey, hitkey, layernum, pad_num, zbin_num, neffelectrons);
 
       if (Verbosity() > 0)
       {
@@ -530,6 +689,11 @@ void PHG4TpcPadPlaneReadout::MapToPadPlane(TrkrHitSetContainer *hitsetcontainer,
 
 void PHG4TpcPadPlaneReadout::populate_rectangular_phibins(const unsigned int layernum, const double phi, const double cloud_sig_rp, std::vector<int> &pad_phibin, std::vector<double> &pad_phibin_share)
 {
+  if (lookup_pad_response(layernum, phi, cloud_sig_rp, pad_phibin, pad_phibin_share))
+  {
+    return;
+  }
+
   double cloud_sig_rp_inv = 1. / cloud_sig_rp;
 
   const int phibin = LayerGeom->get_phibin(phi);
@@ -568,6 +732,11 @@ void PHG4TpcPadPlaneReadout::populate_rectangular_phibins(const unsigned int lay
 
 void PHG4TpcPadPlaneReadout::populate_zigzag_phibins(const unsigned int layernum, const double phi, const double cloud_sig_rp, std::vector<int> &pad_phibin, std::vector<double> &pad_phibin_share)
 {
+  if (lookup_pad_response(layernum, phi, cloud_sig_rp, pad_phibin, pad_phibin_share))
+  {
+    return;
+  }
+
   const double radius = LayerGeom->get_radius();
   const double phistepsize = LayerGeom->get_phistep();
   const auto phibins = LayerGeom->get_phibins();
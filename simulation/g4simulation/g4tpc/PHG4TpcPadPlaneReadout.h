@@ -7,6 +7,8 @@
 
 // rootcint barfs with this header so we need to hide it
 #if !defined(__CINT__) || defined(__CLING__)
+#include "PHG4TpcHitBuffer.h"
+
 #include <gsl/gsl_rng.h>
 #include <array>
 #endif
@@ -17,11 +19,13 @@
 #include <vector>
 
 class PHCompositeNode;
+class PHCounterRng;
 class PHG4CellContainer;
 class PHG4CylinderCellGeomContainer;
 class PHG4CylinderCellGeom;
 class TF1;
 class TNtuple;
+class TrkrHitSet;
 class TrkrHitSetContainer;
 class TrkrHitTruthAssoc;
 
@@ -38,6 +42,11 @@ class PHG4TpcPadPlaneReadout : public PHG4TpcPadPlane
 
   void MapToPadPlane(TrkrHitSetContainer *hitsetcontainer, TrkrHitTruthAssoc *hittruthassoc, const double x_gem, const double y_gem, const double t_gem, PHG4HitContainer::ConstIterator hiter, TNtuple *ntpad, TNtuple *nthit);
 
+  //! sums the charge of all electrons in a buffer and then makes the hits in one go
+  void MapToPadPlane(TrkrHitSetContainer *hitsetcontainer, TrkrHitTruthAssoc *hittruthassoc, const unsigned int n, const double *x_gem, const double *y_gem, const double *t_gem, PHG4HitContainer::ConstIterator hiter, TNtuple *ntpad, TNtuple *nthit);
+
+  void MapToPadPlane(PHG4TpcHitBuffer *hitbuffer, const unsigned int n, const double *x_gem, const double *y_gem, const double *t_gem, PHG4HitContainer::ConstIterator hiter, TNtuple *ntpad, TNtuple *nthit);
+
   void SetDefaultParameters();
   void UpdateInternalParameters();
 
@@ -47,9 +56,20 @@ class PHG4TpcPadPlaneReadout : public PHG4TpcPadPlane
   void populate_zigzag_phibins(const unsigned int layernum, const double phi, const double cloud_sig_rp, std::vector<int> &pad_phibin, std::vector<double> &pad_phibin_share);
   void populate_zbins(const double z, const std::array<double,2>& cloud_sig_zz, std::vector<int> &adc_zbin, std::vector<double> &adc_zbin_share);
 
+  //! precompute the charge sharing between pads for each layer, called from CreateReadoutGeometry
+  void build_pad_response();
+
+  //! adds the charge of one electron to the buffer
+  void StageElectron(PHG4TpcHitBuffer *hitbuffer, const double x_gem, const double y_gem, const double t_gem, PHG4HitContainer::ConstIterator hiter, TNtuple *ntpad, TNtuple *nthit);
+  //! turns the charges of m_HitBuffer into TpcHits
+  void AddBufferedHits(TrkrHitSetContainer *hitsetcontainer);
+
 #if !defined(__CINT__) || defined(__CLING__)
   std::string seggeonodename;
 
+  //! charge of the electrons for the MapToPadPlane calls with a TrkrHitSetContainer
+  PHG4TpcHitBuffer m_HitBuffer;
+
   PHG4CylinderCellGeomContainer *GeomContainer = nullptr;
   PHG4CylinderCellGeom *LayerGeom = nullptr;
 
@@ -86,6 +106,26 @@ class PHG4TpcPadPlaneReadout : public PHG4TpcPadPlane
 
   double averageGEMGain = NAN;
 
+  //! share of the charge on the pads around the electron's pad, tabulated
+  //! vs. the position of the electron inside its pad for a fixed cloud sigma
+  struct PadResponseTable
+  {
+    double sigma = NAN;
+    //! pads -npads_side ... +npads_side relative to the electron's pad
+    int npads_side = 0;
+    //! sampling points of the offset from -1/2 to +1/2 pad pitch
+    int noffsets = 0;
+    //! [ioffset * (2*npads_side+1) + ipad]
+    std::vector<double> share;
+  };
+  static constexpr int _pad_response_offsets = 201;
+
+  //! indexed by layer number, empty for non tpc layers
+  std::vector<PadResponseTable> _pad_response;
+
+  //! fill pads and shares from the table of this layer, false if no table matches cloud_sig_rp
+  bool lookup_pad_response(const unsigned int layernum, const double phi, const double cloud_sig_rp, std::vector<int> &pad_phibin, std::vector<double> &pad_phibin_share) const;
+
 #endif
 
   std::vector<int> adc_zbin;
@@ -96,6 +136,7 @@ class PHG4TpcPadPlaneReadout : public PHG4TpcPadPlane
   // return random distribution of number of electrons after amplification of GEM for each initial ionizing electron
   double getSingleEGEMAmplification();
 #if !defined(__CINT__) || defined(__CLING__)
+  PHCounterRng *m_Rng;
   gsl_rng *RandomGenerator;
 #endif
 };
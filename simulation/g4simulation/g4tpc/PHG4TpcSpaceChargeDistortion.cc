@@ -28,6 +28,7 @@ using namespace std;
 PHG4TpcSpaceChargeDistortion::PHG4TpcSpaceChargeDistortion(
     const std::string &distortion_map_file, int verbose)
   : PHG4TpcDistortion(verbose)
+  , m_Time(0)
 {
   TFile file(distortion_map_file.c_str());
 
@@ -50,6 +51,8 @@ PHG4TpcSpaceChargeDistortion::PHG4TpcSpaceChargeDistortion(
 
     exit(13);
   }
+  m_RMap.AddMap(rDistortion);
+  m_RMap.PhiDependent(false);
   rDistortion->GetYaxis()->SetRange(1, 1);
   rDistortion2 = dynamic_cast<TH2D *>(rDistortion->Project3D("xz"));
   assert(rDistortion2);
@@ -65,6 +68,8 @@ PHG4TpcSpaceChargeDistortion::PHG4TpcSpaceChargeDistortion(
 
     exit(13);
   }
+  m_RPhiMap.AddMap(rPhiDistortion);
+  m_RPhiMap.PhiDependent(false);
   rPhiDistortion->GetYaxis()->SetRange(1, 1);
   rPhiDistortion2 = dynamic_cast<TH2D *>(rPhiDistortion->Project3D("xz"));
   assert(rPhiDistortion2);
@@ -139,6 +144,44 @@ PHG4TpcSpaceChargeDistortion::PHG4TpcSpaceChargeDistortion(
   }
 }
 
+bool PHG4TpcSpaceChargeDistortion::add_time_map(const std::string &distortion_map_file, const double time)
+{
+  TFile file(distortion_map_file.c_str());
+  if (not file.IsOpen())
+  {
+    cout << "PHG4TpcSpaceChargeDistortion::add_time_map - "
+         << "Failed to open distortion file " << distortion_map_file << endl;
+    return false;
+  }
+  TH3F *rDistortion = dynamic_cast<TH3F *>(file.Get("mapDeltaR"));
+  TH3F *rPhiDistortion = dynamic_cast<TH3F *>(file.Get("mapRDeltaPHI"));
+  if (not rDistortion or not rPhiDistortion)
+  {
+    cout << "PHG4TpcSpaceChargeDistortion::add_time_map - "
+         << "Failed to find TH3F mapDeltaR and mapRDeltaPHI in distortion file "
+         << distortion_map_file << endl;
+    return false;
+  }
+  // both maps or none, they are interpolated in time together
+  PHG4TpcDistortionMap rmap = m_RMap;
+  if (not rmap.AddMap(rDistortion, time) or not m_RPhiMap.AddMap(rPhiDistortion, time))
+  {
+    return false;
+  }
+  m_RMap = rmap;
+  if (verbosity > 0)
+  {
+    m_RMap.Print();
+  }
+  return true;
+}
+
+void PHG4TpcSpaceChargeDistortion::set_phi_dependent(const bool b)
+{
+  m_RMap.PhiDependent(b);
+  m_RPhiMap.PhiDependent(b);
+}
+
 PHG4TpcSpaceChargeDistortion::~PHG4TpcSpaceChargeDistortion()
 {
   if (rDistortion2)
@@ -154,8 +197,7 @@ PHG4TpcSpaceChargeDistortion::get_r_distortion(double r, double phi, double z)
   if (z > 0)
     z = -z;
 
-  //double dist = rDistortion->Interpolate(r,lowY,z);
-  double dist = rDistortion2->Interpolate(z, r);
+  double dist = m_RMap.Interpolate(r, phi, z, m_Time);
   double dist2 = accuracyFactor * dist + gsl_ran_gaussian(RandomGenerator, precisionFactor * dist);
   if (verbosity > 0)
   {
@@ -180,8 +222,7 @@ PHG4TpcSpaceChargeDistortion::get_rphi_distortion(double r, double phi,
   if (z > 0)
     z = -z;
 
-  //double dist = rPhiDistortion->Interpolate(r,lowY,z);
-  double dist = rPhiDistortion2->Interpolate(z, r);
+  double dist = m_RPhiMap.Interpolate(r, phi, z, m_Time);
   double dist2 = accuracyFactor * dist + gsl_ran_gaussian(RandomGenerator, precisionFactor * dist);
   if (verbosity > 0)
   {
@@ -196,3 +237,30 @@ PHG4TpcSpaceChargeDistortion::get_rphi_distortion(double r, double phi,
 
   return dist2;
 }
+
+void PHG4TpcSpaceChargeDistortion::get_distortions(const unsigned int n, const double *r, const double *phi, const double *z,
+                                                   double *dr, double *drphi, double *dz)
+{
+  if (n == 0)
+  {
+    return;
+  }
+  //  Calculations ONLY for minus z;
+  m_ZBuffer.resize(n);
+  for (unsigned int i = 0; i < n; i++)
+  {
+    m_ZBuffer[i] = (z[i] > 0 ? -z[i] : z[i]);
+  }
+  m_RMap.Interpolate(n, r, phi, &m_ZBuffer[0], dr, m_Time);
+  m_RPhiMap.Interpolate(n, r, phi, &m_ZBuffer[0], drphi, m_Time);
+  // the smearing draws all r values first, the random sequence differs from single point calls
+  for (unsigned int i = 0; i < n; i++)
+  {
+    dr[i] = accuracyFactor * dr[i] + gsl_ran_gaussian(RandomGenerator, precisionFactor * dr[i]);
+  }
+  for (unsigned int i = 0; i < n; i++)
+  {
+    drphi[i] = accuracyFactor * drphi[i] + gsl_ran_gaussian(RandomGenerator, precisionFactor * drphi[i]);
+    dz[i] = 0;
+  }
+}
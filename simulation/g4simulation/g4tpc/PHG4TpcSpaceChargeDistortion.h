@@ -14,8 +14,10 @@
 class TH2D;
 
 #include "PHG4TpcDistortion.h"
+#include "PHG4TpcDistortionMap.h"
 
 #include <string>
+#include <vector>
 
 /*!
  * \brief PHG4TpcSpaceChargeDistortion
@@ -62,6 +64,18 @@ class PHG4TpcSpaceChargeDistortion : public PHG4TpcDistortion
   double
   get_z_distortion(double r, double phi, double z) { return 0; }
 
+  //! r and r*phi distortions of n primary ionizations, the maps are interpolated in one go
+  void
+  get_distortions(const unsigned int n, const double *r, const double *phi, const double *z,
+                  double *dr, double *drphi, double *dz);
+
+  //! adds the maps of another file for the given time, the maps of the constructor are at time 0
+  bool add_time_map(const std::string &distortion_map_file, const double time);
+  //! time used for the interpolation between the maps
+  void set_time(const double t) { m_Time = t; }
+  //! use the full phi dependence of the maps, by default only the first phi bin is used
+  void set_phi_dependent(const bool b);
+
   TH2D *DRHIST() { return rDistortion2; }
   TH2D *DRPHIHIST() { return rPhiDistortion2; }
 
@@ -77,6 +91,12 @@ class PHG4TpcSpaceChargeDistortion : public PHG4TpcDistortion
   TH2D *rDistortion2;
   TH2D *rPhiDistortion2;
 
+  PHG4TpcDistortionMap m_RMap;
+  PHG4TpcDistortionMap m_RPhiMap;
+  double m_Time;
+  //! z mirrored to negative values for the batched lookup
+  std::vector<double> m_ZBuffer;
+
   double precisionFactor;
   double accuracyFactor;
 };
@@ -7,7 +7,6 @@
 
 #include <g4main/PHG4Hit.h>
 #include <g4main/PHG4HitContainer.h>
-#include <g4main/PHG4Hitv1.h>
 #include <g4main/PHG4Shower.h>
 #include <g4main/PHG4SteppingAction.h>         // for PHG4SteppingAction
 
@@ -45,6 +44,7 @@ PHG4TpcSteppingAction::PHG4TpcSteppingAction(PHG4TpcDetector* detector, const PH
   , hits_(nullptr)
   , absorberhits_(nullptr)
   , hit(nullptr)
+  , hit_version(PHG4HitContainer::HitVersion())
   , params(parameters)
   , savehitcontainer(nullptr)
   , saveshower(nullptr)
@@ -72,6 +72,12 @@ PHG4TpcSteppingAction::~PHG4TpcSteppingAction()
   // legal to delete (it results in a no operation)
   delete hit;
 }
+//____________________________________________________________________________..
+bool PHG4TpcSteppingAction::HandlesVolume(G4VPhysicalVolume* volume)
+{
+  return detector_->IsInTpc(volume) != 0;
+}
+
 //____________________________________________________________________________..
 bool PHG4TpcSteppingAction::UserSteppingAction(const G4Step* aStep, bool)
 {
@@ -147,7 +153,7 @@ bool PHG4TpcSteppingAction::UserSteppingAction(const G4Step* aStep, bool)
     // and we have to make a new one
     if (!hit)
     {
-      hit = new PHG4Hitv1();
+      hit = PHG4HitContainer::NewHit(hit_version);
     }
     hit->set_layer(layer_id);
     //here we set the entrance values in cm
@@ -24,6 +24,9 @@ class PHG4TpcSteppingAction : public PHG4SteppingAction
   //! stepping action
   virtual bool UserSteppingAction(const G4Step *, bool);
 
+  //! only steps in our own volumes are dispatched to this stepping action
+  virtual bool HandlesVolume(G4VPhysicalVolume *volume);
+
   //! reimplemented from base class
   virtual void SetInterfacePointers(PHCompositeNode *);
 
@@ -35,6 +38,8 @@ class PHG4TpcSteppingAction : public PHG4SteppingAction
   PHG4HitContainer *hits_;
   PHG4HitContainer *absorberhits_;
   PHG4Hit *hit;
+  //! PHG4Hit version created, PHG4HitContainer::HitVersion()
+  int hit_version;
   const PHParameters *params;
   PHG4HitContainer *savehitcontainer;
   PHG4Shower *saveshower;
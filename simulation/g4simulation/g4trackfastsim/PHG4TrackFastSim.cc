@@ -6,6 +6,7 @@
  */
 
 #include "PHG4TrackFastSim.h"
+#include "PHG4TrackFastSimResolutionTable.h"
 
 #include <phgenfit/Fitter.h>
 #include <phgenfit/Measurement.h>  // for Measurement
@@ -59,10 +60,14 @@
 #include <GenFit/GFRaveVertexFactory.h>
 #include <GenFit/Track.h>
 
+#include <TDatabasePDG.h>
 #include <TMath.h>
+#include <TMatrixD.h>
 #include <TMatrixDSymfwd.h>  // for TMatrixDSym
 #include <TMatrixTSym.h>     // for TMatrixTSym
 #include <TMatrixTUtils.h>   // for TMatrixTRow
+#include <TParticlePDG.h>
+#include <TVector2.h>
 #include <TVector3.h>        // for TVector3, operator*
 #include <TVectorDfwd.h>     // for TVectorD
 #include <TVectorT.h>        // for TVectorT
@@ -113,6 +118,8 @@ PHG4TrackFastSim::PHG4TrackFastSim(const std::string& name)
   , _vertex_xy_resolution(50E-4)
   , _vertex_z_resolution(50E-4)
   , _primary_tracking(1)
+  , m_ResolutionTable(nullptr)
+  , m_ParametrizedFlag(false)
 {
   _event = -1;
 
@@ -125,9 +132,21 @@ PHG4TrackFastSim::~PHG4TrackFastSim()
 {
   delete _fitter;
   delete _vertex_finder;
+  delete m_ResolutionTable;
   gsl_rng_free(m_RandomGenerator);
 }
 
+void PHG4TrackFastSim::set_resolution_table_output(const std::string& filename,
+                                                   const int npt, const double ptmin, const double ptmax,
+                                                   const int neta, const double etamin, const double etamax)
+{
+  delete m_ResolutionTable;
+  m_ResolutionTable = new PHG4TrackFastSimResolutionTable();
+  m_ResolutionTable->SetBinning(npt, ptmin, ptmax, neta, etamin, etamax);
+  m_ResolutionTableFile = filename;
+  m_ParametrizedFlag = false;
+}
+
 int PHG4TrackFastSim::InitRun(PHCompositeNode* topNode)
 {
   _event = -1;
@@ -143,6 +162,22 @@ int PHG4TrackFastSim::InitRun(PHCompositeNode* topNode)
     return ret;
   }
 
+  if (m_ParametrizedFlag)
+  {
+    delete m_ResolutionTable;
+    m_ResolutionTable = new PHG4TrackFastSimResolutionTable();
+    if (m_ResolutionTable->Read(m_ResolutionTableFile))
+    {
+      cout << PHWHERE << " could not read resolution table " << m_ResolutionTableFile << endl;
+      return Fun4AllReturnCodes::ABORTRUN;
+    }
+    if (_do_vertexing || !_state_names.empty())
+    {
+      cout << PHWHERE << " WARNING: no vertexing and no track state projections in parametrized mode" << endl;
+    }
+    return Fun4AllReturnCodes::EVENT_OK;
+  }
+
   TGeoManager* tgeo_manager = PHGeomUtility::GetTGeoManager(topNode);
   PHField* field = PHFieldUtility::GetFieldMapNode(nullptr, topNode);
 
@@ -232,6 +267,11 @@ int PHG4TrackFastSim::End(PHCompositeNode* topNode)
     _fitter->displayEvent();
   }
 
+  if (m_ResolutionTable && !m_ParametrizedFlag)
+  {
+    m_ResolutionTable->Write(m_ResolutionTableFile);
+  }
+
   return Fun4AllReturnCodes::EVENT_OK;
 }
 
@@ -281,6 +321,7 @@ int PHG4TrackFastSim::process_event(PHCompositeNode* topNode)
   }
 
   GenFitTrackMap gf_track_map;
+  IndexHits();
   // Now we can loop over the particles
 
   for (PHG4TruthInfoContainer::ConstIterator itr = itr_range.first;
@@ -288,6 +329,38 @@ int PHG4TrackFastSim::process_event(PHCompositeNode* topNode)
   {
     PHG4Particle* particle = itr->second;
 
+    if (m_ParametrizedFlag)
+    {
+      // count the hits found for this particle, the table holds the resolution
+      unsigned int nmeas = (_use_vertex_in_fitting ? 1 : 0);
+      for (unsigned int ilayer = 0; ilayer < m_HitsByTrack.size(); ilayer++)
+      {
+        map<int, vector<PHG4Hit*> >::const_iterator hits = m_HitsByTrack[ilayer].find(particle->get_track_id());
+        if (hits == m_HitsByTrack[ilayer].end())
+        {
+          continue;
+        }
+        for (unsigned int ihit = 0; ihit < hits->second.size(); ihit++)
+        {
+          if (gsl_ran_binomial(m_RandomGenerator, _phg4_detector_hitfindeff[ilayer], 1) > 0)
+          {
+            nmeas++;
+          }
+        }
+      }
+      if (nmeas < 3)
+      {
+        continue;
+      }
+      SvtxTrack* svtx_track_out = MakeParametrizedSvtxTrack(particle, nmeas, vtxPoint);
+      if (svtx_track_out)
+      {
+        _trackmap_out->insert(svtx_track_out);
+        delete svtx_track_out;  // insert makes a clone
+      }
+      continue;
+    }
+
     TVector3 seed_pos(vtxPoint.x(), vtxPoint.y(), vtxPoint.z());
     TVector3 seed_mom(0, 0, 0);
     TMatrixDSym seed_cov(6);
@@ -380,6 +453,20 @@ int PHG4TrackFastSim::process_event(PHCompositeNode* topNode)
       svtx_track_out->identify();
     }
 
+    if (svtx_track_out && m_ResolutionTable)
+    {
+      // residuals for the parametrized mode
+      TVector3 true_mom(particle->get_px(), particle->get_py(), particle->get_pz());
+      TVector3 reco_mom(svtx_track_out->get_px(), svtx_track_out->get_py(), svtx_track_out->get_pz());
+      double residual[PHG4TrackFastSimResolutionTable::NPAR];
+      residual[0] = reco_mom.Mag() / true_mom.Mag() - 1;
+      residual[1] = reco_mom.Theta() - true_mom.Theta();
+      residual[2] = TVector2::Phi_mpi_pi(reco_mom.Phi() - true_mom.Phi());
+      residual[3] = svtx_track_out->get_dca2d();
+      residual[4] = svtx_track_out->get_z() - vtx.z();
+      m_ResolutionTable->Fill(true_mom.Pt(), true_mom.Eta(), residual);
+    }
+
     if (svtx_track_out)
     {
       //      track -> output container
@@ -393,7 +480,7 @@ int PHG4TrackFastSim::process_event(PHCompositeNode* topNode)
   }  // Loop all primary particles
 
   //vertex finding
-  if (_do_vertexing)
+  if (_do_vertexing && !m_ParametrizedFlag)
   {
     if (!_vertex_finder)
     {
@@ -706,7 +793,6 @@ int PHG4TrackFastSim::PseudoPatternRecognition(const PHG4Particle* particle,
       continue;
     }
 
-    int dettype = _phg4_detector_type[ilayer];
     float detradres = _phg4_detector_radres[ilayer];
     float detphires = _phg4_detector_phires[ilayer];
     float detlonres = _phg4_detector_lonres[ilayer];
@@ -725,6 +811,23 @@ int PHG4TrackFastSim::PseudoPatternRecognition(const PHG4Particle* particle,
                 << ", detnoise = " << detnoise
                 << " \n";
     }
+    if (detnoise <= 0 && ilayer < m_HitsByTrack.size())
+    {
+      // without noise hits only the hits of this particle matter
+      map<int, vector<PHG4Hit*> >::const_iterator hits = m_HitsByTrack[ilayer].find(particle->get_track_id());
+      if (hits != m_HitsByTrack[ilayer].end())
+      {
+        for (unsigned int ihit = 0; ihit < hits->second.size(); ihit++)
+        {
+          PHGenFit::Measurement* meas = HitToMeasurement(hits->second[ihit], ilayer);
+          if (meas)
+          {
+            meas_out.push_back(meas);
+          }
+        }
+      }
+      continue;
+    }
     for (PHG4HitContainer::LayerIter layerit =
              _phg4hits[ilayer]->getLayers().first;
          layerit != _phg4hits[ilayer]->getLayers().second; layerit++)
@@ -742,39 +845,10 @@ int PHG4TrackFastSim::PseudoPatternRecognition(const PHG4Particle* particle,
 
         if (hit->get_trkid() == particle->get_track_id() || gsl_ran_binomial(m_RandomGenerator, detnoise, 1) > 0)
         {
-          if (gsl_ran_binomial(m_RandomGenerator, dethiteff, 1) > 0)
+          PHGenFit::Measurement* meas = HitToMeasurement(hit, ilayer);
+          if (meas)
           {
-            PHGenFit::Measurement* meas = nullptr;
-            if (dettype == Vertical_Plane)
-            {
-              if (Verbosity())
-              {
-                std::cout << "PHG4TrackFastSim::PseudoPatternRecognition -adding vertical plane hit ilayer: "
-                          << ilayer << "; detphires: " << detphires << "; detradres: " << detradres << " \n";
-                hit->identify();
-              }
-              meas = PHG4HitToMeasurementVerticalPlane(hit,
-                                                       detphires, detradres);
-            }
-            else if (dettype == Cylinder)
-            {
-              if (Verbosity())
-              {
-                std::cout << "PHG4TrackFastSim::PseudoPatternRecognition -adding cylinder hit ilayer: "
-                          << ilayer << "; detphires: " << detphires << "; detlonres : " << detlonres << " \n";
-                hit->identify();
-              }
-              meas = PHG4HitToMeasurementCylinder(hit,
-                                                  detphires, detlonres);
-            }
-            else
-            {
-              LogError("Type not implemented!");
-              return Fun4AllReturnCodes::ABORTEVENT;
-            }
             meas_out.push_back(meas);
-
-            //meas->getMeasurement()->Print(); //DEBUG
           }
         }
       }
@@ -801,6 +875,140 @@ int PHG4TrackFastSim::PseudoPatternRecognition(const PHG4Particle* particle,
   return Fun4AllReturnCodes::EVENT_OK;
 }
 
+void PHG4TrackFastSim::IndexHits()
+{
+  m_HitsByTrack.resize(_phg4hits.size());
+  for (unsigned int ilayer = 0; ilayer < _phg4hits.size(); ilayer++)
+  {
+    m_HitsByTrack[ilayer].clear();
+    if (!_phg4hits[ilayer])
+    {
+      continue;
+    }
+    for (PHG4HitContainer::LayerIter layerit = _phg4hits[ilayer]->getLayers().first;
+         layerit != _phg4hits[ilayer]->getLayers().second; layerit++)
+    {
+      for (PHG4HitContainer::ConstIterator itr = _phg4hits[ilayer]->getHits(*layerit).first;
+           itr != _phg4hits[ilayer]->getHits(*layerit).second; ++itr)
+      {
+        if (itr->second)
+        {
+          m_HitsByTrack[ilayer][itr->second->get_trkid()].push_back(itr->second);
+        }
+      }
+    }
+  }
+}
+
+PHGenFit::Measurement* PHG4TrackFastSim::HitToMeasurement(const PHG4Hit* hit, const unsigned int ilayer)
+{
+  if (gsl_ran_binomial(m_RandomGenerator, _phg4_detector_hitfindeff[ilayer], 1) <= 0)
+  {
+    return nullptr;
+  }
+  const float detphires = _phg4_detector_phires[ilayer];
+  if (_phg4_detector_type[ilayer] == Vertical_Plane)
+  {
+    if (Verbosity())
+    {
+      std::cout << "PHG4TrackFastSim::PseudoPatternRecognition -adding vertical plane hit ilayer: "
+                << ilayer << "; detphires: " << detphires << "; detradres: " << _phg4_detector_radres[ilayer] << " \n";
+      hit->identify();
+    }
+    return PHG4HitToMeasurementVerticalPlane(hit, detphires, _phg4_detector_radres[ilayer]);
+  }
+  else if (_phg4_detector_type[ilayer] == Cylinder)
+  {
+    if (Verbosity())
+    {
+      std::cout << "PHG4TrackFastSim::PseudoPatternRecognition -adding cylinder hit ilayer: "
+                << ilayer << "; detphires: " << detphires << "; detlonres : " << _phg4_detector_lonres[ilayer] << " \n";
+      hit->identify();
+    }
+    return PHG4HitToMeasurementCylinder(hit, detphires, _phg4_detector_lonres[ilayer]);
+  }
+  LogError("Type not implemented!");
+  return nullptr;
+}
+
+SvtxTrack* PHG4TrackFastSim::MakeParametrizedSvtxTrack(const PHG4Particle* particle,
+                                                       const unsigned int nmeas, const TVector3& vtx)
+{
+  TVector3 true_mom(particle->get_px(), particle->get_py(), particle->get_pz());
+  if (true_mom.Pt() <= 0)
+  {
+    return nullptr;
+  }
+  double gaus[PHG4TrackFastSimResolutionTable::NPAR];
+  for (int i = 0; i < PHG4TrackFastSimResolutionTable::NPAR; i++)
+  {
+    gaus[i] = gsl_ran_gaussian(m_RandomGenerator, 1);
+  }
+  double residual[PHG4TrackFastSimResolutionTable::NPAR];
+  const double* rescov = m_ResolutionTable->GetCovariance(true_mom.Pt(), true_mom.Eta());
+  if (!rescov || !m_ResolutionTable->Residuals(true_mom.Pt(), true_mom.Eta(), gaus, residual))
+  {
+    return nullptr;
+  }
+
+  const double p = true_mom.Mag() * (1 + residual[0]);
+  const double theta = true_mom.Theta() + residual[1];
+  const double phi = true_mom.Phi() + residual[2];
+  const double dca2d = residual[3];
+  const double dcaz = residual[4];
+  TVector3 mom;
+  mom.SetMagThetaPhi(p, theta, phi);
+  // dca2d is along mom X beam line, as for the fitted tracks
+  TVector3 pos(vtx.x() + dca2d * sin(phi), vtx.y() - dca2d * cos(phi), vtx.z() + dcaz);
+
+  TParticlePDG* pdg_p = TDatabasePDG::Instance()->GetParticle(particle->get_pid());
+  const int charge = (pdg_p ? lrint(pdg_p->Charge() / 3.) : 0);
+
+  SvtxTrack_FastSim* out_track = new SvtxTrack_FastSim();
+  out_track->set_truth_track_id(particle->get_track_id());
+  out_track->set_dca2d(dca2d);
+  out_track->set_dca2d_error(rescov[3 * PHG4TrackFastSimResolutionTable::NPAR + 3]);
+  out_track->set_dca(sqrt(dca2d * dca2d + dcaz * dcaz));
+  const int ndf = 2 * nmeas - 5;
+  out_track->set_ndf(ndf);
+  out_track->set_chisq(ndf > 0 ? gsl_ran_chisq(m_RandomGenerator, ndf) : 0);
+  out_track->set_charge(charge);
+  out_track->set_num_measurements(nmeas);
+  out_track->set_px(mom.Px());
+  out_track->set_py(mom.Py());
+  out_track->set_pz(mom.Pz());
+  out_track->set_x(pos.X());
+  out_track->set_y(pos.Y());
+  out_track->set_z(pos.Z());
+
+  // propagate the residual covariance to x, y, z, px, py, pz
+  const double sth = sin(theta), cth = cos(theta), sph = sin(phi), cph = cos(phi);
+  const double p0 = true_mom.Mag();
+  TMatrixD jac(6, PHG4TrackFastSimResolutionTable::NPAR);
+  jac(0, 3) = sph;
+  jac(1, 3) = -cph;
+  jac(2, 4) = 1;
+  jac(3, 0) = p0 * sth * cph;
+  jac(3, 1) = p * cth * cph;
+  jac(3, 2) = -p * sth * sph;
+  jac(4, 0) = p0 * sth * sph;
+  jac(4, 1) = p * cth * sph;
+  jac(4, 2) = p * sth * cph;
+  jac(5, 0) = p0 * cth;
+  jac(5, 1) = -p * sth;
+  TMatrixD cov5(PHG4TrackFastSimResolutionTable::NPAR, PHG4TrackFastSimResolutionTable::NPAR, rescov);
+  TMatrixD cov6(jac, TMatrixD::kMult, TMatrixD(cov5, TMatrixD::kMultTranspose, jac));
+  for (int i = 0; i < 6; i++)
+  {
+    for (int j = i; j < 6; j++)
+    {
+      out_track->set_error(i, j, cov6(i, j));
+    }
+  }
+
+  return static_cast<SvtxTrack*>(out_track);
+}
+
 SvtxTrack* PHG4TrackFastSim::MakeSvtxTrack(const PHGenFit::Track* phgf_track,
                                            const unsigned int truth_track_id,
                                            const unsigned int nmeas,
@@ -37,6 +37,7 @@ class Track;
 class PHG4Hit;
 class PHG4HitContainer;
 class PHG4Particle;
+class PHG4TrackFastSimResolutionTable;
 class SvtxTrack;
 class SvtxTrackMap;
 class SvtxVertexMap;
@@ -221,6 +222,21 @@ class PHG4TrackFastSim : public SubsysReco
     _do_vertexing = b;
   }
 
+  //! record the residuals of the fitted tracks vs truth pt and eta, written to filename in End()
+  void set_resolution_table_output(const std::string& filename,
+                                   const int npt = 50, const double ptmin = 0, const double ptmax = 50,
+                                   const int neta = 40, const double etamin = -4, const double etamax = 4);
+
+  //! parametrized mode: do not fit, smear the truth tracks with the residuals of a table
+  //! recorded with set_resolution_table_output() for the same detector configuration.
+  //! Tracks still need three measurements (hits after efficiency, plus the vertex).
+  //! No track state projections and no vertexing in this mode
+  void set_parametrized_resolution(const std::string& filename)
+  {
+    m_ResolutionTableFile = filename;
+    m_ParametrizedFlag = true;
+  }
+
   void DisplayEvent() const;
 
  private:
@@ -247,6 +263,18 @@ class PHG4TrackFastSim : public SubsysReco
 
   PHGenFit::Measurement* VertexMeasurement(const TVector3& vtx, double dxy, double dz);
 
+  //! measurement of a hit after the hit finding efficiency of its layer, nullptr if it is lost
+  PHGenFit::Measurement* HitToMeasurement(const PHG4Hit* hit, const unsigned int ilayer);
+
+  //! sort the hits of every layer by their track id
+  void IndexHits();
+
+  /*!
+   * Make SvtxTrack from the truth particle and the parametrized resolution
+   */
+  SvtxTrack* MakeParametrizedSvtxTrack(const PHG4Particle* particle,
+                                       const unsigned int nmeas, const TVector3& vtx);
+
   /*!
 	 * Make SvtxTrack from PHGenFit::Track
 	 */
@@ -280,6 +308,9 @@ class PHG4TrackFastSim : public SubsysReco
   std::vector<float> _phg4_detector_hitfindeff;
   std::vector<float> _phg4_detector_noise;
 
+  //! per layer, the hits of every track id. Layers without noise hits only look at these
+  std::vector<std::map<int, std::vector<PHG4Hit*> > > m_HitsByTrack;
+
   //! Output Node pointers
 
   std::string _sub_top_node_name;
@@ -331,6 +362,11 @@ class PHG4TrackFastSim : public SubsysReco
   std::vector<std::string> _state_names;
   std::vector<double> _state_location;
 
+  //! resolution table for the parametrized mode or to record the residuals
+  PHG4TrackFastSimResolutionTable* m_ResolutionTable;
+  std::string m_ResolutionTableFile;
+  bool m_ParametrizedFlag;
+
 #if !defined(__CINT__) || defined(__CLING__)
   //! random generator that conform with sPHENIX standard
   gsl_rng* m_RandomGenerator;
@@ -0,0 +1,235 @@
+#include "PHG4TrackFastSimResolutionTable.h"
+
+#include <TFile.h>
+#include <TTree.h>
+#include <TVectorT.h>  // for TVectorD
+
+#include <cmath>
+#include <cstring>  // for memset
+#include <iostream>
+
+using namespace std;
+
+PHG4TrackFastSimResolutionTable::PHG4TrackFastSimResolutionTable()
+  : m_NPt(0)
+  , m_PtMin(0)
+  , m_PtMax(0)
+  , m_NEta(0)
+  , m_EtaMin(0)
+  , m_EtaMax(0)
+  , m_MinEntries(10)
+{
+}
+
+void PHG4TrackFastSimResolutionTable::SetBinning(const int npt, const double ptmin, const double ptmax,
+                                                 const int neta, const double etamin, const double etamax)
+{
+  m_NPt = npt;
+  m_PtMin = ptmin;
+  m_PtMax = ptmax;
+  m_NEta = neta;
+  m_EtaMin = etamin;
+  m_EtaMax = etamax;
+  Bin empty;
+  memset(&empty, 0, sizeof(empty));
+  m_Bins.assign(m_NPt * m_NEta, empty);
+}
+
+int PHG4TrackFastSimResolutionTable::GetBin(const double pt, const double eta) const
+{
+  if (m_Bins.empty())
+  {
+    return -1;
+  }
+  int ipt = floor((pt - m_PtMin) / (m_PtMax - m_PtMin) * m_NPt);
+  int ieta = floor((eta - m_EtaMin) / (m_EtaMax - m_EtaMin) * m_NEta);
+  ipt = max(0, min(m_NPt - 1, ipt));
+  ieta = max(0, min(m_NEta - 1, ieta));
+  return ipt * m_NEta + ieta;
+}
+
+void PHG4TrackFastSimResolutionTable::Fill(const double pt, const double eta, const double *residual)
+{
+  int ibin = GetBin(pt, eta);
+  if (ibin < 0)
+  {
+    return;
+  }
+  Bin &bin = m_Bins[ibin];
+  bin.n++;
+  for (int i = 0; i < NPAR; i++)
+  {
+    bin.sum[i] += residual[i];
+    for (int j = 0; j < NPAR; j++)
+    {
+      bin.sum2[i * NPAR + j] += residual[i] * residual[j];
+    }
+  }
+  bin.valid = false;
+}
+
+void PHG4TrackFastSimResolutionTable::Finish()
+{
+  for (unsigned int ibin = 0; ibin < m_Bins.size(); ibin++)
+  {
+    Bin &bin = m_Bins[ibin];
+    bin.valid = false;
+    if (bin.n < m_MinEntries)
+    {
+      continue;
+    }
+    for (int i = 0; i < NPAR; i++)
+    {
+      bin.mean[i] = bin.sum[i] / bin.n;
+    }
+    for (int i = 0; i < NPAR; i++)
+    {
+      for (int j = 0; j < NPAR; j++)
+      {
+        bin.cov[i * NPAR + j] = bin.sum2[i * NPAR + j] / bin.n - bin.mean[i] * bin.mean[j];
+      }
+    }
+    // Cholesky decomposition, lower triangle
+    bool posdef = true;
+    memset(bin.chol, 0, sizeof(bin.chol));
+    for (int i = 0; i < NPAR && posdef; i++)
+    {
+      for (int j = 0; j <= i; j++)
+      {
+        double sum = bin.cov[i * NPAR + j];
+        for (int k = 0; k < j; k++)
+        {
+          sum -= bin.chol[i * NPAR + k] * bin.chol[j * NPAR + k];
+        }
+        if (i == j)
+        {
+          if (sum <= 0)
+          {
+            posdef = false;
+            break;
+          }
+          bin.chol[i * NPAR + i] = sqrt(sum);
+        }
+        else
+        {
+          bin.chol[i * NPAR + j] = sum / bin.chol[j * NPAR + j];
+        }
+      }
+    }
+    bin.valid = posdef;
+  }
+}
+
+bool PHG4TrackFastSimResolutionTable::Residuals(const double pt, const double eta, const double *gaus, double *residual) const
+{
+  int ibin = GetBin(pt, eta);
+  if (ibin < 0 || !m_Bins[ibin].valid)
+  {
+    return false;
+  }
+  const Bin &bin = m_Bins[ibin];
+  for (int i = 0; i < NPAR; i++)
+  {
+    residual[i] = bin.mean[i];
+    for (int j = 0; j <= i; j++)
+    {
+      residual[i] += bin.chol[i * NPAR + j] * gaus[j];
+    }
+  }
+  return true;
+}
+
+const double *PHG4TrackFastSimResolutionTable::GetCovariance(const double pt, const double eta) const
+{
+  int ibin = GetBin(pt, eta);
+  if (ibin < 0 || !m_Bins[ibin].valid)
+  {
+    return nullptr;
+  }
+  return m_Bins[ibin].cov;
+}
+
+int PHG4TrackFastSimResolutionTable::Write(const string &filename) const
+{
+  TFile *f = TFile::Open(filename.c_str(), "RECREATE");
+  if (!f || f->IsZombie())
+  {
+    cout << "PHG4TrackFastSimResolutionTable::Write - could not open " << filename << endl;
+    delete f;
+    return -1;
+  }
+  TVectorD binning(6);
+  binning[0] = m_NPt;
+  binning[1] = m_PtMin;
+  binning[2] = m_PtMax;
+  binning[3] = m_NEta;
+  binning[4] = m_EtaMin;
+  binning[5] = m_EtaMax;
+  binning.Write("binning");
+
+  TTree *t = new TTree("resolution", "PHG4TrackFastSim track parameter residuals");
+  unsigned int n;
+  double sum[NPAR];
+  double sum2[NPAR * NPAR];
+  t->Branch("n", &n, "n/i");
+  t->Branch("sum", sum, "sum[5]/D");
+  t->Branch("sum2", sum2, "sum2[25]/D");
+  for (unsigned int ibin = 0; ibin < m_Bins.size(); ibin++)
+  {
+    n = m_Bins[ibin].n;
+    memcpy(sum, m_Bins[ibin].sum, sizeof(sum));
+    memcpy(sum2, m_Bins[ibin].sum2, sizeof(sum2));
+    t->Fill();
+  }
+  t->Write();
+  f->Close();
+  delete f;
+  return 0;
+}
+
+int PHG4TrackFastSimResolutionTable::Read(const string &filename)
+{
+  TFile *f = TFile::Open(filename.c_str());
+  if (!f || f->IsZombie())
+  {
+    cout << "PHG4TrackFastSimResolutionTable::Read - could not open " << filename << endl;
+    delete f;
+    return -1;
+  }
+  TVectorD *binning = dynamic_cast<TVectorD *>(f->Get("binning"));
+  TTree *t = dynamic_cast<TTree *>(f->Get("resolution"));
+  if (!binning || !t)
+  {
+    cout << "PHG4TrackFastSimResolutionTable::Read - no resolution table in " << filename << endl;
+    f->Close();
+    delete f;
+    return -1;
+  }
+  SetBinning(lrint((*binning)[0]), (*binning)[1], (*binning)[2],
+             lrint((*binning)[3]), (*binning)[4], (*binning)[5]);
+  if (t->GetEntries() != static_cast<long long>(m_Bins.size()))
+  {
+    cout << "PHG4TrackFastSimResolutionTable::Read - " << filename << " has "
+         << t->GetEntries() << " bins, expected " << m_Bins.size() << endl;
+    f->Close();
+    delete f;
+    return -1;
+  }
+  unsigned int n;
+  double sum[NPAR];
+  double sum2[NPAR * NPAR];
+  t->SetBranchAddress("n", &n);
+  t->SetBranchAddress("sum", sum);
+  t->SetBranchAddress("sum2", sum2);
+  for (unsigned int ibin = 0; ibin < m_Bins.size(); ibin++)
+  {
+    t->GetEntry(ibin);
+    m_Bins[ibin].n = n;
+    memcpy(m_Bins[ibin].sum, sum, sizeof(sum));
+    memcpy(m_Bins[ibin].sum2, sum2, sizeof(sum2));
+  }
+  f->Close();
+  delete f;
+  Finish();
+  return 0;
+}
@@ -0,0 +1,74 @@
+// Tell emacs that this is a C++ source
+//  -*- C++ -*-.
+#ifndef G4TRACKFASTSIM_PHG4TRACKFASTSIMRESOLUTIONTABLE_H
+#define G4TRACKFASTSIM_PHG4TRACKFASTSIMRESOLUTIONTABLE_H
+
+#include <string>
+#include <vector>
+
+/*!
+ * \brief track parameter resolutions binned in truth pt and eta
+ *
+ * Filled with the residuals of the GenFit fitted tracks of PHG4TrackFastSim
+ * for one detector configuration. In parametrized mode PHG4TrackFastSim draws
+ * correlated residuals from the mean and covariance of the bin instead of
+ * fitting. The residuals are relative momentum, theta, phi, dca2d and dca z.
+ */
+class PHG4TrackFastSimResolutionTable
+{
+ public:
+  enum
+  {
+    NPAR = 5
+  };
+
+  PHG4TrackFastSimResolutionTable();
+  virtual ~PHG4TrackFastSimResolutionTable() {}
+
+  void SetBinning(const int npt, const double ptmin, const double ptmax,
+                  const int neta, const double etamin, const double etamax);
+
+  void Fill(const double pt, const double eta, const double *residual);
+
+  int Write(const std::string &filename) const;
+  int Read(const std::string &filename);
+
+  //! draw residuals for a track with this truth pt and eta, gaus are NPAR
+  //! standard normal numbers. pt and eta outside the table use the edge bins.
+  //! Returns false if the bin has too few entries
+  bool Residuals(const double pt, const double eta, const double *gaus, double *residual) const;
+
+  //! covariance of the residuals in the bin of pt and eta, nullptr if the bin is not usable
+  const double *GetCovariance(const double pt, const double eta) const;
+
+ private:
+  struct Bin
+  {
+    unsigned int n;
+    double sum[NPAR];
+    double sum2[NPAR * NPAR];
+    // filled by Finish()
+    double mean[NPAR];
+    double cov[NPAR * NPAR];
+    double chol[NPAR * NPAR];
+    bool valid;
+  };
+
+  int GetBin(const double pt, const double eta) const;
+  //! mean, covariance and its Cholesky decomposition of every bin
+  void Finish();
+
+  int m_NPt;
+  double m_PtMin;
+  double m_PtMax;
+  int m_NEta;
+  double m_EtaMin;
+  double m_EtaMax;
+
+  //! bins with fewer tracks are not used for smearing
+  unsigned int m_MinEntries;
+
+  std::vector<Bin> m_Bins;
+};
+
+#endif
@@ -54,7 +54,8 @@ GlobalVertex* GlobalVertexMapv1::insert(GlobalVertex* clus)
 {
   unsigned int index = 0;
   if (!_map.empty()) index = _map.rbegin()->first + 1;
-  _map.insert(make_pair(index, clus));
-  _map[index]->set_id(index);
-  return _map[index];
+  // the new id is the largest, inserting at the end takes constant time
+  _map.insert(_map.end(), make_pair(index, clus));
+  clus->set_id(index);
+  return clus;
 }
@@ -22,12 +22,13 @@
 #include <phool/getClass.h>
 #include <phool/phool.h>                       // for PHWHERE
 
+#include <algorithm>
 #include <cfloat>
 #include <cmath>
 #include <cstdlib>                            // for exit
-#include <set>                                 // for _Rb_tree_const_iterator
 #include <iostream>
 #include <utility>                             // for pair
+#include <vector>
 
 using namespace std;
 
@@ -39,6 +40,7 @@ GlobalVertexReco::GlobalVertexReco(const string &name)
   , _yerr(0.3)
   , _tdefault(0.0)
   , _terr(0.2)
+  , _time_window(0.0)
 {
 }
 
@@ -93,33 +95,66 @@ int GlobalVertexReco::process_event(PHCompositeNode *topNode)
   // untrust worthy, I'm guessing analyzers would resort exclusively to (1) or (2)
   // in those cases
 
-  std::set<unsigned int> used_svtx_vtxids;
-  std::set<unsigned int> used_bbc_vtxids;
+  // matched vertexes by their position in the SVTX and BBC maps
+  vector<bool> used_svtx(svtxmap ? svtxmap->size() : 0, false);
+  vector<bool> used_bbc(bbcmap ? bbcmap->size() : 0, false);
 
   if (svtxmap && bbcmap)
   {
     if (Verbosity()) cout << "GlobalVertexReco::process_event - svtxmap && bbcmap" << endl;
 
+    // BBC vertexes sorted in z (ties in map order), a SVTX vertex only looks
+    // at the ones within 3 sigma using the largest BBC z error, the nearest
+    // in sigma is the same as searching all of them
+    vector<BbcZ> bbc_sorted;
+    bbc_sorted.reserve(bbcmap->size());
+    float max_bbc_zerr = 0;
+    unsigned int index = 0;
+    for (BbcVertexMap::ConstIter bbciter = bbcmap->begin();
+         bbciter != bbcmap->end();
+         ++bbciter, ++index)
+    {
+      const BbcVertex *bbc = bbciter->second;
+      // vertexes without z or z error never match (nan sigma)
+      if (std::isnan(bbc->get_z()) || std::isnan(bbc->get_z_err())) continue;
+      bbc_sorted.push_back(BbcZ(bbc->get_z(), index, bbc));
+      max_bbc_zerr = max(max_bbc_zerr, fabs(bbc->get_z_err()));
+    }
+    sort(bbc_sorted.begin(), bbc_sorted.end());
+
+    index = 0;
     for (SvtxVertexMap::ConstIter svtxiter = svtxmap->begin();
          svtxiter != svtxmap->end();
-         ++svtxiter)
+         ++svtxiter, ++index)
     {
       const SvtxVertex *svtx = svtxiter->second;
 
+      const float svtx_z = svtx->get_z();
+      const float svtx_zerr2 = svtx->get_error(2, 2);
+      if (std::isnan(svtx_z) || std::isnan(svtx_zerr2)) continue;
+      // a little wider than 3 sigma against rounding
+      const float window = 3.001 * sqrt(svtx_zerr2 + max_bbc_zerr * max_bbc_zerr);
+
       const BbcVertex *bbc_best = nullptr;
+      unsigned int bbc_best_index = 0;
       float min_sigma = FLT_MAX;
-      for (BbcVertexMap::ConstIter bbciter = bbcmap->begin();
-           bbciter != bbcmap->end();
+      for (vector<BbcZ>::const_iterator bbciter = lower_bound(bbc_sorted.begin(), bbc_sorted.end(), BbcZ(svtx_z - window, 0, nullptr));
+           bbciter != bbc_sorted.end() && bbciter->z <= svtx_z + window;
            ++bbciter)
       {
-        const BbcVertex *bbc = bbciter->second;
+        const BbcVertex *bbc = bbciter->vertex;
+
+        // streaming readout: only BBC vertexes of the same crossing
+        if (_time_window > 0 && std::isfinite(svtx->get_t0()) &&
+            fabs(svtx->get_t0() - bbc->get_t()) > _time_window) continue;
 
-        float combined_error = sqrt(svtx->get_error(2, 2) + pow(bbc->get_z_err(), 2));
-        float sigma = fabs(svtx->get_z() - bbc->get_z()) / combined_error;
-        if (sigma < min_sigma)
+        float combined_error = sqrt(svtx_zerr2 + pow(bbc->get_z_err(), 2));
+        float sigma = fabs(svtx_z - bbc->get_z()) / combined_error;
+        if (sigma < min_sigma || (sigma == min_sigma && bbciter->index < bbc_best_index))
         {
           min_sigma = sigma;
           bbc_best = bbc;
+          bbc_best_index = bbciter->index;
         }
       }
 
@@ -144,9 +179,9 @@ int GlobalVertexReco::process_event(PHCompositeNode *topNode)
       vertex->set_ndof(svtx->get_ndof());
 
       vertex->insert_vtxids(GlobalVertex::SVTX, svtx->get_id());
-      used_svtx_vtxids.insert(svtx->get_id());
+      used_svtx[index] = true;
       vertex->insert_vtxids(GlobalVertex::BBC, bbc_best->get_id());
-      used_bbc_vtxids.insert(bbc_best->get_id());
+      used_bbc[bbc_best_index] = true;
 
       globalmap->insert(vertex);
 
@@ -159,13 +194,14 @@ int GlobalVertexReco::process_event(PHCompositeNode *topNode)
   {
     if (Verbosity()) cout << "GlobalVertexReco::process_event - svtxmap " << endl;
 
+    unsigned int index = 0;
     for (SvtxVertexMap::ConstIter svtxiter = svtxmap->begin();
          svtxiter != svtxmap->end();
-         ++svtxiter)
+         ++svtxiter, ++index)
     {
       const SvtxVertex *svtx = svtxiter->second;
 
-      if (used_svtx_vtxids.find(svtx->get_id()) != used_svtx_vtxids.end()) continue;
+      if (used_svtx[index]) continue;
       if (isnan(svtx->get_z())) continue;
 
       // we have a standalone SVTX vertex
@@ -188,7 +224,6 @@ int GlobalVertexReco::process_event(PHCompositeNode *topNode)
       vertex->set_ndof(svtx->get_ndof());
 
       vertex->insert_vtxids(GlobalVertex::SVTX, svtx->get_id());
-      used_svtx_vtxids.insert(svtx->get_id());
 
       globalmap->insert(vertex);
 
@@ -201,13 +236,14 @@ int GlobalVertexReco::process_event(PHCompositeNode *topNode)
   {
     if (Verbosity()) cout << "GlobalVertexReco::process_event -  bbcmap" << endl;
 
+    unsigned int index = 0;
     for (BbcVertexMap::ConstIter bbciter = bbcmap->begin();
          bbciter != bbcmap->end();
-         ++bbciter)
+         ++bbciter, ++index)
     {
       const BbcVertex *bbc = bbciter->second;
 
-      if (used_bbc_vtxids.find(bbc->get_id()) != used_bbc_vtxids.end()) continue;
+      if (used_bbc[index]) continue;
       if (isnan(bbc->get_z())) continue;
 
       GlobalVertex *vertex = new GlobalVertexv1();
@@ -234,7 +270,6 @@ int GlobalVertexReco::process_event(PHCompositeNode *topNode)
       vertex->set_error(2, 2, pow(bbc->get_z_err(), 2));
 
       vertex->insert_vtxids(GlobalVertex::BBC, bbc->get_id());
-      used_bbc_vtxids.insert(bbc->get_id());
 
       globalmap->insert(vertex);
 
@@ -14,6 +14,7 @@
 
 #include <string>                // for string
 
+class BbcVertex;
 class PHCompositeNode;
 
 /// \class GlobalVertexReco
@@ -46,13 +47,36 @@ class GlobalVertexReco : public SubsysReco
     _tdefault = tdefault;
     _terr = terr;
   }
+  /// SVTX and BBC vertexes are only combined if their times differ by
+  /// less than dt (streaming readout), 0 (default) disables the cut,
+  /// SVTX vertexes without t0 are matched in z only
+  void set_time_window(float dt) { _time_window = dt; }
 
  private:
   int CreateNodes(PHCompositeNode *topNode);
 
+  /// BBC vertex with its position in the BbcVertexMap, sorted in z
+  struct BbcZ
+  {
+    BbcZ(float zz, unsigned int idx, const BbcVertex *vtx)
+      : z(zz)
+      , index(idx)
+      , vertex(vtx)
+    {
+    }
+    bool operator<(const BbcZ &other) const
+    {
+      return (z < other.z || (z == other.z && index < other.index));
+    }
+    float z;
+    unsigned int index;
+    const BbcVertex *vertex;
+  };
+
   float _xdefault, _xerr;
   float _ydefault, _yerr;
   float _tdefault, _terr;
+  float _time_window;
 };
 
 #endif  // G4VERTEX_GLOBALVERTEXRECO_H